@@ -0,0 +1,31 @@
+# Copyright (c)      2019 The STE||AR-Group
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+find_package(PkgConfig QUIET)
+pkg_check_modules(PC_PMIX QUIET pmix)
+
+find_path(PMIX_INCLUDE_DIR pmix.h
+  HINTS
+    ${PMIX_ROOT} ENV PMIX_ROOT
+    ${PMIX_DIR} ENV PMIX_DIR
+    ${PC_PMIX_INCLUDEDIR}
+    ${PC_PMIX_INCLUDE_DIRS}
+  PATH_SUFFIXES include)
+
+find_library(PMIX_LIBRARY NAMES pmix
+  HINTS
+    ${PMIX_ROOT} ENV PMIX_ROOT
+    ${PC_PMIX_LIBDIR}
+    ${PC_PMIX_LIBRARY_DIRS}
+  PATH_SUFFIXES lib lib64)
+
+set(PMIX_LIBRARIES ${PMIX_LIBRARY} CACHE INTERNAL "")
+set(PMIX_INCLUDE_DIRS ${PMIX_INCLUDE_DIR} CACHE INTERNAL "")
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(PMIx DEFAULT_MSG
+  PMIX_LIBRARY PMIX_INCLUDE_DIR)
+
+mark_as_advanced(PMIX_ROOT PMIX_LIBRARY PMIX_INCLUDE_DIR)
@@ -0,0 +1,41 @@
+# Copyright (c) 2019 The STE||AR-Group
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+find_package(PkgConfig QUIET)
+pkg_check_modules(PC_ZSTD QUIET libzstd)
+
+find_path(ZSTD_INCLUDE_DIR zstd.h
+  HINTS
+    ${ZSTD_ROOT} ENV ZSTD_ROOT
+    ${PC_ZSTD_MINIMAL_INCLUDEDIR}
+    ${PC_ZSTD_MINIMAL_INCLUDE_DIRS}
+    ${PC_ZSTD_INCLUDEDIR}
+    ${PC_ZSTD_INCLUDE_DIRS}
+  PATH_SUFFIXES include)
+
+find_library(ZSTD_LIBRARY NAMES zstd libzstd
+  HINTS
+    ${ZSTD_ROOT} ENV ZSTD_ROOT
+    ${PC_ZSTD_MINIMAL_LIBDIR}
+    ${PC_ZSTD_MINIMAL_LIBRARY_DIRS}
+    ${PC_ZSTD_LIBDIR}
+    ${PC_ZSTD_LIBRARY_DIRS}
+  PATH_SUFFIXES lib lib64)
+
+set(ZSTD_LIBRARIES ${ZSTD_LIBRARY})
+set(ZSTD_INCLUDE_DIRS ${ZSTD_INCLUDE_DIR})
+
+find_package_handle_standard_args(Zstd DEFAULT_MSG
+  ZSTD_LIBRARY ZSTD_INCLUDE_DIR)
+
+get_property(_type CACHE ZSTD_ROOT PROPERTY TYPE)
+if(_type)
+  set_property(CACHE ZSTD_ROOT PROPERTY ADVANCED 1)
+  if("x${_type}" STREQUAL "xUNINITIALIZED")
+    set_property(CACHE ZSTD_ROOT PROPERTY TYPE PATH)
+  endif()
+endif()
+
+mark_as_advanced(ZSTD_ROOT ZSTD_LIBRARY ZSTD_INCLUDE_DIR)
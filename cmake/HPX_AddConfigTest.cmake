@@ -700,6 +700,13 @@ function(hpx_check_for_cxx17_hardware_destructive_interference_size)
     FILE ${ARGN})
 endfunction()
 
+###############################################################################
+function(hpx_check_for_cxx20_coroutines)
+  add_hpx_config_test(HPX_WITH_CXX20_COROUTINES
+    SOURCE cmake/tests/cxx20_coroutines.cpp
+    FILE ${ARGN})
+endfunction()
+
 ###############################################################################
 function(hpx_check_for_mm_prefetch)
   add_hpx_config_test(HPX_WITH_MM_PREFETCH
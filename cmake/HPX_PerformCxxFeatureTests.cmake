@@ -202,4 +202,10 @@ function(hpx_perform_cxx_feature_tests)
     hpx_check_for_cxx17_hardware_destructive_interference_size(
       DEFINITIONS HPX_HAVE_CXX17_HARDWARE_DESTRUCTIVE_INTERFERENCE_SIZE)
   endif()
+
+  if(HPX_WITH_CXX2A)
+    # Check the availability of certain C++20 language features
+    hpx_check_for_cxx20_coroutines(
+      DEFINITIONS HPX_HAVE_CXX20_COROUTINES)
+  endif()
 endfunction()
@@ -0,0 +1,29 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <coroutine>
+
+struct resumable
+{
+    struct promise_type
+    {
+        resumable get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() {}
+    };
+};
+
+resumable f()
+{
+    co_await std::suspend_never{};
+}
+
+int main()
+{
+    f();
+    return 0;
+}
@@ -0,0 +1,224 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This example solves the same 1D heat distribution problem as the other
+// examples in this directory, but keeps the grid in a partitioned_vector and
+// runs in SPMD style: hpx_main is executed on all localities, each of them
+// updates the partitions it holds. The boundary values of the partitions are
+// exchanged using hpx::partitioned_vector_halo, which sends them directly
+// from buffers allocated once. The interior of each partition is computed
+// while the halos are in flight.
+//
+// The problem size is given per partition and there are 'np' partitions on
+// each locality, which makes this example suitable for weak scaling runs.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/partitioned_vector_halo.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "print_time_results.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector and halo types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_HALO_EXCHANGE(double);
+
+///////////////////////////////////////////////////////////////////////////////
+// Command-line variables
+bool header = true; // print csv heading
+double k = 0.5;     // heat transfer coefficient
+double dt = 1.;     // time step
+double dx = 1.;     // grid spacing
+
+// Our operator
+inline double heat(double left, double middle, double right)
+{
+    return middle + (k*dt/(dx*dx)) * (left - 2*middle + right);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::partitioned_vector<double> vector_type;
+typedef hpx::traits::segmented_iterator_traits<vector_type::iterator> traits;
+typedef hpx::lcos::halo_exchange<double> halo_type;
+
+// the data of one of the partitions located on this locality
+struct partition
+{
+    traits::local_raw_iterator data_;
+    std::vector<double> next_;
+};
+
+// Compute one time step for the given partition. The interior points do not
+// depend on the halos and are computed before waiting for them.
+void do_step(partition& p, halo_type& halo, std::size_t t)
+{
+    traits::local_raw_iterator u = p.data_;
+    std::size_t nx = p.next_.size();
+
+    for (std::size_t i = 1; i < nx - 1; ++i)
+        p.next_[i] = heat(u[i-1], u[i], u[i+1]);
+
+    halo.get_future(t).get();
+
+    double left = *halo.get_data(halo_type::left, t);
+    double right = *halo.get_data(halo_type::right, t);
+    if (nx == 1)
+    {
+        p.next_[0] = heat(left, u[0], right);
+    }
+    else
+    {
+        p.next_[0] = heat(left, u[0], u[1]);
+        p.next_[nx-1] = heat(u[nx-2], u[nx-1], right);
+    }
+
+    halo.release(t);
+
+    // the edges have been copied into the send buffers by now
+    std::copy(p.next_.begin(), p.next_.end(), u);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::uint64_t np = vm["np"].as<std::uint64_t>();   // Partitions per locality.
+    std::uint64_t nx = vm["nx"].as<std::uint64_t>();   // Points per partition.
+    std::uint64_t nt = vm["nt"].as<std::uint64_t>();   // Number of steps.
+
+    if (vm.count("no-header"))
+        header = false;
+
+    char const* const vector_name = "1d_stencil_halo_vector";
+
+    std::uint32_t nl = hpx::get_num_localities(hpx::launch::sync);
+
+    {
+        // create the grid on one locality, connect to it from all others
+        vector_type v;
+
+        if (0 == hpx::get_locality_id())
+        {
+            std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+            v = vector_type(nx * np * nl,
+                    hpx::container_layout(np * nl, localities));
+            v.register_as(hpx::launch::sync, vector_name);
+        }
+        else
+        {
+            v.connect_to(hpx::launch::sync, vector_name);
+        }
+
+        hpx::lcos::barrier b("1d_stencil_halo_barrier");
+
+        // the local partitions are visited in the same order as by the
+        // halo exchange
+        hpx::partitioned_vector_halo<double> halos(
+            "1d_stencil_halo", v, 1, true);
+
+        // set the initial values of the local partitions
+        std::vector<partition> partitions;
+
+        std::uint32_t here = hpx::get_locality_id();
+        traits::local_segment_iterator it = v.segment_begin(here);
+        for (std::size_t p = 0; p != halos.size(); ++p, ++it)
+        {
+            std::size_t base = halos.get_segment(p) * nx;
+            traits::local_raw_iterator data = traits::begin(it);
+            for (std::size_t i = 0; i != nx; ++i)
+                data[i] = double(base + i);
+
+            partition part = { data, std::vector<double>(nx) };
+            partitions.push_back(std::move(part));
+        }
+        HPX_ASSERT(it == v.segment_end(here));
+
+        b.wait();
+
+        // Measure execution time.
+        std::uint64_t t = hpx::util::high_resolution_clock::now();
+
+        for (std::size_t step = 0; step != nt; ++step)
+        {
+            halos.put(step);
+
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), partitions.size(),
+                [&](std::size_t i)
+                {
+                    do_step(partitions[i], halos[i], step);
+                });
+        }
+
+        std::uint64_t elapsed = hpx::util::high_resolution_clock::now() - t;
+
+        // Wait for all localities to finish before printing the results.
+        b.wait();
+
+        if (0 == here)
+        {
+            if (vm.count("results"))
+            {
+                for (std::size_t i = 0; i != v.size(); ++i)
+                {
+                    std::cout << "U[" << i << "] = "
+                              << v.get_value(hpx::launch::sync, i)
+                              << std::endl;
+                }
+            }
+
+            std::uint64_t const os_thread_count = hpx::get_os_thread_count();
+            print_time_results(nl, os_thread_count, elapsed, nx, np, nt,
+                header);
+        }
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace boost::program_options;
+
+    // Configure application-specific options.
+    options_description desc_commandline;
+
+    desc_commandline.add_options()
+        ("results", "print generated results (default: false)")
+        ("nx", value<std::uint64_t>()->default_value(10),
+         "Local x dimension (of each partition)")
+        ("nt", value<std::uint64_t>()->default_value(45),
+         "Number of time steps")
+        ("np", value<std::uint64_t>()->default_value(10),
+         "Number of partitions per locality")
+        ("k", value<double>(&k)->default_value(0.5),
+         "Heat transfer coefficient (default: 0.5)")
+        ("dt", value<double>(&dt)->default_value(1.0),
+         "Timestep unit (default: 1.0[s])")
+        ("dx", value<double>(&dx)->default_value(1.0),
+         "Local x dimension")
+        ( "no-header", "do not print out the csv header row")
+    ;
+
+    // run hpx_main on all localities
+    std::vector<std::string> const cfg = {
+        "hpx.run_hpx_main!=1"
+    };
+
+    // Initialize and run HPX
+    return hpx::init(desc_commandline, argc, argv, cfg);
+}
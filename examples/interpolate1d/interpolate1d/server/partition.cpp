@@ -7,6 +7,7 @@
 
 #include <cstddef>
 #include <string>
+#include <vector>
 
 #include "partition.hpp"
 #include "../read_values.hpp"
@@ -41,10 +42,13 @@ namespace interpolate1d { namespace server
             dim_.offset_, dim_.offset_+dim_.count_);
 
         // read the slice of our data
-        values_.reset(new double[dim_.count_ + ghost_width_left + ghost_width_right]);
-        extract_data(datafilename, values_.get(),
+        std::vector<double> values(
+            dim_.count_ + ghost_width_left + ghost_width_right);
+        extract_data(datafilename, values.data(),
             dim_.offset_ - ghost_width_left,
             dim_.count_ + ghost_width_left + ghost_width_right);
+
+        values_ = hpx::compute::host::replicated_vector<double>(values);
     }
 
     // do the actual interpolation
@@ -7,9 +7,9 @@
 #define HPX_PARTITION_AUG_04_2011_1204PM
 
 #include <hpx/hpx.hpp>
+#include <hpx/compute/host/replicated_vector.hpp>
 
 #include <cstddef>
-#include <memory>
 #include <string>
 
 #include "../dimension.hpp"
@@ -43,7 +43,8 @@ namespace interpolate1d { namespace server
         static mutex_type mtx_;     // one for whole application
 
         dimension dim_;
-        std::unique_ptr<double[]> values_;
+        // the values are read by all cores, keep a copy per NUMA domain
+        hpx::compute::host::replicated_vector<double> values_;
         double min_value_, max_value_, delta_;
     };
 }}
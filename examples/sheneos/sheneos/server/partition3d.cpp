@@ -63,12 +63,15 @@ namespace sheneos { namespace server
 
     inline void
     partition3d::init_data(std::string const& datafilename,
-        char const* name, std::unique_ptr<double[]>& values,
+        char const* name,
+        hpx::compute::host::replicated_vector<double>& values,
         std::size_t array_size)
     {
-        values.reset(new double[array_size]);
-        extract_data(datafilename, name, values.get(), dim_[dimension::ye],
+        std::vector<double> data(array_size);
+        extract_data(datafilename, name, data.data(), dim_[dimension::ye],
             dim_[dimension::temp], dim_[dimension::rho]);
+
+        values = hpx::compute::host::replicated_vector<double>(data);
     }
 
     void partition3d::init(std::string const& datafilename,
@@ -146,7 +149,7 @@ namespace sheneos { namespace server
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    inline double partition3d::tl_interpolate(double* values,
+    inline double partition3d::tl_interpolate(double const* values,
         std::size_t idx_x, std::size_t idx_y, std::size_t idx_z,
         double delta_ye, double delta_logtemp, double delta_logrho) const
     {
@@ -195,44 +198,44 @@ namespace sheneos { namespace server
 
         // Calculate all required values.
         if (eosvalues & logpress) {
-            double value = tl_interpolate(logpress_values_.get(),
+            double value = tl_interpolate(logpress_values_.data(),
                 idx_ye, idx_logtemp, idx_logrho,
                 delta_ye, delta_logtemp, delta_logrho);
             results.push_back(std::pow(10., value));
         }
         if (eosvalues & logenergy) {
-            double value = tl_interpolate(logenergy_values_.get(),
+            double value = tl_interpolate(logenergy_values_.data(),
                 idx_ye, idx_logtemp, idx_logrho,
                 delta_ye, delta_logtemp, delta_logrho);
             results.push_back(std::pow(10., value) - energy_shift_);
         }
         if (eosvalues & entropy) {
-            results.push_back(tl_interpolate(entropy_values_.get(),
+            results.push_back(tl_interpolate(entropy_values_.data(),
                 idx_ye, idx_logtemp, idx_logrho,
                 delta_ye, delta_logtemp, delta_logrho));
         }
         if (eosvalues & munu) {
-            results.push_back(tl_interpolate(munu_values_.get(),
+            results.push_back(tl_interpolate(munu_values_.data(),
                 idx_ye, idx_logtemp, idx_logrho,
                 delta_ye, delta_logtemp, delta_logrho));
         }
         if (eosvalues & cs2) {
-            results.push_back(tl_interpolate(cs2_values_.get(),
+            results.push_back(tl_interpolate(cs2_values_.data(),
                 idx_ye, idx_logtemp, idx_logrho,
                 delta_ye, delta_logtemp, delta_logrho));
         }
         if (eosvalues & dedt) {
-            results.push_back(tl_interpolate(dedt_values_.get(),
+            results.push_back(tl_interpolate(dedt_values_.data(),
                 idx_ye, idx_logtemp, idx_logrho,
                 delta_ye, delta_logtemp, delta_logrho));
         }
         if (eosvalues & dpdrhoe) {
-            results.push_back(tl_interpolate(dpdrhoe_values_.get(),
+            results.push_back(tl_interpolate(dpdrhoe_values_.data(),
                 idx_ye, idx_logtemp, idx_logrho,
                 delta_ye, delta_logtemp, delta_logrho));
         }
         if (eosvalues & dpderho) {
-            results.push_back(tl_interpolate(dpderho_values_.get(),
+            results.push_back(tl_interpolate(dpderho_values_.data(),
                 idx_ye, idx_logtemp, idx_logrho,
                 delta_ye, delta_logtemp, delta_logrho));
         }
@@ -284,45 +287,45 @@ namespace sheneos { namespace server
         switch (eosvalue) {
         case logpress:
             {
-                double value = tl_interpolate(logpress_values_.get(),
+                double value = tl_interpolate(logpress_values_.data(),
                     idx_ye, idx_logtemp, idx_logrho,
                     delta_ye, delta_logtemp, delta_logrho);
                 return std::pow(10., value);
             }
         case logenergy:
             {
-                double value = tl_interpolate(logenergy_values_.get(),
+                double value = tl_interpolate(logenergy_values_.data(),
                     idx_ye, idx_logtemp, idx_logrho,
                     delta_ye, delta_logtemp, delta_logrho);
                 return std::pow(10., value) - energy_shift_;
             }
         case entropy:
-            return tl_interpolate(entropy_values_.get(),
+            return tl_interpolate(entropy_values_.data(),
                 idx_ye, idx_logtemp, idx_logrho,
                 delta_ye, delta_logtemp, delta_logrho);
 
         case munu:
-            return tl_interpolate(munu_values_.get(),
+            return tl_interpolate(munu_values_.data(),
                 idx_ye, idx_logtemp, idx_logrho,
                 delta_ye, delta_logtemp, delta_logrho);
 
         case cs2:
-            return tl_interpolate(cs2_values_.get(),
+            return tl_interpolate(cs2_values_.data(),
                 idx_ye, idx_logtemp, idx_logrho,
                 delta_ye, delta_logtemp, delta_logrho);
 
         case dedt:
-            return tl_interpolate(dedt_values_.get(),
+            return tl_interpolate(dedt_values_.data(),
                 idx_ye, idx_logtemp, idx_logrho,
                 delta_ye, delta_logtemp, delta_logrho);
 
         case dpdrhoe:
-            return tl_interpolate(dpdrhoe_values_.get(),
+            return tl_interpolate(dpdrhoe_values_.data(),
                 idx_ye, idx_logtemp, idx_logrho,
                 delta_ye, delta_logtemp, delta_logrho);
 
         case dpderho:
-            return tl_interpolate(dpderho_values_.get(),
+            return tl_interpolate(dpderho_values_.data(),
                 idx_ye, idx_logtemp, idx_logrho,
                 delta_ye, delta_logtemp, delta_logrho);
 
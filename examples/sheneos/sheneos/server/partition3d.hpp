@@ -7,6 +7,7 @@
 #define HPX_SHENEOS_PARTITION3D_AUG_08_2011_1220PM
 
 #include <hpx/hpx.hpp>
+#include <hpx/compute/host/replicated_vector.hpp>
 
 #include <cstddef>
 #include <cstdint>
@@ -47,14 +48,15 @@ namespace sheneos { namespace server
             char const*, std::unique_ptr<double[]>&);
 
         inline void init_data(std::string const& datafilename,
-            char const* name, std::unique_ptr<double[]>& values,
+            char const* name,
+            hpx::compute::host::replicated_vector<double>& values,
             std::size_t array_size);
 
         /// Get index of a given value in the one-dimensional array-slice.
         inline std::size_t get_index(dimension::type d, double value) const;
 
         /// Tri-linear interpolation routine.
-        inline double tl_interpolate(double* values,
+        inline double tl_interpolate(double const* values,
             std::size_t idx_x, std::size_t idx_y, std::size_t idx_z,
             double delta_ye, double delta_logtemp, double delta_logrho) const;
 
@@ -169,27 +171,28 @@ namespace sheneos { namespace server
 
         double energy_shift_;
 
-        // Dependent variables.
-        std::unique_ptr<double[]> logpress_values_;
-        std::unique_ptr<double[]> logenergy_values_;
-        std::unique_ptr<double[]> entropy_values_;
-        std::unique_ptr<double[]> munu_values_;
-        std::unique_ptr<double[]> cs2_values_;
-        std::unique_ptr<double[]> dedt_values_;
-        std::unique_ptr<double[]> dpdrhoe_values_;
-        std::unique_ptr<double[]> dpderho_values_;
+        // Dependent variables, the tables are read by all cores, keep a
+        // copy per NUMA domain.
+        hpx::compute::host::replicated_vector<double> logpress_values_;
+        hpx::compute::host::replicated_vector<double> logenergy_values_;
+        hpx::compute::host::replicated_vector<double> entropy_values_;
+        hpx::compute::host::replicated_vector<double> munu_values_;
+        hpx::compute::host::replicated_vector<double> cs2_values_;
+        hpx::compute::host::replicated_vector<double> dedt_values_;
+        hpx::compute::host::replicated_vector<double> dpdrhoe_values_;
+        hpx::compute::host::replicated_vector<double> dpderho_values_;
 #if SHENEOS_SUPPORT_FULL_API
-        std::unique_ptr<double[]> muhat_values_;
-        std::unique_ptr<double[]> mu_e_values_;
-        std::unique_ptr<double[]> mu_p_values_;
-        std::unique_ptr<double[]> mu_n_values_;
-        std::unique_ptr<double[]> xa_values_;
-        std::unique_ptr<double[]> xh_values_;
-        std::unique_ptr<double[]> xn_values_;
-        std::unique_ptr<double[]> xp_values_;
-        std::unique_ptr<double[]> abar_values_;
-        std::unique_ptr<double[]> zbar_values_;
-        std::unique_ptr<double[]> gamma_values_;
+        hpx::compute::host::replicated_vector<double> muhat_values_;
+        hpx::compute::host::replicated_vector<double> mu_e_values_;
+        hpx::compute::host::replicated_vector<double> mu_p_values_;
+        hpx::compute::host::replicated_vector<double> mu_n_values_;
+        hpx::compute::host::replicated_vector<double> xa_values_;
+        hpx::compute::host::replicated_vector<double> xh_values_;
+        hpx::compute::host::replicated_vector<double> xn_values_;
+        hpx::compute::host::replicated_vector<double> xp_values_;
+        hpx::compute::host::replicated_vector<double> abar_values_;
+        hpx::compute::host::replicated_vector<double> zbar_values_;
+        hpx::compute::host::replicated_vector<double> gamma_values_;
 #endif
     };
 }}
@@ -98,6 +98,13 @@ namespace hpx { namespace detail
                     hpx::this_thread::suspend(threads::pending, tid,
                         "async_launch_policy_dispatch<fork>");
                 }
+                else if (tid && policy == launch::work_first)
+                {
+                    // run the new thread right away, this thread is queued
+                    // such that it is resumed next (or gets stolen)
+                    hpx::this_thread::suspend(threads::pending_boost, tid,
+                        "async_launch_policy_dispatch<work_first>");
+                }
             }
             return p.get_future();
         }
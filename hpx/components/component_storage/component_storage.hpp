@@ -17,6 +17,7 @@
 #include <hpx/components/component_storage/server/component_storage.hpp>
 
 #include <cstddef>
+#include <string>
 #include <vector>
 
 namespace hpx { namespace components
@@ -30,6 +31,12 @@ namespace hpx { namespace components
 
     public:
         component_storage(hpx::id_type target_locality);
+
+        // The components are stored in a memory mapped file with the given
+        // name on the target locality. The file is removed once the storage
+        // is destroyed.
+        component_storage(hpx::id_type target_locality,
+            std::string const& filename);
         component_storage(hpx::future<naming::id_type> && f);
 
         hpx::future<naming::id_type> migrate_to_here(std::vector<char> const&,
@@ -17,8 +17,11 @@
 #include <hpx/components/containers/unordered/unordered_map.hpp>
 
 #include <hpx/components/component_storage/export_definitions.hpp>
+#include <hpx/components/component_storage/server/mapped_storage.hpp>
 
 #include <cstddef>
+#include <memory>
+#include <string>
 #include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -33,10 +36,13 @@ namespace hpx { namespace components { namespace server
     public:
         component_storage();
 
+        // store the components in a memory mapped file with the given name
+        explicit component_storage(std::string const& filename);
+
         naming::gid_type migrate_to_here(std::vector<char> const&,
             naming::id_type, naming::address const&);
         std::vector<char> migrate_from_here(naming::gid_type const&);
-        std::size_t size() const { return data_.size(); }
+        std::size_t size() const;
 
         HPX_DEFINE_COMPONENT_ACTION(component_storage, migrate_to_here);
         HPX_DEFINE_COMPONENT_ACTION(component_storage, migrate_from_here);
@@ -44,6 +50,7 @@ namespace hpx { namespace components { namespace server
 
     private:
         hpx::unordered_map<naming::gid_type, std::vector<char> > data_;
+        std::unique_ptr<mapped_storage> mapped_data_;
     };
 }}}
 
@@ -0,0 +1,74 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_COMPONENT_STORAGE_SERVER_MAPPED_STORAGE_HPP)
+#define HPX_COMPONENT_STORAGE_SERVER_MAPPED_STORAGE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/naming/name.hpp>
+
+#include <hpx/components/component_storage/export_definitions.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace components { namespace server
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Stores the serialized components in a memory mapped file instead of
+    // main memory. The operating system writes the data back to the file and
+    // evicts it from memory as needed, it is read again only once the
+    // component is migrated back out of the storage.
+    //
+    // The index mapping the ids of the stored components to their offset and
+    // size in the file is kept in memory. The space of components which were
+    // migrated back is reused. The file is removed when the storage is
+    // destroyed.
+    class HPX_MIGRATE_TO_STORAGE_EXPORT mapped_storage
+    {
+        typedef lcos::local::spinlock mutex_type;
+
+        struct record
+        {
+            std::uint64_t offset_;
+            std::uint64_t size_;
+        };
+
+    public:
+        explicit mapped_storage(std::string const& filename);
+        ~mapped_storage();
+
+        mapped_storage(mapped_storage const&) = delete;
+        mapped_storage& operator=(mapped_storage const&) = delete;
+
+        void store(naming::gid_type const& id, std::vector<char> const& data);
+        std::vector<char> retrieve(naming::gid_type const& id);
+
+        std::size_t size() const;
+
+    private:
+        std::uint64_t allocate(std::uint64_t size);
+        void deallocate(std::uint64_t offset, std::uint64_t size);
+        void grow(std::uint64_t size);
+
+        mutable mutex_type mtx_;
+        std::string filename_;
+        int fd_;
+        char* base_;
+        std::uint64_t mapped_size_;
+        std::uint64_t end_;             // end of the used part of the file
+
+        std::unordered_map<naming::gid_type, record> index_;
+        std::map<std::uint64_t, std::uint64_t> free_;   // offset -> size
+    };
+}}}
+
+#endif
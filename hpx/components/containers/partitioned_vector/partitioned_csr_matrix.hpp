@@ -0,0 +1,309 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file hpx/components/partitioned_vector/partitioned_csr_matrix.hpp
+
+#ifndef HPX_PARTITIONED_CSR_MATRIX_HPP
+#define HPX_PARTITIONED_CSR_MATRIX_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/lcos/when_all.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/traits/is_distribution_policy.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <hpx/components/containers/container_distribution_policy.hpp>
+#include <hpx/components/containers/partitioned_vector/partitioned_csr_matrix_component.hpp>
+#include <hpx/components/containers/partitioned_vector/partitioned_vector_decl.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx
+{
+    /// This class implements a distributed sparse matrix stored in
+    /// compressed sparse row (CSR) format.
+    ///
+    /// The rows are distributed over the partitions exactly like the
+    /// elements of a \a hpx::partitioned_vector of \a num_rows elements
+    /// created with the same distribution policy, each partition holds a
+    /// block of consecutive rows. The row pointers, the column indices and
+    /// the values of a block are kept together in one component on one
+    /// locality.
+    ///
+    /// The product with a \a hpx::partitioned_vector is computed by each of
+    /// the partitions on its own locality: the entries of the vector
+    /// referenced by the block are gathered from the partitions of the
+    /// vector on the same locality directly and with one request per
+    /// partition from all others. The entries to gather are computed once
+    /// and are reused as long as the matrix is multiplied with the same
+    /// vector. If the vectors were created with the same distribution
+    /// policy as the matrix, the results are written directly into their
+    /// partitions and only the halo of the vector is communicated.
+    ///
+    /// The element type has to be registered using
+    /// HPX_REGISTER_PARTITIONED_CSR_MATRIX(T), the vectors using
+    /// HPX_REGISTER_PARTITIONED_VECTOR(T).
+    ///
+    /// \tparam T   The type of the elements of the matrix.
+    ///
+    template <typename T>
+    class partitioned_csr_matrix
+    {
+    public:
+        typedef std::size_t size_type;
+        typedef T value_type;
+
+    private:
+        typedef server::partitioned_csr_matrix<T> partition_server;
+        typedef typename partition_server::vector_partition vector_partition;
+
+        struct partition_data
+        {
+            hpx::id_type partition_;
+            size_type row_begin_;
+            size_type num_rows_;
+            std::uint32_t locality_id_;
+        };
+
+    public:
+        partitioned_csr_matrix()
+          : num_rows_(0), num_cols_(0), nnz_(0)
+        {}
+
+        /// Create the matrix from the given matrix in compressed sparse row
+        /// format, the rows are distributed using the default distribution
+        /// policy.
+        ///
+        /// \param num_rows     The number of rows of the matrix.
+        /// \param num_cols     The number of columns of the matrix.
+        /// \param row_ptr      The index of the first non-zero of each row
+        ///                     in col_idx and values, followed by the number
+        ///                     of non-zeros (num_rows + 1 elements).
+        /// \param col_idx      The column of each of the non-zeros.
+        /// \param values       The value of each of the non-zeros.
+        ///
+        partitioned_csr_matrix(size_type num_rows, size_type num_cols,
+                std::vector<size_type> const& row_ptr,
+                std::vector<size_type> const& col_idx,
+                std::vector<T> const& values)
+          : num_rows_(num_rows), num_cols_(num_cols), nnz_(0)
+        {
+            create(row_ptr, col_idx, values, hpx::container_layout);
+        }
+
+        /// Create the matrix from the given matrix in compressed sparse row
+        /// format, the rows are distributed using the given distribution
+        /// policy.
+        template <typename DistPolicy>
+        partitioned_csr_matrix(size_type num_rows, size_type num_cols,
+                std::vector<size_type> const& row_ptr,
+                std::vector<size_type> const& col_idx,
+                std::vector<T> const& values, DistPolicy const& policy,
+                typename std::enable_if<
+                    traits::is_distribution_policy<DistPolicy>::value
+                >::type* = nullptr)
+          : num_rows_(num_rows), num_cols_(num_cols), nnz_(0)
+        {
+            create(row_ptr, col_idx, values, policy);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        size_type num_rows() const
+        {
+            return num_rows_;
+        }
+
+        size_type num_cols() const
+        {
+            return num_cols_;
+        }
+
+        /// Return the number of non-zeros of the matrix.
+        size_type nnz() const
+        {
+            return nnz_;
+        }
+
+        size_type num_partitions() const
+        {
+            return partitions_.size();
+        }
+
+        /// Return the global index of the first row of the given partition.
+        size_type get_row_begin(size_type part) const
+        {
+            HPX_ASSERT(part < partitions_.size());
+            return partitions_[part].row_begin_;
+        }
+
+        /// Return the number of rows of the given partition.
+        size_type get_num_rows(size_type part) const
+        {
+            HPX_ASSERT(part < partitions_.size());
+            return partitions_[part].num_rows_;
+        }
+
+        /// Return the id of the component holding the given partition.
+        hpx::id_type const& get_partition_id(size_type part) const
+        {
+            HPX_ASSERT(part < partitions_.size());
+            return partitions_[part].partition_;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Compute y = A * x, the size of x has to be the number of columns,
+        /// the size of y the number of rows of the matrix.
+        ///
+        /// \returns A future which becomes ready once all elements of y have
+        ///          been written.
+        ///
+        hpx::future<void> spmv(partitioned_vector<T> const& x,
+            partitioned_vector<T>& y) const
+        {
+            if (x.size() != num_cols_ || y.size() != num_rows_)
+            {
+                return hpx::make_exceptional_future<void>(
+                    HPX_GET_EXCEPTION(bad_parameter,
+                        "hpx::partitioned_csr_matrix::spmv",
+                        "the sizes of the vectors do not match the size of "
+                        "the matrix"));
+            }
+
+            std::vector<vector_partition> x_parts = get_vector_partitions(x);
+            std::vector<vector_partition> y_parts = get_vector_partitions(y);
+
+            typedef typename partition_server::spmv_action action_type;
+
+            std::vector<hpx::future<void> > futures;
+            futures.reserve(partitions_.size());
+            for (partition_data const& part : partitions_)
+            {
+                futures.push_back(hpx::async(action_type(), part.partition_,
+                    x_parts, y_parts));
+            }
+
+            return hpx::when_all(futures).then(hpx::launch::sync,
+                [](hpx::future<std::vector<hpx::future<void> > > f)
+                {
+                    for (hpx::future<void>& r : f.get())
+                        r.get();
+                });
+        }
+
+        void spmv(launch::sync_policy, partitioned_vector<T> const& x,
+            partitioned_vector<T>& y) const
+        {
+            spmv(x, y).get();
+        }
+
+    private:
+        template <typename DistPolicy>
+        void create(std::vector<size_type> const& row_ptr,
+            std::vector<size_type> const& col_idx,
+            std::vector<T> const& values, DistPolicy const& policy)
+        {
+            if (row_ptr.size() != num_rows_ + 1 || row_ptr.front() != 0 ||
+                row_ptr.back() != col_idx.size() ||
+                col_idx.size() != values.size())
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "hpx::partitioned_csr_matrix::create",
+                    "inconsistent compressed sparse row data");
+            }
+
+            nnz_ = values.size();
+
+            // the same partitioning as used by hpx::partitioned_vector
+            std::size_t num_parts =
+                traits::num_container_partitions<DistPolicy>::call(policy);
+            std::size_t part_size = (num_rows_ + num_parts - 1) / num_parts;
+
+            typedef std::pair<hpx::id_type, std::vector<hpx::id_type> >
+                bulk_locality_result;
+
+            std::vector<bulk_locality_result> created =
+                policy.template bulk_create<partition_server>(num_parts).get();
+
+            typedef typename partition_server::set_data_action action_type;
+
+            std::vector<hpx::future<void> > futures;
+            futures.reserve(num_parts);
+
+            partitions_.reserve(num_parts);
+            size_type row_begin = 0;
+            for (bulk_locality_result const& r : created)
+            {
+                std::uint32_t locality =
+                    naming::get_locality_id_from_id(r.first);
+                for (hpx::id_type const& id : r.second)
+                {
+                    if (partitions_.size() == num_parts)
+                        break;
+
+                    size_type rows = (std::min)(part_size, num_rows_ - row_begin);
+                    partition_data part = { id, row_begin, rows, locality };
+                    partitions_.push_back(part);
+
+                    // the non-zeros of the rows of this partition
+                    size_type first = row_ptr[row_begin];
+                    size_type last = row_ptr[row_begin + rows];
+
+                    std::vector<size_type> block_ptr(rows + 1);
+                    for (size_type i = 0; i != rows + 1; ++i)
+                        block_ptr[i] = row_ptr[row_begin + i] - first;
+
+                    futures.push_back(hpx::async(action_type(), id, row_begin,
+                        std::move(block_ptr),
+                        std::vector<size_type>(
+                            col_idx.begin() + first, col_idx.begin() + last),
+                        std::vector<T>(
+                            values.begin() + first, values.begin() + last)));
+
+                    row_begin += rows;
+                }
+            }
+            HPX_ASSERT(partitions_.size() == num_parts);
+            HPX_ASSERT(row_begin == num_rows_);
+
+            hpx::wait_all(futures);
+            for (hpx::future<void>& f : futures)
+                f.get();
+        }
+
+        // Return the descriptions of the partitions of the given vector.
+        static std::vector<vector_partition> get_vector_partitions(
+            partitioned_vector<T> const& v)
+        {
+            std::vector<vector_partition> parts;
+
+            auto end = v.segment_cend();
+            for (auto it = v.segment_cbegin(); it != end; ++it)
+            {
+                auto const& part = *it.base();
+                parts.push_back(vector_partition(
+                    part.partition_, part.size_, part.locality_id_));
+            }
+            return parts;
+        }
+
+    private:
+        size_type num_rows_;
+        size_type num_cols_;
+        size_type nnz_;
+        std::vector<partition_data> partitions_;
+    };
+}
+
+#endif
@@ -0,0 +1,423 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file hpx/components/partitioned_vector/partitioned_csr_matrix_component.hpp
+
+#ifndef HPX_PARTITIONED_CSR_MATRIX_COMPONENT_HPP
+#define HPX_PARTITIONED_CSR_MATRIX_COMPONENT_HPP
+
+/// \cond NOINTERNAL
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/parallel/algorithms/for_loop.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/runtime/actions/component_action.hpp>
+#include <hpx/runtime/components/server/simple_component_base.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/get_ptr.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/detail/pp/cat.hpp>
+#include <hpx/util/detail/pp/expand.hpp>
+#include <hpx/util/detail/pp/nargs.hpp>
+
+#include <hpx/components/containers/partitioned_vector/partitioned_vector_component_decl.hpp>
+#include <hpx/components/containers/partitioned_vector/partitioned_vector_decl.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace server
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // One partition of a hpx::partitioned_csr_matrix: a block of consecutive
+    // rows stored in compressed sparse row format. The row pointers, the
+    // column indices and the values of the block are kept together in this
+    // component, which places them on the same locality.
+    template <typename T>
+    class partitioned_csr_matrix
+      : public components::simple_component_base<partitioned_csr_matrix<T> >
+    {
+        typedef lcos::local::spinlock mutex_type;
+
+        typedef hpx::server::partitioned_vector<T, std::vector<T> >
+            vector_partition_server;
+
+    public:
+        typedef partitioned_vector_config_data::partition_data
+            vector_partition;
+
+    private:
+        // Describes which entries of the vector multiplied with this block
+        // are needed and where they are located. The referenced columns are
+        // gathered into a contiguous buffer, the column indices of the
+        // non-zeros are translated to positions in that buffer.
+        struct gather_plan
+        {
+            // the partitions of the vector this plan was created for
+            std::vector<hpx::id_type> ids_;
+
+            // the referenced partitions of the vector, the local indices of
+            // the referenced elements in each of them, and the position of
+            // the first of them in the buffer
+            std::vector<std::size_t> parts_;
+            std::vector<std::vector<std::size_t> > indices_;
+            std::vector<std::size_t> offsets_;
+
+            // the position in the buffer for each of the non-zeros
+            std::vector<std::size_t> columns_;
+            std::size_t size_;
+        };
+
+    public:
+        partitioned_csr_matrix()
+          : row_begin_(0)
+        {}
+
+        ///////////////////////////////////////////////////////////////////////
+        // Set the rows of this block, the row pointers are relative to the
+        // beginning of the given column indices and values.
+        void set_data(std::size_t row_begin, std::vector<std::size_t> row_ptr,
+            std::vector<std::size_t> col_idx, std::vector<T> values)
+        {
+            if (row_ptr.empty() || row_ptr.front() != 0 ||
+                row_ptr.back() != col_idx.size() ||
+                col_idx.size() != values.size())
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "hpx::server::partitioned_csr_matrix::set_data",
+                    "inconsistent compressed sparse row data");
+            }
+
+            std::lock_guard<mutex_type> l(mtx_);
+
+            row_begin_ = row_begin;
+            row_ptr_ = std::move(row_ptr);
+            col_idx_ = std::move(col_idx);
+            values_ = std::move(values);
+            plan_.reset();
+        }
+        HPX_DEFINE_COMPONENT_ACTION(partitioned_csr_matrix, set_data);
+
+        // Return the number of non-zeros in this block.
+        std::size_t nnz() const
+        {
+            return values_.size();
+        }
+        HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_csr_matrix, nnz);
+
+        std::size_t get_row_begin() const
+        {
+            return row_begin_;
+        }
+
+        std::size_t get_num_rows() const
+        {
+            return row_ptr_.empty() ? 0 : row_ptr_.size() - 1;
+        }
+
+        std::vector<std::size_t> const& get_row_ptr() const
+        {
+            return row_ptr_;
+        }
+        std::vector<std::size_t> const& get_col_idx() const
+        {
+            return col_idx_;
+        }
+        std::vector<T> const& get_values() const
+        {
+            return values_;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Compute the rows of y = A * x for this block. The entries of x
+        // referenced by this block are gathered first: directly from the
+        // partitions on this locality, with one request per partition from
+        // all others. The results are written directly into the partitions
+        // of y on this locality.
+        void spmv(std::vector<vector_partition> const& x,
+            std::vector<vector_partition> const& y)
+        {
+            std::shared_ptr<gather_plan> plan = get_plan(x);
+            std::vector<T> buffer(plan->size_);
+
+            // request the remote entries first, to overlap their transfer
+            // with gathering the local ones
+            std::vector<hpx::future<void> > remote;
+            std::uint32_t here = hpx::get_locality_id();
+            for (std::size_t i = 0; i != plan->parts_.size(); ++i)
+            {
+                vector_partition const& part = x[plan->parts_[i]];
+                if (part.locality_id_ == here)
+                    continue;
+
+                typedef typename vector_partition_server::get_values_action
+                    action_type;
+
+                T* dest = buffer.data() + plan->offsets_[i];
+                remote.push_back(hpx::async(action_type(), part.partition_,
+                        plan->indices_[i]
+                    ).then(hpx::launch::sync,
+                        [dest](hpx::future<std::vector<T> > f)
+                        {
+                            std::vector<T> values = f.get();
+                            std::copy(values.begin(), values.end(), dest);
+                        }));
+            }
+
+            for (std::size_t i = 0; i != plan->parts_.size(); ++i)
+            {
+                vector_partition const& part = x[plan->parts_[i]];
+                if (part.locality_id_ != here)
+                    continue;
+
+                std::shared_ptr<vector_partition_server> p =
+                    hpx::get_ptr<vector_partition_server>(
+                        launch::sync, part.partition_);
+
+                std::vector<T> const& data = p->get_data();
+                T* dest = buffer.data() + plan->offsets_[i];
+                for (std::size_t index : plan->indices_[i])
+                    *dest++ = data[index];
+            }
+
+            hpx::wait_all(remote);
+            for (hpx::future<void>& f : remote)
+                f.get();
+
+            // multiply the local rows
+            std::size_t num_rows = get_num_rows();
+            std::vector<T> result(num_rows);
+
+            std::vector<std::size_t> const& columns = plan->columns_;
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), num_rows,
+                [&](std::size_t row)
+                {
+                    T sum = T();
+                    for (std::size_t k = row_ptr_[row]; k != row_ptr_[row + 1];
+                         ++k)
+                    {
+                        sum += values_[k] * buffer[columns[k]];
+                    }
+                    result[row] = sum;
+                });
+
+            scatter(y, result);
+        }
+        HPX_DEFINE_COMPONENT_ACTION(partitioned_csr_matrix, spmv);
+
+    private:
+        // Return the gather plan for the given partitions of x, the plan is
+        // created once and reused as long as x does not change.
+        std::shared_ptr<gather_plan> get_plan(
+            std::vector<vector_partition> const& x)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+
+            if (plan_ && plan_->ids_.size() == x.size() &&
+                std::equal(x.begin(), x.end(), plan_->ids_.begin(),
+                    [](vector_partition const& part, hpx::id_type const& id)
+                    {
+                        return part.partition_ == id;
+                    }))
+            {
+                return plan_;
+            }
+
+            std::shared_ptr<gather_plan> plan = std::make_shared<gather_plan>();
+
+            std::vector<std::size_t> bases;
+            bases.reserve(x.size() + 1);
+            bases.push_back(0);
+            plan->ids_.reserve(x.size());
+            for (vector_partition const& part : x)
+            {
+                bases.push_back(bases.back() + part.size_);
+                plan->ids_.push_back(part.partition_);
+            }
+
+            // the referenced columns, sorted by partition
+            std::vector<std::size_t> referenced(col_idx_);
+            std::sort(referenced.begin(), referenced.end());
+            referenced.erase(
+                std::unique(referenced.begin(), referenced.end()),
+                referenced.end());
+
+            if (!referenced.empty() && referenced.back() >= bases.back())
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "hpx::server::partitioned_csr_matrix::spmv",
+                    "the size of the vector does not match the number of "
+                    "columns of the matrix");
+            }
+
+            std::size_t part = 0;
+            for (std::size_t i = 0; i != referenced.size(); ++i)
+            {
+                std::size_t column = referenced[i];
+                if (plan->parts_.empty() || column >= bases[part + 1])
+                {
+                    part = std::distance(bases.begin(),
+                        std::upper_bound(bases.begin(), bases.end(), column))
+                            - 1;
+
+                    plan->parts_.push_back(part);
+                    plan->indices_.emplace_back();
+                    plan->offsets_.push_back(i);
+                }
+                plan->indices_.back().push_back(column - bases[part]);
+            }
+
+            plan->columns_.reserve(col_idx_.size());
+            for (std::size_t column : col_idx_)
+            {
+                plan->columns_.push_back(std::distance(referenced.begin(),
+                    std::lower_bound(
+                        referenced.begin(), referenced.end(), column)));
+            }
+            plan->size_ = referenced.size();
+
+            plan_ = plan;
+            return plan;
+        }
+
+        // Write the rows of this block into the partitions of y covering
+        // them.
+        void scatter(std::vector<vector_partition> const& y,
+            std::vector<T> const& result)
+        {
+            std::size_t row_end = row_begin_ + result.size();
+            std::uint32_t here = hpx::get_locality_id();
+
+            std::vector<hpx::future<void> > remote;
+            std::size_t base = 0;
+            for (vector_partition const& part : y)
+            {
+                std::size_t first = (std::max)(base, row_begin_);
+                std::size_t last = (std::min)(base + part.size_, row_end);
+                if (first < last)
+                {
+                    auto begin = result.begin() + (first - row_begin_);
+                    auto end = result.begin() + (last - row_begin_);
+
+                    if (part.locality_id_ == here)
+                    {
+                        std::shared_ptr<vector_partition_server> p =
+                            hpx::get_ptr<vector_partition_server>(
+                                launch::sync, part.partition_);
+                        std::copy(begin, end,
+                            p->get_data().begin() + (first - base));
+                    }
+                    else
+                    {
+                        typedef typename
+                            vector_partition_server::set_values_action
+                            action_type;
+
+                        std::vector<std::size_t> indices(last - first);
+                        for (std::size_t i = 0; i != indices.size(); ++i)
+                            indices[i] = first - base + i;
+
+                        remote.push_back(hpx::async(action_type(),
+                            part.partition_, std::move(indices),
+                            std::vector<T>(begin, end)));
+                    }
+                }
+                base += part.size_;
+            }
+
+            if (base < row_end)
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "hpx::server::partitioned_csr_matrix::spmv",
+                    "the size of the result vector does not match the "
+                    "number of rows of the matrix");
+            }
+
+            hpx::wait_all(remote);
+            for (hpx::future<void>& f : remote)
+                f.get();
+        }
+
+    private:
+        mutex_type mtx_;
+
+        std::size_t row_begin_;             // the global index of the first row
+        std::vector<std::size_t> row_ptr_;
+        std::vector<std::size_t> col_idx_;  // global column indices
+        std::vector<T> values_;
+
+        std::shared_ptr<gather_plan> plan_;
+    };
+}}
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_REGISTER_PARTITIONED_CSR_MATRIX_DECLARATION(...)                  \
+    HPX_REGISTER_PARTITIONED_CSR_MATRIX_DECLARATION_(__VA_ARGS__)             \
+/**/
+#define HPX_REGISTER_PARTITIONED_CSR_MATRIX_DECLARATION_(...)                 \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_PARTITIONED_CSR_MATRIX_DECLARATION_,                     \
+            HPX_PP_NARGS(__VA_ARGS__)                                         \
+    )(__VA_ARGS__))                                                           \
+/**/
+
+#define HPX_REGISTER_PARTITIONED_CSR_MATRIX_DECLARATION_1(type)               \
+    HPX_REGISTER_PARTITIONED_CSR_MATRIX_DECLARATION_2(type, type)             \
+/**/
+#define HPX_REGISTER_PARTITIONED_CSR_MATRIX_DECLARATION_2(type, name)         \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::server::partitioned_csr_matrix< type>::set_data_action,          \
+        HPX_PP_CAT(__csr_matrix_set_data_action_, name));                     \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::server::partitioned_csr_matrix< type>::nnz_action,               \
+        HPX_PP_CAT(__csr_matrix_nnz_action_, name));                          \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::server::partitioned_csr_matrix< type>::spmv_action,              \
+        HPX_PP_CAT(__csr_matrix_spmv_action_, name))                          \
+/**/
+
+#define HPX_REGISTER_PARTITIONED_CSR_MATRIX(...)                              \
+    HPX_REGISTER_PARTITIONED_CSR_MATRIX_(__VA_ARGS__)                         \
+/**/
+#define HPX_REGISTER_PARTITIONED_CSR_MATRIX_(...)                             \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_PARTITIONED_CSR_MATRIX_, HPX_PP_NARGS(__VA_ARGS__)       \
+    )(__VA_ARGS__))                                                           \
+/**/
+
+#define HPX_REGISTER_PARTITIONED_CSR_MATRIX_1(type)                           \
+    HPX_REGISTER_PARTITIONED_CSR_MATRIX_2(type, type)                         \
+/**/
+#define HPX_REGISTER_PARTITIONED_CSR_MATRIX_2(type, name)                     \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::server::partitioned_csr_matrix< type>::set_data_action,          \
+        HPX_PP_CAT(__csr_matrix_set_data_action_, name));                     \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::server::partitioned_csr_matrix< type>::nnz_action,               \
+        HPX_PP_CAT(__csr_matrix_nnz_action_, name));                          \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::server::partitioned_csr_matrix< type>::spmv_action,              \
+        HPX_PP_CAT(__csr_matrix_spmv_action_, name));                         \
+    typedef ::hpx::components::simple_component<                              \
+        ::hpx::server::partitioned_csr_matrix< type>                          \
+    > HPX_PP_CAT(__partitioned_csr_matrix_, name);                            \
+    HPX_REGISTER_COMPONENT(HPX_PP_CAT(__partitioned_csr_matrix_, name))       \
+/**/
+
+/// \endcond
+
+#endif
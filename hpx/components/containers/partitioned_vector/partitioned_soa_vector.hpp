@@ -0,0 +1,368 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file hpx/components/containers/partitioned_vector/partitioned_soa_vector.hpp
+
+#if !defined(HPX_PARTITIONED_SOA_VECTOR_HPP)
+#define HPX_PARTITIONED_SOA_VECTOR_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/compute/soa_vector.hpp>
+#include <hpx/lcos/dataflow.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/when_all.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/traits/is_distribution_policy.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/detail/pack.hpp>
+#include <hpx/util/detail/pp/cat.hpp>
+#include <hpx/util/iterator_range.hpp>
+#include <hpx/util/tuple.hpp>
+#include <hpx/util/zip_iterator.hpp>
+
+#include <hpx/components/containers/partitioned_vector/partitioned_vector.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx
+{
+    /// The partitioned_vector holding one field of a partitioned_soa_vector.
+    /// Its partitions are aligned and padded like the fields of a
+    /// compute::soa_vector.
+    template <typename T>
+    using partitioned_soa_vector_field =
+        partitioned_vector<T, compute::soa_field_data<T> >;
+
+    template <typename ... Ts>
+    class partitioned_soa_vector;
+
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        template <typename ... Ts>
+        struct partitioned_soa_vector_value_proxy
+        {
+            partitioned_soa_vector_value_proxy(
+                    partitioned_soa_vector<Ts...>& v, std::size_t index)
+              : v_(v), index_(index)
+            {}
+
+            operator hpx::util::tuple<Ts...>() const
+            {
+                return v_.get_value(launch::sync, index_);
+            }
+
+            partitioned_soa_vector_value_proxy& operator=(
+                hpx::util::tuple<Ts...> const& value)
+            {
+                v_.set_value(launch::sync, index_, value);
+                return *this;
+            }
+
+            partitioned_soa_vector<Ts...>& v_;
+            std::size_t index_;
+        };
+
+        template <typename ... Ts>
+        struct make_partitioned_soa_vector_value
+        {
+            hpx::util::tuple<Ts...> operator()(future<Ts>... values) const
+            {
+                return hpx::util::tuple<Ts...>(values.get()...);
+            }
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A partitioned sequence of tuples stored as a structure of arrays. Each
+    /// field of the tuples is held by a partitioned_vector of its own, all of
+    /// them created with the same size and distribution policy, so that the
+    /// n-th partition of every field lives on the same locality and covers
+    /// the same range of elements.
+    ///
+    /// Elements are accessed through proxy references (as for
+    /// partitioned_vector). Local computations use \a local_segments, which
+    /// zips the partitions of all fields on this locality into ranges of
+    /// pointers into aligned storage, suitable for the algorithms running
+    /// under execution::datapar.
+    ///
+    /// Every field type has to be registered once by
+    /// HPX_REGISTER_PARTITIONED_SOA_VECTOR_FIELD(type) (and declared by
+    /// HPX_REGISTER_PARTITIONED_SOA_VECTOR_FIELD_DECLARATION(type) where
+    /// needed), as for partitioned_vector.
+    template <typename ... Ts>
+    class partitioned_soa_vector
+    {
+        static_assert(sizeof...(Ts) != 0,
+            "partitioned_soa_vector must have at least one field");
+
+        typedef typename hpx::util::detail::make_index_pack<
+                sizeof...(Ts)
+            >::type index_pack_type;
+
+    public:
+        typedef hpx::util::tuple<Ts...> value_type;
+        typedef std::size_t size_type;
+        typedef detail::partitioned_soa_vector_value_proxy<Ts...> reference;
+
+        typedef hpx::util::zip_iterator<Ts*...> local_iterator;
+        typedef hpx::util::iterator_range<local_iterator> local_segment_type;
+
+        template <std::size_t I>
+        using field_type = partitioned_soa_vector_field<
+            typename hpx::util::tuple_element<I, value_type>::type>;
+
+        partitioned_soa_vector() = default;
+
+        /// Create the container with the given overall \a size.
+        explicit partitioned_soa_vector(size_type size)
+          : fields_(partitioned_soa_vector_field<Ts>(size)...)
+        {}
+
+        /// Create the container with the given overall \a size, all
+        /// elements are initialized with \a val.
+        partitioned_soa_vector(size_type size, value_type const& val)
+          : partitioned_soa_vector(size, val, index_pack_type())
+        {}
+
+        /// Create the container with the given overall \a size using the
+        /// given distribution policy.
+        template <typename DistPolicy>
+        partitioned_soa_vector(size_type size, DistPolicy const& policy,
+                typename std::enable_if<
+                    traits::is_distribution_policy<DistPolicy>::value
+                >::type* = nullptr)
+          : fields_(partitioned_soa_vector_field<Ts>(size, policy)...)
+        {}
+
+        /// Create the container with the given overall \a size using the
+        /// given distribution policy, all elements are initialized with
+        /// \a val.
+        template <typename DistPolicy>
+        partitioned_soa_vector(size_type size, value_type const& val,
+                DistPolicy const& policy,
+                typename std::enable_if<
+                    traits::is_distribution_policy<DistPolicy>::value
+                >::type* = nullptr)
+          : partitioned_soa_vector(size, val, policy, index_pack_type())
+        {}
+
+        ///////////////////////////////////////////////////////////////////////
+        size_type size() const
+        {
+            return hpx::util::get<0>(fields_).size();
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        /// The partitioned_vector holding the field \a I of all elements
+        template <std::size_t I>
+        field_type<I>& field()
+        {
+            return hpx::util::get<I>(fields_);
+        }
+
+        template <std::size_t I>
+        field_type<I> const& field() const
+        {
+            return hpx::util::get<I>(fields_);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        reference operator[](size_type pos)
+        {
+            return reference(*this, pos);
+        }
+
+        value_type operator[](size_type pos) const
+        {
+            return get_value(launch::sync, pos);
+        }
+
+        /// Return the element at position \a pos.
+        value_type get_value(launch::sync_policy, size_type pos) const
+        {
+            return get_value(pos).get();
+        }
+
+        /// Asynchronously return the element at position \a pos, the fields
+        /// are retrieved concurrently.
+        future<value_type> get_value(size_type pos) const
+        {
+            return get_value(pos, index_pack_type());
+        }
+
+        /// Store \a val at position \a pos.
+        void set_value(launch::sync_policy, size_type pos,
+            value_type const& val)
+        {
+            set_value(pos, val).get();
+        }
+
+        /// Asynchronously store \a val at position \a pos, the fields are
+        /// stored concurrently.
+        future<void> set_value(size_type pos, value_type const& val)
+        {
+            return set_value(pos, val, index_pack_type());
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Register the fields under \a symbolic_name followed by the index
+        /// of the field.
+        future<void> register_as(std::string const& symbolic_name)
+        {
+            return register_as(symbolic_name, index_pack_type());
+        }
+
+        void register_as(launch::sync_policy,
+            std::string const& symbolic_name)
+        {
+            register_as(symbolic_name).get();
+        }
+
+        /// Connect to the fields registered by \a register_as
+        future<void> connect_to(std::string const& symbolic_name)
+        {
+            return connect_to(symbolic_name, index_pack_type());
+        }
+
+        void connect_to(launch::sync_policy,
+            std::string const& symbolic_name)
+        {
+            connect_to(symbolic_name).get();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Return the partitions of this container which are located on
+        /// this locality. Each segment zips the data of one partition of all
+        /// fields, the underlying iterators are plain pointers.
+        std::vector<local_segment_type> local_segments()
+        {
+            return local_segments(index_pack_type());
+        }
+
+    private:
+        template <std::size_t ... Is>
+        partitioned_soa_vector(size_type size, value_type const& val,
+                hpx::util::detail::pack_c<std::size_t, Is...>)
+          : fields_(partitioned_soa_vector_field<Ts>(
+                size, hpx::util::get<Is>(val))...)
+        {}
+
+        template <typename DistPolicy, std::size_t ... Is>
+        partitioned_soa_vector(size_type size, value_type const& val,
+                DistPolicy const& policy,
+                hpx::util::detail::pack_c<std::size_t, Is...>)
+          : fields_(partitioned_soa_vector_field<Ts>(
+                size, hpx::util::get<Is>(val), policy)...)
+        {}
+
+        template <std::size_t ... Is>
+        future<value_type> get_value(size_type pos,
+            hpx::util::detail::pack_c<std::size_t, Is...>) const
+        {
+            return hpx::dataflow(launch::sync,
+                detail::make_partitioned_soa_vector_value<Ts...>(),
+                hpx::util::get<Is>(fields_).get_value(pos)...);
+        }
+
+        template <std::size_t ... Is>
+        future<void> set_value(size_type pos, value_type const& val,
+            hpx::util::detail::pack_c<std::size_t, Is...>)
+        {
+            return hpx::when_all(hpx::util::get<Is>(fields_).set_value(
+                pos, hpx::util::get<Is>(val))...);
+        }
+
+        template <std::size_t ... Is>
+        future<void> register_as(std::string const& symbolic_name,
+            hpx::util::detail::pack_c<std::size_t, Is...>)
+        {
+            return hpx::when_all(hpx::util::get<Is>(fields_).register_as(
+                symbolic_name + "/" + std::to_string(Is))...);
+        }
+
+        template <std::size_t ... Is>
+        future<void> connect_to(std::string const& symbolic_name,
+            hpx::util::detail::pack_c<std::size_t, Is...>)
+        {
+            return hpx::when_all(hpx::util::get<Is>(fields_).connect_to(
+                symbolic_name + "/" + std::to_string(Is))...);
+        }
+
+        template <std::size_t ... Is>
+        std::vector<local_segment_type> local_segments(
+            hpx::util::detail::pack_c<std::size_t, Is...>)
+        {
+            std::uint32_t const here = hpx::get_locality_id();
+
+            // all fields are partitioned alike, their local partitions are
+            // visited in lockstep
+            auto segments = hpx::util::make_tuple(
+                hpx::util::get<Is>(fields_).segment_begin(here)...);
+            auto const end = hpx::util::get<0>(fields_).segment_end(here);
+
+            std::vector<local_segment_type> result;
+            while (hpx::util::get<0>(segments) != end)
+            {
+                std::size_t const size = hpx::util::get<0>(segments)->size();
+
+                bool const sizes_match[] = {
+                    true, hpx::util::get<Is>(segments)->size() == size ...
+                };
+                (void) sizes_match;
+                HPX_ASSERT(std::all_of(sizes_match,
+                    sizes_match + sizeof...(Is) + 1, [](bool b) { return b; }));
+
+                result.emplace_back(
+                    local_iterator(hpx::util::get<Is>(segments)->data()...),
+                    local_iterator(
+                        hpx::util::get<Is>(segments)->data() + size...));
+
+                int const sequencer[] = {
+                    0, (++hpx::util::get<Is>(segments), 0) ...
+                };
+                (void) sequencer;
+            }
+            return result;
+        }
+
+        hpx::util::tuple<partitioned_soa_vector_field<Ts>...> fields_;
+    };
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Register the partitioned_vector holding the fields of the given type of a
+/// partitioned_soa_vector. This has to be placed into exactly one source file
+/// of the application.
+#define HPX_REGISTER_PARTITIONED_SOA_VECTOR_FIELD(type)                       \
+    typedef ::hpx::compute::soa_field_data<type>                              \
+        HPX_PP_CAT(__partitioned_soa_vector_data_, type);                     \
+    HPX_REGISTER_PARTITIONED_VECTOR(type,                                     \
+        HPX_PP_CAT(__partitioned_soa_vector_data_, type),                     \
+        HPX_PP_CAT(soa_field_, type))                                         \
+/**/
+
+/// Declare the partitioned_vector holding the fields of the given type of a
+/// partitioned_soa_vector.
+#define HPX_REGISTER_PARTITIONED_SOA_VECTOR_FIELD_DECLARATION(type)           \
+    typedef ::hpx::compute::soa_field_data<type>                              \
+        HPX_PP_CAT(__partitioned_soa_vector_data_, type);                     \
+    HPX_REGISTER_PARTITIONED_VECTOR_DECLARATION(type,                         \
+        HPX_PP_CAT(__partitioned_soa_vector_data_, type),                     \
+        HPX_PP_CAT(soa_field_, type))                                         \
+/**/
+
+#endif
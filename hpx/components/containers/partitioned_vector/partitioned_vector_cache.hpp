@@ -0,0 +1,321 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file hpx/components/partitioned_vector/partitioned_vector_cache.hpp
+
+#ifndef HPX_PARTITIONED_VECTOR_CACHE_HPP
+#define HPX_PARTITIONED_VECTOR_CACHE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/when_all.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <hpx/components/containers/partitioned_vector/partitioned_vector_decl.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace hpx
+{
+    /// This class implements an opt-in software cache for the elements of a
+    /// \a hpx::partitioned_vector stored on other localities.
+    ///
+    /// Reading an element of a remote partition fetches the whole block of
+    /// \a block_size consecutive elements containing it with a single
+    /// request, the following reads of elements of the same block are served
+    /// locally. Writes to remote partitions are collected in a
+    /// write-combining buffer and are sent to each of the partitions as one
+    /// request once \a flush or \a fence is called (or once the buffer of a
+    /// partition holds \a max_pending_writes elements). The elements of
+    /// local partitions are accessed directly.
+    ///
+    /// The cache is not coherent with other accesses to the vector: writes
+    /// performed by others become visible only after \a invalidate (or
+    /// \a fence) was called, writes performed through the cache become
+    /// visible to others only after the completion of \a flush (or
+    /// \a fence). Reads through the cache always see the writes performed
+    /// through the same cache. The usual pattern is to call \a fence at the
+    /// points where the application synchronizes anyways, such as barriers.
+    ///
+    /// A cache object is not thread-safe, each thread (or HPX thread)
+    /// accessing the vector has to use its own cache.
+    ///
+    /// \tparam T   The type of the elements of the vector.
+    /// \tparam Data The type of the data of the partitions.
+    ///
+    template <typename T, typename Data>
+    class partitioned_vector_cache
+    {
+    public:
+        typedef typename partitioned_vector<T, Data>::size_type size_type;
+        typedef T value_type;
+
+        /// Create a cache for the given vector.
+        ///
+        /// \param v            The vector to cache the remote elements of.
+        ///                     It has to outlive the cache.
+        /// \param block_size   The number of consecutive elements fetched
+        ///                     with a single request (default: a 4K page).
+        /// \param max_blocks   The maximal number of blocks held in the
+        ///                     cache, the oldest blocks are evicted first.
+        /// \param max_pending_writes The maximal number of buffered writes
+        ///                     for each of the partitions.
+        ///
+        explicit partitioned_vector_cache(partitioned_vector<T, Data>& v,
+                size_type block_size = default_block_size(),
+                size_type max_blocks = 256,
+                size_type max_pending_writes = default_block_size())
+          : vector_(v),
+            block_size_(block_size),
+            max_blocks_(max_blocks),
+            max_pending_writes_(max_pending_writes),
+            writes_(v.partitions_.size())
+        {
+            if (block_size_ == 0 || max_blocks_ == 0 ||
+                max_pending_writes_ == 0)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "partitioned_vector_cache::partitioned_vector_cache",
+                    "the block size, the number of blocks, and the number "
+                    "of pending writes must be greater than zero");
+            }
+        }
+
+        ~partitioned_vector_cache()
+        {
+            // the buffered writes are sent, but not waited for, errors
+            // can't be reported from here
+            try {
+                flush();
+            }
+            catch (...) {
+            }
+        }
+
+        partitioned_vector_cache(partitioned_vector_cache const&) = delete;
+        partitioned_vector_cache& operator=(
+            partitioned_vector_cache const&) = delete;
+
+        /// Returns the element at position \a pos in the vector, fetching
+        /// the block containing it if it is not cached yet.
+        ///
+        /// \param pos   Global position of the element in the vector
+        ///
+        T get_value(size_type pos)
+        {
+            size_type part = vector_.get_partition(pos);
+            size_type local_index = vector_.get_local_index(pos);
+
+            auto const& part_data = vector_.partitions_[part];
+            if (part_data.local_data_)
+                return part_data.local_data_->get_value(local_index);
+
+            return get_block(part, local_index / block_size_)
+                [local_index % block_size_];
+        }
+
+        /// Returns the elements at the positions \a pos in the vector.
+        ///
+        /// \param pos   Global positions of the elements in the vector
+        ///
+        std::vector<T> get_values(std::vector<size_type> const& pos)
+        {
+            std::vector<T> result;
+            result.reserve(pos.size());
+            for (size_type p : pos)
+                result.push_back(get_value(p));
+            return result;
+        }
+
+        /// Stores \a val as the element at position \a pos in the vector. The
+        /// write to a remote partition is buffered until the next \a flush.
+        ///
+        /// \param pos   Global position of the element in the vector
+        /// \param val   The value to store
+        ///
+        void set_value(size_type pos, T const& val)
+        {
+            size_type part = vector_.get_partition(pos);
+            size_type local_index = vector_.get_local_index(pos);
+
+            auto const& part_data = vector_.partitions_[part];
+            if (part_data.local_data_)
+            {
+                part_data.local_data_->set_value(local_index, val);
+                return;
+            }
+
+            // keep the cached block up to date
+            auto it = blocks_.find(
+                block_key(part, local_index / block_size_));
+            if (it != blocks_.end())
+                it->second[local_index % block_size_] = val;
+
+            // combine the writes to the same element
+            pending_writes& w = writes_[part];
+            auto index_it = w.index_.find(local_index);
+            if (index_it != w.index_.end())
+            {
+                w.values_[index_it->second] = val;
+                return;
+            }
+
+            w.index_.emplace(local_index, w.positions_.size());
+            w.positions_.push_back(local_index);
+            w.values_.push_back(val);
+
+            if (w.positions_.size() >= max_pending_writes_)
+                flush_partition(part);
+        }
+
+        /// Sends the buffered writes, a single request for each of the
+        /// partitions.
+        ///
+        /// \returns a future which becomes ready once all the writes sent
+        ///          so far have been performed.
+        ///
+        future<void> flush()
+        {
+            std::vector<future<void> > flushed;
+            for (size_type part = 0; part != writes_.size(); ++part)
+            {
+                flush_partition(part);
+
+                pending_writes& w = writes_[part];
+                if (w.in_flight_.valid())
+                    flushed.push_back(std::move(w.in_flight_));
+            }
+            return hpx::when_all(flushed);
+        }
+
+        /// Sends the buffered writes and waits for those to be performed,
+        /// then drops all cached blocks. Everything written before through
+        /// the cache is visible to others afterwards, the following reads
+        /// see the writes performed by others before.
+        void fence()
+        {
+            flush().get();
+            invalidate();
+        }
+
+        /// Drops all cached blocks, the following reads fetch the current
+        /// values of the elements. The buffered writes are kept.
+        void invalidate()
+        {
+            blocks_.clear();
+            order_.clear();
+        }
+
+        /// Returns the number of consecutive elements fetched at once.
+        size_type block_size() const
+        {
+            return block_size_;
+        }
+
+        /// Returns the number of blocks currently held in the cache.
+        size_type num_cached_blocks() const
+        {
+            return blocks_.size();
+        }
+
+    private:
+        static size_type default_block_size()
+        {
+            return (std::max)(size_type(1), size_type(4096 / sizeof(T)));
+        }
+
+        typedef std::pair<size_type, size_type> block_key;
+
+        struct pending_writes
+        {
+            std::vector<size_type> positions_;
+            std::vector<T> values_;
+            std::unordered_map<size_type, size_type> index_;
+            future<void> in_flight_;
+        };
+
+        // at most one set_values request is outstanding for each of the
+        // partitions, this keeps the writes to the same element in order
+        void wait_for_partition(size_type part)
+        {
+            pending_writes& w = writes_[part];
+            if (w.in_flight_.valid())
+                w.in_flight_.get();
+        }
+
+        void flush_partition(size_type part)
+        {
+            pending_writes& w = writes_[part];
+            if (w.positions_.empty())
+                return;
+
+            wait_for_partition(part);
+
+            w.in_flight_ = vector_.set_values(part, w.positions_, w.values_);
+
+            w.positions_.clear();
+            w.values_.clear();
+            w.index_.clear();
+        }
+
+        std::vector<T>& get_block(size_type part, size_type block)
+        {
+            block_key key(part, block);
+            auto it = blocks_.find(key);
+            if (it != blocks_.end())
+                return it->second;
+
+            // the elements written before have to arrive before reading
+            wait_for_partition(part);
+
+            size_type first = block * block_size_;
+            size_type last = (std::min)(first + block_size_,
+                size_type(vector_.partitions_[part].size_));
+
+            std::vector<size_type> positions;
+            positions.reserve(last - first);
+            for (size_type i = first; i != last; ++i)
+                positions.push_back(i);
+
+            std::vector<T> values =
+                vector_.get_values(launch::sync, part, positions);
+
+            // the buffered writes are newer than the fetched values
+            pending_writes const& w = writes_[part];
+            for (size_type i = 0; i != w.positions_.size(); ++i)
+            {
+                if (w.positions_[i] >= first && w.positions_[i] < last)
+                    values[w.positions_[i] - first] = w.values_[i];
+            }
+
+            if (blocks_.size() >= max_blocks_)
+            {
+                blocks_.erase(order_.front());
+                order_.pop_front();
+            }
+
+            order_.push_back(key);
+            return blocks_.emplace(key, std::move(values)).first->second;
+        }
+
+        partitioned_vector<T, Data>& vector_;
+        size_type block_size_;
+        size_type max_blocks_;
+        size_type max_pending_writes_;
+
+        std::map<block_key, std::vector<T> > blocks_;
+        std::deque<block_key> order_;       // the blocks in the order of fetching
+        std::vector<pending_writes> writes_;
+    };
+}
+
+#endif
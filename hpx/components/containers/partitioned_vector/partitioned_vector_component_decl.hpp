@@ -21,6 +21,8 @@
 #include <hpx/runtime/components/server/component_base.hpp>
 #include <hpx/runtime/actions/component_action.hpp>
 #include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
 #include <hpx/util/detail/pp/cat.hpp>
 #include <hpx/util/detail/pp/expand.hpp>
 #include <hpx/util/detail/pp/nargs.hpp>
@@ -28,6 +30,7 @@
 #include <hpx/components/containers/partitioned_vector/partitioned_vector_fwd.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -38,6 +41,34 @@
 
 namespace hpx { namespace server
 {
+    /// The range [first_, last_) of the elements of the partition referenced
+    /// by partition_, used to describe the elements which are moved between
+    /// partitions while rebalancing a partitioned_vector.
+    struct partitioned_vector_range
+    {
+        partitioned_vector_range()
+          : first_(0), last_(0)
+        {}
+
+        partitioned_vector_range(id_type const& part, std::size_t first,
+                std::size_t last)
+          : partition_(part), first_(first), last_(last)
+        {}
+
+        hpx::id_type partition_;
+        std::size_t first_;
+        std::size_t last_;
+
+    private:
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        void serialize(Archive& ar, unsigned)
+        {
+            ar & partition_ & first_ & last_;
+        }
+    };
+
     /// \brief This is the basic wrapper class for stl vector.
     ///
     /// This contain the implementation of the partitioned_vector_partition's
@@ -240,6 +271,63 @@ namespace hpx { namespace server
         void set_values(std::vector<size_type> const& pos,
             std::vector<T> const& val);
 
+        /// Return the elements in the range [first, last) of the
+        /// partitioned_vector_partition container.
+        ///
+        /// \param first Position of the first element of the range
+        /// \param last  Position past the last element of the range
+        ///
+        std::vector<T> get_range(size_type first, size_type last) const;
+
+        /// First step of rebalancing the partitioned_vector: fetch the
+        /// elements which will be stored in front of and behind the elements
+        /// kept by this partition from the other partitions. The current
+        /// elements of this partition are left untouched, which is why this
+        /// step can be performed for all partitions concurrently.
+        ///
+        /// \param front The ranges of the elements to be stored in front of
+        ///              the kept elements, in order
+        /// \param back  The ranges of the elements to be stored behind the
+        ///              kept elements, in order
+        ///
+        void stage_rebalance(std::vector<partitioned_vector_range> const& front,
+            std::vector<partitioned_vector_range> const& back);
+
+        /// Second step of rebalancing the partitioned_vector: replace the
+        /// elements of this partition with the elements fetched by
+        /// \a stage_rebalance and the kept elements in [first, last) in
+        /// between. This step may be performed only after all partitions
+        /// have finished the first step.
+        ///
+        /// \param first Position of the first element to keep
+        /// \param last  Position past the last element to keep
+        ///
+        void commit_rebalance(size_type first, size_type last);
+
+        /// Read the elements of this partition from the given file of raw
+        /// binary data. The elements are read starting at \a offset (in
+        /// bytes), in blocks which do not cross the boundaries of the
+        /// stripes of the file. All blocks are read concurrently.
+        ///
+        /// \param path        The name of the file
+        /// \param offset      The position of the first element in the file
+        /// \param stripe_size The size of the stripes of the file (in
+        ///                    bytes), zero reads all elements in one block
+        ///
+        void load_data(std::string const& path, std::uint64_t offset,
+            std::size_t stripe_size);
+
+        /// Write the elements of this partition to the given (existing)
+        /// file of raw binary data, see \a load_data.
+        ///
+        /// \param path        The name of the file
+        /// \param offset      The position of the first element in the file
+        /// \param stripe_size The size of the stripes of the file (in
+        ///                    bytes), zero writes all elements in one block
+        ///
+        void save_data(std::string const& path, std::uint64_t offset,
+            std::size_t stripe_size) const;
+
         /// Remove all elements from the vector leaving the
         /// partitioned_vector_partition with size 0.
         ///
@@ -271,6 +359,18 @@ namespace hpx { namespace server
 //         HPX_DEFINE_COMPONENT_ACTION(partitioned_vector_partition, clear);
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, get_copied_data);
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, set_data);
+
+        HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, get_range);
+        HPX_DEFINE_COMPONENT_ACTION(partitioned_vector, stage_rebalance);
+        HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, commit_rebalance);
+
+        HPX_DEFINE_COMPONENT_ACTION(partitioned_vector, load_data);
+        HPX_DEFINE_COMPONENT_ACTION(partitioned_vector, save_data);
+
+    private:
+        // the elements fetched by stage_rebalance
+        std::vector<T> staged_front_;
+        std::vector<T> staged_back_;
     };
 }}
 
@@ -301,6 +401,16 @@ namespace hpx { namespace server
         HPX_PP_CAT(__vector_get_copied_data_action_, name));                  \
     HPX_REGISTER_ACTION_DECLARATION(type::set_data_action,                    \
         HPX_PP_CAT(__vector_set_data_action_, name));                         \
+    HPX_REGISTER_ACTION_DECLARATION(type::get_range_action,                   \
+        HPX_PP_CAT(__vector_get_range_action_, name));                        \
+    HPX_REGISTER_ACTION_DECLARATION(type::stage_rebalance_action,             \
+        HPX_PP_CAT(__vector_stage_rebalance_action_, name));                  \
+    HPX_REGISTER_ACTION_DECLARATION(type::commit_rebalance_action,            \
+        HPX_PP_CAT(__vector_commit_rebalance_action_, name));                 \
+    HPX_REGISTER_ACTION_DECLARATION(type::load_data_action,                   \
+        HPX_PP_CAT(__vector_load_data_action_, name));                        \
+    HPX_REGISTER_ACTION_DECLARATION(type::save_data_action,                   \
+        HPX_PP_CAT(__vector_save_data_action_, name));                        \
 /**/
 
 #define HPX_REGISTER_VECTOR_DECLARATION_1(type)                               \
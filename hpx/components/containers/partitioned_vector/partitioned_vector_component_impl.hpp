@@ -8,6 +8,9 @@
 #define HPX_PARTITIONED_VECTOR_COMPONENT_IMPL_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
 #include <hpx/runtime/components/client_base.hpp>
 #include <hpx/runtime/components/component_factory.hpp>
 #include <hpx/runtime/components/server/locking_hook.hpp>
@@ -15,23 +18,142 @@
 #include <hpx/runtime/components/server/component.hpp>
 #include <hpx/runtime/get_ptr.hpp>
 #include <hpx/runtime/launch_policy.hpp>
+#include <hpx/throw_exception.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/async_file.hpp>
 #include <hpx/util/detail/pp/cat.hpp>
 #include <hpx/util/detail/pp/expand.hpp>
 #include <hpx/util/detail/pp/nargs.hpp>
 
 #include <hpx/components/containers/partitioned_vector/partitioned_vector_decl.hpp>
 
+#if !defined(HPX_WINDOWS)
+#include <fcntl.h>
+#endif
+
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace hpx { namespace server
 {
+    namespace detail
+    {
+        // Transfer the given number of bytes starting at the given offset of
+        // a file by invoking transfer(pos, size, offset) for each block. The
+        // blocks end at the boundaries of the stripes of the file, which
+        // lets parallel file systems serve each of them from a single
+        // storage target. All blocks are transferred concurrently.
+        template <typename F>
+        void transfer_striped(char const* name, std::string const& path,
+            std::size_t size, std::uint64_t offset, std::size_t stripe_size,
+            F && transfer)
+        {
+            std::vector<hpx::future<std::size_t> > blocks;
+            std::vector<std::size_t> sizes;
+
+            std::size_t pos = 0;
+            while (pos != size)
+            {
+                std::size_t block = size - pos;
+                if (stripe_size != 0)
+                {
+                    block = (std::min)(block,
+                        std::size_t(stripe_size - offset % stripe_size));
+                }
+
+                blocks.push_back(transfer(pos, block, offset));
+                sizes.push_back(block);
+
+                pos += block;
+                offset += block;
+            }
+
+            hpx::wait_all(blocks);
+            for (std::size_t i = 0; i != blocks.size(); ++i)
+            {
+                // rethrows exceptions
+                if (blocks[i].get() != sizes[i])
+                {
+                    HPX_THROW_EXCEPTION(hpx::filesystem_error, name,
+                        "unexpected end of file: " + path);
+                }
+            }
+        }
+
+        template <typename Data>
+        void load_data(Data& data, std::string const& path,
+            std::uint64_t offset, std::size_t stripe_size, std::true_type)
+        {
+#if !defined(HPX_WINDOWS)
+            typedef typename Data::value_type value_type;
+
+            util::async_file file(path, O_RDONLY);
+            char* p = reinterpret_cast<char*>(data.data());
+
+            transfer_striped("partitioned_vector::load", path,
+                data.size() * sizeof(value_type), offset, stripe_size,
+                [&](std::size_t pos, std::size_t count, std::uint64_t at)
+                {
+                    return file.pread(p + pos, count, at);
+                });
+#else
+            HPX_THROW_EXCEPTION(hpx::not_implemented,
+                "partitioned_vector::load",
+                "loading a partitioned_vector is not supported on Windows");
+#endif
+        }
+
+        template <typename Data>
+        void save_data(Data const& data, std::string const& path,
+            std::uint64_t offset, std::size_t stripe_size, std::true_type)
+        {
+#if !defined(HPX_WINDOWS)
+            typedef typename Data::value_type value_type;
+
+            util::async_file file(path, O_WRONLY);
+            char const* p = reinterpret_cast<char const*>(data.data());
+
+            transfer_striped("partitioned_vector::save", path,
+                data.size() * sizeof(value_type), offset, stripe_size,
+                [&](std::size_t pos, std::size_t count, std::uint64_t at)
+                {
+                    return file.pwrite(p + pos, count, at);
+                });
+#else
+            HPX_THROW_EXCEPTION(hpx::not_implemented,
+                "partitioned_vector::save",
+                "saving a partitioned_vector is not supported on Windows");
+#endif
+        }
+
+        template <typename Data>
+        void load_data(Data&, std::string const&, std::uint64_t,
+            std::size_t, std::false_type)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "partitioned_vector::load",
+                "the elements of the vector are not trivially copyable");
+        }
+
+        template <typename Data>
+        void save_data(Data const&, std::string const&, std::uint64_t,
+            std::size_t, std::false_type)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "partitioned_vector::save",
+                "the elements of the vector are not trivially copyable");
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename T, typename Data>
     HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT
@@ -289,6 +411,121 @@ namespace hpx { namespace server
     {
         partitioned_vector_partition_.clear();
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, typename Data>
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT std::vector<T>
+    partitioned_vector<T, Data>::get_range(
+        size_type first, size_type last) const
+    {
+        HPX_ASSERT(first <= last && last <= partitioned_vector_partition_.size());
+
+        std::vector<T> result;
+        result.reserve(last - first);
+
+        for (size_type i = first; i != last; ++i)
+            result.push_back(partitioned_vector_partition_[i]);
+
+        return result;
+    }
+
+    template <typename T, typename Data>
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT void
+    partitioned_vector<T, Data>::stage_rebalance(
+        std::vector<partitioned_vector_range> const& front,
+        std::vector<partitioned_vector_range> const& back)
+    {
+        typedef typename partitioned_vector::get_range_action action_type;
+
+        // fetch all ranges concurrently
+        std::vector<hpx::future<std::vector<T> > > ranges;
+        ranges.reserve(front.size() + back.size());
+
+        for (partitioned_vector_range const& r : front)
+        {
+            ranges.push_back(hpx::async<action_type>(
+                r.partition_, r.first_, r.last_));
+        }
+        for (partitioned_vector_range const& r : back)
+        {
+            ranges.push_back(hpx::async<action_type>(
+                r.partition_, r.first_, r.last_));
+        }
+
+        staged_front_.clear();
+        staged_back_.clear();
+
+        for (std::size_t i = 0; i != ranges.size(); ++i)
+        {
+            std::vector<T> values = ranges[i].get();
+            std::vector<T>& staged =
+                (i < front.size()) ? staged_front_ : staged_back_;
+
+            staged.insert(staged.end(), std::make_move_iterator(values.begin()),
+                std::make_move_iterator(values.end()));
+        }
+    }
+
+    template <typename T, typename Data>
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT void
+    partitioned_vector<T, Data>::commit_rebalance(
+        size_type first, size_type last)
+    {
+        data_type& data = partitioned_vector_partition_;
+
+        size_type const old_size = data.size();
+        HPX_ASSERT(first <= last && last <= old_size);
+
+        size_type const kept = last - first;
+        size_type const offset = staged_front_.size();
+        size_type const new_size = offset + kept + staged_back_.size();
+
+        if (new_size > old_size)
+            data.resize(new_size);
+
+        // move the kept elements to their new place
+        if (offset > first)
+        {
+            for (size_type i = kept; i != 0; --i)
+                data[offset + i - 1] = std::move(data[first + i - 1]);
+        }
+        else if (offset < first)
+        {
+            for (size_type i = 0; i != kept; ++i)
+                data[offset + i] = std::move(data[first + i]);
+        }
+
+        for (size_type i = 0; i != offset; ++i)
+            data[i] = std::move(staged_front_[i]);
+
+        for (size_type i = 0; i != staged_back_.size(); ++i)
+            data[offset + kept + i] = std::move(staged_back_[i]);
+
+        if (new_size < old_size)
+            data.resize(new_size);
+
+        staged_front_.clear();
+        staged_back_.clear();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, typename Data>
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT void
+    partitioned_vector<T, Data>::load_data(std::string const& path,
+        std::uint64_t offset, std::size_t stripe_size)
+    {
+        detail::load_data(partitioned_vector_partition_, path, offset,
+            stripe_size, std::is_trivially_copyable<T>());
+    }
+
+    template <typename T, typename Data>
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT void
+    partitioned_vector<T, Data>::save_data(std::string const& path,
+        std::uint64_t offset, std::size_t stripe_size) const
+    {
+        detail::save_data(partitioned_vector_partition_, path, offset,
+            stripe_size, std::is_trivially_copyable<T>());
+    }
 }}
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -317,6 +554,16 @@ namespace hpx { namespace server
         HPX_PP_CAT(__vector_get_copied_data_action_, name));                   \
     HPX_REGISTER_ACTION(                                                       \
         type::set_data_action, HPX_PP_CAT(__vector_set_data_action_, name));   \
+    HPX_REGISTER_ACTION(                                                       \
+        type::get_range_action, HPX_PP_CAT(__vector_get_range_action_, name)); \
+    HPX_REGISTER_ACTION(type::stage_rebalance_action,                          \
+        HPX_PP_CAT(__vector_stage_rebalance_action_, name));                   \
+    HPX_REGISTER_ACTION(type::commit_rebalance_action,                         \
+        HPX_PP_CAT(__vector_commit_rebalance_action_, name));                  \
+    HPX_REGISTER_ACTION(type::load_data_action,                                \
+        HPX_PP_CAT(__vector_load_data_action_, name));                         \
+    HPX_REGISTER_ACTION(type::save_data_action,                                \
+        HPX_PP_CAT(__vector_save_data_action_, name));                         \
     typedef ::hpx::components::component<type> HPX_PP_CAT(__vector_, name);    \
     HPX_REGISTER_COMPONENT(HPX_PP_CAT(__vector_, name))    \
 /**/
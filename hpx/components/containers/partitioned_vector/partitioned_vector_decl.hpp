@@ -210,6 +210,12 @@ namespace hpx
         size_type size_;                // overall size of the vector
         size_type partition_size_;      // cached partition size
 
+        // The global index of the first element of each of the partitions,
+        // empty as long as all partitions have the cached partition size
+        // (except for the trailing ones). The partitions may have arbitrary
+        // sizes after rebalancing the vector only.
+        std::vector<size_type> partition_bases_;
+
         // This is the vector representing the base_index and corresponding
         // global ID's of the underlying partitioned_vector_partitions.
         partitions_vector_type partitions_;
@@ -246,10 +252,35 @@ namespace hpx
         friend class const_segment_vector_iterator<
             T, Data, typename partitions_vector_type::const_iterator>;
 
+        friend class partitioned_vector_cache<T, Data>;
+
         std::size_t get_partition_size() const;
         std::size_t get_global_index(std::size_t segment,
             std::size_t part_size, size_type local_index) const;
 
+        // Update the cached partition size and the global indices of the
+        // first element of each of the partitions from the sizes of the
+        // partitions.
+        void update_partition_bases();
+
+        // Return the configuration data describing this vector.
+        server::partitioned_vector_config_data get_config_data() const;
+
+        // Return the global index of the first element of each of the
+        // partitions (and the overall size) after rebalancing with the given
+        // weights.
+        std::vector<size_type> get_rebalanced_bases(
+            std::vector<double> const& weights) const;
+
+        // Move the elements between the partitions such that the partitions
+        // start at the given global indices.
+        void rebalance_helper(std::vector<size_type> const& bases);
+
+        // Read or write the elements of all partitions from or to the given
+        // file concurrently.
+        void load_helper(std::string const& path, std::size_t stripe_size);
+        void save_helper(std::string const& path, std::size_t stripe_size) const;
+
         ///////////////////////////////////////////////////////////////////////
         // Connect this vector to the existing vector using the given symbolic
         // name.
@@ -286,6 +317,14 @@ namespace hpx
         std::vector<size_type>
         get_local_indices(std::vector<size_type> indices) const;
 
+        // Return the local indices inside the segments corresponding to the
+        // given global indices grouped by segment, the relative order of the
+        // indices of each segment is preserved. The segment of each of the
+        // global indices is stored in parts.
+        std::vector<std::vector<size_type> >
+        get_partitioned_local_indices(std::vector<size_type> const& indices,
+            std::vector<size_type>& parts) const;
+
         // Return the global index corresponding to the local index inside the
         // given segment.
         template <typename SegmentIter>
@@ -422,6 +461,7 @@ namespace hpx
           : base_type(std::move(rhs)),
             size_(rhs.size_),
             partition_size_(rhs.partition_size_),
+            partition_bases_(std::move(rhs.partition_bases_)),
             partitions_(std::move(rhs.partitions_))
         {
             rhs.size_ = 0;
@@ -480,6 +520,7 @@ namespace hpx
 
                 size_ = rhs.size_;
                 partition_size_ = rhs.partition_size_;
+                partition_bases_ = std::move(rhs.partition_bases_);
                 partitions_ = std::move(rhs.partitions_);
 
                 rhs.size_ = 0;
@@ -500,6 +541,93 @@ namespace hpx
             return size_;
         }
 
+        /// Move the boundaries of the partitions such that the number of
+        /// elements stored in each of the partitions is proportional to the
+        /// given weights, e.g. the measured speed of the localities the
+        /// partitions are located on. The overall size and the order of the
+        /// elements of the vector stay the same, the elements are moved
+        /// between the partitions concurrently. The configuration data
+        /// registered for the vector (if any) is replaced in one step once
+        /// all elements have been moved, vectors connecting to it afterwards
+        /// see the new layout. Vectors connected to it before have to
+        /// reconnect.
+        ///
+        /// \param weights The relative weight of each of the partitions
+        ///
+        /// \note The vector must not be accessed concurrently, all iterators
+        ///       referring to it are invalidated.
+        ///
+        /// \return Returns a future which becomes ready once the elements
+        ///         have been moved.
+        ///
+        future<void> rebalance(std::vector<double> const& weights);
+
+        /// Move the boundaries of the partitions such that the number of
+        /// elements stored in each of the partitions is proportional to the
+        /// given weights, see above.
+        ///
+        /// \param weights The relative weight of each of the partitions
+        ///
+        void rebalance(launch::sync_policy, std::vector<double> const& weights);
+
+        /// Read the elements of the vector from the given file of raw binary
+        /// data, which holds the elements in the order of their global
+        /// index (as written by \a save). Each partition reads its own
+        /// elements on the locality it is located on, all partitions are
+        /// read concurrently. The reads are split into blocks which do not
+        /// cross the boundaries of the stripes of the file, and are issued
+        /// through \a hpx::util::async_file. The vector keeps its size and
+        /// layout, the file has to hold at least as many elements.
+        ///
+        /// \param path        The name of the file, it has to be accessible
+        ///                    from all localities holding partitions
+        /// \param stripe_size The size of the stripes of the file system (in
+        ///                    bytes), zero reads each partition in one block
+        ///
+        /// \note The elements have to be trivially copyable.
+        ///
+        /// \return Returns a future which becomes ready once all elements
+        ///         have been read.
+        ///
+        future<void> load(std::string const& path,
+            std::size_t stripe_size = 1048576);
+
+        /// Read the elements of the vector from the given file, see above.
+        ///
+        /// \param path        The name of the file
+        /// \param stripe_size The size of the stripes of the file system
+        ///
+        void load(launch::sync_policy, std::string const& path,
+            std::size_t stripe_size = 1048576);
+
+        /// Write the elements of the vector to the given file of raw binary
+        /// data, in the order of their global index. The file is created (or
+        /// truncated) on the calling locality, then each partition writes its
+        /// own elements on the locality it is located on, all partitions
+        /// concurrently. The writes are split into blocks which do not cross
+        /// the boundaries of the stripes of the file, see \a load.
+        ///
+        /// \param path        The name of the file, it has to be accessible
+        ///                    from all localities holding partitions
+        /// \param stripe_size The size of the stripes of the file system (in
+        ///                    bytes), zero writes each partition in one block
+        ///
+        /// \note The elements have to be trivially copyable.
+        ///
+        /// \return Returns a future which becomes ready once all elements
+        ///         have been written.
+        ///
+        future<void> save(std::string const& path,
+            std::size_t stripe_size = 1048576) const;
+
+        /// Write the elements of the vector to the given file, see above.
+        ///
+        /// \param path        The name of the file
+        /// \param stripe_size The size of the stripes of the file system
+        ///
+        void save(launch::sync_policy, std::string const& path,
+            std::size_t stripe_size = 1048576) const;
+
         //
         //  Element access API's in vector class
         //
@@ -611,7 +739,9 @@ namespace hpx
         }
 
         /// Returns the elements at the positions \a pos
-        /// in the vector container.
+        /// in the vector container. The positions may be given in any order,
+        /// a single request is sent to each of the partitions holding any
+        /// of the elements.
         ///
         /// \param pos   Global position of the element in the vector
         ///
@@ -626,62 +756,49 @@ namespace hpx
             if (pos_vec.empty())
                 return make_ready_future(std::vector<T>());
 
-            // current partition index of the block
-            size_type part_cur = get_partition(pos_vec[0]);
-
-            // iterator to the begin of current block
-            typename std::vector<size_type>::const_iterator part_begin =
-                pos_vec.begin();
+            // group the positions by partition, this issues a single request
+            // for each of the partitions, regardless of the order of the
+            // positions
+            std::vector<size_type> parts;
+            std::vector<std::vector<size_type> > local_indices =
+                get_partitioned_local_indices(pos_vec, parts);
 
-            // vector holding futures of the values for all blocks
+            // vector holding futures of the values for all partitions
             std::vector<future<std::vector<T> > > part_values_future;
-            for (typename std::vector<size_type>::const_iterator it =
-                    pos_vec.begin(); it != pos_vec.end(); ++it)
+            part_values_future.reserve(local_indices.size());
+            for (size_type part = 0; part != local_indices.size(); ++part)
             {
-                // get the partition of the current position
-                size_type part = get_partition(*it);
-
-                // if the partition of the current position is the same
-                // as the rest of the current block go to next position
-                if (part == part_cur)
-                    continue;
-
-                // if the partition of the current position is NOT the same
-                // as the positions before the block ends here
+                if (local_indices[part].empty())
+                {
+                    part_values_future.push_back(
+                        make_ready_future(std::vector<T>()));
+                }
                 else
                 {
-                    // this is the end of a block containing indexes ('pos')
-                    // of the same partition ('part').
-                    // get async values for this block
-                    part_values_future.push_back(get_values(part_cur,
-                        get_local_indices(std::vector<size_type>(part_begin, it))));
-
-                    // reset block variables to start a new one from here
-                    part_cur = part;
-                    part_begin = it;
+                    part_values_future.push_back(
+                        get_values(part, local_indices[part]));
                 }
             }
 
-            // the end of the vector is also an end of a block
-            // get async values for this block
-            part_values_future.push_back(get_values(part_cur,
-                get_local_indices(std::vector<size_type>(
-                    part_begin, pos_vec.end()))));
-
             // This helper function unwraps the vectors from each partition
-            // and merge them to one vector
+            // and places the values in the order of the requested positions
             auto merge_func =
-                [&pos_vec](std::vector<future<std::vector<T> > > && part_values_f)
-                    -> std::vector<T>
+                [](std::vector<future<std::vector<T> > > && part_values_f,
+                    std::vector<size_type> const& parts) -> std::vector<T>
                 {
-                    std::vector<T> values;
-                    values.reserve(pos_vec.size());
-
+                    std::vector<std::vector<T> > part_values;
+                    part_values.reserve(part_values_f.size());
                     for (future<std::vector<T> >& part_f: part_values_f)
+                        part_values.push_back(part_f.get());
+
+                    std::vector<size_type> next(part_values.size(), 0);
+
+                    std::vector<T> values;
+                    values.reserve(parts.size());
+                    for (size_type part : parts)
                     {
-                        std::vector<T> part_values = part_f.get();
-                        std::move(part_values.begin(), part_values.end(),
-                            std::back_inserter(values));
+                        values.push_back(
+                            std::move(part_values[part][next[part]++]));
                     }
                     return values;
                 };
@@ -689,7 +806,7 @@ namespace hpx
             // when all values are here merge them to one vector
             // and return a future to this vector
             return dataflow(launch::async, merge_func,
-                std::move(part_values_future));
+                std::move(part_values_future), std::move(parts));
         }
 
         /// Returns the elements at the positions \a pos
@@ -929,7 +1046,7 @@ namespace hpx
         void set_values(launch::sync_policy, size_type part,
             std::vector<size_type> const& pos, std::vector<T> const& val)
         {
-            set_values(pos, val).get();
+            set_values(part, pos, val).get();
         }
 
         /// Asynchronously set the element at position \a pos in
@@ -959,7 +1076,9 @@ namespace hpx
         }
 
         /// Asynchronously set the element at position \a pos
-        /// to the given value \a val.
+        /// to the given value \a val. The positions may be given in any
+        /// order, a single request is sent to each of the partitions holding
+        /// any of the elements.
         ///
         /// \param pos   Global position of the element in the vector
         /// \param val   The value to be copied
@@ -977,56 +1096,32 @@ namespace hpx
             if (pos.empty())
                 return make_ready_future();
 
-            // partition index of the current block
-            size_type part_cur = get_partition(pos[0]);
-
-            // iterator to the begin of current block
-            typename std::vector<size_type>::const_iterator pos_block_begin =
-                pos.begin();
-            typename std::vector<T>::const_iterator val_block_begin = val.begin();
+            // group the positions and the values by partition, this issues
+            // a single request for each of the partitions, regardless of the
+            // order of the positions
+            std::vector<size_type> parts;
+            std::vector<std::vector<size_type> > local_indices =
+                get_partitioned_local_indices(pos, parts);
 
-            // vector holding futures of the state for all blocks
-            std::vector<future<void> > part_futures;
+            std::vector<std::vector<T> > part_values(local_indices.size());
+            for (size_type part = 0; part != local_indices.size(); ++part)
+                part_values[part].reserve(local_indices[part].size());
 
-            // going through the position vector
-            typename std::vector<size_type>::const_iterator pos_it = pos.begin();
             typename std::vector<T>::const_iterator val_it = val.begin();
-            for (/**/; pos_it != pos.end(); ++pos_it, ++val_it)
-            {
-                // get the partition of the current position
-                size_type part = get_partition(*pos_it);
-
-                // if the partition of the current position is the same
-                // as the rest of the current block go to next position
-                if (part == part_cur)
-                    continue;
+            for (size_type part : parts)
+                part_values[part].push_back(*val_it++);
 
-                // if the partition of the current position is NOT the same
-                // as the positions before the block ends here
-                else
+            // vector holding futures of the state for all partitions
+            std::vector<future<void> > part_futures;
+            for (size_type part = 0; part != local_indices.size(); ++part)
+            {
+                if (!local_indices[part].empty())
                 {
-                    // this is the end of a block containing indexes ('pos')
-                    // of the same partition ('part').
-                    // set asynchronous values for this block
-                    part_futures.push_back(set_values(part_cur,
-                        get_local_indices(std::vector<size_type>(
-                            pos_block_begin, pos_it)),
-                        std::vector<T>(val_block_begin, val_it)));
-
-                    // reset block variables to start a new one from here
-                    part_cur = part;
-                    pos_block_begin = pos_it;
-                    val_block_begin = val_it;
+                    part_futures.push_back(set_values(part,
+                        local_indices[part], part_values[part]));
                 }
             }
 
-            // the end of the vector is also an end of a block
-            // get asynchronous values for this block
-            part_futures.push_back(set_values(part_cur,
-                get_local_indices(std::vector<size_type>(
-                    pos_block_begin, pos.end())),
-                std::vector<T>(val_block_begin, val.end())));
-
             return when_all(part_futures);
         }
 
@@ -0,0 +1,157 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file hpx/components/partitioned_vector/partitioned_vector_halo.hpp
+
+#ifndef HPX_PARTITIONED_VECTOR_HALO_HPP
+#define HPX_PARTITIONED_VECTOR_HALO_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/halo_exchange.hpp>
+#include <hpx/lcos/when_all.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <hpx/components/containers/partitioned_vector/partitioned_vector_decl.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace hpx
+{
+    /// This class exchanges the halos of the partitions of a
+    /// \a hpx::partitioned_vector which are located on the calling locality
+    /// with the neighboring partitions (the previous and the next partition
+    /// of the vector).
+    ///
+    /// Every locality holding partitions of the vector has to create the
+    /// object using the same base name. The first and the last \a width
+    /// elements of each of the local partitions are sent by \a put, they are
+    /// available as the halos of the neighbors once the future returned by
+    /// \a get_future has become ready. The halos are exchanged through
+    /// buffers which are allocated once (see \a hpx::lcos::halo_exchange).
+    ///
+    /// \tparam T   The type of the elements of the vector.
+    /// \tparam Data The type of the data of the partitions.
+    ///
+    template <typename T, typename Data>
+    class partitioned_vector_halo
+    {
+        typedef typename partitioned_vector<T, Data>::const_iterator iterator;
+        typedef hpx::traits::segmented_iterator_traits<iterator> traits;
+        typedef typename traits::local_segment_iterator local_segment_iterator;
+        typedef typename traits::local_raw_iterator local_raw_iterator;
+
+        struct local_partition
+        {
+            std::size_t segment_;
+            local_raw_iterator begin_;
+            local_raw_iterator end_;
+            lcos::halo_exchange<T> halo_;
+        };
+
+    public:
+        typedef T value_type;
+
+        /// Create the halo exchange for the local partitions of the given
+        /// vector.
+        ///
+        /// \param basename     The base name identifying the exchange, all
+        ///                     localities have to use the same name.
+        /// \param v            The vector whose halos are exchanged. Its
+        ///                     partitions may not be resized while the
+        ///                     exchange exists.
+        /// \param width        The number of elements exchanged with each
+        ///                     neighbor.
+        /// \param periodic     Whether the first and the last partition are
+        ///                     neighbors.
+        ///
+        partitioned_vector_halo(std::string const& basename,
+            partitioned_vector<T, Data> const& v, std::size_t width,
+            bool periodic = false)
+        {
+            std::size_t num_segments =
+                std::distance(v.segment_begin(), v.segment_end());
+
+            std::uint32_t here = hpx::get_locality_id();
+            local_segment_iterator end = v.segment_end(here);
+            for (local_segment_iterator it = v.segment_begin(here); it != end;
+                 ++it)
+            {
+                std::size_t segment = v.get_partition(it);
+                local_partition p = { segment, traits::begin(it),
+                    traits::end(it),
+                    lcos::halo_exchange<T>(basename, segment, num_segments,
+                        width, periodic)
+                };
+                partitions_.push_back(std::move(p));
+            }
+        }
+
+        /// Return the number of partitions located on this locality.
+        std::size_t size() const
+        {
+            return partitions_.size();
+        }
+
+        /// Return the index of the i-th local partition in the vector.
+        std::size_t get_segment(std::size_t i) const
+        {
+            HPX_ASSERT(i < partitions_.size());
+            return partitions_[i].segment_;
+        }
+
+        /// Return the halo exchange of the i-th local partition, its left
+        /// and right neighbors have the indices
+        /// \a hpx::lcos::halo_exchange<T>::left and
+        /// \a hpx::lcos::halo_exchange<T>::right.
+        lcos::halo_exchange<T>& operator[](std::size_t i)
+        {
+            HPX_ASSERT(i < partitions_.size());
+            return partitions_[i].halo_;
+        }
+        lcos::halo_exchange<T> const& operator[](std::size_t i) const
+        {
+            HPX_ASSERT(i < partitions_.size());
+            return partitions_[i].halo_;
+        }
+
+        /// Send the edges of all local partitions for the given generation.
+        void put(std::size_t generation)
+        {
+            for (local_partition& p : partitions_)
+                p.halo_.put_edges(p.begin_, p.end_, generation);
+        }
+
+        /// Return a future which becomes ready once the halos of all local
+        /// partitions have arrived for the given generation.
+        hpx::future<void> get_future(std::size_t generation) const
+        {
+            std::vector<hpx::future<void> > futures;
+            futures.reserve(partitions_.size());
+            for (local_partition const& p : partitions_)
+                futures.push_back(p.halo_.get_future(generation));
+            return hpx::when_all(futures);
+        }
+
+        /// Release the halos of all local partitions for the given
+        /// generation.
+        void release(std::size_t generation)
+        {
+            for (local_partition& p : partitions_)
+                p.halo_.release(generation);
+        }
+
+    private:
+        std::vector<local_partition> partitions_;
+    };
+}
+
+#endif
@@ -20,6 +20,7 @@
 #include <hpx/throw_exception.hpp>
 #include <hpx/traits/is_distribution_policy.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/async_file.hpp>
 #include <hpx/util/bind_back.hpp>
 
 #include <hpx/components/containers/container_distribution_policy.hpp>
@@ -27,6 +28,12 @@
 #include <hpx/components/containers/partitioned_vector/partitioned_vector_component_impl.hpp>
 #include <hpx/components/containers/partitioned_vector/partitioned_vector_segmented_iterator.hpp>
 
+#if !defined(HPX_WINDOWS)
+#include <fcntl.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
@@ -55,9 +62,45 @@ namespace hpx
     partitioned_vector<T, Data>::get_global_index(
         std::size_t segment, std::size_t part_size, size_type local_index) const
     {
+        if (!partition_bases_.empty())
+            return partition_bases_[segment] + local_index;
+
         return segment * part_size + local_index;
     }
 
+    template <typename T, typename Data /*= std::vector<T> */>
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT void
+    partitioned_vector<T, Data>::update_partition_bases()
+    {
+        partition_size_ = get_partition_size();
+        partition_bases_.clear();
+
+        // nothing else to do if the partitions have the default sizes
+        bool uniform = true;
+        size_type base = 0;
+        for (partition_data const& part : partitions_)
+        {
+            if (part.size_ != (std::min)(partition_size_, size_ - base))
+            {
+                uniform = false;
+                break;
+            }
+            base += part.size_;
+        }
+        if (uniform)
+            return;
+
+        partition_bases_.reserve(partitions_.size());
+
+        base = 0;
+        for (partition_data const& part : partitions_)
+        {
+            partition_bases_.push_back(base);
+            base += part.size_;
+        }
+        HPX_ASSERT(base == size_);
+    }
+
     template <typename T, typename Data /*= std::vector<T> */>
     HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT void
     partitioned_vector<T, Data>::get_data_helper(
@@ -88,7 +131,7 @@ namespace hpx
         }
         wait_all(ptrs);
 
-        partition_size_ = get_partition_size();
+        update_partition_bases();
         this->base_type::reset(std::move(id));
     }
 
@@ -125,8 +168,9 @@ namespace hpx
     }
 
     template <typename T, typename Data /*= std::vector<T> */>
-    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT hpx::future<void>
-    partitioned_vector<T, Data>::register_as(std::string const& symbolic_name)
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT
+        server::partitioned_vector_config_data
+        partitioned_vector<T, Data>::get_config_data() const
     {
         std::vector<server::partitioned_vector_config_data::partition_data>
             partitions;
@@ -135,11 +179,18 @@ namespace hpx
         std::copy(
             partitions_.begin(), partitions_.end(), std::back_inserter(partitions));
 
-        server::partitioned_vector_config_data data(size_, std::move(partitions));
+        return server::partitioned_vector_config_data(
+            size_, std::move(partitions));
+    }
+
+    template <typename T, typename Data /*= std::vector<T> */>
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT hpx::future<void>
+    partitioned_vector<T, Data>::register_as(std::string const& symbolic_name)
+    {
         this->base_type::reset(
             hpx::new_<components::server::distributed_metadata_base<
                 server::partitioned_vector_config_data>>(
-                hpx::find_here(), std::move(data)));
+                hpx::find_here(), get_config_data()));
 
         return this->base_type::register_as(symbolic_name);
     }
@@ -171,6 +222,13 @@ namespace hpx
         if (global_index == size_)
             return partitions_.size();
 
+        if (!partition_bases_.empty())
+        {
+            return std::distance(partition_bases_.begin(),
+                       std::upper_bound(partition_bases_.begin(),
+                           partition_bases_.end(), global_index)) - 1;
+        }
+
         std::size_t part_size = partition_size_;
         if (part_size != 0)
             return (part_size != size_) ? (global_index / part_size) : 0;
@@ -188,6 +246,9 @@ namespace hpx
             return std::size_t(-1);
         }
 
+        if (!partition_bases_.empty())
+            return global_index - partition_bases_[get_partition(global_index)];
+
         return (partition_size_ != size_) ? (global_index % partition_size_) :
                                             global_index;
     }
@@ -203,6 +264,37 @@ namespace hpx
         return indices;
     }
 
+    template <typename T, typename Data /*= std::vector<T> */>
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT
+        std::vector<std::vector<typename partitioned_vector<T, Data>::size_type> >
+        partitioned_vector<T, Data>::get_partitioned_local_indices(
+            std::vector<size_type> const& indices,
+            std::vector<size_type>& parts) const
+    {
+        std::size_t const num_parts = partitions_.size();
+
+        parts.clear();
+        parts.reserve(indices.size());
+
+        std::vector<std::size_t> counts(num_parts, 0);
+        for (size_type index : indices)
+        {
+            std::size_t part = get_partition(index);
+            HPX_ASSERT(part < num_parts);
+            parts.push_back(part);
+            ++counts[part];
+        }
+
+        std::vector<std::vector<size_type> > local_indices(num_parts);
+        for (std::size_t part = 0; part != num_parts; ++part)
+            local_indices[part].reserve(counts[part]);
+
+        for (std::size_t i = 0; i != indices.size(); ++i)
+            local_indices[parts[i]].push_back(get_local_index(indices[i]));
+
+        return local_indices;
+    }
+
     template <typename T, typename Data /*= std::vector<T> */>
     HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT
         typename partitioned_vector<T, Data>::local_iterator
@@ -383,7 +475,7 @@ namespace hpx
         when_all(ptrs).get();
 
         // cache our partition size
-        partition_size_ = get_partition_size();
+        update_partition_bases();
     }
 
     template <typename T, typename Data /*= std::vector<T> */>
@@ -448,9 +540,279 @@ namespace hpx
 
         size_ = rhs.size_;
         partition_size_ = rhs.partition_size_;
+        partition_bases_ = rhs.partition_bases_;
         std::swap(partitions_, partitions);
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, typename Data /*= std::vector<T> */>
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT
+        std::vector<typename partitioned_vector<T, Data>::size_type>
+        partitioned_vector<T, Data>::get_rebalanced_bases(
+            std::vector<double> const& weights) const
+    {
+        std::size_t const num_parts = partitions_.size();
+        if (weights.size() != num_parts)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "partitioned_vector::rebalance",
+                "the number of weights must be equal to the number of "
+                "partitions");
+        }
+
+        double total = 0.0;
+        for (double w : weights)
+        {
+            if (!(w >= 0.0))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "partitioned_vector::rebalance",
+                    "the weights must not be negative");
+            }
+            total += w;
+        }
+
+        if (num_parts != 0 && !(total > 0.0))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "partitioned_vector::rebalance",
+                "at least one of the weights must be greater than zero");
+        }
+
+        // round the accumulated weights, this keeps the bases ordered
+        std::vector<size_type> bases(num_parts + 1, 0);
+        double accumulated = 0.0;
+        for (std::size_t i = 1; i < num_parts; ++i)
+        {
+            accumulated += weights[i - 1];
+            bases[i] = (std::min)(size_,
+                size_type(double(size_) * (accumulated / total) + 0.5));
+        }
+        bases[num_parts] = size_;
+
+        return bases;
+    }
+
+    template <typename T, typename Data /*= std::vector<T> */>
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT void
+    partitioned_vector<T, Data>::rebalance_helper(
+        std::vector<size_type> const& bases)
+    {
+        typedef server::partitioned_vector_range range_type;
+
+        std::size_t const num_parts = partitions_.size();
+        HPX_ASSERT(bases.size() == num_parts + 1);
+
+        std::vector<size_type> old_bases(num_parts + 1, 0);
+        for (std::size_t i = 0; i != num_parts; ++i)
+            old_bases[i + 1] = old_bases[i] + partitions_[i].size_;
+        HPX_ASSERT(old_bases[num_parts] == size_);
+
+        // append the ranges of the current partitions covering the global
+        // range [first, last)
+        auto get_ranges =
+            [&](size_type first, size_type last, std::vector<range_type>& r)
+            {
+                for (std::size_t i = 0; i != num_parts && first < last; ++i)
+                {
+                    size_type l = (std::min)(last, old_bases[i + 1]);
+                    if (first < l)
+                    {
+                        r.push_back(range_type(partitions_[i].partition_,
+                            first - old_bases[i], l - old_bases[i]));
+                        first = l;
+                    }
+                }
+            };
+
+        // fetch the elements each of the partitions receives from the other
+        // partitions, the elements stay in place in the meantime
+        std::vector<std::pair<size_type, size_type> > kept(num_parts);
+        std::vector<bool> changed(num_parts, false);
+        std::vector<future<void> > staged;
+
+        for (std::size_t k = 0; k != num_parts; ++k)
+        {
+            if (bases[k] == old_bases[k] && bases[k + 1] == old_bases[k + 1])
+                continue;
+
+            changed[k] = true;
+
+            // the current elements of this partition which are kept
+            size_type first = (std::max)(bases[k], old_bases[k]);
+            size_type last = (std::min)(bases[k + 1], old_bases[k + 1]);
+
+            std::vector<range_type> front, back;
+            if (first < last)
+            {
+                get_ranges(bases[k], first, front);
+                get_ranges(last, bases[k + 1], back);
+                kept[k] = std::make_pair(
+                    first - old_bases[k], last - old_bases[k]);
+            }
+            else
+            {
+                get_ranges(bases[k], bases[k + 1], front);
+                kept[k] = std::make_pair(size_type(0), size_type(0));
+            }
+
+            if (!front.empty() || !back.empty())
+            {
+                staged.push_back(hpx::async<
+                        typename partitioned_vector_partition_server::
+                            stage_rebalance_action
+                    >(partitions_[k].partition_, std::move(front),
+                        std::move(back)));
+            }
+        }
+
+        wait_all(staged);
+        for (future<void>& f : staged)
+            f.get();            // rethrow exceptions
+
+        // now replace the elements of all changed partitions
+        std::vector<future<void> > committed;
+        for (std::size_t k = 0; k != num_parts; ++k)
+        {
+            if (!changed[k])
+                continue;
+
+            committed.push_back(hpx::async<
+                    typename partitioned_vector_partition_server::
+                        commit_rebalance_action
+                >(partitions_[k].partition_, kept[k].first, kept[k].second));
+        }
+
+        wait_all(committed);
+        for (future<void>& f : committed)
+            f.get();            // rethrow exceptions
+
+        for (std::size_t k = 0; k != num_parts; ++k)
+            partitions_[k].size_ = bases[k + 1] - bases[k];
+        update_partition_bases();
+
+        // publish the new layout, if this vector was registered
+        if (this->base_type::valid())
+        {
+            typedef typename components::server::distributed_metadata_base<
+                server::partitioned_vector_config_data>::set_action act;
+
+            async(act(), this->get_id(), get_config_data()).get();
+        }
+    }
+
+    template <typename T, typename Data /*= std::vector<T> */>
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT hpx::future<void>
+    partitioned_vector<T, Data>::rebalance(std::vector<double> const& weights)
+    {
+        return hpx::async(&partitioned_vector::rebalance_helper, this,
+            get_rebalanced_bases(weights));
+    }
+
+    template <typename T, typename Data /*= std::vector<T> */>
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT void
+    partitioned_vector<T, Data>::rebalance(
+        launch::sync_policy, std::vector<double> const& weights)
+    {
+        rebalance_helper(get_rebalanced_bases(weights));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, typename Data /*= std::vector<T> */>
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT void
+    partitioned_vector<T, Data>::load_helper(
+        std::string const& path, std::size_t stripe_size)
+    {
+        typedef typename partitioned_vector_partition_server::load_data_action
+            action_type;
+
+        std::vector<future<void> > parts;
+        parts.reserve(partitions_.size());
+
+        std::uint64_t offset = 0;
+        for (partition_data const& p : partitions_)
+        {
+            parts.push_back(hpx::async<action_type>(
+                p.partition_, path, offset, stripe_size));
+            offset += p.size_ * sizeof(T);
+        }
+
+        wait_all(parts);
+        for (future<void>& f : parts)
+            f.get();            // rethrow exceptions
+    }
+
+    template <typename T, typename Data /*= std::vector<T> */>
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT void
+    partitioned_vector<T, Data>::save_helper(
+        std::string const& path, std::size_t stripe_size) const
+    {
+        typedef typename partitioned_vector_partition_server::save_data_action
+            action_type;
+
+#if !defined(HPX_WINDOWS)
+        // create the file with its final size, the partitions write into it
+        {
+            util::async_file file(path, O_WRONLY | O_CREAT | O_TRUNC);
+            if (::ftruncate(file.native_handle(), off_t(size_ * sizeof(T))))
+            {
+                HPX_THROW_EXCEPTION(hpx::filesystem_error,
+                    "partitioned_vector::save",
+                    "could not resize file: " + path);
+            }
+        }
+#endif
+
+        std::vector<future<void> > parts;
+        parts.reserve(partitions_.size());
+
+        std::uint64_t offset = 0;
+        for (partition_data const& p : partitions_)
+        {
+            parts.push_back(hpx::async<action_type>(
+                p.partition_, path, offset, stripe_size));
+            offset += p.size_ * sizeof(T);
+        }
+
+        wait_all(parts);
+        for (future<void>& f : parts)
+            f.get();            // rethrow exceptions
+    }
+
+    template <typename T, typename Data /*= std::vector<T> */>
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT hpx::future<void>
+    partitioned_vector<T, Data>::load(
+        std::string const& path, std::size_t stripe_size)
+    {
+        return hpx::async(&partitioned_vector::load_helper, this, path,
+            stripe_size);
+    }
+
+    template <typename T, typename Data /*= std::vector<T> */>
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT void
+    partitioned_vector<T, Data>::load(launch::sync_policy,
+        std::string const& path, std::size_t stripe_size)
+    {
+        load_helper(path, stripe_size);
+    }
+
+    template <typename T, typename Data /*= std::vector<T> */>
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT hpx::future<void>
+    partitioned_vector<T, Data>::save(
+        std::string const& path, std::size_t stripe_size) const
+    {
+        return hpx::async(&partitioned_vector::save_helper, this, path,
+            stripe_size);
+    }
+
+    template <typename T, typename Data /*= std::vector<T> */>
+    HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT void
+    partitioned_vector<T, Data>::save(launch::sync_policy,
+        std::string const& path, std::size_t stripe_size) const
+    {
+        save_helper(path, stripe_size);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename T, typename Data /*= std::vector<T> */>
     HPX_PARTITIONED_VECTOR_SPECIALIZATION_EXPORT
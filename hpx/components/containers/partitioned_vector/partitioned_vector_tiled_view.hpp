@@ -0,0 +1,526 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file hpx/components/partitioned_vector/partitioned_vector_tiled_view.hpp
+
+#ifndef HPX_PARTITIONED_VECTOR_TILED_VIEW_HPP
+#define HPX_PARTITIONED_VECTOR_TILED_VIEW_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/when_all.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <hpx/components/containers/container_distribution_policy.hpp>
+#include <hpx/components/containers/partitioned_vector/partitioned_vector_component_decl.hpp>
+#include <hpx/components/containers/partitioned_vector/partitioned_vector_decl.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx
+{
+    /// This class describes a two-dimensional matrix stored as tiles which
+    /// are distributed block-cyclically over a grid of localities.
+    ///
+    /// The matrix of \a rows x \a cols elements is split into tiles of
+    /// \a tile_rows x \a tile_cols elements (the tiles at the right and the
+    /// bottom border are padded). The tiles are numbered row-major, the tile
+    /// (ti, tj) is placed on the locality (ti % grid_rows, tj % grid_cols)
+    /// of the grid of localities, which is numbered row-major as well. The
+    /// elements of a tile are stored row-major in one partition.
+    ///
+    struct tiled_layout
+    {
+        tiled_layout()
+          : rows_(0), cols_(0), tile_rows_(1), tile_cols_(1),
+            grid_rows_(1), grid_cols_(1)
+        {}
+
+        tiled_layout(std::size_t rows, std::size_t cols,
+                std::size_t tile_rows, std::size_t tile_cols,
+                std::size_t grid_rows = 1, std::size_t grid_cols = 1)
+          : rows_(rows), cols_(cols),
+            tile_rows_(tile_rows), tile_cols_(tile_cols),
+            grid_rows_(grid_rows), grid_cols_(grid_cols)
+        {
+            if (tile_rows == 0 || tile_cols == 0 || grid_rows == 0 ||
+                grid_cols == 0)
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "hpx::tiled_layout::tiled_layout",
+                    "the sizes of the tiles and of the grid of localities "
+                    "must be larger than zero");
+            }
+        }
+
+        std::size_t rows() const { return rows_; }
+        std::size_t cols() const { return cols_; }
+        std::size_t tile_rows() const { return tile_rows_; }
+        std::size_t tile_cols() const { return tile_cols_; }
+        std::size_t grid_rows() const { return grid_rows_; }
+        std::size_t grid_cols() const { return grid_cols_; }
+
+        /// The number of tiles in each of the dimensions and overall.
+        std::size_t num_tile_rows() const
+        {
+            return (rows_ + tile_rows_ - 1) / tile_rows_;
+        }
+        std::size_t num_tile_cols() const
+        {
+            return (cols_ + tile_cols_ - 1) / tile_cols_;
+        }
+        std::size_t num_tiles() const
+        {
+            return num_tile_rows() * num_tile_cols();
+        }
+
+        /// The number of elements of each tile and of the vector holding the
+        /// tiles.
+        std::size_t tile_size() const
+        {
+            return tile_rows_ * tile_cols_;
+        }
+        std::size_t size() const
+        {
+            return num_tiles() * tile_size();
+        }
+
+        /// The sequence number of a tile, the index of the locality in the
+        /// grid holding it.
+        std::size_t get_tile(std::size_t ti, std::size_t tj) const
+        {
+            HPX_ASSERT(ti < num_tile_rows() && tj < num_tile_cols());
+            return ti * num_tile_cols() + tj;
+        }
+        std::size_t get_owner(std::size_t ti, std::size_t tj) const
+        {
+            return (ti % grid_rows_) * grid_cols_ + (tj % grid_cols_);
+        }
+
+        /// Return the distribution policy for a \a hpx::partitioned_vector
+        /// of \a size() elements which places the tiles on the given grid of
+        /// localities (grid_rows x grid_cols, numbered row-major).
+        container_distribution_policy get_policy(
+            std::vector<id_type> const& localities) const
+        {
+            if (localities.size() != grid_rows_ * grid_cols_)
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "hpx::tiled_layout::get_policy",
+                    "the number of localities does not match the size of "
+                    "the grid of localities");
+            }
+
+            // one entry for each of the tiles, in the order of the tiles
+            std::vector<id_type> tiles;
+            tiles.reserve(num_tiles());
+            for (std::size_t ti = 0; ti != num_tile_rows(); ++ti)
+            {
+                for (std::size_t tj = 0; tj != num_tile_cols(); ++tj)
+                    tiles.push_back(localities[get_owner(ti, tj)]);
+            }
+            return container_layout(num_tiles(), std::move(tiles));
+        }
+
+    private:
+        std::size_t rows_;
+        std::size_t cols_;
+        std::size_t tile_rows_;
+        std::size_t tile_cols_;
+        std::size_t grid_rows_;
+        std::size_t grid_cols_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// This class provides a two-dimensional view of a
+    /// \a hpx::partitioned_vector holding a matrix in the tiled layout
+    /// described by a \a hpx::tiled_layout. The vector has to be created with
+    /// \a tiled_layout::size() elements using the distribution policy
+    /// returned by \a tiled_layout::get_policy(), which gives every tile its
+    /// own partition.
+    ///
+    /// Whole tiles and rectangular sub-arrays are read and written with one
+    /// message per (remote) tile touched, the tiles located on the calling
+    /// locality are accessed directly. The local elements are visited tile
+    /// by tile, in blocks which fit into the cache.
+    ///
+    /// \tparam T   The type of the elements of the matrix.
+    /// \tparam Data The type of the data of the partitions.
+    ///
+    template <typename T, typename Data = std::vector<T> >
+    class partitioned_vector_tiled_view
+    {
+        typedef server::partitioned_vector<T, Data> partition_server;
+        typedef partitioned_vector_partition<T, Data> partition_client;
+
+        struct tile_data
+        {
+            hpx::id_type partition_;
+            std::uint32_t locality_id_;
+            std::shared_ptr<partition_server> local_data_;
+        };
+
+    public:
+        typedef T value_type;
+        typedef std::size_t size_type;
+
+        /// Create the view for the given vector, which has to stay alive as
+        /// long as the view is used.
+        partitioned_vector_tiled_view(partitioned_vector<T, Data>& v,
+                tiled_layout const& layout)
+          : layout_(layout)
+        {
+            if (v.size() != layout_.size() ||
+                std::size_t(std::distance(v.segment_begin(), v.segment_end()))
+                    != layout_.num_tiles())
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "hpx::partitioned_vector_tiled_view",
+                    "the vector was not created for the given tiled layout");
+            }
+
+            tiles_.reserve(layout_.num_tiles());
+            auto end = v.segment_end();
+            for (auto it = v.segment_begin(); it != end; ++it)
+            {
+                tile_data tile = { it->partition_, it->locality_id_,
+                    it->local_data_ };
+                tiles_.push_back(std::move(tile));
+            }
+        }
+
+        tiled_layout const& get_layout() const
+        {
+            return layout_;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Return whether the given tile is located on this locality.
+        bool is_local_tile(std::size_t ti, std::size_t tj) const
+        {
+            return !!tile(ti, tj).local_data_;
+        }
+
+        /// Return the data of a tile located on this locality.
+        Data& local_tile(std::size_t ti, std::size_t tj)
+        {
+            HPX_ASSERT(is_local_tile(ti, tj));
+            return tile(ti, tj).local_data_->get_data();
+        }
+        Data const& local_tile(std::size_t ti, std::size_t tj) const
+        {
+            HPX_ASSERT(is_local_tile(ti, tj));
+            return tile(ti, tj).local_data_->get_data();
+        }
+
+        /// Return a copy of the given tile, fetched with a single message if
+        /// the tile is not located on this locality.
+        hpx::future<Data> get_tile(std::size_t ti, std::size_t tj) const
+        {
+            tile_data const& t = tile(ti, tj);
+            if (t.local_data_)
+                return hpx::make_ready_future(Data(t.local_data_->get_data()));
+
+            return partition_client(t.partition_).get_copied_data();
+        }
+
+        Data get_tile(launch::sync_policy, std::size_t ti, std::size_t tj) const
+        {
+            return get_tile(ti, tj).get();
+        }
+
+        /// Replace the contents of the given tile, sent with a single
+        /// message if the tile is not located on this locality.
+        hpx::future<void> put_tile(std::size_t ti, std::size_t tj, Data data)
+        {
+            if (data.size() != layout_.tile_size())
+            {
+                return hpx::make_exceptional_future<void>(
+                    HPX_GET_EXCEPTION(bad_parameter,
+                        "hpx::partitioned_vector_tiled_view::put_tile",
+                        "the size of the data does not match the size of "
+                        "the tiles"));
+            }
+
+            tile_data const& t = tile(ti, tj);
+            if (t.local_data_)
+            {
+                t.local_data_->get_data() = std::move(data);
+                return hpx::make_ready_future();
+            }
+
+            return partition_client(t.partition_).set_data(std::move(data));
+        }
+
+        void put_tile(launch::sync_policy, std::size_t ti, std::size_t tj,
+            Data data)
+        {
+            put_tile(ti, tj, std::move(data)).get();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Return the sub-array of \a nrows x \a ncols elements starting at
+        /// the element (row, col), stored row-major. The elements are fetched
+        /// with one message per remote tile.
+        hpx::future<std::vector<T> > get(std::size_t row, std::size_t col,
+            std::size_t nrows, std::size_t ncols) const
+        {
+            check_region(row, col, nrows, ncols, "get");
+
+            std::shared_ptr<std::vector<T> > result =
+                std::make_shared<std::vector<T> >(nrows * ncols);
+
+            std::vector<hpx::future<void> > remote;
+            for_each_tile_region(row, col, nrows, ncols,
+                [&](tile_data const& t, region const& r)
+                {
+                    if (t.local_data_)
+                    {
+                        Data const& data = t.local_data_->get_data();
+                        for (std::size_t i = 0; i != r.rows_; ++i)
+                        {
+                            std::size_t src = (r.tile_row_ + i) *
+                                layout_.tile_cols() + r.tile_col_;
+                            std::size_t dest = (r.row_ + i) * ncols + r.col_;
+                            std::copy_n(data.begin() + src, r.cols_,
+                                result->begin() + dest);
+                        }
+                        return;
+                    }
+
+                    remote.push_back(partition_client(t.partition_)
+                        .get_values(tile_indices(r))
+                        .then(hpx::launch::sync,
+                            [result, r, ncols](
+                                hpx::future<std::vector<T> > f)
+                            {
+                                std::vector<T> values = f.get();
+                                auto src = values.begin();
+                                for (std::size_t i = 0; i != r.rows_; ++i)
+                                {
+                                    std::size_t dest =
+                                        (r.row_ + i) * ncols + r.col_;
+                                    std::copy_n(src, r.cols_,
+                                        result->begin() + dest);
+                                    src += r.cols_;
+                                }
+                            }));
+                });
+
+            return hpx::when_all(remote).then(hpx::launch::sync,
+                [result](hpx::future<std::vector<hpx::future<void> > > f)
+                {
+                    for (hpx::future<void>& r : f.get())
+                        r.get();
+                    return std::move(*result);
+                });
+        }
+
+        std::vector<T> get(launch::sync_policy, std::size_t row,
+            std::size_t col, std::size_t nrows, std::size_t ncols) const
+        {
+            return get(row, col, nrows, ncols).get();
+        }
+
+        /// Write the given sub-array of \a nrows x \a ncols elements (stored
+        /// row-major) starting at the element (row, col). The elements are
+        /// sent with one message per remote tile.
+        hpx::future<void> put(std::size_t row, std::size_t col,
+            std::size_t nrows, std::size_t ncols, std::vector<T> const& values)
+        {
+            check_region(row, col, nrows, ncols, "put");
+            if (values.size() != nrows * ncols)
+            {
+                return hpx::make_exceptional_future<void>(
+                    HPX_GET_EXCEPTION(bad_parameter,
+                        "hpx::partitioned_vector_tiled_view::put",
+                        "the number of values does not match the size of "
+                        "the sub-array"));
+            }
+
+            std::vector<hpx::future<void> > remote;
+            for_each_tile_region(row, col, nrows, ncols,
+                [&](tile_data const& t, region const& r)
+                {
+                    if (t.local_data_)
+                    {
+                        Data& data = t.local_data_->get_data();
+                        for (std::size_t i = 0; i != r.rows_; ++i)
+                        {
+                            std::size_t src = (r.row_ + i) * ncols + r.col_;
+                            std::size_t dest = (r.tile_row_ + i) *
+                                layout_.tile_cols() + r.tile_col_;
+                            std::copy_n(values.begin() + src, r.cols_,
+                                data.begin() + dest);
+                        }
+                        return;
+                    }
+
+                    std::vector<T> part;
+                    part.reserve(r.rows_ * r.cols_);
+                    for (std::size_t i = 0; i != r.rows_; ++i)
+                    {
+                        auto src = values.begin() + (r.row_ + i) * ncols +
+                            r.col_;
+                        part.insert(part.end(), src, src + r.cols_);
+                    }
+
+                    remote.push_back(partition_client(t.partition_)
+                        .set_values(tile_indices(r), part));
+                });
+
+            return hpx::when_all(remote).then(hpx::launch::sync,
+                [](hpx::future<std::vector<hpx::future<void> > > f)
+                {
+                    for (hpx::future<void>& r : f.get())
+                        r.get();
+                });
+        }
+
+        void put(launch::sync_policy, std::size_t row, std::size_t col,
+            std::size_t nrows, std::size_t ncols, std::vector<T> const& values)
+        {
+            put(row, col, nrows, ncols, values).get();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Call f(row, col, element) for the elements of all tiles located on
+        /// this locality (without the padding). The tiles are visited one
+        /// after the other, each of them in blocks of \a block_rows x
+        /// \a block_cols elements (the whole tile by default).
+        template <typename F>
+        void for_each_local(F && f, std::size_t block_rows = 0,
+            std::size_t block_cols = 0)
+        {
+            std::size_t const tile_rows = layout_.tile_rows();
+            std::size_t const tile_cols = layout_.tile_cols();
+            if (block_rows == 0)
+                block_rows = tile_rows;
+            if (block_cols == 0)
+                block_cols = tile_cols;
+
+            for (std::size_t ti = 0; ti != layout_.num_tile_rows(); ++ti)
+            {
+                for (std::size_t tj = 0; tj != layout_.num_tile_cols(); ++tj)
+                {
+                    if (!is_local_tile(ti, tj))
+                        continue;
+
+                    Data& data = local_tile(ti, tj);
+
+                    std::size_t rows = (std::min)(tile_rows,
+                        layout_.rows() - ti * tile_rows);
+                    std::size_t cols = (std::min)(tile_cols,
+                        layout_.cols() - tj * tile_cols);
+
+                    for (std::size_t bi = 0; bi < rows; bi += block_rows)
+                    {
+                        std::size_t ei = (std::min)(bi + block_rows, rows);
+                        for (std::size_t bj = 0; bj < cols; bj += block_cols)
+                        {
+                            std::size_t ej = (std::min)(bj + block_cols, cols);
+                            for (std::size_t i = bi; i != ei; ++i)
+                            {
+                                for (std::size_t j = bj; j != ej; ++j)
+                                {
+                                    f(ti * tile_rows + i, tj * tile_cols + j,
+                                        data[i * tile_cols + j]);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+    private:
+        // The part of a sub-array covered by one tile: its position in the
+        // sub-array, in the tile, and its size.
+        struct region
+        {
+            std::size_t row_, col_;
+            std::size_t tile_row_, tile_col_;
+            std::size_t rows_, cols_;
+        };
+
+        tile_data const& tile(std::size_t ti, std::size_t tj) const
+        {
+            return tiles_[layout_.get_tile(ti, tj)];
+        }
+
+        void check_region(std::size_t row, std::size_t col, std::size_t nrows,
+            std::size_t ncols, char const* name) const
+        {
+            if (row + nrows > layout_.rows() || col + ncols > layout_.cols())
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    std::string("hpx::partitioned_vector_tiled_view::") + name,
+                    "the sub-array exceeds the bounds of the matrix");
+            }
+        }
+
+        // Call f for each of the tiles covered by the given sub-array.
+        template <typename F>
+        void for_each_tile_region(std::size_t row, std::size_t col,
+            std::size_t nrows, std::size_t ncols, F && f) const
+        {
+            std::size_t const tile_rows = layout_.tile_rows();
+            std::size_t const tile_cols = layout_.tile_cols();
+
+            for (std::size_t r = row; r < row + nrows; /**/)
+            {
+                std::size_t ti = r / tile_rows;
+                std::size_t rows =
+                    (std::min)((ti + 1) * tile_rows, row + nrows) - r;
+
+                for (std::size_t c = col; c < col + ncols; /**/)
+                {
+                    std::size_t tj = c / tile_cols;
+                    std::size_t cols =
+                        (std::min)((tj + 1) * tile_cols, col + ncols) - c;
+
+                    region reg = { r - row, c - col,
+                        r - ti * tile_rows, c - tj * tile_cols, rows, cols };
+                    f(tile(ti, tj), reg);
+
+                    c += cols;
+                }
+                r += rows;
+            }
+        }
+
+        // The indices of the elements of the given region inside its tile.
+        std::vector<std::size_t> tile_indices(region const& r) const
+        {
+            std::vector<std::size_t> indices;
+            indices.reserve(r.rows_ * r.cols_);
+            for (std::size_t i = 0; i != r.rows_; ++i)
+            {
+                std::size_t base = (r.tile_row_ + i) * layout_.tile_cols() +
+                    r.tile_col_;
+                for (std::size_t j = 0; j != r.cols_; ++j)
+                    indices.push_back(base + j);
+            }
+            return indices;
+        }
+
+    private:
+        tiled_layout layout_;
+        std::vector<tile_data> tiles_;
+    };
+}
+
+#endif
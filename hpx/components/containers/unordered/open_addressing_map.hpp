@@ -0,0 +1,757 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file hpx/components/unordered/open_addressing_map.hpp
+
+#if !defined(HPX_OPEN_ADDRESSING_MAP_HPP)
+#define HPX_OPEN_ADDRESSING_MAP_HPP
+
+/// \brief The storage of the partitions of hpx::unordered_map.
+///
+/// The open_addressing_map is a hash table storing its elements inline in a
+/// flat array of slots. Each slot has a control byte holding seven bits of
+/// the hash of its element (or marking the slot as empty or deleted). A
+/// lookup probes groups of eight control bytes at once, comparing the keys
+/// only for the slots whose control byte matches.
+///
+/// The table is split into a fixed number of shards, each protected by its
+/// own spinlock. The shard of an element is selected by the high bits of its
+/// hash, operations on elements of different shards proceed concurrently.
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/iterator_facade.hpp>
+#include <hpx/util/optional.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace server
+{
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+        struct open_addressing_group
+        {
+            static std::size_t const width = 8;
+
+            static std::uint8_t const empty = 0x80;
+            static std::uint8_t const deleted = 0xfe;
+
+            static std::uint64_t const lsbs = 0x0101010101010101ull;
+            static std::uint64_t const msbs = 0x8080808080808080ull;
+
+            explicit open_addressing_group(std::uint8_t const* ctrl)
+            {
+                std::memcpy(&ctrl_, ctrl, sizeof(ctrl_));
+            }
+
+            // the slots whose control byte is h2, this may include some
+            // false positives which are rejected by comparing the keys
+            std::uint64_t match(std::uint8_t h2) const
+            {
+                std::uint64_t x = ctrl_ ^ (lsbs * h2);
+                return (x - lsbs) & ~x & msbs;
+            }
+
+            std::uint64_t match_empty() const
+            {
+                return ctrl_ & (~ctrl_ << 6) & msbs;
+            }
+
+            std::uint64_t match_empty_or_deleted() const
+            {
+                return ctrl_ & msbs;
+            }
+
+            // the position of the first slot marked in the given mask
+            static std::size_t first(std::uint64_t mask)
+            {
+                std::uint8_t bytes[width];
+                std::memcpy(bytes, &mask, sizeof(bytes));
+
+                std::size_t i = 0;
+                while (!(bytes[i] & 0x80))
+                    ++i;
+                return i;
+            }
+
+            // remove the first slot from the given mask
+            static std::uint64_t next(std::uint64_t mask)
+            {
+                std::uint8_t bytes[width];
+                std::memcpy(bytes, &mask, sizeof(bytes));
+                bytes[first(mask)] = 0;
+                std::memcpy(&mask, bytes, sizeof(bytes));
+                return mask;
+            }
+
+            std::uint64_t ctrl_;
+        };
+
+        template <typename Map, typename Value>
+        class open_addressing_map_iterator;
+        /// \endcond
+    }
+
+    /// \brief The hash table storing the elements of a partition of
+    ///        hpx::unordered_map.
+    ///
+    /// The member functions looking up or modifying single elements are
+    /// thread-safe. Iterating over the table, copying, and serializing it
+    /// is not safe while other threads modify the table.
+    template <typename Key, typename T, typename Hash = std::hash<Key>,
+        typename KeyEqual = std::equal_to<Key> >
+    class open_addressing_map
+    {
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef std::pair<Key const, T> value_type;
+        typedef std::size_t size_type;
+        typedef Hash hasher;
+        typedef KeyEqual key_equal;
+
+        typedef detail::open_addressing_map_iterator<
+                open_addressing_map, value_type
+            > iterator;
+        typedef detail::open_addressing_map_iterator<
+                open_addressing_map const, value_type const
+            > const_iterator;
+
+    private:
+        typedef detail::open_addressing_group group;
+        typedef hpx::lcos::local::spinlock mutex_type;
+        typedef typename std::aligned_storage<
+                sizeof(value_type), alignof(value_type)
+            >::type slot_type;
+
+        template <typename Map, typename Value>
+        friend class detail::open_addressing_map_iterator;
+
+        static size_type const num_shards = 16;
+
+        // the parts of the hash used for selecting the shard, the first
+        // group to probe, and the control byte of an element
+        struct hash_parts
+        {
+            explicit hash_parts(std::size_t h)
+            {
+                std::uint64_t x = h;
+                x ^= x >> 33;
+                x *= 0xff51afd7ed558ccdull;
+                x ^= x >> 33;
+
+                shard_ = static_cast<size_type>(x >> 32) % num_shards;
+                h1_ = static_cast<size_type>(x >> 7);
+                h2_ = static_cast<std::uint8_t>(x & 0x7f);
+            }
+
+            size_type shard_;
+            size_type h1_;
+            std::uint8_t h2_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        class shard
+        {
+        public:
+            static size_type const npos = size_type(-1);
+
+            shard()
+              : capacity_(0), size_(0), deleted_(0)
+            {}
+
+            ~shard()
+            {
+                destroy_all();
+            }
+
+            shard(shard const&) = delete;
+            shard& operator=(shard const&) = delete;
+
+            void copy_from(shard const& rhs)
+            {
+                HPX_ASSERT(capacity_ == 0);
+                if (rhs.capacity_ == 0)
+                    return;
+
+                // the deleted slots are kept, the elements have to stay
+                // reachable along their probe sequences
+                allocate(rhs.capacity_);
+                for (size_type i = 0; i != rhs.capacity_; ++i)
+                {
+                    if (rhs.is_full(i))
+                    {
+                        ::new (static_cast<void*>(&slots_[i]))
+                            value_type(rhs.value(i));
+                        ++size_;
+                    }
+                    ctrl_[i] = rhs.ctrl_[i];
+                }
+                deleted_ = rhs.deleted_;
+            }
+
+            void swap(shard& rhs)
+            {
+                std::swap(ctrl_, rhs.ctrl_);
+                std::swap(slots_, rhs.slots_);
+                std::swap(capacity_, rhs.capacity_);
+                std::swap(size_, rhs.size_);
+                std::swap(deleted_, rhs.deleted_);
+            }
+
+            size_type size() const
+            {
+                return size_;
+            }
+
+            size_type capacity() const
+            {
+                return capacity_;
+            }
+
+            bool is_full(size_type i) const
+            {
+                return !(ctrl_[i] & 0x80);
+            }
+
+            value_type& value(size_type i)
+            {
+                return *reinterpret_cast<value_type*>(&slots_[i]);
+            }
+            value_type const& value(size_type i) const
+            {
+                return *reinterpret_cast<value_type const*>(&slots_[i]);
+            }
+
+            // the first full slot at or after i, capacity() if none
+            size_type next_full(size_type i) const
+            {
+                while (i != capacity_ && !is_full(i))
+                    ++i;
+                return i;
+            }
+
+            size_type find(Key const& key, hash_parts const& h,
+                KeyEqual const& eq) const
+            {
+                if (capacity_ == 0)
+                    return npos;
+
+                size_type const mask = capacity_ / group::width - 1;
+                size_type g = h.h1_ & mask;
+                for (size_type step = 1; /**/; ++step)
+                {
+                    size_type const base = g * group::width;
+                    group grp(&ctrl_[base]);
+
+                    for (std::uint64_t m = grp.match(h.h2_); m != 0;
+                         m = group::next(m))
+                    {
+                        size_type i = base + group::first(m);
+                        if (eq(value(i).first, key))
+                            return i;
+                    }
+
+                    if (grp.match_empty() != 0)
+                        return npos;
+
+                    g = (g + step) & mask;
+                }
+            }
+
+            // insert a new element, the key must not be present yet
+            template <typename K, typename V>
+            size_type insert(K && key, V && val, hash_parts const& h,
+                Hash const& hash)
+            {
+                if (2 * (size_ + 1) > capacity_ - capacity_ / 8 ||
+                    size_ + deleted_ + 1 > capacity_ - capacity_ / 8)
+                {
+                    // grow the table if the elements occupy more than half
+                    // of the usable slots, otherwise just drop the deleted
+                    // slots
+                    size_type new_capacity = capacity_;
+                    if (2 * (size_ + 1) > capacity_ - capacity_ / 8)
+                        new_capacity = capacity_ == 0 ? 2 * group::width :
+                            2 * capacity_;
+                    rehash(new_capacity, hash);
+                }
+
+                size_type i = find_insert_slot(h);
+                ::new (static_cast<void*>(&slots_[i])) value_type(
+                    std::forward<K>(key), std::forward<V>(val));
+
+                if (ctrl_[i] == group::deleted)
+                    --deleted_;
+                ctrl_[i] = h.h2_;
+                ++size_;
+                return i;
+            }
+
+            void erase(size_type i)
+            {
+                value(i).~value_type();
+                ctrl_[i] = group::deleted;
+                --size_;
+                ++deleted_;
+            }
+
+            void clear()
+            {
+                for (size_type i = 0; i != capacity_; ++i)
+                {
+                    if (is_full(i))
+                        value(i).~value_type();
+                    ctrl_[i] = group::empty;
+                }
+                size_ = 0;
+                deleted_ = 0;
+            }
+
+            void reserve(size_type count, Hash const& hash)
+            {
+                size_type new_capacity = capacity_ == 0 ?
+                    2 * group::width : capacity_;
+                while (2 * count > new_capacity - new_capacity / 8)
+                    new_capacity *= 2;
+
+                if (new_capacity != capacity_)
+                    rehash(new_capacity, hash);
+            }
+
+            mutable mutex_type mtx_;
+
+        private:
+            size_type find_insert_slot(hash_parts const& h) const
+            {
+                size_type const mask = capacity_ / group::width - 1;
+                size_type g = h.h1_ & mask;
+                for (size_type step = 1; /**/; ++step)
+                {
+                    size_type const base = g * group::width;
+                    std::uint64_t m =
+                        group(&ctrl_[base]).match_empty_or_deleted();
+                    if (m != 0)
+                        return base + group::first(m);
+
+                    g = (g + step) & mask;
+                }
+            }
+
+            void allocate(size_type capacity)
+            {
+                ctrl_.reset(new std::uint8_t[capacity]);
+                std::memset(ctrl_.get(), group::empty, capacity);
+                slots_.reset(new slot_type[capacity]);
+                capacity_ = capacity;
+                size_ = 0;
+                deleted_ = 0;
+            }
+
+            void rehash(size_type new_capacity, Hash const& hash)
+            {
+                std::unique_ptr<std::uint8_t[]> old_ctrl = std::move(ctrl_);
+                std::unique_ptr<slot_type[]> old_slots = std::move(slots_);
+                size_type old_capacity = capacity_;
+
+                allocate(new_capacity);
+
+                for (size_type i = 0; i != old_capacity; ++i)
+                {
+                    if (old_ctrl[i] & 0x80)
+                        continue;
+
+                    value_type& v =
+                        *reinterpret_cast<value_type*>(&old_slots[i]);
+
+                    hash_parts h(hash(v.first));
+                    size_type j = find_insert_slot(h);
+                    ::new (static_cast<void*>(&slots_[j]))
+                        value_type(std::move(v));
+                    ctrl_[j] = h.h2_;
+                    ++size_;
+
+                    v.~value_type();
+                }
+            }
+
+            void destroy_all()
+            {
+                for (size_type i = 0; i != capacity_; ++i)
+                {
+                    if (is_full(i))
+                        value(i).~value_type();
+                }
+            }
+
+            std::unique_ptr<std::uint8_t[]> ctrl_;
+            std::unique_ptr<slot_type[]> slots_;
+            size_type capacity_;
+            size_type size_;
+            size_type deleted_;
+        };
+
+        typedef std::unique_lock<mutex_type> lock_type;
+
+    public:
+        ///////////////////////////////////////////////////////////////////////
+        explicit open_addressing_map(size_type bucket_count = 0,
+                Hash const& hash = Hash(), KeyEqual const& equal = KeyEqual())
+          : hash_(hash), equal_(equal), shards_(new shard[num_shards])
+        {
+            if (bucket_count != 0)
+                reserve(bucket_count);
+        }
+
+        open_addressing_map(open_addressing_map const& rhs)
+          : hash_(rhs.hash_), equal_(rhs.equal_),
+            shards_(new shard[num_shards])
+        {
+            for (size_type s = 0; s != num_shards; ++s)
+            {
+                lock_type l(rhs.shards_[s].mtx_);
+                shards_[s].copy_from(rhs.shards_[s]);
+            }
+        }
+
+        open_addressing_map(open_addressing_map && rhs)
+          : hash_(rhs.hash_), equal_(rhs.equal_),
+            shards_(new shard[num_shards])
+        {
+            for (size_type s = 0; s != num_shards; ++s)
+                shards_[s].swap(rhs.shards_[s]);
+        }
+
+        // the assignments replace the elements of each of the shards while
+        // holding its lock
+        open_addressing_map& operator=(open_addressing_map const& rhs)
+        {
+            if (this != &rhs)
+                *this = open_addressing_map(rhs);
+            return *this;
+        }
+
+        open_addressing_map& operator=(open_addressing_map && rhs)
+        {
+            if (this != &rhs)
+            {
+                hash_ = rhs.hash_;
+                equal_ = rhs.equal_;
+                for (size_type s = 0; s != num_shards; ++s)
+                {
+                    shard old;
+                    {
+                        lock_type l(shards_[s].mtx_);
+                        shards_[s].swap(old);
+                        shards_[s].swap(rhs.shards_[s]);
+                    }
+                }
+            }
+            return *this;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Returns the number of elements
+        size_type size() const
+        {
+            size_type result = 0;
+            for (size_type s = 0; s != num_shards; ++s)
+            {
+                lock_type l(shards_[s].mtx_);
+                result += shards_[s].size();
+            }
+            return result;
+        }
+
+        /// Checks if the container has no elements
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        /// Returns the maximum possible number of elements
+        size_type max_size() const
+        {
+            return (std::numeric_limits<size_type>::max)() /
+                (2 * sizeof(slot_type));
+        }
+
+        /// Returns the number of slots currently allocated
+        size_type capacity() const
+        {
+            size_type result = 0;
+            for (size_type s = 0; s != num_shards; ++s)
+            {
+                lock_type l(shards_[s].mtx_);
+                result += shards_[s].capacity();
+            }
+            return result;
+        }
+
+        /// Allocate space for at least \a count elements
+        void reserve(size_type count)
+        {
+            size_type per_shard = (count + num_shards - 1) / num_shards;
+            for (size_type s = 0; s != num_shards; ++s)
+            {
+                lock_type l(shards_[s].mtx_);
+                shards_[s].reserve(per_shard, hash_);
+            }
+        }
+
+        /// Remove all elements
+        void clear()
+        {
+            for (size_type s = 0; s != num_shards; ++s)
+            {
+                lock_type l(shards_[s].mtx_);
+                shards_[s].clear();
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Returns the number of elements with the given key (0 or 1)
+        size_type count(Key const& key) const
+        {
+            hash_parts h(hash_(key));
+            shard& sh = shards_[h.shard_];
+
+            lock_type l(sh.mtx_);
+            return sh.find(key, h, equal_) == shard::npos ? 0 : 1;
+        }
+
+        /// Returns a copy of the value of the element with the given key, if
+        /// it exists.
+        hpx::util::optional<T> get(Key const& key) const
+        {
+            hash_parts h(hash_(key));
+            shard& sh = shards_[h.shard_];
+
+            lock_type l(sh.mtx_);
+            size_type i = sh.find(key, h, equal_);
+            if (i == shard::npos)
+                return hpx::util::optional<T>();
+            return hpx::util::optional<T>(sh.value(i).second);
+        }
+
+        /// Removes the element with the given key, if it exists, and returns
+        /// its value.
+        hpx::util::optional<T> take(Key const& key)
+        {
+            hash_parts h(hash_(key));
+            shard& sh = shards_[h.shard_];
+
+            lock_type l(sh.mtx_);
+            size_type i = sh.find(key, h, equal_);
+            if (i == shard::npos)
+                return hpx::util::optional<T>();
+
+            hpx::util::optional<T> result(std::move(sh.value(i).second));
+            sh.erase(i);
+            return result;
+        }
+
+        /// Stores \a val as the value of the element with the given key,
+        /// the element is inserted if it does not exist yet.
+        template <typename T_>
+        void insert_or_assign(Key const& key, T_ && val)
+        {
+            hash_parts h(hash_(key));
+            shard& sh = shards_[h.shard_];
+
+            lock_type l(sh.mtx_);
+            size_type i = sh.find(key, h, equal_);
+            if (i == shard::npos)
+                sh.insert(key, std::forward<T_>(val), h, hash_);
+            else
+                sh.value(i).second = std::forward<T_>(val);
+        }
+
+        /// Invokes \a f with a reference to the value of the element with
+        /// the given key while holding the lock protecting it, a missing
+        /// element is value initialized first.
+        template <typename F>
+        void update(Key const& key, F && f)
+        {
+            hash_parts h(hash_(key));
+            shard& sh = shards_[h.shard_];
+
+            lock_type l(sh.mtx_);
+            size_type i = sh.find(key, h, equal_);
+            if (i == shard::npos)
+                i = sh.insert(key, T(), h, hash_);
+            f(sh.value(i).second);
+        }
+
+        /// Removes the element with the given key, returns the number of
+        /// elements removed (0 or 1).
+        size_type erase(Key const& key)
+        {
+            hash_parts h(hash_(key));
+            shard& sh = shards_[h.shard_];
+
+            lock_type l(sh.mtx_);
+            size_type i = sh.find(key, h, equal_);
+            if (i == shard::npos)
+                return 0;
+
+            sh.erase(i);
+            return 1;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        iterator begin()
+        {
+            return iterator(this, 0, 0);
+        }
+        const_iterator begin() const
+        {
+            return const_iterator(this, 0, 0);
+        }
+        const_iterator cbegin() const
+        {
+            return const_iterator(this, 0, 0);
+        }
+
+        iterator end()
+        {
+            return iterator(this, num_shards, 0);
+        }
+        const_iterator end() const
+        {
+            return const_iterator(this, num_shards, 0);
+        }
+        const_iterator cend() const
+        {
+            return const_iterator(this, num_shards, 0);
+        }
+
+    private:
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        void save(Archive& ar, unsigned) const
+        {
+            size_type count = size();
+            ar << count;
+            for (value_type const& v : *this)
+                ar << v.first << v.second;
+        }
+
+        template <typename Archive>
+        void load(Archive& ar, unsigned)
+        {
+            clear();
+
+            size_type count = 0;
+            ar >> count;
+            reserve(count);
+
+            for (size_type i = 0; i != count; ++i)
+            {
+                Key key;
+                T val;
+                ar >> key >> val;
+                insert_or_assign(key, std::move(val));
+            }
+        }
+
+        HPX_SERIALIZATION_SPLIT_MEMBER()
+
+        Hash hash_;
+        KeyEqual equal_;
+        std::unique_ptr<shard[]> shards_;
+    };
+
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+        template <typename Map, typename Value>
+        class open_addressing_map_iterator
+          : public hpx::util::iterator_facade<
+                open_addressing_map_iterator<Map, Value>, Value,
+                std::forward_iterator_tag
+            >
+        {
+        public:
+            open_addressing_map_iterator()
+              : map_(nullptr), shard_(0), slot_(0)
+            {}
+
+            open_addressing_map_iterator(Map* map, std::size_t shard,
+                    std::size_t slot)
+              : map_(map), shard_(shard), slot_(slot)
+            {
+                satisfy();
+            }
+
+            // iterators convert to const_iterators
+            template <typename OtherMap, typename OtherValue,
+                typename Enable = typename std::enable_if<
+                    std::is_convertible<OtherMap*, Map*>::value
+                >::type>
+            open_addressing_map_iterator(
+                    open_addressing_map_iterator<OtherMap, OtherValue> const& rhs)
+              : map_(rhs.map_), shard_(rhs.shard_), slot_(rhs.slot_)
+            {}
+
+        private:
+            friend class hpx::util::iterator_core_access;
+
+            template <typename OtherMap, typename OtherValue>
+            friend class open_addressing_map_iterator;
+
+            Value& dereference() const
+            {
+                return map_->shards_[shard_].value(slot_);
+            }
+
+            bool equal(open_addressing_map_iterator const& other) const
+            {
+                return shard_ == other.shard_ && slot_ == other.slot_;
+            }
+
+            void increment()
+            {
+                ++slot_;
+                satisfy();
+            }
+
+            // move to the next full slot, the end is (num_shards, 0)
+            void satisfy()
+            {
+                while (shard_ != Map::num_shards)
+                {
+                    slot_ = map_->shards_[shard_].next_full(slot_);
+                    if (slot_ != map_->shards_[shard_].capacity())
+                        return;
+
+                    ++shard_;
+                    slot_ = 0;
+                }
+            }
+
+            Map* map_;
+            std::size_t shard_;
+            std::size_t slot_;
+        };
+        /// \endcond
+    }
+}}
+
+#endif
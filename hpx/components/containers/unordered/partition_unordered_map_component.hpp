@@ -12,8 +12,8 @@
 ///
 /// \brief The partition_unordered_map as the hpx component is defined here.
 ///
-/// The partition_unordered_map is the wrapper to the stl unordered_map class
-/// except all API'are defined as component action. All the API's in client
+/// The partition_unordered_map stores its elements in an open_addressing_map,
+/// all API's are defined as component actions. All the API's in client
 /// classes are asynchronous API which return the futures.
 
 #include <hpx/config.hpp>
@@ -23,48 +23,96 @@
 #include <hpx/runtime/actions/plain_action.hpp>
 #include <hpx/runtime/components/client_base.hpp>
 #include <hpx/runtime/components/component_factory.hpp>
-#include <hpx/runtime/components/server/locking_hook.hpp>
 #include <hpx/runtime/components/server/simple_component_base.hpp>
 #include <hpx/runtime/get_ptr.hpp>
 #include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/serialization/optional.hpp>
 #include <hpx/throw_exception.hpp>
+#include <hpx/util/always_void.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/detail/pp/cat.hpp>
 #include <hpx/util/detail/pp/expand.hpp>
 #include <hpx/util/detail/pp/nargs.hpp>
+#include <hpx/util/optional.hpp>
+
+#include <hpx/components/containers/unordered/open_addressing_map.hpp>
 
 #include <cstddef>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <tuple>
-#include <unordered_map>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace hpx { namespace server
 {
-    /// \brief This is the basic wrapper class for stl unordered_map.
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+        template <typename T, typename Enable = void>
+        struct has_plus_assign
+          : std::false_type
+        {};
+
+        template <typename T>
+        struct has_plus_assign<T, typename hpx::util::always_void<
+                decltype(std::declval<T&>() += std::declval<T const&>())
+            >::type>
+          : std::true_type
+        {};
+
+        template <typename T>
+        struct add_delta
+        {
+            void operator()(T& value) const
+            {
+                call(value, has_plus_assign<T>());
+            }
+
+            void call(T& value, std::true_type) const
+            {
+                value += delta_;
+            }
+
+            void call(T&, std::false_type) const
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "partition_unordered_map::update_values",
+                    "the values of this unordered_map can't be updated, "
+                    "those don't support operator+=");
+            }
+
+            T const& delta_;
+        };
+        /// \endcond
+    }
+
+    /// \brief This is the basic wrapper class for the storage of the
+    ///        partitions.
     ///
     /// This contain the implementation of the partition_unordered_map's
-    /// component functionality.
+    /// component functionality. The data is stored in an
+    /// open_addressing_map, which synchronizes the accesses to its elements
+    /// itself. The actions operating on different elements of the same
+    /// partition execute concurrently.
     template <typename Key, typename T, typename Hash = std::hash<Key>,
         typename KeyEqual = std::equal_to<Key> >
     class partition_unordered_map
-      : public components::locking_hook<
-            hpx::components::simple_component_base<
-                partition_unordered_map<Key, T, Hash, KeyEqual> > >
+      : public hpx::components::simple_component_base<
+            partition_unordered_map<Key, T, Hash, KeyEqual> >
     {
     public:
-        typedef std::unordered_map<Key, T, Hash, KeyEqual> data_type;
+        typedef open_addressing_map<Key, T, Hash, KeyEqual> data_type;
 
         typedef typename data_type::size_type size_type;
         typedef typename data_type::iterator iterator_type;
         typedef typename data_type::const_iterator const_iterator_type;
 
-        typedef components::locking_hook<
-                hpx::components::simple_component_base<
-                    partition_unordered_map<Key, T, Hash, KeyEqual> > >
+        typedef hpx::components::simple_component_base<
+                partition_unordered_map<Key, T, Hash, KeyEqual> >
             base_type;
 
     private:
@@ -200,24 +248,12 @@ namespace hpx { namespace server
         /// \return Return the value of the element at position represented
         ///         by \a pos.
         ///
-        struct erase_on_exit
-        {
-            erase_on_exit(data_type& m, typename data_type::iterator& it)
-              : m_(m), it_(it)
-            {}
-            ~erase_on_exit()
-            {
-                m_.erase(it_);
-            }
-
-            data_type& m_;
-            typename data_type::iterator& it_;
-        };
-
         T get_value(Key const& key, bool erase)
         {
-            typename data_type::iterator it = partition_unordered_map_.find(key);
-            if (it == partition_unordered_map_.end())
+            hpx::util::optional<T> value = erase ?
+                partition_unordered_map_.take(key) :
+                partition_unordered_map_.get(key);
+            if (!value)
             {
                 HPX_THROW_EXCEPTION(bad_parameter,
                     "partition_unordered_map::get_value",
@@ -225,11 +261,7 @@ namespace hpx { namespace server
                     "unordered_map");
             }
 
-            if (!erase)
-                return it->second;
-
-            erase_on_exit t(partition_unordered_map_, it);
-            return it->second;
+            return std::move(*value);
         }
 
         /// Return the element at the position \a pos in the partition_unordered_map
@@ -247,9 +279,9 @@ namespace hpx { namespace server
 
             for (std::size_t i = 0; i != keys.size(); ++i)
             {
-                typename data_type::iterator it =
-                    partition_unordered_map_.find(keys[i]);
-                if (it == partition_unordered_map_.end())
+                hpx::util::optional<T> value =
+                    partition_unordered_map_.get(keys[i]);
+                if (!value)
                 {
                     HPX_THROW_EXCEPTION(bad_parameter,
                         "partition_unordered_map::get_values",
@@ -257,11 +289,30 @@ namespace hpx { namespace server
                         "unordered_map");
                     break;
                 }
-                result.push_back(it->second);
+                result.push_back(std::move(*value));
             }
             return result;
         }
 
+        /// Return the elements with the given keys in the
+        /// partition_unordered_map container, if those exist.
+        ///
+        /// \param keys The keys of the elements in the partition_unordered_map
+        ///
+        /// \return Return the values of the elements with the given keys,
+        ///         the missing elements are empty.
+        ///
+        std::vector<hpx::util::optional<T> >
+        find_values(std::vector<Key> const& keys) const
+        {
+            std::vector<hpx::util::optional<T> > result;
+            result.reserve(keys.size());
+
+            for (std::size_t i = 0; i != keys.size(); ++i)
+                result.push_back(partition_unordered_map_.get(keys[i]));
+            return result;
+        }
+
         ///////////////////////////////////////////////////////////////////////
         // Modifiers API's in server class
         ///////////////////////////////////////////////////////////////////////
@@ -275,7 +326,7 @@ namespace hpx { namespace server
         ///
         void set_value(Key const& pos, T const& val)
         {
-            partition_unordered_map_[pos] = val;
+            partition_unordered_map_.insert_or_assign(pos, val);
         }
 
         /// Copy the value of \a val for the elements at positions \a pos in
@@ -289,10 +340,30 @@ namespace hpx { namespace server
             std::vector<T> const& val)
         {
             HPX_ASSERT(keys.size() == val.size());
-            HPX_ASSERT(keys.size() <= partition_unordered_map_.size());
 
             for (std::size_t i = 0; i != keys.size(); ++i)
-                partition_unordered_map_[keys[i]] = val[i];
+                partition_unordered_map_.insert_or_assign(keys[i], val[i]);
+        }
+
+        /// Add the values \a deltas to the elements with the keys \a keys in
+        /// the partition_unordered_map container (using operator+=), the
+        /// missing elements are value initialized first. This throws
+        /// bad_parameter if the values don't support operator+=.
+        ///
+        /// \param keys   The keys of the elements in the partition_unordered_map
+        ///
+        /// \param deltas The values to be added
+        ///
+        void update_values(std::vector<Key> const& keys,
+            std::vector<T> const& deltas)
+        {
+            HPX_ASSERT(keys.size() == deltas.size());
+
+            for (std::size_t i = 0; i != keys.size(); ++i)
+            {
+                partition_unordered_map_.update(
+                    keys[i], detail::add_delta<T>{deltas[i]});
+            }
         }
 
         /// Remove all elements from the vector leaving the
@@ -314,9 +385,11 @@ namespace hpx { namespace server
 
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, get_value);
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, get_values);
+        HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, find_values);
 
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, set_value);
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, set_values);
+        HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, update_values);
 
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, erase);
 
@@ -356,12 +429,18 @@ namespace hpx { namespace server
     HPX_REGISTER_ACTION_DECLARATION(                                          \
         HPX_PP_CAT(partition_unordered_map, __LINE__)::get_values_action,     \
         HPX_PP_CAT(__unordered_map_get_values_action_, name));                \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        HPX_PP_CAT(partition_unordered_map, __LINE__)::find_values_action,    \
+        HPX_PP_CAT(__unordered_map_find_values_action_, name));               \
     HPX_REGISTER_ACTION_DECLARATION(                                          \
         HPX_PP_CAT(partition_unordered_map, __LINE__)::set_value_action,      \
         HPX_PP_CAT(__unordered_map_set_value_action_, name));                 \
     HPX_REGISTER_ACTION_DECLARATION(                                          \
         HPX_PP_CAT(partition_unordered_map, __LINE__)::set_values_action,     \
         HPX_PP_CAT(__unordered_map_set_values_action_, name));                \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        HPX_PP_CAT(partition_unordered_map, __LINE__)::update_values_action,  \
+        HPX_PP_CAT(__unordered_map_update_values_action_, name));             \
     HPX_REGISTER_ACTION_DECLARATION(                                          \
         HPX_PP_CAT(partition_unordered_map, __LINE__)::size_action,           \
         HPX_PP_CAT(__unordered_map_size_action_, name));                      \
@@ -415,12 +494,18 @@ namespace hpx { namespace server
     HPX_REGISTER_ACTION(                                                      \
         HPX_PP_CAT(partition_unordered_map, __LINE__)::get_values_action,     \
         HPX_PP_CAT(__unordered_map_get_values_action_, name));                \
+    HPX_REGISTER_ACTION(                                                      \
+        HPX_PP_CAT(partition_unordered_map, __LINE__)::find_values_action,    \
+        HPX_PP_CAT(__unordered_map_find_values_action_, name));               \
     HPX_REGISTER_ACTION(                                                      \
         HPX_PP_CAT(partition_unordered_map, __LINE__)::set_value_action,      \
         HPX_PP_CAT(__unordered_map_set_value_action_, name));                 \
     HPX_REGISTER_ACTION(                                                      \
         HPX_PP_CAT(partition_unordered_map, __LINE__)::set_values_action,     \
         HPX_PP_CAT(__unordered_map_set_values_action_, name));                \
+    HPX_REGISTER_ACTION(                                                      \
+        HPX_PP_CAT(partition_unordered_map, __LINE__)::update_values_action,  \
+        HPX_PP_CAT(__unordered_map_update_values_action_, name));             \
     HPX_REGISTER_ACTION(                                                      \
         HPX_PP_CAT(partition_unordered_map, __LINE__)::size_action,           \
         HPX_PP_CAT(__unordered_map_size_action_, name));                      \
@@ -565,6 +650,35 @@ namespace hpx
                 this->get_id(), keys);
         }
 
+        /// Return the elements with the given keys in the
+        /// partition_unordered_map container, if those exist.
+        ///
+        /// \param keys The keys of the elements in the partition_unordered_map
+        ///
+        /// \return Returns the values of the elements, the missing elements
+        ///         are empty
+        ///
+        std::vector<hpx::util::optional<T> > find_values(launch::sync_policy,
+            std::vector<Key> const& keys) const
+        {
+            return find_values(keys).get();
+        }
+
+        /// Return the elements with the given keys in the
+        /// partition_unordered_map container, if those exist.
+        ///
+        /// \param keys The keys of the elements in the partition_unordered_map
+        ///
+        /// \return This returns the values as the hpx::future
+        ///
+        future<std::vector<hpx::util::optional<T> > >
+        find_values(std::vector<Key> const& keys) const
+        {
+            HPX_ASSERT(this->get_id());
+            return hpx::async<typename server_type::find_values_action>(
+                this->get_id(), keys);
+        }
+
         /// Copy the value of \a val in the element at position
         /// \a pos in the partition_unordered_map container.
         ///
@@ -621,6 +735,34 @@ namespace hpx
                 this->get_id(), keys, vals);
         }
 
+        /// Add the values \a deltas to the elements with the keys \a keys in
+        /// the partition_unordered_map container.
+        ///
+        /// \param keys   Keys of the elements in the partition_unordered_map
+        /// \param deltas The values to be added
+        ///
+        void update_values(launch::sync_policy, std::vector<Key> const& keys,
+            std::vector<T> const& deltas)
+        {
+            update_values(keys, deltas).get();
+        }
+
+        /// Add the values \a deltas to the elements with the keys \a keys in
+        /// the partition_unordered_map component.
+        ///
+        /// \param keys   Keys of the elements in the partition_unordered_map
+        /// \param deltas The values to be added
+        ///
+        /// \return This returns the hpx::future of type void
+        ///
+        future<void> update_values(std::vector<Key> const& keys,
+            std::vector<T> const& deltas)
+        {
+            HPX_ASSERT(this->get_id());
+            return hpx::async<typename server_type::update_values_action>(
+                this->get_id(), keys, deltas);
+        }
+
         /// Erase all values with the given key from the partition_unordered_map
         /// container.
         ///
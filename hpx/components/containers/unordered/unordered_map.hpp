@@ -9,7 +9,9 @@
 #define HPX_UNORDERED_MAP_NOV_11_2014_0852PM
 
 #include <hpx/config.hpp>
+#include <hpx/dataflow.hpp>
 #include <hpx/lcos/wait_all.hpp>
+#include <hpx/lcos/when_all.hpp>
 #include <hpx/runtime/components/client_base.hpp>
 #include <hpx/runtime/components/component_type.hpp>
 #include <hpx/runtime/components/copy_component.hpp>
@@ -21,6 +23,7 @@
 #include <hpx/runtime/serialization/vector.hpp>
 #include <hpx/traits/is_distribution_policy.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/optional.hpp>
 
 #include <hpx/components/containers/container_distribution_policy.hpp>
 #include <hpx/components/containers/unordered/partition_unordered_map_component.hpp>
@@ -32,6 +35,7 @@
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -331,6 +335,54 @@ namespace hpx
             return this->hasher_(key) % partitions_.size();
         }
 
+        // Return the keys grouped by partition, the relative order of the
+        // keys of each partition is preserved. The partition of each of the
+        // keys is stored in parts.
+        std::vector<std::vector<Key> > get_partitioned_keys(
+            std::vector<Key> const& keys, std::vector<std::size_t>& parts) const
+        {
+            std::size_t const num_parts = partitions_.size();
+
+            parts.clear();
+            parts.reserve(keys.size());
+
+            std::vector<std::size_t> counts(num_parts, 0);
+            for (Key const& key : keys)
+            {
+                std::size_t part = get_partition(key);
+                parts.push_back(part);
+                ++counts[part];
+            }
+
+            std::vector<std::vector<Key> > part_keys(num_parts);
+            for (std::size_t part = 0; part != num_parts; ++part)
+                part_keys[part].reserve(counts[part]);
+
+            for (std::size_t i = 0; i != keys.size(); ++i)
+                part_keys[parts[i]].push_back(keys[i]);
+
+            return part_keys;
+        }
+
+        // Distribute the keys and the corresponding values over the
+        // partitions.
+        void get_partitioned_values(std::vector<Key> const& keys,
+            std::vector<T> const& values,
+            std::vector<std::vector<Key> >& part_keys,
+            std::vector<std::vector<T> >& part_values) const
+        {
+            std::vector<std::size_t> parts;
+            part_keys = get_partitioned_keys(keys, parts);
+
+            part_values.clear();
+            part_values.resize(part_keys.size());
+            for (std::size_t part = 0; part != part_keys.size(); ++part)
+                part_values[part].reserve(part_keys[part].size());
+
+            for (std::size_t i = 0; i != parts.size(); ++i)
+                part_values[parts[i]].push_back(values[i]);
+        }
+
         std::vector<hpx::id_type> get_partition_ids() const
         {
             std::vector<hpx::id_type> ids;
@@ -754,6 +806,220 @@ namespace hpx
                 .set_value(pos, std::forward<T_>(val));
         }
 
+        /// Asynchronously insert the elements with the keys \a keys and the
+        /// values \a values into the unordered_map, existing elements with
+        /// the same keys are overwritten. The keys are hashed locally, a
+        /// single request is sent to each of the partitions any of the keys
+        /// belongs to.
+        ///
+        /// \param keys   The keys of the elements
+        /// \param values The values of the elements
+        ///
+        /// \return This returns the hpx::future of type void which gets ready
+        ///         once the operation is finished.
+        ///
+        future<void> insert_bulk(std::vector<Key> const& keys,
+            std::vector<T> const& values)
+        {
+            HPX_ASSERT(keys.size() == values.size());
+
+            std::vector<std::vector<Key> > part_keys;
+            std::vector<std::vector<T> > part_values;
+            get_partitioned_values(keys, values, part_keys, part_values);
+
+            std::vector<future<void> > part_futures;
+            for (size_type part = 0; part != part_keys.size(); ++part)
+            {
+                if (part_keys[part].empty())
+                    continue;
+
+                partition_data const& part_data = partitions_[part];
+                if (part_data.local_data_)
+                {
+                    part_data.local_data_->set_values(
+                        part_keys[part], part_values[part]);
+                }
+                else
+                {
+                    part_futures.push_back(
+                        partition_unordered_map_client(part_data.partition_)
+                            .set_values(part_keys[part], part_values[part]));
+                }
+            }
+
+            return when_all(part_futures);
+        }
+
+        /// Insert the elements with the keys \a keys and the values \a values
+        /// into the unordered_map, existing elements with the same keys are
+        /// overwritten.
+        ///
+        /// \param keys   The keys of the elements
+        /// \param values The values of the elements
+        ///
+        void insert_bulk(launch::sync_policy, std::vector<Key> const& keys,
+            std::vector<T> const& values)
+        {
+            insert_bulk(keys, values).get();
+        }
+
+        /// Asynchronously look up the elements with the keys \a keys. The
+        /// keys are hashed locally, a single request is sent to each of the
+        /// partitions any of the keys belongs to.
+        ///
+        /// \param keys   The keys of the elements
+        ///
+        /// \return This returns the hpx::future of the values of the elements
+        ///         in the order of the given keys, the values of the missing
+        ///         elements are empty.
+        ///
+        future<std::vector<hpx::util::optional<T> > >
+        find_bulk(std::vector<Key> const& keys) const
+        {
+            typedef std::vector<hpx::util::optional<T> > result_type;
+
+            std::vector<size_type> parts;
+            std::vector<std::vector<Key> > part_keys =
+                get_partitioned_keys(keys, parts);
+
+            std::vector<future<result_type> > part_values_future;
+            part_values_future.reserve(part_keys.size());
+            for (size_type part = 0; part != part_keys.size(); ++part)
+            {
+                partition_data const& part_data = partitions_[part];
+                if (part_keys[part].empty())
+                {
+                    part_values_future.push_back(
+                        make_ready_future(result_type()));
+                }
+                else if (part_data.local_data_)
+                {
+                    part_values_future.push_back(make_ready_future(
+                        part_data.local_data_->find_values(part_keys[part])));
+                }
+                else
+                {
+                    part_values_future.push_back(
+                        partition_unordered_map_client(part_data.partition_)
+                            .find_values(part_keys[part]));
+                }
+            }
+
+            // places the values in the order of the requested keys
+            auto merge_func =
+                [](std::vector<future<result_type> > && part_values_f,
+                    std::vector<size_type> const& parts) -> result_type
+                {
+                    std::vector<result_type> part_values;
+                    part_values.reserve(part_values_f.size());
+                    for (future<result_type>& part_f: part_values_f)
+                        part_values.push_back(part_f.get());
+
+                    std::vector<size_type> next(part_values.size(), 0);
+
+                    result_type values;
+                    values.reserve(parts.size());
+                    for (size_type part : parts)
+                    {
+                        values.push_back(
+                            std::move(part_values[part][next[part]++]));
+                    }
+                    return values;
+                };
+
+            return dataflow(launch::async, merge_func,
+                std::move(part_values_future), std::move(parts));
+        }
+
+        /// Look up the elements with the keys \a keys.
+        ///
+        /// \param keys   The keys of the elements
+        ///
+        /// \return The values of the elements in the order of the given
+        ///         keys, the values of the missing elements are empty.
+        ///
+        std::vector<hpx::util::optional<T> >
+        find_bulk(launch::sync_policy, std::vector<Key> const& keys) const
+        {
+            return find_bulk(keys).get();
+        }
+
+        /// Asynchronously add the values \a deltas to the elements with the
+        /// keys \a keys, the missing elements are value initialized first.
+        /// The updates are combined locally: all the deltas for the same
+        /// key are summed up (using operator+=) and a single request is sent
+        /// to each of the partitions any of the keys belongs to. This
+        /// requires the updates to be commutative and associative.
+        ///
+        /// \param keys   The keys of the elements
+        /// \param deltas The values to be added to the elements
+        ///
+        /// \return This returns the hpx::future of type void which gets ready
+        ///         once the operation is finished.
+        ///
+        future<void> update_bulk(std::vector<Key> const& keys,
+            std::vector<T> const& deltas)
+        {
+            HPX_ASSERT(keys.size() == deltas.size());
+
+            // pre-aggregate the updates of the same keys
+            std::unordered_map<
+                    Key, T, detail::unordered_hasher<Hash>,
+                    detail::unordered_comparator<KeyEqual>
+                > combined(keys.size(), this->hasher_, this->equal_);
+            for (size_type i = 0; i != keys.size(); ++i)
+            {
+                auto it = combined.find(keys[i]);
+                if (it == combined.end())
+                    combined.emplace(keys[i], deltas[i]);
+                else
+                    it->second += deltas[i];
+            }
+
+            std::vector<std::vector<Key> > part_keys(partitions_.size());
+            std::vector<std::vector<T> > part_deltas(partitions_.size());
+            for (auto const& p : combined)
+            {
+                size_type part = get_partition(p.first);
+                part_keys[part].push_back(p.first);
+                part_deltas[part].push_back(p.second);
+            }
+
+            std::vector<future<void> > part_futures;
+            for (size_type part = 0; part != part_keys.size(); ++part)
+            {
+                if (part_keys[part].empty())
+                    continue;
+
+                partition_data const& part_data = partitions_[part];
+                if (part_data.local_data_)
+                {
+                    part_data.local_data_->update_values(
+                        part_keys[part], part_deltas[part]);
+                }
+                else
+                {
+                    part_futures.push_back(
+                        partition_unordered_map_client(part_data.partition_)
+                            .update_values(part_keys[part], part_deltas[part]));
+                }
+            }
+
+            return when_all(part_futures);
+        }
+
+        /// Add the values \a deltas to the elements with the keys \a keys,
+        /// the missing elements are value initialized first.
+        ///
+        /// \param keys   The keys of the elements
+        /// \param deltas The values to be added to the elements
+        ///
+        void update_bulk(launch::sync_policy, std::vector<Key> const& keys,
+            std::vector<T> const& deltas)
+        {
+            update_bulk(keys, deltas).get();
+        }
+
         /// Asynchronously compute the size of the unordered_map.
         ///
         /// \return Return the number of elements in the unordered_map
@@ -12,6 +12,7 @@
 #include <hpx/apply.hpp>
 #include <hpx/async.hpp>
 #include <hpx/components/iostreams/manipulators.hpp>
+#include <hpx/components/iostreams/server/output_aggregator.hpp>
 #include <hpx/components/iostreams/server/output_stream.hpp>
 #include <hpx/runtime/components/client_base.hpp>
 #include <hpx/util/register_locks.hpp>
@@ -106,6 +107,21 @@ namespace hpx { namespace iostreams
             return get_consolestream();
         }
 
+        inline std::uint8_t get_stream_index(cout_tag)
+        {
+            return cout_stream;
+        }
+
+        inline std::uint8_t get_stream_index(cerr_tag)
+        {
+            return cerr_stream;
+        }
+
+        inline std::uint8_t get_stream_index(consolestream_tag)
+        {
+            return console_stream;
+        }
+
         inline char const* get_outstream_name(cout_tag)
         {
             return "/locality#console/output_stream#cout";
@@ -169,6 +185,7 @@ namespace hpx { namespace iostreams
     private:
         using detail::buffer::mtx_;
         std::atomic<std::uint64_t> generational_count_;
+        std::uint8_t stream_;
 
         // Performs a lazy streaming operation.
         template <typename T>
@@ -198,9 +215,8 @@ namespace hpx { namespace iostreams
 
                 // Perform the write operation, then destroy the old buffer and
                 // stream.
-                typedef server::output_stream::write_async_action action_type;
-                hpx::apply<action_type>(this->get_id(), hpx::get_locality_id(),
-                    generational_count_++, next);
+                detail::write_output(this->get_id(), stream_,
+                    generational_count_++, next, false);
             }
 
             return *this;
@@ -208,7 +224,8 @@ namespace hpx { namespace iostreams
 
         // Performs a synchronous streaming operation.
         template <typename T, typename Lock>
-        ostream& streaming_operator_sync(T const& subject, Lock& l)
+        ostream& streaming_operator_sync(T const& subject, Lock& l,
+            bool force_sync = false)
         { // {{{
             // apply the subject to the local stream
             *static_cast<stream_base_type*>(this) << subject;
@@ -223,9 +240,8 @@ namespace hpx { namespace iostreams
 
             // Perform the write operation, then destroy the old buffer and
             // stream.
-            typedef server::output_stream::write_sync_action action_type;
-            hpx::async<action_type>(this->get_id(), hpx::get_locality_id(),
-                generational_count_++, next).get();
+            detail::write_output(this->get_id(), stream_,
+                generational_count_++, next, true, force_sync);
 
             return *this;
         } // }}}
@@ -252,9 +268,8 @@ namespace hpx { namespace iostreams
 
                 // Perform the write operation, then destroy the old buffer and
                 // stream.
-                typedef server::output_stream::write_async_action action_type;
-                hpx::apply<action_type>(this->get_id(), hpx::get_locality_id(),
-                    generational_count_++, next);
+                detail::write_output(this->get_id(), stream_,
+                    generational_count_++, next, false);
             }
             return true;
         }
@@ -268,6 +283,7 @@ namespace hpx { namespace iostreams
         void initialize(Tag tag)
         {
             *static_cast<base_type*>(this) = detail::create_ostream(tag);
+            stream_ = detail::get_stream_index(tag);
         }
 
         // reset this object during runtime system shutdown
@@ -277,7 +293,8 @@ namespace hpx { namespace iostreams
             std::unique_lock<mutex_type> l(*mtx_, std::try_to_lock);
             if (l)
             {
-                streaming_operator_sync(hpx::async_flush, l);   // unlocks
+                // always wait for the output to reach the console
+                streaming_operator_sync(hpx::async_flush, l, true); // unlocks
             }
 
             // FIXME: find a later spot to invoke this
@@ -291,6 +308,7 @@ namespace hpx { namespace iostreams
           , buffer()
           , stream_base_type(*this)
           , generational_count_(0)
+          , stream_(detail::cout_stream)
         {}
 
         // hpx::flush manipulator
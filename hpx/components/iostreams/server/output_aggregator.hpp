@@ -0,0 +1,129 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_IOSTREAMS_SERVER_OUTPUT_AGGREGATOR_HPP)
+#define HPX_IOSTREAMS_SERVER_OUTPUT_AGGREGATOR_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/serialization/serialization_fwd.hpp>
+#include <hpx/util/interval_timer.hpp>
+
+#include <hpx/components/iostreams/export_definitions.hpp>
+#include <hpx/components/iostreams/server/buffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hpx { namespace iostreams { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Identifies the standard ostream objects in the aggregated output
+    enum standard_stream
+    {
+        cout_stream = 0,
+        cerr_stream = 1,
+        console_stream = 2
+    };
+
+    // One buffer written to one of the standard streams on some locality
+    struct output_entry
+    {
+        std::uint8_t stream_;
+        std::uint32_t locality_id_;
+        std::uint64_t count_;
+        buffer data_;
+
+        template <typename Archive>
+        void serialize(Archive& ar, unsigned)
+        {
+            ar & stream_ & locality_id_ & count_ & data_;
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The output_aggregator collects the output written to the standard
+    // streams on this locality and the output forwarded by its children and
+    // sends it towards the console in batches. The localities form a tree
+    // of the arity given by hpx.iostreams.arity rooted at the console, which
+    // spreads the cost of receiving the output of many localities. Pending
+    // output is sent once it exceeds hpx.iostreams.buffer_size bytes, at
+    // the latest after hpx.iostreams.flush_interval milliseconds, and
+    // whenever a synchronous flush is requested (unless hpx.iostreams.async
+    // is set). The console reorders the output of each locality anyways, so
+    // batches may overtake each other.
+    class output_aggregator
+    {
+    public:
+        HPX_NON_COPYABLE(output_aggregator);
+
+        typedef lcos::local::spinlock mutex_type;
+
+    public:
+        output_aggregator();
+
+        static output_aggregator& get();
+
+        // read the configuration, called during runtime startup
+        void start();
+
+        // synchronously send all pending output, called during shutdown
+        void stop();
+
+        // whether output of this locality goes through the aggregator
+        bool enabled() const
+        {
+            return enabled_;
+        }
+
+        // whether synchronous flushes of the streams are deferred as well
+        bool is_async() const
+        {
+            return async_;
+        }
+
+        // add output written on this locality or received from a child,
+        // sync waits for the output to have reached the console
+        void receive(std::vector<output_entry>&& entries, bool sync);
+
+        // send all pending output
+        void flush(bool sync);
+
+    private:
+        bool flush_pending();
+        void send(std::vector<output_entry>&& entries, bool sync) const;
+
+        mutable mutex_type mtx_;
+        std::vector<output_entry> pending_;
+        std::size_t pending_bytes_;
+
+        std::size_t buffer_size_;
+        std::uint32_t parent_;
+        bool is_console_;
+        bool enabled_;
+        bool async_;
+        bool stopped_;
+
+        std::unique_ptr<util::interval_timer> timer_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Send the given buffer written to the stream identified by id. A
+    // synchronous write waits for the buffer to have been written on the
+    // console unless hpx.iostreams.async is set, force_sync makes it wait
+    // regardless.
+    HPX_IOSTREAMS_EXPORT void write_output(naming::id_type const& id,
+        std::uint8_t stream, std::uint64_t count, buffer const& data,
+        bool sync, bool force_sync = false);
+
+    // Deliver aggregated output to the streams on the console
+    HPX_IOSTREAMS_EXPORT void deliver_output(
+        std::vector<output_entry> const& entries, bool sync);
+}}}
+
+#endif
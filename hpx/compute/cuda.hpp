@@ -12,6 +12,8 @@
 #include <hpx/compute/cuda/default_executor.hpp>
 #include <hpx/compute/cuda/concurrent_executor.hpp>
 #include <hpx/compute/cuda/get_targets.hpp>
+#include <hpx/compute/cuda/multi_stream_executor.hpp>
+#include <hpx/compute/cuda/pinned_buffer_pool.hpp>
 #include <hpx/compute/cuda/serialization/value_proxy.hpp>
 #include <hpx/compute/cuda/target.hpp>
 #include <hpx/compute/cuda/target_distribution_policy.hpp>
@@ -259,5 +259,7 @@ namespace hpx { namespace parallel { namespace execution
     {};
 }}}
 
+#include <hpx/compute/cuda/device_algorithms.hpp>
+
 #endif
 #endif
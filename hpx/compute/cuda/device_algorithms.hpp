@@ -0,0 +1,873 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Device side implementations of reduce, transform_reduce, inclusive_scan
+// and sort for data held in device memory (hpx::compute::vector using a
+// cuda::allocator). These are used instead of the host side partitioners if
+// the algorithm is invoked with a parallel policy using the cuda
+// default_executor (for instance par.on(exec)).
+
+#ifndef HPX_COMPUTE_CUDA_DEVICE_ALGORITHMS_HPP
+#define HPX_COMPUTE_CUDA_DEVICE_ALGORITHMS_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_CUDA)
+#include <hpx/lcos/future.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/result_of.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/detail/radix_sort.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <hpx/compute/cuda/allocator.hpp>
+#include <hpx/compute/cuda/detail/launch.hpp>
+#include <hpx/compute/cuda/detail/scoped_active_target.hpp>
+#include <hpx/compute/cuda/pinned_buffer_pool.hpp>
+#include <hpx/compute/cuda/target.hpp>
+#include <hpx/compute/detail/iterator.hpp>
+
+#include <cuda_runtime.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1 { namespace detail
+{
+    /// \cond NOINTERNAL
+    template <typename T> struct reduce;
+    template <typename T> struct transform_reduce;
+    template <typename FwdIter2> struct inclusive_scan;
+    template <typename RandomIt> struct sort;
+    /// \endcond
+}}}}
+
+namespace hpx { namespace compute { namespace cuda
+{
+    struct default_executor;
+
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The device algorithms operate on iterators referring to device
+        // memory of trivially copyable elements.
+        template <typename Iter, typename Enable = void>
+        struct is_device_iterator
+          : std::false_type
+        {};
+
+        template <typename T, typename U>
+        struct is_device_iterator<
+            compute::detail::iterator<T, cuda::allocator<U> >,
+            typename std::enable_if<
+                std::is_trivially_copyable<
+                    typename std::remove_const<T>::type
+                >::value
+            >::type>
+          : std::true_type
+        {};
+
+        template <typename Iter>
+        auto device_ptr(Iter const& it) -> decltype((*it).device_ptr())
+        {
+            return (*it).device_ptr();
+        }
+
+        // number of threads of the blocks used by the device algorithms
+        HPX_STATIC_CONSTEXPR unsigned algorithm_block_size = 256;
+
+        // number of elements handled by each thread of a scan or sort tile
+        HPX_STATIC_CONSTEXPR unsigned algorithm_items_per_thread = 8;
+
+        HPX_STATIC_CONSTEXPR std::size_t algorithm_tile_size =
+            algorithm_block_size * algorithm_items_per_thread;
+
+        // uninitialized shared memory for Count elements of type T
+        template <typename T, std::size_t Count>
+        struct shared_storage
+        {
+            typename std::aligned_storage<
+                    sizeof(T) * Count, alignof(T)
+                >::type storage_;
+
+            HPX_DEVICE T* data()
+            {
+                return reinterpret_cast<T*>(&storage_);
+            }
+        };
+
+        HPX_HOST_DEVICE inline std::size_t min_count(std::size_t lhs,
+            std::size_t rhs)
+        {
+            return lhs < rhs ? lhs : rhs;
+        }
+
+        // Loads and stores bypassing the (incoherent) L1 cache, used for the
+        // values exchanged between the blocks of a scan.
+        template <typename T>
+        HPX_DEVICE T load_volatile(T const* p)
+        {
+            T result;
+            char volatile const* src =
+                reinterpret_cast<char volatile const*>(p);
+            char* dest = reinterpret_cast<char*>(&result);
+            for (std::size_t i = 0; i != sizeof(T); ++i)
+                dest[i] = src[i];
+            return result;
+        }
+
+        template <typename T>
+        HPX_DEVICE void store_volatile(T* p, T const& value)
+        {
+            char const* src = reinterpret_cast<char const*>(&value);
+            char volatile* dest = reinterpret_cast<char volatile*>(p);
+            for (std::size_t i = 0; i != sizeof(T); ++i)
+                dest[i] = src[i];
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Temporary device memory of an algorithm, the memory has to be kept
+        // alive until the kernels using it have finished.
+        template <typename T>
+        class device_buffer
+        {
+        public:
+            device_buffer(cuda::target const& tgt, std::size_t count)
+              : alloc_(tgt), count_(count), p_(alloc_.allocate(count))
+            {}
+
+            device_buffer(device_buffer const&) = delete;
+            device_buffer& operator=(device_buffer const&) = delete;
+
+            ~device_buffer()
+            {
+                try {
+                    alloc_.deallocate(p_, count_);
+                }
+                catch (...) {
+                    // errors were reported by the kernels already
+                }
+            }
+
+            T* data() const
+            {
+                return p_.device_ptr();
+            }
+
+        private:
+            cuda::allocator<T> alloc_;
+            std::size_t count_;
+            typename cuda::allocator<T>::pointer p_;
+        };
+
+        // fill the given device memory with zeros on the stream of the target
+        inline void clear_device_memory(cuda::target const& tgt, void* p,
+            std::size_t bytes)
+        {
+            detail::scoped_active_target active(tgt);
+
+            cudaError_t error = cudaMemsetAsync(p, 0, bytes, active.stream());
+            if (error != cudaSuccess)
+            {
+                HPX_THROW_EXCEPTION(kernel_error,
+                    "cuda::detail::clear_device_memory()",
+                    std::string("cudaMemsetAsync failed: ") +
+                        cudaGetErrorString(error));
+            }
+        }
+
+#if defined(HPX_COMPUTE_DEVICE_CODE) || defined(HPX_COMPUTE_HOST_CODE)
+        ///////////////////////////////////////////////////////////////////////
+        // Tree reduction: every block reduces a strided subset of the input
+        // and writes one partial result, the partial results are reduced by
+        // a second launch of the same kernel using a single block.
+        template <typename T, typename In, typename Reduce, typename Convert>
+        struct reduce_kernel
+        {
+            In const* in_;
+            std::size_t count_;
+            T* out_;
+            Reduce r_;
+            Convert conv_;
+
+            HPX_DEVICE void operator()()
+            {
+                __shared__ shared_storage<T, algorithm_block_size> storage;
+                __shared__ bool valid[algorithm_block_size];
+
+                T* values = storage.data();
+                unsigned const tid = threadIdx.x;
+
+                std::size_t idx = blockIdx.x * blockDim.x + tid;
+                std::size_t const stride = gridDim.x * blockDim.x;
+
+                bool const has_value = idx < count_;
+                if (has_value)
+                {
+                    T sum = hpx::util::invoke(conv_, in_[idx]);
+                    for (idx += stride; idx < count_; idx += stride)
+                    {
+                        sum = hpx::util::invoke(r_, sum,
+                            hpx::util::invoke(conv_, in_[idx]));
+                    }
+                    ::new (&values[tid]) T(sum);
+                }
+                valid[tid] = has_value;
+                __syncthreads();
+
+                for (unsigned s = blockDim.x / 2; s != 0; s /= 2)
+                {
+                    if (tid < s && valid[tid + s])
+                    {
+                        if (valid[tid])
+                        {
+                            values[tid] = hpx::util::invoke(
+                                r_, values[tid], values[tid + s]);
+                        }
+                        else
+                        {
+                            ::new (&values[tid]) T(values[tid + s]);
+                            valid[tid] = true;
+                        }
+                    }
+                    __syncthreads();
+                }
+
+                // the first thread of every block has a value
+                if (tid == 0)
+                    out_[blockIdx.x] = values[0];
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Single pass scan using decoupled look-back: every block scans one
+        // tile of the input, publishes the sum of its tile and then looks
+        // back at the preceding tiles until it finds a tile which has
+        // published its inclusive prefix. The tiles are assigned in the order
+        // in which the blocks start running, which guarantees that a block
+        // never waits for a tile which has not been started.
+        template <typename T, typename In, typename Out, typename Op,
+            typename Convert>
+        struct scan_kernel
+        {
+            In const* in_;
+            Out* out_;
+            std::size_t count_;
+            T init_;
+            Op op_;
+            Convert conv_;
+            bool exclusive_;
+
+            // tile status: 0 (no value), 1 (aggregate), 2 (inclusive prefix)
+            unsigned* flags_;
+            unsigned* tile_counter_;
+            T* aggregates_;
+            T* prefixes_;
+
+            HPX_DEVICE void operator()()
+            {
+                __shared__ shared_storage<T, algorithm_block_size> storage;
+                __shared__ shared_storage<T, 1> prefix_storage;
+                __shared__ unsigned tile_id;
+
+                T* values = storage.data();
+                T* prefix = prefix_storage.data();
+                unsigned const tid = threadIdx.x;
+
+                if (tid == 0)
+                    tile_id = atomicAdd(tile_counter_, 1u);
+                __syncthreads();
+
+                std::size_t const tile = tile_id;
+                std::size_t const tile_begin = tile * algorithm_tile_size;
+                std::size_t const begin =
+                    tile_begin + tid * algorithm_items_per_thread;
+                std::size_t const end = min_count(
+                    begin + algorithm_items_per_thread, count_);
+                bool const has_items = begin < count_;
+
+                // sum of the elements of this thread
+                if (has_items)
+                {
+                    T sum = hpx::util::invoke(conv_, in_[begin]);
+                    for (std::size_t i = begin + 1; i < end; ++i)
+                    {
+                        sum = hpx::util::invoke(op_, sum,
+                            hpx::util::invoke(conv_, in_[i]));
+                    }
+                    ::new (&values[tid]) T(sum);
+                }
+                __syncthreads();
+
+                // inclusive scan of the sums of the threads, the threads
+                // without elements are at the end of the tile
+                for (unsigned offset = 1; offset < blockDim.x; offset *= 2)
+                {
+                    bool const update = has_items && tid >= offset;
+
+                    T sum;
+                    if (update)
+                    {
+                        sum = hpx::util::invoke(
+                            op_, values[tid - offset], values[tid]);
+                    }
+                    __syncthreads();
+
+                    if (update)
+                        values[tid] = sum;
+                    __syncthreads();
+                }
+
+                if (tid == 0)
+                {
+                    std::size_t const last_thread = min_count(
+                        std::size_t(blockDim.x),
+                        (count_ - tile_begin + algorithm_items_per_thread - 1) /
+                            algorithm_items_per_thread) - 1;
+                    T const aggregate = values[last_thread];
+
+                    T exclusive = init_;
+                    if (tile != 0)
+                    {
+                        store_volatile(&aggregates_[tile], aggregate);
+                        __threadfence();
+                        *static_cast<unsigned volatile*>(&flags_[tile]) = 1;
+
+                        // combine the sums of the preceding tiles
+                        std::size_t j = tile - 1;
+                        bool has_value = false;
+                        while (true)
+                        {
+                            unsigned flag;
+                            do {
+                                flag = *static_cast<unsigned volatile*>(
+                                    &flags_[j]);
+                            } while (flag == 0);
+                            __threadfence();
+
+                            T const value = (flag == 2) ?
+                                load_volatile(&prefixes_[j]) :
+                                load_volatile(&aggregates_[j]);
+
+                            exclusive = has_value ?
+                                hpx::util::invoke(op_, value, exclusive) :
+                                value;
+                            has_value = true;
+
+                            if (flag == 2)
+                                break;
+                            --j;
+                        }
+                    }
+
+                    store_volatile(&prefixes_[tile],
+                        T(hpx::util::invoke(op_, exclusive, aggregate)));
+                    __threadfence();
+                    *static_cast<unsigned volatile*>(&flags_[tile]) = 2;
+
+                    ::new (prefix) T(exclusive);
+                }
+                __syncthreads();
+
+                // write the results of the elements of this thread
+                if (has_items)
+                {
+                    T running = (tid == 0) ? *prefix :
+                        T(hpx::util::invoke(op_, *prefix, values[tid - 1]));
+
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        T next = hpx::util::invoke(op_, running,
+                            hpx::util::invoke(conv_, in_[i]));
+                        out_[i] = exclusive_ ? running : next;
+                        running = next;
+                    }
+                }
+            }
+        };
+
+        // Launch a scan of count elements, the kernels are executed
+        // asynchronously on the stream of the target. The returned buffers
+        // have to be kept alive until the scan has finished.
+        template <typename T>
+        struct scan_buffers
+        {
+            scan_buffers(cuda::target const& tgt, std::size_t num_tiles)
+              : status_(tgt, num_tiles + 1)
+              , values_(tgt, 2 * num_tiles)
+            {
+                clear_device_memory(tgt, status_.data(),
+                    (num_tiles + 1) * sizeof(unsigned));
+            }
+
+            device_buffer<unsigned> status_;
+            device_buffer<T> values_;
+        };
+
+        template <typename T, typename In, typename Out, typename Op,
+            typename Convert>
+        std::shared_ptr<scan_buffers<T> > launch_scan(
+            cuda::target const& tgt, In const* in, Out* out, std::size_t count,
+            T const& init, Op const& op, Convert const& conv, bool exclusive)
+        {
+            std::size_t const num_tiles =
+                (count + algorithm_tile_size - 1) / algorithm_tile_size;
+
+            std::shared_ptr<scan_buffers<T> > buffers =
+                std::make_shared<scan_buffers<T> >(tgt, num_tiles);
+
+            unsigned* status = buffers->status_.data();
+            T* values = buffers->values_.data();
+
+            typedef scan_kernel<T, In, Out, Op, Convert> kernel_type;
+            detail::launch(tgt, int(num_tiles), int(algorithm_block_size),
+                kernel_type{in, out, count, init, op, conv, exclusive,
+                    status, status + num_tiles, values, values + num_tiles});
+
+            return buffers;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Least significant digit radix sort, sorting radix_sort_bits bits of
+        // the keys in each pass. Each pass counts the digits of every tile,
+        // scans the counts (digit major) to find the position of the first
+        // element of each digit and tile, and scatters the elements.
+        HPX_STATIC_CONSTEXPR unsigned radix_sort_bits = 4;
+        HPX_STATIC_CONSTEXPR unsigned radix_sort_buckets =
+            1u << radix_sort_bits;
+
+        template <typename Proj, typename Value>
+        struct radix_sort_key
+        {
+            typedef typename hpx::util::decay<
+                    typename hpx::util::invoke_result<Proj, Value const&>::type
+                >::type key_type;
+
+            typedef parallel::v1::detail::radix_key<key_type> radix_key_type;
+            typedef typename radix_key_type::type type;
+
+            HPX_DEVICE static unsigned digit(Proj const& proj,
+                Value const& value, unsigned shift)
+            {
+                type const key =
+                    radix_key_type::call(hpx::util::invoke(proj, value));
+                return unsigned(key >> shift) & (radix_sort_buckets - 1);
+            }
+        };
+
+        struct plus_count
+        {
+            HPX_HOST_DEVICE std::size_t operator()(std::size_t lhs,
+                std::size_t rhs) const
+            {
+                return lhs + rhs;
+            }
+        };
+
+        template <typename Value, typename Proj>
+        struct radix_histogram_kernel
+        {
+            Value const* in_;
+            std::size_t count_;
+            std::size_t num_tiles_;
+            std::size_t* counts_;
+            Proj proj_;
+            unsigned shift_;
+
+            HPX_DEVICE void operator()()
+            {
+                __shared__ unsigned histogram[radix_sort_buckets];
+
+                unsigned const tid = threadIdx.x;
+                if (tid < radix_sort_buckets)
+                    histogram[tid] = 0;
+                __syncthreads();
+
+                std::size_t const begin = blockIdx.x * algorithm_tile_size;
+                std::size_t const end =
+                    min_count(begin + algorithm_tile_size, count_);
+                for (std::size_t i = begin + tid; i < end; i += blockDim.x)
+                {
+                    atomicAdd(&histogram[radix_sort_key<Proj, Value>::digit(
+                        proj_, in_[i], shift_)], 1u);
+                }
+                __syncthreads();
+
+                // digit major, the scan yields the position of the first
+                // element of each digit of each tile
+                if (tid < radix_sort_buckets)
+                    counts_[tid * num_tiles_ + blockIdx.x] = histogram[tid];
+            }
+        };
+
+        template <typename Value, typename Proj>
+        struct radix_scatter_kernel
+        {
+            Value const* in_;
+            Value* out_;
+            std::size_t count_;
+            std::size_t num_tiles_;
+            std::size_t const* offsets_;
+            Proj proj_;
+            unsigned shift_;
+
+            HPX_DEVICE void operator()()
+            {
+                // the number of elements of each digit handled by each
+                // thread, digit major
+                __shared__ unsigned counts[
+                    radix_sort_buckets * algorithm_block_size];
+                __shared__ unsigned thread_sums[algorithm_block_size];
+                __shared__ unsigned digit_begin[radix_sort_buckets];
+
+                typedef radix_sort_key<Proj, Value> key_type;
+
+                unsigned const tid = threadIdx.x;
+                for (unsigned d = 0; d != radix_sort_buckets; ++d)
+                    counts[d * algorithm_block_size + tid] = 0;
+                __syncthreads();
+
+                std::size_t const begin = blockIdx.x * algorithm_tile_size +
+                    tid * algorithm_items_per_thread;
+                std::size_t const end = min_count(
+                    begin + algorithm_items_per_thread, count_);
+
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    unsigned const d = key_type::digit(proj_, in_[i], shift_);
+                    ++counts[d * algorithm_block_size + tid];
+                }
+                __syncthreads();
+
+                // exclusive scan of the counts, every thread scans
+                // radix_sort_buckets consecutive counts
+                unsigned* my_counts = counts + tid * radix_sort_buckets;
+                unsigned sum = 0;
+                for (unsigned k = 0; k != radix_sort_buckets; ++k)
+                    sum += my_counts[k];
+                thread_sums[tid] = sum;
+                __syncthreads();
+
+                for (unsigned offset = 1; offset < blockDim.x; offset *= 2)
+                {
+                    unsigned const value = (tid >= offset) ?
+                        thread_sums[tid - offset] + thread_sums[tid] :
+                        thread_sums[tid];
+                    __syncthreads();
+                    thread_sums[tid] = value;
+                    __syncthreads();
+                }
+
+                unsigned running = thread_sums[tid] - sum;
+                for (unsigned k = 0; k != radix_sort_buckets; ++k)
+                {
+                    unsigned const c = my_counts[k];
+                    my_counts[k] = running;
+                    running += c;
+                }
+                __syncthreads();
+
+                if (tid < radix_sort_buckets)
+                    digit_begin[tid] = counts[tid * algorithm_block_size];
+                __syncthreads();
+
+                // scatter the elements of this thread in order, which keeps
+                // the sort stable
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    unsigned const d = key_type::digit(proj_, in_[i], shift_);
+                    unsigned const pos = counts[d * algorithm_block_size + tid]++;
+                    out_[offsets_[d * num_tiles_ + blockIdx.x] + pos -
+                        digit_begin[d]] = in_[i];
+                }
+            }
+        };
+#endif
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T, typename In, typename Reduce, typename Convert>
+        hpx::future<T> device_reduce(cuda::target const& tgt, In const* in,
+            std::size_t count, T init, Reduce && r, Convert && conv)
+        {
+#if defined(HPX_COMPUTE_DEVICE_CODE) || defined(HPX_COMPUTE_HOST_CODE)
+            typedef typename hpx::util::decay<Reduce>::type reduce_type;
+            typedef typename hpx::util::decay<Convert>::type convert_type;
+
+            std::size_t const num_blocks = (std::min)(std::size_t(1024),
+                (count + algorithm_block_size - 1) / algorithm_block_size);
+
+            // the partial results of the blocks followed by the final result
+            struct buffers
+            {
+                buffers(cuda::target const& tgt, std::size_t num_blocks)
+                  : values_(tgt, num_blocks + 1), result_(sizeof(T))
+                {}
+
+                device_buffer<T> values_;
+                pinned_buffer result_;
+            };
+            std::shared_ptr<buffers> data =
+                std::make_shared<buffers>(tgt, num_blocks);
+
+            T* values = data->values_.data();
+
+            detail::launch(tgt, int(num_blocks), int(algorithm_block_size),
+                reduce_kernel<T, In, reduce_type, convert_type>{
+                    in, count, values, r, conv});
+            detail::launch(tgt, 1, int(algorithm_block_size),
+                reduce_kernel<T, T, reduce_type,
+                    parallel::util::projection_identity>{
+                    values, num_blocks, values + num_blocks, r,
+                    parallel::util::projection_identity()});
+
+            copy_device_to_host(tgt, data->result_.data(), values + num_blocks,
+                sizeof(T));
+
+            return tgt.get_future().then(hpx::launch::sync,
+                [data, init, r](hpx::future<void> && f) mutable -> T
+                {
+                    f.get();    // propagate exceptions
+
+                    T const* result = static_cast<T const*>(
+                        data->result_.data());
+                    return hpx::util::invoke(r, init, *result);
+                });
+#else
+            HPX_THROW_EXCEPTION(hpx::not_implemented,
+                "hpx::compute::cuda::detail::device_reduce",
+                "Trying to launch a CUDA kernel, but did not compile in CUDA mode");
+#endif
+        }
+
+        template <typename T, typename In, typename Out, typename Op>
+        hpx::future<void> device_inclusive_scan(cuda::target const& tgt,
+            In const* in, Out* out, std::size_t count, T const& init, Op && op)
+        {
+#if defined(HPX_COMPUTE_DEVICE_CODE) || defined(HPX_COMPUTE_HOST_CODE)
+            auto buffers = launch_scan(tgt, in, out, count, init, op,
+                parallel::util::projection_identity(), false);
+
+            return tgt.get_future().then(hpx::launch::sync,
+                [buffers](hpx::future<void> && f) -> void
+                {
+                    f.get();    // propagate exceptions
+                });
+#else
+            HPX_THROW_EXCEPTION(hpx::not_implemented,
+                "hpx::compute::cuda::detail::device_inclusive_scan",
+                "Trying to launch a CUDA kernel, but did not compile in CUDA mode");
+#endif
+        }
+
+        template <typename Value, typename Proj>
+        hpx::future<void> device_radix_sort(cuda::target const& tgt,
+            Value* data, std::size_t count, Proj && proj)
+        {
+#if defined(HPX_COMPUTE_DEVICE_CODE) || defined(HPX_COMPUTE_HOST_CODE)
+            typedef typename hpx::util::decay<Proj>::type proj_type;
+            typedef typename radix_sort_key<proj_type, Value>::type key_type;
+
+            std::size_t const num_tiles =
+                (count + algorithm_tile_size - 1) / algorithm_tile_size;
+            std::size_t const num_counts = radix_sort_buckets * num_tiles;
+
+            struct buffers
+            {
+                buffers(cuda::target const& tgt, std::size_t count,
+                        std::size_t num_counts)
+                  : temp_(tgt, count)
+                  , counts_(tgt, num_counts)
+                  , offsets_(tgt, num_counts)
+                {}
+
+                device_buffer<Value> temp_;
+                device_buffer<std::size_t> counts_;
+                device_buffer<std::size_t> offsets_;
+                std::vector<std::shared_ptr<scan_buffers<std::size_t> > >
+                    scans_;
+            };
+            std::shared_ptr<buffers> b =
+                std::make_shared<buffers>(tgt, count, num_counts);
+
+            // the number of passes is even, the sorted elements end up in
+            // the original sequence
+            Value* in = data;
+            Value* out = b->temp_.data();
+            for (unsigned shift = 0; shift != sizeof(key_type) * CHAR_BIT;
+                 shift += radix_sort_bits)
+            {
+                detail::launch(tgt, int(num_tiles), int(algorithm_block_size),
+                    radix_histogram_kernel<Value, proj_type>{in, count,
+                        num_tiles, b->counts_.data(), proj, shift});
+
+                b->scans_.push_back(launch_scan(tgt, b->counts_.data(),
+                    b->offsets_.data(), num_counts, std::size_t(0),
+                    plus_count(),
+                    parallel::util::projection_identity(), true));
+
+                detail::launch(tgt, int(num_tiles), int(algorithm_block_size),
+                    radix_scatter_kernel<Value, proj_type>{in, out, count,
+                        num_tiles, b->offsets_.data(), proj, shift});
+
+                std::swap(in, out);
+            }
+
+            // the temporary buffers are released once all passes are done
+            return tgt.get_future().then(hpx::launch::sync,
+                [b](hpx::future<void> && f) -> void
+                {
+                    f.get();    // propagate exceptions
+                });
+#else
+            HPX_THROW_EXCEPTION(hpx::not_implemented,
+                "hpx::compute::cuda::detail::device_radix_sort",
+                "Trying to launch a CUDA kernel, but did not compile in CUDA mode");
+#endif
+        }
+    }
+}}}
+
+namespace hpx { namespace parallel { inline namespace v1 { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Algorithms invoked with a parallel policy using the cuda default
+    // executor on sequences in device memory run on the device.
+    template <>
+    struct device_algorithm<compute::cuda::default_executor>
+    {
+        // reduce
+        template <typename T, typename ExPolicy, typename Iter,
+            typename T_, typename Reduce>
+        static typename std::enable_if<
+            compute::cuda::detail::is_device_iterator<Iter>::value &&
+                std::is_trivially_copyable<T>::value,
+            typename util::detail::algorithm_result<ExPolicy, T>::type
+        >::type
+        call(reduce<T> const&, ExPolicy && policy, Iter first, Iter last,
+            T_ && init, Reduce && r)
+        {
+            return call_reduce<T>(std::forward<ExPolicy>(policy), first, last,
+                std::forward<T_>(init), std::forward<Reduce>(r),
+                util::projection_identity());
+        }
+
+        // transform_reduce
+        template <typename T, typename ExPolicy, typename Iter,
+            typename T_, typename Reduce, typename Convert>
+        static typename std::enable_if<
+            compute::cuda::detail::is_device_iterator<Iter>::value &&
+                std::is_trivially_copyable<T>::value,
+            typename util::detail::algorithm_result<ExPolicy, T>::type
+        >::type
+        call(transform_reduce<T> const&, ExPolicy && policy, Iter first,
+            Iter last, T_ && init, Reduce && r, Convert && conv)
+        {
+            return call_reduce<T>(std::forward<ExPolicy>(policy), first, last,
+                std::forward<T_>(init), std::forward<Reduce>(r),
+                std::forward<Convert>(conv));
+        }
+
+        // inclusive_scan
+        template <typename FwdIter2, typename ExPolicy, typename FwdIter1,
+            typename T, typename Op>
+        static typename std::enable_if<
+            compute::cuda::detail::is_device_iterator<FwdIter1>::value &&
+                compute::cuda::detail::is_device_iterator<FwdIter2>::value &&
+                std::is_trivially_copyable<T>::value &&
+                std::is_default_constructible<T>::value,
+            typename util::detail::algorithm_result<ExPolicy, FwdIter2>::type
+        >::type
+        call(inclusive_scan<FwdIter2> const&, ExPolicy && policy,
+            FwdIter1 first, FwdIter1 last, FwdIter2 dest, T const& init,
+            Op && op)
+        {
+            typedef util::detail::algorithm_result<ExPolicy, FwdIter2> result;
+
+            std::size_t const count = std::distance(first, last);
+            FwdIter2 final_dest = dest;
+            std::advance(final_dest, count);
+
+            if (count == 0)
+                return result::get(std::move(final_dest));
+
+            return result::get(compute::cuda::detail::device_inclusive_scan(
+                policy.executor().target(),
+                compute::cuda::detail::device_ptr(first),
+                compute::cuda::detail::device_ptr(dest), count, init,
+                std::forward<Op>(op)
+            ).then(hpx::launch::sync,
+                [final_dest](hpx::future<void> && f) -> FwdIter2
+                {
+                    f.get();    // propagate exceptions
+                    return final_dest;
+                }));
+        }
+
+        // sort, arithmetic keys compared using operator<() are radix sorted
+        template <typename RandomIt, typename ExPolicy, typename Compare,
+            typename Proj>
+        static typename std::enable_if<
+            compute::cuda::detail::is_device_iterator<RandomIt>::value &&
+                use_radix_sort<RandomIt, Compare, Proj>::value,
+            typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+        >::type
+        call(sort<RandomIt> const&, ExPolicy && policy, RandomIt first,
+            RandomIt last, Compare &&, Proj && proj)
+        {
+            typedef util::detail::algorithm_result<ExPolicy, RandomIt> result;
+
+            std::size_t const count = std::distance(first, last);
+            if (count < 2)
+                return result::get(std::move(last));
+
+            return result::get(compute::cuda::detail::device_radix_sort(
+                policy.executor().target(),
+                compute::cuda::detail::device_ptr(first), count,
+                std::forward<Proj>(proj)
+            ).then(hpx::launch::sync,
+                [last](hpx::future<void> && f) -> RandomIt
+                {
+                    f.get();    // propagate exceptions
+                    return last;
+                }));
+        }
+
+    private:
+        template <typename T, typename ExPolicy, typename Iter,
+            typename T_, typename Reduce, typename Convert>
+        static typename util::detail::algorithm_result<ExPolicy, T>::type
+        call_reduce(ExPolicy && policy, Iter first, Iter last, T_ && init,
+            Reduce && r, Convert && conv)
+        {
+            typedef util::detail::algorithm_result<ExPolicy, T> result;
+
+            std::size_t const count = std::distance(first, last);
+            if (count == 0)
+                return result::get(T(std::forward<T_>(init)));
+
+            return result::get(compute::cuda::detail::device_reduce(
+                policy.executor().target(),
+                compute::cuda::detail::device_ptr(first), count,
+                T(std::forward<T_>(init)), std::forward<Reduce>(r),
+                std::forward<Convert>(conv)));
+        }
+    };
+}}}}
+
+#endif
+#endif
@@ -0,0 +1,30 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_COMPUTE_CUDA_EVENT_POLLING_HPP
+#define HPX_COMPUTE_CUDA_EVENT_POLLING_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_CUDA)
+namespace hpx { namespace compute { namespace cuda
+{
+    // If hpx.cuda.event_polling is set, the futures returned by
+    // target::get_future() are completed by polling a CUDA event recorded on
+    // the target's stream instead of from a callback invoked by the CUDA
+    // runtime. The events are polled by the worker threads as part of their
+    // background work, the continuations of the futures run on the HPX worker
+    // threads.
+
+    // Return whether the futures are completed by polling events.
+    HPX_API_EXPORT bool event_polling_enabled();
+
+    // Complete the futures whose events have been reached. Returns whether
+    // any future was completed.
+    HPX_API_EXPORT bool poll_events();
+}}}
+#endif
+
+#endif
@@ -0,0 +1,295 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_COMPUTE_CUDA_MULTI_STREAM_EXECUTOR_HPP
+#define HPX_COMPUTE_CUDA_MULTI_STREAM_EXECUTOR_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_CUDA)
+#include <hpx/lcos/future.hpp>
+#include <hpx/traits/executor_traits.hpp>
+#include <hpx/traits/is_executor.hpp>
+#include <hpx/traits/is_range.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke_fused.hpp>
+#include <hpx/util/iterator_range.hpp>
+#include <hpx/util/range.hpp>
+#include <hpx/util/tuple.hpp>
+
+#include <hpx/parallel/executors/execution.hpp>
+
+#include <hpx/compute/cuda/default_executor.hpp>
+#include <hpx/compute/cuda/detail/launch.hpp>
+#include <hpx/compute/cuda/multi_stream_executor_parameters.hpp>
+#include <hpx/compute/cuda/target.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace compute { namespace cuda
+{
+    namespace detail
+    {
+        // The streams of a multi_stream_executor, shared by all copies of
+        // the executor. Each stream is owned by a separate target referring
+        // to the same device.
+        struct stream_pool
+        {
+            stream_pool(cuda::target const& target, std::size_t num_streams)
+              : current_(0)
+            {
+                HPX_ASSERT(num_streams != 0);
+
+                int device = target.native_handle().get_device();
+                targets_.reserve(num_streams);
+                for (std::size_t i = 0; i != num_streams; ++i)
+                {
+                    cuda::target t(target.get_locality(), device);
+                    t.native_handle().get_stream();
+                    targets_.emplace_back(std::move(t));
+                }
+            }
+
+            // round-robin dispatch to the streams
+            cuda::target const& next()
+            {
+                return targets_[current_++ % targets_.size()];
+            }
+
+            std::vector<cuda::target> targets_;
+            std::atomic<std::size_t> current_;
+        };
+
+        struct kernel_launcher
+        {
+            template <typename F, typename ... Ts>
+            void operator()(F && f, Ts &&... ts) const
+            {
+                detail::launch(*target_, 1, 1,
+                    std::forward<F>(f), std::forward<Ts>(ts)...);
+            }
+
+            cuda::target const* target_;
+        };
+
+        // Launches the kernel once the predecessor has become ready, used if
+        // the dependency can't be expressed on the device.
+        template <typename F, typename ... Ts>
+        struct launch_after
+        {
+            template <typename Future>
+            hpx::future<void> operator()(Future && predecessor)
+            {
+                // propagate the exception of the predecessor, if any
+                predecessor.get();
+
+                util::invoke_fused(kernel_launcher{target_}, std::move(call_));
+                return target_->get_future();
+            }
+
+            cuda::target const* target_;
+            util::tuple<
+                typename util::decay<F>::type,
+                typename util::decay<Ts>::type...
+            > call_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // An executor which keeps a pool of streams on one device and dispatches
+    // the submitted kernels to them in a round-robin fashion. Independent
+    // kernels submitted through the same executor can overlap on the device,
+    // unlike the kernels submitted through a default_executor, which are
+    // serialized on the stream of its target.
+    struct multi_stream_executor
+    {
+        // By default, the bulk work is split into one chunk per stream.
+        typedef multi_stream_executor_parameters executor_parameters_type;
+
+        explicit multi_stream_executor(cuda::target const& target,
+                std::size_t num_streams = 4)
+          : streams_(std::make_shared<detail::stream_pool>(
+                target, num_streams))
+        {}
+
+        /// \cond NOINTERNAL
+        bool operator==(multi_stream_executor const& rhs) const noexcept
+        {
+            return streams_ == rhs.streams_;
+        }
+
+        bool operator!=(multi_stream_executor const& rhs) const noexcept
+        {
+            return !(*this == rhs);
+        }
+
+        cuda::target const& context() const noexcept
+        {
+            return streams_->targets_[0];
+        }
+        /// \endcond
+
+        std::size_t processing_units_count() const
+        {
+            return context().native_handle().processing_units();
+        }
+
+        std::size_t num_streams() const
+        {
+            return streams_->targets_.size();
+        }
+
+        template <typename F, typename ... Ts>
+        void post(F && f, Ts &&... ts) const
+        {
+            detail::launch(streams_->next(), 1, 1,
+                std::forward<F>(f), std::forward<Ts>(ts)...);
+        }
+
+        template <typename F, typename ... Ts>
+        hpx::future<void> async_execute(F && f, Ts &&... ts) const
+        {
+            cuda::target const& t = streams_->next();
+            detail::launch(t, 1, 1,
+                std::forward<F>(f), std::forward<Ts>(ts)...);
+            return t.get_future();
+        }
+
+        template <typename F, typename ... Ts>
+        void sync_execute(F && f, Ts &&... ts) const
+        {
+            cuda::target const& t = streams_->next();
+            detail::launch(t, 1, 1,
+                std::forward<F>(f), std::forward<Ts>(ts)...);
+            t.synchronize();
+        }
+
+        // Launch the kernel once the given future has become ready. If the
+        // future was returned by a CUDA executor and event polling is
+        // enabled (see hpx.cuda.event_polling), the dependency is tracked on
+        // the device through the event of the future and the kernel is
+        // enqueued right away. Otherwise the kernel is launched from a
+        // continuation of the future.
+        template <typename Future, typename F, typename ... Ts>
+        hpx::future<void> async_execute_after(Future && predecessor,
+            F && f, Ts &&... ts) const
+        {
+            cuda::target const& t = streams_->next();
+            if (!predecessor.is_ready() && t.wait_for(predecessor))
+            {
+                detail::launch(t, 1, 1,
+                    std::forward<F>(f), std::forward<Ts>(ts)...);
+                return t.get_future();
+            }
+
+            typedef detail::launch_after<F, Ts...> launch_type;
+            return predecessor.then(hpx::launch::sync,
+                launch_type{&t, util::forward_as_tuple(
+                    std::forward<F>(f), std::forward<Ts>(ts)...)});
+        }
+
+        template <typename F, typename Shape, typename ... Ts>
+        std::vector<hpx::future<void> >
+        bulk_async_execute(F && f, Shape const& shape, Ts &&... ts) const
+        {
+            std::vector<cuda::target const*> targets =
+                bulk_launch(f, shape, ts...);
+
+            std::vector<hpx::future<void> > result;
+            result.reserve(targets.size());
+            for (cuda::target const* t : targets)
+                result.push_back(t->get_future());
+            return result;
+        }
+
+        template <typename F, typename Shape, typename ... Ts>
+        void bulk_sync_execute(F && f, Shape const& shape, Ts &&... ts) const
+        {
+            std::vector<cuda::target const*> targets =
+                bulk_launch(f, shape, ts...);
+
+            for (cuda::target const* t : targets)
+                t->synchronize();
+        }
+
+    private:
+        // Split the shape into one contiguous part per stream and launch a
+        // kernel for each part on the next stream, returns the targets the
+        // kernels were launched on.
+        template <typename F, typename Shape, typename ... Ts>
+        std::vector<cuda::target const*>
+        bulk_launch(F& f, Shape const& shape, Ts&... ts) const
+        {
+            typedef typename hpx::traits::range_iterator<Shape const>::type
+                iterator_type;
+            typedef detail::bulk_launch_helper<
+                    util::iterator_range<iterator_type>
+                > launch_helper;
+
+            std::size_t count = util::size(shape);
+            std::size_t parts = (std::min)(count, num_streams());
+
+            std::vector<cuda::target const*> targets;
+            targets.reserve(parts);
+
+            iterator_type first = util::begin(shape);
+            for (std::size_t i = 0; i != parts; ++i)
+            {
+                std::size_t size = count / parts + (i < count % parts ? 1 : 0);
+                iterator_type last = std::next(first, size);
+
+                cuda::target const& t = streams_->next();
+                launch_helper::call(t, f,
+                    util::iterator_range<iterator_type>(first, last), ts...);
+                targets.push_back(&t);
+
+                first = last;
+            }
+            return targets;
+        }
+
+        std::shared_ptr<detail::stream_pool> streams_;
+    };
+}}}
+
+namespace hpx { namespace parallel { namespace execution
+{
+    template <>
+    struct executor_execution_category<compute::cuda::multi_stream_executor>
+    {
+        typedef parallel::execution::parallel_execution_tag type;
+    };
+
+    template <>
+    struct is_one_way_executor<compute::cuda::multi_stream_executor>
+      : std::true_type
+    {};
+
+    template <>
+    struct is_two_way_executor<compute::cuda::multi_stream_executor>
+      : std::true_type
+    {};
+
+    template <>
+    struct is_bulk_one_way_executor<compute::cuda::multi_stream_executor>
+      : std::true_type
+    {};
+
+    template <>
+    struct is_bulk_two_way_executor<compute::cuda::multi_stream_executor>
+      : std::true_type
+    {};
+}}}
+
+#endif
+#endif
@@ -0,0 +1,45 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_COMPUTE_CUDA_MULTI_STREAM_EXECUTOR_PARAMETERS_HPP
+#define HPX_COMPUTE_CUDA_MULTI_STREAM_EXECUTOR_PARAMETERS_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_CUDA)
+#include <hpx/traits/is_executor_parameters.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+namespace hpx { namespace compute { namespace cuda
+{
+    // Splits the iterations into one chunk per stream of the executor, the
+    // chunks are launched as separate kernels on different streams.
+    struct multi_stream_executor_parameters
+    {
+        template <typename Executor, typename F>
+        std::size_t get_chunk_size(Executor& exec, F &&, std::size_t cores,
+            std::size_t num_tasks)
+        {
+            std::size_t num_streams = exec.num_streams();
+            return (std::max)(std::size_t(1),
+                (num_tasks + num_streams - 1) / num_streams);
+        }
+    };
+}}}
+
+namespace hpx { namespace parallel { namespace execution
+{
+    template <>
+    struct is_executor_parameters<
+            compute::cuda::multi_stream_executor_parameters>
+      : std::true_type
+    {};
+}}}
+
+#endif
+#endif
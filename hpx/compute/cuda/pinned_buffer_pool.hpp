@@ -0,0 +1,178 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_COMPUTE_CUDA_PINNED_BUFFER_POOL_HPP
+#define HPX_COMPUTE_CUDA_PINNED_BUFFER_POOL_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_CUDA)
+#include <hpx/compute/cuda/target.hpp>
+
+#include <cuda_runtime.h>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace hpx { namespace compute { namespace cuda
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The page-locked host memory used for staging the transfers between
+    // pageable host memory and the device is allocated from a pool. The pool
+    // rounds the requested sizes up to powers of two and keeps a limited
+    // number of released buffers of each size for reuse, as allocating
+    // page-locked memory is expensive.
+    namespace detail
+    {
+        HPX_API_EXPORT void* allocate_pinned(std::size_t size);
+        HPX_API_EXPORT void deallocate_pinned(void* p) noexcept;
+
+        // Return the capacity of, and an event associated with, a buffer
+        // allocated by allocate_pinned.
+        HPX_API_EXPORT std::size_t pinned_capacity(void const* p) noexcept;
+        HPX_API_EXPORT cudaEvent_t pinned_event(void* p);
+
+        // Return whether the given host memory is page-locked.
+        HPX_API_EXPORT bool is_pinned(void const* p);
+
+        // Copy the given number of bytes between host memory and the device
+        // on the stream of the given target. Copies from or to pageable host
+        // memory of at least hpx.cuda.staging_threshold bytes are staged
+        // through double buffered pinned buffers of
+        // hpx.cuda.staging_chunk_size bytes, overlapping the copies between
+        // the host buffers with the transfers. Staged copies have completed
+        // when these functions return, all others are asynchronous.
+        HPX_API_EXPORT void copy_host_to_device(cuda::target const& tgt,
+            void* dest, void const* src, std::size_t bytes);
+        HPX_API_EXPORT void copy_device_to_host(cuda::target const& tgt,
+            void* dest, void const* src, std::size_t bytes);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A page-locked host buffer taken from the pool, the buffer is returned
+    // to the pool when the instance is destroyed.
+    class pinned_buffer
+    {
+    public:
+        pinned_buffer() noexcept
+          : data_(nullptr)
+        {}
+
+        explicit pinned_buffer(std::size_t size)
+          : data_(detail::allocate_pinned(size))
+        {}
+
+        pinned_buffer(pinned_buffer const&) = delete;
+        pinned_buffer& operator=(pinned_buffer const&) = delete;
+
+        pinned_buffer(pinned_buffer && rhs) noexcept
+          : data_(rhs.data_)
+        {
+            rhs.data_ = nullptr;
+        }
+
+        pinned_buffer& operator=(pinned_buffer && rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                reset();
+                data_ = rhs.data_;
+                rhs.data_ = nullptr;
+            }
+            return *this;
+        }
+
+        ~pinned_buffer()
+        {
+            reset();
+        }
+
+        void reset() noexcept
+        {
+            if (data_ != nullptr)
+            {
+                detail::deallocate_pinned(data_);
+                data_ = nullptr;
+            }
+        }
+
+        void* data() const noexcept
+        {
+            return data_;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return data_ != nullptr ? detail::pinned_capacity(data_) : 0;
+        }
+
+        // An event which can be recorded after a transfer from or to the
+        // buffer to find out when the buffer can be reused.
+        cudaEvent_t event() const
+        {
+            return detail::pinned_event(data_);
+        }
+
+    private:
+        void* data_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // An allocator for page-locked host memory taken from the pool. Host
+    // containers using this allocator (for instance the buffers holding data
+    // to be sent to or received from a device) are transferred without
+    // staging.
+    template <typename T>
+    struct pinned_allocator
+    {
+        typedef T value_type;
+        typedef T* pointer;
+        typedef T const* const_pointer;
+        typedef T& reference;
+        typedef T const& const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        template <typename U>
+        struct rebind
+        {
+            typedef pinned_allocator<U> other;
+        };
+
+        typedef std::true_type is_always_equal;
+        typedef std::true_type propagate_on_container_move_assignment;
+
+        pinned_allocator() = default;
+
+        template <typename U>
+        pinned_allocator(pinned_allocator<U> const&) noexcept
+        {}
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(detail::allocate_pinned(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, std::size_t) noexcept
+        {
+            detail::deallocate_pinned(p);
+        }
+    };
+
+    template <typename T, typename U>
+    bool operator==(pinned_allocator<T> const&, pinned_allocator<U> const&)
+    {
+        return true;
+    }
+
+    template <typename T, typename U>
+    bool operator!=(pinned_allocator<T> const&, pinned_allocator<U> const&)
+    {
+        return false;
+    }
+}}}
+
+#endif
+#endif
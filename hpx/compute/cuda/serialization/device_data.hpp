@@ -0,0 +1,36 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_COMPUTE_SERIALIZATION_CUDA_DEVICE_DATA_HPP
+#define HPX_COMPUTE_SERIALIZATION_CUDA_DEVICE_DATA_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_CUDA) && !defined(__CUDA_ARCH__)
+#include <hpx/compute/cuda/target.hpp>
+#include <hpx/runtime/serialization/serialization_fwd.hpp>
+
+#include <cstddef>
+
+namespace hpx { namespace compute { namespace cuda { namespace detail
+{
+    // Serialize the given number of bytes of device memory of the given
+    // target. If the archive allows device memory chunks (see
+    // hpx.parcel.<parcelport>.device_memory_chunks) large buffers are added
+    // as zero copy chunks referring to the device memory, which the
+    // parcelport sends from the device directly (CUDA aware MPI, GPUDirect
+    // RDMA). Otherwise the data is copied to the host through a pinned
+    // buffer first.
+    HPX_API_EXPORT void save_device_data(serialization::output_archive& ar,
+        cuda::target const& tgt, void const* data, std::size_t bytes);
+
+    // Deserialize the given number of bytes into device memory of the given
+    // target, the data has been copied to the device when this returns.
+    HPX_API_EXPORT void load_device_data(serialization::input_archive& ar,
+        cuda::target const& tgt, void* data, std::size_t bytes);
+}}}}
+
+#endif
+#endif
@@ -17,6 +17,7 @@
 #include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/runtime/find_here.hpp>
 #include <hpx/runtime/runtime_fwd.hpp>
+#include <hpx/traits/future_access.hpp>
 
 #include <hpx/runtime/serialization/serialization_fwd.hpp>
 
@@ -171,6 +172,17 @@ namespace hpx { namespace compute { namespace cuda
 
         hpx::future<void> get_future() const;
 
+        // Make the work submitted to the stream of this target from now on
+        // wait on the device for the given future. This is possible only for
+        // futures returned by get_future() while hpx.cuda.event_polling is
+        // enabled, false is returned for all other futures.
+        template <typename Future>
+        bool wait_for(Future const& f) const
+        {
+            return wait_for_shared_state(
+                hpx::traits::future_access<Future>::get_shared_state(f).get());
+        }
+
         static std::vector<target> get_local_targets()
         {
             return cuda::get_local_targets();
@@ -188,6 +200,10 @@ namespace hpx { namespace compute { namespace cuda
         }
 
     private:
+        bool wait_for_shared_state(
+            hpx::traits::detail::shared_state_ptr<void>::type::element_type*
+                state) const;
+
 #if !defined(HPX_COMPUTE_DEVICE_CODE)
         friend class hpx::serialization::access;
 
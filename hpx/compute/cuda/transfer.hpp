@@ -14,6 +14,7 @@
 #include <hpx/traits/pointer_category.hpp>
 
 #include <hpx/compute/cuda/allocator.hpp>
+#include <hpx/compute/cuda/pinned_buffer_pool.hpp>
 #include <hpx/compute/detail/iterator.hpp>
 
 #include <cstddef>
@@ -227,9 +228,8 @@ namespace hpx { namespace parallel { namespace util { namespace detail
             std::size_t bytes = count *
                 sizeof(typename std::iterator_traits<InIter>::value_type);
 
-            cudaMemcpyAsync(&(*dest), (*first).device_ptr(),
-                bytes, cudaMemcpyDeviceToHost,
-                first.target().native_handle().get_stream());
+            compute::cuda::detail::copy_device_to_host(first.target(),
+                &(*dest), (*first).device_ptr(), bytes);
 
             std::advance(dest, count);
             return std::make_pair(last, dest);
@@ -254,9 +254,8 @@ namespace hpx { namespace parallel { namespace util { namespace detail
             std::size_t bytes = count *
                 sizeof(typename std::iterator_traits<InIter>::value_type);
 
-            cudaMemcpyAsync((*dest).device_ptr(), &(*first), bytes,
-                cudaMemcpyHostToDevice,
-                dest.target().native_handle().get_stream());
+            compute::cuda::detail::copy_host_to_device(dest.target(),
+                (*dest).device_ptr(), &(*first), bytes);
 
             std::advance(dest, count);
             return std::make_pair(last, dest);
@@ -308,9 +307,8 @@ namespace hpx { namespace parallel { namespace util { namespace detail
             std::size_t bytes = count *
                 sizeof(typename std::iterator_traits<InIter>::value_type);
 
-            cudaMemcpyAsync(&(*dest), (*first).device_ptr(), bytes,
-                cudaMemcpyDeviceToHost,
-                first.target().native_handle().get_stream());
+            compute::cuda::detail::copy_device_to_host(first.target(),
+                &(*dest), (*first).device_ptr(), bytes);
 
             std::advance(first, count);
             std::advance(dest, count);
@@ -335,9 +333,8 @@ namespace hpx { namespace parallel { namespace util { namespace detail
             std::size_t bytes = count *
                 sizeof(typename std::iterator_traits<InIter>::value_type);
 
-            cudaMemcpyAsync((*dest).device_ptr(), &(*first), bytes,
-                cudaMemcpyHostToDevice,
-                dest.target().native_handle().get_stream());
+            compute::cuda::detail::copy_host_to_device(dest.target(),
+                (*dest).device_ptr(), &(*first), bytes);
 
             std::advance(first, count);
             std::advance(dest, count);
@@ -13,6 +13,7 @@
 #include <hpx/compute/host/default_executor.hpp>
 #include <hpx/compute/host/get_targets.hpp>
 #include <hpx/compute/host/numa_domains.hpp>
+#include <hpx/compute/host/replicated_vector.hpp>
 #include <hpx/compute/host/target.hpp>
 #include <hpx/compute/host/target_distribution_policy.hpp>
 #include <hpx/compute/host/traits/access_target.hpp>
@@ -35,9 +35,45 @@
 
 namespace hpx { namespace compute { namespace host
 {
+    /// The pages backing the memory allocated by a block_allocator.
+    enum class huge_pages
+    {
+        none,           ///< use pages of the default size
+        transparent,    ///< ask for transparent huge pages (madvise)
+        explicit_2m,    ///< map explicit 2MiB huge pages (MAP_HUGETLB)
+        explicit_1g     ///< map explicit 1GiB huge pages (MAP_HUGETLB)
+    };
+
+    /// The placement of the pages allocated by a block_allocator onto the
+    /// NUMA domains of its targets.
+    enum class memory_placement
+    {
+        first_touch,    ///< a page is placed on the domain touching it first
+        interleave      ///< the pages are interleaved across the domains
+    };
+
+    namespace detail
+    {
+        // Allocate the given number of bytes with the given kind of pages.
+        // Explicit huge pages fall back to transparent huge pages if the
+        // system has no huge pages of the requested size available. On
+        // systems not supporting huge pages the default pages are used.
+        HPX_API_EXPORT void* allocate_block(std::size_t bytes,
+            huge_pages pages, memory_placement placement,
+            std::vector<host::target> const& targets);
+
+        // Release memory allocated by allocate_block, the arguments must be
+        // equal to the ones passed to allocate_block.
+        HPX_API_EXPORT void deallocate_block(void* p, std::size_t bytes,
+            huge_pages pages);
+    }
+
     /// The block_allocator allocates blocks of memory evenly divided onto the
-    /// passed vector of targets. This is done by using first touch memory
-    /// placement. (maybe better methods will be used in the future...);
+    /// passed vector of targets. By default this is done by using first touch
+    /// memory placement: the objects are constructed by the workers of the
+    /// target owning the block. Alternatively the pages can be interleaved
+    /// across the NUMA domains of all targets, and the memory can be backed
+    /// by huge pages to reduce the number of TLB misses for large blocks.
     ///
     /// This allocator can be used to write NUMA aware algorithms:
     ///
@@ -48,6 +84,10 @@ namespace hpx { namespace compute { namespace host
     /// std::size_t N = 2048;
     /// vector_type v(N, allocator_type(numa_nodes));
     ///
+    /// vector_type w(N, allocator_type(numa_nodes,
+    ///     hpx::compute::host::huge_pages::transparent,
+    ///     hpx::compute::host::memory_placement::interleave));
+    ///
     template <typename T, typename Executor =
         hpx::parallel::execution::local_priority_queue_attached_executor>
     struct block_allocator
@@ -65,7 +105,7 @@ namespace hpx { namespace compute { namespace host
         template <typename U>
         struct rebind
         {
-            typedef block_allocator<U> other;
+            typedef block_allocator<U, Executor> other;
         };
 
         typedef std::false_type is_always_equal;
@@ -75,42 +115,64 @@ namespace hpx { namespace compute { namespace host
 
         block_allocator()
           : executor_(target_type(1))
+          , pages_(huge_pages::none)
+          , placement_(memory_placement::first_touch)
         {}
 
-        block_allocator(target_type const& targets)
+        block_allocator(target_type const& targets,
+                huge_pages pages = huge_pages::none,
+                memory_placement placement = memory_placement::first_touch)
           : executor_(targets)
+          , pages_(pages)
+          , placement_(placement)
         {}
 
-        block_allocator(target_type && targets)
+        block_allocator(target_type && targets,
+                huge_pages pages = huge_pages::none,
+                memory_placement placement = memory_placement::first_touch)
           : executor_(targets)
+          , pages_(pages)
+          , placement_(placement)
         {}
 
         block_allocator(block_allocator const& alloc)
           : executor_(alloc.executor_)
+          , pages_(alloc.pages_)
+          , placement_(alloc.placement_)
         {}
 
         block_allocator(block_allocator && alloc)
           : executor_(std::move(alloc.executor_))
+          , pages_(alloc.pages_)
+          , placement_(alloc.placement_)
         {}
 
         template <typename U>
-        block_allocator(block_allocator<U> const& alloc)
+        block_allocator(block_allocator<U, Executor> const& alloc)
           : executor_(alloc.executor_)
+          , pages_(alloc.pages_)
+          , placement_(alloc.placement_)
         {}
 
         template <typename U>
-        block_allocator(block_allocator<U> && alloc)
+        block_allocator(block_allocator<U, Executor> && alloc)
           : executor_(std::move(alloc.executor_))
+          , pages_(alloc.pages_)
+          , placement_(alloc.placement_)
         {}
 
         block_allocator& operator=(block_allocator const& rhs)
         {
             executor_ = rhs.executor_;
+            pages_ = rhs.pages_;
+            placement_ = rhs.placement_;
             return *this;
         }
         block_allocator& operator=(block_allocator && rhs)
         {
             executor_ = std::move(rhs.executor_);
+            pages_ = rhs.pages_;
+            placement_ = rhs.placement_;
             return *this;
         }
 
@@ -126,15 +188,17 @@ namespace hpx { namespace compute { namespace host
             return &x;
         }
 
-        // Allocates n * sizeof(T) bytes of uninitialized storage by calling
-        // topo.allocate(). The pointer hint may be used to provide locality of
+        // Allocates n * sizeof(T) bytes of uninitialized storage backed by
+        // the pages selected on construction. For interleaved placement the
+        // pages are bound to the NUMA domains of the targets before they are
+        // first touched. The pointer hint may be used to provide locality of
         // reference: the allocator, if supported by the implementation, will
         // attempt to allocate the new memory block as close as possible to hint.
         pointer allocate(size_type n,
             std::allocator<void>::const_pointer hint = nullptr)
         {
-            return reinterpret_cast<pointer>(
-                hpx::threads::get_topology().allocate(n * sizeof(T)));
+            return reinterpret_cast<pointer>(detail::allocate_block(
+                n * sizeof(T), pages_, placement_, executor_.targets()));
         }
 
         // Deallocates the storage referenced by the pointer p, which must be a
@@ -143,7 +207,7 @@ namespace hpx { namespace compute { namespace host
         // originally produced p; otherwise, the behavior is undefined.
         void deallocate(pointer p, size_type n)
         {
-            hpx::threads::get_topology().deallocate(p, n);
+            detail::deallocate_block(p, n * sizeof(T), pages_);
         }
 
         // Returns the maximum theoretically possible value of n, for which the
@@ -158,7 +222,8 @@ namespace hpx { namespace compute { namespace host
         // Constructs count objects of type T in allocated uninitialized
         // storage pointed to by p, using placement-new. This will use the
         // underlying executors to distribute the memory according to
-        // first touch memory placement.
+        // first touch memory placement: each target constructs a contiguous
+        // part of the objects on its own workers.
         template <typename U, typename ... Args>
         void bulk_construct(U* p, std::size_t count, Args &&... args)
         {
@@ -273,8 +338,24 @@ namespace hpx { namespace compute { namespace host
             return executor_.targets();
         }
 
+        // Access the kind of pages and the placement used for the memory
+        huge_pages pages() const noexcept
+        {
+            return pages_;
+        }
+
+        memory_placement placement() const noexcept
+        {
+            return placement_;
+        }
+
     private:
+        template <typename U, typename E>
+        friend struct block_allocator;
+
         block_executor<executor_type> executor_;
+        huge_pages pages_;
+        memory_placement placement_;
     };
 }}}
 
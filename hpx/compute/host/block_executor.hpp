@@ -150,15 +150,19 @@ namespace hpx { namespace compute { namespace host
             > > results;
             std::size_t cnt = util::size(shape);
             std::size_t part_size = cnt / executors_.size();
+            std::size_t remainder = cnt % executors_.size();
 
             results.reserve(cnt);
 
             try {
+                // divide the shape into one contiguous part per target, the
+                // first targets take one of the remaining elements each
                 auto begin = util::begin(shape);
                 for (std::size_t i = 0; i != executors_.size(); ++i)
                 {
                     auto part_end = begin;
-                    std::advance(part_end, part_size);
+                    std::advance(part_end,
+                        part_size + (i < remainder ? 1 : 0));
                     auto futures =
                         parallel::execution::bulk_async_execute(
                             executors_[i],
@@ -192,15 +196,19 @@ namespace hpx { namespace compute { namespace host
                 >::type results;
             std::size_t cnt = util::size(shape);
             std::size_t part_size = cnt / executors_.size();
+            std::size_t remainder = cnt % executors_.size();
 
             results.reserve(cnt);
 
             try {
+                // divide the shape into one contiguous part per target, the
+                // first targets take one of the remaining elements each
                 auto begin = util::begin(shape);
                 for (std::size_t i = 0; i != executors_.size(); ++i)
                 {
                     auto part_end = begin;
-                    std::advance(part_end, part_size);
+                    std::advance(part_end,
+                        part_size + (i < remainder ? 1 : 0));
                     auto part_results =
                         parallel::execution::bulk_sync_execute(
                             executors_[i],
@@ -0,0 +1,198 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef HPX_COMPUTE_HOST_REPLICATED_VECTOR_HPP
+#define HPX_COMPUTE_HOST_REPLICATED_VECTOR_HPP
+
+#include <hpx/config.hpp>
+
+#include <hpx/async.hpp>
+#include <hpx/compute/host/block_allocator.hpp>
+#include <hpx/compute/host/block_executor.hpp>
+#include <hpx/compute/host/numa_domains.hpp>
+#include <hpx/compute/host/target.hpp>
+#include <hpx/compute/vector.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/parallel/algorithms/copy.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/static_chunk_size.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace compute { namespace host
+{
+    namespace detail
+    {
+        // Return the index of the target of every worker thread of this
+        // locality: the first of the given targets whose processing units
+        // overlap with the affinity mask of the worker thread. Worker threads
+        // not running on any of the targets use the first target.
+        HPX_API_EXPORT std::vector<std::size_t> get_worker_thread_targets(
+            std::vector<host::target> const& targets);
+    }
+
+    /// A replicated_vector holds one copy of a read-only sequence of
+    /// elements for each of the given targets (by default for each of the
+    /// NUMA domains of this locality). Each copy is placed in the memory of
+    /// its target: the elements are constructed and filled by the workers of
+    /// the target, and all copies are filled concurrently.
+    ///
+    /// Accessing the elements reads from the copy of the target the calling
+    /// worker thread runs on. This avoids reading large, shared lookup
+    /// tables across the interconnect of the sockets.
+    ///
+    /// typedef hpx::compute::host::replicated_vector<double> table_type;
+    ///
+    /// std::vector<double> values = read_table();
+    /// table_type table(values.begin(), values.end());
+    ///
+    /// double v = table[i];    // reads from the copy of the local domain
+    ///
+    template <typename T>
+    class replicated_vector
+    {
+    private:
+        typedef block_allocator<T> allocator_type;
+        typedef compute::vector<T, allocator_type> replica_type;
+
+    public:
+        typedef T value_type;
+        typedef std::size_t size_type;
+        typedef T const& const_reference;
+        typedef T const* const_iterator;
+
+        typedef std::vector<host::target> target_type;
+
+        replicated_vector()
+          : size_(0)
+        {}
+
+        /// Create one copy of the elements in the range [first, last) for
+        /// each of the given targets.
+        template <typename FwdIter>
+        replicated_vector(FwdIter first, FwdIter last,
+                target_type const& targets = host::numa_domains())
+          : size_(std::distance(first, last))
+          , thread_targets_(detail::get_worker_thread_targets(targets))
+        {
+            HPX_ASSERT(!targets.empty());
+
+            std::vector<hpx::future<replica_type> > replicas;
+            replicas.reserve(targets.size());
+
+            for (host::target const& t : targets)
+            {
+                replicas.push_back(hpx::async(
+                    [first, last, t]() -> replica_type
+                    {
+                        return create_replica(first, last, t);
+                    }));
+            }
+
+            hpx::wait_all(replicas);
+
+            replicas_.reserve(replicas.size());
+            for (hpx::future<replica_type>& f : replicas)
+                replicas_.push_back(f.get());
+        }
+
+        /// Create one copy of the given elements for each of the given
+        /// targets.
+        explicit replicated_vector(std::vector<T> const& values,
+                target_type const& targets = host::numa_domains())
+          : replicated_vector(values.begin(), values.end(), targets)
+        {}
+
+        replicated_vector(replicated_vector &&) = default;
+        replicated_vector& operator=(replicated_vector &&) = default;
+
+        size_type size() const noexcept
+        {
+            return size_;
+        }
+
+        bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+
+        /// The number of copies of the elements
+        std::size_t num_replicas() const noexcept
+        {
+            return replicas_.size();
+        }
+
+        /// The index of the copy used by the calling thread
+        std::size_t local_replica() const
+        {
+            std::size_t num_thread = hpx::get_worker_thread_num();
+            return num_thread < thread_targets_.size() ?
+                thread_targets_[num_thread] : 0;
+        }
+
+        /// Access the element at the given position in the copy of the
+        /// target of the calling thread
+        const_reference operator[](size_type pos) const
+        {
+            HPX_ASSERT(pos < size_);
+            return data()[pos];
+        }
+
+        T const* data() const
+        {
+            return data(local_replica());
+        }
+
+        T const* data(std::size_t replica) const
+        {
+            HPX_ASSERT(replica < replicas_.size());
+            return replicas_[replica].data();
+        }
+
+        const_iterator begin() const
+        {
+            return data();
+        }
+
+        const_iterator end() const
+        {
+            return data() + size_;
+        }
+
+    private:
+        // the elements are constructed and copied by the workers of the
+        // target, which places the pages of the copy on the target
+        template <typename FwdIter>
+        static replica_type create_replica(FwdIter first, FwdIter last,
+            host::target const& t)
+        {
+            target_type targets(1, t);
+            replica_type replica(std::distance(first, last),
+                allocator_type(targets));
+
+            host::block_executor<> exec(targets);
+            hpx::parallel::copy(
+                hpx::parallel::execution::par.on(exec).with(
+                    hpx::parallel::execution::static_chunk_size()),
+                first, last, replica.data());
+
+            return replica;
+        }
+
+        size_type size_;
+        std::vector<replica_type> replicas_;
+        std::vector<std::size_t> thread_targets_;
+    };
+}}}
+
+#endif
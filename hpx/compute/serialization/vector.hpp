@@ -18,11 +18,55 @@
 
 #include <hpx/compute/vector.hpp>
 
+#if defined(HPX_HAVE_CUDA) && !defined(__CUDA_ARCH__)
+#include <hpx/compute/cuda/allocator.hpp>
+#include <hpx/compute/cuda/serialization/device_data.hpp>
+#endif
+
+#include <cstddef>
 #include <type_traits>
 
 namespace hpx { namespace serialization
 {
 #if !defined(__CUDA_ARCH__)
+    namespace detail
+    {
+        // the data of vectors in host memory
+        template <typename T, typename Allocator>
+        void load_data(input_archive & ar, compute::vector<T, Allocator> & v)
+        {
+            load_binary(ar, v.device_data(), v.size() * sizeof(T));
+        }
+
+        template <typename T, typename Allocator>
+        void save_data(output_archive & ar,
+            compute::vector<T, Allocator> const& v)
+        {
+            save_binary(ar, v.device_data(), v.size() * sizeof(T));
+        }
+
+#if defined(HPX_HAVE_CUDA)
+        // the data of vectors in device memory
+        template <typename T>
+        void load_data(input_archive & ar,
+            compute::vector<T, compute::cuda::allocator<T> > & v)
+        {
+            compute::cuda::detail::load_device_data(ar,
+                v.get_allocator().target(), v.device_data(),
+                v.size() * sizeof(T));
+        }
+
+        template <typename T>
+        void save_data(output_archive & ar,
+            compute::vector<T, compute::cuda::allocator<T> > const& v)
+        {
+            compute::cuda::detail::save_device_data(ar,
+                v.get_allocator().target(), v.device_data(),
+                v.size() * sizeof(T));
+        }
+#endif
+    }
+
     // load compute::vector<T>
     namespace detail
     {
@@ -71,7 +115,7 @@ namespace hpx { namespace serialization
                 if(size == 0) return;
 
                 v.resize(size);
-                load_binary(ar, v.device_data(), v.size() * sizeof(value_type));
+                load_data(ar, v);
             }
         }
     }
@@ -118,9 +162,7 @@ namespace hpx { namespace serialization
             else
             {
                 // bitwise save ...
-                typedef typename compute::vector<T, Allocator>::value_type
-                    value_type;
-                save_binary(ar, v.device_data(), v.size() * sizeof(value_type));
+                save_data(ar, v);
             }
         }
     }
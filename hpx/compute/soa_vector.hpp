@@ -0,0 +1,334 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_COMPUTE_SOA_VECTOR_HPP)
+#define HPX_COMPUTE_SOA_VECTOR_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/util/aligned_allocator.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/detail/pack.hpp>
+#include <hpx/util/tuple.hpp>
+#include <hpx/util/zip_iterator.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace compute
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The storage of a single field of a soa_vector (and of the partitions of
+    // a field of a partitioned_soa_vector).
+    template <typename T>
+    using soa_field_data = std::vector<T, util::aligned_allocator<T> >;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A sequence of tuples stored as a structure of arrays: every field of
+    // the tuples is stored contiguously in an array of its own. The arrays
+    // are aligned to a cache line and padded to a whole number of cache
+    // lines (see util::aligned_allocator).
+    //
+    // The iterators are zip_iterators over pointers into the fields,
+    // dereferencing them yields a tuple of references to the fields of one
+    // element, which serves as the proxy reference of the container. Under
+    // execution::datapar the algorithms load and store one vector pack per
+    // field through these iterators (see parallel/datapar/zip_iterator.hpp).
+    template <typename ... Ts>
+    class soa_vector
+    {
+        static_assert(sizeof...(Ts) != 0,
+            "soa_vector must have at least one field");
+
+        typedef typename hpx::util::detail::make_index_pack<
+                sizeof...(Ts)
+            >::type index_pack_type;
+
+    public:
+        typedef hpx::util::tuple<Ts...> value_type;
+        typedef hpx::util::tuple<Ts&...> reference;
+        typedef hpx::util::tuple<Ts const&...> const_reference;
+        typedef hpx::util::zip_iterator<Ts*...> iterator;
+        typedef hpx::util::zip_iterator<Ts const*...> const_iterator;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        template <std::size_t I>
+        using field_type =
+            typename hpx::util::tuple_element<I, value_type>::type;
+
+        soa_vector() = default;
+
+        explicit soa_vector(size_type count)
+          : fields_(soa_field_data<Ts>(count)...)
+        {}
+
+        soa_vector(size_type count, value_type const& value)
+        {
+            resize(count, value);
+        }
+
+        soa_vector(soa_vector const&) = default;
+        soa_vector(soa_vector&&) = default;
+
+        soa_vector& operator=(soa_vector const&) = default;
+        soa_vector& operator=(soa_vector&&) = default;
+
+        ///////////////////////////////////////////////////////////////////////
+        size_type size() const noexcept
+        {
+            return hpx::util::get<0>(fields_).size();
+        }
+
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        // The number of elements all fields can hold without reallocation.
+        size_type capacity() const noexcept
+        {
+            return capacity(index_pack_type());
+        }
+
+        void reserve(size_type count)
+        {
+            reserve(count, index_pack_type());
+        }
+
+        void resize(size_type count)
+        {
+            resize(count, index_pack_type());
+        }
+
+        void resize(size_type count, value_type const& value)
+        {
+            resize(count, value, index_pack_type());
+        }
+
+        void clear() noexcept
+        {
+            clear(index_pack_type());
+        }
+
+        // All fields grow before anything is appended. If copying a field
+        // throws, the fields appended to already are shrunk back.
+        void push_back(value_type const& value)
+        {
+            size_type count = size();
+            if (count == capacity())
+                reserve((std::max)(2 * count, size_type(16)));
+
+            try {
+                push_back(value, index_pack_type());
+            }
+            catch (...) {
+                resize_down(count, index_pack_type());
+                throw;
+            }
+        }
+
+        void pop_back()
+        {
+            HPX_ASSERT(!empty());
+            resize_down(size() - 1, index_pack_type());
+        }
+
+        void swap(soa_vector& other) noexcept
+        {
+            std::swap(fields_, other.fields_);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        reference operator[](size_type pos)
+        {
+            HPX_ASSERT(pos < size());
+            return *(begin() + pos);
+        }
+
+        const_reference operator[](size_type pos) const
+        {
+            HPX_ASSERT(pos < size());
+            return *(begin() + pos);
+        }
+
+        reference front()
+        {
+            return (*this)[0];
+        }
+        const_reference front() const
+        {
+            return (*this)[0];
+        }
+
+        reference back()
+        {
+            return (*this)[size() - 1];
+        }
+        const_reference back() const
+        {
+            return (*this)[size() - 1];
+        }
+
+        // The contiguous array holding the field I of all elements
+        template <std::size_t I>
+        field_type<I>* data() noexcept
+        {
+            return hpx::util::get<I>(fields_).data();
+        }
+
+        template <std::size_t I>
+        field_type<I> const* data() const noexcept
+        {
+            return hpx::util::get<I>(fields_).data();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        iterator begin() noexcept
+        {
+            return make_iterator(0, index_pack_type());
+        }
+        const_iterator begin() const noexcept
+        {
+            return make_iterator(0, index_pack_type());
+        }
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        iterator end() noexcept
+        {
+            return make_iterator(size(), index_pack_type());
+        }
+        const_iterator end() const noexcept
+        {
+            return make_iterator(size(), index_pack_type());
+        }
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        friend bool operator==(soa_vector const& lhs, soa_vector const& rhs)
+        {
+            return lhs.fields_ == rhs.fields_;
+        }
+
+        friend bool operator!=(soa_vector const& lhs, soa_vector const& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        template <std::size_t ... Is>
+        size_type capacity(
+            hpx::util::detail::pack_c<std::size_t, Is...>) const noexcept
+        {
+            size_type const capacities[] = {
+                hpx::util::get<Is>(fields_).capacity() ...
+            };
+            return *std::min_element(
+                capacities, capacities + sizeof...(Is));
+        }
+
+        template <std::size_t ... Is>
+        void reserve(size_type count,
+            hpx::util::detail::pack_c<std::size_t, Is...>)
+        {
+            int const sequencer[] = {
+                0, (hpx::util::get<Is>(fields_).reserve(count), 0) ...
+            };
+            (void) sequencer;
+        }
+
+        template <std::size_t ... Is>
+        void resize(size_type count,
+            hpx::util::detail::pack_c<std::size_t, Is...>)
+        {
+            reserve(count);
+
+            int const sequencer[] = {
+                0, (hpx::util::get<Is>(fields_).resize(count), 0) ...
+            };
+            (void) sequencer;
+        }
+
+        template <std::size_t ... Is>
+        void resize(size_type count, value_type const& value,
+            hpx::util::detail::pack_c<std::size_t, Is...>)
+        {
+            reserve(count);
+
+            int const sequencer[] = {
+                0, (hpx::util::get<Is>(fields_).resize(
+                    count, hpx::util::get<Is>(value)), 0) ...
+            };
+            (void) sequencer;
+        }
+
+        // shrinking the fields does not throw
+        template <std::size_t ... Is>
+        void resize_down(size_type count,
+            hpx::util::detail::pack_c<std::size_t, Is...>) noexcept
+        {
+            int const sequencer[] = {
+                0, (hpx::util::get<Is>(fields_).erase(
+                    hpx::util::get<Is>(fields_).begin() + count,
+                    hpx::util::get<Is>(fields_).end()), 0) ...
+            };
+            (void) sequencer;
+        }
+
+        template <std::size_t ... Is>
+        void clear(hpx::util::detail::pack_c<std::size_t, Is...>) noexcept
+        {
+            int const sequencer[] = {
+                0, (hpx::util::get<Is>(fields_).clear(), 0) ...
+            };
+            (void) sequencer;
+        }
+
+        template <std::size_t ... Is>
+        void push_back(value_type const& value,
+            hpx::util::detail::pack_c<std::size_t, Is...>)
+        {
+            int const sequencer[] = {
+                0, (hpx::util::get<Is>(fields_).push_back(
+                    hpx::util::get<Is>(value)), 0) ...
+            };
+            (void) sequencer;
+        }
+
+        template <std::size_t ... Is>
+        iterator make_iterator(size_type pos,
+            hpx::util::detail::pack_c<std::size_t, Is...>) noexcept
+        {
+            return iterator(hpx::util::get<Is>(fields_).data() + pos ...);
+        }
+
+        template <std::size_t ... Is>
+        const_iterator make_iterator(size_type pos,
+            hpx::util::detail::pack_c<std::size_t, Is...>) const noexcept
+        {
+            return const_iterator(
+                static_cast<Ts const*>(
+                    hpx::util::get<Is>(fields_).data()) + pos ...);
+        }
+
+        hpx::util::tuple<soa_field_data<Ts>...> fields_;
+    };
+
+    template <typename ... Ts>
+    void swap(soa_vector<Ts...>& lhs, soa_vector<Ts...>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+}}
+
+#endif
@@ -423,6 +423,13 @@
 #endif
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+// The size of the inline storage of the functions holding the callables of
+// HPX threads and of future continuations (in multiples of sizeof(void*)).
+#if !defined(HPX_HAVE_TASK_FUNCTION_STORAGE_SIZE)
+#  define HPX_HAVE_TASK_FUNCTION_STORAGE_SIZE 8
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 // Make sure we have support for more than 64 threads for Xeon Phi
 #if defined(__MIC__) && !defined(HPX_HAVE_MORE_THAN_64_THREADS)
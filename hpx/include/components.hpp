@@ -44,6 +44,7 @@
 #include <hpx/runtime/components/server/migration_support.hpp>
 
 #include <hpx/runtime/components/copy_component.hpp>
+#include <hpx/runtime/components/load_balancer.hpp>
 #include <hpx/runtime/components/migrate_component.hpp>
 #include <hpx/runtime/components/new.hpp>
 #include <hpx/runtime/components/pinned_ptr.hpp>
@@ -7,9 +7,12 @@
 #define HPX_COMPRESSION_REGISTRATION_APR_28_2016_1022AM
 
 #include <hpx/config.hpp>
+#include <hpx/plugins/binary_filter/adaptive_compression_registration.hpp>
 #include <hpx/plugins/binary_filter/bzip2_serialization_filter_registration.hpp>
+#include <hpx/plugins/binary_filter/lz4_serialization_filter_registration.hpp>
 #include <hpx/plugins/binary_filter/snappy_serialization_filter_registration.hpp>
 #include <hpx/plugins/binary_filter/zlib_serialization_filter_registration.hpp>
+#include <hpx/plugins/binary_filter/zstd_serialization_filter_registration.hpp>
 
 #endif
 
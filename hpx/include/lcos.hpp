@@ -15,14 +15,21 @@
 
 #include <hpx/lcos/packaged_action.hpp>
 
+#include <hpx/lcos/all_gather.hpp>
+#include <hpx/lcos/all_reduce.hpp>
+#include <hpx/lcos/all_to_all.hpp>
 #include <hpx/lcos/barrier.hpp>
 #include <hpx/lcos/channel.hpp>
+#include <hpx/lcos/distributed_queue.hpp>
+#include <hpx/lcos/flow_channel.hpp>
 #include <hpx/lcos/gather.hpp>
+#include <hpx/lcos/halo_exchange.hpp>
 #include <hpx/lcos/latch.hpp>
 #if defined(HPX_HAVE_QUEUE_COMPATIBILITY)
 #include <hpx/lcos/queue.hpp>
 #endif
 #include <hpx/lcos/reduce.hpp>
+#include <hpx/lcos/reduce_scatter.hpp>
 
 #include <hpx/include/async.hpp>
 #include <hpx/include/dataflow.hpp>
@@ -9,8 +9,11 @@
 
 #include <hpx/config.hpp>
 #include <hpx/dataflow.hpp>
+#include <hpx/lcos/local/adaptive_mutex.hpp>
 #include <hpx/lcos/local/barrier.hpp>
+#include <hpx/lcos/local/bounded_channel.hpp>
 #include <hpx/lcos/local/channel.hpp>
+#include <hpx/lcos/local/completion_queue.hpp>
 #include <hpx/lcos/local/condition_variable.hpp>
 #include <hpx/lcos/local/counting_semaphore.hpp>
 #include <hpx/lcos/local/event.hpp>
@@ -18,8 +21,10 @@
 #include <hpx/lcos/local/mutex.hpp>
 #include <hpx/lcos/local/no_mutex.hpp>
 #include <hpx/lcos/local/recursive_mutex.hpp>
+#include <hpx/lcos/local/scalable_shared_mutex.hpp>
 #include <hpx/lcos/local/shared_mutex.hpp>
 #include <hpx/lcos/local/sliding_semaphore.hpp>
+#include <hpx/lcos/local/task_graph.hpp>
 
 #include <hpx/lcos/future.hpp>
 #include <hpx/lcos/local/and_gate.hpp>
@@ -27,7 +32,9 @@
 #include <hpx/lcos/local/packaged_task.hpp>
 #include <hpx/lcos/local/promise.hpp>
 #include <hpx/lcos/local/receive_buffer.hpp>
+#include <hpx/lcos/local/ring_receive_buffer.hpp>
 #include <hpx/lcos/local/trigger.hpp>
+#include <hpx/lcos/task.hpp>
 
 #endif
 
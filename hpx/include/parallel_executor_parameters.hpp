@@ -8,10 +8,13 @@
 
 #include <hpx/parallel/executors/execution_parameters.hpp>
 
+#include <hpx/parallel/executors/adaptive_chunk_size.hpp>
 #include <hpx/parallel/executors/auto_chunk_size.hpp>
 #include <hpx/parallel/executors/dynamic_chunk_size.hpp>
 #include <hpx/parallel/executors/guided_chunk_size.hpp>
 #include <hpx/parallel/executors/persistent_auto_chunk_size.hpp>
+#include <hpx/parallel/executors/prefetch_distance.hpp>
 #include <hpx/parallel/executors/static_chunk_size.hpp>
+#include <hpx/parallel/executors/tuned_chunk_size.hpp>
 
 #endif
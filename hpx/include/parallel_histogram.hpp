@@ -0,0 +1,12 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_HISTOGRAM_HPP)
+#define HPX_PARALLEL_HISTOGRAM_HPP
+
+#include <hpx/parallel/algorithms/histogram.hpp>
+#include <hpx/parallel/segmented_algorithms/histogram.hpp>
+
+#endif
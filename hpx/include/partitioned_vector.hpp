@@ -6,6 +6,7 @@
 #if !defined(HPX_PARTITIONED_VECTOR_NOV_02_2014_0636PM)
 #define HPX_PARTITIONED_VECTOR_NOV_02_2014_0636PM
 
+#include <hpx/components/containers/partitioned_vector/partitioned_soa_vector.hpp>
 #include <hpx/components/containers/partitioned_vector/partitioned_vector.hpp>
 
 #endif
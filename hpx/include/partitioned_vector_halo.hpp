@@ -0,0 +1,12 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARTITIONED_VECTOR_HALO_OCT_14_2019_0230PM)
+#define HPX_PARTITIONED_VECTOR_HALO_OCT_14_2019_0230PM
+
+#include <hpx/components/containers/partitioned_vector/partitioned_vector.hpp>
+#include <hpx/components/containers/partitioned_vector/partitioned_vector_halo.hpp>
+
+#endif
@@ -6,6 +6,7 @@
 #if !defined(HPX_RUN_AS_MAR_12_2016_0227PM)
 #define HPX_RUN_AS_MAR_12_2016_0227PM
 
+#include <hpx/runtime/threads/post_from_external.hpp>
 #include <hpx/runtime/threads/run_as_hpx_thread.hpp>
 #include <hpx/runtime/threads/run_as_os_thread.hpp>
 
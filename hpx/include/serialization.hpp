@@ -21,6 +21,7 @@
 #include <hpx/runtime/serialization/multi_array.hpp>
 #include <hpx/runtime/serialization/optional.hpp>
 #include <hpx/runtime/serialization/partitioned_vector.hpp>
+#include <hpx/runtime/serialization/pooled.hpp>
 #include <hpx/runtime/serialization/serialize_buffer.hpp>
 #include <hpx/runtime/serialization/set.hpp>
 #include <hpx/runtime/serialization/shared_ptr.hpp>
@@ -7,6 +7,7 @@
 #define HPX_THREAD_APR_17_2012_1003AM
 
 #include <hpx/runtime/threads/executors.hpp>
+#include <hpx/runtime/threads/post_from_external.hpp>
 #include <hpx/runtime/threads/scheduler_specific_ptr.hpp>
 #include <hpx/runtime/threads/thread.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
@@ -11,6 +11,7 @@
 #include <hpx/traits/action_decorate_continuation.hpp>
 #include <hpx/traits/action_decorate_function.hpp>
 #include <hpx/traits/action_does_termination_detection.hpp>
+#include <hpx/traits/action_is_read_only.hpp>
 #include <hpx/traits/action_is_target_valid.hpp>
 #include <hpx/traits/action_message_handler.hpp>
 #include <hpx/traits/action_priority.hpp>
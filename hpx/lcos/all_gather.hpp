@@ -0,0 +1,153 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file lcos/all_gather.hpp
+
+#if !defined(HPX_LCOS_ALL_GATHER_HPP)
+#define HPX_LCOS_ALL_GATHER_HPP
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// Gather the values contributed by all sites, every site receives all
+    /// values.
+    ///
+    /// \param basename     The base name identifying the operation, all
+    ///                     sites have to use the same name.
+    /// \param local_result The value contributed by this site.
+    /// \param num_sites    The number of participating sites (default: all
+    ///                     localities).
+    /// \param generation   The generational counter identifying the sequence
+    ///                     number of the operation performed on the given
+    ///                     base name. It has to be supplied if the operation
+    ///                     is performed more than once with the same name.
+    /// \param this_site    The sequence number of this site (default: the
+    ///                     locality id).
+    ///
+    /// If \a num_sites is a power of two and the gathered values are smaller
+    /// than \a hpx.lcos.collectives.ring_threshold bytes (default: 65536),
+    /// the values are exchanged using recursive doubling. Otherwise they are
+    /// passed around the ring of sites, each site sends every value once.
+    ///
+    /// \returns    A future holding the values of all sites, ordered by the
+    ///             sequence number of the sites.
+    ///
+    template <typename T>
+    hpx::future<std::vector<typename std::decay<T>::type> >
+    all_gather(char const* basename, T && local_result,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1));
+}}
+#else
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/all_reduce.hpp>
+#include <hpx/lcos/detail/collective_mailbox.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        // in round k this site exchanges the 2^k values it holds with its
+        // partner, num_sites has to be a power of two
+        template <typename T>
+        std::vector<T> all_gather_recursive_doubling(
+            collective_site<std::vector<T> >& site, T value)
+        {
+            std::size_t const num_sites = site.num_sites();
+            std::size_t const this_site = site.this_site();
+
+            std::vector<T> result(num_sites);
+            result[this_site] = std::move(value);
+
+            std::size_t round = 0;
+            for (std::size_t mask = 1; mask < num_sites; mask *= 2, ++round)
+            {
+                std::size_t first = this_site & ~(mask - 1);
+                std::size_t partner = this_site ^ mask;
+                std::size_t partner_first = partner & ~(mask - 1);
+
+                site.send(partner, round, std::vector<T>(
+                    result.begin() + first, result.begin() + first + mask));
+
+                std::vector<T> received = site.receive(round);
+                HPX_ASSERT(received.size() == mask);
+                std::move(received.begin(), received.end(),
+                    result.begin() + partner_first);
+            }
+
+            return result;
+        }
+
+        // in step s this site passes the value it received last to the next
+        // site
+        template <typename T>
+        std::vector<T> all_gather_ring(collective_site<T>& site, T value)
+        {
+            std::size_t const num_sites = site.num_sites();
+            std::size_t const this_site = site.this_site();
+            std::size_t const next = (this_site + 1) % num_sites;
+
+            std::vector<T> result(num_sites);
+            result[this_site] = std::move(value);
+
+            for (std::size_t s = 0; s != num_sites - 1; ++s)
+            {
+                std::size_t send = (this_site + num_sites - s) % num_sites;
+                std::size_t recv = (send + num_sites - 1) % num_sites;
+
+                site.send(next, s, result[send]);
+                result[recv] = site.receive(s);
+            }
+
+            return result;
+        }
+
+        template <typename T>
+        std::vector<T> all_gather_value(std::string const& name, T value,
+            std::size_t num_sites, std::size_t this_site)
+        {
+            bool const is_pow2 = (num_sites & (num_sites - 1)) == 0;
+            if (is_pow2 &&
+                num_sites * sizeof(T) < get_collective_ring_threshold())
+            {
+                collective_site<std::vector<T> > site(
+                    name, num_sites, this_site);
+                return all_gather_recursive_doubling(site, std::move(value));
+            }
+
+            collective_site<T> site(name, num_sites, this_site);
+            return all_gather_ring(site, std::move(value));
+        }
+    }
+
+    template <typename T>
+    hpx::future<std::vector<typename util::decay<T>::type> >
+    all_gather(char const* basename, T && local_result,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        typedef typename util::decay<T>::type value_type;
+
+        detail::get_collective_sites(num_sites, this_site);
+
+        return hpx::async(&detail::all_gather_value<value_type>,
+            detail::get_collective_name(basename, generation),
+            std::forward<T>(local_result), num_sites, this_site);
+    }
+}}
+
+#endif // DOXYGEN
+#endif
@@ -0,0 +1,316 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file lcos/all_reduce.hpp
+
+#if !defined(HPX_LCOS_ALL_REDUCE_HPP)
+#define HPX_LCOS_ALL_REDUCE_HPP
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// Combine the values contributed by all sites using the given binary
+    /// operation, every site receives the result.
+    ///
+    /// \param basename     The base name identifying the operation, all
+    ///                     sites have to use the same name.
+    /// \param local_result The value contributed by this site.
+    /// \param op           The binary operation used to combine the values,
+    ///                     it has to be associative and commutative.
+    /// \param num_sites    The number of participating sites (default: all
+    ///                     localities).
+    /// \param generation   The generational counter identifying the sequence
+    ///                     number of the operation performed on the given
+    ///                     base name. It has to be supplied if the operation
+    ///                     is performed more than once with the same name.
+    /// \param this_site    The sequence number of this site (default: the
+    ///                     locality id).
+    ///
+    /// The operation is performed using recursive doubling, the result is
+    /// available after ceil(log2(num_sites)) message exchanges (plus two, if
+    /// \a num_sites is not a power of two).
+    ///
+    /// \returns    A future holding the combined value of all sites.
+    ///
+    template <typename T, typename F>
+    hpx::future<typename std::decay<T>::type>
+    all_reduce(char const* basename, T && local_result, F && op,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1));
+
+    /// Combine the vectors contributed by all sites element by element using
+    /// the given binary operation, every site receives the result.
+    ///
+    /// \param basename     The base name identifying the operation, all
+    ///                     sites have to use the same name.
+    /// \param local_result The values contributed by this site, all sites
+    ///                     have to contribute the same number of values.
+    /// \param op           The binary operation used to combine the elements,
+    ///                     it has to be associative and commutative.
+    /// \param num_sites    The number of participating sites (default: all
+    ///                     localities).
+    /// \param generation   The generational counter identifying the sequence
+    ///                     number of the operation performed on the given
+    ///                     base name.
+    /// \param this_site    The sequence number of this site (default: the
+    ///                     locality id).
+    ///
+    /// Small vectors are combined using recursive doubling. Vectors of at
+    /// least \a hpx.lcos.collectives.ring_threshold bytes (default: 65536)
+    /// are combined using the ring algorithm (a reduce-scatter followed by
+    /// an all-gather of num_sites chunks), which sends only about twice the
+    /// size of the vector from each site.
+    ///
+    /// \returns    A future holding the combined values of all sites.
+    ///
+    template <typename T, typename F>
+    hpx::future<std::vector<T> >
+    all_reduce(char const* basename, std::vector<T> local_result, F && op,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1));
+}}
+#else
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/detail/collective_mailbox.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        template <typename T>
+        struct is_std_vector : std::false_type {};
+
+        template <typename T>
+        struct is_std_vector<std::vector<T> > : std::true_type {};
+
+        inline std::size_t get_collective_ring_threshold()
+        {
+            return std::stoul(get_config_entry(
+                "hpx.lcos.collectives.ring_threshold", 65536));
+        }
+
+        // combine two vectors element by element
+        template <typename F>
+        struct elementwise_op
+        {
+            template <typename T>
+            std::vector<T> operator()(std::vector<T> const& lhs,
+                std::vector<T> const& rhs) const
+            {
+                if (lhs.size() != rhs.size())
+                {
+                    HPX_THROW_EXCEPTION(bad_parameter,
+                        "hpx::lcos::all_reduce",
+                        "all sites have to contribute the same number of "
+                        "values");
+                }
+
+                std::vector<T> result;
+                result.reserve(lhs.size());
+                for (std::size_t i = 0; i != lhs.size(); ++i)
+                    result.push_back(op_(lhs[i], rhs[i]));
+                return result;
+            }
+
+            F& op_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The sites beyond the largest power of two first send their values
+        // to their partner below it, which finally sends them the result.
+        // Combine is always invoked with the value of the site with the
+        // smaller sequence number first, all sites compute the same result.
+        template <typename T, typename Combine>
+        T all_reduce_recursive_doubling(collective_site<T>& site, T value,
+            Combine& combine)
+        {
+            std::size_t const pre_tag = std::size_t(-1);
+            std::size_t const post_tag = std::size_t(-2);
+
+            std::size_t const num_sites = site.num_sites();
+            std::size_t const this_site = site.this_site();
+
+            std::size_t pow2 = 1;
+            while (2 * pow2 <= num_sites)
+                pow2 *= 2;
+
+            if (this_site >= pow2)
+            {
+                site.send(this_site - pow2, pre_tag, std::move(value));
+                return site.receive(post_tag);
+            }
+
+            bool const has_extra = this_site + pow2 < num_sites;
+            if (has_extra)
+                value = combine(value, site.receive(pre_tag));
+
+            std::size_t round = 0;
+            for (std::size_t mask = 1; mask < pow2; mask *= 2, ++round)
+            {
+                std::size_t partner = this_site ^ mask;
+                site.send(partner, round, value);
+
+                T other = site.receive(round);
+                value = (this_site < partner) ?
+                    combine(value, other) : combine(other, value);
+            }
+
+            if (has_extra)
+                site.send(this_site + pow2, post_tag, value);
+
+            return value;
+        }
+
+        // reduce-scatter followed by all-gather of num_sites chunks passed
+        // around the ring of sites
+        template <typename T, typename F>
+        std::vector<T> all_reduce_ring(collective_site<std::vector<T> >& site,
+            std::vector<T> values, F& op)
+        {
+            std::size_t const num_sites = site.num_sites();
+            std::size_t const this_site = site.this_site();
+            std::size_t const next = (this_site + 1) % num_sites;
+            std::size_t const size = values.size();
+
+            auto chunk_first = [&](std::size_t chunk)
+            {
+                return chunk * size / num_sites;
+            };
+
+            auto receive_chunk = [&](std::size_t tag, std::size_t chunk)
+            {
+                std::vector<T> received = site.receive(tag);
+                if (received.size() != chunk_first(chunk + 1) - chunk_first(chunk))
+                {
+                    HPX_THROW_EXCEPTION(bad_parameter,
+                        "hpx::lcos::all_reduce",
+                        "all sites have to contribute the same number of "
+                        "values");
+                }
+                return received;
+            };
+
+            // after step s, this site holds the combination of s + 2 values
+            // of the chunk received last, eventually this site holds the
+            // final values of the chunk this_site + 1
+            for (std::size_t s = 0; s != num_sites - 1; ++s)
+            {
+                std::size_t send = (this_site + num_sites - s) % num_sites;
+                std::size_t recv = (send + num_sites - 1) % num_sites;
+
+                site.send(next, s, std::vector<T>(
+                    values.begin() + chunk_first(send),
+                    values.begin() + chunk_first(send + 1)));
+
+                std::vector<T> received = receive_chunk(s, recv);
+                std::size_t first = chunk_first(recv);
+                for (std::size_t i = 0; i != received.size(); ++i)
+                    values[first + i] = op(received[i], values[first + i]);
+            }
+
+            // pass the final chunks around the ring
+            for (std::size_t s = 0; s != num_sites - 1; ++s)
+            {
+                std::size_t send = (this_site + 1 + num_sites - s) % num_sites;
+                std::size_t recv = (send + num_sites - 1) % num_sites;
+                std::size_t tag = num_sites - 1 + s;
+
+                site.send(next, tag, std::vector<T>(
+                    values.begin() + chunk_first(send),
+                    values.begin() + chunk_first(send + 1)));
+
+                std::vector<T> received = receive_chunk(tag, recv);
+                std::move(received.begin(), received.end(),
+                    values.begin() + chunk_first(recv));
+            }
+
+            return values;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T, typename F>
+        T all_reduce_value(std::string const& name, T value, F op,
+            std::size_t num_sites, std::size_t this_site)
+        {
+            collective_site<T> site(name, num_sites, this_site);
+            return all_reduce_recursive_doubling(site, std::move(value), op);
+        }
+
+        template <typename T, typename F>
+        std::vector<T> all_reduce_vector(std::string const& name,
+            std::vector<T> values, F op, std::size_t num_sites,
+            std::size_t this_site)
+        {
+            collective_site<std::vector<T> > site(name, num_sites, this_site);
+
+            // all sites contribute the same number of values, they all choose
+            // the same algorithm
+            if (num_sites > 1 && values.size() >= num_sites &&
+                values.size() * sizeof(T) >= get_collective_ring_threshold())
+            {
+                return all_reduce_ring(site, std::move(values), op);
+            }
+
+            elementwise_op<F> combine{op};
+            return all_reduce_recursive_doubling(site, std::move(values),
+                combine);
+        }
+    }
+
+    template <typename T, typename F>
+    typename std::enable_if<
+        !detail::is_std_vector<typename util::decay<T>::type>::value,
+        hpx::future<typename util::decay<T>::type>
+    >::type
+    all_reduce(char const* basename, T && local_result, F && op,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        typedef typename util::decay<T>::type value_type;
+        typedef typename util::decay<F>::type op_type;
+
+        detail::get_collective_sites(num_sites, this_site);
+
+        return hpx::async(&detail::all_reduce_value<value_type, op_type>,
+            detail::get_collective_name(basename, generation),
+            std::forward<T>(local_result), std::forward<F>(op), num_sites,
+            this_site);
+    }
+
+    template <typename T, typename F>
+    hpx::future<std::vector<T> >
+    all_reduce(char const* basename, std::vector<T> local_result, F && op,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        typedef typename util::decay<F>::type op_type;
+
+        detail::get_collective_sites(num_sites, this_site);
+
+        return hpx::async(&detail::all_reduce_vector<T, op_type>,
+            detail::get_collective_name(basename, generation),
+            std::move(local_result), std::forward<F>(op), num_sites,
+            this_site);
+    }
+}}
+
+#endif // DOXYGEN
+#endif
@@ -0,0 +1,108 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file lcos/all_to_all.hpp
+
+#if !defined(HPX_LCOS_ALL_TO_ALL_HPP)
+#define HPX_LCOS_ALL_TO_ALL_HPP
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// Exchange one value between every pair of sites.
+    ///
+    /// \param basename     The base name identifying the operation, all
+    ///                     sites have to use the same name.
+    /// \param local_result The values contributed by this site, the value at
+    ///                     position i is sent to site i. It has to hold
+    ///                     exactly \a num_sites values.
+    /// \param num_sites    The number of participating sites (default: all
+    ///                     localities).
+    /// \param generation   The generational counter identifying the sequence
+    ///                     number of the operation performed on the given
+    ///                     base name. It has to be supplied if the operation
+    ///                     is performed more than once with the same name.
+    /// \param this_site    The sequence number of this site (default: the
+    ///                     locality id).
+    ///
+    /// \returns    A future holding the values sent to this site, the value
+    ///             at position i was contributed by site i.
+    ///
+    template <typename T>
+    hpx::future<std::vector<T> >
+    all_to_all(char const* basename, std::vector<T> local_result,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1));
+}}
+#else
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/detail/collective_mailbox.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        // every site sends to the sites following it first to avoid all
+        // sites sending to the same site at the same time
+        template <typename T>
+        std::vector<T> all_to_all_values(std::string const& name,
+            std::vector<T> values, std::size_t num_sites,
+            std::size_t this_site)
+        {
+            collective_site<T> site(name, num_sites, this_site);
+
+            for (std::size_t k = 1; k != num_sites; ++k)
+            {
+                std::size_t dest = (this_site + k) % num_sites;
+                site.send(dest, this_site, std::move(values[dest]));
+            }
+
+            std::vector<T> result(num_sites);
+            for (std::size_t k = 1; k != num_sites; ++k)
+            {
+                std::size_t src = (this_site + num_sites - k) % num_sites;
+                result[src] = site.receive(src);
+            }
+            result[this_site] = std::move(values[this_site]);
+
+            return result;
+        }
+    }
+
+    template <typename T>
+    hpx::future<std::vector<T> >
+    all_to_all(char const* basename, std::vector<T> local_result,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        detail::get_collective_sites(num_sites, this_site);
+
+        if (local_result.size() != num_sites)
+        {
+            return hpx::make_exceptional_future<std::vector<T> >(
+                HPX_GET_EXCEPTION(bad_parameter, "hpx::lcos::all_to_all",
+                    "the number of values has to be equal to the number of "
+                    "sites"));
+        }
+
+        return hpx::async(&detail::all_to_all_values<T>,
+            detail::get_collective_name(basename, generation),
+            std::move(local_result), num_sites, this_site);
+    }
+}}
+
+#endif // DOXYGEN
+#endif
@@ -29,6 +29,34 @@ namespace hpx { namespace lcos {
     }
     /// \endcond
 
+    /// The algorithms which can be used by a \a hpx::lcos::barrier.
+    ///
+    /// The algorithm used by default is selected with the configuration
+    /// setting \a hpx.lcos.barrier.algorithm (\a tree, \a dissemination, or
+    /// \a hierarchical, default: \a tree).
+    enum class barrier_algorithm
+    {
+        /// The participants notify the participant with rank 0, either
+        /// directly or along a tree with the arity
+        /// \a hpx.lcos.collectives.arity (if there are at least
+        /// \a hpx.lcos.collectives.cut_off participants), which in turn
+        /// releases all participants.
+        tree = 0,
+
+        /// In each of the ceil(log2(num)) rounds, the participant with rank
+        /// i notifies the participant with rank (i + 2^round) % num and waits
+        /// for the notification of the participant with rank
+        /// (i - 2^round) % num. There is no central participant, all
+        /// participants leave the barrier after the same number of rounds.
+        dissemination = 1,
+
+        /// The participants located on the same locality synchronize
+        /// locally first, then one participant for each locality performs
+        /// the dissemination algorithm with the participants of the other
+        /// localities and releases the participants of its locality.
+        hierarchical = 2
+    };
+
     /// The barrier is an implementation performing a barrier over a number of
     /// participating threads. The different threads don't have to be on the
     /// same locality. This barrier can be invoked in a distributed application.
@@ -70,6 +98,20 @@ namespace hpx { namespace lcos {
         /// \a num participate and the local rank is \a rank.
         barrier(std::string const&  base_name, std::size_t num, std::size_t rank);
 
+        /// Creates a barrier with a given size and rank using the given
+        /// algorithm
+        ///
+        /// \param base_name The name of the barrier
+        /// \param num The number of participating threads
+        /// \param rank The rank of the calling site for this invocation
+        /// \param algorithm The algorithm to use, all participants must use
+        ///                  the same algorithm
+        ///
+        /// A barrier \a base_name is created. It expects that
+        /// \a num participate and the local rank is \a rank.
+        barrier(std::string const& base_name, std::size_t num, std::size_t rank,
+            barrier_algorithm algorithm);
+
         /// \cond NOINTERNAL
         barrier(barrier&& other);
         barrier& operator=(barrier&& other);
@@ -160,8 +160,17 @@ namespace hpx { namespace lcos
         ///
         /// \param RemoteResult [in] The type of the result to be transferred
         ///               back to this LCO instance.
-        HPX_DEFINE_COMPONENT_DIRECT_ACTION(base_lco_with_value,
-            set_value_nonvirt, set_value_action);
+        ///
+        /// Setting the value of an LCO does not suspend, this action is
+        /// executed directly on the thread receiving the parcel.
+        struct set_value_action
+          : hpx::actions::make_direct_action<
+                decltype(&base_lco_with_value::set_value_nonvirt),
+                &base_lco_with_value::set_value_nonvirt, set_value_action
+            >::type
+        {
+            typedef std::true_type non_blocking;
+        };
 
         /// The \a get_value_action may be used to query the value this LCO
         /// instance exposes as its 'result' value.
@@ -30,9 +30,9 @@
 #include <hpx/util/always_void.hpp>
 #include <hpx/util/annotated_function.hpp>
 #include <hpx/util/deferred_call.hpp>
-#include <hpx/util/internal_allocator.hpp>
 #include <hpx/util/invoke_fused.hpp>
 #include <hpx/util/pack_traversal_async.hpp>
+#include <hpx/util/tagged_allocator.hpp>
 #include <hpx/util/thread_description.hpp>
 #include <hpx/util/tuple.hpp>
 
@@ -306,6 +306,18 @@ namespace hpx { namespace lcos { namespace detail
                 std::forward<T>(current), std::forward<N>(next));
         }
 
+        /// Detach the current execution context and continue when all of
+        /// the remaining futures of a range were set to be ready.
+        template <typename T, typename N>
+        auto operator()(
+            util::async_traverse_detach_range_tag, T&& range, N&& next)
+            -> decltype(async_detach_future_range(
+                std::forward<T>(range), std::forward<N>(next)))
+        {
+            return async_detach_future_range(
+                std::forward<T>(range), std::forward<N>(next));
+        }
+
         /// Finish the dataflow when the traversal has finished
         HPX_FORCEINLINE void operator()(
             util::async_traverse_complete_tag, Futures futures)
@@ -526,12 +538,12 @@ namespace hpx
     auto dataflow(F && f, Ts &&... ts)
     ->  decltype(
             lcos::detail::dataflow_dispatch<typename std::decay<F>::type>::call(
-                hpx::util::internal_allocator<>{}, std::forward<F>(f),
+                hpx::util::future_state_allocator<>{}, std::forward<F>(f),
                 std::forward<Ts>(ts)...
         ))
     {
         return lcos::detail::dataflow_dispatch<typename std::decay<F>::type>::
-            call(hpx::util::internal_allocator<>{}, std::forward<F>(f),
+            call(hpx::util::future_state_allocator<>{}, std::forward<F>(f),
                 std::forward<Ts>(ts)...);
     }
 
@@ -554,11 +566,11 @@ namespace hpx
     HPX_FORCEINLINE
     auto dataflow(T0 && t0, Ts &&... ts)
     ->  decltype(lcos::detail::dataflow_action_dispatch<Action, T0>::call(
-            hpx::util::internal_allocator<>{}, std::forward<T0>(t0),
+            hpx::util::future_state_allocator<>{}, std::forward<T0>(t0),
             std::forward<Ts>(ts)...))
     {
         return lcos::detail::dataflow_action_dispatch<Action, T0>::call(
-            hpx::util::internal_allocator<>{}, std::forward<T0>(t0),
+            hpx::util::future_state_allocator<>{}, std::forward<T0>(t0),
             std::forward<Ts>(ts)...);
     }
 
@@ -13,8 +13,10 @@
 #include <hpx/runtime/launch_policy.hpp>
 #include <hpx/runtime/naming/address.hpp>
 #include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/naming/name.hpp>
 #include <hpx/runtime/threads/thread.hpp>
 #include <hpx/runtime/threads/thread_init_data.hpp>
+#include <hpx/runtime_fwd.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/traits/action_decorate_function.hpp>
 #include <hpx/traits/action_was_object_migrated.hpp>
@@ -26,8 +28,14 @@
 #include <hpx/util/assert.hpp>
 
 #include <cstddef>
+#include <type_traits>
 #include <utility>
 
+namespace hpx { namespace actions { namespace detail
+{
+    struct plain_function;
+}}}
+
 namespace hpx { namespace detail
 {
     /// \cond NOINTERNAL
@@ -389,6 +397,37 @@ namespace hpx { namespace detail
         return true;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Plain actions targeting this locality don't have to be resolved, the
+    // address they are invoked with is ignored and localities can't migrate.
+    template <typename Action>
+    struct is_plain_action
+      : std::is_same<typename Action::component_type,
+            actions::detail::plain_function>
+    {};
+
+    inline bool is_local_plain_action_target(
+        hpx::id_type const& id, naming::address& addr, std::true_type)
+    {
+        naming::gid_type const& here = hpx::get_locality();
+        naming::gid_type const& gid = id.get_gid();
+        if (naming::get_locality_id_from_gid(gid) !=
+                naming::get_locality_id_from_gid(here) ||
+            !naming::is_locality(gid))
+        {
+            return false;
+        }
+
+        addr = naming::address(here, components::component_plain_function);
+        return true;
+    }
+
+    inline bool is_local_plain_action_target(
+        hpx::id_type const&, naming::address&, std::false_type)
+    {
+        return false;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename Action, typename Launch, typename ...Ts>
     hpx::future<
@@ -402,6 +441,14 @@ namespace hpx { namespace detail
         std::pair<bool, components::pinned_ptr> r;
 
         naming::address addr;
+        if (is_local_plain_action_target(
+                id, addr, is_plain_action<action_type>()) &&
+            can_invoke_locally<action_type>())
+        {
+            return async_local_impl<Action>(
+                policy, id, addr, r, std::forward<Ts>(vs)...);
+        }
+
         if (agas::is_local_address_cached(id, addr) &&
             can_invoke_locally<action_type>())
         {
@@ -7,6 +7,7 @@
 #define HPX_LCOS_DETAIL_BARRIER_NODE_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/lcos/barrier.hpp>
 #include <hpx/lcos/base_lco.hpp>
 #include <hpx/lcos/future.hpp>
 #include <hpx/lcos/local/barrier.hpp>
@@ -19,7 +20,9 @@
 #include <hpx/util/atomic_count.hpp>
 
 #include <cstddef>
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <hpx/config/warnings_prefix.hpp>
@@ -48,12 +51,28 @@ namespace hpx { namespace lcos { namespace detail {
 
         barrier_node();
         barrier_node(std::string base_name, std::size_t num, std::size_t rank);
+        barrier_node(std::string base_name, std::size_t num, std::size_t rank,
+            barrier_algorithm algorithm);
         void set_event();
         hpx::future<void> gather();
 
+        // notification sent by other participants of the dissemination and
+        // hierarchical algorithms, tag is the round (or local_gather_tag or
+        // local_release_tag), episode is the sequence number of the barrier
+        // operation
+        void signal(std::size_t tag, std::size_t episode);
+
         hpx::future<void> wait(bool async);
 
+        // Returns whether this node has to be registered with the base name
+        bool needs_registration() const
+        {
+            return algorithm_ != barrier_algorithm::tree || num_ >= cut_off_ ||
+                rank_ == 0;
+        }
+
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(barrier_node, gather);
+        HPX_DEFINE_COMPONENT_DIRECT_ACTION(barrier_node, signal);
 
     private:
         hpx::util::atomic_count count_;
@@ -66,6 +85,7 @@ namespace hpx { namespace lcos { namespace detail {
         std::size_t num_;
         std::size_t arity_;
         std::size_t cut_off_;
+        barrier_algorithm algorithm_;
     private:
         hpx::lcos::local::promise<void> gather_promise_;
         hpx::lcos::local::promise<void> broadcast_promise_;
@@ -74,6 +94,48 @@ namespace hpx { namespace lcos { namespace detail {
         template <typename This>
         hpx::future<void> do_wait(This this_, hpx::future<void> future);
 
+        ///////////////////////////////////////////////////////////////////////
+        // dissemination and hierarchical algorithms
+        static std::size_t const local_gather_tag = std::size_t(-1);
+        static std::size_t const local_release_tag = std::size_t(-2);
+
+        struct signal_data
+        {
+            signal_data()
+              : received_(0), expected_(0)
+            {}
+
+            std::size_t received_;
+            std::size_t expected_;      // zero until somebody waits
+            hpx::lcos::local::promise<void> promise_;
+        };
+
+        // the future becomes ready once count signals with the given tag and
+        // episode have been received
+        hpx::future<void> wait_for_signals(
+            std::size_t tag, std::size_t episode, std::size_t count);
+
+        void connected(std::vector<naming::id_type> ids);
+        hpx::future<void> disseminate(std::size_t episode);
+        hpx::future<void> disseminate(std::size_t round, std::size_t episode);
+
+        mutex_type mtx_;
+        std::map<std::pair<std::size_t, std::size_t>, signal_data> signals_;
+        std::size_t episode_;
+
+        // the ids of the nodes to resolve before the first operation
+        std::vector<hpx::future<naming::id_type> > connecting_;
+        bool connected_;
+
+        // the partner of each of the rounds of the dissemination
+        std::vector<naming::id_type> partners_;
+
+        // the other participants located on this locality, if this is the
+        // participant communicating with the other localities, or the
+        // participant communicating for this locality, otherwise
+        std::vector<naming::id_type> local_participants_;
+        bool is_leader_;
+
         template <typename>
         friend struct components::detail_adl_barrier::init;
 
@@ -101,6 +163,8 @@ namespace hpx { namespace lcos { namespace detail {
 
 HPX_REGISTER_ACTION_DECLARATION(hpx::lcos::detail::barrier_node::gather_action,
     barrier_node_gather_action);
+HPX_REGISTER_ACTION_DECLARATION(hpx::lcos::detail::barrier_node::signal_action,
+    barrier_node_signal_action);
 
 #include <hpx/config/warnings_suffix.hpp>
 
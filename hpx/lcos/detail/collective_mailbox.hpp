@@ -0,0 +1,287 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_DETAIL_COLLECTIVE_MAILBOX_HPP)
+#define HPX_LCOS_DETAIL_COLLECTIVE_MAILBOX_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/apply.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/basename_registration.hpp>
+#include <hpx/runtime/components/new.hpp>
+#include <hpx/runtime/components/server/simple_component_base.hpp>
+#include <hpx/runtime/get_num_localities.hpp>
+#include <hpx/runtime/get_ptr.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/naming/unmanaged.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/detail/pp/cat.hpp>
+#include <hpx/util/detail/pp/expand.hpp>
+#include <hpx/util/detail/pp/nargs.hpp>
+#include <hpx/util/optional.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The mailbox of one of the sites participating in a collective
+    // operation. The other sites deposit the messages for this site, each
+    // message is identified by a tag (usually the step of the algorithm
+    // which sends it). Messages may arrive before they are retrieved.
+    template <typename T>
+    class collective_mailbox
+      : public hpx::components::simple_component_base<collective_mailbox<T> >
+    {
+        typedef lcos::local::spinlock mutex_type;
+
+        struct slot
+        {
+            slot() : waiting_(false) {}
+
+            util::optional<T> value_;
+            bool waiting_;
+            lcos::local::promise<T> promise_;
+        };
+
+    public:
+        collective_mailbox() //-V730
+        {
+            HPX_ASSERT(false);  // shouldn't ever be called
+        }
+
+        collective_mailbox(std::string const& name, std::size_t site)
+          : name_(name), site_(site)
+        {}
+
+        ~collective_mailbox()
+        {
+            hpx::unregister_with_basename(name_, site_);
+        }
+
+        void deposit(std::size_t tag, T value)
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+
+            typename std::map<std::size_t, slot>::iterator it =
+                slots_.insert(std::make_pair(tag, slot())).first;
+
+            if (!it->second.waiting_)
+            {
+                HPX_ASSERT(!it->second.value_);
+                it->second.value_ = std::move(value);
+                return;
+            }
+
+            lcos::local::promise<T> p(std::move(it->second.promise_));
+            slots_.erase(it);
+
+            l.unlock();
+            p.set_value(std::move(value));
+        }
+
+        hpx::future<T> retrieve(std::size_t tag)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+
+            typename std::map<std::size_t, slot>::iterator it =
+                slots_.insert(std::make_pair(tag, slot())).first;
+
+            if (it->second.value_)
+            {
+                T value = std::move(*it->second.value_);
+                slots_.erase(it);
+                return hpx::make_ready_future(std::move(value));
+            }
+
+            HPX_ASSERT(!it->second.waiting_);
+            it->second.waiting_ = true;
+            return it->second.promise_.get_future();
+        }
+
+        HPX_DEFINE_COMPONENT_ACTION(
+            collective_mailbox, deposit, deposit_action);
+
+    private:
+        mutex_type mtx_;
+        std::map<std::size_t, slot> slots_;
+        std::string name_;
+        std::size_t site_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    inline std::string get_collective_name(char const* basename,
+        std::size_t generation)
+    {
+        std::string name(basename);
+        if (generation != std::size_t(-1))
+            name += std::to_string(generation) + "/";
+        return name;
+    }
+
+    // The state of one site of a collective operation: the mailbox of this
+    // site, registered with the basename of the operation, and the ids of the
+    // mailboxes of the other sites this site has sent messages to.
+    //
+    // The functions of this class block, they have to be called on an HPX
+    // thread.
+    template <typename T>
+    class collective_site
+    {
+        typedef collective_mailbox<T> mailbox_type;
+
+    public:
+        collective_site(std::string name, std::size_t num_sites,
+                std::size_t this_site)
+          : name_(std::move(name)),
+            num_sites_(num_sites),
+            this_site_(this_site)
+        {
+            if (this_site_ >= num_sites_)
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "hpx::lcos::detail::collective_site::collective_site",
+                    "the site must be smaller than the number of sites");
+            }
+
+            id_ = hpx::new_<mailbox_type>(hpx::find_here(), name_, this_site_)
+                .get();
+            mailbox_ = hpx::get_ptr<mailbox_type>(hpx::launch::sync, id_);
+
+            // Register unmanaged id to avoid cyclic dependencies, unregister
+            // is done in the destructor of the mailbox.
+            if (!hpx::register_with_basename(
+                    name_, hpx::unmanaged(id_), this_site_).get())
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "hpx::lcos::detail::collective_site::collective_site",
+                    "the given base name for the collective operation was "
+                    "already registered: " + name_);
+            }
+        }
+
+        std::size_t num_sites() const { return num_sites_; }
+        std::size_t this_site() const { return this_site_; }
+
+        // send a message to the given site, this doesn't wait for the
+        // message to arrive
+        void send(std::size_t site, std::size_t tag, T value)
+        {
+            HPX_ASSERT(site < num_sites_ && site != this_site_);
+
+            typedef typename mailbox_type::deposit_action action_type;
+            hpx::apply(action_type(), get_id(site), tag, std::move(value));
+        }
+
+        // wait for the message with the given tag sent to this site
+        T receive(std::size_t tag)
+        {
+            return mailbox_->retrieve(tag).get();
+        }
+
+    private:
+        hpx::id_type const& get_id(std::size_t site)
+        {
+            std::map<std::size_t, hpx::id_type>::iterator it =
+                sites_.find(site);
+            if (it == sites_.end())
+            {
+                it = sites_.insert(std::make_pair(site,
+                    hpx::find_from_basename(name_, site).get())).first;
+            }
+            return it->second;
+        }
+
+        std::string name_;
+        std::size_t num_sites_;
+        std::size_t this_site_;
+
+        hpx::id_type id_;
+        std::shared_ptr<mailbox_type> mailbox_;
+        std::map<std::size_t, hpx::id_type> sites_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    inline void get_collective_sites(std::size_t& num_sites,
+        std::size_t& this_site)
+    {
+        if (num_sites == std::size_t(-1))
+            num_sites = hpx::get_num_localities(hpx::launch::sync);
+        if (this_site == std::size_t(-1))
+            this_site = static_cast<std::size_t>(hpx::get_locality_id());
+    }
+}}}
+
+///////////////////////////////////////////////////////////////////////////////
+// The collective operations all_reduce, all_gather, all_to_all, and
+// reduce_scatter exchange messages of type 'type' and std::vector<type>,
+// both are registered by these macros.
+#define HPX_REGISTER_COLLECTIVES_DECLARATION(...)                             \
+    HPX_REGISTER_COLLECTIVES_DECLARATION_(__VA_ARGS__)                        \
+    /**/
+
+#define HPX_REGISTER_COLLECTIVES_DECLARATION_(...)                            \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_COLLECTIVES_DECLARATION_, HPX_PP_NARGS(__VA_ARGS__)      \
+    )(__VA_ARGS__))                                                           \
+    /**/
+
+#define HPX_REGISTER_COLLECTIVES_DECLARATION_1(type)                          \
+    HPX_REGISTER_COLLECTIVES_DECLARATION_2(type, HPX_PP_CAT(type, _collective))\
+    /**/
+
+#define HPX_REGISTER_COLLECTIVES_DECLARATION_2(type, name)                    \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::detail::collective_mailbox<type>::deposit_action,          \
+        HPX_PP_CAT(collective_deposit_action_, name));                        \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::detail::collective_mailbox<                                \
+            std::vector<type> >::deposit_action,                              \
+        HPX_PP_CAT(collective_deposit_vector_action_, name))                  \
+    /**/
+
+#define HPX_REGISTER_COLLECTIVES(...)                                         \
+    HPX_REGISTER_COLLECTIVES_(__VA_ARGS__)                                    \
+    /**/
+
+#define HPX_REGISTER_COLLECTIVES_(...)                                        \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_COLLECTIVES_, HPX_PP_NARGS(__VA_ARGS__)                  \
+    )(__VA_ARGS__))                                                           \
+    /**/
+
+#define HPX_REGISTER_COLLECTIVES_1(type)                                      \
+    HPX_REGISTER_COLLECTIVES_2(type, HPX_PP_CAT(type, _collective))           \
+    /**/
+
+#define HPX_REGISTER_COLLECTIVES_2(type, name)                                \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::detail::collective_mailbox<type>::deposit_action,          \
+        HPX_PP_CAT(collective_deposit_action_, name));                        \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::detail::collective_mailbox<                                \
+            std::vector<type> >::deposit_action,                              \
+        HPX_PP_CAT(collective_deposit_vector_action_, name));                 \
+    typedef hpx::components::simple_component<                                \
+        hpx::lcos::detail::collective_mailbox<type>                           \
+    > HPX_PP_CAT(collective_mailbox_, name);                                  \
+    HPX_REGISTER_COMPONENT(HPX_PP_CAT(collective_mailbox_, name))             \
+    typedef hpx::components::simple_component<                                \
+        hpx::lcos::detail::collective_mailbox<std::vector<type> >             \
+    > HPX_PP_CAT(collective_vector_mailbox_, name);                           \
+    HPX_REGISTER_COMPONENT(HPX_PP_CAT(collective_vector_mailbox_, name))      \
+    /**/
+
+#endif
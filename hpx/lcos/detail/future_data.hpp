@@ -8,6 +8,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/error_code.hpp>
+#include <hpx/lcos/detail/thread_local_pool.hpp>
 #include <hpx/lcos/local/detail/condition_variable.hpp>
 #include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/runtime/launch_policy.hpp>
@@ -40,6 +41,7 @@
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <memory>
 #include <mutex>
@@ -242,6 +244,13 @@ namespace detail
             return state_.load(std::memory_order_acquire) == exception;
         }
 
+        state get_state(
+            std::memory_order order = std::memory_order_acquire) const
+        {
+            std::uintptr_t s = state_.load(order);
+            return (s & ready) != 0 ? static_cast<state>(s) : empty;
+        }
+
         virtual void execute_deferred(error_code& /*ec*/ = throws) {}
 
         // cancellation is disabled by default
@@ -279,6 +288,22 @@ namespace detail
         /// immediately.
         void set_on_completed(completed_callback_type data_sink) override;
 
+        /// An intrusive continuation, used by operations which attach
+        /// continuations to many shared states at once. The hook is owned by
+        /// the caller and has to stay alive until it has been invoked. It is
+        /// invoked with \a is_ready set to false if the shared state is reset
+        /// or destroyed before becoming ready.
+        struct completion_hook
+        {
+            void (*on_completed_)(completion_hook*, bool is_ready) = nullptr;
+            completion_hook* next_ = nullptr;
+        };
+
+        /// Register the given hook to be invoked once this shared state
+        /// becomes ready. Returns false without registering the hook if the
+        /// shared state is ready already.
+        bool add_completion_hook(completion_hook* hook);
+
         virtual state wait(error_code& ec = throws);
 
         virtual future_status wait_until(
@@ -300,9 +325,38 @@ namespace detail
         }
 
     protected:
+        // Atomically change the state to the given ready state. Wakes up all
+        // waiting threads and invokes all registered continuations. Returns
+        // false if the shared state was ready already.
+        bool make_ready(state s);
+
+        // Release the stack of continuations which were never invoked.
+        static void release_on_completed(std::uintptr_t s) noexcept;
+
+        // Invoke the given list of continuations in order.
+        static void invoke_completion_hooks(completion_hook* hook) noexcept;
+
+        // Mark the shared state to have threads waiting on cond_, returns
+        // false if it is ready already. Has to be called while holding mtx_.
+        bool add_waiter();
+
+        // Before the shared state becomes ready, the state word holds the
+        // (intrusive) stack of registered completion hooks, tagged with
+        // whether threads are waiting on cond_. Once it is ready, it holds
+        // the (odd) ready state. Continuations are attached and the shared
+        // state is made ready without acquiring mtx_ unless threads are
+        // waiting.
+        struct completed_callback_node;
+
+        static_assert(alignof(completion_hook) >= 4,
+            "the low bits of the state word are used as tags");
+
+        HPX_STATIC_CONSTEXPR std::uintptr_t has_waiters = 2;
+        HPX_STATIC_CONSTEXPR std::uintptr_t callbacks_mask =
+            ~(std::uintptr_t(ready) | has_waiters);
+
         mutable mutex_type mtx_;
-        std::atomic<state> state_;                  // current state
-        completed_callback_vector_type on_completed_;
+        std::atomic<std::uintptr_t> state_;         // current state
         local::detail::condition_variable cond_;    // threads waiting in read
     };
 
@@ -416,47 +470,16 @@ namespace detail
             result_type* value_ptr = reinterpret_cast<result_type*>(&storage_);
             construct(value_ptr, std::forward<Ts>(ts)...);
 
-            // At this point the lock needs to be acquired to safely access the
-            // registered continuations
-            std::unique_lock<mutex_type> l(mtx_);
-
-            // handle all threads waiting for the future to become ready
-            auto on_completed = std::move(on_completed_);
-            on_completed_.clear();
-
             // The value has been set, changing the state to 'value' at this
             // point signals to all other threads that this future is ready.
-            state expected = empty;
-            if (!state_.compare_exchange_strong(
-                    expected, value, std::memory_order_release))
+            if (!this->make_ready(value))
             {
                 // this future should be 'empty' still (it can't be made ready
                 // more than once).
-                l.unlock();
                 HPX_THROW_EXCEPTION(promise_already_satisfied,
                     "future_data_base::set_value",
                     "data has already been set for this future");
-                return;
-            }
-
-            // Note: we use notify_one repeatedly instead of notify_all as we
-            //       know: a) that most of the time we have at most one thread
-            //       waiting on the future (most futures are not shared), and
-            //       b) our implementation of condition_variable::notify_one
-            //       relinquishes the lock before resuming the waiting thread
-            //       which avoids suspension of this thread when it tries to
-            //       re-lock the mutex while exiting from condition_variable::wait
-            while (cond_.notify_one(std::move(l), threads::thread_priority_boost))
-            {
-                l = std::unique_lock<mutex_type>(mtx_);
             }
-
-            // Note: cv.notify_one() above 'consumes' the lock 'l' and leaves
-            //       it unlocked when returning.
-
-            // invoke the callback (continuation) function
-            if (!on_completed.empty())
-                handle_on_completed(std::move(on_completed));
         }
 
         void set_exception(std::exception_ptr data) override
@@ -472,47 +495,16 @@ namespace detail
                 reinterpret_cast<std::exception_ptr*>(&storage_);
             ::new ((void*)exception_ptr) std::exception_ptr(std::move(data));
 
-            // At this point the lock needs to be acquired to safely access the
-            // registered continuations
-            std::unique_lock<mutex_type> l(mtx_);
-
-            // handle all threads waiting for the future to become ready
-            auto on_completed = std::move(on_completed_);
-            on_completed_.clear();
-
             // The value has been set, changing the state to 'exception' at this
             // point signals to all other threads that this future is ready.
-            state expected = empty;
-            if (!state_.compare_exchange_strong(
-                    expected, exception, std::memory_order_release))
+            if (!this->make_ready(exception))
             {
                 // this future should be 'empty' still (it can't be made ready
                 // more than once).
-                l.unlock();
                 HPX_THROW_EXCEPTION(promise_already_satisfied,
                     "future_data_base::set_exception",
                     "data has already been set for this future");
-                return;
-            }
-
-            // Note: we use notify_one repeatedly instead of notify_all as we
-            //       know: a) that most of the time we have at most one thread
-            //       waiting on the future (most futures are not shared), and
-            //       b) our implementation of condition_variable::notify_one
-            //       relinquishes the lock before resuming the waiting thread
-            //       which avoids suspension of this thread when it tries to
-            //       re-lock the mutex while exiting from condition_variable::wait
-            while (cond_.notify_one(std::move(l), threads::thread_priority_boost))
-            {
-                l = std::unique_lock<mutex_type>(mtx_);
             }
-
-            // Note: cv.notify_one() above 'consumes' the lock 'l' and leaves
-            //       it unlocked when returning.
-
-            // invoke the callback (continuation) function
-            if (!on_completed.empty())
-                handle_on_completed(std::move(on_completed));
         }
 
         // helper functions for setting data (if successful) or the error (if
@@ -574,7 +566,8 @@ namespace detail
             // and no reader
 
             // release any stored data and callback functions
-            switch (state_.exchange(empty)) {
+            std::uintptr_t s = state_.exchange(empty);
+            switch (s) {
             case value:
             {
                 result_type* value_ptr =
@@ -589,10 +582,10 @@ namespace detail
                 exception_ptr->~exception_ptr();
                 break;
             }
-            default: break;
+            default:
+                release_on_completed(s);
+                break;
             }
-
-            on_completed_.clear();
         }
 
         std::exception_ptr get_exception_ptr() const override
@@ -604,18 +597,59 @@ namespace detail
     protected:
         using base_type::mtx_;
         using base_type::state_;
-        using base_type::on_completed_;
 
     private:
         using base_type::cond_;
         typename future_data_storage<Result>::type storage_;
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Shared states holding small trivially copyable values (or no value) are
+    // allocated from free lists kept for each worker thread. This applies to
+    // all shared states derived from future_data<Result> which are created
+    // using new (i.e. not through a user supplied allocator).
+    template <typename Result>
+    struct use_pooled_future_data
+      : std::integral_constant<bool,
+            std::is_trivially_copyable<
+                typename future_data_result<Result>::type>::value &&
+            sizeof(typename future_data_result<Result>::type) <=
+                4 * sizeof(void*)>
+    {};
+
+    template <typename Result,
+        bool Pooled = use_pooled_future_data<Result>::value>
+    struct future_data_allocation
+    {};
+
+    template <typename Result>
+    struct future_data_allocation<Result, true>
+    {
+        static void* operator new(std::size_t size)
+        {
+            return thread_local_pool::allocate(size);
+        }
+
+        static void operator delete(void* p, std::size_t size) noexcept
+        {
+            thread_local_pool::deallocate(p, size);
+        }
+
+        static void* operator new(std::size_t, void* p) noexcept
+        {
+            return p;
+        }
+
+        static void operator delete(void*, void*) noexcept {}
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     // Customization point to have the ability for creating distinct shared
     // states depending on the value type held.
     template <typename Result>
-    struct future_data : future_data_base<Result>
+    struct future_data
+      : future_data_base<Result>
+      , future_data_allocation<Result>
     {
         HPX_NON_COPYABLE(future_data);
 
@@ -751,11 +785,12 @@ namespace detail
 
     public:
         task_base()
-          : started_(false)
+          : started_(false), id_(threads::invalid_thread_id)
         {}
 
         task_base(init_no_addref no_addref)
-          : base_type(no_addref), started_(false)
+          : base_type(no_addref), started_(false),
+            id_(threads::invalid_thread_id)
         {}
 
         virtual void execute_deferred(error_code& /*ec*/ = throws)
@@ -777,6 +812,8 @@ namespace detail
         {
             if (!started_test_and_set())
                 this->do_run();
+            else if (!this->is_ready())
+                inherit_priority();
             return this->future_data<Result>::wait(ec);
         }
 
@@ -786,10 +823,26 @@ namespace detail
         {
             if (!started_test())
                 return future_status::deferred; //-V110
+            if (!this->is_ready())
+                inherit_priority();
             return this->future_data<Result>::wait_until(abs_time, ec);
         }
 
     private:
+        // The thread running this task inherits the priority and the deadline
+        // of the waiting thread if those are more urgent, which keeps urgent
+        // threads from waiting for less urgent ones. Tasks which have not
+        // started running yet are not affected.
+        void inherit_priority()
+        {
+            if (threads::get_self_ptr() == nullptr)
+                return;
+
+            std::lock_guard<mutex_type> l(this->mtx_);
+            if (id_ != threads::invalid_thread_id)
+                threads::inherit_thread_priority(id_, threads::get_self_id());
+        }
+
         bool started_test() const
         {
             std::lock_guard<mutex_type> l(this->mtx_);
@@ -847,8 +900,35 @@ namespace detail
         }
 
     protected:
+        threads::thread_id_type get_thread_id() const
+        {
+            std::lock_guard<mutex_type> l(this->mtx_);
+            return id_;
+        }
+        void set_thread_id(threads::thread_id_type id)
+        {
+            std::lock_guard<mutex_type> l(this->mtx_);
+            id_ = id;
+        }
+
+        // records the thread running the task
+        struct reset_id
+        {
+            reset_id(task_base& target)
+              : target_(target)
+            {
+                target.set_thread_id(threads::get_self_id());
+            }
+            ~reset_id()
+            {
+                target_.set_thread_id(threads::invalid_thread_id);
+            }
+            task_base& target_;
+        };
+
         static threads::thread_result_type run_impl(future_base_type this_)
         {
+            reset_id r(*this_);
             this_->do_run();
             return threads::thread_result_type(
                 threads::terminated, threads::invalid_thread_id);
@@ -873,6 +953,7 @@ namespace detail
 
     protected:
         bool started_;
+        threads::thread_id_type id_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -885,51 +966,14 @@ namespace detail
         typedef typename future_data<Result>::result_type result_type;
         typedef typename task_base<Result>::init_no_addref init_no_addref;
 
-    protected:
-        threads::thread_id_type get_thread_id() const
-        {
-            std::lock_guard<mutex_type> l(this->mtx_);
-            return id_;
-        }
-        void set_thread_id(threads::thread_id_type id)
-        {
-            std::lock_guard<mutex_type> l(this->mtx_);
-            id_ = id;
-        }
-
     public:
         cancelable_task_base()
-          : id_(threads::invalid_thread_id)
         {}
 
         cancelable_task_base(init_no_addref no_addref)
-          : task_base<Result>(no_addref), id_(threads::invalid_thread_id)
+          : task_base<Result>(no_addref)
         {}
 
-    private:
-        struct reset_id
-        {
-            reset_id(cancelable_task_base& target)
-              : target_(target)
-            {
-                target.set_thread_id(threads::get_self_id());
-            }
-            ~reset_id()
-            {
-                target_.set_thread_id(threads::invalid_thread_id);
-            }
-            cancelable_task_base& target_;
-        };
-
-    protected:
-        static threads::thread_result_type run_impl(future_base_type this_)
-        {
-            reset_id r(*this_);
-            this_->do_run();
-            return threads::thread_result_type(
-                threads::terminated, threads::invalid_thread_id);
-        }
-
     public:
         // cancellation support
         bool cancelable() const
@@ -947,9 +991,9 @@ namespace detail
                 if (this->is_ready())
                     return;   // nothing we can do
 
-                if (id_ != threads::invalid_thread_id) {
+                if (this->id_ != threads::invalid_thread_id) {
                     // interrupt the executing thread
-                    threads::interrupt_thread(id_);
+                    threads::interrupt_thread(this->id_);
 
                     this->started_ = true;
 
@@ -971,9 +1015,6 @@ namespace detail
                 throw;
             }
         }
-
-    protected:
-        threads::thread_id_type id_;
     };
 }}}
 
@@ -6,6 +6,7 @@
 #ifndef HPX_LCOS_DETAIL_FUTURE_TRANSFORMS_HPP
 #define HPX_LCOS_DETAIL_FUTURE_TRANSFORMS_HPP
 
+#include <hpx/lcos/detail/future_data.hpp>
 #include <hpx/lcos/detail/future_traits.hpp>
 #include <hpx/lcos_fwd.hpp>
 #include <hpx/traits/acquire_future.hpp>
@@ -15,8 +16,10 @@
 #include <hpx/util/deferred_call.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <iterator>
+#include <new>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -67,6 +70,122 @@ namespace lcos {
             state->set_on_completed(util::deferred_call(std::forward<N>(next)));
         }
 
+        /// Resumes the given continuation once all futures of a range have
+        /// become ready. A single allocation holds the countdown and one
+        /// completion hook for each future which isn't ready. The
+        /// continuation is run on the thread which made the last future
+        /// ready.
+        template <typename Next>
+        class future_range_countdown
+        {
+            typedef future_data_base<traits::detail::future_data_void>
+                shared_state_base;
+            typedef shared_state_base::completion_hook completion_hook;
+
+            struct hook : completion_hook
+            {
+                future_range_countdown* countdown_;
+            };
+
+            // the hooks are stored right after the countdown
+            static std::size_t hooks_offset()
+            {
+                return (sizeof(future_range_countdown) + alignof(hook) - 1) /
+                    alignof(hook) * alignof(hook);
+            }
+
+            future_range_countdown(Next&& next, std::size_t count)
+              : next_(std::move(next)), count_(count + 1)
+            {}
+
+            hook* get_hook(std::size_t i)
+            {
+                return reinterpret_cast<hook*>(
+                    reinterpret_cast<char*>(this) + hooks_offset()) + i;
+            }
+
+            static void on_completed(completion_hook* h, bool is_ready)
+            {
+                // a shared state which is reset without becoming ready never
+                // resumes the continuation
+                if (is_ready)
+                    static_cast<hook*>(h)->countdown_->release(1);
+            }
+
+            void release(std::size_t n)
+            {
+                if (count_.fetch_sub(n, std::memory_order_acq_rel) != n)
+                    return;
+
+                typename shared_state_base::completed_callback_type f =
+                    util::deferred_call(std::move(next_));
+
+                this->~future_range_countdown();
+                ::operator delete(this);
+
+                // make sure the continuation doesn't recurse deeper than
+                // allowed
+                shared_state_base::handle_on_completed(std::move(f));
+            }
+
+        public:
+            template <typename Range>
+            static void call(Range range, Next next)
+            {
+                // count the futures which are not ready yet
+                std::size_t count = 0;
+                for (Range it = range; !it.is_finished(); ++it)
+                {
+                    if (!async_visit_future(*it))
+                        ++count;
+                }
+
+                if (count == 0)
+                {
+                    next();
+                    return;
+                }
+
+                void* p = ::operator new(hooks_offset() + count * sizeof(hook));
+                future_range_countdown* countdown =
+                    ::new (p) future_range_countdown(std::move(next), count);
+
+                // Attach a hook to each future which is still not ready. The
+                // countdown holds an additional count while doing so.
+                std::size_t registered = 0;
+                for (/**/; !range.is_finished() && registered != count; ++range)
+                {
+                    auto const& state = traits::detail::get_shared_state(*range);
+                    if (state.get() == nullptr || state->is_ready())
+                        continue;
+
+                    hook* h = ::new (countdown->get_hook(registered++)) hook();
+                    h->on_completed_ = &future_range_countdown::on_completed;
+                    h->countdown_ = countdown;
+
+                    if (!state->add_completion_hook(h))
+                        countdown->release(1);
+                }
+
+                countdown->release(count - registered + 1);
+            }
+
+        private:
+            Next next_;
+            std::atomic<std::size_t> count_;
+        };
+
+        /// Attach the continuation next to all futures of the given range
+        template <typename Range, typename N,
+            typename std::enable_if<traits::is_future<typename std::decay<
+                decltype(*std::declval<Range&>())>::type>::value>::type* =
+                nullptr>
+        void async_detach_future_range(Range&& range, N&& next)
+        {
+            future_range_countdown<typename std::decay<N>::type>::call(
+                std::forward<Range>(range), std::forward<N>(next));
+        }
+
         /// Acquire a future range from the given begin and end iterator
         template <typename Iterator,
             typename Container =
@@ -16,14 +16,20 @@
 #include <hpx/runtime/components/server/managed_component_base.hpp>
 #include <hpx/runtime/naming/address.hpp>
 #include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/naming/name.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/traits/future_access.hpp>
 #include <hpx/traits/detail/wrap_int.hpp>
 #include <hpx/util/deferred_call.hpp>
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+#include <hpx/util/hdr_histogram.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#endif
 #include <hpx/util/unique_function.hpp>
 
 #include <boost/intrusive_ptr.hpp>
 
+#include <cstdint>
 #include <exception>
 #include <memory>
 #include <utility>
@@ -37,11 +43,21 @@ namespace lcos {
         {
             typedef typename task_base<Result>::init_no_addref init_no_addref;
 
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+            promise_data()
+              : wait_time_(nullptr)
+            {}
+
+            promise_data(init_no_addref no_addref)
+              : task_base<Result>(no_addref), wait_time_(nullptr)
+            {}
+#else
             promise_data() {}
 
             promise_data(init_no_addref no_addref)
               : task_base<Result>(no_addref)
             {}
+#endif
 
             void set_task(util::unique_function_nonser<void()>&& f)
             {
@@ -53,6 +69,29 @@ namespace lcos {
                 this->task_base<Result>::started_test_and_set();
             }
 
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+            // record the time threads are blocked waiting for the value in
+            // the given histogram
+            void set_wait_time_histogram(util::hdr_histogram* wait_time)
+            {
+                wait_time_ = wait_time;
+            }
+
+            typename task_base<Result>::state wait(
+                error_code& ec = throws) override
+            {
+                if (wait_time_ == nullptr || this->is_ready())
+                    return this->task_base<Result>::wait(ec);
+
+                std::uint64_t start = util::high_resolution_clock::now();
+                typename task_base<Result>::state s =
+                    this->task_base<Result>::wait(ec);
+                wait_time_->record(static_cast<std::int64_t>(
+                    util::high_resolution_clock::now() - start));
+                return s;
+            }
+#endif
+
         private:
             void do_run()
             {
@@ -71,6 +110,9 @@ namespace lcos {
             }
 
             util::unique_function_nonser<void()> f_;
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+            util::hdr_histogram* wait_time_;
+#endif
         };
 
         template <typename Result, typename Allocator>
@@ -336,10 +378,23 @@ namespace lcos {
                 wrapping_ptr lco_ptr(new (ptr) wrapping_type(
                     new wrapped_type(this->shared_state_)), &wrapping_deleter);
 
-                id_ = lco_ptr->get_unmanaged_id();
-                addr_ = naming::address(hpx::get_locality(),
-                    components::get_component_type<wrapped_type>(),
-                    lco_ptr.get());
+                // The LCO is never migrated and its id is never managed, the
+                // id encodes the address of the LCO instead of being bound in
+                // AGAS. Resolving it requires no AGAS lookup (see
+                // addressing_service::resolve_locally_known_addresses) and
+                // recycling the LCO no unbind.
+                components::component_type type =
+                    components::get_component_type<wrapped_type>();
+                naming::gid_type const& here = hpx::get_locality();
+
+                naming::gid_type gid(
+                    reinterpret_cast<std::uint64_t>(lco_ptr.get()));
+                gid = naming::replace_component_type(gid, type);
+                gid = naming::replace_locality_id(gid,
+                    naming::get_locality_id_from_gid(here));
+
+                id_ = naming::id_type(gid, naming::id_type::unmanaged);
+                addr_ = naming::address(here, type, lco_ptr.get());
 
                 // Pass id to shared state if it exposes the set_id() function
                 detail::call_set_id(this->shared_state_, id_, id_retrieved_);
@@ -0,0 +1,134 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_DETAIL_THREAD_LOCAL_POOL_HPP)
+#define HPX_LCOS_DETAIL_THREAD_LOCAL_POOL_HPP
+
+#include <hpx/config.hpp>
+
+#include <cstddef>
+#include <new>
+
+namespace hpx { namespace lcos { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Small, short-lived objects (shared states, coroutine frames) are
+    // recycled through free lists kept for each (worker) thread, one free
+    // list per size class. A block released on a different thread than the
+    // one it was allocated on is added to the free list of the releasing
+    // thread, no synchronization is ever needed. Blocks released after the
+    // free lists of the releasing thread have been destroyed (during thread
+    // or program exit) are handed back to the global allocator.
+    class thread_local_pool
+    {
+        // size classes are powers of two, from 64 bytes up to 8 kB
+        static constexpr std::size_t min_size_log2 = 6;
+        static constexpr std::size_t num_size_classes = 8;
+
+        // number of blocks kept per size class and thread
+        static constexpr std::size_t max_cached_blocks = 256;
+
+        struct free_block
+        {
+            free_block* next;
+        };
+
+        struct free_list
+        {
+            free_block* head = nullptr;
+            std::size_t count = 0;
+        };
+
+        struct free_lists
+        {
+            explicit free_lists(bool& destroyed)
+              : destroyed_(destroyed)
+            {}
+
+            ~free_lists()
+            {
+                for (free_list& l : lists)
+                {
+                    while (l.head != nullptr)
+                    {
+                        free_block* f = l.head;
+                        l.head = f->next;
+                        ::operator delete(f);
+                    }
+                }
+                destroyed_ = true;
+            }
+
+            bool& destroyed_;
+            free_list lists[num_size_classes];
+        };
+
+        static free_lists* get_free_lists()
+        {
+            // trivially destructible, stays accessible until the thread exits
+            static thread_local bool destroyed = false;
+            if (destroyed)
+                return nullptr;
+
+            static thread_local free_lists lists(destroyed);
+            return &lists;
+        }
+
+        static std::size_t size_class(std::size_t size)
+        {
+            std::size_t c = 0;
+            while ((std::size_t(1) << (c + min_size_log2)) < size)
+                ++c;
+            return c;
+        }
+
+    public:
+        static void* allocate(std::size_t size)
+        {
+            std::size_t c = size_class(size);
+            if (c >= num_size_classes)
+                return ::operator new(size);
+
+            free_lists* lists = get_free_lists();
+            if (lists != nullptr)
+            {
+                free_list& l = lists->lists[c];
+                if (l.head != nullptr)
+                {
+                    free_block* f = l.head;
+                    l.head = f->next;
+                    --l.count;
+                    return f;
+                }
+            }
+            return ::operator new(std::size_t(1) << (c + min_size_log2));
+        }
+
+        static void deallocate(void* p, std::size_t size) noexcept
+        {
+            std::size_t c = size_class(size);
+            if (c >= num_size_classes)
+            {
+                ::operator delete(p);
+                return;
+            }
+
+            free_lists* lists = get_free_lists();
+            if (lists == nullptr || lists->lists[c].count == max_cached_blocks)
+            {
+                ::operator delete(p);
+                return;
+            }
+
+            free_list& l = lists->lists[c];
+            free_block* f = static_cast<free_block*>(p);
+            f->next = l.head;
+            l.head = f;
+            ++l.count;
+        }
+    };
+}}}
+
+#endif
@@ -0,0 +1,337 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_DISTRIBUTED_QUEUE_HPP)
+#define HPX_LCOS_DISTRIBUTED_QUEUE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/lcos/server/distributed_queue.hpp>
+#include <hpx/lcos/when_all.hpp>
+#include <hpx/runtime/basename_registration.hpp>
+#include <hpx/runtime/components/new.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/get_num_localities.hpp>
+#include <hpx/runtime/get_ptr.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined(HPX_DISTRIBUTED_QUEUE_STEAL_BATCH)
+#define HPX_DISTRIBUTED_QUEUE_STEAL_BATCH 64
+#endif
+
+namespace hpx { namespace lcos
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A queue of work items distributed over a number of shards (typically
+    // one per locality). Every site creates its own distributed_queue, the
+    // sites find each other using the given base name.
+    //
+    // Items are pushed to the shard of this site, or as a batch to the shard
+    // of any other site. Consumers take the items from the shard of their
+    // own site first. Only once that has run dry, a batch of items is
+    // requested from the other shards, one after the other, starting at a
+    // different shard every time. A shard hands out at most half of its
+    // items, and at most 'steal_batch' of them, at once. The items received
+    // are added to the shard of this site. At most one such request is in
+    // flight for each site, consumers finding the shard empty in the mean
+    // time wait for its result.
+    //
+    // There is no central instance involved, which makes this a scalable
+    // pool of work items for master/worker patterns:
+    //
+    //      distributed_queue<work> q("/work", site, num_sites);
+    //      if (site == 0)
+    //          q.push(all_work);     // the other sites take from this one
+    //      for (std::vector<work> w = q.pop(16); !w.empty(); w = q.pop(16))
+    //          process(w);
+    //
+    // An empty result of pop means that none of the shards held items at the
+    // time they were asked. A site may ask shards which were not created yet,
+    // it waits for those to register, but no shard may be destroyed while
+    // other sites may still ask it for items. The item type has to be
+    // registered using
+    // HPX_REGISTER_DISTRIBUTED_QUEUE(T). Copies of a distributed_queue share
+    // their state.
+    template <typename T>
+    class distributed_queue
+    {
+        typedef lcos::server::distributed_queue<T> server_type;
+        typedef lcos::local::spinlock mutex_type;
+
+        struct shared_state
+          : std::enable_shared_from_this<shared_state>
+        {
+            shared_state(std::string const& basename, std::size_t site,
+                    std::size_t num_sites, std::size_t steal_batch)
+              : basename_(basename),
+                site_(site),
+                num_sites_(num_sites),
+                steal_batch_(steal_batch),
+                next_victim_(0),
+                ids_(num_sites)
+            {
+                HPX_ASSERT(site_ < num_sites_ && steal_batch_ != 0);
+
+                id_ = hpx::local_new<server_type>().get();
+                server_ = hpx::get_ptr<server_type>(launch::sync, id_);
+                hpx::register_with_basename(basename_, id_, site_).get();
+
+                ids_[site_] = id_;
+            }
+
+            ~shared_state()
+            {
+                try {
+                    hpx::unregister_with_basename(basename_, site_);
+                }
+                catch (...) {
+                    // don't throw from the destructor
+                }
+            }
+
+            hpx::id_type resolve(std::size_t site)
+            {
+                HPX_ASSERT(site < num_sites_);
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    if (ids_[site])
+                        return ids_[site];
+                }
+
+                hpx::id_type id = hpx::find_from_basename(basename_, site).get();
+
+                std::lock_guard<mutex_type> l(mtx_);
+                ids_[site] = id;
+                return id;
+            }
+
+            // Return a future which becomes ready once the current request
+            // for items from the other shards has finished, starts a new
+            // request if there is none. The future holds false if none of
+            // the other shards had any items.
+            hpx::shared_future<bool> request_items()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (!request_.valid() || request_.is_ready())
+                {
+                    // the stored future must not keep this state alive
+                    std::weak_ptr<shared_state> this_(
+                        this->shared_from_this());
+                    request_ = hpx::async([this_]()
+                        {
+                            std::shared_ptr<shared_state> state = this_.lock();
+                            return state && state->steal_items();
+                        });
+                }
+                return request_;
+            }
+
+            bool steal_items()
+            {
+                typedef typename server_type::steal_action action_type;
+
+                std::size_t start = next_victim_++;
+                for (std::size_t i = 0; i != num_sites_ - 1; ++i)
+                {
+                    std::size_t victim = (site_ + 1 +
+                        (start + i) % (num_sites_ - 1)) % num_sites_;
+
+                    std::vector<T> items = hpx::async<action_type>(
+                        resolve(victim), steal_batch_).get();
+                    if (!items.empty())
+                    {
+                        server_->push(std::move(items));
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            std::string basename_;
+            std::size_t site_;
+            std::size_t num_sites_;
+            std::size_t steal_batch_;
+            hpx::id_type id_;
+            std::shared_ptr<server_type> server_;
+
+            std::atomic<std::size_t> next_victim_;
+
+            mutex_type mtx_;
+            std::vector<hpx::id_type> ids_;
+            hpx::shared_future<bool> request_;
+        };
+
+    public:
+        typedef T value_type;
+
+        distributed_queue()
+        {}
+
+        /// Create the shard of the given site of a distributed_queue made of
+        /// \a num_sites shards, the sites are identified by their sequence
+        /// number.
+        distributed_queue(std::string const& basename, std::size_t this_site,
+                std::size_t num_sites,
+                std::size_t steal_batch = HPX_DISTRIBUTED_QUEUE_STEAL_BATCH)
+          : state_(std::make_shared<shared_state>(
+                basename, this_site, num_sites, steal_batch))
+        {}
+
+        /// Create the shard of this locality of a distributed_queue made of
+        /// one shard per locality.
+        explicit distributed_queue(std::string const& basename,
+                std::size_t steal_batch = HPX_DISTRIBUTED_QUEUE_STEAL_BATCH)
+          : state_(std::make_shared<shared_state>(basename,
+                hpx::get_locality_id(),
+                hpx::get_num_localities(launch::sync), steal_batch))
+        {}
+
+        ///////////////////////////////////////////////////////////////////////
+        std::size_t get_site() const
+        {
+            HPX_ASSERT(state_);
+            return state_->site_;
+        }
+
+        std::size_t get_num_sites() const
+        {
+            HPX_ASSERT(state_);
+            return state_->num_sites_;
+        }
+
+        hpx::id_type const& get_id() const
+        {
+            HPX_ASSERT(state_);
+            return state_->id_;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Add the given item(s) to the shard of this site.
+        void push(T item)
+        {
+            HPX_ASSERT(state_);
+            state_->server_->push_local(std::move(item));
+        }
+
+        void push(std::vector<T> items)
+        {
+            HPX_ASSERT(state_);
+            state_->server_->push(std::move(items));
+        }
+
+        /// Add the given items to the shard of the given site.
+        hpx::future<void> push(std::size_t site, std::vector<T> items)
+        {
+            HPX_ASSERT(state_);
+            if (site == state_->site_)
+            {
+                state_->server_->push(std::move(items));
+                return hpx::make_ready_future();
+            }
+
+            typedef typename server_type::push_action action_type;
+            return hpx::async<action_type>(
+                state_->resolve(site), std::move(items));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Take at most \a max_count items, from the shard of this site if
+        /// it holds any, from the other shards otherwise. Returns an empty
+        /// vector if none of the shards held items.
+        std::vector<T> pop(std::size_t max_count)
+        {
+            HPX_ASSERT(state_);
+
+            std::vector<T> items;
+            if (max_count == 0)
+                return items;
+
+            while (true)
+            {
+                state_->server_->pop(max_count, items);
+                if (!items.empty() || state_->num_sites_ == 1)
+                    return items;
+
+                // the shard of this site has run dry
+                if (!state_->request_items().get())
+                {
+                    // items may have been pushed to this shard in the mean
+                    // time
+                    state_->server_->pop(max_count, items);
+                    return items;
+                }
+            }
+        }
+
+        /// Take one item as pop does, returns false if there was none.
+        bool try_pop(T& item)
+        {
+            std::vector<T> items = pop(1);
+            if (items.empty())
+                return false;
+
+            item = std::move(items.front());
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Return the number of items in the shard of this site.
+        std::size_t local_size() const
+        {
+            HPX_ASSERT(state_);
+            return state_->server_->size();
+        }
+
+        /// Return the number of items in all shards. The shards are queried
+        /// independently, the result is exact only if no items are pushed or
+        /// taken meanwhile.
+        hpx::future<std::size_t> size() const
+        {
+            HPX_ASSERT(state_);
+            typedef typename server_type::size_action action_type;
+
+            std::vector<hpx::future<std::size_t> > sizes;
+            sizes.reserve(state_->num_sites_);
+            for (std::size_t s = 0; s != state_->num_sites_; ++s)
+            {
+                if (s == state_->site_)
+                {
+                    sizes.push_back(
+                        hpx::make_ready_future(state_->server_->size()));
+                }
+                else
+                {
+                    sizes.push_back(
+                        hpx::async<action_type>(state_->resolve(s)));
+                }
+            }
+
+            return hpx::when_all(sizes).then(
+                [](hpx::future<std::vector<hpx::future<std::size_t> > > f)
+                {
+                    std::size_t count = 0;
+                    for (hpx::future<std::size_t>& size : f.get())
+                        count += size.get();
+                    return count;
+                });
+        }
+
+    private:
+        std::shared_ptr<shared_state> state_;
+    };
+}}
+
+#endif
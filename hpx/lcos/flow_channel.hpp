@@ -0,0 +1,402 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_FLOW_CHANNEL_HPP)
+#define HPX_LCOS_FLOW_CHANNEL_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/apply.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/channel.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/mutex.hpp>
+#include <hpx/lcos/server/flow_channel.hpp>
+#include <hpx/runtime/components/client_base.hpp>
+#include <hpx/runtime/components/new.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/naming_fwd.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#if !defined(HPX_FLOW_CHANNEL_CAPACITY)
+#define HPX_FLOW_CHANNEL_CAPACITY 1024
+#endif
+
+#if !defined(HPX_FLOW_CHANNEL_BATCH_SIZE)
+#define HPX_FLOW_CHANNEL_BATCH_SIZE 64
+#endif
+
+namespace hpx { namespace lcos
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A channel whose producers are throttled by the consumer: a producer has
+    // to acquire a credit for each value it sends, at most 'capacity' values
+    // can be in flight or buffered at the channel. The values are written
+    // through a flow_channel_sender which sends them in batches, and read
+    // through a flow_channel_receiver which fetches them in batches.
+    //
+    // The channel should be created on the locality of the consumer.
+    template <typename T>
+    class flow_channel
+      : public components::client_base<
+            flow_channel<T>, lcos::server::flow_channel<T> >
+    {
+        typedef components::client_base<
+                flow_channel<T>, lcos::server::flow_channel<T>
+            > base_type;
+
+    public:
+        typedef T value_type;
+
+        flow_channel()
+        {}
+
+        // create a new instance of a flow_channel component
+        explicit flow_channel(naming::id_type const& loc,
+                std::size_t capacity = HPX_FLOW_CHANNEL_CAPACITY)
+          : base_type(hpx::new_<lcos::server::flow_channel<T> >(loc, capacity))
+        {}
+
+        explicit flow_channel(hpx::future<naming::id_type>&& id)
+          : base_type(std::move(id))
+        {}
+
+        explicit flow_channel(hpx::shared_future<naming::id_type>&& id)
+          : base_type(std::move(id))
+        {}
+
+        explicit flow_channel(hpx::shared_future<naming::id_type> const& id)
+          : base_type(id)
+        {}
+
+        ///////////////////////////////////////////////////////////////////////
+        // Close the channel, the receivers see the end of the stream after
+        // retrieving the values pushed before. Values still buffered by
+        // senders are lost, use flow_channel_sender::close instead.
+        hpx::future<std::size_t> close(launch::async_policy)
+        {
+            typedef typename lcos::server::flow_channel<T>::close_action
+                action_type;
+            return hpx::async(action_type(), this->get_id());
+        }
+        std::size_t close(launch::sync_policy)
+        {
+            return close(launch::async).get();
+        }
+        std::size_t close()
+        {
+            return close(launch::sync);
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Collects values into batches of the given size and pushes each batch
+    // once enough credits have been acquired. At most one batch is in flight
+    // at any time, which keeps the values in order.
+    //
+    // Copies of a sender share their state, set() may be called concurrently.
+    template <typename T>
+    class flow_channel_sender
+    {
+        typedef lcos::server::flow_channel<T> server_type;
+
+        struct shared_state
+        {
+            shared_state(hpx::id_type const& id, std::size_t batch_size)
+              : id_(id), batch_size_(batch_size), credits_(0)
+            {
+                batch_.reserve(batch_size_);
+            }
+
+            ~shared_state()
+            {
+                try {
+                    flush();
+                    wait_pending();
+                    release_credits();
+                }
+                catch (...) {
+                    // don't throw from the destructor
+                }
+            }
+
+            void set(T value)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                batch_.push_back(std::move(value));
+                if (batch_.size() >= batch_size_)
+                    flush();
+            }
+
+            // send all values collected so far, waits for credits if needed
+            void flush()
+            {
+                std::size_t const size = batch_.size();
+                std::size_t first = 0;
+                while (first != size)
+                {
+                    wait_pending();
+
+                    std::size_t needed = size - first;
+                    if (credits_ == 0)
+                    {
+                        typedef typename server_type::acquire_credits_action
+                            action_type;
+                        hpx::future<std::size_t> f =
+                            hpx::async(action_type(), id_, needed);
+                        credits_ = f.get();
+                        if (credits_ == 0)
+                        {
+                            HPX_THROW_EXCEPTION(invalid_status,
+                                "hpx::lcos::flow_channel_sender::flush",
+                                "attempting to write to a closed channel");
+                        }
+                    }
+
+                    std::size_t count = (std::min)(credits_, needed);
+                    credits_ -= count;
+
+                    std::vector<T> values;
+                    if (count == size)
+                    {
+                        values = std::move(batch_);
+                    }
+                    else
+                    {
+                        values.assign(
+                            std::make_move_iterator(batch_.begin() + first),
+                            std::make_move_iterator(
+                                batch_.begin() + first + count));
+                    }
+                    first += count;
+
+                    // ask for the credits needed for the next batch
+                    typedef typename server_type::push_action action_type;
+                    pending_ = hpx::async(action_type(), id_, std::move(values),
+                        batch_size_ > credits_ ? batch_size_ - credits_ : 0);
+                }
+
+                batch_.clear();
+                batch_.reserve(batch_size_);
+            }
+
+            void wait_pending()
+            {
+                if (pending_.valid())
+                    credits_ += pending_.get();
+            }
+
+            void release_credits()
+            {
+                if (credits_ != 0)
+                {
+                    typedef typename server_type::release_credits_action
+                        action_type;
+                    hpx::apply(action_type(), id_, credits_);
+                    credits_ = 0;
+                }
+            }
+
+            typedef lcos::local::mutex mutex_type;
+
+            mutex_type mtx_;
+            hpx::id_type id_;
+            std::size_t batch_size_;
+            std::size_t credits_;
+            std::vector<T> batch_;
+            hpx::future<std::size_t> pending_;
+        };
+
+    public:
+        flow_channel_sender()
+        {}
+
+        explicit flow_channel_sender(flow_channel<T> const& c,
+                std::size_t batch_size = HPX_FLOW_CHANNEL_BATCH_SIZE)
+          : state_(std::make_shared<shared_state>(
+                c.get_id(), batch_size == 0 ? std::size_t(1) : batch_size))
+        {}
+
+        // Append a value to the current batch, blocks if the batch is full
+        // and there are no credits left.
+        void set(T value)
+        {
+            HPX_ASSERT(state_);
+            state_->set(std::move(value));
+        }
+
+        // Send the values collected so far and wait for them to arrive.
+        void flush()
+        {
+            HPX_ASSERT(state_);
+
+            std::lock_guard<typename shared_state::mutex_type> l(state_->mtx_);
+            state_->flush();
+            state_->wait_pending();
+        }
+
+        // Send the values collected so far and close the channel.
+        std::size_t close()
+        {
+            HPX_ASSERT(state_);
+
+            std::lock_guard<typename shared_state::mutex_type> l(state_->mtx_);
+            state_->flush();
+            state_->wait_pending();
+            state_->release_credits();
+
+            typedef typename server_type::close_action action_type;
+            return hpx::async(action_type(), state_->id_).get();
+        }
+
+        hpx::id_type const& get_id() const
+        {
+            HPX_ASSERT(state_);
+            return state_->id_;
+        }
+
+    private:
+        std::shared_ptr<shared_state> state_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Retrieves the values from the channel in batches of up to the given
+    // size. If prefetching is enabled the next batch is requested as soon as
+    // the previous one has arrived.
+    //
+    // Copies of a receiver share their state, get() may be called
+    // concurrently. Values fetched but not yet retrieved when the last copy
+    // of a receiver is destroyed are lost.
+    template <typename T>
+    class flow_channel_receiver
+    {
+        typedef lcos::server::flow_channel<T> server_type;
+
+        struct shared_state
+        {
+            shared_state(hpx::id_type const& id, std::size_t batch_size,
+                    bool prefetch)
+              : id_(id), batch_size_(batch_size), prefetch_(prefetch),
+                closed_(false)
+            {}
+
+            hpx::future<std::vector<T> > fetch()
+            {
+                typedef typename server_type::get_batch_action action_type;
+                return hpx::async(action_type(), id_, batch_size_);
+            }
+
+            T get()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+
+                if (values_.empty() && !closed_)
+                {
+                    if (!next_.valid())
+                        next_ = fetch();
+
+                    std::vector<T> values = next_.get();
+                    if (values.empty())
+                    {
+                        closed_ = true;
+                    }
+                    else
+                    {
+                        for (T& value : values)
+                            values_.push_back(std::move(value));
+
+                        if (prefetch_)
+                            next_ = fetch();
+                    }
+                }
+
+                if (values_.empty())
+                {
+                    HPX_THROW_EXCEPTION(invalid_status,
+                        "hpx::lcos::flow_channel_receiver::get",
+                        "this channel is empty and was closed");
+                }
+
+                T value = std::move(values_.front());
+                values_.pop_front();
+                return value;
+            }
+
+            typedef lcos::local::mutex mutex_type;
+
+            mutex_type mtx_;
+            hpx::id_type id_;
+            std::size_t batch_size_;
+            bool prefetch_;
+            bool closed_;
+            std::deque<T> values_;
+            hpx::future<std::vector<T> > next_;
+        };
+
+    public:
+        typedef T value_type;
+
+        flow_channel_receiver()
+        {}
+
+        explicit flow_channel_receiver(flow_channel<T> const& c,
+                std::size_t batch_size = HPX_FLOW_CHANNEL_BATCH_SIZE,
+                bool prefetch = true)
+          : state_(std::make_shared<shared_state>(c.get_id(),
+                batch_size == 0 ? std::size_t(1) : batch_size, prefetch))
+        {}
+
+        ///////////////////////////////////////////////////////////////////////
+        // Retrieve the next value, blocks until a value is available. Throws
+        // once the channel was closed and all values have been retrieved.
+        T get(launch::sync_policy) const
+        {
+            HPX_ASSERT(state_);
+            return state_->get();
+        }
+
+        hpx::future<T> get(launch::async_policy) const
+        {
+            HPX_ASSERT(state_);
+
+            std::shared_ptr<shared_state> state = state_;
+            return hpx::async([state]() { return state->get(); });
+        }
+        hpx::future<T> get() const
+        {
+            return get(launch::async);
+        }
+
+        hpx::id_type const& get_id() const
+        {
+            HPX_ASSERT(state_);
+            return state_->id_;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        channel_iterator<T, flow_channel_receiver<T> > begin() const
+        {
+            return channel_iterator<T, flow_channel_receiver<T> >(*this);
+        }
+        channel_iterator<T, flow_channel_receiver<T> > end() const
+        {
+            return channel_iterator<T, flow_channel_receiver<T> >();
+        }
+
+    private:
+        std::shared_ptr<shared_state> state_;
+    };
+}}
+
+#endif
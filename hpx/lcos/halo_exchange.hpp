@@ -0,0 +1,371 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_HALO_EXCHANGE_HPP)
+#define HPX_LCOS_HALO_EXCHANGE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/server/halo_exchange.hpp>
+#include <hpx/runtime/applier/apply_callback.hpp>
+#include <hpx/runtime/basename_registration.hpp>
+#include <hpx/runtime/components/new.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/get_ptr.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime/parcelset_fwd.hpp>
+#include <hpx/runtime/serialization/serialize_buffer.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/yield_while.hpp>
+
+#include <boost/system/error_code.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined(HPX_HALO_EXCHANGE_DEPTH)
+#define HPX_HALO_EXCHANGE_DEPTH 2
+#endif
+
+namespace hpx { namespace lcos
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Exchanges the halos of one site (for instance one partition of a grid)
+    // with its neighbors. Every site creates its own halo_exchange, the sites
+    // find each other using the given base name.
+    //
+    // All buffers are allocated once: for each neighbor and each of the
+    // 'depth' generations which may be in flight at once there is one buffer
+    // the halo is written to and one buffer it is received into. The halos
+    // are sent without waiting for a reply, directly from the send buffers
+    // (which makes them subject to zero-copy serialization). A send buffer is
+    // handed out again once the previous halo sent from it has left. Halos
+    // for neighbors on the same locality are copied into their receive
+    // buffers directly.
+    //
+    // A typical time step looks like:
+    //
+    //      std::copy(..., halo.send_buffer(n, t));   // for all neighbors n
+    //      halo.put(n, t);
+    //      halo.get_future(t).get();
+    //      use(halo.get_data(n, t));                 // for all neighbors n
+    //      halo.release(t);
+    //
+    // Each generation has to be released before the generation 'depth'
+    // steps later can be received. The neighbor n of site s is expected to
+    // list s at the index given by its entry in the neighbors of s, the data
+    // sent by s to its n-th neighbor is received in that entry.
+    //
+    // T has to be bitwise serializable, the type has to be registered using
+    // HPX_REGISTER_HALO_EXCHANGE(T). Copies of a halo_exchange share their
+    // state, they may not be used concurrently for the same neighbor.
+    template <typename T>
+    class halo_exchange
+    {
+        typedef lcos::server::halo_exchange<T> server_type;
+        typedef serialization::serialize_buffer<T> buffer_type;
+
+        // a persistent buffer for the halo sent to one neighbor
+        struct send_slot
+        {
+            send_slot()
+              : in_flight_(false)
+            {}
+
+            std::vector<T> data_;
+            std::atomic<bool> in_flight_;
+        };
+
+        // marks the send buffer as available once the parcel has left
+        struct release_send_slot
+        {
+            std::shared_ptr<send_slot> slot_;
+
+            void operator()(boost::system::error_code const&,
+                parcelset::parcel const&) const
+            {
+                slot_->in_flight_.store(false, std::memory_order_release);
+            }
+        };
+
+        struct neighbor_state
+        {
+            halo_neighbor config_;
+            hpx::future<hpx::id_type> lookup_;
+            hpx::id_type id_;
+            std::shared_ptr<server_type> local_;    // if on this locality
+            std::vector<std::shared_ptr<send_slot> > send_;
+        };
+
+        struct shared_state
+        {
+            shared_state(std::string const& basename, std::size_t site,
+                    std::vector<halo_neighbor> const& neighbors,
+                    std::size_t depth)
+              : basename_(basename), site_(site)
+            {
+                id_ = hpx::local_new<server_type>(neighbors, depth).get();
+                server_ = hpx::get_ptr<server_type>(launch::sync, id_);
+                hpx::register_with_basename(basename_, id_, site_).get();
+
+                neighbors_.resize(neighbors.size());
+                for (std::size_t n = 0; n != neighbors.size(); ++n)
+                {
+                    neighbor_state& nb = neighbors_[n];
+                    nb.config_ = neighbors[n];
+                    if (!nb.config_.valid())
+                        continue;
+
+                    nb.lookup_ = hpx::find_from_basename(
+                        basename_, nb.config_.site_);
+
+                    nb.send_.reserve(depth);
+                    for (std::size_t i = 0; i != depth; ++i)
+                    {
+                        nb.send_.push_back(std::make_shared<send_slot>());
+                        nb.send_.back()->data_.resize(nb.config_.size_);
+                    }
+                }
+            }
+
+            ~shared_state()
+            {
+                try {
+                    // the halos sent last have to leave before the send
+                    // buffers go away
+                    for (neighbor_state& nb : neighbors_)
+                    {
+                        for (auto const& s : nb.send_)
+                        {
+                            util::yield_while([&]()
+                            {
+                                return s->in_flight_.load(
+                                    std::memory_order_acquire);
+                            });
+                        }
+                    }
+                    hpx::unregister_with_basename(basename_, site_);
+                }
+                catch (...) {
+                    // don't throw from the destructor
+                }
+            }
+
+            neighbor_state& resolve(std::size_t n)
+            {
+                HPX_ASSERT(n < neighbors_.size());
+                neighbor_state& nb = neighbors_[n];
+                HPX_ASSERT(nb.config_.valid());
+
+                if (!nb.id_)
+                {
+                    nb.id_ = nb.lookup_.get();
+                    if (naming::get_locality_id_from_id(nb.id_) ==
+                        hpx::get_locality_id())
+                    {
+                        nb.local_ = hpx::get_ptr<server_type>(
+                            launch::sync, nb.id_);
+                    }
+                }
+                return nb;
+            }
+
+            std::string basename_;
+            std::size_t site_;
+            hpx::id_type id_;
+            std::shared_ptr<server_type> server_;
+            std::vector<neighbor_state> neighbors_;
+        };
+
+    public:
+        typedef T value_type;
+
+        // the indices of the neighbors of a one-dimensional decomposition
+        enum { left = 0, right = 1 };
+
+        halo_exchange()
+        {}
+
+        /// Create the halo exchange for the given site, the sites are
+        /// identified by their sequence number.
+        halo_exchange(std::string const& basename, std::size_t this_site,
+                std::vector<halo_neighbor> const& neighbors,
+                std::size_t depth = HPX_HALO_EXCHANGE_DEPTH)
+          : state_(std::make_shared<shared_state>(
+                basename, this_site, neighbors, depth))
+        {}
+
+        /// Create the halo exchange for the given site of a one-dimensional
+        /// decomposition into \a num_sites consecutive sites. The left
+        /// neighbor of site 0 (and the right neighbor of the last site) is
+        /// the other end of the domain if \a periodic is set, none
+        /// otherwise. \a width elements are exchanged in each direction.
+        halo_exchange(std::string const& basename, std::size_t this_site,
+                std::size_t num_sites, std::size_t width,
+                bool periodic = false,
+                std::size_t depth = HPX_HALO_EXCHANGE_DEPTH)
+          : state_(std::make_shared<shared_state>(basename, this_site,
+                neighbors_1d(this_site, num_sites, width, periodic), depth))
+        {}
+
+        ///////////////////////////////////////////////////////////////////////
+        std::size_t get_num_neighbors() const
+        {
+            HPX_ASSERT(state_);
+            return state_->neighbors_.size();
+        }
+
+        halo_neighbor const& get_neighbor(std::size_t n) const
+        {
+            HPX_ASSERT(state_ && n < state_->neighbors_.size());
+            return state_->neighbors_[n].config_;
+        }
+
+        std::size_t get_site() const
+        {
+            HPX_ASSERT(state_);
+            return state_->site_;
+        }
+
+        hpx::id_type const& get_id() const
+        {
+            HPX_ASSERT(state_);
+            return state_->id_;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Return the buffer the halo for the given neighbor and generation
+        /// has to be written to, waits until the halo sent from it 'depth'
+        /// generations before has left. Returns nullptr if the neighbor does
+        /// not exist.
+        T* send_buffer(std::size_t n, std::size_t generation)
+        {
+            HPX_ASSERT(state_ && n < state_->neighbors_.size());
+
+            neighbor_state& nb = state_->neighbors_[n];
+            if (!nb.config_.valid())
+                return nullptr;
+
+            send_slot& s = *nb.send_[generation % nb.send_.size()];
+            util::yield_while([&]()
+            {
+                return s.in_flight_.load(std::memory_order_acquire);
+            });
+            return s.data_.data();
+        }
+
+        /// Send the contents of the send buffer of the given neighbor and
+        /// generation, does not wait for the halo to arrive.
+        void put(std::size_t n, std::size_t generation)
+        {
+            HPX_ASSERT(state_);
+            if (!state_->neighbors_[n].config_.valid())
+                return;
+
+            neighbor_state& nb = state_->resolve(n);
+            std::shared_ptr<send_slot> const& s =
+                nb.send_[generation % nb.send_.size()];
+
+            if (nb.local_)
+            {
+                nb.local_->put_local(state_->site_, n, generation,
+                    s->data_.data(), s->data_.size());
+                return;
+            }
+
+            s->in_flight_.store(true, std::memory_order_relaxed);
+
+            typedef typename server_type::put_action action_type;
+            hpx::apply_cb<action_type>(nb.id_, release_send_slot{s},
+                state_->site_, n, generation,
+                buffer_type(s->data_.data(), s->data_.size(),
+                    buffer_type::reference));
+        }
+
+        /// Send the first and the last elements of the given range to the
+        /// left and the right neighbor of a one-dimensional decomposition.
+        template <typename Iter>
+        void put_edges(Iter first, Iter last, std::size_t generation)
+        {
+            HPX_ASSERT(get_num_neighbors() == 2);
+
+            if (T* data = send_buffer(left, generation))
+            {
+                std::size_t width = get_neighbor(left).size_;
+                HPX_ASSERT(std::size_t(std::distance(first, last)) >= width);
+                std::copy(first, std::next(first, width), data);
+                put(left, generation);
+            }
+
+            if (T* data = send_buffer(right, generation))
+            {
+                std::size_t width = get_neighbor(right).size_;
+                HPX_ASSERT(std::size_t(std::distance(first, last)) >= width);
+                std::copy(std::prev(last, width), last, data);
+                put(right, generation);
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Return a future which becomes ready once the halos of all
+        /// neighbors have arrived for the given generation.
+        hpx::future<void> get_future(std::size_t generation) const
+        {
+            HPX_ASSERT(state_);
+            return state_->server_->get_future(generation);
+        }
+
+        /// Return the halo received from the given neighbor, the future
+        /// returned by get_future must have become ready. The data stays
+        /// valid until the generation is released. Returns nullptr if the
+        /// neighbor does not exist.
+        T const* get_data(std::size_t n, std::size_t generation) const
+        {
+            HPX_ASSERT(state_);
+            return state_->server_->get_data(n, generation);
+        }
+
+        /// Make the receive buffers of the given generation available for
+        /// the halos of the generation 'depth' steps later.
+        void release(std::size_t generation)
+        {
+            HPX_ASSERT(state_);
+            state_->server_->release(generation);
+        }
+
+    private:
+        static std::vector<halo_neighbor> neighbors_1d(std::size_t site,
+            std::size_t num_sites, std::size_t width, bool periodic)
+        {
+            HPX_ASSERT(site < num_sites);
+
+            // this site is the right neighbor of its left neighbor and vice
+            // versa
+            std::vector<halo_neighbor> neighbors(2);
+            if (site != 0)
+                neighbors[left] = halo_neighbor(site - 1, right, width);
+            else if (periodic)
+                neighbors[left] = halo_neighbor(num_sites - 1, right, width);
+
+            if (site != num_sites - 1)
+                neighbors[right] = halo_neighbor(site + 1, left, width);
+            else if (periodic)
+                neighbors[right] = halo_neighbor(0, left, width);
+
+            return neighbors;
+        }
+
+        std::shared_ptr<shared_state> state_;
+    };
+}}
+
+#endif
@@ -0,0 +1,156 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file hpx/lcos/local/adaptive_mutex.hpp
+
+#if !defined(HPX_LCOS_LOCAL_ADAPTIVE_MUTEX_HPP)
+#define HPX_LCOS_LOCAL_ADAPTIVE_MUTEX_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/detail/condition_variable.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/itt_notify.hpp>
+#include <hpx/util/register_locks.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hpx { namespace lcos { namespace local
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// A mutex for short critical sections. On contention, the calling thread
+    /// first spins for about as long as the mutex is usually held (measured
+    /// on a sample of the critical sections) before the HPX thread is
+    /// suspended. Released locks may be taken by any thread (unfair), except
+    /// for every half millisecond, when the lock is handed over directly to
+    /// the longest waiting thread. Threads which are not HPX threads never
+    /// suspend, they keep spinning.
+    ///
+    /// Lock hold and wait times of all adaptive mutexes are collected in the
+    /// histograms exposed through the performance counters
+    /// /threads/time/adaptive-mutex-hold and
+    /// /threads/time/adaptive-mutex-wait.
+    class adaptive_mutex
+    {
+    public:
+        HPX_NON_COPYABLE(adaptive_mutex);
+
+    private:
+        typedef lcos::local::spinlock mutex_type;
+
+        enum : std::uint8_t
+        {
+            locked_bit = 1,
+            parked_bit = 2          // at least one thread is suspended
+        };
+
+        // measure the hold time of one in this many critical sections
+        static constexpr std::uint32_t hold_time_sample_rate = 16;
+
+    public:
+        HPX_EXPORT adaptive_mutex(char const* const description = "");
+
+        HPX_EXPORT ~adaptive_mutex();
+
+        void lock()
+        {
+            HPX_ITT_SYNC_PREPARE(this);
+
+            std::uint8_t expected = 0;
+            if (!state_.compare_exchange_weak(expected, locked_bit,
+                    std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                lock_slow();
+            }
+
+            acquired();
+        }
+
+        bool try_lock()
+        {
+            HPX_ITT_SYNC_PREPARE(this);
+
+            std::uint8_t s = state_.load(std::memory_order_relaxed);
+            while (!(s & locked_bit))
+            {
+                if (state_.compare_exchange_weak(s, s | locked_bit,
+                        std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    acquired();
+                    return true;
+                }
+            }
+
+            HPX_ITT_SYNC_CANCEL(this);
+            return false;
+        }
+
+        void unlock()
+        {
+            HPX_ITT_SYNC_RELEASING(this);
+
+            if (lock_time_ != 0)
+                record_hold_time(util::high_resolution_clock::now() - lock_time_);
+
+            std::uint8_t expected = locked_bit;
+            if (!state_.compare_exchange_strong(expected, 0,
+                    std::memory_order_release, std::memory_order_relaxed))
+            {
+                unlock_slow();
+            }
+
+            HPX_ITT_SYNC_RELEASED(this);
+            util::unregister_lock(this);
+        }
+
+        /// Return the histogram of the (sampled) lock hold times of all
+        /// adaptive mutexes [ns]. The first three values are the lower and
+        /// upper boundaries and the number of buckets, followed by the
+        /// number of measurements for each bucket.
+        HPX_EXPORT static std::vector<std::int64_t> get_hold_time_histogram(
+            bool reset);
+
+        /// Return the histogram of the times threads had to wait for any
+        /// contended adaptive mutex [ns], in the same format.
+        HPX_EXPORT static std::vector<std::int64_t> get_wait_time_histogram(
+            bool reset);
+
+    private:
+        void acquired()
+        {
+            // only the owner of the lock accesses these members
+            if (++acquisitions_ % hold_time_sample_rate == 0)
+                lock_time_ = util::high_resolution_clock::now();
+            else
+                lock_time_ = 0;
+
+            HPX_ITT_SYNC_ACQUIRED(this);
+            util::register_lock(this);
+        }
+
+        HPX_EXPORT void lock_slow();
+        HPX_EXPORT void unlock_slow();
+        HPX_EXPORT void record_hold_time(std::uint64_t hold_time);
+
+    private:
+        std::atomic<std::uint8_t> state_;
+
+        // moving average of the sampled hold times [ns]
+        std::atomic<std::uint32_t> avg_hold_time_;
+        std::uint32_t acquisitions_;
+        std::uint64_t lock_time_;
+
+        // members below are protected by mtx_
+        mutex_type mtx_;
+        detail::condition_variable cond_;
+        std::uint64_t next_fair_handoff_;
+        bool handoff_;
+    };
+}}}
+
+#endif
@@ -0,0 +1,358 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file hpx/lcos/local/bounded_channel.hpp
+
+#if !defined(HPX_LCOS_LOCAL_BOUNDED_CHANNEL_HPP)
+#define HPX_LCOS_LOCAL_BOUNDED_CHANNEL_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/detail/condition_variable.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/optional.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace lcos { namespace local
+{
+    /// A bounded multi-producer, multi-consumer channel holding values of
+    /// type \a T in a ring buffer (based on the queue described by Dmitry
+    /// Vyukov). Sending and receiving values neither allocates memory nor
+    /// acquires a lock. If the channel is full (empty), the blocking
+    /// operations \a send (\a receive) suspend the calling HPX thread until
+    /// a value has been received (sent) by another thread.
+    ///
+    /// \note   Other than \a local::channel, a \a bounded_channel is not a
+    ///         handle to a shared channel, it has to outlive all threads
+    ///         using it.
+    template <typename T>
+    class bounded_channel
+    {
+        static_assert(std::is_nothrow_move_constructible<T>::value,
+            "the values sent through a bounded_channel have to be "
+            "nothrow move constructible");
+
+    public:
+        HPX_NON_COPYABLE(bounded_channel);
+
+    private:
+        typedef lcos::local::spinlock mutex_type;
+
+        struct cell
+        {
+            std::atomic<std::size_t> sequence_;
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type data_;
+        };
+
+        static std::size_t round_up_to_power_of_two(std::size_t size)
+        {
+            std::size_t result = 1;
+            while (result < size)
+                result *= 2;
+            return result;
+        }
+
+    public:
+        /// Create a channel which is able to hold at least \a capacity values,
+        /// the capacity is rounded up to the next power of two.
+        explicit bounded_channel(std::size_t capacity)
+          : mask_(round_up_to_power_of_two(capacity) - 1)
+          , cells_(new cell[mask_ + 1])
+          , enqueue_pos_(0)
+          , dequeue_pos_(0)
+          , closed_(false)
+          , waiting_senders_(0)
+          , waiting_receivers_(0)
+        {
+            for (std::size_t i = 0; i != mask_ + 1; ++i)
+                cells_[i].sequence_.store(i, std::memory_order_relaxed);
+        }
+
+        /// Requires: No threads are using the channel anymore.
+        ~bounded_channel()
+        {
+            std::size_t const end =
+                enqueue_pos_.load(std::memory_order_relaxed);
+            for (std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+                 pos != end; ++pos)
+            {
+                cell& c = cells_[pos & mask_];
+                reinterpret_cast<T*>(&c.data_)->~T();
+            }
+        }
+
+        /// Returns the number of values the channel is able to hold.
+        std::size_t capacity() const noexcept
+        {
+            return mask_ + 1;
+        }
+
+        /// Send the given value if the channel is not full. Returns false
+        /// (without sending the value) otherwise. Throws if the channel is
+        /// closed.
+        bool try_send(T const& t)
+        {
+            check_not_closed("bounded_channel::try_send");
+
+            T value(t);
+            if (!push(value))
+                return false;
+
+            notify(waiting_receivers_, not_empty_);
+            return true;
+        }
+
+        /// Send the given value if the channel is not full. Returns false
+        /// (in which case \a t is left unchanged) otherwise. Throws if the
+        /// channel is closed.
+        bool try_send(T&& t)
+        {
+            check_not_closed("bounded_channel::try_send");
+
+            if (!push(t))
+                return false;
+
+            notify(waiting_receivers_, not_empty_);
+            return true;
+        }
+
+        /// Send the given value, suspend the calling thread as long as the
+        /// channel is full. Throws if the channel is closed.
+        void send(T t)
+        {
+            check_not_closed("bounded_channel::send");
+
+            if (!push(t))
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+                waiting_senders_.fetch_add(1, std::memory_order_seq_cst);
+
+                for (;;)
+                {
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if (push(t))
+                        break;
+
+                    if (closed_.load(std::memory_order_relaxed))
+                    {
+                        waiting_senders_.fetch_sub(
+                            1, std::memory_order_relaxed);
+                        l.unlock();
+                        HPX_THROW_EXCEPTION(hpx::invalid_status,
+                            "bounded_channel::send",
+                            "attempting to write to a closed channel");
+                    }
+
+                    not_full_.wait(l, "bounded_channel::send");
+                }
+
+                waiting_senders_.fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            notify(waiting_receivers_, not_empty_);
+        }
+
+        /// Receive a value if the channel is not empty. Returns false
+        /// otherwise.
+        bool try_receive(T& t)
+        {
+            util::optional<T> value;
+            if (!pop(value))
+                return false;
+
+            notify(waiting_senders_, not_full_);
+
+            t = std::move(*value);
+            return true;
+        }
+
+        /// Receive a value, suspend the calling thread as long as the channel
+        /// is empty. Throws if the channel is empty and was closed.
+        T receive()
+        {
+            util::optional<T> value;
+            if (!pop(value))
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+                waiting_receivers_.fetch_add(1, std::memory_order_seq_cst);
+
+                for (;;)
+                {
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if (pop(value))
+                        break;
+
+                    if (closed_.load(std::memory_order_relaxed))
+                    {
+                        waiting_receivers_.fetch_sub(
+                            1, std::memory_order_relaxed);
+                        l.unlock();
+                        HPX_THROW_EXCEPTION(hpx::invalid_status,
+                            "bounded_channel::receive",
+                            "this channel is empty and was closed");
+                    }
+
+                    not_empty_.wait(l, "bounded_channel::receive");
+                }
+
+                waiting_receivers_.fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            notify(waiting_senders_, not_full_);
+
+            return std::move(*value);
+        }
+
+        /// Close the channel, values which were sent before may still be
+        /// received. All threads blocked on the channel are resumed.
+        void close()
+        {
+            if (closed_.exchange(true))
+            {
+                HPX_THROW_EXCEPTION(hpx::invalid_status,
+                    "bounded_channel::close",
+                    "attempting to close an already closed channel");
+            }
+
+            std::unique_lock<mutex_type> l(mtx_);
+            not_full_.notify_all(std::move(l));
+
+            l = std::unique_lock<mutex_type>(mtx_);
+            not_empty_.notify_all(std::move(l));
+        }
+
+        bool is_closed() const noexcept
+        {
+            return closed_.load(std::memory_order_acquire);
+        }
+
+    private:
+        void check_not_closed(char const* name) const
+        {
+            if (closed_.load(std::memory_order_relaxed))
+            {
+                HPX_THROW_EXCEPTION(hpx::invalid_status, name,
+                    "attempting to write to a closed channel");
+            }
+        }
+
+        // Move the given value into the next free cell, leaves the value
+        // unchanged if the channel is full.
+        bool push(T& t)
+        {
+            std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell& c = cells_[pos & mask_];
+                std::size_t const seq =
+                    c.sequence_.load(std::memory_order_acquire);
+                std::intptr_t const diff =
+                    std::intptr_t(seq) - std::intptr_t(pos);
+
+                if (diff == 0)
+                {
+                    if (enqueue_pos_.compare_exchange_weak(
+                            pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        ::new (&c.data_) T(std::move(t));
+                        c.sequence_.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false;       // the channel is full
+                }
+                else
+                {
+                    pos = enqueue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Move the value out of the oldest occupied cell.
+        bool pop(util::optional<T>& t)
+        {
+            std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell& c = cells_[pos & mask_];
+                std::size_t const seq =
+                    c.sequence_.load(std::memory_order_acquire);
+                std::intptr_t const diff =
+                    std::intptr_t(seq) - std::intptr_t(pos + 1);
+
+                if (diff == 0)
+                {
+                    if (dequeue_pos_.compare_exchange_weak(
+                            pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        T* value = reinterpret_cast<T*>(&c.data_);
+                        t.emplace(std::move(*value));
+                        value->~T();
+                        c.sequence_.store(
+                            pos + mask_ + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false;       // the channel is empty
+                }
+                else
+                {
+                    pos = dequeue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Resume one of the threads waiting for the given condition. Waiting
+        // threads register themselves before checking the channel again, the
+        // fences make sure that either the waiting thread sees the change to
+        // the channel or this thread sees the waiting thread.
+        void notify(std::atomic<std::size_t>& waiting,
+            local::detail::condition_variable& cond)
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiting.load(std::memory_order_relaxed) != 0)
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+                cond.notify_one(std::move(l));
+            }
+        }
+
+    private:
+        std::size_t const mask_;
+        std::unique_ptr<cell[]> cells_;
+
+        // keep the positions of senders and receivers on separate cache lines
+        char pad0_[threads::get_cache_line_size()];
+        std::atomic<std::size_t> enqueue_pos_;
+        char pad1_[threads::get_cache_line_size()];
+        std::atomic<std::size_t> dequeue_pos_;
+        char pad2_[threads::get_cache_line_size()];
+
+        std::atomic<bool> closed_;
+        std::atomic<std::size_t> waiting_senders_;
+        std::atomic<std::size_t> waiting_receivers_;
+
+        mutex_type mtx_;
+        local::detail::condition_variable not_full_;
+        local::detail::condition_variable not_empty_;
+    };
+}}}
+
+#endif
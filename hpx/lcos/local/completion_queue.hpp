@@ -0,0 +1,331 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file lcos/local/completion_queue.hpp
+
+#if !defined(HPX_LCOS_LOCAL_COMPLETION_QUEUE_HPP)
+#define HPX_LCOS_LOCAL_COMPLETION_QUEUE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/detail/condition_variable.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/traits/acquire_shared_state.hpp>
+#include <hpx/traits/future_traits.hpp>
+#include <hpx/traits/is_future.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace lcos { namespace local
+{
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+        struct completion_link
+        {
+            completion_link()
+              : next_(nullptr)
+            {}
+
+            std::atomic<completion_link*> next_;
+        };
+
+        template <typename Future>
+        struct completion_node : completion_link
+        {
+            completion_node(std::size_t index, Future && f)
+              : index_(index), future_(std::move(f))
+            {}
+
+            std::size_t index_;
+            Future future_;
+        };
+
+        // An intrusive multi-producer single-consumer queue of the futures
+        // which have become ready, in the order they became ready (see
+        // Vyukov, "Intrusive MPSC node-based queue"). Pushing a node is a
+        // single atomic exchange, the consumers have to be serialized.
+        template <typename Future>
+        class completion_list
+        {
+        public:
+            typedef completion_node<Future> node_type;
+
+            HPX_NON_COPYABLE(completion_list);
+
+        public:
+            completion_list()
+              : tail_(&stub_), head_(&stub_)
+            {}
+
+            ~completion_list()
+            {
+                while (node_type* n = pop())
+                    delete n;
+            }
+
+            void push(completion_link* n)
+            {
+                n->next_.store(nullptr, std::memory_order_relaxed);
+                completion_link* prev = tail_.exchange(n);
+                prev->next_.store(n);
+            }
+
+            // Returns nullptr if the list is empty or if the next node is
+            // being pushed concurrently.
+            node_type* pop()
+            {
+                completion_link* head = head_;
+                completion_link* next = head->next_.load();
+
+                if (head == &stub_)
+                {
+                    if (next == nullptr)
+                        return nullptr;
+
+                    head_ = next;
+                    head = next;
+                    next = next->next_.load();
+                }
+
+                if (next != nullptr)
+                {
+                    head_ = next;
+                    return static_cast<node_type*>(head);
+                }
+
+                if (head != tail_.load())
+                    return nullptr;
+
+                // the last node can be removed only once the stub is behind it
+                push(&stub_);
+
+                next = head->next_.load();
+                if (next != nullptr)
+                {
+                    head_ = next;
+                    return static_cast<node_type*>(head);
+                }
+                return nullptr;
+            }
+
+        private:
+            std::atomic<completion_link*> tail_;    // written by producers
+            completion_link* head_;                 // owned by the consumer
+            completion_link stub_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Future>
+        class completion_queue_state
+          : public std::enable_shared_from_this<completion_queue_state<Future> >
+        {
+        private:
+            typedef lcos::local::spinlock mutex_type;
+            typedef completion_node<Future> node_type;
+
+        public:
+            completion_queue_state()
+              : added_(0), retrieved_(0), waiting_(0)
+            {}
+
+            std::size_t add(Future && f)
+            {
+                std::size_t const index = added_++;
+
+                node_type* n = new node_type(index, std::move(f));
+
+                auto state = traits::detail::get_shared_state(n->future_);
+                if (state.get() != nullptr && !state->is_ready())
+                {
+                    state->execute_deferred();
+
+                    // execute_deferred might have made the future ready
+                    if (!state->is_ready())
+                    {
+                        std::shared_ptr<completion_queue_state> this_ =
+                            this->shared_from_this();
+                        state->set_on_completed(
+                            [HPX_CAPTURE_MOVE(this_), n]() -> void
+                            {
+                                this_->on_ready(n);
+                            });
+                        return index;
+                    }
+                }
+
+                on_ready(n);
+                return index;
+            }
+
+            std::size_t size() const
+            {
+                return added_.load(std::memory_order_acquire) -
+                    retrieved_.load(std::memory_order_acquire);
+            }
+
+            bool try_get(std::size_t& index, Future& f)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                return try_get_locked(index, f);
+            }
+
+            void get(std::size_t& index, Future& f)
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+                if (size() == 0)
+                {
+                    l.unlock();
+                    HPX_THROW_EXCEPTION(invalid_status,
+                        "completion_queue::get",
+                        "no futures are registered with this completion "
+                        "queue");
+                }
+
+                while (!try_get_locked(index, f))
+                {
+                    // the producers look at waiting_ only after having
+                    // pushed their node, check the list once more
+                    ++waiting_;
+                    if (try_get_locked(index, f))
+                    {
+                        --waiting_;
+                        return;
+                    }
+                    cond_.wait(l, "completion_queue::get");
+                    --waiting_;
+                }
+            }
+
+        private:
+            bool try_get_locked(std::size_t& index, Future& f)
+            {
+                node_type* n = list_.pop();
+                if (n == nullptr)
+                    return false;
+
+                ++retrieved_;
+                index = n->index_;
+                f = std::move(n->future_);
+                delete n;
+                return true;
+            }
+
+            void on_ready(node_type* n)
+            {
+                list_.push(n);
+
+                if (waiting_.load() != 0)
+                {
+                    std::unique_lock<mutex_type> l(mtx_);
+                    cond_.notify_one(std::move(l));
+                }
+            }
+
+            mutable mutex_type mtx_;
+            lcos::local::detail::condition_variable cond_;
+            completion_list<Future> list_;
+
+            std::atomic<std::size_t> added_;
+            std::atomic<std::size_t> retrieved_;
+            std::atomic<std::size_t> waiting_;
+        };
+        /// \endcond
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A \a completion_queue delivers the futures registered with it in the
+    /// order they become ready. Each future is registered once, becoming
+    /// ready pushes it onto a lock-free list with a single atomic exchange.
+    /// Retrieving the next ready future is independent of the number of
+    /// registered futures, which makes waiting for many outstanding
+    /// operations one at a time O(n) overall (as opposed to calling
+    /// \a when_any repeatedly for the remaining futures).
+    ///
+    /// \tparam Future  The type of the registered futures, either
+    ///                 \a hpx::future or \a hpx::shared_future.
+    ///
+    /// \note The futures which are still registered keep the internal state
+    ///       of the queue alive, destroying the queue does not wait for them.
+    ///
+    template <typename Future>
+    class completion_queue
+    {
+        static_assert(traits::is_future<Future>::value,
+            "completion_queue can hold futures only");
+
+        typedef detail::completion_queue_state<Future> state_type;
+
+    public:
+        typedef Future future_type;
+
+        completion_queue()
+          : state_(std::make_shared<state_type>())
+        {}
+
+        /// Register the given future, returns the sequence number which is
+        /// handed out alongside the future once it has become ready. The
+        /// futures are numbered in the order they were registered, starting
+        /// at zero.
+        std::size_t add(Future f)
+        {
+            return state_->add(std::move(f));
+        }
+
+        /// Register all futures of the given sequence.
+        template <typename Iterator>
+        void add(Iterator begin, Iterator end)
+        {
+            for (/**/; begin != end; ++begin)
+                state_->add(std::move(*begin));
+        }
+
+        /// Returns the number of registered futures which were not retrieved
+        /// yet.
+        std::size_t size() const
+        {
+            return state_->size();
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        /// Retrieve the next future which has become ready, if any.
+        ///
+        /// \returns \a true if a ready future was stored in \a f (and its
+        ///          sequence number in \a index).
+        bool try_get(std::size_t& index, Future& f)
+        {
+            return state_->try_get(index, f);
+        }
+
+        /// Retrieve the next future which has become ready, suspends the
+        /// calling thread until one does.
+        ///
+        /// \returns The sequence number and the ready future.
+        ///
+        /// \throws hpx::exception with the error code \a invalid_status if
+        ///         there are no registered futures left.
+        std::pair<std::size_t, Future> get()
+        {
+            std::pair<std::size_t, Future> result;
+            state_->get(result.first, result.second);
+            return result;
+        }
+
+    private:
+        std::shared_ptr<state_type> state_;
+    };
+}}}
+
+#endif
@@ -28,13 +28,15 @@
 //        delete t
 //
 //  def run_task(t):
-//    t.run() // call the task
-//    zero = nullptr
-//    if t.next.compare_exchange_strong(zero,t):
-//      pass
-//    else:
-//      run_task(zero)
-//      delete t
+//    while True:
+//      t.run() // call the task
+//      zero = nullptr
+//      if t.next.compare_exchange_strong(zero,t):
+//        return
+//      else:
+//        // run the next queued task on this thread
+//        delete t
+//        t = zero
 //
 // Consider cases. Thread A, B, and C on guard g.
 // Case 1:
@@ -14,10 +14,12 @@
 #include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/runtime/threads/thread_enums.hpp>
 #include <hpx/util/assert_owns_lock.hpp>
+#include <hpx/util/lock_profiler.hpp>
 #include <hpx/util/register_locks.hpp>
 #include <hpx/util/steady_clock.hpp>
 #include <hpx/util/unlock_guard.hpp>
 
+#include <cstdint>
 #include <mutex>
 #include <utility>
 
@@ -35,6 +37,22 @@ namespace hpx { namespace lcos { namespace local
         typedef lcos::local::spinlock mutex_type;
 
     public:
+        condition_variable()
+#if defined(HPX_HAVE_LOCK_PROFILING)
+          : kind_(util::lock_profiling::kind_condition_variable)
+#endif
+        {}
+
+        // The given kind is used for the waits recorded by the lock profiler,
+        // kind_untracked excludes the waits accounted for by the caller.
+        explicit condition_variable(util::lock_profiling::lock_kind kind)
+#if defined(HPX_HAVE_LOCK_PROFILING)
+          : kind_(kind)
+#endif
+        {
+            (void) kind;
+        }
+
         void notify_one(error_code& ec = throws)
         {
             std::unique_lock<mutex_type> l(mtx_);
@@ -58,8 +76,21 @@ namespace hpx { namespace lcos { namespace local
             std::lock_guard<std::unique_lock<mutex_type> > unlock_next(
                 l, std::adopt_lock);
 
+#if defined(HPX_HAVE_LOCK_PROFILING)
+            bool const profiled =
+                util::lock_profiling::lock_profiling_enabled &&
+                kind_ != util::lock_profiling::kind_untracked;
+            std::uint64_t const token = profiled ?
+                util::lock_profiling::wait_begin(this) : 0;
+#endif
+
             cond_.wait(l, ec);
 
+#if defined(HPX_HAVE_LOCK_PROFILING)
+            if (profiled)
+                util::lock_profiling::wait_end(this, kind_, token);
+#endif
+
             // We need to ignore our internal mutex for the user provided lock
             // being able to be reacquired without a lock held during suspension
             // error. We can't use RAII here since the guard object would get
@@ -93,9 +124,22 @@ namespace hpx { namespace lcos { namespace local
             std::lock_guard<std::unique_lock<mutex_type> > unlock_next(
                 l, std::adopt_lock);
 
+#if defined(HPX_HAVE_LOCK_PROFILING)
+            bool const profiled =
+                util::lock_profiling::lock_profiling_enabled &&
+                kind_ != util::lock_profiling::kind_untracked;
+            std::uint64_t const token = profiled ?
+                util::lock_profiling::wait_begin(this) : 0;
+#endif
+
             threads::thread_state_ex_enum const reason =
                 cond_.wait_until(l, abs_time, ec);
 
+#if defined(HPX_HAVE_LOCK_PROFILING)
+            if (profiled)
+                util::lock_profiling::wait_end(this, kind_, token);
+#endif
+
             // We need to ignore our internal mutex for the user provided lock
             // being able to be reacquired without a lock held during suspension
             // error. We can't use RAII here since the guard object would get
@@ -142,6 +186,9 @@ namespace hpx { namespace lcos { namespace local
     private:
         mutable mutex_type mtx_;
         detail::condition_variable cond_;
+#if defined(HPX_HAVE_LOCK_PROFILING)
+        util::lock_profiling::lock_kind kind_;
+#endif
     };
 
     class condition_variable_any
@@ -175,8 +222,21 @@ namespace hpx { namespace lcos { namespace local
             std::lock_guard<std::unique_lock<mutex_type> > unlock_next(
                 l, std::adopt_lock);
 
+#if defined(HPX_HAVE_LOCK_PROFILING)
+            bool const profiled =
+                util::lock_profiling::lock_profiling_enabled;
+            std::uint64_t const token = profiled ?
+                util::lock_profiling::wait_begin(this) : 0;
+#endif
+
             cond_.wait(l, ec);
 
+#if defined(HPX_HAVE_LOCK_PROFILING)
+            if (profiled)
+                util::lock_profiling::wait_end(this,
+                    util::lock_profiling::kind_condition_variable, token);
+#endif
+
             // We need to ignore our internal mutex for the user provided lock
             // being able to be reacquired without a lock held during suspension
             // error. We can't use RAII here since the guard object would get
@@ -210,9 +270,22 @@ namespace hpx { namespace lcos { namespace local
             std::lock_guard<std::unique_lock<mutex_type> > unlock_next(
                 l, std::adopt_lock);
 
+#if defined(HPX_HAVE_LOCK_PROFILING)
+            bool const profiled =
+                util::lock_profiling::lock_profiling_enabled;
+            std::uint64_t const token = profiled ?
+                util::lock_profiling::wait_begin(this) : 0;
+#endif
+
             threads::thread_state_ex_enum const reason =
                 cond_.wait_until(l, abs_time, ec);
 
+#if defined(HPX_HAVE_LOCK_PROFILING)
+            if (profiled)
+                util::lock_profiling::wait_end(this,
+                    util::lock_profiling::kind_condition_variable, token);
+#endif
+
             // We need to ignore our internal mutex for the user provided lock
             // being able to be reacquired without a lock held during suspension
             // error. We can't use RAII here since the guard object would get
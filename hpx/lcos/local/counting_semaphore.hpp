@@ -66,6 +66,9 @@ namespace hpx { namespace lcos { namespace local
         ///                 yielded.
         void wait(std::int64_t count = 1)
         {
+            if (sem_.try_acquire(count))
+                return;
+
             std::unique_lock<mutex_type> l(mtx_);
             sem_.wait(l, count);
         }
@@ -83,15 +86,20 @@ namespace hpx { namespace lcos { namespace local
         ///                 are available at this point in time.
         bool try_wait(std::int64_t count = 1)
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            return sem_.try_wait(l, count);
+            return sem_.try_acquire(count);
         }
 
         /// \brief Signal the semaphore
+        ///
+        /// \note The lock protecting the queue of suspended threads is
+        ///       acquired only if there are threads waiting.
         void signal(std::int64_t count = 1)
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            sem_.signal(std::move(l), count);
+            if (sem_.release(count))
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+                sem_.notify(std::move(l), count);
+            }
         }
 
         std::int64_t signal_all()
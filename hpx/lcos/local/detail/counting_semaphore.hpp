@@ -13,7 +13,7 @@
 #include <hpx/util/assert.hpp>
 #include <hpx/util/assert_owns_lock.hpp>
 
-#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <mutex>
 #include <utility>
@@ -26,6 +26,18 @@
 ////////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace lcos { namespace local { namespace detail
 {
+    // The value of the semaphore is kept in an atomic variable. Threads take
+    // credits using a CAS loop and add credits with a single atomic addition,
+    // the lock (held by the owner of the semaphore) and the condition
+    // variable are used only if a thread has to suspend or if there are
+    // suspended threads to wake up.
+    //
+    // A waiting thread registers itself in waiters_ before checking the
+    // value for the last time while a signaling thread adds its credits
+    // before checking waiters_. Both are sequentially consistent, so either
+    // the waiting thread sees the credits or the signaling thread sees the
+    // waiting thread (and acquires the lock, which the waiting thread holds
+    // until it has been added to the condition variable).
     class counting_semaphore
     {
     private:
@@ -33,42 +45,61 @@ namespace hpx { namespace lcos { namespace local { namespace detail
 
     public:
         counting_semaphore(std::int64_t value = 0)
-          : value_(value), cond_()
+          : value_(value), waiters_(0), cond_()
         {}
 
+        // take the given number of credits if they are available, does not
+        // need the lock
+        bool try_acquire(std::int64_t count) noexcept
+        {
+            std::int64_t value = value_.load(std::memory_order_relaxed);
+            while (!(value < count))
+            {
+                if (value_.compare_exchange_weak(value, value - count,
+                        std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
         void wait(std::unique_lock<mutex_type>& l, std::int64_t count)
         {
             HPX_ASSERT_OWNS_LOCK(l);
 
-            while (value_ < count)
+            waiters_.fetch_add(1, std::memory_order_seq_cst);
+            while (!try_acquire_seq_cst(count))
             {
                 cond_.wait(l, "counting_semaphore::wait");
             }
-            value_ -= count;
+            waiters_.fetch_sub(1, std::memory_order_relaxed);
         }
 
         bool try_wait(std::unique_lock<mutex_type>& l, std::int64_t count = 1)
         {
             HPX_ASSERT_OWNS_LOCK(l);
+            return try_acquire(count);
+        }
 
-            if (!(value_ < count)) {
-                // enter wait_locked only if there are sufficient credits
-                // available
-                wait(l, count);
-                return true;
-            }
-            return false;
+        // add the given number of credits, does not need the lock. Returns
+        // whether threads may have to be woken up using notify.
+        bool release(std::int64_t count) noexcept
+        {
+            value_.fetch_add(count, std::memory_order_seq_cst);
+            return waiters_.load(std::memory_order_seq_cst) != 0;
         }
 
-        void signal(std::unique_lock<mutex_type> l, std::int64_t count)
+        void notify(std::unique_lock<mutex_type> l, std::int64_t count)
         {
             HPX_ASSERT_OWNS_LOCK(l);
 
             mutex_type* mtx = l.mutex();
 
             // release no more threads than we get resources
-            value_ += count;
-            for (std::int64_t i = 0; value_ >= 0 && i < count; ++i)
+            for (std::int64_t i = 0;
+                 value_.load(std::memory_order_relaxed) >= 0 && i < count;
+                 ++i)
             {
                 // notify_one() returns false if no more threads are
                 // waiting
@@ -79,6 +110,14 @@ namespace hpx { namespace lcos { namespace local { namespace detail
             }
         }
 
+        void signal(std::unique_lock<mutex_type> l, std::int64_t count)
+        {
+            HPX_ASSERT_OWNS_LOCK(l);
+
+            if (release(count))
+                notify(std::move(l), count);
+        }
+
         std::int64_t signal_all(std::unique_lock<mutex_type> l)
         {
             HPX_ASSERT_OWNS_LOCK(l);
@@ -89,7 +128,22 @@ namespace hpx { namespace lcos { namespace local { namespace detail
         }
 
     private:
-        std::int64_t value_;
+        bool try_acquire_seq_cst(std::int64_t count) noexcept
+        {
+            std::int64_t value = value_.load(std::memory_order_seq_cst);
+            while (!(value < count))
+            {
+                if (value_.compare_exchange_weak(value, value - count,
+                        std::memory_order_seq_cst))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::atomic<std::int64_t> value_;
+        std::atomic<std::int64_t> waiters_;     // modified under the lock only
         local::detail::condition_variable cond_;
     };
 }}}}
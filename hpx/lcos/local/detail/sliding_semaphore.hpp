@@ -12,7 +12,7 @@
 #include <hpx/util/assert.hpp>
 #include <hpx/util/assert_owns_lock.hpp>
 
-#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <mutex>
 #include <utility>
@@ -25,6 +25,10 @@
 ////////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace lcos { namespace local { namespace detail
 {
+    // The lower limit is kept in an atomic variable, threads which do not
+    // have to suspend and signals which do not have to wake up any thread
+    // do not touch the lock (see counting_semaphore for the protocol between
+    // waiting and signaling threads).
     class sliding_semaphore
     {
     private:
@@ -32,40 +36,61 @@ namespace hpx { namespace lcos { namespace local { namespace detail
 
     public:
         sliding_semaphore(std::int64_t max_difference, std::int64_t lower_limit)
-          : max_difference_(max_difference), lower_limit_(lower_limit), cond_()
+          : max_difference_(max_difference), lower_limit_(lower_limit),
+            waiters_(0), cond_()
         {}
 
+        // return whether a thread waiting for the given upper limit may
+        // proceed, does not need the lock
+        bool ready(std::int64_t upper_limit) const noexcept
+        {
+            return !(upper_limit - max_difference_ >
+                lower_limit_.load(std::memory_order_acquire));
+        }
+
         void wait(std::unique_lock<mutex_type>& l, std::int64_t upper_limit)
         {
             HPX_ASSERT_OWNS_LOCK(l);
 
-            while (upper_limit - max_difference_ > lower_limit_)
+            waiters_.fetch_add(1, std::memory_order_seq_cst);
+            while (upper_limit - max_difference_ >
+                lower_limit_.load(std::memory_order_seq_cst))
             {
                 cond_.wait(l, "sliding_semaphore::wait");
             }
+            waiters_.fetch_sub(1, std::memory_order_relaxed);
         }
 
         bool try_wait(std::unique_lock<mutex_type>& l, std::int64_t upper_limit)
         {
             HPX_ASSERT_OWNS_LOCK(l);
+            return ready(upper_limit);
+        }
 
-            if (!(upper_limit - max_difference_ > lower_limit_))
+        // raise the lower limit, does not need the lock. Returns whether
+        // threads may have to be woken up using notify.
+        bool release(std::int64_t lower_limit) noexcept
+        {
+            std::int64_t current =
+                lower_limit_.load(std::memory_order_relaxed);
+            while (current < lower_limit)
             {
-                // enter wait_locked only if necessary
-                wait(l, upper_limit);
-                return true;
+                if (lower_limit_.compare_exchange_weak(current, lower_limit,
+                        std::memory_order_seq_cst))
+                {
+                    break;
+                }
             }
-            return false;
+
+            return waiters_.load(std::memory_order_seq_cst) != 0;
         }
 
-        void signal(std::unique_lock<mutex_type> l, std::int64_t lower_limit)
+        void notify(std::unique_lock<mutex_type> l)
         {
             HPX_ASSERT_OWNS_LOCK(l);
 
             mutex_type* mtx = l.mutex();
 
-            lower_limit_ = (std::max)(lower_limit, lower_limit_);
-
             // touch upon all threads
             std::int64_t count = static_cast<std::int64_t>(cond_.size(l));
             for (/**/; count > 0; --count)
@@ -78,17 +103,28 @@ namespace hpx { namespace lcos { namespace local { namespace detail
             }
         }
 
+        void signal(std::unique_lock<mutex_type> l, std::int64_t lower_limit)
+        {
+            HPX_ASSERT_OWNS_LOCK(l);
+
+            if (release(lower_limit))
+                notify(std::move(l));
+        }
+
         std::int64_t signal_all(std::unique_lock<mutex_type> l)
         {
             HPX_ASSERT_OWNS_LOCK(l);
 
-            signal(std::move(l), lower_limit_);
-            return lower_limit_;
+            std::int64_t lower_limit =
+                lower_limit_.load(std::memory_order_relaxed);
+            signal(std::move(l), lower_limit);
+            return lower_limit;
         }
 
     private:
-        std::int64_t max_difference_;
-        std::int64_t lower_limit_;
+        std::int64_t const max_difference_;
+        std::atomic<std::int64_t> lower_limit_;
+        std::atomic<std::int64_t> waiters_;     // modified under the lock only
         local::detail::condition_variable cond_;
     };
 }}}}
@@ -18,7 +18,7 @@
 #include <hpx/traits/future_access.hpp>
 #include <hpx/util/allocator_deleter.hpp>
 #include <hpx/util/deferred_call.hpp>
-#include <hpx/util/internal_allocator.hpp>
+#include <hpx/util/tagged_allocator.hpp>
 #include <hpx/util/thread_description.hpp>
 
 #include <hpx/parallel/executors/execution.hpp>
@@ -108,6 +108,20 @@ namespace hpx { namespace lcos { namespace local
                 typedef typename Base::future_base_type future_base_type;
                 future_base_type this_(this);
 
+                if (policy == launch::work_first &&
+                    threads::get_self_ptr() != nullptr)
+                {
+                    // the new thread is run right away by the calling worker
+                    return threads::register_thread_nullary(
+                        util::deferred_call(
+                            &base_type::run_impl, std::move(this_)),
+                        util::thread_description(f_, "task_object::apply"),
+                        threads::pending_do_not_schedule, true, priority,
+                        threads::thread_schedule_hint(
+                            static_cast<std::int16_t>(get_worker_thread_num())),
+                        stacksize, ec);
+                }
+
                 if (policy == launch::fork)
                 {
                     return threads::register_thread_nullary(
@@ -249,6 +263,20 @@ namespace hpx { namespace lcos { namespace local
                             schedulehint);
                     return threads::invalid_thread_id;
                 }
+                else if (policy == launch::work_first &&
+                    threads::get_self_ptr() != nullptr)
+                {
+                    // the new thread is run right away by the calling worker
+                    return threads::register_thread_nullary(
+                        util::deferred_call(
+                            &base_type::run_impl, std::move(this_)),
+                        util::thread_description(
+                            this->f_, "task_object::apply"),
+                        threads::pending_do_not_schedule, true, priority,
+                        threads::thread_schedule_hint(
+                            static_cast<std::int16_t>(get_worker_thread_num())),
+                        stacksize, ec);
+                }
                 else if (policy == launch::fork) {
                     return threads::register_thread_nullary(
                         util::deferred_call(
@@ -706,13 +734,13 @@ namespace hpx { namespace lcos { namespace local
                 futures_factory>::value>::type>
         explicit futures_factory(F&& f)
           : task_(detail::create_task_object<Result, Cancelable>::call(
-                hpx::util::internal_allocator<>{}, std::forward<F>(f)))
+                hpx::util::future_state_allocator<>{}, std::forward<F>(f)))
           , future_obtained_(false)
         {}
 
         explicit futures_factory(Result (*f)())
           : task_(detail::create_task_object<Result, Cancelable>::call(
-                hpx::util::internal_allocator<>{}, f)),
+                hpx::util::future_state_allocator<>{}, f)),
             future_obtained_(false)
         {}
 
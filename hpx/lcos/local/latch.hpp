@@ -12,6 +12,7 @@
 #include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/util/assert.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <mutex>
 #include <utility>
@@ -37,6 +38,10 @@ namespace hpx { namespace lcos { namespace local
     ///         mechanism. Use lcos::latch instead if this is required.
     ///         It is just a low level synchronization primitive allowing to
     ///         synchronize a given number of \a threads.
+    ///
+    /// \note  The counter is kept in an atomic variable, the internal lock
+    ///        is acquired only by threads which have to suspend and by the
+    ///        thread decrementing the counter to zero.
     class latch
     {
     public:
@@ -69,7 +74,7 @@ namespace hpx { namespace lcos { namespace local
         ~latch ()
         {
             std::unique_lock<mutex_type> l(mtx_);
-            HPX_ASSERT(counter_ == 0);
+            HPX_ASSERT(counter_.load() == 0);
         }
 
         /// Decrements counter_ by 1 . Blocks at the synchronization point
@@ -84,13 +89,19 @@ namespace hpx { namespace lcos { namespace local
         ///
         void count_down_and_wait()
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            HPX_ASSERT(counter_ > 0);
+            std::ptrdiff_t const count =
+                counter_.fetch_sub(1, std::memory_order_acq_rel);
+            HPX_ASSERT(count > 0);
 
-            if (--counter_ == 0)
+            std::unique_lock<mutex_type> l(mtx_);
+            if (count == 1)
+            {
                 cond_.notify_all(std::move(l));    // release the threads
-            else
+            }
+            else if (counter_.load(std::memory_order_acquire) > 0)
+            {
                 cond_.wait(l, "hpx::local::latch::count_down_and_wait");
+            }
         }
 
         /// Decrements counter_ by n. Does not block.
@@ -106,11 +117,18 @@ namespace hpx { namespace lcos { namespace local
         {
             HPX_ASSERT(n >= 0);
 
-            std::unique_lock<mutex_type> l(mtx_);
-            HPX_ASSERT(counter_ >= n);
+            std::ptrdiff_t const count =
+                counter_.fetch_sub(n, std::memory_order_acq_rel);
+            HPX_ASSERT(count >= n);
 
-            if ((counter_ -= n) == 0)
+            // The waiting threads check the counter while holding the lock,
+            // acquiring it after the counter has reached zero makes sure
+            // that they are either woken up or do not suspend at all.
+            if (count == n && n != 0)
+            {
+                std::unique_lock<mutex_type> l(mtx_);
                 cond_.notify_all(std::move(l));    // release the threads
+            }
         }
 
         /// Returns: counter_ == 0. Does not block.
@@ -119,8 +137,7 @@ namespace hpx { namespace lcos { namespace local
         ///
         bool is_ready() const noexcept
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            return counter_ == 0;
+            return counter_.load(std::memory_order_acquire) == 0;
         }
 
         /// If counter_ is 0, returns immediately. Otherwise, blocks the
@@ -131,8 +148,11 @@ namespace hpx { namespace lcos { namespace local
         ///
         void wait() const
         {
+            if (counter_.load(std::memory_order_acquire) == 0)
+                return;
+
             std::unique_lock<mutex_type> l(mtx_);
-            if (counter_ > 0)
+            if (counter_.load(std::memory_order_acquire) > 0)
                 cond_.wait(l, "hpx::local::latch::wait");
         }
 
@@ -152,9 +172,7 @@ namespace hpx { namespace lcos { namespace local
         {
             HPX_ASSERT(n >= 0);
 
-            std::unique_lock<mutex_type> l(mtx_);
-
-            counter_ += n;
+            counter_.fetch_add(n, std::memory_order_acq_rel);
         }
 
         /// Reset counter_ to n. Does not block.
@@ -166,13 +184,11 @@ namespace hpx { namespace lcos { namespace local
         {
             HPX_ASSERT(n >= 0);
 
-            std::unique_lock<mutex_type> l(mtx_);
-
-            counter_ = n;
+            counter_.store(n, std::memory_order_release);
         }
 
     private:
-        std::ptrdiff_t counter_;
+        std::atomic<std::ptrdiff_t> counter_;
         mutable mutex_type mtx_;
         mutable local::detail::condition_variable cond_;
     };
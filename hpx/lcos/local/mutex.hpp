@@ -14,6 +14,10 @@
 #include <hpx/runtime/threads/thread_data_fwd.hpp>
 #include <hpx/util/steady_clock.hpp>
 
+#if defined(HPX_HAVE_LOCK_PROFILING)
+#include <mutex>
+#endif
+
 namespace hpx { namespace lcos { namespace local
 {
     ///////////////////////////////////////////////////////////////////////////
@@ -47,6 +51,11 @@ namespace hpx { namespace lcos { namespace local
         HPX_EXPORT void unlock(error_code& ec = throws);
 
     protected:
+#if defined(HPX_HAVE_LOCK_PROFILING)
+        void lock_profiled(std::unique_lock<mutex_type>& l, void const* site,
+            error_code& ec);
+#endif
+
         mutable mutex_type mtx_;
         threads::thread_id_type owner_id_;
         detail::condition_variable cond_;
@@ -17,7 +17,8 @@
 #include <hpx/traits/future_traits.hpp>
 #include <hpx/util/allocator_deleter.hpp>
 #include <hpx/util/annotated_function.hpp>
-#include <hpx/util/internal_allocator.hpp>
+#include <hpx/util/steady_clock.hpp>
+#include <hpx/util/tagged_allocator.hpp>
 #include <hpx/util/thread_description.hpp>
 
 #include <hpx/parallel/executors/execution.hpp>
@@ -541,6 +542,37 @@ namespace hpx { namespace lcos { namespace detail
             }
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // wait support, the thread running the continuation inherits the
+        // priority and the deadline of the waiting thread if those are more
+        // urgent
+        typename base_type::state wait(error_code& ec = throws) override
+        {
+            if (!this->is_ready())
+                inherit_priority();
+            return this->base_type::wait(ec);
+        }
+
+        future_status wait_until(
+            util::steady_clock::time_point const& abs_time,
+            error_code& ec = throws) override
+        {
+            if (!this->is_ready())
+                inherit_priority();
+            return this->base_type::wait_until(abs_time, ec);
+        }
+
+    private:
+        void inherit_priority()
+        {
+            if (threads::get_self_ptr() == nullptr)
+                return;
+
+            std::lock_guard<mutex_type> l(this->mtx_);
+            if (id_ != threads::invalid_thread_id)
+                threads::inherit_thread_priority(id_, threads::get_self_id());
+        }
+
     public:
         ///////////////////////////////////////////////////////////////////////
         template <typename Policy>
@@ -1064,7 +1096,7 @@ namespace hpx { namespace lcos { namespace detail
     unwrap_impl(Future && future, error_code& ec)
     {
         return unwrap_impl_alloc(
-            util::internal_allocator<>{}, std::forward<Future>(future), ec);
+            util::future_state_allocator<>{}, std::forward<Future>(future), ec);
     }
 
 //     template <typename R>
@@ -0,0 +1,275 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file lcos/local/ring_receive_buffer.hpp
+
+#if !defined(HPX_LCOS_LOCAL_RING_RECEIVE_BUFFER_HPP)
+#define HPX_LCOS_LOCAL_RING_RECEIVE_BUFFER_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/detail/future_data.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/traits/future_access.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+
+#include <boost/intrusive_ptr.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace hpx { namespace lcos { namespace local
+{
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+        template <typename T>
+        struct ring_buffer_state : lcos::detail::future_data<T>
+        {
+            typedef typename lcos::detail::future_data<T>::init_no_addref
+                init_no_addref;
+
+            ring_buffer_state()
+              : lcos::detail::future_data<T>(init_no_addref{})
+            {}
+
+            // the shared state can be reused for the next step if no future
+            // refers to it anymore
+            bool is_unique() const
+            {
+                return this->count_ == 1;
+            }
+        };
+        /// \endcond
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A \a ring_receive_buffer connects the values sent for a time step with
+    /// the futures handed out for the same step, like \a receive_buffer.
+    /// It is meant for codes with a small, known window of steps in flight
+    /// (for instance halo exchanges of stencil codes): the entries are kept
+    /// in a ring of \a depth slots, the entry of step \a s is the slot
+    /// \a s \a % \a depth. The shared states for the futures are allocated
+    /// up front and are reused for later steps as soon as the futures
+    /// referring to them are gone. Storing a value and retrieving the future
+    /// for a step do not acquire a lock.
+    ///
+    /// A slot is available for the step \a s \a + \a depth once both the
+    /// value for step \a s was stored and its future was retrieved. Calling
+    /// \a store_received or \a receive for a step which is \a depth or more
+    /// steps ahead of the oldest incomplete step suspends the caller until
+    /// that step is complete.
+    ///
+    /// \note The value for every step must be stored exactly once and the
+    ///       future for every step must be retrieved exactly once.
+    ///
+    template <typename T>
+    class ring_receive_buffer
+    {
+    private:
+        typedef detail::ring_buffer_state<T> shared_state_type;
+
+        // the state of a slot is the step it is currently used for, and
+        // flags describing the progress of that step
+        enum slot_flags : std::uint64_t
+        {
+            stored = 0x1,
+            received = 0x2,
+            prepared = 0x4,
+            preparing = 0x8,
+            flags_mask = 0xf,
+            step_shift = 4
+        };
+
+        struct slot
+        {
+            std::atomic<std::uint64_t> state_;
+            boost::intrusive_ptr<shared_state_type> shared_state_;
+        };
+
+    public:
+        HPX_NON_COPYABLE(ring_receive_buffer);
+
+    public:
+        /// Create a buffer for \a depth steps in flight, starting at step
+        /// \a first_step.
+        explicit ring_receive_buffer(std::size_t depth,
+                std::size_t first_step = 0)
+          : depth_(depth), slots_(new slot[depth])
+        {
+            if (depth == 0)
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "ring_receive_buffer::ring_receive_buffer",
+                    "the depth of the buffer must not be zero");
+            }
+
+            for (std::size_t i = 0; i != depth_; ++i)
+            {
+                std::size_t step = first_step + i;
+                slot& s = slots_[step % depth_];
+                s.shared_state_.reset(new shared_state_type(), false);
+                s.state_.store(make_state(step) | prepared,
+                    std::memory_order_relaxed);
+            }
+        }
+
+        std::size_t depth() const
+        {
+            return depth_;
+        }
+
+        /// Retrieve the future for the given step, it becomes ready once
+        /// the value for the step has been stored.
+        hpx::future<T> receive(std::size_t step)
+        {
+            slot& s = acquire(step, "ring_receive_buffer::receive");
+
+            hpx::future<T> f =
+                traits::future_access<hpx::future<T> >::create(
+                    s.shared_state_);
+
+            std::uint64_t prev = s.state_.fetch_or(received);
+            if (prev & received)
+            {
+                HPX_THROW_EXCEPTION(invalid_status,
+                    "ring_receive_buffer::receive",
+                    "the future for this step has been retrieved already");
+            }
+            if (prev & stored)
+                release(s, step);
+
+            return f;
+        }
+
+        /// Store the value for the given step.
+        template <typename... Ts>
+        void store_received(std::size_t step, Ts&&... ts)
+        {
+            slot& s = acquire(step, "ring_receive_buffer::store_received");
+
+            if (s.state_.load() & stored)
+            {
+                HPX_THROW_EXCEPTION(invalid_status,
+                    "ring_receive_buffer::store_received",
+                    "the value for this step has been stored already");
+            }
+
+            // the value is set before the step is marked as stored, the slot
+            // is not reused before that
+            s.shared_state_->set_value(std::forward<Ts>(ts)...);
+
+            if (s.state_.fetch_or(stored) & received)
+                release(s, step);
+        }
+
+        /// Make the futures of all steps which have been retrieved, but
+        /// whose value was not stored yet, ready with the given exception.
+        ///
+        /// \returns The number of canceled steps.
+        std::size_t cancel_waiting(std::exception_ptr const& e)
+        {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i != depth_; ++i)
+            {
+                slot& s = slots_[i];
+
+                std::uint64_t state = s.state_.load();
+                while ((state & (prepared | received | stored)) ==
+                    (prepared | received))
+                {
+                    // keep the shared state alive, it must not be reused
+                    // for a later step before the exception was set
+                    boost::intrusive_ptr<shared_state_type> shared_state =
+                        s.shared_state_;
+
+                    if (s.state_.compare_exchange_strong(
+                            state, state | stored))
+                    {
+                        shared_state->set_exception(e);
+                        release(s, std::size_t(state >> step_shift));
+                        ++count;
+                        break;
+                    }
+                }
+            }
+            return count;
+        }
+
+    private:
+        static std::uint64_t make_state(std::size_t step)
+        {
+            return std::uint64_t(step) << step_shift;
+        }
+
+        // Wait for the slot of the given step to become available and make
+        // sure it holds a shared state for this step.
+        slot& acquire(std::size_t step, char const* name)
+        {
+            slot& s = slots_[step % depth_];
+            std::uint64_t const step_state = make_state(step);
+
+            for (std::size_t k = 0; /**/; ++k)
+            {
+                std::uint64_t state = s.state_.load(std::memory_order_acquire);
+                std::uint64_t const current = state & ~std::uint64_t(flags_mask);
+
+                if (current > step_state)
+                {
+                    HPX_THROW_EXCEPTION(invalid_status, name,
+                        "the given step has been completed already");
+                }
+
+                if (current == step_state)
+                {
+                    if (state & prepared)
+                        return s;
+
+                    if (!(state & preparing) &&
+                        s.state_.compare_exchange_strong(
+                            state, state | preparing))
+                    {
+                        prepare(s);
+                        s.state_.store(step_state | prepared,
+                            std::memory_order_release);
+                        return s;
+                    }
+                }
+
+                // the step the slot is used for has not completed yet, or
+                // the slot is being prepared concurrently
+                hpx::util::detail::yield_k(k, name);
+            }
+        }
+
+        // reuse the shared state if it is not referenced by a future anymore
+        static void prepare(slot& s)
+        {
+            if (s.shared_state_->is_unique())
+                s.shared_state_->reset();
+            else
+                s.shared_state_.reset(new shared_state_type(), false);
+        }
+
+        // both operations for the step have been performed, the slot moves
+        // on to the step which is depth steps ahead
+        void release(slot& s, std::size_t step)
+        {
+            s.state_.store(make_state(step + depth_),
+                std::memory_order_release);
+        }
+
+    private:
+        std::size_t const depth_;
+        std::unique_ptr<slot[]> slots_;
+    };
+}}}
+
+#endif
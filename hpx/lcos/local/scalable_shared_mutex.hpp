@@ -0,0 +1,198 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file hpx/lcos/local/scalable_shared_mutex.hpp
+
+#if !defined(HPX_LCOS_LOCAL_SCALABLE_SHARED_MUTEX_HPP)
+#define HPX_LCOS_LOCAL_SCALABLE_SHARED_MUTEX_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/detail/condition_variable.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace lcos { namespace local
+{
+    /// A reader-writer lock for read-mostly data. Readers register themselves
+    /// in a counter kept on a separate cache line for each worker thread, so
+    /// readers running on different cores do not contend with each other.
+    /// Writers announce themselves with a flag and wait until the counts of
+    /// all slots add up to zero. Waiting readers and writers suspend the
+    /// calling HPX thread.
+    ///
+    /// Writers are preferred: once a writer is waiting, new readers are held
+    /// back until it has released the lock. Locking exclusively is more
+    /// expensive than for \a local::shared_mutex, as all slots have to be
+    /// scanned.
+    ///
+    /// \note   An HPX thread holding a shared lock may be resumed on a
+    ///         different worker thread, this is fine as writers only look at
+    ///         the sum of all slots.
+    class scalable_shared_mutex
+    {
+    public:
+        HPX_NON_COPYABLE(scalable_shared_mutex);
+
+    private:
+        typedef lcos::local::spinlock mutex_type;
+
+        struct slot
+        {
+            // the count may become negative for slots from which readers
+            // resumed on a different worker thread have unlocked
+            std::atomic<std::ptrdiff_t> readers_;
+            char pad_[threads::get_cache_line_size() -
+                sizeof(std::atomic<std::ptrdiff_t>)];
+        };
+
+    public:
+        /// Create a lock with one slot per core (and one slot shared by all
+        /// threads which are not HPX worker threads).
+        scalable_shared_mutex()
+          : scalable_shared_mutex(threads::hardware_concurrency() + 1)
+        {}
+
+        /// Create a lock with the given number of slots, worker threads are
+        /// assigned to the slots round robin. The last slot is used by all
+        /// threads which are not HPX worker threads.
+        explicit scalable_shared_mutex(std::size_t num_slots)
+          : num_slots_(num_slots != 0 ? num_slots : 1)
+          , slots_(new slot[num_slots_])
+          , writer_(false)
+        {
+            for (std::size_t i = 0; i != num_slots_; ++i)
+                slots_[i].readers_.store(0, std::memory_order_relaxed);
+        }
+
+        void lock_shared()
+        {
+            while (!try_lock_shared())
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+                while (writer_.load(std::memory_order_seq_cst))
+                {
+                    no_writer_.wait(l,
+                        "scalable_shared_mutex::lock_shared");
+                }
+            }
+        }
+
+        bool try_lock_shared()
+        {
+            std::atomic<std::ptrdiff_t>& readers = get_slot().readers_;
+
+            readers.fetch_add(1, std::memory_order_seq_cst);
+            if (!writer_.load(std::memory_order_seq_cst))
+                return true;
+
+            // a writer is active or waiting, back off
+            readers.fetch_sub(1, std::memory_order_seq_cst);
+            notify_writer();
+            return false;
+        }
+
+        void unlock_shared()
+        {
+            get_slot().readers_.fetch_sub(1, std::memory_order_seq_cst);
+            if (writer_.load(std::memory_order_seq_cst))
+                notify_writer();
+        }
+
+        void lock()
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+
+            // wait for other writers first
+            bool expected = false;
+            while (!writer_.compare_exchange_strong(
+                expected, true, std::memory_order_seq_cst))
+            {
+                no_writer_.wait(l, "scalable_shared_mutex::lock");
+                expected = false;
+            }
+
+            // readers which registered themselves before the flag was set
+            // either see the flag or are counted by the scan
+            while (!no_readers())
+                no_readers_.wait(l, "scalable_shared_mutex::lock");
+        }
+
+        bool try_lock()
+        {
+            bool expected = false;
+            if (!writer_.compare_exchange_strong(
+                    expected, true, std::memory_order_seq_cst))
+            {
+                return false;
+            }
+
+            if (no_readers())
+                return true;
+
+            unlock();
+            return false;
+        }
+
+        void unlock()
+        {
+            HPX_ASSERT(writer_.load(std::memory_order_relaxed));
+            writer_.store(false, std::memory_order_seq_cst);
+
+            std::unique_lock<mutex_type> l(mtx_);
+            no_writer_.notify_all(std::move(l));
+        }
+
+    private:
+        slot& get_slot() const noexcept
+        {
+            std::size_t const num_thread = hpx::get_worker_thread_num();
+            if (num_thread == std::size_t(-1) || num_slots_ == 1)
+                return slots_[num_slots_ - 1];
+            return slots_[num_thread % (num_slots_ - 1)];
+        }
+
+        bool no_readers() const noexcept
+        {
+            std::ptrdiff_t readers = 0;
+            for (std::size_t i = 0; i != num_slots_; ++i)
+                readers += slots_[i].readers_.load(std::memory_order_seq_cst);
+
+            HPX_ASSERT(readers >= 0);
+            return readers == 0;
+        }
+
+        // Resume the writer waiting for the readers to unlock (if any). The
+        // mutex makes sure the writer is either still scanning the slots or
+        // already suspended.
+        void notify_writer()
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+            no_readers_.notify_all(std::move(l));
+        }
+
+    private:
+        std::size_t const num_slots_;
+        std::unique_ptr<slot[]> slots_;
+
+        char pad0_[threads::get_cache_line_size()];
+        std::atomic<bool> writer_;
+        char pad1_[threads::get_cache_line_size()];
+
+        mutex_type mtx_;
+        local::detail::condition_variable no_writer_;
+        local::detail::condition_variable no_readers_;
+    };
+}}}
+
+#endif
@@ -10,7 +10,9 @@
 #include <hpx/config.hpp>
 #include <hpx/lcos/local/condition_variable.hpp>
 #include <hpx/lcos/local/mutex.hpp>
+#include <hpx/util/lock_profiler.hpp>
 
+#include <cstdint>
 #include <mutex>
 
 namespace hpx { namespace lcos { namespace local
@@ -43,9 +45,59 @@ namespace hpx { namespace lcos { namespace local
                 shared_cond.notify_all();
             }
 
+#if defined(HPX_HAVE_LOCK_PROFILING)
+            // wait for the lock to become available, recording the wait and
+            // the acquisition with the lock profiler
+            template <typename Blocked>
+            HPX_FORCEINLINE void profiled_wait(
+                std::unique_lock<mutex_type>& lk, Blocked const& blocked,
+                lcos::local::condition_variable& cond, bool exclusive)
+            {
+                if (!blocked())
+                {
+                    util::lock_profiling::acquired(this,
+                        util::lock_profiling::kind_shared_mutex);
+                    return;
+                }
+
+                std::uint64_t token = util::lock_profiling::wait_begin(this);
+                while (blocked())
+                {
+                    if (exclusive)
+                        state.exclusive_waiting_blocked = true;
+                    cond.wait(lk);
+                }
+                util::lock_profiling::wait_end(this,
+                    util::lock_profiling::kind_shared_mutex, token);
+            }
+#endif
+
+            HPX_FORCEINLINE void profiled_acquired()
+            {
+#if defined(HPX_HAVE_LOCK_PROFILING)
+                if (HPX_UNLIKELY(util::lock_profiling::lock_profiling_enabled))
+                {
+                    util::lock_profiling::acquired(this,
+                        util::lock_profiling::kind_shared_mutex);
+                }
+#endif
+            }
+
+            HPX_FORCEINLINE void profiled_released()
+            {
+#if defined(HPX_HAVE_LOCK_PROFILING)
+                if (HPX_UNLIKELY(util::lock_profiling::lock_profiling_enabled))
+                    util::lock_profiling::released(this);
+#endif
+            }
+
         public:
+            // the waits for the condition variables are recorded by the
+            // lock profiler as waits for the shared_mutex itself
             shared_mutex()
-              : shared_cond(), exclusive_cond(), upgrade_cond()
+              : shared_cond(util::lock_profiling::kind_untracked)
+              , exclusive_cond(util::lock_profiling::kind_untracked)
+              , upgrade_cond(util::lock_profiling::kind_untracked)
             {
                 state_data state_ = {0, 0, 0, 0};
                 state = state_;
@@ -55,6 +107,20 @@ namespace hpx { namespace lcos { namespace local
             {
                 std::unique_lock<mutex_type> lk(state_change);
 
+#if defined(HPX_HAVE_LOCK_PROFILING)
+                if (HPX_UNLIKELY(util::lock_profiling::lock_profiling_enabled))
+                {
+                    profiled_wait(lk, [this]() -> bool
+                        {
+                            return state.exclusive ||
+                                state.exclusive_waiting_blocked;
+                        },
+                        shared_cond, false);
+                    ++state.shared_count;
+                    return;
+                }
+#endif
+
                 while (state.exclusive || state.exclusive_waiting_blocked)
                 {
                     shared_cond.wait(lk);
@@ -73,6 +139,7 @@ namespace hpx { namespace lcos { namespace local
                 else
                 {
                     ++state.shared_count;
+                    profiled_acquired();
                     return true;
                 }
             }
@@ -80,6 +147,7 @@ namespace hpx { namespace lcos { namespace local
             void unlock_shared()
             {
                 std::unique_lock<mutex_type> lk(state_change);
+                profiled_released();
 
                 bool const last_reader = !--state.shared_count;
 
@@ -105,6 +173,19 @@ namespace hpx { namespace lcos { namespace local
             {
                 std::unique_lock<mutex_type> lk(state_change);
 
+#if defined(HPX_HAVE_LOCK_PROFILING)
+                if (HPX_UNLIKELY(util::lock_profiling::lock_profiling_enabled))
+                {
+                    profiled_wait(lk, [this]() -> bool
+                        {
+                            return state.shared_count || state.exclusive;
+                        },
+                        exclusive_cond, true);
+                    state.exclusive = true;
+                    return;
+                }
+#endif
+
                 while (state.shared_count || state.exclusive)
                 {
                     state.exclusive_waiting_blocked = true;
@@ -124,6 +205,7 @@ namespace hpx { namespace lcos { namespace local
                 else
                 {
                     state.exclusive = true;
+                    profiled_acquired();
                     return true;
                 }
             }
@@ -131,6 +213,7 @@ namespace hpx { namespace lcos { namespace local
             void unlock()
             {
                 std::unique_lock<mutex_type> lk(state_change);
+                profiled_released();
                 state.exclusive = false;
                 state.exclusive_waiting_blocked = false;
                 release_waiters();
@@ -70,6 +70,9 @@ namespace hpx { namespace lcos { namespace local
         ///           set by signal() is larger than the max_difference.
         void wait(std::int64_t upper_limit)
         {
+            if (sem_.ready(upper_limit))
+                return;
+
             std::unique_lock<mutex_type> l(mtx_);
             sem_.wait(l, upper_limit);
         }
@@ -85,8 +88,7 @@ namespace hpx { namespace lcos { namespace local
         ///           would not block if it was calling wait().
         bool try_wait(std::int64_t upper_limit = 1)
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            return sem_.try_wait(l, upper_limit);
+            return sem_.ready(upper_limit);
         }
 
         /// \brief Signal the semaphore
@@ -96,10 +98,16 @@ namespace hpx { namespace lcos { namespace local
         ///             re-schedule all suspended threads for which their
         ///             associated upper limit is not larger than the lower
         ///             limit plus the max_difference.
+        ///
+        /// \note The lock protecting the queue of suspended threads is
+        ///       acquired only if there are threads waiting.
         void signal(std::int64_t lower_limit)
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            sem_.signal(std::move(l), lower_limit);
+            if (sem_.release(lower_limit))
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+                sem_.notify(std::move(l));
+            }
         }
 
         std::int64_t signal_all()
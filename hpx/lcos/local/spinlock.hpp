@@ -17,6 +17,7 @@
 #include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/util/detail/yield_k.hpp>
 #include <hpx/util/itt_notify.hpp>
+#include <hpx/util/lock_profiler.hpp>
 #include <hpx/util/register_locks.hpp>
 
 #include <cstddef>
@@ -68,6 +69,14 @@ namespace hpx { namespace lcos { namespace local
         {
             HPX_ITT_SYNC_PREPARE(this);
 
+#if defined(HPX_HAVE_LOCK_PROFILING)
+            if (HPX_UNLIKELY(util::lock_profiling::lock_profiling_enabled))
+            {
+                lock_profiled();
+                return;
+            }
+#endif
+
             for (std::size_t k = 0; !acquire_lock(); ++k)
             {
                 util::detail::yield_k(k, "hpx::lcos::local::spinlock::lock",
@@ -85,6 +94,13 @@ namespace hpx { namespace lcos { namespace local
             bool r = acquire_lock(); //-V707
 
             if (r) {
+#if defined(HPX_HAVE_LOCK_PROFILING)
+                if (HPX_UNLIKELY(util::lock_profiling::lock_profiling_enabled))
+                {
+                    util::lock_profiling::acquired(this,
+                        util::lock_profiling::kind_spinlock);
+                }
+#endif
                 HPX_ITT_SYNC_ACQUIRED(this);
                 util::register_lock(this);
                 return true;
@@ -98,6 +114,11 @@ namespace hpx { namespace lcos { namespace local
         {
             HPX_ITT_SYNC_RELEASING(this);
 
+#if defined(HPX_HAVE_LOCK_PROFILING)
+            if (HPX_UNLIKELY(util::lock_profiling::lock_profiling_enabled))
+                util::lock_profiling::released(this);
+#endif
+
             relinquish_lock();
 
             HPX_ITT_SYNC_RELEASED(this);
@@ -105,6 +126,33 @@ namespace hpx { namespace lcos { namespace local
         }
 
     private:
+#if defined(HPX_HAVE_LOCK_PROFILING)
+        // the call site recorded is the function the lock is inlined into
+        HPX_FORCEINLINE void lock_profiled()
+        {
+            if (acquire_lock())
+            {
+                util::lock_profiling::acquired(this,
+                    util::lock_profiling::kind_spinlock);
+            }
+            else
+            {
+                std::uint64_t token = util::lock_profiling::wait_begin(this);
+                for (std::size_t k = 0; !acquire_lock(); ++k)
+                {
+                    util::detail::yield_k(k,
+                        "hpx::lcos::local::spinlock::lock",
+                        hpx::threads::pending_boost);
+                }
+                util::lock_profiling::wait_end(this,
+                    util::lock_profiling::kind_spinlock, token);
+            }
+
+            HPX_ITT_SYNC_ACQUIRED(this);
+            util::register_lock(this);
+        }
+#endif
+
         // returns whether the mutex has been acquired
         bool acquire_lock()
         {
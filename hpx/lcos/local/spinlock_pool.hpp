@@ -56,7 +56,8 @@ namespace hpx { namespace lcos { namespace local
     private:
         static detail::spinlock_holder pool_[N];
 #if HPX_HAVE_ITTNOTIFY != 0
-        static detail::itt_spinlock_init<Tag> init_;
+        static detail::itt_spinlock_init<Tag, N> init_;
+        friend struct detail::itt_spinlock_init<Tag, N>;
 #endif
     public:
         static lcos::local::spinlock & spinlock_for(void const * pv)
@@ -110,11 +111,11 @@ namespace hpx { namespace lcos { namespace local
         template <typename Tag, std::size_t N>
         itt_spinlock_init<Tag, N>::itt_spinlock_init()
         {
-            for (int i = 0; i < 41; ++i)
+            for (std::size_t i = 0; i != N; ++i)
             {
                 HPX_ITT_SYNC_CREATE(&lcos::local::spinlock_pool<Tag, N>::pool_[i].lock,
                     "hpx::lcos::spinlock", 0);
-                HPX_ITT_SYNC_RENAME(&lcos::local::spinlock_pool<Tag, N>::pool_[i].loc,
+                HPX_ITT_SYNC_RENAME(&lcos::local::spinlock_pool<Tag, N>::pool_[i].lock,
                     "hpx::lcos::spinlock");
             }
         }
@@ -122,7 +123,7 @@ namespace hpx { namespace lcos { namespace local
         template <typename Tag, std::size_t N>
         itt_spinlock_init<Tag, N>::~itt_spinlock_init()
         {
-            for (int i = 0; i < N; ++i)
+            for (std::size_t i = 0; i != N; ++i)
             {
                 HPX_ITT_SYNC_DESTROY(&spinlock_pool<Tag, N>::pool_[i].lock);
             }
@@ -130,7 +131,7 @@ namespace hpx { namespace lcos { namespace local
     }
 
     template <typename Tag, std::size_t N>
-    util::detail::itt_spinlock_init<Tag, N> spinlock_pool<Tag, N>::init_;
+    detail::itt_spinlock_init<Tag, N> spinlock_pool<Tag, N>::init_;
 #endif
 }}}
 
@@ -0,0 +1,335 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file lcos/local/task_graph.hpp
+
+#if !defined(HPX_LCOS_LOCAL_TASK_GRAPH_HPP)
+#define HPX_LCOS_LOCAL_TASK_GRAPH_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/executors/parallel_executor.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/traits/is_executor.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/unique_function.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace lcos { namespace local
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// A \a task_graph records a set of tasks and the dependencies between
+    /// them once and executes (replays) the whole graph as often as needed.
+    /// This is meant for iterative programs which build the same graph of
+    /// \a dataflow or \a then continuations in every iteration.
+    ///
+    /// The graph is recorded by adding the tasks in an order which respects
+    /// their dependencies, every task may depend on tasks added before it
+    /// only (which makes the graph acyclic by construction). It is turned
+    /// into a fixed representation by \a instantiate (or by the first
+    /// \a run): the successors of every task are stored in one array and
+    /// every task has a preallocated counter of its outstanding
+    /// dependencies. Replaying the graph resets the counters, completing a
+    /// task costs one atomic decrement for each of its outgoing edges. The
+    /// tasks do not allocate futures or shared states, the only allocation
+    /// for each replay is the shared state of the returned future.
+    ///
+    /// \code
+    ///     hpx::lcos::local::task_graph g;
+    ///     auto a = g.add([&]() { compute_left(); });
+    ///     auto b = g.add([&]() { compute_right(); });
+    ///     g.add([&]() { exchange(); }, {a, b});
+    ///
+    ///     for (int step = 0; step != num_steps; ++step)
+    ///         g.run().get();
+    /// \endcode
+    ///
+    /// \note If a task throws, the tasks which did not start yet are skipped
+    ///       and the future returned from \a run holds the (first) exception.
+    ///
+    /// \note The graph must outlive all of its replays, it may not be
+    ///       replayed again before the previous replay has finished.
+    ///
+    class task_graph
+    {
+    public:
+        typedef std::size_t node_id;
+
+        HPX_NON_COPYABLE(task_graph);
+
+    public:
+        task_graph()
+          : instantiated_(false)
+          , running_(false)
+          , remaining_(0)
+          , failed_(false)
+        {}
+
+        /// Add a task which is executed once all of the given tasks have
+        /// finished executing.
+        ///
+        /// \returns The id of the new task.
+        ///
+        /// \throws hpx::exception with the error code \a bad_parameter if
+        ///         one of the dependencies does not refer to a task added
+        ///         before, or with \a invalid_status if the graph has been
+        ///         instantiated already.
+        template <typename F>
+        node_id add(F && f, std::initializer_list<node_id> dependencies = {})
+        {
+            return add_node(std::forward<F>(f),
+                std::vector<node_id>(dependencies));
+        }
+
+        template <typename F>
+        node_id add(F && f, std::vector<node_id> dependencies)
+        {
+            return add_node(std::forward<F>(f), std::move(dependencies));
+        }
+
+        /// Returns the number of tasks in the graph.
+        std::size_t size() const
+        {
+            return functions_.size();
+        }
+
+        /// Freeze the graph, no tasks can be added afterwards. This is done
+        /// by the first replay if it was not done explicitly.
+        void instantiate()
+        {
+            if (instantiated_)
+                return;
+
+            std::size_t const count = functions_.size();
+
+            // count the outgoing edges of each task
+            successor_offsets_.assign(count + 1, 0);
+            num_dependencies_.resize(count);
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                num_dependencies_[i] = dependencies_[i].size();
+                for (node_id dep : dependencies_[i])
+                    ++successor_offsets_[dep + 1];
+
+                if (dependencies_[i].empty())
+                    roots_.push_back(i);
+            }
+            for (std::size_t i = 0; i != count; ++i)
+                successor_offsets_[i + 1] += successor_offsets_[i];
+
+            // store the successors of task i at
+            // [successor_offsets_[i], successor_offsets_[i + 1])
+            successors_.resize(successor_offsets_[count]);
+            std::vector<std::size_t> next(successor_offsets_.begin(),
+                successor_offsets_.end() - 1);
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                for (node_id dep : dependencies_[i])
+                    successors_[next[dep]++] = i;
+            }
+
+            counters_.reset(new std::atomic<std::size_t>[count]);
+            std::vector<std::vector<node_id> >().swap(dependencies_);
+
+            instantiated_ = true;
+        }
+
+        /// Execute all tasks of the graph using the given executor.
+        ///
+        /// \returns A future which becomes ready once all tasks have
+        ///          finished executing.
+        ///
+        /// \throws hpx::exception with the error code \a invalid_status if
+        ///         the previous replay has not finished yet.
+        template <typename Executor, typename Enable = typename
+            std::enable_if<traits::is_one_way_executor<
+                typename std::decay<Executor>::type>::value ||
+            traits::is_two_way_executor<
+                typename std::decay<Executor>::type>::value>::type>
+        hpx::future<void> run(Executor && exec)
+        {
+            instantiate();
+
+            if (running_.exchange(true))
+            {
+                HPX_THROW_EXCEPTION(invalid_status, "task_graph::run",
+                    "the previous replay of the task graph has not "
+                    "finished yet");
+            }
+
+            std::size_t const count = functions_.size();
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                counters_[i].store(num_dependencies_[i],
+                    std::memory_order_relaxed);
+            }
+            remaining_.store(count, std::memory_order_relaxed);
+            failed_.store(false, std::memory_order_relaxed);
+            exception_ = std::exception_ptr();
+
+            promise_ = lcos::local::promise<void>();
+            hpx::future<void> result = promise_.get_future();
+
+            if (count == 0)
+            {
+                finish();
+                return result;
+            }
+
+            // creating the threads makes the counters visible to them
+            for (node_id root : roots_)
+                spawn(exec, root);
+
+            return result;
+        }
+
+        /// Execute all tasks of the graph on new HPX threads.
+        hpx::future<void> run()
+        {
+            return run(parallel::execution::parallel_executor());
+        }
+
+    private:
+        template <typename F>
+        node_id add_node(F && f, std::vector<node_id> && dependencies)
+        {
+            if (instantiated_)
+            {
+                HPX_THROW_EXCEPTION(invalid_status, "task_graph::add",
+                    "tasks cannot be added to an instantiated task graph");
+            }
+
+            node_id const id = functions_.size();
+            for (node_id dep : dependencies)
+            {
+                if (dep >= id)
+                {
+                    HPX_THROW_EXCEPTION(bad_parameter, "task_graph::add",
+                        "a task can depend on tasks added before it only");
+                }
+            }
+
+            functions_.emplace_back(std::forward<F>(f));
+            dependencies_.push_back(std::move(dependencies));
+            return id;
+        }
+
+        template <typename Executor>
+        void spawn(Executor const& exec, node_id id)
+        {
+            parallel::execution::post(exec,
+                [this, exec, id]() -> void
+                {
+                    execute(exec, id);
+                });
+        }
+
+        // Run the given task and release its successors. One of the
+        // successors which become ready is run directly by the same thread,
+        // the others are run on new threads.
+        template <typename Executor>
+        void execute(Executor const& exec, node_id id)
+        {
+            static node_id const no_node = node_id(-1);
+
+            while (id != no_node)
+            {
+                if (!failed_.load(std::memory_order_relaxed))
+                {
+                    try {
+                        functions_[id]();
+                    }
+                    catch (...) {
+                        set_exception(std::current_exception());
+                    }
+                }
+
+                node_id next = no_node;
+                for (std::size_t i = successor_offsets_[id];
+                     i != successor_offsets_[id + 1]; ++i)
+                {
+                    node_id const succ = successors_[i];
+                    if (counters_[succ].fetch_sub(1,
+                            std::memory_order_acq_rel) == 1)
+                    {
+                        if (next == no_node)
+                            next = succ;
+                        else
+                            spawn(exec, succ);
+                    }
+                }
+
+                if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    HPX_ASSERT(next == no_node);
+                    finish();
+                    return;
+                }
+
+                id = next;
+            }
+        }
+
+        void set_exception(std::exception_ptr e)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            if (!exception_)
+                exception_ = std::move(e);
+            failed_.store(true, std::memory_order_relaxed);
+        }
+
+        // the graph may be replayed again as soon as the promise is set
+        void finish()
+        {
+            lcos::local::promise<void> p = std::move(promise_);
+            std::exception_ptr e = std::move(exception_);
+            running_.store(false);
+
+            if (e)
+                p.set_exception(std::move(e));
+            else
+                p.set_value();
+        }
+
+    private:
+        typedef lcos::local::spinlock mutex_type;
+
+        std::vector<util::unique_function_nonser<void()> > functions_;
+
+        // the dependencies as recorded, dropped by instantiate()
+        std::vector<std::vector<node_id> > dependencies_;
+
+        // the instantiated graph
+        bool instantiated_;
+        std::vector<std::size_t> num_dependencies_;
+        std::vector<std::size_t> successor_offsets_;
+        std::vector<node_id> successors_;
+        std::vector<node_id> roots_;
+        std::unique_ptr<std::atomic<std::size_t>[]> counters_;
+
+        // state of the current replay
+        std::atomic<bool> running_;
+        std::atomic<std::size_t> remaining_;
+        std::atomic<bool> failed_;
+        mutex_type mtx_;
+        std::exception_ptr exception_;
+        lcos::local::promise<void> promise_;
+    };
+}}}
+
+#endif
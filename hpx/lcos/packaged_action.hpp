@@ -9,6 +9,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/lcos/promise.hpp>
+#include <hpx/runtime/actions/detail/action_latency_registry.hpp>
 #include <hpx/runtime/applier/apply.hpp>
 #include <hpx/runtime/applier/apply_callback.hpp>
 #include <hpx/runtime/components/component_type.hpp>
@@ -19,11 +20,16 @@
 #include <hpx/traits/component_type_is_compatible.hpp>
 #include <hpx/traits/extract_action.hpp>
 #include <hpx/util/assert.hpp>
-#include <hpx/util/internal_allocator.hpp>
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+#include <hpx/util/hdr_histogram.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#endif
+#include <hpx/util/tagged_allocator.hpp>
 
 #include <boost/asio/error.hpp>
 #include <boost/intrusive_ptr.hpp>
 
+#include <cstdint>
 #include <exception>
 #include <memory>
 #include <utility>
@@ -123,6 +129,31 @@ namespace lcos {
         typedef typename action_type::remote_result_type remote_result_type;
         typedef promise<Result, remote_result_type> base_type;
 
+        // Measure the time until the result becomes available and the time
+        // spent waiting for it.
+        void measure_latencies()
+        {
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+            if (!actions::detail::maintain_action_latencies)
+                return;
+
+            actions::detail::action_latency_data& data =
+                actions::detail::get_action_latency_data<action_type>();
+            this->shared_state_->set_wait_time_histogram(
+                &data.histograms_[actions::detail::future_wait_latency]);
+
+            util::hdr_histogram* round_trip =
+                &data.histograms_[actions::detail::round_trip_latency];
+            std::uint64_t start = util::high_resolution_clock::now();
+            this->shared_state_->set_on_completed(
+                [round_trip, start]()
+                {
+                    round_trip->record(static_cast<std::int64_t>(
+                        util::high_resolution_clock::now() - start));
+                });
+#endif
+        }
+
         ///////////////////////////////////////////////////////////////////////
         template <typename... Ts>
         void do_apply(naming::address&& addr, naming::id_type const& id,
@@ -132,6 +163,8 @@ namespace lcos {
                         << hpx::actions::detail::get_action_name<action_type>()
                         << ", " << id << ") args(" << sizeof...(Ts) << ")";
 
+            measure_latencies();
+
             auto&& f = detail::parcel_write_handler<Result>{this->shared_state_};
 
             naming::address addr_(this->resolve());
@@ -165,6 +198,8 @@ namespace lcos {
                         << hpx::actions::detail::get_action_name<action_type>()
                         << ", " << id << ") args(" << sizeof...(Ts) << ")";
 
+            measure_latencies();
+
             auto&& f = detail::parcel_write_handler<Result>{this->shared_state_};
 
             naming::address addr_(this->resolve());
@@ -187,6 +222,8 @@ namespace lcos {
                         << hpx::actions::detail::get_action_name<action_type>()
                         << ", " << id << ") args(" << sizeof...(Ts) << ")";
 
+            measure_latencies();
+
             typedef typename util::decay<Callback>::type callback_type;
             auto&& f = detail::parcel_write_handler_cb<Result, callback_type>{
                 this->shared_state_, std::forward<Callback>(cb)};
@@ -222,6 +259,8 @@ namespace lcos {
                         << hpx::actions::detail::get_action_name<action_type>()
                         << ", " << id << ") args(" << sizeof...(Ts) << ")";
 
+            measure_latencies();
+
             typedef typename util::decay<Callback>::type callback_type;
             auto&& f = detail::parcel_write_handler_cb<Result, callback_type>{
                 this->shared_state_, std::forward<Callback>(cb)};
@@ -243,7 +282,7 @@ namespace lcos {
         // use this instance its member function \a apply needs to be directly
         // called.
         packaged_action()
-          : base_type(std::allocator_arg, hpx::util::internal_allocator<>{})
+          : base_type(std::allocator_arg, hpx::util::future_state_allocator<>{})
         {
         }
 
@@ -373,7 +412,7 @@ namespace lcos {
         /// called.
         packaged_action()
           : packaged_action<Action, Result, false>(
-              std::allocator_arg, hpx::util::internal_allocator<>{})
+              std::allocator_arg, hpx::util::future_state_allocator<>{})
         {
         }
 
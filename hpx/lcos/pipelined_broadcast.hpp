@@ -0,0 +1,403 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file lcos/pipelined_broadcast.hpp
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// \brief Perform a distributed, pipelined broadcast of a large buffer
+    ///
+    /// The function hpx::lcos::pipelined_broadcast invokes the given action
+    /// on all given identifiers, passing along the given buffer. The action
+    /// can be either a plain action or a component action, its only argument
+    /// has to be a hpx::serialization::serialize_buffer.
+    ///
+    /// Contrary to hpx::lcos::broadcast, the buffer is split into chunks that
+    /// are passed down a tree of the targets. Every target forwards each
+    /// chunk to its children as soon as it was received, without copying
+    /// it. The action is invoked on a target once all chunks have arrived
+    /// there.
+    ///
+    /// \param ids        [in] A list of global identifiers identifying the
+    ///                   target objects for which the given action will be
+    ///                   invoked.
+    /// \param buffer     [in] The buffer to pass to all invocations of the
+    ///                   action. It must not be modified before the returned
+    ///                   future has become ready.
+    /// \param chunk_size [in] The size of the chunks in bytes (default:
+    ///                   HPX_PIPELINED_BROADCAST_CHUNK_SIZE, 1MB).
+    ///
+    /// \returns         This function returns a future which becomes ready
+    ///                  once the action has been executed on all targets.
+    ///                  The results of the action invocations are discarded.
+    ///
+    /// \note            Use the macros HPX_REGISTER_PIPELINED_BROADCAST_ACTION
+    ///                  and HPX_REGISTER_PIPELINED_BROADCAST_ACTION_DECLARATION
+    ///                  to register the action for a pipelined broadcast.
+    ///
+    template <typename Action, typename Buffer>
+    hpx::future<void>
+    pipelined_broadcast(
+        std::vector<hpx::id_type> const & ids
+      , Buffer const& buffer
+      , std::size_t chunk_size = HPX_PIPELINED_BROADCAST_CHUNK_SIZE);
+}}
+#else
+
+#if !defined(HPX_LCOS_PIPELINED_BROADCAST_HPP)
+#define HPX_LCOS_PIPELINED_BROADCAST_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/detail/async_colocated.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/lcos/when_all.hpp>
+#include <hpx/runtime/actions/plain_action.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime/serialization/serialize_buffer.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/detail/pp/cat.hpp>
+#include <hpx/util/detail/pp/expand.hpp>
+#include <hpx/util/detail/pp/nargs.hpp>
+#include <hpx/util/tuple.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if !defined(HPX_PIPELINED_BROADCAST_FANOUT)
+#define HPX_PIPELINED_BROADCAST_FANOUT 2
+#endif
+
+#if !defined(HPX_PIPELINED_BROADCAST_CHUNK_SIZE)
+#define HPX_PIPELINED_BROADCAST_CHUNK_SIZE (std::size_t(1) << 20)
+#endif
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The buffers being assembled on this locality, identified by the
+        // locality which started the broadcast, the sequence number of the
+        // broadcast on that locality, and the index of the target.
+        template <typename Buffer>
+        class pipelined_broadcast_buffers
+        {
+            typedef lcos::local::spinlock mutex_type;
+            typedef util::tuple<std::uint32_t, std::uint64_t, std::size_t>
+                key_type;
+
+            struct entry
+            {
+                Buffer buffer_;
+                std::size_t remaining_;
+            };
+
+        public:
+            pipelined_broadcast_buffers()
+              : sequence_(0)
+            {}
+
+            static pipelined_broadcast_buffers& instance()
+            {
+                static pipelined_broadcast_buffers buffers;
+                return buffers;
+            }
+
+            std::uint64_t next_sequence()
+            {
+                return ++sequence_;
+            }
+
+            // Store the given chunk, returns true if this was the last
+            // missing chunk of the buffer.
+            bool deposit(key_type const& key, std::size_t size,
+                std::size_t offset, Buffer const& chunk, Buffer& result)
+            {
+                // no need to assemble buffers consisting of one chunk
+                if (chunk.size() == size)
+                {
+                    result = chunk;
+                    return true;
+                }
+
+                Buffer buffer;
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+
+                    typename std::map<key_type, entry>::iterator it =
+                        entries_.find(key);
+                    if (it == entries_.end())
+                    {
+                        entry e = { Buffer(size), size };
+                        it = entries_.insert(std::make_pair(key, e)).first;
+                    }
+                    buffer = it->second.buffer_;
+                }
+
+                HPX_ASSERT(offset + chunk.size() <= size);
+                std::copy(chunk.data(), chunk.data() + chunk.size(),
+                    buffer.data() + offset);
+
+                std::lock_guard<mutex_type> l(mtx_);
+
+                typename std::map<key_type, entry>::iterator it =
+                    entries_.find(key);
+                HPX_ASSERT(it != entries_.end());
+                HPX_ASSERT(it->second.remaining_ >= chunk.size());
+
+                it->second.remaining_ -= chunk.size();
+                if (it->second.remaining_ != 0)
+                    return false;
+
+                result = std::move(it->second.buffer_);
+                entries_.erase(it);
+                return true;
+            }
+
+        private:
+            std::atomic<std::uint64_t> sequence_;
+            mutex_type mtx_;
+            std::map<key_type, entry> entries_;
+        };
+
+        // keeps the buffer alive which is referenced by a chunk
+        template <typename Buffer>
+        struct pipelined_broadcast_keep_alive
+        {
+            void operator()(typename Buffer::value_type*) const {}
+
+            Buffer buffer_;
+        };
+
+        inline void pipelined_broadcast_return_void(
+            hpx::future<std::vector<hpx::future<void> > > f)
+        {
+            std::vector<hpx::future<void> > futures = f.get();
+            for (hpx::future<void>& fut : futures)
+                fut.get();      // rethrow exceptions
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Action>
+        struct pipelined_broadcast_invoker;
+
+        template <typename Action>
+        struct make_pipelined_broadcast_action
+        {
+            typedef pipelined_broadcast_invoker<Action> invoker_type;
+
+            typedef
+                typename HPX_MAKE_ACTION(invoker_type::call)::type
+                type;
+        };
+
+        template <typename Action>
+        struct pipelined_broadcast_invoker
+        {
+            static_assert(Action::arity == 1,
+                "the action of a pipelined broadcast has to take exactly one "
+                "argument");
+
+            typedef typename util::decay<
+                    typename util::tuple_element<
+                        0, typename Action::arguments_type
+                    >::type
+                >::type buffer_type;
+
+            // Send the chunk to the targets [first, last), the targets are
+            // split into contiguous groups, the first target of each group
+            // forwards the chunk to the remaining targets of its group.
+            static void forward(std::vector<hpx::future<void> >& futures,
+                std::vector<hpx::id_type>::const_iterator first,
+                std::vector<hpx::id_type>::const_iterator last,
+                std::size_t global_idx, std::uint32_t source,
+                std::uint64_t sequence, std::size_t size, std::size_t offset,
+                buffer_type const& chunk)
+            {
+                typedef typename make_pipelined_broadcast_action<Action>::type
+                    action_type;
+
+                std::size_t count = std::size_t(last - first);
+                std::size_t fanout =
+                    (std::min)(count, std::size_t(HPX_PIPELINED_BROADCAST_FANOUT));
+
+                std::size_t applied = 0;
+                for (std::size_t i = 0; i != fanout; ++i)
+                {
+                    std::size_t next = (i + 1) * count / fanout;
+                    if (next == applied)
+                        continue;
+
+                    std::vector<hpx::id_type> ids_next(
+                        first + applied, first + next);
+
+                    hpx::id_type id(ids_next[0]);
+                    futures.push_back(
+                        hpx::detail::async_colocated<action_type>(
+                            id
+                          , std::move(ids_next)
+                          , global_idx + applied
+                          , source
+                          , sequence
+                          , size
+                          , offset
+                          , chunk
+                        )
+                    );
+
+                    applied = next;
+                }
+            }
+
+            // The received chunk is forwarded as is, serializing it again
+            // does not copy the data.
+            static hpx::future<void> call(
+                std::vector<hpx::id_type> const& ids, std::size_t global_idx,
+                std::uint32_t source, std::uint64_t sequence,
+                std::size_t size, std::size_t offset, buffer_type chunk)
+            {
+                HPX_ASSERT(!ids.empty());
+
+                std::vector<hpx::future<void> > futures;
+                futures.reserve(HPX_PIPELINED_BROADCAST_FANOUT + 1);
+
+                forward(futures, ids.begin() + 1, ids.end(), global_idx + 1,
+                    source, sequence, size, offset, chunk);
+
+                buffer_type buffer;
+                if (pipelined_broadcast_buffers<buffer_type>::instance().deposit(
+                        util::make_tuple(source, sequence, global_idx), size,
+                        offset, chunk, buffer))
+                {
+                    futures.push_back(hpx::future<void>(
+                        hpx::async<Action>(ids[0], std::move(buffer))));
+                }
+
+                return hpx::when_all(futures).then(
+                    &pipelined_broadcast_return_void);
+            }
+        };
+    }
+
+    template <typename Action, typename Buffer>
+    hpx::future<void>
+    pipelined_broadcast(
+        std::vector<hpx::id_type> const & ids
+      , Buffer const& buffer
+      , std::size_t chunk_size = HPX_PIPELINED_BROADCAST_CHUNK_SIZE)
+    {
+        typedef detail::pipelined_broadcast_invoker<Action> invoker_type;
+        typedef typename invoker_type::buffer_type buffer_type;
+        typedef typename buffer_type::value_type value_type;
+
+        static_assert(std::is_same<Buffer, buffer_type>::value,
+            "the buffer type has to match the argument of the action");
+
+        if (ids.empty())
+        {
+            return hpx::make_exceptional_future<void>(
+                HPX_GET_EXCEPTION(bad_parameter,
+                    "hpx::lcos::pipelined_broadcast",
+                    "empty list of targets for broadcast operation")
+                );
+        }
+
+        std::size_t const size = buffer.size();
+        std::size_t const elements_per_chunk =
+            (std::max)(chunk_size / sizeof(value_type), std::size_t(1));
+
+        std::uint32_t const source = hpx::get_locality_id();
+        std::uint64_t const sequence = detail::pipelined_broadcast_buffers<
+            buffer_type>::instance().next_sequence();
+
+        // the chunks reference the data of the given buffer
+        std::vector<hpx::future<void> > futures;
+        std::size_t offset = 0;
+        do
+        {
+            std::size_t count = (std::min)(elements_per_chunk, size - offset);
+
+            detail::pipelined_broadcast_keep_alive<buffer_type> keep_alive =
+                { buffer };
+            buffer_type chunk(buffer.data() + offset,
+                count, buffer_type::reference, keep_alive);
+
+            invoker_type::forward(futures, ids.begin(), ids.end(), 0, source,
+                sequence, size, offset, chunk);
+
+            offset += count;
+        }
+        while (offset != size);
+
+        return hpx::when_all(futures).then(
+            &detail::pipelined_broadcast_return_void);
+    }
+}}
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_REGISTER_PIPELINED_BROADCAST_ACTION_DECLARATION(...)              \
+    HPX_REGISTER_PIPELINED_BROADCAST_ACTION_DECLARATION_(__VA_ARGS__)         \
+/**/
+#define HPX_REGISTER_PIPELINED_BROADCAST_ACTION_DECLARATION_(...)             \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_PIPELINED_BROADCAST_ACTION_DECLARATION_,                 \
+            HPX_PP_NARGS(__VA_ARGS__)                                         \
+    )(__VA_ARGS__))                                                           \
+/**/
+
+#define HPX_REGISTER_PIPELINED_BROADCAST_ACTION_DECLARATION_1(Action)         \
+    HPX_REGISTER_PIPELINED_BROADCAST_ACTION_DECLARATION_2(Action, Action)     \
+/**/
+#define HPX_REGISTER_PIPELINED_BROADCAST_ACTION_DECLARATION_2(Action, Name)   \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        ::hpx::lcos::detail::make_pipelined_broadcast_action<Action>::type    \
+      , HPX_PP_CAT(pipelined_broadcast_, Name)                                \
+    )                                                                         \
+    HPX_REGISTER_ASYNC_COLOCATED_DECLARATION(                                 \
+        ::hpx::lcos::detail::make_pipelined_broadcast_action<Action>::type    \
+      , HPX_PP_CAT(async_colocated_pipelined_broadcast_, Name)                \
+    )                                                                         \
+/**/
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_REGISTER_PIPELINED_BROADCAST_ACTION(...)                          \
+    HPX_REGISTER_PIPELINED_BROADCAST_ACTION_(__VA_ARGS__)                     \
+/**/
+#define HPX_REGISTER_PIPELINED_BROADCAST_ACTION_(...)                         \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_PIPELINED_BROADCAST_ACTION_, HPX_PP_NARGS(__VA_ARGS__)   \
+    )(__VA_ARGS__))                                                           \
+/**/
+
+#define HPX_REGISTER_PIPELINED_BROADCAST_ACTION_1(Action)                     \
+    HPX_REGISTER_PIPELINED_BROADCAST_ACTION_2(Action, Action)                 \
+/**/
+#define HPX_REGISTER_PIPELINED_BROADCAST_ACTION_2(Action, Name)               \
+    HPX_REGISTER_ACTION(                                                      \
+        ::hpx::lcos::detail::make_pipelined_broadcast_action<Action>::type    \
+      , HPX_PP_CAT(pipelined_broadcast_, Name)                                \
+    )                                                                         \
+    HPX_REGISTER_ASYNC_COLOCATED(                                             \
+        ::hpx::lcos::detail::make_pipelined_broadcast_action<Action>::type    \
+      , HPX_PP_CAT(async_colocated_pipelined_broadcast_, Name)                \
+    )                                                                         \
+/**/
+
+#endif
+#endif // DOXYGEN
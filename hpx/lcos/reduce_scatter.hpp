@@ -0,0 +1,116 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file lcos/reduce_scatter.hpp
+
+#if !defined(HPX_LCOS_REDUCE_SCATTER_HPP)
+#define HPX_LCOS_REDUCE_SCATTER_HPP
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// Combine the values contributed by all sites position by position
+    /// using the given binary operation, site i receives the combined value
+    /// at position i.
+    ///
+    /// \param basename     The base name identifying the operation, all
+    ///                     sites have to use the same name.
+    /// \param local_result The values contributed by this site. It has to
+    ///                     hold exactly \a num_sites values.
+    /// \param op           The binary operation used to combine the values,
+    ///                     it has to be associative and commutative.
+    /// \param num_sites    The number of participating sites (default: all
+    ///                     localities).
+    /// \param generation   The generational counter identifying the sequence
+    ///                     number of the operation performed on the given
+    ///                     base name. It has to be supplied if the operation
+    ///                     is performed more than once with the same name.
+    /// \param this_site    The sequence number of this site (default: the
+    ///                     locality id).
+    ///
+    /// The partially combined values are passed around the ring of sites,
+    /// each site sends num_sites - 1 values.
+    ///
+    /// \returns    A future holding the combined value at position
+    ///             \a this_site.
+    ///
+    template <typename T, typename F>
+    hpx::future<T>
+    reduce_scatter(char const* basename, std::vector<T> local_result, F && op,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1));
+}}
+#else
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/detail/collective_mailbox.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        // in step s this site combines the value received from the previous
+        // site with its own value at the same position and passes it on,
+        // the value received last is the one at position this_site
+        template <typename T, typename F>
+        T reduce_scatter_values(std::string const& name,
+            std::vector<T> values, F op, std::size_t num_sites,
+            std::size_t this_site)
+        {
+            collective_site<T> site(name, num_sites, this_site);
+            std::size_t const next = (this_site + 1) % num_sites;
+
+            for (std::size_t s = 0; s != num_sites - 1; ++s)
+            {
+                std::size_t send = (this_site + 2 * num_sites - 1 - s) %
+                    num_sites;
+                std::size_t recv = (send + num_sites - 1) % num_sites;
+
+                site.send(next, s, std::move(values[send]));
+                values[recv] = op(site.receive(s), values[recv]);
+            }
+
+            return std::move(values[this_site]);
+        }
+    }
+
+    template <typename T, typename F>
+    hpx::future<T>
+    reduce_scatter(char const* basename, std::vector<T> local_result, F && op,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        typedef typename util::decay<F>::type op_type;
+
+        detail::get_collective_sites(num_sites, this_site);
+
+        if (local_result.size() != num_sites)
+        {
+            return hpx::make_exceptional_future<T>(
+                HPX_GET_EXCEPTION(bad_parameter, "hpx::lcos::reduce_scatter",
+                    "the number of values has to be equal to the number of "
+                    "sites"));
+        }
+
+        return hpx::async(&detail::reduce_scatter_values<T, op_type>,
+            detail::get_collective_name(basename, generation),
+            std::move(local_result), std::forward<F>(op), num_sites,
+            this_site);
+    }
+}}
+
+#endif // DOXYGEN
+#endif
@@ -0,0 +1,158 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_SERVER_DISTRIBUTED_QUEUE_HPP)
+#define HPX_LCOS_SERVER_DISTRIBUTED_QUEUE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/actions/component_action.hpp>
+#include <hpx/runtime/components/server/simple_component_base.hpp>
+#include <hpx/util/detail/pp/cat.hpp>
+#include <hpx/util/detail/pp/expand.hpp>
+#include <hpx/util/detail/pp/nargs.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos { namespace server
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // One shard of a distributed_queue. The consumers on the locality of the
+    // shard take the items from its front, the items requested by other
+    // shards are taken from its back. All operations move whole batches of
+    // items while holding the lock once.
+    template <typename T>
+    class distributed_queue
+      : public components::simple_component_base<distributed_queue<T> >
+    {
+        typedef lcos::local::spinlock mutex_type;
+
+    public:
+        distributed_queue() = default;
+
+        ///////////////////////////////////////////////////////////////////////
+        // Append the given items to the shard.
+        void push(std::vector<T> items)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            items_.insert(items_.end(), std::make_move_iterator(items.begin()),
+                std::make_move_iterator(items.end()));
+        }
+        HPX_DEFINE_COMPONENT_ACTION(distributed_queue, push);
+
+        void push_local(T&& item)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            items_.push_back(std::move(item));
+        }
+
+        // Take at most max_count items from the front of the shard, appends
+        // them to the given vector.
+        void pop(std::size_t max_count, std::vector<T>& items)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+
+            std::size_t count = (std::min)(max_count, items_.size());
+            auto last = items_.begin() + count;
+            items.insert(items.end(), std::make_move_iterator(items_.begin()),
+                std::make_move_iterator(last));
+            items_.erase(items_.begin(), last);
+        }
+
+        // Take at most max_count, but not more than half (rounded up) of the
+        // items from the back of the shard, this leaves work for the local
+        // consumers.
+        std::vector<T> steal(std::size_t max_count)
+        {
+            std::vector<T> items;
+
+            std::lock_guard<mutex_type> l(mtx_);
+
+            std::size_t count =
+                (std::min)(max_count, (items_.size() + 1) / 2);
+            auto first = items_.end() - count;
+            items.reserve(count);
+            items.insert(items.end(), std::make_move_iterator(first),
+                std::make_move_iterator(items_.end()));
+            items_.erase(first, items_.end());
+
+            return items;
+        }
+        HPX_DEFINE_COMPONENT_ACTION(distributed_queue, steal);
+
+        std::size_t size() const
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            return items_.size();
+        }
+        HPX_DEFINE_COMPONENT_ACTION(distributed_queue, size);
+
+    private:
+        mutable mutex_type mtx_;
+        std::deque<T> items_;
+    };
+}}}
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_REGISTER_DISTRIBUTED_QUEUE_DECLARATION(...)                       \
+    HPX_REGISTER_DISTRIBUTED_QUEUE_DECLARATION_(__VA_ARGS__)                  \
+/**/
+#define HPX_REGISTER_DISTRIBUTED_QUEUE_DECLARATION_(...)                      \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_DISTRIBUTED_QUEUE_DECLARATION_,                          \
+            HPX_PP_NARGS(__VA_ARGS__)                                         \
+    )(__VA_ARGS__))                                                           \
+/**/
+
+#define HPX_REGISTER_DISTRIBUTED_QUEUE_DECLARATION_1(type)                    \
+    HPX_REGISTER_DISTRIBUTED_QUEUE_DECLARATION_2(type, type)                  \
+/**/
+#define HPX_REGISTER_DISTRIBUTED_QUEUE_DECLARATION_2(type, name)              \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::server::distributed_queue< type>::push_action,             \
+        HPX_PP_CAT(__distributed_queue_push_action_, name))                   \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::server::distributed_queue< type>::steal_action,            \
+        HPX_PP_CAT(__distributed_queue_steal_action_, name))                  \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::server::distributed_queue< type>::size_action,             \
+        HPX_PP_CAT(__distributed_queue_size_action_, name))                   \
+/**/
+
+#define HPX_REGISTER_DISTRIBUTED_QUEUE(...)                                   \
+    HPX_REGISTER_DISTRIBUTED_QUEUE_(__VA_ARGS__)                              \
+/**/
+#define HPX_REGISTER_DISTRIBUTED_QUEUE_(...)                                  \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_DISTRIBUTED_QUEUE_, HPX_PP_NARGS(__VA_ARGS__)            \
+    )(__VA_ARGS__))                                                           \
+/**/
+
+#define HPX_REGISTER_DISTRIBUTED_QUEUE_1(type)                                \
+    HPX_REGISTER_DISTRIBUTED_QUEUE_2(type, type)                              \
+/**/
+#define HPX_REGISTER_DISTRIBUTED_QUEUE_2(type, name)                          \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::server::distributed_queue< type>::push_action,             \
+        HPX_PP_CAT(__distributed_queue_push_action_, name));                  \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::server::distributed_queue< type>::steal_action,            \
+        HPX_PP_CAT(__distributed_queue_steal_action_, name));                 \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::server::distributed_queue< type>::size_action,             \
+        HPX_PP_CAT(__distributed_queue_size_action_, name));                  \
+    typedef ::hpx::components::simple_component<                              \
+        ::hpx::lcos::server::distributed_queue< type>                         \
+    > HPX_PP_CAT(__distributed_queue_component_, name);                       \
+    HPX_REGISTER_COMPONENT(HPX_PP_CAT(__distributed_queue_component_, name))  \
+/**/
+
+#endif
@@ -0,0 +1,305 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_SERVER_FLOW_CHANNEL_HPP)
+#define HPX_LCOS_SERVER_FLOW_CHANNEL_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/actions/component_action.hpp>
+#include <hpx/runtime/components/server/simple_component_base.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/detail/pp/cat.hpp>
+#include <hpx/util/detail/pp/expand.hpp>
+#include <hpx/util/detail/pp/nargs.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace lcos { namespace server
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The consumer side of a flow controlled channel. Producers have to
+    // acquire a credit for each value they push, the number of credits is
+    // the capacity of the channel. Credits are given back as soon as the
+    // values have been retrieved from the channel.
+    template <typename T>
+    class flow_channel
+      : public components::simple_component_base<flow_channel<T> >
+    {
+        typedef lcos::local::spinlock mutex_type;
+
+        struct credit_request
+        {
+            std::size_t count_;
+            lcos::local::promise<std::size_t> promise_;
+        };
+
+        struct batch_request
+        {
+            std::size_t count_;
+            lcos::local::promise<std::vector<T> > promise_;
+        };
+
+    public:
+        flow_channel()
+          : credits_(0), closed_(false)
+        {
+            HPX_ASSERT(false);  // shouldn't ever be called
+        }
+
+        explicit flow_channel(std::size_t capacity)
+          : credits_(capacity), closed_(false)
+        {
+            if (capacity == 0)
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "hpx::lcos::server::flow_channel::flow_channel",
+                    "the capacity of a channel must be larger than zero");
+            }
+        }
+
+        // Acquire up to the given number of credits, the returned future
+        // becomes ready as soon as at least one credit is available. Zero
+        // credits are granted once the channel was closed.
+        hpx::future<std::size_t> acquire_credits(std::size_t count)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+
+            if (closed_)
+                return hpx::make_ready_future(std::size_t(0));
+
+            if (credits_ != 0 && credit_requests_.empty())
+                return hpx::make_ready_future(grant_credits(count));
+
+            credit_requests_.push_back(credit_request());
+            credit_requests_.back().count_ = count;
+            return credit_requests_.back().promise_.get_future();
+        }
+        HPX_DEFINE_COMPONENT_DIRECT_ACTION(flow_channel, acquire_credits);
+
+        // Give back credits which were acquired but not used.
+        void release_credits(std::size_t count)
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+            credits_ += count;
+            satisfy_requests(l);
+        }
+        HPX_DEFINE_COMPONENT_DIRECT_ACTION(flow_channel, release_credits);
+
+        // Push a batch of values covered by credits acquired before. Returns
+        // up to the given number of additional credits if those are
+        // immediately available, this function never waits.
+        std::size_t push(std::vector<T> values, std::size_t credits)
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+
+            if (closed_)
+            {
+                l.unlock();
+                HPX_THROW_EXCEPTION(invalid_status,
+                    "hpx::lcos::server::flow_channel::push",
+                    "attempting to write to a closed channel");
+            }
+
+            for (T& value : values)
+                values_.push_back(std::move(value));
+
+            std::size_t granted = 0;
+            if (credits_ != 0 && credit_requests_.empty())
+                granted = grant_credits(credits);
+
+            satisfy_requests(l);
+            return granted;
+        }
+        HPX_DEFINE_COMPONENT_ACTION(flow_channel, push);
+
+        // Retrieve up to the given number of values, the returned future
+        // becomes ready as soon as at least one value is available. An empty
+        // batch is returned once the channel was closed and all values have
+        // been retrieved.
+        hpx::future<std::vector<T> > get_batch(std::size_t count)
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+
+            if (batch_requests_.empty() && (!values_.empty() || closed_))
+            {
+                std::vector<T> result = take_values(count);
+                satisfy_requests(l);
+                return hpx::make_ready_future(std::move(result));
+            }
+
+            batch_requests_.push_back(batch_request());
+            batch_requests_.back().count_ = count;
+            return batch_requests_.back().promise_.get_future();
+        }
+        HPX_DEFINE_COMPONENT_DIRECT_ACTION(flow_channel, get_batch);
+
+        // Close the channel, returns the number of values which have not
+        // been retrieved yet.
+        std::size_t close()
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+
+            if (closed_)
+            {
+                l.unlock();
+                HPX_THROW_EXCEPTION(invalid_status,
+                    "hpx::lcos::server::flow_channel::close",
+                    "attempting to close an already closed channel");
+            }
+
+            closed_ = true;
+            std::size_t count = values_.size();
+            satisfy_requests(l);
+            return count;
+        }
+        HPX_DEFINE_COMPONENT_ACTION(flow_channel, close);
+
+    private:
+        std::size_t grant_credits(std::size_t count)
+        {
+            std::size_t granted = (std::min)(count, credits_);
+            credits_ -= granted;
+            return granted;
+        }
+
+        std::vector<T> take_values(std::size_t count)
+        {
+            std::size_t taken = (std::min)(count, values_.size());
+
+            std::vector<T> result;
+            result.reserve(taken);
+            for (std::size_t i = 0; i != taken; ++i)
+            {
+                result.push_back(std::move(values_.front()));
+                values_.pop_front();
+            }
+
+            credits_ += taken;
+            return result;
+        }
+
+        // serve waiting consumers and producers, the promises are set after
+        // releasing the lock
+        void satisfy_requests(std::unique_lock<mutex_type>& l)
+        {
+            std::vector<std::pair<
+                    lcos::local::promise<std::vector<T> >, std::vector<T> >
+                > batches;
+            while (!batch_requests_.empty() && (!values_.empty() || closed_))
+            {
+                batch_request& r = batch_requests_.front();
+                batches.push_back(std::make_pair(std::move(r.promise_),
+                    take_values(r.count_)));
+                batch_requests_.pop_front();
+            }
+
+            std::vector<std::pair<
+                    lcos::local::promise<std::size_t>, std::size_t>
+                > credits;
+            while (!credit_requests_.empty() && (credits_ != 0 || closed_))
+            {
+                credit_request& r = credit_requests_.front();
+                credits.push_back(std::make_pair(std::move(r.promise_),
+                    closed_ ? std::size_t(0) : grant_credits(r.count_)));
+                credit_requests_.pop_front();
+            }
+
+            l.unlock();
+
+            for (auto& b : batches)
+                b.first.set_value(std::move(b.second));
+
+            for (auto& c : credits)
+                c.first.set_value(c.second);
+        }
+
+    private:
+        mutex_type mtx_;
+        std::deque<T> values_;
+        std::size_t credits_;
+        bool closed_;
+
+        std::deque<credit_request> credit_requests_;
+        std::deque<batch_request> batch_requests_;
+    };
+}}}
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_REGISTER_FLOW_CHANNEL_DECLARATION(...)                            \
+    HPX_REGISTER_FLOW_CHANNEL_DECLARATION_(__VA_ARGS__)                       \
+/**/
+#define HPX_REGISTER_FLOW_CHANNEL_DECLARATION_(...)                           \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_FLOW_CHANNEL_DECLARATION_, HPX_PP_NARGS(__VA_ARGS__)     \
+    )(__VA_ARGS__))                                                           \
+/**/
+
+#define HPX_REGISTER_FLOW_CHANNEL_DECLARATION_1(type)                         \
+    HPX_REGISTER_FLOW_CHANNEL_DECLARATION_2(type, type)                       \
+/**/
+#define HPX_REGISTER_FLOW_CHANNEL_DECLARATION_2(type, name)                   \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::server::flow_channel< type>::acquire_credits_action,       \
+        HPX_PP_CAT(__flow_channel_acquire_credits_action_, name));            \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::server::flow_channel< type>::release_credits_action,       \
+        HPX_PP_CAT(__flow_channel_release_credits_action_, name));            \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::server::flow_channel< type>::push_action,                  \
+        HPX_PP_CAT(__flow_channel_push_action_, name));                       \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::server::flow_channel< type>::get_batch_action,             \
+        HPX_PP_CAT(__flow_channel_get_batch_action_, name));                  \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::server::flow_channel< type>::close_action,                 \
+        HPX_PP_CAT(__flow_channel_close_action_, name))                       \
+/**/
+
+#define HPX_REGISTER_FLOW_CHANNEL(...)                                        \
+    HPX_REGISTER_FLOW_CHANNEL_(__VA_ARGS__)                                   \
+/**/
+#define HPX_REGISTER_FLOW_CHANNEL_(...)                                       \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_FLOW_CHANNEL_, HPX_PP_NARGS(__VA_ARGS__)                 \
+    )(__VA_ARGS__))                                                           \
+/**/
+
+#define HPX_REGISTER_FLOW_CHANNEL_1(type)                                     \
+    HPX_REGISTER_FLOW_CHANNEL_2(type, type)                                   \
+/**/
+#define HPX_REGISTER_FLOW_CHANNEL_2(type, name)                               \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::server::flow_channel< type>::acquire_credits_action,       \
+        HPX_PP_CAT(__flow_channel_acquire_credits_action_, name));            \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::server::flow_channel< type>::release_credits_action,       \
+        HPX_PP_CAT(__flow_channel_release_credits_action_, name));            \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::server::flow_channel< type>::push_action,                  \
+        HPX_PP_CAT(__flow_channel_push_action_, name));                       \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::server::flow_channel< type>::get_batch_action,             \
+        HPX_PP_CAT(__flow_channel_get_batch_action_, name));                  \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::server::flow_channel< type>::close_action,                 \
+        HPX_PP_CAT(__flow_channel_close_action_, name));                      \
+    typedef ::hpx::components::simple_component<                              \
+        ::hpx::lcos::server::flow_channel< type>                              \
+    > HPX_PP_CAT(__flow_channel_component_, name);                            \
+    HPX_REGISTER_COMPONENT(HPX_PP_CAT(__flow_channel_component_, name))       \
+/**/
+
+#endif
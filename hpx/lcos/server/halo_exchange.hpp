@@ -0,0 +1,373 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_SERVER_HALO_EXCHANGE_HPP)
+#define HPX_LCOS_SERVER_HALO_EXCHANGE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/actions/component_action.hpp>
+#include <hpx/runtime/components/server/simple_component_base.hpp>
+#include <hpx/runtime/serialization/serialize_buffer.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/detail/pp/cat.hpp>
+#include <hpx/util/detail/pp/expand.hpp>
+#include <hpx/util/detail/pp/nargs.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Describes one of the neighbors a site exchanges halos with.
+    struct halo_neighbor
+    {
+        halo_neighbor()
+          : site_(std::size_t(-1)), peer_(0), size_(0)
+        {}
+
+        halo_neighbor(std::size_t site, std::size_t peer, std::size_t size)
+          : site_(site), peer_(peer), size_(size)
+        {}
+
+        // returns false for placeholders of missing neighbors (for instance
+        // at the boundaries of a non-periodic domain)
+        bool valid() const
+        {
+            return site_ != std::size_t(-1);
+        }
+
+        std::size_t site_;  // the site of the neighbor
+        std::size_t peer_;  // the index of this site in the neighbors of site_
+        std::size_t size_;  // the number of elements sent in each direction
+
+        template <typename Archive>
+        void serialize(Archive& ar, unsigned)
+        {
+            ar & site_ & peer_ & size_;
+        }
+    };
+}}
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace lcos { namespace server
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The receiving side of a halo exchange. The halos are put into buffers
+    // which are allocated once, there is one buffer for each neighbor and
+    // each of the 'depth' generations which may be in flight at once.
+    template <typename T>
+    class halo_exchange
+      : public components::simple_component_base<halo_exchange<T> >
+    {
+        typedef lcos::local::spinlock mutex_type;
+        typedef serialization::serialize_buffer<T> buffer_type;
+
+        struct receive_slot
+        {
+            receive_slot()
+              : generation_(0), ready_(false)
+            {}
+
+            std::vector<T> data_;
+            std::size_t generation_;
+            bool ready_;
+        };
+
+        // the number of halos which have arrived for one generation
+        struct generation_slot
+        {
+            generation_slot()
+              : generation_(0), arrived_(0), waiting_(false)
+            {}
+
+            std::size_t generation_;
+            std::size_t arrived_;
+            bool waiting_;
+            lcos::local::promise<void> promise_;
+        };
+
+        // halos which arrived before the previous generation using the same
+        // buffer was released
+        struct pending_halo
+        {
+            std::size_t neighbor_;
+            std::size_t generation_;
+            buffer_type data_;
+        };
+
+    public:
+        halo_exchange()
+          : depth_(0), expected_(0)
+        {
+            HPX_ASSERT(false);  // shouldn't ever be called
+        }
+
+        halo_exchange(std::vector<halo_neighbor> const& neighbors,
+                std::size_t depth)
+          : neighbors_(neighbors),
+            depth_(depth),
+            expected_(0),
+            slots_(neighbors.size() * depth),
+            generations_(depth)
+        {
+            if (depth == 0)
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "hpx::lcos::server::halo_exchange::halo_exchange",
+                    "the depth of a halo exchange must be larger than zero");
+            }
+
+            for (std::size_t n = 0; n != neighbors_.size(); ++n)
+            {
+                if (!neighbors_[n].valid())
+                    continue;
+
+                ++expected_;
+                for (std::size_t i = 0; i != depth_; ++i)
+                    slot(n, i).data_.resize(neighbors_[n].size_);
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Store the halo sent by the given neighbor for the given generation.
+        void put(std::size_t from_site, std::size_t from_index,
+            std::size_t generation, buffer_type data)
+        {
+            put_local(from_site, from_index, generation, data.data(),
+                data.size(), &data);
+        }
+        HPX_DEFINE_COMPONENT_ACTION(halo_exchange, put);
+
+        // Same as put, used by neighbors on the same locality. The data is
+        // copied before this function returns.
+        void put_local(std::size_t from_site, std::size_t from_index,
+            std::size_t generation, T const* data, std::size_t size,
+            buffer_type* buffer = nullptr)
+        {
+            std::size_t n = find_neighbor(from_site, from_index);
+            if (size != neighbors_[n].size_)
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "hpx::lcos::server::halo_exchange::put",
+                    "the size of the halo does not match the size of the "
+                    "receive buffer");
+            }
+
+            std::unique_lock<mutex_type> l(mtx_);
+
+            receive_slot& s = slot(n, generation % depth_);
+            if (s.ready_)
+            {
+                // the buffer is still in use by an earlier generation, keep
+                // the data until it is released
+                pending_halo p = { n, generation,
+                    buffer != nullptr ? *buffer :
+                        buffer_type(data, size, buffer_type::copy)
+                };
+                pending_.push_back(std::move(p));
+                return;
+            }
+
+            std::copy(data, data + size, s.data_.begin());
+            s.generation_ = generation;
+            s.ready_ = true;
+
+            arrived(generation, l);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Return a future which becomes ready once the halos of all neighbors
+        // have arrived for the given generation.
+        hpx::future<void> get_future(std::size_t generation)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+
+            generation_slot& g = generations_[generation % depth_];
+            if (g.arrived_ == expected_ &&
+                (expected_ == 0 || g.generation_ == generation))
+            {
+                return hpx::make_ready_future();
+            }
+
+            HPX_ASSERT(g.arrived_ == 0 || g.generation_ == generation);
+            if (!g.waiting_)
+            {
+                g.waiting_ = true;
+                g.promise_ = lcos::local::promise<void>();
+            }
+            return g.promise_.get_future();
+        }
+
+        // Return the halo received from the given neighbor, the halos of the
+        // generation must have arrived.
+        T const* get_data(std::size_t n, std::size_t generation) const
+        {
+            HPX_ASSERT(n < neighbors_.size());
+            if (!neighbors_[n].valid())
+                return nullptr;
+
+            receive_slot const& s = slot(n, generation % depth_);
+            HPX_ASSERT(s.ready_ && s.generation_ == generation);
+            return s.data_.data();
+        }
+
+        // Make the buffers used by the given generation available for the
+        // generation 'depth' steps later.
+        void release(std::size_t generation)
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+
+            std::size_t index = generation % depth_;
+            for (std::size_t n = 0; n != neighbors_.size(); ++n)
+                slot(n, index).ready_ = false;
+
+            generation_slot& g = generations_[index];
+            g.generation_ = generation + depth_;
+            g.arrived_ = 0;
+            g.waiting_ = false;
+
+            // move the halos which arrived early into the released buffers
+            auto it = pending_.begin();
+            while (it != pending_.end())
+            {
+                receive_slot& s = slot(it->neighbor_, it->generation_ % depth_);
+                if (s.ready_)
+                {
+                    ++it;
+                    continue;
+                }
+
+                std::copy(it->data_.data(), it->data_.data() + it->data_.size(),
+                    s.data_.begin());
+                s.generation_ = it->generation_;
+                s.ready_ = true;
+
+                std::size_t next = it->generation_;
+                it = pending_.erase(it);
+
+                // the promise is set after releasing the lock, which
+                // requires to restart the iteration
+                if (arrived(next, l))
+                {
+                    l.lock();
+                    it = pending_.begin();
+                }
+            }
+        }
+
+        std::vector<halo_neighbor> const& get_neighbors() const
+        {
+            return neighbors_;
+        }
+
+        std::size_t get_depth() const
+        {
+            return depth_;
+        }
+
+    private:
+        receive_slot& slot(std::size_t n, std::size_t index)
+        {
+            return slots_[n * depth_ + index];
+        }
+        receive_slot const& slot(std::size_t n, std::size_t index) const
+        {
+            return slots_[n * depth_ + index];
+        }
+
+        std::size_t find_neighbor(std::size_t site, std::size_t index) const
+        {
+            for (std::size_t n = 0; n != neighbors_.size(); ++n)
+            {
+                if (neighbors_[n].site_ == site && neighbors_[n].peer_ == index)
+                    return n;
+            }
+
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "hpx::lcos::server::halo_exchange::find_neighbor",
+                "the halo was sent by a site which is not a neighbor");
+            return std::size_t(-1);
+        }
+
+        // Count the arrival of a halo, notifies a waiting consumer once all
+        // halos of the generation have arrived. Returns true if the lock was
+        // released.
+        bool arrived(std::size_t generation, std::unique_lock<mutex_type>& l)
+        {
+            generation_slot& g = generations_[generation % depth_];
+            g.generation_ = generation;
+            if (++g.arrived_ != expected_ || !g.waiting_)
+                return false;
+
+            g.waiting_ = false;
+            lcos::local::promise<void> p(std::move(g.promise_));
+
+            l.unlock();
+            p.set_value();
+            return true;
+        }
+
+    private:
+        mutex_type mtx_;
+        std::vector<halo_neighbor> neighbors_;
+        std::size_t depth_;
+        std::size_t expected_;      // the number of valid neighbors
+
+        std::vector<receive_slot> slots_;
+        std::vector<generation_slot> generations_;
+        std::vector<pending_halo> pending_;
+    };
+}}}
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_REGISTER_HALO_EXCHANGE_DECLARATION(...)                           \
+    HPX_REGISTER_HALO_EXCHANGE_DECLARATION_(__VA_ARGS__)                      \
+/**/
+#define HPX_REGISTER_HALO_EXCHANGE_DECLARATION_(...)                          \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_HALO_EXCHANGE_DECLARATION_, HPX_PP_NARGS(__VA_ARGS__)    \
+    )(__VA_ARGS__))                                                           \
+/**/
+
+#define HPX_REGISTER_HALO_EXCHANGE_DECLARATION_1(type)                        \
+    HPX_REGISTER_HALO_EXCHANGE_DECLARATION_2(type, type)                      \
+/**/
+#define HPX_REGISTER_HALO_EXCHANGE_DECLARATION_2(type, name)                  \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::server::halo_exchange< type>::put_action,                  \
+        HPX_PP_CAT(__halo_exchange_put_action_, name))                        \
+/**/
+
+#define HPX_REGISTER_HALO_EXCHANGE(...)                                       \
+    HPX_REGISTER_HALO_EXCHANGE_(__VA_ARGS__)                                  \
+/**/
+#define HPX_REGISTER_HALO_EXCHANGE_(...)                                      \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_HALO_EXCHANGE_, HPX_PP_NARGS(__VA_ARGS__)                \
+    )(__VA_ARGS__))                                                           \
+/**/
+
+#define HPX_REGISTER_HALO_EXCHANGE_1(type)                                    \
+    HPX_REGISTER_HALO_EXCHANGE_2(type, type)                                  \
+/**/
+#define HPX_REGISTER_HALO_EXCHANGE_2(type, name)                              \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::server::halo_exchange< type>::put_action,                  \
+        HPX_PP_CAT(__halo_exchange_put_action_, name));                       \
+    typedef ::hpx::components::simple_component<                              \
+        ::hpx::lcos::server::halo_exchange< type>                             \
+    > HPX_PP_CAT(__halo_exchange_component_, name);                           \
+    HPX_REGISTER_COMPONENT(HPX_PP_CAT(__halo_exchange_component_, name))      \
+/**/
+
+#endif
@@ -81,7 +81,9 @@ namespace hpx
 
 #include <boost/intrusive_ptr.hpp>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <exception>
 #include <type_traits>
@@ -138,6 +140,184 @@ namespace hpx { namespace lcos
             }
         };
 
+        ///////////////////////////////////////////////////////////////////////
+        // The shared state of one of the futures created by splitting a
+        // (unique) future. It refers to its element inside of the result of
+        // the split future instead of holding a copy of it, the element is
+        // moved out of there only when the future is retrieved. A single
+        // continuation attached to the split future makes all of the element
+        // futures ready.
+        template <typename T>
+        class split_element : public future_data<T>
+        {
+            typedef future_data<T> base_type;
+
+        public:
+            typedef typename base_type::result_type result_type;
+
+            explicit split_element(
+                boost::intrusive_ptr<future_data_refcnt_base> parent)
+              : parent_(std::move(parent)), element_(nullptr)
+            {}
+
+            ~split_element() noexcept override
+            {
+                // the value lives in the result of the split future, make
+                // sure the base class does not destroy it
+                if (this->state_.load(std::memory_order_relaxed) ==
+                    base_type::value)
+                {
+                    this->state_.store(
+                        base_type::empty, std::memory_order_relaxed);
+                }
+            }
+
+            result_type* get_result(error_code& ec = throws) override
+            {
+                if (this->get_result_void(ec) == nullptr)
+                    return nullptr;
+                return element_;
+            }
+
+            void set_element(result_type* element)
+            {
+                element_ = element;
+                if (!this->make_ready(base_type::value))
+                {
+                    HPX_THROW_EXCEPTION(promise_already_satisfied,
+                        "split_element::set_element",
+                        "data has already been set for this future");
+                }
+            }
+
+        private:
+            // keeps the result holding the element alive
+            boost::intrusive_ptr<future_data_refcnt_base> parent_;
+            result_type* element_;
+        };
+
+        // references are not stored in place, those are extracted by a
+        // continuation for each element
+        template <typename ... Ts>
+        struct can_split_in_place
+          : hpx::util::detail::all_of<
+                std::integral_constant<bool, !std::is_reference<Ts>::value>...
+            >
+        {};
+
+        template <typename T>
+        HPX_FORCEINLINE hpx::future<T> make_split_element_future(
+            boost::intrusive_ptr<split_element<T> > const& p)
+        {
+            typename hpx::traits::detail::shared_state_ptr<T>::type state(p);
+            return hpx::traits::future_access<hpx::future<T> >::create(
+                std::move(state));
+        }
+
+        template <typename Result, typename ... Ts, std::size_t ... Is>
+        void on_split_ready(
+            typename traits::detail::shared_state_ptr<Result>::type const&
+                state,
+            hpx::util::tuple<boost::intrusive_ptr<split_element<Ts> >...>&
+                elements,
+            hpx::util::detail::pack_c<std::size_t, Is...>)
+        {
+            if (state->has_value())
+            {
+                Result* result = state->get_result();
+                int const _sequencer[] = { 0,
+                    (hpx::util::get<Is>(elements)->set_element(
+                        &hpx::util::get<Is>(*result)), 0)...
+                };
+                (void)_sequencer;
+            }
+            else
+            {
+                std::exception_ptr e = state->get_exception_ptr();
+                int const _sequencer[] = { 0,
+                    (hpx::util::get<Is>(elements)->set_exception(e), 0)...
+                };
+                (void)_sequencer;
+            }
+        }
+
+        template <typename Result, typename ... Ts, std::size_t ... Is>
+        hpx::util::tuple<hpx::future<Ts>...>
+        split_in_place(hpx::future<Result>& future,
+            hpx::util::detail::pack<Ts...>,
+            hpx::util::detail::pack_c<std::size_t, Is...> is)
+        {
+            typedef typename traits::detail::shared_state_ptr<Result>::type
+                shared_state_ptr;
+
+            shared_state_ptr state =
+                hpx::traits::detail::get_shared_state(future);
+
+            hpx::util::tuple<boost::intrusive_ptr<split_element<Ts> >...>
+                elements(new split_element<Ts>(state)...);
+
+            hpx::util::tuple<hpx::future<Ts>...> result(
+                make_split_element_future(hpx::util::get<Is>(elements))...);
+
+            state->execute_deferred();
+            state->set_on_completed(
+                [HPX_CAPTURE_MOVE(elements), state, is]() mutable -> void
+                {
+                    on_split_ready<Result>(state, elements, is);
+                });
+
+            return result;
+        }
+
+        // Split a future holding a sequence of values of the same type, all
+        // elements which are not part of the sequence hold an exception.
+        template <typename T, typename Result>
+        void split_range_in_place(hpx::future<Result>& future,
+            hpx::future<T>* first, std::size_t size)
+        {
+            typedef typename traits::detail::shared_state_ptr<Result>::type
+                shared_state_ptr;
+
+            shared_state_ptr state =
+                hpx::traits::detail::get_shared_state(future);
+
+            std::vector<boost::intrusive_ptr<split_element<T> > > elements;
+            elements.reserve(size);
+            for (std::size_t i = 0; i != size; ++i)
+            {
+                elements.emplace_back(new split_element<T>(state));
+                first[i] = make_split_element_future(elements.back());
+            }
+
+            state->execute_deferred();
+            state->set_on_completed(
+                [HPX_CAPTURE_MOVE(elements), state]() -> void
+                {
+                    std::exception_ptr e;
+                    std::size_t count = 0;
+                    if (state->has_value())
+                    {
+                        Result* result = state->get_result();
+                        count = (std::min)(result->size(), elements.size());
+                        for (std::size_t i = 0; i != count; ++i)
+                            elements[i]->set_element(&(*result)[i]);
+
+                        if (count != elements.size())
+                        {
+                            e = HPX_GET_EXCEPTION(length_error,
+                                "split_future", "index out of bounds");
+                        }
+                    }
+                    else
+                    {
+                        e = state->get_exception_ptr();
+                    }
+
+                    for (std::size_t i = count; i != elements.size(); ++i)
+                        elements[i]->set_exception(e);
+                });
+        }
+
         ///////////////////////////////////////////////////////////////////////
         template <typename Result, typename Tuple, std::size_t I, typename Future>
         inline typename hpx::traits::detail::shared_state_ptr<
@@ -190,11 +370,30 @@ namespace hpx { namespace lcos
         HPX_FORCEINLINE
         hpx::util::tuple<hpx::future<Ts>...>
         split_future_helper(hpx::future<hpx::util::tuple<Ts...> > && f,
-            hpx::util::detail::pack_c<std::size_t, Is...>)
+            hpx::util::detail::pack_c<std::size_t, Is...>, std::false_type)
         {
             return hpx::util::make_tuple(extract_nth_future<Is>(f)...);
         }
 
+        template <typename ... Ts, std::size_t ... Is>
+        HPX_FORCEINLINE
+        hpx::util::tuple<hpx::future<Ts>...>
+        split_future_helper(hpx::future<hpx::util::tuple<Ts...> > && f,
+            hpx::util::detail::pack_c<std::size_t, Is...> is, std::true_type)
+        {
+            return split_in_place(f, hpx::util::detail::pack<Ts...>(), is);
+        }
+
+        template <typename ... Ts, std::size_t ... Is>
+        HPX_FORCEINLINE
+        hpx::util::tuple<hpx::future<Ts>...>
+        split_future_helper(hpx::future<hpx::util::tuple<Ts...> > && f,
+            hpx::util::detail::pack_c<std::size_t, Is...> is)
+        {
+            return split_future_helper(std::move(f), is,
+                can_split_in_place<Ts...>());
+        }
+
         template <typename ... Ts, std::size_t ... Is>
         HPX_FORCEINLINE
         hpx::util::tuple<hpx::future<Ts>...>
@@ -208,12 +407,35 @@ namespace hpx { namespace lcos
         template <typename T1, typename T2>
         HPX_FORCEINLINE
         std::pair<hpx::future<T1>, hpx::future<T2> >
-        split_future_helper(hpx::future<std::pair<T1, T2> > && f)
+        split_future_helper(hpx::future<std::pair<T1, T2> > && f,
+            std::false_type)
         {
             return std::make_pair(extract_nth_future<0>(f),
                 extract_nth_future<1>(f));
         }
 
+        template <typename T1, typename T2>
+        HPX_FORCEINLINE
+        std::pair<hpx::future<T1>, hpx::future<T2> >
+        split_future_helper(hpx::future<std::pair<T1, T2> > && f,
+            std::true_type)
+        {
+            hpx::util::tuple<hpx::future<T1>, hpx::future<T2> > result =
+                split_in_place(f, hpx::util::detail::pack<T1, T2>(),
+                    hpx::util::detail::pack_c<std::size_t, 0, 1>());
+            return std::make_pair(std::move(hpx::util::get<0>(result)),
+                std::move(hpx::util::get<1>(result)));
+        }
+
+        template <typename T1, typename T2>
+        HPX_FORCEINLINE
+        std::pair<hpx::future<T1>, hpx::future<T2> >
+        split_future_helper(hpx::future<std::pair<T1, T2> > && f)
+        {
+            return split_future_helper(std::move(f),
+                can_split_in_place<T1, T2>());
+        }
+
         template <typename T1, typename T2>
         HPX_FORCEINLINE
         std::pair<hpx::future<T1>, hpx::future<T2> >
@@ -287,6 +509,15 @@ namespace hpx { namespace lcos
             return hpx::traits::future_access<hpx::future<T> >::create(p);
         }
 
+        template <std::size_t N, typename T>
+        inline std::array<hpx::future<T>, N>
+        split_future_helper_array(hpx::future<std::array<T, N> > && f)
+        {
+            std::array<hpx::future<T>, N> result;
+            split_range_in_place(f, result.data(), N);
+            return result;
+        }
+
         template <std::size_t N, typename T, typename Future>
         inline std::array<hpx::future<T>, N>
         split_future_helper_array(Future && f)
@@ -299,6 +530,16 @@ namespace hpx { namespace lcos
             return result;
         }
 
+        template <typename T>
+        inline std::vector<hpx::future<T> >
+        split_future_helper_vector(hpx::future<std::vector<T> > && f,
+            std::size_t size)
+        {
+            std::vector<hpx::future<T> > result(size);
+            split_range_in_place(f, result.data(), size);
+            return result;
+        }
+
         template <typename T, typename Future>
         inline std::vector<hpx::future<T> >
         split_future_helper_vector(Future && f, std::size_t size)
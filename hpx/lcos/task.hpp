@@ -0,0 +1,370 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_TASK_HPP)
+#define HPX_LCOS_TASK_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_CXX20_COROUTINES)
+
+#include <hpx/lcos/detail/thread_local_pool.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/traits/future_access.hpp>
+#include <hpx/traits/future_traits.hpp>
+#include <hpx/traits/is_future.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace lcos
+{
+    template <typename T = void>
+    class task;
+
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Awaiting a (shared) future resumes the awaiting coroutine directly
+        // from the completion of the future's shared state, no continuation
+        // (and no shared state for it) is created. Awaited lvalues are held by
+        // reference.
+        template <typename Future>
+        struct future_awaiter
+        {
+            typedef typename traits::future_traits<Future>::type result_type;
+
+            bool await_ready() const
+            {
+                return f_.is_ready();
+            }
+
+            void await_suspend(std::coroutine_handle<> h)
+            {
+                auto const& state = traits::detail::get_shared_state(f_);
+                state->set_on_completed([h]() { h.resume(); });
+            }
+
+            result_type await_resume()
+            {
+                return f_.get();
+            }
+
+            Future f_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        struct task_promise_base
+        {
+            static void* operator new(std::size_t size)
+            {
+                return thread_local_pool::allocate(size);
+            }
+
+            static void operator delete(void* p, std::size_t size) noexcept
+            {
+                thread_local_pool::deallocate(p, size);
+            }
+
+            // tasks are started once they are awaited
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            // once finished, transfer control directly to the awaiting
+            // coroutine (symmetric transfer)
+            struct final_awaiter
+            {
+                bool await_ready() noexcept
+                {
+                    return false;
+                }
+
+                template <typename Promise>
+                std::coroutine_handle<> await_suspend(
+                    std::coroutine_handle<Promise> h) noexcept
+                {
+                    return h.promise().continuation_;
+                }
+
+                void await_resume() noexcept {}
+            };
+
+            final_awaiter final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void unhandled_exception() noexcept
+            {
+                exception_ = std::current_exception();
+            }
+
+            template <typename Future>
+            typename std::enable_if<
+                traits::is_future<typename std::decay<Future>::type>::value,
+                future_awaiter<Future>
+            >::type await_transform(Future && f)
+            {
+                return {std::forward<Future>(f)};
+            }
+
+            template <typename Awaitable>
+            typename std::enable_if<
+                !traits::is_future<typename std::decay<Awaitable>::type>::value,
+                Awaitable&&
+            >::type await_transform(Awaitable && a) noexcept
+            {
+                return std::forward<Awaitable>(a);
+            }
+
+            void rethrow_if_exception()
+            {
+                if (exception_)
+                    std::rethrow_exception(exception_);
+            }
+
+            std::coroutine_handle<> continuation_ = std::noop_coroutine();
+            std::exception_ptr exception_;
+        };
+
+        template <typename T>
+        struct task_promise : task_promise_base
+        {
+            task<T> get_return_object() noexcept;
+
+            template <typename U>
+            void return_value(U && value)
+            {
+                value_.emplace(std::forward<U>(value));
+            }
+
+            T get_result()
+            {
+                rethrow_if_exception();
+                HPX_ASSERT(value_.has_value());
+                return std::move(*value_);
+            }
+
+            std::optional<T> value_;
+        };
+
+        template <>
+        struct task_promise<void> : task_promise_base
+        {
+            task<void> get_return_object() noexcept;
+
+            void return_void() noexcept {}
+
+            void get_result()
+            {
+                rethrow_if_exception();
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Coroutine running a task to completion without being awaited by
+        // another coroutine, destroys itself once done.
+        struct detached_task
+        {
+            struct promise_type
+            {
+                static void* operator new(std::size_t size)
+                {
+                    return thread_local_pool::allocate(size);
+                }
+
+                static void operator delete(void* p, std::size_t size) noexcept
+                {
+                    thread_local_pool::deallocate(p, size);
+                }
+
+                detached_task get_return_object() noexcept
+                {
+                    return {};
+                }
+
+                std::suspend_never initial_suspend() noexcept
+                {
+                    return {};
+                }
+
+                std::suspend_never final_suspend() noexcept
+                {
+                    return {};
+                }
+
+                void return_void() noexcept {}
+
+                void unhandled_exception() noexcept
+                {
+                    std::terminate();
+                }
+            };
+        };
+
+        template <typename T>
+        detached_task run_task(task<T> t, local::promise<T> p)
+        {
+            try
+            {
+                if constexpr (std::is_void<T>::value)
+                {
+                    co_await std::move(t);
+                    p.set_value();
+                }
+                else
+                {
+                    p.set_value(co_await std::move(t));
+                }
+            }
+            catch (...)
+            {
+                p.set_exception(std::current_exception());
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A lazily started coroutine producing a value of type \a T. A task is
+    /// started once it is awaited, the awaiting coroutine is resumed directly
+    /// once the task has finished. Frames of tasks are allocated from a pool
+    /// kept for each worker thread. Inside of a task, awaiting an
+    /// \a hpx::future or \a hpx::shared_future suspends the task until the
+    /// future becomes ready, the task is then resumed on the thread which
+    /// made the future ready.
+    template <typename T>
+    class task
+    {
+        static_assert(!std::is_reference<T>::value,
+            "hpx::task does not support reference types");
+
+    public:
+        typedef detail::task_promise<T> promise_type;
+
+    private:
+        typedef std::coroutine_handle<promise_type> handle_type;
+
+        friend struct detail::task_promise<T>;
+
+        explicit task(handle_type coro) noexcept
+          : coro_(coro)
+        {}
+
+        struct awaiter
+        {
+            bool await_ready() const noexcept
+            {
+                return coro_.done();
+            }
+
+            // start the awaited task right away (symmetric transfer)
+            std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<> awaiting) noexcept
+            {
+                coro_.promise().continuation_ = awaiting;
+                return coro_;
+            }
+
+            T await_resume()
+            {
+                return coro_.promise().get_result();
+            }
+
+            handle_type coro_;
+        };
+
+    public:
+        task(task && rhs) noexcept
+          : coro_(rhs.coro_)
+        {
+            rhs.coro_ = nullptr;
+        }
+
+        task& operator=(task && rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                if (coro_)
+                    coro_.destroy();
+                coro_ = rhs.coro_;
+                rhs.coro_ = nullptr;
+            }
+            return *this;
+        }
+
+        task(task const&) = delete;
+        task& operator=(task const&) = delete;
+
+        ~task()
+        {
+            if (coro_)
+                coro_.destroy();
+        }
+
+        bool valid() const noexcept
+        {
+            return bool(coro_);
+        }
+
+        awaiter operator co_await() const& noexcept
+        {
+            HPX_ASSERT(coro_);
+            return awaiter{coro_};
+        }
+
+        awaiter operator co_await() const&& noexcept
+        {
+            HPX_ASSERT(coro_);
+            return awaiter{coro_};
+        }
+
+        /// Start executing this task on the calling thread, the returned
+        /// future becomes ready once the task has finished.
+        hpx::future<T> get_future() &&
+        {
+            HPX_ASSERT(coro_);
+
+            local::promise<T> p;
+            hpx::future<T> f = p.get_future();
+            detail::run_task(std::move(*this), std::move(p));
+            return f;
+        }
+
+    private:
+        handle_type coro_;
+    };
+
+    namespace detail
+    {
+        template <typename T>
+        task<T> task_promise<T>::get_return_object() noexcept
+        {
+            return task<T>(
+                std::coroutine_handle<task_promise>::from_promise(*this));
+        }
+
+        inline task<void> task_promise<void>::get_return_object() noexcept
+        {
+            return task<void>(
+                std::coroutine_handle<task_promise>::from_promise(*this));
+        }
+    }
+}}
+
+namespace hpx
+{
+    using lcos::task;
+}
+
+#endif
+#endif
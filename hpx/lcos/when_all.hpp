@@ -144,8 +144,8 @@ namespace hpx
 #include <hpx/traits/future_access.hpp>
 #include <hpx/traits/is_future.hpp>
 #include <hpx/traits/is_future_range.hpp>
-#include <hpx/util/internal_allocator.hpp>
 #include <hpx/util/pack_traversal_async.hpp>
+#include <hpx/util/tagged_allocator.hpp>
 #include <hpx/util/tuple.hpp>
 
 #include <cstddef>
@@ -217,6 +217,16 @@ namespace hpx { namespace lcos
                     std::forward<T>(current), std::forward<N>(next));
             }
 
+            template <typename T, typename N>
+            auto operator()(
+                util::async_traverse_detach_range_tag, T&& range, N&& next)
+                -> decltype(async_detach_future_range(
+                    std::forward<T>(range), std::forward<N>(next)))
+            {
+                return async_detach_future_range(
+                    std::forward<T>(range), std::forward<N>(next));
+            }
+
             template <typename T>
             void operator()(util::async_traverse_complete_tag, T&& pack)
             {
@@ -242,7 +252,7 @@ namespace hpx { namespace lcos
             typename frame_type::base_type::init_no_addref no_addref;
 
             auto frame = util::traverse_pack_async_allocator(
-                util::internal_allocator<>{},
+                util::future_state_allocator<>{},
                 util::async_traverse_in_place_tag<frame_type>{}, no_addref,
                 func(std::forward<T>(args))...);
 
@@ -32,7 +32,9 @@ namespace hpx
     ///       \a std::size_t is implicitly convertible to as the
     ///       first parameter and the \a future as the second
     ///       parameter. The first parameter will correspond to the
-    ///       index of the current \a future in the collection.
+    ///       index of the current \a future in the collection. The
+    ///       function is called for the futures in the order they become
+    ///       ready, the calls are not concurrent.
     ///
     /// \return   Returns a future representing the event of all input futures
     ///           being ready.
@@ -61,7 +63,9 @@ namespace hpx
     ///       \a std::size_t is implicitly convertible to as the
     ///       first parameter and the \a future as the second
     ///       parameter. The first parameter will correspond to the
-    ///       index of the current \a future in the collection.
+    ///       index of the current \a future in the collection. The
+    ///       function is called for the futures in the order they become
+    ///       ready, the calls are not concurrent.
     ///
     /// \return   Returns a future representing the event of all input futures
     ///           being ready.
@@ -115,7 +119,9 @@ namespace hpx
     ///       \a std::size_t is implicitly convertible to as the
     ///       first parameter and the \a future as the second
     ///       parameter. The first parameter will correspond to the
-    ///       index of the current \a future in the collection.
+    ///       index of the current \a future in the collection. The
+    ///       function is called for the futures in the order they become
+    ///       ready, the calls are not concurrent.
     ///
     /// \return   Returns a future holding the iterator pointing to the first
     ///           element after the last one.
@@ -128,6 +134,7 @@ namespace hpx
 
 #include <hpx/config.hpp>
 #include <hpx/lcos/detail/future_data.hpp>
+#include <hpx/lcos/local/completion_queue.hpp>
 #include <hpx/lcos/when_some.hpp>
 #include <hpx/runtime/launch_policy.hpp>
 #include <hpx/traits/acquire_future.hpp>
@@ -139,6 +146,7 @@ namespace hpx
 #include <hpx/util/bind_back.hpp>
 #include <hpx/util/decay.hpp>
 #include <hpx/util/detail/pack.hpp>
+#include <hpx/util/detail/yield_k.hpp>
 #include <hpx/util/range.hpp>
 #include <hpx/util/tuple.hpp>
 #include <hpx/util/unwrap_ref.hpp>
@@ -146,7 +154,9 @@ namespace hpx
 #include <boost/intrusive_ptr.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <exception>
 #include <iterator>
 #include <type_traits>
 #include <utility>
@@ -366,6 +376,133 @@ namespace hpx { namespace lcos
             std::size_t count_;
             std::size_t needed_count_;
         };
+
+        // Calls the supplied function for the futures of a range in the order
+        // they become ready. Every future which becomes ready is pushed onto
+        // a lock-free list, whoever makes the number of pending entries go
+        // from zero to one drains the list. This serializes the calls to the
+        // function without holding any lock while invoking it.
+        template <typename Future, typename F>
+        struct when_each_range_frame //-V690
+          : lcos::detail::future_data<void>
+        {
+            typedef lcos::future<void> type;
+
+        private:
+            typedef lcos::local::detail::completion_node<Future> node_type;
+
+            // workaround gcc regression wrongly instantiating constructors
+            when_each_range_frame();
+            when_each_range_frame(when_each_range_frame const&);
+
+        public:
+            template <typename F_>
+            when_each_range_frame(F_ && f, std::size_t needed_count)
+              : f_(std::forward<F_>(f))
+              , pending_(1)       // held by the thread registering the futures
+              , count_(0)
+              , needed_count_(needed_count)
+            {}
+
+            void do_await(std::vector<Future>& values)
+            {
+                if (needed_count_ == 0)
+                {
+                    this->set_value(util::unused);
+                    return;
+                }
+
+                for (std::size_t i = 0; i != values.size(); ++i)
+                {
+                    node_type* n = new node_type(i, std::move(values[i]));
+
+                    typename traits::detail::shared_state_ptr_for<
+                            Future
+                        >::type next_future_data =
+                            traits::detail::get_shared_state(n->future_);
+
+                    if (next_future_data.get() != nullptr &&
+                        !next_future_data->is_ready())
+                    {
+                        next_future_data->execute_deferred();
+
+                        // execute_deferred might have made the future ready
+                        if (!next_future_data->is_ready())
+                        {
+                            boost::intrusive_ptr<when_each_range_frame>
+                                this_(this);
+                            next_future_data->set_on_completed(
+                                [HPX_CAPTURE_MOVE(this_), n]() -> void {
+                                    this_->on_ready(n);
+                                });
+                            continue;
+                        }
+                    }
+
+                    on_ready(n);
+                }
+
+                // the futures which became ready meanwhile are left to us
+                if (pending_.fetch_sub(1) != 1)
+                    drain();
+            }
+
+        private:
+            void on_ready(node_type* n)
+            {
+                ready_.push(n);
+                if (pending_.fetch_add(1) == 0)
+                    drain();
+            }
+
+            void drain()
+            {
+                do {
+                    // a future which became ready before the one(s) we were
+                    // notified about might not be linked into the list yet
+                    node_type* n = ready_.pop();
+                    for (std::size_t k = 0; n == nullptr; n = ready_.pop())
+                        util::detail::yield_k(++k, "when_each");
+
+                    invoke(n->index_, std::move(n->future_));
+                    delete n;
+
+                    if (++count_ == needed_count_)
+                    {
+                        if (exception_)
+                            this->set_exception(std::move(exception_));
+                        else
+                            this->set_value(util::unused);
+                        return;
+                    }
+                } while (pending_.fetch_sub(1) != 1);
+            }
+
+            void invoke(std::size_t index, Future && f)
+            {
+                try {
+                    dispatch::call(f_, index, std::move(f),
+                        typename traits::is_invocable<
+                            F, std::size_t, Future
+                        >::type()
+                    );
+                }
+                catch (...) {
+                    // report the first exception once all futures are ready
+                    if (!exception_)
+                        exception_ = std::current_exception();
+                }
+            }
+
+            F f_;
+            lcos::local::detail::completion_list<Future> ready_;
+            std::atomic<std::size_t> pending_;
+
+            // accessed by the thread draining the list only
+            std::size_t count_;
+            std::size_t needed_count_;
+            std::exception_ptr exception_;
+        };
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -376,9 +513,8 @@ namespace hpx { namespace lcos
         static_assert(
             traits::is_future<Future>::value, "invalid use of when_each");
 
-        typedef util::tuple<std::vector<Future> > argument_type;
         typedef typename std::decay<F>::type func_type;
-        typedef detail::when_each_frame<argument_type, func_type> frame_type;
+        typedef detail::when_each_range_frame<Future, func_type> frame_type;
 
         std::vector<Future> lazy_values_;
         lazy_values_.reserve(lazy_values.size());
@@ -387,12 +523,10 @@ namespace hpx { namespace lcos
             std::back_inserter(lazy_values_),
             traits::acquire_future_disp());
 
-        std::size_t lazy_values_size = lazy_values_.size();
         boost::intrusive_ptr<frame_type> p(new frame_type(
-            util::forward_as_tuple(std::move(lazy_values_)),
-            std::forward<F>(func), lazy_values_size));
+            std::forward<F>(func), lazy_values_.size()));
 
-        p->do_await();
+        p->do_await(lazy_values_);
 
         using traits::future_access;
         return future_access<typename frame_type::type>::create(std::move(p));
@@ -25,9 +25,9 @@
 #include <hpx/parallel/traits/projected.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/foreach_partitioner.hpp>
+#include <hpx/parallel/util/lookback_scan_partitioner.hpp>
 #include <hpx/parallel/util/loop.hpp>
 #include <hpx/parallel/util/projection_identity.hpp>
-#include <hpx/parallel/util/scan_partitioner.hpp>
 #include <hpx/parallel/util/transfer.hpp>
 #include <hpx/parallel/util/zip_iterator.hpp>
 #include <hpx/util/unused.hpp>
@@ -41,8 +41,6 @@
 #include <utility>
 #include <vector>
 
-#include <boost/shared_array.hpp>
-
 namespace hpx { namespace parallel { inline namespace v1
 {
     ///////////////////////////////////////////////////////////////////////////
@@ -53,13 +51,23 @@ namespace hpx { namespace parallel { inline namespace v1
 
         struct copy_iteration
         {
+            bool nontemporal_;
+
             template <typename Iter>
             HPX_HOST_DEVICE HPX_FORCEINLINE
             void operator()(Iter part_begin, std::size_t part_size, std::size_t)
             {
                 using hpx::util::get;
                 auto iters = part_begin.get_iterator_tuple();
-                util::copy_n(get<0>(iters), part_size, get<1>(iters));
+                if (nontemporal_)
+                {
+                    util::copy_n_nontemporal(
+                        get<0>(iters), part_size, get<1>(iters));
+                }
+                else
+                {
+                    util::copy_n(get<0>(iters), part_size, get<1>(iters));
+                }
             }
         };
 
@@ -89,12 +97,15 @@ namespace hpx { namespace parallel { inline namespace v1
             {
                 typedef hpx::util::zip_iterator<FwdIter1, FwdIter2> zip_iterator;
 
+                std::size_t count = std::distance(first, last);
+                bool nontemporal =
+                    util::detail::use_nontemporal_stores<FwdIter2>(count);
+
                 return get_iter_pair(
                     util::foreach_partitioner<ExPolicy>::call(
                         std::forward<ExPolicy>(policy),
-                        hpx::util::make_zip_iterator(first, dest),
-                        std::distance(first, last),
-                        copy_iteration(),
+                        hpx::util::make_zip_iterator(first, dest), count,
+                        copy_iteration{nontemporal},
                         [](zip_iterator && last) -> zip_iterator
                         {
                             using hpx::util::get;
@@ -230,13 +241,9 @@ namespace hpx { namespace parallel { inline namespace v1
                     util::foreach_partitioner<ExPolicy>::call(
                         std::forward<ExPolicy>(policy),
                         hpx::util::make_zip_iterator(first, dest), count,
-                        [](zip_iterator part_begin, std::size_t part_size,
-                            std::size_t)
-                        {
-                            using hpx::util::get;
-
-                            auto iters = part_begin.get_iterator_tuple();
-                            util::copy_n(get<0>(iters), part_size, get<1>(iters));
+                        copy_iteration{
+                            util::detail::use_nontemporal_stores<FwdIter2>(
+                                count)
                         },
                         [](zip_iterator && last) -> zip_iterator
                         {
@@ -376,6 +383,14 @@ namespace hpx { namespace parallel { inline namespace v1
             return std::make_pair(first, dest);
         }
 
+        // The number of elements to copy from the tiles processed so far, or
+        // from one tile together with the flags marking them.
+        struct copy_if_tile
+        {
+            std::size_t count_;
+            bool* flags_;
+        };
+
         template <typename IterPair>
         struct copy_if : public detail::algorithm<copy_if<IterPair>, IterPair>
         {
@@ -413,78 +428,87 @@ namespace hpx { namespace parallel { inline namespace v1
 
                 difference_type count = std::distance(first, last);
 
-                boost::shared_array<bool> flags(new bool[count]);
-                std::size_t init = 0;
+                // the elements to copy are flagged in a buffer held only
+                // while the tile is processed
+                typedef util::lookback_tile_buffers<bool> buffers_type;
+                std::shared_ptr<buffers_type> buffers =
+                    std::make_shared<buffers_type>(count);
+
+                copy_if_tile init = { 0, nullptr };
 
                 using hpx::util::get;
                 using hpx::util::make_zip_iterator;
-                typedef util::scan_partitioner<
-                        ExPolicy, std::pair<FwdIter1, FwdIter2>, std::size_t
+                typedef util::lookback_scan_partitioner<
+                        ExPolicy, std::pair<FwdIter1, FwdIter2>, copy_if_tile
                     > scan_partitioner_type;
 
                 auto f1 =
                     [HPX_CAPTURE_FORWARD(pred),
-                        HPX_CAPTURE_FORWARD(proj)
-                    ](zip_iterator part_begin, std::size_t part_size)
-                    ->  std::size_t
+                        HPX_CAPTURE_FORWARD(proj), buffers
+                    ](FwdIter1 part_begin, std::size_t part_size)
+                    ->  copy_if_tile
                     {
-                        std::size_t curr = 0;
+                        copy_if_tile tile = { 0, buffers->acquire() };
 
                         // MSVC complains if proj is captured by ref below
                         util::loop_n<ExPolicy>(
-                            part_begin, part_size,
-                            [&pred, proj, &curr](zip_iterator it) mutable
+                            make_zip_iterator(part_begin, tile.flags_),
+                            part_size,
+                            [&pred, proj, &tile](zip_iterator it) mutable
                             {
                                 bool f = hpx::util::invoke(pred,
                                     hpx::util::invoke(proj, get<0>(*it)));
 
                                 if ((get<1>(*it) = f))
-                                    ++curr;
+                                    ++tile.count_;
                             });
 
-                        return curr;
+                        return tile;
                     };
                 auto f3 =
-                    [dest, flags](
-                        zip_iterator part_begin, std::size_t part_size,
-                        hpx::shared_future<std::size_t> curr,
-                        hpx::shared_future<std::size_t> next
-                    ) mutable
+                    [dest, buffers](FwdIter1 part_begin,
+                        std::size_t part_size, copy_if_tile const& offset,
+                        copy_if_tile const& tile) -> void
                     {
-                        HPX_UNUSED(flags);
-
-                        next.get();     // rethrow exceptions
-
-                        std::advance(dest, curr.get());
+                        FwdIter2 out = dest;
+                        std::advance(out, offset.count_);
                         util::loop_n<ExPolicy>(
-                            part_begin, part_size,
-                            [&dest](zip_iterator it) mutable
+                            make_zip_iterator(part_begin, tile.flags_),
+                            part_size,
+                            [&out](zip_iterator it)
                             {
                                 if (get<1>(*it))
-                                    *dest++ = get<0>(*it);
+                                    *out++ = get<0>(*it);
                             });
+
+                        buffers->release(tile.flags_);
                     };
 
                 return scan_partitioner_type::call(
                     std::forward<ExPolicy>(policy),
-                    make_zip_iterator(first, flags.get()), count, init,
-                    // step 1 performs first part of scan algorithm
+                    first, count, init,
+                    // step 1 flags the elements to copy in each tile
                     std::move(f1),
-                    // step 2 propagates the partition results from left
-                    // to right
-                    hpx::util::unwrapping(std::plus<std::size_t>()),
-                    // step 3 runs final accumulation on each partition
+                    // the number of elements to copy is summed up
+                    [](copy_if_tile const& prev_sum, copy_if_tile const& curr)
+                    ->  copy_if_tile
+                    {
+                        copy_if_tile sum = {
+                            prev_sum.count_ + curr.count_, nullptr };
+                        return sum;
+                    },
+                    // step 2 copies the flagged elements of each tile as
+                    // soon as the number of preceding elements is known
                     std::move(f3),
-                    // step 4 use this return value
-                    [last, dest, flags](
-                        std::vector<hpx::shared_future<std::size_t> > && items,
-                        std::vector<hpx::future<void> > &&) mutable
+                    // step 3 use this return value
+                    [last, dest, buffers](copy_if_tile const& total)
                     ->  std::pair<FwdIter1, FwdIter2>
                     {
-                        HPX_UNUSED(flags);
+                        HPX_UNUSED(buffers);
 
-                        std::advance(dest, items.back().get());
-                        return std::make_pair(last, dest);
+                        FwdIter2 out = dest;
+                        std::advance(out, total.count_);
+                        return std::make_pair(last, out);
                     });
             }
         };
@@ -10,6 +10,7 @@
 #include <hpx/lcos/future.hpp>
 #include <hpx/runtime/serialization/serialization_fwd.hpp>
 #include <hpx/throw_exception.hpp>
+#include <hpx/traits/detail/wrap_int.hpp>
 #include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/decay.hpp>
 
@@ -70,6 +71,20 @@ namespace hpx { namespace parallel { inline namespace v1 { namespace detail
         typedef void type;
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // Executors which run on an accelerator can provide a device side
+    // implementation of some of the algorithms by specializing this template.
+    // The specialization exposes a function
+    //
+    //     static result call(Algorithm const&, ExPolicy&& policy, Args&&...)
+    //
+    // for each algorithm it implements, which receives the same arguments as
+    // Algorithm::parallel. All other algorithms use Algorithm::parallel.
+    template <typename Executor, typename Enable = void>
+    struct device_algorithm
+    {};
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename Derived, typename Result = void>
     struct algorithm
@@ -377,11 +392,39 @@ namespace hpx { namespace parallel { inline namespace v1 { namespace detail
         >::type
         call(ExPolicy && policy, std::false_type, Args&&... args) const
         {
-            return Derived::parallel(std::forward<ExPolicy>(policy),
+            return call_parallel(0, std::forward<ExPolicy>(policy),
                 std::forward<Args>(args)...);
         }
 
     private:
+        template <typename ExPolicy, typename... Args>
+        typename parallel::util::detail::algorithm_result<
+            ExPolicy, local_result_type
+        >::type
+        call_parallel(hpx::traits::detail::wrap_int, ExPolicy && policy,
+            Args&&... args) const
+        {
+            return Derived::parallel(std::forward<ExPolicy>(policy),
+                std::forward<Args>(args)...);
+        }
+
+        // use the device side implementation of the algorithm, if the
+        // executor provides one
+        template <typename ExPolicy, typename... Args>
+        auto call_parallel(int, ExPolicy && policy, Args&&... args) const
+        ->  decltype(device_algorithm<
+                    typename hpx::util::decay<ExPolicy>::type::executor_type
+                >::call(std::declval<Derived const&>(),
+                    std::forward<ExPolicy>(policy),
+                    std::forward<Args>(args)...))
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type::executor_type
+                executor_type;
+
+            return device_algorithm<executor_type>::call(derived(),
+                std::forward<ExPolicy>(policy), std::forward<Args>(args)...);
+        }
+
         char const* const name_;
 
         friend class hpx::serialization::access;
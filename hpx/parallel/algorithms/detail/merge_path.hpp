@@ -0,0 +1,83 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_DETAIL_MERGE_PATH_2019_MAY_14_0915AM)
+#define HPX_PARALLEL_DETAIL_MERGE_PATH_2019_MAY_14_0915AM
+
+#include <hpx/config.hpp>
+#include <hpx/util/invoke.hpp>
+
+#include <hpx/parallel/executors/execution_information.hpp>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace hpx { namespace parallel { inline namespace v1 { namespace detail
+{
+    /// \cond NOINTERNAL
+
+    // Merge path partitioning: the elements of the merge of two sorted
+    // ranges are split at the positions 'diag' of the merged range. Each
+    // split is found by a binary search along the diagonal of the merge
+    // matrix, independently of all other splits.
+    //
+    // Return the number of elements of the first range which are among the
+    // first 'diag' elements of the stable merge of both ranges (the elements
+    // of the first range precede equivalent elements of the second range),
+    // the remaining 'diag' minus that number elements come from the second
+    // range.
+    template <typename RanIter1, typename RanIter2, typename Comp,
+        typename Proj1, typename Proj2>
+    std::size_t merge_path_split(RanIter1 first1, std::size_t size1,
+        RanIter2 first2, std::size_t size2, std::size_t diag,
+        Comp && comp, Proj1 && proj1, Proj2 && proj2)
+    {
+        std::size_t low = diag > size2 ? diag - size2 : 0;
+        std::size_t high = (std::min)(diag, size1);
+
+        while (low < high)
+        {
+            std::size_t mid = low + (high - low) / 2;
+            if (!hpx::util::invoke(comp,
+                    hpx::util::invoke(proj2, first2[diag - mid - 1]),
+                    hpx::util::invoke(proj1, first1[mid])))
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    // Return the position in the merged range of size 'size' where the
+    // given partition out of 'num_parts' begins.
+    inline std::size_t merge_path_diagonal(std::size_t size,
+        std::size_t part, std::size_t num_parts)
+    {
+        return (size / num_parts) * part +
+            (std::min)(part, size % num_parts);
+    }
+
+    // Return the number of partitions a merge of 'size' elements is split
+    // into: one for each core, but none with less than 'min_size' elements.
+    template <typename ExPolicy>
+    std::size_t merge_path_num_partitions(ExPolicy const& policy,
+        std::size_t size, std::size_t min_size)
+    {
+        std::size_t cores = execution::processing_units_count(
+            policy.executor(), policy.parameters());
+
+        std::size_t num_parts = (std::min)(cores, size / (std::max)(
+            min_size, std::size_t(1)));
+        return (std::max)(num_parts, std::size_t(1));
+    }
+
+    /// \endcond
+}}}}
+
+#endif
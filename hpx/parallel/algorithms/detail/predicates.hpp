@@ -381,6 +381,24 @@ namespace hpx { namespace parallel { inline namespace v1 { namespace detail
             return t1 / t2;
         }
     };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Invoke the binary predicate on the elements referenced by the given
+    // iterators (or on the vector-packs the given pointers refer to) and
+    // return whether it is not satisfied.
+    template <typename F>
+    struct invoke_not_indirect
+    {
+        typename std::remove_reference<F>::type& f_;
+
+        template <typename Iter1, typename Iter2>
+        HPX_HOST_DEVICE HPX_FORCEINLINE
+        auto operator()(Iter1 it1, Iter2 it2)
+        ->  decltype(!hpx::util::invoke(f_, *it1, *it2))
+        {
+            return !hpx::util::invoke(f_, *it1, *it2);
+        }
+    };
 }}}}
 
 #endif
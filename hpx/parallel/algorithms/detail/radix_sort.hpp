@@ -0,0 +1,325 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHM_DETAIL_RADIX_SORT_HPP)
+#define HPX_PARALLEL_ALGORITHM_DETAIL_RADIX_SORT_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/result_of.hpp>
+
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/executors/execution_information.hpp>
+#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1 { namespace detail
+{
+    /// \cond NOINTERNAL
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Map keys onto unsigned integers such that the order of the integers
+    // matches the order of the keys.
+    template <typename T, typename Enable = void>
+    struct radix_key
+    {
+        HPX_STATIC_CONSTEXPR bool is_supported = false;
+    };
+
+    template <typename T>
+    struct radix_key<T,
+        typename std::enable_if<
+            std::is_integral<T>::value && !std::is_same<T, bool>::value
+        >::type>
+    {
+        HPX_STATIC_CONSTEXPR bool is_supported = true;
+
+        typedef typename std::make_unsigned<T>::type type;
+
+        HPX_HOST_DEVICE static type call(T value)
+        {
+            type key = static_cast<type>(value);
+            if (std::is_signed<T>::value)
+                key ^= type(1) << (sizeof(type) * CHAR_BIT - 1);
+            return key;
+        }
+    };
+
+    template <typename T, typename Bits>
+    struct radix_key_floating_point
+    {
+        HPX_STATIC_CONSTEXPR bool is_supported = true;
+
+        typedef Bits type;
+
+        HPX_HOST_DEVICE static type call(T value)
+        {
+            type key;
+            std::memcpy(&key, &value, sizeof(type));
+
+            // negative values have to be sorted in reverse order
+            type const sign = type(1) << (sizeof(type) * CHAR_BIT - 1);
+            return (key & sign) ? type(~key) : type(key | sign);
+        }
+    };
+
+    template <>
+    struct radix_key<float>
+      : radix_key_floating_point<float, std::uint32_t>
+    {};
+
+    template <>
+    struct radix_key<double>
+      : radix_key_floating_point<double, std::uint64_t>
+    {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Radix sort replaces the comparison based sort if the elements are
+    // ordered by their (projected) arithmetic value using the default
+    // comparison.
+    template <typename RandomIt, typename Compare, typename Proj>
+    struct use_radix_sort
+    {
+    private:
+        typedef typename std::iterator_traits<RandomIt>::value_type value_type;
+        typedef typename hpx::util::decay<Compare>::type compare_type;
+        typedef typename hpx::util::decay<
+                typename hpx::util::invoke_result<Proj,
+                    typename std::iterator_traits<RandomIt>::reference
+                >::type
+            >::type key_type;
+
+    public:
+        HPX_STATIC_CONSTEXPR bool value =
+            radix_key<key_type>::is_supported &&
+            std::is_default_constructible<value_type>::value &&
+            (std::is_same<compare_type, detail::less>::value ||
+             std::is_same<compare_type, std::less<key_type> >::value);
+
+        typedef std::integral_constant<bool, value> type;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // number of bits sorted by each pass
+    HPX_STATIC_CONSTEXPR std::size_t radix_bits = 8;
+    HPX_STATIC_CONSTEXPR std::size_t radix_buckets =
+        std::size_t(1) << radix_bits;
+
+    // minimal number of elements handled by a single task
+    HPX_STATIC_CONSTEXPR std::size_t radix_sort_min_chunk_size = 65536ul;
+
+    // invoke f for all chunks concurrently
+    template <typename ExPolicy, typename F>
+    void radix_sort_for_each_chunk(ExPolicy& policy, std::size_t num_chunks,
+        F const& f)
+    {
+        std::vector<hpx::future<void> > chunks;
+        chunks.reserve(num_chunks);
+        for (std::size_t c = 0; c != num_chunks; ++c)
+        {
+            chunks.push_back(execution::async_execute(
+                policy.executor(), [&f, c]() { f(c); }));
+        }
+        hpx::wait_all(chunks);
+
+        std::list<std::exception_ptr> errors;
+        util::detail::handle_local_exceptions<ExPolicy>::call(chunks, errors);
+    }
+
+    // extract the digit of the projected key of an element at the given
+    // position
+    template <typename RadixKey, typename Proj>
+    struct radix_digit
+    {
+        radix_digit(Proj& proj, std::size_t shift)
+          : proj_(proj), shift_(shift)
+        {}
+
+        template <typename T>
+        std::size_t operator()(T && value) const
+        {
+            typename RadixKey::type key = RadixKey::call(
+                hpx::util::invoke(proj_, std::forward<T>(value)));
+            return std::size_t(key >> shift_) & (radix_buckets - 1);
+        }
+
+        Proj& proj_;
+        std::size_t shift_;
+    };
+
+    // Stable LSD radix sort, each pass distributes the elements by one digit
+    // of their keys. Every chunk of the input counts its digits, the
+    // per-chunk counts are turned into the positions the chunks are
+    // scattering their elements to.
+    template <typename ExPolicy, typename RandomIt, typename Proj>
+    RandomIt parallel_radix_sort(ExPolicy policy, RandomIt first,
+        RandomIt last, Proj proj)
+    {
+        typedef typename std::iterator_traits<RandomIt>::value_type value_type;
+        typedef typename hpx::util::decay<
+                typename hpx::util::invoke_result<Proj,
+                    typename std::iterator_traits<RandomIt>::reference
+                >::type
+            >::type key_type;
+        typedef radix_key<key_type> radix_key_type;
+        typedef typename radix_key_type::type bits_type;
+
+        std::size_t const count = std::size_t(last - first);
+        if (count < 2)
+            return last;
+
+        std::size_t const cores = execution::processing_units_count(
+            policy.executor(), policy.parameters());
+
+        std::size_t num_chunks = (std::min)(cores,
+            (count + radix_sort_min_chunk_size - 1) / radix_sort_min_chunk_size);
+        if (num_chunks == 0)
+            num_chunks = 1;
+        std::size_t const chunk_size = (count + num_chunks - 1) / num_chunks;
+
+        std::unique_ptr<value_type[]> buffer(new value_type[count]);
+        std::vector<std::size_t> offsets(num_chunks * radix_buckets);
+
+        // the elements currently live in the buffer if this is true
+        bool in_buffer = false;
+
+        std::size_t const num_passes =
+            (sizeof(bits_type) * CHAR_BIT + radix_bits - 1) / radix_bits;
+
+        for (std::size_t pass = 0; pass != num_passes; ++pass)
+        {
+            std::size_t const shift = pass * radix_bits;
+
+            radix_digit<radix_key_type, Proj> digit(proj, shift);
+
+            auto chunk_range =
+                [count, chunk_size](std::size_t c)
+                {
+                    std::size_t begin = (std::min)(c * chunk_size, count);
+                    std::size_t end = (std::min)(begin + chunk_size, count);
+                    return std::make_pair(begin, end);
+                };
+
+            // count the digits of every chunk
+            radix_sort_for_each_chunk(policy, num_chunks,
+                [&](std::size_t c)
+                {
+                    std::size_t* counts = &offsets[c * radix_buckets];
+                    std::fill(counts, counts + radix_buckets, std::size_t(0));
+
+                    std::pair<std::size_t, std::size_t> r = chunk_range(c);
+                    if (in_buffer)
+                    {
+                        for (std::size_t i = r.first; i != r.second; ++i)
+                            ++counts[digit(buffer[i])];
+                    }
+                    else
+                    {
+                        for (std::size_t i = r.first; i != r.second; ++i)
+                            ++counts[digit(first[i])];
+                    }
+                });
+
+            // turn the counts into positions, bucket by bucket, and chunk by
+            // chunk inside of each bucket
+            std::size_t pos = 0;
+            bool all_in_one_bucket = false;
+            for (std::size_t b = 0; b != radix_buckets; ++b)
+            {
+                std::size_t const bucket_start = pos;
+                for (std::size_t c = 0; c != num_chunks; ++c)
+                {
+                    std::size_t& offset = offsets[c * radix_buckets + b];
+                    std::size_t const n = offset;
+                    offset = pos;
+                    pos += n;
+                }
+
+                if (pos - bucket_start == count)
+                    all_in_one_bucket = true;
+            }
+            HPX_ASSERT(pos == count);
+
+            // nothing to do if all keys have the same digit
+            if (all_in_one_bucket)
+                continue;
+
+            // distribute the elements
+            radix_sort_for_each_chunk(policy, num_chunks,
+                [&](std::size_t c)
+                {
+                    std::size_t* positions = &offsets[c * radix_buckets];
+
+                    std::pair<std::size_t, std::size_t> r = chunk_range(c);
+                    if (in_buffer)
+                    {
+                        for (std::size_t i = r.first; i != r.second; ++i)
+                        {
+                            first[positions[digit(buffer[i])]++] =
+                                std::move(buffer[i]);
+                        }
+                    }
+                    else
+                    {
+                        for (std::size_t i = r.first; i != r.second; ++i)
+                        {
+                            buffer[positions[digit(first[i])]++] =
+                                std::move(first[i]);
+                        }
+                    }
+                });
+
+            in_buffer = !in_buffer;
+        }
+
+        // move the elements back into the sequence, if needed
+        if (in_buffer)
+        {
+            radix_sort_for_each_chunk(policy, num_chunks,
+                [&](std::size_t c)
+                {
+                    std::size_t begin = (std::min)(c * chunk_size, count);
+                    std::size_t end = (std::min)(begin + chunk_size, count);
+                    std::move(&buffer[0] + begin, &buffer[0] + end,
+                        first + begin);
+                });
+        }
+
+        return last;
+    }
+
+    template <typename ExPolicy, typename RandomIt, typename Proj>
+    hpx::future<RandomIt> parallel_radix_sort_async(ExPolicy && policy,
+        RandomIt first, RandomIt last, Proj && proj)
+    {
+        typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+        typedef typename hpx::util::decay<Proj>::type proj_type;
+
+        return execution::async_execute(policy.executor(),
+            &parallel_radix_sort<policy_type, RandomIt, proj_type>,
+            policy, first, last, std::forward<Proj>(proj));
+    }
+    /// \endcond
+}}}}
+
+#endif
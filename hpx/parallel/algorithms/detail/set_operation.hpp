@@ -7,18 +7,21 @@
 #define HPX_PARALLEL_ALGORITHMS_SET_OPERATION_MAR_06_2015_0704PM
 
 #include <hpx/config.hpp>
-#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
 
+#include <hpx/parallel/algorithms/detail/merge_path.hpp>
 #include <hpx/parallel/execution_policy.hpp>
-#include <hpx/parallel/executors/execution_information.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/foreach_partitioner.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
 
 #include <boost/shared_array.hpp>
 
+#include <algorithm>
 #include <cstddef>
-#include <type_traits>
+#include <iterator>
+#include <utility>
 #include <vector>
 
 namespace hpx { namespace parallel { inline namespace v1 { namespace detail
@@ -26,141 +29,161 @@ namespace hpx { namespace parallel { inline namespace v1 { namespace detail
     /// \cond NOINTERNAL
 
     ///////////////////////////////////////////////////////////////////////////
-    template <typename FwdIter>
-    struct set_operations_buffer
+    // An output iterator which only counts the elements written to it.
+    class set_operation_counter
     {
+    public:
+        typedef std::output_iterator_tag iterator_category;
+        typedef void value_type;
+        typedef void difference_type;
+        typedef void pointer;
+        typedef void reference;
+
+        set_operation_counter()
+          : count_(0)
+        {}
+
+        set_operation_counter& operator*()
+        {
+            return *this;
+        }
+
         template <typename T>
-        class rewritable_ref
+        set_operation_counter& operator=(T const&)
         {
-        public:
-            rewritable_ref() : item_(0) {}
-            rewritable_ref(T const& item) : item_(item) {}
+            return *this;
+        }
 
-            rewritable_ref& operator= (T const& item)
-            {
-                item_ = &item;
-                return *this;
-            }
+        set_operation_counter& operator++()
+        {
+            ++count_;
+            return *this;
+        }
+        set_operation_counter& operator++(int)
+        {
+            ++count_;
+            return *this;
+        }
 
-            operator T const&() const
-            {
-                HPX_ASSERT(item_ != 0);
-                return *item_;
-            }
-
-        private:
-            T const* item_;
-        };
-
-        typedef typename std::iterator_traits<FwdIter>::value_type value_type;
-        typedef typename std::conditional<
-            std::is_scalar<value_type>::value,
-            value_type, rewritable_ref<value_type>
-        >::type type;
+        std::size_t count() const
+        {
+            return count_;
+        }
+
+    private:
+        std::size_t count_;
     };
 
     struct set_chunk_data
     {
-        set_chunk_data() { start = len = start_index = (std::size_t)(-1); }
-        std::size_t start;
+        set_chunk_data()
+          : start1(0), end1(0), start2(0), end2(0), len(0), start_index(0)
+        {}
+
+        std::size_t start1;
+        std::size_t end1;
+        std::size_t start2;
+        std::size_t end2;
         std::size_t len;
         std::size_t start_index;
     };
 
+    // Split both ranges at the given position of their merge (see
+    // merge_path_split) and move the split back to the beginning of the
+    // elements which are equivalent to the first element after it. This way
+    // all equivalent elements of both ranges end up in the same chunk.
+    template <typename RanIter1, typename RanIter2, typename F>
+    std::pair<std::size_t, std::size_t> set_operation_split(
+        RanIter1 first1, std::size_t len1, RanIter2 first2, std::size_t len2,
+        std::size_t diag, F const& f)
+    {
+        std::size_t start1 = merge_path_split(first1, len1, first2, len2,
+            diag, f, util::projection_identity(),
+            util::projection_identity());
+        std::size_t start2 = diag - start1;
+
+        // the first element after the split comes from the second range if
+        // it is less than the next element of the first range
+        if (start2 != len2 &&
+            (start1 == len1 || f(first2[start2], first1[start1])))
+        {
+            start1 = std::lower_bound(
+                first1, first1 + start1, first2[start2], f) - first1;
+            start2 = std::lower_bound(
+                first2, first2 + start2, first2[start2], f) - first2;
+        }
+        else if (start1 != len1)
+        {
+            start2 = std::lower_bound(
+                first2, first2 + start2, first1[start1], f) - first2;
+            start1 = std::lower_bound(
+                first1, first1 + start1, first1[start1], f) - first1;
+        }
+
+        return std::make_pair(start1, start2);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
+    // Perform the given set operation on the sorted ranges [first1, last1)
+    // and [first2, last2), writing the result to dest. The merge of both
+    // ranges is split into chunks of about the same size (see
+    // set_operation_split). The first step applies the set operation to each
+    // chunk counting the elements it produces, the second step applies it
+    // again writing the elements of each chunk directly to its place in the
+    // destination. No intermediate buffers are needed.
     template <typename ExPolicy, typename RanIter1, typename RanIter2,
-        typename FwdIter, typename F, typename Combiner, typename SetOp>
+        typename FwdIter, typename F, typename SetOp>
     typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
     set_operation(ExPolicy policy,
         RanIter1 first1, RanIter1 last1, RanIter2 first2, RanIter2 last2,
-        FwdIter dest, F && f, Combiner && combiner, SetOp && setop)
+        FwdIter dest, F && f, SetOp && setop)
     {
-        typedef typename std::iterator_traits<RanIter1>::difference_type
-            difference_type1;
-        typedef typename std::iterator_traits<RanIter2>::difference_type
-            difference_type2;
-
-        // allocate intermediate buffers
-        difference_type1 len1 = std::distance(first1, last1);
-        difference_type2 len2 = std::distance(first2, last2);
+        typedef typename hpx::util::decay<F>::type func_type;
+        typedef typename hpx::util::decay<SetOp>::type setop_type;
 
-        typedef typename set_operations_buffer<FwdIter>::type buffer_type;
-        boost::shared_array<buffer_type> buffer(
-            new buffer_type[combiner(len1, len2)]);
+        std::size_t len1 = std::distance(first1, last1);
+        std::size_t len2 = std::distance(first2, last2);
 
-        std::size_t cores = execution::processing_units_count(
-            policy.executor(), policy.parameters());
-
-        std::size_t step = (len1 + cores - 1) / cores;
+        std::size_t cores = merge_path_num_partitions(policy,
+            len1 + len2, 1);
         boost::shared_array<set_chunk_data> chunks(new set_chunk_data[cores]);
 
-        // fill the buffer piecewise
+        func_type func(std::forward<F>(f));
+        setop_type op(std::forward<SetOp>(setop));
+
+        // count the elements of each chunk
         return parallel::util::partitioner<ExPolicy, FwdIter, void>::call(
             policy, chunks.get(), cores,
             // first step, is applied to all partitions
             [=](set_chunk_data* curr_chunk, std::size_t part_size) -> void
             {
-                HPX_ASSERT(part_size == 1);
-
-                // find start in sequence 1
-                std::size_t start1 = (curr_chunk - chunks.get()) * step;
-                std::size_t end1 = (std::min)(start1 + step, std::size_t(len1));
-
-                if (start1 >= end1)
-                    return;
-
-                bool first_partition = (start1 == 0);
-                bool last_partition = (end1 == std::size_t(len1));
-
-                // all but the last chunk require special handling
-                if (!last_partition)
-                {
-                    // this chunk will be handled by the next one if all
-                    // elements of this partition are equal
-                    if (!f(first1[start1], first1[end1]))
-                        return;
-
-                    // move backwards to find earliest element which is equal to
-                    // the last element of the current chunk
-                    while (end1 != 0 && !f(first1[end1 - 1], first1[end1]))
-                        --end1;
-                }
-
-                // move backwards to find earliest element which is equal to
-                // the first element of the current chunk
-                while (start1 != 0 && !f(first1[start1 - 1], first1[start1]))
-                    --start1;
-
-                // find start and end in sequence 2
-                std::size_t start2 = 0;
-                if (!first_partition)
+                for (/**/; part_size != 0; --part_size, ++curr_chunk)
                 {
-                    start2 =
-                        std::lower_bound(
-                            first2, first2 + len2, first1[start1], f
-                        ) - first2;
+                    std::size_t part = curr_chunk - chunks.get();
+
+                    std::pair<std::size_t, std::size_t> start =
+                        set_operation_split(first1, len1, first2, len2,
+                            merge_path_diagonal(len1 + len2, part, cores),
+                            func);
+                    std::pair<std::size_t, std::size_t> end =
+                        set_operation_split(first1, len1, first2, len2,
+                            merge_path_diagonal(len1 + len2, part + 1, cores),
+                            func);
+
+                    curr_chunk->start1 = start.first;
+                    curr_chunk->end1 = end.first;
+                    curr_chunk->start2 = start.second;
+                    curr_chunk->end2 = end.second;
+
+                    curr_chunk->len =
+                        op(first1 + start.first, first1 + end.first,
+                           first2 + start.second, first2 + end.second,
+                           set_operation_counter(), func
+                        ).count();
                 }
-
-                std::size_t end2 = len2;
-                if (!last_partition)
-                {
-                    end2 =
-                        std::lower_bound(
-                            first2 + start2, first2 + len2, first1[end1], f
-                        ) - first2;
-                }
-
-                // perform requested set-operation into the proper place of the
-                // intermediate buffer
-                curr_chunk->start = combiner(start1, start2);
-                auto buffer_dest = buffer.get() + curr_chunk->start;
-                curr_chunk->len =
-                    setop(first1 + start1, first1 + end1,
-                          first2 + start2, first2 + end2, buffer_dest, f
-                    ) - buffer_dest;
             },
             // second step, is executed after all partitions are done running
-            [buffer, chunks, cores, dest](std::vector<future<void> >&&) -> FwdIter
+            [=](std::vector<future<void> >&&) -> FwdIter
             {
                 // accumulate real length
                 set_chunk_data* chunk = chunks.get();
@@ -172,28 +195,33 @@ namespace hpx { namespace parallel { inline namespace v1 { namespace detail
                         curr_chunk->start_index + curr_chunk->len;
                 }
 
-                // finally, copy data to destination
+                // finally, write the elements of each chunk to their place
+                // in the destination
                 parallel::util::foreach_partitioner<
                         hpx::parallel::execution::parallel_policy
                     >::call(execution::par, chunks.get(), cores,
-                        [buffer, dest](
-                            set_chunk_data* chunk, std::size_t, std::size_t)
+                        [=](set_chunk_data* curr, std::size_t part_size,
+                            std::size_t)
                         {
-                            if (chunk->start == (size_t)(-1) ||
-                                chunk->start_index == (size_t)(-1) ||
-                                chunk->len == (size_t)(-1))
-                                return;
-
-                            std::copy(buffer.get() + chunk->start,
-                                buffer.get() + chunk->start + chunk->len,
-                                dest + chunk->start_index);
+                            for (/**/; part_size != 0; --part_size, ++curr)
+                            {
+                                if (curr->len == 0)
+                                    continue;
+
+                                op(first1 + curr->start1,
+                                    first1 + curr->end1,
+                                    first2 + curr->start2,
+                                    first2 + curr->end2,
+                                    std::next(dest, curr->start_index), func);
+                            }
                         },
                         [](set_chunk_data* last) -> set_chunk_data*
                         {
                             return last;
                         });
 
-                return dest;
+                return std::next(dest,
+                    chunk->start_index + chunk->len);
             });
     }
 
@@ -15,6 +15,7 @@
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
 #include <hpx/parallel/algorithms/detail/predicates.hpp>
 #include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/util/cancellation_token.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/loop.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
@@ -36,6 +37,79 @@ namespace hpx { namespace parallel { inline namespace v1
     {
         /// \cond NOINTERNAL
 
+        // Compare the given partition and cancel the token if any pair of
+        // elements does not satisfy the predicate.
+        template <typename ExPolicy, typename ZipIter, typename Token,
+            typename F>
+        bool equal_partition(std::false_type, ZipIter it,
+            std::size_t part_count, Token& tok, F && f)
+        {
+            typedef typename std::iterator_traits<ZipIter>::reference
+                reference;
+
+            util::loop_n<ExPolicy>(
+                it, part_count, tok,
+                [&f, &tok](ZipIter const& curr)
+                {
+                    reference t = *curr;
+                    if (!hpx::util::invoke(f, hpx::util::get<0>(t),
+                            hpx::util::get<1>(t)))
+                    {
+                        tok.cancel();
+                    }
+                });
+            return !tok.was_cancelled();
+        }
+
+        // vector-pack execution policies compare the partition in blocks of
+        // cancellation_poll_interval elements, checking the token in between
+        template <typename ExPolicy, typename ZipIter, typename Token,
+            typename F>
+        bool equal_partition(std::true_type, ZipIter it,
+            std::size_t part_count, Token& tok, F && f)
+        {
+            auto iters = it.get_iterator_tuple();
+            auto first1 = hpx::util::get<0>(iters);
+            auto first2 = hpx::util::get<1>(iters);
+
+            while (part_count != 0)
+            {
+                if (tok.was_cancelled())
+                    return false;
+
+                std::size_t n =
+                    (std::min)(part_count, util::cancellation_poll_interval);
+
+                auto last1 = std::next(first1, n);
+                auto p = util::find_first2<ExPolicy>(first1, last1, first2,
+                    invoke_not_indirect<F>{f});
+
+                if (p.first != last1)
+                {
+                    tok.cancel();
+                    return false;
+                }
+
+                first1 = last1;
+                std::advance(first2, n);
+                part_count -= n;
+            }
+            return true;
+        }
+
+        template <typename ExPolicy, typename ZipIter, typename Token,
+            typename F>
+        bool equal_partition(ZipIter it, std::size_t part_count, Token& tok,
+            F && f)
+        {
+            typedef execution::is_vectorpack_execution_policy<ExPolicy>
+                is_vectorpack;
+
+            return equal_partition<ExPolicy>(is_vectorpack(), it, part_count,
+                tok, std::forward<F>(f));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
         // Our own version of the C++14 equal (_binary).
         template <typename InIter1, typename InIter2, typename F>
         bool sequential_equal_binary(InIter1 first1, InIter1 last1,
@@ -107,7 +181,6 @@ namespace hpx { namespace parallel { inline namespace v1
                 }
 
                 typedef hpx::util::zip_iterator<FwdIter1, FwdIter2> zip_iterator;
-                typedef typename zip_iterator::reference reference;
 
                 util::cancellation_token<> tok;
                 auto f1 =
@@ -115,18 +188,8 @@ namespace hpx { namespace parallel { inline namespace v1
                         zip_iterator it, std::size_t part_count
                     ) mutable -> bool
                     {
-                        util::loop_n<ExPolicy>(
-                            it, part_count, tok,
-                            [&f, &tok](zip_iterator const& curr)
-                            {
-                                reference t = *curr;
-                                if (!hpx::util::invoke(f, hpx::util::get<0>(t),
-                                        hpx::util::get<1>(t)))
-                                {
-                                    tok.cancel();
-                                }
-                            });
-                        return !tok.was_cancelled();
+                        return equal_partition<ExPolicy>(it, part_count, tok,
+                            f);
                     };
 
                 return util::partitioner<ExPolicy, bool>::call(
@@ -275,7 +338,8 @@ namespace hpx { namespace parallel { inline namespace v1
             sequential(ExPolicy, InIter1 first1, InIter1 last1,
                 InIter2 first2, F && f)
             {
-                return std::equal(first1, last1, first2, std::forward<F>(f));
+                return util::find_first2<ExPolicy>(first1, last1, first2,
+                    invoke_not_indirect<F>{f}).first == last1;
             }
 
             template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
@@ -295,7 +359,6 @@ namespace hpx { namespace parallel { inline namespace v1
                 difference_type count = std::distance(first1, last1);
 
                 typedef hpx::util::zip_iterator<FwdIter1, FwdIter2> zip_iterator;
-                typedef typename zip_iterator::reference reference;
 
                 util::cancellation_token<> tok;
                 auto f1 =
@@ -303,18 +366,8 @@ namespace hpx { namespace parallel { inline namespace v1
                         zip_iterator it, std::size_t part_count
                     ) mutable -> bool
                     {
-                        util::loop_n<ExPolicy>(
-                            it, part_count, tok,
-                            [&f, &tok](zip_iterator const& curr)
-                            {
-                                reference t = *curr;
-                                if (!hpx::util::invoke(f, hpx::util::get<0>(t),
-                                        hpx::util::get<1>(t)))
-                                {
-                                    tok.cancel();
-                                }
-                            });
-                        return !tok.was_cancelled();
+                        return equal_partition<ExPolicy>(it, part_count, tok,
+                            f);
                     };
 
                 return util::partitioner<ExPolicy, bool>::call(
@@ -19,7 +19,9 @@
 #include <hpx/parallel/algorithms/detail/is_negative.hpp>
 #include <hpx/parallel/execution_policy.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/foreach_partitioner.hpp>
 #include <hpx/parallel/util/projection_identity.hpp>
+#include <hpx/parallel/util/transfer.hpp>
 
 #include <algorithm>
 #include <cstddef>
@@ -82,11 +84,28 @@ namespace hpx { namespace parallel { inline namespace v1
                 if(first == last)
                     return util::detail::algorithm_result<ExPolicy>::get();
 
+                std::size_t count = std::distance(first, last);
+                if (util::detail::use_nontemporal_stores<FwdIter>(count))
+                {
+                    return hpx::util::void_guard<result_type>(),
+                        util::foreach_partitioner<ExPolicy>::call(
+                            std::forward<ExPolicy>(policy), first, count,
+                            [val](FwdIter part_begin, std::size_t part_size,
+                                std::size_t)
+                            {
+                                util::fill_n_nontemporal(
+                                    part_begin, part_size, val);
+                            },
+                            [](FwdIter && last) -> FwdIter
+                            {
+                                return std::move(last);
+                            });
+                }
+
                 return hpx::util::void_guard<result_type>(),
                     for_each_n<FwdIter>().call(
                         std::forward<ExPolicy>(policy), std::false_type(),
-                        first, std::distance(first, last),
-                        fill_iteration<T>{val},
+                        first, count, fill_iteration<T>{val},
                         util::projection_identity());
             }
         };
@@ -212,6 +231,22 @@ namespace hpx { namespace parallel { inline namespace v1
             {
                 typedef typename std::iterator_traits<FwdIter>::value_type type;
 
+                if (util::detail::use_nontemporal_stores<FwdIter>(count))
+                {
+                    return util::foreach_partitioner<ExPolicy>::call(
+                        std::forward<ExPolicy>(policy), first, count,
+                        [val](FwdIter part_begin, std::size_t part_size,
+                            std::size_t)
+                        {
+                            util::fill_n_nontemporal(
+                                part_begin, part_size, val);
+                        },
+                        [](FwdIter && last) -> FwdIter
+                        {
+                            return std::move(last);
+                        });
+                }
+
                 return
                     for_each_n<FwdIter>().call(
                         std::forward<ExPolicy>(policy),
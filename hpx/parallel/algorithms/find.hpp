@@ -17,6 +17,7 @@
 #include <hpx/parallel/algorithms/detail/predicates.hpp>
 #include <hpx/parallel/execution_policy.hpp>
 #include <hpx/parallel/traits/projected.hpp>
+#include <hpx/parallel/util/cancellation_token.hpp>
 #include <hpx/parallel/util/compare_projected.hpp>
 #include <hpx/parallel/util/invoke_projected.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
@@ -37,6 +38,83 @@ namespace hpx { namespace parallel { inline namespace v1
     namespace detail
     {
         /// \cond NOINTERNAL
+
+        // Invoke the predicate on the element referenced by the iterator, or
+        // on the vector-pack the pointer refers to.
+        template <typename F>
+        struct find_indirect
+        {
+            typename std::remove_reference<F>::type& f_;
+
+            template <typename Iter>
+            HPX_HOST_DEVICE HPX_FORCEINLINE
+            auto operator()(Iter it)
+            ->  decltype(hpx::util::invoke(f_, *it))
+            {
+                return hpx::util::invoke(f_, *it);
+            }
+        };
+
+        // Search the given partition for the first element which satisfies
+        // the predicate and record its index in the cancellation token.
+        template <typename ExPolicy, typename FwdIter, typename Token,
+            typename F>
+        void find_partition(std::false_type, FwdIter it,
+            std::size_t part_size, std::size_t base_idx, Token& tok, F && f)
+        {
+            typedef typename std::iterator_traits<FwdIter>::reference
+                reference;
+
+            util::loop_idx_n(
+                base_idx, it, part_size, tok,
+                [&f, &tok](reference v, std::size_t i) -> void
+                {
+                    if (hpx::util::invoke(f, v))
+                        tok.cancel(i);
+                });
+        }
+
+        // vector-pack execution policies search the partition in blocks of
+        // cancellation_poll_interval elements, checking the token in between
+        template <typename ExPolicy, typename FwdIter, typename Token,
+            typename F>
+        void find_partition(std::true_type, FwdIter it,
+            std::size_t part_size, std::size_t base_idx, Token& tok, F && f)
+        {
+            while (part_size != 0 && !tok.was_cancelled(base_idx))
+            {
+                std::size_t n =
+                    (std::min)(part_size, util::cancellation_poll_interval);
+
+                FwdIter last = std::next(it, n);
+                FwdIter found = util::find_first<ExPolicy>(it, last,
+                    find_indirect<F>{f});
+
+                if (found != last)
+                {
+                    tok.cancel(base_idx + std::distance(it, found));
+                    return;
+                }
+
+                it = last;
+                part_size -= n;
+                base_idx += n;
+            }
+        }
+
+        template <typename ExPolicy, typename FwdIter, typename Token,
+            typename F>
+        void find_partition(FwdIter it, std::size_t part_size,
+            std::size_t base_idx, Token& tok, F && f)
+        {
+            typedef execution::is_vectorpack_execution_policy<ExPolicy>
+                is_vectorpack;
+
+            find_partition<ExPolicy>(is_vectorpack(), it, part_size,
+                base_idx, tok, std::forward<F>(f));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
         template <typename Iter>
         struct find : public detail::algorithm<find<Iter>, Iter>
         {
@@ -48,7 +126,9 @@ namespace hpx { namespace parallel { inline namespace v1
             static InIter
             sequential(ExPolicy, InIter first, InIter last, T const& val)
             {
-                return std::find(first, last, val);
+                detail::compare_to<T> pred(val);
+                return util::find_first<ExPolicy>(first, last,
+                    find_indirect<detail::compare_to<T> >{pred});
             }
 
             template <typename ExPolicy, typename FwdIter, typename T>
@@ -59,7 +139,6 @@ namespace hpx { namespace parallel { inline namespace v1
                 T const& val)
             {
                 typedef util::detail::algorithm_result<ExPolicy, FwdIter> result;
-                typedef typename std::iterator_traits<FwdIter>::value_type type;
                 typedef typename std::iterator_traits<FwdIter>::difference_type
                     difference_type;
 
@@ -75,13 +154,8 @@ namespace hpx { namespace parallel { inline namespace v1
                         [val, tok](FwdIter it, std::size_t part_size,
                             std::size_t base_idx) mutable -> void
                         {
-                            util::loop_idx_n(
-                                base_idx, it, part_size, tok,
-                                [&val, &tok](type& v, std::size_t i) -> void
-                                {
-                                    if (v == val)
-                                        tok.cancel(i);
-                                });
+                            find_partition<ExPolicy>(it, part_size, base_idx,
+                                tok, detail::compare_to<T>(val));
                         },
                         [=](std::vector<hpx::future<void> > &&) mutable -> FwdIter
                         {
@@ -204,7 +278,8 @@ namespace hpx { namespace parallel { inline namespace v1
             static InIter
             sequential(ExPolicy, InIter first, InIter last, F && f)
             {
-                return std::find_if(first, last, f);
+                return util::find_first<ExPolicy>(first, last,
+                    find_indirect<F>{f});
             }
 
             template <typename ExPolicy, typename FwdIter, typename F>
@@ -214,7 +289,6 @@ namespace hpx { namespace parallel { inline namespace v1
             parallel(ExPolicy && policy, FwdIter first, FwdIter last, F && f)
             {
                 typedef util::detail::algorithm_result<ExPolicy, FwdIter> result;
-                typedef typename std::iterator_traits<Iter>::value_type type;
                 typedef typename std::iterator_traits<Iter>::difference_type
                     difference_type;
 
@@ -232,13 +306,8 @@ namespace hpx { namespace parallel { inline namespace v1
                             std::size_t base_idx
                         ) mutable -> void
                         {
-                            util::loop_idx_n(
-                                base_idx, it, part_size, tok,
-                                [&f, &tok](type& v, std::size_t i) -> void
-                                {
-                                    if (hpx::util::invoke(f, v))
-                                        tok.cancel(i);
-                                });
+                            find_partition<ExPolicy>(it, part_size, base_idx,
+                                tok, f);
                         },
                         [=](std::vector<hpx::future<void> > &&) mutable -> FwdIter
                         {
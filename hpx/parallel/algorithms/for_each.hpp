@@ -29,6 +29,7 @@
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/foreach_partitioner.hpp>
 #include <hpx/parallel/util/loop.hpp>
+#include <hpx/parallel/util/prefetching_loop.hpp>
 #include <hpx/parallel/util/projection_identity.hpp>
 
 #include <algorithm>
@@ -81,28 +82,47 @@ namespace hpx { namespace parallel { inline namespace v1
             }
         };
 
+        // The iterations over a partition can't throw if neither the
+        // function, the projection nor the iterator can throw. This lets the
+        // partitioner skip all of the exception handling.
+        template <typename F, typename Proj, typename Iter>
+        struct is_nothrow_for_each_iteration
+          : std::integral_constant<bool,
+                noexcept(++std::declval<Iter&>()) &&
+                noexcept(HPX_INVOKE(std::declval<F&>(),
+                    HPX_INVOKE(std::declval<Proj&>(),
+                        *std::declval<Iter&>())))>
+        {};
+
         template <typename ExPolicy, typename F, typename Proj>
         struct for_each_iteration
         {
             typedef typename hpx::util::decay<ExPolicy>::type execution_policy_type;
             typedef typename hpx::util::decay<F>::type fun_type;
             typedef typename hpx::util::decay<Proj>::type proj_type;
+            typedef typename util::detail::prefetcher_type<
+                    execution_policy_type
+                >::type prefetcher_type;
 
             fun_type f_;
             proj_type proj_;
+            prefetcher_type prefetcher_;
 
             template <typename Iter>
             HPX_HOST_DEVICE HPX_FORCEINLINE
             void execute(Iter part_begin, std::size_t part_size)
             {
-                util::loop_n<execution_policy_type>(part_begin, part_size,
+                util::loop_n_prefetch<execution_policy_type>(part_begin,
+                    part_size, prefetcher_,
                     invoke_projected<fun_type, proj_type>{f_, proj_});
             }
 
             template <typename F_, typename Proj_>
-            HPX_HOST_DEVICE for_each_iteration(F_ && f, Proj_ && proj)
+            HPX_HOST_DEVICE for_each_iteration(F_ && f, Proj_ && proj,
+                    prefetcher_type const& prefetcher = prefetcher_type())
               : f_(std::forward<F_>(f))
               , proj_(std::forward<Proj_>(proj))
+              , prefetcher_(prefetcher)
             {}
 
 #if !defined(__NVCC__) && !defined(__CUDACC__)
@@ -112,11 +132,13 @@ namespace hpx { namespace parallel { inline namespace v1
             HPX_HOST_DEVICE for_each_iteration(for_each_iteration const& rhs)
               : f_(rhs.f_)
               , proj_(rhs.proj_)
+              , prefetcher_(rhs.prefetcher_)
             {}
 
             HPX_HOST_DEVICE for_each_iteration(for_each_iteration && rhs)
               : f_(std::move(rhs.f_))
               , proj_(std::move(rhs.proj_))
+              , prefetcher_(std::move(rhs.prefetcher_))
             {}
 #endif
 
@@ -126,7 +148,10 @@ namespace hpx { namespace parallel { inline namespace v1
             template <typename Iter>
             HPX_HOST_DEVICE HPX_FORCEINLINE
             void operator()(Iter part_begin, std::size_t part_size,
-                std::size_t /*part_index*/)
+                std::size_t /*part_index*/) noexcept(
+                    is_nothrow_for_each_iteration<
+                        fun_type, proj_type, Iter
+                    >::value)
             {
                 hpx::util::annotate_function annotate(f_);
                 execute(part_begin, part_size);
@@ -162,7 +187,8 @@ namespace hpx { namespace parallel { inline namespace v1
                 if (count != 0)
                 {
                     auto f1 = for_each_iteration<ExPolicy, F, Proj>(
-                        std::forward<F>(f), std::forward<Proj>(proj));
+                        std::forward<F>(f), std::forward<Proj>(proj),
+                        util::get_prefetcher(policy));
 
                     return util::foreach_partitioner<ExPolicy>::call(
                         std::forward<ExPolicy>(policy), first, count,
@@ -365,7 +391,8 @@ namespace hpx { namespace parallel { inline namespace v1
                 if (first != last)
                 {
                     auto f1 = for_each_iteration<ExPolicy, F, Proj>(
-                        std::forward<F>(f), std::forward<Proj>(proj));
+                        std::forward<F>(f), std::forward<Proj>(proj),
+                        util::get_prefetcher(policy));
 
                     return util::foreach_partitioner<ExPolicy>::call(
                         std::forward<ExPolicy>(policy),
@@ -27,11 +27,14 @@
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
 #include <hpx/parallel/algorithms/detail/predicates.hpp>
 #include <hpx/parallel/algorithms/for_loop_induction.hpp>
+#include <hpx/parallel/algorithms/for_loop_random.hpp>
 #include <hpx/parallel/algorithms/for_loop_reduction.hpp>
 #include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/execution_parameters.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/loop.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
+#include <hpx/parallel/util/prefetching_loop.hpp>
 
 #include <algorithm>
 #include <cstddef>
@@ -98,25 +101,43 @@ namespace hpx { namespace parallel { inline namespace v2
         }
 
         ///////////////////////////////////////////////////////////////////////
-        template <typename F, typename S, typename Tuple>
+        template <typename F, typename S, typename Tuple,
+            typename Prefetcher = parallel::execution::detail::no_prefetcher>
         struct part_iterations;
 
-        template <typename F, typename S, typename ...Ts>
-        struct part_iterations<F, S, hpx::util::tuple<Ts...> >
+        template <typename F, typename S, typename ...Ts, typename Prefetcher>
+        struct part_iterations<F, S, hpx::util::tuple<Ts...>, Prefetcher>
         {
             typedef typename hpx::util::decay<F>::type fun_type;
 
             fun_type f_;
             S stride_;
             hpx::util::tuple<Ts...> args_;
+            Prefetcher prefetcher_;
 
             template <typename F_, typename S_, typename Args>
-            part_iterations(F_&& f, S_&& stride, Args&& args)
+            part_iterations(F_&& f, S_&& stride, Args&& args,
+                    Prefetcher const& prefetcher = Prefetcher())
               : f_(std::forward<F_>(f))
               , stride_(std::forward<S_>(stride))
               , args_(std::forward<Args>(args))
+              , prefetcher_(prefetcher)
             {}
 
+            // advance the given iteration variable by one (strided) step
+            template <typename B>
+            HPX_HOST_DEVICE HPX_FORCEINLINE
+            std::size_t next_step(B& it, std::size_t& steps) const
+            {
+                // NVCC seems to have a bug with std::min...
+                std::size_t chunk = S(steps) < stride_ ? steps : stride_;
+
+                // modifies 'chunk'
+                it = parallel::v1::detail::next(it, steps, chunk);
+                steps -= chunk;
+                return chunk;
+            }
+
             template <typename B>
             HPX_HOST_DEVICE
             void execute(B part_begin, std::size_t part_steps,
@@ -126,21 +147,38 @@ namespace hpx { namespace parallel { inline namespace v2
                     sizeof...(Ts)>::type();
                 detail::init_iteration(args_, pack, part_index);
 
+                // the iteration variable of the iteration to prefetch for,
+                // this is a no-op if no prefetching was requested
+                B ahead = part_begin;
+                std::size_t ahead_steps = 0;
+                std::size_t distance = prefetcher_.distance();
+                if (distance != 0)
+                {
+                    ahead_steps = part_steps;
+                    while (distance-- != 0 && ahead_steps != 0)
+                        next_step(ahead, ahead_steps);
+                }
+
+                std::size_t count = util::detail::preemption_poll_interval;
                 while (part_steps != 0)
                 {
-                    detail::invoke_iteration(args_, pack, f_, part_begin);
+                    if (ahead_steps != 0)
+                    {
+                        prefetcher_(ahead);
+                        next_step(ahead, ahead_steps);
+                    }
 
-                    // NVCC seems to have a bug with std::min...
-                    std::size_t chunk =
-                        S(part_steps) < stride_ ? part_steps : stride_;
+                    detail::invoke_iteration(args_, pack, f_, part_begin);
 
-                    // modifies 'chunk'
-                    part_begin = parallel::v1::detail::next(
-                        part_begin, part_steps, chunk);
-                    part_steps -= chunk;
-                    part_index += chunk;
+                    part_index += next_step(part_begin, part_steps);
 
                     detail::next_iteration(args_, pack, part_index);
+
+                    if (--count == 0)
+                    {
+                        util::detail::preemption_point();
+                        count = util::detail::preemption_poll_interval;
+                    }
                 }
             }
 
@@ -220,10 +258,15 @@ namespace hpx { namespace parallel { inline namespace v2
                 args_type args =
                     hpx::util::forward_as_tuple(std::forward<Ts>(ts)...);
 
+                typedef typename util::detail::prefetcher_type<
+                        ExPolicy
+                    >::type prefetcher_type;
+
                 return util::partitioner<ExPolicy>::call_with_index(policy,
                     first, size, stride,
-                    part_iterations<F, S, args_type>{
-                        std::forward<F>(f), stride, args
+                    part_iterations<F, S, args_type, prefetcher_type>{
+                        std::forward<F>(f), stride, args,
+                        util::get_prefetcher(policy)
                     },
                     [=] (std::vector<hpx::future<void> > &&) mutable -> void
                     {
@@ -1150,13 +1193,14 @@ namespace hpx { namespace parallel { inline namespace v2
 #if defined(HPX_HAVE_THREAD_DESCRIPTION)
 namespace hpx { namespace traits
 {
-    template <typename F, typename S, typename Tuple>
+    template <typename F, typename S, typename Tuple, typename Prefetcher>
     struct get_function_address<
-        parallel::v2::detail::part_iterations<F, S, Tuple> >
+        parallel::v2::detail::part_iterations<F, S, Tuple, Prefetcher> >
     {
         static std::size_t call(
-            parallel::v2::detail::part_iterations<F, S, Tuple> const& f)
-                noexcept
+            parallel::v2::detail::part_iterations<
+                F, S, Tuple, Prefetcher
+            > const& f) noexcept
         {
             return get_function_address<
                     typename hpx::util::decay<F>::type
@@ -1164,13 +1208,14 @@ namespace hpx { namespace traits
         }
     };
 
-    template <typename F, typename S, typename Tuple>
+    template <typename F, typename S, typename Tuple, typename Prefetcher>
     struct get_function_annotation<
-        parallel::v2::detail::part_iterations<F, S, Tuple> >
+        parallel::v2::detail::part_iterations<F, S, Tuple, Prefetcher> >
     {
         static char const* call(
-            parallel::v2::detail::part_iterations<F, S, Tuple> const& f)
-                noexcept
+            parallel::v2::detail::part_iterations<
+                F, S, Tuple, Prefetcher
+            > const& f) noexcept
         {
             return get_function_annotation<
                     typename hpx::util::decay<F>::type
@@ -1179,13 +1224,14 @@ namespace hpx { namespace traits
     };
 
 #if HPX_HAVE_ITTNOTIFY != 0 && !defined(HPX_HAVE_APEX)
-    template <typename F, typename S, typename Tuple>
+    template <typename F, typename S, typename Tuple, typename Prefetcher>
     struct get_function_annotation_itt<
-        parallel::v2::detail::part_iterations<F, S, Tuple> >
+        parallel::v2::detail::part_iterations<F, S, Tuple, Prefetcher> >
     {
         static util::itt::string_handle call(
-            parallel::v2::detail::part_iterations<F, S, Tuple> const& f)
-                noexcept
+            parallel::v2::detail::part_iterations<
+                F, S, Tuple, Prefetcher
+            > const& f) noexcept
         {
             return get_function_annotation_itt<
                     typename hpx::util::decay<F>::type
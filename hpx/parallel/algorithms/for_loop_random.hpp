@@ -0,0 +1,81 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/algorithms/for_loop_random.hpp
+
+#if !defined(HPX_PARALLEL_ALGORITHM_FOR_LOOP_RANDOM_HPP)
+#define HPX_PARALLEL_ALGORITHM_FOR_LOOP_RANDOM_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/util/philox_engine.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hpx { namespace parallel { inline namespace v2
+{
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        ///////////////////////////////////////////////////////////////////////
+        struct random_stream_helper
+        {
+            explicit random_stream_helper(std::uint64_t seed) noexcept
+              : seed_(seed), engine_(seed)
+            {}
+
+            HPX_HOST_DEVICE
+            void init_iteration(std::size_t index) noexcept
+            {
+                engine_.seed(seed_, index);
+            }
+
+            HPX_HOST_DEVICE
+            hpx::util::philox_engine& iteration_value() noexcept
+            {
+                return engine_;
+            }
+
+            HPX_HOST_DEVICE
+            void next_iteration(std::size_t index) noexcept
+            {
+                engine_.seed(seed_, index);
+            }
+
+            HPX_HOST_DEVICE
+            void exit_iteration(std::size_t /*index*/) noexcept
+            {
+            }
+
+        private:
+            std::uint64_t seed_;
+            hpx::util::philox_engine engine_;
+        };
+
+        /// \endcond
+    }
+
+    /// The function template returns a random stream object to be passed to
+    /// a looping algorithm. For each element in the input range, the looping
+    /// algorithm passes a (counter based) random number engine to the element
+    /// access function, the engine passed for the element at ordinal
+    /// position \a p is \a hpx::util::philox_engine(seed, p). The random
+    /// numbers drawn for an element therefore depend on the seed and the
+    /// position of the element only: they do not depend on the execution
+    /// policy or on the way the iterations are partitioned.
+    ///
+    /// \param seed     [in] The seed identifying the random sequences to use.
+    ///
+    /// \returns This returns a random stream object for the given seed.
+    ///
+    HPX_FORCEINLINE detail::random_stream_helper
+    random_stream(std::uint64_t seed)
+    {
+        return detail::random_stream_helper(seed);
+    }
+}}}
+
+#endif
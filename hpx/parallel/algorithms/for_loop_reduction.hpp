@@ -9,20 +9,26 @@
 #define HPX_PARALLEL_ALGORITHM_FOR_LOOP_REDUCTION_MAR_05_2016_0837PM
 
 #include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/runtime/get_os_thread_count.hpp>
 #include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/cache_aligned_data.hpp>
 #include <hpx/util/decay.hpp>
 
 #include <hpx/parallel/algorithms/detail/predicates.hpp>
 
-#include <boost/shared_array.hpp>
-
 #include <cstddef>
 #include <cstdlib>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace hpx { namespace parallel { inline namespace v2
 {
@@ -30,6 +36,126 @@ namespace hpx { namespace parallel { inline namespace v2
     {
         /// \cond NOINTERNAL
 
+        ///////////////////////////////////////////////////////////////////////
+        // The views of a reduction, one per worker thread. Each view is
+        // placed on its own cache line(s), which avoids false sharing between
+        // the worker threads updating their views.
+        template <typename T>
+        class reduction_views
+        {
+            struct view
+            {
+                T value_;
+                bool used_;
+            };
+
+        public:
+            explicit reduction_views(std::size_t cores)
+              : views_(cores)
+            {}
+
+            std::size_t size() const noexcept
+            {
+                return views_.size();
+            }
+
+            void reset(T const& identity)
+            {
+                for (hpx::util::cache_aligned_data<view>& v : views_)
+                {
+                    v.data_.value_ = identity;
+                    v.data_.used_ = false;
+                }
+            }
+
+            T& value(std::size_t i)
+            {
+                HPX_ASSERT(i < views_.size());
+                return views_[i].data_.value_;
+            }
+
+            // mark the view as being used and return it
+            T& use(std::size_t i)
+            {
+                HPX_ASSERT(i < views_.size());
+                view& v = views_[i].data_;
+                v.used_ = true;
+                return v.value_;
+            }
+
+            // return the indices of all views which were used
+            std::vector<std::size_t> used() const
+            {
+                std::vector<std::size_t> result;
+                for (std::size_t i = 0; i != views_.size(); ++i)
+                {
+                    if (views_[i].data_.used_)
+                        result.push_back(i);
+                }
+                return result;
+            }
+
+        private:
+            std::vector<hpx::util::cache_aligned_data<view> > views_;
+        };
+
+        // The views are reused by subsequent reductions of the same type,
+        // which avoids allocating (and, for views owning memory, growing)
+        // the views for every invocation of an algorithm.
+        template <typename T>
+        class reduction_views_pool
+        {
+            typedef hpx::lcos::local::spinlock mutex_type;
+
+        public:
+            static std::shared_ptr<reduction_views<T> > get(
+                T const& identity)
+            {
+                std::size_t cores = hpx::get_os_thread_count();
+                reduction_views_pool& pool = instance();
+
+                std::unique_ptr<reduction_views<T> > views;
+                {
+                    std::lock_guard<mutex_type> l(pool.mtx_);
+                    while (!pool.views_.empty() && !views)
+                    {
+                        views = std::move(pool.views_.back());
+                        pool.views_.pop_back();
+
+                        // the number of cores might have changed
+                        if (views->size() != cores)
+                            views.reset();
+                    }
+                }
+
+                if (!views)
+                    views.reset(new reduction_views<T>(cores));
+                views->reset(identity);
+
+                return std::shared_ptr<reduction_views<T> >(
+                    views.release(), &reduction_views_pool::release);
+            }
+
+        private:
+            static reduction_views_pool& instance()
+            {
+                static reduction_views_pool pool;
+                return pool;
+            }
+
+            static void release(reduction_views<T>* p)
+            {
+                std::unique_ptr<reduction_views<T> > views(p);
+
+                reduction_views_pool& pool = instance();
+                std::lock_guard<mutex_type> l(pool.mtx_);
+                pool.views_.push_back(std::move(views));
+            }
+
+            mutex_type mtx_;
+            std::vector<std::unique_ptr<reduction_views<T> > > views_;
+        };
+
         ///////////////////////////////////////////////////////////////////////
         template <typename T, typename Op>
         struct reduction_helper
@@ -37,36 +163,71 @@ namespace hpx { namespace parallel { inline namespace v2
             template <typename Op_>
             reduction_helper(T& var, T const& identity, Op_ && op)
               : var_(var), op_(std::forward<Op_>(op))
-            {
-                std::size_t cores = hpx::get_os_thread_count();
-                data_.reset(new T[cores]);
-                for (std::size_t i = 0; i != cores; ++i)
-                    data_[i] = identity;
-            }
+              , views_(reduction_views_pool<T>::get(identity))
+            {}
 
             void init_iteration(std::size_t)
             {
-                HPX_ASSERT(hpx::get_worker_thread_num() < hpx::get_os_thread_count());
+                HPX_ASSERT(hpx::get_worker_thread_num() < views_->size());
             }
 
             T& iteration_value()
             {
-                return data_[hpx::get_worker_thread_num()];
+                return views_->use(hpx::get_worker_thread_num());
             }
 
             void next_iteration(std::size_t /*index*/) noexcept {}
 
             void exit_iteration(std::size_t /*index*/)
             {
-                std::size_t cores = hpx::get_os_thread_count();
-                for (std::size_t i = 0; i != cores; ++i)
-                    var_ = op_(var_, data_[i]);
+                // only the views which were used hold partial results
+                std::vector<std::size_t> used = views_->used();
+                if (used.empty())
+                    return;
+
+                // combining views which own memory (containers, etc.) is
+                // expensive enough to combine independent pairs concurrently
+                bool concurrently = !std::is_arithmetic<T>::value &&
+                    hpx::threads::get_self_ptr() != nullptr;
+
+                tree_combine(used.data(), used.data() + used.size(),
+                    concurrently);
+                var_ = op_(var_, views_->value(used[0]));
             }
 
         private:
+            // combine the views [first, last) pairwise into the view *first
+            void tree_combine(std::size_t const* first,
+                std::size_t const* last, bool concurrently)
+            {
+                std::size_t count = last - first;
+                if (count < 2)
+                    return;
+
+                std::size_t const* middle = first + count / 2;
+                if (concurrently && count > 2)
+                {
+                    hpx::future<void> f = hpx::async(
+                        [this, first, middle, concurrently]()
+                        {
+                            tree_combine(first, middle, concurrently);
+                        });
+                    tree_combine(middle, last, concurrently);
+                    f.get();
+                }
+                else
+                {
+                    tree_combine(first, middle, concurrently);
+                    tree_combine(middle, last, concurrently);
+                }
+
+                T& lhs = views_->value(*first);
+                lhs = op_(lhs, views_->value(*middle));
+            }
+
             T& var_;
             Op op_;
-            boost::shared_array<T> data_;
+            std::shared_ptr<reduction_views<T> > views_;
         };
 
         /// \endcond
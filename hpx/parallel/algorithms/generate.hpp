@@ -13,16 +13,21 @@
 #include <hpx/traits/concepts.hpp>
 #include <hpx/traits/is_iterator.hpp>
 #include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/philox_engine.hpp>
 
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
 #include <hpx/parallel/algorithms/detail/is_negative.hpp>
 #include <hpx/parallel/algorithms/for_each.hpp>
 #include <hpx/parallel/execution_policy.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/foreach_partitioner.hpp>
 #include <hpx/parallel/util/projection_identity.hpp>
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <type_traits>
 #include <utility>
@@ -288,6 +293,236 @@ namespace hpx { namespace parallel { inline namespace v1
             std::forward<ExPolicy>(policy), is_seq(),
             first, std::size_t(count), std::forward<F>(f));
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // generate using a counter based random number generator
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // Creates the value of the element at the given position from an
+        // engine whose stream is the (global) position of the element.
+        template <typename F>
+        struct random_generator
+        {
+            std::uint64_t seed_;
+            std::uint64_t offset_;
+            F f_;
+
+            template <typename T>
+            HPX_HOST_DEVICE HPX_FORCEINLINE
+            void operator()(T& value, std::size_t index)
+            {
+                hpx::util::philox_engine engine(seed_, offset_ + index);
+                value = hpx::util::invoke(f_, engine);
+            }
+
+            template <typename Archive>
+            void serialize(Archive& ar, unsigned)
+            {
+                ar & seed_ & offset_ & f_;
+            }
+        };
+
+        template <typename F>
+        random_generator<typename hpx::util::decay<F>::type>
+        make_random_generator(std::uint64_t seed, F && f)
+        {
+            return random_generator<typename hpx::util::decay<F>::type>{
+                seed, 0, std::forward<F>(f)};
+        }
+
+        template <typename FwdIter>
+        struct generate_random
+          : public detail::algorithm<generate_random<FwdIter>, FwdIter>
+        {
+            generate_random()
+              : generate_random::algorithm("generate_random")
+            {}
+
+            template <typename ExPolicy, typename InIter, typename Gen>
+            static InIter
+            sequential(ExPolicy, InIter first, std::size_t count, Gen && gen)
+            {
+                for (std::size_t i = 0; i != count; ++i, ++first)
+                    gen(*first, i);
+                return first;
+            }
+
+            template <typename ExPolicy, typename Iter, typename Gen>
+            static typename util::detail::algorithm_result<
+                ExPolicy, Iter
+            >::type
+            parallel(ExPolicy && policy, Iter first, std::size_t count,
+                Gen && gen)
+            {
+                if (count == 0)
+                {
+                    return util::detail::algorithm_result<
+                            ExPolicy, Iter
+                        >::get(std::move(first));
+                }
+
+                // the values depend on the position of the elements only,
+                // the partitioning does not influence the result
+                return util::foreach_partitioner<ExPolicy>::call(
+                    std::forward<ExPolicy>(policy), first, count,
+                    [HPX_CAPTURE_FORWARD(gen)](Iter part_begin,
+                        std::size_t part_size, std::size_t part_index)
+                        mutable
+                    {
+                        for (std::size_t i = 0; i != part_size;
+                             ++i, ++part_begin)
+                        {
+                            gen(*part_begin, part_index + i);
+                        }
+                    },
+                    util::projection_identity());
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // non-segmented implementation
+        template <typename ExPolicy, typename FwdIter, typename F>
+        inline typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        generate_random_(ExPolicy && policy, FwdIter first, FwdIter last,
+            random_generator<F> && gen, std::false_type)
+        {
+            typedef parallel::execution::is_sequenced_execution_policy<
+                    ExPolicy
+                > is_seq;
+
+            return detail::generate_random<FwdIter>().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first, std::size_t(std::distance(first, last)),
+                std::move(gen));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename FwdIter, typename F>
+        inline typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        generate_random_(ExPolicy && policy, FwdIter first, FwdIter last,
+            random_generator<F> && gen, std::true_type);
+
+        /// \endcond
+    }
+
+    /// Assign each element in range [first, last) a random value created by
+    /// the given function object \a f from a counter based random number
+    /// engine. The engine passed to \a f for the element at position \a i
+    /// of the range is \a hpx::util::philox_engine(seed, i), independently
+    /// of the execution policy. Unlike \a generate used with a (shared)
+    /// conventional engine, the result is reproducible for parallel
+    /// execution and the elements can be processed without synchronization.
+    ///
+    /// \note   Complexity: Exactly \a distance(first, last)
+    ///                     invocations of \a f and assignments.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it executes the assignments.
+    /// \tparam FwdIter     The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     forward iterator.
+    /// \tparam F           The type of the function/function object to use
+    ///                     (deduced). \a F must meet the requirements of
+    ///                     \a CopyConstructible.
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param seed         The seed identifying the random sequences to use.
+    /// \param f            generator function that will be called. signature of
+    ///                     function should be equivalent to the following:
+    ///                     \code
+    ///                     Ret fun(hpx::util::philox_engine& engine);
+    ///                     \endcode \n
+    ///                     The type \a Ret must be such that an object of type
+    ///                     \a FwdIter can be dereferenced and assigned a value
+    ///                     of type \a Ret.
+    ///
+    /// The assignments in the parallel \a generate algorithm invoked with an
+    /// execution policy object of type \a sequenced_policy
+    /// execute in sequential order in the calling thread.
+    ///
+    /// The assignments in the parallel \a generate algorithm invoked with
+    /// an execution policy object of type \a parallel_policy or
+    /// \a parallel_task_policy are permitted to execute in an unordered
+    /// fashion in unspecified threads, and indeterminately sequenced
+    /// within each thread.
+    ///
+    /// \returns  The \a generate algorithm returns a \a hpx::future<FwdIter>
+    ///           if the execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy
+    ///           and returns \a FwdIter otherwise.
+    ///           It returns \a last.
+    ///
+    template <typename ExPolicy, typename FwdIter, typename F,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<FwdIter>::value)>
+    typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+    generate(ExPolicy && policy, FwdIter first, FwdIter last,
+        std::uint64_t seed, F && f)
+    {
+        static_assert(
+            (hpx::traits::is_forward_iterator<FwdIter>::value),
+            "Required at least forward iterator.");
+
+        typedef hpx::traits::is_segmented_iterator<FwdIter> is_segmented;
+
+        return detail::generate_random_(
+            std::forward<ExPolicy>(policy), first, last,
+            detail::make_random_generator(seed, std::forward<F>(f)),
+            is_segmented());
+    }
+
+    /// Assigns each element in range [first, first+count) a random value
+    /// created by the given function object \a f from a counter based random
+    /// number engine, see \a generate. The engine passed to \a f for the
+    /// element at position \a i is \a hpx::util::philox_engine(seed, i).
+    ///
+    /// \note   Complexity: Exactly \a count invocations of \a f and
+    ///         assignments, for count > 0.
+    ///
+    /// \returns  The \a generate_n algorithm returns a
+    ///           \a hpx::future<FwdIter> if the execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy
+    ///           and returns \a FwdIter otherwise.
+    ///           It returns \a first + \a count.
+    ///
+    template <typename ExPolicy, typename FwdIter, typename Size, typename F,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<FwdIter>::value)>
+    typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+    generate_n(ExPolicy && policy, FwdIter first, Size count,
+        std::uint64_t seed, F && f)
+    {
+        static_assert(
+            (hpx::traits::is_forward_iterator<FwdIter>::value),
+            "Required at least forward iterator.");
+
+        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+        if (detail::is_negative(count))
+        {
+            return util::detail::algorithm_result<ExPolicy, FwdIter>::get(
+                std::move(first));
+        }
+
+        return detail::generate_random<FwdIter>().call(
+            std::forward<ExPolicy>(policy), is_seq(),
+            first, std::size_t(count),
+            detail::make_random_generator(seed, std::forward<F>(f)));
+    }
 }}}
 
 #endif
@@ -0,0 +1,768 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/algorithms/histogram.hpp
+
+#if !defined(HPX_PARALLEL_ALGORITHM_HISTOGRAM_HPP)
+#define HPX_PARALLEL_ALGORITHM_HISTOGRAM_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/traits/concepts.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/algorithms/for_loop.hpp>
+#include <hpx/parallel/algorithms/for_loop_reduction.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/executors/execution_information.hpp>
+#include <hpx/parallel/traits/projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // histogram
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // combine the bins of two (partial) histograms
+        struct add_histogram_bins
+        {
+            std::vector<std::size_t> operator()(std::vector<std::size_t> lhs,
+                std::vector<std::size_t> const& rhs) const
+            {
+                HPX_ASSERT(lhs.size() == rhs.size());
+                for (std::size_t i = 0; i != lhs.size(); ++i)
+                    lhs[i] += rhs[i];
+                return lhs;
+            }
+        };
+
+        // count the element referred to by the iterator in its bin
+        template <typename F, typename Proj>
+        struct histogram_iteration
+        {
+            typename hpx::util::decay<F>::type f_;
+            typename hpx::util::decay<Proj>::type proj_;
+            std::size_t num_bins_;
+
+            template <typename Iter>
+            HPX_FORCEINLINE void operator()(Iter it,
+                std::vector<std::size_t>& bins)
+            {
+                std::size_t bin = hpx::util::invoke(f_,
+                    hpx::util::invoke(proj_, *it));
+                if (bin < num_bins_)
+                    ++bins[bin];
+            }
+        };
+
+        // Every worker thread accumulates into its own copy of the bins, the
+        // copies are merged once all elements have been counted.
+        template <typename ExPolicy, typename FwdIter, typename Iteration>
+        std::vector<std::size_t>
+        parallel_histogram(ExPolicy && policy, FwdIter first, FwdIter last,
+            std::size_t num_bins, Iteration && iteration, std::false_type)
+        {
+            std::vector<std::size_t> bins(num_bins, 0);
+            v2::for_loop(std::forward<ExPolicy>(policy), first, last,
+                v2::reduction(bins, std::vector<std::size_t>(num_bins, 0),
+                    add_histogram_bins()),
+                std::forward<Iteration>(iteration));
+            return bins;
+        }
+
+        template <typename ExPolicy, typename FwdIter, typename Iteration>
+        hpx::future<std::vector<std::size_t> >
+        parallel_histogram(ExPolicy && policy, FwdIter first, FwdIter last,
+            std::size_t num_bins, Iteration && iteration, std::true_type)
+        {
+            // the bins have to stay alive until the reduction has finished
+            std::shared_ptr<std::vector<std::size_t> > bins =
+                std::make_shared<std::vector<std::size_t> >(num_bins, 0);
+
+            return v2::for_loop(std::forward<ExPolicy>(policy), first, last,
+                v2::reduction(*bins, std::vector<std::size_t>(num_bins, 0),
+                    add_histogram_bins()),
+                std::forward<Iteration>(iteration)).then(
+                    [bins](hpx::future<void> && f) -> std::vector<std::size_t>
+                    {
+                        f.get();    // rethrow exceptions
+                        return std::move(*bins);
+                    });
+        }
+
+        struct histogram
+          : public detail::algorithm<histogram, std::vector<std::size_t> >
+        {
+            histogram()
+              : histogram::algorithm("histogram")
+            {}
+
+            template <typename ExPolicy, typename InIter, typename F,
+                typename Proj>
+            static std::vector<std::size_t>
+            sequential(ExPolicy, InIter first, InIter last,
+                std::size_t num_bins, F && f, Proj && proj)
+            {
+                std::vector<std::size_t> bins(num_bins, 0);
+                histogram_iteration<F, Proj> iteration{
+                    std::forward<F>(f), std::forward<Proj>(proj), num_bins
+                };
+                for (/**/; first != last; ++first)
+                    iteration(first, bins);
+                return bins;
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename F,
+                typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::vector<std::size_t>
+            >::type
+            parallel(ExPolicy && policy, FwdIter first, FwdIter last,
+                std::size_t num_bins, F && f, Proj && proj)
+            {
+                typedef execution::is_async_execution_policy<ExPolicy>
+                    is_async;
+
+                return parallel_histogram(std::forward<ExPolicy>(policy),
+                    first, last, num_bins,
+                    histogram_iteration<F, Proj>{
+                        std::forward<F>(f), std::forward<Proj>(proj), num_bins
+                    },
+                    is_async());
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // store the bins into the output sequence
+        template <typename OutIter>
+        OutIter get_histogram(std::vector<std::size_t> && bins, OutIter dest)
+        {
+            return std::copy(bins.begin(), bins.end(), dest);
+        }
+
+        template <typename OutIter>
+        hpx::future<OutIter>
+        get_histogram(hpx::future<std::vector<std::size_t> > && bins,
+            OutIter dest)
+        {
+            return bins.then(
+                [dest](hpx::future<std::vector<std::size_t> > && f) -> OutIter
+                {
+                    std::vector<std::size_t> bins = f.get();
+                    return std::copy(bins.begin(), bins.end(), dest);
+                });
+        }
+
+        // non-segmented implementation
+        template <typename ExPolicy, typename FwdIter, typename OutIter,
+            typename F, typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+        histogram_(ExPolicy && policy, FwdIter first, FwdIter last,
+            OutIter dest, std::size_t num_bins, F && f, Proj && proj,
+            std::false_type)
+        {
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+            return get_histogram(
+                detail::histogram().call(std::forward<ExPolicy>(policy),
+                    is_seq(), first, last, num_bins, std::forward<F>(f),
+                    std::forward<Proj>(proj)),
+                dest);
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter, typename OutIter,
+            typename F, typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+        histogram_(ExPolicy && policy, FwdIter first, FwdIter last,
+            OutIter dest, std::size_t num_bins, F && f, Proj && proj,
+            std::true_type);
+
+        ///////////////////////////////////////////////////////////////////////
+        // find the bucket of a value given the sorted bucket boundaries
+        template <typename T, typename Compare>
+        struct bucket_index
+        {
+            std::vector<T> bounds_;
+            Compare comp_;
+
+            template <typename U>
+            std::size_t operator()(U const& value) const
+            {
+                return std::size_t(
+                    std::upper_bound(bounds_.begin(), bounds_.end(), value,
+                        comp_) - bounds_.begin());
+            }
+
+            template <typename Archive>
+            void serialize(Archive& ar, unsigned)
+            {
+                ar & bounds_ & comp_;
+            }
+        };
+        /// \endcond
+    }
+
+    /// Counts the elements in the range [first, last) by the bins they fall
+    /// into. The bin of an element is the value returned by \a f for its
+    /// (projected) value. Elements for which \a f returns a bin outside of
+    /// [0, \a num_bins) are not counted.
+    ///
+    /// \note   Complexity: Performs exactly \a last - \a first applications of
+    ///         the function \a f and the projection \a proj.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it executes the assignments.
+    /// \tparam FwdIter     The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of an
+    ///                     forward iterator.
+    /// \tparam OutIter     The type of the iterator representing the
+    ///                     destination range (deduced).
+    ///                     This iterator type must meet the requirements of an
+    ///                     output iterator.
+    /// \tparam F           The type of the function/function object to use
+    ///                     (deduced). Unlike its sequential form, the parallel
+    ///                     overload of \a histogram requires \a F to meet the
+    ///                     requirements of \a CopyConstructible.
+    /// \tparam Proj        The type of an optional projection function. This
+    ///                     defaults to \a util::projection_identity
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param dest         Refers to the beginning of the destination range
+    ///                     the \a num_bins counts are written to.
+    /// \param num_bins     The number of bins of the histogram.
+    /// \param f            Specifies the function (or function object) which
+    ///                     will be invoked for each of the elements in the
+    ///                     sequence specified by [first, last). It returns the
+    ///                     bin the element belongs to. The signature of this
+    ///                     function should be equivalent to:
+    ///                     \code
+    ///                     std::size_t f(const Type &a);
+    ///                     \endcode \n
+    ///                     The signature does not need to have const&, but
+    ///                     the function must not modify the objects passed to
+    ///                     it. The type \a Type must be such that an object of
+    ///                     type \a FwdIter can be dereferenced and then
+    ///                     implicitly converted to Type.
+    /// \param proj         Specifies the function (or function object) which
+    ///                     will be invoked for each of the elements as a
+    ///                     projection operation before the function \a f is
+    ///                     invoked.
+    ///
+    /// The parallel \a histogram algorithm counts into separate bins for
+    /// each of the worker threads, those are merged once all elements are
+    /// counted. This avoids any synchronization between the threads.
+    ///
+    /// \note The invocations of \a f in the parallel \a histogram algorithm
+    ///       invoked with an execution policy object of type
+    ///       \a sequenced_policy execute in sequential order in the calling
+    ///       thread.
+    /// \note The invocations of \a f in the parallel \a histogram algorithm
+    ///       invoked with an execution policy object of type
+    ///       \a parallel_policy or \a parallel_task_policy are permitted to
+    ///       execute in an unordered fashion in unspecified threads, and
+    ///       indeterminately sequenced within each thread.
+    ///
+    /// \returns  The \a histogram algorithm returns a \a hpx::future<OutIter>
+    ///           if the execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and
+    ///           returns \a OutIter otherwise.
+    ///           The \a histogram algorithm returns the output iterator to
+    ///           the element in the destination range, one past the last
+    ///           bin written.
+    ///
+    template <typename ExPolicy, typename FwdIter, typename OutIter,
+        typename F, typename Proj = util::projection_identity,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<FwdIter>::value &&
+        hpx::traits::is_iterator<OutIter>::value &&
+        traits::is_projected<Proj, FwdIter>::value &&
+        traits::is_indirect_callable<
+            ExPolicy, F, traits::projected<Proj, FwdIter>
+        >::value)>
+    typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+    histogram(ExPolicy && policy, FwdIter first, FwdIter last, OutIter dest,
+        std::size_t num_bins, F && f, Proj && proj = Proj())
+    {
+        static_assert(
+            (hpx::traits::is_forward_iterator<FwdIter>::value),
+            "Requires at least forward iterator.");
+        static_assert(
+            (hpx::traits::is_output_iterator<OutIter>::value ||
+                hpx::traits::is_forward_iterator<OutIter>::value),
+            "Requires at least output iterator.");
+
+        typedef hpx::traits::is_segmented_iterator<FwdIter> is_segmented;
+
+        return detail::histogram_(std::forward<ExPolicy>(policy), first, last,
+            dest, num_bins, std::forward<F>(f), std::forward<Proj>(proj),
+            is_segmented());
+    }
+
+    /// Counts the elements in the range [first, last) by the buckets they
+    /// fall into. The buckets are given by the sorted sequence of
+    /// boundaries [bounds_first, bounds_last): an element (after
+    /// projection) falls into the bucket \a i if it is not less than the
+    /// boundary \a i-1 and less than the boundary \a i. This writes one
+    /// count more than there are boundaries, the first and the last count
+    /// are the number of elements below the first and not below the last
+    /// boundary.
+    ///
+    /// \note   Complexity: Performs O((\a last - \a first) *
+    ///         log(\a bounds_last - \a bounds_first)) comparisons.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it executes the assignments.
+    /// \tparam FwdIter1    The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of an
+    ///                     forward iterator.
+    /// \tparam FwdIter2    The type of the iterators referring to the bucket
+    ///                     boundaries (deduced). This iterator type must
+    ///                     meet the requirements of an forward iterator.
+    /// \tparam OutIter     The type of the iterator representing the
+    ///                     destination range (deduced).
+    ///                     This iterator type must meet the requirements of an
+    ///                     output iterator.
+    /// \tparam Compare     The type of the function/function object to use
+    ///                     (deduced). Unlike its sequential form, the parallel
+    ///                     overload of \a bucketize requires \a Compare to meet
+    ///                     the requirements of \a CopyConstructible. This
+    ///                     defaults to std::less<>
+    /// \tparam Proj        The type of an optional projection function. This
+    ///                     defaults to \a util::projection_identity
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param bounds_first Refers to the beginning of the sorted sequence of
+    ///                     bucket boundaries.
+    /// \param bounds_last  Refers to the end of the sorted sequence of
+    ///                     bucket boundaries.
+    /// \param dest         Refers to the beginning of the destination range
+    ///                     the counts are written to.
+    /// \param comp         comp is a callable object which returns true if
+    ///                     the first argument is less than the second.
+    /// \param proj         Specifies the function (or function object) which
+    ///                     will be invoked for each of the elements as a
+    ///                     projection operation before the comparisons are
+    ///                     invoked.
+    ///
+    /// \note The comparisons in the parallel \a bucketize algorithm
+    ///       invoked with an execution policy object of type
+    ///       \a sequenced_policy execute in sequential order in the calling
+    ///       thread.
+    /// \note The comparisons in the parallel \a bucketize algorithm
+    ///       invoked with an execution policy object of type
+    ///       \a parallel_policy or \a parallel_task_policy are permitted to
+    ///       execute in an unordered fashion in unspecified threads, and
+    ///       indeterminately sequenced within each thread.
+    ///
+    /// \returns  The \a bucketize algorithm returns a \a hpx::future<OutIter>
+    ///           if the execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and
+    ///           returns \a OutIter otherwise.
+    ///           The \a bucketize algorithm returns the output iterator to
+    ///           the element in the destination range, one past the last
+    ///           count written.
+    ///
+    template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+        typename OutIter, typename Compare = detail::less,
+        typename Proj = util::projection_identity,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<FwdIter1>::value &&
+        hpx::traits::is_iterator<FwdIter2>::value &&
+        hpx::traits::is_iterator<OutIter>::value &&
+        traits::is_projected<Proj, FwdIter1>::value)>
+    typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+    bucketize(ExPolicy && policy, FwdIter1 first, FwdIter1 last,
+        FwdIter2 bounds_first, FwdIter2 bounds_last, OutIter dest,
+        Compare && comp = Compare(), Proj && proj = Proj())
+    {
+        static_assert(
+            (hpx::traits::is_forward_iterator<FwdIter1>::value),
+            "Requires at least forward iterator.");
+        static_assert(
+            (hpx::traits::is_forward_iterator<FwdIter2>::value),
+            "Requires at least forward iterator.");
+        static_assert(
+            (hpx::traits::is_output_iterator<OutIter>::value ||
+                hpx::traits::is_forward_iterator<OutIter>::value),
+            "Requires at least output iterator.");
+
+        typedef typename std::iterator_traits<FwdIter2>::value_type bound_type;
+        typedef detail::bucket_index<
+                bound_type, typename hpx::util::decay<Compare>::type
+            > bucket_index_type;
+
+        typedef hpx::traits::is_segmented_iterator<FwdIter1> is_segmented;
+
+        // the boundaries are copied as they might have to be sent to
+        // other localities
+        std::vector<bound_type> bounds(bounds_first, bounds_last);
+        std::size_t num_bins = bounds.size() + 1;
+
+        return detail::histogram_(std::forward<ExPolicy>(policy), first, last,
+            dest, num_bins,
+            bucket_index_type{std::move(bounds), std::forward<Compare>(comp)},
+            std::forward<Proj>(proj), is_segmented());
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // group_by
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // minimal number of elements handled by a single task
+        HPX_STATIC_CONSTEXPR std::size_t group_by_min_chunk_size = 16384ul;
+
+        // invoke f for all chunks concurrently
+        template <typename ExPolicy, typename F>
+        void group_by_for_each_chunk(ExPolicy& policy, std::size_t num_chunks,
+            F const& f)
+        {
+            std::vector<hpx::future<void> > chunks;
+            chunks.reserve(num_chunks);
+            for (std::size_t c = 0; c != num_chunks; ++c)
+            {
+                chunks.push_back(execution::async_execute(
+                    policy.executor(), [&f, c]() { f(c); }));
+            }
+            hpx::wait_all(chunks);
+
+            std::list<std::exception_ptr> errors;
+            util::detail::handle_local_exceptions<ExPolicy>::call(
+                chunks, errors);
+        }
+
+        // Copy the elements to their groups, this is a stable counting
+        // sort: every chunk of the input counts the elements of each group,
+        // the per-chunk counts are then turned into the positions the chunks
+        // are copying their elements to.
+        template <typename ExPolicy, typename FwdIter, typename RandIter,
+            typename OutIter, typename F, typename Proj>
+        std::pair<RandIter, OutIter>
+        parallel_group_by(ExPolicy policy, FwdIter first, FwdIter last,
+            RandIter dest, OutIter offsets, std::size_t num_groups, F f,
+            Proj proj)
+        {
+            std::size_t const count = std::distance(first, last);
+
+            std::size_t const cores = execution::processing_units_count(
+                policy.executor(), policy.parameters());
+
+            // every chunk has to handle enough elements to justify the
+            // memory for its counts
+            std::size_t num_chunks = (std::min)(cores,
+                (count + group_by_min_chunk_size - 1) / group_by_min_chunk_size);
+            if (num_groups != 0)
+                num_chunks = (std::min)(num_chunks, count / num_groups);
+            if (num_chunks == 0)
+                num_chunks = 1;
+            std::size_t const chunk_size = (count + num_chunks - 1) / num_chunks;
+
+            std::vector<FwdIter> chunk_first;
+            chunk_first.reserve(num_chunks);
+            for (std::size_t c = 0, pos = 0; c != num_chunks; ++c)
+            {
+                chunk_first.push_back(first);
+                std::size_t n = (std::min)(chunk_size, count - pos);
+                std::advance(first, n);
+                pos += n;
+            }
+
+            auto chunk_count =
+                [count, chunk_size](std::size_t c) -> std::size_t
+                {
+                    std::size_t begin = (std::min)(c * chunk_size, count);
+                    return (std::min)(begin + chunk_size, count) - begin;
+                };
+
+            auto group_of =
+                [&](FwdIter it) -> std::size_t
+                {
+                    return hpx::util::invoke(f, hpx::util::invoke(proj, *it));
+                };
+
+            // count the elements of each group in every chunk
+            std::vector<std::size_t> positions(num_chunks * num_groups, 0);
+            group_by_for_each_chunk(policy, num_chunks,
+                [&](std::size_t c)
+                {
+                    std::size_t* counts = positions.data() + c * num_groups;
+                    FwdIter it = chunk_first[c];
+                    for (std::size_t n = chunk_count(c); n != 0; --n, ++it)
+                    {
+                        std::size_t g = group_of(it);
+                        if (g < num_groups)
+                            ++counts[g];
+                    }
+                });
+
+            // turn the counts into positions, group by group, and chunk by
+            // chunk inside of each group
+            std::size_t pos = 0;
+            for (std::size_t g = 0; g != num_groups; ++g)
+            {
+                *offsets++ = pos;
+                for (std::size_t c = 0; c != num_chunks; ++c)
+                {
+                    std::size_t& offset = positions[c * num_groups + g];
+                    std::size_t const n = offset;
+                    offset = pos;
+                    pos += n;
+                }
+            }
+            *offsets++ = pos;
+
+            // copy the elements
+            group_by_for_each_chunk(policy, num_chunks,
+                [&](std::size_t c)
+                {
+                    std::size_t* next = positions.data() + c * num_groups;
+                    FwdIter it = chunk_first[c];
+                    for (std::size_t n = chunk_count(c); n != 0; --n, ++it)
+                    {
+                        std::size_t g = group_of(it);
+                        if (g < num_groups)
+                            dest[next[g]++] = *it;
+                    }
+                });
+
+            return std::make_pair(dest + pos, offsets);
+        }
+
+        template <typename RandIter, typename OutIter>
+        struct group_by
+          : public detail::algorithm<
+                group_by<RandIter, OutIter>, std::pair<RandIter, OutIter> >
+        {
+            group_by()
+              : group_by::algorithm("group_by")
+            {}
+
+            template <typename ExPolicy, typename InIter, typename F,
+                typename Proj>
+            static std::pair<RandIter, OutIter>
+            sequential(ExPolicy, InIter first, InIter last, RandIter dest,
+                OutIter offsets, std::size_t num_groups, F && f, Proj && proj)
+            {
+                std::vector<std::size_t> positions = histogram::sequential(
+                    execution::seq, first, last, num_groups, f, proj);
+
+                std::size_t pos = 0;
+                for (std::size_t g = 0; g != num_groups; ++g)
+                {
+                    *offsets++ = pos;
+                    std::size_t const n = positions[g];
+                    positions[g] = pos;
+                    pos += n;
+                }
+                *offsets++ = pos;
+
+                for (/**/; first != last; ++first)
+                {
+                    std::size_t g = hpx::util::invoke(f,
+                        hpx::util::invoke(proj, *first));
+                    if (g < num_groups)
+                        dest[positions[g]++] = *first;
+                }
+
+                return std::make_pair(dest + pos, offsets);
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename F,
+                typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::pair<RandIter, OutIter>
+            >::type
+            parallel(ExPolicy && policy, FwdIter first, FwdIter last,
+                RandIter dest, OutIter offsets, std::size_t num_groups,
+                F && f, Proj && proj)
+            {
+                typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+                typedef typename hpx::util::decay<F>::type fun_type;
+                typedef typename hpx::util::decay<Proj>::type proj_type;
+
+                typedef util::detail::algorithm_result<
+                        ExPolicy, std::pair<RandIter, OutIter>
+                    > result;
+
+                return result::get(execution::async_execute(policy.executor(),
+                    &parallel_group_by<
+                        policy_type, FwdIter, RandIter, OutIter, fun_type,
+                        proj_type
+                    >,
+                    policy, first, last, dest, offsets, num_groups,
+                    std::forward<F>(f), std::forward<Proj>(proj)));
+            }
+        };
+        /// \endcond
+    }
+
+    /// Copies the elements in the range [first, last) to the range
+    /// beginning at \a dest, arranged by their groups. The group of an
+    /// element is the value returned by \a f for its (projected) value. The
+    /// elements of the group 0 are copied first, followed by those of the
+    /// group 1 and so on, the relative order of the elements of a group is
+    /// preserved. Elements for which \a f returns a group outside of
+    /// [0, \a num_groups) are not copied. The algorithm writes
+    /// \a num_groups + 1 offsets to the range beginning at \a offsets, the
+    /// elements of the group \a g are stored at the positions
+    /// [offsets[g], offsets[g+1]) of the destination range.
+    ///
+    /// \note   Complexity: Performs exactly 2 * (\a last - \a first)
+    ///         applications of the function \a f and the projection \a proj
+    ///         and at most \a last - \a first assignments.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it executes the assignments.
+    /// \tparam FwdIter     The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of an
+    ///                     forward iterator.
+    /// \tparam RandIter    The type of the iterator representing the
+    ///                     destination range (deduced).
+    ///                     This iterator type must meet the requirements of an
+    ///                     random access iterator.
+    /// \tparam OutIter     The type of the iterator representing the
+    ///                     offsets range (deduced).
+    ///                     This iterator type must meet the requirements of an
+    ///                     output iterator.
+    /// \tparam F           The type of the function/function object to use
+    ///                     (deduced). Unlike its sequential form, the parallel
+    ///                     overload of \a group_by requires \a F to meet the
+    ///                     requirements of \a CopyConstructible.
+    /// \tparam Proj        The type of an optional projection function. This
+    ///                     defaults to \a util::projection_identity
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param dest         Refers to the beginning of the destination range.
+    /// \param offsets      Refers to the beginning of the range the offsets
+    ///                     of the groups are written to.
+    /// \param num_groups   The number of groups.
+    /// \param f            Specifies the function (or function object) which
+    ///                     will be invoked for each of the elements in the
+    ///                     sequence specified by [first, last). It returns the
+    ///                     group the element belongs to. The signature of this
+    ///                     function should be equivalent to:
+    ///                     \code
+    ///                     std::size_t f(const Type &a);
+    ///                     \endcode \n
+    ///                     The signature does not need to have const&, but
+    ///                     the function must not modify the objects passed to
+    ///                     it. The type \a Type must be such that an object of
+    ///                     type \a FwdIter can be dereferenced and then
+    ///                     implicitly converted to Type.
+    /// \param proj         Specifies the function (or function object) which
+    ///                     will be invoked for each of the elements as a
+    ///                     projection operation before the function \a f is
+    ///                     invoked.
+    ///
+    /// \note The assignments in the parallel \a group_by algorithm invoked
+    ///       with an execution policy object of type \a sequenced_policy
+    ///       execute in sequential order in the calling thread.
+    /// \note The assignments in the parallel \a group_by algorithm invoked
+    ///       with an execution policy object of type \a parallel_policy or
+    ///       \a parallel_task_policy are permitted to execute in an unordered
+    ///       fashion in unspecified threads, and indeterminately sequenced
+    ///       within each thread.
+    ///
+    /// \returns  The \a group_by algorithm returns a
+    ///           \a hpx::future<std::pair<RandIter, OutIter> > if the
+    ///           execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and
+    ///           returns \a std::pair<RandIter, OutIter> otherwise.
+    ///           The \a group_by algorithm returns the iterators one past the
+    ///           last element copied to the destination range and one past
+    ///           the last offset written.
+    ///
+    template <typename ExPolicy, typename FwdIter, typename RandIter,
+        typename OutIter, typename F,
+        typename Proj = util::projection_identity,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<FwdIter>::value &&
+        hpx::traits::is_iterator<RandIter>::value &&
+        hpx::traits::is_iterator<OutIter>::value &&
+        traits::is_projected<Proj, FwdIter>::value &&
+        traits::is_indirect_callable<
+            ExPolicy, F, traits::projected<Proj, FwdIter>
+        >::value)>
+    typename util::detail::algorithm_result<
+        ExPolicy, std::pair<RandIter, OutIter>
+    >::type
+    group_by(ExPolicy && policy, FwdIter first, FwdIter last, RandIter dest,
+        OutIter offsets, std::size_t num_groups, F && f,
+        Proj && proj = Proj())
+    {
+        static_assert(
+            (hpx::traits::is_forward_iterator<FwdIter>::value),
+            "Requires at least forward iterator.");
+        static_assert(
+            (hpx::traits::is_random_access_iterator<RandIter>::value),
+            "Requires a random access iterator.");
+        static_assert(
+            (hpx::traits::is_output_iterator<OutIter>::value ||
+                hpx::traits::is_forward_iterator<OutIter>::value),
+            "Requires at least output iterator.");
+
+        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+        return detail::group_by<RandIter, OutIter>().call(
+            std::forward<ExPolicy>(policy), is_seq(), first, last, dest,
+            offsets, num_groups, std::forward<F>(f),
+            std::forward<Proj>(proj));
+    }
+}}}
+
+#endif
@@ -19,8 +19,8 @@
 #include <hpx/parallel/execution_policy.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/loop.hpp>
+#include <hpx/parallel/util/lookback_scan_partitioner.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
-#include <hpx/parallel/util/scan_partitioner.hpp>
 #include <hpx/parallel/util/projection_identity.hpp>
 #include <hpx/util/unused.hpp>
 
@@ -109,64 +109,45 @@ namespace hpx { namespace parallel { inline namespace v1
                 FwdIter2 final_dest = dest;
                 std::advance(final_dest, count);
 
-                // The overall scan algorithm is performed by executing 3
-                // steps. The first calculates the scan results for each
-                // partition. The second accumulates the result from left to
-                // right to be used by the third step--which operates on the
-                // same partitions the first step operated on.
+                // The scan is performed in a single pass over tiles of the
+                // input. The first step calculates the sum of a tile, the
+                // second step writes the final results of the tile as soon
+                // as the sum of all preceding tiles is known (decoupled
+                // look-back).
 
                 using hpx::util::get;
                 using hpx::util::make_zip_iterator;
 
-                auto f3 =
-                    [op, policy](
-                        zip_iterator part_begin, std::size_t part_size,
-                        hpx::shared_future<T> curr, hpx::shared_future<T> next
-                    )
-                    {
-                        HPX_UNUSED(policy);
-
-                        next.get();     // rethrow exceptions
-
-                        T val = curr.get();
-                        FwdIter2 dst = get<1>(part_begin.get_iterator_tuple());
-
-                        // MSVC 2015 fails if op is captured by reference
-                        util::loop_n<ExPolicy>(
-                            dst, part_size,
-                            [=, &val](FwdIter2 it)
-                            {
-                                *it = hpx::util::invoke(op, val, *it);
-                            });
-                    };
-
-                return util::scan_partitioner<ExPolicy, FwdIter2, T>::call(
+                return util::lookback_scan_partitioner<
+                        ExPolicy, FwdIter2, T
+                    >::call(
                     std::forward<ExPolicy>(policy),
                     make_zip_iterator(first, dest), count, init,
-                    // step 1 performs first part of scan algorithm
-                    [op, last, HPX_CAPTURE_FORWARD(conv)](
+                    // step 1 calculates the sum of each tile
+                    [op, conv](
                         zip_iterator part_begin, std::size_t part_size) -> T
                     {
-                        T part_init = hpx::util::invoke(conv, get<0>(*part_begin));
-                        get<1>(*part_begin++) = part_init;
-
-                        auto iters = part_begin.get_iterator_tuple();
-                        if(get<0>(iters) != last)
+                        FwdIter1 it = get<0>(part_begin.get_iterator_tuple());
+                        T sum = hpx::util::invoke(conv, *it);
+                        for (++it; --part_size != 0; ++it)
                         {
-                            return sequential_inclusive_scan_n(get<0>(iters),
-                                part_size - 1, get<1>(iters), part_init, op,
-                                conv);
+                            sum = hpx::util::invoke(
+                                op, sum, hpx::util::invoke(conv, *it));
                         }
-                        return part_init;
+                        return sum;
+                    },
+                    // the sums of the tiles are combined using op
+                    op,
+                    // step 2 writes the results of each tile in one sweep
+                    [op, conv](zip_iterator part_begin,
+                        std::size_t part_size, T const& prefix) -> void
+                    {
+                        auto iters = part_begin.get_iterator_tuple();
+                        sequential_inclusive_scan_n(get<0>(iters), part_size,
+                            get<1>(iters), prefix, op, conv);
                     },
-                    // step 2 propagates the partition results from left
-                    // to right
-                    hpx::util::unwrapping(op),
-                    // step 3 runs final accumulation on each partition
-                    std::move(f3),
-                    // step 4 use this return value
-                    [final_dest](std::vector<hpx::shared_future<T> > &&,
-                        std::vector<hpx::future<void> > &&)
+                    // step 3 use this return value
+                    [final_dest](T const&) -> FwdIter2
                     {
                         return final_dest;
                     });
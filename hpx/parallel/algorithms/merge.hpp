@@ -15,6 +15,7 @@
 
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
 #include <hpx/parallel/algorithms/detail/is_negative.hpp>
+#include <hpx/parallel/algorithms/detail/merge_path.hpp>
 #include <hpx/parallel/algorithms/detail/predicates.hpp>
 #include <hpx/parallel/algorithms/detail/transfer.hpp>
 #include <hpx/parallel/execution_policy.hpp>
@@ -79,171 +80,82 @@ namespace hpx { namespace parallel { inline namespace v1
             return hpx::util::make_tuple(last1, last2, dest);
         }
 
-        struct upper_bound_helper
-        {
-            // upper_bound with projection function.
-            template<typename RandIter, typename Type, typename Comp, typename Proj>
-            static RandIter
-            call(RandIter first, RandIter last, const Type& value,
-                Comp comp, Proj proj)
-            {
-                typedef typename std::iterator_traits<RandIter>::difference_type
-                    difference_type;
-
-                difference_type count = std::distance(first, last);
-
-                while (count > 0)
-                {
-                    difference_type step = count / 2;
-                    RandIter mid = std::next(first, step);
-
-                    if (!hpx::util::invoke(comp,
-                        value,
-                        hpx::util::invoke(proj, *mid)))
-                    {
-                        first = ++mid;
-                        count -= step + 1;
-                    }
-                    else
-                    {
-                        count = step;
-                    }
-                }
-
-                return first;
-            }
-
-            typedef struct lower_bound_helper another_type;
-        };
-
-        struct lower_bound_helper
-        {
-            // lower_bound with projection function.
-            template<typename RandIter, typename Type, typename Comp, typename Proj>
-            static RandIter
-            call(RandIter first, RandIter last, const Type& value,
-                Comp comp, Proj proj)
-            {
-                typedef typename std::iterator_traits<RandIter>::difference_type
-                    difference_type;
-
-                difference_type count = std::distance(first, last);
-
-                while (count > 0)
-                {
-                    difference_type step = count / 2;
-                    RandIter mid = std::next(first, step);
-
-                    if (hpx::util::invoke(comp,
-                        hpx::util::invoke(proj, *mid),
-                        value))
-                    {
-                        first = ++mid;
-                        count -= step + 1;
-                    }
-                    else
-                    {
-                        count = step;
-                    }
-                }
-
-                return first;
-            }
-
-            typedef struct upper_bound_helper another_type;
-        };
+        // The number of elements below which a merge is not split into
+        // several tasks.
+        static const std::size_t merge_limit_per_task = 65536ul;
 
+        // Merge the two ranges into the range starting at dest, returns once
+        // the merge is complete. The merged range is split into partitions of
+        // exactly the same size, one for each core, each of which is merged
+        // by a separate task directly into its place in the destination. The
+        // slices of both input ranges making up a partition are found using
+        // merge path partitioning.
         template <typename ExPolicy,
             typename RandIter1, typename RandIter2, typename RandIter3,
-            typename Comp, typename Proj1, typename Proj2,
-            typename BinarySearchHelper>
+            typename Comp, typename Proj1, typename Proj2>
         void
-        parallel_merge_helper(ExPolicy policy,
+        parallel_merge_helper(ExPolicy& policy,
             RandIter1 first1, RandIter1 last1,
             RandIter2 first2, RandIter2 last2,
-            RandIter3 dest, Comp comp,
-            Proj1 proj1, Proj2 proj2,
-            bool range_reversal, BinarySearchHelper)
+            RandIter3 dest, Comp& comp,
+            Proj1& proj1, Proj2& proj2)
         {
-            const std::size_t threshold = 65536ul;
-            HPX_ASSERT(threshold >= 1ul);
-
             std::size_t size1 = last1 - first1;
             std::size_t size2 = last2 - first2;
+            std::size_t size = size1 + size2;
 
-            // Perform sequential merge if data size is smaller than threshold.
-            if (size1 + size2 <= threshold)
-            {
-                if (range_reversal)
-                {
-                    sequential_merge(first2, first2 + size2,
-                        first1, first1 + size1, dest, comp, proj2, proj1);
-                }
-                else
-                {
-                    sequential_merge(first1, first1 + size1,
-                        first2, first2 + size2, dest, comp, proj1, proj2);
-                }
-                return;
-            }
+            std::size_t num_parts = merge_path_num_partitions(
+                policy, size, merge_limit_per_task);
 
-            // Let size1 is bigger than size2 always.
-            if (size1 < size2)
+            auto merge_part =
+                [&, first1, first2, dest, size1, size2, size, num_parts](
+                    std::size_t part) -> void
+                {
+                    std::size_t diag1 =
+                        merge_path_diagonal(size, part, num_parts);
+                    std::size_t diag2 =
+                        merge_path_diagonal(size, part + 1, num_parts);
+
+                    std::size_t split1 = merge_path_split(first1, size1,
+                        first2, size2, diag1, comp, proj1, proj2);
+                    std::size_t split2 = merge_path_split(first1, size1,
+                        first2, size2, diag2, comp, proj1, proj2);
+
+                    sequential_merge(first1 + split1, first1 + split2,
+                        first2 + (diag1 - split1), first2 + (diag2 - split2),
+                        dest + diag1, comp, proj1, proj2);
+                };
+
+            if (num_parts == 1)
             {
-                // For stability of algorithm, must switch binary search methods
-                //   when swapping size1 and size2.
-                parallel_merge_helper(policy,
-                    first2, last2, first1, last1, dest, comp, proj2, proj1,
-                    !range_reversal,
-                    typename BinarySearchHelper::another_type());
+                merge_part(0);
                 return;
             }
 
-            HPX_ASSERT(size1 >= size2);
-            HPX_ASSERT(size1 >= 1ul);
-
-            RandIter1 mid1 = first1 + size1 / 2;
-            RandIter2 boundary2 = BinarySearchHelper::call(
-                first2, last2, hpx::util::invoke(proj1, *mid1), comp, proj2);
-            RandIter3 target = dest + (mid1 - first1) + (boundary2 - first2);
-
-            *target = *mid1;
+            std::vector<hpx::future<void>> futures;
+            futures.reserve(num_parts);
 
-            hpx::future<void> fut = execution::async_execute(policy.executor(),
-                [&]() -> void
+            try {
+                for (std::size_t part = 1; part != num_parts; ++part)
                 {
-                    // Process leftside ranges.
-                    parallel_merge_helper(policy,
-                        first1, mid1, first2, boundary2,
-                        dest, comp, proj1, proj2,
-                        range_reversal, BinarySearchHelper());
-                });
+                    futures.push_back(execution::async_execute(
+                        policy.executor(), merge_part, part));
+                }
 
-            try {
-                // Process rightside ranges.
-                parallel_merge_helper(policy,
-                    mid1 + 1, last1, boundary2, last2,
-                    target + 1, comp, proj1, proj2,
-                    range_reversal, BinarySearchHelper());
+                // the first partition is merged by this thread
+                merge_part(0);
             }
             catch (...) {
-                fut.wait();
-
-                std::vector<hpx::future<void>> futures(2);
-                futures[0] = std::move(fut);
-                futures[1] = hpx::make_exceptional_future<void>(
-                    std::current_exception());
-
-                std::list<std::exception_ptr> errors;
-                util::detail::handle_local_exceptions<ExPolicy>::call(
-                    futures, errors);
-
-                // Not reachable.
-                HPX_ASSERT(false);
-                return;
+                futures.push_back(hpx::make_exceptional_future<void>(
+                    std::current_exception()));
             }
 
-            fut.get();
+            for (hpx::future<void>& f : futures)
+                f.wait();
+
+            std::list<std::exception_ptr> errors;
+            util::detail::handle_local_exceptions<ExPolicy>::call(
+                futures, errors);
         }
 
         template <typename ExPolicy,
@@ -272,10 +184,9 @@ namespace hpx { namespace parallel { inline namespace v1
                         Proj1_& proj1, Proj2_& proj2) -> result_type
                     {
                         try {
-                            parallel_merge_helper(
-                                std::move(policy), first1, last1, first2, last2, dest,
-                                std::move(comp), std::move(proj1), std::move(proj2),
-                                false, lower_bound_helper());
+                            parallel_merge_helper(policy,
+                                first1, last1, first2, last2, dest,
+                                comp, proj1, proj2);
 
                             return hpx::util::make_tuple(last1, last2,
                                 dest + (last1 - first1) + (last2 - first2));
@@ -549,126 +460,69 @@ namespace hpx { namespace parallel { inline namespace v1
             RandIter first, RandIter middle, RandIter last,
             Comp && comp, Proj && proj)
         {
-            const std::size_t threshold = 65536ul;
-            HPX_ASSERT(threshold >= 5ul);
-
             std::size_t left_size = middle - first;
             std::size_t right_size = last - middle;
+            std::size_t size = left_size + right_size;
 
             // Perform sequential inplace_merge
             //   if data size is smaller than threshold.
-            if (left_size + right_size <= threshold)
+            if (size <= merge_limit_per_task)
             {
                 sequential_inplace_merge(first, middle, last,
                     std::forward<Comp>(comp), std::forward<Proj>(proj));
                 return;
             }
 
-            if (left_size >= right_size)
-            {
-                // Means that always 'pivot' < 'middle'.
-                HPX_ASSERT(left_size >= 3ul);
-
-                // Select pivot in left-side range.
-                RandIter pivot = first + left_size / 2;
-                RandIter boundary = lower_bound_helper::call(
-                    middle, last, hpx::util::invoke(proj, *pivot), comp, proj);
-                RandIter target = pivot + (boundary - middle);
-
-                // Swap two blocks, [pivot, middle) and [middle, boundary).
-                // After this, [first, last) will be divided into three blocks,
-                //   [first, target), target, and [target+1, last).
-                // And all elements of [first, target) are less than
-                //   the thing of target.
-                // And all elements of [target+1, last) are greater or equal than
-                //   the thing of target.
-                std::rotate(pivot, middle, boundary);
-
-                hpx::future<void> fut = execution::async_execute(
-                    policy.executor(),
-                    [&]() -> void
-                    {
-                        // Process the range which is left-side of 'target'.
-                        parallel_inplace_merge_helper(policy,
-                            first, pivot, target, comp, proj);
-                    });
-
-                try {
-                    // Process the range which is right-side of 'target'.
+            // Split the merged range into two halves of the same size using
+            //   merge path partitioning: [first, left_mid) and
+            //   [middle, right_mid) form the left half.
+            std::size_t diag = size / 2;
+            std::size_t split = merge_path_split(
+                first, left_size, middle, right_size, diag, comp, proj, proj);
+
+            RandIter left_mid = first + split;
+            RandIter right_mid = middle + (diag - split);
+            RandIter target = first + diag;
+
+            // Swap two blocks, [left_mid, middle) and [middle, right_mid).
+            // After this, [first, target) holds both ranges of the left half
+            //   and [target, last) both ranges of the right half, all
+            //   elements of the left half merge before those of the right
+            //   half.
+            std::rotate(left_mid, middle, right_mid);
+
+            hpx::future<void> fut = execution::async_execute(
+                policy.executor(),
+                [&]() -> void
+                {
+                    // Process the left half.
                     parallel_inplace_merge_helper(policy,
-                        target + 1, boundary, last, comp, proj);
-                }
-                catch (...) {
-                    fut.wait();
-
-                    std::vector<hpx::future<void>> futures(2);
-                    futures[0] = std::move(fut);
-                    futures[1] = hpx::make_exceptional_future<void>(
-                        std::current_exception());
-
-                    std::list<std::exception_ptr> errors;
-                    util::detail::handle_local_exceptions<ExPolicy>::call(
-                        futures, errors);
+                        first, left_mid, target, comp, proj);
+                });
 
-                    // Not reachable.
-                    HPX_ASSERT(false);
-                }
-                if (fut.valid()) // NOLINT
-                    fut.get();
+            try {
+                // Process the right half.
+                parallel_inplace_merge_helper(policy,
+                    target, right_mid, last, comp, proj);
             }
-            else /* left_size < right_size */
-            {
-                // Means that always 'pivot' < 'last'.
-                HPX_ASSERT(right_size >= 3ul);
-
-                // Select pivot in right-side range.
-                RandIter pivot = middle + right_size / 2;
-                RandIter boundary = upper_bound_helper::call(
-                    first, middle, hpx::util::invoke(proj, *pivot), comp, proj);
-                RandIter target = boundary + (pivot - middle);
-
-                // Swap two blocks, [boundary, middle) and [middle, pivot+1).
-                // After this, [first, last) will be divided into three blocks,
-                //   [first, target), target, and [target+1, last).
-                // And all elements of [first, target) are less than
-                //   the thing of target.
-                // And all elements of [target+1, last) are greater or equal than
-                //   the thing of target.
-                std::rotate(boundary, middle, pivot + 1);
-
-                hpx::future<void> fut = execution::async_execute(
-                    policy.executor(),
-                    [&]() -> void
-                    {
-                        // Process the range which is left-side of 'target'.
-                        parallel_inplace_merge_helper(policy,
-                            first, boundary, target, comp, proj);
-                    });
-
-                try {
-                    // Process the range which is right-side of 'target'.
-                    parallel_inplace_merge_helper(policy,
-                        target + 1, pivot + 1, last, comp, proj);
-                }
-                catch (...) {
-                    fut.wait();
-
-                    std::vector<hpx::future<void>> futures(2);
-                    futures[0] = std::move(fut);
-                    futures[1] = hpx::make_exceptional_future<void>(
-                        std::current_exception());
+            catch (...) {
+                fut.wait();
 
-                    std::list<std::exception_ptr> errors;
-                    util::detail::handle_local_exceptions<ExPolicy>::call(
-                        futures, errors);
+                std::vector<hpx::future<void>> futures(2);
+                futures[0] = std::move(fut);
+                futures[1] = hpx::make_exceptional_future<void>(
+                    std::current_exception());
 
-                    // Not reachable.
-                    HPX_ASSERT(false);
-                }
+                std::list<std::exception_ptr> errors;
+                util::detail::handle_local_exceptions<ExPolicy>::call(
+                    futures, errors);
 
-                if (fut.valid()) // NOLINT
-                    fut.get();
+                // Not reachable.
+                HPX_ASSERT(false);
             }
+
+            if (fut.valid()) // NOLINT
+                fut.get();
         }
 
         template <typename ExPolicy, typename RandIter, typename Comp,
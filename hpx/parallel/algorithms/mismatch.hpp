@@ -15,6 +15,7 @@
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
 #include <hpx/parallel/algorithms/detail/predicates.hpp>
 #include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/util/cancellation_token.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/loop.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
@@ -34,6 +35,76 @@ namespace hpx { namespace parallel { inline namespace v1
     namespace detail
     {
         /// \cond NOINTERNAL
+
+        // Search the given partition for the first pair of elements which
+        // does not satisfy the predicate and record its index in the
+        // cancellation token.
+        template <typename ExPolicy, typename ZipIter, typename Token,
+            typename F>
+        void mismatch_partition(std::false_type, ZipIter it,
+            std::size_t part_count, std::size_t base_idx, Token& tok, F && f)
+        {
+            typedef typename std::iterator_traits<ZipIter>::reference
+                reference;
+
+            util::loop_idx_n(
+                base_idx, it, part_count, tok,
+                [&f, &tok](reference t, std::size_t i)
+                {
+                    if (!hpx::util::invoke(f,
+                            hpx::util::get<0>(t), hpx::util::get<1>(t)))
+                    {
+                        tok.cancel(i);
+                    }
+                });
+        }
+
+        // vector-pack execution policies compare the partition in blocks of
+        // cancellation_poll_interval elements, checking the token in between
+        template <typename ExPolicy, typename ZipIter, typename Token,
+            typename F>
+        void mismatch_partition(std::true_type, ZipIter it,
+            std::size_t part_count, std::size_t base_idx, Token& tok, F && f)
+        {
+            auto iters = it.get_iterator_tuple();
+            auto first1 = hpx::util::get<0>(iters);
+            auto first2 = hpx::util::get<1>(iters);
+
+            while (part_count != 0 && !tok.was_cancelled(base_idx))
+            {
+                std::size_t n =
+                    (std::min)(part_count, util::cancellation_poll_interval);
+
+                auto last1 = std::next(first1, n);
+                auto p = util::find_first2<ExPolicy>(first1, last1, first2,
+                    invoke_not_indirect<F>{f});
+
+                if (p.first != last1)
+                {
+                    tok.cancel(base_idx + std::distance(first1, p.first));
+                    return;
+                }
+
+                first1 = last1;
+                std::advance(first2, n);
+                part_count -= n;
+                base_idx += n;
+            }
+        }
+
+        template <typename ExPolicy, typename ZipIter, typename Token,
+            typename F>
+        void mismatch_partition(ZipIter it, std::size_t part_count,
+            std::size_t base_idx, Token& tok, F && f)
+        {
+            typedef execution::is_vectorpack_execution_policy<ExPolicy>
+                is_vectorpack;
+
+            mismatch_partition<ExPolicy>(is_vectorpack(), it, part_count,
+                base_idx, tok, std::forward<F>(f));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
         template <typename InIter1, typename InIter2, typename F>
         std::pair<InIter1, InIter2>
         sequential_mismatch_binary(InIter1 first1, InIter1 last1,
@@ -97,7 +168,6 @@ namespace hpx { namespace parallel { inline namespace v1
                 }
 
                 typedef hpx::util::zip_iterator<FwdIter1, FwdIter2> zip_iterator;
-                typedef typename zip_iterator::reference reference;
 
                 util::cancellation_token<std::size_t> tok(count1);
 
@@ -110,17 +180,8 @@ namespace hpx { namespace parallel { inline namespace v1
                             std::size_t base_idx
                         ) mutable -> void
                         {
-                            util::loop_idx_n(
-                                base_idx, it, part_count, tok,
-                                [&f, &tok](reference t, std::size_t i)
-                                {
-                                    if (!hpx::util::invoke(f,
-                                            hpx::util::get<0>(t),
-                                            hpx::util::get<1>(t)))
-                                    {
-                                        tok.cancel(i);
-                                    }
-                                });
+                            mismatch_partition<ExPolicy>(it, part_count,
+                                base_idx, tok, f);
                         },
                         [=](std::vector<hpx::future<void> > &&) mutable
                             -> std::pair<FwdIter1, FwdIter2>
@@ -276,7 +337,8 @@ namespace hpx { namespace parallel { inline namespace v1
             sequential(ExPolicy, InIter1 first1, InIter1 last1, InIter2 first2,
                 F && f)
             {
-                return std::mismatch(first1, last1, first2, std::forward<F>(f));
+                return util::find_first2<ExPolicy>(first1, last1, first2,
+                    invoke_not_indirect<F>{f});
             }
 
             template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
@@ -296,7 +358,6 @@ namespace hpx { namespace parallel { inline namespace v1
                 difference_type count = std::distance(first1, last1);
 
                 typedef hpx::util::zip_iterator<FwdIter1, FwdIter2> zip_iterator;
-                typedef typename zip_iterator::reference reference;
 
                 util::cancellation_token<std::size_t> tok(count);
 
@@ -309,17 +370,8 @@ namespace hpx { namespace parallel { inline namespace v1
                             std::size_t base_idx
                         ) mutable -> void
                         {
-                            util::loop_idx_n(
-                                base_idx, it, part_count, tok,
-                                [&f, &tok](reference t, std::size_t i)
-                                {
-                                    if (!hpx::util::invoke(f,
-                                            hpx::util::get<0>(t),
-                                            hpx::util::get<1>(t)))
-                                    {
-                                        tok.cancel(i);
-                                    }
-                                });
+                            mismatch_partition<ExPolicy>(it, part_count,
+                                base_idx, tok, f);
                         },
                         [=](std::vector<hpx::future<void> > &&) mutable ->
                             std::pair<FwdIter1, FwdIter2>
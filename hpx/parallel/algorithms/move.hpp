@@ -60,18 +60,30 @@ namespace hpx { namespace parallel { inline namespace v1
                 typedef hpx::util::zip_iterator<FwdIter1, FwdIter2> zip_iterator;
                 typedef typename zip_iterator::reference reference;
 
+                std::size_t count = std::distance(first, last);
+                bool nontemporal =
+                    util::detail::use_nontemporal_stores<FwdIter2>(count);
+
                 return get_iter_pair(
                     util::foreach_partitioner<ExPolicy>::call(
                         std::forward<ExPolicy>(policy),
-                        hpx::util::make_zip_iterator(first, dest),
-                        std::distance(first, last),
-                        [](zip_iterator part_begin, std::size_t part_size,
-                            std::size_t)
+                        hpx::util::make_zip_iterator(first, dest), count,
+                        [nontemporal](zip_iterator part_begin,
+                            std::size_t part_size, std::size_t)
                         {
                             using hpx::util::get;
 
                             auto iters = part_begin.get_iterator_tuple();
-                            util::move_n(get<0>(iters), part_size, get<1>(iters));
+                            if (nontemporal)
+                            {
+                                util::move_n_nontemporal(
+                                    get<0>(iters), part_size, get<1>(iters));
+                            }
+                            else
+                            {
+                                util::move_n(
+                                    get<0>(iters), part_size, get<1>(iters));
+                            }
                         },
                         [](zip_iterator && last) -> zip_iterator
                         {
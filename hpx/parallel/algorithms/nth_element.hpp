@@ -0,0 +1,307 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHM_NTH_ELEMENT_HPP)
+#define HPX_PARALLEL_ALGORITHM_NTH_ELEMENT_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/traits/concepts.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/algorithms/partition.hpp>
+#include <hpx/parallel/algorithms/sort.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/traits/projected.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // nth_element
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // number of elements looked at for selecting a pivot
+        static const std::size_t nth_element_sample_size = 127ul;
+
+        // Select the pivot from a sorted sample of elements spread evenly
+        // over the range. The rank of the pivot inside of the sample
+        // corresponds to the position of nth inside of the range, which
+        // makes it likely for nth to end up close to the pivot.
+        template <typename RandomIt, typename Comp>
+        RandomIt nth_element_select_pivot(RandomIt first, RandomIt nth,
+            RandomIt last, Comp const& comp)
+        {
+            std::size_t size = last - first;
+            std::size_t sample_size = (std::min)(size, nth_element_sample_size);
+
+            std::vector<RandomIt> sample;
+            sample.reserve(sample_size);
+            for (std::size_t i = 0; i != sample_size; ++i)
+                sample.push_back(first + i * (size / sample_size));
+
+            std::sort(sample.begin(), sample.end(),
+                [&comp](RandomIt lhs, RandomIt rhs)
+                {
+                    return comp(*lhs, *rhs);
+                });
+
+            std::size_t rank = (nth - first) * sample_size / size;
+            return sample[(std::min)(rank, sample_size - 1)];
+        }
+
+        // Partition the range around a pivot in parallel, and continue with
+        // the part containing nth until it is small enough to be handled by
+        // std::nth_element.
+        template <typename ExPolicy, typename RandomIt, typename Comp>
+        void nth_element_helper(ExPolicy& policy, RandomIt first,
+            RandomIt nth, RandomIt last, Comp const& comp)
+        {
+            typedef typename std::iterator_traits<RandomIt>::value_type
+                value_type;
+
+            while (std::size_t(last - first) > sort_limit_per_task)
+            {
+                // move the pivot out of the way of the partitioning
+                std::iter_swap(first,
+                    nth_element_select_pivot(first, nth, last, comp));
+
+                RandomIt boundary = partition_helper::call(policy,
+                    first + 1, last,
+                    [first, &comp](value_type const& t) -> bool
+                    {
+                        return comp(t, *first);
+                    },
+                    util::projection_identity());
+
+                RandomIt pivot = boundary - 1;
+                std::iter_swap(first, pivot);
+
+                if (nth == pivot)
+                    return;
+
+                if (nth < pivot)
+                {
+                    last = pivot;
+                    continue;
+                }
+
+                // skip all elements equal to the pivot, this way the loop
+                // finishes even if there are many of them
+                first = partition_helper::call(policy,
+                    pivot + 1, last,
+                    [pivot, &comp](value_type const& t) -> bool
+                    {
+                        return !comp(*pivot, t);
+                    },
+                    util::projection_identity());
+
+                if (nth < first)
+                    return;
+            }
+
+            std::nth_element(first, nth, last, comp);
+        }
+
+        template <typename ExPolicy, typename RandomIt, typename Comp>
+        RandomIt parallel_nth_element(ExPolicy policy, RandomIt first,
+            RandomIt nth, RandomIt last, Comp comp)
+        {
+            nth_element_helper(policy, first, nth, last, comp);
+            return last;
+        }
+
+        template <typename ExPolicy, typename RandomIt, typename Comp>
+        hpx::future<RandomIt>
+        parallel_nth_element_async(ExPolicy && policy, RandomIt first,
+            RandomIt nth, RandomIt last, Comp && comp)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef typename hpx::util::decay<Comp>::type comp_type;
+
+            if (nth == last ||
+                std::size_t(last - first) <= sort_limit_per_task)
+            {
+                if (nth != last)
+                    std::nth_element(first, nth, last, comp);
+                return hpx::make_ready_future(last);
+            }
+
+            return execution::async_execute(policy.executor(),
+                &parallel_nth_element<policy_type, RandomIt, comp_type>,
+                policy, first, nth, last, std::forward<Comp>(comp));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // nth_element
+        template <typename RandomIt>
+        struct nth_element
+          : public detail::algorithm<nth_element<RandomIt>, RandomIt>
+        {
+            nth_element()
+              : nth_element::algorithm("nth_element")
+            {}
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static RandomIt
+            sequential(ExPolicy, RandomIt first, RandomIt nth, RandomIt last,
+                Compare && comp, Proj && proj)
+            {
+                std::nth_element(first, nth, last,
+                    util::compare_projected<Compare, Proj>(
+                            std::forward<Compare>(comp),
+                            std::forward<Proj>(proj)
+                        ));
+                return last;
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, RandomIt
+            >::type
+            parallel(ExPolicy && policy, RandomIt first, RandomIt nth,
+                RandomIt last, Compare && comp, Proj && proj)
+            {
+                typedef util::detail::algorithm_result<
+                    ExPolicy, RandomIt
+                > algorithm_result;
+
+                typedef util::compare_projected<
+                        typename hpx::util::decay<Compare>::type,
+                        typename hpx::util::decay<Proj>::type
+                    > compare_type;
+
+                try {
+                    return algorithm_result::get(
+                        parallel_nth_element_async(
+                            std::forward<ExPolicy>(policy), first, nth, last,
+                            compare_type(std::forward<Compare>(comp),
+                                std::forward<Proj>(proj))));
+                }
+                catch (...) {
+                    return algorithm_result::get(
+                        detail::handle_exception<ExPolicy, RandomIt>::call(
+                            std::current_exception()));
+                }
+            }
+        };
+        /// \endcond
+    }
+
+    //-----------------------------------------------------------------------------
+    /// Rearranges the elements in the range [first, last) such that the
+    /// element pointed at by \a nth is changed to whatever element would occur
+    /// in that position if [first, last) were sorted. All of the elements
+    /// before this new \a nth element are less than or equal to the elements
+    /// after the new \a nth element. The function uses the given comparison
+    /// function object comp (defaults to using operator<()).
+    ///
+    /// \note   Complexity: O(N) applications of the predicate on average,
+    ///                     where N = std::distance(first, last).
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam RandomIt    The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     random access iterator.
+    /// \tparam Comp        The type of the function/function object to use
+    ///                     (deduced).
+    /// \tparam Proj        The type of an optional projection function. This
+    ///                     defaults to \a util::projection_identity
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param nth          Refers to the element defining the partition
+    ///                     criteria.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param comp         comp is a callable object. The return value of the
+    ///                     INVOKE operation applied to an object of type Comp,
+    ///                     when contextually converted to bool, yields true if
+    ///                     the first argument of the call is less than the
+    ///                     second, and false otherwise. It is assumed that comp
+    ///                     will not apply any non-constant function through the
+    ///                     dereferenced iterator.
+    /// \param proj         Specifies the function (or function object) which
+    ///                     will be invoked for each pair of elements as a
+    ///                     projection operation before the actual predicate
+    ///                     \a comp is invoked.
+    ///
+    /// \a comp has to induce a strict weak ordering on the values.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a sequenced_policy execute in sequential order in the
+    /// calling thread.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a parallel_policy or \a parallel_task_policy are
+    /// permitted to execute in an unordered fashion in unspecified
+    /// threads, and indeterminately sequenced within each thread.
+    ///
+    /// The parallel versions of the algorithm repeatedly partition the
+    /// sequence in parallel around a pivot selected from a sample of the
+    /// elements.
+    ///
+    /// \returns  The \a nth_element algorithm returns a
+    ///           \a hpx::future<RandomIt> if the execution policy is of
+    ///           type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and returns \a RandomIt
+    ///           otherwise.
+    ///           The algorithm returns an iterator pointing to the first
+    ///           element after the last element in the input sequence.
+    //-----------------------------------------------------------------------------
+    template <typename ExPolicy, typename RandomIt,
+        typename Proj = util::projection_identity,
+        typename Compare = detail::less,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<RandomIt>::value &&
+        traits::is_projected<Proj, RandomIt>::value &&
+        traits::is_indirect_callable<
+            ExPolicy, Compare,
+                traits::projected<Proj, RandomIt>,
+                traits::projected<Proj, RandomIt>
+        >::value)>
+    typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+    nth_element(ExPolicy && policy, RandomIt first, RandomIt nth,
+        RandomIt last, Compare && comp = Compare(), Proj && proj = Proj())
+    {
+        static_assert(
+            (hpx::traits::is_random_access_iterator<RandomIt>::value),
+            "Requires a random access iterator.");
+
+        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+        return detail::nth_element<RandomIt>().call(
+            std::forward<ExPolicy>(policy), is_seq(), first, nth, last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj));
+    }
+}}}
+
+#endif
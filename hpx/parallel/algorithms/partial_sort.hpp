@@ -0,0 +1,438 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHM_PARTIAL_SORT_HPP)
+#define HPX_PARALLEL_ALGORITHM_PARTIAL_SORT_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/traits/concepts.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/algorithms/nth_element.hpp>
+#include <hpx/parallel/algorithms/sort.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/traits/projected.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // partial_sort
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // Select the smallest elements using the parallel nth_element and
+        // sort them afterwards.
+        template <typename ExPolicy, typename RandomIt, typename Comp>
+        RandomIt parallel_partial_sort(ExPolicy policy, RandomIt first,
+            RandomIt middle, RandomIt last, Comp comp)
+        {
+            if (middle != last)
+                nth_element_helper(policy, first, middle, last, comp);
+
+            parallel_sort_async(policy, first, middle, comp).get();
+            return last;
+        }
+
+        template <typename ExPolicy, typename RandomIt, typename Comp>
+        hpx::future<RandomIt>
+        parallel_partial_sort_async(ExPolicy && policy, RandomIt first,
+            RandomIt middle, RandomIt last, Comp && comp)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef typename hpx::util::decay<Comp>::type comp_type;
+
+            if (std::size_t(last - first) <= sort_limit_per_task)
+            {
+                std::partial_sort(first, middle, last, comp);
+                return hpx::make_ready_future(last);
+            }
+
+            return execution::async_execute(policy.executor(),
+                &parallel_partial_sort<policy_type, RandomIt, comp_type>,
+                policy, first, middle, last, std::forward<Comp>(comp));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // partial_sort
+        template <typename RandomIt>
+        struct partial_sort
+          : public detail::algorithm<partial_sort<RandomIt>, RandomIt>
+        {
+            partial_sort()
+              : partial_sort::algorithm("partial_sort")
+            {}
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static RandomIt
+            sequential(ExPolicy, RandomIt first, RandomIt middle,
+                RandomIt last, Compare && comp, Proj && proj)
+            {
+                std::partial_sort(first, middle, last,
+                    util::compare_projected<Compare, Proj>(
+                            std::forward<Compare>(comp),
+                            std::forward<Proj>(proj)
+                        ));
+                return last;
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, RandomIt
+            >::type
+            parallel(ExPolicy && policy, RandomIt first, RandomIt middle,
+                RandomIt last, Compare && comp, Proj && proj)
+            {
+                typedef util::detail::algorithm_result<
+                    ExPolicy, RandomIt
+                > algorithm_result;
+
+                typedef util::compare_projected<
+                        typename hpx::util::decay<Compare>::type,
+                        typename hpx::util::decay<Proj>::type
+                    > compare_type;
+
+                try {
+                    return algorithm_result::get(
+                        parallel_partial_sort_async(
+                            std::forward<ExPolicy>(policy),
+                            first, middle, last,
+                            compare_type(std::forward<Compare>(comp),
+                                std::forward<Proj>(proj))));
+                }
+                catch (...) {
+                    return algorithm_result::get(
+                        detail::handle_exception<ExPolicy, RandomIt>::call(
+                            std::current_exception()));
+                }
+            }
+        };
+        /// \endcond
+    }
+
+    //-----------------------------------------------------------------------------
+    /// Rearranges elements such that the range [first, middle) contains the
+    /// sorted middle - first smallest elements in the range [first, last).
+    /// The order of equal elements is not guaranteed to be preserved. The
+    /// order of the remaining elements in the range [middle, last) is
+    /// unspecified. The function uses the given comparison function object
+    /// comp (defaults to using operator<()).
+    ///
+    /// \note   Complexity: Approximately (last-first)*log(middle-first)
+    ///                     applications of \a comp.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam RandomIt    The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     random access iterator.
+    /// \tparam Comp        The type of the function/function object to use
+    ///                     (deduced).
+    /// \tparam Proj        The type of an optional projection function. This
+    ///                     defaults to \a util::projection_identity
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param middle       Refers to the end of the range of elements which
+    ///                     will be sorted.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param comp         comp is a callable object. The return value of the
+    ///                     INVOKE operation applied to an object of type Comp,
+    ///                     when contextually converted to bool, yields true if
+    ///                     the first argument of the call is less than the
+    ///                     second, and false otherwise. It is assumed that comp
+    ///                     will not apply any non-constant function through the
+    ///                     dereferenced iterator.
+    /// \param proj         Specifies the function (or function object) which
+    ///                     will be invoked for each pair of elements as a
+    ///                     projection operation before the actual predicate
+    ///                     \a comp is invoked.
+    ///
+    /// \a comp has to induce a strict weak ordering on the values.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a sequenced_policy execute in sequential order in the
+    /// calling thread.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a parallel_policy or \a parallel_task_policy are
+    /// permitted to execute in an unordered fashion in unspecified
+    /// threads, and indeterminately sequenced within each thread.
+    ///
+    /// \returns  The \a partial_sort algorithm returns a
+    ///           \a hpx::future<RandomIt> if the execution policy is of
+    ///           type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and returns \a RandomIt
+    ///           otherwise.
+    ///           The algorithm returns an iterator pointing to the first
+    ///           element after the last element in the input sequence.
+    //-----------------------------------------------------------------------------
+    template <typename ExPolicy, typename RandomIt,
+        typename Proj = util::projection_identity,
+        typename Compare = detail::less,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<RandomIt>::value &&
+        traits::is_projected<Proj, RandomIt>::value &&
+        traits::is_indirect_callable<
+            ExPolicy, Compare,
+                traits::projected<Proj, RandomIt>,
+                traits::projected<Proj, RandomIt>
+        >::value)>
+    typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+    partial_sort(ExPolicy && policy, RandomIt first, RandomIt middle,
+        RandomIt last, Compare && comp = Compare(), Proj && proj = Proj())
+    {
+        static_assert(
+            (hpx::traits::is_random_access_iterator<RandomIt>::value),
+            "Requires a random access iterator.");
+
+        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+        return detail::partial_sort<RandomIt>().call(
+            std::forward<ExPolicy>(policy), is_seq(), first, middle, last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // partial_sort_copy
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // Copy all elements if they fit into the destination range, otherwise
+        // select the smallest elements from a copy of the input first.
+        template <typename ExPolicy, typename FwdIter, typename RandomIt,
+            typename Comp>
+        RandomIt parallel_partial_sort_copy(ExPolicy policy, FwdIter first,
+            FwdIter last, RandomIt d_first, RandomIt d_last, Comp comp)
+        {
+            typedef typename std::iterator_traits<FwdIter>::value_type
+                value_type;
+
+            std::size_t size = std::distance(first, last);
+            std::size_t d_size = d_last - d_first;
+
+            if (size <= d_size)
+            {
+                d_last = std::copy(first, last, d_first);
+            }
+            else
+            {
+                std::vector<value_type> buffer(first, last);
+                nth_element_helper(policy, buffer.begin(),
+                    buffer.begin() + d_size, buffer.end(), comp);
+
+                d_last = std::move(
+                    buffer.begin(), buffer.begin() + d_size, d_first);
+            }
+
+            parallel_sort_async(policy, d_first, d_last, comp).get();
+            return d_last;
+        }
+
+        template <typename RandomIt>
+        struct partial_sort_copy
+          : public detail::algorithm<partial_sort_copy<RandomIt>, RandomIt>
+        {
+            partial_sort_copy()
+              : partial_sort_copy::algorithm("partial_sort_copy")
+            {}
+
+            template <typename ExPolicy, typename InIter, typename Compare,
+                typename Proj>
+            static RandomIt
+            sequential(ExPolicy, InIter first, InIter last,
+                RandomIt d_first, RandomIt d_last, Compare && comp,
+                Proj && proj)
+            {
+                return std::partial_sort_copy(first, last, d_first, d_last,
+                    util::compare_projected<Compare, Proj>(
+                            std::forward<Compare>(comp),
+                            std::forward<Proj>(proj)
+                        ));
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename Compare,
+                typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, RandomIt
+            >::type
+            parallel(ExPolicy && policy, FwdIter first, FwdIter last,
+                RandomIt d_first, RandomIt d_last, Compare && comp,
+                Proj && proj)
+            {
+                typedef util::detail::algorithm_result<
+                    ExPolicy, RandomIt
+                > algorithm_result;
+
+                typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+                typedef util::compare_projected<
+                        typename hpx::util::decay<Compare>::type,
+                        typename hpx::util::decay<Proj>::type
+                    > compare_type;
+
+                try {
+                    return algorithm_result::get(
+                        execution::async_execute(policy.executor(),
+                            &parallel_partial_sort_copy<
+                                policy_type, FwdIter, RandomIt, compare_type>,
+                            policy, first, last, d_first, d_last,
+                            compare_type(std::forward<Compare>(comp),
+                                std::forward<Proj>(proj))));
+                }
+                catch (...) {
+                    return algorithm_result::get(
+                        detail::handle_exception<ExPolicy, RandomIt>::call(
+                            std::current_exception()));
+                }
+            }
+        };
+        /// \endcond
+    }
+
+    //-----------------------------------------------------------------------------
+    /// Sorts some of the elements in the range [first, last) in ascending
+    /// order, storing the result in the range [d_first, d_last). At most
+    /// d_last - d_first of the elements are placed sorted to the range
+    /// [d_first, d_first + n) where n is the number of elements to sort
+    /// (n = min(last - first, d_last - d_first)). The order of equal
+    /// elements is not guaranteed to be preserved. The function uses the
+    /// given comparison function object comp (defaults to using operator<()).
+    ///
+    /// \note   Complexity: O(Nlog(min(D,N))), where N =
+    ///                     std::distance(first, last) and D =
+    ///                     std::distance(d_first, d_last) comparisons.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam FwdIter     The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of an
+    ///                     forward iterator.
+    /// \tparam RandomIt    The type of the destination iterators used
+    ///                     (deduced). This iterator type must meet the
+    ///                     requirements of a random access iterator.
+    /// \tparam Comp        The type of the function/function object to use
+    ///                     (deduced).
+    /// \tparam Proj        The type of an optional projection function. This
+    ///                     defaults to \a util::projection_identity
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param d_first      Refers to the beginning of the destination range.
+    /// \param d_last       Refers to the end of the destination range.
+    /// \param comp         comp is a callable object. The return value of the
+    ///                     INVOKE operation applied to an object of type Comp,
+    ///                     when contextually converted to bool, yields true if
+    ///                     the first argument of the call is less than the
+    ///                     second, and false otherwise. It is assumed that comp
+    ///                     will not apply any non-constant function through the
+    ///                     dereferenced iterator.
+    /// \param proj         Specifies the function (or function object) which
+    ///                     will be invoked for each pair of elements as a
+    ///                     projection operation before the actual predicate
+    ///                     \a comp is invoked.
+    ///
+    /// \a comp has to induce a strict weak ordering on the values.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a sequenced_policy execute in sequential order in the
+    /// calling thread.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a parallel_policy or \a parallel_task_policy are
+    /// permitted to execute in an unordered fashion in unspecified
+    /// threads, and indeterminately sequenced within each thread.
+    ///
+    /// \returns  The \a partial_sort_copy algorithm returns a
+    ///           \a hpx::future<RandomIt> if the execution policy is of
+    ///           type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and returns \a RandomIt
+    ///           otherwise.
+    ///           The algorithm returns an iterator to the element defining
+    ///           the upper boundary of the sorted range [d_first,
+    ///           d_first + n).
+    //-----------------------------------------------------------------------------
+    template <typename ExPolicy, typename FwdIter, typename RandomIt,
+        typename Proj = util::projection_identity,
+        typename Compare = detail::less,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<FwdIter>::value &&
+        hpx::traits::is_iterator<RandomIt>::value &&
+        traits::is_projected<Proj, FwdIter>::value &&
+        traits::is_projected<Proj, RandomIt>::value &&
+        traits::is_indirect_callable<
+            ExPolicy, Compare,
+                traits::projected<Proj, RandomIt>,
+                traits::projected<Proj, RandomIt>
+        >::value)>
+    typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+    partial_sort_copy(ExPolicy && policy, FwdIter first, FwdIter last,
+        RandomIt d_first, RandomIt d_last, Compare && comp = Compare(),
+        Proj && proj = Proj())
+    {
+#if defined(HPX_HAVE_ALGORITHM_INPUT_ITERATOR_SUPPORT)
+        static_assert(
+            (hpx::traits::is_input_iterator<FwdIter>::value),
+            "Requires at least input iterator.");
+
+        typedef std::integral_constant<bool,
+                execution::is_sequenced_execution_policy<ExPolicy>::value ||
+               !hpx::traits::is_forward_iterator<FwdIter>::value
+            > is_seq;
+#else
+        static_assert(
+            (hpx::traits::is_forward_iterator<FwdIter>::value),
+            "Requires at least forward iterator.");
+
+        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+#endif
+        static_assert(
+            (hpx::traits::is_random_access_iterator<RandomIt>::value),
+            "Requires a random access iterator.");
+
+        return detail::partial_sort_copy<RandomIt>().call(
+            std::forward<ExPolicy>(policy), is_seq(), first, last,
+            d_first, d_last, std::forward<Compare>(comp),
+            std::forward<Proj>(proj));
+    }
+}}}
+
+#endif
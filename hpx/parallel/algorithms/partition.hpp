@@ -31,9 +31,9 @@
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
 #include <hpx/parallel/util/invoke_projected.hpp>
+#include <hpx/parallel/util/lookback_scan_partitioner.hpp>
 #include <hpx/parallel/util/loop.hpp>
 #include <hpx/parallel/util/projection_identity.hpp>
-#include <hpx/parallel/util/scan_partitioner.hpp>
 #include <hpx/parallel/util/zip_iterator.hpp>
 
 #include <algorithm>
@@ -42,12 +42,11 @@
 #include <exception>
 #include <iterator>
 #include <list>
+#include <memory>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
-#include <boost/shared_array.hpp>
-
 namespace hpx { namespace parallel { inline namespace v1
 {
     ///////////////////////////////////////////////////////////////////////////
@@ -320,17 +319,21 @@ namespace hpx { namespace parallel { inline namespace v1
         sequential_partition(BidirIter first, BidirIter last,
             Pred && pred, Proj && proj)
         {
-            using hpx::util::invoke;
-
             while (true)
             {
-                while (first != last && invoke(pred, invoke(proj, *first)))
+                while (first != last &&
+                    hpx::util::invoke(pred, hpx::util::invoke(proj, *first)))
+                {
                     ++first;
+                }
                 if (first == last)
                     break;
 
-                while (first != --last && !invoke(pred, invoke(proj, *last)))
-                    ;
+                while (first != --last &&
+                    !hpx::util::invoke(pred, hpx::util::invoke(proj, *last)))
+                {
+                    /**/
+                }
                 if (first == last)
                     break;
 
@@ -349,17 +352,18 @@ namespace hpx { namespace parallel { inline namespace v1
         sequential_partition(FwdIter first, FwdIter last,
             Pred && pred, Proj && proj)
         {
-            using hpx::util::invoke;
-
-            while (first != last && invoke(pred, invoke(proj, *first)))
+            while (first != last &&
+                hpx::util::invoke(pred, hpx::util::invoke(proj, *first)))
+            {
                 ++first;
+            }
 
             if (first == last)
                 return first;
 
             for (FwdIter it = std::next(first); it != last; ++it)
             {
-                if (invoke(pred, invoke(proj, *it)))
+                if (hpx::util::invoke(pred, hpx::util::invoke(proj, *it)))
                     std::iter_swap(first++, it);
             }
 
@@ -572,8 +576,6 @@ namespace hpx { namespace parallel { inline namespace v1
             partition_thread(block_manager<FwdIter>& block_manager,
                 Pred pred, Proj proj)
             {
-                using hpx::util::invoke;
-
                 block<FwdIter> left_block, right_block;
 
                 left_block = block_manager.get_left_block();
@@ -583,14 +585,16 @@ namespace hpx { namespace parallel { inline namespace v1
                 {
                     while ( (!left_block.empty() ||
                             !(left_block = block_manager.get_left_block()).empty()) &&
-                        invoke(pred, invoke(proj, *left_block.first)))
+                        hpx::util::invoke(pred,
+                            hpx::util::invoke(proj, *left_block.first)))
                     {
                         ++left_block.first;
                     }
 
                     while ( (!right_block.empty() ||
                             !(right_block = block_manager.get_right_block()).empty()) &&
-                        !invoke(pred, invoke(proj, *right_block.first)))
+                        !hpx::util::invoke(pred,
+                            hpx::util::invoke(proj, *right_block.first)))
                     {
                         ++right_block.first;
                     }
@@ -623,8 +627,6 @@ namespace hpx { namespace parallel { inline namespace v1
 
                 while (true)
                 {
-                    using hpx::util::invoke;
-
                     while (true)
                     {
                         if (left_iter->empty())
@@ -634,7 +636,8 @@ namespace hpx { namespace parallel { inline namespace v1
                                 left_iter->block_no > 0)
                                 break;
                         }
-                        if (!invoke(pred, invoke(proj, *left_iter->first)))
+                        if (!hpx::util::invoke(pred,
+                                hpx::util::invoke(proj, *left_iter->first)))
                             break;
                         ++left_iter->first;
                     }
@@ -647,7 +650,8 @@ namespace hpx { namespace parallel { inline namespace v1
                                 (--right_iter)->block_no < 0)
                                 break;
                         }
-                        if (invoke(pred, invoke(proj, *right_iter->first)))
+                        if (hpx::util::invoke(pred,
+                                hpx::util::invoke(proj, *right_iter->first)))
                             break;
                         ++right_iter->first;
                     }
@@ -1101,6 +1105,15 @@ namespace hpx { namespace parallel { inline namespace v1
                 std::move(dest_true), std::move(dest_false));
         }
 
+        // The numbers of elements to copy to dest_true and dest_false from
+        // the tiles processed so far, or from one tile together with the
+        // flags marking the elements to copy to dest_true.
+        struct partition_copy_tile
+        {
+            std::pair<std::size_t, std::size_t> counts_;
+            bool* flags_;
+        };
+
         template <typename IterTuple>
         struct partition_copy
           : public detail::algorithm<partition_copy<IterTuple>, IterTuple>
@@ -1145,101 +1158,107 @@ namespace hpx { namespace parallel { inline namespace v1
 
                 difference_type count = std::distance(first, last);
 
-                boost::shared_array<bool> flags(new bool[count]);
-                output_iterator_offset init = { 0, 0 };
+                // the elements to copy to dest_true are flagged in a buffer
+                // held only while the tile is processed
+                typedef util::lookback_tile_buffers<bool> buffers_type;
+                std::shared_ptr<buffers_type> buffers =
+                    std::make_shared<buffers_type>(count);
+
+                partition_copy_tile init = { output_iterator_offset(0, 0),
+                    nullptr };
 
                 using hpx::util::get;
                 using hpx::util::make_zip_iterator;
-                typedef util::scan_partitioner<
+                typedef util::lookback_scan_partitioner<
                         ExPolicy, hpx::util::tuple<FwdIter1, FwdIter2, FwdIter3>,
-                        output_iterator_offset
+                        partition_copy_tile
                     > scan_partitioner_type;
 
                 auto f1 =
-                    [HPX_CAPTURE_FORWARD(pred), HPX_CAPTURE_FORWARD(proj)](
-                       zip_iterator part_begin, std::size_t part_size)
-                    -> output_iterator_offset
+                    [HPX_CAPTURE_FORWARD(pred), HPX_CAPTURE_FORWARD(proj),
+                        buffers
+                    ](FwdIter1 part_begin, std::size_t part_size)
+                    -> partition_copy_tile
                     {
+                        bool* flags = buffers->acquire();
                         std::size_t true_count = 0;
 
                         // MSVC complains if pred or proj is captured by ref below
                         util::loop_n<ExPolicy>(
-                            part_begin, part_size,
+                            make_zip_iterator(part_begin, flags), part_size,
                             [pred, proj, &true_count](zip_iterator it) mutable
                             {
-                                using hpx::util::invoke;
-                                bool f = invoke(pred, invoke(proj, get<0>(*it)));
+                                bool f = hpx::util::invoke(pred,
+                                    hpx::util::invoke(proj, get<0>(*it)));
 
                                 if ((get<1>(*it) = f))
                                     ++true_count;
                             });
 
-                        return output_iterator_offset(
-                            true_count, part_size - true_count);
+                        partition_copy_tile tile = {
+                            output_iterator_offset(
+                                true_count, part_size - true_count),
+                            flags };
+                        return tile;
                     };
                 auto f3 =
-                    [dest_true, dest_false, flags](
-                        zip_iterator part_begin, std::size_t part_size,
-                        hpx::shared_future<output_iterator_offset> curr,
-                        hpx::shared_future<output_iterator_offset> next
-                    ) mutable -> void
+                    [dest_true, dest_false, buffers](FwdIter1 part_begin,
+                        std::size_t part_size,
+                        partition_copy_tile const& offset,
+                        partition_copy_tile const& tile) -> void
                     {
-                        HPX_UNUSED(flags);
-
-                        next.get();     // rethrow exceptions
-
-                        output_iterator_offset offset = curr.get();
-                        std::size_t count_true = get<0>(offset);
-                        std::size_t count_false = get<1>(offset);
-                        std::advance(dest_true, count_true);
-                        std::advance(dest_false, count_false);
+                        FwdIter2 out_true = dest_true;
+                        FwdIter3 out_false = dest_false;
+                        std::advance(out_true, get<0>(offset.counts_));
+                        std::advance(out_false, get<1>(offset.counts_));
 
                         util::loop_n<ExPolicy>(
-                            part_begin, part_size,
-                            [&dest_true, &dest_false](zip_iterator it) mutable
+                            make_zip_iterator(part_begin, tile.flags_),
+                            part_size,
+                            [&out_true, &out_false](zip_iterator it)
                             {
                                 if(get<1>(*it))
-                                    *dest_true++ = get<0>(*it);
+                                    *out_true++ = get<0>(*it);
                                 else
-                                    *dest_false++ = get<0>(*it);
+                                    *out_false++ = get<0>(*it);
                             });
+
+                        buffers->release(tile.flags_);
                     };
 
                 return scan_partitioner_type::call(
                     std::forward<ExPolicy>(policy),
-                    make_zip_iterator(first, flags.get()), count, init,
-                    // step 1 performs first part of scan algorithm
+                    first, count, init,
+                    // step 1 flags the elements of each tile
                     std::move(f1),
-                    // step 2 propagates the partition results from left
-                    // to right
-                    hpx::util::unwrapping(
-                        [](output_iterator_offset const& prev_sum,
-                            output_iterator_offset const& curr)
-                        -> output_iterator_offset
-                        {
-                            return output_iterator_offset(
-                                get<0>(prev_sum) + get<0>(curr),
-                                get<1>(prev_sum) + get<1>(curr));
-                        }),
-                    // step 3 runs final accumulation on each partition
+                    // the numbers of elements to copy are summed up
+                    [](partition_copy_tile const& prev_sum,
+                        partition_copy_tile const& curr)
+                    -> partition_copy_tile
+                    {
+                        partition_copy_tile sum = {
+                            output_iterator_offset(
+                                get<0>(prev_sum.counts_) + get<0>(curr.counts_),
+                                get<1>(prev_sum.counts_) + get<1>(curr.counts_)),
+                            nullptr };
+                        return sum;
+                    },
+                    // step 2 copies the elements of each tile as soon as the
+                    // number of preceding elements is known
                     std::move(f3),
-                    // step 4 use this return value
-                    [last, dest_true, dest_false, flags](
-                        std::vector<
-                            hpx::shared_future<output_iterator_offset>
-                        > && items,
-                        std::vector<hpx::future<void> > &&) mutable
+                    // step 3 use this return value
+                    [last, dest_true, dest_false, buffers](
+                        partition_copy_tile const& total)
                     ->  hpx::util::tuple<FwdIter1, FwdIter2, FwdIter3>
                     {
-                        HPX_UNUSED(flags);
+                        HPX_UNUSED(buffers);
 
-                        output_iterator_offset count_pair = items.back().get();
-                        std::size_t count_true = get<0>(count_pair);
-                        std::size_t count_false = get<1>(count_pair);
-                        std::advance(dest_true, count_true);
-                        std::advance(dest_false, count_false);
+                        FwdIter2 out_true = dest_true;
+                        FwdIter3 out_false = dest_false;
+                        std::advance(out_true, get<0>(total.counts_));
+                        std::advance(out_false, get<1>(total.counts_));
 
-                        return hpx::util::make_tuple(last, dest_true, dest_false);
+                        return hpx::util::make_tuple(last, out_true, out_false);
                     });
             }
         };
@@ -13,13 +13,14 @@
 #include <hpx/util/range.hpp>
 #include <hpx/util/unwrap.hpp>
 
-#include <hpx/parallel/algorithms/detail/accumulate.hpp>
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
 #include <hpx/parallel/algorithms/detail/distance.hpp>
 #include <hpx/parallel/execution_policy.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/loop.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
+#include <hpx/parallel/util/prefetching_loop.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
 
 #include <algorithm>
 #include <cstddef>
@@ -48,8 +49,9 @@ namespace hpx { namespace parallel { inline namespace v1
             static T sequential(
                 ExPolicy, InIterB first, InIterE last, T_&& init, Reduce&& r)
             {
-                return detail::accumulate(first, last, std::forward<T_>(init),
-                    std::forward<Reduce>(r));
+                return util::transform_accumulate<ExPolicy>(first, last,
+                    T(std::forward<T_>(init)), std::forward<Reduce>(r),
+                    util::projection_identity());
             }
 
             template <typename ExPolicy, typename FwdIterB, typename FwdIterE,
@@ -64,12 +66,15 @@ namespace hpx { namespace parallel { inline namespace v1
                         std::forward<T_>(init));
                 }
 
+                auto prefetcher = util::get_prefetcher(policy);
                 auto f1 =
-                    [r](FwdIterB part_begin, std::size_t part_size) -> T
+                    [r, prefetcher](FwdIterB part_begin, std::size_t part_size)
+                        -> T
                     {
                         T val = *part_begin;
-                        return util::accumulate_n(++part_begin, --part_size,
-                            std::move(val), r);
+                        return util::transform_accumulate_n_prefetch<ExPolicy>(
+                            ++part_begin, --part_size, std::move(val),
+                            prefetcher, r, util::projection_identity());
                     };
 
                 return util::partitioner<ExPolicy, T>::call(
@@ -204,7 +209,8 @@ namespace hpx { namespace parallel { inline namespace v1
     template <typename ExPolicy, typename FwdIterB, typename FwdIterE,
         typename T, typename F>
     inline typename std::enable_if<
-        execution::is_execution_policy<ExPolicy>::value,
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<FwdIterB>::value,
         typename util::detail::algorithm_result<ExPolicy, T>::type
     >::type
     reduce(ExPolicy&& policy, FwdIterB first, FwdIterE last, T init, F&& f)
@@ -275,7 +281,8 @@ namespace hpx { namespace parallel { inline namespace v1
     template <typename ExPolicy, typename FwdIterB, typename FwdIterE,
         typename T>
     inline typename std::enable_if<
-        execution::is_execution_policy<ExPolicy>::value,
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<FwdIterB>::value,
         typename util::detail::algorithm_result<ExPolicy, T>::type
     >::type
     reduce(ExPolicy&& policy, FwdIterB first, FwdIterE last, T init)
@@ -346,7 +353,8 @@ namespace hpx { namespace parallel { inline namespace v1
     ///
     template <typename ExPolicy, typename FwdIterB, typename FwdIterE>
     inline typename std::enable_if<
-        execution::is_execution_policy<ExPolicy>::value,
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<FwdIterB>::value,
         typename util::detail::algorithm_result<ExPolicy,
             typename std::iterator_traits<FwdIterB>::value_type
         >::type
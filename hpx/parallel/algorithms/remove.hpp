@@ -11,6 +11,7 @@
 #include <hpx/config.hpp>
 #include <hpx/traits/concepts.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/invoke.hpp>
 #include <hpx/util/tagged_pair.hpp>
 #include <hpx/util/unused.hpp>
@@ -29,7 +30,6 @@
 #include <hpx/parallel/util/projection_identity.hpp>
 #include <hpx/parallel/util/scan_partitioner.hpp>
 #include <hpx/parallel/util/transfer.hpp>
-#include <hpx/parallel/util/zip_iterator.hpp>
 
 #include <algorithm>
 #include <cstddef>
@@ -40,7 +40,6 @@
 #include <utility>
 #include <vector>
 
-#include <boost/shared_array.hpp>
 
 namespace hpx { namespace parallel { inline namespace v1
 {
@@ -85,7 +84,6 @@ namespace hpx { namespace parallel { inline namespace v1
             parallel(ExPolicy && policy, FwdIter first, FwdIter last,
                 Pred && pred, Proj && proj)
             {
-                typedef hpx::util::zip_iterator<FwdIter, bool*> zip_iterator;
                 typedef util::detail::algorithm_result<
                     ExPolicy, FwdIter
                 > algorithm_result;
@@ -97,115 +95,100 @@ namespace hpx { namespace parallel { inline namespace v1
                 if (count == 0)
                     return algorithm_result::get(std::move(last));
 
-                boost::shared_array<bool> flags(new bool[count]);
                 std::size_t init = 0u;
 
-                using hpx::util::get;
-                using hpx::util::make_zip_iterator;
                 typedef util::scan_partitioner<
                         ExPolicy, FwdIter, std::size_t, void,
                         util::scan_partitioner_sequential_f3_tag
                     > scan_partitioner_type;
 
+                // step 1 removes the elements of each partition in place
                 auto f1 =
                     [HPX_CAPTURE_FORWARD(pred),
                         HPX_CAPTURE_FORWARD(proj)
-                    ](zip_iterator part_begin, std::size_t part_size)
+                    ](FwdIter part_begin, std::size_t part_size) mutable
                     ->  std::size_t
                     {
-                        // MSVC complains if pred or proj is captured by ref below
-                        util::loop_n<ExPolicy>(
-                            part_begin, part_size,
-                            [pred, proj](zip_iterator it) mutable
-                            {
-                                bool f = hpx::util::invoke(pred,
-                                    hpx::util::invoke(proj, get<0>(*it)));
-
-                                get<1>(*it) = f;
-                            });
-
-                        // There is no need to return the partition result.
-                        // But, the scan_partitioner doesn't support 'void' as
-                        // Result1. So, unavoidably return non-meaning value.
-                        return 0u;
+                        FwdIter part_end = part_begin;
+                        std::advance(part_end, part_size);
+
+                        return std::distance(part_begin,
+                            sequential_remove_if(part_begin, part_end,
+                                pred, proj));
                     };
 
                 std::shared_ptr<FwdIter> dest_ptr =
                     std::make_shared<FwdIter>(first);
                 auto f3 =
-                    [dest_ptr, flags](
-                        zip_iterator part_begin, std::size_t part_size,
-                        hpx::shared_future<std::size_t> curr,
-                        hpx::shared_future<std::size_t> next
+                    [dest_ptr](FwdIter part_begin, std::size_t,
+                        hpx::shared_future<std::size_t> prev,
+                        hpx::shared_future<std::size_t> curr
                     ) mutable -> void
                     {
-                        HPX_UNUSED(flags);
-
-                        curr.get();     // rethrow exceptions
-                        next.get();     // rethrow exceptions
+                        prev.get();     // rethrow exceptions
 
+                        std::size_t kept = curr.get();
                         FwdIter& dest = *dest_ptr;
 
-                        if (dest == get<0>(part_begin.get_iterator_tuple()))
+                        // move the remaining elements of the partition as
+                        // one block behind the elements kept so far
+                        if (dest == part_begin)
                         {
-                            // Self-assignment must be detected.
-                            util::loop_n<ExPolicy>(
-                                part_begin, part_size,
-                                [&dest](zip_iterator it)
-                                {
-                                    if(!get<1>(*it))
-                                    {
-                                        if (dest != get<0>(it.get_iterator_tuple()))
-                                            *dest++ = std::move(get<0>(*it));
-                                        else
-                                            ++dest;
-                                    }
-                                });
+                            std::advance(dest, kept);
                         }
                         else
                         {
-                            // Self-assignment can't be performed.
-                            util::loop_n<ExPolicy>(
-                                part_begin, part_size,
-                                [&dest](zip_iterator it)
-                                {
-                                    if(!get<1>(*it))
-                                        *dest++ = std::move(get<0>(*it));
-                                });
+                            FwdIter part_end = part_begin;
+                            std::advance(part_end, kept);
+                            dest = std::move(part_begin, part_end, dest);
                         }
                     };
 
                 return scan_partitioner_type::call(
                     std::forward<ExPolicy>(policy),
-                    make_zip_iterator(first, flags.get()),
-                    count, init,
+                    first, count, init,
                     // step 1 performs first part of scan algorithm
                     std::move(f1),
-                    // step 2 propagates the partition results from left
-                    // to right
+                    // step 2 hands the number of elements kept by each
+                    // partition to step 3
                     hpx::util::unwrapping(
-                        [](std::size_t, std::size_t)
-                            -> std::size_t
+                        [](std::size_t, std::size_t curr) -> std::size_t
                         {
-                            // There is no need to propagate the partition
-                            // results. But, the scan_partitioner doesn't
-                            // support 'void' as Result1. So, unavoidably
-                            // return non-meaning value.
-                            return 0u;
+                            return curr;
                         }),
-                    // step 3 runs final accumulation on each partition
+                    // step 3 moves the elements of each partition in place
                     std::move(f3),
                     // step 4 use this return value
-                    [dest_ptr, flags](
+                    [dest_ptr](
                         std::vector<hpx::shared_future<std::size_t> > &&,
                         std::vector<hpx::future<void> > &&) mutable
                     ->  FwdIter
                     {
-                        HPX_UNUSED(flags);
                         return *dest_ptr;
                     });
             }
         };
+
+        template <typename ExPolicy, typename FwdIter, typename Pred,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        remove_if_(ExPolicy && policy, FwdIter first, FwdIter last,
+            Pred && pred, Proj && proj, std::false_type)
+        {
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+            return detail::remove_if<FwdIter>().call(
+                    std::forward<ExPolicy>(policy), is_seq(),
+                    first, last, std::forward<Pred>(pred),
+                    std::forward<Proj>(proj));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename SegIter, typename Pred,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        remove_if_(ExPolicy && policy, SegIter first, SegIter last,
+            Pred && pred, Proj && proj, std::true_type);
         /// \endcond
     }
 
@@ -295,16 +278,45 @@ namespace hpx { namespace parallel { inline namespace v1
             (hpx::traits::is_forward_iterator<FwdIter>::value),
             "Required at least forward iterator.");
 
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+        typedef hpx::traits::is_segmented_iterator<FwdIter> is_segmented;
 
-        return detail::remove_if<FwdIter>().call(
-                std::forward<ExPolicy>(policy), is_seq(),
+        return detail::remove_if_(std::forward<ExPolicy>(policy),
                 first, last, std::forward<Pred>(pred),
-                std::forward<Proj>(proj));
+                std::forward<Proj>(proj), is_segmented());
     }
 
     /////////////////////////////////////////////////////////////////////////////
     // remove
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // the predicate used by remove, this can be sent to the segments of
+        // segmented iterators
+        template <typename T>
+        struct remove_equal_to
+        {
+            remove_equal_to(T const& value = T())
+              : value_(value)
+            {}
+
+            template <typename U>
+            bool operator()(U const& a) const
+            {
+                return value_ == a;
+            }
+
+            T value_;
+
+            template <typename Archive>
+            void serialize(Archive& ar, unsigned)
+            {
+                ar & value_;
+            }
+        };
+        /// \endcond
+    }
+
     /// Removes all elements satisfying specific criteria from the range
     /// [first, last) and returns a past-the-end iterator for the new
     /// end of the range. This version removes all elements that are
@@ -368,15 +380,9 @@ namespace hpx { namespace parallel { inline namespace v1
     remove(ExPolicy && policy, FwdIter first, FwdIter last,
         T const& value, Proj && proj = Proj())
     {
-        typedef typename std::iterator_traits<FwdIter>::value_type Type;
-
         // Just utilize existing parallel remove_if.
         return remove_if(std::forward<ExPolicy>(policy),
-                first, last,
-                [value](Type const& a) -> bool
-                {
-                    return value == a;
-                },
+                first, last, detail::remove_equal_to<T>(value),
                 std::forward<Proj>(proj));
     }
 }}}
@@ -31,6 +31,19 @@ namespace hpx { namespace parallel { inline namespace v1
     namespace detail
     {
         /// \cond NOINTERNAL
+
+        // perform the set operation on one chunk
+        struct set_union_op
+        {
+            template <typename Iter1, typename Iter2, typename OutIter,
+                typename F>
+            OutIter operator()(Iter1 first1, Iter1 last1,
+                Iter2 first2, Iter2 last2, OutIter dest, F const& f) const
+            {
+                return std::set_union(first1, last1, first2, last2, dest, f);
+            }
+        };
+
         template <typename FwdIter>
         struct set_union : public detail::algorithm<set_union<FwdIter>, FwdIter>
         {
@@ -56,11 +69,6 @@ namespace hpx { namespace parallel { inline namespace v1
             parallel(ExPolicy && policy, RanIter1 first1, RanIter1 last1,
                 RanIter2 first2, RanIter2 last2, FwdIter dest, F && f)
             {
-                typedef typename std::iterator_traits<RanIter1>::difference_type
-                    difference_type1;
-                typedef typename std::iterator_traits<RanIter2>::difference_type
-                    difference_type2;
-
                 if (first1 == last1)
                 {
                     return util::detail::convert_to_result(
@@ -89,26 +97,9 @@ namespace hpx { namespace parallel { inline namespace v1
                             });
                 }
 
-                typedef typename set_operations_buffer<FwdIter>::type buffer_type;
-                typedef typename hpx::util::decay<F>::type func_type;
-
                 return set_operation(std::forward<ExPolicy>(policy),
                     first1, last1, first2, last2, dest, std::forward<F>(f),
-                    // calculate approximate destination index
-                    [](difference_type1 idx1, difference_type2 idx2)
-                    ->  difference_type1
-                    {
-                        return idx1 + idx2;
-                    },
-                    // perform required set operation for one chunk
-                    [](RanIter1 part_first1, RanIter1 part_last1,
-                        RanIter2 part_first2, RanIter2 part_last2,
-                        buffer_type* dest, func_type const& f)
-                    ->  buffer_type*
-                    {
-                        return std::set_union(part_first1, part_last1,
-                            part_first2, part_last2, dest, f);
-                    });
+                    set_union_op());
             }
         };
         /// \endcond
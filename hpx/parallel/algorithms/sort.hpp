@@ -13,12 +13,14 @@
 #include <hpx/dataflow.hpp>
 #include <hpx/traits/concepts.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/decay.hpp>
 #include <hpx/util/invoke.hpp>
 
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
 #include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/algorithms/detail/radix_sort.hpp>
 #include <hpx/parallel/exception_list.hpp>
 #include <hpx/parallel/execution_policy.hpp>
 #include <hpx/parallel/executors/execution.hpp>
@@ -239,12 +241,13 @@ namespace hpx { namespace parallel { inline namespace v1
                     // call the sort routine and return the right type,
                     // depending on execution policy
                     return algorithm_result::get(
-                        parallel_sort_async(std::forward<ExPolicy>(policy),
-                            first, last,
-                            util::compare_projected<Compare, Proj>(
-                                std::forward<Compare>(comp),
-                                std::forward<Proj>(proj)
-                            )));
+                        parallel_sort(
+                            typename use_radix_sort<
+                                RandomIt, Compare, Proj
+                            >::type(),
+                            std::forward<ExPolicy>(policy), first, last,
+                            std::forward<Compare>(comp),
+                            std::forward<Proj>(proj)));
                 }
                 catch (...) {
                     return algorithm_result::get(
@@ -252,7 +255,59 @@ namespace hpx { namespace parallel { inline namespace v1
                             std::current_exception()));
                 }
             }
+
+        private:
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static hpx::future<RandomIt>
+            parallel_sort(std::false_type, ExPolicy && policy,
+                RandomIt first, RandomIt last, Compare && comp, Proj && proj)
+            {
+                return parallel_sort_async(std::forward<ExPolicy>(policy),
+                    first, last,
+                    util::compare_projected<Compare, Proj>(
+                        std::forward<Compare>(comp),
+                        std::forward<Proj>(proj)
+                    ));
+            }
+
+            // arithmetic keys compared using operator<() are radix sorted
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static hpx::future<RandomIt>
+            parallel_sort(std::true_type, ExPolicy && policy,
+                RandomIt first, RandomIt last, Compare && comp, Proj && proj)
+            {
+                if (std::size_t(last - first) < sort_limit_per_task)
+                {
+                    return parallel_sort(std::false_type(),
+                        std::forward<ExPolicy>(policy), first, last,
+                        std::forward<Compare>(comp), std::forward<Proj>(proj));
+                }
+
+                return parallel_radix_sort_async(
+                    std::forward<ExPolicy>(policy), first, last,
+                    std::forward<Proj>(proj));
+            }
         };
+
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+        sort_(ExPolicy && policy, RandomIt first, RandomIt last,
+            Compare && comp, Proj && proj, std::false_type)
+        {
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+            return detail::sort<RandomIt>().call(
+                std::forward<ExPolicy>(policy), is_seq(), first, last,
+                std::forward<Compare>(comp), std::forward<Proj>(proj));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename SegIter, typename Compare,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        sort_(ExPolicy && policy, SegIter first, SegIter last,
+            Compare && comp, Proj && proj, std::true_type);
         /// \endcond
     }
 
@@ -343,11 +398,11 @@ namespace hpx { namespace parallel { inline namespace v1
             (hpx::traits::is_random_access_iterator<RandomIt>::value),
             "Requires a random access iterator.");
 
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+        typedef hpx::traits::is_segmented_iterator<RandomIt> is_segmented;
 
-        return detail::sort<RandomIt>().call(
-            std::forward<ExPolicy>(policy), is_seq(), first, last,
-            std::forward<Compare>(comp), std::forward<Proj>(proj));
+        return detail::sort_(std::forward<ExPolicy>(policy), first, last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj),
+            is_segmented());
     }
 }}}
 
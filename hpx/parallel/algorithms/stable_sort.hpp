@@ -0,0 +1,352 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHM_STABLE_SORT_HPP)
+#define HPX_PARALLEL_ALGORITHM_STABLE_SORT_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/traits/concepts.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/algorithms/detail/radix_sort.hpp>
+#include <hpx/parallel/algorithms/merge.hpp>
+#include <hpx/parallel/algorithms/sort.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/traits/projected.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // stable_sort
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // Sort [first, last) and leave the result either in place or in the
+        // sequence starting at dest, depending on to_dest. Both halves are
+        // sorted into the respective other sequence and are merged from
+        // there.
+        template <typename ExPolicy, typename Iter1, typename Iter2,
+            typename Comp, typename Proj>
+        void stable_sort_helper(ExPolicy& policy, Iter1 first, Iter1 last,
+            Iter2 dest, Comp& comp, Proj& proj, bool to_dest)
+        {
+            std::size_t size = last - first;
+            if (size <= sort_limit_per_task)
+            {
+                std::stable_sort(first, last,
+                    util::compare_projected<Comp&, Proj&>(comp, proj));
+                if (to_dest)
+                    std::move(first, last, dest);
+                return;
+            }
+
+            Iter1 mid = first + size / 2;
+            Iter2 dest_mid = dest + size / 2;
+            Iter2 dest_last = dest + size;
+
+            hpx::future<void> fut = execution::async_execute(policy.executor(),
+                [&]() -> void
+                {
+                    // Process leftside range.
+                    stable_sort_helper(policy, first, mid, dest, comp, proj,
+                        !to_dest);
+                });
+
+            try {
+                // Process rightside range.
+                stable_sort_helper(policy, mid, last, dest_mid, comp, proj,
+                    !to_dest);
+            }
+            catch (...) {
+                fut.wait();
+
+                std::vector<hpx::future<void>> futures(2);
+                futures[0] = std::move(fut);
+                futures[1] = hpx::make_exceptional_future<void>(
+                    std::current_exception());
+
+                std::list<std::exception_ptr> errors;
+                util::detail::handle_local_exceptions<ExPolicy>::call(
+                    futures, errors);
+
+                // Not reachable.
+                HPX_ASSERT(false);
+                return;
+            }
+
+            fut.get();
+
+            // The left range has to go first for stability.
+            if (to_dest)
+            {
+                parallel_merge_helper(policy,
+                    std::make_move_iterator(first),
+                    std::make_move_iterator(mid),
+                    std::make_move_iterator(mid),
+                    std::make_move_iterator(last),
+                    dest, comp, proj, proj);
+            }
+            else
+            {
+                parallel_merge_helper(policy,
+                    std::make_move_iterator(dest),
+                    std::make_move_iterator(dest_mid),
+                    std::make_move_iterator(dest_mid),
+                    std::make_move_iterator(dest_last),
+                    first, comp, proj, proj);
+            }
+        }
+
+        template <typename ExPolicy, typename RandomIt, typename Comp,
+            typename Proj>
+        RandomIt parallel_stable_sort(ExPolicy policy, RandomIt first,
+            RandomIt last, Comp comp, Proj proj)
+        {
+            typedef typename std::iterator_traits<RandomIt>::value_type
+                value_type;
+
+            // the elements are moved into the buffer and sorted from there
+            // back into the sequence
+            std::vector<value_type> buffer(
+                std::make_move_iterator(first), std::make_move_iterator(last));
+
+            stable_sort_helper(policy, buffer.begin(), buffer.end(), first,
+                comp, proj, true);
+
+            return last;
+        }
+
+        template <typename ExPolicy, typename RandomIt, typename Comp,
+            typename Proj>
+        hpx::future<RandomIt>
+        parallel_stable_sort_async(ExPolicy && policy, RandomIt first,
+            RandomIt last, Comp && comp, Proj && proj)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef typename hpx::util::decay<Comp>::type comp_type;
+            typedef typename hpx::util::decay<Proj>::type proj_type;
+
+            std::size_t size = last - first;
+            if (size <= sort_limit_per_task)
+            {
+                std::stable_sort(first, last,
+                    util::compare_projected<Comp, Proj>(
+                        std::forward<Comp>(comp), std::forward<Proj>(proj)));
+                return hpx::make_ready_future(last);
+            }
+
+            return execution::async_execute(policy.executor(),
+                &parallel_stable_sort<
+                    policy_type, RandomIt, comp_type, proj_type>,
+                policy, first, last, std::forward<Comp>(comp),
+                std::forward<Proj>(proj));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // stable_sort
+        template <typename RandomIt>
+        struct stable_sort
+          : public detail::algorithm<stable_sort<RandomIt>, RandomIt>
+        {
+            stable_sort()
+              : stable_sort::algorithm("stable_sort")
+            {}
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static RandomIt
+            sequential(ExPolicy, RandomIt first, RandomIt last,
+                Compare && comp, Proj && proj)
+            {
+                std::stable_sort(first, last,
+                    util::compare_projected<Compare, Proj>(
+                            std::forward<Compare>(comp),
+                            std::forward<Proj>(proj)
+                        ));
+                return last;
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, RandomIt
+            >::type
+            parallel(ExPolicy && policy, RandomIt first, RandomIt last,
+                Compare && comp, Proj && proj)
+            {
+                typedef util::detail::algorithm_result<
+                    ExPolicy, RandomIt
+                > algorithm_result;
+
+                try {
+                    // call the sort routine and return the right type,
+                    // depending on execution policy
+                    return algorithm_result::get(
+                        parallel_sort(
+                            typename use_radix_sort<
+                                RandomIt, Compare, Proj
+                            >::type(),
+                            std::forward<ExPolicy>(policy), first, last,
+                            std::forward<Compare>(comp),
+                            std::forward<Proj>(proj)));
+                }
+                catch (...) {
+                    return algorithm_result::get(
+                        detail::handle_exception<ExPolicy, RandomIt>::call(
+                            std::current_exception()));
+                }
+            }
+
+        private:
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static hpx::future<RandomIt>
+            parallel_sort(std::false_type, ExPolicy && policy,
+                RandomIt first, RandomIt last, Compare && comp, Proj && proj)
+            {
+                return parallel_stable_sort_async(
+                    std::forward<ExPolicy>(policy), first, last,
+                    std::forward<Compare>(comp), std::forward<Proj>(proj));
+            }
+
+            // LSD radix sort is stable as well
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static hpx::future<RandomIt>
+            parallel_sort(std::true_type, ExPolicy && policy,
+                RandomIt first, RandomIt last, Compare && comp, Proj && proj)
+            {
+                if (std::size_t(last - first) <= sort_limit_per_task)
+                {
+                    return parallel_sort(std::false_type(),
+                        std::forward<ExPolicy>(policy), first, last,
+                        std::forward<Compare>(comp), std::forward<Proj>(proj));
+                }
+
+                return parallel_radix_sort_async(
+                    std::forward<ExPolicy>(policy), first, last,
+                    std::forward<Proj>(proj));
+            }
+        };
+        /// \endcond
+    }
+
+    //-----------------------------------------------------------------------------
+    /// Sorts the elements in the range [first, last) in ascending order. The
+    /// order of equal elements is guaranteed to be preserved. The function
+    /// uses the given comparison function object comp (defaults to using
+    /// operator<()).
+    ///
+    /// \note   Complexity: O(Nlog(N)), where N = std::distance(first, last)
+    ///                     comparisons.
+    ///
+    /// A sequence is sorted with respect to a comparator \a comp and a
+    /// projection \a proj if for every iterator i pointing to the sequence and
+    /// every non-negative integer n such that i + n is a valid iterator
+    /// pointing to an element of the sequence, and
+    /// INVOKE(comp, INVOKE(proj, *(i + n)), INVOKE(proj, *i)) == false.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam Iter        The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     random access iterator.
+    /// \tparam Comp        The type of the function/function object to use
+    ///                     (deduced).
+    /// \tparam Proj        The type of an optional projection function. This
+    ///                     defaults to \a util::projection_identity
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param comp         comp is a callable object. The return value of the
+    ///                     INVOKE operation applied to an object of type Comp,
+    ///                     when contextually converted to bool, yields true if
+    ///                     the first argument of the call is less than the
+    ///                     second, and false otherwise. It is assumed that comp
+    ///                     will not apply any non-constant function through the
+    ///                     dereferenced iterator.
+    /// \param proj         Specifies the function (or function object) which
+    ///                     will be invoked for each pair of elements as a
+    ///                     projection operation before the actual predicate
+    ///                     \a comp is invoked.
+    ///
+    /// \a comp has to induce a strict weak ordering on the values.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a sequenced_policy execute in sequential order in the
+    /// calling thread.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a parallel_policy or \a parallel_task_policy are
+    /// permitted to execute in an unordered fashion in unspecified
+    /// threads, and indeterminately sequenced within each thread.
+    ///
+    /// The parallel versions of the algorithm merge sort the sequence using
+    /// a temporary buffer of the same size. Arithmetic elements (or
+    /// elements with arithmetic projections) compared using operator<() are
+    /// radix sorted instead.
+    ///
+    /// \returns  The \a stable_sort algorithm returns a
+    ///           \a hpx::future<RandomIt> if the execution policy is of
+    ///           type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and returns \a RandomIt
+    ///           otherwise.
+    ///           The algorithm returns an iterator pointing to the first
+    ///           element after the last element in the input sequence.
+    //-----------------------------------------------------------------------------
+    template <typename ExPolicy, typename RandomIt,
+        typename Proj = util::projection_identity,
+        typename Compare = detail::less,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<RandomIt>::value &&
+        traits::is_projected<Proj, RandomIt>::value &&
+        traits::is_indirect_callable<
+            ExPolicy, Compare,
+                traits::projected<Proj, RandomIt>,
+                traits::projected<Proj, RandomIt>
+        >::value)>
+    typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+    stable_sort(ExPolicy && policy, RandomIt first, RandomIt last,
+        Compare && comp = Compare(), Proj && proj = Proj())
+    {
+        static_assert(
+            (hpx::traits::is_random_access_iterator<RandomIt>::value),
+            "Requires a random access iterator.");
+
+        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+        return detail::stable_sort<RandomIt>().call(
+            std::forward<ExPolicy>(policy), is_seq(), first, last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj));
+    }
+}}}
+
+#endif
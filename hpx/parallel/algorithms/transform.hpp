@@ -29,6 +29,7 @@
 #include <hpx/parallel/traits/projected.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/foreach_partitioner.hpp>
+#include <hpx/parallel/util/prefetching_loop.hpp>
 #include <hpx/parallel/util/projection_identity.hpp>
 #include <hpx/parallel/util/transform_loop.hpp>
 #include <hpx/parallel/util/zip_iterator.hpp>
@@ -64,20 +65,37 @@ namespace hpx { namespace parallel { inline namespace v1
             }
         };
 
+        // The vectorized loops are not combined with non-temporal stores.
+        template <typename ExPolicy, typename OutIter>
+        bool use_nontemporal_stores(std::size_t count)
+        {
+            return !execution::is_vectorpack_execution_policy<ExPolicy>::value &&
+                util::detail::use_nontemporal_stores<OutIter>(count);
+        }
+
         template <typename ExPolicy, typename F, typename Proj>
         struct transform_iteration
         {
             typedef typename hpx::util::decay<ExPolicy>::type execution_policy_type;
             typedef typename hpx::util::decay<F>::type fun_type;
             typedef typename hpx::util::decay<Proj>::type proj_type;
+            typedef typename util::detail::prefetcher_type<
+                    execution_policy_type
+                >::type prefetcher_type;
 
             fun_type f_;
             proj_type proj_;
+            bool nontemporal_;
+            prefetcher_type prefetcher_;
 
             template <typename F_, typename Proj_>
-            HPX_HOST_DEVICE transform_iteration(F_ && f, Proj_ && proj)
+            HPX_HOST_DEVICE transform_iteration(F_ && f, Proj_ && proj,
+                    bool nontemporal = false,
+                    prefetcher_type const& prefetcher = prefetcher_type())
               : f_(std::forward<F_>(f))
               , proj_(std::forward<Proj_>(proj))
+              , nontemporal_(nontemporal)
+              , prefetcher_(prefetcher)
             {}
 
 #if !defined(__NVCC__) && !defined(__CUDACC__)
@@ -87,11 +105,15 @@ namespace hpx { namespace parallel { inline namespace v1
             HPX_HOST_DEVICE transform_iteration(transform_iteration const& rhs)
               : f_(rhs.f_)
               , proj_(rhs.proj_)
+              , nontemporal_(rhs.nontemporal_)
+              , prefetcher_(rhs.prefetcher_)
             {}
 
             HPX_HOST_DEVICE transform_iteration(transform_iteration && rhs)
               : f_(std::move(rhs.f_))
               , proj_(std::move(rhs.proj_))
+              , nontemporal_(rhs.nontemporal_)
+              , prefetcher_(std::move(rhs.prefetcher_))
             {}
 #endif
 
@@ -111,9 +133,16 @@ namespace hpx { namespace parallel { inline namespace v1
             execute(Iter part_begin, std::size_t part_size)
             {
                 auto iters = part_begin.get_iterator_tuple();
-                return util::transform_loop_n<execution_policy_type>(
+                if (nontemporal_)
+                {
+                    return util::transform_loop_n_nontemporal(
+                        hpx::util::get<0>(iters), part_size,
+                        hpx::util::get<1>(iters),
+                        transform_projected<F, Proj>{f_, proj_});
+                }
+                return util::transform_loop_n_prefetch<execution_policy_type>(
                     hpx::util::get<0>(iters), part_size,
-                    hpx::util::get<1>(iters),
+                    hpx::util::get<1>(iters), prefetcher_,
                     transform_projected<F, Proj>{f_, proj_});
             }
 
@@ -164,14 +193,16 @@ namespace hpx { namespace parallel { inline namespace v1
             {
                 if (first != last)
                 {
+                    std::size_t count = std::distance(first, last);
                     auto f1 = transform_iteration<ExPolicy, F, Proj>(
-                        std::forward<F>(f), std::forward<Proj>(proj));
+                        std::forward<F>(f), std::forward<Proj>(proj),
+                        use_nontemporal_stores<ExPolicy, FwdIter2>(count),
+                        util::get_prefetcher(policy));
 
                     return get_iter_pair(
                         util::foreach_partitioner<ExPolicy>::call(
                             std::forward<ExPolicy>(policy),
-                            hpx::util::make_zip_iterator(first, dest),
-                            std::distance(first, last),
+                            hpx::util::make_zip_iterator(first, dest), count,
                             std::move(f1), util::projection_identity()));
                 }
 
@@ -359,17 +390,26 @@ namespace hpx { namespace parallel { inline namespace v1
             typedef typename hpx::util::decay<F>::type fun_type;
             typedef typename hpx::util::decay<Proj1>::type proj1_type;
             typedef typename hpx::util::decay<Proj2>::type proj2_type;
+            typedef typename util::detail::prefetcher_type<
+                    execution_policy_type
+                >::type prefetcher_type;
 
             fun_type f_;
             proj1_type proj1_;
             proj2_type proj2_;
+            bool nontemporal_;
+            prefetcher_type prefetcher_;
 
             template <typename F_, typename Proj1_, typename Proj2_>
             HPX_HOST_DEVICE
-            transform_binary_iteration(F_ && f, Proj1_ && proj1, Proj2_ && proj2)
+            transform_binary_iteration(F_ && f, Proj1_ && proj1, Proj2_ && proj2,
+                    bool nontemporal = false,
+                    prefetcher_type const& prefetcher = prefetcher_type())
               : f_(std::forward<F_>(f))
               , proj1_(std::forward<Proj1_>(proj1))
               , proj2_(std::forward<Proj2_>(proj2))
+              , nontemporal_(nontemporal)
+              , prefetcher_(prefetcher)
             {}
 
 #if !defined(__NVCC__) && !defined(__CUDACC__)
@@ -381,6 +421,8 @@ namespace hpx { namespace parallel { inline namespace v1
               : f_(rhs.f_)
               , proj1_(rhs.proj1_)
               , proj2_(rhs.proj2_)
+              , nontemporal_(rhs.nontemporal_)
+              , prefetcher_(rhs.prefetcher_)
             {}
 
             HPX_HOST_DEVICE
@@ -388,6 +430,8 @@ namespace hpx { namespace parallel { inline namespace v1
               : f_(std::move(rhs.f_))
               , proj1_(std::move(rhs.proj1_))
               , proj2_(std::move(rhs.proj2_))
+              , nontemporal_(rhs.nontemporal_)
+              , prefetcher_(std::move(rhs.prefetcher_))
             {}
 #endif
 
@@ -413,10 +457,20 @@ namespace hpx { namespace parallel { inline namespace v1
                 std::size_t /*part_index*/)
             {
                 auto iters = part_begin.get_iterator_tuple();
-                return util::transform_binary_loop_n<execution_policy_type>(
-                    hpx::util::get<0>(iters), part_size,
+                if (nontemporal_)
+                {
+                    return util::transform_binary_loop_n_nontemporal(
+                        hpx::util::get<0>(iters), part_size,
+                        hpx::util::get<1>(iters), hpx::util::get<2>(iters),
+                        transform_binary_projected<F, Proj1, Proj2>{
+                            f_, proj1_, proj2_
+                        });
+                }
+                return util::transform_binary_loop_n_prefetch<
+                        execution_policy_type
+                    >(hpx::util::get<0>(iters), part_size,
                     hpx::util::get<1>(iters), hpx::util::get<2>(iters),
-                    transform_binary_projected<F, Proj1, Proj2>{
+                    prefetcher_, transform_binary_projected<F, Proj1, Proj2>{
                         f_, proj1_, proj2_
                     });
             }
@@ -456,16 +510,18 @@ namespace hpx { namespace parallel { inline namespace v1
             {
                 if (first1 != last1)
                 {
+                    std::size_t count = std::distance(first1, last1);
                     auto f1 = transform_binary_iteration<ExPolicy, F, Proj1, Proj2>(
                         std::forward<F>(f), std::forward<Proj1>(proj1),
-                        std::forward<Proj2>(proj2));
+                        std::forward<Proj2>(proj2),
+                        use_nontemporal_stores<ExPolicy, FwdIter3>(count),
+                        util::get_prefetcher(policy));
 
                     return get_iter_tuple(
                         util::foreach_partitioner<ExPolicy>::call(
                             std::forward<ExPolicy>(policy),
                             hpx::util::make_zip_iterator(first1, first2, dest),
-                            std::distance(first1, last1),
-                            std::move(f1), util::projection_identity()));
+                            count, std::move(f1), util::projection_identity()));
                 }
 
                 return util::detail::algorithm_result<
@@ -708,18 +764,20 @@ namespace hpx { namespace parallel { inline namespace v1
             {
                 if (first1 != last1 && first2 != last2)
                 {
+                    std::size_t count = (std::min)(
+                        std::distance(first1, last1),
+                        std::distance(first2, last2));
                     auto f1 = transform_binary_iteration<ExPolicy, F, Proj1, Proj2>(
                         std::forward<F>(f), std::forward<Proj1>(proj1),
-                        std::forward<Proj2>(proj2));
+                        std::forward<Proj2>(proj2),
+                        use_nontemporal_stores<ExPolicy, FwdIter3>(count),
+                        util::get_prefetcher(policy));
 
                     return get_iter_tuple(
                         util::foreach_partitioner<ExPolicy>::call(
                             std::forward<ExPolicy>(policy),
                             hpx::util::make_zip_iterator(first1, first2, dest),
-                            (std::min)(
-                                std::distance(first1, last1),
-                                std::distance(first2, last2)),
-                            std::move(f1), util::projection_identity()));
+                            count, std::move(f1), util::projection_identity()));
                 }
 
                 return util::detail::algorithm_result<
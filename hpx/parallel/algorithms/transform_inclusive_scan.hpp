@@ -20,8 +20,8 @@
 #include <hpx/parallel/execution_policy.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/loop.hpp>
+#include <hpx/parallel/util/lookback_scan_partitioner.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
-#include <hpx/parallel/util/scan_partitioner.hpp>
 #include <hpx/util/unused.hpp>
 
 #include <algorithm>
@@ -109,60 +109,45 @@ namespace hpx { namespace parallel { inline namespace v1
                 FwdIter2 final_dest = dest;
                 std::advance(final_dest, count);
 
-                // The overall scan algorithm is performed by executing 2
-                // subsequent parallel steps. The first calculates the scan
-                // results for each partition and the second produces the
-                // overall result
+                // The scan is performed in a single pass over tiles of the
+                // input. The first step calculates the sum of a tile, the
+                // second step writes the final results of the tile as soon
+                // as the sum of all preceding tiles is known (decoupled
+                // look-back).
 
                 using hpx::util::get;
                 using hpx::util::make_zip_iterator;
 
-                auto f3 =
-                    [op](
-                        zip_iterator part_begin, std::size_t part_size,
-                        hpx::shared_future<T> curr, hpx::shared_future<T> next
-                    ) -> void
-                    {
-                        next.get();     // rethrow exceptions
-
-                        T val = curr.get();
-                        FwdIter2 dst = get<1>(part_begin.get_iterator_tuple());
-
-                        util::loop_n<ExPolicy>(
-                            dst, part_size,
-                            [&op, &val](FwdIter2 it) -> void
-                            {
-                                *it = hpx::util::invoke(op, *it, val);
-                            });
-                    };
-
-                return util::scan_partitioner<ExPolicy, FwdIter2, T>::call(
+                return util::lookback_scan_partitioner<
+                        ExPolicy, FwdIter2, T
+                    >::call(
                     std::forward<ExPolicy>(policy),
                     make_zip_iterator(first, dest), count, init,
-                    // step 1 performs first part of scan algorithm
+                    // step 1 calculates the sum of each tile
                     [op, conv](
-                        zip_iterator part_begin, std::size_t part_size
-                    ) -> T
+                        zip_iterator part_begin, std::size_t part_size) -> T
+                    {
+                        FwdIter1 it = get<0>(part_begin.get_iterator_tuple());
+                        T sum = hpx::util::invoke(conv, *it);
+                        for (++it; --part_size != 0; ++it)
+                        {
+                            sum = hpx::util::invoke(
+                                op, sum, hpx::util::invoke(conv, *it));
+                        }
+                        return sum;
+                    },
+                    // the sums of the tiles are combined using op
+                    op,
+                    // step 2 writes the results of each tile in one sweep
+                    [op, conv](zip_iterator part_begin,
+                        std::size_t part_size, T const& prefix) -> void
                     {
-                        T part_init =
-                            hpx::util::invoke(conv, get<0>(*part_begin));
-                        get<1>(*part_begin++) = part_init;
-
                         auto iters = part_begin.get_iterator_tuple();
-                        return sequential_transform_inclusive_scan_n(
-                            get<0>(iters),
-                            part_size-1,
-                            get<1>(iters),
-                            conv, part_init, op);
+                        sequential_transform_inclusive_scan_n(get<0>(iters),
+                            part_size, get<1>(iters), conv, prefix, op);
                     },
-                    // step 2 propagates the partition results from left
-                    // to right
-                    hpx::util::unwrapping(op),
-                    // step 3 runs final accumulation on each partition
-                    std::move(f3),
-                    // step 4 use this return value
-                    [final_dest](std::vector<hpx::shared_future<T> > &&,
-                        std::vector<hpx::future<void> > &&) -> FwdIter2
+                    // step 3 use this return value
+                    [final_dest](T const&) -> FwdIter2
                     {
                         return final_dest;
                     });
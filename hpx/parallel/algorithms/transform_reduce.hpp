@@ -23,6 +23,7 @@
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/loop.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
+#include <hpx/parallel/util/prefetching_loop.hpp>
 
 #include <algorithm>
 #include <cstddef>
@@ -53,16 +54,9 @@ namespace hpx { namespace parallel { inline namespace v1
             sequential(ExPolicy, InIter first, InIter last, T_ && init,
                 Reduce && r, Convert && conv)
             {
-                typedef typename std::iterator_traits<InIter>::value_type
-                    value_type;
-
-                return std::accumulate(
-                    first, last, std::forward<T_>(init),
-                    [&r, &conv](T const& res, value_type const& next) -> T
-                    {
-                        return hpx::util::invoke(r, res,
-                            hpx::util::invoke(conv, next));
-                    });
+                return util::transform_accumulate<ExPolicy>(first, last,
+                    T(std::forward<T_>(init)), std::forward<Reduce>(r),
+                    std::forward<Convert>(conv));
             }
 
             template <typename ExPolicy, typename FwdIter, typename T_,
@@ -78,23 +72,15 @@ namespace hpx { namespace parallel { inline namespace v1
                         std::move(init_));
                 }
 
-                typedef typename std::iterator_traits<FwdIter>::reference
-                    reference;
-
+                auto prefetcher = util::get_prefetcher(policy);
                 auto f1 =
-                    [r, HPX_CAPTURE_FORWARD(conv)](
+                    [r, HPX_CAPTURE_FORWARD(conv), prefetcher](
                         FwdIter part_begin, std::size_t part_size) -> T
                     {
                         T val = hpx::util::invoke(conv, *part_begin);
-                        return util::accumulate_n(++part_begin, --part_size,
-                            std::move(val),
-                            // MSVC14 bails out if r and conv are captured by
-                            // reference
-                            [=](T const& res, reference next)-> T
-                            {
-                                return hpx::util::invoke(r, res,
-                                    hpx::util::invoke(conv, next));
-                            });
+                        return util::transform_accumulate_n_prefetch<ExPolicy>(
+                            ++part_begin, --part_size, std::move(val),
+                            prefetcher, r, conv);
                     };
 
                 return util::partitioner<ExPolicy, T>::call(
@@ -17,6 +17,7 @@
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/loop.hpp>
 #include <hpx/parallel/util/partitioner_with_cleanup.hpp>
+#include <hpx/parallel/util/transfer.hpp>
 #include <hpx/parallel/util/zip_iterator.hpp>
 
 #include <algorithm>
@@ -92,14 +93,23 @@ namespace hpx { namespace parallel { inline namespace v1
             typedef typename std::iterator_traits<Iter>::value_type
                 value_type;
 
+            // trivially copyable values can be written using non-temporal
+            // stores, those don't need to be constructed in place
+            bool nontemporal = util::detail::use_nontemporal_stores<Iter>(count);
+
             util::cancellation_token<util::detail::no_data> tok;
             return util::partitioner_with_cleanup<
                     ExPolicy, void, partition_result_type
                 >::call(
                     std::forward<ExPolicy>(policy), first, count,
-                    [value, tok](Iter it, std::size_t part_size)
+                    [value, tok, nontemporal](Iter it, std::size_t part_size)
                         mutable -> partition_result_type
                     {
+                        if (nontemporal)
+                        {
+                            return std::make_pair(it,
+                                util::fill_n_nontemporal(it, part_size, value));
+                        }
                         return std::make_pair(it,
                             sequential_uninitialized_fill_n(
                                 it, part_size, value, tok));
@@ -9,6 +9,8 @@
 #include <hpx/config.hpp>
 #include <hpx/traits/concepts.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/assert.hpp>
 #include <hpx/util/invoke.hpp>
 #include <hpx/util/tagged_pair.hpp>
 #include <hpx/util/unused.hpp>
@@ -85,7 +87,6 @@ namespace hpx { namespace parallel { inline namespace v1
             parallel(ExPolicy && policy, FwdIter first, FwdIter last,
                 Pred && pred, Proj && proj)
             {
-                typedef hpx::util::zip_iterator<FwdIter, bool*> zip_iterator;
                 typedef util::detail::algorithm_result<
                     ExPolicy, FwdIter
                 > algorithm_result;
@@ -97,129 +98,132 @@ namespace hpx { namespace parallel { inline namespace v1
                 if (count < 2)
                     return algorithm_result::get(std::move(last));
 
-                boost::shared_array<bool> flags(new bool[count]);
                 std::size_t init = 0u;
 
-                flags[0] = false;
-
-                using hpx::util::get;
-                using hpx::util::make_zip_iterator;
                 typedef util::scan_partitioner<
                         ExPolicy, FwdIter, std::size_t, void,
                         util::scan_partitioner_sequential_f3_tag
                     > scan_partitioner_type;
 
+                // step 1 removes the duplicates of each partition in place,
+                // the first element of a partition is kept until it is
+                // compared with the last element kept before it in step 3
                 auto f1 =
-                    [HPX_CAPTURE_FORWARD(pred),
-                        HPX_CAPTURE_FORWARD(proj)
-                    ](zip_iterator part_begin, std::size_t part_size)
+                    [pred, proj](FwdIter part_begin, std::size_t part_size)
                     -> std::size_t
                     {
-                        FwdIter base = get<0>(part_begin.get_iterator_tuple());
-
-                        // MSVC complains if pred or proj is captured by ref below
-                        util::loop_n<ExPolicy>(
-                            ++part_begin, part_size,
-                            [base, pred, proj](zip_iterator it) mutable
-                            {
-                                using hpx::util::invoke;
-
-                                bool f = invoke(pred,
-                                    invoke(proj, *base),
-                                    invoke(proj, get<0>(*it)));
+                        FwdIter part_end = part_begin;
+                        std::advance(part_end, part_size);
 
-                                if (!(get<1>(*it) = f))
-                                    base = get<0>(it.get_iterator_tuple());
-                            });
-
-                        // There is no need to return the partition result.
-                        // But, the scan_partitioner doesn't support 'void' as
-                        // Result1. So, unavoidably return non-meaning value.
-                        return 0u;
+                        return std::distance(part_begin,
+                            sequential_unique(part_begin, part_end,
+                                pred, proj));
                     };
 
-                std::shared_ptr<FwdIter> dest_ptr =
-                    std::make_shared<FwdIter>(first);
+                // the end of the elements kept so far and the position of
+                // the last of them
+                std::shared_ptr<std::pair<FwdIter, FwdIter> > dest_ptr =
+                    std::make_shared<std::pair<FwdIter, FwdIter> >(
+                        first, first);
                 auto f3 =
-                    [dest_ptr, flags](
-                        zip_iterator part_begin, std::size_t part_size,
-                        hpx::shared_future<std::size_t> curr,
-                        hpx::shared_future<std::size_t> next
+                    [dest_ptr, first,
+                        HPX_CAPTURE_FORWARD(pred),
+                        HPX_CAPTURE_FORWARD(proj)
+                    ](FwdIter part_begin, std::size_t,
+                        hpx::shared_future<std::size_t> prev,
+                        hpx::shared_future<std::size_t> curr
                     ) mutable -> void
                     {
-                        HPX_UNUSED(flags);
+                        prev.get();     // rethrow exceptions
 
-                        curr.get();     // rethrow exceptions
-                        next.get();     // rethrow exceptions
+                        std::size_t kept = curr.get();
+                        FwdIter& dest = dest_ptr->first;
+                        FwdIter& last_kept = dest_ptr->second;
+
+                        if (part_begin != first)
+                        {
+                            using hpx::util::invoke;
 
-                        FwdIter& dest = *dest_ptr;
+                            HPX_ASSERT(kept != 0);
+                            if (invoke(pred, invoke(proj, *last_kept),
+                                    invoke(proj, *part_begin)))
+                            {
+                                ++part_begin;
+                                if (--kept == 0)
+                                    return;
+                            }
+                        }
 
-                        if (dest == get<0>(part_begin.get_iterator_tuple()))
+                        // move the remaining elements of the partition as
+                        // one block behind the elements kept so far
+                        last_kept = dest;
+                        std::advance(last_kept, kept - 1);
+
+                        if (dest == part_begin)
                         {
-                            // Self-assignment must be detected.
-                            util::loop_n<ExPolicy>(
-                                part_begin, part_size,
-                                [&dest](zip_iterator it)
-                                {
-                                    if(!get<1>(*it))
-                                    {
-                                        if (dest != get<0>(it.get_iterator_tuple()))
-                                            *dest++ = std::move(get<0>(*it));
-                                        else
-                                            ++dest;
-                                    }
-                                });
+                            dest = last_kept;
+                            ++dest;
                         }
                         else
                         {
-                            // Self-assignment can't be performed.
-                            util::loop_n<ExPolicy>(
-                                part_begin, part_size,
-                                [&dest](zip_iterator it)
-                                {
-                                    if(!get<1>(*it))
-                                        *dest++ = std::move(get<0>(*it));
-                                });
+                            FwdIter part_end = part_begin;
+                            std::advance(part_end, kept);
+                            dest = std::move(part_begin, part_end, dest);
                         }
                     };
 
                 return scan_partitioner_type::call(
                     std::forward<ExPolicy>(policy),
-                    make_zip_iterator(first, flags.get()),
-                    count - 1, init,
+                    first, count, init,
                     // step 1 performs first part of scan algorithm
                     std::move(f1),
-                    // step 2 propagates the partition results from left
-                    // to right
+                    // step 2 hands the number of elements kept by each
+                    // partition to step 3
                     hpx::util::unwrapping(
-                        [](std::size_t, std::size_t) -> std::size_t
+                        [](std::size_t, std::size_t curr) -> std::size_t
                         {
-                            // There is no need to propagate the partition
-                            // results. But, the scan_partitioner doesn't
-                            // support 'void' as Result1. So, unavoidably
-                            // return non-meaning value.
-                            return 0u;
+                            return curr;
                         }),
-                    // step 3 runs final accumulation on each partition
+                    // step 3 moves the elements of each partition in place
                     std::move(f3),
                     // step 4 use this return value
-                    [HPX_CAPTURE_MOVE(dest_ptr), first, count, flags](
+                    [HPX_CAPTURE_MOVE(dest_ptr)](
                         std::vector<hpx::shared_future<std::size_t> > &&,
                         std::vector<hpx::future<void> > &&) mutable
                     ->  FwdIter
                     {
-                        if (!flags[count - 1])
-                        {
-                            std::advance(first, count - 1);
-                            if (first != (*dest_ptr))
-                                *(*dest_ptr)++ = std::move(*first);
-                            else
-                                ++(*dest_ptr);
-                        }
-                        return *dest_ptr;
+                        return dest_ptr->first;
                     });
             }
         };
+
+        template <typename ExPolicy, typename FwdIter, typename Pred,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        unique_(ExPolicy && policy, FwdIter first, FwdIter last,
+            Pred && pred, Proj && proj, std::false_type)
+        {
+#if defined(HPX_HAVE_ALGORITHM_INPUT_ITERATOR_SUPPORT)
+            typedef std::integral_constant<bool,
+                    execution::is_sequenced_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter>::value
+                > is_seq;
+#else
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+#endif
+
+            return detail::unique<FwdIter>().call(
+                    std::forward<ExPolicy>(policy), is_seq(),
+                    first, last, std::forward<Pred>(pred),
+                    std::forward<Proj>(proj));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename SegIter, typename Pred,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        unique_(ExPolicy && policy, SegIter first, SegIter last,
+            Pred && pred, Proj && proj, std::true_type);
         /// \endcond
     }
 
@@ -312,23 +316,17 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_input_iterator<FwdIter>::value),
             "Required at least input iterator.");
-
-        typedef std::integral_constant<bool,
-                execution::is_sequenced_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter>::value
-            > is_seq;
 #else
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter>::value),
             "Required at least forward iterator.");
-
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
 #endif
 
-        return detail::unique<FwdIter>().call(
-                std::forward<ExPolicy>(policy), is_seq(),
+        typedef hpx::traits::is_segmented_iterator<FwdIter> is_segmented;
+
+        return detail::unique_(std::forward<ExPolicy>(policy),
                 first, last, std::forward<Pred>(pred),
-                std::forward<Proj>(proj));
+                std::forward<Proj>(proj), is_segmented());
     }
 
     /////////////////////////////////////////////////////////////////////////////
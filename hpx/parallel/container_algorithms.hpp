@@ -21,6 +21,7 @@
 #include <hpx/parallel/container_algorithms/minmax.hpp>
 #include <hpx/parallel/container_algorithms/move.hpp>
 #include <hpx/parallel/container_algorithms/partition.hpp>
+#include <hpx/parallel/container_algorithms/reduce.hpp>
 #include <hpx/parallel/container_algorithms/remove.hpp>
 #include <hpx/parallel/container_algorithms/remove_copy.hpp>
 #include <hpx/parallel/container_algorithms/replace.hpp>
@@ -30,5 +31,6 @@
 #include <hpx/parallel/container_algorithms/sort.hpp>
 #include <hpx/parallel/container_algorithms/transform.hpp>
 #include <hpx/parallel/container_algorithms/unique.hpp>
+#include <hpx/parallel/container_algorithms/views.hpp>
 
 #endif
@@ -12,10 +12,12 @@
 #include <hpx/traits/concepts.hpp>
 #include <hpx/traits/is_iterator.hpp>
 #include <hpx/traits/is_range.hpp>
+#include <hpx/util/decay.hpp>
 #include <hpx/util/range.hpp>
 #include <hpx/util/tagged_pair.hpp>
 
 #include <hpx/parallel/algorithms/copy.hpp>
+#include <hpx/parallel/container_algorithms/views.hpp>
 #include <hpx/parallel/traits/projected.hpp>
 #include <hpx/parallel/traits/projected_range.hpp>
 
@@ -24,6 +26,57 @@
 
 namespace hpx { namespace parallel { inline namespace v1
 {
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+        template <typename ExPolicy, typename Rng, typename OutIter>
+        typename util::detail::algorithm_result<
+            ExPolicy,
+            hpx::util::tagged_pair<
+                tag::in(typename hpx::traits::range_traits<Rng>::iterator_type),
+                tag::out(OutIter)
+            >
+        >::type
+        copy_range(ExPolicy && policy, Rng && rng, OutIter dest,
+            std::false_type)
+        {
+            return v1::copy(std::forward<ExPolicy>(policy),
+                hpx::util::begin(rng), hpx::util::end(rng), dest);
+        }
+
+        // Copying a filter view copies the elements of the adapted range
+        // which satisfy the predicate, every chunk compacts its elements
+        // before they are written.
+        template <typename ExPolicy, typename Rng, typename OutIter>
+        typename util::detail::algorithm_result<
+            ExPolicy,
+            hpx::util::tagged_pair<
+                tag::in(typename hpx::traits::range_traits<Rng>::iterator_type),
+                tag::out(OutIter)
+            >
+        >::type
+        copy_range(ExPolicy && policy, Rng && rng, OutIter dest,
+            std::true_type)
+        {
+            typedef typename hpx::util::decay<Rng>::type view_type;
+            typedef typename view_type::iterator iterator;
+            typedef decltype(rng.base_begin()) base_iterator;
+
+            iterator last = rng.end();
+            return views::detail::convert_filter_result(
+                v1::copy_if(std::forward<ExPolicy>(policy),
+                    rng.base_begin(), rng.base_end(), dest, rng.predicate()),
+                [last](hpx::util::tagged_pair<
+                        tag::in(base_iterator), tag::out(OutIter)
+                    > const& p)
+                {
+                    return hpx::util::make_tagged_pair<tag::in, tag::out>(
+                        last, p.out());
+                });
+        }
+        /// \endcond
+    }
+
     /// Copies the elements in the range \a rng to another
     /// range beginning at \a dest.
     ///
@@ -82,8 +135,12 @@ namespace hpx { namespace parallel { inline namespace v1
     >::type
     copy(ExPolicy && policy, Rng && rng, OutIter dest)
     {
-        return copy(std::forward<ExPolicy>(policy),
-            hpx::util::begin(rng), hpx::util::end(rng), dest);
+        typedef traits::is_filter_view<
+                typename hpx::util::decay<Rng>::type
+            > is_filter_view;
+
+        return detail::copy_range(std::forward<ExPolicy>(policy),
+            std::forward<Rng>(rng), dest, is_filter_view());
     }
 
     /// Copies the elements in the range \a rng to another
@@ -11,9 +11,11 @@
 #include <hpx/config.hpp>
 #include <hpx/traits/concepts.hpp>
 #include <hpx/traits/is_range.hpp>
+#include <hpx/util/decay.hpp>
 #include <hpx/util/range.hpp>
 
 #include <hpx/parallel/algorithms/for_each.hpp>
+#include <hpx/parallel/container_algorithms/views.hpp>
 #include <hpx/parallel/traits/projected_range.hpp>
 #include <hpx/parallel/util/projection_identity.hpp>
 
@@ -22,6 +24,50 @@
 
 namespace hpx { namespace parallel { inline namespace v1
 {
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+        template <typename ExPolicy, typename Rng, typename F, typename Proj>
+        typename util::detail::algorithm_result<
+            ExPolicy, typename hpx::traits::range_iterator<Rng>::type
+        >::type
+        for_each_range(ExPolicy && policy, Rng && rng, F && f, Proj && proj,
+            std::false_type)
+        {
+            return v1::for_each(std::forward<ExPolicy>(policy),
+                hpx::util::begin(rng), hpx::util::end(rng),
+                std::forward<F>(f), std::forward<Proj>(proj));
+        }
+
+        // The elements of a filter view are visited by iterating over the
+        // adapted range, the predicate is evaluated in the same pass.
+        template <typename ExPolicy, typename Rng, typename F, typename Proj>
+        typename util::detail::algorithm_result<
+            ExPolicy, typename hpx::traits::range_iterator<Rng>::type
+        >::type
+        for_each_range(ExPolicy && policy, Rng && rng, F && f, Proj && proj,
+            std::true_type)
+        {
+            typedef typename hpx::util::decay<Rng>::type view_type;
+            typedef typename view_type::iterator iterator;
+            typedef decltype(rng.base_begin()) base_iterator;
+            typedef views::detail::filtered_function<
+                    typename hpx::util::decay<F>::type,
+                    typename hpx::util::decay<decltype(rng.predicate())>::type,
+                    typename hpx::util::decay<Proj>::type
+                > function_type;
+
+            iterator last = rng.end();
+            return views::detail::convert_filter_result(
+                v1::for_each(std::forward<ExPolicy>(policy),
+                    rng.base_begin(), rng.base_end(),
+                    function_type{std::forward<F>(f), rng.predicate(),
+                        std::forward<Proj>(proj)}),
+                [last](base_iterator const&) { return last; });
+        }
+        /// \endcond
+    }
+
     /// Applies \a f to the result of dereferencing every iterator in the
     /// given range \a rng.
     ///
@@ -106,9 +152,13 @@ namespace hpx { namespace parallel { inline namespace v1
     >::type
     for_each(ExPolicy && policy, Rng && rng, F && f, Proj && proj = Proj())
     {
-        return for_each(std::forward<ExPolicy>(policy),
-            hpx::util::begin(rng), hpx::util::end(rng), std::forward<F>(f),
-            std::forward<Proj>(proj));
+        typedef traits::is_filter_view<
+                typename hpx::util::decay<Rng>::type
+            > is_filter_view;
+
+        return detail::for_each_range(std::forward<ExPolicy>(policy),
+            std::forward<Rng>(rng), std::forward<F>(f),
+            std::forward<Proj>(proj), is_filter_view());
     }
 }}}
 
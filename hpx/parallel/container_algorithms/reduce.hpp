@@ -0,0 +1,270 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/container_algorithms/reduce.hpp
+
+#if !defined(HPX_PARALLEL_CONTAINER_ALGORITHM_REDUCE_HPP)
+#define HPX_PARALLEL_CONTAINER_ALGORITHM_REDUCE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/traits/concepts.hpp>
+#include <hpx/traits/is_range.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/optional.hpp>
+#include <hpx/util/range.hpp>
+
+#include <hpx/parallel/algorithms/reduce.hpp>
+#include <hpx/parallel/algorithms/transform_reduce.hpp>
+#include <hpx/parallel/container_algorithms/views.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // the elements not satisfying the predicate don't contribute
+        template <typename Pred, typename T>
+        struct filter_to_optional
+        {
+            Pred pred_;
+
+            template <typename U>
+            hpx::util::optional<T> operator()(U const& value) const
+            {
+                if (hpx::util::invoke(pred_, value))
+                    return hpx::util::optional<T>(T(value));
+                return hpx::util::optional<T>();
+            }
+        };
+
+        template <typename F, typename T>
+        struct combine_optional
+        {
+            F f_;
+
+            hpx::util::optional<T> operator()(hpx::util::optional<T> const& lhs,
+                hpx::util::optional<T> const& rhs) const
+            {
+                if (!lhs)
+                    return rhs;
+                if (!rhs)
+                    return lhs;
+                return hpx::util::optional<T>(
+                    hpx::util::invoke(f_, *lhs, *rhs));
+            }
+        };
+
+        template <typename ExPolicy, typename Rng, typename T, typename F>
+        typename util::detail::algorithm_result<ExPolicy, T>::type
+        reduce_range(ExPolicy && policy, Rng && rng, T init, F && f,
+            std::false_type)
+        {
+            return v1::reduce(std::forward<ExPolicy>(policy),
+                hpx::util::begin(rng), hpx::util::end(rng), std::move(init),
+                std::forward<F>(f));
+        }
+
+        // The elements of a filter view are reduced in one pass over the
+        // adapted range, the reduction of every chunk skips the elements
+        // not satisfying the predicate.
+        template <typename ExPolicy, typename Rng, typename T, typename F>
+        typename util::detail::algorithm_result<ExPolicy, T>::type
+        reduce_range(ExPolicy && policy, Rng && rng, T init, F && f,
+            std::true_type)
+        {
+            typedef typename hpx::util::decay<F>::type func_type;
+            typedef filter_to_optional<
+                    typename hpx::util::decay<decltype(rng.predicate())>::type,
+                    T
+                > convert_type;
+            typedef combine_optional<func_type, T> combine_type;
+
+            func_type op(std::forward<F>(f));
+            return views::detail::convert_filter_result(
+                v1::transform_reduce(std::forward<ExPolicy>(policy),
+                    rng.base_begin(), rng.base_end(), hpx::util::optional<T>(),
+                    combine_type{op}, convert_type{rng.predicate()}),
+                [init, op](hpx::util::optional<T> const& r) -> T
+                {
+                    return r ? hpx::util::invoke(op, init, *r) : init;
+                });
+        }
+        /// \endcond
+    }
+
+    /// Returns GENERALIZED_SUM(f, init, *first, ..., *(first + (last - first) - 1))
+    /// for the range [first, last) given by \a rng.
+    ///
+    /// \note   Complexity: O(\a size(rng)) applications of the
+    ///         predicate \a f.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it executes the assignments.
+    /// \tparam Rng         The type of the source range used (deduced).
+    ///                     The iterators extracted from this range type must
+    ///                     meet the requirements of an forward iterator.
+    /// \tparam F           The type of the function/function object to use
+    ///                     (deduced). Unlike its sequential form, the parallel
+    ///                     overload of \a reduce requires \a F to meet the
+    ///                     requirements of \a CopyConstructible.
+    /// \tparam T           The type of the value to be used as initial (and
+    ///                     intermediate) values (deduced).
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param rng          Refers to the sequence of elements the algorithm
+    ///                     will be applied to.
+    /// \param init         The initial value for the generalized sum.
+    /// \param f            Specifies the function (or function object) which
+    ///                     will be invoked for each of the elements in the
+    ///                     sequence specified by \a rng. This is a
+    ///                     binary predicate. The signature of this predicate
+    ///                     should be equivalent to:
+    ///                     \code
+    ///                     Ret fun(const Type1 &a, const Type1 &b);
+    ///                     \endcode \n
+    ///                     The signature does not need to have const&.
+    ///                     The types \a Type1 \a Ret must be
+    ///                     such that an object of type \a T can be
+    ///                     implicitly converted to any of those types.
+    ///
+    /// The reduce operations in the parallel \a reduce algorithm invoked
+    /// with an execution policy object of type \a sequenced_policy
+    /// execute in sequential order in the calling thread.
+    ///
+    /// The reduce operations in the parallel \a reduce algorithm invoked
+    /// with an execution policy object of type \a parallel_policy
+    /// or \a parallel_task_policy are permitted to execute in an unordered
+    /// fashion in unspecified threads, and indeterminately sequenced
+    /// within each thread.
+    ///
+    /// If \a rng is a filter view, only the elements satisfying its
+    /// predicate are reduced. Those are selected while the adapted range is
+    /// reduced, no intermediate sequence is formed.
+    ///
+    /// \returns  The \a reduce algorithm returns a \a hpx::future<T> if the
+    ///           execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and
+    ///           returns \a T otherwise.
+    ///           The \a reduce algorithm returns the result of the
+    ///           generalized sum over the elements given by the input range
+    ///           \a rng.
+    ///
+    template <typename ExPolicy, typename Rng, typename T, typename F,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_range<Rng>::value)>
+    typename util::detail::algorithm_result<ExPolicy, T>::type
+    reduce(ExPolicy && policy, Rng && rng, T init, F && f)
+    {
+        typedef traits::is_filter_view<
+                typename hpx::util::decay<Rng>::type
+            > is_filter_view;
+
+        return detail::reduce_range(std::forward<ExPolicy>(policy),
+            std::forward<Rng>(rng), std::move(init), std::forward<F>(f),
+            is_filter_view());
+    }
+
+    /// Returns GENERALIZED_SUM(+, init, *first, ..., *(first + (last - first) - 1))
+    /// for the range [first, last) given by \a rng.
+    ///
+    /// \note   Complexity: O(\a size(rng)) applications of the
+    ///         operator+().
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it executes the assignments.
+    /// \tparam Rng         The type of the source range used (deduced).
+    ///                     The iterators extracted from this range type must
+    ///                     meet the requirements of an forward iterator.
+    /// \tparam T           The type of the value to be used as initial (and
+    ///                     intermediate) values (deduced).
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param rng          Refers to the sequence of elements the algorithm
+    ///                     will be applied to.
+    /// \param init         The initial value for the generalized sum.
+    ///
+    /// \returns  The \a reduce algorithm returns a \a hpx::future<T> if the
+    ///           execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and
+    ///           returns \a T otherwise.
+    ///           The \a reduce algorithm returns the result of the
+    ///           generalized sum (applying operator+()) over the elements
+    ///           given by the input range \a rng.
+    ///
+    template <typename ExPolicy, typename Rng, typename T,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_range<Rng>::value)>
+    typename util::detail::algorithm_result<ExPolicy, T>::type
+    reduce(ExPolicy && policy, Rng && rng, T init)
+    {
+        return reduce(std::forward<ExPolicy>(policy), std::forward<Rng>(rng),
+            std::move(init), std::plus<T>());
+    }
+
+    /// Returns GENERALIZED_SUM(+, T(), *first, ..., *(first + (last - first) - 1))
+    /// for the range [first, last) given by \a rng, where T is the
+    /// value_type of the iterators of \a rng.
+    ///
+    /// \note   Complexity: O(\a size(rng)) applications of the
+    ///         operator+().
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it executes the assignments.
+    /// \tparam Rng         The type of the source range used (deduced).
+    ///                     The iterators extracted from this range type must
+    ///                     meet the requirements of an forward iterator.
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param rng          Refers to the sequence of elements the algorithm
+    ///                     will be applied to.
+    ///
+    /// \returns  The \a reduce algorithm returns a \a hpx::future<T> if the
+    ///           execution policy is of type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and
+    ///           returns T otherwise.
+    ///           The \a reduce algorithm returns the result of the
+    ///           generalized sum (applying operator+()) over the elements
+    ///           given by the input range \a rng.
+    ///
+    template <typename ExPolicy, typename Rng,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_range<Rng>::value)>
+    typename util::detail::algorithm_result<
+        ExPolicy, typename hpx::traits::range_traits<Rng>::value_type
+    >::type
+    reduce(ExPolicy && policy, Rng && rng)
+    {
+        typedef typename hpx::traits::range_traits<Rng>::value_type
+            value_type;
+
+        return reduce(std::forward<ExPolicy>(policy), std::forward<Rng>(rng),
+            value_type(), std::plus<value_type>());
+    }
+}}}
+
+#endif
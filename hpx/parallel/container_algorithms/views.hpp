@@ -0,0 +1,421 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/container_algorithms/views.hpp
+
+#if !defined(HPX_PARALLEL_CONTAINER_ALGORITHM_VIEWS_HPP)
+#define HPX_PARALLEL_CONTAINER_ALGORITHM_VIEWS_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/traits/is_future.hpp>
+#include <hpx/traits/is_range.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/iterator_facade.hpp>
+#include <hpx/util/iterator_range.hpp>
+#include <hpx/util/range.hpp>
+#include <hpx/util/result_of.hpp>
+#include <hpx/util/transform_iterator.hpp>
+#include <hpx/util/tuple.hpp>
+#include <hpx/util/zip_iterator.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// The views defined here are lazy adaptors of existing ranges. Applying the
+// parallel algorithms to a chain of views evaluates the whole chain in one
+// pass over each of the chunks, no intermediate results are stored. The views
+// refer to the ranges they adapt, those have to outlive the views.
+namespace hpx { namespace parallel { inline namespace v1 { namespace views
+{
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // The iterators of the views store the functions they apply. This
+        // makes those copy assignable even if the function is not (such as
+        // lambdas), which is required by the iterators.
+        template <typename F>
+        struct function_holder
+        {
+            template <typename F_, typename Enable = typename
+                std::enable_if<
+                   !std::is_same<
+                        typename hpx::util::decay<F_>::type, function_holder
+                    >::value
+                >::type>
+            explicit function_holder(F_ && f)
+              : f_(std::forward<F_>(f))
+            {}
+
+            function_holder(function_holder const&) = default;
+            function_holder(function_holder &&) = default;
+
+            function_holder& operator=(function_holder const& rhs)
+            {
+                if (this != &rhs)
+                {
+                    f_.~F();
+                    ::new (static_cast<void*>(std::addressof(f_))) F(rhs.f_);
+                }
+                return *this;
+            }
+
+            F const& get() const
+            {
+                return f_;
+            }
+
+        private:
+            F f_;
+        };
+
+        // invokes the function with the dereferenced iterator
+        template <typename F>
+        struct dereference_transformer
+        {
+            explicit dereference_transformer(F f)
+              : f_(std::move(f))
+            {}
+
+            template <typename Iter>
+            typename hpx::util::invoke_result<
+                F const&, typename std::iterator_traits<Iter>::reference
+            >::type
+            operator()(Iter const& it) const
+            {
+                return hpx::util::invoke(f_.get(), *it);
+            }
+
+            function_holder<F> f_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // the position as the value, used by enumerate
+        class counting_iterator
+          : public hpx::util::iterator_facade<
+                counting_iterator, std::size_t const,
+                std::random_access_iterator_tag, std::size_t
+            >
+        {
+        public:
+            counting_iterator()
+              : value_(0)
+            {}
+
+            explicit counting_iterator(std::size_t value)
+              : value_(value)
+            {}
+
+        private:
+            friend class hpx::util::iterator_core_access;
+
+            std::size_t dereference() const
+            {
+                return value_;
+            }
+
+            bool equal(counting_iterator const& other) const
+            {
+                return value_ == other.value_;
+            }
+
+            void increment()
+            {
+                ++value_;
+            }
+
+            void decrement()
+            {
+                --value_;
+            }
+
+            void advance(std::ptrdiff_t n)
+            {
+                value_ += n;
+            }
+
+            std::ptrdiff_t distance_to(counting_iterator const& other) const
+            {
+                return std::ptrdiff_t(other.value_) - std::ptrdiff_t(value_);
+            }
+
+            std::size_t value_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // skips the elements not satisfying the predicate
+        template <typename Iter, typename Pred>
+        class filter_iterator
+          : public hpx::util::iterator_facade<
+                filter_iterator<Iter, Pred>,
+                typename std::iterator_traits<Iter>::value_type,
+                std::forward_iterator_tag,
+                typename std::iterator_traits<Iter>::reference,
+                typename std::iterator_traits<Iter>::difference_type
+            >
+        {
+        public:
+            filter_iterator(Iter it, Iter last, function_holder<Pred> pred)
+              : it_(it), last_(last), pred_(std::move(pred))
+            {
+                satisfy_predicate();
+            }
+
+            Iter base() const
+            {
+                return it_;
+            }
+
+        private:
+            friend class hpx::util::iterator_core_access;
+
+            typename std::iterator_traits<Iter>::reference dereference() const
+            {
+                return *it_;
+            }
+
+            bool equal(filter_iterator const& other) const
+            {
+                return it_ == other.it_;
+            }
+
+            void increment()
+            {
+                ++it_;
+                satisfy_predicate();
+            }
+
+            void satisfy_predicate()
+            {
+                while (it_ != last_ && !hpx::util::invoke(pred_.get(), *it_))
+                    ++it_;
+            }
+
+            Iter it_;
+            Iter last_;
+            function_holder<Pred> pred_;
+        };
+        /// \endcond
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A view of the elements of a range transformed by a function. The
+    /// iterators of this view have the same category as the iterators of the
+    /// adapted range.
+    template <typename Iter, typename F>
+    using transform_view = hpx::util::iterator_range<
+            hpx::util::transform_iterator<
+                Iter, detail::dereference_transformer<F>
+            >
+        >;
+
+    /// Returns a view of the elements of the range \a rng transformed by the
+    /// function \a f. The function is invoked whenever an element of the view
+    /// is accessed.
+    ///
+    /// \param rng          Refers to the sequence of elements to adapt.
+    /// \param f            Specifies the function (or function object) which
+    ///                     will be invoked for the elements of \a rng.
+    ///
+    template <typename Rng, typename F,
+        typename Iter = typename hpx::traits::range_iterator<Rng>::type>
+    transform_view<Iter, typename hpx::util::decay<F>::type>
+    transform(Rng && rng, F && f)
+    {
+        typedef detail::dereference_transformer<
+                typename hpx::util::decay<F>::type
+            > transformer;
+        typedef hpx::util::transform_iterator<Iter, transformer> iterator;
+
+        transformer t(std::forward<F>(f));
+        return transform_view<Iter, typename hpx::util::decay<F>::type>(
+            iterator(hpx::util::begin(rng), t),
+            iterator(hpx::util::end(rng), t));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A view of the elements of a range which satisfy a predicate. The
+    /// parallel algorithms operating on ranges (for_each, copy and reduce)
+    /// recognize filter views and apply the predicate while processing the
+    /// adapted range, each chunk compacts its elements independently.
+    template <typename Iter, typename Pred>
+    class filter_view
+    {
+    public:
+        typedef detail::filter_iterator<Iter, Pred> iterator;
+
+        template <typename Pred_>
+        filter_view(Iter first, Iter last, Pred_ && pred)
+          : first_(first), last_(last), pred_(std::forward<Pred_>(pred))
+        {}
+
+        iterator begin() const
+        {
+            return iterator(first_, last_, pred_);
+        }
+
+        iterator end() const
+        {
+            return iterator(last_, last_, pred_);
+        }
+
+        /// \cond NOINTERNAL
+        Iter base_begin() const
+        {
+            return first_;
+        }
+
+        Iter base_end() const
+        {
+            return last_;
+        }
+
+        Pred const& predicate() const
+        {
+            return pred_.get();
+        }
+        /// \endcond
+
+    private:
+        Iter first_;
+        Iter last_;
+        detail::function_holder<Pred> pred_;
+    };
+
+    /// Returns a view of the elements of the range \a rng for which the
+    /// predicate \a pred returns true.
+    ///
+    /// \param rng          Refers to the sequence of elements to adapt.
+    /// \param pred         Specifies the predicate which will be invoked for
+    ///                     the elements of \a rng.
+    ///
+    template <typename Rng, typename Pred,
+        typename Iter = typename hpx::traits::range_iterator<Rng>::type>
+    filter_view<Iter, typename hpx::util::decay<Pred>::type>
+    filter(Rng && rng, Pred && pred)
+    {
+        return filter_view<Iter, typename hpx::util::decay<Pred>::type>(
+            hpx::util::begin(rng), hpx::util::end(rng),
+            std::forward<Pred>(pred));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A view of the tuples of the corresponding elements of several ranges.
+    template <typename ... Iter>
+    using zip_view = hpx::util::iterator_range<
+            hpx::util::zip_iterator<Iter...>
+        >;
+
+    /// Returns a view of the tuples of the corresponding elements of the
+    /// ranges \a rngs, which have to be of the same size.
+    ///
+    /// \param rngs         Refer to the sequences of elements to adapt.
+    ///
+    template <typename ... Rng>
+    zip_view<typename hpx::traits::range_iterator<Rng>::type...>
+    zip(Rng && ... rngs)
+    {
+        return zip_view<typename hpx::traits::range_iterator<Rng>::type...>(
+            hpx::util::make_zip_iterator(hpx::util::begin(rngs)...),
+            hpx::util::make_zip_iterator(hpx::util::end(rngs)...));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A view of the elements of a range paired with their positions.
+    template <typename Iter>
+    using enumerate_view = zip_view<detail::counting_iterator, Iter>;
+
+    /// Returns a view of the tuples of the positions and the elements of the
+    /// range \a rng.
+    ///
+    /// \param rng          Refers to the sequence of elements to adapt.
+    ///
+    template <typename Rng,
+        typename Iter = typename hpx::traits::range_iterator<Rng>::type>
+    enumerate_view<Iter> enumerate(Rng && rng)
+    {
+        std::size_t size = std::distance(
+            hpx::util::begin(rng), hpx::util::end(rng));
+
+        return enumerate_view<Iter>(
+            hpx::util::make_zip_iterator(
+                detail::counting_iterator(0), hpx::util::begin(rng)),
+            hpx::util::make_zip_iterator(
+                detail::counting_iterator(size), hpx::util::end(rng)));
+    }
+}}}}
+
+namespace hpx { namespace parallel { namespace traits
+{
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    struct is_filter_view
+      : std::false_type
+    {};
+
+    template <typename Iter, typename Pred>
+    struct is_filter_view<parallel::views::filter_view<Iter, Pred> >
+      : std::true_type
+    {};
+}}}
+
+namespace hpx { namespace parallel { inline namespace v1 { namespace views
+{
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // invokes the function for the elements satisfying the predicate
+        template <typename F, typename Pred, typename Proj>
+        struct filtered_function
+        {
+            F f_;
+            Pred pred_;
+            Proj proj_;
+
+            template <typename T>
+            HPX_FORCEINLINE void operator()(T && t)
+            {
+                if (hpx::util::invoke(pred_, t))
+                    hpx::util::invoke(f_, hpx::util::invoke(proj_,
+                        std::forward<T>(t)));
+            }
+        };
+
+        // The algorithms return the iterators of the adapted range for
+        // filter views, convert those into the iterators of the view.
+        template <typename T, typename F>
+        typename std::enable_if<
+           !hpx::traits::is_future<T>::value,
+            typename hpx::util::invoke_result<F, T>::type
+        >::type
+        convert_filter_result(T && t, F && f)
+        {
+            return hpx::util::invoke(f, std::forward<T>(t));
+        }
+
+        template <typename T, typename F>
+        hpx::future<typename hpx::util::invoke_result<F, T>::type>
+        convert_filter_result(hpx::future<T> && t, F && f)
+        {
+            typedef typename hpx::util::decay<F>::type func_type;
+            func_type conv(std::forward<F>(f));
+            return t.then(
+                [conv](hpx::future<T> && r)
+                {
+                    return hpx::util::invoke(conv, r.get());
+                });
+        }
+        /// \endcond
+    }
+}}}}
+
+#endif
@@ -209,6 +209,70 @@ namespace hpx { namespace parallel { namespace util { namespace detail
         }
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename V>
+    struct invoke_vectorized_in1
+    {
+        template <typename F, typename Iter>
+        static typename hpx::util::invoke_result<F, V*>::type
+        call_aligned(F && f, Iter& it)
+        {
+            typedef typename std::iterator_traits<Iter>::value_type value_type;
+
+            V tmp(traits::vector_pack_load<V, value_type>::aligned(it));
+            std::advance(it, traits::vector_pack_size<V>::value);
+
+            return hpx::util::invoke(std::forward<F>(f), &tmp);
+        }
+
+        template <typename F, typename Iter>
+        static typename hpx::util::invoke_result<F, V*>::type
+        call_unaligned(F && f, Iter& it)
+        {
+            typedef typename std::iterator_traits<Iter>::value_type value_type;
+
+            V tmp(traits::vector_pack_load<V, value_type>::unaligned(it));
+            std::advance(it, traits::vector_pack_size<V>::value);
+
+            return hpx::util::invoke(std::forward<F>(f), &tmp);
+        }
+    };
+
+    // Same as datapar_loop_step, except that the elements are read only and
+    // the iterator is not required to be aligned.
+    template <typename Iter>
+    struct datapar_loop_step_in1
+    {
+        typedef typename std::iterator_traits<Iter>::value_type value_type;
+
+        typedef typename traits::vector_pack_type<value_type, 1>::type V1;
+        typedef typename traits::vector_pack_type<value_type>::type V;
+
+        template <typename F>
+        HPX_HOST_DEVICE HPX_FORCEINLINE
+        static typename hpx::util::invoke_result<F, V1*>::type
+        call1(F && f, Iter& it)
+        {
+            return invoke_vectorized_in1<V1>::call_unaligned(
+                std::forward<F>(f), it);
+        }
+
+        template <typename F>
+        HPX_HOST_DEVICE HPX_FORCEINLINE
+        static typename hpx::util::invoke_result<F, V*>::type
+        callv(F && f, Iter& it)
+        {
+            if (is_data_aligned(it))
+            {
+                return invoke_vectorized_in1<V>::call_unaligned(
+                    std::forward<F>(f), it);
+            }
+
+            return invoke_vectorized_in1<V>::call_aligned(
+                std::forward<F>(f), it);
+        }
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename V1, typename V2>
     struct invoke_vectorized_in2
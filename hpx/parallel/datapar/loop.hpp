@@ -13,11 +13,16 @@
 #include <hpx/parallel/datapar/execution_policy_fwd.hpp>
 #include <hpx/parallel/datapar/iterator_helpers.hpp>
 #include <hpx/parallel/traits/vector_pack_alignment_size.hpp>
+#include <hpx/parallel/traits/vector_pack_find_first_set.hpp>
 #include <hpx/parallel/traits/vector_pack_load_store.hpp>
 #include <hpx/parallel/traits/vector_pack_type.hpp>
 #include <hpx/parallel/util/loop.hpp>
+#include <hpx/traits/is_callable.hpp>
 #include <hpx/traits/is_execution_policy.hpp>
+#include <hpx/traits/is_iterator.hpp>
 #include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/result_of.hpp>
 
 #include <algorithm>
 #include <cstddef>
@@ -297,6 +302,270 @@ namespace hpx { namespace parallel { namespace util
                 return first;
             }
         };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Callables which can't be invoked with vector-packs are executed on
+        // the individual elements instead.
+        template <typename F, typename Iter, typename Enable = void>
+        struct is_datapar_invocable
+          : std::false_type
+        {};
+
+        template <typename F, typename Iter>
+        struct is_datapar_invocable<F, Iter,
+            typename std::enable_if<
+                iterator_datapar_compatible<Iter>::value
+            >::type>
+          : hpx::traits::is_invocable<F,
+                typename traits::vector_pack_type<
+                    typename std::iterator_traits<Iter>::value_type
+                >::type*>
+        {};
+
+        template <typename F, typename Iter1, typename Iter2,
+            typename Enable = void>
+        struct is_datapar_invocable2
+          : std::false_type
+        {};
+
+        template <typename F, typename Iter1, typename Iter2>
+        struct is_datapar_invocable2<F, Iter1, Iter2,
+            typename std::enable_if<
+                iterator_datapar_compatible<Iter1>::value &&
+                iterator_datapar_compatible<Iter2>::value &&
+                iterators_datapar_compatible<Iter1, Iter2>::value
+            >::type>
+          : hpx::traits::is_invocable<F,
+                typename traits::vector_pack_type<
+                    typename std::iterator_traits<Iter1>::value_type
+                >::type*,
+                typename traits::vector_pack_type<
+                    typename std::iterator_traits<Iter2>::value_type
+                >::type*>
+        {};
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Iter, typename F, typename Enable = void>
+        struct datapar_find_first
+        {
+            template <typename InIter, typename F_>
+            HPX_HOST_DEVICE HPX_FORCEINLINE
+            static InIter call(InIter first, InIter last, F_ && f)
+            {
+                for (/**/; first != last; ++first)
+                {
+                    if (f(first))
+                        break;
+                }
+                return first;
+            }
+        };
+
+        template <typename Iter, typename F>
+        struct datapar_find_first<Iter, F,
+            typename std::enable_if<
+                is_datapar_invocable<F, Iter>::value
+            >::type>
+        {
+            typedef typename std::iterator_traits<Iter>::value_type value_type;
+            typedef typename traits::vector_pack_type<value_type>::type V;
+
+            template <typename InIter, typename F_>
+            HPX_HOST_DEVICE HPX_FORCEINLINE
+            static InIter call(InIter first, InIter last, F_ && f)
+            {
+                static std::size_t HPX_CONSTEXPR_OR_CONST size =
+                    traits::vector_pack_size<V>::value;
+
+                // test a whole vector-pack at once, the iterator has
+                // already been advanced past the pack if a match is found
+                for (std::size_t len = std::distance(first, last); len >= size;
+                     len -= size)
+                {
+                    int idx = traits::find_first_set(
+                        datapar_loop_step_in1<InIter>::callv(f, first));
+                    if (idx != -1)
+                        return first - (size - idx);
+                }
+
+                for (/**/; first != last; ++first)
+                {
+                    if (f(first))
+                        break;
+                }
+                return first;
+            }
+        };
+
+        template <typename Iter1, typename Iter2, typename F,
+            typename Enable = void>
+        struct datapar_find_first2
+        {
+            template <typename InIter1, typename InIter2, typename F_>
+            HPX_HOST_DEVICE HPX_FORCEINLINE
+            static std::pair<InIter1, InIter2>
+            call(InIter1 first1, InIter1 last1, InIter2 first2, F_ && f)
+            {
+                for (/**/; first1 != last1; (void) ++first1, ++first2)
+                {
+                    if (f(first1, first2))
+                        break;
+                }
+                return std::make_pair(std::move(first1), std::move(first2));
+            }
+        };
+
+        template <typename Iter1, typename Iter2, typename F>
+        struct datapar_find_first2<Iter1, Iter2, F,
+            typename std::enable_if<
+                is_datapar_invocable2<F, Iter1, Iter2>::value
+            >::type>
+        {
+            typedef typename std::iterator_traits<Iter1>::value_type
+                value_type;
+            typedef typename traits::vector_pack_type<value_type>::type V;
+
+            template <typename InIter1, typename InIter2, typename F_>
+            HPX_HOST_DEVICE HPX_FORCEINLINE
+            static std::pair<InIter1, InIter2>
+            call(InIter1 first1, InIter1 last1, InIter2 first2, F_ && f)
+            {
+                static std::size_t HPX_CONSTEXPR_OR_CONST size =
+                    traits::vector_pack_size<V>::value;
+
+                for (std::size_t len = std::distance(first1, last1);
+                     len >= size; len -= size)
+                {
+                    int idx = traits::find_first_set(
+                        datapar_loop_step2<InIter1, InIter2>::callv(
+                            f, first1, first2));
+                    if (idx != -1)
+                    {
+                        return std::make_pair(first1 - (size - idx),
+                            first2 - (size - idx));
+                    }
+                }
+
+                for (/**/; first1 != last1; (void) ++first1, ++first2)
+                {
+                    if (f(first1, first2))
+                        break;
+                }
+                return std::make_pair(std::move(first1), std::move(first2));
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The result is returned by value as it may refer to a temporary
+        // vector-pack.
+        template <typename Conv>
+        struct datapar_transform_indirect
+        {
+            Conv& conv_;
+
+            template <typename Iter>
+            HPX_HOST_DEVICE HPX_FORCEINLINE
+            auto operator()(Iter it)
+            ->  typename hpx::util::decay<
+                    decltype(hpx::util::invoke(conv_, *it))
+                >::type
+            {
+                return hpx::util::invoke(conv_, *it);
+            }
+        };
+
+        template <typename Reduce, typename Conv, typename Iter,
+            typename Enable = void>
+        struct is_datapar_reduction
+          : std::false_type
+        {};
+
+        template <typename Reduce, typename Conv, typename Iter>
+        struct is_datapar_reduction<Reduce, Conv, Iter,
+            typename std::enable_if<
+                is_datapar_invocable<
+                    datapar_transform_indirect<Conv>, Iter
+                >::value
+            >::type>
+          : hpx::traits::is_invocable<Reduce,
+                typename hpx::util::invoke_result<
+                    datapar_transform_indirect<Conv>,
+                    typename traits::vector_pack_type<
+                        typename std::iterator_traits<Iter>::value_type
+                    >::type*
+                >::type,
+                typename hpx::util::invoke_result<
+                    datapar_transform_indirect<Conv>,
+                    typename traits::vector_pack_type<
+                        typename std::iterator_traits<Iter>::value_type
+                    >::type*
+                >::type>
+        {};
+
+        template <typename Iter, typename Reduce, typename Conv,
+            typename Enable = void>
+        struct datapar_transform_accumulate_n
+        {
+            template <typename InIter, typename T, typename Reduce_,
+                typename Conv_>
+            HPX_HOST_DEVICE HPX_FORCEINLINE
+            static T call(InIter it, std::size_t count, T init, Reduce_ && r,
+                Conv_ && conv)
+            {
+                for (/**/; count != 0; (void) --count, ++it)
+                {
+                    init = hpx::util::invoke(r, init,
+                        hpx::util::invoke(conv, *it));
+                }
+                return init;
+            }
+        };
+
+        template <typename Iter, typename Reduce, typename Conv>
+        struct datapar_transform_accumulate_n<Iter, Reduce, Conv,
+            typename std::enable_if<
+                is_datapar_reduction<Reduce, Conv, Iter>::value
+            >::type>
+        {
+            typedef typename std::iterator_traits<Iter>::value_type value_type;
+            typedef typename traits::vector_pack_type<value_type>::type V;
+
+            template <typename InIter, typename T, typename Reduce_,
+                typename Conv_>
+            HPX_HOST_DEVICE HPX_FORCEINLINE
+            static T call(InIter it, std::size_t count, T init, Reduce_ && r,
+                Conv_ && conv)
+            {
+                static std::size_t HPX_CONSTEXPR_OR_CONST size =
+                    traits::vector_pack_size<V>::value;
+
+                if (count >= size)
+                {
+                    datapar_transform_indirect<Conv> f{conv};
+
+                    // one partial sum for each of the vector lanes
+                    auto part_sum = datapar_loop_step_in1<InIter>::callv(f, it);
+                    for (count -= size; count >= size; count -= size)
+                    {
+                        part_sum = hpx::util::invoke(r, part_sum,
+                            datapar_loop_step_in1<InIter>::callv(f, it));
+                    }
+
+                    // horizontal reduction of the partial sums
+                    for (std::size_t i = 0; i != part_sum.size(); ++i)
+                    {
+                        init = hpx::util::invoke(r, init, T(part_sum[i]));
+                    }
+                }
+
+                for (/**/; count != 0; (void) --count, ++it)
+                {
+                    init = hpx::util::invoke(r, init,
+                        hpx::util::invoke(conv, *it));
+                }
+                return init;
+            }
+        };
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -382,6 +651,86 @@ namespace hpx { namespace parallel { namespace util
     {
         return detail::datapar_loop_n<Iter>::call(it, count, std::forward<F>(f));
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename ExPolicy, typename Iter, typename F>
+    HPX_HOST_DEVICE HPX_FORCEINLINE
+    typename std::enable_if<
+        execution::is_vectorpack_execution_policy<ExPolicy>::value, Iter
+    >::type
+    find_first(Iter first, Iter last, F && f)
+    {
+        typedef typename std::remove_reference<F>::type& func_type;
+        return detail::datapar_find_first<Iter, func_type>::call(
+            first, last, f);
+    }
+
+    template <typename ExPolicy, typename Iter1, typename Iter2, typename F>
+    HPX_HOST_DEVICE HPX_FORCEINLINE
+    typename std::enable_if<
+        execution::is_vectorpack_execution_policy<ExPolicy>::value,
+        std::pair<Iter1, Iter2>
+    >::type
+    find_first2(Iter1 first1, Iter1 last1, Iter2 first2, F && f)
+    {
+        typedef typename std::remove_reference<F>::type& func_type;
+        return detail::datapar_find_first2<Iter1, Iter2, func_type>::call(
+            first1, last1, first2, f);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename ExPolicy, typename Iter, typename T, typename Reduce,
+        typename Conv>
+    HPX_HOST_DEVICE HPX_FORCEINLINE
+    typename std::enable_if<
+        execution::is_vectorpack_execution_policy<ExPolicy>::value, T
+    >::type
+    transform_accumulate_n(Iter it, std::size_t count, T init, Reduce && r,
+        Conv && conv)
+    {
+        typedef typename std::remove_reference<Reduce>::type& reduce_type;
+        typedef typename std::remove_reference<Conv>::type conv_type;
+
+        return detail::datapar_transform_accumulate_n<
+                Iter, reduce_type, conv_type
+            >::call(it, count, std::move(init), r, conv);
+    }
+
+    template <typename ExPolicy, typename Begin, typename End, typename T,
+        typename Reduce, typename Conv>
+    HPX_HOST_DEVICE HPX_FORCEINLINE
+    typename std::enable_if<
+        execution::is_vectorpack_execution_policy<ExPolicy>::value &&
+            std::is_same<Begin, End>::value &&
+            hpx::traits::is_random_access_iterator<Begin>::value,
+        T
+    >::type
+    transform_accumulate(Begin first, End last, T init, Reduce && r,
+        Conv && conv)
+    {
+        return util::transform_accumulate_n<ExPolicy>(first,
+            std::distance(first, last), std::move(init),
+            std::forward<Reduce>(r), std::forward<Conv>(conv));
+    }
+
+    template <typename ExPolicy, typename Begin, typename End, typename T,
+        typename Reduce, typename Conv>
+    HPX_HOST_DEVICE HPX_FORCEINLINE
+    typename std::enable_if<
+        execution::is_vectorpack_execution_policy<ExPolicy>::value &&
+            !(std::is_same<Begin, End>::value &&
+                hpx::traits::is_random_access_iterator<Begin>::value),
+        T
+    >::type
+    transform_accumulate(Begin first, End last, T init, Reduce && r,
+        Conv && conv)
+    {
+        for (/**/; first != last; ++first)
+        {
+            init = hpx::util::invoke(r, init, hpx::util::invoke(conv, *first));
+        }
+        return init;
+    }
 }}}
 
 #endif
@@ -9,6 +9,7 @@
 #include <hpx/config.hpp>
 
 #include <hpx/parallel/executors/default_executor.hpp>
+#include <hpx/parallel/executors/distributed_stealing_executor.hpp>
 #include <hpx/parallel/executors/distribution_policy_executor.hpp>
 #include <hpx/parallel/executors/parallel_executor.hpp>
 #include <hpx/parallel/executors/pool_executor.hpp>
@@ -0,0 +1,95 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/executors/adaptive_chunk_size.hpp
+
+#if !defined(HPX_PARALLEL_ADAPTIVE_CHUNK_SIZE_HPP)
+#define HPX_PARALLEL_ADAPTIVE_CHUNK_SIZE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/traits/is_executor_parameters.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+namespace hpx { namespace parallel { namespace execution
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// Loop iterations are not divided into chunks up front. Instead, one
+    /// task is created for each core, and the iterations still to be executed
+    /// by a running task are split in half and handed to a new task whenever
+    /// a core runs out of work (lazy binary splitting). Balanced loops end up
+    /// with roughly one task per core while imbalanced loops are still
+    /// balanced dynamically. The optional chunk size parameter defines the
+    /// number of loop iterations which are executed between two checks for
+    /// idle cores and thus is the minimal size of a range to split off. If
+    /// the size is not specified, it is derived from the number of
+    /// iterations and cores.
+    ///
+    /// \note This executor parameters type is equivalent to TBB's
+    ///       auto_partitioner.
+    ///
+    struct adaptive_chunk_size
+    {
+        /// Construct an \a adaptive_chunk_size executor parameters object
+        ///
+        /// \param min_chunk_size [in] The optional minimal chunk size to use
+        ///                     as the minimal number of loop iterations to
+        ///                     schedule together. The default is to use
+        ///                     1/64th of the iterations available for each
+        ///                     core.
+        ///
+        HPX_CONSTEXPR explicit
+        adaptive_chunk_size(std::size_t min_chunk_size = 0)
+          : min_chunk_size_(min_chunk_size)
+        {}
+
+        /// \cond NOINTERNAL
+        // This executor parameters type requests the iterations to be split
+        // on demand while they are being executed.
+        typedef std::true_type has_lazy_splitting;
+
+        template <typename Executor, typename F>
+        HPX_CONSTEXPR std::size_t
+        get_chunk_size(Executor && exec, F &&, std::size_t cores,
+            std::size_t num_tasks) const
+        {
+            return min_chunk_size_ != 0 ? min_chunk_size_ :
+                (std::max)(std::size_t(1),
+                    (num_tasks + 64 * cores - 1) / (64 * cores));
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        void serialize(Archive & ar, const unsigned int version)
+        {
+            ar & min_chunk_size_;
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        std::size_t min_chunk_size_;
+        /// \endcond
+    };
+}}}
+
+namespace hpx { namespace parallel { namespace execution
+{
+    /// \cond NOINTERNAL
+    template <>
+    struct is_executor_parameters<parallel::execution::adaptive_chunk_size>
+      : std::true_type
+    {};
+    /// \endcond
+}}}
+
+#endif
@@ -0,0 +1,233 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/executors/bulk_join_execute.hpp
+
+#if !defined(HPX_PARALLEL_EXECUTORS_BULK_JOIN_EXECUTE_HPP)
+#define HPX_PARALLEL_EXECUTORS_BULK_JOIN_EXECUTE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/exception_list.hpp>
+#include <hpx/lcos/detail/future_data.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/traits/future_access.hpp>
+#include <hpx/traits/is_range.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/range.hpp>
+#include <hpx/util/unused.hpp>
+
+#include <boost/intrusive_ptr.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <list>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace parallel { namespace execution { namespace detail
+{
+    /// \cond NOINTERNAL
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The shared state of the future returned from bulk_join_execute. It
+    // holds the function to invoke for every element of the shape and counts
+    // down the number of outstanding elements, the future becomes ready once
+    // the last element has been processed.
+    template <typename F>
+    struct bulk_join_state : lcos::detail::future_data<void>
+    {
+    private:
+        typedef lcos::detail::future_data<void> base_type;
+        typedef lcos::local::spinlock mutex_type;
+
+    public:
+        typedef typename base_type::init_no_addref init_no_addref;
+
+        template <typename F_>
+        bulk_join_state(std::size_t count, F_ && f)
+          : base_type(init_no_addref{})
+          , f_(std::forward<F_>(f))
+          , count_(count)
+        {}
+
+        template <typename T>
+        void execute(std::size_t i, T && t)
+        {
+            typedef std::integral_constant<bool,
+                    noexcept(f_(i, std::forward<T>(t)))
+                > is_nothrow;
+
+            execute(is_nothrow(), i, std::forward<T>(t));
+        }
+
+        void add_exception(std::exception_ptr e)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            errors_.push_back(std::move(e));
+        }
+
+        void count_down(std::size_t n)
+        {
+            if (count_.fetch_sub(n, std::memory_order_acq_rel) != n)
+                return;
+
+            // all elements have been processed, no other thread accesses
+            // the list of errors anymore
+            if (errors_.empty())
+            {
+                this->set_value(hpx::util::unused);
+            }
+            else
+            {
+                this->set_exception(std::make_exception_ptr(
+                    exception_list(std::move(errors_))));
+            }
+        }
+
+    private:
+        template <typename T>
+        void execute(std::false_type, std::size_t i, T && t)
+        {
+            try {
+                f_(i, std::forward<T>(t));
+            }
+            catch (...) {
+                add_exception(std::current_exception());
+            }
+            count_down(1);
+        }
+
+        // functions which can't throw don't need any exception handling
+        template <typename T>
+        void execute(std::true_type, std::size_t i, T && t)
+        {
+            f_(i, std::forward<T>(t));
+            count_down(1);
+        }
+
+        typename std::decay<F>::type f_;
+        std::atomic<std::size_t> count_;
+        mutex_type mtx_;
+        std::list<std::exception_ptr> errors_;
+    };
+
+    template <typename F, typename T>
+    struct bulk_join_task
+    {
+        boost::intrusive_ptr<bulk_join_state<F> > state_;
+        std::size_t i_;
+        T t_;
+
+        void operator()()
+        {
+            state_->execute(i_, std::move(t_));
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename F, typename Iter>
+    struct bulk_join_store_result
+    {
+        typename std::decay<F>::type f_;
+        Iter dest_;
+
+        template <typename T>
+        void operator()(std::size_t i, T && t)
+        {
+            dest_[i] = hpx::util::invoke(f_, std::forward<T>(t));
+        }
+    };
+
+    template <typename F>
+    struct bulk_join_discard_result
+    {
+        typename std::decay<F>::type f_;
+
+        template <typename T>
+        void operator()(std::size_t, T && t) noexcept(noexcept(HPX_INVOKE(
+            std::declval<typename std::decay<F>::type&>(),
+            std::declval<T>())))
+        {
+            hpx::util::invoke(f_, std::forward<T>(t));
+        }
+    };
+
+    template <typename Executor, typename F, typename Shape>
+    hpx::future<void> bulk_join_execute_impl(Executor && exec, F && f,
+        Shape const& shape)
+    {
+        typedef bulk_join_state<F> shared_state_type;
+        typedef typename hpx::traits::range_traits<Shape>::value_type
+            value_type;
+
+        std::size_t const size = hpx::util::size(shape);
+
+        // the calling thread holds one count until all elements have been
+        // scheduled
+        boost::intrusive_ptr<shared_state_type> state(
+            new shared_state_type(size + 1, std::forward<F>(f)), false);
+
+        hpx::future<void> result =
+            hpx::traits::future_access<hpx::future<void> >::create(state);
+
+        std::size_t i = 0;
+        try {
+            for (auto it = hpx::util::begin(shape); i != size; ++i, ++it)
+            {
+                execution::post(exec,
+                    bulk_join_task<F, value_type>{state, i, *it});
+            }
+        }
+        catch (...) {
+            // the elements which were not scheduled will not count down
+            state->add_exception(std::current_exception());
+            state->count_down(size - i);
+        }
+
+        state->count_down(1);
+        return result;
+    }
+    /// \endcond
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Invoke \a f for every element of \a shape on the given executor and
+    /// join all of the invocations in a single future. Unlike
+    /// \a bulk_async_execute, no future (and shared state) is created for
+    /// every element: all invocations count down one shared counter, which
+    /// is the shared state of the returned future. The results of the
+    /// invocations are discarded.
+    ///
+    /// \returns A future which becomes ready once all invocations have
+    ///          finished. If any of the invocations exited with an
+    ///          exception, the future holds an \a hpx::exception_list of all
+    ///          of these exceptions.
+    ///
+    template <typename Executor, typename F, typename Shape>
+    hpx::future<void> bulk_join_execute(Executor && exec, F && f,
+        Shape const& shape)
+    {
+        return bulk_join_execute_impl(std::forward<Executor>(exec),
+            bulk_join_discard_result<F>{std::forward<F>(f)}, shape);
+    }
+
+    /// Invoke \a f for every element of \a shape on the given executor, as
+    /// above, the result of the invocation for the i-th element of the
+    /// shape is assigned to \a dest[i]. The caller has to keep the range
+    /// referred to by \a dest alive until the returned future has become
+    /// ready.
+    template <typename Executor, typename F, typename Shape, typename Iter>
+    hpx::future<void> bulk_join_execute(Executor && exec, F && f,
+        Shape const& shape, Iter dest)
+    {
+        return bulk_join_execute_impl(std::forward<Executor>(exec),
+            bulk_join_store_result<F, Iter>{std::forward<F>(f), dest}, shape);
+    }
+}}}}
+
+#endif
@@ -0,0 +1,260 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/executors/distributed_stealing_executor.hpp
+
+#if !defined(HPX_PARALLEL_EXECUTORS_DISTRIBUTED_STEALING_EXECUTOR_HPP)
+#define HPX_PARALLEL_EXECUTORS_DISTRIBUTED_STEALING_EXECUTOR_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/async.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/packaged_task.hpp>
+#include <hpx/parallel/executors/execution_fwd.hpp>
+#include <hpx/runtime/actions/plain_action.hpp>
+#include <hpx/runtime/find_here.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/traits/is_action.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke_fused.hpp>
+#include <hpx/util/tuple.hpp>
+#include <hpx/util/unique_function.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace parallel { namespace execution
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // A task which was not started yet. The task is invoked with the
+        // locality it should run on, it returns a future which becomes ready
+        // once it has finished running.
+        typedef util::unique_function_nonser<
+                hpx::future<void>(naming::id_type const&)
+            > stealable_task;
+
+        // Queue a task on this locality, it will be run here or on another
+        // locality which is running out of work.
+        HPX_EXPORT void enqueue_stealable_task(stealable_task && task);
+
+        // Account for tasks which were stolen from another locality while
+        // they are running on this one.
+        HPX_EXPORT void stolen_task_started();
+        HPX_EXPORT void stolen_task_finished();
+
+        ///////////////////////////////////////////////////////////////////////
+        struct stolen_task_scope
+        {
+            stolen_task_scope()
+            {
+                stolen_task_started();
+            }
+            ~stolen_task_scope()
+            {
+                stolen_task_finished();
+            }
+        };
+
+        // Run a task on the locality which has stolen it.
+        template <typename Action, typename ... Ts>
+        typename Action::local_result_type run_stolen_task(Ts ... ts)
+        {
+            stolen_task_scope scope;
+            return hpx::async<Action>(hpx::find_here(), std::move(ts)...)
+                .get();
+        }
+
+        template <typename Action, typename ... Ts>
+        struct run_stolen_task_action
+          : ::hpx::actions::action<
+                typename Action::local_result_type (*)(Ts...)
+              , &run_stolen_task<Action, Ts...>
+              , run_stolen_task_action<Action, Ts...> >
+        {};
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Result>
+        Result get_stolen_task_result(hpx::future<Result> && f)
+        {
+            return f.get();
+        }
+
+        template <typename Result>
+        struct set_stolen_task_result
+        {
+            void operator()(hpx::future<Result> && f)
+            {
+                task_(std::move(f));
+            }
+
+            lcos::local::packaged_task<Result(hpx::future<Result>)> task_;
+        };
+
+        template <typename Action, typename ... Ts>
+        struct launch_stealable_task
+        {
+            typedef typename Action::local_result_type result_type;
+
+            template <typename ... Ts_>
+            hpx::future<result_type> operator()(Ts_ &&... ts) const
+            {
+                if (where_ == hpx::find_here())
+                {
+                    return hpx::async<Action>(where_,
+                        std::forward<Ts_>(ts)...);
+                }
+
+                typedef run_stolen_task_action<Action, Ts...> action_type;
+                return hpx::async<action_type>(where_,
+                    std::forward<Ts_>(ts)...);
+            }
+
+            naming::id_type const& where_;
+        };
+
+        template <typename Action, typename ... Ts>
+        struct stealable_task_impl
+        {
+            typedef typename Action::local_result_type result_type;
+
+            hpx::future<void> operator()(naming::id_type const& where)
+            {
+                hpx::future<result_type> f = util::invoke_fused(
+                    launch_stealable_task<Action, Ts...>{where},
+                    std::move(args_));
+
+                return f.then(hpx::launch::sync,
+                    set_stolen_task_result<result_type>{std::move(result_)});
+            }
+
+            lcos::local::packaged_task<
+                    result_type(hpx::future<result_type>)
+                > result_;
+            util::tuple<Ts...> args_;
+        };
+        /// \endcond
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A \a distributed_stealing_executor queues the actions given to it on
+    /// the locality where it is used. Those are started locally as soon as a
+    /// worker thread is available. Localities running out of work steal
+    /// batches of the actions which were not started yet from the localities
+    /// which have queued more actions than they have worker threads.
+    ///
+    /// A locality with more queued actions than worker threads advertises
+    /// this to all other localities. Idle localities which have received
+    /// such an advertisement send steal requests, first to the advertising
+    /// locality, then to randomly selected localities, until a request
+    /// succeeds or every locality was asked once. Stolen actions are run
+    /// on the stealing locality, their results are sent back to the
+    /// locality which queued them.
+    ///
+    /// \note The executor accepts plain actions only. Their arguments have
+    ///       to be serializable and their results must not depend on the
+    ///       locality they run on.
+    ///
+    class distributed_stealing_executor
+    {
+    private:
+        /// \cond NOINTERNAL
+        template <typename Action, typename ... Ts>
+        hpx::future<typename Action::local_result_type>
+        enqueue(Ts &&... ts) const
+        {
+            typedef typename Action::local_result_type result_type;
+            typedef detail::stealable_task_impl<
+                    Action, typename hpx::util::decay<Ts>::type...
+                > task_type;
+
+            task_type task{
+                lcos::local::packaged_task<
+                    result_type(hpx::future<result_type>)
+                >(&detail::get_stolen_task_result<result_type>),
+                util::make_tuple(std::forward<Ts>(ts)...)};
+
+            hpx::future<result_type> f = task.result_.get_future();
+            detail::enqueue_stealable_task(std::move(task));
+            return f;
+        }
+        /// \endcond
+
+    public:
+        /// \cond NOINTERNAL
+        bool operator==(distributed_stealing_executor const& rhs) const
+            noexcept
+        {
+            return true;
+        }
+
+        bool operator!=(distributed_stealing_executor const& rhs) const
+            noexcept
+        {
+            return !(*this == rhs);
+        }
+
+        distributed_stealing_executor const& context() const noexcept
+        {
+            return *this;
+        }
+        /// \endcond
+
+        /// \cond NOINTERNAL
+        typedef parallel_execution_tag execution_category;
+
+        template <typename Action, typename ... Ts>
+        void post(Action &&, Ts &&... ts) const
+        {
+            static_assert(
+                hpx::traits::is_action<
+                    typename hpx::util::decay<Action>::type
+                >::value,
+                "distributed_stealing_executor can run plain actions only");
+
+            enqueue<typename hpx::util::decay<Action>::type>(
+                std::forward<Ts>(ts)...);
+        }
+
+        template <typename Action, typename ... Ts>
+        hpx::future<
+            typename hpx::util::decay<Action>::type::local_result_type
+        >
+        async_execute(Action &&, Ts &&... ts) const
+        {
+            static_assert(
+                hpx::traits::is_action<
+                    typename hpx::util::decay<Action>::type
+                >::value,
+                "distributed_stealing_executor can run plain actions only");
+
+            return enqueue<typename hpx::util::decay<Action>::type>(
+                std::forward<Ts>(ts)...);
+        }
+
+        template <typename Action, typename ... Ts>
+        typename hpx::util::decay<Action>::type::local_result_type
+        sync_execute(Action && act, Ts &&... ts) const
+        {
+            return async_execute(std::forward<Action>(act),
+                std::forward<Ts>(ts)...).get();
+        }
+        /// \endcond
+    };
+
+    /// \cond NOINTERNAL
+    template <>
+    struct is_two_way_executor<
+            parallel::execution::distributed_stealing_executor>
+      : std::true_type
+    {};
+    /// \endcond
+}}}
+
+#endif
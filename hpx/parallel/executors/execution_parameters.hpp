@@ -387,6 +387,60 @@ namespace hpx { namespace parallel { namespace execution
 
         HPX_HAS_MEMBER_XXX_TRAIT_DEF(mark_end_execution)
 
+        ///////////////////////////////////////////////////////////////////////
+        // customization point for interface get_prefetcher()
+        template <typename Parameters, typename Executor_>
+        struct get_prefetcher_fn_helper<Parameters, Executor_,
+            typename std::enable_if<
+                hpx::traits::is_executor_any<Executor_>::value ||
+                    hpx::traits::is_threads_executor<Executor_>::value
+            >::type>
+        {
+            template <typename AnyParameters, typename Executor>
+            HPX_FORCEINLINE static no_prefetcher call(
+                hpx::traits::detail::wrap_int, AnyParameters &&, Executor &&)
+            {
+                return no_prefetcher();
+            }
+
+            template <typename AnyParameters, typename Executor>
+            HPX_FORCEINLINE static auto call(int, AnyParameters && params,
+                    Executor && exec)
+            ->  decltype(params.get_prefetcher(std::forward<Executor>(exec)))
+            {
+                return params.get_prefetcher(std::forward<Executor>(exec));
+            }
+
+            template <typename Executor>
+            HPX_FORCEINLINE static auto call(Parameters& params,
+                    Executor && exec)
+            ->  decltype(call(0, params, std::forward<Executor>(exec)))
+            {
+                return call(0, params, std::forward<Executor>(exec));
+            }
+
+            template <typename AnyParameters, typename Executor>
+            HPX_FORCEINLINE static auto call(AnyParameters params,
+                    Executor && exec)
+            ->  decltype(call(std::declval<Parameters&>(),
+                    std::forward<Executor>(exec)))
+            {
+                return call(static_cast<Parameters&>(params),
+                    std::forward<Executor>(exec));
+            }
+
+            template <typename AnyParameters, typename Executor>
+            struct result
+            {
+                using type = decltype(call(
+                    std::declval<AnyParameters>(),
+                    std::declval<Executor>()
+                ));
+            };
+        };
+
+        HPX_HAS_MEMBER_XXX_TRAIT_DEF(get_prefetcher)
+
         /// \endcond
     }
 
@@ -555,6 +609,29 @@ namespace hpx { namespace parallel { namespace execution
             }
         };
 
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T, typename Wrapper, typename Enable = void>
+        struct get_prefetcher_call_helper
+        {
+        };
+
+        template <typename T, typename Wrapper>
+        struct get_prefetcher_call_helper<T, Wrapper,
+            typename std::enable_if<
+                has_get_prefetcher<T>::value
+            >::type>
+        {
+            template <typename Executor>
+            HPX_FORCEINLINE auto get_prefetcher(Executor && exec)
+            ->  decltype(std::declval<T&>().get_prefetcher(
+                    std::forward<Executor>(exec)))
+            {
+                auto& wrapped =
+                    static_cast<unwrapper<Wrapper>*>(this)->member_.get();
+                return wrapped.get_prefetcher(std::forward<Executor>(exec));
+            }
+        };
+
         ///////////////////////////////////////////////////////////////////////
         template <typename T>
         struct base_member_helper
@@ -576,6 +653,7 @@ namespace hpx { namespace parallel { namespace execution
           , mark_end_execution_call_helper<T, boost::reference_wrapper<T> >
           , processing_units_count_call_helper<T, boost::reference_wrapper<T> >
           , reset_thread_distribution_call_helper<T, boost::reference_wrapper<T> >
+          , get_prefetcher_call_helper<T, boost::reference_wrapper<T> >
         {
             typedef boost::reference_wrapper<T> wrapper_type;
 
@@ -593,6 +671,7 @@ namespace hpx { namespace parallel { namespace execution
           , mark_end_execution_call_helper<T, std::reference_wrapper<T> >
           , processing_units_count_call_helper<T, std::reference_wrapper<T> >
           , reset_thread_distribution_call_helper<T, std::reference_wrapper<T> >
+          , get_prefetcher_call_helper<T, std::reference_wrapper<T> >
         {
             typedef std::reference_wrapper<T> wrapper_type;
 
@@ -634,6 +713,7 @@ namespace hpx { namespace parallel { namespace execution
             HPX_STATIC_ASSERT_ON_PARAMETERS_AMBIGUITY(count_processing_units);
             HPX_STATIC_ASSERT_ON_PARAMETERS_AMBIGUITY(maximal_number_of_chunks);
             HPX_STATIC_ASSERT_ON_PARAMETERS_AMBIGUITY(reset_thread_distribution);
+            HPX_STATIC_ASSERT_ON_PARAMETERS_AMBIGUITY(get_prefetcher);
 
             template <typename Dependent = void, typename Enable =
                 typename std::enable_if<
@@ -29,6 +29,7 @@ namespace hpx { namespace parallel { namespace execution
         struct count_processing_units_tag {};
         struct mark_begin_execution_tag {};
         struct mark_end_execution_tag {};
+        struct get_prefetcher_tag {};
         /// \endcond
     }
 
@@ -54,6 +55,9 @@ namespace hpx { namespace parallel { namespace execution
 
         template <typename Parameters, typename Executor, typename Enable = void>
         struct mark_end_execution_fn_helper;
+
+        template <typename Parameters, typename Executor, typename Enable = void>
+        struct get_prefetcher_fn_helper;
         /// \endcond
     }
 
@@ -265,6 +269,54 @@ namespace hpx { namespace parallel { namespace execution
             }
         };
 
+        ///////////////////////////////////////////////////////////////////////
+        // The prefetcher returned by get_prefetcher if the executor
+        // parameters don't request any prefetching
+        struct no_prefetcher
+        {
+            HPX_CONSTEXPR std::size_t distance() const
+            {
+                return 0;
+            }
+
+            template <typename Iter>
+            HPX_HOST_DEVICE HPX_FORCEINLINE void operator()(Iter const&) const
+            {
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // get_prefetcher dispatch point
+        template <typename Parameters, typename Executor>
+        HPX_FORCEINLINE auto get_prefetcher(Parameters&& params,
+                Executor&& exec)
+        ->  typename get_prefetcher_fn_helper<
+                typename hpx::util::decay_unwrap<Parameters>::type,
+                typename hpx::util::decay<Executor>::type
+            >::template result<Parameters, Executor>::type
+        {
+            return get_prefetcher_fn_helper<
+                    typename hpx::util::decay_unwrap<Parameters>::type,
+                    typename hpx::util::decay<Executor>::type
+                >::call(std::forward<Parameters>(params),
+                    std::forward<Executor>(exec));
+        }
+
+        template <>
+        struct customization_point<get_prefetcher_tag>
+        {
+        public:
+            template <typename Parameters, typename Executor>
+            HPX_FORCEINLINE auto operator()(Parameters&& params,
+                    Executor&& exec) const
+            -> decltype(get_prefetcher(std::forward<Parameters>(params),
+                    std::forward<Executor>(exec)))
+            {
+                return get_prefetcher(std::forward<Parameters>(params),
+                    std::forward<Executor>(exec));
+            }
+        };
+
         /// \endcond
     }
 
@@ -381,6 +433,24 @@ namespace hpx { namespace parallel { namespace execution
                 detail::static_const<detail::customization_point<
                     detail::mark_end_execution_tag
                 > >::value;
+
+        /// Retrieve the prefetcher to be used by the parallel algorithms
+        ///
+        /// \param params [in] The executor parameters object to use as a
+        ///              fallback if the executor does not expose
+        ///
+        /// \note This calls params.get_prefetcher(exec) if it exists;
+        ///       otherwise it returns a prefetcher which does not prefetch
+        ///       anything. A prefetcher exposes the number of iterations it
+        ///       runs ahead of the current one (distance()) and is invoked
+        ///       with the iterator (or loop variable) of that iteration.
+        ///
+        constexpr detail::customization_point<
+                detail::get_prefetcher_tag
+            > const& get_prefetcher =
+                detail::static_const<detail::customization_point<
+                    detail::get_prefetcher_tag
+                > >::value;
     }
 }}}
 
@@ -13,6 +13,7 @@
 #include <hpx/async_launch_policy_dispatch.hpp>
 #include <hpx/lcos/future.hpp>
 #include <hpx/lcos/local/latch.hpp>
+#include <hpx/lcos/local/packaged_task.hpp>
 #include <hpx/parallel/algorithms/detail/predicates.hpp>
 #include <hpx/parallel/executors/fused_bulk_execute.hpp>
 #include <hpx/parallel/executors/post_policy_dispatch.hpp>
@@ -21,15 +22,16 @@
 #include <hpx/runtime/launch_policy.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
 #include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/runtime/threads/thread_init_data.hpp>
 #include <hpx/traits/future_traits.hpp>
 #include <hpx/traits/is_executor.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/bind_back.hpp>
 #include <hpx/util/deferred_call.hpp>
-#include <hpx/util/internal_allocator.hpp>
 #include <hpx/util/invoke.hpp>
 #include <hpx/util/one_shot.hpp>
 #include <hpx/util/range.hpp>
+#include <hpx/util/tagged_allocator.hpp>
 #include <hpx/util/unwrap.hpp>
 
 #include <algorithm>
@@ -148,7 +150,7 @@ namespace hpx { namespace parallel { namespace execution
 
             typename hpx::traits::detail::shared_state_ptr<result_type>::type p =
                 lcos::detail::make_continuation_alloc_nounwrap<result_type>(
-                    hpx::util::internal_allocator<>{},
+                    hpx::util::future_state_allocator<>{},
                     std::forward<Future>(predecessor), policy_, std::move(func));
 
             return hpx::traits::future_access<hpx::future<result_type> >::create(
@@ -240,7 +242,7 @@ namespace hpx { namespace parallel { namespace execution
             // vector<future<func_result_type>> -> vector<func_result_type>
             shared_state_type p =
                 lcos::detail::make_continuation_alloc<vector_result_type>(
-                    hpx::util::internal_allocator<>{},
+                    hpx::util::future_state_allocator<>{},
                     std::forward<Future>(predecessor), policy_,
                     [HPX_CAPTURE_MOVE(func)](future_type&& predecessor) mutable
                     ->  vector_result_type
@@ -265,14 +267,56 @@ namespace hpx { namespace parallel { namespace execution
             // spawn tasks sequentially
             HPX_ASSERT(base + size <= results.size());
 
-            for (std::size_t i = 0; i != size; ++i, ++it)
+            if (size > 1 && policy_ == launch::async)
+            {
+                // register all tasks at once
+                spawn_batched(results, base, size, func, it, ts...);
+            }
+            else
             {
-                results[base + i] = async_execute(func, *it, ts...);
+                for (std::size_t i = 0; i != size; ++i, ++it)
+                {
+                    results[base + i] = async_execute(func, *it, ts...);
+                }
             }
 
             l.count_down(size);
         }
 
+        template <typename Result, typename F, typename Iter, typename ... Ts>
+        void spawn_batched(std::vector<hpx::future<Result> >& results,
+            std::size_t base, std::size_t size, F const& func, Iter it,
+            Ts const&... ts) const
+        {
+            typedef lcos::local::packaged_task<Result()> task_type;
+            typedef hpx::applier::detail::thread_function_nullary<task_type>
+                thread_function;
+
+            hpx::util::thread_description desc(func,
+                "hpx::parallel::execution::parallel_executor::"
+                "bulk_async_execute");
+            std::ptrdiff_t stacksize =
+                threads::get_stack_size(threads::thread_stacksize_default);
+
+            std::vector<threads::thread_init_data> data;
+            data.reserve(size);
+
+            for (std::size_t i = 0; i != size; ++i, ++it)
+            {
+                task_type task(
+                    hpx::util::deferred_call(func, *it, ts...));
+                results[base + i] = task.get_future();
+
+                data.emplace_back(
+                    threads::thread_function_type(
+                        thread_function{std::move(task)}),
+                    desc, 0, policy_.priority(), threads::thread_schedule_hint(),
+                    stacksize);
+            }
+
+            threads::register_threads(data);
+        }
+
         template <typename Result, typename F, typename Iter, typename ... Ts>
         void spawn_hierarchical(std::vector<hpx::future<Result> >& results,
             lcos::local::latch& l, std::size_t base, std::size_t size,
@@ -58,6 +58,40 @@ namespace hpx { namespace parallel { namespace execution { namespace detail
             }
         }
     };
+
+    template <>
+    struct post_policy_dispatch<launch::work_first_policy>
+    {
+        template <typename F, typename... Ts>
+        static void call(hpx::util::thread_description const& desc,
+            launch::work_first_policy const& policy, F && f, Ts &&... ts)
+        {
+            if (threads::get_self_ptr() == nullptr)
+            {
+                post_policy_dispatch<launch::async_policy>::call(desc,
+                    launch::async_policy(policy.priority()),
+                    std::forward<F>(f), std::forward<Ts>(ts)...);
+                return;
+            }
+
+            threads::thread_id_type tid = threads::register_thread_nullary(
+                hpx::util::deferred_call(
+                    std::forward<F>(f), std::forward<Ts>(ts)...),
+                desc, threads::pending_do_not_schedule, true, policy.priority(),
+                threads::thread_schedule_hint(
+                    static_cast<std::int16_t>(get_worker_thread_num())),
+                threads::thread_stacksize_current);
+
+            // run the new thread right away, make sure this thread is
+            // resumed next
+            if (tid)
+            {
+                // yield_to(tid)
+                hpx::this_thread::suspend(threads::pending_boost, tid,
+                    "hpx::parallel::execution::parallel_executor::post");
+            }
+        }
+    };
 }}}}
 
 #endif
@@ -0,0 +1,235 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/executors/prefetch_distance.hpp
+
+#if !defined(HPX_PARALLEL_PREFETCH_DISTANCE_HPP)
+#define HPX_PARALLEL_PREFETCH_DISTANCE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/traits/is_executor_parameters.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+
+#include <hpx/parallel/executors/execution_parameters_fwd.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if defined(HPX_HAVE_MM_PREFETCH)
+#if defined(HPX_MSVC)
+#include <intrin.h>
+#endif
+#if defined(HPX_GCC_VERSION)
+#include <emmintrin.h>
+#endif
+#endif
+
+namespace hpx { namespace parallel { namespace execution
+{
+    /// \cond NOINTERNAL
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        HPX_FORCEINLINE void prefetch_address(void const* p)
+        {
+#if defined(HPX_GCC_VERSION) || defined(HPX_CLANG_VERSION)
+            __builtin_prefetch(p);
+#elif defined(HPX_HAVE_MM_PREFETCH)
+            _mm_prefetch(static_cast<char const*>(p), _MM_HINT_T0);
+#else
+            (void)p;
+#endif
+        }
+
+        template <typename Iter, typename Enable = void>
+        struct is_prefetchable_iterator
+          : std::false_type
+        {};
+
+        template <typename Iter>
+        struct is_prefetchable_iterator<Iter,
+                typename std::enable_if<
+                    hpx::traits::is_iterator<Iter>::value
+                >::type>
+          : std::is_lvalue_reference<
+                typename std::iterator_traits<Iter>::reference>
+        {};
+
+        ///////////////////////////////////////////////////////////////////////
+        // prefetches the element referred to by the iterator
+        struct direct_prefetcher
+        {
+            std::size_t distance_;
+
+            std::size_t distance() const
+            {
+                return distance_;
+            }
+
+            template <typename Iter>
+            HPX_FORCEINLINE typename std::enable_if<
+                is_prefetchable_iterator<Iter>::value
+            >::type
+            operator()(Iter const& it) const
+            {
+                prefetch_address(std::addressof(*it));
+            }
+
+            template <typename Iter>
+            HPX_FORCEINLINE typename std::enable_if<
+               !is_prefetchable_iterator<Iter>::value
+            >::type
+            operator()(Iter const&) const
+            {
+            }
+        };
+
+        // prefetches the address returned by the given function
+        template <typename F>
+        struct indirect_prefetcher
+        {
+            std::size_t distance_;
+            F f_;
+
+            std::size_t distance() const
+            {
+                return distance_;
+            }
+
+            template <typename Iter>
+            HPX_FORCEINLINE void operator()(Iter const& it) const
+            {
+                prefetch_address(hpx::util::invoke(f_, it));
+            }
+        };
+    }
+    /// \endcond
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Loop iterations prefetch the data accessed by the iteration which is
+    /// \a distance iterations ahead of the current one into the caches. This
+    /// is supported by for_each, for_each_n, for_loop, transform, reduce and
+    /// transform_reduce, which prefetch the elements referenced by their
+    /// input iterators.
+    ///
+    /// \note This executor parameters type can be combined with any of the
+    ///       chunk size executor parameters types.
+    ///
+    struct prefetch_distance
+    {
+        /// Construct a \a prefetch_distance executor parameters object
+        ///
+        /// \param distance     [in] The number of iterations to prefetch
+        ///                     ahead of the current one. Passing zero
+        ///                     disables prefetching.
+        ///
+        HPX_CONSTEXPR explicit prefetch_distance(std::size_t distance = 0)
+          : distance_(distance)
+        {}
+
+        /// \cond NOINTERNAL
+        template <typename Executor>
+        detail::direct_prefetcher get_prefetcher(Executor &&) const
+        {
+            return detail::direct_prefetcher{distance_};
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        void serialize(Archive & ar, const unsigned int version)
+        {
+            ar & distance_;
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        std::size_t distance_;
+        /// \endcond
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Loop iterations prefetch the address returned by the given function
+    /// for the iteration which is \a distance iterations ahead of the current
+    /// one. The function is invoked with the iterator of that iteration (or
+    /// the loop variable for for_loop) and has to return a pointer, which
+    /// allows to prefetch gather and scatter accesses, e.g. the elements
+    /// referenced through the column indices of a sparse matrix.
+    ///
+    /// \note Use \a make_prefetch_indirect to create objects of this type.
+    ///
+    template <typename F>
+    struct prefetch_indirect
+    {
+        /// Construct a \a prefetch_indirect executor parameters object
+        ///
+        /// \param distance     [in] The number of iterations to prefetch
+        ///                     ahead of the current one. Passing zero
+        ///                     disables prefetching.
+        /// \param f            [in] The function returning the address to
+        ///                     prefetch for a given iteration.
+        ///
+        template <typename F_>
+        prefetch_indirect(std::size_t distance, F_ && f)
+          : distance_(distance), f_(std::forward<F_>(f))
+        {}
+
+        /// \cond NOINTERNAL
+        template <typename Executor>
+        detail::indirect_prefetcher<F> get_prefetcher(Executor &&) const
+        {
+            return detail::indirect_prefetcher<F>{distance_, f_};
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        std::size_t distance_;
+        F f_;
+        /// \endcond
+    };
+
+    /// Create a \a prefetch_indirect executor parameters object
+    ///
+    /// \param distance     [in] The number of iterations to prefetch ahead of
+    ///                     the current one.
+    /// \param f            [in] The function returning the address to
+    ///                     prefetch for a given iteration.
+    ///
+    template <typename F>
+    prefetch_indirect<typename hpx::util::decay<F>::type>
+    make_prefetch_indirect(std::size_t distance, F && f)
+    {
+        return prefetch_indirect<typename hpx::util::decay<F>::type>(
+            distance, std::forward<F>(f));
+    }
+}}}
+
+namespace hpx { namespace parallel { namespace execution
+{
+    /// \cond NOINTERNAL
+    template <>
+    struct is_executor_parameters<parallel::execution::prefetch_distance>
+      : std::true_type
+    {};
+
+    template <typename F>
+    struct is_executor_parameters<parallel::execution::prefetch_indirect<F> >
+      : std::true_type
+    {};
+    /// \endcond
+}}}
+
+#endif
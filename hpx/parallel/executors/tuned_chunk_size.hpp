@@ -0,0 +1,264 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/executors/tuned_chunk_size.hpp
+
+#if !defined(HPX_PARALLEL_TUNED_CHUNK_SIZE_HPP)
+#define HPX_PARALLEL_TUNED_CHUNK_SIZE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/traits/is_executor_parameters.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace hpx { namespace parallel { namespace execution
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// Loop iterations are divided into pieces of a size which is tuned
+    /// across repeated invocations of the same loop. Each invocation is
+    /// timed, and the chunk size is doubled or halved as long as this
+    /// reduces the execution time per iteration (hill climbing). Once no
+    /// further improvement is found, the best chunk size is used until the
+    /// measured execution time gets worse by more than the given threshold,
+    /// in which case the tuning is restarted. The tuning is restarted as
+    /// well whenever the number of iterations or cores changes.
+    ///
+    /// \note Copies of a \a tuned_chunk_size object share their history,
+    ///       which allows to create one object per loop (call site) and to
+    ///       pass it to every invocation of that loop. Loops running
+    ///       concurrently should use separate objects.
+    ///
+    struct tuned_chunk_size
+    {
+        /// Construct a \a tuned_chunk_size executor parameters object
+        ///
+        /// \note Default constructed \a tuned_chunk_size executor parameter
+        ///       types take the best of 3 invocations to measure each chunk
+        ///       size and restart the tuning if the execution time gets worse
+        ///       by more than 20%.
+        ///
+        tuned_chunk_size()
+          : state_(std::make_shared<state>(3, 0.2))
+        {}
+
+        /// Construct a \a tuned_chunk_size executor parameters object
+        ///
+        /// \param samples      [in] The number of invocations to measure for
+        ///                     each chunk size, the best of those is used.
+        /// \param retune_threshold [in] The relative increase of the
+        ///                     execution time which restarts the tuning.
+        ///
+        explicit tuned_chunk_size(std::size_t samples,
+                double retune_threshold = 0.2)
+          : state_(std::make_shared<state>(
+                (std::max)(samples, std::size_t(1)), retune_threshold))
+        {}
+
+        /// Return the chunk size which is currently considered best
+        std::size_t best_chunk_size() const
+        {
+            std::lock_guard<hpx::lcos::local::spinlock> l(state_->mtx_);
+            return state_->best_chunk_size_;
+        }
+
+        /// \cond NOINTERNAL
+        template <typename Executor, typename F>
+        std::size_t get_chunk_size(Executor& exec, F &&, std::size_t cores,
+            std::size_t count)
+        {
+            std::lock_guard<hpx::lcos::local::spinlock> l(state_->mtx_);
+            return state_->get_chunk_size(cores, count);
+        }
+
+        template <typename Executor>
+        void mark_begin_execution(Executor &&)
+        {
+            std::lock_guard<hpx::lcos::local::spinlock> l(state_->mtx_);
+            state_->start_ = hpx::util::high_resolution_clock::now();
+        }
+
+        template <typename Executor>
+        void mark_end_execution(Executor &&)
+        {
+            std::uint64_t now = hpx::util::high_resolution_clock::now();
+
+            std::lock_guard<hpx::lcos::local::spinlock> l(state_->mtx_);
+            state_->add_sample(now - state_->start_);
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        void serialize(Archive & ar, const unsigned int version)
+        {
+            ar & *state_;
+        }
+
+        struct state
+        {
+            state(std::size_t samples, double retune_threshold)
+              : samples_(samples), retune_threshold_(retune_threshold)
+              , cores_(0), count_(0), chunk_size_(0), best_chunk_size_(0)
+              , best_time_(0), sample_time_(0), num_samples_(0)
+              , grow_(true), reversed_(false), converged_(false), start_(0)
+            {}
+
+            std::size_t get_chunk_size(std::size_t cores, std::size_t count)
+            {
+                if (count == 0)
+                    return 1;
+
+                // restart tuning if the shape of the loop has changed
+                if (cores != cores_ || count != count_ || chunk_size_ == 0)
+                {
+                    cores_ = cores;
+                    count_ = count;
+                    chunk_size_ = (std::max)(std::size_t(1),
+                        (count + 4 * cores - 1) / (4 * cores));
+                    best_chunk_size_ = chunk_size_;
+                    best_time_ = 0;
+                    num_samples_ = 0;
+                    grow_ = true;
+                    reversed_ = false;
+                    converged_ = false;
+                }
+                return chunk_size_;
+            }
+
+            void add_sample(std::uint64_t elapsed)
+            {
+                if (count_ == 0 || chunk_size_ == 0)
+                    return;
+
+                // nanoseconds per iteration, the best of all samples
+                double t = double(elapsed) / count_;
+                sample_time_ = num_samples_ == 0 ? t : (std::min)(sample_time_, t);
+                if (++num_samples_ < samples_)
+                    return;
+
+                t = sample_time_;
+                num_samples_ = 0;
+
+                if (converged_)
+                {
+                    if (t <= best_time_ * (1 + retune_threshold_))
+                    {
+                        best_time_ = (std::min)(best_time_, t);
+                        return;
+                    }
+
+                    // the timings have changed, restart tuning from here
+                    best_time_ = t;
+                    grow_ = true;
+                    reversed_ = false;
+                    converged_ = false;
+                }
+                else if (best_time_ == 0 || t < best_time_ * 0.98)
+                {
+                    // the current chunk size is better, keep going into the
+                    // same direction, there is no point in turning around
+                    // if this was not the first measurement
+                    reversed_ = reversed_ || best_time_ != 0;
+                    best_time_ = t;
+                    best_chunk_size_ = chunk_size_;
+                }
+                else if (!reversed_)
+                {
+                    grow_ = !grow_;
+                    reversed_ = true;
+                }
+                else
+                {
+                    chunk_size_ = best_chunk_size_;
+                    converged_ = true;
+                    return;
+                }
+
+                next_chunk_size();
+            }
+
+            void next_chunk_size()
+            {
+                // there is no point in creating fewer chunks than cores
+                std::size_t max_chunk_size = (count_ + cores_ - 1) / cores_;
+
+                std::size_t next = grow_ ?
+                    (std::min)(best_chunk_size_ * 2, max_chunk_size) :
+                    best_chunk_size_ / 2;
+
+                if (next == 0 || next == best_chunk_size_)
+                {
+                    if (!reversed_)
+                    {
+                        grow_ = !grow_;
+                        reversed_ = true;
+                        next_chunk_size();
+                        return;
+                    }
+
+                    chunk_size_ = best_chunk_size_;
+                    converged_ = true;
+                    return;
+                }
+
+                chunk_size_ = next;
+            }
+
+            template <typename Archive>
+            void serialize(Archive & ar, const unsigned int version)
+            {
+                ar & samples_ & retune_threshold_ & cores_ & count_ &
+                    chunk_size_ & best_chunk_size_ & best_time_ & grow_ &
+                    reversed_ & converged_;
+            }
+
+            std::size_t samples_;
+            double retune_threshold_;
+
+            std::size_t cores_;             // shape of the tuned loop
+            std::size_t count_;
+            std::size_t chunk_size_;        // chunk size currently measured
+            std::size_t best_chunk_size_;
+            double best_time_;              // nanoseconds per iteration
+            double sample_time_;
+            std::size_t num_samples_;
+            bool grow_;
+            bool reversed_;
+            bool converged_;
+
+            std::uint64_t start_;
+            hpx::lcos::local::spinlock mtx_;
+        };
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        std::shared_ptr<state> state_;
+        /// \endcond
+    };
+}}}
+
+namespace hpx { namespace parallel { namespace execution
+{
+    /// \cond NOINTERNAL
+    template <>
+    struct is_executor_parameters<parallel::execution::tuned_chunk_size>
+      : std::true_type
+    {};
+    /// \endcond
+}}}
+
+#endif
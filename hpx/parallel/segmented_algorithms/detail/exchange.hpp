@@ -0,0 +1,422 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHMS_DETAIL_EXCHANGE_HPP)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHMS_DETAIL_EXCHANGE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/latch.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/unused.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// The segmented algorithms moving elements between the segments (sort,
+// unique and remove_if) do so in a single all-to-all exchange: each of the
+// segments fetches the elements it will hold from the other segments,
+// all segments wait for each other, and then overwrite their elements.
+namespace hpx { namespace parallel { inline namespace v1 { namespace detail
+{
+    /// \cond NOINTERNAL
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The non-empty parts of the segments covered by a segmented range.
+    template <typename SegIter>
+    struct segmented_pieces
+    {
+        typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+        typedef typename traits::segment_iterator segment_iterator;
+        typedef typename traits::local_iterator local_iterator;
+
+        segmented_pieces(SegIter first, SegIter last)
+        {
+            segment_iterator sit = traits::segment(first);
+            segment_iterator send = traits::segment(last);
+
+            if (sit == send)
+            {
+                // all elements are on the same partition
+                add(sit, traits::local(first), traits::local(last));
+            }
+            else {
+                // handle the remaining part of the first partition
+                add(sit, traits::local(first), traits::end(sit));
+
+                // handle all of the full partitions
+                for (++sit; sit != send; ++sit)
+                    add(sit, traits::begin(sit), traits::end(sit));
+
+                // handle the beginning of the last partition
+                add(sit, traits::begin(sit), traits::local(last));
+            }
+        }
+
+        std::size_t size() const
+        {
+            return ids_.size();
+        }
+
+        std::vector<id_type> ids_;
+        std::vector<local_iterator> first_;
+        std::vector<local_iterator> last_;
+        std::vector<std::size_t> sizes_;
+
+    private:
+        void add(segment_iterator const& sit, local_iterator const& beg,
+            local_iterator const& end)
+        {
+            if (beg != end)
+            {
+                ids_.push_back(traits::get_id(sit));
+                first_.push_back(beg);
+                last_.push_back(end);
+                sizes_.push_back(std::distance(beg, end));
+            }
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // wait for all of the segments, rethrow their exceptions
+    template <typename ExPolicy, typename T>
+    std::vector<T>
+    get_segment_results(std::vector<hpx::future<T> > && segments)
+    {
+        hpx::wait_all(segments);
+
+        std::list<std::exception_ptr> errors;
+        parallel::util::detail::handle_remote_exceptions<
+                typename hpx::util::decay<ExPolicy>::type
+            >::call(segments, errors);
+
+        std::vector<T> results;
+        results.reserve(segments.size());
+        for (hpx::future<T>& f : segments)
+            results.push_back(f.get());
+        return results;
+    }
+
+    template <typename ExPolicy>
+    void get_segment_results(std::vector<hpx::future<void> > && segments)
+    {
+        hpx::wait_all(segments);
+
+        std::list<std::exception_ptr> errors;
+        parallel::util::detail::handle_remote_exceptions<
+                typename hpx::util::decay<ExPolicy>::type
+            >::call(segments, errors);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Run the algorithm Algo on a segment, returns the number of elements
+    // before the iterator returned by the algorithm. The local iterators
+    // of the segments are not sent back to the caller.
+    template <typename Iter>
+    Iter get_local_result(Iter it)
+    {
+        return it;
+    }
+
+    template <typename Iter>
+    Iter get_local_result(hpx::future<Iter> && f)
+    {
+        return f.get();
+    }
+
+    template <template <typename> class Algo>
+    struct segmented_local_count
+      : public detail::algorithm<segmented_local_count<Algo>, std::size_t>
+    {
+        segmented_local_count()
+          : segmented_local_count::algorithm("segmented_local_count")
+        {}
+
+        template <typename ExPolicy, typename Iter, typename ... Args>
+        static std::size_t
+        sequential(ExPolicy && policy, Iter first, Iter last, Args && ... args)
+        {
+            return std::distance(first, get_local_result(
+                Algo<Iter>().call(std::forward<ExPolicy>(policy),
+                    std::true_type(), first, last,
+                    std::forward<Args>(args)...)));
+        }
+
+        template <typename ExPolicy, typename Iter, typename ... Args>
+        static typename util::detail::algorithm_result<
+            ExPolicy, std::size_t
+        >::type
+        parallel(ExPolicy && policy, Iter first, Iter last, Args && ... args)
+        {
+            std::size_t count = std::distance(first, get_local_result(
+                Algo<Iter>().call(std::forward<ExPolicy>(policy),
+                    std::false_type(), first, last,
+                    std::forward<Args>(args)...)));
+
+            return util::detail::algorithm_result<
+                    ExPolicy, std::size_t
+                >::get(std::move(count));
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // copy the elements of a segment into a vector
+    template <typename T>
+    struct segmented_fetch
+      : public detail::algorithm<segmented_fetch<T>, std::vector<T> >
+    {
+        segmented_fetch()
+          : segmented_fetch::algorithm("segmented_fetch")
+        {}
+
+        template <typename ExPolicy, typename InIter>
+        static std::vector<T>
+        sequential(ExPolicy, InIter first, InIter last)
+        {
+            return std::vector<T>(first, last);
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The elements [first_, last_) of the piece source_, the runs belonging to
+    // the same group_ are merged.
+    struct segmented_run
+    {
+        std::size_t source_;
+        std::size_t first_;
+        std::size_t last_;
+        std::size_t group_;
+
+        template <typename Archive>
+        void serialize(Archive& ar, unsigned)
+        {
+            ar & source_ & first_ & last_ & group_;
+        }
+    };
+
+    // merge the sorted runs of each of the groups pairwise
+    template <typename T, typename Compare>
+    void merge_segmented_runs(std::vector<T>& buffer,
+        std::vector<std::size_t> const& bounds,
+        std::vector<segmented_run> const& runs, Compare const& comp)
+    {
+        std::size_t i = 0;
+        while (i != runs.size())
+        {
+            std::size_t j = i + 1;
+            while (j != runs.size() && runs[j].group_ == runs[i].group_)
+                ++j;
+
+            std::vector<std::size_t> b(
+                bounds.begin() + i, bounds.begin() + j + 1);
+            while (b.size() > 2)
+            {
+                std::vector<std::size_t> next;
+                next.reserve(b.size() / 2 + 2);
+
+                std::size_t k = 0;
+                for (/**/; k + 2 < b.size(); k += 2)
+                {
+                    std::inplace_merge(buffer.begin() + b[k],
+                        buffer.begin() + b[k + 1], buffer.begin() + b[k + 2],
+                        comp);
+                    next.push_back(b[k]);
+                }
+                if (k + 2 == b.size())
+                    next.push_back(b[k]);
+                next.push_back(b.back());
+
+                b = std::move(next);
+            }
+
+            i = j;
+        }
+    }
+
+    // Executed on the locality of a piece: fetch the given runs from the
+    // other pieces and overwrite the piece with the elements starting at
+    // position 'skip' of their concatenation, once all pieces have fetched
+    // their runs.
+    template <typename LocalIter>
+    struct segmented_exchange
+      : public detail::algorithm<segmented_exchange<LocalIter> >
+    {
+        segmented_exchange()
+          : segmented_exchange::algorithm("segmented_exchange")
+        {}
+
+        template <typename ExPolicy, typename Iter, typename Compare,
+            typename Proj>
+        static hpx::util::unused_type
+        sequential(ExPolicy, Iter first, Iter last,
+            std::vector<id_type> const& ids,
+            std::vector<LocalIter> const& sources,
+            std::vector<segmented_run> const& runs, std::size_t skip,
+            hpx::lcos::latch l, bool merge, Compare && comp, Proj && proj)
+        {
+            typedef typename std::iterator_traits<LocalIter>::value_type
+                value_type;
+
+            std::vector<value_type> buffer;
+            std::exception_ptr error;
+
+            try {
+                std::vector<hpx::future<std::vector<value_type> > > fetched;
+                fetched.reserve(runs.size());
+                for (segmented_run const& run : runs)
+                {
+                    LocalIter src = sources[run.source_];
+                    fetched.push_back(dispatch_async(ids[run.source_],
+                        segmented_fetch<value_type>(), execution::seq,
+                        std::true_type(), std::next(src, run.first_),
+                        std::next(src, run.last_)));
+                }
+
+                std::vector<std::vector<value_type> > values =
+                    get_segment_results<execution::sequenced_policy>(
+                        std::move(fetched));
+
+                std::vector<std::size_t> bounds;
+                bounds.reserve(values.size() + 1);
+                bounds.push_back(0);
+                for (std::vector<value_type>& v : values)
+                {
+                    buffer.insert(buffer.end(),
+                        std::make_move_iterator(v.begin()),
+                        std::make_move_iterator(v.end()));
+                    bounds.push_back(buffer.size());
+                }
+
+                if (merge)
+                {
+                    typedef util::compare_projected<
+                            typename hpx::util::decay<Compare>::type,
+                            typename hpx::util::decay<Proj>::type
+                        > compare_type;
+
+                    merge_segmented_runs(buffer, bounds, runs,
+                        compare_type(std::forward<Compare>(comp),
+                            std::forward<Proj>(proj)));
+                }
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+
+            // none of the elements may be overwritten before all of the
+            // pieces have fetched theirs, this has to be reached even on
+            // error to not block the other pieces
+            l.count_down_and_wait();
+
+            if (error)
+                std::rethrow_exception(error);
+
+            std::size_t count = (std::min)(
+                std::size_t(std::distance(first, last)), buffer.size() - skip);
+            std::move(buffer.begin() + skip, buffer.begin() + skip + count,
+                first);
+
+            return hpx::util::unused;
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Move the elements [offsets[i], offsets[i] + counts[i]) of each of the
+    // pieces to the front of the range, in order. Returns the number of
+    // elements moved.
+    template <typename ExPolicy, typename SegIter>
+    std::size_t compact_segments(segmented_pieces<SegIter> const& pieces,
+        std::vector<std::size_t> const& offsets,
+        std::vector<std::size_t> const& counts)
+    {
+        typedef typename segmented_pieces<SegIter>::local_iterator
+            local_iterator;
+
+        std::size_t const p = pieces.size();
+
+        // the position of the kept elements of each piece in the result
+        std::vector<std::size_t> kept_first(p + 1, 0);
+        for (std::size_t i = 0; i != p; ++i)
+            kept_first[i + 1] = kept_first[i] + counts[i];
+
+        std::size_t const total = kept_first[p];
+
+        std::vector<std::size_t> targets;
+        std::vector<std::vector<segmented_run> > target_runs;
+
+        std::size_t pos = 0;
+        for (std::size_t k = 0; k != p && pos < total; ++k)
+        {
+            std::size_t first = pos;
+            std::size_t last = (std::min)(pos + pieces.sizes_[k], total);
+            pos += pieces.sizes_[k];
+
+            std::vector<segmented_run> runs;
+            for (std::size_t i = 0; i != p; ++i)
+            {
+                std::size_t lo = (std::max)(first, kept_first[i]);
+                std::size_t hi = (std::min)(last, kept_first[i + 1]);
+                if (lo < hi)
+                {
+                    runs.push_back(segmented_run{i,
+                        offsets[i] + lo - kept_first[i],
+                        offsets[i] + hi - kept_first[i], 0});
+                }
+            }
+
+            // the elements of this piece are in place already
+            if (runs.size() == 1 && runs[0].source_ == k &&
+                runs[0].first_ == 0)
+            {
+                continue;
+            }
+
+            targets.push_back(k);
+            target_runs.push_back(std::move(runs));
+        }
+
+        if (targets.empty())
+            return total;
+
+        hpx::lcos::latch l(std::ptrdiff_t(targets.size()));
+
+        std::vector<hpx::future<void> > exchanged;
+        exchanged.reserve(targets.size());
+        for (std::size_t t = 0; t != targets.size(); ++t)
+        {
+            std::size_t k = targets[t];
+            exchanged.push_back(dispatch_async(pieces.ids_[k],
+                segmented_exchange<local_iterator>(), execution::seq,
+                std::true_type(), pieces.first_[k], pieces.last_[k],
+                pieces.ids_, pieces.first_, target_runs[t], std::size_t(0),
+                l, false, detail::less(), util::projection_identity()));
+        }
+
+        get_segment_results<ExPolicy>(std::move(exchanged));
+        return total;
+    }
+
+    /// \endcond
+}}}}
+
+#endif
@@ -17,6 +17,7 @@
 #include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
 
 #include <algorithm>
+#include <cstddef>
 #include <exception>
 #include <iterator>
 #include <list>
@@ -211,6 +212,141 @@ namespace hpx { namespace parallel { inline namespace v1
         generate_(ExPolicy&& policy, FwdIter first, FwdIter last, F && f,
             std::false_type);
 
+        ///////////////////////////////////////////////////////////////////////
+        // segmented_generate_random, the position of the elements in the
+        // whole sequence is passed on to the segments as the offset of the
+        // generator
+
+        // sequential remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter,
+            typename F>
+        static typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        segmented_generate_random(Algo && algo, ExPolicy const& policy,
+            SegIter first, SegIter last, random_generator<F> gen,
+            std::true_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::segment_iterator segment_iterator;
+            typedef typename traits::local_iterator local_iterator_type;
+            typedef util::detail::algorithm_result<ExPolicy, SegIter> result;
+
+            segment_iterator sit = traits::segment(first);
+            segment_iterator send = traits::segment(last);
+
+            local_iterator_type beg = traits::local(first);
+            local_iterator_type out = traits::local(last);
+            for (/**/; /**/; ++sit)
+            {
+                local_iterator_type end =
+                    (sit == send) ? traits::local(last) : traits::end(sit);
+
+                std::size_t const count = std::distance(beg, end);
+                if (count != 0)
+                {
+                    out = dispatch(traits::get_id(sit), algo, policy,
+                        std::true_type(), beg, count, gen);
+                    gen.offset_ += count;
+                }
+
+                if (sit == send)
+                    break;
+
+                beg = traits::begin(std::next(sit));
+            }
+
+            return result::get(traits::compose(send, out));
+        }
+
+        // parallel remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter,
+            typename F>
+        static typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        segmented_generate_random(Algo && algo, ExPolicy const& policy,
+            SegIter first, SegIter last, random_generator<F> gen,
+            std::false_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::segment_iterator segment_iterator;
+            typedef typename traits::local_iterator local_iterator_type;
+
+            typedef std::integral_constant<bool,
+                    !hpx::traits::is_forward_iterator<SegIter>::value
+                > forced_seq;
+            typedef util::detail::algorithm_result<ExPolicy, SegIter> result;
+
+            segment_iterator sit = traits::segment(first);
+            segment_iterator send = traits::segment(last);
+
+            std::vector<shared_future<local_iterator_type> > segments;
+            segments.reserve(std::distance(sit, send) + 1);
+
+            local_iterator_type beg = traits::local(first);
+            for (/**/; /**/; ++sit)
+            {
+                local_iterator_type end =
+                    (sit == send) ? traits::local(last) : traits::end(sit);
+
+                std::size_t const count = std::distance(beg, end);
+                if (count != 0)
+                {
+                    segments.push_back(dispatch_async(traits::get_id(sit),
+                        algo, policy, forced_seq(), beg, count, gen));
+                    gen.offset_ += count;
+                }
+
+                if (sit == send)
+                    break;
+
+                beg = traits::begin(std::next(sit));
+            }
+
+            return result::get(
+                dataflow(
+                    [=](std::vector<hpx::shared_future<local_iterator_type> > && r)
+                        ->  SegIter
+                    {
+                        // handle any remote exceptions, will throw on error
+                        std::list<std::exception_ptr> errors;
+                        parallel::util::detail::handle_remote_exceptions<
+                            ExPolicy
+                        >::call(r, errors);
+                        return traits::compose(send, r.back().get());
+                    },
+                    std::move(segments)));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename FwdIter, typename F>
+        inline typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        generate_random_(ExPolicy && policy, FwdIter first, FwdIter last,
+            random_generator<F> && gen, std::true_type)
+        {
+            typedef parallel::execution::is_sequenced_execution_policy<
+                    ExPolicy
+                > is_seq;
+
+            if (first == last)
+            {
+                typedef util::detail::algorithm_result<ExPolicy, FwdIter> result;
+                return result::get(std::move(last));
+            }
+
+            typedef hpx::traits::segmented_iterator_traits<FwdIter>
+                iterator_traits;
+
+            return segmented_generate_random(
+                generate_random<typename iterator_traits::local_iterator>(),
+                std::forward<ExPolicy>(policy), first, last, std::move(gen),
+                is_seq());
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter, typename F>
+        typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        generate_random_(ExPolicy&& policy, FwdIter first, FwdIter last,
+            random_generator<F> && gen, std::false_type);
+
         /// \endcond
     }
 }}}
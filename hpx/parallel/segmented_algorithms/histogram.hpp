@@ -0,0 +1,259 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_HISTOGRAM_HPP)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_HISTOGRAM_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/dataflow.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/unwrap.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/histogram.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_histogram
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // sequential remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter,
+            typename F, typename Proj>
+        static typename util::detail::algorithm_result<
+            ExPolicy, std::vector<std::size_t>
+        >::type
+        segmented_histogram(Algo && algo, ExPolicy const& policy,
+            SegIter first, SegIter last, std::size_t num_bins, F && f,
+            Proj && proj, std::true_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::segment_iterator segment_iterator;
+            typedef typename traits::local_iterator local_iterator_type;
+            typedef util::detail::algorithm_result<
+                    ExPolicy, std::vector<std::size_t>
+                > result;
+
+            segment_iterator sit = traits::segment(first);
+            segment_iterator send = traits::segment(last);
+
+            std::vector<std::size_t> overall_result(num_bins, 0);
+            add_histogram_bins add;
+
+            if (sit == send)
+            {
+                // all elements are on the same partition
+                local_iterator_type beg = traits::local(first);
+                local_iterator_type end = traits::local(last);
+                if (beg != end)
+                {
+                    overall_result = dispatch(traits::get_id(sit),
+                        algo, policy, std::true_type(), beg, end,
+                        num_bins, f, proj);
+                }
+            }
+            else {
+                // handle the remaining part of the first partition
+                local_iterator_type beg = traits::local(first);
+                local_iterator_type end = traits::end(sit);
+                if (beg != end)
+                {
+                    overall_result = add(std::move(overall_result),
+                        dispatch(traits::get_id(sit), algo, policy,
+                            std::true_type(), beg, end, num_bins, f, proj));
+                }
+
+                // handle all of the full partitions
+                for (++sit; sit != send; ++sit)
+                {
+                    beg = traits::begin(sit);
+                    end = traits::end(sit);
+                    if (beg != end)
+                    {
+                        overall_result = add(std::move(overall_result),
+                            dispatch(traits::get_id(sit), algo, policy,
+                                std::true_type(), beg, end, num_bins, f, proj));
+                    }
+                }
+
+                // handle the beginning of the last partition
+                beg = traits::begin(sit);
+                end = traits::local(last);
+                if (beg != end)
+                {
+                    overall_result = add(std::move(overall_result),
+                        dispatch(traits::get_id(sit), algo, policy,
+                            std::true_type(), beg, end, num_bins, f, proj));
+                }
+            }
+
+            return result::get(std::move(overall_result));
+        }
+
+        // Combine the bins of the segments pairwise, which merges the partial
+        // histograms as soon as they become available and keeps the depth of
+        // the reduction logarithmic in the number of segments.
+        inline hpx::future<std::vector<std::size_t> >
+        tree_reduce_histograms(
+            std::vector<hpx::future<std::vector<std::size_t> > > && bins,
+            std::size_t num_bins)
+        {
+            if (bins.empty())
+            {
+                return hpx::make_ready_future(
+                    std::vector<std::size_t>(num_bins, 0));
+            }
+
+            while (bins.size() > 1)
+            {
+                std::vector<hpx::future<std::vector<std::size_t> > > next;
+                next.reserve((bins.size() + 1) / 2);
+
+                for (std::size_t i = 0; i + 1 < bins.size(); i += 2)
+                {
+                    next.push_back(hpx::dataflow(
+                        hpx::util::unwrapping(add_histogram_bins()),
+                        std::move(bins[i]), std::move(bins[i + 1])));
+                }
+                if (bins.size() % 2 != 0)
+                    next.push_back(std::move(bins.back()));
+
+                bins = std::move(next);
+            }
+            return std::move(bins.front());
+        }
+
+        // parallel remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter,
+            typename F, typename Proj>
+        static typename util::detail::algorithm_result<
+            ExPolicy, std::vector<std::size_t>
+        >::type
+        segmented_histogram(Algo && algo, ExPolicy const& policy,
+            SegIter first, SegIter last, std::size_t num_bins, F && f,
+            Proj && proj, std::false_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::segment_iterator segment_iterator;
+            typedef typename traits::local_iterator local_iterator_type;
+
+            typedef std::integral_constant<bool,
+                    !hpx::traits::is_forward_iterator<SegIter>::value
+                > forced_seq;
+
+            typedef util::detail::algorithm_result<
+                    ExPolicy, std::vector<std::size_t>
+                > result;
+
+            segment_iterator sit = traits::segment(first);
+            segment_iterator send = traits::segment(last);
+
+            std::vector<hpx::future<std::vector<std::size_t> > > segments;
+            segments.reserve(std::distance(sit, send));
+
+            if (sit == send)
+            {
+                // all elements are on the same partition
+                local_iterator_type beg = traits::local(first);
+                local_iterator_type end = traits::local(last);
+                if (beg != end)
+                {
+                    segments.push_back(dispatch_async(traits::get_id(sit),
+                        algo, policy, forced_seq(), beg, end, num_bins, f,
+                        proj));
+                }
+            }
+            else {
+                // handle the remaining part of the first partition
+                local_iterator_type beg = traits::local(first);
+                local_iterator_type end = traits::end(sit);
+                if (beg != end)
+                {
+                    segments.push_back(dispatch_async(traits::get_id(sit),
+                        algo, policy, forced_seq(), beg, end, num_bins, f,
+                        proj));
+                }
+
+                // handle all of the full partitions
+                for (++sit; sit != send; ++sit)
+                {
+                    beg = traits::begin(sit);
+                    end = traits::end(sit);
+                    if (beg != end)
+                    {
+                        segments.push_back(dispatch_async(traits::get_id(sit),
+                            algo, policy, forced_seq(), beg, end, num_bins, f,
+                            proj));
+                    }
+                }
+
+                // handle the beginning of the last partition
+                beg = traits::begin(sit);
+                end = traits::local(last);
+                if (beg != end)
+                {
+                    segments.push_back(dispatch_async(traits::get_id(sit),
+                        algo, policy, forced_seq(), beg, end, num_bins, f,
+                        proj));
+                }
+            }
+
+            return result::get(
+                tree_reduce_histograms(std::move(segments), num_bins));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename SegIter, typename OutIter,
+            typename F, typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+        histogram_(ExPolicy && policy, SegIter first, SegIter last,
+            OutIter dest, std::size_t num_bins, F && f, Proj && proj,
+            std::true_type)
+        {
+            typedef parallel::execution::is_sequenced_execution_policy<
+                    ExPolicy
+                > is_seq;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<ExPolicy, OutIter>::get(
+                    std::fill_n(dest, num_bins, std::size_t(0)));
+            }
+
+            return get_histogram(
+                segmented_histogram(histogram(),
+                    std::forward<ExPolicy>(policy), first, last, num_bins,
+                    std::forward<F>(f), std::forward<Proj>(proj), is_seq()),
+                dest);
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter, typename OutIter,
+            typename F, typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+        histogram_(ExPolicy && policy, FwdIter first, FwdIter last,
+            OutIter dest, std::size_t num_bins, F && f, Proj && proj,
+            std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
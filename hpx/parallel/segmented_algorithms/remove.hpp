@@ -0,0 +1,138 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_REMOVE_HPP)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_REMOVE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/remove.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/exchange.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_remove_if
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // Remove the elements from each of the segments, then move the
+        // remaining elements of all segments to the front of the range in
+        // one exchange.
+        template <typename ExPolicy, typename SegIter, typename Pred,
+            typename Proj>
+        SegIter segmented_remove_if(ExPolicy policy, SegIter first,
+            SegIter last, Pred pred, Proj proj)
+        {
+            typedef segmented_pieces<SegIter> pieces_type;
+
+            typedef std::integral_constant<bool,
+                    execution::is_sequenced_execution_policy<
+                        ExPolicy
+                    >::value ||
+                   !hpx::traits::is_forward_iterator<SegIter>::value
+                > forced_seq;
+
+            pieces_type pieces(first, last);
+            std::size_t const p = pieces.size();
+
+            std::vector<hpx::future<std::size_t> > removed;
+            removed.reserve(p);
+            for (std::size_t i = 0; i != p; ++i)
+            {
+                removed.push_back(dispatch_async(pieces.ids_[i],
+                    segmented_local_count<detail::remove_if>(), policy,
+                    forced_seq(), pieces.first_[i], pieces.last_[i], pred,
+                    proj));
+            }
+
+            std::vector<std::size_t> offsets(p, 0);
+            std::vector<std::size_t> counts =
+                get_segment_results<ExPolicy>(std::move(removed));
+
+            return std::next(first,
+                compact_segments<ExPolicy>(pieces, offsets, counts));
+        }
+
+        template <typename ExPolicy, typename SegIter, typename Pred,
+            typename Proj>
+        SegIter segmented_remove_if_(ExPolicy && policy, SegIter first,
+            SegIter last, Pred && pred, Proj && proj, std::false_type)
+        {
+            return segmented_remove_if(std::forward<ExPolicy>(policy), first,
+                last, std::forward<Pred>(pred), std::forward<Proj>(proj));
+        }
+
+        template <typename ExPolicy, typename SegIter, typename Pred,
+            typename Proj>
+        hpx::future<SegIter> segmented_remove_if_(ExPolicy && policy,
+            SegIter first, SegIter last, Pred && pred, Proj && proj,
+            std::true_type)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef typename hpx::util::decay<Pred>::type pred_type;
+            typedef typename hpx::util::decay<Proj>::type proj_type;
+
+            return hpx::async(
+                &segmented_remove_if<
+                    policy_type, SegIter, pred_type, proj_type
+                >,
+                std::forward<ExPolicy>(policy), first, last,
+                std::forward<Pred>(pred), std::forward<Proj>(proj));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename SegIter, typename Pred,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        remove_if_(ExPolicy && policy, SegIter first, SegIter last,
+            Pred && pred, Proj && proj, std::true_type)
+        {
+            typedef execution::is_async_execution_policy<
+                    typename hpx::util::decay<ExPolicy>::type
+                > is_async;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, SegIter
+                    >::get(std::move(last));
+            }
+
+            return segmented_remove_if_(std::forward<ExPolicy>(policy), first,
+                last, std::forward<Pred>(pred), std::forward<Proj>(proj),
+                is_async());
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter, typename Pred,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        remove_if_(ExPolicy && policy, FwdIter first, FwdIter last,
+            Pred && pred, Proj && proj, std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
@@ -0,0 +1,310 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_SORT_HPP)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_SORT_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/latch.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/sort.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/exchange.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_sort
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // the number of samples drawn from each of the sorted segments
+        static std::size_t const sort_samples_per_segment = 64;
+
+        // draw count evenly spaced elements from a sorted segment
+        template <typename T>
+        struct sort_samples
+          : public detail::algorithm<sort_samples<T>, std::vector<T> >
+        {
+            sort_samples()
+              : sort_samples::algorithm("sort_samples")
+            {}
+
+            template <typename ExPolicy, typename InIter>
+            static std::vector<T>
+            sequential(ExPolicy, InIter first, InIter last, std::size_t count)
+            {
+                std::size_t size = std::distance(first, last);
+
+                std::vector<T> samples;
+                samples.reserve(count);
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    samples.push_back(
+                        *std::next(first, (2 * i + 1) * size / (2 * count)));
+                }
+                return samples;
+            }
+        };
+
+        // split a sorted segment at the given splitters, returns the
+        // boundaries of the buckets
+        template <typename T>
+        struct sort_split
+          : public detail::algorithm<sort_split<T>, std::vector<std::size_t> >
+        {
+            sort_split()
+              : sort_split::algorithm("sort_split")
+            {}
+
+            template <typename ExPolicy, typename InIter, typename Compare,
+                typename Proj>
+            static std::vector<std::size_t>
+            sequential(ExPolicy, InIter first, InIter last,
+                std::vector<T> const& splitters, Compare && comp, Proj && proj)
+            {
+                util::compare_projected<
+                        typename hpx::util::decay<Compare>::type,
+                        typename hpx::util::decay<Proj>::type
+                    > cmp(std::forward<Compare>(comp),
+                        std::forward<Proj>(proj));
+
+                std::vector<std::size_t> bounds;
+                bounds.reserve(splitters.size() + 2);
+                bounds.push_back(0);
+
+                InIter it = first;
+                for (T const& splitter : splitters)
+                {
+                    it = std::lower_bound(it, last, splitter, cmp);
+                    bounds.push_back(std::distance(first, it));
+                }
+
+                bounds.push_back(std::distance(first, last));
+                return bounds;
+            }
+        };
+
+        // The sample sort of the segments:
+        //  - sort each of the segments locally
+        //  - select one splitter for each of the segments but the first from
+        //    regular samples of the sorted segments, the splitters define one
+        //    bucket for each of the segments
+        //  - each segment fetches the buckets overlapping with its part of
+        //    the sorted sequence (the sizes of the segments stay the same)
+        //    and merges those
+        template <typename ExPolicy, typename SegIter, typename Compare,
+            typename Proj>
+        SegIter segmented_sort(ExPolicy policy, SegIter first, SegIter last,
+            Compare comp, Proj proj)
+        {
+            typedef segmented_pieces<SegIter> pieces_type;
+            typedef typename pieces_type::local_iterator local_iterator;
+            typedef typename std::iterator_traits<SegIter>::value_type
+                value_type;
+
+            typedef std::integral_constant<bool,
+                    execution::is_sequenced_execution_policy<
+                        ExPolicy
+                    >::value ||
+                   !hpx::traits::is_forward_iterator<SegIter>::value
+                > forced_seq;
+
+            pieces_type pieces(first, last);
+            std::size_t const p = pieces.size();
+
+            // sort each of the segments
+            {
+                std::vector<hpx::future<std::size_t> > sorted;
+                sorted.reserve(p);
+                for (std::size_t i = 0; i != p; ++i)
+                {
+                    sorted.push_back(dispatch_async(pieces.ids_[i],
+                        segmented_local_count<detail::sort>(), policy,
+                        forced_seq(), pieces.first_[i], pieces.last_[i], comp,
+                        proj));
+                }
+                get_segment_results<ExPolicy>(std::move(sorted));
+            }
+
+            if (p < 2)
+                return last;
+
+            // select the splitters
+            std::vector<value_type> splitters;
+            {
+                std::vector<hpx::future<std::vector<value_type> > > sampled;
+                sampled.reserve(p);
+                for (std::size_t i = 0; i != p; ++i)
+                {
+                    std::size_t count = (std::min)(
+                        sort_samples_per_segment, pieces.sizes_[i]);
+                    sampled.push_back(dispatch_async(pieces.ids_[i],
+                        sort_samples<value_type>(), execution::seq,
+                        std::true_type(), pieces.first_[i], pieces.last_[i],
+                        count));
+                }
+
+                std::vector<value_type> samples;
+                for (std::vector<value_type>& s :
+                    get_segment_results<ExPolicy>(std::move(sampled)))
+                {
+                    samples.insert(samples.end(),
+                        std::make_move_iterator(s.begin()),
+                        std::make_move_iterator(s.end()));
+                }
+
+                std::sort(samples.begin(), samples.end(),
+                    util::compare_projected<Compare, Proj>(comp, proj));
+
+                splitters.reserve(p - 1);
+                for (std::size_t j = 1; j != p; ++j)
+                    splitters.push_back(samples[j * samples.size() / p]);
+            }
+
+            // split the segments into the buckets
+            std::vector<std::vector<std::size_t> > bounds;
+            {
+                std::vector<hpx::future<std::vector<std::size_t> > > split;
+                split.reserve(p);
+                for (std::size_t i = 0; i != p; ++i)
+                {
+                    split.push_back(dispatch_async(pieces.ids_[i],
+                        sort_split<value_type>(), execution::seq,
+                        std::true_type(), pieces.first_[i], pieces.last_[i],
+                        splitters, comp, proj));
+                }
+                bounds = get_segment_results<ExPolicy>(std::move(split));
+            }
+
+            // the position of the buckets in the sorted sequence
+            std::vector<std::size_t> bucket_first(p + 1, 0);
+            for (std::size_t j = 0; j != p; ++j)
+            {
+                bucket_first[j + 1] = bucket_first[j];
+                for (std::size_t i = 0; i != p; ++i)
+                    bucket_first[j + 1] += bounds[i][j + 1] - bounds[i][j];
+            }
+
+            // exchange the buckets
+            hpx::lcos::latch l(static_cast<std::ptrdiff_t>(p));
+
+            std::vector<hpx::future<void> > exchanged;
+            exchanged.reserve(p);
+
+            std::size_t pos = 0;
+            std::size_t j0 = 0;
+            for (std::size_t k = 0; k != p; ++k)
+            {
+                std::size_t pos_last = pos + pieces.sizes_[k];
+                while (bucket_first[j0 + 1] <= pos)
+                    ++j0;
+
+                std::vector<segmented_run> runs;
+                for (std::size_t j = j0; j != p && bucket_first[j] < pos_last;
+                     ++j)
+                {
+                    for (std::size_t i = 0; i != p; ++i)
+                    {
+                        if (bounds[i][j] != bounds[i][j + 1])
+                        {
+                            runs.push_back(segmented_run{
+                                i, bounds[i][j], bounds[i][j + 1], j});
+                        }
+                    }
+                }
+
+                exchanged.push_back(dispatch_async(pieces.ids_[k],
+                    segmented_exchange<local_iterator>(), execution::seq,
+                    std::true_type(), pieces.first_[k], pieces.last_[k],
+                    pieces.ids_, pieces.first_, runs, pos - bucket_first[j0],
+                    l, true, comp, proj));
+
+                pos = pos_last;
+            }
+
+            get_segment_results<ExPolicy>(std::move(exchanged));
+            return last;
+        }
+
+        template <typename ExPolicy, typename SegIter, typename Compare,
+            typename Proj>
+        SegIter segmented_sort_(ExPolicy && policy, SegIter first,
+            SegIter last, Compare && comp, Proj && proj, std::false_type)
+        {
+            return segmented_sort(std::forward<ExPolicy>(policy), first, last,
+                std::forward<Compare>(comp), std::forward<Proj>(proj));
+        }
+
+        template <typename ExPolicy, typename SegIter, typename Compare,
+            typename Proj>
+        hpx::future<SegIter> segmented_sort_(ExPolicy && policy,
+            SegIter first, SegIter last, Compare && comp, Proj && proj,
+            std::true_type)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef typename hpx::util::decay<Compare>::type compare_type;
+            typedef typename hpx::util::decay<Proj>::type proj_type;
+
+            return hpx::async(
+                &segmented_sort<policy_type, SegIter, compare_type, proj_type>,
+                std::forward<ExPolicy>(policy), first, last,
+                std::forward<Compare>(comp), std::forward<Proj>(proj));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename SegIter, typename Compare,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        sort_(ExPolicy && policy, SegIter first, SegIter last,
+            Compare && comp, Proj && proj, std::true_type)
+        {
+            typedef execution::is_async_execution_policy<
+                    typename hpx::util::decay<ExPolicy>::type
+                > is_async;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, SegIter
+                    >::get(std::move(last));
+            }
+
+            return segmented_sort_(std::forward<ExPolicy>(policy), first,
+                last, std::forward<Compare>(comp), std::forward<Proj>(proj),
+                is_async());
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+        sort_(ExPolicy && policy, RandomIt first, RandomIt last,
+            Compare && comp, Proj && proj, std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
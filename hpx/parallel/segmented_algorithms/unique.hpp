@@ -0,0 +1,169 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_UNIQUE_HPP)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_UNIQUE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/unique.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/exchange.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_unique
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // Remove the consecutive duplicates from each of the segments, then
+        // move the remaining elements of all segments to the front of the
+        // range in one exchange. The first remaining element of a segment
+        // is dropped as well if it is equivalent to the last element of the
+        // preceding segment.
+        template <typename ExPolicy, typename SegIter, typename Pred,
+            typename Proj>
+        SegIter segmented_unique(ExPolicy policy, SegIter first,
+            SegIter last, Pred pred, Proj proj)
+        {
+            typedef segmented_pieces<SegIter> pieces_type;
+            typedef typename std::iterator_traits<SegIter>::value_type
+                value_type;
+
+            typedef std::integral_constant<bool,
+                    execution::is_sequenced_execution_policy<
+                        ExPolicy
+                    >::value ||
+                   !hpx::traits::is_forward_iterator<SegIter>::value
+                > forced_seq;
+
+            pieces_type pieces(first, last);
+            std::size_t const p = pieces.size();
+
+            // fetch the elements at the boundaries of the segments
+            std::vector<hpx::future<std::vector<value_type> > > boundaries;
+            boundaries.reserve(2 * (p - 1));
+            for (std::size_t i = 1; i != p; ++i)
+            {
+                boundaries.push_back(dispatch_async(pieces.ids_[i - 1],
+                    segmented_fetch<value_type>(), execution::seq,
+                    std::true_type(), std::prev(pieces.last_[i - 1]),
+                    pieces.last_[i - 1]));
+                boundaries.push_back(dispatch_async(pieces.ids_[i],
+                    segmented_fetch<value_type>(), execution::seq,
+                    std::true_type(), pieces.first_[i],
+                    std::next(pieces.first_[i])));
+            }
+
+            std::vector<std::vector<value_type> > boundary_values =
+                get_segment_results<ExPolicy>(std::move(boundaries));
+
+            std::vector<hpx::future<std::size_t> > uniqued;
+            uniqued.reserve(p);
+            for (std::size_t i = 0; i != p; ++i)
+            {
+                uniqued.push_back(dispatch_async(pieces.ids_[i],
+                    segmented_local_count<detail::unique>(), policy,
+                    forced_seq(), pieces.first_[i], pieces.last_[i], pred,
+                    proj));
+            }
+
+            std::vector<std::size_t> offsets(p, 0);
+            std::vector<std::size_t> counts =
+                get_segment_results<ExPolicy>(std::move(uniqued));
+            for (std::size_t i = 1; i != p; ++i)
+            {
+                if (hpx::util::invoke(pred,
+                        hpx::util::invoke(proj, boundary_values[2 * i - 2][0]),
+                        hpx::util::invoke(proj, boundary_values[2 * i - 1][0])))
+                {
+                    offsets[i] = 1;
+                    --counts[i];
+                }
+            }
+
+            return std::next(first,
+                compact_segments<ExPolicy>(pieces, offsets, counts));
+        }
+
+        template <typename ExPolicy, typename SegIter, typename Pred,
+            typename Proj>
+        SegIter segmented_unique_(ExPolicy && policy, SegIter first,
+            SegIter last, Pred && pred, Proj && proj, std::false_type)
+        {
+            return segmented_unique(std::forward<ExPolicy>(policy), first,
+                last, std::forward<Pred>(pred), std::forward<Proj>(proj));
+        }
+
+        template <typename ExPolicy, typename SegIter, typename Pred,
+            typename Proj>
+        hpx::future<SegIter> segmented_unique_(ExPolicy && policy,
+            SegIter first, SegIter last, Pred && pred, Proj && proj,
+            std::true_type)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef typename hpx::util::decay<Pred>::type pred_type;
+            typedef typename hpx::util::decay<Proj>::type proj_type;
+
+            return hpx::async(
+                &segmented_unique<policy_type, SegIter, pred_type, proj_type>,
+                std::forward<ExPolicy>(policy), first, last,
+                std::forward<Pred>(pred), std::forward<Proj>(proj));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename SegIter, typename Pred,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        unique_(ExPolicy && policy, SegIter first, SegIter last,
+            Pred && pred, Proj && proj, std::true_type)
+        {
+            typedef execution::is_async_execution_policy<
+                    typename hpx::util::decay<ExPolicy>::type
+                > is_async;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, SegIter
+                    >::get(std::move(last));
+            }
+
+            return segmented_unique_(std::forward<ExPolicy>(policy), first,
+                last, std::forward<Pred>(pred), std::forward<Proj>(proj),
+                is_async());
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter, typename Pred,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        unique_(ExPolicy && policy, FwdIter first, FwdIter last,
+            Pred && pred, Proj && proj, std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
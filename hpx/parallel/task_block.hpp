@@ -13,12 +13,16 @@
 #include <hpx/exception.hpp>
 #include <hpx/lcos/dataflow.hpp>
 #include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/detail/condition_variable.hpp>
 #include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/lcos/when_all.hpp>
 #include <hpx/traits/is_future.hpp>
+#include <hpx/util/assert.hpp>
 #include <hpx/util/bind.hpp>
 #include <hpx/util/bind_back.hpp>
 #include <hpx/util/decay.hpp>
+#include <hpx/util/deferred_call.hpp>
+#include <hpx/util/detail/yield_k.hpp>
 
 #include <hpx/parallel/exception_list.hpp>
 #include <hpx/parallel/execution_policy.hpp>
@@ -28,6 +32,8 @@
 #include <boost/utility/addressof.hpp>      // boost::addressof
 #include <memory>                           // std::addressof
 
+#include <atomic>
+#include <cstddef>
 #include <exception>
 #include <mutex>
 #include <type_traits>
@@ -53,6 +59,117 @@ namespace hpx { namespace parallel { inline namespace v2
                 errors.add(std::current_exception());
             }
         }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The join counter of a task block. The tasks spawned by run are
+        // posted to the executor without creating a future for each of them,
+        // they only decrement the counter (and record their exceptions) when
+        // they finish.
+        class task_block_frame
+        {
+        private:
+            typedef hpx::lcos::local::spinlock mutex_type;
+
+            // the number of times a waiting thread yields to the tasks
+            // before suspending
+            static constexpr std::size_t num_yields = 32;
+
+        public:
+            task_block_frame()
+              : pending_(0)
+            {}
+
+            ~task_block_frame()
+            {
+                HPX_ASSERT(pending_.load() == 0);
+            }
+
+            task_block_frame(task_block_frame const&) = delete;
+            task_block_frame& operator=(task_block_frame const&) = delete;
+
+            void enter() noexcept
+            {
+                pending_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            // called by the tasks once they have finished
+            void leave()
+            {
+                std::size_t count = pending_.load(std::memory_order_relaxed);
+                while (count > 1)
+                {
+                    if (pending_.compare_exchange_weak(count, count - 1,
+                            std::memory_order_acq_rel))
+                    {
+                        return;
+                    }
+                }
+
+                // The last task decrements the counter while holding the
+                // lock, the waiting thread acquires the lock before it may
+                // destroy the frame.
+                std::unique_lock<mutex_type> l(mtx_);
+                if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    cond_.notify_all(std::move(l));
+            }
+
+            void add_exception()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                handle_task_block_exceptions(errors_);
+            }
+
+            // Wait for all tasks to finish. The waiting thread yields first,
+            // which gives its worker thread the chance to execute the tasks
+            // run has just queued there, and suspends only afterwards.
+            void wait()
+            {
+                for (std::size_t k = 0;
+                     k != num_yields &&
+                        pending_.load(std::memory_order_acquire) != 0;
+                     ++k)
+                {
+                    hpx::util::detail::yield_k(k, "task_block::wait");
+                }
+
+                std::unique_lock<mutex_type> l(mtx_);
+                while (pending_.load(std::memory_order_acquire) != 0)
+                    cond_.wait(l, "task_block::wait");
+            }
+
+            // move the exceptions thrown by the tasks to the given list
+            void take_exceptions(parallel::exception_list& errors)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                for (std::exception_ptr const& e: errors_)
+                    errors.add(e);
+                errors_ = parallel::exception_list();
+            }
+
+        private:
+            std::atomic<std::size_t> pending_;
+            mutex_type mtx_;
+            hpx::lcos::local::detail::condition_variable cond_;
+            parallel::exception_list errors_;
+        };
+
+        template <typename F>
+        struct task_block_task
+        {
+            void operator()()
+            {
+                try {
+                    f_();
+                }
+                catch (...) {
+                    frame_->add_exception();
+                }
+                frame_->leave();
+            }
+
+            task_block_frame* frame_;
+            F f_;
+        };
         /// \endcond
     }
 
@@ -117,8 +234,6 @@ namespace hpx { namespace parallel { inline namespace v2
     {
     private:
         /// \cond NOINTERNAL
-        typedef hpx::lcos::local::spinlock mutex_type;
-
         template <typename ExPolicy_, typename F>
         friend typename util::detail::algorithm_result<ExPolicy_>::type
         define_task_block(ExPolicy_ &&, F &&);
@@ -157,47 +272,49 @@ namespace hpx { namespace parallel { inline namespace v2
 
         task_block* operator&() const = delete;
 
-        static void
-        on_ready(std::vector<hpx::future<void> > && results,
-            parallel::exception_list && errors)
-        {
-            for (hpx::future<void>& f: results)
-            {
-                if (f.has_exception())
-                    errors.add(f.get_exception_ptr());
-            }
-            if (errors.size() != 0)
-                throw std::forward<parallel::exception_list>(errors);
-        }
-
-        // return future representing the execution of all tasks
+        // wait for all tasks, return the (ready) future representing their
+        // execution
         typename util::detail::algorithm_result<ExPolicy>::type
         when(bool throw_on_error = false)
         {
-            std::vector<hpx::future<void> > tasks;
-            parallel::exception_list errors;
+            frame_.wait();
 
-            {
-                std::lock_guard<mutex_type> l(mtx_);
-                std::swap(tasks_, tasks);
-                std::swap(errors_, errors);
-            }
+            // the exceptions are kept until the task block has completed
+            frame_.take_exceptions(errors_);
 
             typedef util::detail::algorithm_result<ExPolicy> result;
 
-            if (tasks.empty() && errors.size() == 0)
+            if (!throw_on_error || errors_.size() == 0)
                 return result::get();
 
-            if (!throw_on_error)
-                return result::get(hpx::when_all(tasks));
+            parallel::exception_list errors;
+            std::swap(errors_, errors);
 
-            return
-                result::get(
-                    hpx::dataflow(
-                        hpx::util::one_shot(hpx::util::bind_back(
-                            &task_block::on_ready, std::move(errors))),
-                        std::move(tasks)
-                    ));
+            return result::get(
+                hpx::make_exceptional_future<void>(std::move(errors)));
+        }
+
+        template <typename Executor, typename F, typename ... Ts>
+        void spawn(Executor && exec, F && f, Ts &&... ts)
+        {
+            typedef decltype(hpx::util::deferred_call(
+                std::forward<F>(f), std::forward<Ts>(ts)...)) function_type;
+
+            detail::task_block_task<function_type> task = {
+                &frame_,
+                hpx::util::deferred_call(std::forward<F>(f),
+                    std::forward<Ts>(ts)...)
+            };
+
+            frame_.enter();
+            try {
+                execution::post(
+                    std::forward<Executor>(exec), std::move(task));
+            }
+            catch (...) {
+                frame_.leave();
+                throw;
+            }
         }
         /// \endcond
 
@@ -252,14 +369,8 @@ namespace hpx { namespace parallel { inline namespace v2
                     "the task_block is not active");
             }
 
-            typedef typename ExPolicy::executor_type executor_type;
-
-            hpx::future<void> result = execution::async_execute(
-                policy_.executor(), std::forward<F>(f),
+            spawn(policy_.executor(), std::forward<F>(f),
                 std::forward<Ts>(ts)...);
-
-            std::lock_guard<mutex_type> l(mtx_);
-            tasks_.push_back(std::move(result));
         }
 
         /// Causes the expression f() to be invoked asynchronously using the
@@ -307,13 +418,7 @@ namespace hpx { namespace parallel { inline namespace v2
                     "the task_block is not active");
             }
 
-            typedef typename ExPolicy::executor_type executor_type;
-
-            hpx::future<void> result = execution::async_execute(
-                exec, std::forward<F>(f), std::forward<Ts>(ts)...);
-
-            std::lock_guard<mutex_type> l(mtx_);
-            tasks_.push_back(std::move(result));
+            spawn(exec, std::forward<F>(f), std::forward<Ts>(ts)...);
         }
 
         /// Blocks until the tasks spawned using this task_block have
@@ -369,8 +474,7 @@ namespace hpx { namespace parallel { inline namespace v2
         ExPolicy const& policy() const { return policy_; }
 
     private:
-        mutable mutex_type mtx_;
-        std::vector<hpx::future<void> > tasks_;
+        detail::task_block_frame frame_;
         parallel::exception_list errors_;
         threads::thread_id_type id_;
         ExPolicy policy_;
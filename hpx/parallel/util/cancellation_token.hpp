@@ -10,11 +10,27 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cstddef>
 #include <functional>
 #include <memory>
 
+// The number of iterations a loop executes between two checks of its
+// cancellation token.
+#if !defined(HPX_CANCELLATION_TOKEN_POLL_INTERVAL)
+#define HPX_CANCELLATION_TOKEN_POLL_INTERVAL 256
+#endif
+
 namespace hpx { namespace parallel { namespace util
 {
+    ///////////////////////////////////////////////////////////////////////////
+    // Loops observing a cancellation token check it before the first and
+    // then after every cancellation_poll_interval iterations. The iterations
+    // in between run without touching the token. A partition which starts
+    // running after the algorithm was cancelled returns before accessing
+    // any of its elements.
+    static const std::size_t cancellation_poll_interval =
+        HPX_CANCELLATION_TOKEN_POLL_INTERVAL;
+
     namespace detail
     {
         struct no_data
@@ -83,6 +83,29 @@ namespace hpx { namespace parallel { namespace util { namespace detail
                 throw exception_list(std::move(errors));
         }
 
+        // the future joining a bulk of tasks holds an exception_list of the
+        // exceptions thrown by the tasks (see bulk_join_execute)
+        static void call(hpx::future<void> const& joined,
+            std::list<std::exception_ptr>& errors, bool throw_errors = true)
+        {
+            if (joined.valid() && joined.has_exception())
+            {
+                try {
+                    std::rethrow_exception(joined.get_exception_ptr());
+                }
+                catch (exception_list const& el) {
+                    for (std::exception_ptr const& e: el)
+                        call(e, errors);
+                }
+                catch (...) {
+                    call(std::current_exception(), errors);
+                }
+            }
+
+            if (throw_errors && !errors.empty())
+                throw exception_list(std::move(errors));
+        }
+
         template <typename T, typename Cleanup>
         static void call(std::vector<hpx::future<T> >& workitems,
             std::list<std::exception_ptr>& errors, Cleanup && cleanup,
@@ -165,6 +188,13 @@ namespace hpx { namespace parallel { namespace util { namespace detail
             }
         }
 
+        static void call(hpx::future<void> const& joined,
+            std::list<std::exception_ptr>&, bool = true)
+        {
+            if (joined.valid() && joined.has_exception())
+                hpx::terminate();
+        }
+
         template <typename T, typename Cleanup>
         static void call(std::vector<hpx::future<T> > const& workitems,
             std::list<std::exception_ptr>&, Cleanup &&, bool = true)
@@ -0,0 +1,190 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_UTIL_DETAIL_LAZY_SPLITTING_HPP)
+#define HPX_PARALLEL_UTIL_DETAIL_LAZY_SPLITTING_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/invoke.hpp>
+
+#include <hpx/parallel/algorithms/detail/is_negative.hpp>
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/executors/execution_information.hpp>
+#include <hpx/parallel/executors/execution_parameters.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace parallel { namespace util { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Executes the iterations [first, first + count) by invoking f for each
+    // chunk of iterations. Before each chunk it checks whether fewer tasks
+    // than cores are active and, if there is enough work left, hands the
+    // second half of the remaining iterations to a new task. A task finishes
+    // only after all tasks split off from it have finished.
+    template <typename Executor, typename F>
+    struct lazy_splitting_state
+    {
+        template <typename Executor_, typename F_>
+        lazy_splitting_state(Executor_ && exec, F_ && f, std::size_t cores,
+                std::size_t chunk_size)
+          : exec_(std::forward<Executor_>(exec))
+          , f_(std::forward<F_>(f))
+          , cores_(cores)
+          , chunk_size_(chunk_size)
+          , active_(0)
+        {}
+
+        // reserve a slot for a new task, fails if all cores are busy
+        bool try_add_task()
+        {
+            if (active_.fetch_add(1) < cores_)
+                return true;
+
+            --active_;
+            return false;
+        }
+
+        Executor exec_;
+        F f_;
+        std::size_t const cores_;
+        std::size_t const chunk_size_;
+        std::atomic<std::size_t> active_;
+    };
+
+    template <typename State, typename FwdIter>
+    void lazy_splitting_iteration(std::shared_ptr<State> const& state,
+        FwdIter first, std::size_t count, std::size_t base_idx)
+    {
+        std::size_t const chunk_size = state->chunk_size_;
+        std::vector<hpx::future<void> > children;
+
+        std::exception_ptr ex;
+        try {
+            while (count != 0)
+            {
+                if (count >= 2 * chunk_size && state->try_add_task())
+                {
+                    // keep the first half, a multiple of the chunk size
+                    std::size_t keep = (count / 2 / chunk_size) * chunk_size;
+
+                    // modifies 'keep'
+                    FwdIter middle =
+                        parallel::v1::detail::next(first, count, keep);
+
+                    children.push_back(execution::async_execute(
+                        state->exec_,
+                        &lazy_splitting_iteration<State, FwdIter>, state,
+                        middle, count - keep, base_idx + keep));
+
+                    count = keep;
+                }
+
+                std::size_t chunk = (std::min)(chunk_size, count);
+                hpx::util::invoke(state->f_, first, chunk, base_idx);
+
+                // modifies 'chunk'
+                first = parallel::v1::detail::next(first, count, chunk);
+
+                count -= chunk;
+                base_idx += chunk;
+            }
+        }
+        catch (...) {
+            ex = std::current_exception();
+        }
+
+        // this task does not occupy a core anymore while waiting
+        --state->active_;
+
+        // the children refer to the same data, they have to finish first
+        hpx::wait_all(children);
+
+        if (ex)
+            std::rethrow_exception(ex);
+
+        for (hpx::future<void>& f : children)
+        {
+            if (f.has_exception())
+                f.get();        // rethrow
+        }
+    }
+
+    template <typename ExPolicy, typename FwdIter, typename Stride,
+        typename F>
+    std::vector<hpx::future<void> > lazy_splitting_partition(
+        ExPolicy && policy, FwdIter first, std::size_t count, Stride s,
+        F && f)
+    {
+        typedef typename std::decay<ExPolicy>::type::executor_type
+            executor_type;
+        typedef lazy_splitting_state<
+                executor_type, typename std::decay<F>::type
+            > state_type;
+
+        std::vector<hpx::future<void> > workitems;
+        if (count == 0)
+            return workitems;
+
+        std::size_t const cores = execution::processing_units_count(
+            policy.executor(), policy.parameters());
+
+        std::size_t chunk_size = execution::get_chunk_size(
+            policy.parameters(), policy.executor(), [](){ return 0; },
+            cores, count);
+
+        Stride stride = parallel::v1::detail::abs(s);
+        if (stride != 1)
+        {
+            chunk_size = (std::max)(std::size_t(stride),
+                ((chunk_size + stride) / stride - 1) * stride);
+        }
+        HPX_ASSERT(0 != chunk_size);
+
+        // start with one task per core, each owning a contiguous range
+        std::size_t tasks =
+            (std::max)(std::size_t(1), (std::min)(cores, count / chunk_size));
+        std::size_t task_size = (count + tasks - 1) / tasks;
+        task_size = ((task_size + chunk_size - 1) / chunk_size) * chunk_size;
+
+        std::shared_ptr<state_type> state = std::make_shared<state_type>(
+            policy.executor(), std::forward<F>(f), cores, chunk_size);
+
+        workitems.reserve(tasks);
+        std::size_t base_idx = 0;
+        while (count != 0)
+        {
+            std::size_t chunk = (std::min)(task_size, count);
+
+            ++state->active_;
+            workitems.push_back(execution::async_execute(
+                policy.executor(),
+                &lazy_splitting_iteration<state_type, FwdIter>, state,
+                first, chunk, base_idx));
+
+            // modifies 'chunk'
+            first = parallel::v1::detail::next(first, count, chunk);
+
+            count -= chunk;
+            base_idx += chunk;
+        }
+
+        return workitems;
+    }
+}}}}
+
+#endif
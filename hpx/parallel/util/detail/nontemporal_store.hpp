@@ -0,0 +1,180 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_UTIL_DETAIL_NONTEMPORAL_STORE_HPP)
+#define HPX_PARALLEL_UTIL_DETAIL_NONTEMPORAL_STORE_HPP
+
+#include <hpx/config.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if !defined(__CUDACC__) && defined(HPX_HAVE_CXX11_STD_IS_TRIVIALLY_COPYABLE) && \
+    (defined(__SSE2__) || defined(_M_X64) || \
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define HPX_PARALLEL_HAVE_NONTEMPORAL_STORES
+#include <emmintrin.h>
+#endif
+
+// Destination ranges of at least this many bytes are written using
+// non-temporal stores by copy, move, fill, uninitialized_fill and transform.
+// Ranges of this size would not fit into the (last level) caches anyway, so
+// writing them through the caches would only evict other data and require
+// reading each cache line before it is overwritten.
+#if !defined(HPX_PARALLEL_NONTEMPORAL_STORE_THRESHOLD)
+#define HPX_PARALLEL_NONTEMPORAL_STORE_THRESHOLD 4194304
+#endif
+
+namespace hpx { namespace parallel { namespace util { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Non-temporal stores are supported for pointers to trivially copyable
+    // types only.
+    template <typename Iter, typename Enable = void>
+    struct supports_nontemporal_stores
+      : std::false_type
+    {
+        static bool use(std::size_t)
+        {
+            return false;
+        }
+    };
+
+#if defined(HPX_PARALLEL_HAVE_NONTEMPORAL_STORES)
+    template <typename T>
+    struct supports_nontemporal_stores<T*,
+        typename std::enable_if<
+            std::is_trivially_copyable<T>::value &&
+           !std::is_const<T>::value && !std::is_volatile<T>::value
+        >::type>
+      : std::true_type
+    {
+        static bool use(std::size_t count)
+        {
+            return count * sizeof(T) >= HPX_PARALLEL_NONTEMPORAL_STORE_THRESHOLD;
+        }
+    };
+#endif
+
+    // Return whether writing count elements starting at an iterator of type
+    // Iter should use non-temporal stores.
+    template <typename Iter>
+    HPX_FORCEINLINE bool use_nontemporal_stores(std::size_t count)
+    {
+        return supports_nontemporal_stores<Iter>::use(count);
+    }
+
+#if defined(HPX_PARALLEL_HAVE_NONTEMPORAL_STORES)
+    ///////////////////////////////////////////////////////////////////////////
+    // Non-temporal stores are weakly ordered, nontemporal_store_fence has to
+    // be called before the written data is handed to other threads.
+    HPX_FORCEINLINE void nontemporal_store_fence()
+    {
+        _mm_sfence();
+    }
+
+    // Copy the given number of bytes using non-temporal stores, the ranges
+    // may not overlap.
+    inline void nontemporal_copy_bytes(char* dest, char const* src,
+        std::size_t bytes)
+    {
+        std::size_t head =
+            (16 - (reinterpret_cast<std::uintptr_t>(dest) & 15)) & 15;
+        if (head > bytes)
+            head = bytes;
+
+        std::memcpy(dest, src, head);
+        dest += head;
+        src += head;
+        bytes -= head;
+
+        // write one cache line at a time
+        for (/**/; bytes >= 64; bytes -= 64, dest += 64, src += 64)
+        {
+            __m128i const* s = reinterpret_cast<__m128i const*>(src);
+            __m128i* d = reinterpret_cast<__m128i*>(dest);
+
+            __m128i v0 = _mm_loadu_si128(s);
+            __m128i v1 = _mm_loadu_si128(s + 1);
+            __m128i v2 = _mm_loadu_si128(s + 2);
+            __m128i v3 = _mm_loadu_si128(s + 3);
+
+            _mm_stream_si128(d, v0);
+            _mm_stream_si128(d + 1, v1);
+            _mm_stream_si128(d + 2, v2);
+            _mm_stream_si128(d + 3, v3);
+        }
+
+        for (/**/; bytes >= 16; bytes -= 16, dest += 16, src += 16)
+        {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dest),
+                _mm_loadu_si128(reinterpret_cast<__m128i const*>(src)));
+        }
+
+        std::memcpy(dest, src, bytes);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    HPX_CONSTEXPR inline std::size_t nontemporal_gcd(std::size_t a,
+        std::size_t b)
+    {
+        return b == 0 ? a : nontemporal_gcd(b, a % b);
+    }
+
+    // The smallest number of elements which make up a whole number of
+    // vector registers.
+    template <typename T>
+    struct nontemporal_fill_pattern
+    {
+        static const std::size_t size = 16 / nontemporal_gcd(sizeof(T), 16);
+        static const std::size_t bytes = size * sizeof(T);
+    };
+
+    // Fill the given range using non-temporal stores.
+    template <typename T>
+    void nontemporal_fill_n(T* dest, std::size_t count, T const& value)
+    {
+        typedef nontemporal_fill_pattern<T> pattern_type;
+
+        // store single elements until the destination is properly aligned
+        for (std::size_t i = 0; i != pattern_type::size && count != 0 &&
+                (reinterpret_cast<std::uintptr_t>(dest) & 15) != 0; ++i)
+        {
+            *dest++ = value;
+            --count;
+        }
+
+        if (pattern_type::bytes <= 256 &&
+            (reinterpret_cast<std::uintptr_t>(dest) & 15) == 0)
+        {
+            typename std::aligned_storage<
+                    pattern_type::bytes <= 256 ? pattern_type::bytes : 16, 16
+                >::type storage;
+            char* pattern = reinterpret_cast<char*>(&storage);
+            for (std::size_t i = 0; i != pattern_type::size; ++i)
+                std::memcpy(pattern + i * sizeof(T), &value, sizeof(T));
+
+            for (/**/; count >= pattern_type::size;
+                 count -= pattern_type::size, dest += pattern_type::size)
+            {
+                char* d = reinterpret_cast<char*>(dest);
+                for (std::size_t j = 0; j != pattern_type::bytes; j += 16)
+                {
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(d + j),
+                        _mm_load_si128(
+                            reinterpret_cast<__m128i const*>(pattern + j)));
+                }
+            }
+        }
+
+        std::fill_n(dest, count, value);
+    }
+#endif
+}}}}
+
+#endif
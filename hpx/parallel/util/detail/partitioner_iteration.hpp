@@ -7,7 +7,10 @@
 #define HPX_PARALLEL_UTIL_DETAIL_PARTITIONER_ITERATION
 
 #include <hpx/config.hpp>
+#include <hpx/util/detail/pack.hpp>
+#include <hpx/util/invoke.hpp>
 #include <hpx/util/invoke_fused.hpp>
+#include <hpx/util/tuple.hpp>
 
 #include <cstddef>
 #include <type_traits>
@@ -18,6 +21,28 @@ namespace hpx { namespace parallel { namespace util
 {
     namespace detail
     {
+        // A partition function which can't throw for any of its chunks lets
+        // the partitioners skip all of the exception handling. This is the
+        // case if its call operator is declared noexcept.
+        template <typename F, typename ... Ts>
+        struct is_nothrow_partition
+          : std::integral_constant<bool,
+                noexcept(HPX_INVOKE(
+                    std::declval<typename std::decay<F>::type&>(),
+                    std::declval<Ts>()...))>
+        {};
+
+        template <typename F, typename Tuple, typename Is =
+            typename hpx::util::detail::fused_index_pack<Tuple>::type>
+        struct is_nothrow_partition_fused;
+
+        template <typename F, typename Tuple, std::size_t ... Is>
+        struct is_nothrow_partition_fused<F, Tuple,
+                hpx::util::detail::pack_c<std::size_t, Is...> >
+          : is_nothrow_partition<F,
+                decltype(hpx::util::get<Is>(std::declval<Tuple>()))...>
+        {};
+
         // Hand-crafted function object allowing to replace a more complex
         // bind(functional::invoke_fused(), f1, _1)
         template <typename Result, typename F>
@@ -27,7 +52,9 @@ namespace hpx { namespace parallel { namespace util
 
             template <typename T>
             HPX_HOST_DEVICE HPX_FORCEINLINE
-            Result operator()(T && t)
+            Result operator()(T && t) noexcept(
+                std::is_void<Result>::value &&
+                is_nothrow_partition_fused<F, T&&>::value)
             {
                 return hpx::util::invoke_fused_r<Result>(f_, std::forward<T>(t));
             }
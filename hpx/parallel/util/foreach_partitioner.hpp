@@ -14,10 +14,12 @@
 
 #include <hpx/parallel/algorithms/detail/predicates.hpp>
 #include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/bulk_join_execute.hpp>
 #include <hpx/parallel/executors/execution.hpp>
 #include <hpx/parallel/executors/execution_parameters.hpp>
 #include <hpx/parallel/util/detail/chunk_size.hpp>
 #include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+#include <hpx/parallel/util/detail/lazy_splitting.hpp>
 #include <hpx/parallel/util/detail/partitioner_iteration.hpp>
 #include <hpx/parallel/util/detail/scoped_executor_parameters.hpp>
 #include <hpx/parallel/util/detail/select_partitioner.hpp>
@@ -36,12 +38,23 @@ namespace hpx { namespace parallel { namespace util
 {
     namespace detail
     {
+        // The chunks of a foreach partitioning. Only the chunks which are
+        // run while determining the chunk size or which are created by lazy
+        // splitting are represented by separate futures, all other chunks
+        // are joined in a single future.
+        template <typename Result>
+        struct foreach_partition_items
+        {
+            std::vector<hpx::future<Result>> inititems;
+            std::vector<hpx::future<Result>> workitems;
+            hpx::future<void> joined;
+        };
+
         template <
             typename Result,
             typename ExPolicy, typename FwdIter, typename F>
-        std::pair<std::vector<hpx::future<Result>>, std::vector<hpx::future<Result>>>
-        foreach_partition(
-            ExPolicy && policy,
+        foreach_partition_items<Result> foreach_partition(
+            std::false_type /*has_lazy_splitting*/, ExPolicy && policy,
             FwdIter first, std::size_t count, F && f)
         {
             // estimate a chunk size based on number of cores used
@@ -52,18 +65,55 @@ namespace hpx { namespace parallel { namespace util
                     parameters_type
                 >::type;
 
-            std::vector<hpx::future<Result>> inititems;
+            foreach_partition_items<Result> items;
             auto shape = detail::get_bulk_iteration_shape_idx(
                 has_variable_chunk_size{},
                 std::forward<ExPolicy>(policy),
-                inititems, f, first, count, 1);
-
-            std::vector<hpx::future<Result>> workitems =
-                execution::bulk_async_execute(
-                    policy.executor(),
-                    partitioner_iteration<Result, F>{std::forward<F>(f)},
-                    std::move(shape));
-            return std::make_pair(std::move(inititems), std::move(workitems));
+                items.inititems, f, first, count, 1);
+
+            // the results of the chunks are not needed, join all of them
+            // instead of creating a future for each
+            items.joined = execution::detail::bulk_join_execute(
+                policy.executor(),
+                partitioner_iteration<Result, F>{std::forward<F>(f)},
+                std::move(shape));
+            return items;
+        }
+
+        template <
+            typename Result,
+            typename ExPolicy, typename FwdIter, typename F>
+        foreach_partition_items<Result> foreach_partition(
+            std::true_type /*has_lazy_splitting*/, ExPolicy && policy,
+            FwdIter first, std::size_t count, F && f)
+        {
+            // the tasks are split on demand, no chunks are created up front
+            foreach_partition_items<Result> items;
+            items.workitems = detail::lazy_splitting_partition(
+                std::forward<ExPolicy>(policy), first, count, 1,
+                std::forward<F>(f));
+            return items;
+        }
+
+        template <
+            typename Result,
+            typename ExPolicy, typename FwdIter, typename F>
+        foreach_partition_items<Result> foreach_partition(
+            ExPolicy && policy,
+            FwdIter first, std::size_t count, F && f)
+        {
+            using parameters_type =
+                typename std::decay<ExPolicy>::type::executor_parameters_type;
+            using has_lazy_splitting = std::integral_constant<bool,
+                    execution::extract_has_lazy_splitting<
+                        parameters_type
+                    >::type::value &&
+                    std::is_void<Result>::value
+                >;
+
+            return detail::foreach_partition<Result>(
+                has_lazy_splitting{}, std::forward<ExPolicy>(policy),
+                first, count, std::forward<F>(f));
         }
 
         ///////////////////////////////////////////////////////////////////////
@@ -87,6 +137,22 @@ namespace hpx { namespace parallel { namespace util
             static FwdIter call(
                 ExPolicy_ && policy,
                 FwdIter first, std::size_t count, F1 && f1, F2 && f2)
+            {
+                typedef detail::is_nothrow_partition<
+                        F1, FwdIter, std::size_t, std::size_t
+                    > is_nothrow;
+
+                return call(is_nothrow(), std::forward<ExPolicy_>(policy),
+                    first, count, std::forward<F1>(f1), std::forward<F2>(f2));
+            }
+
+        private:
+            template <
+                typename ExPolicy_,
+                typename FwdIter, typename F1, typename F2>
+            static FwdIter call(std::false_type,
+                ExPolicy_ && policy,
+                FwdIter first, std::size_t count, F1 && f1, F2 && f2)
             {
                 // inform parameter traits
                 scoped_executor_parameters scoped_params(
@@ -94,39 +160,88 @@ namespace hpx { namespace parallel { namespace util
 
                 FwdIter last = parallel::v1::detail::next(first, count);
 
-                std::vector<hpx::future<Result>> inititems, workitems;
+                foreach_partition_items<Result> items;
                 std::list<std::exception_ptr> errors;
                 try
                 {
-                    std::tie(inititems, workitems) =
-                        detail::foreach_partition<Result>(
-                            std::forward<ExPolicy_>(policy),
-                            first, count,
-                            std::forward<F1>(f1));
+                    items = detail::foreach_partition<Result>(
+                        std::forward<ExPolicy_>(policy),
+                        first, count,
+                        std::forward<F1>(f1));
                 } catch (...) {
                     handle_local_exceptions::call(
                         std::current_exception(), errors);
                 }
-                return reduce(
-                    std::move(inititems), std::move(workitems), std::move(errors),
+                return reduce(std::move(items), std::move(errors),
                     std::forward<F2>(f2), std::move(last));
             }
 
-        private:
+            // The chunks can't throw, no exceptions have to be collected. The
+            // joined chunks still hold an exception if scheduling some of
+            // them failed.
+            template <
+                typename ExPolicy_,
+                typename FwdIter, typename F1, typename F2>
+            static FwdIter call(std::true_type,
+                ExPolicy_ && policy,
+                FwdIter first, std::size_t count, F1 && f1, F2 && f2)
+            {
+                // inform parameter traits
+                scoped_executor_parameters scoped_params(
+                    policy.parameters(), policy.executor());
+
+                FwdIter last = parallel::v1::detail::next(first, count);
+
+                foreach_partition_items<Result> items;
+                try
+                {
+                    items = detail::foreach_partition<Result>(
+                        std::forward<ExPolicy_>(policy),
+                        first, count,
+                        std::forward<F1>(f1));
+                } catch (...) {
+                    // rethrow either bad_alloc or exception_list
+                    handle_local_exceptions::call(std::current_exception());
+                }
+
+                // wait for all tasks to finish
+                hpx::wait_all(items.workitems);
+                if (items.joined.valid())
+                {
+                    items.joined.wait();
+                    if (HPX_UNLIKELY(items.joined.has_exception()))
+                    {
+                        return reduce(std::move(items),
+                            std::list<std::exception_ptr>(),
+                            std::forward<F2>(f2), std::move(last));
+                    }
+                }
+
+                try
+                {
+                    return f2(std::move(last));
+                } catch (...) {
+                    // rethrow either bad_alloc or exception_list
+                    handle_local_exceptions::call(std::current_exception());
+                }
+            }
+
             template <typename F, typename FwdIter>
             static FwdIter reduce(
-                std::vector<hpx::future<Result>>&& inititems,
-                std::vector<hpx::future<Result>>&& workitems,
+                foreach_partition_items<Result>&& items,
                 std::list<std::exception_ptr>&& errors,
                 F && f, FwdIter last)
             {
                 // wait for all tasks to finish
-                hpx::wait_all(workitems);
+                hpx::wait_all(items.workitems);
+                if (items.joined.valid())
+                    items.joined.wait();
 
-                // always rethrow if 'errors' is not empty or workitems has
-                // exceptional future
-                handle_local_exceptions::call(inititems, errors);
-                handle_local_exceptions::call(workitems, errors);
+                // always rethrow if 'errors' is not empty or any of the
+                // chunks has exited with an exception
+                handle_local_exceptions::call(items.joined, errors, false);
+                handle_local_exceptions::call(items.inititems, errors);
+                handle_local_exceptions::call(items.workitems, errors);
 
                 try
                 {
@@ -157,6 +272,22 @@ namespace hpx { namespace parallel { namespace util
             static hpx::future<FwdIter> call(
                 ExPolicy_ && policy,
                 FwdIter first, std::size_t count, F1 && f1, F2 && f2)
+            {
+                typedef detail::is_nothrow_partition<
+                        F1, FwdIter, std::size_t, std::size_t
+                    > is_nothrow;
+
+                return call(is_nothrow(), std::forward<ExPolicy_>(policy),
+                    first, count, std::forward<F1>(f1), std::forward<F2>(f2));
+            }
+
+        private:
+            template <
+                typename ExPolicy_,
+                typename FwdIter, typename F1, typename F2>
+            static hpx::future<FwdIter> call(std::false_type,
+                ExPolicy_ && policy,
+                FwdIter first, std::size_t count, F1 && f1, F2 && f2)
             {
                 // inform parameter traits
                 std::shared_ptr<scoped_executor_parameters> scoped_params =
@@ -165,15 +296,14 @@ namespace hpx { namespace parallel { namespace util
 
                 FwdIter last = parallel::v1::detail::next(first, count);
 
-                std::vector<hpx::future<Result>> inititems, workitems;
+                foreach_partition_items<Result> items;
                 std::list<std::exception_ptr> errors;
                 try
                 {
-                    std::tie(inititems, workitems) =
-                        detail::foreach_partition<Result>(
-                            std::forward<ExPolicy_>(policy),
-                            first, count,
-                            std::forward<F1>(f1));
+                    items = detail::foreach_partition<Result>(
+                        std::forward<ExPolicy_>(policy),
+                        first, count,
+                        std::forward<F1>(f1));
                 } catch (std::bad_alloc const&) {
                     return hpx::make_exceptional_future<FwdIter>(
                         std::current_exception());
@@ -182,36 +312,103 @@ namespace hpx { namespace parallel { namespace util
                         std::current_exception(), errors);
                 }
                 return reduce(
-                    std::move(scoped_params),
-                    std::move(inititems), std::move(workitems), std::move(errors),
-                    std::forward<F2>(f2), std::move(last));
+                    std::move(scoped_params), std::move(items),
+                    std::move(errors), std::forward<F2>(f2), std::move(last));
+            }
+
+            // The chunks can't throw, the continuation only has to check the
+            // single future joining the chunks for failures to schedule them.
+            template <
+                typename ExPolicy_,
+                typename FwdIter, typename F1, typename F2>
+            static hpx::future<FwdIter> call(std::true_type,
+                ExPolicy_ && policy,
+                FwdIter first, std::size_t count, F1 && f1, F2 && f2)
+            {
+                // inform parameter traits
+                std::shared_ptr<scoped_executor_parameters> scoped_params =
+                    std::make_shared<scoped_executor_parameters>(
+                        policy.parameters(), policy.executor());
+
+                FwdIter last = parallel::v1::detail::next(first, count);
+
+                foreach_partition_items<Result> items;
+                try
+                {
+                    items = detail::foreach_partition<Result>(
+                        std::forward<ExPolicy_>(policy),
+                        first, count,
+                        std::forward<F1>(f1));
+                } catch (std::bad_alloc const&) {
+                    return hpx::make_exceptional_future<FwdIter>(
+                        std::current_exception());
+                } catch (...) {
+                    std::list<std::exception_ptr> errors;
+                    handle_local_exceptions::call(
+                        std::current_exception(), errors);
+                    return hpx::make_exceptional_future<FwdIter>(
+                        exception_list(std::move(errors)));
+                }
+
+                // the chunks run while determining the chunk size have
+                // already finished, only the chunks created by lazy
+                // splitting are represented by separate futures
+                if (!items.workitems.empty())
+                {
+                    return reduce(
+                        std::move(scoped_params), std::move(items),
+                        std::list<std::exception_ptr>(),
+                        std::forward<F2>(f2), std::move(last));
+                }
+
+                if (!items.joined.valid())
+                    items.joined = hpx::make_ready_future();
+
+                return items.joined.then(hpx::launch::sync,
+                    [last, HPX_CAPTURE_MOVE(scoped_params),
+                        HPX_CAPTURE_FORWARD(f2)
+                    ](hpx::future<void> && r) mutable -> FwdIter
+                    {
+                        HPX_UNUSED(scoped_params);
+
+                        if (HPX_UNLIKELY(r.has_exception()))
+                        {
+                            std::list<std::exception_ptr> errors;
+                            handle_local_exceptions::call(r, errors);
+                        }
+                        return f2(std::move(last));
+                    });
             }
 
-        private:
             template <typename F, typename FwdIter>
             static hpx::future<FwdIter> reduce(
                 std::shared_ptr<scoped_executor_parameters>&& scoped_params,
-                std::vector<hpx::future<Result>>&& inititems,
-                std::vector<hpx::future<Result>>&& workitems,
+                foreach_partition_items<Result>&& items,
                 std::list<std::exception_ptr>&& errors,
                 F && f, FwdIter last)
             {
+                if (!items.joined.valid())
+                    items.joined = hpx::make_ready_future();
+
                 // wait for all tasks to finish
                 return hpx::dataflow(
                     [last, HPX_CAPTURE_MOVE(errors),
                         HPX_CAPTURE_MOVE(scoped_params),
                         HPX_CAPTURE_FORWARD(f)
                     ](std::vector<hpx::future<Result> > && r1,
-                      std::vector<hpx::future<Result> > && r2
+                      std::vector<hpx::future<Result> > && r2,
+                      hpx::future<void> && r3
                     ) mutable ->  FwdIter
                     {
                         HPX_UNUSED(scoped_params);
 
+                        handle_local_exceptions::call(r3, errors, false);
                         handle_local_exceptions::call(r1, errors);
                         handle_local_exceptions::call(r2, errors);
                         return f(std::move(last));
                     },
-                    std::move(inititems), std::move(workitems));
+                    std::move(items.inititems), std::move(items.workitems),
+                    std::move(items.joined));
             }
         };
     }
@@ -0,0 +1,431 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_UTIL_LOOKBACK_SCAN_PARTITIONER_HPP)
+#define HPX_PARALLEL_UTIL_LOOKBACK_SCAN_PARTITIONER_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/exception_list.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/traits/is_callable.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/optional.hpp>
+#include <hpx/util/yield_while.hpp>
+
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/executors/execution_information.hpp>
+#include <hpx/parallel/executors/execution_parameters.hpp>
+#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+#include <hpx/parallel/util/detail/scoped_executor_parameters.hpp>
+#include <hpx/parallel/util/detail/select_partitioner.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace parallel { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // The range is processed in tiles which are small enough to stay in
+        // the cache between computing their aggregate and writing their
+        // final results.
+        static const std::size_t lookback_scan_max_tile_size = 16384ul;
+
+        enum lookback_tile_status
+        {
+            lookback_tile_invalid = 0,
+            lookback_tile_aggregate = 1,    // aggregate_ is valid
+            lookback_tile_prefix = 2,       // aggregate_ and prefix_ are valid
+            lookback_tile_failed = 3
+        };
+
+        template <typename T>
+        struct lookback_tile
+        {
+            lookback_tile()
+              : status_(lookback_tile_invalid)
+            {}
+
+            std::atomic<int> status_;
+            hpx::util::optional<T> aggregate_;
+            hpx::util::optional<T> prefix_;     // inclusive prefix
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Single-pass scan using decoupled look-back (Merrill & Garland).
+        // Each worker task repeatedly grabs the next tile, computes and
+        // publishes its aggregate and then walks back over the preceding
+        // tiles, summing up their aggregates until it finds a tile which has
+        // published its inclusive prefix. The tiles are handed out in order,
+        // which guarantees that all preceding tiles are being processed by
+        // running tasks while waiting for them.
+        template <typename FwdIter, typename T,
+            typename F1, typename Op, typename F3>
+        struct lookback_scan
+        {
+            lookback_scan(std::vector<FwdIter>&& starts, std::size_t count,
+                    std::size_t tile_size, T const& init,
+                    F1& f1, Op& op, F3& f3)
+              : starts_(std::move(starts)), count_(count)
+              , tile_size_(tile_size), init_(init)
+              , f1_(f1), op_(op), f3_(f3)
+              , tiles_(starts_.size())
+              , next_tile_(0), failed_(false)
+            {}
+
+            void run()
+            {
+                std::size_t i = 0;
+                while (!failed_.load(std::memory_order_acquire) &&
+                    (i = next_tile_++) < tiles_.size())
+                {
+                    try {
+                        process(i);
+                    }
+                    catch (...) {
+                        failed_.store(true, std::memory_order_release);
+                        tiles_[i].status_.store(lookback_tile_failed,
+                            std::memory_order_release);
+                        throw;
+                    }
+                }
+            }
+
+            T const& total() const
+            {
+                HPX_ASSERT(tiles_.back().status_ == lookback_tile_prefix);
+                return *tiles_.back().prefix_;
+            }
+
+        private:
+            void process(std::size_t i)
+            {
+                lookback_tile<T>& tile = tiles_[i];
+
+                FwdIter it = starts_[i];
+                std::size_t size = (i + 1 == tiles_.size()) ?
+                    count_ - i * tile_size_ : tile_size_;
+
+                tile.aggregate_.emplace(hpx::util::invoke(f1_, it, size));
+
+                if (i == 0)
+                {
+                    tile.prefix_.emplace(
+                        hpx::util::invoke(op_, init_, *tile.aggregate_));
+                    tile.status_.store(lookback_tile_prefix,
+                        std::memory_order_release);
+
+                    finish(it, size, init_, *tile.aggregate_);
+                    return;
+                }
+
+                tile.status_.store(lookback_tile_aggregate,
+                    std::memory_order_release);
+
+                // look back until a tile with a known prefix is found
+                hpx::util::optional<T> exclusive;
+                for (std::size_t j = i; j-- != 0; /**/)
+                {
+                    lookback_tile<T> const& prev = tiles_[j];
+
+                    int status = lookback_tile_invalid;
+                    hpx::util::yield_while(
+                        [&]() -> bool
+                        {
+                            status = prev.status_.load(
+                                std::memory_order_acquire);
+                            return status == lookback_tile_invalid;
+                        });
+
+                    if (status == lookback_tile_failed)
+                    {
+                        // the exception is reported by the failing tile
+                        tile.status_.store(lookback_tile_failed,
+                            std::memory_order_release);
+                        return;
+                    }
+
+                    T const& value = (status == lookback_tile_prefix) ?
+                        *prev.prefix_ : *prev.aggregate_;
+
+                    if (exclusive)
+                        exclusive.emplace(
+                            hpx::util::invoke(op_, value, *exclusive));
+                    else
+                        exclusive.emplace(value);
+
+                    if (status == lookback_tile_prefix)
+                        break;
+                }
+                HPX_ASSERT(exclusive);
+
+                // successors may stop looking back at this tile now
+                tile.prefix_.emplace(
+                    hpx::util::invoke(op_, *exclusive, *tile.aggregate_));
+                tile.status_.store(lookback_tile_prefix,
+                    std::memory_order_release);
+
+                finish(it, size, *exclusive, *tile.aggregate_);
+            }
+
+            // f3 may additionally receive the aggregate of the tile, which
+            // allows to hand state from f1 to f3
+            void finish(FwdIter it, std::size_t size, T const& prefix,
+                T const& aggregate)
+            {
+                finish(it, size, prefix, aggregate,
+                    hpx::traits::is_invocable<F3&, FwdIter, std::size_t,
+                        T const&, T const&>());
+            }
+
+            void finish(FwdIter it, std::size_t size, T const& prefix,
+                T const& aggregate, std::true_type)
+            {
+                hpx::util::invoke(f3_, it, size, prefix, aggregate);
+            }
+
+            void finish(FwdIter it, std::size_t size, T const& prefix,
+                T const&, std::false_type)
+            {
+                hpx::util::invoke(f3_, it, size, prefix);
+            }
+
+            std::vector<FwdIter> starts_;
+            std::size_t count_;
+            std::size_t tile_size_;
+            T init_;
+
+            F1& f1_;
+            Op& op_;
+            F3& f3_;
+
+            std::vector<lookback_tile<T> > tiles_;
+            std::atomic<std::size_t> next_tile_;
+            std::atomic<bool> failed_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename ExPolicy, typename R, typename T>
+        struct lookback_scan_static_partitioner
+        {
+            using parameters_type = typename ExPolicy::executor_parameters_type;
+            using executor_type = typename ExPolicy::executor_type;
+
+            using scoped_executor_parameters =
+                detail::scoped_executor_parameters_ref<
+                    parameters_type, executor_type>;
+
+            using handle_local_exceptions = detail::handle_local_exceptions<ExPolicy>;
+
+            template <
+                typename ExPolicy_,
+                typename FwdIter, typename T_,
+                typename F1, typename Op, typename F3, typename F4>
+            static R call(
+                ExPolicy_ && policy,
+                FwdIter first, std::size_t count, T_ && init,
+                F1 && f1, Op && op, F3 && f3, F4 && f4)
+            {
+                HPX_ASSERT(count > 0);
+
+                // inform parameter traits
+                scoped_executor_parameters scoped_param(
+                    policy.parameters(), policy.executor());
+
+                typedef lookback_scan<
+                        FwdIter, T,
+                        typename std::decay<F1>::type,
+                        typename std::decay<Op>::type,
+                        typename std::decay<F3>::type
+                    > scan_type;
+
+                typename std::decay<F1>::type f1_(std::forward<F1>(f1));
+                typename std::decay<Op>::type op_(std::forward<Op>(op));
+                typename std::decay<F3>::type f3_(std::forward<F3>(f3));
+
+                std::size_t const cores = execution::processing_units_count(
+                    policy.executor(), policy.parameters());
+
+                std::size_t tile_size = execution::get_chunk_size(
+                    policy.parameters(), policy.executor(), [](){ return 0; },
+                    cores, count);
+                tile_size = (std::max)(std::size_t(1),
+                    (std::min)(tile_size, lookback_scan_max_tile_size));
+
+                std::size_t num_tiles = (count + tile_size - 1) / tile_size;
+
+                std::vector<FwdIter> starts;
+                starts.reserve(num_tiles);
+                for (std::size_t remaining = count; remaining != 0; /**/)
+                {
+                    std::size_t chunk = (std::min)(tile_size, remaining);
+                    starts.push_back(first);
+
+                    // modifies 'chunk'
+                    first = parallel::v1::detail::next(first, remaining, chunk);
+                    remaining -= chunk;
+                }
+                HPX_ASSERT(starts.size() == num_tiles);
+
+                scan_type scan(std::move(starts), count, tile_size, init,
+                    f1_, op_, f3_);
+
+                std::vector<hpx::future<void> > workitems;
+                std::list<std::exception_ptr> errors;
+                try
+                {
+                    std::size_t num_tasks = (std::min)(cores, num_tiles);
+                    workitems.reserve(num_tasks);
+
+                    for (std::size_t i = 0; i != num_tasks; ++i)
+                    {
+                        workitems.push_back(execution::async_execute(
+                            policy.executor(),
+                            [&scan]() { scan.run(); }));
+                    }
+                } catch (...) {
+                    handle_local_exceptions::call(
+                        std::current_exception(), errors);
+                }
+
+                // wait for all tasks to finish
+                hpx::wait_all(workitems);
+
+                // always rethrow if 'errors' is not empty or 'workitems' has
+                // an exceptional future
+                handle_local_exceptions::call(workitems, errors);
+
+                try
+                {
+                    return f4(scan.total());
+                } catch (...) {
+                    // rethrow either bad_alloc or exception_list
+                    handle_local_exceptions::call(std::current_exception());
+                }
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename ExPolicy, typename R, typename T>
+        struct lookback_scan_task_static_partitioner
+        {
+            template <
+                typename ExPolicy_,
+                typename FwdIter, typename T_,
+                typename F1, typename Op, typename F3, typename F4>
+            static hpx::future<R> call(
+                ExPolicy_ && policy,
+                FwdIter first, std::size_t count, T_ && init,
+                F1 && f1, Op && op, F3 && f3, F4 && f4)
+            {
+                return execution::async_execute(
+                    policy.executor(),
+                    [first, count,
+                        HPX_CAPTURE_FORWARD(policy),
+                        HPX_CAPTURE_FORWARD(init),
+                        HPX_CAPTURE_FORWARD(f1),
+                        HPX_CAPTURE_FORWARD(op),
+                        HPX_CAPTURE_FORWARD(f3),
+                        HPX_CAPTURE_FORWARD(f4)
+                    ]() mutable -> R
+                    {
+                        using partitioner_type =
+                            lookback_scan_static_partitioner<ExPolicy, R, T>;
+                        return partitioner_type::call(
+                            std::forward<ExPolicy_>(policy),
+                            first, count, std::move(init),
+                            f1, op, f3, f4);
+                    });
+            }
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A pool of buffers of one tile each, used by algorithms which have to
+    // keep per element state between f1 and f3 of a tile (see
+    // lookback_scan_partitioner). Only the tiles being processed hold a
+    // buffer, so the memory needed depends on the number of tasks processing
+    // the tiles and not on the number of elements.
+    template <typename T>
+    class lookback_tile_buffers
+    {
+        typedef hpx::lcos::local::spinlock mutex_type;
+
+    public:
+        // count is the number of elements of the whole range
+        explicit lookback_tile_buffers(std::size_t count)
+          : size_((std::min)(count, detail::lookback_scan_max_tile_size))
+        {}
+
+        T* acquire()
+        {
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (!free_.empty())
+                {
+                    T* buffer = free_.back();
+                    free_.pop_back();
+                    return buffer;
+                }
+            }
+
+            std::unique_ptr<T[]> buffer(new T[size_]);
+
+            std::lock_guard<mutex_type> l(mtx_);
+            free_.reserve(buffers_.size() + 1);
+            buffers_.push_back(std::move(buffer));
+            return buffers_.back().get();
+        }
+
+        void release(T* buffer)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            free_.push_back(buffer);
+        }
+
+    private:
+        mutex_type mtx_;
+        std::size_t size_;
+        std::vector<T*> free_;
+        std::vector<std::unique_ptr<T[]> > buffers_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // ExPolicy:    execution policy
+    // R:           overall result type
+    // T:           type of the partial sums
+    //
+    // f1(first, count) -> T computes the aggregate of a tile, op(T, T) -> T
+    // combines aggregates, f3(first, count, T) writes the final results of a
+    // tile given the sum of all preceding elements (including init), and
+    // f4(T) -> R receives the overall sum. f3(first, count, T, T) is called
+    // with the aggregate of the tile as the last argument if possible. f1
+    // and f3 of a tile are invoked one after the other by the same task.
+    template <typename ExPolicy, typename R, typename T>
+    struct lookback_scan_partitioner
+      : detail::select_partitioner<
+            typename std::decay<ExPolicy>::type,
+            detail::lookback_scan_static_partitioner,
+            detail::lookback_scan_task_static_partitioner
+        >::template apply<R, T>
+    {};
+}}}
+
+#endif
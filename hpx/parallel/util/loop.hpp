@@ -12,6 +12,7 @@
 #endif
 #include <hpx/parallel/util/cancellation_token.hpp>
 #include <hpx/parallel/util/projection_identity.hpp>
+#include <hpx/runtime/threads/detail/time_slice.hpp>
 #include <hpx/traits/is_execution_policy.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/invoke.hpp>
@@ -52,6 +53,19 @@ namespace hpx { namespace parallel { namespace util
     ///////////////////////////////////////////////////////////////////////////
     namespace detail
     {
+        ///////////////////////////////////////////////////////////////////////
+        // Let the scheduler preempt a long running loop if its thread pool
+        // uses time slicing. The loops call this once every
+        // preemption_poll_interval iterations.
+        HPX_HOST_DEVICE HPX_FORCEINLINE void preemption_point()
+        {
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+            hpx::threads::detail::yield_if_time_slice_expired();
+#endif
+        }
+
+        using hpx::threads::detail::preemption_poll_interval;
+
         ///////////////////////////////////////////////////////////////////////
         // Helper class to repeatedly call a function starting from a given
         // iterator position.
@@ -63,9 +77,16 @@ namespace hpx { namespace parallel { namespace util
             HPX_HOST_DEVICE HPX_FORCEINLINE
             static Begin call(Begin it, End end, F && f)
             {
+                std::size_t count = preemption_poll_interval;
                 for (/**/; it != end; ++it)
+                {
+                    if (--count == 0)
+                    {
+                        preemption_point();
+                        count = preemption_poll_interval;
+                    }
                     f(it);
-
+                }
                 return it;
             }
 
@@ -74,10 +95,16 @@ namespace hpx { namespace parallel { namespace util
             HPX_HOST_DEVICE HPX_FORCEINLINE
             static Begin call(Begin it, End end, CancelToken& tok, F && f)
             {
-                for (/**/; it != end; ++it)
+                std::size_t count = 0;
+                for (/**/; it != end; (void) ++it, --count)
                 {
-                    if (tok.was_cancelled())
-                        break;
+                    if (count == 0)
+                    {
+                        if (tok.was_cancelled())
+                            break;
+                        preemption_point();
+                        count = cancellation_poll_interval;
+                    }
                     f(it);
                 }
                 return it;
@@ -136,6 +163,42 @@ namespace hpx { namespace parallel { namespace util
             std::forward<F>(f));
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Return the first position in [first, last) for which f returns true,
+    // or last if there is no such position.
+    template <typename ExPolicy, typename Iter, typename F>
+    HPX_HOST_DEVICE HPX_FORCEINLINE
+    typename std::enable_if<
+       !execution::is_vectorpack_execution_policy<ExPolicy>::value, Iter
+    >::type
+    find_first(Iter first, Iter last, F && f)
+    {
+        for (/**/; first != last; ++first)
+        {
+            if (f(first))
+                break;
+        }
+        return first;
+    }
+
+    // Return the first pair of positions in [first1, last1) and the sequence
+    // starting at first2 for which f returns true.
+    template <typename ExPolicy, typename Iter1, typename Iter2, typename F>
+    HPX_HOST_DEVICE HPX_FORCEINLINE
+    typename std::enable_if<
+       !execution::is_vectorpack_execution_policy<ExPolicy>::value,
+        std::pair<Iter1, Iter2>
+    >::type
+    find_first2(Iter1 first1, Iter1 last1, Iter2 first2, F && f)
+    {
+        for (/**/; first1 != last1; (void) ++first1, ++first2)
+        {
+            if (f(first1, first2))
+                break;
+        }
+        return std::make_pair(std::move(first1), std::move(first2));
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     namespace detail
     {
@@ -149,22 +212,38 @@ namespace hpx { namespace parallel { namespace util
             // handle sequences of non-futures
             template <typename Iter, typename F>
             HPX_HOST_DEVICE HPX_FORCEINLINE
-            static Iter call(Iter it, std::size_t count, F && f)
+            static Iter call_block(Iter it, std::size_t count, F && f)
             {
                 for (/**/; count != 0; (void) --count, ++it)
                     f(it);
                 return it;
             }
 
+            template <typename Iter, typename F>
+            HPX_HOST_DEVICE HPX_FORCEINLINE
+            static Iter call(Iter it, std::size_t count, F && f)
+            {
+                while (count > preemption_poll_interval)
+                {
+                    it = call_block(it, preemption_poll_interval, f);
+                    count -= preemption_poll_interval;
+                    preemption_point();
+                }
+                return call_block(it, count, f);
+            }
+
             template <typename Iter, typename CancelToken, typename F>
             HPX_HOST_DEVICE HPX_FORCEINLINE
             static Iter call(Iter it, std::size_t count, CancelToken& tok, F && f)
             {
-                for (/**/; count != 0; (void) --count, ++it)
+                while (count != 0 && !tok.was_cancelled())
                 {
-                    if (tok.was_cancelled())
-                        break;
-                    f(it);
+                    std::size_t n = count < cancellation_poll_interval ?
+                        count : cancellation_poll_interval;
+
+                    it = call_block(it, n, f);
+                    count -= n;
+                    preemption_point();
                 }
                 return it;
             }
@@ -469,7 +548,7 @@ namespace hpx { namespace parallel { namespace util
             // handle sequences of non-futures
             template <typename Iter, typename F>
             static Iter
-            call(std::size_t base_idx, Iter it, std::size_t count, F && f)
+            call_block(std::size_t base_idx, Iter it, std::size_t count, F && f)
             {
                 for (/**/; count != 0; (void) --count, ++it, ++base_idx)
                     f(*it, base_idx);
@@ -477,16 +556,33 @@ namespace hpx { namespace parallel { namespace util
                 return it;
             }
 
+            template <typename Iter, typename F>
+            static Iter
+            call(std::size_t base_idx, Iter it, std::size_t count, F && f)
+            {
+                while (count > preemption_poll_interval)
+                {
+                    it = call_block(base_idx, it, preemption_poll_interval, f);
+                    count -= preemption_poll_interval;
+                    base_idx += preemption_poll_interval;
+                    preemption_point();
+                }
+                return call_block(base_idx, it, count, f);
+            }
+
             template <typename Iter, typename CancelToken, typename F>
             static Iter
             call(std::size_t base_idx, Iter it, std::size_t count,
                 CancelToken& tok, F && f)
             {
-                for (/**/; count != 0; (void) --count, ++it, ++base_idx)
+                while (count != 0 && !tok.was_cancelled(base_idx))
                 {
-                    if (tok.was_cancelled(base_idx))
-                        break;
-                    f(*it, base_idx);
+                    std::size_t n = (std::min)(count, cancellation_poll_interval);
+
+                    it = call_block(base_idx, it, n, f);
+                    count -= n;
+                    base_idx += n;
+                    preemption_point();
                 }
                 return it;
             }
@@ -541,6 +637,41 @@ namespace hpx { namespace parallel { namespace util
             std::forward<Pred>(f));
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Combine init with conv(*it) for all elements using r. For vector-pack
+    // execution policies the elements are reduced in any order.
+    template <typename ExPolicy, typename Iter, typename T, typename Reduce,
+        typename Conv>
+    HPX_HOST_DEVICE HPX_FORCEINLINE
+    typename std::enable_if<
+       !execution::is_vectorpack_execution_policy<ExPolicy>::value, T
+    >::type
+    transform_accumulate_n(Iter it, std::size_t count, T init, Reduce && r,
+        Conv && conv)
+    {
+        for (/**/; count != 0; (void) --count, ++it)
+        {
+            init = hpx::util::invoke(r, init, hpx::util::invoke(conv, *it));
+        }
+        return init;
+    }
+
+    template <typename ExPolicy, typename Begin, typename End, typename T,
+        typename Reduce, typename Conv>
+    HPX_HOST_DEVICE HPX_FORCEINLINE
+    typename std::enable_if<
+       !execution::is_vectorpack_execution_policy<ExPolicy>::value, T
+    >::type
+    transform_accumulate(Begin first, End last, T init, Reduce && r,
+        Conv && conv)
+    {
+        for (/**/; first != last; ++first)
+        {
+            init = hpx::util::invoke(r, init, hpx::util::invoke(conv, *first));
+        }
+        return init;
+    }
+
     template <typename T, typename Iter, typename Reduce,
         typename Conv = util::projection_identity>
     HPX_FORCEINLINE T
@@ -20,6 +20,7 @@
 #include <hpx/parallel/executors/execution_parameters.hpp>
 #include <hpx/parallel/util/detail/chunk_size.hpp>
 #include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+#include <hpx/parallel/util/detail/lazy_splitting.hpp>
 #include <hpx/parallel/util/detail/partitioner_iteration.hpp>
 #include <hpx/parallel/util/detail/scoped_executor_parameters.hpp>
 #include <hpx/parallel/util/detail/select_partitioner.hpp>
@@ -80,7 +81,7 @@ namespace hpx { namespace parallel { namespace util
             typename Result,
             typename ExPolicy, typename FwdIter, typename Stride, typename F>
         std::vector<hpx::future<Result>> partition_with_index(
-            ExPolicy && policy,
+            std::false_type /*has_lazy_splitting*/, ExPolicy && policy,
             FwdIter first, std::size_t count, Stride stride, F && f)
         {
             // estimate a chunk size based on number of cores used
@@ -113,6 +114,40 @@ namespace hpx { namespace parallel { namespace util
             return inititems;
         }
 
+        template <
+            typename Result,
+            typename ExPolicy, typename FwdIter, typename Stride, typename F>
+        std::vector<hpx::future<Result>> partition_with_index(
+            std::true_type /*has_lazy_splitting*/, ExPolicy && policy,
+            FwdIter first, std::size_t count, Stride stride, F && f)
+        {
+            // the tasks are split on demand, no chunks are created up front
+            return detail::lazy_splitting_partition(
+                std::forward<ExPolicy>(policy), first, count, stride,
+                std::forward<F>(f));
+        }
+
+        template <
+            typename Result,
+            typename ExPolicy, typename FwdIter, typename Stride, typename F>
+        std::vector<hpx::future<Result>> partition_with_index(
+            ExPolicy && policy,
+            FwdIter first, std::size_t count, Stride stride, F && f)
+        {
+            using parameters_type =
+                typename std::decay<ExPolicy>::type::executor_parameters_type;
+            using has_lazy_splitting = std::integral_constant<bool,
+                    execution::extract_has_lazy_splitting<
+                        parameters_type
+                    >::type::value &&
+                    std::is_void<Result>::value
+                >;
+
+            return detail::partition_with_index<Result>(
+                has_lazy_splitting{}, std::forward<ExPolicy>(policy),
+                first, count, stride, std::forward<F>(f));
+        }
+
         template <
             typename Result,
             typename ExPolicy, typename FwdIter, typename Data, typename F>
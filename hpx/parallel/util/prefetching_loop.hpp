@@ -0,0 +1,228 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_UTIL_PREFETCHING_LOOP_HPP)
+#define HPX_PARALLEL_UTIL_PREFETCHING_LOOP_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/traits/is_execution_policy.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/tuple.hpp>
+
+#include <hpx/parallel/executors/execution_parameters.hpp>
+#include <hpx/parallel/executors/prefetch_distance.hpp>
+#include <hpx/parallel/util/loop.hpp>
+#include <hpx/parallel/util/transform_loop.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace parallel { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // The vectorized loops don't prefetch.
+        template <typename ExPolicy, typename Enable = void>
+        struct prefetcher_type
+        {
+            typedef typename hpx::util::decay<
+                    decltype(execution::get_prefetcher(
+                        std::declval<ExPolicy&>().parameters(),
+                        std::declval<ExPolicy&>().executor()))
+                >::type type;
+        };
+
+        template <typename ExPolicy>
+        struct prefetcher_type<ExPolicy,
+            typename std::enable_if<
+                execution::is_vectorpack_execution_policy<ExPolicy>::value
+            >::type>
+        {
+            typedef execution::detail::no_prefetcher type;
+        };
+
+        template <typename ExPolicy>
+        HPX_FORCEINLINE execution::detail::no_prefetcher
+        get_prefetcher(ExPolicy &, std::true_type)
+        {
+            return execution::detail::no_prefetcher();
+        }
+
+        template <typename ExPolicy>
+        HPX_FORCEINLINE typename prefetcher_type<
+            typename hpx::util::decay<ExPolicy>::type
+        >::type
+        get_prefetcher(ExPolicy & policy, std::false_type)
+        {
+            return execution::get_prefetcher(
+                policy.parameters(), policy.executor());
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Invoke f for the count iterations starting at it, each one
+        // prefetching the data for the iteration which is
+        // prefetcher.distance() iterations ahead.
+        template <typename Iter, typename Prefetcher, typename F>
+        HPX_FORCEINLINE Iter
+        prefetching_loop_n(Iter it, std::size_t count,
+            Prefetcher const& prefetcher, F && f)
+        {
+            std::size_t distance = prefetcher.distance();
+            if (distance != 0 && distance < count)
+            {
+                Iter ahead = std::next(it, distance);
+                for (std::size_t n = count - distance; n != 0;
+                     (void) --n, ++it, ++ahead)
+                {
+                    prefetcher(ahead);
+                    f(it);
+                }
+                count = distance;
+            }
+
+            for (/**/; count != 0; (void) --count, ++it)
+            {
+                f(it);
+            }
+            return it;
+        }
+    }
+
+    // Return the prefetcher requested by the executor parameters of the
+    // given execution policy.
+    template <typename ExPolicy>
+    HPX_FORCEINLINE
+    typename detail::prefetcher_type<
+        typename hpx::util::decay<ExPolicy>::type
+    >::type
+    get_prefetcher(ExPolicy && policy)
+    {
+        typedef typename execution::is_vectorpack_execution_policy<
+                ExPolicy
+            >::type is_vectorpack;
+        return detail::get_prefetcher(policy, is_vectorpack());
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename ExPolicy, typename Iter, typename F>
+    HPX_HOST_DEVICE HPX_FORCEINLINE Iter
+    loop_n_prefetch(Iter it, std::size_t count,
+        execution::detail::no_prefetcher const&, F && f)
+    {
+        return util::loop_n<ExPolicy>(it, count, std::forward<F>(f));
+    }
+
+    template <typename ExPolicy, typename Iter, typename Prefetcher,
+        typename F>
+    HPX_FORCEINLINE Iter
+    loop_n_prefetch(Iter it, std::size_t count, Prefetcher const& prefetcher,
+        F && f)
+    {
+        return detail::prefetching_loop_n(it, count, prefetcher,
+            [&f](Iter curr) -> void
+            {
+                hpx::util::invoke(f, curr);
+            });
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename ExPolicy, typename Iter, typename OutIter, typename F>
+    HPX_HOST_DEVICE HPX_FORCEINLINE std::pair<Iter, OutIter>
+    transform_loop_n_prefetch(Iter it, std::size_t count, OutIter dest,
+        execution::detail::no_prefetcher const&, F && f)
+    {
+        return util::transform_loop_n<ExPolicy>(it, count, dest,
+            std::forward<F>(f));
+    }
+
+    template <typename ExPolicy, typename Iter, typename OutIter,
+        typename Prefetcher, typename F>
+    HPX_FORCEINLINE std::pair<Iter, OutIter>
+    transform_loop_n_prefetch(Iter it, std::size_t count, OutIter dest,
+        Prefetcher const& prefetcher, F && f)
+    {
+        it = detail::prefetching_loop_n(it, count, prefetcher,
+            [&f, &dest](Iter curr) -> void
+            {
+                *dest = hpx::util::invoke(f, curr);
+                ++dest;
+            });
+        return std::make_pair(std::move(it), std::move(dest));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename ExPolicy, typename InIter1, typename InIter2,
+        typename OutIter, typename F>
+    HPX_HOST_DEVICE HPX_FORCEINLINE hpx::util::tuple<InIter1, InIter2, OutIter>
+    transform_binary_loop_n_prefetch(InIter1 first1, std::size_t count,
+        InIter2 first2, OutIter dest, execution::detail::no_prefetcher const&,
+        F && f)
+    {
+        return util::transform_binary_loop_n<ExPolicy>(first1, count, first2,
+            dest, std::forward<F>(f));
+    }
+
+    // both input sequences are prefetched
+    template <typename ExPolicy, typename InIter1, typename InIter2,
+        typename OutIter, typename Prefetcher, typename F>
+    HPX_FORCEINLINE hpx::util::tuple<InIter1, InIter2, OutIter>
+    transform_binary_loop_n_prefetch(InIter1 first1, std::size_t count,
+        InIter2 first2, OutIter dest, Prefetcher const& prefetcher, F && f)
+    {
+        std::size_t distance = prefetcher.distance();
+        if (distance != 0 && distance < count)
+        {
+            InIter1 ahead1 = std::next(first1, distance);
+            InIter2 ahead2 = std::next(first2, distance);
+            for (std::size_t n = count - distance; n != 0;
+                 (void) --n, ++first1, ++first2, ++dest, ++ahead1, ++ahead2)
+            {
+                prefetcher(ahead1);
+                prefetcher(ahead2);
+                *dest = hpx::util::invoke(f, first1, first2);
+            }
+            count = distance;
+        }
+
+        for (/**/; count != 0; (void) --count, ++first1, ++first2, ++dest)
+        {
+            *dest = hpx::util::invoke(f, first1, first2);
+        }
+        return hpx::util::make_tuple(std::move(first1), std::move(first2),
+            std::move(dest));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename ExPolicy, typename Iter, typename T, typename Reduce,
+        typename Conv>
+    HPX_HOST_DEVICE HPX_FORCEINLINE T
+    transform_accumulate_n_prefetch(Iter it, std::size_t count, T init,
+        execution::detail::no_prefetcher const&, Reduce && r, Conv && conv)
+    {
+        return util::transform_accumulate_n<ExPolicy>(it, count,
+            std::move(init), std::forward<Reduce>(r), std::forward<Conv>(conv));
+    }
+
+    template <typename ExPolicy, typename Iter, typename T, typename Reduce,
+        typename Conv, typename Prefetcher>
+    HPX_FORCEINLINE T
+    transform_accumulate_n_prefetch(Iter it, std::size_t count, T init,
+        Prefetcher const& prefetcher, Reduce && r, Conv && conv)
+    {
+        detail::prefetching_loop_n(it, count, prefetcher,
+            [&](Iter curr) -> void
+            {
+                init = hpx::util::invoke(r, init,
+                    hpx::util::invoke(conv, *curr));
+            });
+        return init;
+    }
+}}}
+
+#endif
@@ -17,7 +17,7 @@ namespace hpx { namespace parallel { namespace util
     {
         template <typename T>
         HPX_HOST_DEVICE HPX_FORCEINLINE
-        T && operator()(T && val) const
+        T && operator()(T && val) const noexcept
         {
             return std::forward<T>(val);
         }
@@ -10,6 +10,8 @@
 #include <hpx/traits/pointer_category.hpp>
 #include <hpx/util/decay.hpp>
 
+#include <hpx/parallel/util/detail/nontemporal_store.hpp>
+
 #include <algorithm>
 #include <cstddef>
 #include <cstring> // for std::memmove
@@ -268,6 +270,136 @@ namespace hpx { namespace parallel { namespace util
             category;
         return detail::move_n_helper<category>::call(first, count, dest);
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The nontemporal variants below write the destination using non-temporal
+    // stores where this is possible and fall back to their plain counterparts
+    // otherwise. The algorithms use those for large ranges only (see
+    // detail::use_nontemporal_stores), as the written data would have been
+    // evicted from the caches before being accessed again anyway.
+    namespace detail
+    {
+        template <typename Category, typename Enable = void>
+        struct copy_n_nontemporal_helper
+        {
+            template <typename InIter, typename OutIter>
+            HPX_HOST_DEVICE HPX_FORCEINLINE static std::pair<InIter, OutIter>
+            call(InIter first, std::size_t count, OutIter dest)
+            {
+                return copy_n_helper<Category>::call(first, count, dest);
+            }
+        };
+
+#if defined(HPX_PARALLEL_HAVE_NONTEMPORAL_STORES)
+        template <typename Dummy>
+        struct copy_n_nontemporal_helper<
+            hpx::traits::trivially_copyable_pointer_tag, Dummy>
+        {
+            template <typename InIter, typename OutIter>
+            static std::pair<InIter, OutIter>
+            call(InIter first, std::size_t count, OutIter dest)
+            {
+                typedef typename std::iterator_traits<InIter>::value_type
+                    data_type;
+
+                const char* const first_ch = reinterpret_cast<const char*>(first);
+                char* const dest_ch = reinterpret_cast<char*>(dest);
+                std::size_t const bytes = count * sizeof(data_type);
+
+                // overlapping ranges are left to std::memmove
+                if (first_ch < dest_ch + bytes && dest_ch < first_ch + bytes)
+                    return copy_memmove(first, count, dest);
+
+                nontemporal_copy_bytes(dest_ch, first_ch, bytes);
+                nontemporal_store_fence();
+
+                std::advance(first, count);
+                std::advance(dest, count);
+                return std::make_pair(first, dest);
+            }
+        };
+#endif
+
+        template <typename Category, typename Enable = void>
+        struct move_n_nontemporal_helper
+        {
+            template <typename InIter, typename OutIter>
+            HPX_FORCEINLINE static std::pair<InIter, OutIter>
+            call(InIter first, std::size_t count, OutIter dest)
+            {
+                return move_n_helper<Category>::call(first, count, dest);
+            }
+        };
+
+#if defined(HPX_PARALLEL_HAVE_NONTEMPORAL_STORES)
+        template <typename Dummy>
+        struct move_n_nontemporal_helper<
+                hpx::traits::trivially_copyable_pointer_tag, Dummy>
+          : copy_n_nontemporal_helper<
+                hpx::traits::trivially_copyable_pointer_tag, Dummy>
+        {};
+#endif
+
+        template <typename Iter, typename T>
+        HPX_FORCEINLINE Iter
+        fill_n_nontemporal(Iter dest, std::size_t count, T const& value,
+            std::false_type)
+        {
+            return std::fill_n(dest, count, value);
+        }
+
+#if defined(HPX_PARALLEL_HAVE_NONTEMPORAL_STORES)
+        template <typename T, typename U>
+        T* fill_n_nontemporal(T* dest, std::size_t count, U const& value,
+            std::true_type)
+        {
+            nontemporal_fill_n(dest, count, T(value));
+            nontemporal_store_fence();
+            return dest + count;
+        }
+#endif
+    }
+
+    template <typename InIter, typename OutIter>
+    HPX_HOST_DEVICE HPX_FORCEINLINE std::pair<InIter, OutIter>
+    copy_n_nontemporal(InIter first, std::size_t count, OutIter dest)
+    {
+        typedef
+            typename hpx::traits::pointer_category<
+                typename hpx::util::decay<
+                    typename hpx::traits::remove_const_iterator_value_type<
+                        InIter
+                    >::type>::type,
+                typename hpx::util::decay<OutIter>::type
+            >::type
+            category;
+        return detail::copy_n_nontemporal_helper<category>::call(
+            first, count, dest);
+    }
+
+    template <typename InIter, typename OutIter>
+    HPX_FORCEINLINE std::pair<InIter, OutIter>
+    move_n_nontemporal(InIter first, std::size_t count, OutIter dest)
+    {
+        typedef
+            typename hpx::traits::pointer_category<
+                typename hpx::util::decay<InIter>::type,
+                typename hpx::util::decay<OutIter>::type
+            >::type
+            category;
+        return detail::move_n_nontemporal_helper<category>::call(
+            first, count, dest);
+    }
+
+    template <typename Iter, typename T>
+    HPX_FORCEINLINE Iter
+    fill_n_nontemporal(Iter dest, std::size_t count, T const& value)
+    {
+        typedef typename detail::supports_nontemporal_stores<
+                typename hpx::util::decay<Iter>::type
+            >::type category;
+        return detail::fill_n_nontemporal(dest, count, value, category());
+    }
 }}}
 
 #endif
@@ -8,6 +8,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/parallel/util/cancellation_token.hpp>
+#include <hpx/parallel/util/detail/nontemporal_store.hpp>
 #include <hpx/traits/is_execution_policy.hpp>
 #include <hpx/util/invoke.hpp>
 #include <hpx/util/tuple.hpp>
@@ -15,6 +16,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <iterator>
+#include <new>
 #include <type_traits>
 #include <utility>
 
@@ -183,6 +185,136 @@ namespace hpx { namespace parallel { namespace util
         return detail::transform_binary_loop_n<InIter1, InIter2>::call(
             first1, count, first2, dest, std::forward<F>(f));
     }
+    ///////////////////////////////////////////////////////////////////////////
+    // The nontemporal variants of transform_loop_n and transform_binary_loop_n
+    // collect the results in small, cache resident blocks which are written
+    // to the destination using non-temporal stores.
+    namespace detail
+    {
+        template <typename T>
+        struct nontemporal_transform_block
+        {
+            static const std::size_t size =
+                sizeof(T) < 1024 ? 1024 / sizeof(T) : 1;
+            static const std::size_t alignment =
+                std::alignment_of<T>::value < 16 ?
+                    16 : std::alignment_of<T>::value;
+
+            typedef typename std::aligned_storage<
+                    size * sizeof(T), alignment
+                >::type type;
+        };
+
+        template <typename Iter, typename OutIter, typename F>
+        HPX_HOST_DEVICE HPX_FORCEINLINE
+        std::pair<Iter, OutIter>
+        transform_loop_n_nontemporal(Iter first, std::size_t count,
+            OutIter dest, F && f, std::false_type)
+        {
+            return transform_loop_n<Iter>::call(first, count, dest,
+                std::forward<F>(f));
+        }
+
+#if defined(HPX_PARALLEL_HAVE_NONTEMPORAL_STORES)
+        template <typename Iter, typename T, typename F>
+        std::pair<Iter, T*>
+        transform_loop_n_nontemporal(Iter first, std::size_t count,
+            T* dest, F && f, std::true_type)
+        {
+            typedef nontemporal_transform_block<T> block_type;
+
+            typename block_type::type storage;
+            T* block = reinterpret_cast<T*>(&storage);
+
+            while (count != 0)
+            {
+                std::size_t size = (std::min)(count, block_type::size);
+                for (std::size_t i = 0; i != size; (void) ++i, ++first)
+                {
+                    ::new (block + i) T(hpx::util::invoke(f, first));
+                }
+
+                nontemporal_copy_bytes(reinterpret_cast<char*>(dest),
+                    reinterpret_cast<char const*>(block), size * sizeof(T));
+
+                dest += size;
+                count -= size;
+            }
+
+            nontemporal_store_fence();
+            return std::make_pair(std::move(first), dest);
+        }
+#endif
+
+        template <typename Iter1, typename Iter2, typename OutIter, typename F>
+        HPX_HOST_DEVICE HPX_FORCEINLINE
+        hpx::util::tuple<Iter1, Iter2, OutIter>
+        transform_binary_loop_n_nontemporal(Iter1 first1, std::size_t count,
+            Iter2 first2, OutIter dest, F && f, std::false_type)
+        {
+            return transform_binary_loop_n<Iter1, Iter2>::call(
+                first1, count, first2, dest, std::forward<F>(f));
+        }
+
+#if defined(HPX_PARALLEL_HAVE_NONTEMPORAL_STORES)
+        template <typename Iter1, typename Iter2, typename T, typename F>
+        hpx::util::tuple<Iter1, Iter2, T*>
+        transform_binary_loop_n_nontemporal(Iter1 first1, std::size_t count,
+            Iter2 first2, T* dest, F && f, std::true_type)
+        {
+            typedef nontemporal_transform_block<T> block_type;
+
+            typename block_type::type storage;
+            T* block = reinterpret_cast<T*>(&storage);
+
+            while (count != 0)
+            {
+                std::size_t size = (std::min)(count, block_type::size);
+                for (std::size_t i = 0; i != size;
+                    (void) ++i, ++first1, ++first2)
+                {
+                    ::new (block + i) T(hpx::util::invoke(f, first1, first2));
+                }
+
+                nontemporal_copy_bytes(reinterpret_cast<char*>(dest),
+                    reinterpret_cast<char const*>(block), size * sizeof(T));
+
+                dest += size;
+                count -= size;
+            }
+
+            nontemporal_store_fence();
+            return hpx::util::make_tuple(std::move(first1), std::move(first2),
+                dest);
+        }
+#endif
+    }
+
+    template <typename Iter, typename OutIter, typename F>
+    HPX_HOST_DEVICE HPX_FORCEINLINE
+    std::pair<Iter, OutIter>
+    transform_loop_n_nontemporal(Iter it, std::size_t count, OutIter dest,
+        F && f)
+    {
+        typedef typename detail::supports_nontemporal_stores<
+                OutIter
+            >::type category;
+        return detail::transform_loop_n_nontemporal(it, count, dest,
+            std::forward<F>(f), category());
+    }
+
+    template <typename InIter1, typename InIter2, typename OutIter, typename F>
+    HPX_HOST_DEVICE HPX_FORCEINLINE
+    hpx::util::tuple<InIter1, InIter2, OutIter>
+    transform_binary_loop_n_nontemporal(InIter1 first1, std::size_t count,
+        InIter2 first2, OutIter dest, F && f)
+    {
+        typedef typename detail::supports_nontemporal_stores<
+                OutIter
+            >::type category;
+        return detail::transform_binary_loop_n_nontemporal(first1, count,
+            first2, dest, std::forward<F>(f), category());
+    }
 }}}
 
 #if defined(HPX_HAVE_DATAPAR)
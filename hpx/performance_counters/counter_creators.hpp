@@ -10,9 +10,19 @@
 #include <hpx/exception_fwd.hpp>
 #include <hpx/performance_counters/counters_fwd.hpp>
 #include <hpx/util/function.hpp>
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+#include <hpx/runtime/actions/detail/action_latency_registry.hpp>
+#endif
+#if defined(HPX_HAVE_LOCK_PROFILING)
+#include <hpx/util/lock_profiler.hpp>
+#endif
+#if defined(HPX_HAVE_ALLOCATION_ACCOUNTING)
+#include <hpx/util/allocation_accounting.hpp>
+#endif
 
 #include <cstdint>
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -149,6 +159,19 @@ namespace hpx { namespace performance_counters
         counter_info const&, discover_counter_func const&,
         discover_counters_mode, error_code&);
 
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+    ///////////////////////////////////////////////////////////////////////////
+    // Creation function for action latency counters
+    HPX_API_EXPORT naming::gid_type action_latency_counter_creator(
+        counter_info const& info,
+        hpx::actions::detail::action_latency_type type, error_code& ec);
+
+    // Discoverer function for action latency counters
+    HPX_API_EXPORT bool action_latency_counter_discoverer(
+        counter_info const& info, discover_counter_func const& f,
+        discover_counters_mode mode, error_code& ec);
+#endif
+
 #if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
     ///////////////////////////////////////////////////////////////////////////
     // Creation function for per-action parcel data counters
@@ -164,6 +187,54 @@ namespace hpx { namespace performance_counters
         counter_info const& info, discover_counter_func const& f,
         discover_counters_mode mode, error_code& ec);
 #endif
+
+#if defined(HPX_HAVE_TASK_HARDWARE_COUNTERS)
+    ///////////////////////////////////////////////////////////////////////////
+    // Creation function for the hardware event counters attributed to HPX
+    // thread descriptions, the event is given as its index (see
+    // util::task_counters::get_task_event_count)
+    HPX_API_EXPORT naming::gid_type task_event_counter_creator(
+        counter_info const& info, std::size_t event, error_code& ec);
+
+    // Discoverer function for the hardware event counters attributed to HPX
+    // thread descriptions
+    HPX_API_EXPORT bool task_event_counter_discoverer(
+        counter_info const& info, discover_counter_func const& f,
+        discover_counters_mode mode, error_code& ec);
+#endif
+
+#if defined(HPX_HAVE_LOCK_PROFILING)
+    ///////////////////////////////////////////////////////////////////////////
+    // Creation function for the lock contention counters, reporting the given
+    // statistic for the call sites of the locks
+    HPX_API_EXPORT naming::gid_type lock_contention_counter_creator(
+        counter_info const& info, util::lock_profiling::statistic stat,
+        error_code& ec);
+
+    // Discoverer function for the lock contention counters
+    HPX_API_EXPORT bool lock_contention_counter_discoverer(
+        counter_info const& info, discover_counter_func const& f,
+        discover_counters_mode mode, error_code& ec);
+#endif
+
+#if defined(HPX_HAVE_ALLOCATION_ACCOUNTING)
+    ///////////////////////////////////////////////////////////////////////////
+    // Creation function for the allocation accounting counters, reporting the
+    // given statistic for the subsystem given as the counter parameter
+    HPX_API_EXPORT naming::gid_type allocation_counter_creator(
+        counter_info const& info, util::allocation_accounting::statistic stat,
+        error_code& ec);
+
+    // Creation function for the counter reporting the number of allocations
+    // per second of a subsystem since the counter was evaluated last
+    HPX_API_EXPORT naming::gid_type allocation_rate_counter_creator(
+        counter_info const& info, error_code& ec);
+
+    // Discoverer function for the allocation accounting counters
+    HPX_API_EXPORT bool allocation_counter_discoverer(
+        counter_info const& info, discover_counter_func const& f,
+        discover_counters_mode mode, error_code& ec);
+#endif
 }}
 
 #endif
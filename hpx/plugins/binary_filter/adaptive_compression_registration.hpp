@@ -0,0 +1,153 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_ACTION_ADAPTIVE_COMPRESSION_REGISTRATION_HPP)
+#define HPX_ACTION_ADAPTIVE_COMPRESSION_REGISTRATION_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime_fwd.hpp>
+#include <hpx/traits/action_serialization_filter.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace plugins { namespace compression
+{
+    // Keeps track of the compression ratio reached for the messages of one
+    // action. Compressing is worthwhile only if the data shrinks enough to
+    // make up for the time spent compressing it. Once the measured ratio is
+    // worse than the configured one, messages are sent uncompressed, every
+    // probe_interval-th message is still compressed to notice changes in
+    // the nature of the data.
+    class compression_statistics
+    {
+    public:
+        HPX_STATIC_CONSTEXPR std::uint64_t probe_interval = 64;
+
+        // the weight of older messages is halved after this many bytes
+        HPX_STATIC_CONSTEXPR std::uint64_t decay_bytes = std::uint64_t(1) << 30;
+
+        compression_statistics()
+          : uncompressed_bytes_(0), compressed_bytes_(0)
+          , num_compressed_(0), num_skipped_(0)
+        {}
+
+        // Return whether the next message should be compressed
+        bool use_compression(double max_ratio)
+        {
+            std::uint64_t uncompressed =
+                uncompressed_bytes_.load(std::memory_order_relaxed);
+            std::uint64_t compressed =
+                compressed_bytes_.load(std::memory_order_relaxed);
+
+            if (double(compressed) <= max_ratio * double(uncompressed) ||
+                (num_compressed_ + num_skipped_) % probe_interval == 0)
+            {
+                ++num_compressed_;
+                return true;
+            }
+
+            ++num_skipped_;
+            return false;
+        }
+
+        // Account for a message which was compressed
+        void record(std::size_t uncompressed_size, std::size_t compressed_size)
+        {
+            std::uint64_t uncompressed =
+                uncompressed_bytes_.fetch_add(uncompressed_size,
+                    std::memory_order_relaxed) + uncompressed_size;
+            compressed_bytes_.fetch_add(compressed_size,
+                std::memory_order_relaxed);
+
+            if (uncompressed > decay_bytes)
+            {
+                // not exact if other messages are recorded concurrently,
+                // which does not matter for an estimate
+                uncompressed_bytes_.store(uncompressed / 2,
+                    std::memory_order_relaxed);
+                compressed_bytes_.store(
+                    compressed_bytes_.load(std::memory_order_relaxed) / 2,
+                    std::memory_order_relaxed);
+            }
+        }
+
+        std::uint64_t uncompressed_bytes() const
+        {
+            return uncompressed_bytes_.load(std::memory_order_relaxed);
+        }
+        std::uint64_t compressed_bytes() const
+        {
+            return compressed_bytes_.load(std::memory_order_relaxed);
+        }
+        std::uint64_t num_compressed() const
+        {
+            return num_compressed_.load(std::memory_order_relaxed);
+        }
+        std::uint64_t num_skipped() const
+        {
+            return num_skipped_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<std::uint64_t> uncompressed_bytes_;
+        std::atomic<std::uint64_t> compressed_bytes_;
+        std::atomic<std::uint64_t> num_compressed_;
+        std::atomic<std::uint64_t> num_skipped_;
+    };
+
+    // The largest ratio of compressed to uncompressed size for which
+    // compressing the messages is worthwhile
+    inline double get_max_compression_ratio()
+    {
+        static double const max_ratio = std::stod(
+            hpx::get_config_entry("hpx.parcel.compression_max_ratio", "0.8"));
+        return max_ratio;
+    }
+}}}
+
+///////////////////////////////////////////////////////////////////////////////
+// Compress the parcels of the given action with the given filter (for instance
+// "lz4_serialization_filter") only as long as this pays off.
+#define HPX_ACTION_USES_ADAPTIVE_COMPRESSION(action, filter)                  \
+    namespace hpx { namespace traits                                          \
+    {                                                                         \
+        template <>                                                           \
+        struct action_serialization_filter< action>                           \
+        {                                                                     \
+            static hpx::plugins::compression::compression_statistics&         \
+                statistics()                                                  \
+            {                                                                 \
+                static hpx::plugins::compression::compression_statistics s;   \
+                return s;                                                     \
+            }                                                                 \
+                                                                              \
+            /* Note that the caller is responsible for deleting the filter */ \
+            /* instance returned from this function */                        \
+            static serialization::binary_filter* call(                        \
+                    parcelset::parcel const& p)                               \
+            {                                                                 \
+                if (!statistics().use_compression(hpx::plugins::compression:: \
+                        get_max_compression_ratio()))                         \
+                {                                                             \
+                    return nullptr;                                           \
+                }                                                             \
+                return hpx::create_binary_filter(filter, true);               \
+            }                                                                 \
+                                                                              \
+            static void record(std::size_t uncompressed_size,                 \
+                std::size_t compressed_size)                                  \
+            {                                                                 \
+                statistics().record(uncompressed_size, compressed_size);      \
+            }                                                                 \
+        };                                                                    \
+    }}                                                                        \
+/**/
+
+#endif
@@ -0,0 +1,69 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_ACTION_ZSTD_SERIALIZATION_FILTER_HPP)
+#define HPX_ACTION_ZSTD_SERIALIZATION_FILTER_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/plugins/binary_filter/zstd_serialization_filter_registration.hpp>
+
+#if defined(HPX_HAVE_COMPRESSION_ZSTD)
+
+#include <hpx/runtime/serialization/binary_filter.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace plugins { namespace compression
+{
+    // The data is compressed while it is being serialized, only the
+    // compressed data is kept in memory.
+    struct HPX_LIBRARY_EXPORT zstd_serialization_filter
+      : public serialization::binary_filter
+    {
+        zstd_serialization_filter(bool compress = false,
+            serialization::binary_filter* next_filter = nullptr);
+        ~zstd_serialization_filter();
+
+        void load(void* dst, std::size_t dst_count);
+        void save(void const* src, std::size_t src_count);
+        bool flush(void* dst, std::size_t dst_count, std::size_t& written);
+
+        void set_max_length(std::size_t size);
+        std::size_t init_data(char const* buffer,
+            std::size_t size, std::size_t buffer_size);
+
+    private:
+        // serialization support
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        HPX_FORCEINLINE void serialize(Archive& ar, const unsigned int) {}
+
+        HPX_SERIALIZATION_POLYMORPHIC(zstd_serialization_filter);
+
+        void compress_block(bool finish);
+
+        struct stream;
+        std::unique_ptr<stream> stream_;
+
+        // the data not compressed yet (while saving), or the decompressed
+        // data (while loading)
+        std::vector<char> buffer_;
+        std::vector<char> compressed_;
+        std::size_t current_;
+        bool compress_;
+        bool finished_;
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
+#endif
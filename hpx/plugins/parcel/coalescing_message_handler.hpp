@@ -78,12 +78,26 @@ namespace hpx { namespace plugins { namespace parcel
 
         void update_num_messages();
         void update_interval();
+        void update_target_latency();
+
+        void adapt_locked();
 
     private:
         mutable mutex_type mtx_;
         parcelset::parcelport* pp_;
         std::size_t num_coalesced_parcels_;
         std::size_t interval_;
+
+        // the configured settings, the number of messages is the upper bound
+        // if the parameters are adapted at runtime
+        std::size_t max_coalesced_parcels_;
+        std::size_t max_interval_;
+
+        // adapt the parameters to not exceed the given latency [us], if
+        // non-zero
+        std::size_t target_latency_;
+        double avg_time_between_parcels_;   // [ns]
+
         detail::message_buffer buffer_;
         util::pool_timer timer_;
         bool stopped_;
@@ -16,6 +16,7 @@
 #include <hpx/runtime/parcelset/parcel_buffer.hpp>
 #include <hpx/util/assert.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -40,8 +41,21 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
 
         static int const data_size_ = 512;
 
+        // values of the piggy back flag
+        enum piggy_back_mode
+        {
+            piggy_back_none = 0,    // data is sent separately
+            piggy_back_all = 1,     // data follows the header
+            piggy_back_eager = 2,   // the complete message follows the header
+            piggy_back_mask = 3,
+
+            // the addresses of zero-copy chunks to be pulled by the receiver
+            // are sent after the transmission chunks
+            rma_addresses = 4
+        };
+
         template <typename Buffer>
-        header(Buffer const & buffer, int tag)
+        header(Buffer const & buffer, int tag, bool eager = false)
         {
             std::int64_t size = static_cast<std::int64_t>(buffer.size_);
             std::int64_t numbytes = static_cast<std::int64_t>(buffer.data_size_);
@@ -56,18 +70,33 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
             set<pos_numchunks_second>(static_cast<value_type>
                 (buffer.num_chunks_.second));
 
-            if(buffer.data_.size() <= (data_size_ - pos_piggy_back_data))
+            if(eager)
+            {
+                // the sender appends the transmission chunks, the data and
+                // the zero-copy chunks to this header (see eager())
+                data_[pos_piggy_back_flag] = piggy_back_eager;
+            }
+            else if(buffer.data_.size() <= (data_size_ - pos_piggy_back_data))
             {
-                data_[pos_piggy_back_flag] = 1;
+                data_[pos_piggy_back_flag] = piggy_back_all;
                 std::memcpy(&data_[pos_piggy_back_data], &buffer.data_[0],
                     buffer.data_.size());
             }
             else
             {
-                data_[pos_piggy_back_flag] = 0;
+                data_[pos_piggy_back_flag] = piggy_back_none;
             }
         }
 
+        // construct from a received message, which may be shorter or longer
+        // than the header itself
+        header(char const* data, std::size_t size)
+        {
+            reset();
+            std::memcpy(&data_[0], data,
+                (std::min)(size, static_cast<std::size_t>(data_size_)));
+        }
+
         header()
         {
             reset();
@@ -121,11 +150,31 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
 
         char * piggy_back()
         {
-            if(data_[pos_piggy_back_flag])
+            if((data_[pos_piggy_back_flag] & piggy_back_mask) == piggy_back_all)
                 return &data_[pos_piggy_back_data];
             return nullptr;
         }
 
+        void set_rma()
+        {
+            data_[pos_piggy_back_flag] |= rma_addresses;
+        }
+
+        bool rma() const
+        {
+            return (data_[pos_piggy_back_flag] & rma_addresses) != 0;
+        }
+
+        // An eager message consists of the first pos_piggy_back_data bytes
+        // of the header followed by the transmission chunks (if there are
+        // zero-copy chunks), the data and the zero-copy chunks, it doesn't
+        // need a tag.
+        bool eager() const
+        {
+            return (data_[pos_piggy_back_flag] & piggy_back_mask) ==
+                piggy_back_eager;
+        }
+
     private:
         std::array<char, data_size_> data_;
 
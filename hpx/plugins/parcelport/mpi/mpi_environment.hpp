@@ -14,8 +14,10 @@
 #include <hpx/plugins/parcelport/mpi/mpi.hpp>
 #include <hpx/util_fwd.hpp>
 
+#include <cstddef>
 #include <cstdlib>
 #include <string>
+#include <vector>
 
 #include <hpx/config/warnings_prefix.hpp>
 
@@ -35,6 +37,20 @@ namespace hpx { namespace util
 
         static MPI_Comm& communicator();
 
+        // The parcelport may spread its messages over several duplicates of
+        // the communicator (hpx.parcel.mpi.communicators), which allows MPI
+        // implementations to progress them independently (for instance
+        // using separate virtual communication interfaces). Communicator 0
+        // is the one returned by communicator().
+        static std::size_t num_communicators();
+        static MPI_Comm& communicator(std::size_t i);
+
+        // Zero-copy chunks of at least hpx.parcel.mpi.rma_threshold bytes
+        // are exposed in a dynamic window of their communicator and pulled
+        // by the receiver, rma_window returns nullptr if this is disabled.
+        static std::size_t rma_threshold();
+        static MPI_Win* rma_window(std::size_t i);
+
         static std::string get_processor_name();
 
         static bool check_mpi_environment(runtime_configuration const& cfg);
@@ -68,6 +84,9 @@ namespace hpx { namespace util
         static bool has_called_init_;
         static int provided_threading_flag_;
         static MPI_Comm communicator_;
+        static std::vector<MPI_Comm> communicators_;
+        static std::size_t rma_threshold_;
+        static std::vector<MPI_Win> rma_windows_;
     };
 }}
 
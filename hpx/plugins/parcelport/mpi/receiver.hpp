@@ -15,8 +15,12 @@
 #include <hpx/plugins/parcelport/mpi/header.hpp>
 #include <hpx/plugins/parcelport/mpi/receiver_connection.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/runtime_configuration.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <deque>
 #include <iterator>
 #include <list>
@@ -24,6 +28,7 @@
 #include <mutex>
 #include <set>
 #include <utility>
+#include <vector>
 
 namespace hpx { namespace parcelset { namespace policies { namespace mpi
 {
@@ -39,20 +44,42 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
         typedef std::shared_ptr<connection_type> connection_ptr;
         typedef std::deque<connection_ptr> connection_list;
 
-        receiver(Parcelport & pp)
+        receiver(Parcelport & pp, util::runtime_configuration const& ini)
           : pp_(pp)
-        {}
+          , next_channel_(0)
+        {
+            // the receive buffers have to hold the largest eager message
+            std::size_t receive_size = (std::max)(
+                util::get_entry_as<std::size_t>(
+                    ini, "hpx.parcel.mpi.eager_threshold", 8192),
+                static_cast<std::size_t>(header::data_size_));
+            std::size_t num_receives = (std::max)(
+                util::get_entry_as<std::size_t>(
+                    ini, "hpx.parcel.mpi.eager_receives", 4),
+                std::size_t(1));
+
+            std::size_t num_channels =
+                util::mpi_environment::num_communicators();
+
+            channels_.reserve(num_channels);
+            for (std::size_t i = 0; i != num_channels; ++i)
+            {
+                channels_.emplace_back(
+                    new header_channel(i, num_receives, receive_size));
+            }
+        }
 
         void run()
         {
             util::mpi_environment::scoped_lock l;
-            new_header();
+            for (std::unique_ptr<header_channel> const& channel : channels_)
+                channel->start();
         }
 
-        bool background_work()
+        bool background_work(std::size_t num_thread = std::size_t(-1))
         {
             // We first try to accept a new connection
-            connection_ptr connection = accept();
+            connection_ptr connection = accept(num_thread);
 
             // If we don't have a new connection, try to handle one of the
             // already accepted ones.
@@ -84,80 +111,129 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
             }
         }
 
-        connection_ptr accept()
+        // Worker threads look for new messages on the communicator assigned
+        // to them first, the others are visited round robin to make sure all
+        // of them make progress regardless of the number of workers.
+        connection_ptr accept(std::size_t num_thread = std::size_t(-1))
         {
-            std::unique_lock<mutex_type> l(headers_mtx_, std::try_to_lock);
-            if(l)
-                return accept_locked(l);
-            return connection_ptr();
-        }
+            std::size_t num_channels = channels_.size();
 
-        connection_ptr accept_locked(std::unique_lock<mutex_type> & header_lock)
-        {
             connection_ptr res;
-            util::mpi_environment::scoped_try_lock l;
+            if (num_thread != std::size_t(-1))
+            {
+                res = channels_[num_thread % num_channels]->accept(pp_);
+                if (res || num_channels == 1)
+                    return res;
+            }
 
-            if(l.locked)
+            return channels_[next_channel_++ % num_channels]->accept(pp_);
+        }
+
+    private:
+        // The pool of persistent receives for the headers (and the eager
+        // messages) sent through one communicator
+        struct header_channel
+        {
+            header_channel(std::size_t comm, std::size_t num_receives,
+                    std::size_t receive_size)
+              : comm_(comm)
+              , buffers_(num_receives, std::vector<char>(receive_size))
+              , requests_(num_receives, MPI_REQUEST_NULL)
+            {}
+
+            void start()
             {
-                MPI_Status status;
-                if(request_done_locked(hdr_request_, &status))
+                for (std::size_t i = 0; i != requests_.size(); ++i)
                 {
-                    header h = new_header();
-                    l.unlock();
-                    header_lock.unlock();
-                    res.reset(
-                        new connection_type(
-                            status.MPI_SOURCE
-                          , h
-                          , pp_
-                        )
+                    MPI_Recv_init(
+                        buffers_[i].data()
+                      , static_cast<int>(buffers_[i].size())
+                      , MPI_BYTE
+                      , MPI_ANY_SOURCE
+                      , 0
+                      , util::mpi_environment::communicator(comm_)
+                      , &requests_[i]
                     );
-                    return res;
+                    MPI_Start(&requests_[i]);
                 }
             }
-            return res;
-        }
 
-        header new_header()
-        {
-            header h = rcv_header_;
-            rcv_header_.reset();
-            MPI_Irecv(
-                rcv_header_.data()
-              , rcv_header_.data_size_
-              , MPI_BYTE
-              , MPI_ANY_SOURCE
-              , 0
-              , util::mpi_environment::communicator()
-              , &hdr_request_
-            );
-            return h;
-        }
+            connection_ptr accept(Parcelport & pp)
+            {
+                std::unique_lock<mutex_type> l(headers_mtx_, std::try_to_lock);
+                if(l)
+                    return accept_locked(l, pp);
+                return connection_ptr();
+            }
+
+            connection_ptr accept_locked(
+                std::unique_lock<mutex_type> & header_lock, Parcelport & pp)
+            {
+                connection_ptr res;
+                util::mpi_environment::scoped_try_lock l;
+
+                if(l.locked)
+                {
+                    MPI_Status status;
+                    int index = MPI_UNDEFINED;
+                    if(request_done_locked(index, &status))
+                    {
+                        int count = 0;
+                        MPI_Get_count(&status, MPI_BYTE, &count);
+
+                        // the connection copies what it needs, the buffer
+                        // is reused right away
+                        std::vector<char> const& buffer = buffers_[index];
+                        header h(buffer.data(), static_cast<std::size_t>(count));
+                        res.reset(
+                            new connection_type(
+                                status.MPI_SOURCE
+                              , h
+                              , pp
+                              , comm_
+                              , buffer.data()
+                              , static_cast<std::size_t>(count)
+                            )
+                        );
+
+                        MPI_Start(&requests_[index]);
+                        return res;
+                    }
+                }
+                return res;
+            }
+
+            bool request_done_locked(int& index, MPI_Status *status)
+            {
+                int completed = 0;
+                int ret = 0;
+                ret = MPI_Testany(static_cast<int>(requests_.size()),
+                    requests_.data(), &index, &completed, status);
+                HPX_ASSERT(ret == MPI_SUCCESS);
+                if(completed && index != MPI_UNDEFINED)
+                {
+                    return true;
+                }
+                return false;
+            }
+
+            std::size_t const comm_;
+
+            mutex_type headers_mtx_;
+            std::vector<std::vector<char> > buffers_;
+            std::vector<MPI_Request> requests_;
+        };
 
         Parcelport & pp_;
 
-        mutex_type headers_mtx_;
-        MPI_Request hdr_request_;
-        header rcv_header_;
+        std::vector<std::unique_ptr<header_channel> > channels_;
+        std::atomic<std::size_t> next_channel_;
 
         mutex_type handles_header_mtx_;
         handles_header_type handles_header_;
 
         mutex_type connections_mtx_;
         connection_list connections_;
-
-        bool request_done_locked(MPI_Request & r, MPI_Status *status)
-        {
-            int completed = 0;
-            int ret = 0;
-            ret = MPI_Test(&r, &completed, status);
-            HPX_ASSERT(ret == MPI_SUCCESS);
-            if(completed)
-            {
-                return true;
-            }
-            return false;
-        }
     };
 
 }}}}
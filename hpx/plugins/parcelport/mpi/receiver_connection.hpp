@@ -31,6 +31,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
         {
             initialized
           , rcvd_transmission_chunks
+          , rcvd_rma_addresses
           , rcvd_data
           , rcvd_chunks
           , sent_release_tag
@@ -47,10 +48,14 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
             int src
           , header h
           , Parcelport & pp
+          , std::size_t comm = 0
+          , char const* eager_data = nullptr
+          , std::size_t eager_size = 0
         )
           : state_(initialized)
           , src_(src)
           , tag_(h.tag())
+          , comm_(comm)
           , header_(h)
           , request_(MPI_REQUEST_NULL)
           , request_ptr_(nullptr)
@@ -65,6 +70,56 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
 
             buffer_.data_.resize(static_cast<std::size_t>(header_.size()));
             buffer_.num_chunks_ = header_.num_chunks();
+
+            if(header_.eager())
+                unpack_eager(eager_data, eager_size);
+        }
+
+        // Copy the message out of the receive buffer it arrived in, as the
+        // buffer is reused for the next message right away.
+        void unpack_eager(char const* data, std::size_t size)
+        {
+            HPX_ASSERT(data != nullptr);
+            HPX_ASSERT(size >= std::size_t(header::pos_piggy_back_data));
+
+            char const* p = data + header::pos_piggy_back_data;
+
+            std::size_t num_zero_copy_chunks =
+                static_cast<std::size_t>(
+                    static_cast<std::uint32_t>(buffer_.num_chunks_.first));
+            std::size_t num_non_zero_copy_chunks =
+                static_cast<std::size_t>(
+                    static_cast<std::uint32_t>(buffer_.num_chunks_.second));
+
+            if(num_zero_copy_chunks != 0)
+            {
+                buffer_.transmission_chunks_.resize(
+                    num_zero_copy_chunks + num_non_zero_copy_chunks);
+
+                std::size_t chunks_size = buffer_.transmission_chunks_.size() *
+                    sizeof(buffer_type::transmission_chunk_type);
+                std::memcpy(buffer_.transmission_chunks_.data(), p,
+                    chunks_size);
+                p += chunks_size;
+            }
+
+            if(!buffer_.data_.empty())
+            {
+                std::memcpy(buffer_.data_.data(), p, buffer_.data_.size());
+                p += buffer_.data_.size();
+            }
+
+            buffer_.chunks_.resize(num_zero_copy_chunks);
+            for(std::size_t idx = 0; idx != num_zero_copy_chunks; ++idx)
+            {
+                std::size_t chunk_size =
+                    buffer_.transmission_chunks_[idx].second;
+                buffer_.chunks_[idx].assign(p, p + chunk_size);
+                p += chunk_size;
+            }
+
+            HPX_ASSERT(p == data + size);
+            (void)size;
         }
 
         bool receive(std::size_t num_thread = -1)
@@ -72,8 +127,12 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
             switch (state_)
             {
                 case initialized:
+                    if(header_.eager())
+                        return receive_eager(num_thread);
                     return receive_transmission_chunks(num_thread);
                 case rcvd_transmission_chunks:
+                    return receive_rma_addresses(num_thread);
+                case rcvd_rma_addresses:
                     return receive_data(num_thread);
                 case rcvd_data:
                     return receive_chunks(num_thread);
@@ -87,6 +146,20 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
             return false;
         }
 
+        // eager messages have been received completely and don't use a tag
+        // which would have to be released
+        bool receive_eager(std::size_t num_thread = -1)
+        {
+            performance_counters::parcels::data_point& data = buffer_.data_point_;
+            data.time_ = timer_.elapsed_nanoseconds() - data.time_;
+
+            decode_parcels(pp_, std::move(buffer_), num_thread);
+
+            state_ = sent_release_tag;
+
+            return done();
+        }
+
         bool receive_transmission_chunks(std::size_t num_thread = -1)
         {
             // determine the size of the chunk buffer
@@ -113,7 +186,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
                       , MPI_BYTE
                       , src_
                       , tag_
-                      , util::mpi_environment::communicator()
+                      , util::mpi_environment::communicator(comm_)
                       , &request_
                     );
                     request_ptr_ = &request_;
@@ -122,6 +195,35 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
 
             state_ = rcvd_transmission_chunks;
 
+            return receive_rma_addresses(num_thread);
+        }
+
+        // the addresses of the zero-copy chunks to pull from the sender
+        bool receive_rma_addresses(std::size_t num_thread = -1)
+        {
+            if(!request_done()) return false;
+
+            if(header_.rma())
+            {
+                rma_addresses_.resize(buffer_.chunks_.size());
+                {
+                    util::mpi_environment::scoped_lock l;
+                    MPI_Irecv(
+                        rma_addresses_.data()
+                      , static_cast<int>(
+                            rma_addresses_.size() * sizeof(MPI_Aint))
+                      , MPI_BYTE
+                      , src_
+                      , tag_
+                      , util::mpi_environment::communicator(comm_)
+                      , &request_
+                    );
+                    request_ptr_ = &request_;
+                }
+            }
+
+            state_ = rcvd_rma_addresses;
+
             return receive_data(num_thread);
         }
 
@@ -143,7 +245,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
                   , MPI_BYTE
                   , src_
                   , tag_
-                  , util::mpi_environment::communicator()
+                  , util::mpi_environment::communicator(comm_)
                   , &request_
                 );
                 request_ptr_ = &request_;
@@ -165,6 +267,28 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
 
                 data_type & c = buffer_.chunks_[idx];
                 c.resize(chunk_size);
+
+                if(!rma_addresses_.empty() && rma_addresses_[idx] != 0)
+                {
+                    // pull the chunk exposed by the sender
+                    MPI_Win* win = util::mpi_environment::rma_window(comm_);
+                    HPX_ASSERT(win != nullptr);
+
+                    util::mpi_environment::scoped_lock l;
+                    MPI_Rget(
+                        c.data()
+                      , static_cast<int>(c.size())
+                      , MPI_BYTE
+                      , src_
+                      , rma_addresses_[idx]
+                      , static_cast<int>(c.size())
+                      , MPI_BYTE
+                      , *win
+                      , &request_
+                    );
+                    request_ptr_ = &request_;
+                }
+                else
                 {
                     util::mpi_environment::scoped_lock l;
                     MPI_Irecv(
@@ -173,7 +297,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
                       , MPI_BYTE
                       , src_
                       , tag_
-                      , util::mpi_environment::communicator()
+                      , util::mpi_environment::communicator(comm_)
                       , &request_
                     );
                     request_ptr_ = &request_;
@@ -200,7 +324,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
                   , MPI_INT
                   , src_
                   , 1
-                  , util::mpi_environment::communicator()
+                  , util::mpi_environment::communicator(comm_)
                   , &request_
                 );
                 request_ptr_ = &request_;
@@ -244,12 +368,14 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
 
         int src_;
         int tag_;
+        std::size_t comm_;      // communicator the message is received from
         header header_;
         buffer_type buffer_;
 
         MPI_Request request_;
         MPI_Request *request_ptr_;
         std::size_t chunks_idx_;
+        std::vector<MPI_Aint> rma_addresses_;   // 0 if sent two-sided
 
         Parcelport & pp_;
     };
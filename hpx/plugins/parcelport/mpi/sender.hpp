@@ -12,18 +12,26 @@
 #if defined(HPX_HAVE_PARCELPORT_MPI)
 
 #include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/runtime_configuration.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
 
 #include <hpx/plugins/parcelport/mpi/mpi_environment.hpp>
 #include <hpx/plugins/parcelport/mpi/sender_connection.hpp>
 #include <hpx/plugins/parcelport/mpi/tag_provider.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
 #include <iterator>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <utility>
+#include <vector>
 
 namespace hpx { namespace parcelset { namespace policies { namespace mpi
 {
@@ -37,14 +45,23 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
 
         typedef hpx::lcos::local::spinlock mutex_type;
 
-        sender()
-          : next_free_tag_(-1)
+        explicit sender(util::runtime_configuration const& ini)
+          : eager_threshold_(util::get_entry_as<std::size_t>(
+                ini, "hpx.parcel.mpi.eager_threshold", 8192))
+          , next_channel_(0)
         {
+            std::size_t num_channels =
+                util::mpi_environment::num_communicators();
+
+            channels_.reserve(num_channels);
+            for (std::size_t i = 0; i != num_channels; ++i)
+                channels_.emplace_back(new tag_channel(i));
         }
 
         void run()
         {
-            get_next_free_tag();
+            for (std::unique_ptr<tag_channel> const& channel : channels_)
+                channel->get_next_free_tag();
         }
 
         connection_ptr create_connection(int dest, parcelset::parcelport* pp)
@@ -58,9 +75,40 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
             connections_.push_back(ptr);
         }
 
-        int acquire_tag()
+        // Messages sent from a worker thread go through the communicator
+        // assigned to it
+        std::size_t select_communicator() const
+        {
+            std::size_t num_thread = hpx::get_worker_thread_num();
+            if (num_thread == std::size_t(-1))
+                num_thread = 0;
+            return num_thread % channels_.size();
+        }
+
+        // messages up to this size (including the header) are sent at once
+        std::size_t eager_threshold() const
+        {
+            return eager_threshold_;
+        }
+
+        int acquire_tag(std::size_t comm)
+        {
+            HPX_ASSERT(comm < channels_.size());
+            return channels_[comm]->tag_provider_.acquire();
+        }
+
+        // Messages whose chunks are pulled by the receiver are complete
+        // only once the receiver has released their tag
+        void await_tag_release(std::size_t comm, int tag)
+        {
+            HPX_ASSERT(comm < channels_.size());
+            channels_[comm]->await_release(tag);
+        }
+
+        bool tag_released(std::size_t comm, int tag)
         {
-            return tag_provider_.acquire();
+            HPX_ASSERT(comm < channels_.size());
+            return channels_[comm]->released(tag);
         }
 
         void send_messages(
@@ -89,7 +137,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
             }
         }
 
-        bool background_work()
+        bool background_work(std::size_t num_thread = std::size_t(-1))
         {
             connection_ptr connection;
             {
@@ -106,69 +154,129 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
                 send_messages(std::move(connection));
                 has_work = true;
             }
-            next_free_tag();
+
+            // Check the released tags of the communicator of this worker
+            // thread, the others are visited round robin to make sure all
+            // of them make progress regardless of the number of workers.
+            std::size_t num_channels = channels_.size();
+            if (num_thread != std::size_t(-1))
+                channels_[num_thread % num_channels]->next_free_tag();
+            if (num_channels != 1 || num_thread == std::size_t(-1))
+                channels_[next_channel_++ % num_channels]->next_free_tag();
+
             return has_work;
         }
 
     private:
-        tag_provider tag_provider_;
-
-        void next_free_tag()
+        // The tags of the messages sent through one communicator and the
+        // pending receive for the tags released by their receivers
+        struct tag_channel
         {
-            int next_free = -1;
+            explicit tag_channel(std::size_t comm)
+              : comm_(comm)
+              , next_free_tag_request_(MPI_REQUEST_NULL)
+              , next_free_tag_(-1)
+            {}
+
+            void next_free_tag()
             {
-                std::unique_lock<mutex_type> l(next_free_tag_mtx_, std::try_to_lock);
-                if(l)
-                    next_free = next_free_tag_locked();
+                int next_free = -1;
+                {
+                    std::unique_lock<mutex_type> l(
+                        next_free_tag_mtx_, std::try_to_lock);
+                    if(l)
+                        next_free = next_free_tag_locked();
+                }
+
+                if(next_free != -1)
+                {
+                    HPX_ASSERT(next_free > 1);
+                    if(!complete_release(next_free))
+                        tag_provider_.release(next_free);
+                }
             }
 
-            if(next_free != -1)
+            void await_release(int tag)
             {
-                HPX_ASSERT(next_free > 1);
-                tag_provider_.release(next_free);
+                std::lock_guard<mutex_type> l(awaited_mtx_);
+                awaited_.insert(tag);
             }
-        }
 
-        int next_free_tag_locked()
-        {
-            util::mpi_environment::scoped_try_lock l;
+            // the tag is handed back to the provider once the connection
+            // waiting for it has noticed the release
+            bool complete_release(int tag)
+            {
+                std::lock_guard<mutex_type> l(awaited_mtx_);
+                if(awaited_.erase(tag) == 0)
+                    return false;
+                released_.insert(tag);
+                return true;
+            }
 
-            if(l.locked)
+            bool released(int tag)
             {
-                MPI_Status status;
-                int completed = 0;
-                int ret = 0;
-                ret = MPI_Test(&next_free_tag_request_, &completed, &status);
-                HPX_ASSERT(ret == MPI_SUCCESS);
-                if(completed)// && status->MPI_ERROR != MPI_ERR_PENDING)
                 {
-                    return get_next_free_tag();
+                    std::lock_guard<mutex_type> l(awaited_mtx_);
+                    if(released_.erase(tag) == 0)
+                        return false;
                 }
+                tag_provider_.release(tag);
+                return true;
             }
-            return -1;
-        }
 
-        int get_next_free_tag()
-        {
-            int next_free = next_free_tag_;
-            MPI_Irecv(
-                &next_free_tag_
-              , 1
-              , MPI_INT
-              , MPI_ANY_SOURCE
-              , 1
-              , util::mpi_environment::communicator()
-              , &next_free_tag_request_
-            );
-            return next_free;
-        }
+            int next_free_tag_locked()
+            {
+                util::mpi_environment::scoped_try_lock l;
+
+                if(l.locked)
+                {
+                    MPI_Status status;
+                    int completed = 0;
+                    int ret = 0;
+                    ret = MPI_Test(&next_free_tag_request_, &completed, &status);
+                    HPX_ASSERT(ret == MPI_SUCCESS);
+                    if(completed)// && status->MPI_ERROR != MPI_ERR_PENDING)
+                    {
+                        return get_next_free_tag();
+                    }
+                }
+                return -1;
+            }
+
+            int get_next_free_tag()
+            {
+                int next_free = next_free_tag_;
+                MPI_Irecv(
+                    &next_free_tag_
+                  , 1
+                  , MPI_INT
+                  , MPI_ANY_SOURCE
+                  , 1
+                  , util::mpi_environment::communicator(comm_)
+                  , &next_free_tag_request_
+                );
+                return next_free;
+            }
+
+            std::size_t const comm_;
+            tag_provider tag_provider_;
+
+            mutex_type next_free_tag_mtx_;
+            MPI_Request next_free_tag_request_;
+            int next_free_tag_;
+
+            mutex_type awaited_mtx_;
+            std::set<int> awaited_;
+            std::set<int> released_;
+        };
+
+        std::size_t const eager_threshold_;
+
+        std::vector<std::unique_ptr<tag_channel> > channels_;
+        std::atomic<std::size_t> next_channel_;
 
         mutex_type connections_mtx_;
         connection_list connections_;
-
-        mutex_type next_free_tag_mtx_;
-        MPI_Request next_free_tag_request_;
-        int next_free_tag_;
     };
 
 
@@ -21,6 +21,8 @@
 #include <hpx/util/unique_function.hpp>
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -30,7 +32,11 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
     struct sender;
     struct sender_connection;
 
-    int acquire_tag(sender *);
+    std::size_t select_communicator(sender *);
+    std::size_t eager_threshold(sender *);
+    int acquire_tag(sender *, std::size_t comm);
+    void await_tag_release(sender *, std::size_t comm, int tag);
+    bool tag_released(sender *, std::size_t comm, int tag);
     void add_connection(sender *, std::shared_ptr<sender_connection> const&);
 
     struct sender_connection
@@ -53,6 +59,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
             initialized
           , sent_header
           , sent_transmission_chunks
+          , sent_rma_addresses
           , sent_data
           , sent_chunks
         };
@@ -70,9 +77,13 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
           : state_(initialized)
           , sender_(s)
           , dst_(dst)
+          , comm_(0)
+          , eager_(false)
+          , rma_(false)
           , request_(MPI_REQUEST_NULL)
           , request_ptr_(nullptr)
           , chunks_idx_(0)
+          , zero_copy_idx_(0)
           , ack_(0)
           , pp_(pp)
           , there_(
@@ -103,8 +114,30 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
             buffer_.data_point_.time_ = util::high_resolution_clock::now();
             request_ptr_ = nullptr;
             chunks_idx_ = 0;
-            tag_ = acquire_tag(sender_);
-            header_ = header(buffer_, tag_);
+            zero_copy_idx_ = 0;
+            rma_ = false;
+            comm_ = select_communicator(sender_);
+
+            // small messages are sent at once, without acquiring a tag
+            std::size_t eager_size = eager_message_size();
+            eager_ = eager_size <= eager_threshold(sender_);
+            if(eager_)
+            {
+                tag_ = 0;
+                header_ = header(buffer_, tag_, true);
+            }
+            else
+            {
+                tag_ = acquire_tag(sender_, comm_);
+                header_ = header(buffer_, tag_);
+
+                rma_ = expose_chunks();
+                if(rma_)
+                {
+                    header_.set_rma();
+                    await_tag_release(sender_, comm_, tag_);
+                }
+            }
             header_.assert_valid();
 
             state_ = initialized;
@@ -130,10 +163,12 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
             switch(state_)
             {
                 case initialized:
-                    return send_header();
+                    return eager_ ? send_eager() : send_header();
                 case sent_header:
                     return send_transmission_chunks();
                 case sent_transmission_chunks:
+                    return send_rma_addresses();
+                case sent_rma_addresses:
                     return send_data();
                 case sent_data:
                     return send_chunks();
@@ -146,6 +181,135 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
             return false;
         }
 
+        // Attach the large zero-copy chunks to the window of the
+        // communicator, the receiver pulls them using their addresses
+        bool expose_chunks()
+        {
+            rma_addresses_.clear();
+
+            MPI_Win* win = util::mpi_environment::rma_window(comm_);
+            if(win == nullptr)
+                return false;
+
+            std::size_t threshold = util::mpi_environment::rma_threshold();
+
+            bool exposed = false;
+            for(serialization::serialization_chunk const& c : buffer_.chunks_)
+            {
+                if(c.type_ != serialization::chunk_type_pointer)
+                    continue;
+
+                MPI_Aint address = 0;
+                if(c.size_ >= threshold)
+                {
+                    util::mpi_environment::scoped_lock l;
+                    void* data = const_cast<void *>(c.data_.cpos_);
+                    MPI_Win_attach(*win, data, static_cast<MPI_Aint>(c.size_));
+                    MPI_Get_address(data, &address);
+                    exposed = true;
+                }
+                rma_addresses_.push_back(address);
+            }
+
+            if(!exposed)
+                rma_addresses_.clear();
+            return exposed;
+        }
+
+        void release_chunks()
+        {
+            MPI_Win* win = util::mpi_environment::rma_window(comm_);
+            HPX_ASSERT(win != nullptr);
+
+            std::size_t idx = 0;
+            for(serialization::serialization_chunk const& c : buffer_.chunks_)
+            {
+                if(c.type_ != serialization::chunk_type_pointer)
+                    continue;
+
+                if(rma_addresses_[idx++] != 0)
+                {
+                    util::mpi_environment::scoped_lock l;
+                    MPI_Win_detach(*win, const_cast<void *>(c.data_.cpos_));
+                }
+            }
+            rma_addresses_.clear();
+        }
+
+        std::size_t eager_message_size() const
+        {
+            std::size_t size = header::pos_piggy_back_data +
+                buffer_.data_.size();
+
+            if(static_cast<std::uint32_t>(buffer_.num_chunks_.first) != 0)
+            {
+                size += buffer_.transmission_chunks_.size() *
+                    sizeof(parcel_buffer_type::transmission_chunk_type);
+            }
+
+            for(serialization::serialization_chunk const& c : buffer_.chunks_)
+            {
+                if(c.type_ == serialization::chunk_type_pointer)
+                    size += c.size_;
+            }
+
+            return size;
+        }
+
+        bool send_eager()
+        {
+            HPX_ASSERT(state_ == initialized);
+            HPX_ASSERT(request_ptr_ == nullptr);
+
+            // pack the header and all of the message into a single buffer
+            eager_buffer_.resize(eager_message_size());
+
+            char* p = eager_buffer_.data();
+            std::memcpy(p, header_.data(), header::pos_piggy_back_data);
+            p += header::pos_piggy_back_data;
+
+            if(static_cast<std::uint32_t>(buffer_.num_chunks_.first) != 0)
+            {
+                std::size_t size = buffer_.transmission_chunks_.size() *
+                    sizeof(parcel_buffer_type::transmission_chunk_type);
+                std::memcpy(p, buffer_.transmission_chunks_.data(), size);
+                p += size;
+            }
+
+            if(!buffer_.data_.empty())
+            {
+                std::memcpy(p, buffer_.data_.data(), buffer_.data_.size());
+                p += buffer_.data_.size();
+            }
+
+            for(serialization::serialization_chunk const& c : buffer_.chunks_)
+            {
+                if(c.type_ == serialization::chunk_type_pointer)
+                {
+                    std::memcpy(p, c.data_.cpos_, c.size_);
+                    p += c.size_;
+                }
+            }
+            HPX_ASSERT(p == eager_buffer_.data() + eager_buffer_.size());
+
+            {
+                util::mpi_environment::scoped_lock l;
+                MPI_Isend(
+                    eager_buffer_.data()
+                  , static_cast<int>(eager_buffer_.size())
+                  , MPI_BYTE
+                  , dst_
+                  , 0
+                  , util::mpi_environment::communicator(comm_)
+                  , &request_
+                );
+                request_ptr_ = &request_;
+            }
+
+            state_ = sent_chunks;
+            return done();
+        }
+
         bool send_header()
         {
             {
@@ -158,7 +322,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
                   , MPI_BYTE
                   , dst_
                   , 0
-                  , util::mpi_environment::communicator()
+                  , util::mpi_environment::communicator(comm_)
                   , &request_
                 );
                 request_ptr_ = &request_;
@@ -190,19 +354,43 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
                   , MPI_BYTE
                   , dst_
                   , tag_
-                  , util::mpi_environment::communicator()
+                  , util::mpi_environment::communicator(comm_)
                   , &request_
                 );
                 request_ptr_ = &request_;
             }
 
             state_ = sent_transmission_chunks;
+            return send_rma_addresses();
+        }
+
+        bool send_rma_addresses()
+        {
+            HPX_ASSERT(state_ == sent_transmission_chunks);
+            if(!request_done()) return false;
+
+            if(rma_)
+            {
+                util::mpi_environment::scoped_lock l;
+                MPI_Isend(
+                    rma_addresses_.data()
+                  , static_cast<int>(rma_addresses_.size() * sizeof(MPI_Aint))
+                  , MPI_BYTE
+                  , dst_
+                  , tag_
+                  , util::mpi_environment::communicator(comm_)
+                  , &request_
+                );
+                request_ptr_ = &request_;
+            }
+
+            state_ = sent_rma_addresses;
             return send_data();
         }
 
         bool send_data()
         {
-            HPX_ASSERT(state_ == sent_transmission_chunks);
+            HPX_ASSERT(state_ == sent_rma_addresses);
             if(!request_done()) return false;
 
             if(!header_.piggy_back())
@@ -214,7 +402,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
                   , MPI_BYTE
                   , dst_
                   , tag_
-                  , util::mpi_environment::communicator()
+                  , util::mpi_environment::communicator(comm_)
                   , &request_
                 );
                 request_ptr_ = &request_;
@@ -233,7 +421,11 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
                 serialization::serialization_chunk& c = buffer_.chunks_[chunks_idx_];
                 if(c.type_ == serialization::chunk_type_pointer)
                 {
-                    if(!request_done()) return false;
+                    if(rma_ && rma_addresses_[zero_copy_idx_] != 0)
+                    {
+                        // pulled by the receiver
+                    }
+                    else if(!request_done()) return false;
                     else
                     {
                         util::mpi_environment::scoped_lock l;
@@ -243,11 +435,12 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
                           , MPI_BYTE
                           , dst_
                           , tag_
-                          , util::mpi_environment::communicator()
+                          , util::mpi_environment::communicator(comm_)
                           , &request_
                         );
                         request_ptr_ = &request_;
                     }
+                    zero_copy_idx_++;
                  }
 
                 chunks_idx_++;
@@ -262,13 +455,25 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
         {
             if(!request_done()) return false;
 
+            if(rma_)
+            {
+                // the receiver releases the tag after it has pulled all
+                // exposed chunks
+                if(!tag_released(sender_, comm_, tag_)) return false;
+
+                release_chunks();
+                rma_ = false;
+            }
+
             error_code ec;
             handler_(ec);
             handler_.reset();
             buffer_.data_point_.time_ =
                 util::high_resolution_clock::now() - buffer_.data_point_.time_;
             pp_->add_sent_data(buffer_.data_point_);
-            buffer_.clear();
+            // keep the memory of the buffer for the next message
+            buffer_.clear(static_cast<std::size_t>(
+                pp_->get_max_outbound_message_size()));
 
             state_ = initialized;
 
@@ -299,6 +504,9 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
         sender_type * sender_;
         int tag_;
         int dst_;
+        std::size_t comm_;      // communicator used for the current message
+        bool eager_;            // the current message is sent eagerly
+        bool rma_;              // some chunks are pulled by the receiver
         util::unique_function_nonser<
             void(
                 error_code const&
@@ -313,10 +521,13 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
         > postprocess_handler_;
 
         header header_;
+        std::vector<char> eager_buffer_;
 
         MPI_Request request_;
         MPI_Request *request_ptr_;
         std::size_t chunks_idx_;
+        std::size_t zero_copy_idx_;
+        std::vector<MPI_Aint> rma_addresses_;   // 0 if sent two-sided
         char ack_;
 
         parcelset::parcelport* pp_;
@@ -0,0 +1,166 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_CONNECTION_HANDLER_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_CONNECTION_HANDLER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/plugins/parcelport/shmem/locality.hpp>
+#include <hpx/plugins/parcelport/shmem/segment.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/parcelset/parcelport_impl.hpp>
+#include <hpx/util_fwd.hpp>
+
+#include <boost/asio/ip/host_name.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace parcelset
+{
+    namespace policies { namespace shmem
+    {
+        class receiver;
+        class sender;
+        class HPX_EXPORT connection_handler;
+    }}
+
+    template <>
+    struct connection_handler_traits<policies::shmem::connection_handler>
+    {
+        typedef policies::shmem::sender connection_type;
+        typedef std::false_type send_early_parcel;
+        typedef std::true_type  do_background_work;
+        typedef std::false_type send_immediate_parcels;
+
+        static const char * type()
+        {
+            return "shmem";
+        }
+
+        static const char * pool_name()
+        {
+            return "parcel-pool-shmem";
+        }
+
+        static const char * pool_name_postfix()
+        {
+            return "-shmem";
+        }
+    };
+
+    namespace policies { namespace shmem
+    {
+        /// A parcelport for localities running on the same host. Each
+        /// locality owns a shared memory segment holding a set of channels,
+        /// every connection to a locality claims one of the channels of its
+        /// segment and copies the parcel data directly into it. This
+        /// parcelport cannot be used for bootstrapping, it is selected (over
+        /// all other parcelports) for all destinations on the same host.
+        class HPX_EXPORT connection_handler
+          : public parcelport_impl<connection_handler>
+        {
+            typedef parcelport_impl<connection_handler> base_type;
+        public:
+
+            static std::vector<std::string> runtime_configuration()
+            {
+                std::vector<std::string> lines;
+
+                return lines;
+            }
+
+            connection_handler(util::runtime_configuration const& ini,
+                util::function_nonser<void(std::size_t, char const*)> const&
+                    on_start_thread,
+                util::function_nonser<void(std::size_t, char const*)> const&
+                    on_stop_thread);
+
+            ~connection_handler();
+
+            /// Start the handling of connections.
+            bool do_run();
+
+            /// Stop the handling of connectons.
+            void do_stop();
+
+            /// Return the name of this locality
+            std::string get_locality_name() const
+            {
+                return boost::asio::ip::host_name();
+            }
+
+            /// Only localities on the same host can be reached through
+            /// shared memory.
+            bool can_connect(parcelset::locality const& l,
+                bool use_alternative_parcelport) override;
+
+            std::shared_ptr<sender> create_connection(
+                parcelset::locality const& l, error_code& ec);
+
+            parcelset::locality agas_locality(util::runtime_configuration const& ini)
+                const;
+
+            parcelset::locality create_locality() const;
+
+            /// Receive the data written to our channels and continue the
+            /// pending write operations.
+            bool background_work(std::size_t num_thread);
+
+            /// Remember a write operation which could not be completed right
+            /// away.
+            void add_pending_write(std::shared_ptr<sender> sender_conn);
+
+        private:
+            connection_handler(util::runtime_configuration const& ini,
+                std::unique_ptr<segment> s,
+                util::function_nonser<void(std::size_t, char const*)> const&
+                    on_start_thread,
+                util::function_nonser<void(std::size_t, char const*)> const&
+                    on_stop_thread);
+
+            std::shared_ptr<segment> get_segment(std::string const& name);
+
+            bool receive();
+            bool has_incoming_data() const;
+            bool progress_pending_writes();
+
+            void io_service_work();
+
+            /// The segment receiving the parcels sent to this locality, and
+            /// the receiving ends of all of its channels.
+            std::unique_ptr<segment> segment_;
+            std::vector<std::unique_ptr<receiver> > receivers_;
+
+            std::atomic<bool> stopped_;
+
+            /// The segments of other localities opened by this one.
+            lcos::local::spinlock segments_mtx_;
+            std::map<std::string, std::shared_ptr<segment> > segments_;
+
+            /// The write operations waiting for space in their channel.
+            lcos::local::spinlock pending_writes_mtx_;
+            std::vector<std::shared_ptr<sender> > pending_writes_;
+            std::atomic<std::size_t> num_pending_writes_;
+        };
+    }}
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
+
+#endif
@@ -0,0 +1,70 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_HEADER_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_HEADER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <cstddef>
+#include <cstring>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    /// The header preceding each message written to a channel. It holds the
+    /// sizes of the parcel buffer being transferred, in the same format as
+    /// used by the TCP parcelport.
+    struct header
+    {
+        enum data_pos
+        {
+            pos_size             = 0,
+            pos_data_size        = 8,
+            pos_numchunks_first  = 16,
+            pos_numchunks_second = 20
+        };
+
+        static constexpr std::size_t size = 24;
+
+        template <typename Buffer>
+        static void save(char* data, Buffer const& buffer)
+        {
+            set<pos_size>(data, buffer.size_);
+            set<pos_data_size>(data, buffer.data_size_);
+            set<pos_numchunks_first>(data, buffer.num_chunks_.first);
+            set<pos_numchunks_second>(data, buffer.num_chunks_.second);
+        }
+
+        template <typename Buffer>
+        static void load(char const* data, Buffer& buffer)
+        {
+            get<pos_size>(data, buffer.size_);
+            get<pos_data_size>(data, buffer.data_size_);
+            get<pos_numchunks_first>(data, buffer.num_chunks_.first);
+            get<pos_numchunks_second>(data, buffer.num_chunks_.second);
+        }
+
+    private:
+        // the integer types used by the parcel buffer are stored in little
+        // endian byte order already
+        template <std::size_t Pos, typename T>
+        static void set(char* data, T const& t)
+        {
+            std::memcpy(data + Pos, &t, sizeof(T));
+        }
+
+        template <std::size_t Pos, typename T>
+        static void get(char const* data, T& t)
+        {
+            std::memcpy(&t, data + Pos, sizeof(T));
+        }
+    };
+}}}}
+
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_LOCALITY_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_LOCALITY_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/string.hpp>
+
+#include <string>
+
+namespace hpx { namespace parcelset
+{
+    namespace policies { namespace shmem
+    {
+        /// A shared memory endpoint is identified by the host it lives on
+        /// and the name of the segment receiving its parcels. Two localities
+        /// can talk through shared memory only if their host ids are equal.
+        class locality
+        {
+        public:
+            locality()
+            {}
+
+            locality(std::string const& host, std::string const& segment)
+              : host_(host), segment_(segment)
+            {}
+
+            std::string const & host() const
+            {
+                return host_;
+            }
+
+            std::string const & segment() const
+            {
+                return segment_;
+            }
+
+            static const char *type()
+            {
+                return "shmem";
+            }
+
+            explicit operator bool() const noexcept
+            {
+                return !segment_.empty();
+            }
+
+            void save(serialization::output_archive & ar) const
+            {
+                ar << host_;
+                ar << segment_;
+            }
+
+            void load(serialization::input_archive & ar)
+            {
+                ar >> host_;
+                ar >> segment_;
+            }
+
+        private:
+            friend bool operator==(locality const & lhs, locality const & rhs)
+            {
+                return lhs.segment_ == rhs.segment_ && lhs.host_ == rhs.host_;
+            }
+
+            friend bool operator<(locality const & lhs, locality const & rhs)
+            {
+                return lhs.host_ < rhs.host_ ||
+                    (lhs.host_ == rhs.host_ && lhs.segment_ < rhs.segment_);
+            }
+
+            friend std::ostream & operator<<(std::ostream & os, locality const & loc)
+            {
+                os << loc.host_ << ":" << loc.segment_;
+                return os;
+            }
+
+            std::string host_;
+            std::string segment_;
+        };
+    }}
+}}
+
+#endif
+
+#endif
@@ -0,0 +1,228 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_RECEIVER_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_RECEIVER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/performance_counters/parcels/data_point.hpp>
+#include <hpx/plugins/parcelport/shmem/connection_handler.hpp>
+#include <hpx/plugins/parcelport/shmem/header.hpp>
+#include <hpx/plugins/parcelport/shmem/segment.hpp>
+#include <hpx/runtime/parcelset/decode_parcels.hpp>
+#include <hpx/runtime/parcelset/parcel_buffer.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    /// The receiving end of one channel of the segment owned by this
+    /// locality. The channel holds a stream of messages, which may have been
+    /// written by different connections one after the other.
+    class receiver
+    {
+        typedef parcel_buffer<std::vector<char>, std::vector<char> >
+            parcel_buffer_type;
+
+        enum state
+        {
+            state_read_header,
+            state_read_chunk_data,
+            state_read_data
+        };
+
+    public:
+        receiver(segment const& s, std::size_t channel,
+                connection_handler& parcelport)
+          : reader_(s, channel)
+          , state_(state_read_header)
+          , parcelport_(parcelport)
+          , timer_()
+        {
+            buffers_.add(header_, header::size);
+        }
+
+        /// Return whether the channel holds data which was not received yet.
+        bool has_data() const noexcept
+        {
+            return reader_.has_data();
+        }
+
+        /// Consume all data available in the channel, return whether
+        /// anything was received.
+        bool receive()
+        {
+            if (!reader_.has_data())
+                return false;
+
+            // only one thread consumes the data of a channel at any time
+            std::unique_lock<lcos::local::spinlock> l(mtx_, std::try_to_lock);
+            if (!l.owns_lock())
+                return false;
+
+            bool did_some_work = false;
+            while (reader_.has_data())
+            {
+                did_some_work = true;
+
+                bool const done = buffers_.read(reader_);
+
+                // give the space back to the sender right away, large
+                // messages are streamed through the channel
+                reader_.release();
+
+                if (done)
+                    handle_read();
+            }
+            return did_some_work;
+        }
+
+    private:
+        void handle_read()
+        {
+            switch (state_)
+            {
+            case state_read_header:
+                handle_read_header();
+                break;
+
+            case state_read_chunk_data:
+                handle_read_chunk_data();
+                break;
+
+            case state_read_data:
+                handle_read_data();
+                break;
+
+            default:
+                HPX_ASSERT(false);
+                break;
+            }
+        }
+
+        /// Handle a completed read of the message header.
+        void handle_read_header()
+        {
+            header::load(header_, buffer_);
+
+            performance_counters::parcels::data_point& data = buffer_.data_point_;
+            data.time_ = timer_.elapsed_nanoseconds();
+            data.serialization_time_ = 0;
+            data.num_parcels_ = 0;
+
+            // Determine the length of the serialized data.
+            std::uint64_t inbound_size = buffer_.size_;
+            data.bytes_ = static_cast<std::size_t>(inbound_size);
+
+            // determine the size of the chunk buffer
+            std::size_t num_zero_copy_chunks =
+                static_cast<std::size_t>(
+                    static_cast<std::uint32_t>(buffer_.num_chunks_.first));
+            std::size_t num_non_zero_copy_chunks =
+                static_cast<std::size_t>(
+                    static_cast<std::uint32_t>(buffer_.num_chunks_.second));
+
+            buffers_.clear();
+            if (num_zero_copy_chunks != 0) {
+                typedef parcel_buffer_type::transmission_chunk_type
+                    transmission_chunk_type;
+
+                std::vector<transmission_chunk_type>& chunks =
+                    buffer_.transmission_chunks_;
+
+                chunks.resize(static_cast<std::size_t>(
+                    num_zero_copy_chunks + num_non_zero_copy_chunks));
+
+                buffers_.add(chunks.data(), chunks.size() *
+                    sizeof(transmission_chunk_type));
+
+                // add main buffer holding data which was serialized normally
+                buffer_.data_.resize(static_cast<std::size_t>(inbound_size));
+                buffers_.add(buffer_.data_.data(), buffer_.data_.size());
+
+                state_ = state_read_chunk_data;
+            }
+            else {
+                // add main buffer holding data which was serialized normally
+                buffer_.data_.resize(static_cast<std::size_t>(inbound_size));
+                buffers_.add(buffer_.data_.data(), buffer_.data_.size());
+
+                state_ = state_read_data;
+            }
+
+            if (buffers_.empty())
+                handle_read();
+        }
+
+        /// Handle a completed read of the chunk table and the message data.
+        void handle_read_chunk_data()
+        {
+            // add appropriately sized chunk buffers for the zero-copy data
+            std::size_t num_zero_copy_chunks =
+                static_cast<std::size_t>(
+                    static_cast<std::uint32_t>(buffer_.num_chunks_.first));
+
+            buffers_.clear();
+            buffer_.chunks_.resize(num_zero_copy_chunks);
+            for (std::size_t i = 0; i != num_zero_copy_chunks; ++i)
+            {
+                std::size_t chunk_size = static_cast<std::size_t>(
+                    buffer_.transmission_chunks_[i].second);
+                buffer_.chunks_[i].resize(chunk_size);
+                buffers_.add(buffer_.chunks_[i].data(), chunk_size);
+            }
+
+            state_ = state_read_data;
+            if (buffers_.empty())
+                handle_read_data();
+        }
+
+        /// Handle a completed read of message data.
+        void handle_read_data()
+        {
+            // complete data point and pass it along
+            buffer_.data_point_.time_ = timer_.elapsed_nanoseconds() -
+                buffer_.data_point_.time_;
+
+            // decode the received parcels.
+            decode_parcels_in_place(parcelport_, buffer_, -1);
+
+            // the next message starts with its header
+            state_ = state_read_header;
+            buffers_.clear();
+            buffers_.add(header_, header::size);
+        }
+
+        lcos::local::spinlock mtx_;
+        channel_reader reader_;
+
+        /// The buffers of the parcel being received.
+        char header_[header::size];
+        buffer_list buffers_;
+        parcel_buffer_type buffer_;
+
+        state state_;
+
+        /// The handler used to process the incoming request.
+        connection_handler& parcelport_;
+
+        /// Counters and timers for parcels received.
+        util::high_resolution_timer timer_;
+    };
+}}}}
+
+#endif
+
+#endif
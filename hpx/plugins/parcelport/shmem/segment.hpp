@@ -0,0 +1,367 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_SEGMENT_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_SEGMENT_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The layout of a shared memory segment is:
+    //
+    //      segment_header
+    //      channel_header[num_channels]
+    //      (page aligned) data of channel 0
+    //      ...
+    //      data of channel (num_channels - 1)
+    //
+    // Each segment is owned by the receiving locality. Each sending
+    // connection claims one of the channels, so every channel has a single
+    // producer (the connection) and a single consumer (the receiving
+    // locality). The data of a channel is a circular buffer, the positions
+    // are never wrapped.
+    struct segment_header
+    {
+        static constexpr std::uint64_t magic = 0x6870782d73686d31ull;
+
+        std::uint64_t magic_;
+        std::uint64_t num_channels_;
+        std::uint64_t channel_size_;
+        std::uint64_t data_offset_;
+
+        char pad0_[threads::get_cache_line_size()];
+
+        // The doorbell of the receiving locality, senders increment it and
+        // wake up the receiver if it announced to go to sleep.
+        std::atomic<std::uint32_t> doorbell_;
+        std::atomic<std::uint32_t> sleeping_;
+
+        char pad1_[threads::get_cache_line_size()];
+    };
+
+    struct channel_header
+    {
+        // 0 if the channel is not used by any connection
+        std::atomic<std::uint32_t> owner_;
+        char pad0_[threads::get_cache_line_size()];
+
+        // read position, written by the receiver only
+        std::atomic<std::uint64_t> head_;
+        char pad1_[threads::get_cache_line_size()];
+
+        // write position, written by the sender only
+        std::atomic<std::uint64_t> tail_;
+        char pad2_[threads::get_cache_line_size()];
+    };
+
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free &&
+        std::atomic<std::uint64_t>::is_always_lock_free,
+        "the atomics shared between processes have to be lock free");
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A mapping of a shared memory segment into this process.
+    class HPX_EXPORT segment
+    {
+    public:
+        HPX_NON_COPYABLE(segment);
+
+        /// Create a new segment with the given number of channels (each
+        /// holding channel_size bytes, which has to be a power of two). The
+        /// name is generated, the segment is unlinked by the destructor.
+        segment(std::size_t num_channels, std::size_t channel_size);
+
+        /// Open the existing segment with the given name.
+        explicit segment(std::string const& name);
+
+        ~segment();
+
+        std::string const& name() const noexcept
+        {
+            return name_;
+        }
+
+        segment_header& header() const noexcept
+        {
+            return *static_cast<segment_header*>(base_);
+        }
+
+        std::size_t num_channels() const noexcept
+        {
+            return header().num_channels_;
+        }
+
+        channel_header& channel(std::size_t i) const noexcept
+        {
+            HPX_ASSERT(i < num_channels());
+            return reinterpret_cast<channel_header*>(
+                static_cast<char*>(base_) + sizeof(segment_header))[i];
+        }
+
+        char* channel_data(std::size_t i) const noexcept
+        {
+            HPX_ASSERT(i < num_channels());
+            segment_header const& h = header();
+            return static_cast<char*>(base_) + h.data_offset_ +
+                i * h.channel_size_;
+        }
+
+        std::size_t channel_size() const noexcept
+        {
+            return header().channel_size_;
+        }
+
+        /// Claim a free channel for a new connection, return its index or
+        /// std::size_t(-1) if all channels are in use.
+        std::size_t claim_channel() const noexcept;
+
+        /// Give back a channel which was claimed before.
+        void release_channel(std::size_t i) const noexcept;
+
+        /// Wake up the receiver owning this segment, if it is sleeping.
+        void ring_doorbell() const noexcept;
+
+        /// Suspend the calling OS thread until the doorbell is rung, or the
+        /// timeout has expired. Before going to sleep, \a has_work is
+        /// called, the thread does not sleep if it returns true.
+        template <typename F>
+        void wait_for_doorbell(F && has_work, std::uint64_t timeout_ns) const
+        {
+            segment_header& h = header();
+            std::uint32_t const doorbell =
+                h.doorbell_.load(std::memory_order_acquire);
+
+            h.sleeping_.store(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (!has_work())
+                futex_wait(h.doorbell_, doorbell, timeout_ns);
+
+            h.sleeping_.store(0, std::memory_order_relaxed);
+        }
+
+        /// Remove the name of the segment, it is destroyed once all
+        /// processes have unmapped it.
+        void unlink() noexcept;
+
+    private:
+        void map(int fd, std::size_t size);
+
+        static void futex_wait(std::atomic<std::uint32_t>& word,
+            std::uint32_t value, std::uint64_t timeout_ns) noexcept;
+        static void futex_wake(std::atomic<std::uint32_t>& word) noexcept;
+
+        std::string name_;
+        void* base_;
+        std::size_t size_;
+        bool linked_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The producing end of a channel.
+    class channel_writer
+    {
+    public:
+        channel_writer(segment const& s, std::size_t i) noexcept
+          : channel_(s.channel(i))
+          , data_(s.channel_data(i))
+          , size_(s.channel_size())
+          , tail_(channel_.tail_.load(std::memory_order_relaxed))
+        {}
+
+        /// Copy as much of the given data into the channel as possible,
+        /// return the number of bytes copied. The data becomes visible to
+        /// the receiver only after publish() has been called.
+        std::size_t write(void const* data, std::size_t size) noexcept
+        {
+            std::uint64_t const head =
+                channel_.head_.load(std::memory_order_acquire);
+            std::size_t const available = size_ - std::size_t(tail_ - head);
+            if (size > available)
+                size = available;
+
+            copy(data, size);
+            return size;
+        }
+
+        /// Make all written data visible to the receiver, return whether
+        /// anything had been written.
+        bool publish() noexcept
+        {
+            if (channel_.tail_.load(std::memory_order_relaxed) == tail_)
+                return false;
+
+            channel_.tail_.store(tail_, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            return true;
+        }
+
+    private:
+        void copy(void const* data, std::size_t size) noexcept
+        {
+            std::size_t const pos = std::size_t(tail_) & (size_ - 1);
+            std::size_t const first = (std::min)(size, size_ - pos);
+
+            std::memcpy(data_ + pos, data, first);
+            std::memcpy(data_, static_cast<char const*>(data) + first,
+                size - first);
+            tail_ += size;
+        }
+
+        channel_header& channel_;
+        char* data_;
+        std::size_t size_;
+        std::uint64_t tail_;
+    };
+
+    /// The consuming end of a channel.
+    class channel_reader
+    {
+    public:
+        channel_reader(segment const& s, std::size_t i) noexcept
+          : channel_(s.channel(i))
+          , data_(s.channel_data(i))
+          , size_(s.channel_size())
+          , head_(channel_.head_.load(std::memory_order_relaxed))
+        {}
+
+        /// Return whether the sender has published any data which was not
+        /// read yet.
+        bool has_data() const noexcept
+        {
+            return channel_.tail_.load(std::memory_order_relaxed) != head_;
+        }
+
+        /// Copy as much of the published data as possible into the given
+        /// buffer, return the number of bytes copied. The space becomes
+        /// available to the sender only after release() has been called.
+        std::size_t read(void* data, std::size_t size) noexcept
+        {
+            std::uint64_t const tail =
+                channel_.tail_.load(std::memory_order_acquire);
+            std::size_t const available = std::size_t(tail - head_);
+            if (size > available)
+                size = available;
+
+            std::size_t const pos = std::size_t(head_) & (size_ - 1);
+            std::size_t const first = (std::min)(size, size_ - pos);
+
+            std::memcpy(data, data_ + pos, first);
+            std::memcpy(static_cast<char*>(data) + first, data_, size - first);
+            head_ += size;
+            return size;
+        }
+
+        /// Give the space of all data read so far back to the sender.
+        void release() noexcept
+        {
+            channel_.head_.store(head_, std::memory_order_release);
+        }
+
+    private:
+        channel_header& channel_;
+        char* data_;
+        std::size_t size_;
+        std::uint64_t head_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The list of buffers making up a message, transferred through a
+    /// channel in as many steps as needed.
+    class buffer_list
+    {
+    public:
+        buffer_list()
+          : current_(0)
+        {}
+
+        void clear()
+        {
+            buffers_.clear();
+            current_ = 0;
+        }
+
+        void add(void const* data, std::size_t size)
+        {
+            if (size != 0)
+            {
+                buffers_.emplace_back(
+                    const_cast<char*>(static_cast<char const*>(data)), size);
+            }
+        }
+
+        bool empty() const noexcept
+        {
+            return current_ == buffers_.size();
+        }
+
+        /// Write as much of the remaining buffers to the channel as
+        /// possible, return true if everything was written.
+        bool write(channel_writer& w) noexcept
+        {
+            return transfer(
+                [&w](char* data, std::size_t size)
+                {
+                    return w.write(data, size);
+                });
+        }
+
+        /// Fill as much of the remaining buffers from the channel as
+        /// possible, return true if everything was read.
+        bool read(channel_reader& r) noexcept
+        {
+            return transfer(
+                [&r](char* data, std::size_t size)
+                {
+                    return r.read(data, size);
+                });
+        }
+
+    private:
+        template <typename F>
+        bool transfer(F && f) noexcept
+        {
+            while (current_ != buffers_.size())
+            {
+                std::pair<char*, std::size_t>& b = buffers_[current_];
+                std::size_t const n = f(b.first, b.second);
+
+                b.first += n;
+                b.second -= n;
+                if (b.second != 0)
+                    return false;
+
+                ++current_;
+            }
+            return true;
+        }
+
+        std::vector<std::pair<char*, std::size_t> > buffers_;
+        std::size_t current_;
+    };
+}}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
+
+#endif
@@ -0,0 +1,218 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_SENDER_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_SENDER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/performance_counters/parcels/data_point.hpp>
+#include <hpx/performance_counters/parcels/gatherer.hpp>
+#include <hpx/plugins/parcelport/shmem/connection_handler.hpp>
+#include <hpx/plugins/parcelport/shmem/header.hpp>
+#include <hpx/plugins/parcelport/shmem/locality.hpp>
+#include <hpx/plugins/parcelport/shmem/segment.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/parcelset/parcelport_connection.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/state.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/deferred_call.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/unique_function.hpp>
+
+#include <boost/system/error_code.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    class sender
+      : public parcelset::parcelport_connection<sender, std::vector<char> >
+    {
+        using postprocess_handler_type = util::unique_function_nonser<void(
+            boost::system::error_code const&)>;
+
+        using parcel_postprocess_type = util::unique_function_nonser<void(
+                boost::system::error_code const&
+              , parcelset::locality const&
+              , std::shared_ptr<sender>
+            )>;
+
+    public:
+        /// Construct a sending parcelport_connection writing to the given
+        /// channel of the segment of the destination.
+        sender(std::shared_ptr<segment> s, std::size_t channel,
+                parcelset::locality const& locality_id,
+                connection_handler* pp)
+          : segment_(std::move(s))
+          , channel_(channel)
+          , writer_(*segment_, channel)
+          , there_(locality_id)
+          , timer_()
+          , pp_(pp)
+        {
+        }
+
+        ~sender()
+        {
+            segment_->release_channel(channel_);
+        }
+
+        parcelset::locality const& destination() const
+        {
+            return there_;
+        }
+
+        void verify_(parcelset::locality const & parcel_locality_id) const
+        {
+        }
+
+        template <typename Handler, typename ParcelPostprocess>
+        void async_write(Handler && handler,
+            ParcelPostprocess && parcel_postprocess)
+        {
+            HPX_ASSERT(!buffer_.data_.empty());
+            HPX_ASSERT(!handler_);
+            HPX_ASSERT(!postprocess_handler_);
+
+            handler_ = std::forward<Handler>(handler);
+            postprocess_handler_ = std::forward<ParcelPostprocess>(parcel_postprocess);
+            HPX_ASSERT(handler_);
+            HPX_ASSERT(postprocess_handler_);
+
+            /// Increment sends and begin timer.
+            buffer_.data_point_.time_ = timer_.elapsed_nanoseconds();
+
+            // The message is written in the format used by the TCP
+            // parcelport: the header, the chunk table, the data, and all
+            // zero-copy chunks.
+            header::save(header_, buffer_);
+
+            buffers_.clear();
+            buffers_.add(header_, header::size);
+
+            std::vector<parcel_buffer_type::transmission_chunk_type>& chunks =
+                buffer_.transmission_chunks_;
+            if (!chunks.empty()) {
+                buffers_.add(chunks.data(), chunks.size() *
+                    sizeof(parcel_buffer_type::transmission_chunk_type));
+
+                // add main buffer holding data which was serialized normally
+                buffers_.add(buffer_.data_.data(), buffer_.data_.size());
+
+                // now add chunks themselves, those hold zero-copy serialized chunks
+                for (serialization::serialization_chunk& c : buffer_.chunks_)
+                {
+                    if (c.type_ == serialization::chunk_type_pointer)
+                        buffers_.add(c.data_.cpos_, c.size_);
+                }
+            }
+            else {
+                // add main buffer holding data which was serialized normally
+                buffers_.add(buffer_.data_.data(), buffer_.data_.size());
+            }
+
+            // Write as much as possible right away, the connection handler
+            // continues writing the rest (if any).
+            if (!progress())
+                pp_->add_pending_write(shared_from_this());
+        }
+
+        /// Write as much of the pending message as the channel can take,
+        /// return true if the write operation has completed.
+        bool progress()
+        {
+            bool const done = buffers_.write(writer_);
+            if (writer_.publish())
+                segment_->ring_doorbell();
+
+            if (done)
+                handle_write(boost::system::error_code());
+            return done;
+        }
+
+        /// Complete the pending write operation with the given error.
+        void abort(boost::system::error_code const& e)
+        {
+            handle_write(e);
+        }
+
+    private:
+        static void reset_handler(postprocess_handler_type handler)
+        {
+            handler.reset();
+        }
+
+        /// handle completed write operation
+        void handle_write(boost::system::error_code const& e)
+        {
+            // just call initial handler
+            handler_(e);
+
+            postprocess_handler_type handler;
+            std::swap(handler, handler_);
+
+            if (threads::threadmanager_is(state_running))
+            {
+                // the handler needs to be reset on an HPX thread (it destroys
+                // the parcel, which in turn might invoke HPX functions)
+                threads::register_thread_nullary(util::deferred_call(
+                    &sender::reset_handler, std::move(handler)));
+            }
+            else
+            {
+                reset_handler(std::move(handler));
+            }
+
+            if (!e)
+            {
+                // complete data point and push back onto gatherer
+                buffer_.data_point_.time_ =
+                    timer_.elapsed_nanoseconds() - buffer_.data_point_.time_;
+                pp_->add_sent_data(buffer_.data_point_);
+            }
+            // keep the memory of the buffer for the next message
+            buffer_.clear(static_cast<std::size_t>(
+                pp_->get_max_outbound_message_size()));
+
+            // Call post-processing handler, which will send remaining pending
+            // parcels. Pass along the connection so it can be reused if more
+            // parcels have to be sent.
+            parcel_postprocess_type postprocess_handler;
+            std::swap(postprocess_handler, postprocess_handler_);
+            postprocess_handler(e, there_, shared_from_this());
+        }
+
+        /// The segment of the destination and the channel owned by this
+        /// connection.
+        std::shared_ptr<segment> segment_;
+        std::size_t channel_;
+        channel_writer writer_;
+
+        /// The buffers of the parcel being sent.
+        char header_[header::size];
+        buffer_list buffers_;
+
+        /// the other (receiving) end of this connection
+        parcelset::locality there_;
+
+        /// Counters and their data containers.
+        util::high_resolution_timer timer_;
+        connection_handler* pp_;
+
+        postprocess_handler_type handler_;
+        parcel_postprocess_type postprocess_handler_;
+    };
+}}}}
+
+#endif
+
+#endif
@@ -24,6 +24,8 @@
 #include <boost/asio/ip/tcp.hpp>
 
 #include <cstddef>
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -110,7 +112,19 @@ namespace hpx { namespace parcelset
 
             parcelset::locality create_locality() const;
 
+            /// Register an accepted connection as a stripe of the connection
+            /// with the given id (see stripes.hpp)
+            void add_stripe(std::uint64_t id, std::size_t index,
+                std::size_t count, std::shared_ptr<receiver> const& stripe);
+
+            /// Return the stripes of the connection with the given id, the
+            /// result is empty if not all of them have been announced
+            std::vector<std::shared_ptr<receiver> > get_stripes(
+                std::uint64_t id) const;
+
         private:
+            void connect_stripes(sender& connection,
+                parcelset::locality const& l);
             void handle_accept(boost::system::error_code const & e,
                 std::shared_ptr<receiver> receiver_conn);
             void handle_read_completion(boost::system::error_code const& e,
@@ -125,6 +139,18 @@ namespace hpx { namespace parcelset
             typedef std::set<std::shared_ptr<receiver> > accepted_connections_set;
             accepted_connections_set accepted_connections_;
 
+            /// The accepted stripes of the connections from other localities
+            typedef std::map<std::uint64_t,
+                    std::vector<std::shared_ptr<receiver> >
+                > stripes_map;
+            stripes_map stripes_;
+
+            /// The number of stripes opened with every outgoing connection
+            /// and the least number of bytes of zero-copy chunks a message
+            /// needs to have to be striped
+            std::size_t const stripe_connections_;
+            std::size_t const stripe_threshold_;
+
 #if defined(HPX_HOLDON_TO_OUTGOING_CONNECTIONS)
             typedef std::set<boost::weak_ptr<sender> > write_connections_set;
             write_connections_set write_connections_;
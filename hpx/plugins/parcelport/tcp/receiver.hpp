@@ -19,6 +19,8 @@
 #include <hpx/config/asio.hpp>
 #include <hpx/performance_counters/parcels/data_point.hpp>
 #include <hpx/performance_counters/parcels/gatherer.hpp>
+#include <hpx/plugins/parcelport/tcp/connection_handler.hpp>
+#include <hpx/plugins/parcelport/tcp/stripes.hpp>
 #include <hpx/runtime/parcelset/decode_parcels.hpp>
 #include <hpx/runtime/parcelset/parcelport_connection.hpp>
 #include <hpx/util/assert.hpp>
@@ -33,6 +35,7 @@
 #include <boost/asio/read.hpp>
 #include <boost/asio/write.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -43,8 +46,6 @@
 
 namespace hpx { namespace parcelset { namespace policies { namespace tcp
 {
-    class connection_handler;
-
     class receiver
       : public parcelport_connection<receiver, std::vector<char>, std::vector<char> >
     {
@@ -59,6 +60,10 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
           , timer_()
           , mtx_()
           , operation_in_flight_(0)
+          , stripes_id_(0)
+          , num_stripes_(0)
+          , striped_(false)
+          , pending_reads_(0)
         {}
 
         ~receiver()
@@ -120,6 +125,31 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
             }
         }
 
+        /// Return the id announced by the sending end of this connection if
+        /// it is accompanied by stripes (see stripes.hpp), zero otherwise.
+        std::uint64_t stripes_id() const
+        {
+            return stripes_id_;
+        }
+
+        /// Asynchronously read one part of a striped message, this is a
+        /// stripe of the connection receiving the message.
+        template <typename Handler>
+        void async_read_part(
+            std::vector<boost::asio::mutable_buffer> const& buffers,
+            Handler handler)
+        {
+            std::unique_lock<mutex_type> lk(mtx_);
+            if (!socket_.is_open())
+            {
+                lk.unlock();
+                handler(boost::asio::error::make_error_code(
+                    boost::asio::error::not_connected));
+                return;
+            }
+            boost::asio::async_read(socket_, buffers, handler);
+        }
+
         void shutdown()
         {
             std::lock_guard<mutex_type> lk(mtx_);
@@ -153,6 +183,12 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 //                 async_read(handler);
             }
             else {
+                if (buffer_.size_ == stripe_announcement_tag)
+                {
+                    handle_announcement(handler);
+                    return;
+                }
+
                 ++operation_in_flight_;
                 // Determine the length of the serialized data.
                 std::uint64_t inbound_size = buffer_.size_;
@@ -170,6 +206,13 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                 // receive buffers
                 std::vector<boost::asio::mutable_buffer> buffers;
 
+                // the zero-copy chunks of striped messages are received over
+                // this connection and its stripes
+                std::uint32_t zero_copy_chunks = buffer_.num_chunks_.first;
+                striped_ = (zero_copy_chunks & striped_message_flag) != 0;
+                buffer_.num_chunks_.first =
+                    zero_copy_chunks & ~striped_message_flag;
+
                 // determine the size of the chunk buffer
                 std::size_t num_zero_copy_chunks =
                     static_cast<std::size_t>(
@@ -265,6 +308,12 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                         boost::asio::buffer(buffer_.chunks_[i].data(), chunk_size));
                 }
 
+                if (striped_)
+                {
+                    read_parts(buffers, handler);
+                    return;
+                }
+
                 // Start an asynchronous call to receive the data.
                 void (receiver::*f)(boost::system::error_code const&,
                         Handler)
@@ -293,6 +342,138 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
             }
         }
 
+        /// Start reading the parts of the zero-copy chunks of a striped
+        /// message, the first part is read from this connection, all others
+        /// from its stripes.
+        template <typename Handler>
+        void read_parts(std::vector<boost::asio::mutable_buffer> const& chunks,
+            Handler handler)
+        {
+            std::vector<std::shared_ptr<receiver> > stripes;
+            if (stripes_id_ != 0)
+                stripes = parcelport_.get_stripes(stripes_id_);
+
+            if (stripes.empty() || stripes.size() != num_stripes_)
+            {
+                // report this problem back to the handler
+                handler(boost::asio::error::make_error_code(
+                    boost::asio::error::operation_not_supported));
+                --operation_in_flight_;
+                return;
+            }
+
+            std::uint64_t bytes = 0;
+            for (boost::asio::mutable_buffer const& b : chunks)
+                bytes += boost::asio::buffer_size(b);
+
+            std::size_t const num_parts = num_stripes_ + 1;
+
+            stripe_error_ = boost::system::error_code();
+            pending_reads_ = num_parts;
+
+            void (receiver::*f)(boost::system::error_code const&, Handler)
+                = &receiver::handle_read_part<Handler>;
+
+            for (std::size_t i = 0; i != num_stripes_; ++i)
+            {
+                std::vector<boost::asio::mutable_buffer> part;
+                append_stripe(part, chunks,
+                    stripe_begin(bytes, i + 1, num_parts),
+                    stripe_begin(bytes, i + 2, num_parts));
+
+                stripes[i]->async_read_part(part,
+                    util::bind(f, shared_from_this(),
+                        boost::asio::placeholders::error,
+                        util::protect(handler)));
+            }
+
+            std::vector<boost::asio::mutable_buffer> part;
+            append_stripe(part, chunks, 0, stripe_begin(bytes, 1, num_parts));
+
+            async_read_part(part,
+                util::bind(f, shared_from_this(),
+                    boost::asio::placeholders::error,
+                    util::protect(handler)));
+        }
+
+        /// Handle the completed read of one part of a striped message.
+        template <typename Handler>
+        void handle_read_part(boost::system::error_code const& e,
+            Handler handler)
+        {
+            {
+                std::lock_guard<mutex_type> l(stripe_mtx_);
+                if (e && !stripe_error_)
+                    stripe_error_ = e;
+            }
+
+            if (--pending_reads_ == 0)
+                handle_read_data(stripe_error_, handler);
+        }
+
+        /// Handle the announcement of a connection which is accompanied by
+        /// stripes or of one of its stripes.
+        template <typename Handler>
+        void handle_announcement(Handler handler)
+        {
+            std::uint64_t const id = buffer_.data_size_;
+            std::size_t const index = static_cast<std::size_t>(
+                static_cast<std::uint32_t>(buffer_.num_chunks_.first));
+            std::size_t const count = static_cast<std::size_t>(
+                static_cast<std::uint32_t>(buffer_.num_chunks_.second));
+
+            buffer_.size_ = 0;
+            buffer_.data_size_ = 0;
+            buffer_.num_chunks_ =
+                parcel_buffer_type::count_chunks_type(0, 0);
+
+            // stripes are not read from anymore, the connection they
+            // belong to reads the parts of the messages from them
+            void (receiver::*f)(boost::system::error_code const&,
+                    Handler) = nullptr;
+            if (index == 0)
+            {
+                stripes_id_ = id;
+                num_stripes_ = count;
+                f = &receiver::handle_write_ack<Handler>;
+            }
+            else
+            {
+                parcelport_.add_stripe(id, index, count, shared_from_this());
+                f = &receiver::handle_write_stripe_ack<Handler>;
+            }
+
+            ++operation_in_flight_;
+            ack_ = true;
+            {
+                std::unique_lock<mutex_type> lk(mtx_);
+                if(!socket_.is_open())
+                {
+                    lk.unlock();
+                    // report this problem back to the handler
+                    handler(boost::asio::error::make_error_code(
+                        boost::asio::error::not_connected));
+                    --operation_in_flight_;
+                    return;
+                }
+                boost::asio::async_write(socket_,
+                    boost::asio::buffer(&ack_, sizeof(ack_)),
+                    util::bind(f, shared_from_this(),
+                        boost::asio::placeholders::error,
+                        util::protect(handler)));
+            }
+        }
+
+        template <typename Handler>
+        void handle_write_stripe_ack(boost::system::error_code const& e,
+            Handler handler)
+        {
+            HPX_ASSERT(operation_in_flight_ != 0);
+            if (e)
+                handler(e);
+            --operation_in_flight_;
+        }
+
         /// Handle a completed read of message data.
         template <typename Handler>
         void handle_read_data(boost::system::error_code const& e,
@@ -316,8 +497,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                     = &receiver::handle_write_ack<Handler>;
 
                 // decode the received parcels.
-                decode_parcels(parcelport_, std::move(buffer_), -1);
-                buffer_ = parcel_buffer_type();
+                decode_parcels_in_place(parcelport_, buffer_, -1);
 
                 ack_ = true;
                 {
@@ -371,6 +551,15 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 
         mutex_type mtx_;
         hpx::util::atomic_count operation_in_flight_;
+
+        /// The stripes accompanying this connection and the state of reading
+        /// the parts of a striped message
+        std::uint64_t stripes_id_;
+        std::size_t num_stripes_;
+        bool striped_;
+        mutex_type stripe_mtx_;
+        std::atomic<std::size_t> pending_reads_;
+        boost::system::error_code stripe_error_;
     };
 }}}}
 
@@ -14,9 +14,11 @@
 #if defined(HPX_HAVE_PARCELPORT_TCP)
 
 #include <hpx/config/asio.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/performance_counters/parcels/data_point.hpp>
 #include <hpx/performance_counters/parcels/gatherer.hpp>
 #include <hpx/plugins/parcelport/tcp/locality.hpp>
+#include <hpx/plugins/parcelport/tcp/stripes.hpp>
 #include <hpx/runtime/parcelset/locality.hpp>
 #include <hpx/runtime/parcelset/parcelport.hpp>
 #include <hpx/runtime/parcelset/parcelport_connection.hpp>
@@ -36,8 +38,11 @@
 #include <boost/asio/read.hpp>
 #include <boost/asio/write.hpp>
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -59,6 +64,9 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
           , there_(locality_id)
           , timer_()
           , pp_(pp)
+          , stripe_threshold_(0)
+          , pending_writes_(0)
+          , stripe_bytes_(0)
         {
         }
 
@@ -70,11 +78,28 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                 socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
                 socket_.close(ec);    // close the socket to give it back to the OS
             }
+            for (std::unique_ptr<boost::asio::ip::tcp::socket>& s : stripes_)
+            {
+                boost::system::error_code ec;
+                s->shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+                s->close(ec);
+            }
         }
 
         /// Get the socket associated with the parcelport_connection.
         boost::asio::ip::tcp::socket& socket() { return socket_; }
 
+        /// Set the connections the zero-copy chunks of messages with at
+        /// least threshold bytes of zero-copy chunks are split over (see
+        /// stripes.hpp). The connections have been announced already.
+        void set_stripes(
+            std::vector<std::unique_ptr<boost::asio::ip::tcp::socket> >&& stripes,
+            std::size_t threshold)
+        {
+            stripes_ = std::move(stripes);
+            stripe_threshold_ = threshold;
+        }
+
         parcelset::locality const& destination() const
         {
             return there_;
@@ -124,48 +149,109 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
             buffer_.data_point_.time_ = timer_.elapsed_nanoseconds();
 
             // Write the serialized data to the socket. We use "gather-write"
-            // to send both the header and the data in a single write operation.
-            std::vector<boost::asio::const_buffer> buffers;
-            buffers.push_back(boost::asio::buffer(&buffer_.size_,
-                sizeof(buffer_.size_)));
-            buffers.push_back(boost::asio::buffer(&buffer_.data_size_,
-                sizeof(buffer_.data_size_)));
+            // to send the header, the chunk table, the data, and all zero-copy
+            // chunks in a single write operation (a single sendmsg, as long
+            // as the number of buffers does not exceed the limit of asio).
+            // The fields of the header are copied next to each other to
+            // occupy only one I/O vector, the list of buffers is reused for
+            // all parcels sent through this connection.
+            static_assert(sizeof(header) == sizeof(buffer_.size_) +
+                    sizeof(buffer_.data_size_) + sizeof(buffer_.num_chunks_),
+                "the parcel header should not contain any padding");
+
+            header_.size_ = buffer_.size_;
+            header_.data_size_ = buffer_.data_size_;
+            header_.num_chunks_ = buffer_.num_chunks_;
 
-            // add chunk description
-            buffers.push_back(boost::asio::buffer(&buffer_.num_chunks_,
-                sizeof(buffer_.num_chunks_)));
+            buffers_.clear();
+            buffers_.push_back(boost::asio::buffer(&header_, sizeof(header_)));
+
+            std::size_t num_stripes = 0;
 
             std::vector<parcel_buffer_type::transmission_chunk_type>& chunks =
                 buffer_.transmission_chunks_;
             if (!chunks.empty()) {
-                buffers.push_back(
+                buffers_.push_back(
                     boost::asio::buffer(chunks.data(), chunks.size() *
                         sizeof(parcel_buffer_type::transmission_chunk_type)));
 
                 // add main buffer holding data which was serialized normally
-                buffers.push_back(boost::asio::buffer(buffer_.data_));
+                buffers_.push_back(boost::asio::buffer(buffer_.data_));
 
                 // now add chunks themselves, those hold zero-copy serialized chunks
+                std::uint64_t zero_copy_bytes = 0;
+                chunk_buffers_.clear();
                 for (serialization::serialization_chunk& c : buffer_.chunks_)
                 {
                     if (c.type_ == serialization::chunk_type_pointer)
-                        buffers.push_back(boost::asio::buffer(c.data_.cpos_, c.size_));
+                    {
+                        chunk_buffers_.push_back(
+                            boost::asio::buffer(c.data_.cpos_, c.size_));
+                        zero_copy_bytes += c.size_;
+                    }
+                }
+
+                if (!stripes_.empty() && zero_copy_bytes >= stripe_threshold_)
+                {
+                    num_stripes = stripes_.size();
+                    header_.num_chunks_.first =
+                        static_cast<std::uint32_t>(buffer_.num_chunks_.first) |
+                        striped_message_flag;
+
+                    // the first part is sent together with the message
+                    append_stripe(buffers_, chunk_buffers_, 0,
+                        stripe_begin(zero_copy_bytes, 1, num_stripes + 1));
+
+                    stripe_buffers_.resize(num_stripes);
+                    for (std::size_t i = 0; i != num_stripes; ++i)
+                    {
+                        stripe_buffers_[i].clear();
+                        append_stripe(stripe_buffers_[i], chunk_buffers_,
+                            stripe_begin(zero_copy_bytes, i + 1, num_stripes + 1),
+                            stripe_begin(zero_copy_bytes, i + 2, num_stripes + 1));
+                    }
+                }
+                else
+                {
+                    buffers_.insert(buffers_.end(),
+                        chunk_buffers_.begin(), chunk_buffers_.end());
                 }
             }
             else {
                 // add main buffer holding data which was serialized normally
-                buffers.push_back(boost::asio::buffer(buffer_.data_));
+                buffers_.push_back(boost::asio::buffer(buffer_.data_));
             }
 
             // this additional wrapping of the handler into a bind object is
             // needed to keep  this parcelport_connection object alive for the whole
             // write operation
-            void (sender::*f)(boost::system::error_code const&, std::size_t)
-                = &sender::handle_write;
-
             using util::placeholders::_1;
             using util::placeholders::_2;
-            boost::asio::async_write(socket_, buffers,
+
+            if (num_stripes == 0)
+            {
+                void (sender::*f)(boost::system::error_code const&, std::size_t)
+                    = &sender::handle_write;
+
+                boost::asio::async_write(socket_, buffers_,
+                    util::bind(f, shared_from_this(), _1, _2));
+                return;
+            }
+
+            // the message is complete once all parts have been written
+            void (sender::*f)(boost::system::error_code const&, std::size_t)
+                = &sender::handle_write_part;
+
+            stripe_error_ = boost::system::error_code();
+            stripe_bytes_ = 0;
+            pending_writes_ = num_stripes + 1;
+
+            for (std::size_t i = 0; i != num_stripes; ++i)
+            {
+                boost::asio::async_write(*stripes_[i], stripe_buffers_[i],
+                    util::bind(f, shared_from_this(), _1, _2));
+            }
+            boost::asio::async_write(socket_, buffers_,
                 util::bind(f, shared_from_this(), _1, _2));
         }
 
@@ -175,6 +261,21 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
             handler.reset();
         }
 
+        /// handle the completed write of one part of a striped message
+        void handle_write_part(
+            boost::system::error_code const& e, std::size_t bytes)
+        {
+            {
+                std::lock_guard<hpx::lcos::local::spinlock> l(stripe_mtx_);
+                if (e && !stripe_error_)
+                    stripe_error_ = e;
+                stripe_bytes_ += bytes;
+            }
+
+            if (--pending_writes_ == 0)
+                handle_write(stripe_error_, stripe_bytes_);
+        }
+
         /// handle completed write operation
         void handle_write(boost::system::error_code const& e, std::size_t bytes)
         {
@@ -240,7 +341,9 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 #if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
             state_ = state_handle_read_ack;
 #endif
-            buffer_.clear();
+            // keep the memory of the buffer for the next message
+            buffer_.clear(static_cast<std::size_t>(
+                pp_->get_max_outbound_message_size()));
             // Call post-processing handler, which will send remaining pending
             // parcels. Pass along the connection so it can be reused if more
             // parcels have to be sent.
@@ -258,6 +361,19 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
         /// Socket for the parcelport_connection.
         boost::asio::ip::tcp::socket socket_;
 
+        /// The header of the parcel being sent, in the order the fields are
+        /// expected by the receiver.
+        struct header
+        {
+            util::integer::ulittle64_t size_;
+            util::integer::ulittle64_t data_size_;
+            parcel_buffer_type::count_chunks_type num_chunks_;
+        };
+        header header_;
+
+        /// The buffers of the parcel being sent.
+        std::vector<boost::asio::const_buffer> buffers_;
+
         bool ack_;
 
         /// the other (receiving) end of this connection
@@ -275,6 +391,19 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                 , std::shared_ptr<sender>
                 )
         > postprocess_handler_;
+
+        /// The additional connections to the destination, the buffers of the
+        /// zero-copy chunks and of the parts sent over each stripe.
+        std::vector<std::unique_ptr<boost::asio::ip::tcp::socket> > stripes_;
+        std::size_t stripe_threshold_;
+        std::vector<boost::asio::const_buffer> chunk_buffers_;
+        std::vector<std::vector<boost::asio::const_buffer> > stripe_buffers_;
+
+        /// The state of writing the parts of a striped message
+        hpx::lcos::local::spinlock stripe_mtx_;
+        std::atomic<std::size_t> pending_writes_;
+        boost::system::error_code stripe_error_;
+        std::size_t stripe_bytes_;
     };
 }}}}
 
@@ -0,0 +1,91 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_TCP_STRIPES_HPP
+#define HPX_PARCELSET_POLICIES_TCP_STRIPES_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_TCP)
+
+#include <hpx/runtime/parcelset/parcel_buffer.hpp>
+#include <hpx/util/integer/endian.hpp>
+
+#include <boost/asio/buffer.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace tcp
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A connection may be accompanied by additional connections to the same
+    // locality (stripes), the zero-copy chunks of large messages are split
+    // over all of those. Each of the connections announces itself to the
+    // receiver right after it was established, the announcement has the
+    // layout of a message header:
+    //
+    //      size_       stripe_announcement_tag
+    //      data_size_  the id of the connection the stripe belongs to
+    //      num_chunks_ (index of the stripe, number of stripes)
+    //
+    // The connection itself announces itself with index zero. Messages whose
+    // zero-copy chunks are split have the striped_message_flag set in the
+    // number of zero-copy chunks. The n-th part of the concatenated zero-copy
+    // chunks is sent over the n-th connection, the first part over the
+    // connection sending the message.
+    HPX_STATIC_CONSTEXPR std::uint64_t stripe_announcement_tag =
+        ~std::uint64_t(0);
+
+    HPX_STATIC_CONSTEXPR std::uint32_t striped_message_flag =
+        std::uint32_t(1) << 31;
+
+    struct stripe_announcement
+    {
+        util::integer::ulittle64_t size_;
+        util::integer::ulittle64_t data_size_;
+        parcel_buffer<std::vector<char> >::count_chunks_type num_chunks_;
+    };
+
+    // Return the first byte of the given part if the given number of bytes
+    // is split into num_parts parts
+    inline std::uint64_t stripe_begin(std::uint64_t bytes,
+        std::size_t part, std::size_t num_parts)
+    {
+        return part == num_parts ? bytes : (bytes / num_parts) * part;
+    }
+
+    // Append the buffers covering the bytes [begin, end) of the concatenated
+    // buffers to stripe.
+    template <typename Buffer>
+    void append_stripe(std::vector<Buffer>& stripe,
+        std::vector<Buffer> const& buffers, std::uint64_t begin,
+        std::uint64_t end)
+    {
+        std::uint64_t pos = 0;
+        for (Buffer const& b : buffers)
+        {
+            if (pos >= end)
+                break;
+
+            std::uint64_t const size = boost::asio::buffer_size(b);
+            if (pos + size > begin)
+            {
+                std::size_t const first = static_cast<std::size_t>(
+                    begin > pos ? begin - pos : 0);
+                std::size_t const last = static_cast<std::size_t>(
+                    (std::min)(end - pos, size));
+                stripe.push_back(boost::asio::buffer(b + first, last - first));
+            }
+            pos += size;
+        }
+    }
+}}}}
+
+#endif
+
+#endif
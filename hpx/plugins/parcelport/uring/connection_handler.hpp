@@ -0,0 +1,163 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_URING_CONNECTION_HANDLER_HPP
+#define HPX_PARCELSET_POLICIES_URING_CONNECTION_HANDLER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_URING)
+#include <hpx/config/asio.hpp>
+
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/plugins/parcelport/uring/io_uring.hpp>
+#include <hpx/plugins/parcelport/uring/locality.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/parcelset/parcelport_impl.hpp>
+#include <hpx/util_fwd.hpp>
+
+#include <boost/asio/ip/host_name.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace parcelset
+{
+    namespace policies { namespace uring
+    {
+        class receiver;
+        class sender;
+        class HPX_EXPORT connection_handler;
+    }}
+
+    template <>
+    struct connection_handler_traits<policies::uring::connection_handler>
+    {
+        typedef policies::uring::sender connection_type;
+        typedef std::true_type  send_early_parcel;
+        typedef std::true_type  do_background_work;
+        typedef std::false_type send_immediate_parcels;
+
+        static const char * type()
+        {
+            return "uring";
+        }
+
+        static const char * pool_name()
+        {
+            return "parcel-pool-uring";
+        }
+
+        static const char * pool_name_postfix()
+        {
+            return "-uring";
+        }
+    };
+
+    namespace policies { namespace uring
+    {
+        parcelset::locality parcelport_address(
+            util::runtime_configuration const& ini);
+
+        /// A parcelport using TCP sockets, where all data is transferred
+        /// through io_uring. The ring is polled from the background work of
+        /// the HPX worker threads, the threads of the io_service pool are
+        /// used only while the runtime is starting (before any background
+        /// work is done).
+        class HPX_EXPORT connection_handler
+          : public parcelport_impl<connection_handler>
+        {
+            typedef parcelport_impl<connection_handler> base_type;
+        public:
+
+            static std::vector<std::string> runtime_configuration()
+            {
+                std::vector<std::string> lines;
+
+                return lines;
+            }
+
+            connection_handler(util::runtime_configuration const& ini,
+                util::function_nonser<void(std::size_t, char const*)> const&
+                    on_start_thread,
+                util::function_nonser<void(std::size_t, char const*)> const&
+                    on_stop_thread);
+
+            ~connection_handler();
+
+            /// Start the handling of connections.
+            bool do_run();
+
+            /// Stop the handling of connectons.
+            void do_stop();
+
+            /// Return the name of this locality
+            std::string get_locality_name() const
+            {
+                return boost::asio::ip::host_name();
+            }
+
+            std::shared_ptr<sender> create_connection(
+                parcelset::locality const& l, error_code& ec);
+
+            parcelset::locality agas_locality(util::runtime_configuration const& ini)
+                const;
+
+            parcelset::locality create_locality() const;
+
+            /// Submit the queued operations and handle completed ones.
+            bool background_work(std::size_t num_thread);
+
+            /// Remove a connection which has been closed
+            void handle_read_completion(boost::system::error_code const& e,
+                std::shared_ptr<receiver> receiver_conn);
+
+        private:
+            /// Accept incoming connections on a listening socket.
+            struct acceptor : operation
+            {
+                acceptor(connection_handler& handler, int fd)
+                  : operation(&connection_handler::handle_accept)
+                  , handler_(handler)
+                  , fd_(fd)
+                {}
+
+                connection_handler& handler_;
+                int fd_;
+            };
+
+            static void handle_accept(operation& op, int result);
+            void async_accept(acceptor& a);
+
+            void io_service_work();
+
+            std::shared_ptr<ring> ring_;
+            std::atomic<bool> stopped_;
+
+            /// The sockets used to listen for incoming connections.
+            std::vector<std::unique_ptr<acceptor> > acceptors_;
+
+            /// The list of accepted connections
+            mutable lcos::local::spinlock connections_mtx_;
+
+            typedef std::set<std::shared_ptr<receiver> > accepted_connections_set;
+            accepted_connections_set accepted_connections_;
+        };
+    }}
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
+
+#endif
@@ -0,0 +1,81 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_URING_HEADER_HPP
+#define HPX_PARCELSET_POLICIES_URING_HEADER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_URING)
+
+#include <hpx/plugins/parcelport/uring/io_uring.hpp>
+#include <hpx/util/integer/endian.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace hpx { namespace parcelset { namespace policies { namespace uring
+{
+    /// The layout of the control block of a connection. It holds the header
+    /// of the parcel buffer being transferred (in the same format as used by
+    /// the TCP parcelport), followed by the acknowledgement byte sent back by
+    /// the receiver.
+    struct header
+    {
+        enum data_pos
+        {
+            pos_size             = 0,
+            pos_data_size        = 8,
+            pos_numchunks_first  = 16,
+            pos_numchunks_second = 20,
+            pos_ack              = 24
+        };
+
+        static constexpr std::size_t size = pos_ack;
+        static constexpr std::size_t ack_size = 1;
+
+        static_assert(pos_ack + ack_size <= ring::control_block_size,
+            "the control block should hold the header and the "
+            "acknowledgement");
+
+        template <typename Buffer>
+        static void save(char* control, Buffer const& buffer)
+        {
+            set<pos_size>(control, buffer.size_);
+            set<pos_data_size>(control, buffer.data_size_);
+            set<pos_numchunks_first>(control, buffer.num_chunks_.first);
+            set<pos_numchunks_second>(control, buffer.num_chunks_.second);
+        }
+
+        template <typename Buffer>
+        static void load(char const* control, Buffer& buffer)
+        {
+            get<pos_size>(control, buffer.size_);
+            get<pos_data_size>(control, buffer.data_size_);
+            get<pos_numchunks_first>(control, buffer.num_chunks_.first);
+            get<pos_numchunks_second>(control, buffer.num_chunks_.second);
+        }
+
+    private:
+        // the integer types used by the parcel buffer are stored in little
+        // endian byte order already
+        template <std::size_t Pos, typename T>
+        static void set(char* control, T const& t)
+        {
+            std::memcpy(control + Pos, &t, sizeof(T));
+        }
+
+        template <std::size_t Pos, typename T>
+        static void get(char const* control, T& t)
+        {
+            std::memcpy(&t, control + Pos, sizeof(T));
+        }
+    };
+}}}}
+
+#endif
+
+#endif
@@ -0,0 +1,240 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_URING_IO_URING_HPP
+#define HPX_PARCELSET_POLICIES_URING_IO_URING_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_URING)
+
+#include <hpx/util/assert.hpp>
+#include <hpx/util/io_uring.hpp>
+
+#include <linux/io_uring.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace parcelset { namespace policies { namespace uring
+{
+    using hpx::util::uring::operation;
+    using hpx::util::uring::ring;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A connected socket used with the ring. The socket is added to the
+    /// table of fixed files, if possible.
+    class socket
+    {
+    public:
+        HPX_NON_COPYABLE(socket);
+
+        socket(std::shared_ptr<ring> r, int fd)
+          : ring_(std::move(r))
+          , fd_(fd)
+          , index_(ring_->register_file(fd))
+          , control_(ring_->control_block(index_))
+        {
+            if (control_ == nullptr)
+                control_ = local_control_;
+        }
+
+        ~socket()
+        {
+            close();
+        }
+
+        ring& get_ring() const noexcept
+        {
+            return *ring_;
+        }
+
+        int native_handle() const noexcept
+        {
+            return fd_;
+        }
+
+        bool is_open() const noexcept
+        {
+            return fd_ != -1;
+        }
+
+        /// Shut down both directions of the connection, this aborts all
+        /// pending operations.
+        void shutdown() noexcept
+        {
+            if (fd_ != -1)
+                ::shutdown(fd_, SHUT_RDWR);
+        }
+
+        /// Remove the socket from the table of fixed files and close it.
+        void close() noexcept
+        {
+            if (fd_ != -1)
+            {
+                ring_->unregister_file(index_);
+                ::close(fd_);
+                fd_ = -1;
+                index_ = -1;
+            }
+        }
+
+        /// Return the control block of this connection, which is used for
+        /// the fixed size parts of the protocol.
+        char* control_block() const noexcept
+        {
+            return control_;
+        }
+
+        /// Prepare a transfer from or into the control block. Only reads use
+        /// the registered buffer, writes have to be sent as a message to
+        /// suppress SIGPIPE if the other end has closed the connection.
+        void prepare_control(io_uring_sqe& sqe, bool write, std::size_t offset,
+            std::size_t size) const noexcept
+        {
+            HPX_ASSERT(offset + size <= ring::control_block_size);
+
+            if (write)
+            {
+                sqe.opcode = IORING_OP_SEND;
+                sqe.msg_flags = MSG_NOSIGNAL;
+            }
+            else if (control_ != local_control_)
+            {
+                sqe.opcode = IORING_OP_READ_FIXED;
+                sqe.buf_index = 0;
+            }
+            else
+            {
+                sqe.opcode = IORING_OP_RECV;
+            }
+            sqe.addr = reinterpret_cast<std::uint64_t>(control_ + offset);
+            sqe.len = static_cast<std::uint32_t>(size);
+            set_file(sqe);
+        }
+
+        /// Prepare a scatter/gather transfer.
+        void prepare_message(io_uring_sqe& sqe, bool write,
+            msghdr const* msg) const noexcept
+        {
+            sqe.opcode = write ? IORING_OP_SENDMSG : IORING_OP_RECVMSG;
+            sqe.addr = reinterpret_cast<std::uint64_t>(msg);
+            sqe.len = 1;
+            sqe.msg_flags = write ? MSG_NOSIGNAL : MSG_WAITALL;
+            set_file(sqe);
+        }
+
+    private:
+        void set_file(io_uring_sqe& sqe) const noexcept
+        {
+            if (index_ != -1)
+            {
+                sqe.fd = index_;
+                sqe.flags |= IOSQE_FIXED_FILE;
+            }
+            else
+            {
+                sqe.fd = fd_;
+            }
+        }
+
+        std::shared_ptr<ring> ring_;
+        int fd_;
+        int index_;
+        char* control_;
+        char local_control_[ring::control_block_size];
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The list of buffers of a scatter/gather transfer, which may complete
+    /// in several pieces.
+    class message_buffers
+    {
+    public:
+        message_buffers()
+          : first_(0)
+        {
+            std::memset(&msg_, 0, sizeof(msg_));
+        }
+
+        void clear()
+        {
+            iov_.clear();
+            first_ = 0;
+        }
+
+        void add(void const* data, std::size_t size)
+        {
+            if (size == 0)
+                return;
+
+            iovec iov;
+            iov.iov_base = const_cast<void*>(data);
+            iov.iov_len = size;
+            iov_.push_back(iov);
+        }
+
+        bool empty() const noexcept
+        {
+            return first_ == iov_.size();
+        }
+
+        /// Return the message header describing the remaining buffers.
+        msghdr const* get()
+        {
+            HPX_ASSERT(!empty());
+
+            std::size_t count = iov_.size() - first_;
+            if (count > max_iov)
+                count = max_iov;
+
+            msg_.msg_iov = iov_.data() + first_;
+            msg_.msg_iovlen = count;
+            return &msg_;
+        }
+
+        /// Account for the given number of transferred bytes.
+        void consume(std::size_t bytes)
+        {
+            while (bytes != 0)
+            {
+                HPX_ASSERT(!empty());
+
+                iovec& iov = iov_[first_];
+                if (bytes < iov.iov_len)
+                {
+                    iov.iov_base = static_cast<char*>(iov.iov_base) + bytes;
+                    iov.iov_len -= bytes;
+                    return;
+                }
+
+                bytes -= iov.iov_len;
+                ++first_;
+            }
+        }
+
+    private:
+        // the number of buffers the kernel accepts for a single message
+        static constexpr std::size_t max_iov = 1024;
+
+        std::vector<iovec> iov_;
+        std::size_t first_;
+        msghdr msg_;
+    };
+}}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
+
+#endif
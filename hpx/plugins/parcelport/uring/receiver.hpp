@@ -0,0 +1,312 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_URING_RECEIVER_HPP
+#define HPX_PARCELSET_POLICIES_URING_RECEIVER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_URING)
+
+#include <hpx/config/asio.hpp>
+#include <hpx/performance_counters/parcels/data_point.hpp>
+#include <hpx/performance_counters/parcels/gatherer.hpp>
+#include <hpx/plugins/parcelport/uring/connection_handler.hpp>
+#include <hpx/plugins/parcelport/uring/header.hpp>
+#include <hpx/plugins/parcelport/uring/io_uring.hpp>
+#include <hpx/runtime/parcelset/decode_parcels.hpp>
+#include <hpx/runtime/parcelset/parcelport_connection.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <boost/asio/error.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace uring
+{
+    class receiver
+      : public parcelport_connection<receiver, std::vector<char>, std::vector<char> >
+      , private operation
+    {
+        enum state
+        {
+            state_idle,
+            state_read_header,
+            state_read_chunk_data,
+            state_read_data,
+            state_write_ack
+        };
+
+    public:
+        receiver(std::shared_ptr<ring> r, int fd, std::uint64_t max_inbound_size,
+            connection_handler& parcelport)
+          : operation(&receiver::handle_completion)
+          , socket_(std::move(r), fd)
+          , max_inbound_size_(max_inbound_size)
+          , state_(state_idle)
+          , received_(0)
+          , parcelport_(parcelport)
+          , timer_()
+        {}
+
+        /// Get the socket associated with the parcelport_connection.
+        uring::socket& socket() { return socket_; }
+
+        /// Start reading parcels from the socket. The connection is kept
+        /// alive until the connection is closed, or an error occurs.
+        void async_read()
+        {
+            self_ = shared_from_this();
+            read_header();
+        }
+
+        /// Abort the pending read operation, the connection is closed once
+        /// that operation has completed.
+        void shutdown()
+        {
+            socket_.shutdown();
+        }
+
+    private:
+        void read_header()
+        {
+            HPX_ASSERT(buffer_.data_.empty());
+            // Store the time of the begin of the read operation
+            performance_counters::parcels::data_point& data = buffer_.data_point_;
+            data.time_ = timer_.elapsed_nanoseconds();
+            data.serialization_time_ = 0;
+            data.bytes_ = 0;
+            data.num_parcels_ = 0;
+
+            // Issue a read operation to read the message header into the
+            // control block.
+            state_ = state_read_header;
+            received_ = 0;
+            submit_read_control(header::size);
+        }
+
+        void submit_read_control(std::size_t size)
+        {
+            socket_.get_ring().submit(*this,
+                [this, size](io_uring_sqe& sqe)
+                {
+                    socket_.prepare_control(sqe, false, received_,
+                        size - received_);
+                });
+        }
+
+        void submit_read()
+        {
+            msghdr const* msg = buffers_.get();
+            socket_.get_ring().submit(*this,
+                [this, msg](io_uring_sqe& sqe)
+                {
+                    socket_.prepare_message(sqe, false, msg);
+                });
+        }
+
+        void submit_write_ack()
+        {
+            socket_.get_ring().submit(*this,
+                [this](io_uring_sqe& sqe)
+                {
+                    socket_.prepare_control(sqe, true, header::pos_ack,
+                        header::ack_size);
+                });
+        }
+
+        static void handle_completion(operation& op, int result)
+        {
+            receiver& this_ = static_cast<receiver&>(op);
+
+            if (result <= 0)
+            {
+                // the connection was closed by the other end (or shut down)
+                this_.handle_error(result == 0 ?
+                    boost::asio::error::make_error_code(
+                        boost::asio::error::eof) :
+                    boost::system::error_code(-result,
+                        boost::system::system_category()));
+                return;
+            }
+
+            switch (this_.state_)
+            {
+            case state_read_header:
+                this_.received_ += std::size_t(result);
+                if (this_.received_ != header::size)
+                    this_.submit_read_control(header::size);
+                else
+                    this_.handle_read_header();
+                break;
+
+            case state_read_chunk_data:
+                this_.buffers_.consume(std::size_t(result));
+                if (!this_.buffers_.empty())
+                    this_.submit_read();
+                else
+                    this_.handle_read_chunk_data();
+                break;
+
+            case state_read_data:
+                this_.buffers_.consume(std::size_t(result));
+                if (!this_.buffers_.empty())
+                    this_.submit_read();
+                else
+                    this_.handle_read_data();
+                break;
+
+            case state_write_ack:
+                // Issue a read operation to read the next parcel.
+                this_.read_header();
+                break;
+
+            default:
+                HPX_ASSERT(false);
+                break;
+            }
+        }
+
+        /// Handle a completed read of the message header.
+        void handle_read_header()
+        {
+            header::load(socket_.control_block(), buffer_);
+
+            // Determine the length of the serialized data.
+            std::uint64_t inbound_size = buffer_.size_;
+
+            if (inbound_size > max_inbound_size_)
+            {
+                // report this problem back to the handler
+                handle_error(boost::asio::error::make_error_code(
+                    boost::asio::error::operation_not_supported));
+                return;
+            }
+
+            buffer_.data_point_.bytes_ = static_cast<std::size_t>(inbound_size);
+
+            // determine the size of the chunk buffer
+            std::size_t num_zero_copy_chunks =
+                static_cast<std::size_t>(
+                    static_cast<std::uint32_t>(buffer_.num_chunks_.first));
+            std::size_t num_non_zero_copy_chunks =
+                static_cast<std::size_t>(
+                    static_cast<std::uint32_t>(buffer_.num_chunks_.second));
+
+            buffers_.clear();
+            if (num_zero_copy_chunks != 0) {
+                typedef parcel_buffer_type::transmission_chunk_type
+                    transmission_chunk_type;
+
+                std::vector<transmission_chunk_type>& chunks =
+                    buffer_.transmission_chunks_;
+
+                chunks.resize(static_cast<std::size_t>(
+                    num_zero_copy_chunks + num_non_zero_copy_chunks));
+
+                buffers_.add(chunks.data(), chunks.size() *
+                    sizeof(transmission_chunk_type));
+
+                // add main buffer holding data which was serialized normally
+                buffer_.data_.resize(static_cast<std::size_t>(inbound_size));
+                buffers_.add(buffer_.data_.data(), buffer_.data_.size());
+
+                state_ = state_read_chunk_data;
+            }
+            else {
+                // add main buffer holding data which was serialized normally
+                buffer_.data_.resize(static_cast<std::size_t>(inbound_size));
+                buffers_.add(buffer_.data_.data(), buffer_.data_.size());
+
+                state_ = state_read_data;
+            }
+
+            if (buffers_.empty())
+                handle_read_data();
+            else
+                submit_read();
+        }
+
+        /// Handle a completed read of the chunk table and the message data.
+        void handle_read_chunk_data()
+        {
+            // add appropriately sized chunk buffers for the zero-copy data
+            std::size_t num_zero_copy_chunks =
+                static_cast<std::size_t>(
+                    static_cast<std::uint32_t>(buffer_.num_chunks_.first));
+
+            buffers_.clear();
+            buffer_.chunks_.resize(num_zero_copy_chunks);
+            for (std::size_t i = 0; i != num_zero_copy_chunks; ++i)
+            {
+                std::size_t chunk_size = static_cast<std::size_t>(
+                    buffer_.transmission_chunks_[i].second);
+                buffer_.chunks_[i].resize(chunk_size);
+                buffers_.add(buffer_.chunks_[i].data(), chunk_size);
+            }
+
+            state_ = state_read_data;
+            if (buffers_.empty())
+                handle_read_data();
+            else
+                submit_read();
+        }
+
+        /// Handle a completed read of message data.
+        void handle_read_data()
+        {
+            // complete data point and pass it along
+            buffer_.data_point_.time_ = timer_.elapsed_nanoseconds() -
+                buffer_.data_point_.time_;
+
+            // decode the received parcels.
+            decode_parcels_in_place(parcelport_, buffer_, -1);
+
+            // now send acknowledgment byte
+            socket_.control_block()[header::pos_ack] = 1;
+            state_ = state_write_ack;
+            submit_write_ack();
+        }
+
+        void handle_error(boost::system::error_code const& e)
+        {
+            std::shared_ptr<receiver> self(std::move(self_));
+            state_ = state_idle;
+
+            socket_.close();
+            parcelport_.handle_read_completion(e, std::move(self));
+        }
+
+        /// Socket for the parcelport_connection.
+        uring::socket socket_;
+
+        std::uint64_t max_inbound_size_;
+
+        /// The buffers of the parcel being received.
+        message_buffers buffers_;
+
+        state state_;
+        std::size_t received_;
+
+        // keeps this connection alive while an operation is in flight
+        std::shared_ptr<receiver> self_;
+
+        /// The handler used to process the incoming request.
+        connection_handler& parcelport_;
+
+        /// Counters and timers for parcels received.
+        util::high_resolution_timer timer_;
+    };
+}}}}
+
+#endif
+
+#endif
@@ -0,0 +1,296 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_URING_SENDER_HPP
+#define HPX_PARCELSET_POLICIES_URING_SENDER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_URING)
+
+#include <hpx/config/asio.hpp>
+#include <hpx/performance_counters/parcels/data_point.hpp>
+#include <hpx/performance_counters/parcels/gatherer.hpp>
+#include <hpx/plugins/parcelport/uring/header.hpp>
+#include <hpx/plugins/parcelport/uring/io_uring.hpp>
+#include <hpx/plugins/parcelport/uring/locality.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/parcelset/parcelport.hpp>
+#include <hpx/runtime/parcelset/parcelport_connection.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/state.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/deferred_call.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/unique_function.hpp>
+
+#include <boost/asio/error.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace uring
+{
+    class sender
+      : public parcelset::parcelport_connection<sender, std::vector<char> >
+      , private operation
+    {
+        using postprocess_handler_type = util::unique_function_nonser<void(
+            boost::system::error_code const&)>;
+
+        using parcel_postprocess_type = util::unique_function_nonser<void(
+                boost::system::error_code const&
+              , parcelset::locality const&
+              , std::shared_ptr<sender>
+            )>;
+
+        enum state
+        {
+            state_idle,
+            state_write,
+            state_read_ack
+        };
+
+    public:
+        /// Construct a sending parcelport_connection for a connected
+        /// socket.
+        sender(std::shared_ptr<ring> r, int fd,
+                parcelset::locality const& locality_id,
+                parcelset::parcelport* pp)
+          : operation(&sender::handle_completion)
+          , socket_(std::move(r), fd)
+          , state_(state_idle)
+          , received_(0)
+          , there_(locality_id)
+          , timer_()
+          , pp_(pp)
+        {
+        }
+
+        /// Get the socket associated with the parcelport_connection.
+        uring::socket& socket() { return socket_; }
+
+        parcelset::locality const& destination() const
+        {
+            return there_;
+        }
+
+        void verify_(parcelset::locality const & parcel_locality_id) const
+        {
+        }
+
+        template <typename Handler, typename ParcelPostprocess>
+        void async_write(Handler && handler,
+            ParcelPostprocess && parcel_postprocess)
+        {
+            HPX_ASSERT(state_ == state_idle);
+            HPX_ASSERT(!buffer_.data_.empty());
+            HPX_ASSERT(!handler_);
+            HPX_ASSERT(!postprocess_handler_);
+
+            handler_ = std::forward<Handler>(handler);
+            postprocess_handler_ = std::forward<ParcelPostprocess>(parcel_postprocess);
+            HPX_ASSERT(handler_);
+            HPX_ASSERT(postprocess_handler_);
+
+            /// Increment sends and begin timer.
+            buffer_.data_point_.time_ = timer_.elapsed_nanoseconds();
+
+            // Send the header (from the control block), the chunk table, the
+            // data, and all zero-copy chunks as a single message.
+            char* control = socket_.control_block();
+            header::save(control, buffer_);
+
+            buffers_.clear();
+            buffers_.add(control, header::size);
+
+            std::vector<parcel_buffer_type::transmission_chunk_type>& chunks =
+                buffer_.transmission_chunks_;
+            if (!chunks.empty()) {
+                buffers_.add(chunks.data(), chunks.size() *
+                    sizeof(parcel_buffer_type::transmission_chunk_type));
+
+                // add main buffer holding data which was serialized normally
+                buffers_.add(buffer_.data_.data(), buffer_.data_.size());
+
+                // now add chunks themselves, those hold zero-copy serialized chunks
+                for (serialization::serialization_chunk& c : buffer_.chunks_)
+                {
+                    if (c.type_ == serialization::chunk_type_pointer)
+                        buffers_.add(c.data_.cpos_, c.size_);
+                }
+            }
+            else {
+                // add main buffer holding data which was serialized normally
+                buffers_.add(buffer_.data_.data(), buffer_.data_.size());
+            }
+
+            // the connection is kept alive until the operation has completed
+            self_ = shared_from_this();
+            state_ = state_write;
+            submit_write();
+        }
+
+    private:
+        void submit_write()
+        {
+            msghdr const* msg = buffers_.get();
+            socket_.get_ring().submit(*this,
+                [this, msg](io_uring_sqe& sqe)
+                {
+                    socket_.prepare_message(sqe, true, msg);
+                });
+        }
+
+        void submit_read_ack()
+        {
+            socket_.get_ring().submit(*this,
+                [this](io_uring_sqe& sqe)
+                {
+                    socket_.prepare_control(sqe, false,
+                        header::pos_ack + received_, header::ack_size - received_);
+                });
+        }
+
+        static void handle_completion(operation& op, int result)
+        {
+            sender& this_ = static_cast<sender&>(op);
+
+            boost::system::error_code e;
+            if (result < 0)
+            {
+                e = boost::system::error_code(-result,
+                    boost::system::system_category());
+            }
+
+            if (this_.state_ == state_write)
+            {
+                if (!e)
+                {
+                    // continue until the whole message was sent
+                    this_.buffers_.consume(std::size_t(result));
+                    if (!this_.buffers_.empty())
+                    {
+                        this_.submit_write();
+                        return;
+                    }
+                }
+                this_.handle_write(e);
+            }
+            else
+            {
+                HPX_ASSERT(this_.state_ == state_read_ack);
+                if (!e)
+                {
+                    if (result == 0)
+                    {
+                        e = boost::asio::error::make_error_code(
+                            boost::asio::error::eof);
+                    }
+                    else if (++this_.received_ != header::ack_size)
+                    {
+                        this_.submit_read_ack();
+                        return;
+                    }
+                }
+                this_.handle_read_ack(e);
+            }
+        }
+
+        static void reset_handler(postprocess_handler_type handler)
+        {
+            handler.reset();
+        }
+
+        /// handle completed write operation
+        void handle_write(boost::system::error_code const& e)
+        {
+            // just call initial handler
+            handler_(e);
+
+            postprocess_handler_type handler;
+            std::swap(handler, handler_);
+
+            if (threads::threadmanager_is(state_running))
+            {
+                // the handler needs to be reset on an HPX thread (it destroys
+                // the parcel, which in turn might invoke HPX functions)
+                threads::register_thread_nullary(util::deferred_call(
+                    &sender::reset_handler, std::move(handler)));
+            }
+            else
+            {
+                reset_handler(std::move(handler));
+            }
+
+            if (e)
+            {
+                // inform post-processing handler of error as well
+                call_postprocess_handler(e);
+                return;
+            }
+
+            // complete data point and push back onto gatherer
+            buffer_.data_point_.time_ =
+                timer_.elapsed_nanoseconds() - buffer_.data_point_.time_;
+            pp_->add_sent_data(buffer_.data_point_);
+
+            // now handle the acknowledgment byte which is sent by the receiver
+            state_ = state_read_ack;
+            received_ = 0;
+            submit_read_ack();
+        }
+
+        void handle_read_ack(boost::system::error_code const& e)
+        {
+            // keep the memory of the buffer for the next message
+            buffer_.clear(static_cast<std::size_t>(
+                pp_->get_max_outbound_message_size()));
+            call_postprocess_handler(e);
+        }
+
+        // Call post-processing handler, which will send remaining pending
+        // parcels. Pass along the connection so it can be reused if more
+        // parcels have to be sent.
+        void call_postprocess_handler(boost::system::error_code const& e)
+        {
+            std::shared_ptr<sender> self(std::move(self_));
+            state_ = state_idle;
+
+            parcel_postprocess_type postprocess_handler;
+            std::swap(postprocess_handler, postprocess_handler_);
+            postprocess_handler(e, there_, std::move(self));
+        }
+
+        /// Socket for the parcelport_connection.
+        uring::socket socket_;
+
+        /// The buffers of the parcel being sent.
+        message_buffers buffers_;
+
+        state state_;
+        std::size_t received_;
+
+        // keeps this connection alive while an operation is in flight
+        std::shared_ptr<sender> self_;
+
+        /// the other (receiving) end of this connection
+        parcelset::locality there_;
+
+        /// Counters and their data containers.
+        util::high_resolution_timer timer_;
+        parcelset::parcelport* pp_;
+
+        postprocess_handler_type handler_;
+        parcel_postprocess_type postprocess_handler_;
+    };
+}}}}
+
+#endif
+
+#endif
@@ -104,6 +104,9 @@ namespace hpx { namespace plugins
                 "async_serialization = ${HPX_PARCEL_" + name_uc +
                     "_ASYNC_SERIALIZATION:"
                     "$[hpx.parcel.async_serialization]}",
+                "decode_segment_size = ${HPX_PARCEL_" + name_uc +
+                    "_DECODE_SEGMENT_SIZE:"
+                    "$[hpx.parcel.decode_segment_size]}",
                 "priority = ${HPX_PARCEL_" + name_uc +
                     "_PRIORITY:" + traits::plugin_config_data<Parcelport>::priority()
                                  + "}"
@@ -117,6 +117,25 @@ namespace hpx { namespace actions
         virtual serialization::binary_filter* get_serialization_filter(
             parcelset::parcel const& p) const = 0;
 
+        /// Account for the sizes of a message holding this action before and
+        /// after it was compressed by the filter returned from
+        /// \a get_serialization_filter.
+        virtual void record_compression(std::size_t uncompressed_size,
+            std::size_t compressed_size) const = 0;
+
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+        /// Account for the time (nanoseconds) it took to serialize a parcel
+        /// holding this action.
+        virtual void record_serialization_time(
+            std::int64_t serialization_time) const = 0;
+#endif
+
+        /// Return the size of the serialized arguments of this action if it
+        /// is known in advance, std::size_t(-1) otherwise. Actions with a
+        /// known size hold neither futures nor id_types, so parcels carrying
+        /// them do not need to be preprocessed before being sent.
+        virtual std::size_t get_fixed_arguments_size() const = 0;
+
         /// Return a pointer to the message handler to be used for this action.
         virtual parcelset::policies::message_handler* get_message_handler(
             parcelset::parcelhandler* ph, parcelset::locality const& loc,
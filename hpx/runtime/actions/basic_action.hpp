@@ -17,6 +17,7 @@
 #include <hpx/runtime/actions/basic_action_fwd.hpp>
 #include <hpx/runtime/actions/continuation.hpp>
 #include <hpx/runtime/actions/detail/action_factory.hpp>
+#include <hpx/runtime/actions/detail/action_latency_registry.hpp>
 #include <hpx/runtime/actions/detail/invocation_count_registry.hpp>
 #include <hpx/runtime/actions/preassigned_action_id.hpp>
 #include <hpx/runtime/actions/transfer_action.hpp>
@@ -29,6 +30,8 @@
 #include <hpx/runtime/threads/thread_enums.hpp>
 #include <hpx/runtime_fwd.hpp>
 #include <hpx/traits/action_decorate_function.hpp>
+#include <hpx/traits/action_is_non_blocking.hpp>
+#include <hpx/traits/action_is_read_only.hpp>
 #include <hpx/traits/action_priority.hpp>
 #include <hpx/traits/action_remote_result.hpp>
 #include <hpx/traits/action_stacksize.hpp>
@@ -99,11 +102,19 @@ namespace hpx { namespace actions
               , lva_(lva)
               , comptype_(comptype)
               , args_(std::forward<Ts>(vs)...)
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+              , created_(maintain_action_latencies ?
+                    util::high_resolution_clock::now() : 0)
+#endif
             {}
 
             threads::thread_result_type
             operator()(threads::thread_state_ex_enum)
             {
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+                if (created_ != 0)
+                    record_action_latency<Action>(queue_latency, created_);
+#endif
                 try
                 {
                     LTM_(debug) << "Executing "
@@ -146,6 +157,9 @@ namespace hpx { namespace actions
             naming::address::address_type lva_;
             naming::address::component_type comptype_;
             typename Action::arguments_type args_;
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+            std::uint64_t created_;
+#endif
         };
 
         ///////////////////////////////////////////////////////////////////////
@@ -165,11 +179,20 @@ namespace hpx { namespace actions
               , lva_(lva)
               , comptype_(comptype)
               , args_(std::forward<Ts>(vs)...)
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+              , created_(maintain_action_latencies ?
+                    util::high_resolution_clock::now() : 0)
+#endif
             {}
 
             threads::thread_result_type
             operator()(threads::thread_state_ex_enum)
             {
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+                if (created_ != 0)
+                    record_action_latency<Action>(queue_latency, created_);
+#endif
+
                 LTM_(debug)
                     << "Executing " << Action::get_action_name(lva_)
                     << " with continuation(" << cont_.get_id() << ")";
@@ -190,6 +213,9 @@ namespace hpx { namespace actions
             naming::address::address_type lva_;
             naming::address::component_type comptype_;
             typename Action::arguments_type args_;
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+            std::uint64_t created_;
+#endif
         };
 
         ///////////////////////////////////////////////////////////////////////
@@ -823,6 +849,31 @@ namespace hpx { namespace serialization
     HPX_ACTION_HAS_PRIORITY(action, threads::thread_priority_high_recursive)  \
 /**/
 
+// Direct actions marked as non-blocking are executed directly on the thread
+// decoding the parcel, even if that is not an HPX thread. Debug builds verify
+// that those actions do not suspend.
+#define HPX_ACTION_IS_NON_BLOCKING(action)                                    \
+    namespace hpx { namespace traits                                          \
+    {                                                                         \
+        template <>                                                           \
+        struct action_is_non_blocking< action>                                \
+          : std::true_type                                                    \
+        {};                                                                   \
+    }}                                                                        \
+/**/
+
+// Component actions marked as read-only do not modify the component they are
+// invoked on, a locking_hook runs them concurrently with each other.
+#define HPX_ACTION_IS_READ_ONLY(action)                                       \
+    namespace hpx { namespace traits                                          \
+    {                                                                         \
+        template <>                                                           \
+        struct action_is_read_only< action>                                   \
+          : std::true_type                                                    \
+        {};                                                                   \
+    }}                                                                        \
+/**/
+
 /// \endcond
 
 /// \def HPX_REGISTER_ACTION_DECLARATION(action)
@@ -37,7 +37,12 @@ namespace hpx { namespace actions {
         typename util::invoke_result<cont_type, hpx::naming::id_type, T>::type
         operator()(hpx::naming::id_type const& lco, T && t) const
         {
-            hpx::apply_c(cont_, lco, target_, std::forward<T>(t));
+            // A chain started without an LCO ends with this action, its
+            // result is not sent anywhere.
+            if (lco)
+                hpx::apply_c(cont_, lco, target_, std::forward<T>(t));
+            else
+                hpx::apply<cont_type>(target_, std::forward<T>(t));
 
             // Unfortunately we need to default construct the return value,
             // this possibly imposes an additional restriction of return types.
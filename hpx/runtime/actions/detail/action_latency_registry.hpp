@@ -0,0 +1,106 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_ACTIONS_ACTION_LATENCY_REGISTRY_HPP)
+#define HPX_ACTIONS_ACTION_LATENCY_REGISTRY_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/actions/action_support.hpp>
+#include <hpx/util/hdr_histogram.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/jenkins_hash.hpp>
+#include <hpx/util/static.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace actions { namespace detail
+{
+    // The latencies are collected only after a latency counter has been
+    // created.
+    extern HPX_EXPORT bool maintain_action_latencies;
+
+    enum action_latency_type
+    {
+        round_trip_latency = 0,     // request sent until its future is ready
+        serialization_latency,      // time spent serializing a parcel
+        queue_latency,              // thread created until it starts running
+        future_wait_latency,        // time blocked waiting for the future
+        action_latency_type_last
+    };
+
+    // The latency distributions (in nanoseconds) collected for one action.
+    struct action_latency_data
+    {
+        util::hdr_histogram histograms_[action_latency_type_last];
+    };
+
+    class HPX_EXPORT action_latency_registry
+    {
+    public:
+        HPX_NON_COPYABLE(action_latency_registry);
+
+    public:
+        typedef lcos::local::spinlock mutex_type;
+        typedef std::unordered_map<
+                std::string, std::unique_ptr<action_latency_data>,
+                hpx::util::jenkins_hash
+            > map_type;
+
+        action_latency_registry() {}
+
+        static action_latency_registry& instance();
+
+        // Return the latency data for the given action, the data is created
+        // on first use and is never released.
+        action_latency_data& get(std::string const& name);
+
+        // Return the latency (nanoseconds) below which the given percentage
+        // of the recorded latencies fall.
+        std::int64_t get_latency(std::string const& name,
+            action_latency_type type, double percentile, bool reset);
+
+    private:
+        struct tag {};
+        friend struct hpx::util::static_<action_latency_registry, tag>;
+
+        mutex_type mtx_;
+        map_type map_;
+    };
+
+    // Used by the latency counters, see action_latency_registry::get_latency
+    HPX_EXPORT std::int64_t get_action_latency(action_latency_type type,
+        std::string const& name, double percentile, bool reset);
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Action>
+    action_latency_data& get_action_latency_data()
+    {
+        static action_latency_data& data =
+            action_latency_registry::instance().get(get_action_name<Action>());
+        return data;
+    }
+
+    template <typename Action>
+    void record_action_latency(action_latency_type type,
+        std::uint64_t start_time)
+    {
+        get_action_latency_data<Action>().histograms_[type].record(
+            static_cast<std::int64_t>(
+                util::high_resolution_clock::now() - start_time));
+    }
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
+#endif
@@ -14,6 +14,7 @@
 
 #include <hpx/runtime/actions/action_support.hpp>
 #include <hpx/runtime/actions/base_action.hpp>
+#include <hpx/runtime/actions/detail/action_latency_registry.hpp>
 #include <hpx/runtime/actions/detail/invocation_count_registry.hpp>
 #include <hpx/runtime/components/pinned_ptr.hpp>
 #include <hpx/runtime/serialization/input_archive.hpp>
@@ -26,7 +27,9 @@
 #include <hpx/traits/action_serialization_filter.hpp>
 #include <hpx/traits/action_stacksize.hpp>
 #include <hpx/traits/action_was_object_migrated.hpp>
+#include <hpx/traits/is_bitwise_serializable.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/detail/pack.hpp>
 #include <hpx/util/get_and_reset_value.hpp>
 #include <hpx/util/serialize_exception.hpp>
 #include <hpx/util/tuple.hpp>
@@ -94,6 +97,33 @@ namespace hpx { namespace actions
         private:
             std::unique_ptr<Args> data_;
         };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The serialized size of the arguments is known in advance if all of
+        // them are bitwise serializable.
+        HPX_CONSTEXPR inline std::size_t sum_sizes()
+        {
+            return 0;
+        }
+
+        template <typename... Sizes>
+        HPX_CONSTEXPR std::size_t sum_sizes(std::size_t size, Sizes... sizes)
+        {
+            return size + sum_sizes(sizes...);
+        }
+
+        template <typename Args>
+        struct fixed_arguments_size
+          : std::integral_constant<std::size_t, std::size_t(-1)>
+        {};
+
+        template <typename... Ts>
+        struct fixed_arguments_size<util::tuple<Ts...> >
+          : std::integral_constant<std::size_t,
+                util::detail::all_of<
+                    traits::is_bitwise_serializable<Ts>...
+                >::value ? sum_sizes(sizeof(Ts)...) : std::size_t(-1)>
+        {};
     }
 }}
 
@@ -267,6 +297,35 @@ namespace hpx { namespace actions
             return traits::action_serialization_filter<derived_type>::call(p);
         }
 
+        /// Account for the sizes of a message holding this action before and
+        /// after it was compressed.
+        void record_compression(std::size_t uncompressed_size,
+            std::size_t compressed_size) const override
+        {
+            traits::detail::record_compression<
+                    traits::action_serialization_filter<derived_type>
+                >::call(uncompressed_size, compressed_size);
+        }
+
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+        /// Account for the time it took to serialize a parcel holding this
+        /// action.
+        void record_serialization_time(
+            std::int64_t serialization_time) const override
+        {
+            detail::get_action_latency_data<derived_type>()
+                .histograms_[detail::serialization_latency]
+                .record(serialization_time);
+        }
+#endif
+
+        /// Return the size of the serialized arguments if all of them are
+        /// bitwise serializable, std::size_t(-1) otherwise.
+        std::size_t get_fixed_arguments_size() const override
+        {
+            return detail::fixed_arguments_size<arguments_type>::value;
+        }
+
         /// Return a pointer to the message handler to be used for this action.
         parcelset::policies::message_handler* get_message_handler(
             parcelset::parcelhandler* ph, parcelset::locality const& loc,
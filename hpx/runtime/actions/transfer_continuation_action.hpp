@@ -58,6 +58,10 @@ namespace hpx { namespace actions
 
         bool has_continuation() const override;
 
+        /// The continuation refers to its target by an id_type which needs
+        /// to be preprocessed.
+        std::size_t get_fixed_arguments_size() const override;
+
         /// The \a get_thread_function constructs a proper thread function for
         /// a \a thread, encapsulating the functionality and the arguments
         /// of the action it is called for.
@@ -133,6 +137,13 @@ namespace hpx { namespace actions
         return true;
     }
 
+    template <typename Action>
+    std::size_t
+    transfer_continuation_action<Action>::get_fixed_arguments_size() const
+    {
+        return std::size_t(-1);
+    }
+
     template <typename Action>
     template <std::size_t ...Is>
     threads::thread_function_type
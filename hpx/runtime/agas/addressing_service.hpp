@@ -26,10 +26,14 @@
 #include <hpx/runtime/naming/name.hpp>
 #include <hpx/runtime/parcelset_fwd.hpp>
 #include <hpx/state.hpp>
+#include <hpx/util/allocation_accounting.hpp>
+#include <hpx/util/cache/concurrent_clock_cache.hpp>
 #include <hpx/util/cache/lru_cache.hpp>
+#include <hpx/util/cache/statistics/concurrent_full_statistics.hpp>
 #include <hpx/util/cache/statistics/local_full_statistics.hpp>
 #include <hpx/util_fwd.hpp>
 #include <hpx/util/function.hpp>
+#include <hpx/util/interval_timer.hpp>
 
 #include <boost/dynamic_bitset.hpp>
 
@@ -71,22 +75,49 @@ public:
 
     // {{{ gva cache
     struct gva_cache_key;
+    struct gva_cache_id;
+    struct gva_cache_id_hash;
+    struct gva_cache_entry;
+
+    // The entries referring to a single object, this cache is read without
+    // taking a lock.
+    typedef hpx::util::cache::concurrent_clock_cache<
+        gva_cache_id
+      , gva_cache_entry
+      , gva_cache_id_hash
+      , hpx::util::cache::statistics::concurrent_full_statistics
+    > gva_cache_type;
 
+    // The entries referring to a range of objects, looked up only if an id
+    // was not found in gva_cache_.
     typedef hpx::util::cache::lru_cache<
         gva_cache_key
       , gva
       , hpx::util::cache::statistics::local_full_statistics
-    > gva_cache_type;
+    > gva_range_cache_type;
     // }}}
 
     typedef std::set<naming::gid_type> migrated_objects_table_type;
+    typedef std::map<naming::gid_type, naming::address>
+        migrated_objects_forwarding_type;
     typedef std::map<naming::gid_type, std::int64_t> refcnt_requests_type;
 
-    mutable mutex_type gva_cache_mtx_;
     std::shared_ptr<gva_cache_type> gva_cache_;
 
+    mutable mutex_type gva_range_cache_mtx_;
+    std::shared_ptr<gva_range_cache_type> gva_range_cache_;
+    std::atomic<std::size_t> gva_range_cache_size_;
+
+#if defined(HPX_HAVE_ALLOCATION_ACCOUNTING)
+    // The memory held by the caches, the memory of the range cache is
+    // estimated from its number of entries.
+    util::allocation_accounting::accounted_size gva_cache_memory_;
+    util::allocation_accounting::accounted_size gva_range_cache_memory_;
+#endif
+
     mutable mutex_type migrated_objects_mtx_;
     migrated_objects_table_type migrated_objects_table_;
+    migrated_objects_forwarding_type migrated_objects_forwarding_;
 
     mutable mutex_type console_cache_mtx_;
     std::uint32_t console_cache_;
@@ -99,6 +130,28 @@ public:
 
     std::shared_ptr<refcnt_requests_type> refcnt_requests_;
 
+    // Credits which were requested from AGAS ahead of time, these are handed
+    // out whenever the credit of a local id_type is exhausted
+    struct credit_reserve_entry
+    {
+        credit_reserve_entry()
+          : credit_(0), used_(false)
+        {}
+
+        std::int64_t credit_;
+        bool used_;
+    };
+    typedef std::map<naming::gid_type, credit_reserve_entry>
+        credit_reserve_type;
+
+    mutex_type credit_reserve_mtx_;
+    credit_reserve_type credit_reserve_;
+
+    // Pending decrefs and unused reserved credits are sent to AGAS
+    // periodically
+    std::size_t const refcnt_flush_interval_;
+    util::interval_timer refcnt_requests_timer_;
+
     service_mode const service_type;
     runtime_mode const runtime_type;
 
@@ -228,6 +281,18 @@ protected:
         naming::gid_type const& id
       , future<primary_namespace::resolved_type> f
         );
+    naming::address resolve_full_postproc_entry(
+        naming::gid_type const& id
+      , primary_namespace::resolved_type const& rep
+        );
+    std::vector<naming::address> resolve_bulk_postproc(
+        std::vector<naming::gid_type> const& ids
+      , std::vector<naming::address> addrs
+      , std::vector<std::vector<std::size_t> > const& indices
+      , future<std::vector<
+            future<std::vector<primary_namespace::resolved_type> >
+        > > f
+        );
     bool bind_postproc(
         naming::gid_type const& id
       , gva const& g
@@ -240,6 +305,18 @@ protected:
         );
 
 private:
+    /// Account for the memory held by the caches, assumes that
+    /// \a gva_range_cache_mtx_ is locked.
+    void update_cache_memory_accounting();
+
+    /// Return the reserved credits to AGAS, if \a unused_only is true only
+    /// those which were not touched since the last call are returned.
+    void release_credit_reserve(bool unused_only);
+
+    /// Invoked by \a refcnt_requests_timer_
+    bool flush_refcnt_requests();
+    void start_refcnt_requests_timer();
+
     /// Assumes that \a refcnt_requests_mtx_ is locked.
     void send_refcnt_requests(
         std::unique_lock<mutex_type>& l
@@ -992,6 +1069,21 @@ public:
         return resolve_async(id.get_gid());
     }
 
+    /// \brief Resolve the addresses of many global ids at once
+    ///
+    /// The ids which can't be resolved using the local cache are grouped by
+    /// the locality managing them, all ids managed by one locality are
+    /// resolved using a single request. The requests sent to the different
+    /// localities are in flight concurrently.
+    ///
+    /// \param ids       [in] The global address of the objects to resolve.
+    ///
+    /// \returns         The addresses of the objects, in the same order as
+    ///                   the given ids.
+    hpx::future<std::vector<naming::address> > resolve_async(
+        std::vector<naming::id_type> const& ids
+        );
+
     ///////////////////////////////////////////////////////////////////////////
     hpx::future<naming::id_type> get_colocation_id_async(
         naming::id_type const& id
@@ -1151,6 +1243,37 @@ public:
         return incref_async(gid, credits).get(ec);
     }
 
+    /// \brief Return whether credits may be reserved locally, unused ones are
+    ///        returned to AGAS only if refcnt_flush_interval is not zero.
+    bool has_credit_reserve() const
+    {
+        return refcnt_flush_interval_ != 0;
+    }
+
+    /// \brief Take the given amount of credits for the given id from the
+    ///        locally reserved credits.
+    ///
+    /// \returns          Whether enough credits were available, nothing is
+    ///                   taken otherwise.
+    bool borrow_credit(
+        naming::gid_type const& gid
+      , std::int64_t credits
+        );
+
+    /// \brief Add credits (which have been accounted for by AGAS already) to
+    ///        the locally reserved credits for the given id.
+    void add_credit_reserve(
+        naming::gid_type const& gid
+      , std::int64_t credits
+        );
+
+    /// \brief Asynchronously request the given amount of credits for the
+    ///        given id from AGAS and add those to the reserved credits.
+    void replenish_credit_reserve(
+        naming::gid_type const& gid
+      , std::int64_t credits
+        );
+
     /// \brief Decrement the global reference count for the given id
     ///
     /// \param id         [in] The global address (id) for which the
@@ -1322,6 +1445,13 @@ public:
     future<hpx::id_type> on_symbol_namespace_event(std::string const& name,
         bool call_for_past_events = false);
 
+    /// \brief Install listeners for all of the given names, see
+    ///        \a on_symbol_namespace_event. Only one request is sent to each
+    ///        locality responsible for any of the names.
+    std::vector<future<hpx::id_type> > on_symbol_namespace_events(
+        std::vector<std::string> const& names,
+        bool call_for_past_events = false);
+
     /// \warning This function is for internal use only. It is dangerous and
     ///          may break your code if you use it.
     void update_cache_entry(
@@ -1393,6 +1523,17 @@ public:
     /// Remove the given object from the table of migrated objects
     void unmark_as_migrated(naming::gid_type const& gid);
 
+    /// Remember the new location of the given object which was migrated
+    /// away from this locality, once its migration has finished.
+    void track_migrated_object(naming::gid_type const& gid);
+
+    /// Send the given parcel directly to the new location of its (migrated)
+    /// destination object, if that is known. The cache of the sending
+    /// locality is updated as well.
+    ///
+    /// \returns Whether the parcel was forwarded.
+    bool forward_to_migrated_object(parcelset::parcel& p);
+
     // Pre-cache locality endpoints in hosted locality namespace
     void pre_cache_endpoints(std::vector<parcelset::endpoints_type> const&);
 };
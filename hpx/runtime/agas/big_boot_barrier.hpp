@@ -24,6 +24,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <map>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -35,6 +36,7 @@ namespace hpx { namespace agas
 {
 
 struct notification_header;
+struct registration_header;
 
 struct HPX_EXPORT big_boot_barrier
 {
@@ -56,8 +58,22 @@ private:
 
     std::vector<parcelset::endpoints_type> localities;
 
+    // responses to the localities taking part in startup synchronization,
+    // these are sent as soon as the bootstrap locality is up
+    std::vector<notification_header> notifications;
+    std::uint32_t const fanout;
+
+    // exchange the bootstrap data through the key-value store of the PMIx
+    // server instead of sending parcels (see util::pmix_environment)
+    bool const use_pmix;
+    std::map<std::uint32_t, std::uint32_t> pmix_ranks;
+
     void spin();
 
+    void wait_bootstrap_pmix();
+    void wait_hosted_pmix(registration_header const& hdr);
+    void trigger_pmix(std::vector<notification_header>&& hdrs);
+
     void notify();
 
 public:
@@ -87,12 +103,7 @@ public:
       , util::runtime_configuration const& ini_
         );
 
-    ~big_boot_barrier()
-    {
-        util::unique_function_nonser<void()>* f;
-        while (thunks.pop(f))
-            delete f;
-    }
+    ~big_boot_barrier();
 
     parcelset::locality here() { return bootstrap_agas; }
     parcelset::endpoints_type const &get_endpoints() { return endpoints; }
@@ -113,11 +124,15 @@ public:
       , Action act
       , Args &&... args);
 
-    void apply_notification(
+    void add_notification(notification_header&& hdr);
+
+    void send_notifications(
         std::uint32_t source_locality_id
-      , std::uint32_t target_locality_id
-      , parcelset::locality const& dest
-      , notification_header&& hdr);
+      , std::vector<notification_header>&& hdrs
+      , std::vector<parcelset::endpoints_type> const& endpoints
+      , std::uint32_t fanout);
+
+    std::uint32_t get_fanout() const { return fanout; }
 
     void wait_bootstrap();
     void wait_hosted(std::string const& locality_name,
@@ -299,6 +299,10 @@ HPX_API_EXPORT naming::id_type get_colocation_id(
 HPX_API_EXPORT hpx::future<hpx::id_type> on_symbol_namespace_event(
     std::string const& name, bool call_for_past_events);
 
+HPX_API_EXPORT std::vector<hpx::future<hpx::id_type> >
+    on_symbol_namespace_events(std::vector<std::string> const& names,
+        bool call_for_past_events);
+
 ///////////////////////////////////////////////////////////////////////////////
 HPX_API_EXPORT hpx::future<std::pair<naming::id_type, naming::address>>
     begin_migration(naming::id_type const& id);
@@ -316,6 +320,8 @@ HPX_API_EXPORT std::pair<bool, components::pinned_ptr>
 
 HPX_API_EXPORT void unmark_as_migrated(naming::gid_type const& gid);
 
+HPX_API_EXPORT void track_migrated_object(naming::gid_type const& gid);
+
 HPX_API_EXPORT hpx::future<std::map<std::string, hpx::id_type> >
     find_symbols(std::string const& pattern = "*");
 HPX_API_EXPORT std::map<std::string, hpx::id_type> find_symbols(
@@ -69,6 +69,10 @@ struct HPX_EXPORT primary_namespace
     resolved_type resolve_gid(naming::gid_type id);
     future<resolved_type> resolve_full(naming::gid_type id);
 
+    // All ids have to be managed by the same instance of the service
+    future<std::vector<resolved_type> > resolve_full(
+        std::vector<naming::gid_type> ids);
+
     future<id_type> colocate(naming::gid_type id);
 
     naming::address unbind_gid(std::uint64_t count, naming::gid_type id);
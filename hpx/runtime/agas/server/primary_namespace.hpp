@@ -19,11 +19,14 @@
 #include <hpx/runtime/components/server/fixed_component_base.hpp>
 #include <hpx/runtime/naming/id_type.hpp>
 #include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime/threads/topology.hpp>
 #include <hpx/traits/action_message_handler.hpp>
 #include <hpx/traits/action_serialization_filter.hpp>
+#include <hpx/util/fibhash.hpp>
 #include <hpx/util/internal_allocator.hpp>
 #include <hpx/util/tuple.hpp>
 
+#include <array>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
@@ -32,6 +35,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -121,19 +125,44 @@ struct HPX_EXPORT primary_namespace
 
     typedef std::pair<gva, naming::gid_type> gva_table_data_type;
     typedef std::map<naming::gid_type, gva_table_data_type> gva_table_type;
-    typedef std::map<naming::gid_type, std::int64_t> refcnt_table_type;
+    typedef std::unordered_map<naming::gid_type, std::int64_t>
+        refcnt_table_type;
 
     typedef hpx::util::tuple<naming::gid_type, gva, naming::gid_type>
         resolved_type;
     // }}}
 
   private:
-    // REVIEW: Separate mutexes might reduce contention here. This has to be
-    // investigated carefully.
+    // The mutex protects the GVA table and the table of migrating objects.
+    // The GVA table is kept sorted as resolving a gid requires to look up
+    // the range it belongs to.
     mutex_type mutex_;
 
     gva_table_type gvas_;
-    refcnt_table_type refcnts_;
+
+    // The reference counts are only looked up using exact keys, they are
+    // distributed over independently locked shards (padded to avoid false
+    // sharing). This way the credit requests for different objects do not
+    // serialize on a single lock.
+    HPX_STATIC_CONSTEXPR std::size_t num_refcnt_shards = 32;
+
+    struct refcnt_shard
+    {
+        mutex_type mtx_;
+        refcnt_table_type refcnts_;
+
+        // make sure no two shards share a cache line
+        char cacheline_pad_[threads::get_cache_line_size()];
+    };
+
+    refcnt_shard& get_refcnt_shard(naming::gid_type const& gid)
+    {
+        return refcnt_shards_[util::fibhash<num_refcnt_shards>(
+            std::hash<naming::gid_type>()(gid))];
+    }
+
+    std::array<refcnt_shard, num_refcnt_shards> refcnt_shards_;
+
     typedef std::map<
             naming::gid_type,
             hpx::util::tuple<bool, std::size_t, lcos::local::detail::condition_variable>
@@ -221,14 +250,10 @@ struct HPX_EXPORT primary_namespace
     counter_data counter_data_;
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
-    /// Dump the credit counts of all matching ranges. Expects that \p l
-    /// is locked.
+    /// Dump the credit counts of all matching ranges.
     void dump_refcnt_matches(
-        refcnt_table_type::iterator lower_it
-      , refcnt_table_type::iterator upper_it
-      , naming::gid_type const& lower
+        naming::gid_type const& lower
       , naming::gid_type const& upper
-      , std::unique_lock<mutex_type>& l
       , const char* func_name
         );
 #endif
@@ -288,6 +313,10 @@ struct HPX_EXPORT primary_namespace
 
     resolved_type resolve_gid(naming::gid_type id);
 
+    // Resolve all given ids at once, the results are returned in the same
+    // order as the ids
+    std::vector<resolved_type> resolve_gids(std::vector<naming::gid_type> ids);
+
     naming::id_type colocate(naming::gid_type id);
 
     naming::address unbind_gid(
@@ -344,7 +373,7 @@ struct HPX_EXPORT primary_namespace
 
     void resolve_free_list(
         std::unique_lock<mutex_type>& l
-      , std::list<refcnt_table_type::iterator> const& free_list
+      , std::list<naming::gid_type> const& free_list
       , free_entry_list_type& free_entry_list
       , naming::gid_type const& lower
       , naming::gid_type const& upper
@@ -375,6 +404,7 @@ struct HPX_EXPORT primary_namespace
     HPX_DEFINE_COMPONENT_ACTION(primary_namespace, decrement_credit);
     HPX_DEFINE_COMPONENT_ACTION(primary_namespace, increment_credit);
     HPX_DEFINE_COMPONENT_ACTION(primary_namespace, resolve_gid);
+    HPX_DEFINE_COMPONENT_ACTION(primary_namespace, resolve_gids);
     HPX_DEFINE_COMPONENT_ACTION(primary_namespace, unbind_gid);
     HPX_DEFINE_COMPONENT_ACTION(primary_namespace, route);
     HPX_DEFINE_COMPONENT_ACTION(primary_namespace, statistics_counter);
@@ -441,6 +471,13 @@ HPX_REGISTER_ACTION_DECLARATION(
     hpx::agas::server::primary_namespace::resolve_gid_action,
     primary_namespace_resolve_gid_action)
 
+HPX_ACTION_USES_MEDIUM_STACK(
+    hpx::agas::server::primary_namespace::resolve_gids_action)
+
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::primary_namespace::resolve_gids_action,
+    primary_namespace_resolve_gids_action)
+
 HPX_ACTION_USES_MEDIUM_STACK(
     hpx::agas::server::primary_namespace::colocate_action)
 
@@ -476,6 +513,8 @@ typedef hpx::util::tuple<
     > gva_tuple_type;
 HPX_REGISTER_BASE_LCO_WITH_VALUE_DECLARATION(
     gva_tuple_type, gva_tuple)
+HPX_REGISTER_BASE_LCO_WITH_VALUE_DECLARATION(
+    std::vector<gva_tuple_type>, vector_gva_tuple)
 typedef std::pair<hpx::naming::id_type, hpx::naming::address>
     std_pair_address_id_type;
 HPX_REGISTER_BASE_LCO_WITH_VALUE_DECLARATION(
@@ -14,12 +14,15 @@
 #include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/runtime/actions/component_action.hpp>
 #include <hpx/runtime/components/server/fixed_component_base.hpp>
+#include <hpx/runtime/serialization/string.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
 #include <hpx/util/function.hpp>
 
 #include <atomic>
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -50,6 +53,12 @@ struct HPX_EXPORT symbol_namespace
         gid_table_type;
 
     typedef std::multimap<std::string, hpx::id_type> on_event_data_map_type;
+
+    // localities which hold a copy of an entry in their cache
+    typedef std::map<std::string, std::set<std::uint32_t> > watchers_table_type;
+
+    // entries owned by other localities which were resolved from here
+    typedef std::map<std::string, naming::id_type> cache_type;
     // }}}
 
   private:
@@ -57,6 +66,11 @@ struct HPX_EXPORT symbol_namespace
     gid_table_type gids_;
     std::string instance_name_;
     on_event_data_map_type on_event_data_;
+    watchers_table_type watchers_;
+
+    mutable mutex_type cache_mtx_;
+    cache_type cache_;
+    std::uint64_t cache_epoch_;
 
     // data structure holding all counters for the omponent_namespace component
     struct counter_data
@@ -122,6 +136,7 @@ struct HPX_EXPORT symbol_namespace
   public:
     symbol_namespace()
       : base_type(HPX_AGAS_SYMBOL_NS_MSB, HPX_AGAS_SYMBOL_NS_LSB)
+      , cache_epoch_(0)
     {}
 
     void finalize();
@@ -163,12 +178,45 @@ struct HPX_EXPORT symbol_namespace
 
     naming::gid_type statistics_counter(std::string const& key);
 
+    /// Resolve the given name, the locality \a locality_id will be notified
+    /// once the name is unbound.
+    naming::gid_type resolve_cached(
+        std::string const& key
+      , std::uint32_t locality_id
+        );
+
+    /// Same as \a on_event for all given names, the locality
+    /// \a locality_id (if valid) will be notified once any of the names
+    /// is unbound.
+    bool on_events(
+        std::vector<std::string> const& names
+      , bool call_for_past_events
+      , std::vector<hpx::id_type> const& lcos
+      , std::uint32_t locality_id
+        );
+
+    /// Remove the given name from the cache of this locality
+    void invalidate(std::string const& key);
+
+    // access the cache of entries owned by other localities
+    bool get_cached(std::string const& key, naming::id_type& id) const;
+    std::uint64_t get_cache_epoch() const;
+    void add_cached(std::string const& key, naming::id_type const& id,
+        std::uint64_t epoch);
+    void clear_cache();
+
     HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, bind);
     HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, resolve);
     HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, unbind);
     HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, iterate);
     HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, on_event);
     HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, statistics_counter);
+    HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, resolve_cached);
+    HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, on_events);
+    HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, invalidate);
+
+  private:
+    void add_watcher(std::string const& key, std::uint32_t locality_id);
 };
 
 }}}
@@ -215,6 +263,24 @@ HPX_REGISTER_ACTION_DECLARATION(
     hpx::agas::server::symbol_namespace::statistics_counter_action,
     symbol_namespace_statistics_counter_action)
 
+HPX_ACTION_USES_MEDIUM_STACK(
+    hpx::agas::server::symbol_namespace::resolve_cached_action)
+
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::symbol_namespace::resolve_cached_action,
+    symbol_namespace_resolve_cached_action)
+
+HPX_ACTION_USES_MEDIUM_STACK(
+    hpx::agas::server::symbol_namespace::on_events_action)
+
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::symbol_namespace::on_events_action,
+    symbol_namespace_on_events_action)
+
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::symbol_namespace::invalidate_action,
+    symbol_namespace_invalidate_action)
+
 #include <hpx/config/warnings_suffix.hpp>
 
 #endif // HPX_D69CE952_C5D9_4545_B83E_BA3DCFD812EB
@@ -75,6 +75,13 @@ struct symbol_namespace
       , hpx::id_type lco
         );
 
+    /// Wait for all of the given names to be bound, the requests are sent
+    /// with one message per locality owning any of the names.
+    std::vector<hpx::future<naming::id_type> > on_events(
+        std::vector<std::string> const& names
+      , bool call_for_past_events
+        );
+
     hpx::future<iterate_names_return_type> iterate_async(
         std::string const& pattern) const;
     iterate_names_return_type iterate(std::string const& pattern) const;
@@ -83,8 +90,17 @@ struct symbol_namespace
     void register_server_instance(std::uint32_t locality_id);
     void unregister_server_instance(error_code& ec);
 
+    /// Keep names owned by other localities in a local cache, entries are
+    /// invalidated by their owner once they are unbound.
+    void enable_caching(bool enable)
+    {
+        caching_ = enable;
+    }
+    void clear_cache();
+
 private:
     std::unique_ptr<server_type> server_;
+    bool caching_;
 };
 
 }}
@@ -18,15 +18,22 @@
 #include <hpx/state.hpp>
 #include <hpx/traits/action_continuation.hpp>
 #include <hpx/traits/action_decorate_continuation.hpp>
+#include <hpx/traits/action_is_non_blocking.hpp>
 #include <hpx/traits/action_priority.hpp>
 #include <hpx/traits/action_schedule_thread.hpp>
 #include <hpx/traits/action_select_direct_execution.hpp>
 #include <hpx/traits/action_stacksize.hpp>
 #include <hpx/util/decay.hpp>
+#if defined(HPX_DEBUG)
+#include <hpx/runtime/threads/coroutines/detail/coroutine_self.hpp>
+#include <hpx/throw_exception.hpp>
+#endif
 
 #include <chrono>
+#include <cstddef>
 #include <exception>
 #include <memory>
+#include <string>
 #include <utility>
 
 namespace hpx
@@ -160,6 +167,60 @@ namespace hpx { namespace applier { namespace detail
         }
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Direct actions are executed directly if the current HPX thread has
+    // sufficient stack space left. Direct actions which never suspend are
+    // executed directly on any other thread as well.
+    template <typename Action>
+    HPX_FORCEINLINE bool can_execute_directly()
+    {
+        if (traits::action_is_non_blocking<Action>::value &&
+            nullptr == threads::get_self_ptr())
+        {
+            return true;
+        }
+
+        return this_thread::has_sufficient_stack_space() ||
+            !threads::threadmanager_is_at_least(state_running);
+    }
+
+    // Debug builds verify that actions marked as non-blocking do not suspend.
+    // Suspending a non-HPX thread is reported by the runtime anyways, on HPX
+    // threads the thread phase changes whenever the thread was suspended.
+    template <typename Action,
+        bool NonBlocking = traits::action_is_non_blocking<Action>::value>
+    struct verify_non_blocking
+    {
+        HPX_FORCEINLINE void check() const {}
+    };
+
+#if defined(HPX_DEBUG)
+    template <typename Action>
+    struct verify_non_blocking<Action, true>
+    {
+        verify_non_blocking()
+          : self_(threads::get_self_ptr())
+          , phase_(self_ != nullptr ? self_->get_thread_phase() : 0)
+        {}
+
+        void check() const
+        {
+            if (self_ != nullptr && self_->get_thread_phase() != phase_)
+            {
+                HPX_THROW_EXCEPTION(invalid_status,
+                    "applier::detail::verify_non_blocking::check",
+                    std::string("the action '") +
+                        actions::detail::get_action_name<Action>() +
+                        "' was suspended while being executed although it "
+                        "is marked as non-blocking");
+            }
+        }
+
+        threads::thread_self* self_;
+        std::size_t phase_;
+    };
+#endif
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename Action,
         bool DirectExecute = Action::direct_execution::value>
@@ -229,10 +290,11 @@ namespace hpx { namespace applier { namespace detail
         {
             // Direct actions should be able to be executed from a
             // non-HPX thread as well
-            if (this_thread::has_sufficient_stack_space() ||
-                !threads::threadmanager_is_at_least(state_running))
+            if (can_execute_directly<Action>())
             {
+                verify_non_blocking<Action> verify;
                 call_sync<Action>(lva, comptype, std::forward<Ts>(vs)...);
+                verify.check();
             }
             else
             {
@@ -250,11 +312,12 @@ namespace hpx { namespace applier { namespace detail
         {
             // Direct actions should be able to be executed from a
             // non-HPX thread as well
-            if (this_thread::has_sufficient_stack_space() ||
-                !threads::threadmanager_is_at_least(state_running))
+            if (can_execute_directly<Action>())
             {
+                verify_non_blocking<Action> verify;
                 call_sync<Action>(std::forward<Continuation>(cont), lva,
                     comptype, std::forward<Ts>(vs)...);
+                verify.check();
             }
             else
             {
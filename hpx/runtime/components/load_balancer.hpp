@@ -0,0 +1,399 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file load_balancer.hpp
+
+#if !defined(HPX_RUNTIME_COMPONENTS_LOAD_BALANCER_HPP)
+#define HPX_RUNTIME_COMPONENTS_LOAD_BALANCER_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/async.hpp>
+#include <hpx/lcos/detail/async_colocated.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/mutex.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/performance_counters/performance_counter.hpp>
+#include <hpx/runtime/actions/plain_action.hpp>
+#include <hpx/runtime/components/migrate_component.hpp>
+#include <hpx/runtime/find_localities.hpp>
+#include <hpx/runtime/get_colocation_id.hpp>
+#include <hpx/runtime/get_ptr.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/traits/component_supports_migration.hpp>
+#include <hpx/util/interval_timer.hpp>
+#include <hpx/util/steady_clock.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace components
+{
+    namespace server
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Return the number of actions which were scheduled for the given
+        // (local) object since the last reset.
+        template <typename Component>
+        std::uint64_t get_component_activity(naming::id_type const& id,
+            bool reset)
+        {
+            std::shared_ptr<Component> ptr =
+                hpx::get_ptr<Component>(launch::sync, id);
+
+            // get_ptr has pinned the object as well
+            std::uint64_t const count = ptr->activity_count(reset);
+            return count != 0 ? count - 1 : 0;
+        }
+
+        template <typename Component>
+        struct get_component_activity_action
+          : ::hpx::actions::action<
+                std::uint64_t (*)(naming::id_type const&, bool)
+              , &get_component_activity<Component>
+              , get_component_activity_action<Component> >
+        {};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The parameters controlling the decisions of a \a load_balancer.
+    struct load_balancing_parameters
+    {
+        /// A locality is overloaded if its load exceeds the average load of
+        /// all localities by this factor.
+        double high_watermark = 1.25;
+
+        /// A locality is underloaded if its load is below the average load of
+        /// all localities by this factor.
+        double low_watermark = 0.75;
+
+        /// The maximal number of components migrated during one round.
+        std::size_t max_migrations = 8;
+
+        /// The number of rounds a migrated component is not considered for
+        /// another migration.
+        std::size_t cooldown = 2;
+
+        /// Localities whose load is below this value are never considered to
+        /// be overloaded.
+        double min_load = 1.0;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The load_balancer migrates the most active of the tracked component
+    /// instances from overloaded to underloaded localities.
+    ///
+    /// The load of a locality is the length of its thread queues
+    /// (/threadqueue/length), if idle rates are collected, the fraction of
+    /// time its worker threads are busy (/threads/idle-rate) is added. The
+    /// activity of a component is the number of actions scheduled for it
+    /// since the previous round.
+    ///
+    /// Each round (\a rebalance) moves at most
+    /// \a load_balancing_parameters::max_migrations components, all of them
+    /// migrated concurrently. The distance between the high and the low
+    /// watermarks and the cooldown of the migrated components prevent them
+    /// from being moved back and forth between the localities.
+    ///
+    /// \tparam Component   The component type of the tracked instances, it
+    ///                     has to support migration.
+    ///
+    /// \note The tracked ids keep the component instances alive, they have to
+    ///       be untracked before they can be destroyed.
+    template <typename Component>
+    class load_balancer
+    {
+    private:
+        typedef lcos::local::spinlock mutex_type;
+
+        static_assert(traits::component_supports_migration<Component>::call(),
+            "the load_balancer requires a component supporting migration");
+
+        struct tracked_component
+        {
+            naming::id_type id_;
+            std::size_t cooldown_;
+        };
+
+        struct candidate
+        {
+            naming::id_type id_;
+            std::uint64_t activity_;
+        };
+
+    public:
+        explicit load_balancer(
+                load_balancing_parameters const& params =
+                    load_balancing_parameters())
+          : params_(params)
+        {}
+
+        load_balancer(load_balancer const&) = delete;
+        load_balancer& operator=(load_balancer const&) = delete;
+
+        ~load_balancer()
+        {
+            stop();
+        }
+
+        /// Add the given component instance to the instances which may be
+        /// migrated.
+        void track(naming::id_type const& id)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            components_.push_back(tracked_component{id, 0});
+        }
+
+        /// Remove the given component instance from the instances which may
+        /// be migrated.
+        void untrack(naming::id_type const& id)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            components_.erase(
+                std::remove_if(components_.begin(), components_.end(),
+                    [&](tracked_component const& c)
+                    {
+                        return c.id_ == id;
+                    }),
+                components_.end());
+        }
+
+        /// Perform one round of load balancing.
+        ///
+        /// \returns A future holding the number of components which were
+        ///          successfully migrated.
+        hpx::future<std::size_t> rebalance()
+        {
+            return hpx::async(&load_balancer::rebalance_round, this);
+        }
+
+        /// Perform a round of load balancing periodically.
+        ///
+        /// \param interval [in] The time between two consecutive rounds.
+        void start(util::steady_duration const& interval)
+        {
+            stop();
+            timer_.reset(new util::interval_timer(
+                [this]() -> bool
+                {
+                    rebalance_round();
+                    return true;
+                },
+                interval, "load_balancer", true));
+            timer_->start(false);
+        }
+
+        /// Stop performing load balancing periodically.
+        void stop()
+        {
+            if (timer_)
+            {
+                timer_->stop();
+                timer_.reset();
+            }
+        }
+
+    private:
+        std::vector<double> sample_loads()
+        {
+            if (localities_.empty())
+            {
+                localities_ = hpx::find_all_localities();
+                for (naming::id_type const& locality : localities_)
+                {
+                    queue_lengths_.emplace_back(
+                        "/threadqueue{locality#0/total}/length", locality);
+#if defined(HPX_HAVE_THREAD_IDLE_RATES)
+                    idle_rates_.emplace_back(
+                        "/threads{locality#0/total}/idle-rate", locality);
+#endif
+                }
+            }
+
+            std::vector<hpx::future<double> > values;
+            values.reserve(2 * localities_.size());
+            for (std::size_t i = 0; i != localities_.size(); ++i)
+            {
+                values.push_back(queue_lengths_[i].get_value<double>());
+#if defined(HPX_HAVE_THREAD_IDLE_RATES)
+                values.push_back(idle_rates_[i].get_value<double>(true));
+#endif
+            }
+            hpx::wait_all(values);
+
+            std::vector<double> loads;
+            loads.reserve(localities_.size());
+            for (std::size_t i = 0, j = 0; i != localities_.size(); ++i)
+            {
+                double load = values[j++].get();
+#if defined(HPX_HAVE_THREAD_IDLE_RATES)
+                // the idle rate is given in units of 0.01%
+                load += 1.0 - values[j++].get() / 10000.0;
+#endif
+                loads.push_back(load);
+            }
+            return loads;
+        }
+
+        std::size_t locality_index(naming::id_type const& locality) const
+        {
+            for (std::size_t i = 0; i != localities_.size(); ++i)
+            {
+                if (localities_[i] == locality)
+                    return i;
+            }
+            return localities_.size();
+        }
+
+        std::size_t rebalance_round()
+        {
+            std::lock_guard<lcos::local::mutex> round_lock(round_mtx_);
+
+            std::vector<tracked_component> components;
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                for (tracked_component& c : components_)
+                {
+                    if (c.cooldown_ != 0)
+                        --c.cooldown_;
+                    else
+                        components.push_back(c);
+                }
+            }
+
+            std::vector<double> const loads = sample_loads();
+            if (components.empty() || loads.size() < 2)
+                return 0;
+
+            double average = 0.0;
+            for (double load : loads)
+                average += load;
+            average /= loads.size();
+
+            // the underloaded localities, the least loaded first
+            std::vector<std::size_t> targets;
+            for (std::size_t i = 0; i != loads.size(); ++i)
+            {
+                if (loads[i] < params_.low_watermark * average)
+                    targets.push_back(i);
+            }
+            if (targets.empty())
+                return 0;
+
+            std::sort(targets.begin(), targets.end(),
+                [&](std::size_t lhs, std::size_t rhs)
+                {
+                    return loads[lhs] < loads[rhs];
+                });
+
+            // the activity of the components is reset every round, including
+            // the ones which are not moved
+            std::vector<hpx::future<naming::id_type> > locations;
+            std::vector<hpx::future<std::uint64_t> > activities;
+            locations.reserve(components.size());
+            activities.reserve(components.size());
+            for (tracked_component const& c : components)
+            {
+                typedef server::get_component_activity_action<Component>
+                    action_type;
+
+                locations.push_back(hpx::get_colocation_id(c.id_));
+                activities.push_back(hpx::detail::async_colocated<action_type>(
+                    c.id_, c.id_, true));
+            }
+            hpx::wait_all(locations);
+            hpx::wait_all(activities);
+
+            // the components located on an overloaded locality, the most
+            // active first
+            std::vector<candidate> candidates;
+            for (std::size_t i = 0; i != components.size(); ++i)
+            {
+                // ignore components which have been destroyed meanwhile
+                if (locations[i].has_exception() ||
+                    activities[i].has_exception())
+                {
+                    continue;
+                }
+
+                std::size_t const source =
+                    locality_index(locations[i].get());
+                std::uint64_t const activity = activities[i].get();
+
+                if (source == loads.size() || activity == 0 ||
+                    loads[source] < params_.min_load ||
+                    loads[source] <= params_.high_watermark * average)
+                {
+                    continue;
+                }
+
+                candidates.push_back(candidate{components[i].id_, activity});
+            }
+
+            std::sort(candidates.begin(), candidates.end(),
+                [](candidate const& lhs, candidate const& rhs)
+                {
+                    return lhs.activity_ > rhs.activity_;
+                });
+
+            std::size_t const count =
+                (std::min)(candidates.size(), params_.max_migrations);
+
+            std::vector<hpx::future<naming::id_type> > migrated;
+            migrated.reserve(count);
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                std::size_t const target = targets[i % targets.size()];
+                migrated.push_back(hpx::components::migrate<Component>(
+                    candidates[i].id_, localities_[target]));
+            }
+            hpx::wait_all(migrated);
+
+            std::size_t result = 0;
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    if (migrated[i].has_exception())
+                        continue;
+
+                    ++result;
+                    for (tracked_component& c : components_)
+                    {
+                        if (c.id_ == candidates[i].id_)
+                            c.cooldown_ = params_.cooldown;
+                    }
+                }
+            }
+            return result;
+        }
+
+    private:
+        load_balancing_parameters const params_;
+
+        mutable mutex_type mtx_;
+        std::vector<tracked_component> components_;
+
+        // one round is performed at a time only
+        lcos::local::mutex round_mtx_;
+        std::vector<naming::id_type> localities_;
+        std::vector<performance_counters::performance_counter> queue_lengths_;
+#if defined(HPX_HAVE_THREAD_IDLE_RATES)
+        std::vector<performance_counters::performance_counter> idle_rates_;
+#endif
+
+        std::unique_ptr<util::interval_timer> timer_;
+    };
+}}
+
+#endif
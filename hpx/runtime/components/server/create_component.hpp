@@ -13,9 +13,11 @@
 #include <hpx/runtime/components/component_type.hpp>
 #include <hpx/runtime/naming/address.hpp>
 #include <hpx/throw_exception.hpp>
+#include <hpx/util/one_size_heap_list.hpp>
 
 #include <cstddef>
 #include <sstream>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -115,64 +117,100 @@ namespace hpx { namespace components { namespace server
         return naming::invalid_gid;
     }
 
-    ///////////////////////////////////////////////////////////////////////////
-    /// Create count components and forward the passed parameters
-    template <typename Component, typename...Ts>
-    std::vector<naming::gid_type> bulk_create(std::size_t count, Ts&&...ts)
+    namespace detail
     {
-        component_type type = get_component_type<typename Component::wrapped_type>();
-        std::vector<naming::gid_type> gids;
-        if(!enabled(type))
+        // Components allocated from a list of wrapper heaps can be placed
+        // next to each other, which gives them a contiguous range of global
+        // ids bound in AGAS all at once.
+        template <typename Component>
+        struct supports_bulk_allocation
+          : std::is_base_of<
+                util::one_size_heap_list, typename Component::heap_type>
+        {};
+
+        template <typename Component, typename...Ts>
+        std::vector<naming::gid_type> bulk_create(std::false_type,
+            component_type, std::size_t count, Ts&&...ts)
         {
-            HPX_THROW_EXCEPTION(bad_request,
-                "components::server::bulk_create",
-                "the component is disabled for this locality (" +
-                get_component_type_name(type) + ")");
+            std::vector<naming::gid_type> gids;
+            gids.reserve(count);
+
+            for (std::size_t i = 0; i != count; ++i)
+                gids.push_back(create<Component>(ts...));
+
             return gids;
         }
 
-        gids.reserve(count);
-
-        Component *storage =
-            static_cast<Component*>(component_heap<Component>().alloc(count));
-        Component *storage_it = storage;
-        std::size_t succeeded = 0;
-        try
+        template <typename Component, typename...Ts>
+        std::vector<naming::gid_type> bulk_create(std::true_type,
+            component_type type, std::size_t count, Ts&&...ts)
         {
-            // Call constructors and try to get the GID...
-            for (std::size_t i = 0; i != count; ++i, ++storage_it)
+            std::vector<naming::gid_type> gids;
+            gids.reserve(count);
+
+            Component *storage = static_cast<Component*>(
+                component_heap<Component>().alloc(count));
+            Component *storage_it = storage;
+            std::size_t succeeded = 0;
+            try
             {
-                Component* c = nullptr;
-                c = new(storage_it) Component(std::forward<Ts>(ts)...);
-                naming::gid_type gid = c->get_base_gid();
-                if (!gid)
+                // Call constructors and try to get the GID...
+                for (std::size_t i = 0; i != count; ++i, ++storage_it)
                 {
-                    c->finalize();
-                    c->~Component();
-                    HPX_THROW_EXCEPTION(hpx::unknown_component_address,
-                        "bulk_create<Component>",
-                        "can't assign global id");
+                    Component* c = nullptr;
+                    c = new(storage_it) Component(ts...);
+                    naming::gid_type gid = c->get_base_gid();
+                    if (!gid)
+                    {
+                        c->finalize();
+                        c->~Component();
+                        HPX_THROW_EXCEPTION(hpx::unknown_component_address,
+                            "bulk_create<Component>",
+                            "can't assign global id");
+                    }
+                    gids.push_back(std::move(gid));
+                    ++instance_count(type);
+                    ++succeeded;
                 }
-                gids.push_back(std::move(gid));
-                ++instance_count(type);
-                ++succeeded;
             }
-        }
-        catch(...)
-        {
-            // If an exception wsa thrown, roll back
-            storage_it = storage;
-            for (std::size_t i = 0; i != succeeded; ++i, ++storage_it)
+            catch(...)
             {
-                storage_it->finalize();
-                storage_it->~Component();
-                --instance_count(type);
+                // If an exception wsa thrown, roll back
+                storage_it = storage;
+                for (std::size_t i = 0; i != succeeded; ++i, ++storage_it)
+                {
+                    storage_it->finalize();
+                    storage_it->~Component();
+                    --instance_count(type);
+                }
+                component_heap<Component>().free(storage, count);
+                throw;
             }
-            component_heap<Component>().free(storage, count);
-            throw;
+
+            return gids;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Create count components and forward the passed parameters
+    template <typename Component, typename...Ts>
+    std::vector<naming::gid_type> bulk_create(std::size_t count, Ts&&...ts)
+    {
+        component_type type = get_component_type<typename Component::wrapped_type>();
+        if(!enabled(type))
+        {
+            HPX_THROW_EXCEPTION(bad_request,
+                "components::server::bulk_create",
+                "the component is disabled for this locality (" +
+                get_component_type_name(type) + ")");
+            return std::vector<naming::gid_type>();
         }
 
-        return gids;
+        // components which can't be allocated contiguously are created one
+        // by one
+        return detail::bulk_create<Component>(
+            typename detail::supports_bulk_allocation<Component>::type(),
+            type, count, std::forward<Ts>(ts)...);
     }
 }}}
 
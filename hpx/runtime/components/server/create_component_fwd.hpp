@@ -9,10 +9,12 @@
 #define HPX_COMPONENTS_SERVER_CREATE_COMPONENT_FWD_JUN_22_2015_0206PM
 
 #include <hpx/config.hpp>
+#include <hpx/runtime/components/component_type.hpp>
 #include <hpx/runtime/naming/address.hpp>
 
 #include <cstddef>
 #include <cstdint>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -31,6 +33,13 @@ namespace hpx { namespace components { namespace server
     template <typename Component, typename...Ts>
     std::vector<naming::gid_type> bulk_create(std::size_t count, Ts&&...ts);
 
+    namespace detail
+    {
+        template <typename Component, typename...Ts>
+        std::vector<naming::gid_type> bulk_create(std::true_type,
+            components::component_type type, std::size_t count, Ts&&...ts);
+    }
+
     template <typename Component, typename...Ts>
     inline naming::gid_type construct(Ts&&...ts)
     {
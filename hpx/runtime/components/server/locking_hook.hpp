@@ -7,11 +7,13 @@
 #define HPX_COMPONENTS_SERVER_LOCKING_HOOK_OCT_17_2012_0732PM
 
 #include <hpx/config.hpp>
+#include <hpx/lcos/local/no_mutex.hpp>
 #include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/runtime/get_lva.hpp>
 #include <hpx/runtime/threads/coroutines/coroutine.hpp>
 #include <hpx/traits/action_decorate_function.hpp>
 #include <hpx/util/bind_front.hpp>
+#include <hpx/util/always_void.hpp>
 #include <hpx/util/register_locks.hpp>
 #include <hpx/util/unlock_guard.hpp>
 
@@ -21,9 +23,30 @@
 
 namespace hpx { namespace components
 {
+    namespace detail
+    {
+        template <typename Mutex, typename Enable = void>
+        struct supports_shared_locking
+          : std::false_type
+        {};
+
+        template <typename Mutex>
+        struct supports_shared_locking<Mutex,
+                typename util::always_void<
+                    decltype(std::declval<Mutex&>().lock_shared())
+                >::type>
+          : std::true_type
+        {};
+    }
+
     /// This hook can be inserted into the derivation chain of any component
     /// allowing to automatically lock all action invocations for any instance
     /// of the given component.
+    ///
+    /// Actions marked as read-only (see \a HPX_ACTION_IS_READ_ONLY) acquire
+    /// a shared lock if the mutex supports it (for instance
+    /// \a lcos::local::shared_mutex), they are executed concurrently with
+    /// each other but not with any other action.
     template <typename BaseComponent, typename Mutex = lcos::local::spinlock>
     struct locking_hook : BaseComponent
     {
@@ -61,6 +84,20 @@ namespace hpx { namespace components
                     lva, std::forward<F>(f))));
         }
 
+        /// This is the hook implementation for decorate_action used for
+        /// read-only actions. It acquires a shared lock if the mutex supports
+        /// it and an exclusive lock otherwise.
+        template <typename F>
+        static threads::thread_function_type
+        decorate_read_only_action(naming::address::address_type lva, F && f)
+        {
+            return util::one_shot(util::bind_front(
+                &locking_hook::read_only_thread_function,
+                get_lva<this_component_type>::call(lva),
+                traits::component_decorate_read_only_function<base_type>::call(
+                    lva, std::forward<F>(f))));
+        }
+
     protected:
         typedef util::function_nonser<
             threads::thread_arg_type(threads::thread_result_type)
@@ -115,6 +152,62 @@ namespace hpx { namespace components
             return result;
         }
 
+        threads::thread_result_type read_only_thread_function(
+            threads::thread_function_type f, threads::thread_arg_type state)
+        {
+            return read_only_thread_function_impl(
+                detail::supports_shared_locking<mutex_type>(),
+                std::move(f), state);
+        }
+
+        threads::thread_result_type read_only_thread_function_impl(
+            std::false_type,
+            threads::thread_function_type f, threads::thread_arg_type state)
+        {
+            return thread_function(std::move(f), state);
+        }
+
+        struct shared_lock_guard
+        {
+            explicit shared_lock_guard(mutex_type& mtx)
+              : mtx_(mtx)
+            {
+                mtx_.lock_shared();
+                util::ignore_lock(&mtx_);
+            }
+
+            ~shared_lock_guard()
+            {
+                util::reset_ignored(&mtx_);
+                mtx_.unlock_shared();
+            }
+
+            mutex_type& mtx_;
+        };
+
+        // Execute the wrapped read-only action while holding a shared lock.
+        threads::thread_result_type read_only_thread_function_impl(
+            std::true_type,
+            threads::thread_function_type f, threads::thread_arg_type state)
+        {
+            threads::thread_result_type result(threads::unknown,
+                threads::invalid_thread_id);
+
+            shared_lock_guard l(mtx_);
+
+            {
+                // register our yield decorator
+                decorate_wrapper yield_decorator(util::bind_front(
+                    &locking_hook::read_only_yield_function, this));
+
+                result = f(state);
+
+                (void)yield_decorator;       // silence gcc warnings
+            }
+
+            return result;
+        }
+
         struct undecorate_wrapper
         {
             undecorate_wrapper()
@@ -151,9 +244,52 @@ namespace hpx { namespace components
             return result;
         }
 
+        // The same for read-only actions, this releases the shared lock while
+        // the thread is suspended.
+        threads::thread_arg_type read_only_yield_function(
+            threads::thread_result_type state)
+        {
+            undecorate_wrapper yield_decorator;
+            threads::thread_arg_type result = threads::wait_unknown;
+
+            util::reset_ignored(&mtx_);
+            mtx_.unlock_shared();
+
+            result = threads::get_self().yield_impl(state);
+
+            mtx_.lock_shared();
+            util::ignore_lock(&mtx_);
+
+            return result;
+        }
+
     private:
         mutable mutex_type mtx_;
     };
+
+    /// Components which are never modified after their construction do not
+    /// need to lock anything. Using a locking_hook with
+    /// \a lcos::local::no_mutex skips the hook entirely, the actions of those
+    /// components are scheduled as if it was not there.
+    template <typename BaseComponent>
+    struct locking_hook<BaseComponent, lcos::local::no_mutex> : BaseComponent
+    {
+    private:
+        typedef BaseComponent base_type;
+
+    public:
+        template <typename ...Arg>
+        locking_hook(Arg &&... arg)
+          : base_type(std::forward<Arg>(arg)...)
+        {}
+
+        locking_hook(locking_hook const& rhs)
+          : base_type(rhs)
+        {}
+        locking_hook(locking_hook && rhs)
+          : base_type(std::move(rhs))
+        {}
+    };
 }}
 
 #endif
@@ -478,7 +478,9 @@ namespace hpx { namespace components
             naming::gid_type const& gid, void** p, Ts&&...ts);
 
         template <typename Component_, typename...Ts>
-        friend std::vector<naming::gid_type> bulk_create(std::size_t count, Ts&&...ts);
+        friend std::vector<naming::gid_type> server::detail::bulk_create(
+            std::true_type, components::component_type type,
+            std::size_t count, Ts&&...ts);
 #else
     public:
 #endif
@@ -104,6 +104,11 @@ namespace hpx { namespace components { namespace server
     //    to the old locality will be properly forwarded to the new location
     //    of the object. Eventually this entry will have to be cleaned up no
     //    later than when the object is destroyed.
+    //    d) Remember the new address of the object on locality B as soon as
+    //       the migration has finished (see step 2c). Parcels arriving
+    //       afterwards are sent to locality C directly instead of being routed
+    //       through locality D, and the sending locality is told about the new
+    //       address of the object.
     //
     ///////////////////////////////////////////////////////////////////////////
 
@@ -156,6 +161,12 @@ namespace hpx { namespace components { namespace server
                         {
                             agas::unmark_as_migrated(to_migrate.get_gid());
                         }
+                        else
+                        {
+                            // forward parcels still arriving here directly
+                            // to the new location
+                            agas::track_migrated_object(to_migrate.get_gid());
+                        }
                         return f.get();
                     });
         }
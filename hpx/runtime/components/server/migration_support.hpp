@@ -40,6 +40,7 @@ namespace hpx { namespace components
         migration_support(Arg &&... arg)
           : base_type(std::forward<Arg>(arg)...)
           , pin_count_(0)
+          , activity_count_(0)
           , was_marked_for_migration_(false)
         {}
 
@@ -78,7 +79,10 @@ namespace hpx { namespace components
             std::lock_guard<mutex_type> l(mtx_);
             HPX_ASSERT(pin_count_ != ~0x0u);
             if (pin_count_ != ~0x0u)
+            {
                 ++pin_count_;
+                ++activity_count_;
+            }
         }
         bool unpin()
         {
@@ -133,6 +137,18 @@ namespace hpx { namespace components
             std::lock_guard<mutex_type> l(mtx_);
             return pin_count_;
         }
+
+        // Return the number of times this object was pinned (i.e. the number
+        // of actions scheduled for it), this is used by the load_balancer
+        std::uint64_t activity_count(bool reset = false)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            std::uint64_t const result = activity_count_;
+            if (reset)
+                activity_count_ = 0;
+            return result;
+        }
+
         void mark_as_migrated()
         {
             std::lock_guard<mutex_type> l(mtx_);
@@ -200,6 +216,20 @@ namespace hpx { namespace components
                 components::pinned_ptr::create<this_component_type>(lva)));
         }
 
+        /// The same for read-only actions, those are passed on to the
+        /// decoration for read-only actions of the base component.
+        template <typename F>
+        static threads::thread_function_type
+        decorate_read_only_action(naming::address::address_type lva, F && f)
+        {
+            return util::one_shot(util::bind_front(
+                &migration_support::thread_function,
+                get_lva<this_component_type>::call(lva),
+                traits::component_decorate_read_only_function<base_type>::call(
+                    lva, std::forward<F>(f)),
+                components::pinned_ptr::create<this_component_type>(lva)));
+        }
+
         // Return whether the given object was migrated, if it was not
         // migrated, it also returns a pinned pointer.
         static std::pair<bool, components::pinned_ptr>
@@ -227,6 +257,7 @@ namespace hpx { namespace components
     private:
         mutable mutex_type mtx_;
         std::uint32_t pin_count_;
+        std::uint64_t activity_count_;
         hpx::lcos::local::promise<void> trigger_migration_;
         bool was_marked_for_migration_;
     };
@@ -283,6 +283,7 @@ namespace hpx { namespace components { namespace server
             bool isdefault, bool isenabled,
             boost::program_options::options_description& options,
             std::set<std::string>& startup_handled);
+        void register_component_types(hpx::util::plugin::dll& d);
 
         bool load_startup_shutdown_functions(hpx::util::plugin::dll& d,
             error_code& ec);
@@ -425,14 +426,8 @@ namespace hpx { namespace components { namespace server
                 typename Component::wrapped_type>();
 
 
-        std::vector<naming::gid_type> ids;
-        ids.reserve(count);
-
         typedef typename Component::wrapping_type wrapping_type;
-        for (std::size_t i = 0; i != count; ++i)
-        {
-            ids.push_back(create<wrapping_type>());
-        }
+        std::vector<naming::gid_type> ids = bulk_create<wrapping_type>(count);
 
         LRT_(info) << "successfully created " << count //-V128
                    << " component(s) of type: "
@@ -449,14 +444,9 @@ namespace hpx { namespace components { namespace server
             components::get_component_type<
                 typename Component::wrapped_type>();
 
-        std::vector<naming::gid_type> ids;
-        ids.reserve(count);
-
         typedef typename Component::wrapping_type wrapping_type;
-        for (std::size_t i = 0; i != count; ++i)
-        {
-            ids.push_back(create<wrapping_type>(v, vs...));
-        }
+        std::vector<naming::gid_type> ids =
+            bulk_create<wrapping_type>(count, v, vs...);
 
         LRT_(info) << "successfully created " << count //-V128
                    << " component(s) of type: "
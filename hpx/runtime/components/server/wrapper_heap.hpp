@@ -93,10 +93,11 @@ namespace hpx { namespace components { namespace detail
         std::size_t size() const override;
         std::size_t free_size() const override;
 
-        bool is_empty() const;
+        bool is_empty() const override;
         bool has_allocatable_slots() const;
 
         bool alloc(void** result, std::size_t count = 1) override;
+        std::size_t alloc_some(void** result, std::size_t max_count) override;
         void free(void *p, std::size_t count = 1) override;
         bool did_alloc (void *p) const override;
 
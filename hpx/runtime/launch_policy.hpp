@@ -28,11 +28,12 @@ namespace hpx
             sync = 0x08,
             fork = 0x10,  // same as async, but forces continuation stealing
             apply = 0x20,
+            work_first = 0x40,  // same as fork, but resumes the parent next
 
             sync_policies = 0x0a,       // sync | deferred
-            async_policies = 0x15,      // async | task | fork
-            all = 0x3f                  // async | deferred | task | sync |
-                                        // fork | apply
+            async_policies = 0x55,      // async | task | fork | work_first
+            all = 0x7f                  // async | deferred | task | sync |
+                                        // fork | apply | work_first
         };
 
         struct policy_holder_base
@@ -174,6 +175,22 @@ namespace hpx
             }
         };
 
+        struct work_first_policy : policy_holder<work_first_policy>
+        {
+            HPX_CONSTEXPR explicit work_first_policy(
+                    threads::thread_priority priority =
+                        threads::thread_priority_default) noexcept
+              : policy_holder<work_first_policy>(
+                    launch_policy::work_first, priority)
+            {}
+
+            HPX_CONSTEXPR work_first_policy operator()(
+                threads::thread_priority priority) const noexcept
+            {
+                return work_first_policy(priority);
+            }
+        };
+
         struct sync_policy : policy_holder<sync_policy>
         {
             HPX_CONSTEXPR sync_policy() noexcept
@@ -360,6 +377,13 @@ namespace hpx
           : detail::policy_holder<>{detail::launch_policy::fork}
         {}
 
+        /// Create a launch policy representing asynchronous execution. The
+        /// new thread is executed right away, the calling thread is resumed
+        /// next (unless it was stolen by another worker meanwhile)
+        HPX_CONSTEXPR launch(detail::work_first_policy) noexcept
+          : detail::policy_holder<>{detail::launch_policy::work_first}
+        {}
+
         /// Create a launch policy representing synchronous execution
         HPX_CONSTEXPR launch(detail::sync_policy) noexcept
           : detail::policy_holder<>{detail::launch_policy::sync}
@@ -385,6 +409,7 @@ namespace hpx
         /// \cond NOINTERNAL
         using async_policy = detail::async_policy;
         using fork_policy = detail::fork_policy;
+        using work_first_policy = detail::work_first_policy;
         using sync_policy = detail::sync_policy;
         using deferred_policy = detail::deferred_policy;
         using apply_policy = detail::apply_policy;
@@ -400,6 +425,13 @@ namespace hpx
         /// new thread is executed in a preferred way
         HPX_EXPORT static const detail::fork_policy fork;
 
+        /// Predefined launch policy representing work-first execution: the
+        /// new thread is executed right away on the current worker thread,
+        /// the calling thread is queued such that it is resumed as soon as
+        /// the new thread completes or suspends, other worker threads may
+        /// steal it in the meantime.
+        HPX_EXPORT static const detail::work_first_policy work_first;
+
         /// Predefined launch policy representing synchronous execution
         HPX_EXPORT static const detail::sync_policy sync;
 
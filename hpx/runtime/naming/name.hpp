@@ -12,6 +12,7 @@
 #include <hpx/util/spinlock_pool.hpp>
 #include <hpx/runtime/naming/id_type.hpp>
 #include <hpx/runtime/naming_fwd.hpp>
+#include <hpx/runtime/serialization/detail/compact_array_encoding.hpp>
 #include <hpx/runtime/serialization/serialization_fwd.hpp>
 #include <hpx/traits/get_remote_result.hpp>
 #include <hpx/traits/is_bitwise_serializable.hpp>
@@ -417,6 +418,23 @@ namespace hpx { namespace naming
 // we know that we can serialize a gid as a byte sequence
 HPX_IS_BITWISE_SERIALIZABLE(hpx::naming::gid_type)
 
+namespace hpx { namespace serialization { namespace detail
+{
+    // Arrays of gids are delta encoded by archives with compact encoding:
+    // the upper half of each gid is stored as the difference (xor) to the
+    // upper half of its predecessor, which is zero for gids of the same
+    // locality, the lower half as the (zigzag encoded) difference to the
+    // lower half of its predecessor.
+    template <>
+    struct compact_array_encoding<naming::gid_type> : std::true_type
+    {
+        HPX_EXPORT static void save(output_archive& ar,
+            naming::gid_type const* data, std::size_t size);
+        HPX_EXPORT static void load(input_archive& ar,
+            naming::gid_type* data, std::size_t size);
+    };
+}}}
+
 namespace hpx { namespace naming
 {
     ///////////////////////////////////////////////////////////////////////////
@@ -15,25 +15,52 @@
 #include <hpx/runtime/naming/resolver_client.hpp>
 #include <hpx/runtime/parcelset/parcel.hpp>
 #include <hpx/runtime/parcelset/detail/parcel_route_handler.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/runtime/threads/thread_init_data.hpp>
 #include <hpx/runtime_fwd.hpp>
+#include <hpx/traits/serialization_access_data.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/deferred_call.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
 #include <hpx/util/logging.hpp>
+#include <hpx/util/task_tracer.hpp>
+#include <hpx/util/thread_description.hpp>
+#include <hpx/util/yield_while.hpp>
 
 #include <boost/exception/exception.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <functional>
+#include <iterator>
 #include <sstream>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace hpx { namespace parcelset
 {
+    namespace detail
+    {
+        inline void record_parcel_receive(parcel const& p)
+        {
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+            std::uint64_t id = p.parcel_id().get_lsb();
+#else
+            std::uint64_t id = 0;
+#endif
+            util::tracing::record_event(util::tracing::event_parcel_receive,
+                id, p.get_action()->get_action_name(),
+                naming::get_locality_id_from_gid(p.source_id().get_gid()));
+        }
+    }
+
     template <typename Buffer>
     std::vector<serialization::serialization_chunk> decode_chunks(Buffer & buffer)
     {
@@ -75,8 +102,7 @@ namespace hpx { namespace parcelset
                  ++i)
             {
                 transmission_chunk_type& c = buffer.transmission_chunks_[i];
-                std::size_t first = static_cast<std::size_t>(
-                    static_cast<std::uint64_t>(c.first));
+                std::uint64_t first = static_cast<std::uint64_t>(c.first);
                 std::size_t second = static_cast<std::size_t>(
                     static_cast<std::uint64_t>(c.second));
 
@@ -84,8 +110,24 @@ namespace hpx { namespace parcelset
                 while (chunks[index].size_ != 0)
                     ++index;
 
-                // place the index based chunk at the right spot
-                chunks[index] = serialization::create_index_chunk(first, second);
+                if (first & Buffer::reference_chunk_flag)
+                {
+                    // repeat the zero-copy chunk the data was sent with
+                    serialization::serialization_chunk const& ref =
+                        chunks[static_cast<std::size_t>(
+                            first & ~Buffer::reference_chunk_flag)];
+                    HPX_ASSERT(ref.type_ == serialization::chunk_type_pointer &&
+                        ref.size_ == second);
+
+                    chunks[index] = serialization::create_pointer_chunk(
+                        ref.data_.cpos_, second);
+                }
+                else
+                {
+                    // place the index based chunk at the right spot
+                    chunks[index] = serialization::create_index_chunk(
+                        static_cast<std::size_t>(first), second);
+                }
                 ++index;
             }
 #if defined(HPX_DEBUG)
@@ -102,11 +144,291 @@ namespace hpx { namespace parcelset
         return chunks;
     }
 
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Decode the given number of parcels from the archive, the parcels of
+        // direct actions are appended to deferred_parcels if deferred is set.
+        // Returns the time spent for scheduling the parcels.
+        template <typename Parcelport>
+        std::int64_t decode_parcels_sequence(Parcelport & pp,
+            serialization::input_archive & archive, std::size_t parcel_count,
+            bool deferred, parcel_batch const* batch, std::size_t num_thread,
+            std::vector<parcel> & deferred_parcels)
+        {
+            util::high_resolution_timer timer;
+            std::int64_t overall_add_parcel_time = 0;
+
+            for(std::size_t i = 0; i != parcel_count; ++i)
+            {
+                bool deferred_schedule = deferred;
+
+#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
+                std::size_t archive_pos = archive.current_pos();
+                std::int64_t serialize_time = timer.elapsed_nanoseconds();
+#endif
+                // de-serialize parcel and add it to incoming parcel queue
+                parcel p;
+                // deferred_schedule will be set to false if the action
+                // to be loaded is a non direct action. If we only got
+                // one parcel to decode, deferred_schedule will be
+                // preset to false and the direct action will be called
+                // directly
+                bool migrated = batch != nullptr ?
+                    p.load_schedule(archive, num_thread,
+                        deferred_schedule, *batch) :
+                    p.load_schedule(archive, num_thread,
+                        deferred_schedule);
+
+                std::int64_t add_parcel_time = timer.elapsed_nanoseconds();
+
+                if (HPX_UNLIKELY(util::tracing::tracing_enabled))
+                    detail::record_parcel_receive(p);
+
+#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
+                performance_counters::parcels::data_point action_data;
+                action_data.bytes_ = archive.current_pos() - archive_pos;
+                action_data.serialization_time_ =
+                    add_parcel_time - serialize_time;
+                action_data.num_parcels_ = 1;
+                pp.add_received_data(p.get_action()->get_action_name(),
+                    action_data);
+#endif
+
+                // make sure this parcel ended up on the right locality
+                naming::gid_type const& here = hpx::get_locality();
+                if (hpx::get_runtime_ptr() && here &&
+                    (naming::get_locality_id_from_gid(
+                         p.destination_locality()) !=
+                     naming::get_locality_id_from_gid(here)))
+                {
+                    std::ostringstream os;
+                    os << "parcel destination does not match "
+                          "locality which received the parcel ("
+                       << here << "), " << p;
+                    HPX_THROW_EXCEPTION(invalid_status,
+                        "hpx::parcelset::decode_message",
+                        os.str());
+                    return overall_add_parcel_time;
+                }
+
+                if (migrated)
+                {
+                    naming::resolver_client& client =
+                        hpx::naming::get_agas_client();
+                    client.route(
+                        std::move(p),
+                        &parcelset::detail::parcel_route_handler,
+                        threads::thread_priority_normal);
+                }
+                // If we got a direct action,
+                else if (deferred_schedule)
+                    deferred_parcels.push_back(std::move(p));
+
+                // be sure not to measure add_parcel as serialization time
+                overall_add_parcel_time += timer.elapsed_nanoseconds() -
+                    add_parcel_time;
+            }
+
+            return overall_add_parcel_time;
+        }
+
+        inline void schedule_deferred_parcels(
+            std::vector<parcel> & deferred_parcels, std::size_t num_thread)
+        {
+            if (deferred_parcels.size() > 1)
+            {
+                // schedule all but the first parcel using a single
+                // new thread.
+                std::vector<parcel> parcels;
+                parcels.reserve(deferred_parcels.size() - 1);
+                std::move(deferred_parcels.begin() + 1,
+                    deferred_parcels.end(), std::back_inserter(parcels));
+
+                hpx::applier::register_thread_nullary(
+                    util::deferred_call(
+                        [num_thread](std::vector<parcel>&& ps)
+                        {
+                            for (parcel& p : ps)
+                                p.schedule_action(num_thread);
+                        }, std::move(parcels)),
+                    "schedule_parcels",
+                    threads::pending, true,
+                    threads::thread_priority_boost,
+                    threads::thread_schedule_hint(
+                        static_cast<std::int16_t>(num_thread)),
+                    threads::thread_stacksize_default);
+            }
+            if (!deferred_parcels.empty())
+            {
+                // If we are the first deferred parcel, we don't need to spin
+                // a new thread...
+                deferred_parcels[0].schedule_action(num_thread);
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Decode the parcels of one segment of a message (see encode_parcels)
+        template <typename Parcelport, typename Buffer>
+        struct decode_segment
+        {
+            void operator()()
+            {
+                std::size_t const num_thread = num_thread_;
+                std::vector<parcel> deferred_parcels;
+
+                try {
+                    serialization::input_archive archive(buffer_.data_,
+                        inbound_data_size_, &chunks_, flags_, pos_);
+
+                    deferred_parcels.reserve(parcel_count_);
+                    decode_parcels_sequence(pp_, archive, parcel_count_,
+                        true, &batch_, num_thread, deferred_parcels);
+                }
+                catch (...) {
+                    LPT_(error)
+                        << "decode_message: caught exception while decoding "
+                           "a message segment.";
+                    hpx::report_error(std::current_exception());
+                    deferred_parcels.clear();
+                }
+
+                // the message may not be accessed anymore
+                --pending_;
+
+                try {
+                    for (parcel& p : deferred_parcels)
+                        p.schedule_action(num_thread);
+                }
+                catch (...) {
+                    hpx::report_error(std::current_exception());
+                }
+            }
+
+            Parcelport & pp_;
+            Buffer & buffer_;
+            std::size_t inbound_data_size_;
+            std::vector<serialization::serialization_chunk> const& chunks_;
+            std::uint32_t flags_;
+            serialization::archive_position pos_;
+            std::size_t parcel_count_;
+            parcel_batch const& batch_;
+            std::size_t num_thread_;
+            std::atomic<std::size_t> & pending_;
+        };
+
+        // Return the position of the given offset into the last chunk of a
+        // message
+        inline serialization::archive_position message_tail_position(
+            std::vector<serialization::serialization_chunk> const& chunks,
+            std::uint64_t data_pos)
+        {
+            serialization::archive_position pos;
+            pos.data_pos_ = data_pos;
+            if (!chunks.empty())
+            {
+                serialization::serialization_chunk const& c = chunks.back();
+                if (c.type_ != serialization::chunk_type_index ||
+                    c.data_.index_ > data_pos)
+                {
+                    HPX_THROW_EXCEPTION(serialization_error,
+                        "hpx::parcelset::decode_message",
+                        "invalid message segment table");
+                    return pos;
+                }
+                pos.chunk_ = chunks.size() - 1;
+                pos.chunk_pos_ = data_pos - c.data_.index_;
+            }
+            return pos;
+        }
+
+        // Spawn the decoding of all but the first segment of a message. The
+        // positions of the segments are stored at the end of the message,
+        // its last 8 bytes hold the offset of the table.
+        template <typename Parcelport, typename Buffer>
+        void spawn_decode_segments(Parcelport & pp, Buffer & buffer,
+            std::size_t inbound_data_size,
+            std::vector<serialization::serialization_chunk> const& chunks,
+            std::uint32_t flags, std::size_t parcel_count,
+            std::size_t segment_size, parcel_batch const& batch,
+            std::size_t num_thread, std::atomic<std::size_t> & pending)
+        {
+            typedef typename std::decay<decltype(buffer.data_)>::type
+                data_type;
+            typedef traits::serialization_access_data<data_type> access_traits;
+
+            std::size_t const size = access_traits::size(buffer.data_);
+            if (size < sizeof(std::uint64_t))
+            {
+                HPX_THROW_EXCEPTION(serialization_error,
+                    "hpx::parcelset::decode_message",
+                    "invalid message segment table");
+                return;
+            }
+
+            std::vector<serialization::archive_position> segments;
+            {
+                std::uint64_t table_pos = 0;
+                serialization::input_archive archive(buffer.data_,
+                    inbound_data_size, &chunks, flags,
+                    message_tail_position(chunks, size - sizeof(std::uint64_t)));
+                archive >> table_pos;
+
+                serialization::input_archive table(buffer.data_,
+                    inbound_data_size, &chunks, flags,
+                    message_tail_position(chunks, table_pos));
+                table >> segments;
+            }
+
+            std::size_t const num_segments =
+                (parcel_count + segment_size - 1) / segment_size;
+            if (segments.size() != num_segments - 1)
+            {
+                HPX_THROW_EXCEPTION(serialization_error,
+                    "hpx::parcelset::decode_message",
+                    "invalid message segment table");
+                return;
+            }
+
+            typedef decode_segment<Parcelport, Buffer> decode_segment_type;
+            typedef hpx::applier::detail::thread_function_nullary<
+                    decode_segment_type
+                > thread_function;
+
+            util::thread_description desc("decode_parcels");
+            std::ptrdiff_t stacksize =
+                threads::get_stack_size(threads::thread_stacksize_default);
+
+            std::vector<threads::thread_init_data> data;
+            data.reserve(segments.size());
+
+            for (std::size_t i = 1; i != num_segments; ++i)
+            {
+                std::size_t const count = (std::min)(
+                    segment_size, parcel_count - i * segment_size);
+
+                decode_segment_type f = { pp, buffer, inbound_data_size,
+                    chunks, flags, segments[i - 1], count, batch, num_thread,
+                    pending };
+
+                data.emplace_back(
+                    threads::thread_function_type(
+                        thread_function{std::move(f)}),
+                    desc, 0, threads::thread_priority_boost,
+                    threads::thread_schedule_hint(), stacksize);
+            }
+
+            pending += data.size();
+            threads::register_threads(data);
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
+    // Decode the parcels held by the given buffer without taking it over.
     template <typename Parcelport, typename Buffer>
-    void decode_message_with_chunks(
+    void decode_message_with_chunks_in_place(
         Parcelport & pp
-      , Buffer buffer
+      , Buffer & buffer
       , std::size_t parcel_count
       , std::vector<serialization::serialization_chunk> &chunks
       , std::size_t num_thread = -1
@@ -115,6 +437,19 @@ namespace hpx { namespace parcelset
         std::size_t inbound_data_size = static_cast<std::size_t>(
             static_cast<std::uint64_t>(buffer.data_size_));
 
+        buffer.update_memory_accounting();
+
+        // the segments of a message decoded concurrently, they refer to the
+        // buffer which is reused once this function has returned
+        std::atomic<std::size_t> pending(0);
+        auto wait_for_segments =
+            [&pending]()
+            {
+                util::yield_while(
+                    [&pending]() { return pending.load() != 0; },
+                    "decode_message");
+            };
+
         // protect from un-handled exceptions bubbling up
         try {
             try {
@@ -130,104 +465,55 @@ namespace hpx { namespace parcelset
                     serialization::input_archive archive(buffer.data_,
                         inbound_data_size, &chunks);
 
-                    if(parcel_count == 0)
+                    // Messages holding a parcel count store the information
+                    // shared by all parcels only once (see encode_parcels).
+                    detail::parcel_batch batch;
+                    bool const batched = parcel_count == 0;
+                    std::uint64_t segment_size = 0;
+                    if(batched)
                     {
                         archive >> parcel_count; //-V128
+                        archive >> batch;
+                        archive >> segment_size;
                     }
-                    if (parcel_count > 1)
-                        deferred_parcels.reserve(parcel_count);
 
-                    for(std::size_t i = 0; i != parcel_count; ++i)
+                    // Large messages are split into segments, all but the
+                    // first one are decoded concurrently by new threads. The
+                    // parcels can be decoded sequentially as well.
+                    std::size_t count = parcel_count;
+                    if (segment_size != 0 && parcel_count > segment_size &&
+                        hpx::is_running() && hpx::get_os_thread_count() > 1)
                     {
-                        bool deferred_schedule = parcel_count > 1;
-
-#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
-                        std::size_t archive_pos = archive.current_pos();
-                        std::int64_t serialize_time = timer.elapsed_nanoseconds();
-#endif
-                        // de-serialize parcel and add it to incoming parcel queue
-                        parcel p;
-                        // deferred_schedule will be set to false if the action
-                        // to be loaded is a non direct action. If we only got
-                        // one parcel to decode, deferred_schedule will be
-                        // preset to false and the direct action will be called
-                        // directly
-                        bool migrated = p.load_schedule(archive, num_thread,
-                            deferred_schedule);
-
-                        std::int64_t add_parcel_time = timer.elapsed_nanoseconds();
+                        detail::spawn_decode_segments(pp, buffer,
+                            inbound_data_size, chunks, archive.flags(),
+                            parcel_count,
+                            static_cast<std::size_t>(segment_size), batch,
+                            num_thread, pending);
+                        count = static_cast<std::size_t>(segment_size);
+                    }
 
-#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
-                        performance_counters::parcels::data_point action_data;
-                        action_data.bytes_ = archive.current_pos() - archive_pos;
-                        action_data.serialization_time_ =
-                            add_parcel_time - serialize_time;
-                        action_data.num_parcels_ = 1;
-                        pp.add_received_data(p.get_action()->get_action_name(),
-                            action_data);
-#endif
+                    if (count > 1)
+                        deferred_parcels.reserve(count);
 
-                        // make sure this parcel ended up on the right locality
-                        naming::gid_type const& here = hpx::get_locality();
-                        if (hpx::get_runtime_ptr() && here &&
-                            (naming::get_locality_id_from_gid(
-                                 p.destination_locality()) !=
-                             naming::get_locality_id_from_gid(here)))
-                        {
-                            std::ostringstream os;
-                            os << "parcel destination does not match "
-                                  "locality which received the parcel ("
-                               << here << "), " << p;
-                            HPX_THROW_EXCEPTION(invalid_status,
-                                "hpx::parcelset::decode_message",
-                                os.str());
-                            return;
-                        }
-
-                        if (migrated)
-                        {
-                            naming::resolver_client& client =
-                                hpx::naming::get_agas_client();
-                            client.route(
-                                std::move(p),
-                                &parcelset::detail::parcel_route_handler,
-                                threads::thread_priority_normal);
-                        }
-                        // If we got a direct action,
-                        else if (deferred_schedule)
-                            deferred_parcels.push_back(std::move(p));
-
-                        // be sure not to measure add_parcel as serialization time
-                        overall_add_parcel_time += timer.elapsed_nanoseconds() -
-                            add_parcel_time;
+                    try {
+                        overall_add_parcel_time =
+                            detail::decode_parcels_sequence(pp, archive, count,
+                                parcel_count > 1, batched ? &batch : nullptr,
+                                num_thread, deferred_parcels);
+                    }
+                    catch (...) {
+                        wait_for_segments();
+                        throw;
                     }
+                    wait_for_segments();
 
                     // complete received data with parcel count
                     data.num_parcels_ = parcel_count;
-                    data.raw_bytes_ = archive.bytes_read();
+                    data.raw_bytes_ = segment_size != 0 ?
+                        inbound_data_size : archive.bytes_read();
 
-                    if (!deferred_parcels.empty())
-                    {
-                        for (std::size_t i = 1; i != deferred_parcels.size(); ++i)
-                        {
-                            // schedule all but the first parcel on a new thread.
-                            hpx::applier::register_thread_nullary(
-                                util::deferred_call(
-                                    [num_thread](parcel&& p)
-                                    {
-                                        p.schedule_action(num_thread);
-                                    }, std::move(deferred_parcels[i])),
-                                "schedule_parcel",
-                                threads::pending, true,
-                                threads::thread_priority_boost,
-                                threads::thread_schedule_hint(
-                                    static_cast<std::int16_t>(num_thread)),
-                                threads::thread_stacksize_default);
-                        }
-                        // If we are the first deferred parcel, we don't need to spin
-                        // a new thread...
-                        deferred_parcels[0].schedule_action(num_thread);
-                    }
+                    detail::schedule_deferred_parcels(
+                        deferred_parcels, num_thread);
                 }
 
                 // store the time required for serialization
@@ -268,6 +554,19 @@ namespace hpx { namespace parcelset
         }
     }
 
+    template <typename Parcelport, typename Buffer>
+    void decode_message_with_chunks(
+        Parcelport & pp
+      , Buffer buffer
+      , std::size_t parcel_count
+      , std::vector<serialization::serialization_chunk> &chunks
+      , std::size_t num_thread = -1
+    )
+    {
+        decode_message_with_chunks_in_place(pp, buffer, parcel_count, chunks,
+            num_thread);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename Parcelport, typename Buffer>
     void decode_message(
@@ -321,6 +620,24 @@ namespace hpx { namespace parcelset
         }
     }
 
+    // Decode the parcels held by the given buffer without taking it over.
+    // The buffer is cleared afterwards, it keeps its memory for receiving
+    // the next message unless that exceeds the maximal outbound message
+    // size of the parcelport (which is the usual upper bound of coalesced
+    // messages).
+    template <typename Parcelport, typename Buffer>
+    void decode_parcels_in_place(Parcelport & parcelport, Buffer & buffer,
+        std::size_t num_thread)
+    {
+        std::vector<serialization::serialization_chunk>
+            chunks(decode_chunks(buffer));
+        decode_message_with_chunks_in_place(parcelport, buffer, 0, chunks,
+            num_thread);
+
+        buffer.clear(static_cast<std::size_t>(
+            parcelport.get_max_outbound_message_size()));
+    }
+
 }}
 
 #endif
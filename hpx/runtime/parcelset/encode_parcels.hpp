@@ -14,24 +14,29 @@
 #include <hpx/exception.hpp>
 #include <hpx/exception_info.hpp>
 #include <hpx/runtime/actions/basic_action.hpp>
+#include <hpx/runtime/actions/detail/action_latency_registry.hpp>
 #include <hpx/runtime/parcelset/parcel.hpp>
 #include <hpx/runtime/parcelset/parcel_buffer.hpp>
 #include <hpx/runtime/parcelset/parcelport.hpp>
 #include <hpx/runtime/parcelset_fwd.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
 #include <hpx/runtime_fwd.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
 #include <hpx/util/integer/endian.hpp>
 #include <hpx/util/logging.hpp>
+#include <hpx/util/task_tracer.hpp>
 
 #include <boost/exception/exception.hpp>
 
 #include <cstddef>
 #include <cstdint>
 #include <exception>
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace hpx
@@ -40,6 +45,19 @@ namespace hpx
     {
         namespace detail
         {
+            ///////////////////////////////////////////////////////////////////
+            inline void record_parcel_send(parcel const& p)
+            {
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+                std::uint64_t id = p.parcel_id().get_lsb();
+#else
+                std::uint64_t id = 0;
+#endif
+                util::tracing::record_event(util::tracing::event_parcel_send,
+                    id, p.get_action()->get_action_name(),
+                    p.destination_locality_id());
+            }
+
             ///////////////////////////////////////////////////////////////////
             inline char
             to_digit(int number)
@@ -76,8 +94,46 @@ namespace hpx
                 return result;
             }
 
+            ///////////////////////////////////////////////////////////////////
+            // Replace the zero-copy chunks which refer to the same data as
+            // an earlier zero-copy chunk of the message (for instance the
+            // same serialize_buffer passed to several coalesced parcels) by
+            // references to that chunk, the data is sent only once.
+            template <typename Chunk>
+            void deduplicate_chunks(std::vector<Chunk>& chunks)
+            {
+                typedef std::pair<void const*, std::size_t> key_type;
+                std::map<key_type, std::size_t> sent;
+
+                std::size_t num_pointer_chunks = 0;
+                for (Chunk const& c : chunks)
+                {
+                    if (c.type_ == serialization::chunk_type_pointer)
+                        ++num_pointer_chunks;
+                }
+                if (num_pointer_chunks < 2)
+                    return;
+
+                for (std::size_t i = 0; i != chunks.size(); ++i)
+                {
+                    Chunk& c = chunks[i];
+                    if (c.type_ != serialization::chunk_type_pointer)
+                        continue;
+
+                    auto r = sent.insert(
+                        std::make_pair(key_type(c.data_.cpos_, c.size_), i));
+                    if (!r.second)
+                    {
+                        c.type_ = static_cast<std::uint8_t>(
+                            serialization::chunk_type_reference);
+                        c.data_.index_ = r.first->second;
+                    }
+                }
+            }
+
             template <typename Buffer>
-            void encode_finalize(Buffer & buffer, std::size_t arg_size)
+            void encode_finalize(Buffer & buffer, std::size_t arg_size,
+                bool deduplicate = false)
             {
                 buffer.size_ = buffer.data_.size();
                 buffer.data_size_ = arg_size;
@@ -98,6 +154,9 @@ namespace hpx
                 std::vector<transmission_chunk_type>& chunks =
                     buffer.transmission_chunks_;
 
+                if (deduplicate)
+                    deduplicate_chunks(buffer.chunks_);
+
                 chunks.clear();
                 chunks.reserve(buffer.chunks_.size());
 
@@ -122,8 +181,15 @@ namespace hpx
                             chunks.push_back(
                                 transmission_chunk_type(c.data_.index_, c.size_));
                         }
+                        else if (c.type_ == serialization::chunk_type_reference) {
+                            chunks.push_back(transmission_chunk_type(
+                                c.data_.index_ | Buffer::reference_chunk_flag,
+                                c.size_));
+                        }
                     }
                 }
+
+                buffer.update_memory_accounting();
             }
         }
 
@@ -184,20 +250,79 @@ namespace hpx
                           , &buffer.chunks_
                           , filter.get());
 
+                        // Messages holding a parcel count store the
+                        // destination locality and the table of actions
+                        // only once for all parcels.
+                        detail::parcel_batch batch;
+
+                        // Large messages are split into segments of parcels
+                        // which can be decoded concurrently by the receiver,
+                        // the positions of the segments are appended to the
+                        // message (see decode_parcels).
+                        std::uint64_t segment_size = 0;
+                        std::vector<serialization::archive_position> segments;
                         if(num_parcels != std::size_t(-1))
+                        {
                             archive << parcels_sent; //-V128
 
+                            batch = detail::parcel_batch(ps, parcels_sent);
+                            archive << batch;
+
+                            serialization::archive_position pos;
+                            std::size_t const decode_segment_size =
+                                pp.decode_segment_size();
+                            if (decode_segment_size != 0 &&
+                                parcels_sent > decode_segment_size &&
+                                archive.get_position(pos))
+                            {
+                                segment_size = decode_segment_size;
+                                segments.reserve(
+                                    parcels_sent / decode_segment_size);
+                            }
+                            archive << segment_size;
+                        }
+
                         for(std::size_t i = 0; i != parcels_sent; ++i)
                         {
 #if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
                             std::size_t archive_pos = archive.current_pos();
+#endif
+#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS) || \
+    defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
                             std::int64_t serialize_time =
                                 timer.elapsed_nanoseconds();
 #endif
 
+                            if (segment_size != 0 && i != 0 &&
+                                i % segment_size == 0)
+                            {
+                                // segments must not refer to pointers
+                                // serialized by each other
+                                archive.reset_pointer_tracking();
+
+                                serialization::archive_position pos;
+                                archive.get_position(pos);
+                                segments.push_back(pos);
+                            }
+
                             LPT_(debug) << ps[i];
                             archive.set_split_gids(ps[i].split_gids());
-                            archive << ps[i];
+                            if(num_parcels != std::size_t(-1))
+                                ps[i].save_batched(archive, batch, i);
+                            else
+                                archive << ps[i];
+
+                            if (HPX_UNLIKELY(util::tracing::tracing_enabled))
+                                detail::record_parcel_send(ps[i]);
+
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+                            if (actions::detail::maintain_action_latencies)
+                            {
+                                ps[i].get_action()->record_serialization_time(
+                                    timer.elapsed_nanoseconds() -
+                                    serialize_time);
+                            }
+#endif
 
 #if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
                             performance_counters::parcels::data_point action_data;
@@ -210,10 +335,36 @@ namespace hpx
                                 action_data);
 #endif
                         }
+
+                        if (segment_size != 0)
+                        {
+                            // the message ends with the offset of the table
+                            // of segment positions
+                            serialization::archive_position pos;
+                            archive.get_position(pos);
+                            archive << segments;
+                            archive << pos.data_pos_;
+                        }
+
                         archive.flush();
                         arg_size = archive.bytes_written();
                     }
 
+                    if (filter.get() != nullptr)
+                    {
+                        // zero-copy chunks are sent as they are
+                        std::size_t zero_copy_size = 0;
+                        for (serialization::serialization_chunk const& c :
+                            buffer.chunks_)
+                        {
+                            if (c.type_ == serialization::chunk_type_pointer)
+                                zero_copy_size += c.size_;
+                        }
+
+                        ps[0].get_action()->record_compression(
+                            arg_size - zero_copy_size, buffer.data_.size());
+                    }
+
                     // store the time required for serialization
                     buffer.data_point_.serialization_time_ =
                         timer.elapsed_nanoseconds();
@@ -259,7 +410,8 @@ namespace hpx
             }
 
             buffer.data_point_.num_parcels_ = parcels_sent;
-            detail::encode_finalize(buffer, arg_size);
+            detail::encode_finalize(
+                buffer, arg_size, pp.allow_chunk_deduplication());
 
             return parcels_sent;
         }
@@ -25,6 +25,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <hpx/config/warnings_prefix.hpp>
 
@@ -64,6 +65,8 @@ namespace hpx { namespace parcelset
 
             bool has_continuation_;
         };
+
+        class parcel_batch;
     }
 
     class HPX_EXPORT parcel
@@ -161,6 +164,16 @@ namespace hpx { namespace parcelset
         bool load_schedule(serialization::input_archive & ar,
             std::size_t num_thread, bool& deferred_schedule);
 
+        // serialization support for parcels sent as part of a message
+        // holding several parcels, the information shared by all of those
+        // is stored only once in the batch (see encode_parcels)
+        void save_batched(serialization::output_archive & ar,
+            detail::parcel_batch const& batch, std::size_t index) const;
+
+        bool load_schedule(serialization::input_archive & ar,
+            std::size_t num_thread, bool& deferred_schedule,
+            detail::parcel_batch const& batch);
+
         // generate unique parcel id
         static naming::gid_type generate_unique_id(
             std::uint32_t locality_id = naming::invalid_locality_id);
@@ -171,6 +184,10 @@ namespace hpx { namespace parcelset
         // serialization support
         friend class hpx::serialization::access;
         void load_data(serialization::input_archive & ar);
+        void load_data(serialization::input_archive & ar,
+            detail::parcel_batch const& batch);
+        bool schedule_loaded(serialization::input_archive & ar,
+            std::size_t num_thread, bool& deferred_schedule);
         void serialize(serialization::input_archive & ar, unsigned);
         void serialize(serialization::output_archive & ar, unsigned);
 
@@ -184,6 +201,50 @@ namespace hpx { namespace parcelset
         std::size_t num_chunks_;
     };
 
+    namespace detail
+    {
+        /// The information stored only once for all parcels sent in the same
+        /// message: the locality the parcels are sent to, and the table of
+        /// the actions they invoke. Each parcel refers to its action by the
+        /// index into that table.
+        class HPX_EXPORT parcel_batch
+        {
+        public:
+            parcel_batch() = default;
+
+            /// Collect the shared information of the given parcels.
+            parcel_batch(parcel const* ps, std::size_t num_parcels);
+
+            naming::gid_type const& destination_locality() const
+            {
+                return dest_locality_;
+            }
+
+            /// Return the index of the action of the parcel at the given
+            /// position (valid while encoding only).
+            std::uint16_t action_index(std::size_t i) const
+            {
+                return indices_[i];
+            }
+
+            /// Create the action stored at the given index of the table.
+            std::unique_ptr<actions::base_action> create_action(
+                std::uint16_t index, bool has_continuation) const;
+
+        private:
+            friend class hpx::serialization::access;
+            void serialize(serialization::input_archive & ar, unsigned);
+            void serialize(serialization::output_archive & ar, unsigned);
+
+            naming::gid_type dest_locality_;
+            std::vector<std::uint32_t> action_ids_;
+#if defined(HPX_DEBUG)
+            std::vector<std::string> action_names_;
+#endif
+            std::vector<std::uint16_t> indices_;
+        };
+    }
+
     HPX_EXPORT std::string dump_parcel(parcel const& p);
 }}
 
@@ -10,8 +10,10 @@
 #include <hpx/config.hpp>
 #include <hpx/performance_counters/parcels/data_point.hpp>
 #include <hpx/runtime/serialization/serialization_chunk.hpp>
+#include <hpx/util/allocation_accounting.hpp>
 #include <hpx/util/integer/endian.hpp>
 
+#include <cstdint>
 #include <utility>
 #include <vector>
 
@@ -31,6 +33,10 @@ namespace hpx { namespace parcelset
           : data_(allocator)
           , num_chunks_(count_chunks_type(0, 0))
           , size_(0), data_size_(0), header_size_(0)
+#if defined(HPX_HAVE_ALLOCATION_ACCOUNTING)
+          , data_memory_(util::allocation_accounting::parcel_buffers)
+          , chunks_memory_(util::allocation_accounting::serialization)
+#endif
         {}
 
         explicit parcel_buffer(BufferType const & data,
@@ -38,6 +44,10 @@ namespace hpx { namespace parcelset
           : data_(data, allocator)
           , num_chunks_(count_chunks_type(0, 0))
           , size_(0), data_size_(0), header_size_(0)
+#if defined(HPX_HAVE_ALLOCATION_ACCOUNTING)
+          , data_memory_(util::allocation_accounting::parcel_buffers)
+          , chunks_memory_(util::allocation_accounting::serialization)
+#endif
         {}
 
         explicit parcel_buffer(BufferType && data,
@@ -45,6 +55,10 @@ namespace hpx { namespace parcelset
           : data_(std::move(data), allocator)
           , num_chunks_(count_chunks_type(0, 0))
           , size_(0), data_size_(0), header_size_(0)
+#if defined(HPX_HAVE_ALLOCATION_ACCOUNTING)
+          , data_memory_(util::allocation_accounting::parcel_buffers)
+          , chunks_memory_(util::allocation_accounting::serialization)
+#endif
         {}
 
         explicit parcel_buffer(BufferType && data,
@@ -52,6 +66,10 @@ namespace hpx { namespace parcelset
           : data_(std::move(data))
           , num_chunks_(count_chunks_type(0, 0))
           , size_(0), data_size_(0), header_size_(0)
+#if defined(HPX_HAVE_ALLOCATION_ACCOUNTING)
+          , data_memory_(util::allocation_accounting::parcel_buffers)
+          , chunks_memory_(util::allocation_accounting::serialization)
+#endif
         {}
 
         parcel_buffer(parcel_buffer && other)
@@ -63,6 +81,10 @@ namespace hpx { namespace parcelset
           , data_size_(other.data_size_)
           , header_size_(other.header_size_)
           , data_point_(other.data_point_)
+#if defined(HPX_HAVE_ALLOCATION_ACCOUNTING)
+          , data_memory_(std::move(other.data_memory_))
+          , chunks_memory_(std::move(other.chunks_memory_))
+#endif
         {
         }
 
@@ -76,6 +98,10 @@ namespace hpx { namespace parcelset
             data_size_ = other.data_size_;
             header_size_ = other.header_size_;
             data_point_ = other.data_point_;
+#if defined(HPX_HAVE_ALLOCATION_ACCOUNTING)
+            data_memory_ = std::move(other.data_memory_);
+            chunks_memory_ = std::move(other.chunks_memory_);
+#endif
 
             return *this;
         }
@@ -92,6 +118,31 @@ namespace hpx { namespace parcelset
             data_point_ = performance_counters::parcels::data_point();
         }
 
+        // Clear the buffer for the next message while keeping the allocated
+        // memory, unless the buffer has grown beyond the given size.
+        void clear(std::size_t max_retained_size)
+        {
+            clear();
+            if (data_.capacity() > max_retained_size)
+            {
+                BufferType(data_.get_allocator()).swap(data_);
+                update_memory_accounting();
+            }
+        }
+
+        // Account for the memory held by the buffer and the chunk lists,
+        // called whenever a message was encoded into or received by it.
+        void update_memory_accounting()
+        {
+#if defined(HPX_HAVE_ALLOCATION_ACCOUNTING)
+            data_memory_.update(
+                data_.size() * sizeof(typename BufferType::value_type));
+            chunks_memory_.update(chunks_.capacity() * sizeof(ChunkType) +
+                transmission_chunks_.capacity() *
+                    sizeof(transmission_chunk_type));
+#endif
+        }
+
         BufferType data_;
         std::vector<ChunkType> chunks_;
 
@@ -100,6 +151,11 @@ namespace hpx { namespace parcelset
         > transmission_chunk_type;
         std::vector<transmission_chunk_type> transmission_chunks_;
 
+        // marks the entries of transmission_chunks_ which repeat a zero-copy
+        // chunk of the same message, the entry holds the index of that chunk
+        HPX_STATIC_CONSTEXPR std::uint64_t reference_chunk_flag =
+            std::uint64_t(1) << 63;
+
         // pair of (zero-copy, non-zero-copy) chunks
         count_chunks_type num_chunks_;
 
@@ -109,7 +165,16 @@ namespace hpx { namespace parcelset
 
         /// Counters and their data containers.
         performance_counters::parcels::data_point data_point_;
+
+#if defined(HPX_HAVE_ALLOCATION_ACCOUNTING)
+        util::allocation_accounting::accounted_size data_memory_;
+        util::allocation_accounting::accounted_size chunks_memory_;
+#endif
     };
+
+    template <typename BufferType, typename ChunkType>
+    HPX_CONSTEXPR_OR_CONST std::uint64_t
+        parcel_buffer<BufferType, ChunkType>::reference_chunk_flag;
 }}
 
 #endif
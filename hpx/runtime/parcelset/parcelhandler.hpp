@@ -309,6 +309,10 @@ namespace hpx { namespace parcelset
         // number of parcels routed
         std::int64_t get_parcel_routed_count(bool reset);
 
+        // number of parcels sent directly to the locality managing the
+        // address of their destination
+        std::int64_t get_parcel_speculatively_routed_count(bool reset);
+
         // number of parcels received
         std::int64_t get_parcel_receive_count(
             std::string const& pp_type, bool reset) const;
@@ -429,8 +433,14 @@ namespace hpx { namespace parcelset
 
         std::pair<std::shared_ptr<parcelport>, locality>
         find_appropriate_destination(naming::gid_type const & dest_gid);
+        std::pair<std::shared_ptr<parcelport>, locality>
+        find_least_loaded_destination(naming::gid_type const& dest_gid,
+            endpoints_type const& dest_endpoints);
         locality find_endpoint(endpoints_type const & eps, std::string const & name);
 
+        bool route_speculatively(
+            naming::gid_type const& gid, naming::address& addr);
+
         void register_counter_types(std::string const& pp_type);
         void register_connection_cache_counter_types(std::string const& pp_type);
 
@@ -480,9 +490,17 @@ namespace hpx { namespace parcelset
         message_handler_map handlers_;
         bool const load_message_handlers_;
 
+        /// Spread the parcels over all parcelports which can connect to
+        /// their destination (see find_least_loaded_destination)
+        bool const use_multi_rail_;
+
         /// Count number of (outbound) parcels routed
         std::atomic<std::int64_t> count_routed_;
 
+        /// Count number of (outbound) parcels sent to the locality managing
+        /// the address of their destination
+        std::atomic<std::int64_t> count_speculatively_routed_;
+
         /// global exception handler for unhandled exceptions thrown from the
         /// parcel layer
         mutable mutex_type mtx_;
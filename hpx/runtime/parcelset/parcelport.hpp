@@ -168,7 +168,8 @@ namespace hpx { namespace parcelset
             connection_cache_evictions = 1,
             connection_cache_hits = 2,
             connection_cache_misses = 3,
-            connection_cache_reclaims = 4
+            connection_cache_reclaims = 4,
+            connection_cache_reconnects = 5
         };
 
         // invoke pending background work
@@ -316,11 +317,41 @@ namespace hpx { namespace parcelset
             return allow_zero_copy_optimizations_;
         }
 
+        /// Return whether zero copy chunks may refer to device memory, which
+        /// requires a CUDA aware transport
+        bool allow_device_memory_chunks() const
+        {
+            return allow_device_memory_chunks_;
+        }
+
+        /// Return whether zero copy chunks referring to the same data are
+        /// sent only once per message, which requires the transport to
+        /// decode the chunks using decode_parcels
+        bool allow_chunk_deduplication() const
+        {
+            return allow_chunk_deduplication_;
+        }
+
+        /// Return whether integral values and vectors of integral values or
+        /// gids are stored in their compact (variable length, delta) encoding
+        bool allow_compact_encoding() const
+        {
+            return allow_compact_encoding_;
+        }
+
         bool async_serialization() const
         {
             return async_serialization_;
         }
 
+        /// Return the number of parcels after which coalesced messages are
+        /// split into segments which can be decoded in parallel (0 if
+        /// messages are not split)
+        std::size_t decode_segment_size() const
+        {
+            return decode_segment_size_;
+        }
+
         // callback while bootstrap the parcel layer
         void early_pending_parcel_handler(boost::system::error_code const& ec,
             parcel const & p);
@@ -331,10 +362,12 @@ namespace hpx { namespace parcelset
 
         hpx::applier::applier *applier_;
 
-        /// The cache for pending parcels
+        /// The cache for pending parcels, the parcels of high priority actions
+        /// are kept in front of all other parcels for the same destination
         typedef util::tuple<
             std::vector<parcel>
           , std::vector<write_handler_type>
+          , std::size_t                     // number of high priority parcels
         > map_second_type;
         typedef std::map<locality, map_second_type> pending_parcels_map;
         pending_parcels_map pending_parcels_;
@@ -363,10 +396,16 @@ namespace hpx { namespace parcelset
         /// serialization is allowed to use array optimization
         bool allow_array_optimizations_;
         bool allow_zero_copy_optimizations_;
+        bool allow_device_memory_chunks_;
+        bool allow_chunk_deduplication_;
+        bool allow_compact_encoding_;
 
         /// async serialization of parcels
         bool async_serialization_;
 
+        /// number of parcels per independently decodable message segment
+        std::size_t decode_segment_size_;
+
         /// priority of the parcelport
         int priority_;
         std::string type_;
@@ -18,6 +18,7 @@
 #include <hpx/runtime/parcelset/encode_parcels.hpp>
 #include <hpx/runtime/parcelset/parcelport.hpp>
 #include <hpx/runtime/threads/thread.hpp>
+#include <hpx/runtime_fwd.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/atomic_count.hpp>
@@ -25,16 +26,19 @@
 #include <hpx/util/connection_cache.hpp>
 #include <hpx/util/deferred_call.hpp>
 #include <hpx/util/detail/yield_k.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
 #include <hpx/util/io_service_pool.hpp>
 #include <hpx/util/runtime_configuration.hpp>
 #include <hpx/util/safe_lexical_cast.hpp>
 
 #include <boost/predef/other/endian.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <mutex>
@@ -72,6 +76,30 @@ namespace hpx { namespace parcelset
                 ini, key + ".io_pool_size", "2");
         }
 
+        // If polling is enabled the handlers of the io_service_pool are run
+        // from the background work of the worker threads once the runtime is
+        // up, the threads of the pool are used only while starting up and
+        // shutting down.
+        static bool polling(util::runtime_configuration const& ini)
+        {
+            std::string key("hpx.parcel.");
+            key += connection_handler_type();
+
+            return hpx::util::get_entry_as<int>(ini, key + ".polling", "0") != 0;
+        }
+
+        // The longest time (in microseconds) between two polls of the
+        // io_service_pool if the polls find nothing to do.
+        static std::uint64_t polling_interval(
+            util::runtime_configuration const& ini)
+        {
+            std::string key("hpx.parcel.");
+            key += connection_handler_type();
+
+            return hpx::util::get_entry_as<std::uint64_t>(
+                ini, key + ".polling_interval", "100");
+        }
+
         static const char *pool_name()
         {
             return connection_handler_traits<ConnectionHandler>::pool_name();
@@ -121,6 +149,12 @@ namespace hpx { namespace parcelset
           , max_background_thread_(hpx::util::safe_lexical_cast<std::size_t>(
                 hpx::get_config_entry("hpx.max_background_threads",
                     (std::numeric_limits<std::size_t>::max)())))
+          , polling_(polling(ini))
+          , max_polling_interval_(polling_interval(ini) * 1000)
+          , polling_busy_(false)
+          , polling_state_(pool_threads_running)
+          , polling_interval_(0)
+          , next_poll_(0)
         {
 #if BOOST_ENDIAN_BIG_BYTE
             std::string endian_out = get_config_entry("hpx.parcel.endian_out", "big");
@@ -142,7 +176,12 @@ namespace hpx { namespace parcelset
             else {
                 if (!this->allow_zero_copy_optimizations())
                     archive_flags_ |= serialization::disable_data_chunking;
+                else if (this->allow_device_memory_chunks())
+                    archive_flags_ |= serialization::enable_device_memory_chunks;
             }
+
+            if (this->allow_compact_encoding())
+                archive_flags_ |= serialization::enable_compact_encoding;
         }
 
         ~parcelport_impl() override
@@ -194,6 +233,10 @@ namespace hpx { namespace parcelset
 
         void stop(bool blocking = true) override
         {
+            // flushing and the blocking shutdown rely on the pool threads
+            if (polling_)
+                resume_pool_threads();
+
             flush_parcels();
 
             if (blocking) {
@@ -302,7 +345,13 @@ namespace hpx { namespace parcelset
         bool do_background_work(std::size_t num_thread) override
         {
             trigger_pending_work();
-            return do_background_work_impl<ConnectionHandler>(num_thread);
+
+            bool did_some_work = false;
+            if (polling_)
+                did_some_work = poll_io_service_pool();
+
+            return do_background_work_impl<ConnectionHandler>(num_thread) ||
+                did_some_work;
         }
 
         /// support enable_shared_from_this
@@ -388,6 +437,9 @@ namespace hpx { namespace parcelset
                 case connection_cache_reclaims:
                     return connection_cache_.get_cache_reclaims(reset);
 
+                case connection_cache_reconnects:
+                    return connection_cache_.get_cache_reconnects(reset);
+
                 default:
                     break;
             }
@@ -409,6 +461,77 @@ namespace hpx { namespace parcelset
             return static_cast<ConnectionHandler const &>(*this);
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // The worker threads don't run any background work before the
+        // runtime is up, so the pool threads serve the io_service_pool while
+        // starting up. The first poll after that releases them.
+        bool poll_io_service_pool()
+        {
+            // only one worker thread polls at any time, the handlers of an
+            // io_service must not run concurrently
+            if (polling_busy_.load(std::memory_order_relaxed) ||
+                polling_busy_.exchange(true, std::memory_order_acquire))
+            {
+                return false;
+            }
+
+            bool did_some_work = false;
+            if (polling_state_ == pool_threads_released)
+            {
+                did_some_work = poll_io_service_pool_locked();
+            }
+            else if (polling_state_ == pool_threads_running &&
+                hpx::is_running())
+            {
+                io_service_pool_.release_threads();
+                polling_state_ = pool_threads_released;
+                did_some_work = poll_io_service_pool_locked();
+            }
+
+            polling_busy_.store(false, std::memory_order_release);
+            return did_some_work;
+        }
+
+        bool poll_io_service_pool_locked()
+        {
+            // While the polls find something to do the pool is polled on
+            // every call, otherwise the time between polls doubles up to
+            // max_polling_interval_.
+            std::uint64_t now = util::high_resolution_clock::now();
+            if (now < next_poll_)
+                return false;
+
+            if (io_service_pool_.poll() != 0)
+            {
+                polling_interval_ = 0;
+                next_poll_ = 0;
+                return true;
+            }
+
+            polling_interval_ = (std::min)(
+                (std::max)(2 * polling_interval_, std::uint64_t(1000)),
+                max_polling_interval_);
+            next_poll_ = now + polling_interval_;
+            return false;
+        }
+
+        // Hand the io_service_pool back to its threads for shutting down.
+        void resume_pool_threads()
+        {
+            for (std::size_t k = 0;
+                 polling_busy_.exchange(true, std::memory_order_acquire); ++k)
+            {
+                util::detail::yield_k(k,
+                    "parcelport_impl::resume_pool_threads");
+            }
+
+            if (polling_state_ == pool_threads_released)
+                io_service_pool_.run(false);
+            polling_state_ = pool_threads_stopping;
+
+            polling_busy_.store(false, std::memory_order_release);
+        }
+
         template <typename ConnectionHandler_>
         typename std::enable_if<
             connection_handler_traits<
@@ -594,8 +717,10 @@ namespace hpx { namespace parcelset
                 std::terminate();
             }
             else {
-                // Get a connection or reserve space for a new connection.
-                if (!connection_cache_.get_or_reserve(l, sender_connection))
+                // Get a connection or reserve space for a new connection,
+                // force creates a new connection beyond the cache limits
+                if (!connection_cache_.get_or_reserve(
+                        l, sender_connection, force))
                 {
                     // If no slot is available it's not a problem as the parcel
                     // will be sent out whenever the next connection is returned
@@ -617,6 +742,23 @@ namespace hpx { namespace parcelset
         }
 
         ///////////////////////////////////////////////////////////////////////
+        // Parcels of high priority actions (AGAS replies, LCO sets, etc.) are
+        // sent before all other parcels pending for the same destination.
+        static bool is_high_priority(parcel const& p)
+        {
+            switch (p.get_thread_priority())
+            {
+            case threads::thread_priority_high:
+            case threads::thread_priority_high_recursive:
+            case threads::thread_priority_boost:
+                return true;
+
+            default:
+                break;
+            }
+            return false;
+        }
+
         void enqueue_parcel(locality const& locality_id,
             parcel&& p, write_handler_type&& f)
         {
@@ -631,8 +773,21 @@ namespace hpx { namespace parcelset
             > il(&l);
 
             mapped_type& e = pending_parcels_[locality_id];
-            util::get<0>(e).push_back(std::move(p));
-            util::get<1>(e).push_back(std::move(f));
+            if (is_high_priority(p))
+            {
+                // append to the high priority parcels
+                std::size_t& num_high = util::get<2>(e);
+                util::get<0>(e).insert(
+                    util::get<0>(e).begin() + num_high, std::move(p));
+                util::get<1>(e).insert(
+                    util::get<1>(e).begin() + num_high, std::move(f));
+                ++num_high;
+            }
+            else
+            {
+                util::get<0>(e).push_back(std::move(p));
+                util::get<1>(e).push_back(std::move(f));
+            }
 
             parcel_destinations_.insert(locality_id);
             ++num_parcel_destinations_;
@@ -654,12 +809,50 @@ namespace hpx { namespace parcelset
 
             HPX_ASSERT(parcels.size() == handlers.size());
 
+            // move the high priority parcels to the front, keeping the order
+            // of the parcels within each of the lanes
+            std::size_t num_high = 0;
+            for (std::size_t i = 0; i != parcels.size(); ++i)
+            {
+                if (is_high_priority(parcels[i]))
+                {
+                    if (i != num_high)
+                    {
+                        std::rotate(parcels.begin() + num_high,
+                            parcels.begin() + i, parcels.begin() + i + 1);
+                        std::rotate(handlers.begin() + num_high,
+                            handlers.begin() + i, handlers.begin() + i + 1);
+                    }
+                    ++num_high;
+                }
+            }
+
             mapped_type& e = pending_parcels_[locality_id];
             if (util::get<0>(e).empty())
             {
                 HPX_ASSERT(util::get<1>(e).empty());
                 std::swap(util::get<0>(e), parcels);
                 std::swap(util::get<1>(e), handlers);
+                util::get<2>(e) = num_high;
+            }
+            else if (num_high != 0)
+            {
+                // the new high priority parcels go behind the pending ones
+                HPX_ASSERT(util::get<0>(e).size() == util::get<1>(e).size());
+                std::size_t pos = util::get<2>(e);
+
+                util::get<0>(e).insert(util::get<0>(e).begin() + pos,
+                    std::make_move_iterator(parcels.begin()),
+                    std::make_move_iterator(parcels.begin() + num_high));
+                util::get<1>(e).insert(util::get<1>(e).begin() + pos,
+                    std::make_move_iterator(handlers.begin()),
+                    std::make_move_iterator(handlers.begin() + num_high));
+                util::get<2>(e) += num_high;
+
+                std::move(parcels.begin() + num_high, parcels.end(),
+                    std::back_inserter(util::get<0>(e)));
+                std::move(handlers.begin() + num_high, handlers.end(),
+                    std::back_inserter(util::get<1>(e)));
             }
             else
             {
@@ -702,6 +895,7 @@ namespace hpx { namespace parcelset
                     HPX_ASSERT(util::get<0>(it->second).size() == 0);
                     std::swap(handlers, util::get<1>(it->second));
                     HPX_ASSERT(handlers.size() == parcels.size());
+                    util::get<2>(it->second) = 0;
 
                     HPX_ASSERT(!handlers.empty());
                 }
@@ -740,6 +934,10 @@ namespace hpx { namespace parcelset
                         handler = std::move(handlers.back());
                         handlers.pop_back();
 
+                        std::size_t& num_high = util::get<2>(pending.second);
+                        if (num_high > parcels.size())
+                            num_high = parcels.size();
+
                         if (parcels.empty())
                         {
                             pending_parcels_.erase(dest);
@@ -797,9 +995,9 @@ namespace hpx { namespace parcelset
                 return;
             }
 
-            // If one of the sending threads are in suspended state, we
-            // need to force a new connection to avoid deadlocks.
-            bool force_connection = true;
+            // High priority parcels get a connection of their own if all
+            // connections to the destination are busy sending other parcels.
+            bool force_connection = has_high_priority_parcels(locality_id);
 
             error_code ec;
             std::shared_ptr<connection> sender_connection =
@@ -841,6 +1039,14 @@ namespace hpx { namespace parcelset
         }
 
 
+        bool has_high_priority_parcels(locality const& locality_id) const
+        {
+            std::lock_guard<lcos::local::spinlock> l(mtx_);
+            pending_parcels_map::const_iterator it =
+                pending_parcels_.find(locality_id);
+            return it != pending_parcels_.end() && util::get<2>(it->second) != 0;
+        }
+
         void send_pending_parcels_trampoline(
             boost::system::error_code const& ec,
             locality const& locality_id,
@@ -968,6 +1174,23 @@ namespace hpx { namespace parcelset
 
         std::atomic<std::size_t> num_thread_;
         std::size_t const max_background_thread_;
+
+        /// Polling the io_service_pool from the background work
+        enum polling_state
+        {
+            pool_threads_running,
+            pool_threads_released,
+            pool_threads_stopping
+        };
+
+        bool const polling_;
+        std::uint64_t const max_polling_interval_;
+
+        // everything below is protected by polling_busy_
+        std::atomic<bool> polling_busy_;
+        polling_state polling_state_;
+        std::uint64_t polling_interval_;
+        std::uint64_t next_poll_;
     };
 }}
 
@@ -16,6 +16,7 @@
 #include <hpx/runtime/naming/address.hpp>
 #include <hpx/runtime/naming/name.hpp>
 #include <hpx/runtime/naming/split_gid.hpp>
+#include <hpx/runtime/parcelset/detail/parcel_await.hpp>
 #include <hpx/runtime/parcelset/parcel.hpp>
 #include <hpx/runtime/parcelset/parcelhandler.hpp>
 #include <hpx/traits/is_action.hpp>
@@ -23,6 +24,7 @@
 #include <hpx/util/assert.hpp>
 #include <hpx/util/unused.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <memory>
 #include <type_traits>
@@ -112,6 +114,73 @@ namespace hpx { namespace parcelset
             }
         };
 
+        // Joins the splitting of the credit of the destination with the
+        // preprocessing of the parcel (awaiting the futures and splitting the
+        // ids held by the arguments), which run concurrently. The parcel is
+        // created with the stripped destination, the split destination is
+        // patched in once both have finished.
+        template <typename PutParcel>
+        struct put_parcel_join
+        {
+            explicit put_parcel_join(PutParcel&& pp)
+              : pp_(std::forward<PutParcel>(pp)),
+                count_(2)
+            {}
+
+            void set_destination(hpx::future<naming::gid_type> f)
+            {
+                dest_ = f.get();
+                done();
+            }
+
+            void set_parcel(parcel&& p)
+            {
+                p_ = std::move(p);
+                done();
+            }
+
+            void done()
+            {
+                if (--count_ == 0)
+                {
+                    p_.set_destination_id(std::move(dest_));
+                    pp_(std::move(p_));
+                }
+            }
+
+            typename std::decay<PutParcel>::type pp_;
+            std::atomic<int> count_;
+            naming::gid_type dest_;
+            parcel p_;
+        };
+
+        template <typename PutParcel>
+        void put_parcel_overlapped(PutParcel&& pp,
+            future<naming::gid_type>&& split_gid, naming::id_type const& dest,
+            naming::address&& addr,
+            std::unique_ptr<actions::base_action>&& action)
+        {
+            typedef put_parcel_join<PutParcel> join_type;
+            std::shared_ptr<join_type> join =
+                std::make_shared<join_type>(std::forward<PutParcel>(pp));
+
+            split_gid.then(hpx::launch::sync,
+                [join](hpx::future<naming::gid_type> f)
+                {
+                    join->set_destination(std::move(f));
+                });
+
+            parcel_await_apply(
+                detail::create_parcel::call_with_action(
+                    naming::detail::get_stripped_gid(dest.get_gid()),
+                    std::move(addr), std::move(action)),
+                write_handler_type(), 0,
+                [join](parcel&& p, write_handler_type&&)
+                {
+                    join->set_parcel(std::move(p));
+                });
+        }
+
         template <typename PutParcel>
         void put_parcel_impl(PutParcel&& pp,
             naming::id_type dest, naming::address&& addr,
@@ -149,6 +218,14 @@ namespace hpx { namespace parcelset
                         std::move(action)
                     ));
                 }
+                else if (addr)
+                {
+                    // the parcel will not be routed through AGAS, which would
+                    // serialize it again as part of the routing action
+                    put_parcel_overlapped(std::forward<PutParcel>(pp),
+                        std::move(split_gid), dest, std::move(addr),
+                        std::move(action));
+                }
                 else
                 {
                     split_gid.then(
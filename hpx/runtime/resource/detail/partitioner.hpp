@@ -72,6 +72,9 @@ namespace hpx { namespace resource { namespace detail
         std::size_t num_threads_;
         hpx::threads::policies::scheduler_mode mode_;
         scheduler_function create_function_;
+
+        // work sharing with other pools
+        pool_sharing_mode sharing_mode_;
     };
 
     ///////////////////////////////////////////////////////////////////////
@@ -143,6 +146,10 @@ namespace hpx { namespace resource { namespace detail
         hpx::threads::policies::scheduler_mode
         get_scheduler_mode(std::size_t pool_index) const;
 
+        void set_pool_sharing_mode(std::string const& pool_name,
+            pool_sharing_mode mode);
+        pool_sharing_mode get_pool_sharing_mode(std::size_t pool_index) const;
+
         std::string const& get_pool_name(std::size_t index) const;
         std::size_t get_pool_index(std::string const& pool_name) const;
 
@@ -231,6 +231,12 @@ namespace hpx { namespace resource
         // allow the default pool to be renamed to something else
         HPX_EXPORT void set_default_pool_name(std::string const& name);
 
+        // Allow idle worker threads of the borrowing pools to execute the low
+        // priority threads of the lending pools. This has to be called after
+        // the pool has been created.
+        HPX_EXPORT void set_pool_sharing_mode(std::string const& pool_name,
+            pool_sharing_mode mode);
+
         HPX_EXPORT const std::string & get_default_pool_name() const;
 
         ///////////////////////////////////////////////////////////////////////
@@ -52,6 +52,23 @@ namespace hpx
             mode_allow_dynamic_pools = 2
         };
 
+        /// This enumeration describes how a thread pool shares work with the
+        /// other thread pools. The idle worker threads of a borrowing pool
+        /// execute the low priority threads of the lending pools.
+        enum pool_sharing_mode
+        {
+            /// The pool neither lends nor borrows work (default).
+            sharing_none = 0,
+            /// The low priority threads of this pool may be executed by the
+            /// idle worker threads of the borrowing pools.
+            sharing_lender = 1,
+            /// The idle worker threads of this pool execute low priority
+            /// threads of the lending pools.
+            sharing_borrower = 2,
+            /// The pool lends and borrows work.
+            sharing_lender_borrower = sharing_lender | sharing_borrower
+        };
+
         using scheduler_function =
             util::function_nonser<
                 std::unique_ptr<hpx::threads::thread_pool_base>(
@@ -76,6 +93,7 @@ namespace hpx
             abp_priority_fifo = 5,
             abp_priority_lifo = 6,
             shared_priority = 7,
+            hierarchical_priority = 8,
         };
     }
 }
@@ -34,7 +34,9 @@ namespace hpx { namespace serialization
         endian_little               = 0x00008000,
         disable_array_optimization  = 0x00010000,
         disable_data_chunking       = 0x00020000,
-        all_archive_flags           = 0x0003e000    // all of the above
+        enable_device_memory_chunks = 0x00040000,
+        enable_compact_encoding     = 0x00080000,
+        all_archive_flags           = 0x000fe000    // all of the above
     };
 
     void HPX_FORCEINLINE
@@ -94,6 +96,24 @@ namespace hpx { namespace serialization
                 true : false;
         }
 
+        // Device memory (see compute::vector) may be referred to by zero
+        // copy chunks, the parcelport transfers these directly.
+        bool enable_device_memory_chunks() const
+        {
+            return (!(flags_ & hpx::serialization::disable_data_chunking) &&
+                (flags_ & hpx::serialization::enable_device_memory_chunks)) ?
+                true : false;
+        }
+
+        // Integral values are stored as variable length integers (LEB128,
+        // zigzag encoded if signed) and vectors of integral values or gids
+        // are delta encoded, see detail::compact_array_encoding.
+        bool enable_compact_encoding() const
+        {
+            return (flags_ & hpx::serialization::enable_compact_encoding) ?
+                true : false;
+        }
+
         std::uint32_t flags() const
         {
             return flags_;
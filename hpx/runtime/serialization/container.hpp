@@ -15,9 +15,30 @@
 #include <hpx/util/assert.hpp>
 
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 
 namespace hpx { namespace serialization
 {
+    // The position of an archive inside its data, allows to start reading
+    // an archive in the middle (see input_archive)
+    struct archive_position
+    {
+        archive_position()
+          : data_pos_(0), chunk_(0), chunk_pos_(0)
+        {}
+
+        template <typename Archive>
+        void serialize(Archive& ar, unsigned)
+        {
+            ar & data_pos_ & chunk_ & chunk_pos_;
+        }
+
+        std::uint64_t data_pos_;        // offset into the data
+        std::uint64_t chunk_;           // index of the current chunk
+        std::uint64_t chunk_pos_;       // offset into the current chunk
+    };
+
     struct erased_output_container
     {
         virtual ~erased_output_container() {}
@@ -36,6 +57,13 @@ namespace hpx { namespace serialization
         virtual void reset() = 0;
         virtual std::size_t get_num_chunks() const = 0;
         virtual void flush() = 0;
+
+        // Return the position data will be written to next, returns false
+        // if the data can't be read starting from that position.
+        virtual bool get_position(archive_position& /*pos*/) const
+        {
+            return false;
+        }
     };
 
     struct erased_input_container
@@ -46,6 +74,14 @@ namespace hpx { namespace serialization
         virtual void set_filter(binary_filter* filter) = 0;
         virtual void load_binary(void * address, std::size_t count) = 0;
         virtual void load_binary_chunk(void * address, std::size_t count) = 0;
+
+        // Return the address of the next chunk of data if it may be
+        // referenced beyond the lifetime of the archive, nullptr otherwise.
+        virtual void const* reference_binary_chunk(std::size_t /*count*/,
+            std::size_t /*alignment*/, std::shared_ptr<void const>& /*owner*/)
+        {
+            return nullptr;
+        }
     };
 }}
 
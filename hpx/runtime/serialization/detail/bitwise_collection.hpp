@@ -0,0 +1,152 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_SERIALIZATION_DETAIL_BITWISE_COLLECTION_HPP
+#define HPX_SERIALIZATION_DETAIL_BITWISE_COLLECTION_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/serialization/basic_archive.hpp>
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
+#include <hpx/traits/is_bitwise_serializable.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace serialization { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Bitwise serializable objects are stored as the sequence of their bytes
+    // (integral types are not, those are stored in a portable way). The
+    // elements of collections which are not contiguous in memory are still
+    // written one after the other, which requires one (virtual) call into the
+    // archive's container for each of them. The functions below keep the
+    // format but copy the elements into blocks first, each of which is
+    // written and read at once.
+    template <typename T>
+    struct is_bitwise_collection_element
+      : std::integral_constant<bool,
+            hpx::traits::is_bitwise_serializable<
+                typename std::remove_const<T>::type
+            >::value &&
+            !std::is_integral<T>::value && !std::is_enum<T>::value &&
+            std::is_default_constructible<T>::value>
+    {};
+
+    // the size of the blocks the elements are bundled into
+    HPX_STATIC_CONSTEXPR std::size_t bitwise_collection_block_size = 1024;
+
+    template <typename T>
+    HPX_CONSTEXPR std::size_t bitwise_collection_block_elements()
+    {
+        return sizeof(T) < bitwise_collection_block_size ?
+            bitwise_collection_block_size / sizeof(T) : 1;
+    }
+
+    template <typename Collection>
+    bool save_bitwise_collection(output_archive& ar,
+        Collection const& collection, std::false_type)
+    {
+        return false;
+    }
+
+    template <typename Collection>
+    bool save_bitwise_collection(output_archive& ar,
+        Collection const& collection, std::true_type)
+    {
+        if (ar.disable_array_optimization())
+            return false;
+
+        typedef typename Collection::value_type value_type;
+        HPX_CONSTEXPR_OR_CONST std::size_t block_elements =
+            bitwise_collection_block_elements<value_type>();
+
+        char block[block_elements * sizeof(value_type)];
+
+        std::size_t count = 0;
+        for (value_type const& v : collection)
+        {
+            std::memcpy(block + count * sizeof(value_type),
+                static_cast<void const*>(&v), sizeof(value_type));
+
+            if (++count == block_elements)
+            {
+                save_binary(ar, block, count * sizeof(value_type));
+                count = 0;
+            }
+        }
+
+        if (count != 0)
+            save_binary(ar, block, count * sizeof(value_type));
+
+        return true;
+    }
+
+    // Save all elements of the given collection in blocks, return false if
+    // they have to be saved one by one instead.
+    template <typename Collection>
+    bool save_bitwise_collection(output_archive& ar,
+        Collection const& collection)
+    {
+        return save_bitwise_collection(ar, collection,
+            is_bitwise_collection_element<
+                typename Collection::value_type>());
+    }
+
+    template <typename Value, typename F>
+    bool load_bitwise_collection(input_archive& ar, std::uint64_t size,
+        F&& f, std::false_type)
+    {
+        return false;
+    }
+
+    template <typename Value, typename F>
+    bool load_bitwise_collection(input_archive& ar, std::uint64_t size,
+        F&& f, std::true_type)
+    {
+        if (ar.disable_array_optimization())
+            return false;
+
+        typedef typename std::remove_const<Value>::type value_type;
+        HPX_CONSTEXPR_OR_CONST std::size_t block_elements =
+            bitwise_collection_block_elements<value_type>();
+
+        char block[block_elements * sizeof(value_type)];
+
+        while (size != 0)
+        {
+            std::size_t count = size < block_elements ?
+                static_cast<std::size_t>(size) : block_elements;
+
+            load_binary(ar, block, count * sizeof(value_type));
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                value_type v;
+                std::memcpy(static_cast<void*>(&v),
+                    block + i * sizeof(value_type), sizeof(value_type));
+                f(std::move(v));
+            }
+
+            size -= count;
+        }
+
+        return true;
+    }
+
+    // Load the given number of elements saved by save_bitwise_collection and
+    // pass each of them to the given function, return false if they have to
+    // be loaded one by one instead.
+    template <typename Value, typename F>
+    bool load_bitwise_collection(input_archive& ar, std::uint64_t size, F&& f)
+    {
+        return load_bitwise_collection<Value>(ar, size, std::forward<F>(f),
+            is_bitwise_collection_element<Value>());
+    }
+}}}
+
+#endif
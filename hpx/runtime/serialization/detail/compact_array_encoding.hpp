@@ -0,0 +1,100 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_SERIALIZATION_DETAIL_COMPACT_ARRAY_ENCODING_HPP
+#define HPX_SERIALIZATION_DETAIL_COMPACT_ARRAY_ENCODING_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/serialization/serialization_fwd.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace hpx { namespace serialization { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Vectors of the types this is specialized for are stored in a compact
+    // form by archives with enable_compact_encoding, instead of being copied
+    // bitwise. Specializations provide:
+    //
+    //      static void save(output_archive& ar, T const* data,
+    //          std::size_t size);
+    //      static void load(input_archive& ar, T* data, std::size_t size);
+    //
+    template <typename T, typename Enable = void>
+    struct compact_array_encoding : std::false_type {};
+
+    // Integral values wider than a byte are stored as variable length
+    // integers. Sorted sequences (indices, offsets, counts) are delta
+    // encoded, each value is stored as the difference to its predecessor.
+    template <typename T>
+    struct compact_array_encoding<T,
+        typename std::enable_if<
+            std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+            (sizeof(T) > 1) && (sizeof(T) <= sizeof(std::uint64_t))
+        >::type>
+      : std::true_type
+    {
+        template <typename Archive>
+        static void save(Archive& ar, T const* data, std::size_t size)
+        {
+            bool sorted = std::is_sorted(data, data + size);
+            ar << sorted;
+
+            if (!sorted || size == 0)
+            {
+                for (std::size_t i = 0; i != size; ++i)
+                    ar << data[i];
+                return;
+            }
+
+            // the differences are computed modulo 2^64, which gives the
+            // exact (non-negative) difference for signed values as well
+            ar << data[0];
+            for (std::size_t i = 1; i != size; ++i)
+            {
+                ar.save_varint(to_unsigned(data[i]) - to_unsigned(data[i - 1]));
+            }
+        }
+
+        template <typename Archive>
+        static void load(Archive& ar, T* data, std::size_t size)
+        {
+            bool sorted = false;
+            ar >> sorted;
+
+            if (!sorted || size == 0)
+            {
+                for (std::size_t i = 0; i != size; ++i)
+                    ar >> data[i];
+                return;
+            }
+
+            ar >> data[0];
+            std::uint64_t value = to_unsigned(data[0]);
+            for (std::size_t i = 1; i != size; ++i)
+            {
+                value += ar.load_varint();
+                data[i] = static_cast<T>(
+                    static_cast<typename std::conditional<
+                        std::is_signed<T>::value, std::int64_t, std::uint64_t
+                    >::type>(value));
+            }
+        }
+
+    private:
+        static std::uint64_t to_unsigned(T val)
+        {
+            return static_cast<std::uint64_t>(
+                static_cast<typename std::conditional<
+                    std::is_signed<T>::value, std::int64_t, std::uint64_t
+                >::type>(val));
+        }
+    };
+}}}
+
+#endif
@@ -0,0 +1,110 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_SERIALIZATION_DETAIL_CONTAINER_STORAGE_HPP
+#define HPX_SERIALIZATION_DETAIL_CONTAINER_STORAGE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// The size of the storage the archives construct their (type erased)
+// containers in. Larger containers are allocated on the heap.
+#if !defined(HPX_SERIALIZATION_CONTAINER_STORAGE_SIZE)
+#define HPX_SERIALIZATION_CONTAINER_STORAGE_SIZE 128
+#endif
+
+namespace hpx { namespace serialization { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Owns the erased container of an archive. The container is constructed
+    // inside the archive if it fits, which avoids a heap allocation for every
+    // archive created while sending or receiving a parcel.
+    template <typename Base>
+    class container_storage
+    {
+        typedef typename std::aligned_storage<
+                HPX_SERIALIZATION_CONTAINER_STORAGE_SIZE
+            >::type storage_type;
+
+        template <typename T>
+        struct fits_storage
+          : std::integral_constant<bool,
+                sizeof(T) <= sizeof(storage_type) &&
+                alignof(storage_type) % alignof(T) == 0>
+        {};
+
+    public:
+        container_storage()
+          : ptr_(nullptr), local_(false)
+        {}
+
+        container_storage(container_storage const&) = delete;
+        container_storage& operator=(container_storage const&) = delete;
+
+        ~container_storage()
+        {
+            destroy();
+        }
+
+        template <typename T, typename ... Ts>
+        void emplace(Ts &&... ts)
+        {
+            static_assert(std::is_base_of<Base, T>::value,
+                "the container must derive from the erased container type");
+
+            destroy();
+            emplace_impl<T>(fits_storage<T>(), std::forward<Ts>(ts)...);
+        }
+
+        Base* get() const
+        {
+            return ptr_;
+        }
+
+        Base* operator->() const
+        {
+            HPX_ASSERT(ptr_ != nullptr);
+            return ptr_;
+        }
+
+    private:
+        template <typename T, typename ... Ts>
+        void emplace_impl(std::true_type, Ts &&... ts)
+        {
+            ptr_ = new (&storage_) T(std::forward<Ts>(ts)...);
+            local_ = true;
+        }
+
+        template <typename T, typename ... Ts>
+        void emplace_impl(std::false_type, Ts &&... ts)
+        {
+            ptr_ = new T(std::forward<Ts>(ts)...);
+            local_ = false;
+        }
+
+        void destroy()
+        {
+            if (ptr_ == nullptr)
+                return;
+
+            if (local_)
+                ptr_->~Base();
+            else
+                delete ptr_;
+            ptr_ = nullptr;
+        }
+
+        storage_type storage_;
+        Base* ptr_;
+        bool local_;
+    };
+}}}
+
+#endif
@@ -22,6 +22,7 @@
 #include <hpx/util/jenkins_hash.hpp>
 #include <hpx/util/static.hpp>
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <typeinfo>
@@ -125,44 +126,43 @@ namespace hpx { namespace serialization { namespace detail
         }
     };
 
+    // Polymorphic objects are identified on the wire by a 64 bit hash of
+    // their portable class name, which avoids sending (and looking up) the
+    // name with every object. The ids are deterministic, all localities
+    // derive the same id from the same name, collisions are detected when
+    // the classes are registered.
     class polymorphic_nonintrusive_factory
     {
     public:
         HPX_NON_COPYABLE(polymorphic_nonintrusive_factory);
 
     public:
+        typedef std::unordered_map<std::uint64_t,
+                  function_bunch_type> serializer_map_type;
         typedef std::unordered_map<std::string,
-                  function_bunch_type, hpx::util::jenkins_hash> serializer_map_type;
-        typedef std::unordered_map<std::string,
-                  std::string, hpx::util::jenkins_hash> serializer_typeinfo_map_type;
+                  std::uint64_t, hpx::util::jenkins_hash> serializer_typeinfo_map_type;
+        typedef std::unordered_map<std::uint64_t,
+                  std::string> serializer_name_map_type;
 
         HPX_EXPORT static polymorphic_nonintrusive_factory& instance();
 
-        void register_class(const std::type_info& typeinfo,
-            const std::string& class_name,
-            const function_bunch_type& bunch)
+        // return the id used on the wire for the given class name (64 bit
+        // FNV-1a hash)
+        static std::uint64_t get_id(char const* class_name)
         {
-            if(!typeinfo.name() && std::string(typeinfo.name()).empty())
-            {
-                HPX_THROW_EXCEPTION(serialization_error
-                  , "polymorphic_nonintrusive_factory::register_class"
-                  , "Cannot register a factory with an empty type name");
-            }
-            if(class_name.empty())
+            std::uint64_t hash = 14695981039346656037ull;
+            for (/**/; *class_name != '\0'; ++class_name)
             {
-                HPX_THROW_EXCEPTION(serialization_error
-                  , "polymorphic_nonintrusive_factory::register_class"
-                  , "Cannot register a factory with an empty name");
+                hash ^= static_cast<unsigned char>(*class_name);
+                hash *= 1099511628211ull;
             }
-            auto it = map_.find(class_name);
-            auto jt = typeinfo_map_.find(typeinfo.name());
-
-            if(it == map_.end())
-                map_[class_name] = bunch;
-            if(jt == typeinfo_map_.end())
-                typeinfo_map_[typeinfo.name()] = class_name;
+            return hash;
         }
 
+        HPX_EXPORT void register_class(const std::type_info& typeinfo,
+            const std::string& class_name,
+            const function_bunch_type& bunch);
+
         // the following templates are defined in *.ipp file
         template <class T>
         void save(output_archive& ar, const T& t);
@@ -182,8 +182,12 @@ namespace hpx { namespace serialization { namespace detail
 
         friend struct hpx::util::static_<polymorphic_nonintrusive_factory>;
 
+        HPX_EXPORT function_bunch_type const& get_bunch(
+            std::uint64_t id) const;
+
         serializer_map_type map_;
         serializer_typeinfo_map_type typeinfo_map_;
+        serializer_name_map_type name_map_;
     };
 
     template <class Derived>
@@ -7,6 +7,7 @@
 #define HPX_SERIALIZATION_DETAIL_SERIALIZE_COLLECTION_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/runtime/serialization/detail/bitwise_collection.hpp>
 #include <hpx/runtime/serialization/detail/polymorphic_nonintrusive_factory.hpp>
 #include <hpx/traits/detail/reserve.hpp>
 
@@ -96,6 +97,9 @@ namespace hpx { namespace serialization { namespace detail
     void save_collection(Archive& ar, const Collection& collection)
     {
         using value_type = typename Collection::value_type;
+        if (save_bitwise_collection(ar, collection))
+            return;
+
         save_collection_impl<value_type>::type::call(ar, collection);
     }
 
@@ -104,6 +108,19 @@ namespace hpx { namespace serialization { namespace detail
             typename Collection::size_type size)
     {
         using value_type = typename Collection::value_type;
+
+        collection.clear();
+        hpx::traits::detail::reserve_if_reservable(collection, size);
+
+        if (load_bitwise_collection<value_type>(ar, size,
+                [&collection](value_type&& v)
+                {
+                    collection.push_back(std::move(v));
+                }))
+        {
+            return;
+        }
+
         load_collection_impl<value_type>::type::call(ar, collection, size);
     }
 
@@ -11,6 +11,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/runtime/serialization/basic_archive.hpp>
+#include <hpx/runtime/serialization/detail/container_storage.hpp>
 #include <hpx/runtime/serialization/detail/polymorphic_nonintrusive_factory.hpp>
 #include <hpx/runtime/serialization/detail/raw_ptr.hpp>
 #include <hpx/runtime/serialization/input_container.hpp>
@@ -46,8 +47,10 @@ namespace hpx { namespace serialization
                 std::size_t inbound_data_size = 0,
                 const std::vector<serialization_chunk>* chunks = nullptr)
           : base_type(0U)
-          , buffer_(new input_container<Container>(buffer, chunks, inbound_data_size))
         {
+            buffer_.emplace<input_container<Container> >(
+                buffer, chunks, inbound_data_size);
+
             // endianness needs to be saves separately as it is needed to
             // properly interpret the flags
 
@@ -74,6 +77,21 @@ namespace hpx { namespace serialization
             }
         }
 
+        // Read the data of an archive starting at the given position in the
+        // middle of it, the archive header is not read again but the flags
+        // it held have to be passed in.
+        template <typename Container>
+        input_archive(Container & buffer,
+                std::size_t inbound_data_size,
+                const std::vector<serialization_chunk>* chunks,
+                std::uint32_t flags, archive_position const& pos)
+          : base_type(flags)
+        {
+            buffer_.emplace<input_container<Container> >(
+                buffer, chunks, inbound_data_size, pos);
+            this->base_type::size_ = static_cast<std::size_t>(pos.data_pos_);
+        }
+
         template <typename T>
         void invoke_impl(T & t)
         {
@@ -126,12 +144,55 @@ namespace hpx { namespace serialization
             return size_;
         }
 
+        // Return the address of the bitwise serialized data of the next
+        // count bytes if the container of the archive allows to reference it
+        // in place (see serialization_access_data::keep_alive), owner keeps
+        // the data alive. Returns nullptr otherwise, the data has to be
+        // loaded using load_binary_chunk in this case.
+        void const* reference_binary_chunk(std::size_t count,
+            std::size_t alignment, std::shared_ptr<void const>& owner)
+        {
+#if BOOST_ENDIAN_BIG_BYTE
+            bool archive_endianess_differs = endian_little();
+#else
+            bool archive_endianess_differs = endian_big();
+#endif
+            if (0 == count || disable_data_chunking() ||
+                disable_array_optimization() || archive_endianess_differs)
+            {
+                return nullptr;
+            }
+
+            void const* data =
+                buffer_->reference_binary_chunk(count, alignment, owner);
+            if (data != nullptr)
+                size_ += count;
+            return data;
+        }
+
         // this function is needed to avoid a MSVC linker error
         std::size_t current_pos() const
         {
             return basic_archive<input_archive>::current_pos();
         }
 
+        // Load a variable length integer (LEB128) stored by
+        // output_archive::save_varint.
+        std::uint64_t load_varint()
+        {
+            std::uint64_t val = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7)
+            {
+                unsigned char byte = 0;
+                load_binary(&byte, 1);
+
+                val |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+                if (!(byte & 0x80))
+                    break;
+            }
+            return val;
+        }
+
     private:
         friend struct basic_archive<input_archive>;
         template <class T>
@@ -175,7 +236,16 @@ namespace hpx { namespace serialization
         void load_integral(T & val, std::false_type)
         {
             std::int64_t l;
-            load_integral_impl(l);
+            if (enable_compact_encoding())
+            {
+                std::uint64_t ul = load_varint();
+                l = static_cast<std::int64_t>(ul >> 1) ^
+                    -static_cast<std::int64_t>(ul & 1);
+            }
+            else
+            {
+                load_integral_impl(l);
+            }
             val = static_cast<T>(l);
         }
 
@@ -183,7 +253,10 @@ namespace hpx { namespace serialization
         void load_integral(T & val, std::true_type)
         {
             std::uint64_t ul;
-            load_integral_impl(ul);
+            if (enable_compact_encoding())
+                ul = load_varint();
+            else
+                load_integral_impl(ul);
             val = static_cast<T>(ul);
         }
 
@@ -281,7 +354,7 @@ namespace hpx { namespace serialization
             return static_cast<Helper &>(*it->second);
         }
 
-        std::unique_ptr<erased_input_container> buffer_;
+        detail::container_storage<erased_input_container> buffer_;
         pointer_tracker pointer_tracker_;
     };
 }}
@@ -72,6 +72,24 @@ namespace hpx { namespace serialization
             }
         }
 
+        // start reading at the given position (see
+        // erased_output_container::get_position)
+        input_container(Container const& cont,
+                std::vector<serialization_chunk> const* chunks,
+                std::size_t inbound_data_size, archive_position const& pos)
+          : cont_(cont), current_(static_cast<std::size_t>(pos.data_pos_)),
+            filter_(), decompressed_size_(inbound_data_size),
+            chunks_(nullptr), current_chunk_(std::size_t(-1)),
+            current_chunk_size_(0)
+        {
+            if (chunks && chunks->size() != 0)
+            {
+                chunks_ = chunks;
+                current_chunk_ = static_cast<std::size_t>(pos.chunk_);
+                current_chunk_size_ = static_cast<std::size_t>(pos.chunk_pos_);
+            }
+        }
+
         void set_filter(binary_filter* filter) // override
         {
             filter_.reset(filter);
@@ -163,6 +181,37 @@ namespace hpx { namespace serialization
             }
         }
 
+        // The data of pointer chunks can be referenced in place if the
+        // container allows to keep it alive beyond the archive.
+        void const* reference_binary_chunk(std::size_t count,
+            std::size_t alignment, std::shared_ptr<void const>& owner) // override
+        {
+            if (chunks_ == nullptr ||
+                count < HPX_ZERO_COPY_SERIALIZATION_THRESHOLD ||
+                filter_)
+            {
+                return nullptr;
+            }
+
+            HPX_ASSERT(current_chunk_ != std::size_t(-1));
+            if (get_chunk_type(current_chunk_) != chunk_type_pointer ||
+                get_chunk_size(current_chunk_) != count)
+            {
+                return nullptr;
+            }
+
+            void const* data = get_chunk_data(current_chunk_).cpos_;
+            if (reinterpret_cast<std::uintptr_t>(data) % alignment != 0)
+                return nullptr;
+
+            owner = access_traits::keep_alive(cont_);
+            if (!owner)
+                return nullptr;
+
+            ++current_chunk_;
+            return data;
+        }
+
         Container const& cont_;
         std::size_t current_;
         std::unique_ptr<binary_filter> filter_;
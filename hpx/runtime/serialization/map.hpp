@@ -7,9 +7,11 @@
 #define HPX_SERIALIZATION_MAP_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/runtime/serialization/detail/bitwise_collection.hpp>
 #include <hpx/runtime/serialization/input_archive.hpp>
 #include <hpx/runtime/serialization/output_archive.hpp>
 #include <hpx/traits/is_bitwise_serializable.hpp>
+#include <hpx/traits/supports_in_place_load.hpp>
 
 #include <cstddef>
 #include <cstdint>
@@ -29,6 +31,20 @@ namespace hpx
              && is_bitwise_serializable<typename std::remove_const<Value>::type>::value
             >
         {};
+
+        template <typename Key, typename Value>
+        struct supports_in_place_load<std::pair<Key, Value> >
+          : std::integral_constant<
+                bool,
+                supports_in_place_load<typename std::remove_const<Key>::type>::value
+             && supports_in_place_load<typename std::remove_const<Value>::type>::value
+            >
+        {};
+
+        template <typename Key, typename Value, typename Comp, typename Alloc>
+        struct supports_in_place_load<std::map<Key, Value, Comp, Alloc> >
+          : std::true_type
+        {};
     }
 
     namespace serialization
@@ -96,21 +112,113 @@ namespace hpx
             detail::save_pair_impl(ar, t, optimized());
         }
 
+        namespace detail
+        {
+            // The elements of a map are loaded in order of their keys. Those
+            // are merged with the elements of the map loaded into: the
+            // elements with keys which are not loaded are erased, the values
+            // of the elements with keys which are loaded are overwritten, and
+            // only the elements with new keys are allocated.
+
+            // Erase all elements before the position of the given key, return
+            // the element with that key or the position to insert it at.
+            template <class Map>
+            typename Map::iterator find_load_position(Map& t,
+                typename Map::iterator it, typename Map::key_type const& key)
+            {
+                typename Map::key_compare comp = t.key_comp();
+
+                typename Map::iterator end = t.end();
+                typename Map::iterator pos = it;
+                while (pos != end && comp(pos->first, key))
+                    ++pos;
+
+                return t.erase(it, pos);
+            }
+
+            template <class Map>
+            bool is_load_position(Map& t, typename Map::iterator it,
+                typename Map::key_type const& key)
+            {
+                return it != t.end() && !t.key_comp()(key, it->first);
+            }
+
+            template <class Map>
+            typename Map::iterator merge_loaded(Map& t,
+                typename Map::iterator it, typename Map::value_type&& v)
+            {
+                it = find_load_position(t, it, v.first);
+                if (is_load_position(t, it, v.first))
+                {
+                    it->second = std::move(v.second);
+                    return ++it;
+                }
+
+                t.insert(it, std::move(v));
+                return it;
+            }
+
+            template <class Map>
+            void load_mapped_value(input_archive& ar,
+                typename Map::iterator it, std::true_type)
+            {
+                ar >> it->second;
+            }
+
+            template <class Map>
+            void load_mapped_value(input_archive& ar,
+                typename Map::iterator it, std::false_type)
+            {
+                typename Map::mapped_type value;
+                ar >> value;
+                it->second = std::move(value);
+            }
+        }
+
         template <class Key, class Value, class Comp, class Alloc>
         void serialize(input_archive& ar, std::map<Key, Value, Comp, Alloc>& t, unsigned)
         {
-            typedef typename std::map<Key, Value, Comp, Alloc>::value_type value_type;
+            typedef std::map<Key, Value, Comp, Alloc> map_type;
+            typedef typename map_type::value_type value_type;
+            typedef typename map_type::iterator iterator;
 
             std::uint64_t size;
             ar >> size; //-V128
 
-            t.clear();
+            iterator it = t.begin();
+            if (detail::load_bitwise_collection<value_type>(ar, size,
+                    [&t, &it](value_type&& v)
+                    {
+                        it = detail::merge_loaded(t, it, std::move(v));
+                    }))
+            {
+                t.erase(it, t.end());
+                return;
+            }
+
+            typedef std::integral_constant<bool,
+                hpx::traits::supports_in_place_load<Value>::value> in_place;
+
             for (std::size_t i = 0; i < size; ++i)
             {
-                value_type v;
-                ar >> v;
-                t.insert(t.end(), std::move(v));
+                Key key;
+                ar >> key;
+
+                it = detail::find_load_position(t, it, key);
+                if (detail::is_load_position(t, it, key))
+                {
+                    detail::load_mapped_value<map_type>(ar, it, in_place());
+                    ++it;
+                }
+                else
+                {
+                    Value value;
+                    ar >> value;
+                    t.emplace_hint(it, std::move(key), std::move(value));
+                }
             }
+
+            t.erase(it, t.end());
         }
 
         template <class Key, class Value, class Comp, class Alloc>
@@ -121,6 +229,9 @@ namespace hpx
 
             std::uint64_t size = t.size();
             ar << size;
+            if (detail::save_bitwise_collection(ar, t))
+                return;
+
             for(const value_type& val : t)
             {
                 ar << val;
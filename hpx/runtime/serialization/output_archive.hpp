@@ -12,6 +12,7 @@
 #include <hpx/config.hpp>
 #include <hpx/runtime/naming_fwd.hpp>
 #include <hpx/runtime/serialization/basic_archive.hpp>
+#include <hpx/runtime/serialization/detail/container_storage.hpp>
 #include <hpx/runtime/serialization/detail/polymorphic_nonintrusive_factory.hpp>
 #include <hpx/runtime/serialization/detail/raw_ptr.hpp>
 #include <hpx/runtime/serialization/output_container.hpp>
@@ -39,63 +40,60 @@ namespace hpx { namespace serialization
 {
     namespace detail
     {
+        typedef container_storage<erased_output_container>
+            output_container_storage;
+
         template <typename Container>
-        inline std::unique_ptr<erased_output_container>
-        create_output_container(Container& buffer,
-            std::vector<serialization_chunk>* chunks,
+        inline void create_output_container(output_container_storage& res,
+            Container& buffer, std::vector<serialization_chunk>* chunks,
             binary_filter* filter, std::false_type)
         {
-            std::unique_ptr<erased_output_container> res;
             if (filter == nullptr)
             {
                 if (chunks == nullptr)
                 {
-                    res.reset(new output_container<Container, basic_chunker>(
-                        buffer));
+                    res.emplace<output_container<Container, basic_chunker> >(
+                        buffer);
                 }
                 else
                 {
-                    res.reset(new output_container<Container, vector_chunker>(
-                        buffer, chunks));
+                    res.emplace<output_container<Container, vector_chunker> >(
+                        buffer, chunks);
                 }
             }
             else
             {
                 if (chunks == nullptr)
                 {
-                    res.reset(
-                        new filtered_output_container<Container, basic_chunker>(
-                            buffer));
+                    res.emplace<
+                        filtered_output_container<Container, basic_chunker>
+                    >(buffer);
                 }
                 else
                 {
-                    res.reset(
-                        new filtered_output_container<Container, vector_chunker>(
-                            buffer, chunks));
+                    res.emplace<
+                        filtered_output_container<Container, vector_chunker>
+                    >(buffer, chunks);
                 }
             }
-            return res;
         }
 
         template <typename Container>
-        inline std::unique_ptr<erased_output_container>
-        create_output_container(Container& buffer,
-            std::vector<serialization_chunk>* chunks,
+        inline void create_output_container(output_container_storage& res,
+            Container& buffer, std::vector<serialization_chunk>* chunks,
             binary_filter* filter, std::true_type)
         {
-            std::unique_ptr<erased_output_container> res;
             if (filter == nullptr)
             {
-                res.reset(new output_container<Container, counting_chunker>(
-                    buffer, chunks));
+                res.emplace<output_container<Container, counting_chunker> >(
+                    buffer, chunks);
             }
             else
             {
-                res.reset(
-                    new filtered_output_container<Container, counting_chunker>(
-                        buffer, chunks));
+                res.emplace<
+                    filtered_output_container<Container, counting_chunker>
+                >(buffer, chunks);
             }
-            return res;
         }
     }
 
@@ -123,21 +121,23 @@ namespace hpx { namespace serialization
                 std::vector<serialization_chunk>* chunks = nullptr,
                 binary_filter* filter = nullptr)
           : base_type(make_flags(flags, chunks))
-          , buffer_(detail::create_output_container(buffer, chunks, filter,
-                typename traits::serialization_access_data<Container>::
-                    preprocessing_only()))
           , split_gids_(nullptr)
         {
+            detail::create_output_container(buffer_, buffer, chunks, filter,
+                typename traits::serialization_access_data<Container>::
+                    preprocessing_only());
+
             // endianness needs to be saves separately as it is needed to
             // properly interpret the flags
 
             // FIXME: make bool once integer compression is implemented
             std::uint64_t endianess = this->base_type::endian_big() ? ~0ul : 0ul;
-            save(endianess);
+            save_integral_impl(endianess);
 
             // send flags sent by the other end to make sure both ends have
-            // the same assumptions about the archive format
-            save(this->flags_);
+            // the same assumptions about the archive format, both are stored
+            // with a fixed size as the other end does not know the flags yet
+            save_integral_impl(static_cast<std::uint64_t>(this->flags_));
 
             bool has_filter = filter != nullptr;
             save(has_filter);
@@ -201,6 +201,37 @@ namespace hpx { namespace serialization
             buffer_->flush();
         }
 
+        // Retrieve the position the next data will be written to, the data
+        // written from there on may be read by an input_archive constructed
+        // from that position. Returns false if this is not supported.
+        bool get_position(archive_position& pos) const
+        {
+            return buffer_->get_position(pos);
+        }
+
+        // Forget about the pointers serialized so far, pointers written
+        // afterwards will not refer to anything written before.
+        void reset_pointer_tracking()
+        {
+            pointer_tracker_.clear();
+        }
+
+        // Store the given value as a variable length integer (LEB128), using
+        // one byte for each 7 bits of the value.
+        void save_varint(std::uint64_t val)
+        {
+            unsigned char bytes[10];
+            std::size_t count = 0;
+            while (val >= 0x80)
+            {
+                bytes[count++] = static_cast<unsigned char>(val | 0x80);
+                val >>= 7;
+            }
+            bytes[count++] = static_cast<unsigned char>(val);
+
+            save_binary(bytes, count);
+        }
+
     private:
         friend struct basic_archive<output_archive>;
 
@@ -293,12 +324,26 @@ namespace hpx { namespace serialization
         template <typename T>
         void save_integral(T val, std::false_type)
         {
+            if (enable_compact_encoding())
+            {
+                // zigzag encoding maps small negative values to small
+                // unsigned values as well
+                std::int64_t l = static_cast<std::int64_t>(val);
+                save_varint((static_cast<std::uint64_t>(l) << 1) ^
+                    static_cast<std::uint64_t>(l >> 63));
+                return;
+            }
             save_integral_impl(static_cast<std::int64_t>(val));
         }
 
         template <typename T>
         void save_integral(T val, std::true_type)
         {
+            if (enable_compact_encoding())
+            {
+                save_varint(static_cast<std::uint64_t>(val));
+                return;
+            }
             save_integral_impl(static_cast<std::uint64_t>(val));
         }
 
@@ -389,7 +434,7 @@ namespace hpx { namespace serialization
             return it->second;
         }
 
-        std::unique_ptr<erased_output_container> buffer_;
+        detail::output_container_storage buffer_;
         pointer_tracker pointer_tracker_;
         split_gids_type * split_gids_;
     };
@@ -221,6 +221,23 @@ namespace hpx { namespace serialization
             access_traits::reset(cont_);
         }
 
+        bool get_position(archive_position& pos) const // override
+        {
+            pos.data_pos_ = current_;
+            if (chunker_.get_chunk_type() == chunk_type_pointer)
+            {
+                // the next data will start a new index chunk
+                pos.chunk_ = chunker_.get_num_chunks();
+                pos.chunk_pos_ = 0;
+            }
+            else
+            {
+                pos.chunk_ = chunker_.get_num_chunks() - 1;
+                pos.chunk_pos_ = current_ - chunker_.get_chunk_data_index();
+            }
+            return true;
+        }
+
         void set_filter(binary_filter* filter) // override
         {
             HPX_ASSERT(chunker_.get_num_chunks() == 1 &&
@@ -341,6 +358,12 @@ namespace hpx { namespace serialization
             this->base_type::set_filter(nullptr);
         }
 
+        bool get_position(archive_position& /*pos*/) const // override
+        {
+            // compressed data can be read sequentially only
+            return false;
+        }
+
         void save_binary(void const* address, std::size_t count) // override
         {
             HPX_ASSERT(count != 0);
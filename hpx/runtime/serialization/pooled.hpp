@@ -0,0 +1,231 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_SERIALIZATION_POOLED_HPP
+#define HPX_SERIALIZATION_POOLED_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/serialization/serialization_fwd.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace serialization
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The objects held by all instances of pooled<T, Tag> which are not
+        // in use. At most max_cached_objects are kept, the others are
+        // deleted when they are released.
+        template <typename T, typename Tag>
+        class object_pool
+        {
+            typedef hpx::lcos::local::spinlock mutex_type;
+
+            HPX_STATIC_CONSTEXPR std::size_t max_cached_objects = 64;
+
+            object_pool()
+            {
+                cache_.reserve(max_cached_objects);
+            }
+
+        public:
+            ~object_pool()
+            {
+                for (T* p : cache_)
+                    delete p;
+            }
+
+            static object_pool& get()
+            {
+                static object_pool pool;
+                return pool;
+            }
+
+            T* acquire()
+            {
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    if (!cache_.empty())
+                    {
+                        T* p = cache_.back();
+                        cache_.pop_back();
+                        return p;
+                    }
+                }
+                return new T();
+            }
+
+            void release(T* p)
+            {
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    if (cache_.size() != max_cached_objects)
+                    {
+                        cache_.push_back(p);
+                        return;
+                    }
+                }
+                delete p;
+            }
+
+        private:
+            mutex_type mtx_;
+            std::vector<T*> cache_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A handle to an object of type T taken from a pool of such objects,
+    // which is returned to the pool when the handle is destroyed. The objects
+    // in the pool keep their value, and with it the storage they allocated.
+    //
+    // The object held by a pooled<T> is loaded in place when the handle is
+    // deserialized. Loading vectors, strings and maps into existing objects
+    // reuses their capacity (see traits::supports_in_place_load), so an
+    // action taking, e.g., a pooled<std::vector<double> > argument does not
+    // allocate memory for the argument once the pool holds objects of
+    // sufficient size:
+    //
+    //      void consume(pooled<std::vector<double> > const& data)
+    //      {
+    //          std::vector<double> const& v = *data;
+    //          ...
+    //      }
+    //      HPX_PLAIN_ACTION(consume);
+    //
+    // Arguments of different actions can be kept in different pools by
+    // giving them different tag types. Copying values into pooled objects
+    // on the sending side reuses the capacity of those as well. The value of
+    // the object held by a default constructed handle is unspecified, it
+    // is the value the object had when it was returned to the pool.
+    template <typename T, typename Tag = void>
+    class pooled
+    {
+        typedef detail::object_pool<T, Tag> pool_type;
+
+    public:
+        typedef T value_type;
+
+        pooled()
+          : p_(pool_type::get().acquire())
+        {}
+
+        pooled(T const& value)
+          : p_(pool_type::get().acquire())
+        {
+            assign(value);
+        }
+
+        pooled(T&& value)
+          : p_(pool_type::get().acquire())
+        {
+            assign(std::move(value));
+        }
+
+        pooled(pooled const& rhs)
+          : p_(pool_type::get().acquire())
+        {
+            assign(*rhs);
+        }
+
+        pooled(pooled&& rhs) noexcept
+          : p_(rhs.p_)
+        {
+            rhs.p_ = nullptr;
+        }
+
+        ~pooled()
+        {
+            if (p_ != nullptr)
+                pool_type::get().release(p_);
+        }
+
+        pooled& operator=(pooled const& rhs)
+        {
+            if (this != &rhs)
+                assign(*rhs);
+            return *this;
+        }
+
+        pooled& operator=(pooled&& rhs) noexcept
+        {
+            std::swap(p_, rhs.p_);
+            return *this;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        T& operator*()
+        {
+            HPX_ASSERT(p_ != nullptr);
+            return *p_;
+        }
+        T const& operator*() const
+        {
+            HPX_ASSERT(p_ != nullptr);
+            return *p_;
+        }
+
+        T* operator->()
+        {
+            HPX_ASSERT(p_ != nullptr);
+            return p_;
+        }
+        T const* operator->() const
+        {
+            HPX_ASSERT(p_ != nullptr);
+            return p_;
+        }
+
+        T& get()
+        {
+            return **this;
+        }
+        T const& get() const
+        {
+            return **this;
+        }
+
+    private:
+        // the object of a moved from handle is acquired when it is assigned
+        // to again
+        template <typename U>
+        void assign(U&& value)
+        {
+            if (p_ == nullptr)
+                p_ = pool_type::get().acquire();
+            *p_ = std::forward<U>(value);
+        }
+
+        // serialization support
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        void save(Archive& ar, unsigned) const
+        {
+            ar << **this;
+        }
+
+        template <typename Archive>
+        void load(Archive& ar, unsigned)
+        {
+            if (p_ == nullptr)
+                p_ = pool_type::get().acquire();
+            ar >> *p_;
+        }
+
+        HPX_SERIALIZATION_SPLIT_MEMBER()
+
+        T* p_;
+    };
+}}
+
+#endif
@@ -0,0 +1,111 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file receive_buffer_registry.hpp
+
+#ifndef HPX_SERIALIZATION_RECEIVE_BUFFER_REGISTRY_HPP
+#define HPX_SERIALIZATION_RECEIVE_BUFFER_REGISTRY_HPP
+
+#include <hpx/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hpx { namespace serialization
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// Register application owned memory a \a serialize_buffer can be
+    /// received into.
+    ///
+    /// A \a serialize_buffer whose receive target was set to the returned key
+    /// (see serialize_buffer::set_receive_target) is loaded directly into the
+    /// given memory when it is received on this locality, no memory is
+    /// allocated for it. The memory has to stay valid until it is
+    /// unregistered, the application has to make sure it is not accessed
+    /// while data may be received into it.
+    ///
+    /// \param data     The memory to receive the data into.
+    /// \param bytes    The size of the memory in bytes.
+    ///
+    /// \returns        The key identifying the memory, the key is unique
+    ///                 across all localities.
+    ///
+    /// \note This function needs to be executed on a HPX-thread.
+    HPX_EXPORT std::uint64_t register_receive_buffer(
+        void* data, std::size_t bytes);
+
+    /// Unregister memory registered with \a register_receive_buffer, data
+    /// sent to the key afterwards is received into newly allocated memory.
+    HPX_EXPORT void unregister_receive_buffer(std::uint64_t key);
+
+    namespace detail
+    {
+        // Return the memory registered with the given key on this locality
+        // if it has at least the given size, nullptr otherwise.
+        HPX_EXPORT void* find_receive_buffer(
+            std::uint64_t key, std::size_t bytes);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Registers an array of \a size elements of type T as a receive buffer
+    /// for the lifetime of the object.
+    template <typename T>
+    class receive_buffer_registration
+    {
+    public:
+        receive_buffer_registration()
+          : key_(0)
+        {}
+
+        receive_buffer_registration(T* data, std::size_t size)
+          : key_(register_receive_buffer(data, size * sizeof(T)))
+        {}
+
+        receive_buffer_registration(receive_buffer_registration&& rhs)
+          : key_(rhs.key_)
+        {
+            rhs.key_ = 0;
+        }
+
+        receive_buffer_registration& operator=(
+            receive_buffer_registration&& rhs)
+        {
+            if (this != &rhs)
+            {
+                reset();
+                key_ = rhs.key_;
+                rhs.key_ = 0;
+            }
+            return *this;
+        }
+
+        ~receive_buffer_registration()
+        {
+            reset();
+        }
+
+        receive_buffer_registration(
+            receive_buffer_registration const&) = delete;
+        receive_buffer_registration& operator=(
+            receive_buffer_registration const&) = delete;
+
+        /// Return the key to pass to serialize_buffer::set_receive_target.
+        std::uint64_t key() const { return key_; }
+
+        void reset()
+        {
+            if (key_ != 0)
+            {
+                unregister_receive_buffer(key_);
+                key_ = 0;
+            }
+        }
+
+    private:
+        std::uint64_t key_;
+    };
+}}
+
+#endif
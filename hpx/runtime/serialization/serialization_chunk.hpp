@@ -31,7 +31,8 @@ namespace hpx { namespace serialization
     enum chunk_type
     {
         chunk_type_index = 0,
-        chunk_type_pointer = 1
+        chunk_type_pointer = 1,
+        chunk_type_reference = 2    // repeats the pointer chunk at index_
     };
 
     struct serialization_chunk
@@ -63,6 +64,16 @@ namespace hpx { namespace serialization
         return retval;
     }
 
+    inline serialization_chunk create_reference_chunk(
+        std::size_t chunk, std::size_t size)
+    {
+        serialization_chunk retval = {
+            { 0 }, size, 0, static_cast<std::uint8_t>(chunk_type_reference)
+        };
+        retval.data_.index_ = chunk;
+        return retval;
+    }
+
 }}
 
 #endif
@@ -9,8 +9,10 @@
 
 #include <hpx/config.hpp>
 #include <hpx/runtime/serialization/array.hpp>
+#include <hpx/runtime/serialization/receive_buffer_registry.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
 #include <hpx/throw_exception.hpp>
+#include <hpx/traits/is_bitwise_serializable.hpp>
 #include <hpx/traits/supports_streaming_with_any.hpp>
 #include <hpx/util/bind_back.hpp>
 
@@ -18,7 +20,10 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <type_traits>
+#include <utility>
 
 namespace hpx { namespace serialization
 {
@@ -31,6 +36,9 @@ namespace hpx { namespace serialization
 
         static void no_deleter(T*) {}
 
+        // keeps the data referenced in place alive
+        static void release_owner(T*, std::shared_ptr<void const> const&) {}
+
         template <typename Deallocator>
         static void deleter(T* p, Deallocator dealloc, std::size_t size)
         {
@@ -52,6 +60,7 @@ namespace hpx { namespace serialization
         explicit serialize_buffer(allocator_type const& alloc = allocator_type())
           : size_(0)
           , alloc_(alloc)
+          , target_(0)
         {}
 
         explicit serialize_buffer(std::size_t size,
@@ -59,6 +68,7 @@ namespace hpx { namespace serialization
           : data_()
           , size_(size)
           , alloc_(alloc)
+          , target_(0)
         {
             data_.reset(alloc_.allocate(size),
                         util::bind_back(&serialize_buffer::deleter<allocator_type>,
@@ -72,6 +82,7 @@ namespace hpx { namespace serialization
           : data_()
           , size_(size)
           , alloc_(alloc)
+          , target_(0)
         {
             if (mode == copy) {
                 data_.reset(alloc_.allocate(size),
@@ -98,6 +109,7 @@ namespace hpx { namespace serialization
           : data_()
           , size_(size)
           , alloc_(alloc)
+          , target_(0)
         {
             // if 2 allocators are specified we assume mode 'take'
             data_ = boost::shared_array<T>(data,
@@ -112,6 +124,7 @@ namespace hpx { namespace serialization
           : data_()
           , size_(size)
           , alloc_(alloc)
+          , target_(0)
         {
             if (mode == copy) {
                 data_.reset(alloc_.allocate(size), deleter);
@@ -131,6 +144,7 @@ namespace hpx { namespace serialization
           : data_()
           , size_(size)
           , alloc_(alloc)
+          , target_(0)
         {
             if (mode == copy) {
                 data_.reset(alloc_.allocate(size), deleter);
@@ -156,6 +170,7 @@ namespace hpx { namespace serialization
           : data_()
           , size_(size)
           , alloc_(alloc)
+          , target_(0)
         {
             // if 2 allocators are specified we assume mode 'take'
             data_ = boost::shared_array<T>(data, deleter);
@@ -167,6 +182,7 @@ namespace hpx { namespace serialization
           : data_()
           , size_(size)
           , alloc_(alloc)
+          , target_(0)
         {
             // create from const data implies 'copy' mode
             data_.reset(alloc_.allocate(size),
@@ -183,6 +199,7 @@ namespace hpx { namespace serialization
           : data_()
           , size_(size)
           , alloc_(alloc)
+          , target_(0)
         {
             // create from const data implies 'copy' mode
             data_.reset(alloc_.allocate(size), deleter);
@@ -195,6 +212,7 @@ namespace hpx { namespace serialization
           : data_()
           , size_(size)
           , alloc_(alloc)
+          , target_(0)
         {
             if (mode == copy) {
                 data_.reset(alloc_.allocate(size),
@@ -230,6 +248,17 @@ namespace hpx { namespace serialization
 
         std::size_t size() const { return size_; }
 
+        // Make the receiving locality load the data into the application
+        // owned memory registered with the given key (see
+        // hpx::serialization::register_receive_buffer) instead of allocating
+        // new memory. The data is loaded into newly allocated memory as
+        // usual if no buffer of sufficient size is registered with the key
+        // on the receiving locality, and the key has no effect if the buffer
+        // is not serialized at all (for instance if it is passed to an
+        // action executed locally).
+        void set_receive_target(std::uint64_t key) { target_ = key; }
+        std::uint64_t get_receive_target() const { return target_; }
+
     private:
         // serialization support
         friend class hpx::serialization::access;
@@ -238,7 +267,7 @@ namespace hpx { namespace serialization
         template <typename Archive>
         void save(Archive& ar, const unsigned int version) const
         {
-            ar << size_ << alloc_; //-V128
+            ar << size_ << alloc_ << target_; //-V128
 
             if (size_ != 0)
             {
@@ -250,7 +279,28 @@ namespace hpx { namespace serialization
         template <typename Archive>
         void load(Archive& ar, const unsigned int version)
         {
-            ar >> size_ >> alloc_; //-V128
+            ar >> size_ >> alloc_ >> target_; //-V128
+
+            if (size_ != 0 && target_ != 0)
+            {
+                // load the data straight into the registered memory
+                void* target = detail::find_receive_buffer(
+                    target_, size_ * sizeof(T));
+                if (target != nullptr)
+                {
+                    data_ = boost::shared_array<T>(static_cast<T*>(target),
+                        &serialize_buffer::no_deleter);
+                    ar >> hpx::serialization::make_array(data_.get(), size_);
+                    return;
+                }
+            }
+
+            typedef std::integral_constant<bool,
+                hpx::traits::is_bitwise_serializable<T>::value
+            > use_reference;
+
+            if (size_ != 0 && load_reference(ar, use_reference()))
+                return;
 
             data_.reset(alloc_.allocate(size_),
                 util::bind_back(&serialize_buffer::deleter<allocator_type>,
@@ -262,6 +312,30 @@ namespace hpx { namespace serialization
             }
         }
 
+        // Reference the data in place if the archive allows it, this avoids
+        // copying the data of buffers restored from memory mapped files.
+        template <typename Archive>
+        bool load_reference(Archive& ar, std::true_type)
+        {
+            std::shared_ptr<void const> owner;
+            void const* data = ar.reference_binary_chunk(
+                size_ * sizeof(T), alignof(T), owner);
+            if (data == nullptr)
+                return false;
+
+            data_ = boost::shared_array<T>(
+                static_cast<T*>(const_cast<void*>(data)),
+                util::bind_back(&serialize_buffer::release_owner,
+                    std::move(owner)));
+            return true;
+        }
+
+        template <typename Archive>
+        bool load_reference(Archive&, std::false_type)
+        {
+            return false;
+        }
+
         HPX_SERIALIZATION_SPLIT_MEMBER()
 
         // this is needed for util::any
@@ -275,6 +349,7 @@ namespace hpx { namespace serialization
         boost::shared_array<T> data_;
         std::size_t size_;
         Allocator alloc_;
+        std::uint64_t target_;      // key of the registered receive buffer
     };
 }}
 
@@ -7,6 +7,7 @@
 #define HPX_SERIALIZATION_SET_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/runtime/serialization/detail/bitwise_collection.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
 
 #include <cstddef>
@@ -24,6 +25,15 @@ namespace hpx { namespace serialization
         ar >> size;
 
         set.clear();
+        if (detail::load_bitwise_collection<T>(ar, size,
+                [&set](T&& t)
+                {
+                    set.insert(set.end(), std::move(t));
+                }))
+        {
+            return;
+        }
+
         for (std::size_t i = 0; i < size; ++i) {
             T t;
             ar >> t;
@@ -38,6 +48,9 @@ namespace hpx { namespace serialization
         std::uint64_t size = set.size();
         ar << size;
         if(set.empty()) return;
+        if (detail::save_bitwise_collection(ar, set))
+            return;
+
         for (T const& i: set) {
             ar << i;
         }
@@ -9,9 +9,19 @@
 #include <hpx/config.hpp>
 #include <hpx/runtime/serialization/basic_archive.hpp>
 #include <hpx/runtime/serialization/serialization_fwd.hpp>
+#include <hpx/traits/supports_in_place_load.hpp>
 
 #include <cstdint>
 #include <string>
+#include <type_traits>
+
+namespace hpx { namespace traits
+{
+    template <typename Char, typename CharTraits, typename Allocator>
+    struct supports_in_place_load<std::basic_string<Char, CharTraits, Allocator> >
+      : std::true_type
+    {};
+}}
 
 namespace hpx { namespace serialization
 {
@@ -8,15 +8,27 @@
 #define HPX_SERIALIZATION_UNORDERED_MAP_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/runtime/serialization/detail/bitwise_collection.hpp>
 #include <hpx/runtime/serialization/input_archive.hpp>
 #include <hpx/runtime/serialization/map.hpp>
 #include <hpx/runtime/serialization/output_archive.hpp>
+#include <hpx/traits/supports_in_place_load.hpp>
 
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 
 namespace hpx
 {
+    namespace traits
+    {
+        template <class Key, class Value, class Hash, class KeyEqual, class Alloc>
+        struct supports_in_place_load<
+                std::unordered_map<Key, Value, Hash, KeyEqual, Alloc> >
+          : std::true_type
+        {};
+    }
+
     namespace serialization
     {
         template <class Key, class Value, class Hash, class KeyEqual, class Alloc>
@@ -33,6 +45,16 @@ namespace hpx
             ar >> size; //-V128
 
             t.clear();
+            t.reserve(size);
+            if (detail::load_bitwise_collection<value_type>(ar, size,
+                    [&t](value_type&& v)
+                    {
+                        t.insert(std::move(v));
+                    }))
+            {
+                return;
+            }
+
             for (size_type i = 0; i < size; ++i)
             {
                 value_type v;
@@ -51,6 +73,9 @@ namespace hpx
             typedef typename container_type::value_type value_type;
 
             ar << t.size(); //-V128
+            if (detail::save_bitwise_collection(ar, t))
+                return;
+
             for(const value_type& val : t)
             {
                 ar << val;
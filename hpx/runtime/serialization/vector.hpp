@@ -9,29 +9,89 @@
 #include <hpx/config.hpp>
 #include <hpx/runtime/serialization/array.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/detail/compact_array_encoding.hpp>
 #include <hpx/runtime/serialization/detail/serialize_collection.hpp>
 #include <hpx/traits/is_bitwise_serializable.hpp>
+#include <hpx/traits/supports_in_place_load.hpp>
 
 #include <cstddef>
 #include <cstdint>
 #include <type_traits>
 #include <vector>
 
+namespace hpx
+{
+    namespace traits
+    {
+        // loading a vector replaces all of its elements
+        template <typename T, typename Allocator>
+        struct supports_in_place_load<std::vector<T, Allocator> >
+          : std::true_type
+        {};
+    }
+}
+
 namespace hpx { namespace serialization
 {
     namespace detail
     {
+        template <typename T, typename Allocator>
+        void load_array(input_archive & ar, std::vector<T, Allocator> & v,
+            std::false_type)
+        {
+            ar >> hpx::serialization::make_array(v.data(), v.size());
+        }
+
+        template <typename T, typename Allocator>
+        void load_array(input_archive & ar, std::vector<T, Allocator> & v,
+            std::true_type)
+        {
+            if (ar.enable_compact_encoding())
+            {
+                compact_array_encoding<T>::load(ar, v.data(), v.size());
+                return;
+            }
+            ar >> hpx::serialization::make_array(v.data(), v.size());
+        }
+
+        template <typename T, typename Allocator>
+        void load_elements(input_archive & ar, std::vector<T, Allocator> & vs,
+            std::uint64_t size, std::false_type)
+        {
+            vs.clear();
+            detail::load_collection(ar, vs, size);
+        }
+
+        // the elements already present are loaded in place, which keeps
+        // their storage (e.g. the capacity of nested vectors) alive
+        template <typename T, typename Allocator>
+        void load_elements(input_archive & ar, std::vector<T, Allocator> & vs,
+            std::uint64_t size, std::true_type)
+        {
+            vs.resize(size);
+            for (T& v : vs)
+                ar >> v;
+        }
+
         // load vector<T>
         template <typename T, typename Allocator>
         void load_impl(input_archive & ar, std::vector<T, Allocator> & vs,
             std::false_type)
         {
+            typedef std::integral_constant<bool,
+                hpx::traits::supports_in_place_load<T>::value &&
+                std::is_default_constructible<T>::value> in_place;
+
             // normal load ...
             std::uint64_t size;
             ar >> size; //-V128
-            if (size == 0) return;
+            if (size == 0)
+            {
+                vs.clear();
+                return;
+            }
 
-            detail::load_collection(ar, vs, size);
+            load_elements(ar, vs, size, in_place());
         }
 
         template <typename T, typename Allocator>
@@ -47,11 +107,13 @@ namespace hpx { namespace serialization
             // bitwise load ...
             std::uint64_t size;
             ar >> size; //-V128
+
+            v.clear();
             if(size == 0) return;
 
             if (v.size() < size)
                 v.resize(size);
-            ar >> hpx::serialization::make_array(v.data(), v.size());
+            load_array(ar, v, compact_array_encoding<T>());
         }
     }
 
@@ -84,13 +146,31 @@ namespace hpx { namespace serialization
                 >::type
             >::value> use_optimized;
 
-        v.clear();
         detail::load_impl(ar, v, use_optimized());
     }
 
     // save vector<T>
     namespace detail
     {
+        template <typename T, typename Allocator>
+        void save_array(output_archive & ar,
+            const std::vector<T, Allocator> & v, std::false_type)
+        {
+            ar << hpx::serialization::make_array(v.data(), v.size());
+        }
+
+        template <typename T, typename Allocator>
+        void save_array(output_archive & ar,
+            const std::vector<T, Allocator> & v, std::true_type)
+        {
+            if (ar.enable_compact_encoding())
+            {
+                compact_array_encoding<T>::save(ar, v.data(), v.size());
+                return;
+            }
+            ar << hpx::serialization::make_array(v.data(), v.size());
+        }
+
         template <typename T, typename Allocator>
         void save_impl(output_archive & ar, const std::vector<T, Allocator> & vs,
             std::false_type)
@@ -110,7 +190,7 @@ namespace hpx { namespace serialization
             }
 
             // bitwise (zero-copy) save ...
-            ar << hpx::serialization::make_array(v.data(), v.size());
+            save_array(ar, v, compact_array_encoding<T>());
         }
     }
 
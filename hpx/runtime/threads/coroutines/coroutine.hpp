@@ -64,10 +64,12 @@ namespace hpx { namespace threads { namespace coroutines
 
         typedef util::unique_function_nonser<result_type(arg_type)> functor_type;
 
+        // see context_base for the meaning of stack and reserved
         coroutine(functor_type&& f,
                 thread_id_type id,
-                std::ptrdiff_t stack_size = detail::default_stack_size)
-          : impl_(std::move(f), id, stack_size)
+                std::ptrdiff_t stack_size = detail::default_stack_size,
+                void* stack = nullptr, std::ptrdiff_t reserved = 0)
+          : impl_(std::move(f), id, stack_size, stack, reserved)
         {
             HPX_ASSERT(impl_.is_ready());
         }
@@ -126,6 +128,12 @@ namespace hpx { namespace threads { namespace coroutines
             return impl_.result();
         }
 
+        result_type run_inline(arg_type arg,
+            impl_type::inline_yield_type && inline_yield)
+        {
+            return impl_.run_inline(arg, std::move(inline_yield));
+        }
+
         bool is_ready() const
         {
             return impl_.is_ready();
@@ -140,6 +148,17 @@ namespace hpx { namespace threads { namespace coroutines
 #endif
         }
 
+        // Return the lowest and the highest address of the stack of this
+        // coroutine, both are nullptr if they are not known.
+        std::pair<void*, void*> get_stack_bounds() const
+        {
+#if defined(HPX_COROUTINES_HAVE_STACK_BOUNDS)
+            return impl_.get_stack_bounds();
+#else
+            return std::pair<void*, void*>(nullptr, nullptr);
+#endif
+        }
+
     private:
         impl_type impl_;
     };
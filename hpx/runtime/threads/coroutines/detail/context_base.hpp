@@ -48,6 +48,7 @@
 #include <hpx/runtime/threads/coroutines/exception.hpp>
 #include <hpx/runtime/threads/thread_id_type.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/unused.hpp>
 #if defined(HPX_HAVE_APEX)
 #include <hpx/util/apex.hpp>
 #endif
@@ -101,10 +102,18 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         typedef void deleter_type(context_base const*);
         typedef hpx::threads::thread_id_type thread_id_type;
 
+        // If HPX_COROUTINES_HAVE_EXTERNAL_STACKS is defined, the context can
+        // be created on a stack allocated by its owner (posix::alloc_stack),
+        // the topmost reserved bytes of which are not used by the context.
         template <typename Derived>
-        context_base(
-            Derived& derived, std::ptrdiff_t stack_size, thread_id_type id)
+        context_base(Derived& derived, std::ptrdiff_t stack_size,
+            thread_id_type id, void* stack = nullptr,
+            std::ptrdiff_t reserved = 0)
+#if defined(HPX_COROUTINES_HAVE_EXTERNAL_STACKS)
+          : default_context_impl(derived, stack_size, stack, reserved)
+#else
           : default_context_impl(derived, stack_size)
+#endif
           , m_caller()
           , m_state(ctx_ready)
           , m_exit_state(ctx_exit_not_requested)
@@ -123,7 +132,13 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
           , m_type_info()
           , m_thread_id(id)
           , continuation_recursion_count_(0)
-        {}
+        {
+#if !defined(HPX_COROUTINES_HAVE_EXTERNAL_STACKS)
+            HPX_ASSERT(stack == nullptr && reserved == 0);
+            HPX_UNUSED(stack);
+            HPX_UNUSED(reserved);
+#endif
+        }
 
         void reset()
         {
@@ -131,6 +146,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
             m_phase = 0;
 #endif
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
+            m_tss_slots.clear();
             delete_tss_storage(m_thread_data);
 #else
             m_thread_data = 0;
@@ -230,6 +246,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
             HPX_ASSERT(exited());
             m_thread_id.reset();
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
+            m_tss_slots.clear();
             delete_tss_storage(m_thread_data);
 #else
             m_thread_data = 0;
@@ -285,6 +302,11 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
                 m_thread_data = create_tss_storage();
             return m_thread_data;
         }
+
+        tss_slots& get_thread_tss_slots() const
+        {
+            return m_tss_slots;
+        }
 #endif
 
         std::size_t& get_continuation_recursion_count()
@@ -354,6 +376,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 #endif
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
             HPX_ASSERT(m_thread_data == nullptr);
+            HPX_ASSERT(m_tss_slots.empty());
 #else
             HPX_ASSERT(m_thread_data == 0);
 #endif
@@ -406,6 +429,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 #endif
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
         mutable detail::tss_storage* m_thread_data;
+        mutable detail::tss_slots m_tss_slots;
 #else
         mutable std::size_t m_thread_data;
 #endif
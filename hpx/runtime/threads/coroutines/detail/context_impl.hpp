@@ -122,6 +122,9 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
     typedef lx::context_impl default_context_impl;
 }}}}
 
+// the stack bounds are known to this context only
+#define HPX_COROUTINES_HAVE_STACK_BOUNDS
+
 #elif defined(_POSIX_VERSION) || defined(__bgq__) || defined(__powerpc__) ||   \
     defined(__s390x_)
 
@@ -27,6 +27,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <stdexcept>
+#include <utility>
 #include <sys/param.h>
 
 #if defined(HPX_HAVE_STACKOVERFLOW_DETECTION)
@@ -155,7 +156,7 @@ namespace hpx { namespace threads { namespace coroutines
             typedef x86_linux_context_impl_base context_impl_base;
 
             x86_linux_context_impl()
-                : m_stack(nullptr)
+                : m_stack(nullptr), m_reserved(0)
             {
 #if defined(HPX_HAVE_STACKOVERFLOW_DETECTION)
                 // concept inspired by the following links:
@@ -181,14 +182,25 @@ namespace hpx { namespace threads { namespace coroutines
             /**
              * Create a context that on restore invokes Functor on
              *  a new stack. The stack size can be optionally specified.
+             *
+             * If @p stack is given, the context runs on that memory (of
+             * @p stack_size bytes, allocated with posix::alloc_stack) instead
+             * of allocating its own stack and does not free it. The topmost
+             * @p reserved bytes of such a stack are left alone, they are
+             * kept for the object owning the context.
              */
             template<typename Functor>
-            x86_linux_context_impl(Functor& cb, std::ptrdiff_t stack_size = -1)
+            x86_linux_context_impl(Functor& cb, std::ptrdiff_t stack_size = -1,
+                    void* stack = nullptr, std::ptrdiff_t reserved = 0)
               : m_stack_size(stack_size == -1
                   ? static_cast<std::ptrdiff_t>(default_stack_size)
                   : stack_size),
-                m_stack(nullptr)
+                m_stack(stack),
+                m_reserved(reserved)
             {
+                HPX_ASSERT((stack == nullptr) == (reserved == 0));
+                HPX_ASSERT(reserved % 64 == 0 && reserved < EXEC_PAGESIZE);
+
                 if (0 != (m_stack_size % EXEC_PAGESIZE))
                 {
                     throw std::runtime_error(
@@ -204,23 +216,24 @@ namespace hpx { namespace threads { namespace coroutines
                             m_stack_size));
                 }
 
-                m_stack = posix::alloc_stack(static_cast<std::size_t>(m_stack_size));
+                if (m_stack == nullptr)
+                    m_stack = posix::alloc_stack(
+                        static_cast<std::size_t>(m_stack_size));
                 HPX_ASSERT(m_stack);
                 posix::watermark_stack(m_stack, static_cast<std::size_t>(m_stack_size));
 
                 typedef void fun(Functor*);
                 fun * funp = trampoline;
 
-                m_sp = (static_cast<void**>(m_stack)
-                    + static_cast<std::size_t>(m_stack_size) / sizeof(void*))
-                    - context_size;
+                m_sp = stack_top() - context_size;
 
                 m_sp[backup_cb_idx] = m_sp[cb_idx] = &cb;
                 m_sp[backup_funp_idx] = m_sp[funp_idx] = nasty_cast<void*>(funp);
+                terminate_frame_chain();
 
 #if defined(HPX_HAVE_VALGRIND) && !defined(NVALGRIND)
                 {
-                    void * eos = static_cast<char*>(m_stack) + m_stack_size;
+                    void * eos = stack_top();
                     m_sp[valgrind_id_idx] = reinterpret_cast<void*>(
                         VALGRIND_STACK_REGISTER(m_stack, eos));
                 }
@@ -300,7 +313,12 @@ namespace hpx { namespace threads { namespace coroutines
                     VALGRIND_STACK_DEREGISTER(
                         reinterpret_cast<std::size_t>(m_sp[valgrind_id_idx]));
 #endif
-                    posix::free_stack(m_stack, static_cast<std::size_t>(m_stack_size));
+                    // external stacks are freed by their owner
+                    if (m_reserved == 0)
+                    {
+                        posix::free_stack(
+                            m_stack, static_cast<std::size_t>(m_stack_size));
+                    }
                 }
             }
 
@@ -327,15 +345,24 @@ namespace hpx { namespace threads { namespace coroutines
                     increment_stack_recycle_count();
 
                     // On rebind, we initialize our stack to ensure a virgin stack
-                    m_sp = (static_cast<void**>(m_stack)
-                        + static_cast<std::size_t>(m_stack_size) / sizeof(void*))
-                        - context_size;
+                    m_sp = stack_top() - context_size;
 
                     m_sp[cb_idx] = m_sp[backup_cb_idx];
                     m_sp[funp_idx] = m_sp[backup_funp_idx];
+                    terminate_frame_chain();
                 }
             }
 
+            // Return the lowest and the highest address of the stack. Stack
+            // walks starting on this stack end at the entry of the coroutine
+            // (see terminate_frame_chain).
+            std::pair<void*, void*> get_stack_bounds() const
+            {
+                if (m_stack == nullptr)
+                    return std::pair<void*, void*>(nullptr, nullptr);
+                return std::pair<void*, void*>(m_stack, stack_top());
+            }
+
             std::ptrdiff_t get_available_stack_space()
             {
                 return get_stack_ptr() - reinterpret_cast<std::size_t>(m_stack) -
@@ -393,30 +420,30 @@ namespace hpx { namespace threads { namespace coroutines
         private:
 #if defined(__x86_64__)
             /** structure of context_data:
-             * 13: backup address of function to execute
-             * 12: backup address of trampoline
-             * 11: additional alignment (or valgrind_id if enabled)
-             * 10: parm 0 of trampoline
-             * 9:  dummy return address for trampoline
-             * 8:  return addr (here: start addr)
-             * 7:  rbp
-             * 6:  rbx
-             * 5:  rsi
-             * 4:  rdi
+             * 11: backup address of function to execute
+             * 10: backup address of trampoline
+             * 9:  additional alignment (or valgrind_id if enabled)
+             * 8:  parm 0 of trampoline
+             * 7:  dummy return address for trampoline
+             * 6:  return addr (here: start addr)
+             * 5:  rbp
+             * 4:  rbx
              * 3:  r12
              * 2:  r13
              * 1:  r14
              * 0:  r15
              **/
 #if defined(HPX_HAVE_VALGRIND) && !defined(NVALGRIND)
-            static const std::size_t valgrind_id_idx = 11;
+            static const std::size_t valgrind_id_idx = 9;
 #endif
 
-            static const std::size_t context_size = 14;
-            static const std::size_t backup_cb_idx = 13;
-            static const std::size_t backup_funp_idx = 12;
-            static const std::size_t cb_idx = 10;
-            static const std::size_t funp_idx = 8;
+            static const std::size_t context_size = 12;
+            static const std::size_t backup_cb_idx = 11;
+            static const std::size_t backup_funp_idx = 10;
+            static const std::size_t cb_idx = 8;
+            static const std::size_t entry_return_idx = 7;
+            static const std::size_t funp_idx = 6;
+            static const std::size_t frame_ptr_idx = 5;
 #else
             /** structure of context_data:
              * 9: valgrind_id (if enabled)
@@ -440,11 +467,32 @@ namespace hpx { namespace threads { namespace coroutines
             static const std::size_t backup_cb_idx = 8;
             static const std::size_t backup_funp_idx = 7;
             static const std::size_t cb_idx = 6;
+            static const std::size_t entry_return_idx = 5;
             static const std::size_t funp_idx = 4;
+            static const std::size_t frame_ptr_idx = 3;
 #endif
 
+            // The frame pointer the trampoline starts with and its return
+            // address are null, which marks the outermost frame of the
+            // coroutine for frame pointer based stack walks (debuggers and
+            // the sampling profiler), instead of letting them continue into
+            // whatever is left on the stack.
+            void terminate_frame_chain()
+            {
+                m_sp[frame_ptr_idx] = nullptr;
+                m_sp[entry_return_idx] = nullptr;
+            }
+
+            void** stack_top() const
+            {
+                return static_cast<void**>(m_stack) +
+                    static_cast<std::size_t>(m_stack_size - m_reserved) /
+                        sizeof(void*);
+            }
+
             std::ptrdiff_t m_stack_size;
             void* m_stack;
+            std::ptrdiff_t m_reserved;      // non-zero for external stacks
 
 #if defined(HPX_HAVE_STACKOVERFLOW_DETECTION)
             struct sigaction action;
@@ -454,6 +502,9 @@ namespace hpx { namespace threads { namespace coroutines
 
         typedef x86_linux_context_impl context_impl;
 
+        // the contexts can run on stacks allocated by their owner
+#define HPX_COROUTINES_HAVE_EXTERNAL_STACKS
+
         /**
          * Free function. Saves the current context in @p from
          * and restores the context in @p to.
@@ -35,6 +35,7 @@
 #include <hpx/config.hpp>
 #include <hpx/runtime/threads/coroutines/detail/swap_context.hpp>
 #include <hpx/runtime/threads/coroutines/exception.hpp>
+#include <hpx/util/allocation_accounting.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/get_and_reset_value.hpp>
 #include <hpx/util/unused.hpp>
@@ -215,12 +216,21 @@ namespace hpx { namespace threads { namespace coroutines
                             )
                         );
                 }
+
+                util::allocation_accounting::allocated(
+                    util::allocation_accounting::thread_stacks,
+                    static_cast<std::size_t>(stacksize_));
             }
 
             ~fibers_context_impl()
             {
                 if (m_ctx != nullptr)
+                {
                     DeleteFiber(m_ctx);
+                    util::allocation_accounting::deallocated(
+                        util::allocation_accounting::thread_stacks,
+                        static_cast<std::size_t>(stacksize_));
+                }
             }
 
             // Return the size of the reserved stack address space.
@@ -42,6 +42,7 @@
 #include <hpx/runtime/threads/thread_enums.hpp>
 #include <hpx/runtime/threads/thread_id_type.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/function.hpp>
 #include <hpx/util/unique_function.hpp>
 
 #include <cstddef>
@@ -66,10 +67,12 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         typedef thread_state_ex_enum arg_type;
 
         typedef util::unique_function_nonser<result_type(arg_type)> functor_type;
+        typedef util::function_nonser<arg_type(result_type)> inline_yield_type;
 
         coroutine_impl(functor_type&& f, thread_id_type id,
-            std::ptrdiff_t stack_size)
-          : context_base(*this, stack_size, id)
+            std::ptrdiff_t stack_size, void* stack = nullptr,
+            std::ptrdiff_t reserved = 0)
+          : context_base(*this, stack_size, id, stack, reserved)
           , m_result(unknown, invalid_thread_id)
           , m_arg(nullptr)
           , m_fun(std::move(f))
@@ -81,6 +84,13 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
         HPX_EXPORT void operator()() noexcept;
 
+        // Execute the stored functor directly on the stack of the caller,
+        // the stack of this coroutine is not touched. All yields are handled
+        // by the given function, which has to return only once the coroutine
+        // is supposed to continue.
+        HPX_EXPORT result_type run_inline(arg_type arg,
+            inline_yield_type && inline_yield);
+
     public:
         void bind_result(result_type res)
         {
@@ -94,6 +94,10 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         {
             HPX_ASSERT(m_pimpl);
 
+            // a coroutine executed inline has no context to switch away from
+            if (!inline_yield_.empty())
+                return inline_yield_(std::move(arg));
+
             this->m_pimpl->bind_result(arg);
 
             {
@@ -132,6 +136,13 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
             return tmp;
         }
 
+        // install the function handling all yields of a coroutine which is
+        // executed inline on the stack of its caller
+        void set_inline_yield(yield_decorator_type && f)
+        {
+            inline_yield_ = std::move(f);
+        }
+
         thread_id_type get_thread_id() const
         {
             HPX_ASSERT(m_pimpl);
@@ -151,6 +162,9 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         std::ptrdiff_t get_available_stack_space()
         {
 #if defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
+            // the stack of the coroutine is not used if executed inline
+            if (!inline_yield_.empty())
+                return (std::numeric_limits<std::ptrdiff_t>::max)();
             return m_pimpl->get_available_stack_space();
 #else
             return (std::numeric_limits<std::ptrdiff_t>::max)();
@@ -185,6 +199,12 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
             HPX_ASSERT(m_pimpl);
             return m_pimpl->get_thread_tss_data(true);
         }
+
+        tss_slots& get_thread_tss_slots()
+        {
+            HPX_ASSERT(m_pimpl);
+            return m_pimpl->get_thread_tss_slots();
+        }
 #endif
 
         std::size_t& get_continuation_recursion_count()
@@ -220,6 +240,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
     private:
         yield_decorator_type yield_decorator_;
+        yield_decorator_type inline_yield_;
 
         impl_ptr get_impl()
         {
@@ -31,6 +31,8 @@
 #define HPX_RUNTIME_THREADS_COROUTINES_DETAIL_POSIX_UTILITY_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/runtime/threads/coroutines/detail/stack_pool.hpp>
+#include <hpx/util/allocation_accounting.hpp>
 #include <hpx/util/assert.hpp>
 
 // include unist.d conditionally to check for POSIX version. Not all OSs have the
@@ -80,6 +82,16 @@ namespace posix
 
     inline void* alloc_stack(std::size_t size)
     {
+#if defined(HPX_COROUTINES_HAVE_STACK_POOL)
+        if (use_stack_pool)
+        {
+            void* stack = stack_pool::allocate(size);
+            util::allocation_accounting::allocated(
+                util::allocation_accounting::thread_stacks, size);
+            return stack;
+        }
+#endif
+
         void* real_stack = ::mmap(nullptr,
             size + EXEC_PAGESIZE,
             PROT_EXEC | PROT_READ | PROT_WRITE,
@@ -105,6 +117,9 @@ namespace posix
                 throw std::runtime_error("mmap() failed to allocate thread stack");
         }
 
+        util::allocation_accounting::allocated(
+            util::allocation_accounting::thread_stacks, size);
+
 #if defined(HPX_HAVE_THREAD_GUARD_PAGE)
         if (use_guard_pages)
         {
@@ -151,6 +166,17 @@ namespace posix
 
     inline void free_stack(void* stack, std::size_t size)
     {
+        util::allocation_accounting::deallocated(
+            util::allocation_accounting::thread_stacks, size);
+
+#if defined(HPX_COROUTINES_HAVE_STACK_POOL)
+        if (use_stack_pool)
+        {
+            stack_pool::deallocate(stack, size);
+            return;
+        }
+#endif
+
 #if defined(HPX_HAVE_THREAD_GUARD_PAGE)
         if (use_guard_pages) {
             void** real_stack =
@@ -186,7 +212,10 @@ namespace posix
      */
     inline void* alloc_stack(std::size_t size)
     {
-        return new stack_aligner[size / sizeof(stack_aligner)];
+        void* stack = new stack_aligner[size / sizeof(stack_aligner)];
+        util::allocation_accounting::allocated(
+            util::allocation_accounting::thread_stacks, size);
+        return stack;
     }
 
     inline void watermark_stack(void* stack, std::size_t size)
@@ -199,6 +228,8 @@ namespace posix
 
     inline void free_stack(void* stack, std::size_t size)
     {
+        util::allocation_accounting::deallocated(
+            util::allocation_accounting::thread_stacks, size);
         delete[] static_cast<stack_aligner*>(stack);
     }
 
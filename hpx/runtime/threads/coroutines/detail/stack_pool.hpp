@@ -0,0 +1,50 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_RUNTIME_THREADS_COROUTINES_DETAIL_STACK_POOL_HPP
+#define HPX_RUNTIME_THREADS_COROUTINES_DETAIL_STACK_POOL_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_THREAD_STACK_MMAP) && (defined(__linux) ||              \
+    defined(linux) || defined(__linux__) || defined(__FreeBSD__))
+#define HPX_COROUTINES_HAVE_STACK_POOL
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hpx { namespace threads { namespace coroutines { namespace detail {
+namespace posix
+{
+    // these global variables control whether coroutine stacks are taken from
+    // the stack pool and after how long [ms] unused stacks are given back
+    HPX_EXPORT extern bool use_stack_pool;
+    HPX_EXPORT extern std::uint64_t stack_pool_idle_threshold;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Coroutine stacks are carved out of large regions of virtual memory, each
+    // region holds stacks of one size and is owned by the OS thread which
+    // reserved it. The memory of a stack is committed lazily by the operating
+    // system once it is touched. Stacks released to the pool are reused by
+    // the owning thread, stacks which were not reused for longer than the
+    // idle threshold are given back to the operating system (MADV_FREE)
+    // without giving up their address space. Pooled stacks have no guard
+    // pages.
+    struct stack_pool
+    {
+        HPX_EXPORT static void* allocate(std::size_t size);
+        HPX_EXPORT static void deallocate(void* stack, std::size_t size);
+
+        // virtual memory reserved for stacks [bytes]
+        HPX_EXPORT static std::int64_t get_reserved_bytes(bool reset);
+
+        // memory of stacks which are in use or were released recently, this
+        // is an upper bound of the committed stack memory [bytes]
+        HPX_EXPORT static std::int64_t get_committed_bytes(bool reset);
+    };
+}}}}}
+
+#endif
+#endif
@@ -15,10 +15,17 @@
 #include <hpx/util/assert.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <utility>
 
+// The number of thread_specific_ptr instances whose values are stored in a
+// fixed slot of each HPX thread.
+#if !defined(HPX_THREAD_TSS_FAST_SLOTS)
+#define HPX_THREAD_TSS_FAST_SLOTS 8
+#endif
+
 namespace hpx { namespace threads { namespace coroutines { namespace detail
 {
     //////////////////////////////////////////////////////////////////////////
@@ -181,6 +188,79 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         tss_node_data_map data_;
     };
 
+    //////////////////////////////////////////////////////////////////////////
+    // The first HPX_THREAD_TSS_FAST_SLOTS keys which are alive at the same
+    // time are assigned a slot in an array stored in every HPX thread. Their
+    // values are accessed by index, without a lookup and without allocating
+    // the tss_storage of the thread. Any further keys use the tss_storage.
+    static const std::size_t tss_num_slots = HPX_THREAD_TSS_FAST_SLOTS;
+
+    static_assert(tss_num_slots <= 32,
+        "HPX_THREAD_TSS_FAST_SLOTS must not be larger than 32");
+
+    struct tss_slot_key
+    {
+        std::size_t index_;     // tss_num_slots if no slot was assigned
+        std::uint64_t id_;      // unique for every assignment of a slot
+    };
+
+    class HPX_EXPORT tss_slots
+    {
+    public:
+        tss_slots()
+          : used_(0)
+        {}
+
+        tss_slots(tss_slots const&) = delete;
+        tss_slots& operator=(tss_slots const&) = delete;
+
+        ~tss_slots()
+        {
+            clear();
+        }
+
+        // Return the node holding the value of the given key, if any
+        tss_data_node* find(tss_slot_key key)
+        {
+            HPX_ASSERT(key.index_ < tss_num_slots);
+            slot& s = slots_[key.index_];
+            return s.id_ == key.id_ ? &s.node_ : nullptr;
+        }
+
+        // Store a value for the given key. The value a released key may have
+        // left in the slot is cleaned up.
+        void insert(tss_slot_key key,
+            std::shared_ptr<tss_cleanup_function> const& func, void* tss_data);
+
+        void erase(tss_slot_key key, bool cleanup_existing);
+
+        // Clean up all values, this is done once the thread has terminated.
+        void clear();
+
+        bool empty() const
+        {
+            return used_ == 0;
+        }
+
+    private:
+        struct slot
+        {
+            slot()
+              : id_(0)
+            {}
+
+            std::uint64_t id_;
+            tss_data_node node_;
+        };
+
+        slot slots_[tss_num_slots];
+        std::uint32_t used_;    // mask of the slots holding a value
+    };
+
+    // Assign a free slot to a new key, if there is one
+    HPX_EXPORT tss_slot_key allocate_tss_slot();
+    HPX_EXPORT void release_tss_slot(tss_slot_key key);
+
     //////////////////////////////////////////////////////////////////////////
     HPX_EXPORT tss_data_node* find_tss_data(void const* key);
 
@@ -196,6 +276,17 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         std::shared_ptr<tss_cleanup_function> const& func,
         void* tss_data = nullptr, bool cleanup_existing = false);
 
+    // The same for keys which may have been assigned a slot, the tss_storage
+    // is used for the given key if they were not
+    HPX_EXPORT void* get_tss_data(void const* key, tss_slot_key slot);
+
+    HPX_EXPORT void erase_tss_node(void const* key, tss_slot_key slot,
+        bool cleanup_existing = false);
+
+    HPX_EXPORT void set_tss_data(void const* key, tss_slot_key slot,
+        std::shared_ptr<tss_cleanup_function> const& func,
+        void* tss_data = nullptr, bool cleanup_existing = false);
+
     //////////////////////////////////////////////////////////////////////////
     class tss_storage;
 
@@ -12,8 +12,11 @@
 #include <hpx/runtime/threads/thread_init_data.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/logging.hpp>
+#include <hpx/util/task_graph_profiler.hpp>
+#include <hpx/util/task_tracer.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <sstream>
 
 namespace hpx { namespace threads { namespace detail
@@ -70,24 +73,50 @@ namespace hpx { namespace threads { namespace detail
         if (nullptr == data.scheduler_base)
             data.scheduler_base = scheduler;
 
-        // Pass critical priority from parent to child (but only if there is
-        // none is explicitly specified).
+        // Pass critical priority and the deadline from parent to child (but
+        // only if there is none explicitly specified).
         if (self)
         {
+            thread_data* parent = threads::get_self_id().get();
             if (data.priority == thread_priority_default &&
-                thread_priority_high_recursive ==
-                    threads::get_self_id()->get_priority())
+                thread_priority_high_recursive == parent->get_priority())
             {
                 data.priority = thread_priority_high_recursive;
             }
+            if (data.deadline ==
+                    (util::steady_clock::time_point::max)() &&
+                parent->has_deadline())
+            {
+                data.deadline = parent->get_deadline();
+            }
         }
 
         if (data.priority == thread_priority_default)
             data.priority = thread_priority_normal;
 
+#if defined(HPX_HAVE_TASK_GRAPH_PROFILER)
+        // the new thread depends on the one creating it
+        if (HPX_UNLIKELY(util::task_graph::profiling_enabled))
+            util::task_graph::thread_enabled(data.task_graph_info);
+#endif
+
         // create the new thread
         scheduler->create_thread(data, &id, initial_state, run_now, ec);
 
+        // the thread id is known only if the thread was created right away
+        if (HPX_UNLIKELY(util::tracing::tracing_enabled))
+        {
+#ifdef HPX_HAVE_THREAD_DESCRIPTION
+            util::tracing::record_event(util::tracing::event_thread_create,
+                reinterpret_cast<std::uint64_t>(id.get()), data.description,
+                static_cast<std::uint32_t>(initial_state));
+#else
+            util::tracing::record_event(util::tracing::event_thread_create,
+                reinterpret_cast<std::uint64_t>(id.get()), nullptr,
+                static_cast<std::uint32_t>(initial_state));
+#endif
+        }
+
         LTM_(info) << "register_thread(" << id << "): initial_state("
                    << get_thread_state_name(initial_state) << "), "
                    << "run_now(" << (run_now ? "true" : "false")
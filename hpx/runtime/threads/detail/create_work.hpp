@@ -14,13 +14,12 @@
 #include <hpx/util/logging.hpp>
 
 #include <sstream>
+#include <vector>
 
 namespace hpx { namespace threads { namespace detail
 {
-    inline void create_work(policies::scheduler_base* scheduler,
-        thread_init_data& data,
-        thread_state_enum initial_state = threads::pending,
-        error_code& ec = throws)
+    inline bool verify_work_state(thread_state_enum initial_state,
+        error_code& ec)
     {
         // verify parameters
         switch (initial_state) {
@@ -38,30 +37,26 @@ namespace hpx { namespace threads { namespace detail
                 HPX_THROWS_IF(ec, bad_parameter,
                     "thread::detail::create_work",
                     strm.str());
-                return;
+                return false;
             }
         }
+        return true;
+    }
 
+    // Fill in the parts of the thread_init_data which have not been
+    // explicitly specified, returns false if the data is invalid.
+    inline bool prepare_work(policies::scheduler_base* scheduler,
+        thread_init_data& data, thread_self* self, error_code& ec)
+    {
 #ifdef HPX_HAVE_THREAD_DESCRIPTION
         if (!data.description)
         {
             HPX_THROWS_IF(ec, bad_parameter,
                 "thread::detail::create_work", "description is nullptr");
-            return;
+            return false;
         }
 #endif
 
-        LTM_(info)
-            << "create_work: initial_state("
-            << get_thread_state_name(initial_state) << "), thread_priority("
-            << get_thread_priority_name(data.priority)
-#ifdef HPX_HAVE_THREAD_DESCRIPTION
-            << "), description(" << data.description
-#endif
-            << ")";
-
-        thread_self* self = get_self_ptr();
-
 #ifdef HPX_HAVE_THREAD_PARENT_REFERENCE
         if (nullptr == data.parent_id) {
 
@@ -89,13 +84,41 @@ namespace hpx { namespace threads { namespace detail
             }
         }
 
-        // create the new thread
         if (data.priority == thread_priority_default)
             data.priority = thread_priority_normal;
 
-        if (thread_priority_high == data.priority ||
-            thread_priority_high_recursive == data.priority ||
-            thread_priority_boost == data.priority)
+        return true;
+    }
+
+    inline bool is_critical_priority(thread_priority priority)
+    {
+        return thread_priority_high == priority ||
+            thread_priority_high_recursive == priority ||
+            thread_priority_boost == priority;
+    }
+
+    inline void create_work(policies::scheduler_base* scheduler,
+        thread_init_data& data,
+        thread_state_enum initial_state = threads::pending,
+        error_code& ec = throws)
+    {
+        if (!verify_work_state(initial_state, ec))
+            return;
+
+        LTM_(info)
+            << "create_work: initial_state("
+            << get_thread_state_name(initial_state) << "), thread_priority("
+            << get_thread_priority_name(data.priority)
+#ifdef HPX_HAVE_THREAD_DESCRIPTION
+            << "), description(" << data.description
+#endif
+            << ")";
+
+        if (!prepare_work(scheduler, data, get_self_ptr(), ec))
+            return;
+
+        // create the new thread
+        if (is_critical_priority(data.priority))
         {
             // For critical priority threads, create the thread immediately.
             scheduler->create_thread(data, nullptr, initial_state, true, ec);
@@ -105,6 +128,32 @@ namespace hpx { namespace threads { namespace detail
             scheduler->create_thread(data, nullptr, initial_state, false, ec);
         }
     }
+
+    // Create a batch of work items, the scheduler distributes these over its
+    // queues at once.
+    inline void create_work(policies::scheduler_base* scheduler,
+        std::vector<thread_init_data>& data,
+        thread_state_enum initial_state = threads::pending,
+        error_code& ec = throws)
+    {
+        if (!verify_work_state(initial_state, ec))
+            return;
+
+        LTM_(info)
+            << "create_work: initial_state("
+            << get_thread_state_name(initial_state) << "), count("
+            << data.size() << ")";
+
+        thread_self* self = get_self_ptr();
+        for (thread_init_data& d : data)
+        {
+            if (!prepare_work(scheduler, d, self, ec))
+                return;
+        }
+
+        // create the new threads
+        scheduler->create_threads(data, initial_state, ec);
+    }
 }}}
 
 #endif
@@ -0,0 +1,150 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_DETAIL_EXTERNAL_INBOX_HPP)
+#define HPX_RUNTIME_THREADS_DETAIL_EXTERNAL_INBOX_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+#include <hpx/runtime/threads/thread_enums.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/util/thread_description.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace hpx { namespace threads { namespace policies
+{
+    class scheduler_base;
+}}}
+
+namespace hpx { namespace threads { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A task submitted by a thread which is not an HPX worker thread. The
+    // thread function is fully constructed by the submitting thread, the
+    // worker turns it into an HPX thread without any further allocation of
+    // the function object.
+    struct external_task
+    {
+        external_task()
+          : next_(nullptr), priority_(thread_priority_normal)
+        {}
+
+        external_task(thread_function_type && func,
+                util::thread_description const& desc,
+                thread_priority priority = thread_priority_normal)
+          : next_(nullptr), func_(std::move(func)), desc_(desc),
+            priority_(priority)
+        {}
+
+        HPX_NON_COPYABLE(external_task);
+
+        std::atomic<external_task*> next_;
+        thread_function_type func_;
+        util::thread_description desc_;
+        thread_priority priority_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The inboxes through which threads outside of the runtime hand work to
+    // the worker threads of the default pool. There is one intrusive
+    // multi-producer single-consumer queue (see Vyukov, "Intrusive MPSC
+    // node-based queue") per worker: a submitting thread appends a single
+    // task or a whole chain of tasks with one atomic exchange, it never takes
+    // a lock and never touches the queues of the scheduler. The workers drain
+    // their inbox from the scheduling loop and create the HPX threads locally.
+    //
+    // The submitting threads pick the inbox round robin (using a thread local
+    // counter) and wake the owning worker if it is parked because it was
+    // idle.
+    class HPX_EXPORT external_inbox
+    {
+    public:
+        HPX_NON_COPYABLE(external_inbox);
+
+    private:
+        struct queue
+        {
+            queue();
+
+            bool empty() const
+            {
+                return head_ == &stub_ &&
+                    tail_.load(std::memory_order_acquire) == &stub_;
+            }
+
+            void push(external_task* first, external_task* last);
+            external_task* pop();
+
+            char pad0_[threads::get_cache_line_size()];
+            std::atomic<external_task*> tail_;      // written by producers
+            char pad1_[threads::get_cache_line_size()];
+            external_task* head_;                   // owned by the worker
+            external_task stub_;
+            char pad2_[threads::get_cache_line_size()];
+        };
+
+    public:
+        external_inbox();
+        ~external_inbox();
+
+        static external_inbox& get();
+
+        // Called by the thread manager once the default pool runs, and
+        // after it has been stopped. Tasks which have not been drained when
+        // the pool is detached are dropped.
+        void attach(policies::scheduler_base* scheduler,
+            std::size_t num_threads);
+        void detach();
+
+        // Hand the given chain of tasks (linked through next_) to one of the
+        // workers. Returns false if the runtime is not running, the tasks
+        // remain owned by the caller in this case.
+        bool push(external_task* first, external_task* last);
+
+        // Distribute the given tasks over all inboxes, this uses a single
+        // atomic exchange per inbox. Returns false if the runtime is not
+        // running, without having taken ownership of any of the tasks.
+        bool push_bulk(std::unique_ptr<external_task>* tasks,
+            std::size_t count);
+
+        // Create the HPX threads for all tasks in the inbox of the given
+        // (pool local) worker, called by the scheduling loops. Returns the
+        // number of threads created.
+        std::size_t poll(policies::scheduler_base* scheduler,
+            std::size_t num_thread)
+        {
+            if (scheduler != scheduler_.load(std::memory_order_acquire) ||
+                num_thread >= num_queues_ || queues_[num_thread].empty())
+            {
+                return 0;
+            }
+            return drain(scheduler, num_thread);
+        }
+
+        // Return whether the inbox of the given (pool local) worker is
+        // empty, a worker does not go to sleep as long as it is not.
+        bool empty(policies::scheduler_base const* scheduler,
+            std::size_t num_thread) const
+        {
+            return scheduler != scheduler_.load(std::memory_order_acquire) ||
+                num_thread >= num_queues_ || queues_[num_thread].empty();
+        }
+
+    private:
+        std::size_t drain(policies::scheduler_base* scheduler,
+            std::size_t num_thread);
+        void clear();
+
+        std::atomic<policies::scheduler_base*> scheduler_;
+        std::size_t num_queues_;
+        std::unique_ptr<queue[]> queues_;
+    };
+}}}
+
+#endif
@@ -0,0 +1,114 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_DETAIL_IDLE_BACKOFF_HPP)
+#define HPX_RUNTIME_THREADS_DETAIL_IDLE_BACKOFF_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace hpx { namespace threads { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Adaptive back-off for a worker thread which has run out of work. An
+    // idle worker first spins, then spins using the SMT pause instruction,
+    // and finally goes to sleep until new work is announced (or the sleep
+    // time has expired).
+    //
+    // The duration of the spinning phases is tuned from the measured length
+    // of the idle periods of this worker: if new work typically arrives
+    // quickly the worker spins long enough to pick it up without having to
+    // be woken, if the worker is idle for long periods it stops spinning
+    // early and saves power instead.
+    class idle_backoff
+    {
+    public:
+        // all durations are given in microseconds
+        idle_backoff(std::int64_t max_spin_time, std::int64_t max_sleep_time)
+          : max_spin_time_((std::max)(max_spin_time, std::int64_t(1)) * 1000),
+            max_sleep_time_((std::max)(max_sleep_time, std::int64_t(1))),
+            idle_start_(0),
+            average_idle_time_(0),
+            spin_time_(max_spin_time_),
+            sleep_time_(min_sleep_time)
+        {}
+
+        // Called whenever the worker found work to do
+        void on_work()
+        {
+            if (idle_start_ == 0)
+                return;
+
+            // moving average over the lengths of the idle periods
+            std::int64_t idle_time =
+                std::int64_t(util::high_resolution_clock::now() - idle_start_);
+            average_idle_time_ += (idle_time - average_idle_time_) / 8;
+
+            // Spin for twice the average idle period if that likely catches
+            // the next task, otherwise spin only briefly before sleeping.
+            if (2 * average_idle_time_ <= max_spin_time_)
+            {
+                spin_time_ = (std::max)(
+                    2 * average_idle_time_, std::int64_t(min_spin_time));
+            }
+            else
+            {
+                spin_time_ = min_spin_time;
+            }
+
+            idle_start_ = 0;
+            sleep_time_ = min_sleep_time;
+        }
+
+        // Called whenever the worker did not find any work
+        template <typename Scheduler>
+        void on_idle(Scheduler& scheduler, std::size_t num_thread)
+        {
+            std::uint64_t now = util::high_resolution_clock::now();
+            if (idle_start_ == 0)
+            {
+                idle_start_ = now;
+                return;
+            }
+
+            std::int64_t idle_time = std::int64_t(now - idle_start_);
+            if (idle_time < spin_time_)
+                return;
+
+            if (idle_time < 2 * spin_time_)
+            {
+                for (int i = 0; i != pause_count; ++i)
+                    HPX_SMT_PAUSE;
+                return;
+            }
+
+            // sleep with exponentially increasing timeouts, new work
+            // will wake up the worker right away
+            scheduler.idle_sleep(num_thread,
+                std::chrono::microseconds(sleep_time_));
+            sleep_time_ = (std::min)(2 * sleep_time_, max_sleep_time_);
+        }
+
+    private:
+        static constexpr std::int64_t min_spin_time = 1000;     // [ns]
+        static constexpr std::int64_t min_sleep_time = 10;      // [us]
+        static constexpr int pause_count = 16;
+
+        std::int64_t const max_spin_time_;          // [ns]
+        std::int64_t const max_sleep_time_;         // [us]
+
+        std::uint64_t idle_start_;                  // [ns], 0 if busy
+        std::int64_t average_idle_time_;            // [ns]
+        std::int64_t spin_time_;                    // [ns]
+        std::int64_t sleep_time_;                   // [us]
+    };
+}}}
+
+#endif
@@ -21,6 +21,7 @@
 #include <exception>
 #include <iosfwd>
 #include <utility>
+#include <vector>
 
 #include <hpx/config/warnings_prefix.hpp>
 
@@ -49,6 +50,9 @@ namespace hpx { namespace threads { namespace detail
         void create_work(thread_init_data& data,
             thread_state_enum initial_state, error_code& ec);
 
+        void create_threads(std::vector<thread_init_data>& data,
+            thread_state_enum initial_state, error_code& ec);
+
         thread_state set_state(thread_id_type const& id,
             thread_state_enum new_state, thread_state_ex_enum new_state_ex,
             thread_priority priority, error_code& ec);
@@ -0,0 +1,151 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_DETAIL_PARKING_SPOT_HPP)
+#define HPX_RUNTIME_THREADS_DETAIL_PARKING_SPOT_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+
+#if defined(__linux) || defined(linux) || defined(__linux__)
+#define HPX_THREADS_PARKING_SPOT_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#else
+#include <hpx/compat/condition_variable.hpp>
+#include <hpx/compat/mutex.hpp>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace hpx { namespace threads { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A place where exactly one (idle) worker thread can be parked until it
+    // is explicitly woken up or until a timeout has expired. Waking a parked
+    // worker never disturbs any other worker, which avoids the thundering
+    // herd caused by notifying a condition variable shared by all workers.
+    //
+    // On Linux the worker waits on a futex, elsewhere a mutex and condition
+    // variable per parking spot are used instead.
+    class parking_spot
+    {
+    public:
+        parking_spot()
+          : state_(running),
+            numa_node_(std::size_t(-1))
+        {}
+
+        parking_spot(parking_spot const&) = delete;
+        parking_spot& operator=(parking_spot const&) = delete;
+
+        // Announce that the calling worker is about to be parked. Any
+        // unpark() request issued after this call will make park() return
+        // immediately.
+        void prepare_park()
+        {
+            state_.store(parked);
+        }
+
+        // Block the calling worker until it is woken up or until the timeout
+        // has expired, prepare_park() has to be called first.
+        void park(std::chrono::microseconds timeout)
+        {
+#if defined(HPX_THREADS_PARKING_SPOT_FUTEX)
+            if (state_.load(std::memory_order_acquire) == parked)
+            {
+                struct timespec ts;
+                ts.tv_sec = time_t(timeout.count() / 1000000);
+                ts.tv_nsec = long((timeout.count() % 1000000) * 1000);
+
+                // spurious returns are fine, the caller re-checks its work
+                syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&state_),
+                    FUTEX_WAIT_PRIVATE, std::uint32_t(parked), &ts, nullptr, 0);
+            }
+#else
+            std::unique_lock<compat::mutex> l(mtx_);
+            if (state_.load(std::memory_order_acquire) == parked)
+                cond_.wait_for(l, timeout);
+#endif
+        }
+
+        // Mark the worker as running again, must be called by the parked
+        // worker after park() has returned (or if it decided not to park).
+        void finish_park()
+        {
+            state_.store(running, std::memory_order_release);
+        }
+
+        // Wake the worker parked here, if any. Returns whether a parked
+        // worker was found (and has been woken up).
+        bool unpark()
+        {
+            std::uint32_t expected = parked;
+            if (state_.load(std::memory_order_relaxed) != parked ||
+                !state_.compare_exchange_strong(expected, notified))
+            {
+                return false;
+            }
+
+#if defined(HPX_THREADS_PARKING_SPOT_FUTEX)
+            syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&state_),
+                FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+            std::lock_guard<compat::mutex> l(mtx_);
+            cond_.notify_one();
+#endif
+            return true;
+        }
+
+        bool is_parked() const
+        {
+            return state_.load(std::memory_order_relaxed) == parked;
+        }
+
+        // The NUMA node of the worker owning this parking spot is cached
+        // here, std::size_t(-1) if not known yet.
+        std::size_t get_numa_node() const
+        {
+            return numa_node_.load(std::memory_order_relaxed);
+        }
+
+        void set_numa_node(std::size_t numa_node)
+        {
+            numa_node_.store(numa_node, std::memory_order_relaxed);
+        }
+
+    private:
+        enum : std::uint32_t
+        {
+            running = 0,
+            parked = 1,
+            notified = 2
+        };
+
+        static_assert(
+            sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+            "the futex word has to be layout compatible with std::uint32_t");
+
+        std::atomic<std::uint32_t> state_;
+        std::atomic<std::size_t> numa_node_;
+
+#if !defined(HPX_THREADS_PARKING_SPOT_FUTEX)
+        compat::mutex mtx_;
+        compat::condition_variable cond_;
+#endif
+
+        // parking spots of different workers live next to each other,
+        // avoid false sharing
+        char pad_[threads::get_cache_line_size()];
+    };
+}}}
+
+#endif
@@ -16,6 +16,7 @@
 #include <hpx/runtime/threads/policies/callback_notifier.hpp>
 #include <hpx/runtime/threads/policies/scheduler_base.hpp>
 #include <hpx/runtime/threads/thread_pool_base.hpp>
+#include <hpx/runtime/threads/topology.hpp>
 #include <hpx/util/assert.hpp>
 
 #include <atomic>
@@ -77,6 +78,9 @@ namespace hpx { namespace threads { namespace detail
         void create_work(thread_init_data& data,
             thread_state_enum initial_state, error_code& ec) override;
 
+        void create_threads(std::vector<thread_init_data>& data,
+            thread_state_enum initial_state, error_code& ec) override;
+
         thread_state set_state(thread_id_type const& id,
             thread_state_enum new_state, thread_state_ex_enum new_state_ex,
             thread_priority priority, error_code& ec) override;
@@ -217,6 +221,18 @@ namespace hpx { namespace threads { namespace detail
         {
             return sched_->Scheduler::get_num_stolen_to_staged(num, reset);
         }
+
+        std::int64_t get_num_successful_steals(
+            std::size_t num, bool reset) override
+        {
+            return sched_->Scheduler::get_num_successful_steals(num, reset);
+        }
+
+        std::int64_t get_num_failed_steals(
+            std::size_t num, bool reset) override
+        {
+            return sched_->Scheduler::get_num_failed_steals(num, reset);
+        }
 #endif
         std::int64_t get_queue_length(
             std::size_t num_thread, bool reset) override
@@ -264,6 +280,9 @@ namespace hpx { namespace threads { namespace detail
         std::int64_t avg_idle_rate_all(bool reset) override;
         std::int64_t avg_idle_rate(std::size_t, bool) override;
 
+        std::int64_t get_cumulative_exec_time() const override;
+        std::int64_t get_cumulative_tfunc_time() const override;
+
 #if defined(HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES)
         std::int64_t avg_creation_idle_rate(std::size_t, bool) override;
         std::int64_t avg_cleanup_idle_rate(std::size_t, bool) override;
@@ -394,6 +413,9 @@ namespace hpx { namespace threads { namespace detail
 
             // scheduler utilization data
             bool tasks_active_;
+
+            // the data of each worker thread gets its own cache line(s)
+            char cacheline_pad_[threads::get_cache_line_size()];
         };
 
         std::vector<scheduling_counter_data> counter_data_;
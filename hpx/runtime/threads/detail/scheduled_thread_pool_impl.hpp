@@ -399,18 +399,21 @@ namespace hpx { namespace threads { namespace detail
     template <typename Scheduler>
     void scheduled_thread_pool<Scheduler>::suspend_internal(error_code& ec)
     {
+        // The pool is usually suspended right after the last work item has
+        // been scheduled, don't sleep while waiting for it to be finished.
         util::yield_while([this]()
             {
                 return this->sched_->Scheduler::get_thread_count() >
                     this->get_background_thread_count();
             }, "scheduled_thread_pool::suspend_internal",
-            hpx::threads::pending);
+            hpx::threads::pending, false);
 
         for (std::size_t i = 0; i != threads_.size(); ++i)
         {
             hpx::state expected = state_running;
             sched_->Scheduler::get_state(i).compare_exchange_strong(expected,
                  state_pre_sleep);
+            sched_->Scheduler::wake_idle_worker(i);
         }
 
         for (std::size_t i = 0; i != threads_.size(); ++i)
@@ -699,10 +702,40 @@ namespace hpx { namespace threads { namespace detail
 
         detail::create_work(sched_.get(), data, initial_state, ec);    //-V601
 
+        // wake up a possibly sleeping worker thread
+        sched_->Scheduler::do_some_work(data.schedulehint.hint);
+
         // update statistics
         ++tasks_scheduled_;
     }
 
+    template <typename Scheduler>
+    void scheduled_thread_pool<Scheduler>::create_threads(
+        std::vector<thread_init_data>& data, thread_state_enum initial_state,
+        error_code& ec)
+    {
+        // verify state
+        if (thread_count_ == 0 && !sched_->Scheduler::is_state(state_running))
+        {
+            // thread-manager is not currently running
+            HPX_THROWS_IF(ec, invalid_status,
+                "thread_pool<Scheduler>::create_threads",
+                "invalid state: thread pool is not running");
+            return;
+        }
+
+        detail::create_work(sched_.get(), data, initial_state, ec);    //-V601
+
+        // wake up (at most) one sleeping worker thread per new work item
+        std::size_t num_wakeups =
+            (std::min)(data.size(), get_os_thread_count());
+        for (std::size_t i = 0; i != num_wakeups; ++i)
+            sched_->Scheduler::do_some_work(std::size_t(-1));
+
+        // update statistics
+        tasks_scheduled_ += data.size();
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename Scheduler>
     thread_state scheduled_thread_pool<Scheduler>::set_state(
@@ -1576,6 +1609,24 @@ namespace hpx { namespace threads { namespace detail
         return std::int64_t(10000. * percent);    // 0.01 percent
     }
 
+    template <typename Scheduler>
+    std::int64_t
+    scheduled_thread_pool<Scheduler>::get_cumulative_exec_time() const
+    {
+        return accumulate_projected(counter_data_.begin(),
+            counter_data_.end(), std::int64_t(0),
+            &scheduling_counter_data::exec_times_);
+    }
+
+    template <typename Scheduler>
+    std::int64_t
+    scheduled_thread_pool<Scheduler>::get_cumulative_tfunc_time() const
+    {
+        return accumulate_projected(counter_data_.begin(),
+            counter_data_.end(), std::int64_t(0),
+            &scheduling_counter_data::tfunc_times_);
+    }
+
     template <typename Scheduler>
     std::int64_t scheduled_thread_pool<Scheduler>::avg_idle_rate(
         std::size_t num, bool reset)
@@ -1861,11 +1912,14 @@ namespace hpx { namespace threads { namespace detail
         HPX_ASSERT(expected == state_running || expected == state_pre_sleep ||
             expected == state_sleeping);
 
+        // an idle worker notices the new state only once it wakes up
+        sched_->Scheduler::wake_idle_worker(virt_core);
+
         util::yield_while([&state]()
             {
                 return state.load() == state_pre_sleep;
             }, "scheduled_thread_pool::suspend_processing_unit_internal",
-            hpx::threads::pending);
+            hpx::threads::pending, false);
     }
 
     template <typename Scheduler>
@@ -1976,7 +2030,7 @@ namespace hpx { namespace threads { namespace detail
                 this->sched_->Scheduler::resume(virt_core);
                 return state.load() == state_sleeping;
             }, "scheduled_thread_pool::resume_processing_unit_internal",
-            hpx::threads::pending);
+            hpx::threads::pending, false);
     }
 
     template <typename Scheduler>
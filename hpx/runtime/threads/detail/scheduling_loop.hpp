@@ -10,14 +10,24 @@
 #include <hpx/runtime/agas/interface.hpp>
 #include <hpx/runtime/config_entry.hpp>
 #include <hpx/runtime/get_thread_name.hpp>
+#include <hpx/runtime/threads/detail/external_inbox.hpp>
+#include <hpx/runtime/threads/detail/idle_backoff.hpp>
 #include <hpx/runtime/threads/detail/periodic_maintenance.hpp>
+#include <hpx/runtime/threads/detail/time_slice.hpp>
+#include <hpx/runtime/threads/detail/timer_wheel.hpp>
+#include <hpx/runtime/threads/policies/scheduler_base.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/state.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/unique_function.hpp>
 #include <hpx/util/hardware/timestamp.hpp>
 #include <hpx/util/itt_notify.hpp>
+#include <hpx/util/lockfree/epoch.hpp>
 #include <hpx/util/safe_lexical_cast.hpp>
+#include <hpx/util/sampling_profiler.hpp>
+#include <hpx/util/task_graph_profiler.hpp>
+#include <hpx/util/task_hardware_counters.hpp>
+#include <hpx/util/task_tracer.hpp>
 
 #if defined(HPX_HAVE_APEX)
 #include <hpx/util/apex.hpp>
@@ -30,6 +40,19 @@
 #include <memory>
 #include <utility>
 
+#ifdef HPX_HAVE_THREAD_IDLE_RATES
+namespace hpx { namespace threads { namespace policies
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // We control whether to collect idle rates and thread execution times
+    // using this global bool. It will be set by any of the related
+    // performance counters or by the configuration setting
+    // hpx.thread_instrumentation. Once set it stays set, thus no race
+    // conditions will occur.
+    extern HPX_EXPORT bool maintain_idle_rates;
+}}}
+#endif
+
 namespace hpx { namespace threads { namespace detail
 {
     ///////////////////////////////////////////////////////////////////////
@@ -201,12 +224,15 @@ namespace hpx { namespace threads { namespace detail
     };
 
 #ifdef HPX_HAVE_THREAD_IDLE_RATES
+    // The timestamps are taken only once policies::maintain_idle_rates has
+    // been set, the measurements start with the first snapshot after that.
     struct idle_collect_rate
     {
         idle_collect_rate(std::int64_t& tfunc_time, std::int64_t& exec_time)
           : start_timestamp_(util::hardware::timestamp())
           , tfunc_time_(tfunc_time)
           , exec_time_(exec_time)
+          , enabled_(false)
         {}
 
         void collect_exec_time(std::int64_t timestamp)
@@ -215,8 +241,12 @@ namespace hpx { namespace threads { namespace detail
         }
         void take_snapshot()
         {
-            if (tfunc_time_ == std::int64_t(-1))
+            if (!policies::maintain_idle_rates)
+                return;
+
+            if (!enabled_ || tfunc_time_ == std::int64_t(-1))
             {
+                enabled_ = true;
                 start_timestamp_ = util::hardware::timestamp();
                 tfunc_time_ = 0;
                 exec_time_ = 0;
@@ -231,17 +261,20 @@ namespace hpx { namespace threads { namespace detail
 
         std::int64_t& tfunc_time_;
         std::int64_t& exec_time_;
+        bool enabled_;
     };
 
     struct exec_time_wrapper
     {
         exec_time_wrapper(idle_collect_rate& idle_rate)
-          : timestamp_(util::hardware::timestamp())
+          : timestamp_(policies::maintain_idle_rates ?
+                util::hardware::timestamp() : std::int64_t(-1))
           , idle_rate_(idle_rate)
         {}
         ~exec_time_wrapper()
         {
-            idle_rate_.collect_exec_time(timestamp_);
+            if (timestamp_ != std::int64_t(-1))
+                idle_rate_.collect_exec_time(timestamp_);
         }
 
         std::int64_t timestamp_;
@@ -299,14 +332,19 @@ namespace hpx { namespace threads { namespace detail
     {
         background_exec_time_wrapper(
             background_work_duration_counter& background_work_duration)
-          : timestamp_(util::hardware::timestamp())
+          : timestamp_(policies::maintain_idle_rates ?
+                util::hardware::timestamp() : std::int64_t(-1))
           , background_work_duration_(background_work_duration)
         {
         }
 
         ~background_exec_time_wrapper()
         {
-            background_work_duration_.collect_background_exec_time(timestamp_);
+            if (timestamp_ != std::int64_t(-1))
+            {
+                background_work_duration_.collect_background_exec_time(
+                    timestamp_);
+            }
         }
 
         std::int64_t timestamp_;
@@ -314,6 +352,29 @@ namespace hpx { namespace threads { namespace detail
     };
 #endif    // HPX_HAVE_BACKGROUND_THREAD_COUNTERS
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Record a change of the state of the given thread in the task trace
+    inline void record_thread_event(thread_data* thrd, thread_state_enum state)
+    {
+        std::uint64_t id = reinterpret_cast<std::uint64_t>(thrd);
+        if (state == active)
+        {
+            util::tracing::record_event(util::tracing::event_thread_run, id,
+                thrd->get_description(),
+                static_cast<std::uint32_t>(thrd->get_thread_phase()));
+        }
+        else if (state == terminated)
+        {
+            util::tracing::record_event(
+                util::tracing::event_thread_terminate, id, nullptr);
+        }
+        else
+        {
+            util::tracing::record_event(util::tracing::event_thread_suspend,
+                id, nullptr, static_cast<std::uint32_t>(state));
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     struct is_active_wrapper
     {
@@ -413,7 +474,22 @@ namespace hpx { namespace threads { namespace detail
             background_(std::move(background)),
             max_background_threads_(max_background_threads),
             max_idle_loop_count_(max_idle_loop_count),
-            max_busy_loop_count_(max_busy_loop_count)
+            max_busy_loop_count_(max_busy_loop_count),
+            adaptive_idle_backoff_(
+                hpx::util::safe_lexical_cast<int>(
+                    hpx::get_config_entry("hpx.adaptive_idle_backoff", 0)) != 0),
+            max_idle_spin_time_(
+                hpx::util::safe_lexical_cast<std::int64_t>(
+                    hpx::get_config_entry("hpx.max_idle_spin_time", 20))),
+            max_idle_sleep_time_(
+                hpx::util::safe_lexical_cast<std::int64_t>(
+                    hpx::get_config_entry("hpx.max_idle_sleep_time", 1000))),
+            borrow_idle_loop_count_(
+                hpx::util::safe_lexical_cast<std::int64_t>(
+                    hpx::get_config_entry("hpx.borrow_idle_loop_count", 100))),
+            time_slice_(
+                hpx::util::safe_lexical_cast<std::int64_t>(
+                    hpx::get_config_entry("hpx.thread_time_slice", 10000)))
         {}
 
         callback_type outer_;
@@ -422,8 +498,86 @@ namespace hpx { namespace threads { namespace detail
         std::size_t const max_background_threads_;
         std::int64_t const max_idle_loop_count_;
         std::int64_t const max_busy_loop_count_;
+
+        // adaptive spinning and sleeping of idle worker threads
+        bool const adaptive_idle_backoff_;
+        std::int64_t const max_idle_spin_time_;     // [us]
+        std::int64_t const max_idle_sleep_time_;    // [us]
+
+        // number of idle loops after which a worker thread of a borrowing
+        // pool executes threads of the lending pools
+        std::int64_t const borrow_idle_loop_count_;
+
+        // maximal time an HPX thread runs before it yields at its next
+        // preemption point, if the pool uses time slicing
+        std::int64_t const time_slice_;             // [us]
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Execute a thread borrowed from the scheduler of another thread pool,
+    // the thread is rescheduled or destroyed by the scheduler owning it.
+    inline void execute_borrowed_thread(thread_data* thrd,
+        std::int64_t& busy_loop_count)
+    {
+        policies::scheduler_base* owner = thrd->get_scheduler_base();
+
+        thread_state state = thrd->get_state();
+        thread_state_enum state_val = state.state();
+
+        if (HPX_LIKELY(pending == state_val))
+        {
+            thread_data* next_thrd = nullptr;
+            {
+                detail::switch_status thrd_stat(thrd, state);
+                if (HPX_UNLIKELY(!thrd_stat.is_valid() ||
+                        thrd_stat.get_previous() != pending))
+                {
+                    // some other worker-thread started executing this thread
+                    thrd_stat.disable_restore();
+                    return;
+                }
+
+                thrd_stat = (*thrd)();
+
+                // some other worker-thread changed the state of this thread
+                if (HPX_UNLIKELY(!thrd_stat.store_state(state)))
+                    return;
+
+                state_val = state.state();
+                next_thrd = thrd_stat.get_next_thread();
+            }
+
+            // the thread to switch to directly is handed back to its owner
+            if (next_thrd != nullptr && next_thrd != thrd)
+            {
+                next_thrd->get_scheduler_base()->schedule_thread(next_thrd,
+                    threads::thread_schedule_hint(), true,
+                    next_thrd->get_priority());
+            }
+
+            if (HPX_UNLIKELY(state_val == pending))
+            {
+                owner->schedule_thread_last(thrd,
+                    threads::thread_schedule_hint(), true,
+                    thrd->get_priority());
+            }
+            else if (HPX_UNLIKELY(state_val == pending_boost))
+            {
+                thrd->set_state(pending);
+                owner->schedule_thread(thrd, threads::thread_schedule_hint(),
+                    true, thread_priority_boost);
+            }
+        }
+        else if (HPX_UNLIKELY(active == state_val))
+        {
+            owner->schedule_thread(thrd, threads::thread_schedule_hint(),
+                true, thrd->get_priority());
+        }
+
+        if (HPX_LIKELY(state_val == depleted || state_val == terminated))
+            owner->destroy_thread(thrd, busy_loop_count);
+    }
+
     template <typename SchedulingPolicy>
     thread_id_type create_background_thread(SchedulingPolicy& scheduler,
         scheduling_callbacks& callbacks, std::shared_ptr<bool>& background_running,
@@ -584,6 +738,13 @@ namespace hpx { namespace threads { namespace detail
         // spin for some time after queues have become empty
         bool may_exit = false;
 
+        // embedded schedulers have to return to their outer scheduler
+        // instead of going to sleep
+        bool const use_idle_backoff = params.adaptive_idle_backoff_ &&
+            !(scheduler.get_scheduler_mode() & policies::fast_idle_mode);
+        idle_backoff backoff(
+            params.max_idle_spin_time_, params.max_idle_sleep_time_);
+
 #if defined(HPX_HAVE_NETWORKING)
         bool networking_is_enabled = hpx::is_networking_enabled();
 
@@ -623,6 +784,9 @@ namespace hpx { namespace threads { namespace detail
 
                 may_exit = false;
 
+                if (use_idle_backoff)
+                    backoff.on_work();
+
                 // Only pending HPX threads will be executed.
                 // Any non-pending HPX threads are leftovers from a set_state()
                 // call for a previously pending HPX thread (see comments above).
@@ -661,6 +825,43 @@ namespace hpx { namespace threads { namespace detail
                                 // and add to aggregate execution time.
                                 exec_time_wrapper exec_time_collector(idle_rate);
 
+                                // preempt the thread once it has run for
+                                // more than its time slice
+                                time_slice_guard slice(
+                                    scheduler.get_scheduler_mode(),
+                                    params.time_slice_);
+
+                                if (HPX_UNLIKELY(
+                                        util::tracing::tracing_enabled))
+                                {
+                                    record_thread_event(thrd, active);
+                                }
+
+                                if (HPX_UNLIKELY(util::task_counters::
+                                        task_counters_enabled))
+                                {
+                                    util::task_counters::task_started(
+                                        thrd->get_description());
+                                }
+
+                                if (HPX_UNLIKELY(
+                                        util::sampling::sampling_enabled))
+                                {
+                                    util::sampling::task_started(
+                                        thrd->get_description(),
+                                        thrd->get_stack_bounds());
+                                }
+
+#if defined(HPX_HAVE_TASK_GRAPH_PROFILER)
+                                if (HPX_UNLIKELY(util::task_graph::
+                                        profiling_enabled))
+                                {
+                                    util::task_graph::node_started(
+                                        thrd->get_task_graph_info(),
+                                        thrd->get_description());
+                                }
+#endif
+
 
 #if defined(HPX_HAVE_APEX)
                                 // get the APEX data pointer, in case we are resuming the
@@ -687,6 +888,31 @@ namespace hpx { namespace threads { namespace detail
 #else
                                 thrd_stat = (*thrd)();
 #endif
+#if defined(HPX_HAVE_TASK_GRAPH_PROFILER)
+                                if (HPX_UNLIKELY(util::task_graph::
+                                        profiling_enabled))
+                                {
+                                    util::task_graph::node_finished();
+                                }
+#endif
+                                if (HPX_UNLIKELY(
+                                        util::sampling::sampling_enabled))
+                                {
+                                    util::sampling::task_stopped();
+                                }
+
+                                if (HPX_UNLIKELY(util::task_counters::
+                                        task_counters_enabled))
+                                {
+                                    util::task_counters::task_stopped();
+                                }
+
+                                if (HPX_UNLIKELY(
+                                        util::tracing::tracing_enabled))
+                                {
+                                    record_thread_event(thrd,
+                                        thrd_stat.get_previous());
+                                }
                             }
 
 #ifdef HPX_HAVE_THREAD_CUMULATIVE_COUNTS
@@ -824,8 +1050,9 @@ namespace hpx { namespace threads { namespace detail
             {
                 ++idle_loop_count;
 
-                if (scheduler.SchedulingPolicy::wait_or_add_new(
-                        num_thread, running, idle_loop_count))
+                bool no_new_work = scheduler.SchedulingPolicy::wait_or_add_new(
+                    num_thread, running, idle_loop_count);
+                if (no_new_work)
                 {
                     // Clean up terminated threads before trying to exit
                     bool can_exit =
@@ -922,9 +1149,39 @@ namespace hpx { namespace threads { namespace detail
                     }
                 }
 #endif
+                // execute low priority work of the lending pools if this
+                // worker thread has been idle for a while
+                if (running && !may_exit &&
+                    idle_loop_count > params.borrow_idle_loop_count_)
+                {
+                    thread_data* borrowed = nullptr;
+                    if (scheduler.SchedulingPolicy::borrow_thread(
+                            num_thread, borrowed))
+                    {
+                        execute_borrowed_thread(borrowed, busy_loop_count);
+                        no_new_work = false;
+                    }
+                }
+
+                // wake the threads whose timeouts have expired
+                if (timer_wheel::get().poll() != 0)
+                    no_new_work = false;
+
+                // pick up the work submitted by threads outside the runtime
+                if (external_inbox::get().poll(&scheduler, num_thread) != 0)
+                    no_new_work = false;
+
+                // the worker is quiescent, delete the nodes of the lock-free
+                // queues which can't be accessed anymore
+                util::lockfree::collect_retired_nodes();
+
                 // call back into invoking context
                 if (!params.inner_.empty())
                     params.inner_();
+
+                // back off (and possibly sleep) if there is nothing to do
+                if (use_idle_backoff && no_new_work && running)
+                    backoff.on_idle(scheduler, num_thread);
             }
 
             // something went badly wrong, give up
@@ -935,6 +1192,12 @@ namespace hpx { namespace threads { namespace detail
             {
                 busy_loop_count = 0;
 
+                // busy worker threads have to advance the timer wheel, drain
+                // their external inbox and collect retired nodes as well
+                timer_wheel::get().poll();
+                external_inbox::get().poll(&scheduler, num_thread);
+                util::lockfree::collect_retired_nodes();
+
 #if defined(HPX_HAVE_NETWORKING)
                 if (networking_is_enabled)
                 {
@@ -1023,7 +1286,8 @@ namespace hpx { namespace threads { namespace detail
                 }
                 else
                 {
-                    scheduler.SchedulingPolicy::cleanup_terminated(true);
+                    // clean up (some of) the terminated threads while idle
+                    scheduler.SchedulingPolicy::cleanup_terminated(false);
                 }
             }
         }
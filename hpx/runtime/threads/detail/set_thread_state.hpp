@@ -12,6 +12,7 @@
 #include <hpx/runtime/threads/coroutines/coroutine.hpp>
 #include <hpx/runtime/threads/detail/create_thread.hpp>
 #include <hpx/runtime/threads/detail/create_work.hpp>
+#include <hpx/runtime/threads/detail/timer_wheel.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/runtime_fwd.hpp>
@@ -22,6 +23,7 @@
 #include <hpx/util/io_service_pool.hpp>
 #include <hpx/util/logging.hpp>
 #include <hpx/util/steady_clock.hpp>
+#include <hpx/util/task_graph_profiler.hpp>
 
 #include <boost/asio/basic_waitable_timer.hpp>
 
@@ -134,6 +136,17 @@ namespace hpx { namespace threads { namespace detail
             switch (previous_state_val) {
             case active:
                 {
+                    // run-to-completion threads wait in place for being
+                    // resumed, no helper thread is needed
+                    if ((new_state == pending || new_state == pending_boost) &&
+                        thrd->resume_inline(new_state_ex))
+                    {
+                        if (&ec != &throws)
+                            ec = make_success_code();
+
+                        return previous_state;
+                    }
+
                     // schedule a new thread to set the state
                     LTM_(warning)
                         << "set_thread_state: thread is currently active, scheduling "
@@ -236,6 +249,12 @@ namespace hpx { namespace threads { namespace detail
                 previous_state_val == pending_boost) &&
             (new_state == pending || new_state == pending_boost))
         {
+#if defined(HPX_HAVE_TASK_GRAPH_PROFILER)
+            // the woken up thread depends on the one waking it
+            if (HPX_UNLIKELY(util::task_graph::profiling_enabled))
+                util::task_graph::thread_enabled(thrd->get_task_graph_info());
+#endif
+
             // REVIEW: Passing a specific target thread may interfere with the
             // round robin queuing.
 
@@ -384,6 +403,20 @@ namespace hpx { namespace threads { namespace detail
             return invalid_thread_id;
         }
 
+        // the timer wheel does not need a helper thread, however the timeout
+        // can't be cancelled either
+        timer_wheel& wheel = timer_wheel::get();
+        if (wheel.enabled())
+        {
+            wheel.insert_owned(abs_time, thrd, newstate, newstate_ex, priority);
+            if (started != nullptr)
+                started->store(true);
+
+            if (&ec != &throws)
+                ec = make_success_code();
+            return invalid_thread_id;
+        }
+
         // this creates a new thread which creates the timer and handles the
         // requested actions
         thread_init_data data(
@@ -0,0 +1,83 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_DETAIL_TIME_SLICE_HPP)
+#define HPX_RUNTIME_THREADS_DETAIL_TIME_SLICE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/policies/scheduler_mode.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+// The number of iterations the loops of the parallel algorithms execute
+// between two preemption points.
+#if !defined(HPX_THREAD_PREEMPTION_POLL_INTERVAL)
+#define HPX_THREAD_PREEMPTION_POLL_INTERVAL 1024
+#endif
+
+namespace hpx { namespace threads { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Time slices of the HPX threads running on pools which were created with
+    // policies::time_slicing. Before a worker switches to an HPX thread it
+    // sets its deadline, the thread gives up the worker at the next
+    // preemption point after the deadline has passed. Preemption points are
+    // cooperative, they are located in hpx::this_thread::preemption_point and
+    // in the inner loops of the parallel algorithms.
+    //
+    // With policies::time_slice_signal a POSIX timer additionally signals the
+    // expiration of the time slice to the worker. The preemption points then
+    // only read a flag instead of the clock. The thread is never switched
+    // from inside the signal handler, this would not be safe while it holds
+    // a lock or is inside the allocator.
+    static const std::size_t preemption_poll_interval =
+        HPX_THREAD_PREEMPTION_POLL_INTERVAL;
+
+    // Return whether the time slice of the HPX thread running on the calling
+    // worker has expired. This is always false if the caller is not an HPX
+    // thread or if its pool does not use time slicing.
+    HPX_EXPORT bool time_slice_expired();
+
+    // Yield the calling HPX thread if its time slice has expired.
+    HPX_EXPORT void yield_if_time_slice_expired();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Starts the time slice of the HPX thread the scheduling loop is about to
+    // run and ends it once the thread has returned to the scheduling loop.
+    class time_slice_guard
+    {
+    public:
+        time_slice_guard(policies::scheduler_mode mode,
+                std::int64_t time_slice)        // [us]
+          : active_((mode & policies::time_slicing) && time_slice > 0),
+            previous_deadline_(0)
+        {
+            if (HPX_UNLIKELY(active_))
+            {
+                previous_deadline_ = start(time_slice,
+                    (mode & policies::time_slice_signal) != 0);
+            }
+        }
+
+        ~time_slice_guard()
+        {
+            if (HPX_UNLIKELY(active_))
+                stop(previous_deadline_);
+        }
+
+        HPX_NON_COPYABLE(time_slice_guard);
+
+    private:
+        HPX_EXPORT static std::int64_t start(
+            std::int64_t time_slice, bool use_signal);
+        HPX_EXPORT static void stop(std::int64_t previous_deadline);
+
+        bool const active_;
+        std::int64_t previous_deadline_;
+    };
+}}}
+
+#endif
@@ -0,0 +1,169 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_DETAIL_TIMER_WHEEL_HPP)
+#define HPX_RUNTIME_THREADS_DETAIL_TIMER_WHEEL_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/thread_enums.hpp>
+#include <hpx/runtime/threads/thread_id_type.hpp>
+#include <hpx/util/spinlock.hpp>
+#include <hpx/util/steady_clock.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hpx { namespace threads { namespace detail
+{
+    class timer_wheel;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A timeout registered with the timer_wheel. Entries waited for by a
+    // suspended thread usually live on the stack of that thread, they have
+    // to be cancelled before going out of scope (even if they have fired).
+    struct timer_wheel_entry
+    {
+        enum state
+        {
+            state_idle = 0,         // not registered
+            state_queued = 1,       // waiting for its expiration time
+            state_firing = 2,       // removed from the wheel, being fired
+            state_done = 3          // fired or cancelled
+        };
+
+        timer_wheel_entry(thread_id_type const& thrd,
+                thread_state_enum newstate = pending,
+                thread_state_ex_enum newstate_ex = wait_timeout,
+                thread_priority priority = thread_priority_normal)
+          : thrd_(thrd), newstate_(newstate), newstate_ex_(newstate_ex),
+            priority_(priority), owned_(false), expiry_(0), level_(0),
+            slot_(0), prev_(nullptr), next_(nullptr), shard_(nullptr),
+            state_(state_idle)
+        {}
+
+        HPX_NON_COPYABLE(timer_wheel_entry);
+
+        thread_id_type thrd_;
+        thread_state_enum newstate_;
+        thread_state_ex_enum newstate_ex_;
+        thread_priority priority_;
+
+        // owned entries are deleted by the wheel after they have fired,
+        // non-owned entries only wake their thread if it is still suspended
+        bool owned_;
+
+        std::uint64_t expiry_;              // [ticks]
+        std::uint16_t level_;
+        std::uint16_t slot_;
+        timer_wheel_entry* prev_;
+        timer_wheel_entry* next_;
+        void* shard_;
+
+        std::atomic<int> state_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A hierarchical timing wheel (see Varghese and Lauck, "Hashed and
+    // Hierarchical Timing Wheels") holding the timeouts of suspended HPX
+    // threads. Inserting and cancelling a timeout is O(1) and does not
+    // involve the timer pool, the wheel is advanced by the scheduling loops
+    // of the worker threads, which wake the threads whose timeouts expired.
+    //
+    // The wheel consists of four levels of 256 slots each, a timeout is
+    // kept in the finest level which covers its expiration time and is
+    // moved to the next finer level once that level wraps around. The
+    // timeouts are distributed over several shards (selected by the worker
+    // thread registering them) to reduce the contention on the locks.
+    //
+    // The wheel is used if hpx.timer_wheel.enabled is set, the duration of
+    // one tick is given by hpx.timer_wheel.resolution [us]. Timeouts never
+    // fire early, but they may fire late by up to one tick plus the time it
+    // takes for a worker thread to poll the wheel.
+    class HPX_EXPORT timer_wheel
+    {
+    public:
+        HPX_NON_COPYABLE(timer_wheel);
+
+        typedef util::spinlock mutex_type;
+
+        static constexpr std::size_t num_levels = 4;
+        static constexpr std::size_t slot_bits = 8;
+        static constexpr std::size_t num_slots = std::size_t(1) << slot_bits;
+
+    private:
+        struct shard
+        {
+            shard();
+
+            mutex_type mtx_;
+            std::atomic<std::uint64_t> next_tick_;  // next tick to process
+            std::atomic<std::size_t> count_;
+            timer_wheel_entry* slots_[num_levels][num_slots];
+        };
+
+    public:
+        timer_wheel();
+        ~timer_wheel();
+
+        static timer_wheel& get();
+
+        bool enabled() const
+        {
+            return enabled_;
+        }
+
+        // Register the given entry to fire at abs_time, the entry has to
+        // stay alive until it has fired or has been cancelled.
+        void insert(timer_wheel_entry& e,
+            util::steady_time_point const& abs_time);
+
+        // Register a heap allocated entry which is deleted after it fired.
+        void insert_owned(util::steady_time_point const& abs_time,
+            thread_id_type const& thrd, thread_state_enum newstate,
+            thread_state_ex_enum newstate_ex, thread_priority priority);
+
+        // Remove the entry from the wheel, returns false if it has already
+        // fired. If the entry is being fired concurrently this waits for
+        // the firing to complete, afterwards the entry may be destroyed.
+        bool cancel(timer_wheel_entry& e);
+
+        // Fire all expired timeouts, called by the scheduling loops. Returns
+        // the number of threads which have been woken up.
+        std::size_t poll()
+        {
+            if (!enabled_ || count_.load(std::memory_order_relaxed) == 0)
+                return 0;
+            return poll_shards();
+        }
+
+    private:
+        std::uint64_t current_tick() const;
+        std::uint64_t expiry_tick(util::steady_time_point const& abs_time) const;
+
+        shard& get_shard();
+
+        void add(shard& s, timer_wheel_entry& e);
+        void unlink(shard& s, timer_wheel_entry& e);
+        void cascade(shard& s, std::size_t level, std::size_t slot);
+
+        std::size_t poll_shards();
+        std::size_t poll_shard(shard& s, std::uint64_t now);
+        void fire(timer_wheel_entry* e);
+        void requeue(timer_wheel_entry& e);
+
+        bool enabled_;
+        std::int64_t resolution_;               // [ns]
+        util::steady_clock::time_point epoch_;
+
+        // total number of queued entries, allows for a cheap check
+        std::atomic<std::size_t> count_;
+        std::vector<std::unique_ptr<shard> > shards_;
+    };
+}}}
+
+#endif
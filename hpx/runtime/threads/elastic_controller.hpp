@@ -0,0 +1,118 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_RUNTIME_THREADS_ELASTIC_CONTROLLER_HPP
+#define HPX_RUNTIME_THREADS_ELASTIC_CONTROLLER_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/thread_pool_base.hpp>
+#include <hpx/util/interval_timer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hpx { namespace threads
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// The parameters of an \a elastic_controller, by default these are
+    /// read from the configuration section hpx.elasticity.
+    struct HPX_EXPORT elastic_controller_parameters
+    {
+        elastic_controller_parameters();
+
+        /// The time between two evaluations of the load of the pools [ms]
+        std::int64_t interval_;
+
+        /// The number of consecutive evaluations a pool has to be overloaded
+        /// (underloaded) before a processing unit is added (removed)
+        std::size_t hysteresis_;
+
+        /// The minimal number of active worker threads of a pool
+        std::size_t min_threads_;
+
+        /// A pool is overloaded if the number of queued threads per active
+        /// worker thread exceeds this value
+        std::int64_t grow_queue_length_;
+
+        /// A pool is overloaded if its idle rate is below this value and
+        /// underloaded if its idle rate is above shrink_idle_rate_ [0.01%].
+        /// The idle rates are used only if HPX_WITH_THREAD_IDLE_RATES is on.
+        std::int64_t grow_idle_rate_;
+        std::int64_t shrink_idle_rate_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The elastic_controller periodically adjusts the number of active
+    /// worker threads of the given thread pools to their load. The pools
+    /// have to be created with threads::policies::enable_elasticity.
+    ///
+    /// A worker thread is added to an overloaded pool by resuming one of its
+    /// suspended processing units. If that processing unit is shared with
+    /// another controlled pool (see resource::partitioner::add_resource with
+    /// exclusive set to false) which is active on it and not overloaded, it
+    /// is suspended there first, moving the processing unit between the
+    /// pools. A worker thread is removed from an underloaded pool by
+    /// suspending its processing unit, which hands it back to the operating
+    /// system.
+    class HPX_EXPORT elastic_controller
+    {
+    public:
+        HPX_NON_COPYABLE(elastic_controller);
+
+    public:
+        explicit elastic_controller(std::vector<std::string> const& pools,
+            elastic_controller_parameters const& params =
+                elastic_controller_parameters());
+        ~elastic_controller();
+
+        /// Start evaluating the load of the pools periodically
+        bool start();
+
+        /// Stop evaluating the load of the pools
+        bool stop();
+
+        /// Evaluate the load of the pools once and adjust their number of
+        /// active worker threads, this is called periodically once the
+        /// controller has been started. This must not be called
+        /// concurrently. Always returns true.
+        bool evaluate();
+
+    private:
+        struct pool_data
+        {
+            explicit pool_data(thread_pool_base* pool);
+
+            thread_pool_base* pool_;
+            std::int64_t exec_time_;
+            std::int64_t tfunc_time_;
+            std::size_t overloaded_;
+            std::size_t underloaded_;
+        };
+
+        bool is_overloaded(pool_data const& data,
+            std::int64_t idle_rate) const;
+        bool is_underloaded(pool_data const& data,
+            std::int64_t idle_rate) const;
+        std::int64_t get_idle_rate(pool_data& data) const;
+
+        void grow(pool_data& data);
+        void shrink(pool_data& data);
+
+        elastic_controller_parameters params_;
+        std::vector<pool_data> pools_;
+        util::interval_timer timer_;
+    };
+
+    namespace detail
+    {
+        // Start an elastic_controller for the pools listed in
+        // hpx.elasticity.pools once the runtime has been started.
+        void register_elastic_controller();
+    }
+}}
+
+#endif
@@ -38,6 +38,10 @@ namespace hpx { namespace threads { namespace executors
                     thread_priority priority,
                     thread_stacksize stacksize = thread_stacksize_default);
 
+            pool_executor(const std::string& pool_name,
+                    util::steady_clock::duration const& relative_deadline,
+                    thread_stacksize stacksize = thread_stacksize_default);
+
             // Schedule the specified function for execution in this executor.
             // Depending on the subclass implementation, this may block in some
             // situations.
@@ -85,6 +89,10 @@ namespace hpx { namespace threads { namespace executors
             // the scheduler used by this executor
             pool_type& pool_;
 
+            // the deadline of the created threads relative to the point in
+            // time they are added, zero if they have no deadline
+            util::steady_clock::duration relative_deadline_;
+
             // protect scheduler initialization
             typedef compat::mutex mutex_type;
             mutable mutex_type mtx_;
@@ -104,6 +112,14 @@ namespace hpx { namespace threads { namespace executors
         pool_executor(std::string const& pool_name,
                 thread_priority priority,
                 thread_stacksize stacksize = thread_stacksize_default);
+
+        // The threads created by this executor have a deadline of the given
+        // duration after the point in time they were added, they are run in
+        // earliest deadline first order before other threads by the
+        // schedulers supporting deadlines.
+        pool_executor(std::string const& pool_name,
+                util::steady_clock::duration const& relative_deadline,
+                thread_stacksize stacksize = thread_stacksize_default);
     };
 }}}
 
@@ -0,0 +1,36 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_THREADMANAGER_CLEANUP_STATISTICS_HPP)
+#define HPX_THREADMANAGER_CLEANUP_STATISTICS_HPP
+
+#include <hpx/config.hpp>
+
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace threads { namespace policies
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Counters for the cleanup of terminated threads over all thread queues
+    // of this locality. Terminated threads are normally cleaned up by idle
+    // worker threads, a worker thread which terminates a thread while more
+    // than hpx.thread_queue.max_terminated_threads are waiting to be cleaned
+    // up does so itself (forced cleanup).
+    struct cleanup_statistics
+    {
+        // The number of cleaned up thread objects and the time spent doing
+        // so (in nanoseconds).
+        HPX_EXPORT static std::int64_t get_idle_count(bool reset);
+        HPX_EXPORT static std::int64_t get_idle_time(bool reset);
+        HPX_EXPORT static std::int64_t get_forced_count(bool reset);
+        HPX_EXPORT static std::int64_t get_forced_time(bool reset);
+
+        HPX_EXPORT static void record(bool forced, std::int64_t count,
+            std::int64_t time);
+    };
+}}}
+
+#endif
@@ -0,0 +1,128 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_POLICIES_DEADLINE_QUEUE_HPP)
+#define HPX_RUNTIME_THREADS_POLICIES_DEADLINE_QUEUE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/util/steady_clock.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace hpx { namespace threads { namespace policies
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Holds the pending HPX threads having a deadline, ordered by their
+    // deadlines. The deadline of each thread is recorded when it is pushed,
+    // later changes of the deadline of a queued thread take effect the next
+    // time it is scheduled. The earliest deadline can be queried without
+    // locking, which allows a worker thread to pick the queue holding the
+    // most urgent thread.
+    template <typename Mutex>
+    class deadline_queue
+    {
+        typedef Mutex mutex_type;
+
+        struct entry
+        {
+            std::int64_t deadline_;
+            threads::thread_data* thrd_;
+
+            // std::push_heap creates a max heap, the earliest deadline has
+            // to be on top
+            friend bool operator<(entry const& lhs, entry const& rhs)
+            {
+                return lhs.deadline_ > rhs.deadline_;
+            }
+        };
+
+    public:
+        // the value returned by earliest() for an empty queue
+        static constexpr std::int64_t no_deadline =
+            (std::numeric_limits<std::int64_t>::max)();
+
+        deadline_queue()
+          : earliest_(no_deadline)
+        {}
+
+        deadline_queue(deadline_queue const&) = delete;
+        deadline_queue& operator=(deadline_queue const&) = delete;
+
+        static std::int64_t get_deadline(
+            util::steady_clock::time_point const& deadline)
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                deadline.time_since_epoch()).count();
+        }
+
+        void push(threads::thread_data* thrd,
+            util::steady_clock::time_point const& deadline)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            heap_.push_back(entry{get_deadline(deadline), thrd});
+            std::push_heap(heap_.begin(), heap_.end());
+            earliest_.store(heap_.front().deadline_,
+                std::memory_order_relaxed);
+        }
+
+        // Take the thread with the earliest deadline.
+        bool pop(threads::thread_data*& thrd)
+        {
+            if (empty())
+                return false;
+
+            std::lock_guard<mutex_type> l(mtx_);
+            if (heap_.empty())
+                return false;
+
+            std::pop_heap(heap_.begin(), heap_.end());
+            thrd = heap_.back().thrd_;
+            heap_.pop_back();
+            earliest_.store(heap_.empty() ? no_deadline :
+                heap_.front().deadline_, std::memory_order_relaxed);
+            return true;
+        }
+
+        // Return the earliest deadline of the queued threads [ns], or
+        // no_deadline if the queue is empty.
+        std::int64_t earliest() const
+        {
+            return earliest_.load(std::memory_order_relaxed);
+        }
+
+        bool empty() const
+        {
+            return earliest() == no_deadline;
+        }
+
+        std::size_t size() const
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            return heap_.size();
+        }
+
+    private:
+        mutable mutex_type mtx_;
+        std::vector<entry> heap_;
+        std::atomic<std::int64_t> earliest_;
+
+        // the queues of all worker threads are stored next to each other
+        char pad_[threads::get_cache_line_size()];
+    };
+
+    template <typename Mutex>
+    constexpr std::int64_t deadline_queue<Mutex>::no_deadline;
+}}}
+
+#endif
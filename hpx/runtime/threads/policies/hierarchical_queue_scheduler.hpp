@@ -0,0 +1,426 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_THREADMANAGER_SCHEDULING_HIERARCHICAL_QUEUE_HPP)
+#define HPX_THREADMANAGER_SCHEDULING_HIERARCHICAL_QUEUE_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_HIERARCHICAL_SCHEDULER)
+#include <hpx/compat/mutex.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/resource/detail/partitioner.hpp>
+#include <hpx/runtime/threads/cpu_mask.hpp>
+#include <hpx/runtime/threads/policies/local_priority_queue_scheduler.hpp>
+#include <hpx/runtime/threads/policies/lockfree_queue_backends.hpp>
+#include <hpx/runtime/threads/thread_data.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/runtime/threads_fwd.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/logging.hpp>
+
+#include <boost/lexical_cast.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace threads { namespace policies
+{
+    namespace detail
+    {
+        inline std::size_t get_steal_level_backoff()
+        {
+            static std::size_t steal_level_backoff =
+                boost::lexical_cast<std::size_t>(hpx::get_config_entry(
+                    "hpx.thread_queue.steal_level_backoff", "2"));
+            return steal_level_backoff;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The hierarchical_queue_scheduler maintains the same queues as the
+    /// local_priority_queue_scheduler, but steals work strictly in the order
+    /// of the machine topology: first from the SMT siblings sharing the same
+    /// core, then from the cores sharing a cache (L2 or L3), then from the
+    /// remaining cores of the same NUMA domain, then from the remaining NUMA
+    /// domains of the same socket, and finally from remote sockets.
+    /// A worker thread is allowed to steal from the next level only after
+    /// an exponentially growing number of consecutive unsuccessful attempts
+    /// on the closer levels (see hpx.thread_queue.steal_level_backoff).
+    template <typename Mutex = compat::mutex,
+        typename PendingQueuing = lockfree_fifo,
+        typename StagedQueuing = lockfree_fifo,
+        typename TerminatedQueuing = lockfree_lifo>
+    class HPX_EXPORT hierarchical_queue_scheduler
+        : public local_priority_queue_scheduler<
+            Mutex, PendingQueuing, StagedQueuing, TerminatedQueuing
+          >
+    {
+    public:
+        typedef local_priority_queue_scheduler<
+            Mutex, PendingQueuing, StagedQueuing, TerminatedQueuing
+        > base_type;
+
+        typedef typename base_type::thread_queue_type thread_queue_type;
+        typedef typename base_type::init_parameter_type
+            init_parameter_type;
+
+        // the levels of the topology stealing is performed from
+        enum steal_level
+        {
+            steal_core = 0,         // SMT siblings
+            steal_cache = 1,        // cores sharing a cache
+            steal_numa_node = 2,    // same NUMA domain
+            steal_socket = 3,       // same socket
+            steal_remote = 4,       // other sockets
+            num_steal_levels = 5
+        };
+
+    private:
+        // per worker state, only accessed by the owning worker thread
+        struct steal_state
+        {
+            steal_state()
+              : failed_steals_(0)
+            {}
+
+            std::size_t failed_steals_;
+
+            // make sure no two workers share a cache line
+            char cacheline_pad_[threads::get_cache_line_size()];
+        };
+
+        static std::size_t adjust_backoff(std::size_t backoff)
+        {
+            // make sure the thresholds below fit into a std::size_t
+            return backoff > 12 ? 12 : backoff;
+        }
+
+    public:
+        hierarchical_queue_scheduler(init_parameter_type const& init,
+                bool deferred_initialization = true)
+          : base_type(init, deferred_initialization),
+            victim_levels_(init.num_queues_),
+            steal_states_(init.num_queues_),
+            backoff_(adjust_backoff(detail::get_steal_level_backoff()))
+        {}
+
+        static std::string get_scheduler_name()
+        {
+            return "hierarchical_queue_scheduler";
+        }
+
+        /// Return the number of consecutive unsuccessful stealing attempts
+        /// after which the given level may be used.
+        std::size_t get_steal_threshold(std::size_t level) const
+        {
+            return (std::size_t(1) << (level * backoff_)) - 1;
+        }
+
+        /// Return the most distant level the given worker thread is
+        /// currently allowed to steal from.
+        std::size_t get_max_steal_level(std::size_t num_thread) const
+        {
+            std::size_t failed = steal_states_[num_thread].failed_steals_;
+
+            std::size_t level = steal_core;
+            while (level + 1 != num_steal_levels &&
+                failed >= get_steal_threshold(level + 1))
+            {
+                ++level;
+            }
+            return level;
+        }
+
+        /// Return the next thread to be executed, return false if none is
+        /// available
+        bool get_next_thread(std::size_t num_thread, bool running,
+            std::int64_t& idle_loop_count, threads::thread_data*& thrd) override
+        {
+            std::size_t queues_size = this->queues_.size();
+            std::size_t high_priority_queues =
+                this->high_priority_queues_.size();
+
+            HPX_ASSERT(num_thread < queues_size);
+            thread_queue_type* this_high_priority_queue = nullptr;
+            thread_queue_type* this_queue = this->queues_[num_thread];
+
+            if (num_thread < high_priority_queues)
+            {
+                this_high_priority_queue =
+                    this->high_priority_queues_[num_thread];
+                bool result =
+                    this_high_priority_queue->get_next_thread(thrd);
+
+                this_high_priority_queue->increment_num_pending_accesses();
+                if (result)
+                {
+                    steal_states_[num_thread].failed_steals_ = 0;
+                    return true;
+                }
+                this_high_priority_queue->increment_num_pending_misses();
+            }
+
+            {
+                bool result = this_queue->get_next_thread(thrd);
+
+                this_queue->increment_num_pending_accesses();
+                if (result)
+                {
+                    steal_states_[num_thread].failed_steals_ = 0;
+                    return true;
+                }
+                this_queue->increment_num_pending_misses();
+
+                bool have_staged = this_queue->
+                    get_staged_queue_length(std::memory_order_relaxed) != 0;
+
+                // Give up, we should have work to convert.
+                if (have_staged)
+                    return false;
+            }
+
+            if (!running)
+            {
+                return false;
+            }
+
+            std::size_t max_level = get_max_steal_level(num_thread);
+            for (std::size_t level = 0; level <= max_level; ++level)
+            {
+                for (std::size_t idx: victim_levels_[num_thread][level])
+                {
+                    HPX_ASSERT(idx != num_thread);
+
+                    if (idx < high_priority_queues &&
+                        num_thread < high_priority_queues)
+                    {
+                        thread_queue_type* q = this->high_priority_queues_[idx];
+                        if (q->get_next_thread(thrd, running))
+                        {
+                            q->increment_num_stolen_from_pending();
+                            this_high_priority_queue->
+                                increment_num_stolen_to_pending();
+                            steal_states_[num_thread].failed_steals_ = 0;
+                            return true;
+                        }
+                    }
+
+                    thread_queue_type* q = this->queues_[idx];
+                    if (q->get_next_thread(thrd, running))
+                    {
+                        q->increment_num_stolen_from_pending();
+                        this_queue->increment_num_stolen_to_pending();
+                        steal_states_[num_thread].failed_steals_ = 0;
+                        return true;
+                    }
+                }
+            }
+
+            return this->low_priority_queue_.get_next_thread(thrd);
+        }
+
+        /// This is a function which gets called periodically by the thread
+        /// manager to allow for maintenance tasks to be executed in the
+        /// scheduler. Returns true if the OS thread calling this function
+        /// has to be terminated (i.e. no more work has to be done).
+        bool wait_or_add_new(std::size_t num_thread, bool running,
+            std::int64_t& idle_loop_count) override
+        {
+            std::size_t added = 0;
+            bool result = true;
+
+            std::size_t high_priority_queues =
+                this->high_priority_queues_.size();
+            thread_queue_type* this_high_priority_queue = nullptr;
+            thread_queue_type* this_queue = this->queues_[num_thread];
+
+            if (num_thread < high_priority_queues)
+            {
+                this_high_priority_queue =
+                    this->high_priority_queues_[num_thread];
+                result = this_high_priority_queue->wait_or_add_new(running,
+                            idle_loop_count, added)
+                        && result;
+                if (0 != added) return result;
+            }
+
+            result = this_queue->wait_or_add_new(
+                running, idle_loop_count, added) && result;
+            if (0 != added) return result;
+
+            // Check if we have been disabled
+            if (!running)
+            {
+                return true;
+            }
+
+            steal_state& state = steal_states_[num_thread];
+
+            std::size_t max_level = get_max_steal_level(num_thread);
+            for (std::size_t level = 0; level <= max_level; ++level)
+            {
+                for (std::size_t idx: victim_levels_[num_thread][level])
+                {
+                    HPX_ASSERT(idx != num_thread);
+
+                    if (idx < high_priority_queues &&
+                        num_thread < high_priority_queues)
+                    {
+                        thread_queue_type* q = this->high_priority_queues_[idx];
+                        result = this_high_priority_queue->
+                            wait_or_add_new(running, idle_loop_count,
+                                added, q)
+                          && result;
+
+                        if (0 != added)
+                        {
+                            q->increment_num_stolen_from_staged(added);
+                            this_high_priority_queue->
+                                increment_num_stolen_to_staged(added);
+                            state.failed_steals_ = 0;
+                            return result;
+                        }
+                    }
+
+                    thread_queue_type* q = this->queues_[idx];
+                    result = this_queue->wait_or_add_new(running,
+                        idle_loop_count, added, q) && result;
+                    if (0 != added)
+                    {
+                        q->increment_num_stolen_from_staged(added);
+                        this_queue->increment_num_stolen_to_staged(added);
+                        state.failed_steals_ = 0;
+                        return result;
+                    }
+                }
+            }
+
+            // nothing could be stolen, back off before moving on to the
+            // next level
+            if (state.failed_steals_ <
+                get_steal_threshold(num_steal_levels - 1))
+            {
+                ++state.failed_steals_;
+            }
+
+#ifdef HPX_HAVE_THREAD_MINIMAL_DEADLOCK_DETECTION
+            // no new work is available, are we deadlocked?
+            if (HPX_UNLIKELY(minimal_deadlock_detection && LHPX_ENABLED(error)))
+            {
+                bool suspended_only = true;
+
+                for (std::size_t i = 0;
+                     suspended_only && i != this->queues_.size(); ++i)
+                {
+                    suspended_only = this->queues_[i]->dump_suspended_threads(
+                        i, idle_loop_count, running);
+                }
+
+                if (HPX_UNLIKELY(suspended_only)) {
+                    if (running) {
+                        LTM_(error) //-V128
+                            << "queue(" << num_thread << "): "
+                            << "no new work available, are we deadlocked?";
+                    }
+                    else {
+                        LHPX_CONSOLE_(hpx::util::logging::level::error) //-V128
+                              << "  [TM] queue(" << num_thread << "): "
+                              << "no new work available, are we deadlocked?\n";
+                    }
+                }
+            }
+#endif
+
+            result = this->low_priority_queue_.wait_or_add_new(running,
+                idle_loop_count, added) && result;
+
+            return result;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void on_start_thread(std::size_t num_thread) override
+        {
+            base_type::on_start_thread(num_thread);
+
+            std::size_t num_threads = this->queues_.size();
+            auto const& topo = this->rp_.get_topology();
+
+            // get the topology masks of all queues...
+            std::vector<mask_type> core_masks(num_threads);
+            std::vector<mask_type> cache_masks(num_threads);
+            std::vector<mask_type> numa_masks(num_threads);
+            std::vector<mask_type> socket_masks(num_threads);
+            for (std::size_t i = 0; i != num_threads; ++i)
+            {
+                std::size_t num_pu = this->rp_.get_pu_num(
+                    this->local_to_global_thread_index(i));
+                core_masks[i] = topo.get_core_affinity_mask(num_pu);
+                cache_masks[i] = topo.get_cache_affinity_mask(num_pu);
+                numa_masks[i] = topo.get_numa_node_affinity_mask(num_pu);
+                socket_masks[i] = topo.get_socket_affinity_mask(num_pu);
+            }
+
+            mask_cref_type core_mask = core_masks[num_thread];
+            mask_cref_type cache_mask = cache_masks[num_thread];
+            mask_cref_type numa_mask = numa_masks[num_thread];
+            mask_cref_type socket_mask = socket_masks[num_thread];
+
+            std::vector<std::vector<std::size_t> >& levels =
+                victim_levels_[num_thread];
+            levels.clear();
+            levels.resize(num_steal_levels);
+
+            // check our neighbors in a radial fashion (left and right
+            // alternating, increasing distance each iteration), each of them
+            // is assigned to the closest level it shares with this thread
+            for (std::size_t i = 1; i <= num_threads / 2; ++i)
+            {
+                std::size_t left = (num_thread + num_threads - i) % num_threads;
+                std::size_t right = (num_thread + i) % num_threads;
+
+                for (std::size_t other : { left, right })
+                {
+                    std::size_t level = steal_remote;
+                    if (any(core_mask & core_masks[other]))
+                        level = steal_core;
+                    else if (any(cache_mask & cache_masks[other]))
+                        level = steal_cache;
+                    else if (any(numa_mask & numa_masks[other]))
+                        level = steal_numa_node;
+                    else if (any(socket_mask & socket_masks[other]))
+                        level = steal_socket;
+
+                    // honor --hpx:numa-sensitive=2, i.e. never steal
+                    // across NUMA domains
+                    if (level > steal_numa_node && this->numa_sensitive_ == 2)
+                        continue;
+
+                    levels[level].push_back(other);
+
+                    if (left == right)
+                        break;
+                }
+            }
+        }
+
+    protected:
+        // victim threads for each worker thread, grouped by steal level
+        std::vector<std::vector<std::vector<std::size_t> > > victim_levels_;
+        std::vector<steal_state> steal_states_;
+        std::size_t const backoff_;
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
+#endif
@@ -9,7 +9,10 @@
 
 #include <hpx/config.hpp>
 #include <hpx/compat/mutex.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/runtime/threads/policies/deadline_queue.hpp>
 #include <hpx/runtime/threads/policies/lockfree_queue_backends.hpp>
+#include <hpx/runtime/threads/policies/run_next_slot.hpp>
 #include <hpx/runtime/threads/policies/scheduler_base.hpp>
 #include <hpx/runtime/threads/policies/thread_queue.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
@@ -20,6 +23,7 @@
 #include <hpx/util/logging.hpp>
 #include <hpx/util_fwd.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
@@ -53,6 +57,9 @@ namespace hpx { namespace threads { namespace policies
     /// High priority threads are executed by the first N OS threads before any
     /// other work is executed. Low priority threads are executed by the last
     /// OS thread whenever no other work is available.
+    /// Threads having a deadline are kept in one deadline_queue per OS thread
+    /// and are executed in earliest deadline first order (over all queues)
+    /// before any other work.
     template <typename Mutex = compat::mutex,
         typename PendingQueuing = lockfree_fifo,
         typename StagedQueuing = lockfree_fifo,
@@ -128,11 +135,20 @@ namespace hpx { namespace threads { namespace policies
             low_priority_queue_(init.max_queue_thread_count_),
             curr_queue_(0),
             numa_sensitive_(init.numa_sensitive_),
+            numa_domains_(init.num_queues_),
+            run_next_slots_(init.num_queues_),
+            use_run_next_(detail::get_run_next_slot()),
+            run_next_steal_delay_(detail::get_run_next_steal_delay()),
+            deadline_queues_(init.num_queues_),
+            num_deadline_threads_(0),
             rp_(resource::get_partitioner())
         {
             victim_threads_.clear();
             victim_threads_.resize(init.num_queues_);
 
+            for (std::size_t i = 0; i != init.num_queues_; ++i)
+                numa_domains_[i].store(std::size_t(-1));
+
             if (!deferred_initialization)
             {
 #if defined(HPX_MSVC)
@@ -474,10 +490,15 @@ namespace hpx { namespace threads { namespace policies
         void create_thread(thread_init_data& data, thread_id_type* id,
             thread_state_enum initial_state, bool run_now, error_code& ec) override
         {
-            // NOTE: This scheduler ignores NUMA hints.
-            std::size_t num_thread =
-                data.schedulehint.mode == thread_schedule_hint_mode_thread ?
-                data.schedulehint.hint : std::size_t(-1);
+            std::size_t num_thread = std::size_t(-1);
+            if (data.schedulehint.mode == thread_schedule_hint_mode_thread)
+            {
+                num_thread = data.schedulehint.hint;
+            }
+            else if (data.schedulehint.mode == thread_schedule_hint_mode_numa)
+            {
+                num_thread = select_numa_thread(data.schedulehint.hint);
+            }
 #ifdef HPX_HAVE_THREAD_TARGET_ADDRESS
 //             // try to figure out the NUMA node where the data lives
 //             if (numa_sensitive_ && std::size_t(-1) == num_thread) {
@@ -502,6 +523,27 @@ namespace hpx { namespace threads { namespace policies
             std::unique_lock<pu_mutex_type> l;
             num_thread = select_active_pu(l, num_thread);
 
+            // Threads having a deadline are created right away, as the
+            // staged queues are not ordered by deadline.
+            if (data.deadline != (util::steady_clock::time_point::max)() &&
+                (initial_state == pending || initial_state == pending_boost))
+            {
+                if (data.priority == thread_priority_boost)
+                {
+                    data.priority = thread_priority_normal;
+                }
+
+                thread_id_type thrd;
+                queues_[num_thread]->create_thread(data, &thrd,
+                    pending_do_not_schedule, true, ec);
+                if (&ec != &throws && ec)
+                    return;
+
+                push_deadline_thread(num_thread, thrd.get());
+                if (id) *id = thrd;
+                return;
+            }
+
             // now create the thread
             if (data.priority == thread_priority_high_recursive ||
                 data.priority == thread_priority_high ||
@@ -530,6 +572,52 @@ namespace hpx { namespace threads { namespace policies
                 run_now, ec);
         }
 
+        /// Create a batch of task descriptions. Normal priority tasks without
+        /// any scheduling hint are split into contiguous chunks, one for
+        /// each of the queues, all other tasks are created one by one.
+        void create_threads(std::vector<thread_init_data>& data,
+            thread_state_enum initial_state, error_code& ec) override
+        {
+            bool can_split = std::all_of(data.begin(), data.end(),
+                [](thread_init_data const& d)
+                {
+                    return d.priority == thread_priority_normal &&
+                        d.schedulehint.mode == thread_schedule_hint_mode_none &&
+                        d.deadline == (util::steady_clock::time_point::max)();
+                });
+
+            if (!can_split)
+            {
+                scheduler_base::create_threads(data, initial_state, ec);
+                return;
+            }
+
+            std::size_t queue_size = queues_.size();
+            std::size_t count = data.size();
+            std::size_t num_chunks = (std::min)(count, queue_size);
+
+            // start with the next queue in round-robin order, this also
+            // spreads small batches over all queues
+            std::size_t first_queue = curr_queue_.fetch_add(num_chunks);
+
+            std::size_t begin = 0;
+            for (std::size_t i = 0; i != num_chunks; ++i)
+            {
+                std::size_t end = (count * (i + 1)) / num_chunks;
+
+                std::unique_lock<pu_mutex_type> l;
+                std::size_t num_thread =
+                    select_active_pu(l, (first_queue + i) % queue_size);
+
+                queues_[num_thread]->create_threads(
+                    data.data() + begin, end - begin, initial_state, ec);
+                if (&ec != &throws && ec)
+                    return;
+
+                begin = end;
+            }
+        }
+
         /// Return the next thread to be executed, return false if none is
         /// available
         bool get_next_thread(std::size_t num_thread, bool running,
@@ -542,6 +630,12 @@ namespace hpx { namespace threads { namespace policies
             thread_queue_type* this_high_priority_queue = nullptr;
             thread_queue_type* this_queue = queues_[num_thread];
 
+            if (num_deadline_threads_.load(std::memory_order_relaxed) != 0 &&
+                pop_deadline_thread(num_thread, running, thrd))
+            {
+                return true;
+            }
+
             if (num_thread < high_priority_queues)
             {
                 this_high_priority_queue = high_priority_queues_[num_thread];
@@ -554,6 +648,10 @@ namespace hpx { namespace threads { namespace policies
                 this_high_priority_queue->increment_num_pending_misses();
             }
 
+            // the thread most recently made ready by this worker runs next
+            if (use_run_next_ && run_next_slots_[num_thread].pop(thrd))
+                return true;
+
             {
                 bool result = this_queue->get_next_thread(thrd);
 
@@ -598,18 +696,63 @@ namespace hpx { namespace threads { namespace policies
                     this_queue->increment_num_stolen_to_pending();
                     return true;
                 }
+
+                if (use_run_next_ &&
+                    run_next_slots_[idx].steal(thrd, run_next_steal_delay_))
+                {
+                    queues_[idx]->increment_num_stolen_from_pending();
+                    this_queue->increment_num_stolen_to_pending();
+                    return true;
+                }
             }
 
             return low_priority_queue_.get_next_thread(thrd);
         }
 
+        /// Return a low priority thread to be executed by a worker thread of
+        /// another pool
+        bool lend_thread(threads::thread_data*& thrd) override
+        {
+            if (low_priority_queue_.get_next_thread(thrd))
+                return true;
+
+            // the worker threads of this pool might be too busy to convert
+            // the staged low priority tasks into threads
+            std::int64_t idle_loop_count = 0;
+            std::size_t added = 0;
+            low_priority_queue_.wait_or_add_new(true, idle_loop_count, added);
+            return added != 0 && low_priority_queue_.get_next_thread(thrd);
+        }
+
         /// Schedule the passed thread
         void schedule_thread(threads::thread_data* thrd,
             threads::thread_schedule_hint schedulehint,
             bool allow_fallback = false,
             thread_priority priority = thread_priority_normal) override
         {
-            // NOTE: This scheduler ignores NUMA hints.
+            bool const high_priority =
+                priority == thread_priority_high_recursive ||
+                priority == thread_priority_high ||
+                priority == thread_priority_boost;
+            bool const has_deadline = thrd->has_deadline();
+
+            // A normal priority thread made ready without a hint by one of
+            // our worker threads is run next by that worker, the thread it
+            // displaces from the run-next slot is queued instead.
+            if (use_run_next_ && !high_priority && !has_deadline &&
+                priority != thread_priority_low &&
+                schedulehint.mode == thread_schedule_hint_mode_none)
+            {
+                std::size_t self =
+                    global_to_local_thread_index(hpx::get_worker_thread_num());
+                if (self < run_next_slots_.size())
+                {
+                    thrd = run_next_slots_[self].push(thrd);
+                    if (thrd == nullptr)
+                        return;
+                }
+            }
+
             std::size_t num_thread = std::size_t(-1);
             if (schedulehint.mode == thread_schedule_hint_mode_thread)
             {
@@ -617,6 +760,8 @@ namespace hpx { namespace threads { namespace policies
             }
             else
             {
+                if (schedulehint.mode == thread_schedule_hint_mode_numa)
+                    num_thread = select_numa_thread(schedulehint.hint);
                 allow_fallback = false;
             }
 
@@ -634,9 +779,11 @@ namespace hpx { namespace threads { namespace policies
             std::unique_lock<pu_mutex_type> l;
             num_thread = select_active_pu(l, num_thread, allow_fallback);
 
-            if (priority == thread_priority_high_recursive ||
-                priority == thread_priority_high ||
-                priority == thread_priority_boost)
+            if (thrd->has_deadline())
+            {
+                push_deadline_thread(num_thread, thrd);
+            }
+            else if (high_priority)
             {
                 std::size_t num = num_thread % high_priority_queues_.size();
                 high_priority_queues_[num]->schedule_thread(thrd);
@@ -657,7 +804,6 @@ namespace hpx { namespace threads { namespace policies
             bool allow_fallback = false,
             thread_priority priority = thread_priority_normal) override
         {
-            // NOTE: This scheduler ignores NUMA hints.
             std::size_t num_thread = std::size_t(-1);
             if (schedulehint.mode == thread_schedule_hint_mode_thread)
             {
@@ -665,6 +811,8 @@ namespace hpx { namespace threads { namespace policies
             }
             else
             {
+                if (schedulehint.mode == thread_schedule_hint_mode_numa)
+                    num_thread = select_numa_thread(schedulehint.hint);
                 allow_fallback = false;
             }
 
@@ -682,7 +830,11 @@ namespace hpx { namespace threads { namespace policies
             std::unique_lock<pu_mutex_type> l;
             num_thread = select_active_pu(l, num_thread, allow_fallback);
 
-            if (priority == thread_priority_high_recursive ||
+            if (thrd->has_deadline())
+            {
+                push_deadline_thread(num_thread, thrd);
+            }
+            else if (priority == thread_priority_high_recursive ||
                 priority == thread_priority_high ||
                 priority == thread_priority_boost)
             {
@@ -724,6 +876,11 @@ namespace hpx { namespace threads { namespace policies
                 if (num_thread == queues_.size()-1)
                     count += low_priority_queue_.get_queue_length();
 
+                if (!run_next_slots_[num_thread].empty())
+                    ++count;
+
+                count += std::int64_t(deadline_queues_[num_thread].size());
+
                 return count + queues_[num_thread]->get_queue_length();
             }
 
@@ -734,9 +891,13 @@ namespace hpx { namespace threads { namespace policies
             count += low_priority_queue_.get_queue_length();
 
             for (std::size_t i = 0; i != queues_.size(); ++i)
+            {
                 count += queues_[i]->get_queue_length();
+                if (!run_next_slots_[i].empty())
+                    ++count;
+            }
 
-            return count;
+            return count + num_deadline_threads_.load(std::memory_order_relaxed);
         }
 
         ///////////////////////////////////////////////////////////////////////
@@ -971,6 +1132,10 @@ namespace hpx { namespace threads { namespace policies
         bool wait_or_add_new(std::size_t num_thread, bool running,
             std::int64_t& idle_loop_count) override
         {
+            // the thread in the run-next slot has to be run first
+            if (use_run_next_ && !run_next_slots_[num_thread].empty())
+                return false;
+
             std::size_t added = 0;
             bool result = true;
 
@@ -1112,6 +1277,9 @@ namespace hpx { namespace threads { namespace policies
 
             std::size_t num_pu = rp_.get_affinity_data().get_pu_num(num_thread);
             mask_cref_type pu_mask = topo.get_thread_affinity_mask(num_pu);
+
+            numa_domains_[num_thread].store(
+                topo.get_numa_node_number(num_pu), std::memory_order_relaxed);
             mask_cref_type numa_mask = numa_masks[num_thread];
             mask_cref_type core_mask = core_masks[num_thread];
 
@@ -1215,6 +1383,66 @@ namespace hpx { namespace threads { namespace policies
             curr_queue_.store(0);
         }
 
+    protected:
+        void push_deadline_thread(std::size_t num_thread,
+            threads::thread_data* thrd)
+        {
+            HPX_ASSERT(num_thread < deadline_queues_.size());
+            ++num_deadline_threads_;
+            deadline_queues_[num_thread].push(thrd, thrd->get_deadline());
+        }
+
+        // Take the thread with the earliest deadline queued for this worker
+        // thread or, if running, for one of its victims.
+        bool pop_deadline_thread(std::size_t num_thread, bool running,
+            threads::thread_data*& thrd)
+        {
+            std::size_t best = num_thread;
+            std::int64_t earliest = deadline_queues_[num_thread].earliest();
+
+            if (running)
+            {
+                for (std::size_t idx : victim_threads_[num_thread])
+                {
+                    std::int64_t deadline = deadline_queues_[idx].earliest();
+                    if (deadline < earliest)
+                    {
+                        earliest = deadline;
+                        best = idx;
+                    }
+                }
+            }
+
+            if (!deadline_queues_[best].pop(thrd))
+                return false;
+
+            --num_deadline_threads_;
+            if (best != num_thread)
+            {
+                queues_[best]->increment_num_stolen_from_pending();
+                queues_[num_thread]->increment_num_stolen_to_pending();
+            }
+            return true;
+        }
+
+        // Select one of the worker threads running on the given NUMA domain
+        // (round robin), returns std::size_t(-1) if there is none.
+        std::size_t select_numa_thread(std::size_t domain)
+        {
+            std::size_t queue_size = queues_.size();
+            std::size_t first = curr_queue_++;
+            for (std::size_t i = 0; i != queue_size; ++i)
+            {
+                std::size_t num_thread = (first + i) % queue_size;
+                if (numa_domains_[num_thread].load(
+                        std::memory_order_relaxed) == domain)
+                {
+                    return num_thread;
+                }
+            }
+            return std::size_t(-1);
+        }
+
     protected:
         std::size_t max_queue_thread_count_;
         std::vector<thread_queue_type*> queues_;
@@ -1225,6 +1453,19 @@ namespace hpx { namespace threads { namespace policies
 
         std::vector<std::vector<std::size_t> > victim_threads_;
 
+        // the NUMA domain of each worker thread, std::size_t(-1) until the
+        // worker has been started
+        std::vector<std::atomic<std::size_t> > numa_domains_;
+
+        // the threads to run next, one per worker (see run_next_slot)
+        std::vector<run_next_slot> run_next_slots_;
+        bool const use_run_next_;
+        std::uint64_t const run_next_steal_delay_;
+
+        // the pending threads having a deadline, one queue per worker
+        std::vector<deadline_queue<Mutex> > deadline_queues_;
+        std::atomic<std::int64_t> num_deadline_threads_;
+
         resource::detail::partitioner& rp_;
     };
 }}}
@@ -11,6 +11,7 @@
 
 #if defined(HPX_HAVE_LOCAL_SCHEDULER)
 #include <hpx/compat/mutex.hpp>
+#include <hpx/runtime/config_entry.hpp>
 #include <hpx/runtime/threads/policies/lockfree_queue_backends.hpp>
 #include <hpx/runtime/threads/policies/scheduler_base.hpp>
 #include <hpx/runtime/threads/policies/thread_queue.hpp>
@@ -19,9 +20,12 @@
 #include <hpx/runtime/threads_fwd.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
 #include <hpx/util/logging.hpp>
 #include <hpx/util_fwd.hpp>
 
+#include <boost/lexical_cast.hpp>
+
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
@@ -46,6 +50,25 @@ namespace hpx { namespace threads { namespace policies
     extern bool minimal_deadlock_detection;
 #endif
 
+    namespace detail
+    {
+        inline std::string get_steal_victim_selection()
+        {
+            static std::string steal_victim_selection =
+                hpx::get_config_entry(
+                    "hpx.thread_queue.steal_victim_selection", "round-robin");
+            return steal_victim_selection;
+        }
+
+        inline bool get_steal_half()
+        {
+            static bool steal_half =
+                boost::lexical_cast<int>(hpx::get_config_entry(
+                    "hpx.thread_queue.steal_half", "0")) != 0;
+            return steal_half;
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     /// The local_queue_scheduler maintains exactly one queue of work
     /// items (threads) per OS thread, where this OS thread pulls its next work
@@ -109,6 +132,52 @@ namespace hpx { namespace threads { namespace policies
         };
         typedef init_parameter init_parameter_type;
 
+        // the policies available for selecting the queue to steal from
+        enum victim_selection_policy
+        {
+            victim_round_robin = 0,     // walk all other queues in order
+            victim_random = 1,          // pick victims at random
+            victim_power_of_two = 2     // pick the longer of two random queues
+        };
+
+    private:
+        // per worker stealing state, the random number state is accessed by
+        // the owning worker thread only
+        struct steal_data
+        {
+            steal_data()
+              : random_state_(0),
+                successful_steals_(0),
+                failed_steals_(0)
+            {}
+
+            std::uint64_t random_state_;
+            std::atomic<std::int64_t> successful_steals_;
+            std::atomic<std::int64_t> failed_steals_;
+
+            // make sure no two workers share a cache line
+            char cacheline_pad_[threads::get_cache_line_size()];
+        };
+
+        static victim_selection_policy get_victim_selection_policy()
+        {
+            std::string const policy = detail::get_steal_victim_selection();
+            if (policy == "round-robin")
+                return victim_round_robin;
+            if (policy == "random")
+                return victim_random;
+            if (policy == "power-of-two")
+                return victim_power_of_two;
+
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "local_queue_scheduler::get_victim_selection_policy",
+                "unknown value for hpx.thread_queue.steal_victim_selection: " +
+                policy + " (valid values are: round-robin, random, and "
+                "power-of-two)");
+            return victim_round_robin;
+        }
+
+    public:
         local_queue_scheduler(init_parameter_type const& init,
                 bool deferred_initialization = true)
           : scheduler_base(init.num_queues_, init.description_),
@@ -116,6 +185,9 @@ namespace hpx { namespace threads { namespace policies
             queues_(init.num_queues_),
             curr_queue_(0),
             numa_sensitive_(init.numa_sensitive_),
+            victim_selection_(get_victim_selection_policy()),
+            steal_half_(detail::get_steal_half()),
+            steal_data_(init.num_queues_),
 #ifndef HPX_NATIVE_MIC        // we know that the MIC has one NUMA domain only
             steals_in_numa_domain_(),
             steals_outside_numa_domain_(),
@@ -134,6 +206,13 @@ namespace hpx { namespace threads { namespace policies
             resize(steals_in_numa_domain_, init.num_queues_);
             resize(steals_outside_numa_domain_, init.num_queues_);
 #endif
+            for (std::size_t i = 0; i != init.num_queues_; ++i)
+            {
+                // any non-zero seed will do for the xorshift generator
+                steal_data_[i].random_state_ =
+                    (i + 1) * std::uint64_t(0x9e3779b97f4a7c15ull);
+            }
+
             if (!deferred_initialization)
             {
                 HPX_ASSERT(init.num_queues_ != 0);
@@ -275,6 +354,38 @@ namespace hpx { namespace threads { namespace policies
             num_stolen_threads += queues_[num_thread]->get_num_stolen_to_staged(reset);
             return num_stolen_threads;
         }
+
+        std::int64_t get_num_successful_steals(
+            std::size_t num_thread, bool reset) override
+        {
+            std::int64_t num_steals = 0;
+            if (num_thread == std::size_t(-1))
+            {
+                for (std::size_t i = 0; i != steal_data_.size(); ++i)
+                    num_steals += util::get_and_reset_value(
+                        steal_data_[i].successful_steals_, reset);
+                return num_steals;
+            }
+
+            return util::get_and_reset_value(
+                steal_data_[num_thread].successful_steals_, reset);
+        }
+
+        std::int64_t get_num_failed_steals(
+            std::size_t num_thread, bool reset) override
+        {
+            std::int64_t num_steals = 0;
+            if (num_thread == std::size_t(-1))
+            {
+                for (std::size_t i = 0; i != steal_data_.size(); ++i)
+                    num_steals += util::get_and_reset_value(
+                        steal_data_[i].failed_steals_, reset);
+                return num_steals;
+            }
+
+            return util::get_and_reset_value(
+                steal_data_[num_thread].failed_steals_, reset);
+        }
 #endif
 
         ///////////////////////////////////////////////////////////////////////
@@ -369,84 +480,13 @@ namespace hpx { namespace threads { namespace policies
                 return false;
             }
 
-            if (numa_sensitive_ != 0)
-            {
-                auto const& rp = resource::get_partitioner();
-
-                // steal work items: first try to steal from other cores in
-                // the same NUMA node
-                std::size_t pu_number =
-                    rp.get_affinity_data().get_pu_num(num_thread);
-
-#if !defined(HPX_NATIVE_MIC)    // we know that the MIC has one NUMA domain only
-                if (test(steals_in_numa_domain_, pu_number)) //-V600 //-V111
-#endif
+            return steal_from_victims(num_thread,
+                [&](std::size_t idx) -> std::int64_t
                 {
-                    mask_cref_type this_numa_domain =
-                        numa_domain_masks_[num_thread];
-
-                    // steal thread from other queue
-                    for (std::size_t i = 1; i != queues_size; ++i)
-                    {
-                        // FIXME: Do a better job here.
-                        std::size_t const idx = (i + num_thread) % queues_size;
-
-                        HPX_ASSERT(idx != num_thread);
-
-                        std::size_t pu_num = rp.get_affinity_data().get_pu_num(idx);
-                        if (!test(this_numa_domain, pu_num)) //-V560 //-V600 //-V111
-                            continue;
-
-                        thread_queue_type* q = queues_[idx];
-                        if (q->get_next_thread(thrd, running))
-                        {
-                            q->increment_num_stolen_from_pending();
-                            queues_[num_thread]->increment_num_stolen_to_pending();
-                            return true;
-                        }
-                    }
-                }
-
-#ifndef HPX_NATIVE_MIC        // we know that the MIC has one NUMA domain only
-                // if nothing found, ask everybody else
-                if (test(steals_outside_numa_domain_, pu_number)) //-V600 //-V111
-                {
-                    mask_cref_type numa_domain =
-                        outside_numa_domain_masks_[num_thread];
-
-                    // steal thread from other queue
-                    for (std::size_t i = 1; i != queues_size; ++i)
-                    {
-                        // FIXME: Do a better job here.
-                        std::size_t const idx = (i + num_thread) % queues_size;
-
-                        HPX_ASSERT(idx != num_thread);
-
-                        std::size_t pu_num = rp.get_affinity_data().get_pu_num(idx);
-                        if (!test(numa_domain, pu_num))    //-V560 //-V600 //-V111
-                            continue;
-
-                        thread_queue_type* q = queues_[idx];
-                        if (q->get_next_thread(thrd, running))
-                        {
-                            q->increment_num_stolen_from_pending();
-                            queues_[num_thread]->increment_num_stolen_to_pending();
-                            return true;
-                        }
-                    }
-                }
-#endif
-            }
-
-            else // not NUMA-sensitive
-            {
-                for (std::size_t i = 1; i != queues_size; ++i)
+                    return queues_[idx]->get_pending_queue_length();
+                },
+                [&](std::size_t idx) -> bool
                 {
-                    // FIXME: Do a better job here.
-                    std::size_t const idx = (i + num_thread) % queues_size;
-
-                    HPX_ASSERT(idx != num_thread);
-
                     thread_queue_type* q = queues_[idx];
                     if (q->get_next_thread(thrd, running))
                     {
@@ -454,10 +494,8 @@ namespace hpx { namespace threads { namespace policies
                         queues_[num_thread]->increment_num_stolen_to_pending();
                         return true;
                     }
-                }
-            }
-
-            return false;
+                    return false;
+                });
         }
 
         /// Schedule the passed thread
@@ -693,7 +731,6 @@ namespace hpx { namespace threads { namespace policies
         virtual bool wait_or_add_new(std::size_t num_thread, bool running,
             std::int64_t& idle_loop_count) override
         {
-            std::size_t queues_size = queues_.size();
             HPX_ASSERT(num_thread < queues_.size());
 
             std::size_t added = 0;
@@ -709,99 +746,27 @@ namespace hpx { namespace threads { namespace policies
                 return true;
             }
 
-            if (numa_sensitive_ != 0)   // limited or no stealing across domains
-            {
-                auto const& rp = resource::get_partitioner();
-
-                // steal work items: first try to steal from other cores in
-                // the same NUMA node
-                std::size_t pu_number =
-                    rp.get_affinity_data().get_pu_num(num_thread);
-
-#if !defined(HPX_NATIVE_MIC)    // we know that the MIC has one NUMA domain only
-                if (test(steals_in_numa_domain_, pu_number)) //-V600 //-V111
-#endif
+            bool stolen = steal_from_victims(num_thread,
+                [&](std::size_t idx) -> std::int64_t
                 {
-                    mask_cref_type numa_domain_mask =
-                        numa_domain_masks_[num_thread];
-                    for (std::size_t i = 1; i != queues_size; ++i)
-                    {
-                        // FIXME: Do a better job here.
-                        std::size_t const idx = (i + num_thread) % queues_size;
-
-                        HPX_ASSERT(idx != num_thread);
-
-                        if (!test(numa_domain_mask,
-                                rp.get_affinity_data().get_pu_num(idx))) //-V600
-                        {
-                            continue;
-                        }
-
-                        result = queues_[num_thread]->wait_or_add_new(running,
-                            idle_loop_count, added, queues_[idx]) && result;
-                        if (0 != added)
-                        {
-                            queues_[idx]->increment_num_stolen_from_staged(added);
-                            queues_[num_thread]->increment_num_stolen_to_staged(added);
-                            return result;
-                        }
-                    }
-                }
-
-#ifndef HPX_NATIVE_MIC        // we know that the MIC has one NUMA domain only
-                // if nothing found, ask everybody else
-                if (test(steals_outside_numa_domain_, pu_number)) //-V600 //-V111
-                {
-                    threads::policies::detail::affinity_data const& affinity_data =
-                        rp.get_affinity_data();
-
-                    mask_cref_type numa_domain_mask =
-                        outside_numa_domain_masks_[num_thread];
-                    for (std::size_t i = 1; i != queues_size; ++i)
-                    {
-                        // FIXME: Do a better job here.
-                        std::size_t const idx = (i + num_thread) % queues_size;
-
-                        HPX_ASSERT(idx != num_thread);
-
-                        if (!test(numa_domain_mask,
-                                affinity_data.get_pu_num(idx))) //-V600
-                        {
-                            continue;
-                        }
-
-                        result = queues_[num_thread]->wait_or_add_new(running,
-                            idle_loop_count, added, queues_[idx]) && result;
-                        if (0 != added)
-                        {
-                            queues_[idx]->increment_num_stolen_from_staged(added);
-                            queues_[num_thread]->increment_num_stolen_to_staged(added);
-                            return result;
-                        }
-                    }
-                }
-#endif
-            }
-
-            else // not NUMA-sensitive
-            {
-                for (std::size_t i = 1; i != queues_size; ++i)
+                    return queues_[idx]->get_staged_queue_length(
+                        std::memory_order_relaxed);
+                },
+                [&](std::size_t idx) -> bool
                 {
-                    // FIXME: Do a better job here.
-                    std::size_t const idx = (i + num_thread) % queues_size;
-
-                    HPX_ASSERT(idx != num_thread);
-
                     result = queues_[num_thread]->wait_or_add_new(running,
-                        idle_loop_count, added, queues_[idx]) && result;
+                        idle_loop_count, added, queues_[idx], false,
+                        steal_half_) && result;
                     if (0 != added)
                     {
                         queues_[idx]->increment_num_stolen_from_staged(added);
                         queues_[num_thread]->increment_num_stolen_to_staged(added);
-                        return result;
+                        return true;
                     }
-                }
-            }
+                    return false;
+                });
+            if (stolen)
+                return result;
 
 #ifdef HPX_HAVE_THREAD_MINIMAL_DEADLOCK_DETECTION
             // no new work is available, are we deadlocked?
@@ -834,6 +799,136 @@ namespace hpx { namespace threads { namespace policies
             return result;
         }
 
+    protected:
+        // xorshift64, good enough for picking victims
+        std::size_t next_random(std::size_t num_thread)
+        {
+            std::uint64_t& x = steal_data_[num_thread].random_state_;
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            return static_cast<std::size_t>(x);
+        }
+
+        // return a random queue index different from num_thread
+        std::size_t random_victim(std::size_t num_thread)
+        {
+            std::size_t queues_size = queues_.size();
+            std::size_t idx = next_random(num_thread) % (queues_size - 1);
+            return idx >= num_thread ? idx + 1 : idx;
+        }
+
+        // Invoke f for the victims admitted by the given predicate in the
+        // order defined by the victim selection policy. Stops as soon as f
+        // returns true. The function load is used to compare the amount of
+        // work available on two victims.
+        template <typename Admit, typename Load, typename F>
+        bool for_each_victim(std::size_t num_thread, Admit && admit,
+            Load && load, F && f)
+        {
+            std::size_t queues_size = queues_.size();
+            if (queues_size < 2)
+                return false;
+
+            if (victim_selection_ == victim_round_robin)
+            {
+                for (std::size_t i = 1; i != queues_size; ++i)
+                {
+                    std::size_t const idx = (i + num_thread) % queues_size;
+
+                    HPX_ASSERT(idx != num_thread);
+
+                    if (admit(idx) && f(idx))
+                        return true;
+                }
+                return false;
+            }
+
+            // pick the same number of (random) victims as round robin
+            // selection would visit
+            for (std::size_t i = 1; i != queues_size; ++i)
+            {
+                std::size_t idx = random_victim(num_thread);
+                if (victim_selection_ == victim_power_of_two)
+                {
+                    std::size_t other = random_victim(num_thread);
+                    if (!admit(idx) || (admit(other) && load(other) > load(idx)))
+                        idx = other;
+                }
+
+                HPX_ASSERT(idx != num_thread);
+
+                if (admit(idx) && f(idx))
+                    return true;
+            }
+            return false;
+        }
+
+        // Try to steal work for the given worker thread by invoking f for
+        // the victim queues, honoring the NUMA sensitivity of the scheduler.
+        template <typename Load, typename F>
+        bool steal_from_victims(std::size_t num_thread, Load && load, F && f)
+        {
+            bool result = false;
+
+            if (numa_sensitive_ != 0)   // limited or no stealing across domains
+            {
+                auto const& rp = resource::get_partitioner();
+                threads::policies::detail::affinity_data const& affinity_data =
+                    rp.get_affinity_data();
+
+                // steal work items: first try to steal from other cores in
+                // the same NUMA node
+                std::size_t pu_number = affinity_data.get_pu_num(num_thread);
+
+#if !defined(HPX_NATIVE_MIC)    // we know that the MIC has one NUMA domain only
+                if (test(steals_in_numa_domain_, pu_number)) //-V600 //-V111
+#endif
+                {
+                    mask_cref_type numa_domain_mask =
+                        numa_domain_masks_[num_thread];
+                    result = for_each_victim(num_thread,
+                        [&](std::size_t idx)
+                        {
+                            return test(numa_domain_mask,
+                                affinity_data.get_pu_num(idx)); //-V600
+                        },
+                        load, f);
+                }
+
+#ifndef HPX_NATIVE_MIC        // we know that the MIC has one NUMA domain only
+                // if nothing found, ask everybody else
+                if (!result &&
+                    test(steals_outside_numa_domain_, pu_number)) //-V600 //-V111
+                {
+                    mask_cref_type numa_domain_mask =
+                        outside_numa_domain_masks_[num_thread];
+                    result = for_each_victim(num_thread,
+                        [&](std::size_t idx)
+                        {
+                            return test(numa_domain_mask,
+                                affinity_data.get_pu_num(idx)); //-V600
+                        },
+                        load, f);
+                }
+#endif
+            }
+            else // not NUMA-sensitive
+            {
+                result = for_each_victim(num_thread,
+                    [](std::size_t) { return true; }, load, f);
+            }
+
+#ifdef HPX_HAVE_THREAD_STEALING_COUNTS
+            if (result)
+                ++steal_data_[num_thread].successful_steals_;
+            else
+                ++steal_data_[num_thread].failed_steals_;
+#endif
+            return result;
+        }
+
+    public:
         ///////////////////////////////////////////////////////////////////////
         void on_start_thread(std::size_t num_thread) override
         {
@@ -904,6 +999,10 @@ namespace hpx { namespace threads { namespace policies
         std::atomic<std::size_t> curr_queue_;
         std::size_t numa_sensitive_;
 
+        victim_selection_policy const victim_selection_;
+        bool const steal_half_;
+        std::vector<steal_data> steal_data_;
+
 #if !defined(HPX_NATIVE_MIC)        // we know that the MIC has one NUMA domain only
         mask_type steals_in_numa_domain_;
         mask_type steals_outside_numa_domain_;
@@ -10,8 +10,10 @@
 
 #include <hpx/config.hpp>
 
+#include <hpx/util/lockfree/chase_lev_deque.hpp>
 #include <hpx/util/lockfree/deque.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 
@@ -21,11 +23,22 @@ namespace hpx { namespace threads { namespace policies
 struct lockfree_fifo;
 struct lockfree_lifo;
 
+// The freelist of the lock-free deques used by the queues. With the
+// reclaiming freelist the deques cache a bounded number of nodes, nodes
+// beyond that are returned to the system once the worker threads have passed
+// through a quiescent state (see hpx::util::lockfree::epoch_domain).
+#if defined(HPX_HAVE_LOCKFREE_RECLAMATION)
+typedef boost::lockfree::reclaiming_freelist_t lockfree_queue_freelist;
+#else
+typedef boost::lockfree::caching_freelist_t lockfree_queue_freelist;
+#endif
+
 // FIFO
 template <typename T>
 struct lockfree_fifo_backend
 {
-    typedef boost::lockfree::deque<T> container_type;
+    typedef boost::lockfree::deque<T, lockfree_queue_freelist>
+        container_type;
     typedef T value_type;
     typedef T& reference;
     typedef T const& const_reference;
@@ -70,7 +83,8 @@ struct lockfree_fifo
 template <typename T>
 struct lockfree_lifo_backend
 {
-    typedef boost::lockfree::deque<T> container_type;
+    typedef boost::lockfree::deque<T, lockfree_queue_freelist>
+        container_type;
     typedef T value_type;
     typedef T& reference;
     typedef T const& const_reference;
@@ -113,6 +127,102 @@ struct lockfree_lifo
     };
 };
 
+///////////////////////////////////////////////////////////////////////////////
+// LIFO for the owning worker thread + stealing at opposite end, based on the
+// Chase-Lev work-stealing deque. The owning worker thread pushes and pops
+// without read-modify-write operations, all other threads steal from the top.
+//
+// As any thread may schedule work onto any queue, pushes from threads other
+// than the owner (and pushes to the other end) are directed to a separate
+// multi-producer overflow queue which is drained after the deque.
+struct lockfree_chase_lev;
+
+namespace detail
+{
+    // the address of this thread local object identifies the calling OS
+    // thread
+    inline void const* get_chase_lev_thread_token()
+    {
+        static HPX_NATIVE_TLS char token = 0;
+        return &token;
+    }
+}
+
+template <typename T>
+struct lockfree_chase_lev_backend
+{
+    typedef boost::lockfree::chase_lev_deque<T> container_type;
+    typedef boost::lockfree::deque<T, lockfree_queue_freelist>
+        overflow_container_type;
+    typedef T value_type;
+    typedef T& reference;
+    typedef T const& const_reference;
+    typedef std::uint64_t size_type;
+
+    lockfree_chase_lev_backend(
+        size_type initial_size = 0
+      , size_type num_thread = size_type(-1)
+        )
+      : queue_(std::size_t(initial_size))
+      , overflow_(std::size_t(initial_size))
+      , owner_(nullptr)
+    {}
+
+    // Has to be called by the worker thread owning this queue before it
+    // starts executing work.
+    void on_start_thread()
+    {
+        owner_.store(detail::get_chase_lev_thread_token(),
+            std::memory_order_release);
+    }
+
+    bool push(const_reference val, bool other_end = false)
+    {
+        if (!other_end && is_owner())
+            return queue_.push_bottom(val);
+        return overflow_.push_left(val);
+    }
+
+    bool pop(reference val, bool /*steal*/ = true)
+    {
+        if (is_owner())
+        {
+            if (queue_.pop_bottom(val))
+                return true;
+        }
+        else if (queue_.steal_top(val))
+        {
+            return true;
+        }
+        return overflow_.pop_right(val);
+    }
+
+    bool empty()
+    {
+        return queue_.empty() && overflow_.empty();
+    }
+
+  private:
+    bool is_owner() const
+    {
+        return owner_.load(std::memory_order_relaxed) ==
+            detail::get_chase_lev_thread_token();
+    }
+
+    container_type queue_;
+    overflow_container_type overflow_;
+    std::atomic<void const*> owner_;
+};
+
+struct lockfree_chase_lev
+{
+    template <typename T>
+    struct apply
+    {
+        typedef lockfree_chase_lev_backend<T> type;
+    };
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // FIFO + stealing at opposite end.
 #if defined(HPX_HAVE_ABP_SCHEDULER)
@@ -122,7 +232,8 @@ struct lockfree_abp_lifo;
 template <typename T>
 struct lockfree_abp_fifo_backend
 {
-    typedef boost::lockfree::deque<T> container_type;
+    typedef boost::lockfree::deque<T, lockfree_queue_freelist>
+        container_type;
     typedef T value_type;
     typedef T& reference;
     typedef T const& const_reference;
@@ -172,7 +283,8 @@ struct lockfree_abp_fifo
 template <typename T>
 struct lockfree_abp_lifo_backend
 {
-    typedef boost::lockfree::deque<T> container_type;
+    typedef boost::lockfree::deque<T, lockfree_queue_freelist>
+        container_type;
     typedef T value_type;
     typedef T& reference;
     typedef T const& const_reference;
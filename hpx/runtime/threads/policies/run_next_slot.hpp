@@ -0,0 +1,115 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_POLICIES_RUN_NEXT_SLOT_HPP)
+#define HPX_RUNTIME_THREADS_POLICIES_RUN_NEXT_SLOT_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <boost/lexical_cast.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace hpx { namespace threads { namespace policies
+{
+    namespace detail
+    {
+        inline bool get_run_next_slot()
+        {
+            static bool run_next_slot =
+                boost::lexical_cast<int>(hpx::get_config_entry(
+                    "hpx.thread_queue.run_next_slot", "0")) != 0;
+            return run_next_slot;
+        }
+
+        // [ns]
+        inline std::uint64_t get_run_next_steal_delay()
+        {
+            static std::uint64_t run_next_steal_delay =
+                boost::lexical_cast<std::uint64_t>(hpx::get_config_entry(
+                    "hpx.thread_queue.run_next_steal_delay", "50")) * 1000;
+            return run_next_steal_delay;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Holds the HPX thread most recently made ready by the owning worker
+    // thread. The owner runs this thread next, bypassing its queues, which
+    // keeps the data shared with the thread which made it ready in cache.
+    // Other worker threads may steal the thread only once it has been
+    // waiting in the slot for longer than a given delay.
+    class run_next_slot
+    {
+    public:
+        run_next_slot()
+          : thrd_(nullptr),
+            timestamp_(0)
+        {}
+
+        run_next_slot(run_next_slot const&) = delete;
+        run_next_slot& operator=(run_next_slot const&) = delete;
+
+        // Store the given thread, returns the thread which was displaced from
+        // the slot (or nullptr), owner only.
+        threads::thread_data* push(threads::thread_data* thrd)
+        {
+            timestamp_.store(util::high_resolution_clock::now(),
+                std::memory_order_relaxed);
+            return thrd_.exchange(thrd, std::memory_order_acq_rel);
+        }
+
+        // Take the thread stored in the slot, owner only.
+        bool pop(threads::thread_data*& thrd)
+        {
+            if (thrd_.load(std::memory_order_relaxed) == nullptr)
+                return false;
+
+            thrd = thrd_.exchange(nullptr, std::memory_order_acq_rel);
+            return thrd != nullptr;
+        }
+
+        // Take the thread stored in the slot if it has been waiting for at
+        // least the given delay [ns], may be called from any thread.
+        bool steal(threads::thread_data*& thrd, std::uint64_t delay)
+        {
+            threads::thread_data* t = thrd_.load(std::memory_order_acquire);
+            if (t == nullptr)
+                return false;
+
+            std::uint64_t now = util::high_resolution_clock::now();
+            if (now - timestamp_.load(std::memory_order_relaxed) < delay)
+                return false;
+
+            if (!thrd_.compare_exchange_strong(t, nullptr,
+                    std::memory_order_acq_rel, std::memory_order_relaxed))
+            {
+                return false;
+            }
+
+            thrd = t;
+            return true;
+        }
+
+        bool empty() const
+        {
+            return thrd_.load(std::memory_order_relaxed) == nullptr;
+        }
+
+    private:
+        std::atomic<threads::thread_data*> thrd_;
+        std::atomic<std::uint64_t> timestamp_;
+
+        // the slots of all worker threads are stored next to each other
+        char pad_[threads::get_cache_line_size()];
+    };
+}}}
+
+#endif
@@ -9,15 +9,21 @@
 #include <hpx/config.hpp>
 #include <hpx/compat/condition_variable.hpp>
 #include <hpx/compat/mutex.hpp>
+#include <hpx/compute/cuda/event_polling.hpp>
 #include <hpx/runtime/agas/interface.hpp>
 #include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
 #include <hpx/runtime/parcelset_fwd.hpp>
 #include <hpx/runtime/resource/detail/partitioner.hpp>
+#include <hpx/runtime/threads/detail/external_inbox.hpp>
+#include <hpx/runtime/threads/detail/parking_spot.hpp>
 #include <hpx/runtime/threads/policies/scheduler_mode.hpp>
 #include <hpx/runtime/threads/thread_init_data.hpp>
 #include <hpx/runtime/threads/thread_pool_base.hpp>
 #include <hpx/state.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/cache_aligned_data.hpp>
+#include <hpx/util/detail/async_file_polling.hpp>
 #include <hpx/util/safe_lexical_cast.hpp>
 #include <hpx/util/yield_while.hpp>
 #include <hpx/util_fwd.hpp>
@@ -87,6 +93,8 @@ namespace hpx { namespace threads { namespace policies
                     hpx::get_config_entry("hpx.max_idle_backoff_time",
                         HPX_IDLE_BACKOFF_TIME_MAX)))
 #endif
+          , idle_sleepers_(0)
+          , parking_spots_(num_threads)
           , suspend_mtxs_(num_threads)
           , suspend_conds_(num_threads)
           , pu_mtxs_(num_threads)
@@ -96,7 +104,7 @@ namespace hpx { namespace threads { namespace policies
           , background_thread_count_(0)
         {
             for (std::size_t i = 0; i != num_threads; ++i)
-                states_[i].store(state_initialized);
+                states_[i].data_.store(state_initialized);
         }
 
         virtual ~scheduler_base()
@@ -127,7 +135,7 @@ namespace hpx { namespace threads { namespace policies
 
         char const* get_description() const { return description_; }
 
-        void idle_callback(std::size_t /*num_thread*/)
+        void idle_callback(std::size_t num_thread)
         {
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
             // Put this thread to sleep for some time, additionally it gets
@@ -142,8 +150,9 @@ namespace hpx { namespace threads { namespace policies
 
             ++wait_count_;
 
-            std::unique_lock<pu_mutex_type> l(mtx_);
-            cond_.wait_for(l, period);
+            idle_sleep(global_to_local_thread_index(num_thread), period);
+#else
+            HPX_UNUSED(num_thread);
 #endif
         }
 
@@ -153,31 +162,121 @@ namespace hpx { namespace threads { namespace policies
             if (hpx::parcelset::do_background_work(num_thread))
                 result = true;
 
+#if defined(HPX_HAVE_CUDA)
+            if (hpx::compute::cuda::poll_events())
+                result = true;
+#endif
+
+#if defined(HPX_HAVE_IO_URING)
+            if (hpx::util::detail::poll_async_files())
+                result = true;
+#endif
+
             if (0 == num_thread)
                 hpx::agas::garbage_collect_non_blocking();
             return result;
         }
 
+        /// Put the given worker thread to sleep until new work is announced
+        /// by \a do_some_work or until the given timeout has expired. The
+        /// thread does not go to sleep if its queues or its external inbox
+        /// are not empty or if it is about to be suspended or stopped.
+        template <typename Rep, typename Period>
+        void idle_sleep(std::size_t num_thread,
+            std::chrono::duration<Rep, Period> const& timeout)
+        {
+            HPX_ASSERT(num_thread < parking_spots_.size());
+            threads::detail::parking_spot& spot = parking_spots_[num_thread];
+
+            if (spot.get_numa_node() == std::size_t(-1))
+                spot.set_numa_node(
+                    domain_from_local_thread_index(num_thread));
+
+            // announce the sleeper before checking the queues, any work
+            // added afterwards will be followed by a wakeup
+            spot.prepare_park();
+            ++idle_sleepers_;
+            if (get_queue_length(num_thread) == 0 &&
+                threads::detail::external_inbox::get().empty(
+                    this, num_thread) &&
+                states_[num_thread].data_.load() < state_pre_sleep)
+            {
+                spot.park(std::chrono::duration_cast<
+                    std::chrono::microseconds>(timeout));
+            }
+            --idle_sleepers_;
+            spot.finish_park();
+        }
+
+        /// Wake up the worker \a num_thread if it sleeps because it was idle,
+        /// this makes it notice a change of its state right away instead of
+        /// once its idle timeout has expired.
+        void wake_idle_worker(std::size_t num_thread)
+        {
+            HPX_ASSERT(num_thread < parking_spots_.size());
+            parking_spots_[num_thread].unpark();
+        }
+
         /// This function gets called by the thread-manager whenever new work
-        /// has been added, allowing the scheduler to reactivate one or more of
-        /// possibly idling OS threads
+        /// has been added, allowing the scheduler to reactivate one of the
+        /// possibly idling OS threads. The worker \a num_thread is woken up
+        /// if it sleeps, otherwise exactly one sleeping worker is woken up,
+        /// preferably one on the same NUMA node as the calling worker.
         void do_some_work(std::size_t num_thread)
         {
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
             wait_count_.store(0, std::memory_order_release);
-
-            if (num_thread == std::size_t(-1))
-                cond_.notify_all();
-            else
-                cond_.notify_one();
 #endif
+            if (idle_sleepers_.load() == 0)
+                return;
+
+            std::size_t const num_spots = parking_spots_.size();
+            if (num_thread < num_spots && parking_spots_[num_thread].unpark())
+                return;
+
+            // find the NUMA node of the producer if it runs on this pool
+            std::size_t numa_node = std::size_t(-1);
+            std::size_t start = 0;
+            std::size_t worker = hpx::get_worker_thread_num();
+            if (worker != std::size_t(-1) && parent_pool_ != nullptr)
+            {
+                std::size_t offset = parent_pool_->get_thread_offset();
+                if (worker >= offset && worker - offset < num_spots)
+                {
+                    start = worker - offset;
+                    numa_node = parking_spots_[start].get_numa_node();
+                    if (numa_node == std::size_t(-1))
+                    {
+                        numa_node = domain_from_local_thread_index(start);
+                        parking_spots_[start].set_numa_node(numa_node);
+                    }
+                }
+            }
+
+            // prefer a sleeper close to the producer, fall back to any
+            if (numa_node != std::size_t(-1))
+            {
+                for (std::size_t i = 0; i != num_spots; ++i)
+                {
+                    threads::detail::parking_spot& spot =
+                        parking_spots_[(start + i) % num_spots];
+                    if (spot.get_numa_node() == numa_node && spot.unpark())
+                        return;
+                }
+            }
+
+            for (std::size_t i = 0; i != num_spots; ++i)
+            {
+                if (parking_spots_[(start + i) % num_spots].unpark())
+                    return;
+            }
         }
 
         virtual void suspend(std::size_t num_thread)
         {
             HPX_ASSERT(num_thread < suspend_conds_.size());
 
-            states_[num_thread].store(state_sleeping);
+            states_[num_thread].data_.store(state_sleeping);
             std::unique_lock<pu_mutex_type> l(suspend_mtxs_[num_thread]);
             suspend_conds_[num_thread].wait(l);
 
@@ -185,7 +284,8 @@ namespace hpx { namespace threads { namespace policies
             // non-blocking/locking functions to stopping or terminating, in
             // which case the state is left untouched.
             hpx::state expected = state_sleeping;
-            states_[num_thread].compare_exchange_strong(expected, state_running);
+            states_[num_thread].data_.compare_exchange_strong(
+                expected, state_running);
 
             HPX_ASSERT(expected == state_sleeping ||
                 expected == state_stopping || expected == state_terminating);
@@ -232,11 +332,11 @@ namespace hpx { namespace threads { namespace policies
                                 (num_thread + offset) % states_size;
 
                             l = std::unique_lock<pu_mutex_type>(
-                                pu_mtxs_[num_thread_local], std::try_to_lock);
+                                pu_mtxs_[num_thread_local].data_, std::try_to_lock);
 
                             if (l.owns_lock())
                             {
-                                if (states_[num_thread_local] <=
+                                if (states_[num_thread_local].data_ <=
                                     max_allowed_state)
                                 {
                                     num_thread = num_thread_local;
@@ -246,7 +346,8 @@ namespace hpx { namespace threads { namespace policies
                                 l.unlock();
                             }
 
-                            if (states_[num_thread_local] <= max_allowed_state)
+                            if (states_[num_thread_local].data_ <=
+                                max_allowed_state)
                             {
                                 ++num_allowed_threads;
                             }
@@ -286,10 +387,10 @@ namespace hpx { namespace threads { namespace policies
                         (num_thread + offset) % states_size;
 
                     l = std::unique_lock<pu_mutex_type>(
-                        pu_mtxs_[num_thread_local], std::try_to_lock);
+                        pu_mtxs_[num_thread_local].data_, std::try_to_lock);
 
                     if (l.owns_lock() &&
-                        states_[num_thread_local] <= state_suspended)
+                        states_[num_thread_local].data_ <= state_suspended)
                     {
                         return num_thread_local;
                     }
@@ -303,31 +404,29 @@ namespace hpx { namespace threads { namespace policies
         std::atomic<hpx::state>& get_state(std::size_t num_thread)
         {
             HPX_ASSERT(num_thread < states_.size());
-            return states_[num_thread];
+            return states_[num_thread].data_;
         }
         std::atomic<hpx::state> const& get_state(std::size_t num_thread) const
         {
             HPX_ASSERT(num_thread < states_.size());
-            return states_[num_thread];
+            return states_[num_thread].data_;
         }
 
         void set_all_states(hpx::state s)
         {
-            typedef std::atomic<hpx::state> state_type;
-            for (state_type& state : states_)
+            for (auto& state : states_)
             {
-                state.store(s);
+                state.data_.store(s);
             }
         }
 
         void set_all_states_at_least(hpx::state s)
         {
-            typedef std::atomic<hpx::state> state_type;
-            for (state_type& state : states_)
+            for (auto& state : states_)
             {
-                if (state < s)
+                if (state.data_ < s)
                 {
-                    state.store(s);
+                    state.data_.store(s);
                 }
             }
         }
@@ -335,10 +434,9 @@ namespace hpx { namespace threads { namespace policies
         // return whether all states are at least at the given one
         bool has_reached_state(hpx::state s) const
         {
-            typedef std::atomic<hpx::state> state_type;
-            for (state_type const& state : states_)
+            for (auto const& state : states_)
             {
-                if (state.load() < s)
+                if (state.data_.load() < s)
                     return false;
             }
             return true;
@@ -346,10 +444,9 @@ namespace hpx { namespace threads { namespace policies
 
         bool is_state(hpx::state s) const
         {
-            typedef std::atomic<hpx::state> state_type;
-            for (state_type const& state : states_)
+            for (auto const& state : states_)
             {
-                if (state.load() != s)
+                if (state.data_.load() != s)
                     return false;
             }
             return true;
@@ -360,10 +457,9 @@ namespace hpx { namespace threads { namespace policies
             std::pair<hpx::state, hpx::state> result(
                 last_valid_runtime_state, first_valid_runtime_state);
 
-            typedef std::atomic<hpx::state> state_type;
-            for (state_type const& state_iter : states_)
+            for (auto const& state_iter : states_)
             {
-                hpx::state s = state_iter.load();
+                hpx::state s = state_iter.data_.load();
                 result.first = (std::min)(result.first, s);
                 result.second = (std::max)(result.second, s);
             }
@@ -385,13 +481,55 @@ namespace hpx { namespace threads { namespace policies
         pu_mutex_type& get_pu_mutex(std::size_t num_thread)
         {
             HPX_ASSERT(num_thread < pu_mtxs_.size());
-            return pu_mtxs_[num_thread];
+            return pu_mtxs_[num_thread].data_;
         }
 
         ///////////////////////////////////////////////////////////////////////
         virtual bool numa_sensitive() const { return false; }
         virtual bool has_thread_stealing() const { return false; }
 
+        ///////////////////////////////////////////////////////////////////////
+        // Support for sharing work between thread pools, the idle worker
+        // threads of a borrowing pool execute low priority threads of the
+        // lending pools (see resource::pool_sharing_mode).
+
+        // Set the schedulers this scheduler may borrow threads from, this is
+        // done before the worker threads are started.
+        void set_lenders(std::vector<scheduler_base*> lenders)
+        {
+            lenders_ = std::move(lenders);
+        }
+
+        // Take a thread from one of the lending schedulers for execution by
+        // the given (idle) worker thread of this scheduler. The thread is
+        // still owned by the lending scheduler.
+        bool borrow_thread(std::size_t num_thread, threads::thread_data*& thrd)
+        {
+            std::size_t const num_lenders = lenders_.size();
+            for (std::size_t i = 0; i != num_lenders; ++i)
+            {
+                scheduler_base* lender =
+                    lenders_[(num_thread + i) % num_lenders];
+
+                hpx::state s = lender->get_state(0).load(
+                    std::memory_order_relaxed);
+                if (s >= state_running && s < state_pre_shutdown &&
+                    lender->lend_thread(thrd))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Take a low priority thread of this scheduler for execution by a
+        // worker thread of another pool. Schedulers which do not support
+        // lending threads always return false.
+        virtual bool lend_thread(threads::thread_data*& /*thrd*/)
+        {
+            return false;
+        }
+
         inline std::size_t domain_from_local_thread_index(std::size_t n)
         {
             auto &rp = resource::get_partitioner();
@@ -462,6 +600,19 @@ namespace hpx { namespace threads { namespace policies
             bool reset) = 0;
         virtual std::int64_t get_num_stolen_to_staged(std::size_t num_thread,
             bool reset) = 0;
+
+        // Only schedulers keeping track of their stealing attempts override
+        // these.
+        virtual std::int64_t get_num_successful_steals(
+            std::size_t /*num_thread*/, bool /*reset*/)
+        {
+            return 0;
+        }
+        virtual std::int64_t get_num_failed_steals(
+            std::size_t /*num_thread*/, bool /*reset*/)
+        {
+            return 0;
+        }
 #endif
 
         virtual std::int64_t get_queue_length(
@@ -501,6 +652,24 @@ namespace hpx { namespace threads { namespace policies
         virtual void create_thread(thread_init_data& data, thread_id_type* id,
             thread_state_enum initial_state, bool run_now, error_code& ec) = 0;
 
+        // Create a batch of task descriptions (threads with critical priority
+        // are created immediately). Schedulers may override this to insert
+        // all tasks into their queues at once.
+        virtual void create_threads(std::vector<thread_init_data>& data,
+            thread_state_enum initial_state, error_code& ec)
+        {
+            for (thread_init_data& d : data)
+            {
+                bool run_now = d.priority == thread_priority_high ||
+                    d.priority == thread_priority_high_recursive ||
+                    d.priority == thread_priority_boost;
+
+                create_thread(d, nullptr, initial_state, run_now, ec);
+                if (&ec != &throws && ec)
+                    return;
+            }
+        }
+
         virtual bool get_next_thread(std::size_t num_thread, bool running,
             std::int64_t& idle_loop_count, threads::thread_data*& thrd) = 0;
 
@@ -543,19 +712,25 @@ namespace hpx { namespace threads { namespace policies
 
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
         // support for suspension on idle queues
-        pu_mutex_type mtx_;
-        compat::condition_variable cond_;
         std::atomic<std::uint32_t> wait_count_;
         double max_idle_backoff_time_;
 #endif
 
+        // support for sleeping idle worker threads (see idle_sleep), every
+        // worker has its own parking spot to allow for targeted wakeups
+        std::atomic<std::int32_t> idle_sleepers_;
+        std::vector<threads::detail::parking_spot> parking_spots_;
+
         // support for suspension of pus
         std::vector<pu_mutex_type> suspend_mtxs_;
         std::vector<compat::condition_variable> suspend_conds_;
 
-        std::vector<pu_mutex_type> pu_mtxs_;
+        // the per worker locks and states are accessed by the worker threads
+        // in their scheduling loops, avoid false sharing between workers
+        std::vector<util::cache_aligned_data<pu_mutex_type> > pu_mtxs_;
 
-        std::vector<std::atomic<hpx::state> > states_;
+        std::vector<util::cache_aligned_data<std::atomic<hpx::state> > >
+            states_;
         char const* description_;
 
         // the pool that owns this scheduler
@@ -563,6 +738,9 @@ namespace hpx { namespace threads { namespace policies
 
         std::atomic<std::int64_t> background_thread_count_;
 
+        // the schedulers this scheduler borrows threads from
+        std::vector<scheduler_base*> lenders_;
+
 #if defined(HPX_HAVE_SCHEDULER_LOCAL_STORAGE)
     public:
         coroutines::detail::tss_data_node* find_tss_data(void const* key)
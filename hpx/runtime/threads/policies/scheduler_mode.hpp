@@ -33,6 +33,16 @@ namespace hpx { namespace threads { namespace policies
             ///< scheduler to dynamically increase and reduce the number of
             ///< processing units it runs on. Setting this value not succeed for
             ///< schedulers that do not support this functionality.
+        time_slicing = 0x20,            ///< The HPX threads run for at most
+            ///< hpx.thread_time_slice microseconds before they yield the
+            ///< worker thread at their next preemption point (see
+            ///< hpx::this_thread::preemption_point). The parallel algorithms
+            ///< contain preemption points in their inner loops.
+        time_slice_signal = 0x40,       ///< In addition to time_slicing, the
+            ///< expiration of the time slice is signalled to the worker
+            ///< thread by a timer signal, which makes the preemption points
+            ///< cheaper. This is supported on Linux only and is ignored
+            ///< elsewhere.
         default_mode = do_background_work | reduce_thread_priority | delay_exit
             ///< This option represents the default mode.
     };
@@ -0,0 +1,164 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_THREADMANAGER_SHARDED_THREAD_MAP_HPP)
+#define HPX_THREADMANAGER_SHARDED_THREAD_MAP_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+#include <hpx/runtime/threads/thread_id_type.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/fibhash.hpp>
+#include <hpx/util/internal_allocator.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace threads { namespace policies
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The sharded_thread_map holds all threads known to a thread_queue. The
+    // threads are distributed over a (power of two) number of independently
+    // locked shards, which are padded to avoid false sharing. This way
+    // creating and retiring threads from several cores does not serialize on
+    // a single mutex anymore.
+    template <typename Mutex>
+    class sharded_thread_map
+    {
+    public:
+        HPX_NON_COPYABLE(sharded_thread_map);
+
+        using mutex_type = Mutex;
+        using map_type = std::unordered_set<thread_id_type,
+            std::hash<thread_id_type>, std::equal_to<thread_id_type>,
+            util::internal_allocator<thread_id_type>>;
+
+        // maximal number of shards supported
+        HPX_STATIC_CONSTEXPR std::size_t max_shards = 64;
+
+    private:
+        struct shard
+        {
+            mutable mutex_type mtx_;
+            map_type map_;
+
+            // make sure no two shards share a cache line
+            char cacheline_pad_[threads::get_cache_line_size()];
+        };
+
+        static std::size_t adjust_num_shards(std::size_t num_shards)
+        {
+            if (num_shards == 0)
+                return 1;
+            if (num_shards >= max_shards)
+                return max_shards;
+
+            // round up to the next power of two
+            std::size_t result = 1;
+            while (result < num_shards)
+                result <<= 1;
+            return result;
+        }
+
+        shard& get_shard(thread_id_type const& id)
+        {
+            std::size_t h = util::fibhash<max_shards>(
+                reinterpret_cast<std::size_t>(id.get()));
+            return shards_[h & (num_shards_ - 1)];
+        }
+        shard const& get_shard(thread_id_type const& id) const
+        {
+            std::size_t h = util::fibhash<max_shards>(
+                reinterpret_cast<std::size_t>(id.get()));
+            return shards_[h & (num_shards_ - 1)];
+        }
+
+    public:
+        explicit sharded_thread_map(std::size_t num_shards = 1)
+          : num_shards_(adjust_num_shards(num_shards))
+          , shards_(num_shards_)
+          , count_(0)
+        {
+        }
+
+        std::size_t num_shards() const
+        {
+            return num_shards_;
+        }
+
+        // Add a new thread to the map, returns false if the thread was
+        // already known.
+        bool insert(thread_id_type const& id)
+        {
+            shard& s = get_shard(id);
+            {
+                std::lock_guard<mutex_type> lk(s.mtx_);
+                if (!s.map_.insert(id).second)
+                    return false;
+            }
+            ++count_;
+            return true;
+        }
+
+        // Remove the given thread from the map, returns false if the thread
+        // was not known.
+        bool erase(thread_id_type const& id)
+        {
+            shard& s = get_shard(id);
+            {
+                std::lock_guard<mutex_type> lk(s.mtx_);
+                if (s.map_.erase(id) == 0)
+                    return false;
+            }
+            --count_;
+            HPX_ASSERT(count_ >= 0);
+            return true;
+        }
+
+        bool contains(thread_id_type const& id) const
+        {
+            shard const& s = get_shard(id);
+            std::lock_guard<mutex_type> lk(s.mtx_);
+            return s.map_.find(id) != s.map_.end();
+        }
+
+        // Return the overall number of threads stored in the map. This
+        // value is computed without acquiring any locks.
+        std::int64_t size() const
+        {
+            return count_.load(std::memory_order_relaxed);
+        }
+
+        // Invoke the given function for all threads stored in the map. The
+        // shards are locked one at a time while being traversed.
+        template <typename F>
+        void for_each(F && f) const
+        {
+            for (shard const& s : shards_)
+            {
+                std::lock_guard<mutex_type> lk(s.mtx_);
+                for (thread_id_type const& id : s.map_)
+                {
+                    f(id);
+                }
+            }
+        }
+
+    private:
+        std::size_t const num_shards_;
+        std::vector<shard> shards_;
+
+        std::atomic<std::int64_t> count_;   // overall count of threads
+    };
+}}}
+
+#endif
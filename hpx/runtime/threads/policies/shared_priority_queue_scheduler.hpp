@@ -11,6 +11,7 @@
 #include <hpx/runtime/get_worker_thread_num.hpp>
 #include <hpx/runtime/threads/policies/lockfree_queue_backends.hpp>
 #include <hpx/runtime/threads/policies/queue_helpers.hpp>
+#include <hpx/runtime/threads/policies/run_next_slot.hpp>
 #include <hpx/runtime/threads/policies/scheduler_base.hpp>
 #include <hpx/runtime/threads/policies/thread_queue.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
@@ -29,6 +30,7 @@
 #include <string>
 #include <numeric>
 #include <type_traits>
+#include <vector>
 
 #include <hpx/config/warnings_prefix.hpp>
 
@@ -78,6 +80,9 @@ namespace policies {
           , max_queue_thread_count_(max_tasks)
           , num_workers_(num_worker_threads)
           , num_domains_(1)
+          , run_next_slots_(num_worker_threads)
+          , use_run_next_(detail::get_run_next_slot())
+          , run_next_steal_delay_(detail::get_run_next_steal_delay())
           , initialized_(false)
         {
             HPX_ASSERT(num_worker_threads != 0);
@@ -696,6 +701,11 @@ namespace policies {
                 if (result) break;
             }
 
+            // the thread most recently made ready by this worker runs next
+            if (!result && use_run_next_) {
+                result = run_next_slots_[thread_num].pop(thrd);
+            }
+
             // try a normal priority task
             if (!result) {
                 for (std::size_t d=0; d<num_domains_; ++d) {
@@ -727,6 +737,17 @@ namespace policies {
                 result = lp_queues_[domain_num].get_next_thread(0, thrd);
 #endif
             }
+
+            // steal threads which have been waiting in the run-next slot of
+            // another worker for too long
+            if (!result && use_run_next_) {
+                for (std::size_t i=1; i<num_workers_; ++i) {
+                    std::size_t victim = (thread_num+i) % num_workers_;
+                    result = run_next_slots_[victim].steal(
+                        thrd, run_next_steal_delay_);
+                    if (result) break;
+                }
+            }
             if (result)
             {
                 HPX_ASSERT(thrd->get_scheduler_base() == this);
@@ -761,6 +782,18 @@ namespace policies {
                     // Reset thread_num to first queue.
                     thread_num = 0;
                 }
+                else if (use_run_next_ &&
+                    priority != thread_priority_high &&
+                    priority != thread_priority_high_recursive &&
+                    priority != thread_priority_boost &&
+                    priority != thread_priority_low)
+                {
+                    // run this thread next on this worker, queue the thread
+                    // it displaces from the run-next slot instead
+                    thrd = run_next_slots_[thread_num].push(thrd);
+                    if (thrd == nullptr)
+                        return;
+                }
                 thread_num = select_active_pu(l, thread_num, allow_fallback);
                 domain_num     = d_lookup_[thread_num];
                 q_index        = q_lookup_[thread_num];
@@ -933,8 +966,14 @@ namespace policies {
                 count += np_queues_[d].get_queue_length();
                 count += lp_queues_[d].get_queue_length();
             }
+            for (std::size_t i=0; i<num_workers_; ++i) {
+                if (!run_next_slots_[i].empty()) ++count;
+            }
 
             if (thread_num != std::size_t(-1)) {
+                if (!run_next_slots_[thread_num].empty())
+                    return 1;
+
                 // find the numa domain from the local thread index
                 std::size_t domain = d_lookup_[thread_num];
                 // get next task, steal if from another domain
@@ -1078,6 +1117,10 @@ namespace policies {
                     "Invalid thread number: " + std::to_string(thread_num));
             }
 
+            // the thread in the run-next slot has to be run first
+            if (use_run_next_ && !run_next_slots_[thread_num].empty())
+                return false;
+
             // find the numa domain from the local thread index
             std::size_t domain_num = d_lookup_[thread_num];
 
@@ -1299,6 +1342,11 @@ namespace policies {
         // number of numa domains that the threads are occupying
         std::size_t num_domains_;
 
+        // the threads to run next, one per worker (see run_next_slot)
+        std::vector<run_next_slot> run_next_slots_;
+        bool const use_run_next_;
+        std::uint64_t const run_next_steal_delay_;
+
         // used to make sure the scheduler is only initialized once on a thread
         bool initialized_;
         hpx::lcos::local::spinlock init_mutex;
@@ -13,6 +13,7 @@
 #include <hpx/compat/mutex.hpp>
 #include <hpx/runtime/threads/policies/local_queue_scheduler.hpp>
 #include <hpx/runtime/threads/policies/lockfree_queue_backends.hpp>
+#include <hpx/runtime/threads/policies/static_task_ring.hpp>
 #include <hpx/runtime/threads/policies/thread_queue.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/runtime/threads/topology.hpp>
@@ -20,6 +21,7 @@
 #include <hpx/util/assert.hpp>
 #include <hpx/util/logging.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -42,9 +44,11 @@ namespace hpx { namespace threads { namespace policies
 #endif
 
     ///////////////////////////////////////////////////////////////////////////
-    /// The local_queue_scheduler maintains exactly one queue of work
+    /// The static_queue_scheduler maintains exactly one queue of work
     /// items (threads) per OS thread, where this OS thread pulls its next work
-    /// from.
+    /// from. Batches of tasks are split evenly over the OS threads and handed
+    /// to them directly, the OS threads create the HPX threads themselves.
+    /// This scheduler does not do any work stealing.
     template <typename Mutex = compat::mutex,
         typename PendingQueuing = lockfree_fifo,
         typename StagedQueuing = lockfree_fifo,
@@ -63,7 +67,15 @@ namespace hpx { namespace threads { namespace policies
                 typename base_type::init_parameter_type const& init,
                 bool deferred_initialization = true)
           : base_type(init, deferred_initialization)
-        {}
+        {
+            std::size_t ring_size = detail::get_static_ring_size();
+            if (ring_size != 0)
+            {
+                rings_.reserve(init.num_queues_);
+                for (std::size_t i = 0; i != init.num_queues_; ++i)
+                    rings_.emplace_back(new static_task_ring(ring_size));
+            }
+        }
 
         virtual bool has_thread_stealing() const override { return false; }
 
@@ -91,11 +103,105 @@ namespace hpx { namespace threads { namespace policies
                 if (result)
                     return true;
                 q->increment_num_pending_misses();
+
+                // create the next of the tasks handed to this OS thread
+                if (!rings_.empty() && rings_[num_thread]->pop(
+                        [&](thread_init_data& data)
+                        {
+                            result = q->create_thread_direct(
+                                data, thrd, throws);
+                        }))
+                {
+                    return result;
+                }
             }
 
             return false;
         }
 
+        /// Create a batch of threads. Normal priority tasks are split into
+        /// contiguous chunks, the i-th chunk is handed to the i-th OS thread
+        /// (tasks with a scheduling hint are handed to the OS thread it
+        /// refers to). This avoids staging the tasks and converting them
+        /// under the lock of the queue, tasks which do not fit are staged as
+        /// usual.
+        void create_threads(std::vector<thread_init_data>& data,
+            thread_state_enum initial_state, error_code& ec) override
+        {
+            if (rings_.empty() || initial_state != pending ||
+                (this->get_scheduler_mode() & policies::enable_elasticity))
+            {
+                base_type::create_threads(data, initial_state, ec);
+                return;
+            }
+
+            std::size_t queues_size = this->queues_.size();
+            std::size_t count = data.size();
+            std::size_t num_chunks = (std::min)(count, queues_size);
+
+            std::size_t begin = 0;
+            for (std::size_t i = 0; i != num_chunks; ++i)
+            {
+                std::size_t end = (count * (i + 1)) / num_chunks;
+                for (/**/; begin != end; ++begin)
+                {
+                    thread_init_data& d = data[begin];
+                    if (d.priority != thread_priority_normal ||
+                        d.schedulehint.mode == thread_schedule_hint_mode_numa)
+                    {
+                        bool run_now = d.priority == thread_priority_high ||
+                            d.priority == thread_priority_high_recursive ||
+                            d.priority == thread_priority_boost;
+
+                        this->create_thread(
+                            d, nullptr, initial_state, run_now, ec);
+                        if (&ec != &throws && ec)
+                            return;
+                        continue;
+                    }
+
+                    std::size_t num_thread = i;
+                    if (d.schedulehint.mode == thread_schedule_hint_mode_thread)
+                        num_thread = std::size_t(d.schedulehint.hint) %
+                            queues_size;
+
+                    if (!rings_[num_thread]->push(d))
+                    {
+                        this->queues_[num_thread]->create_thread(
+                            d, nullptr, initial_state, false, ec);
+                        if (&ec != &throws && ec)
+                            return;
+                    }
+                }
+            }
+
+            if (&ec != &throws)
+                ec = make_success_code();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The tasks handed to the OS threads are counted as staged tasks
+        std::int64_t get_queue_length(
+            std::size_t num_thread = std::size_t(-1)) const override
+        {
+            return base_type::get_queue_length(num_thread) +
+                get_ring_length(num_thread);
+        }
+
+        std::int64_t get_thread_count(thread_state_enum state = unknown,
+            thread_priority priority = thread_priority_default,
+            std::size_t num_thread = std::size_t(-1),
+            bool reset = false) const override
+        {
+            std::int64_t count = base_type::get_thread_count(
+                state, priority, num_thread, reset);
+
+            if (state == unknown || state == staged)
+                count += get_ring_length(num_thread);
+
+            return count;
+        }
+
         /// This is a function which gets called periodically by the thread
         /// manager to allow for maintenance tasks to be executed in the
         /// scheduler. Returns true if the OS thread calling this function
@@ -106,6 +212,10 @@ namespace hpx { namespace threads { namespace policies
             std::size_t queues_size = this->queues_.size();
             HPX_ASSERT(num_thread < queues_size);
 
+            // there are tasks left to be created by this OS thread
+            if (!rings_.empty() && !rings_[num_thread]->empty())
+                return false;
+
             std::size_t added = 0;
             bool result = true;
 
@@ -149,6 +259,27 @@ namespace hpx { namespace threads { namespace policies
 
             return result;
         }
+
+    protected:
+        std::int64_t get_ring_length(std::size_t num_thread) const
+        {
+            if (rings_.empty())
+                return 0;
+
+            if (std::size_t(-1) != num_thread)
+            {
+                HPX_ASSERT(num_thread < rings_.size());
+                return std::int64_t(rings_[num_thread]->size());
+            }
+
+            std::int64_t count = 0;
+            for (auto const& ring : rings_)
+                count += std::int64_t(ring->size());
+            return count;
+        }
+
+        // the tasks handed directly to each of the OS threads
+        std::vector<std::unique_ptr<static_task_ring> > rings_;
     };
 }}}
 
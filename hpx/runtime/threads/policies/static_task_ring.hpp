@@ -0,0 +1,186 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_POLICIES_STATIC_TASK_RING_HPP)
+#define HPX_RUNTIME_THREADS_POLICIES_STATIC_TASK_RING_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/threads/thread_init_data.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <boost/lexical_cast.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace threads { namespace policies
+{
+    namespace detail
+    {
+        // number of tasks each worker thread of the static schedulers can
+        // receive directly, zero disables the direct hand-off
+        inline std::size_t get_static_ring_size()
+        {
+            static std::size_t static_ring_size =
+                boost::lexical_cast<std::size_t>(hpx::get_config_entry(
+                    "hpx.thread_queue.static_ring_size", "256"));
+            return static_ring_size;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A bounded ring of task descriptions owned by one worker thread of a
+    // static scheduler. Any thread may push tasks, only the owning worker
+    // thread pops them and creates the HPX threads itself. The tasks are
+    // stored in place, pushing a task neither allocates nor locks.
+    //
+    // Every slot carries a sequence number telling whether it is free for
+    // the producer at a given position or holds the task for the consumer
+    // at that position, which lets producers reserve slots with a single
+    // compare-and-swap on the tail.
+    class static_task_ring
+    {
+        struct slot
+        {
+            std::atomic<std::size_t> seq_;
+            typename std::aligned_storage<sizeof(thread_init_data),
+                alignof(thread_init_data)>::type data_;
+
+            thread_init_data* get()
+            {
+                return reinterpret_cast<thread_init_data*>(&data_);
+            }
+        };
+
+    public:
+        // the capacity is rounded up to the next power of two
+        explicit static_task_ring(std::size_t capacity)
+          : mask_(0),
+            head_(0),
+            tail_(0)
+        {
+            std::size_t size = 1;
+            while (size < capacity)
+                size <<= 1;
+
+            mask_ = size - 1;
+            slots_.reset(new slot[size]);
+            for (std::size_t i = 0; i != size; ++i)
+                slots_[i].seq_.store(i, std::memory_order_relaxed);
+        }
+
+        static_task_ring(static_task_ring const&) = delete;
+        static_task_ring& operator=(static_task_ring const&) = delete;
+
+        ~static_task_ring()
+        {
+            // destroy the tasks which have never been run
+            std::size_t head = head_.load(std::memory_order_relaxed);
+            std::size_t tail = tail_.load(std::memory_order_relaxed);
+            for (/**/; head != tail; ++head)
+                slots_[head & mask_].get()->~thread_init_data();
+        }
+
+        // Move the given task into the ring, returns false if the ring is
+        // full (the task is left untouched), may be called from any thread.
+        bool push(thread_init_data& data)
+        {
+            std::size_t pos = tail_.load(std::memory_order_relaxed);
+            slot* s = nullptr;
+            for (;;)
+            {
+                s = &slots_[pos & mask_];
+                std::size_t seq = s->seq_.load(std::memory_order_acquire);
+                std::ptrdiff_t diff =
+                    static_cast<std::ptrdiff_t>(seq - pos);
+
+                if (diff == 0)
+                {
+                    if (tail_.compare_exchange_weak(pos, pos + 1,
+                            std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false;       // the ring is full
+                }
+                else
+                {
+                    pos = tail_.load(std::memory_order_relaxed);
+                }
+            }
+
+            new (s->get()) thread_init_data(std::move(data));
+            s->seq_.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Pass the oldest task to the given function and remove it from the
+        // ring afterwards, owner only.
+        template <typename F>
+        bool pop(F && f)
+        {
+            std::size_t pos = head_.load(std::memory_order_relaxed);
+            slot& s = slots_[pos & mask_];
+            if (s.seq_.load(std::memory_order_acquire) != pos + 1)
+                return false;
+
+            // release the slot even if the function throws
+            struct release_slot
+            {
+                ~release_slot()
+                {
+                    s_.get()->~thread_init_data();
+                    ring_.head_.store(pos_ + 1, std::memory_order_relaxed);
+                    s_.seq_.store(pos_ + ring_.mask_ + 1,
+                        std::memory_order_release);
+                }
+
+                static_task_ring& ring_;
+                slot& s_;
+                std::size_t pos_;
+            };
+
+            release_slot r = { *this, s, pos };
+            f(*s.get());
+            return true;
+        }
+
+        // The number of tasks in the ring, may be called from any thread
+        // (the result is approximate while tasks are pushed or popped).
+        std::size_t size() const
+        {
+            std::size_t head = head_.load(std::memory_order_relaxed);
+            std::size_t tail = tail_.load(std::memory_order_relaxed);
+            return tail > head ? tail - head : 0;
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+    private:
+        std::unique_ptr<slot[]> slots_;
+        std::size_t mask_;
+
+        // the consumer and the producers touch different cache lines
+        char pad0_[threads::get_cache_line_size()];
+        std::atomic<std::size_t> head_;
+        char pad1_[threads::get_cache_line_size()];
+        std::atomic<std::size_t> tail_;
+        char pad2_[threads::get_cache_line_size()];
+    };
+}}}
+
+#endif
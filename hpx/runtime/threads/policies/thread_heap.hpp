@@ -0,0 +1,142 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_THREADMANAGER_THREAD_HEAP_HPP)
+#define HPX_THREADMANAGER_THREAD_HEAP_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/thread_data.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace threads { namespace policies
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The thread_heap keeps the recycled thread objects (and their stacks) of
+    // one stack size class. The thread objects are kept in intrusive singly
+    // linked lists, one for each NUMA domain. Each thread object is returned
+    // to the list of the domain its stack was first touched in, which allows
+    // to hand out thread objects with a NUMA-local stack whenever possible.
+    //
+    // The thread_heap is not thread-safe, it is protected by the mutex of the
+    // owning thread_queue.
+    class thread_heap
+    {
+    public:
+        HPX_NON_COPYABLE(thread_heap);
+
+        explicit thread_heap(std::size_t num_domains = 1)
+          : heads_(num_domains == 0 ? 1 : num_domains, nullptr)
+          , count_(0)
+        {
+        }
+
+        bool empty() const
+        {
+            return count_ == 0;
+        }
+
+        std::size_t size() const
+        {
+            return count_;
+        }
+
+        std::size_t num_domains() const
+        {
+            return heads_.size();
+        }
+
+        // Add the given thread object to the list of the NUMA domain its
+        // stack belongs to.
+        void push(thread_data* thrd)
+        {
+            std::size_t domain = thrd->get_numa_domain();
+            if (domain >= heads_.size())
+                domain = 0;
+
+            thrd->set_next_recycled(heads_[domain]);
+            heads_[domain] = thrd;
+            ++count_;
+        }
+
+        // Retrieve a thread object, preferring one with a stack which was
+        // first touched in the given NUMA domain. The parameter 'local' will
+        // be set to whether the returned object is local to that domain.
+        // Returns nullptr if no thread object is available.
+        thread_data* pop(std::size_t domain, bool& local)
+        {
+            if (count_ == 0)
+                return nullptr;
+
+            if (domain >= heads_.size())
+                domain = 0;
+
+            local = true;
+            thread_data* thrd = pop_from(domain);
+            if (thrd == nullptr)
+            {
+                local = false;
+                for (std::size_t i = 0; i != heads_.size(); ++i)
+                {
+                    thrd = pop_from(i);
+                    if (thrd != nullptr)
+                        break;
+                }
+            }
+
+            HPX_ASSERT(thrd != nullptr);
+            return thrd;
+        }
+
+        // Remove all thread objects, invoking the given function for each of
+        // them.
+        template <typename F>
+        void clear(F && f)
+        {
+            for (thread_data*& head : heads_)
+            {
+                while (head != nullptr)
+                {
+                    thread_data* thrd = head;
+                    head = thrd->get_next_recycled();
+                    thrd->set_next_recycled(nullptr);
+                    f(thrd);
+                }
+            }
+            count_ = 0;
+        }
+
+        // Counters for recycled thread objects which were handed out to a
+        // thread running on the same (local) or a different (remote) NUMA
+        // domain as the one which first touched the stack.
+        HPX_EXPORT static std::int64_t get_local_reuse_count(bool reset);
+        HPX_EXPORT static std::int64_t get_remote_reuse_count(bool reset);
+
+        HPX_EXPORT static void increment_local_reuse_count();
+        HPX_EXPORT static void increment_remote_reuse_count();
+
+    private:
+        thread_data* pop_from(std::size_t domain)
+        {
+            thread_data* thrd = heads_[domain];
+            if (thrd != nullptr)
+            {
+                heads_[domain] = thrd->get_next_recycled();
+                thrd->set_next_recycled(nullptr);
+                --count_;
+            }
+            return thrd;
+        }
+
+        std::vector<thread_data*> heads_;
+        std::size_t count_;
+    };
+}}}
+
+#endif
@@ -11,16 +11,24 @@
 #include <hpx/compat/mutex.hpp>
 #include <hpx/error_code.hpp>
 #include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/runtime/resource/detail/partitioner.hpp>
+#include <hpx/runtime/threads/policies/cleanup_statistics.hpp>
 #include <hpx/runtime/threads/policies/lockfree_queue_backends.hpp>
 #include <hpx/runtime/threads/policies/queue_helpers.hpp>
+#include <hpx/runtime/threads/policies/sharded_thread_map.hpp>
+#include <hpx/runtime/threads/policies/thread_heap.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
+#include <hpx/runtime/threads/topology.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/block_profiler.hpp>
 #include <hpx/util/function.hpp>
 #include <hpx/util/get_and_reset_value.hpp>
 #include <hpx/util/high_resolution_clock.hpp>
-#include <hpx/util/internal_allocator.hpp>
+#include <hpx/util/lock_profiler.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+#include <hpx/util/tagged_allocator.hpp>
 #include <hpx/util/unlock_guard.hpp>
 
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
@@ -34,18 +42,26 @@
 #include <cstdint>
 #include <exception>
 #include <functional>
-#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
-#include <unordered_set>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace threads { namespace policies
 {
+#ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
+    ///////////////////////////////////////////////////////////////////////////
+    // We control whether to collect thread creation and cleanup times using
+    // this global bool. It will be set by any of the related performance
+    // counters or by the configuration setting hpx.thread_instrumentation.
+    // Once set it stays set, thus no race conditions will occur.
+    extern HPX_EXPORT bool maintain_creation_and_cleanup_rates;
+#endif
+
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
     ///////////////////////////////////////////////////////////////////////////
     // We control whether to collect queue wait times using this global bool.
@@ -60,57 +76,130 @@ namespace hpx { namespace threads { namespace policies
     // startup code
     extern bool minimal_deadlock_detection;
 #endif
+#if defined(HPX_COROUTINES_HAVE_EXTERNAL_STACKS)
+    ///////////////////////////////////////////////////////////////////////////
+    // We globally control whether new thread objects are placed at the top of
+    // their own stack using this global bool variable. It will be set once by
+    // the runtime configuration startup code
+    extern HPX_EXPORT bool fused_thread_data;
+#endif
 
     namespace detail
     {
-        inline int get_min_tasks_to_steal_pending()
+        // A thread queue limit which can be changed while the runtime is
+        // running by assigning a new value to its configuration entry (see
+        // hpx::set_config_entry), e.g. by the hpx::util::autotuner.
+        class thread_queue_limit
+        {
+        public:
+            thread_queue_limit(char const* key, std::string const& dflt)
+              : value_(boost::lexical_cast<int>(
+                    hpx::get_config_entry(key, dflt)))
+            {
+                hpx::set_config_entry_callback(key,
+                    [this](std::string const&, std::string const& value)
+                    {
+                        value_.store(util::safe_lexical_cast(value,
+                            value_.load(std::memory_order_relaxed)),
+                            std::memory_order_relaxed);
+                    });
+            }
+
+            int get() const
+            {
+                return value_.load(std::memory_order_relaxed);
+            }
+
+        private:
+            std::atomic<int> value_;
+        };
+
+        inline thread_queue_limit const& get_min_tasks_to_steal_pending()
         {
-            static int min_tasks_to_steal_pending =
-                boost::lexical_cast<int>(hpx::get_config_entry(
-                    "hpx.thread_queue.min_tasks_to_steal_pending", "0"));
+            static thread_queue_limit min_tasks_to_steal_pending(
+                "hpx.thread_queue.min_tasks_to_steal_pending", "0");
             return min_tasks_to_steal_pending;
         }
 
-        inline int get_min_tasks_to_steal_staged()
+        inline thread_queue_limit const& get_min_tasks_to_steal_staged()
         {
-            static int min_tasks_to_steal_staged =
-                boost::lexical_cast<int>(hpx::get_config_entry(
-                    "hpx.thread_queue.min_tasks_to_steal_staged", "10"));
+            static thread_queue_limit min_tasks_to_steal_staged(
+                "hpx.thread_queue.min_tasks_to_steal_staged", "10");
             return min_tasks_to_steal_staged;
         }
 
-        inline int get_min_add_new_count()
+        inline thread_queue_limit const& get_min_add_new_count()
         {
-            static int min_add_new_count =
-                boost::lexical_cast<int>(hpx::get_config_entry(
-                    "hpx.thread_queue.min_add_new_count", "10"));
+            static thread_queue_limit min_add_new_count(
+                "hpx.thread_queue.min_add_new_count", "10");
             return min_add_new_count;
         }
 
-        inline int get_max_add_new_count()
+        inline thread_queue_limit const& get_max_add_new_count()
         {
-            static int max_add_new_count =
-                boost::lexical_cast<int>(hpx::get_config_entry(
-                    "hpx.thread_queue.max_add_new_count", "10"));
+            static thread_queue_limit max_add_new_count(
+                "hpx.thread_queue.max_add_new_count", "10");
             return max_add_new_count;
         }
 
-        inline int get_max_delete_count()
+        inline thread_queue_limit const& get_max_delete_count()
         {
-            static int max_delete_count =
-                boost::lexical_cast<int>(hpx::get_config_entry(
-                    "hpx.thread_queue.max_delete_count", "1000"));
+            static thread_queue_limit max_delete_count(
+                "hpx.thread_queue.max_delete_count", "1000");
             return max_delete_count;
         }
 
-        inline int get_max_terminated_threads()
+        inline thread_queue_limit const& get_max_terminated_threads()
         {
-            static int max_terminated_threads =
-                boost::lexical_cast<int>(hpx::get_config_entry(
-                    "hpx.thread_queue.max_terminated_threads",
-                    std::to_string(HPX_SCHEDULER_MAX_TERMINATED_THREADS)));
+            static thread_queue_limit max_terminated_threads(
+                "hpx.thread_queue.max_terminated_threads",
+                std::to_string(HPX_SCHEDULER_MAX_TERMINATED_THREADS));
             return max_terminated_threads;
         }
+
+        inline std::size_t get_thread_map_shards()
+        {
+            static std::size_t thread_map_shards =
+                boost::lexical_cast<std::size_t>(hpx::get_config_entry(
+                    "hpx.thread_queue.thread_map_shards", "8"));
+            return thread_map_shards;
+        }
+
+        // Notify queue backends which need to know their owning worker
+        // thread (see lockfree_chase_lev_backend), all others are ignored.
+        template <typename Queue>
+        auto on_start_thread(Queue& queue, int)
+          -> decltype(queue.on_start_thread())
+        {
+            return queue.on_start_thread();
+        }
+
+        template <typename Queue>
+        void on_start_thread(Queue&, long)
+        {
+        }
+
+        inline std::size_t get_num_numa_domains()
+        {
+            static std::size_t num_numa_domains =
+                threads::get_topology().get_number_of_numa_nodes();
+            return num_numa_domains == 0 ? 1 : num_numa_domains;
+        }
+
+        // Return the NUMA domain of the worker thread invoking this function.
+        inline std::size_t get_current_numa_domain()
+        {
+            std::size_t num_thread = hpx::get_worker_thread_num();
+            if (num_thread == std::size_t(-1))
+                return 0;
+
+            auto& rp = resource::get_partitioner();
+            if (num_thread >= rp.get_num_threads())
+                return 0;
+
+            return rp.get_topology().get_numa_node_number(
+                rp.get_pu_num(num_thread));
+        }
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -153,31 +242,38 @@ namespace hpx { namespace threads { namespace policies
     {
     private:
         // we use a simple mutex to protect the data members for now
+#if defined(HPX_HAVE_LOCK_PROFILING)
+        // OS mutexes are wrapped to make them visible to the lock profiler
+        typedef typename std::conditional<
+                std::is_same<Mutex, compat::mutex>::value,
+                util::lock_profiling::profiled_mutex<Mutex>, Mutex
+            >::type mutex_type;
+#else
         typedef Mutex mutex_type;
+#endif
 
         // don't steal if less than this amount of tasks are left
-        int const min_tasks_to_steal_pending;
-        int const min_tasks_to_steal_staged;
+        detail::thread_queue_limit const& min_tasks_to_steal_pending;
+        detail::thread_queue_limit const& min_tasks_to_steal_staged;
 
         // create at least this amount of threads from tasks
-        int const min_add_new_count;
+        detail::thread_queue_limit const& min_add_new_count;
 
         // create not more than this amount of threads from tasks
-        int const max_add_new_count;
+        detail::thread_queue_limit const& max_add_new_count;
 
         // number of terminated threads to discard
-        int const max_delete_count;
+        detail::thread_queue_limit const& max_delete_count;
 
-        // number of terminated threads to collect before cleaning them up
-        int const max_terminated_threads;
+        // number of terminated threads to collect before the worker thread
+        // terminating a thread cleans them up itself instead of leaving this
+        // to the idle worker threads
+        detail::thread_queue_limit const& max_terminated_threads;
 
         // this is the type of a map holding all threads (except depleted ones)
-        using thread_map_type = std::unordered_set<thread_id_type,
-            std::hash<thread_id_type>, std::equal_to<thread_id_type>,
-            util::internal_allocator<thread_id_type>>;
+        using thread_map_type = sharded_thread_map<mutex_type>;
 
-        using thread_heap_type =
-            std::list<thread_id_type, util::internal_allocator<thread_id_type>>;
+        using thread_heap_type = thread_heap;
 
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
         typedef
@@ -259,27 +355,42 @@ namespace hpx { namespace threads { namespace policies
                 state = pending;
             }
 
-            // Check for an unused thread object.
+            // Check for an unused thread object, prefer one with a stack
+            // which is local to the NUMA domain of the calling thread.
+            std::size_t domain = detail::get_current_numa_domain();
             if (!heap->empty())
             {
                 // Take ownership of the thread object and rebind it.
-                thrd = heap->front();
-                heap->pop_front();
+                bool local = true;
+                thrd = thread_id_type(heap->pop(domain, local));
                 thrd->rebind(data, state);
+
+                if (local)
+                    thread_heap::increment_local_reuse_count();
+                else
+                    thread_heap::increment_remote_reuse_count();
             }
             else
             {
                 hpx::util::unlock_guard<Lock> ull(lk);
 
-                // Allocate a new thread object.
-                threads::thread_data* p = thread_alloc_.allocate(1);
-                new (p) threads::thread_data(data, this, state);
+                // Allocate a new thread object, the top of its stack is
+                // touched by the constructor of the coroutine.
+                threads::thread_data* p = allocate(data, this, state);
+                p->set_numa_domain(domain);
                 thrd = thread_id_type(p);
             }
         }
 
-        static util::internal_allocator<threads::thread_data> thread_alloc_;
-        static util::internal_allocator<task_description> task_description_alloc_;
+        typedef util::tagged_allocator<threads::thread_data,
+                util::allocation_accounting::thread_data>
+            thread_allocator_type;
+        typedef util::tagged_allocator<task_description,
+                util::allocation_accounting::thread_data>
+            task_description_allocator_type;
+
+        static thread_allocator_type thread_alloc_;
+        static task_description_allocator_type task_description_alloc_;
 
         ///////////////////////////////////////////////////////////////////////
         // add new threads if there is some amount of work available
@@ -316,10 +427,7 @@ namespace hpx { namespace threads { namespace policies
                 task_description_alloc_.deallocate(task, 1);
 
                 // add the new entry to the map of all threads
-                std::pair<thread_map_type::iterator, bool> p =
-                    thread_map_.insert(thrd);
-
-                if (HPX_UNLIKELY(!p.second)) {
+                if (HPX_UNLIKELY(!thread_map_.insert(thrd))) {
                     --addfrom->new_tasks_count_;
                     lk.unlock();
                     HPX_THROW_EXCEPTION(hpx::out_of_memory,
@@ -328,9 +436,8 @@ namespace hpx { namespace threads { namespace policies
                     return 0;
                 }
 
-                ++thread_map_count_;
-
-                // Decrement only after thread_map_count_ has been incremented
+                // Decrement only after the thread map count has been
+                // incremented
                 --addfrom->new_tasks_count_;
 
                 // only insert the thread into the work-items queue if it is in
@@ -343,7 +450,7 @@ namespace hpx { namespace threads { namespace policies
                 }
 
                 // this thread has to be in the map now
-                HPX_ASSERT(thread_map_.find(thrd) != thread_map_.end());
+                HPX_ASSERT(thread_map_.contains(thrd));
                 HPX_ASSERT(&thrd->get_queue<thread_queue>() == this);
             }
 
@@ -355,12 +462,14 @@ namespace hpx { namespace threads { namespace policies
 
         ///////////////////////////////////////////////////////////////////////
         bool add_new_always(std::size_t& added, thread_queue* addfrom,
-            std::unique_lock<mutex_type> &lk, bool steal = false)
+            std::unique_lock<mutex_type> &lk, bool steal = false,
+            bool steal_half = false)
         {
             HPX_ASSERT(lk.owns_lock());
 
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
-            util::tick_counter tc(add_new_time_);
+            util::tick_counter tc(
+                add_new_time_, maintain_creation_and_cleanup_rates);
 #endif
 
             // create new threads from pending tasks (if appropriate)
@@ -369,27 +478,39 @@ namespace hpx { namespace threads { namespace policies
             // if we are desperate (no work in the queues), add some even if the
             // map holds more than max_count
             if (HPX_LIKELY(max_count_)) {
-                std::size_t count = thread_map_.size();
-                if (max_count_ >= count + min_add_new_count) { //-V104
+                int const min_add_new = min_add_new_count.get();
+                std::size_t count =
+                    static_cast<std::size_t>(thread_map_.size());
+                if (max_count_ >= count + min_add_new) { //-V104
                     HPX_ASSERT(max_count_ - count <
                         static_cast<std::size_t>(
                             (std::numeric_limits<std::int64_t>::max)()
                         ));
                     add_count = static_cast<std::int64_t>(max_count_ - count);
-                    if (add_count < min_add_new_count)
-                        add_count = min_add_new_count;
-                    if (add_count > max_add_new_count)
-                        add_count = max_add_new_count;
+                    if (add_count < min_add_new)
+                        add_count = min_add_new;
+                    if (add_count > max_add_new_count.get())
+                        add_count = max_add_new_count.get();
                 }
                 else if (work_items_.empty()) {
-                    add_count = min_add_new_count;    // add this number of threads
-                    max_count_ += min_add_new_count;  // increase max_count //-V101
+                    add_count = min_add_new;    // add this number of threads
+                    max_count_ += min_add_new;  // increase max_count //-V101
                 }
                 else {
                     return false;
                 }
             }
 
+            // when stealing, move half of the staged tasks of the victim in
+            // one go
+            if (steal_half && addfrom != this)
+            {
+                std::int64_t half = (addfrom->new_tasks_count_.load(
+                    std::memory_order_relaxed) + 1) / 2;
+                if (half > 0)
+                    add_count = half;
+            }
+
             std::size_t addednew = add_new(add_count, addfrom, lk, steal);
             added += addednew;
             return addednew != 0;
@@ -401,37 +522,37 @@ namespace hpx { namespace threads { namespace policies
 
             if (stacksize == get_stack_size(thread_stacksize_small))
             {
-                thread_heap_small_.push_front(thrd);
+                thread_heap_small_.push(thrd.get());
             }
             else if (stacksize == get_stack_size(thread_stacksize_medium))
             {
-                thread_heap_medium_.push_front(thrd);
+                thread_heap_medium_.push(thrd.get());
             }
             else if (stacksize == get_stack_size(thread_stacksize_large))
             {
-                thread_heap_large_.push_front(thrd);
+                thread_heap_large_.push(thrd.get());
             }
             else if (stacksize == get_stack_size(thread_stacksize_huge))
             {
-                thread_heap_huge_.push_front(thrd);
+                thread_heap_huge_.push(thrd.get());
             }
             else
             {
                 switch(stacksize) {
                 case thread_stacksize_small:
-                    thread_heap_small_.push_front(thrd);
+                    thread_heap_small_.push(thrd.get());
                     break;
 
                 case thread_stacksize_medium:
-                    thread_heap_medium_.push_front(thrd);
+                    thread_heap_medium_.push(thrd.get());
                     break;
 
                 case thread_stacksize_large:
-                    thread_heap_large_.push_front(thrd);
+                    thread_heap_large_.push(thrd.get());
                     break;
 
                 case thread_stacksize_huge:
-                    thread_heap_huge_.push_front(thrd);
+                    thread_heap_huge_.push(thrd.get());
                     break;
 
                 default:
@@ -446,16 +567,22 @@ namespace hpx { namespace threads { namespace policies
         /// (state is terminated) are properly destroyed.
         ///
         /// This returns 'true' if there are no more terminated threads waiting
-        /// to be deleted.
-        bool cleanup_terminated_locked(bool delete_all = false)
+        /// to be deleted. If 'forced' is set, the cleanup is accounted for as
+        /// being done by a busy worker thread.
+        bool cleanup_terminated_locked(bool delete_all = false,
+            bool forced = false)
         {
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
-            util::tick_counter tc(cleanup_terminated_time_);
+            util::tick_counter tc(
+                cleanup_terminated_time_, maintain_creation_and_cleanup_rates);
 #endif
 
-            if (terminated_items_count_ == 0)
+            std::int64_t const count = terminated_items_count_;
+            if (count == 0)
                 return true;
 
+            std::uint64_t const start = util::high_resolution_clock::now();
+
             if (delete_all) {
                 // delete all threads
                 thread_data* todelete;
@@ -465,14 +592,10 @@ namespace hpx { namespace threads { namespace policies
                     --terminated_items_count_;
 
                     // this thread has to be in this map
-                    HPX_ASSERT(thread_map_.find(tid) != thread_map_.end());
-
-                    bool deleted = thread_map_.erase(tid) != 0;
+                    bool deleted = thread_map_.erase(tid);
                     HPX_ASSERT(deleted);
                     if (deleted) {
                         deallocate(todelete);
-                        --thread_map_count_;
-                        HPX_ASSERT(thread_map_count_ >= 0);
                     }
                 }
             }
@@ -481,7 +604,7 @@ namespace hpx { namespace threads { namespace policies
                 std::int64_t delete_count =
                     (std::max)(
                         static_cast<std::int64_t>(terminated_items_count_ / 10),
-                        static_cast<std::int64_t>(max_delete_count));
+                        static_cast<std::int64_t>(max_delete_count.get()));
 
                 thread_data* todelete;
                 while (delete_count && terminated_items_.pop(todelete))
@@ -489,20 +612,22 @@ namespace hpx { namespace threads { namespace policies
                     thread_id_type tid(todelete);
                     --terminated_items_count_;
 
-                    thread_map_type::iterator it = thread_map_.find(tid);
-
                     // this thread has to be in this map
-                    HPX_ASSERT(it != thread_map_.end());
-
-                    recycle_thread(*it);
-
-                    thread_map_.erase(it);
-                    --thread_map_count_;
-                    HPX_ASSERT(thread_map_count_ >= 0);
+                    bool deleted = thread_map_.erase(tid);
+                    HPX_ASSERT(deleted);
+                    if (deleted) {
+                        recycle_thread(tid);
+                    }
 
                     --delete_count;
                 }
             }
+
+            cleanup_statistics::record(forced,
+                count - terminated_items_count_,
+                static_cast<std::int64_t>(
+                    util::high_resolution_clock::now() - start));
+
             return terminated_items_count_ == 0;
         }
 
@@ -544,7 +669,7 @@ namespace hpx { namespace threads { namespace policies
             max_add_new_count(detail::get_max_add_new_count()),
             max_delete_count(detail::get_max_delete_count()),
             max_terminated_threads(detail::get_max_terminated_threads()),
-            thread_map_count_(0),
+            thread_map_(detail::get_thread_map_shards()),
             work_items_(128, queue_num),
             work_items_count_(0),
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
@@ -562,10 +687,10 @@ namespace hpx { namespace threads { namespace policies
             new_tasks_wait_(0),
             new_tasks_wait_count_(0),
 #endif
-            thread_heap_small_(),
-            thread_heap_medium_(),
-            thread_heap_large_(),
-            thread_heap_huge_(),
+            thread_heap_small_(detail::get_num_numa_domains()),
+            thread_heap_medium_(detail::get_num_numa_domains()),
+            thread_heap_large_(detail::get_num_numa_domains()),
+            thread_heap_huge_(detail::get_num_numa_domains()),
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
             add_new_time_(0),
             cleanup_terminated_time_(0),
@@ -581,26 +706,63 @@ namespace hpx { namespace threads { namespace policies
             add_new_logger_("thread_queue::add_new")
         {}
 
+        static threads::thread_data* allocate(threads::thread_init_data& data,
+            thread_queue* queue, thread_state_enum state)
+        {
+            using threads::thread_data;
+#if defined(HPX_COROUTINES_HAVE_EXTERNAL_STACKS)
+            if (fused_thread_data)
+            {
+                // Place the thread object right above the context at the top
+                // of its stack, this saves the separate allocation and keeps
+                // the thread object and the context in adjacent cache lines.
+                namespace posix = coroutines::detail::posix;
+
+                std::size_t size = data.stacksize;
+                void* stack = posix::alloc_stack(size);
+                void* p = static_cast<char*>(stack) + size -
+                    thread_data::fused_size();
+                try {
+                    return new (p) thread_data(data, queue, state, stack);
+                }
+                catch (...) {
+                    posix::free_stack(stack, size);
+                    throw;
+                }
+            }
+#endif
+            thread_data* p = thread_alloc_.allocate(1);
+            new (p) thread_data(data, queue, state);
+            return p;
+        }
+
         static void deallocate(threads::thread_data* p)
         {
             using threads::thread_data;
+#if defined(HPX_COROUTINES_HAVE_EXTERNAL_STACKS)
+            if (fused_thread_data)
+            {
+                // the stack outlives the thread object living on it
+                namespace posix = coroutines::detail::posix;
+
+                std::size_t size = p->get_stack_size();
+                void* stack = reinterpret_cast<char*>(p) +
+                    thread_data::fused_size() - size;
+                p->~thread_data();
+                posix::free_stack(stack, size);
+                return;
+            }
+#endif
             p->~thread_data();
             thread_alloc_.deallocate(p, 1);
         }
 
         ~thread_queue()
         {
-            for(auto t: thread_heap_small_)
-                deallocate(t.get());
-
-            for(auto t: thread_heap_medium_)
-                deallocate(t.get());
-
-            for(auto t: thread_heap_large_)
-                deallocate(t.get());
-
-            for(auto t: thread_heap_huge_)
-                deallocate(t.get());
+            thread_heap_small_.clear(&thread_queue::deallocate);
+            thread_heap_medium_.clear(&thread_queue::deallocate);
+            thread_heap_large_.clear(&thread_queue::deallocate);
+            thread_heap_huge_.clear(&thread_queue::deallocate);
         }
 
         void set_max_count(std::size_t max_count = max_thread_count)
@@ -744,25 +906,22 @@ namespace hpx { namespace threads { namespace policies
                 // created, as it might have that the current HPX thread gets
                 // suspended.
                 {
-                    std::unique_lock<mutex_type> lk(mtx_);
-
-                    create_thread_object(thrd, data, initial_state, lk);
-
-                    // add a new entry in the map for this thread
-                    std::pair<thread_map_type::iterator, bool> p =
-                        thread_map_.insert(thrd);
+                    {
+                        std::unique_lock<mutex_type> lk(mtx_);
+                        create_thread_object(thrd, data, initial_state, lk);
+                    }
 
-                    if (HPX_UNLIKELY(!p.second)) {
-                        lk.unlock();
+                    // add a new entry in the map for this thread, this is
+                    // protected by the lock of the corresponding shard only
+                    if (HPX_UNLIKELY(!thread_map_.insert(thrd))) {
                         HPX_THROWS_IF(ec, hpx::out_of_memory,
                             "threadmanager::register_thread",
                             "Couldn't add new thread to the map of threads");
                         return;
                     }
-                    ++thread_map_count_;
 
                     // this thread has to be in the map now
-                    HPX_ASSERT(thread_map_.find(thrd) != thread_map_.end());
+                    HPX_ASSERT(thread_map_.contains(thrd));
                     HPX_ASSERT(&thrd->get_queue<thread_queue>() == this);
 
                     // push the new thread in the pending queue thread
@@ -794,6 +953,60 @@ namespace hpx { namespace threads { namespace policies
                 ec = make_success_code();
         }
 
+        // Register task descriptions for the given count of consecutive
+        // elements of data for later thread creation.
+        void create_threads(thread_init_data* data, std::size_t count,
+            thread_state_enum initial_state, error_code& ec)
+        {
+            new_tasks_count_ += std::int64_t(count);
+
+#ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
+            std::uint64_t now = util::high_resolution_clock::now();
+#endif
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                task_description* td = task_description_alloc_.allocate(1);
+#ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
+                new (td) task_description(std::move(data[i]), initial_state,
+                    now);
+#else
+                new (td) task_description(std::move(data[i]), initial_state); //-V106
+#endif
+                new_tasks_.push(td);
+            }
+
+            if (&ec != &throws)
+                ec = make_success_code();
+        }
+
+        // Create a new pending thread which is returned instead of being
+        // scheduled, the calling worker thread is expected to run it right
+        // away.
+        bool create_thread_direct(thread_init_data& data,
+            threads::thread_data*& thrd, error_code& ec)
+        {
+            threads::thread_id_type id;
+            {
+                std::unique_lock<mutex_type> lk(mtx_);
+                create_thread_object(id, data, pending, lk);
+            }
+
+            if (HPX_UNLIKELY(!thread_map_.insert(id))) {
+                HPX_THROWS_IF(ec, hpx::out_of_memory,
+                    "thread_queue::create_thread_direct",
+                    "Couldn't add new thread to the map of threads");
+                return false;
+            }
+
+            HPX_ASSERT(thread_map_.contains(id));
+            HPX_ASSERT(&id->get_queue<thread_queue>() == this);
+
+            thrd = id.get();
+            if (&ec != &throws)
+                ec = make_success_code();
+            return true;
+        }
+
         void move_work_items_from(thread_queue *src, std::int64_t count)
         {
             thread_description* trd;
@@ -858,7 +1071,7 @@ namespace hpx { namespace threads { namespace policies
             std::int64_t work_items_count =
                 work_items_count_.load(std::memory_order_relaxed);
 
-            if (allow_stealing && min_tasks_to_steal_pending > work_items_count)
+            if (allow_stealing && min_tasks_to_steal_pending.get() > work_items_count)
             {
                 return false;
             }
@@ -908,10 +1121,14 @@ namespace hpx { namespace threads { namespace policies
             HPX_ASSERT(&thrd->get_queue<thread_queue>() == this);
             terminated_items_.push(thrd);
 
+            // the terminated threads are cleaned up by the idle worker
+            // threads, clean up some of them right away only if those don't
+            // keep up
             std::int64_t count = ++terminated_items_count_;
-            if (count > max_terminated_threads)
+            if (count > max_terminated_threads.get())
             {
-                cleanup_terminated(true);   // clean up all terminated threads
+                std::lock_guard<mutex_type> lk(mtx_);
+                cleanup_terminated_locked(false, true);
             }
         }
 
@@ -926,43 +1143,43 @@ namespace hpx { namespace threads { namespace policies
                 return new_tasks_count_;
 
             if (unknown == state)
-                return thread_map_count_ + new_tasks_count_ - terminated_items_count_;
-
-            // acquire lock only if absolutely necessary
-            std::lock_guard<mutex_type> lk(mtx_);
-
-            std::int64_t num_threads = 0;
-            thread_map_type::const_iterator end = thread_map_.end();
-            for (thread_map_type::const_iterator it = thread_map_.begin();
-                 it != end; ++it)
             {
-                if ((*it)->get_state().state() == state)
-                    ++num_threads;
+                return thread_map_.size() + new_tasks_count_ -
+                    terminated_items_count_;
             }
+
+            // the shards of the thread map are locked only if absolutely
+            // necessary
+            std::int64_t num_threads = 0;
+            thread_map_.for_each(
+                [&](thread_id_type const& id)
+                {
+                    if (id->get_state().state() == state)
+                        ++num_threads;
+                });
             return num_threads;
         }
 
         ///////////////////////////////////////////////////////////////////////
         void abort_all_suspended_threads()
         {
-            std::lock_guard<mutex_type> lk(mtx_);
-            thread_map_type::iterator end =  thread_map_.end();
-            for (thread_map_type::iterator it = thread_map_.begin();
-                 it != end; ++it)
-            {
-                if ((*it)->get_state().state() == suspended)
+            thread_map_.for_each(
+                [this](thread_id_type const& id)
                 {
-                    (*it)->set_state(pending, wait_abort);
-                    schedule_thread((*it).get());
-                }
-            }
+                    if (id->get_state().state() == suspended)
+                    {
+                        id->set_state(pending, wait_abort);
+                        schedule_thread(id.get());
+                    }
+                });
         }
 
         bool enumerate_threads(
             util::function_nonser<bool(thread_id_type)> const& f,
             thread_state_enum state = unknown) const
         {
-            std::uint64_t count = thread_map_count_;
+            std::uint64_t count =
+                static_cast<std::uint64_t>(thread_map_.size());
             if (state == terminated)
             {
                 count = terminated_items_count_;
@@ -980,24 +1197,20 @@ namespace hpx { namespace threads { namespace policies
 
             if (state == unknown)
             {
-                std::lock_guard<mutex_type> lk(mtx_);
-                thread_map_type::const_iterator end =  thread_map_.end();
-                for (thread_map_type::const_iterator it = thread_map_.begin();
-                     it != end; ++it)
-                {
-                    ids.push_back(*it);
-                }
+                thread_map_.for_each(
+                    [&](thread_id_type const& id)
+                    {
+                        ids.push_back(id);
+                    });
             }
             else
             {
-                std::lock_guard<mutex_type> lk(mtx_);
-                thread_map_type::const_iterator end =  thread_map_.end();
-                for (thread_map_type::const_iterator it = thread_map_.begin();
-                     it != end; ++it)
-                {
-                    if ((*it)->get_state().state() == state)
-                        ids.push_back(*it);
-                }
+                thread_map_.for_each(
+                    [&](thread_id_type const& id)
+                    {
+                        if (id->get_state().state() == state)
+                            ids.push_back(id);
+                    });
             }
 
             // now invoke callback function for all matching threads
@@ -1014,9 +1227,12 @@ namespace hpx { namespace threads { namespace policies
         /// manager to allow for maintenance tasks to be executed in the
         /// scheduler. Returns true if the OS thread calling this function
         /// has to be terminated (i.e. no more work has to be done).
+        /// If steal_half is set, half of the staged tasks of addfrom are
+        /// converted at once.
         inline bool wait_or_add_new(bool running,
             std::int64_t& idle_loop_count, std::size_t& added,
-            thread_queue* addfrom = nullptr, bool steal = false) HPX_HOT
+            thread_queue* addfrom = nullptr, bool steal = false,
+            bool steal_half = false) HPX_HOT
         {
             // try to generate new threads from task lists, but only if our
             // own list of threads is empty
@@ -1027,7 +1243,7 @@ namespace hpx { namespace threads { namespace policies
                 {
                     // don't try to steal if there are only a few tasks left on
                     // this queue
-                    if (running && min_tasks_to_steal_staged >
+                    if (running && min_tasks_to_steal_staged.get() >
                         addfrom->new_tasks_count_.load(std::memory_order_relaxed))
                     {
                         return false;
@@ -1057,28 +1273,26 @@ namespace hpx { namespace threads { namespace policies
                     return false;            // avoid long wait on lock
 
                 // stop running after all HPX threads have been terminated
-                bool added_new = add_new_always(added, addfrom, lk, steal);
+                bool added_new =
+                    add_new_always(added, addfrom, lk, steal, steal_half);
                 if (!added_new) {
-                    // Before exiting each of the OS threads deletes the
-                    // remaining terminated HPX threads
+                    // This worker thread is idle, clean up some of the
+                    // terminated HPX threads. Before exiting each of the OS
+                    // threads deletes all of the remaining ones.
                     // REVIEW: Should we be doing this if we are stealing?
-                    bool canexit = cleanup_terminated_locked(true);
+                    bool canexit = cleanup_terminated_locked(!running);
                     if (!running && canexit) {
                         // we don't have any registered work items anymore
                         //do_some_work();       // notify possibly waiting threads
                         return true;            // terminate scheduling loop
                     }
-                    return false;
-                }
-                else
-                {
-                    cleanup_terminated_locked();
-                    return false;
                 }
+                return false;
             }
 
-            bool canexit = cleanup_terminated(true);
-            if (!running && canexit)
+            // there is work to do, leave the terminated threads to the idle
+            // worker threads
+            if (!running && cleanup_terminated(true))
             {
                 // we don't have any registered work items anymore
                 return true; // terminate scheduling loop
@@ -1095,8 +1309,14 @@ namespace hpx { namespace threads { namespace policies
             return false;
 #else
             if (minimal_deadlock_detection) {
-                std::lock_guard<mutex_type> lk(mtx_);
-                return detail::dump_suspended_threads(num_thread, thread_map_
+                std::vector<thread_id_type> ids;
+                ids.reserve(static_cast<std::size_t>(thread_map_.size()));
+                thread_map_.for_each(
+                    [&](thread_id_type const& id)
+                    {
+                        ids.push_back(id);
+                    });
+                return detail::dump_suspended_threads(num_thread, ids
                   , idle_loop_count, running);
             }
             return false;
@@ -1104,7 +1324,10 @@ namespace hpx { namespace threads { namespace policies
         }
 
         ///////////////////////////////////////////////////////////////////////
-        void on_start_thread(std::size_t num_thread) {}
+        void on_start_thread(std::size_t num_thread)
+        {
+            detail::on_start_thread(work_items_, 0);
+        }
         void on_stop_thread(std::size_t num_thread) {}
         void on_error(std::size_t num_thread, std::exception_ptr const& e) {}
 
@@ -1112,7 +1335,11 @@ namespace hpx { namespace threads { namespace policies
         mutable mutex_type mtx_;            // mutex protecting the members
 
         thread_map_type thread_map_;        // mapping of thread id's to HPX-threads
-        std::atomic<std::int64_t> thread_map_count_; // overall count of work items
+
+        // The lists below are accessed by different threads (the owning
+        // worker, the threads scheduling new work, and the thieves), keep
+        // each of them and its counter on separate cache lines.
+        char pad0_[threads::get_cache_line_size()];
 
         work_items_type work_items_;        // list of active work items
         std::atomic<std::int64_t> work_items_count_; // count of active work items
@@ -1122,10 +1349,15 @@ namespace hpx { namespace threads { namespace policies
         std::atomic<std::int64_t> work_items_wait_count_; // overall number of
                                                           // work items in queue
 #endif
+        char pad1_[threads::get_cache_line_size()];
+
         terminated_items_type terminated_items_;    // list of terminated threads
         std::atomic<std::int64_t> terminated_items_count_; // count of terminated items
 
         std::size_t max_count_;     // maximum number of existing HPX-threads
+
+        char pad2_[threads::get_cache_line_size()];
+
         task_items_type new_tasks_; // list of new tasks to run
 
         std::atomic<std::int64_t> new_tasks_count_; // count of new tasks to run
@@ -1133,6 +1365,7 @@ namespace hpx { namespace threads { namespace policies
         std::atomic<std::int64_t> new_tasks_wait_;  // overall wait time of new tasks
         std::atomic<std::int64_t> new_tasks_wait_count_; // overall number tasks waited
 #endif
+        char pad3_[threads::get_cache_line_size()];
 
         thread_heap_type thread_heap_small_;
         thread_heap_type thread_heap_medium_;
@@ -1167,13 +1400,15 @@ namespace hpx { namespace threads { namespace policies
     ///////////////////////////////////////////////////////////////////////////
     template <typename Mutex, typename PendingQueuing, typename StagedQueuing,
         typename TerminatedQueuing>
-    util::internal_allocator<threads::thread_data> thread_queue<Mutex,
-        PendingQueuing, StagedQueuing, TerminatedQueuing>::thread_alloc_;
+    typename thread_queue<Mutex, PendingQueuing, StagedQueuing,
+            TerminatedQueuing>::thread_allocator_type
+        thread_queue<Mutex, PendingQueuing, StagedQueuing,
+            TerminatedQueuing>::thread_alloc_;
 
     template <typename Mutex, typename PendingQueuing, typename StagedQueuing,
         typename TerminatedQueuing>
-    util::internal_allocator<typename thread_queue<Mutex, PendingQueuing,
-            StagedQueuing, TerminatedQueuing>::task_description>
+    typename thread_queue<Mutex, PendingQueuing, StagedQueuing,
+            TerminatedQueuing>::task_description_allocator_type
         thread_queue<Mutex, PendingQueuing, StagedQueuing,
             TerminatedQueuing>::task_description_alloc_;
 }}}
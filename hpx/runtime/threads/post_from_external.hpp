@@ -0,0 +1,121 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file post_from_external.hpp
+
+#if !defined(HPX_RUNTIME_THREADS_POST_FROM_EXTERNAL_HPP)
+#define HPX_RUNTIME_THREADS_POST_FROM_EXTERNAL_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/error_code.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/runtime/threads/detail/external_inbox.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/util/thread_description.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx
+{
+    namespace detail
+    {
+        template <typename F>
+        std::unique_ptr<threads::detail::external_task>
+        make_external_task(F && f)
+        {
+            threads::thread_function_type thread_func(
+                applier::detail::thread_function_nullary<
+                    typename std::decay<F>::type>{std::forward<F>(f)});
+
+            return std::unique_ptr<threads::detail::external_task>(
+                new threads::detail::external_task(std::move(thread_func),
+                    util::thread_description("post_from_external")));
+        }
+    }
+
+    /// Schedule the given function for execution on a new HPX thread of the
+    /// default thread pool. In contrast to \a hpx::apply this may be
+    /// called from any OS thread, also from threads which are not known to
+    /// the runtime (for instance the callback threads of a networking
+    /// library). The function never blocks and never takes a lock, the work
+    /// is handed to one of the worker threads with a single atomic operation
+    /// and is turned into an HPX thread by that worker.
+    ///
+    /// \param f    The function to execute, it is invoked without arguments.
+    /// \param ec   [in,out] this represents the error status on exit, if
+    ///             this is pre-initialized to \a hpx#throws the function
+    ///             will throw on error instead.
+    ///
+    /// \note The function reports an error (and drops \a f) if the runtime
+    ///       is not running. Work submitted concurrently with the shutdown
+    ///       of the runtime may be dropped silently.
+    ///
+    template <typename F>
+    void post_from_external(F && f, error_code& ec = throws)
+    {
+        std::unique_ptr<threads::detail::external_task> task =
+            detail::make_external_task(std::forward<F>(f));
+
+        if (!threads::detail::external_inbox::get().push(
+                task.get(), task.get()))
+        {
+            HPX_THROWS_IF(ec, invalid_status, "hpx::post_from_external",
+                "the runtime is not running");
+            return;
+        }
+        task.release();
+
+        if (&ec != &throws)
+            ec = make_success_code();
+    }
+
+    /// Schedule all functions in the range [first, last) for execution on
+    /// new HPX threads of the default thread pool, see
+    /// \a hpx::post_from_external. The functions are distributed over the
+    /// worker threads, each worker receives its share with a single atomic
+    /// operation.
+    ///
+    /// \param first    The beginning of the range of functions to execute,
+    ///                 the functions are moved from.
+    /// \param last     The end of the range of functions to execute.
+    /// \param ec       [in,out] this represents the error status on exit, if
+    ///                 this is pre-initialized to \a hpx#throws the function
+    ///                 will throw on error instead.
+    ///
+    template <typename Iter>
+    void post_from_external(Iter first, Iter last, error_code& ec = throws)
+    {
+        std::vector<std::unique_ptr<threads::detail::external_task> > tasks;
+        tasks.reserve(std::distance(first, last));
+        for (/**/; first != last; ++first)
+            tasks.push_back(detail::make_external_task(std::move(*first)));
+
+        if (tasks.empty())
+        {
+            if (&ec != &throws)
+                ec = make_success_code();
+            return;
+        }
+
+        if (!threads::detail::external_inbox::get().push_bulk(
+                tasks.data(), tasks.size()))
+        {
+            HPX_THROWS_IF(ec, invalid_status, "hpx::post_from_external",
+                "the runtime is not running");
+            return;
+        }
+
+        if (&ec != &throws)
+            ec = make_success_code();
+    }
+}
+
+#endif
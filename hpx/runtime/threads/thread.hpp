@@ -10,6 +10,7 @@
 #include <hpx/exception_fwd.hpp>
 #include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/lcos_fwd.hpp>
+#include <hpx/runtime/threads/detail/time_slice.hpp>
 #include <hpx/runtime/threads/thread_data_fwd.hpp>
 #include <hpx/runtime_fwd.hpp>
 #include <hpx/util/deferred_call.hpp>
@@ -197,6 +198,14 @@ namespace hpx
         HPX_API_EXPORT void yield() noexcept;
         HPX_API_EXPORT void yield_to(thread::id) noexcept;
 
+        /// Yield the calling thread if it has used up its time slice. This
+        /// does nothing unless the thread runs on a thread pool created with
+        /// threads::policies::time_slicing.
+        inline void preemption_point()
+        {
+            threads::detail::yield_if_time_slice_expired();
+        }
+
         // extensions
         HPX_API_EXPORT threads::thread_priority get_priority();
         HPX_API_EXPORT std::ptrdiff_t get_stack_size();
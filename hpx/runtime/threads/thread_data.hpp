@@ -23,6 +23,8 @@
 #include <hpx/util/function.hpp>
 #include <hpx/util/logging.hpp>
 #include <hpx/util/spinlock_pool.hpp>
+#include <hpx/util/steady_clock.hpp>
+#include <hpx/util/task_graph_profiler.hpp>
 #include <hpx/util/thread_description.hpp>
 #if defined(HPX_HAVE_APEX)
 #include <hpx/util/apex.hpp>
@@ -356,6 +358,15 @@ namespace hpx { namespace threads
         }
 #endif
 
+#ifdef HPX_HAVE_TASK_GRAPH_PROFILER
+        /// Return the data recorded for this thread by the task graph
+        /// profiler
+        util::task_graph::thread_info& get_task_graph_info()
+        {
+            return task_graph_info_;
+        }
+#endif
+
 #ifdef HPX_HAVE_THREAD_MINIMAL_DEADLOCK_DETECTION
         void set_marked_state(thread_state_enum mark) const
         {
@@ -447,6 +458,21 @@ namespace hpx { namespace threads
             priority_ = priority;
         }
 
+        // The deadline is taken into account the next time the thread is
+        // scheduled.
+        util::steady_clock::time_point get_deadline() const
+        {
+            return deadline_;
+        }
+        void set_deadline(util::steady_clock::time_point const& deadline)
+        {
+            deadline_ = deadline;
+        }
+        bool has_deadline() const
+        {
+            return deadline_ != (util::steady_clock::time_point::max)();
+        }
+
         // handle thread interruption
         bool interruption_requested() const
         {
@@ -496,12 +522,43 @@ namespace hpx { namespace threads
             return stacksize_;
         }
 
+        // Return the lowest and the highest address of the stack of this
+        // thread, both are nullptr if they are not known.
+        std::pair<void*, void*> get_stack_bounds() const
+        {
+            return coroutine_.get_stack_bounds();
+        }
+
         template <typename ThreadQueue>
         ThreadQueue& get_queue()
         {
             return *static_cast<ThreadQueue *>(queue_);
         }
 
+        /// Return the NUMA domain the stack of this thread was first touched
+        /// in
+        std::size_t get_numa_domain() const
+        {
+            return numa_domain_;
+        }
+
+        void set_numa_domain(std::size_t domain)
+        {
+            numa_domain_ = static_cast<std::uint32_t>(domain);
+        }
+
+        /// Access the link used by the thread queues to keep track of this
+        /// thread object while it is waiting to be recycled
+        thread_data* get_next_recycled() const
+        {
+            return next_recycled_;
+        }
+
+        void set_next_recycled(thread_data* next)
+        {
+            next_recycled_ = next;
+        }
+
         /// \brief Execute the thread function
         ///
         /// \returns        This function returns the thread state the thread
@@ -511,9 +568,38 @@ namespace hpx { namespace threads
         coroutine_type::result_type operator()()
         {
             HPX_ASSERT(this == coroutine_.get_thread_id().get());
+            if (run_to_completion_)
+            {
+                return coroutine_.run_inline(set_state_ex(wait_signaled),
+                    [this](coroutine_type::result_type arg)
+                    {
+                        return this->yield_inline(arg);
+                    });
+            }
             return coroutine_(set_state_ex(wait_signaled));
         }
 
+        /// Return whether this thread is executed directly on the stack of
+        /// the scheduling loop
+        bool runs_to_completion() const
+        {
+            return run_to_completion_;
+        }
+
+        /// Resume a run-to-completion thread which waits in place for being
+        /// made pending again, returns false if this is not such a thread.
+        bool resume_inline(thread_state_ex_enum new_state_ex)
+        {
+            if (!run_to_completion_)
+                return false;
+
+            // a resume request issued before the thread started waiting is
+            // kept and consumed as soon as it tries to wait
+            inline_state_.store(
+                std::int32_t(new_state_ex), std::memory_order_release);
+            return true;
+        }
+
         thread_id_type get_thread_id() const
         {
             HPX_ASSERT(this == coroutine_.get_thread_id().get());
@@ -568,37 +654,55 @@ namespace hpx { namespace threads
         /// This function will be called when the thread is about to be deleted
         //virtual void reset() {}
 
-        /// Construct a new \a thread
+        /// Number of bytes at the top of a stack occupied by a thread object
+        /// which is placed on its own stack (see thread_queue).
+        static constexpr std::ptrdiff_t fused_size()
+        {
+            return (sizeof(thread_data) + 63) & ~std::ptrdiff_t(63);
+        }
+
+        /// Construct a new \a thread, if \a stack is given the thread runs
+        /// on that stack, which then has to hold the thread object itself at
+        /// its top (the last \a fused_size() bytes).
         thread_data(thread_init_data& init_data,
-            void* queue, thread_state_enum newstate)
+            void* queue, thread_state_enum newstate, void* stack = nullptr)
           : current_state_(thread_state(newstate, wait_signaled)),
+            queue_(queue),
+            scheduler_base_(init_data.scheduler_base),
+            next_recycled_(nullptr),
+            stacksize_(init_data.stacksize),
+            deadline_(init_data.deadline),
+            priority_(init_data.priority),
+            inline_state_(inline_running),
+            numa_domain_(0),
+            run_to_completion_(init_data.run_to_completion),
+            requested_interrupt_(false),
+            enabled_interrupt_(true),
+            ran_exit_funcs_(false),
+            coroutine_(std::move(init_data.func),
+                thread_id_type(this_()), init_data.stacksize, stack,
+                stack != nullptr ? fused_size() : 0)
 #ifdef HPX_HAVE_THREAD_TARGET_ADDRESS
-            component_id_(init_data.lva),
+          , component_id_(init_data.lva)
 #endif
 #ifdef HPX_HAVE_THREAD_DESCRIPTION
-            description_(init_data.description),
-            lco_description_(),
+          , description_(init_data.description)
+          , lco_description_()
 #endif
 #ifdef HPX_HAVE_THREAD_PARENT_REFERENCE
-            parent_locality_id_(init_data.parent_locality_id),
-            parent_thread_id_(init_data.parent_id),
-            parent_thread_phase_(init_data.parent_phase),
+          , parent_locality_id_(init_data.parent_locality_id)
+          , parent_thread_id_(init_data.parent_id)
+          , parent_thread_phase_(init_data.parent_phase)
+#endif
+#ifdef HPX_HAVE_TASK_GRAPH_PROFILER
+          , task_graph_info_(init_data.task_graph_info)
 #endif
 #ifdef HPX_HAVE_THREAD_MINIMAL_DEADLOCK_DETECTION
-            marked_state_(unknown),
+          , marked_state_(unknown)
 #endif
 #ifdef HPX_HAVE_THREAD_BACKTRACE_ON_SUSPENSION
-            backtrace_(nullptr),
+          , backtrace_(nullptr)
 #endif
-            priority_(init_data.priority),
-            requested_interrupt_(false),
-            enabled_interrupt_(true),
-            ran_exit_funcs_(false),
-            scheduler_base_(init_data.scheduler_base),
-            stacksize_(init_data.stacksize),
-            coroutine_(std::move(init_data.func),
-                thread_id_type(this_()), init_data.stacksize),
-            queue_(queue)
         {
             LTM_(debug) << "thread::thread(" << this << "), description("
                         << get_description() << ")";
@@ -621,10 +725,15 @@ namespace hpx { namespace threads
             set_apex_data(init_data.apex_data);
 #endif
             HPX_ASSERT(init_data.stacksize != 0);
+            HPX_ASSERT(stack == nullptr ||
+                static_cast<char*>(stack) + init_data.stacksize ==
+                    reinterpret_cast<char*>(this) + fused_size());
             HPX_ASSERT(coroutine_.is_ready());
         }
 
     private:
+        thread_state_ex_enum yield_inline(coroutine_type::result_type arg);
+
         void rebind_base(thread_init_data& init_data, thread_state_enum newstate)
         {
             free_thread_exit_callbacks();
@@ -643,6 +752,9 @@ namespace hpx { namespace threads
             parent_thread_id_ = init_data.parent_id;
             parent_thread_phase_ = init_data.parent_phase;
 #endif
+#ifdef HPX_HAVE_TASK_GRAPH_PROFILER
+            task_graph_info_ = init_data.task_graph_info;
+#endif
 #ifdef HPX_HAVE_THREAD_MINIMAL_DEADLOCK_DETECTION
             set_marked_state(unknown);
 #endif
@@ -650,9 +762,12 @@ namespace hpx { namespace threads
             backtrace_ = nullptr;
 #endif
             priority_ = init_data.priority;
+            deadline_ = init_data.deadline;
             requested_interrupt_ = false;
             enabled_interrupt_ = true;
             ran_exit_funcs_ = false;
+            run_to_completion_ = init_data.run_to_completion;
+            inline_state_.store(inline_running, std::memory_order_relaxed);
             exit_funcs_.clear();
             scheduler_base_ = init_data.scheduler_base;
 
@@ -680,9 +795,48 @@ namespace hpx { namespace threads
 #endif
         }
 
+        // A run-to-completion thread is not executed on its own stack, it
+        // waits for being resumed in place instead of being suspended
+        enum : std::int32_t
+        {
+            inline_running = -1,
+            inline_waiting = -2
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The data accessed by the scheduling loops for every thread comes
+        // first and occupies 64 bytes, which is a single cache line if the
+        // object is allocated at a cache line boundary (as done by the usual
+        // allocators for objects of this size).
         mutable std::atomic<thread_state> current_state_;
 
+        // the queue and the scheduler which created/manage this thread, and
+        // the link used while this object is kept for recycling
+        void* queue_;
+        policies::scheduler_base* scheduler_base_;
+        thread_data* next_recycled_;
+
+        std::ptrdiff_t stacksize_;
+        util::steady_clock::time_point deadline_;
+        thread_priority priority_;
+        std::atomic<std::int32_t> inline_state_;
+
+        // NUMA domain the stack of this thread was first touched in
+        std::uint32_t numa_domain_;
+
+        bool run_to_completion_;
+        bool requested_interrupt_;
+        bool enabled_interrupt_;
+        bool ran_exit_funcs_;
+
+        coroutine_type coroutine_;
+
         ///////////////////////////////////////////////////////////////////////
+        // Data which is not touched while scheduling the thread
+
+        // Singly linked list (heap-allocated)
+        std::forward_list<util::function_nonser<void()> > exit_funcs_;
+
         // Debugging/logging information
 #ifdef HPX_HAVE_THREAD_TARGET_ADDRESS
         naming::address_type component_id_;
@@ -699,6 +853,10 @@ namespace hpx { namespace threads
         std::size_t parent_thread_phase_;
 #endif
 
+#ifdef HPX_HAVE_TASK_GRAPH_PROFILER
+        util::task_graph::thread_info task_graph_info_;
+#endif
+
 #ifdef HPX_HAVE_THREAD_MINIMAL_DEADLOCK_DETECTION
         mutable thread_state_enum marked_state_;
 #endif
@@ -710,24 +868,6 @@ namespace hpx { namespace threads
         util::backtrace const* backtrace_;
 # endif
 #endif
-
-        ///////////////////////////////////////////////////////////////////////
-        thread_priority priority_;
-
-        bool requested_interrupt_;
-        bool enabled_interrupt_;
-        bool ran_exit_funcs_;
-
-        // Singly linked list (heap-allocated)
-        std::forward_list<util::function_nonser<void()> > exit_funcs_;
-
-        // reference to scheduler which created/manages this thread
-        policies::scheduler_base* scheduler_base_;
-
-        std::ptrdiff_t stacksize_;
-
-        coroutine_type coroutine_;
-        void* queue_;
     };
 }}
 
@@ -54,7 +54,8 @@ namespace hpx { namespace threads
     typedef thread_state_ex_enum thread_arg_type;
 
     typedef thread_result_type thread_function_sig(thread_arg_type);
-    typedef util::unique_function_nonser<thread_function_sig> thread_function_type;
+    typedef util::unique_function_nonser<thread_function_sig,
+        util::detail::task_function_storage_size> thread_function_type;
     /// \endcond
 
     ///////////////////////////////////////////////////////////////////////
@@ -29,6 +29,7 @@
 #include <cstdint>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace threads
@@ -282,6 +283,20 @@ namespace hpx { namespace threads
     // Return the number of the NUMA node the current thread is running on
     HPX_API_EXPORT std::size_t get_numa_node_number();
 
+    ///////////////////////////////////////////////////////////////////////////
+    /// Return a scheduling hint which places a new thread on a worker thread
+    /// of the NUMA domain owning the memory page at the given address.
+    ///
+    /// \param addr       [in] The address of the data the new thread is
+    ///                   going to work on.
+    ///
+    /// \returns          A NUMA scheduling hint for the domain holding the
+    ///                   memory at \a addr, or a default constructed hint
+    ///                   (no preference) if the domain can't be determined,
+    ///                   for instance because the page was not touched yet.
+    HPX_API_EXPORT thread_schedule_hint get_data_affinity_hint(
+        void const* addr);
+
     ///////////////////////////////////////////////////////////////////////////
     /// Returns whether the given thread can be interrupted at this point.
     ///
@@ -403,6 +418,59 @@ namespace hpx { namespace threads
     HPX_API_EXPORT threads::thread_priority get_thread_priority(
         thread_id_type const& id, error_code& ec = throws);
 
+    ///////////////////////////////////////////////////////////////////////////
+    /// Return the deadline of the given thread
+    ///
+    /// \param id         [in] The thread id of the thread whose deadline
+    ///                   is queried.
+    /// \param ec         [in,out] this represents the error status on exit,
+    ///                   if this is pre-initialized to \a hpx#throws
+    ///                   the function will throw on error instead.
+    ///
+    /// \returns          The deadline of the thread, or
+    ///                   util::steady_clock::time_point::max() if the thread
+    ///                   has no deadline.
+    ///
+    /// \note             As long as \a ec is not pre-initialized to
+    ///                   \a hpx#throws this function doesn't
+    ///                   throw but returns the result code using the
+    ///                   parameter \a ec. Otherwise it throws an instance
+    ///                   of hpx#exception.
+    HPX_API_EXPORT util::steady_clock::time_point get_thread_deadline(
+        thread_id_type const& id, error_code& ec = throws);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Set the deadline of the given thread
+    ///
+    /// \param id         [in] The thread id of the thread whose deadline
+    ///                   is changed.
+    /// \param deadline   [in] The point in time the thread should have
+    ///                   completed by. Schedulers supporting deadlines run
+    ///                   pending threads in earliest deadline first order
+    ///                   before all other threads. The new deadline is taken
+    ///                   into account the next time the thread is scheduled,
+    ///                   it is inherited by the threads created by the given
+    ///                   thread which have no deadline of their own.
+    /// \param ec         [in,out] this represents the error status on exit,
+    ///                   if this is pre-initialized to \a hpx#throws
+    ///                   the function will throw on error instead.
+    ///
+    /// \note             As long as \a ec is not pre-initialized to
+    ///                   \a hpx#throws this function doesn't
+    ///                   throw but returns the result code using the
+    ///                   parameter \a ec. Otherwise it throws an instance
+    ///                   of hpx#exception.
+    HPX_API_EXPORT void set_thread_deadline(thread_id_type const& id,
+        util::steady_time_point const& deadline, error_code& ec = throws);
+
+    /// \cond NOINTERNAL
+    // Let the thread \a id inherit the priority and the deadline of the
+    // thread \a waiter which is about to wait for it, if those are more
+    // urgent than its own.
+    HPX_API_EXPORT void inherit_thread_priority(thread_id_type const& id,
+        thread_id_type const& waiter);
+    /// \endcond
+
     ///////////////////////////////////////////////////////////////////////////
     /// Return stack size of the given thread
     ///
@@ -968,6 +1036,29 @@ namespace hpx { namespace applier
         threads::thread_state_enum initial_state = threads::pending,
         error_code& ec = throws);
 
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Create a batch of new work items using the given data.
+    ///
+    /// \param data       [in] The descriptions of the work items to create.
+    ///                   The elements are moved from, the container itself
+    ///                   is left unchanged.
+    /// \param initial_state [in] The thread state all newly created
+    ///                   HPX-threads will have.
+    /// \param ec         [in,out] This represents the error status on exit,
+    ///                   if this is pre-initialized to \a hpx#throws
+    ///                   the function will throw on error instead.
+    ///
+    /// \note This function is equivalent to calling threads#register_work_plain
+    ///       for each of the given elements. It distributes the work items
+    ///       over the queues of the worker threads of the current pool while
+    ///       acquiring each queue only once and waking up the worker threads
+    ///       only once for the whole batch.
+    ///
+    HPX_API_EXPORT void register_threads(
+        std::vector<threads::thread_init_data>& data,
+        threads::thread_state_enum initial_state = threads::pending,
+        error_code& ec = throws);
+
     ///////////////////////////////////////////////////////////////////////////
     /// \brief Create a new work item using the given function as the
     ///        work to be executed.
@@ -1042,6 +1133,8 @@ namespace hpx { namespace threads
     using applier::register_work_plain;
     using applier::register_work;
     using applier::register_work_nullary;
+
+    using applier::register_threads;
 }}
 
 /// \endcond
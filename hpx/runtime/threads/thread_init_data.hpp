@@ -12,6 +12,8 @@
 #include <hpx/runtime/threads/thread_data_fwd.hpp>
 #include <hpx/runtime/threads/thread_enums.hpp>
 #include <hpx/runtime/threads_fwd.hpp>
+#include <hpx/util/steady_clock.hpp>
+#include <hpx/util/task_graph_profiler.hpp>
 #include <hpx/util/thread_description.hpp>
 #if defined(HPX_HAVE_APEX)
 #include <hpx/util/apex.hpp>
@@ -45,9 +47,11 @@ namespace hpx { namespace threads
             apex_data(nullptr),
 #endif
             priority(thread_priority_normal),
+            deadline((util::steady_clock::time_point::max)()),
             schedulehint(),
             stacksize(get_default_stack_size()),
-            scheduler_base(nullptr)
+            scheduler_base(nullptr),
+            run_to_completion(false)
         {}
 
         thread_init_data(thread_init_data&& rhs)
@@ -62,15 +66,20 @@ namespace hpx { namespace threads
             parent_locality_id(rhs.parent_locality_id), parent_id(rhs.parent_id),
             parent_phase(rhs.parent_phase),
 #endif
+#if defined(HPX_HAVE_TASK_GRAPH_PROFILER)
+            task_graph_info(rhs.task_graph_info),
+#endif
 #ifdef HPX_HAVE_APEX
         /* HPX_HAVE_APEX forces the HPX_HAVE_THREAD_DESCRIPTION
          * and HPX_HAVE_THREAD_PARENT_REFERENCE settings to be on */
             apex_data(apex_new_task(description, parent_locality_id, parent_id )),
 #endif
             priority(rhs.priority),
+            deadline(rhs.deadline),
             schedulehint(rhs.schedulehint),
             stacksize(rhs.stacksize),
-            scheduler_base(rhs.scheduler_base)
+            scheduler_base(rhs.scheduler_base),
+            run_to_completion(rhs.run_to_completion)
         {
             if (stacksize == 0)
                 stacksize = get_default_stack_size();
@@ -98,10 +107,13 @@ namespace hpx { namespace threads
          * and HPX_HAVE_THREAD_PARENT_REFERENCE settings to be on */
             apex_data(apex_new_task(description,parent_locality_id,parent_id)),
 #endif
-            priority(priority_), schedulehint(os_thread),
+            priority(priority_),
+            deadline((util::steady_clock::time_point::max)()),
+            schedulehint(os_thread),
             stacksize(stacksize_ == std::ptrdiff_t(-1) ?
                 get_default_stack_size() : stacksize_),
-            scheduler_base(scheduler_base_)
+            scheduler_base(scheduler_base_),
+            run_to_completion(false)
         {
             if (stacksize == 0)
                 stacksize = get_default_stack_size();
@@ -120,6 +132,9 @@ namespace hpx { namespace threads
         threads::thread_id_type parent_id;
         std::size_t parent_phase;
 #endif
+#if defined(HPX_HAVE_TASK_GRAPH_PROFILER)
+        util::task_graph::thread_info task_graph_info;
+#endif
 #ifdef HPX_HAVE_APEX
         /* HPX_HAVE_APEX forces the HPX_HAVE_THREAD_DESCRIPTION
          * and HPX_HAVE_THREAD_PARENT_REFERENCE settings to be on */
@@ -127,10 +142,22 @@ namespace hpx { namespace threads
 #endif
 
         thread_priority priority;
+
+        // The point in time the thread should have completed by, schedulers
+        // supporting deadlines run the pending threads having one in earliest
+        // deadline first order before any other threads. The default
+        // (time_point::max()) means the thread has no deadline.
+        util::steady_clock::time_point deadline;
+
         thread_schedule_hint schedulehint;
         std::ptrdiff_t stacksize;
 
         policies::scheduler_base* scheduler_base;
+
+        // The thread function does not (or very rarely) suspend, execute it
+        // directly on the stack of the scheduling loop. A suspension of such
+        // a thread blocks the worker thread until it is resumed.
+        bool run_to_completion;
     };
 }}
 
@@ -176,6 +176,8 @@ namespace hpx { namespace threads
             thread_state_enum initial_state, bool run_now, error_code& ec) = 0;
         virtual void create_work(thread_init_data& data,
             thread_state_enum initial_state, error_code& ec) = 0;
+        virtual void create_threads(std::vector<thread_init_data>& data,
+            thread_state_enum initial_state, error_code& ec) = 0;
 
         virtual thread_state set_state(thread_id_type const& id,
             thread_state_enum new_state, thread_state_ex_enum new_state_ex,
@@ -243,6 +245,12 @@ namespace hpx { namespace threads
         virtual std::int64_t avg_idle_rate_all(bool /*reset*/) { return 0; }
         virtual std::int64_t avg_idle_rate(std::size_t, bool) { return 0; }
 
+        // Return the accumulated time spent executing HPX threads and the
+        // accumulated time spent in the scheduling loops of all worker
+        // threads, these are not affected by resetting the idle rates.
+        virtual std::int64_t get_cumulative_exec_time() const { return 0; }
+        virtual std::int64_t get_cumulative_tfunc_time() const { return 0; }
+
 #if defined(HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES)
         virtual std::int64_t avg_creation_idle_rate(
             std::size_t /*thread_num*/, bool /*reset*/) { return 0; }
@@ -274,6 +282,11 @@ namespace hpx { namespace threads
             std::size_t /*thread_num*/, bool /*reset*/) { return 0; }
         virtual std::int64_t get_num_stolen_to_staged(
             std::size_t /*thread_num*/, bool /*reset*/) { return 0; }
+
+        virtual std::int64_t get_num_successful_steals(
+            std::size_t /*thread_num*/, bool /*reset*/) { return 0; }
+        virtual std::int64_t get_num_failed_steals(
+            std::size_t /*thread_num*/, bool /*reset*/) { return 0; }
 #endif
 
         virtual std::int64_t get_thread_count(thread_state_enum /*state*/,
@@ -55,14 +55,20 @@ namespace hpx { namespace threads
 
         std::shared_ptr<cleanup_function> cleanup_;
 
+        // the values of the first few instances are stored in a fixed slot
+        // of every HPX thread
+        coroutines::detail::tss_slot_key slot_;
+
     public:
         typedef T element_type;
 
         thread_specific_ptr()
-          : cleanup_(std::make_shared<delete_data>())
+          : cleanup_(std::make_shared<delete_data>()),
+            slot_(coroutines::detail::allocate_tss_slot())
         {}
 
         explicit thread_specific_ptr(void (*func_)(T*))
+          : slot_(coroutines::detail::allocate_tss_slot())
         {
             if (func_)
                 cleanup_.reset(new run_custom_cleanup_function(func_));
@@ -72,12 +78,14 @@ namespace hpx { namespace threads
         {
             // clean up data if this type is used locally for one thread
             if (get_self_ptr())
-                coroutines::detail::erase_tss_node(this, true);
+                coroutines::detail::erase_tss_node(this, slot_, true);
+            coroutines::detail::release_tss_slot(slot_);
         }
 
         T* get() const
         {
-            return static_cast<T*>(coroutines::detail::get_tss_data(this));
+            return static_cast<T*>(
+                coroutines::detail::get_tss_data(this, slot_));
         }
 
         T* operator->() const
@@ -94,7 +102,7 @@ namespace hpx { namespace threads
         {
             T* const temp = get();
             coroutines::detail::set_tss_data(
-                this, std::shared_ptr<cleanup_function>());
+                this, slot_, std::shared_ptr<cleanup_function>());
             return temp;
         }
         void reset(T* new_value = nullptr)
@@ -103,7 +111,7 @@ namespace hpx { namespace threads
             if (current_value != new_value)
             {
                 coroutines::detail::set_tss_data(
-                    this, cleanup_, new_value, true);
+                    this, slot_, cleanup_, new_value, true);
             }
         }
     };
@@ -142,6 +142,22 @@ namespace hpx { namespace threads
             thread_state_enum initial_state = pending,
             bool run_now = true, error_code& ec = throws);
 
+        /// The function \a register_threads adds a batch of new work items
+        /// to the thread manager. This is equivalent to calling
+        /// \a register_work for each of the elements of \a data, except that
+        /// the work items are distributed over the queues of the pool of the
+        /// calling thread at once and that the worker threads are notified
+        /// only once.
+        ///
+        /// \param data   [in] The descriptions of the work items to create,
+        ///               all elements are moved from.
+        /// \param initial_state
+        ///               [in] The value of this parameter defines the initial
+        ///               state of the newly created threads.
+        void register_threads(std::vector<thread_init_data>& data,
+            thread_state_enum initial_state = pending,
+            error_code& ec = throws);
+
         /// \brief  Run the thread manager's work queue. This function
         ///         instantiates the specified number of OS threads in each
         ///         pool. All OS threads are started to execute the function
@@ -328,6 +344,18 @@ namespace hpx { namespace threads
             performance_counters::counter_info const& info, error_code& ec);
 #endif
 
+        naming::gid_type idle_rate_counter_creator(
+            threadmanager_counter_func total_func,
+            threadpool_counter_func pool_func,
+            performance_counters::counter_info const& info, error_code& ec);
+
+#ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
+        naming::gid_type creation_and_cleanup_rate_counter_creator(
+            threadmanager_counter_func total_func,
+            threadpool_counter_func pool_func,
+            performance_counters::counter_info const& info, error_code& ec);
+#endif
+
         naming::gid_type locality_pool_thread_no_total_counter_creator(
             threadpool_counter_func pool_func,
             performance_counters::counter_info const& info, error_code& ec);
@@ -404,6 +432,8 @@ namespace hpx { namespace threads
         std::int64_t get_num_stolen_from_staged(bool reset);
         std::int64_t get_num_stolen_to_pending(bool reset);
         std::int64_t get_num_stolen_to_staged(bool reset);
+        std::int64_t get_num_successful_steals(bool reset);
+        std::int64_t get_num_failed_steals(bool reset);
 #endif
 
 private:
@@ -185,6 +185,18 @@ namespace hpx { namespace threads
         mask_cref_type get_core_affinity_mask(std::size_t num_thread,
             error_code& ec = throws) const;
 
+        /// \brief Return a bit mask where each set bit corresponds to a
+        ///        processing unit sharing the first cache level above
+        ///        the core the given thread is running on (usually L2 or
+        ///        L3). Falls back to the NUMA domain mask if no such cache
+        ///        exists.
+        ///
+        /// \param ec         [in,out] this represents the error status on exit,
+        ///                   if this is pre-initialized to \a hpx#throws
+        ///                   the function will throw on error instead.
+        mask_cref_type get_cache_affinity_mask(std::size_t num_thread,
+            error_code& ec = throws) const;
+
         /// \brief Return a bit mask where each set bit corresponds to a
         ///        processing unit available to the given thread.
         ///
@@ -287,8 +299,11 @@ namespace hpx { namespace threads
         threads::mask_type get_area_membind_nodeset(
             const void *addr, std::size_t len) const;
 
+        /// bind the given memory area to a numa node set as specified by
+        /// the policy (see hwloc docs)
         bool set_area_membind_nodeset(
-            const void *addr, std::size_t len, void *nodeset) const;
+            const void *addr, std::size_t len, void *nodeset,
+            hpx_hwloc_membind_policy policy = membind_bind) const;
 
         int get_numa_domain(const void *addr) const;
 
@@ -310,6 +325,7 @@ namespace hpx { namespace threads
         mask_type init_core_affinity_mask_from_core(
             std::size_t num_core, mask_cref_type default_mask = mask_type()
             ) const;
+        mask_type init_cache_affinity_mask(std::size_t num_thread) const;
         mask_type init_thread_affinity_mask(std::size_t num_thread) const;
         mask_type init_thread_affinity_mask(
             std::size_t num_core
@@ -404,6 +420,7 @@ namespace hpx { namespace threads
         std::vector<mask_type> socket_affinity_masks_;
         std::vector<mask_type> numa_node_affinity_masks_;
         std::vector<mask_type> core_affinity_masks_;
+        std::vector<mask_type> cache_affinity_masks_;
         std::vector<mask_type> thread_affinity_masks_;
     };
 
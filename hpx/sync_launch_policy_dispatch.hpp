@@ -55,6 +55,13 @@ namespace hpx { namespace detail
                     hpx::this_thread::suspend(threads::pending, tid,
                         "sync_launch_policy_dispatch<fork>");
                 }
+                else if (tid && policy == launch::work_first)
+                {
+                    // run the new thread right away, this thread is queued
+                    // such that it is resumed next (or gets stolen)
+                    hpx::this_thread::suspend(threads::pending_boost, tid,
+                        "sync_launch_policy_dispatch<work_first>");
+                }
             }
 
             return p.get_future().get();
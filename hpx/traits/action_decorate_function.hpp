@@ -8,10 +8,12 @@
 
 #include <hpx/runtime/naming_fwd.hpp>
 #include <hpx/runtime/threads/thread_data_fwd.hpp>
+#include <hpx/traits/action_is_read_only.hpp>
 #include <hpx/traits/detail/wrap_int.hpp>
 #include <hpx/traits/has_xxx.hpp>
 #include <hpx/util/unique_function.hpp>
 
+#include <type_traits>
 #include <utility>
 
 namespace hpx { namespace traits
@@ -35,6 +37,25 @@ namespace hpx { namespace traits
             return Component::decorate_action(lva, std::forward<F>(f));
         }
 
+        // read-only actions are decorated like any other action, unless the
+        // component implements a separate function for those
+        template <typename Component, typename F>
+        auto decorate_read_only_function(wrap_int, naming::address_type lva,
+                F && f)
+        ->  decltype(decorate_function<Component>(0, lva, std::forward<F>(f)))
+        {
+            return decorate_function<Component>(0, lva, std::forward<F>(f));
+        }
+
+        template <typename Component, typename F>
+        auto decorate_read_only_function(int, naming::address_type lva, F && f)
+        ->  decltype(Component::decorate_read_only_action(
+                lva, std::forward<F>(f)))
+        {
+            return Component::decorate_read_only_action(
+                lva, std::forward<F>(f));
+        }
+
         HPX_HAS_XXX_TRAIT_DEF(decorates_action);
     }
 
@@ -51,11 +72,29 @@ namespace hpx { namespace traits
         template <typename F>
         static threads::thread_function_type
         call(naming::address_type lva, F && f)
+        {
+            return call(action_is_read_only<Action>(), lva,
+                std::forward<F>(f));
+        }
+
+    private:
+        template <typename F>
+        static threads::thread_function_type
+        call(std::false_type, naming::address_type lva, F && f)
         {
             using component_type = typename Action::component_type;
             return detail::decorate_function<component_type>(0,
                 lva, std::forward<F>(f));
         }
+
+        template <typename F>
+        static threads::thread_function_type
+        call(std::true_type, naming::address_type lva, F && f)
+        {
+            using component_type = typename Action::component_type;
+            return detail::decorate_read_only_function<component_type>(0,
+                lva, std::forward<F>(f));
+        }
     };
 
     template <typename Action, typename Enable = void>
@@ -74,6 +113,18 @@ namespace hpx { namespace traits
                 lva, std::forward<F>(f));
         }
     };
+
+    template <typename Component, typename Enable = void>
+    struct component_decorate_read_only_function
+    {
+        template <typename F>
+        static threads::thread_function_type
+        call(naming::address_type lva, F && f)
+        {
+            return detail::decorate_read_only_function<Component>(0,
+                lva, std::forward<F>(f));
+        }
+    };
 }}
 
 #endif
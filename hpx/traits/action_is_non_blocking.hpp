@@ -0,0 +1,40 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_TRAITS_ACTION_IS_NON_BLOCKING_HPP)
+#define HPX_TRAITS_ACTION_IS_NON_BLOCKING_HPP
+
+#include <hpx/util/always_void.hpp>
+
+#include <type_traits>
+
+namespace hpx { namespace traits
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        template <typename Action, typename Enable = void>
+        struct action_is_non_blocking_helper
+          : std::false_type
+        {};
+
+        template <typename Action>
+        struct action_is_non_blocking_helper<Action,
+                typename util::always_void<typename Action::non_blocking>::type>
+          : Action::non_blocking
+        {};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Customization point for marking direct actions which never suspend.
+    // Those are executed directly on any thread, even on the threads of the
+    // parcelports decoding the incoming parcels.
+    template <typename Action, typename Enable = void>
+    struct action_is_non_blocking
+      : detail::action_is_non_blocking_helper<Action>
+    {};
+}}
+
+#endif
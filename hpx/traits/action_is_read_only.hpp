@@ -0,0 +1,40 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_TRAITS_ACTION_IS_READ_ONLY_HPP)
+#define HPX_TRAITS_ACTION_IS_READ_ONLY_HPP
+
+#include <hpx/util/always_void.hpp>
+
+#include <type_traits>
+
+namespace hpx { namespace traits
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        template <typename Action, typename Enable = void>
+        struct action_is_read_only_helper
+          : std::false_type
+        {};
+
+        template <typename Action>
+        struct action_is_read_only_helper<Action,
+                typename util::always_void<typename Action::read_only>::type>
+          : Action::read_only
+        {};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Customization point for marking component actions which do not modify
+    // the component they are invoked on. Hooks serializing the actions of a
+    // component (locking_hook) may run those concurrently.
+    template <typename Action, typename Enable = void>
+    struct action_is_read_only
+      : detail::action_is_read_only_helper<Action>
+    {};
+}}
+
+#endif
@@ -8,6 +8,9 @@
 
 #include <hpx/runtime/parcelset_fwd.hpp>
 #include <hpx/runtime/serialization/serialization_fwd.hpp>
+#include <hpx/util/always_void.hpp>
+
+#include <cstddef>
 
 namespace hpx { namespace traits
 {
@@ -22,6 +25,31 @@ namespace hpx { namespace traits
             return nullptr;   // by default actions don't have a serialization filter
         }
     };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Specializations of action_serialization_filter may want to know how
+    // well the data of the messages was compressed, those expose a function
+    // static void record(std::size_t uncompressed_size,
+    //     std::size_t compressed_size)
+    namespace detail
+    {
+        template <typename Filter, typename Enable = void>
+        struct record_compression
+        {
+            static void call(std::size_t, std::size_t) {}
+        };
+
+        template <typename Filter>
+        struct record_compression<Filter,
+            typename util::always_void<decltype(&Filter::record)>::type>
+        {
+            static void call(std::size_t uncompressed_size,
+                std::size_t compressed_size)
+            {
+                Filter::record(uncompressed_size, compressed_size);
+            }
+        };
+    }
 }}
 
 #endif
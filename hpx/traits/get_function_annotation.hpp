@@ -10,6 +10,7 @@
 #include <hpx/util/itt_notify.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 
 namespace hpx { namespace traits
@@ -24,6 +25,17 @@ namespace hpx { namespace traits
         }
     };
 
+    // The id of the interned annotation (see util::annotation), zero if the
+    // annotation is not interned yet
+    template <typename F, typename Enable = void>
+    struct get_function_annotation_id
+    {
+        static std::uint32_t call(F const& /*f*/) noexcept
+        {
+            return 0;
+        }
+    };
+
 #if HPX_HAVE_ITTNOTIFY != 0 && !defined(HPX_HAVE_APEX)
     template <typename F, typename Enable = void>
     struct get_function_annotation_itt
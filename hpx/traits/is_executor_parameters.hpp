@@ -70,6 +70,25 @@ namespace hpx { namespace parallel { namespace execution
         using type = typename Parameters::has_variable_chunk_size;
     };
 
+    // If a parameters type exposes 'has_lazy_splitting' aliased to
+    // std::true_type it is assumed that the iterations should not be divided
+    // up front but split on demand while they are being executed.
+    template <typename Parameters, typename Enable = void>
+    struct extract_has_lazy_splitting
+    {
+        // by default, assume all chunks are created up front
+        using type = std::false_type;
+    };
+
+    template <typename Parameters>
+    struct extract_has_lazy_splitting<Parameters,
+        typename hpx::util::always_void<
+            typename Parameters::has_lazy_splitting
+        >::type>
+    {
+        using type = typename Parameters::has_lazy_splitting;
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     namespace detail
     {
@@ -15,6 +15,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <type_traits>
 
 namespace hpx { namespace traits
@@ -71,6 +72,15 @@ namespace hpx { namespace traits
             return decompressed_size;
         }
 
+        // Return a handle keeping the data of the container alive, the data
+        // of chunks may be referenced in place as long as it is held. The
+        // handle is empty if the data must not be referenced beyond the
+        // lifetime of the archive.
+        static std::shared_ptr<void const> keep_alive(Container const& cont)
+        {
+            return std::shared_ptr<void const>();
+        }
+
         static void reset(Container& cont)
         {}
     };
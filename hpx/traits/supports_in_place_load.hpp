@@ -0,0 +1,37 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_TRAITS_SUPPORTS_IN_PLACE_LOAD_HPP
+#define HPX_TRAITS_SUPPORTS_IN_PLACE_LOAD_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/traits/is_bitwise_serializable.hpp>
+
+#include <type_traits>
+
+namespace hpx { namespace traits
+{
+    // Loading an object of a type supporting in place loads into an existing
+    // object of that type yields the same value as loading it into a default
+    // constructed object. The serialization of collections loads the elements
+    // of such types into the elements already present, which keeps the
+    // storage (e.g. the capacity of nested vectors) of those alive.
+    template <typename T, typename Enable = void>
+    struct supports_in_place_load
+      : std::integral_constant<bool,
+            is_bitwise_serializable<T>::value || std::is_enum<T>::value>
+    {};
+}}
+
+#define HPX_SUPPORTS_IN_PLACE_LOAD(T)                                         \
+namespace hpx { namespace traits {                                            \
+    template <>                                                               \
+    struct supports_in_place_load< T >                                        \
+      : std::true_type                                                        \
+    {};                                                                       \
+}}                                                                            \
+/**/
+
+#endif
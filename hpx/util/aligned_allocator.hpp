@@ -0,0 +1,123 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_ALIGNED_ALLOCATOR_HPP)
+#define HPX_UTIL_ALIGNED_ALLOCATOR_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+namespace hpx { namespace util
+{
+    namespace detail
+    {
+        HPX_CONSTEXPR inline std::size_t aligned_allocator_alignment(
+            std::size_t alignment, std::size_t type_alignment)
+        {
+            return alignment < type_alignment ? type_alignment : alignment;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // An allocator returning memory aligned to (at least) Alignment bytes. The
+    // size of every allocation is rounded up to a multiple of the alignment,
+    // so that loading a whole vector pack (of at most Alignment bytes) from
+    // the last aligned address of an allocation never reads past its end. The
+    // default alignment of a cache line is enough for all vector packs
+    // supported by datapar.
+    template <typename T,
+        std::size_t Alignment = threads::get_cache_line_size()>
+    struct aligned_allocator
+    {
+        static_assert((Alignment & (Alignment - 1)) == 0,
+            "the alignment must be a power of two");
+
+        typedef T value_type;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef T& reference;
+        typedef T const& const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        template <typename U>
+        struct rebind
+        {
+            typedef aligned_allocator<U, Alignment> other;
+        };
+
+        typedef std::true_type is_always_equal;
+        typedef std::true_type propagate_on_container_move_assignment;
+
+        static HPX_CONSTEXPR_OR_CONST std::size_t alignment =
+            detail::aligned_allocator_alignment(Alignment, alignof(T));
+
+        aligned_allocator() = default;
+
+        template <typename U>
+        aligned_allocator(aligned_allocator<U, Alignment> const&)
+        {
+        }
+
+        pointer allocate(size_type n)
+        {
+            if (n > max_size())
+                throw std::bad_alloc();
+
+            // the pointer returned by malloc is stored right in front of the
+            // aligned block
+            std::size_t size =
+                (n * sizeof(T) + alignment - 1) & ~(alignment - 1);
+            void* p = std::malloc(size + alignment + sizeof(void*));
+            if (p == nullptr)
+                throw std::bad_alloc();
+
+            std::uintptr_t aligned =
+                (reinterpret_cast<std::uintptr_t>(p) + sizeof(void*) +
+                    alignment - 1) & ~std::uintptr_t(alignment - 1);
+            reinterpret_cast<void**>(aligned)[-1] = p;
+            return reinterpret_cast<pointer>(aligned);
+        }
+
+        void deallocate(pointer p, size_type)
+        {
+            if (p != nullptr)
+                std::free(reinterpret_cast<void**>(p)[-1]);
+        }
+
+        size_type max_size() const noexcept
+        {
+            return ((std::numeric_limits<size_type>::max)() - 2 * alignment -
+                sizeof(void*)) / sizeof(T);
+        }
+    };
+
+    template <typename T, std::size_t Alignment>
+    HPX_CONSTEXPR_OR_CONST std::size_t
+        aligned_allocator<T, Alignment>::alignment;
+
+    template <typename T, typename U, std::size_t Alignment>
+    HPX_CONSTEXPR bool operator==(aligned_allocator<T, Alignment> const&,
+        aligned_allocator<U, Alignment> const&)
+    {
+        return true;
+    }
+
+    template <typename T, typename U, std::size_t Alignment>
+    HPX_CONSTEXPR bool operator!=(aligned_allocator<T, Alignment> const&,
+        aligned_allocator<U, Alignment> const&)
+    {
+        return false;
+    }
+}}
+
+#endif
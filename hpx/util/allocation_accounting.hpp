@@ -0,0 +1,150 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_ALLOCATION_ACCOUNTING_HPP)
+#define HPX_UTIL_ALLOCATION_ACCOUNTING_HPP
+
+#include <hpx/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+// The allocation accounting keeps track of the memory allocated by the
+// subsystems of the runtime. The memory of a subsystem is either allocated
+// through a util::tagged_allocator or reported explicitly using the functions
+// below (or an accounted_size instance). For each subsystem the number of
+// bytes currently allocated, the high-water mark of that value and the number
+// of allocations are recorded, these are exposed as the performance counters
+// /runtime/allocations/...
+namespace hpx { namespace util { namespace allocation_accounting
+{
+    enum subsystem
+    {
+        thread_stacks = 0,          // the stacks of the HPX threads
+        thread_data = 1,            // thread_data and task descriptions
+        shared_states = 2,          // the shared states of futures
+        parcel_buffers = 3,         // the buffers holding serialized parcels
+        agas_caches = 4,            // the AGAS address resolution caches
+        serialization = 5,          // the chunk lists of serialized data
+        subsystem_last
+    };
+
+    // The statistics which can be queried for a subsystem
+    enum statistic
+    {
+        stat_bytes_live = 0,        // the number of bytes currently allocated
+        stat_high_water = 1,        // the maximum of stat_bytes_live
+        stat_allocations = 2,       // the number of allocations so far
+        stat_last
+    };
+
+    // Return the name of the given subsystem, as used for the counter
+    // parameters.
+    HPX_EXPORT char const* get_subsystem_name(subsystem s);
+
+    // Return the subsystem with the given name, or subsystem_last if there
+    // is no such subsystem.
+    HPX_EXPORT subsystem get_subsystem(std::string const& name);
+
+#if defined(HPX_HAVE_ALLOCATION_ACCOUNTING)
+    // Record the allocation or deallocation of the given number of bytes by
+    // the given subsystem.
+    HPX_EXPORT void allocated(subsystem s, std::size_t bytes);
+    HPX_EXPORT void deallocated(subsystem s, std::size_t bytes);
+
+    // Return the given statistic for the given subsystem. Resetting the
+    // high-water mark sets it to the number of bytes currently allocated,
+    // the other statistics are not affected by reset.
+    HPX_EXPORT std::int64_t get_statistic(statistic stat, subsystem s,
+        bool reset);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Accounts for the memory held by an object which is not allocated
+    // through a tagged_allocator (for instance the capacity of a buffer).
+    // The memory is released from the accounting when the instance is
+    // destroyed.
+    class accounted_size
+    {
+    public:
+        explicit accounted_size(subsystem s)
+          : subsystem_(s), size_(0)
+        {}
+
+        accounted_size(accounted_size const&) = delete;
+        accounted_size& operator=(accounted_size const&) = delete;
+
+        accounted_size(accounted_size && rhs)
+          : subsystem_(rhs.subsystem_), size_(rhs.size_)
+        {
+            rhs.size_ = 0;
+        }
+
+        accounted_size& operator=(accounted_size && rhs)
+        {
+            if (this != &rhs)
+            {
+                update(0);
+                subsystem_ = rhs.subsystem_;
+                size_ = rhs.size_;
+                rhs.size_ = 0;
+            }
+            return *this;
+        }
+
+        ~accounted_size()
+        {
+            update(0);
+        }
+
+        // Change the number of bytes accounted for, growing counts as an
+        // allocation.
+        void update(std::size_t size)
+        {
+            if (size > size_)
+                allocated(subsystem_, size - size_);
+            else if (size < size_)
+                deallocated(subsystem_, size_ - size);
+            size_ = size;
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+    private:
+        subsystem subsystem_;
+        std::size_t size_;
+    };
+#else
+    inline void allocated(subsystem, std::size_t)
+    {
+    }
+
+    inline void deallocated(subsystem, std::size_t)
+    {
+    }
+
+    class accounted_size
+    {
+    public:
+        explicit accounted_size(subsystem)
+        {}
+
+        void update(std::size_t)
+        {
+        }
+
+        std::size_t size() const
+        {
+            return 0;
+        }
+    };
+#endif
+}}}
+
+#endif
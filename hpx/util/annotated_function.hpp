@@ -7,6 +7,7 @@
 #define HPX_ANNOTATED_FUNCTION_JAN_31_2017_1148AM
 
 #include <hpx/config.hpp>
+#include <hpx/util/annotation.hpp>
 
 #if defined(HPX_HAVE_THREAD_DESCRIPTION)
 #include <hpx/runtime/threads/thread_data_fwd.hpp>
@@ -23,15 +24,29 @@
 #elif defined(HPX_HAVE_APEX)
 #include <hpx/util/apex.hpp>
 #endif
+#include <hpx/util/sampling_profiler.hpp>
+#include <hpx/util/task_tracer.hpp>
 #endif
 
 #include <cstddef>
 #include <cstdint>
+#include <string>
 #include <type_traits>
 #include <utility>
 
 namespace hpx { namespace util
 {
+    namespace detail
+    {
+        // names which are not taken as a function to annotate
+        template <typename F, typename T = typename std::decay<F>::type>
+        struct is_annotation_name
+          : std::integral_constant<bool,
+                std::is_same<T, std::string>::value ||
+                std::is_same<T, annotation>::value>
+        {};
+    }
+
 #if defined(HPX_HAVE_THREAD_DESCRIPTION)
     ///////////////////////////////////////////////////////////////////////////
 #if defined(HPX_COMPUTE_DEVICE_CODE)
@@ -40,6 +55,8 @@ namespace hpx { namespace util
         HPX_NON_COPYABLE(annotate_function);
 
         explicit annotate_function(char const* name) {}
+        explicit annotate_function(annotation const& a) {}
+        explicit annotate_function(std::string const& name) {}
         template <typename F>
         explicit HPX_HOST_DEVICE annotate_function(F && f) {}
 
@@ -55,7 +72,18 @@ namespace hpx { namespace util
           : task_(thread_domain_,
                 hpx::util::itt::string_handle(name))
         {}
-        template <typename F>
+        explicit annotate_function(annotation const& a)
+          : task_(thread_domain_,
+                hpx::util::itt::string_handle(a.name()))
+        {}
+        explicit annotate_function(std::string const& name)
+          : task_(thread_domain_,
+                hpx::util::itt::string_handle(name.c_str()))
+        {}
+        template <typename F, typename =
+            typename std::enable_if<
+                !detail::is_annotation_name<F>::value
+            >::type>
         explicit annotate_function(F && f)
           : task_(thread_domain_,
                 hpx::traits::get_function_annotation_itt<
@@ -73,24 +101,48 @@ namespace hpx { namespace util
         HPX_NON_COPYABLE(annotate_function);
 
         explicit annotate_function(char const* name)
-          : desc_(hpx::threads::get_self_ptr() ?
-                hpx::threads::set_thread_description(
-                    hpx::threads::get_self_id(), name) :
-                nullptr)
+          : annotate_function(hpx::util::thread_description(name), 0)
+        {}
+
+        // The annotation carries the interned id of the name, which spares
+        // the profilers from looking it up.
+        explicit annotate_function(annotation const& a)
+          : annotate_function(hpx::util::thread_description(a), 0)
+        {}
+
+        // The name is interned, it doesn't have to outlive the scope.
+        explicit annotate_function(std::string const& name)
+          : annotate_function(
+                hpx::util::thread_description(annotation(name)), 0)
+        {}
+
+        template <typename F, typename =
+            typename std::enable_if<
+                !detail::is_annotation_name<F>::value
+            >::type>
+        explicit annotate_function(F && f)
+          : annotate_function(hpx::util::thread_description(f), 0)
+        {}
+
+        ~annotate_function()
         {
-#if defined(HPX_HAVE_APEX)
-            threads::set_self_apex_data(
-                apex_update_task(threads::get_self_apex_data(),
-                desc_));
-#endif
+            if (hpx::threads::get_self_ptr())
+            {
+                hpx::threads::set_thread_description(
+                    hpx::threads::get_self_id(), desc_);
+
+                if (HPX_UNLIKELY(util::tracing::tracing_enabled))
+                    record_annotation(desc_);
+                if (HPX_UNLIKELY(util::sampling::sampling_enabled))
+                    util::sampling::set_annotation(desc_);
+            }
         }
 
-        template <typename F>
-        explicit annotate_function(F && f)
+    private:
+        annotate_function(hpx::util::thread_description const& desc, int)
           : desc_(hpx::threads::get_self_ptr() ?
                 hpx::threads::set_thread_description(
-                    hpx::threads::get_self_id(),
-                    hpx::util::thread_description(f)) :
+                    hpx::threads::get_self_id(), desc) :
                 nullptr)
         {
 #if defined(HPX_HAVE_APEX)
@@ -98,17 +150,26 @@ namespace hpx { namespace util
                 apex_update_task(threads::get_self_apex_data(),
                 desc_));
 #endif
+            if (HPX_UNLIKELY(util::tracing::tracing_enabled))
+                record_annotation(desc);
+            if (HPX_UNLIKELY(util::sampling::sampling_enabled))
+                util::sampling::set_annotation(desc);
         }
 
-        ~annotate_function()
+        // the task trace shows the new description of the running thread
+        static void record_annotation(hpx::util::thread_description const& desc)
         {
             if (hpx::threads::get_self_ptr())
             {
-                hpx::threads::set_thread_description(
-                    hpx::threads::get_self_id(), desc_);
+                util::tracing::record_event(util::tracing::event_annotation,
+                    reinterpret_cast<std::uint64_t>(
+                        hpx::threads::get_self_id().get()),
+                    desc);
             }
         }
 
+    public:
+
         hpx::util::thread_description desc_;
     };
 #endif
@@ -131,12 +192,26 @@ namespace hpx { namespace util
               : f_(std::move(f)), name_(name)
             {}
 
+            annotated_function(F const& f, annotation const& a)
+              : f_(f), name_(a.name()), annotation_(a)
+            {}
+
+            annotated_function(F && f, annotation const& a)
+              : f_(std::move(f)), name_(a.name()), annotation_(a)
+            {}
+
         public:
             template <typename ... Ts>
             typename invoke_result<
                 typename util::decay_unwrap<F>::type, Ts...>::type
             operator()(Ts && ... ts)
             {
+                if (annotation_)
+                {
+                    annotate_function func(annotation_);
+                    return util::invoke(f_, std::forward<Ts>(ts)...);
+                }
+
                 annotate_function func(name_);
                 return util::invoke(f_, std::forward<Ts>(ts)...);
             }
@@ -159,9 +234,15 @@ namespace hpx { namespace util
                 return name_ ? name_ : typeid(f_).name();
             }
 
+            std::uint32_t get_function_annotation_id() const noexcept
+            {
+                return annotation_.id();
+            }
+
         private:
             typename util::decay_unwrap<F>::type f_;
             char const* name_;
+            annotation annotation_;
         };
     }
 
@@ -176,6 +257,31 @@ namespace hpx { namespace util
         return result_type(std::forward<F>(f), name);
     }
 
+    // Annotate the function with an interned name, see HPX_ANNOTATION.
+    template <typename F>
+    detail::annotated_function<typename std::decay<F>::type>
+    annotated_function(F && f, annotation const& a)
+    {
+        typedef detail::annotated_function<
+            typename std::decay<F>::type
+        > result_type;
+
+        return result_type(std::forward<F>(f), a);
+    }
+
+    // Annotate the function with a name built at runtime. The name is
+    // interned, it doesn't have to outlive the returned function object.
+    template <typename F>
+    detail::annotated_function<typename std::decay<F>::type>
+    annotated_function(F && f, std::string const& name)
+    {
+        typedef detail::annotated_function<
+            typename std::decay<F>::type
+        > result_type;
+
+        return result_type(std::forward<F>(f), annotation(name));
+    }
+
 #else
     ///////////////////////////////////////////////////////////////////////////
     struct annotate_function
@@ -183,7 +289,12 @@ namespace hpx { namespace util
         HPX_NON_COPYABLE(annotate_function);
 
         explicit annotate_function(char const* /*name*/) {}
-        template <typename F>
+        explicit annotate_function(annotation const& /*a*/) {}
+        explicit annotate_function(std::string const& /*name*/) {}
+        template <typename F, typename =
+            typename std::enable_if<
+                !detail::is_annotation_name<F>::value
+            >::type>
         explicit HPX_HOST_DEVICE annotate_function(F && /*f*/) {}
 
         // add empty (but non-trivial) destructor to silence warnings
@@ -196,6 +307,18 @@ namespace hpx { namespace util
     {
         return std::forward<F>(f);
     }
+
+    template <typename F>
+    F && annotated_function(F && f, annotation const&)
+    {
+        return std::forward<F>(f);
+    }
+
+    template <typename F>
+    F && annotated_function(F && f, std::string const&)
+    {
+        return std::forward<F>(f);
+    }
 #endif
 }}
 
@@ -221,6 +344,16 @@ namespace hpx { namespace traits
             return f.get_function_annotation();
         }
     };
+
+    template <typename F>
+    struct get_function_annotation_id<util::detail::annotated_function<F> >
+    {
+        static std::uint32_t
+        call(util::detail::annotated_function<F> const& f) noexcept
+        {
+            return f.get_function_annotation_id();
+        }
+    };
 }}
 #endif
 
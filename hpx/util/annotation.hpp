@@ -0,0 +1,137 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_ANNOTATION_HPP)
+#define HPX_UTIL_ANNOTATION_HPP
+
+#include <hpx/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+///////////////////////////////////////////////////////////////////////////////
+// Annotations (the names of actions and the names given to
+// annotated_function and annotate_function) are interned in a global table
+// which assigns a 32 bit id to each distinct name. The profilers, the task
+// tracer and the per-task counters key their data on these ids instead of
+// hashing and comparing the names over and over. The interned names are
+// never released, the table is not meant for an unbounded number of names
+// (like names with embedded indices).
+//
+// Interning a name is a lock-free lookup once the name is known, only the
+// first occurrence of a name takes a lock. HPX_ANNOTATION("name") computes
+// the hash of a string literal at compile time and interns it once per call
+// site, any later evaluation just reads the id.
+namespace hpx { namespace util
+{
+    namespace detail
+    {
+        // FNV-1a
+        HPX_CONSTEXPR_OR_CONST std::uint64_t annotation_hash_basis =
+            14695981039346656037ull;
+        HPX_CONSTEXPR_OR_CONST std::uint64_t annotation_hash_prime =
+            1099511628211ull;
+
+        HPX_CONSTEXPR inline std::uint64_t annotation_hash(char const* name,
+            std::uint64_t hash = annotation_hash_basis) noexcept
+        {
+            return *name == '\0' ? hash : annotation_hash(name + 1,
+                (hash ^ std::uint64_t(static_cast<unsigned char>(*name))) *
+                    annotation_hash_prime);
+        }
+
+        // Intern the given name, its hash has to be computed by
+        // annotation_hash.
+        HPX_EXPORT std::uint32_t intern_annotation(char const* name,
+            std::size_t length, std::uint64_t hash);
+    }
+
+    // Return the id of the given name, interning it if necessary. The id of
+    // a nullptr is zero, all other ids are non-zero.
+    HPX_EXPORT std::uint32_t intern_annotation(char const* name);
+    HPX_EXPORT std::uint32_t intern_annotation(std::string const& name);
+
+    // Return the id of the given name or zero if it was never interned.
+    HPX_EXPORT std::uint32_t find_annotation(std::string const& name);
+
+    // Return the interned name with the given id, nullptr for zero. The
+    // returned string stays valid until the program ends.
+    HPX_EXPORT char const* get_annotation_name(std::uint32_t id) noexcept;
+
+    // Return the number of interned names.
+    HPX_EXPORT std::size_t get_annotation_count() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // An interned name. Copying an annotation is free, and the name can be
+    // a temporary string as the table keeps its own copy.
+    class annotation
+    {
+    public:
+        annotation() noexcept
+          : id_(0), name_(nullptr)
+        {}
+
+        explicit annotation(char const* name)
+          : id_(intern_annotation(name))
+          , name_(get_annotation_name(id_))
+        {}
+
+        explicit annotation(std::string const& name)
+          : id_(intern_annotation(name))
+          , name_(get_annotation_name(id_))
+        {}
+
+        // used by HPX_ANNOTATION
+        annotation(char const* name, std::size_t length, std::uint64_t hash)
+          : id_(detail::intern_annotation(name, length, hash))
+          , name_(get_annotation_name(id_))
+        {}
+
+        std::uint32_t id() const noexcept
+        {
+            return id_;
+        }
+
+        char const* name() const noexcept
+        {
+            return name_;
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return id_ != 0;
+        }
+
+        friend bool operator==(annotation const& lhs, annotation const& rhs)
+        {
+            return lhs.id_ == rhs.id_;
+        }
+
+        friend bool operator!=(annotation const& lhs, annotation const& rhs)
+        {
+            return lhs.id_ != rhs.id_;
+        }
+
+    private:
+        std::uint32_t id_;
+        char const* name_;
+    };
+}}
+
+// Create the annotation for a string literal. The name is interned when the
+// expression is evaluated the first time.
+#define HPX_ANNOTATION(name)                                                  \
+    ([]() -> ::hpx::util::annotation const& {                                 \
+        static ::hpx::util::annotation const annotation_(name,                \
+            sizeof(name) - 1,                                                 \
+            std::integral_constant<std::uint64_t,                             \
+                ::hpx::util::detail::annotation_hash(name)>::value);          \
+        return annotation_;                                                   \
+    }())                                                                      \
+/**/
+
+#endif
@@ -0,0 +1,137 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file async_file.hpp
+
+#ifndef HPX_UTIL_ASYNC_FILE_HPP
+#define HPX_UTIL_ASYNC_FILE_HPP
+
+#include <hpx/config.hpp>
+
+#if !defined(HPX_WINDOWS)
+#include <hpx/lcos/future.hpp>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// A file whose reads and writes complete asynchronously, the operations
+    /// return futures which become ready once the data has been transferred.
+    ///
+    /// If HPX was built with HPX_WITH_IO_URING and the kernel supports it
+    /// (and hpx.async_file.io_uring is set), the operations are submitted
+    /// through a ring shared by all files. The ring is polled from the
+    /// background work of the worker threads, no thread blocks while an
+    /// operation is in flight. Otherwise the operations are executed as
+    /// blocking system calls on the OS-threads of the io-pool.
+    ///
+    /// The memory referred to by an operation has to stay valid until the
+    /// future returned by it has become ready. Buffers which are used for
+    /// many operations can be registered with \a register_buffer, which
+    /// saves the kernel from mapping their pages for every operation.
+    /// All operations on the file have to complete before it is closed.
+    class HPX_EXPORT async_file
+    {
+    public:
+        async_file() noexcept;
+
+        /// Open the given file, \a flags and \a mode are the same as for
+        /// the open system call.
+        async_file(std::string const& path, int flags, int mode = 0644);
+
+        async_file(async_file const&) = delete;
+        async_file& operator=(async_file const&) = delete;
+
+        async_file(async_file && rhs) noexcept;
+        async_file& operator=(async_file && rhs) noexcept;
+
+        ~async_file();
+
+        void open(std::string const& path, int flags, int mode = 0644);
+        void close();
+
+        bool is_open() const noexcept
+        {
+            return fd_ != -1;
+        }
+
+        int native_handle() const noexcept
+        {
+            return fd_;
+        }
+
+        /// Read or write the given data at the current position of the
+        /// file. The position is advanced by the requested size as soon as
+        /// the operation has been submitted, which allows for several
+        /// operations to be in flight at once.
+        hpx::future<std::size_t> read(void* data, std::size_t size);
+        hpx::future<std::size_t> write(void const* data, std::size_t size);
+
+        /// Read or write the given data at the given offset into the file.
+        /// The futures hold the number of transferred bytes, which may be
+        /// less than requested (for instance at the end of the file).
+        hpx::future<std::size_t> pread(void* data, std::size_t size,
+            std::uint64_t offset);
+        hpx::future<std::size_t> pwrite(void const* data, std::size_t size,
+            std::uint64_t offset);
+
+        /// Scatter/gather versions of pread and pwrite, the array of buffers
+        /// is copied and does not have to stay valid.
+        hpx::future<std::size_t> preadv(iovec const* iov, std::size_t count,
+            std::uint64_t offset);
+        hpx::future<std::size_t> pwritev(iovec const* iov, std::size_t count,
+            std::uint64_t offset);
+
+        /// Flush the data written to the file to the storage device.
+        hpx::future<void> sync();
+
+        /// Set or return the position used by read and write.
+        void seek(std::uint64_t position) noexcept
+        {
+            position_.store(position, std::memory_order_relaxed);
+        }
+
+        std::uint64_t tell() const noexcept
+        {
+            return position_.load(std::memory_order_relaxed);
+        }
+
+        /// Register the given memory for the operations of all files. This
+        /// is expensive (it waits for the operations in flight), it should
+        /// be done once for buffers which are used repeatedly. Returns false
+        /// if buffers are not registered (the operations work nevertheless).
+        static bool register_buffer(void* data, std::size_t size);
+
+        /// Remove the registration of the given buffer, no operation
+        /// referring to it may be in flight.
+        static void unregister_buffer(void* data);
+
+        /// Return whether the operations are submitted through io_uring.
+        static bool uses_io_uring();
+
+    private:
+        hpx::future<std::size_t> submit_transfer(bool write, iovec const* iov,
+            std::size_t count, std::uint64_t offset);
+
+        int fd_;
+        int index_;         // slot in the table of fixed files of the ring
+        std::atomic<std::uint64_t> position_;
+    };
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
+
+#endif
@@ -0,0 +1,141 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_UTIL_AUTOTUNER_HPP
+#define HPX_UTIL_AUTOTUNER_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/performance_counters/performance_counter.hpp>
+#include <hpx/util/function.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// Tunes a set of parameters online while an iterative application is
+    /// running, instead of sweeping them offline with one run per point.
+    ///
+    /// Every tunable has a list of candidate values. The autotuner measures
+    /// an objective (to be minimized) for each iteration enclosed in
+    /// begin_iteration() and end_iteration(), and searches the candidates by
+    /// hill climbing: starting from the current configuration it moves one
+    /// tunable at a time to a neighbouring candidate as long as this improves
+    /// the objective. Each configuration is scored by the minimum of
+    /// \a samples iterations, which filters out noise. The search stops once
+    /// no neighbour of the best configuration improves on it or after
+    /// \a warmup_iterations iterations, whichever comes first. The best
+    /// configuration is then locked in for the remaining iterations.
+    ///
+    /// Configuration tunables (see add_config_tunable) are applied through
+    /// hpx::set_config_entry. Runtime parameters reacting to changes of
+    /// their entry are, for instance, hpx.thread_queue.* and
+    /// hpx.plugins.coalescing_message_handler.*. Other parameters, like the
+    /// chunk size used by an application, are registered with a setter
+    /// function (see add_tunable).
+    ///
+    /// The autotuner is not thread-safe, it is meant to be driven from the
+    /// loop of the application.
+    class HPX_EXPORT autotuner
+    {
+    public:
+        typedef util::function_nonser<void(std::int64_t)> setter_type;
+
+        /// The objective is the wall time of an iteration.
+        explicit autotuner(std::size_t warmup_iterations,
+            std::size_t samples = 3);
+
+        /// The objective is the value of the given performance counter,
+        /// which is reset at the beginning of each iteration.
+        autotuner(std::string const& counter_name,
+            std::size_t warmup_iterations, std::size_t samples = 3);
+
+        /// Register a tunable which is applied by calling \a setter.
+        void add_tunable(std::string const& name,
+            std::vector<std::int64_t> candidates, setter_type setter);
+
+        /// Register the configuration entry \a key as a tunable. The search
+        /// starts at the current value of the entry if it is one of the
+        /// candidates.
+        void add_config_tunable(std::string const& key,
+            std::vector<std::int64_t> candidates);
+
+        void begin_iteration();
+
+        /// Finish an iteration measuring the objective the autotuner was
+        /// constructed with.
+        void end_iteration();
+
+        /// Finish an iteration with an objective computed by the caller.
+        void end_iteration(double objective);
+
+        /// Return whether the autotuner is still searching.
+        bool is_tuning() const
+        {
+            return tuning_;
+        }
+
+        /// Return the value currently applied to the given tunable.
+        std::int64_t get(std::string const& name) const;
+
+        /// Return the best configuration found so far.
+        std::vector<std::pair<std::string, std::int64_t> > best() const;
+
+        /// Stop the search and apply the best configuration found so far.
+        void lock_in();
+
+        /// Write the best values of the configuration tunables to an ini
+        /// file, which can be passed to the next run using --hpx:config.
+        void save(std::string const& filename) const;
+
+    private:
+        struct tunable
+        {
+            std::string name_;
+            std::vector<std::int64_t> candidates_;
+            setter_type setter_;
+            bool is_config_;
+        };
+
+        typedef std::vector<std::size_t> configuration;
+
+        void add(tunable t, std::size_t start);
+        void apply(configuration const& config);
+        void configuration_done(double score);
+        bool next_configuration();
+
+        std::size_t warmup_iterations_;
+        std::size_t samples_;
+        std::string counter_name_;
+        performance_counters::performance_counter counter_;
+
+        std::vector<tunable> tunables_;
+
+        configuration current_;         // configuration being measured
+        configuration applied_;
+        configuration best_;
+        double best_score_;
+        std::map<configuration, double> scores_;
+
+        std::size_t iterations_;
+        std::size_t current_samples_;
+        double current_score_;
+        bool tuning_;
+
+        high_resolution_timer timer_;
+    };
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
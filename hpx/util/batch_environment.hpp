@@ -79,6 +79,11 @@ namespace hpx { namespace util
             boost::asio::ip::tcp::endpoint, std::pair<std::string, std::size_t>
         > node_map_type;
 
+    private:
+        void init_from_batch_system(std::vector<std::string> & nodelist,
+            util::runtime_configuration const& cfg, bool debug);
+
+    public:
         std::string agas_node_;
         std::size_t agas_node_num_;
         std::size_t node_num_;
@@ -0,0 +1,517 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_UTIL_CACHE_CONCURRENT_CLOCK_CACHE_HPP
+#define HPX_UTIL_CACHE_CONCURRENT_CLOCK_CACHE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/cache/statistics/no_statistics.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace util { namespace cache
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// \class concurrent_clock_cache concurrent_clock_cache.hpp hpx/util/cache/concurrent_clock_cache.hpp
+    ///
+    /// \brief The \a concurrent_clock_cache implements a local cache which
+    ///        can be read by any number of threads concurrently without
+    ///        taking a lock.
+    ///
+    /// The entries are held in sets of \a ways slots, an entry can be stored
+    /// in the set selected by the hash of its key only. Each slot is
+    /// protected by a sequence lock: readers copy the slot and retry if it
+    /// was modified meanwhile, writers are serialized per set. The entry to
+    /// evict from a full set is chosen by the CLOCK algorithm, which
+    /// approximates LRU using a flag set whenever an entry is found.
+    ///
+    /// \tparam Key           The type of the keys to use to identify the
+    ///                       entries stored in the cache. The type has to be
+    ///                       trivially copyable and equality comparable.
+    /// \tparam Entry         The type of the items to be held in the cache.
+    ///                       The type has to be trivially copyable.
+    /// \tparam Hash          The function object used to hash the keys.
+    /// \tparam Statistics    A (optional) type allowing to collect some basic
+    ///                       statistics about the operation of the cache
+    ///                       instance, it has to support concurrent updates.
+    template <
+        typename Key, typename Entry, typename Hash = std::hash<Key>,
+        typename Statistics = statistics::no_statistics
+    >
+    class concurrent_clock_cache
+    {
+        static_assert(std::is_trivially_copyable<Key>::value &&
+            std::is_trivially_copyable<Entry>::value,
+            "the keys and entries of a concurrent_clock_cache have to be "
+            "trivially copyable");
+
+    public:
+        typedef Key key_type;
+        typedef Entry entry_type;
+        typedef Statistics statistics_type;
+        typedef std::pair<key_type, entry_type> entry_pair;
+        typedef std::size_t size_type;
+
+        /// The number of slots in each set
+        HPX_STATIC_CONSTEXPR std::size_t ways = 8;
+
+    private:
+        typedef typename statistics_type::update_on_exit update_on_exit;
+        typedef lcos::local::spinlock mutex_type;
+
+        struct slot_data
+        {
+            bool occupied_;
+            key_type key_;
+            entry_type entry_;
+        };
+
+        HPX_STATIC_CONSTEXPR std::size_t num_words =
+            (sizeof(slot_data) + sizeof(std::uint64_t) - 1) /
+                sizeof(std::uint64_t);
+
+        struct slot
+        {
+            slot()
+              : version_(0), tag_(0), referenced_(false)
+            {
+                for (std::atomic<std::uint64_t>& w : words_)
+                    w.store(0, std::memory_order_relaxed);
+            }
+
+            // Take a consistent snapshot of the slot
+            void read(slot_data& d) const noexcept
+            {
+                std::uint64_t buffer[num_words];
+                for (std::size_t k = 0; /**/; ++k)
+                {
+                    std::uint64_t const version =
+                        version_.load(std::memory_order_acquire);
+                    if ((version & 1) == 0)
+                    {
+                        for (std::size_t i = 0; i != num_words; ++i)
+                        {
+                            buffer[i] =
+                                words_[i].load(std::memory_order_relaxed);
+                        }
+
+                        std::atomic_thread_fence(std::memory_order_acquire);
+                        if (version_.load(std::memory_order_relaxed) ==
+                            version)
+                        {
+                            break;
+                        }
+                    }
+                    hpx::util::detail::yield_k(k,
+                        "hpx::util::cache::concurrent_clock_cache::read");
+                }
+                std::memcpy(&d, buffer, sizeof(slot_data));
+            }
+
+            // The lock of the set has to be held by the caller
+            void write(slot_data const& d, std::size_t tag) noexcept
+            {
+                std::uint64_t buffer[num_words] = {};
+                std::memcpy(buffer, &d, sizeof(slot_data));
+
+                std::uint64_t const version =
+                    version_.load(std::memory_order_relaxed);
+                version_.store(version + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+
+                tag_.store(tag, std::memory_order_relaxed);
+                for (std::size_t i = 0; i != num_words; ++i)
+                    words_[i].store(buffer[i], std::memory_order_relaxed);
+
+                version_.store(version + 2, std::memory_order_release);
+            }
+
+            void clear() noexcept
+            {
+                slot_data d;
+                std::memset(&d, 0, sizeof(slot_data));
+                write(d, 0);
+                referenced_.store(false, std::memory_order_relaxed);
+            }
+
+            std::atomic<std::uint64_t> version_;
+
+            // the hash of the key, used by readers to skip slots quickly
+            std::atomic<std::size_t> tag_;
+            std::atomic<bool> referenced_;
+            std::atomic<std::uint64_t> words_[num_words];
+        };
+
+        struct set
+        {
+            set()
+              : hand_(0)
+            {}
+
+            mutex_type mtx_;
+            std::size_t hand_;
+            slot slots_[ways];
+        };
+
+        struct table
+        {
+            explicit table(std::size_t num_sets)
+              : mask_(num_sets - 1), size_(0), sets_(new set[num_sets])
+            {}
+
+            std::size_t num_sets() const
+            {
+                return mask_ + 1;
+            }
+
+            set& get_set(std::size_t hash) const
+            {
+                // mix the bits of the hash using Fibonacci hashing
+                std::uint64_t const h =
+                    std::uint64_t(hash) * std::uint64_t(11400714819323198485ull);
+                return sets_[std::size_t(h >> 32) & mask_];
+            }
+
+            std::size_t const mask_;
+            std::atomic<size_type> size_;
+            std::unique_ptr<set[]> sets_;
+        };
+
+    public:
+        /// \brief Construct a new instance of a concurrent_clock_cache.
+        ///
+        /// \param max_size   [in] The maximal number of entries the cache
+        ///                   should hold. The capacity is rounded up to a
+        ///                   power of two multiple of \a ways.
+        explicit concurrent_clock_cache(size_type max_size = 0,
+                Hash const& hash = Hash())
+          : hash_(hash), table_(nullptr)
+        {
+            reserve(max_size);
+        }
+
+        concurrent_clock_cache(concurrent_clock_cache const&) = delete;
+        concurrent_clock_cache& operator=(
+            concurrent_clock_cache const&) = delete;
+
+        /// \brief Return current size of the cache.
+        size_type size() const
+        {
+            return get_table().size_.load(std::memory_order_relaxed);
+        }
+
+        /// \brief Access the maximum size the cache is allowed to grow to.
+        size_type capacity() const
+        {
+            return get_table().num_sets() * ways;
+        }
+
+        /// \brief Change the maximum size this cache can grow to
+        ///
+        /// The entries are moved to a new table. Entries inserted while the
+        /// cache is resized might get lost. The previous tables are kept
+        /// alive for concurrent readers until the cache is destroyed.
+        ///
+        /// \param max_size    [in] The new maximum size this the cache will
+        ///             be allowed to grow to.
+        void reserve(size_type max_size)
+        {
+            std::size_t num_sets = 1;
+            while (num_sets * ways < max_size)
+                num_sets *= 2;
+
+            std::lock_guard<mutex_type> l(tables_mtx_);
+
+            table* old_table = table_.load(std::memory_order_acquire);
+            if (old_table != nullptr && old_table->num_sets() == num_sets)
+                return;
+
+            std::unique_ptr<table> new_table(new table(num_sets));
+            if (old_table != nullptr)
+            {
+                for (std::size_t i = 0; i != old_table->num_sets(); ++i)
+                {
+                    set& s = old_table->sets_[i];
+                    std::lock_guard<mutex_type> ls(s.mtx_);
+                    for (slot& sl : s.slots_)
+                    {
+                        slot_data d;
+                        sl.read(d);
+                        if (d.occupied_)
+                            update(*new_table, d.key_, d.entry_);
+                    }
+                }
+            }
+
+            table_.store(new_table.get(), std::memory_order_release);
+            tables_.push_back(std::move(new_table));
+        }
+
+        /// \brief Return the number of bytes allocated for the entries of
+        ///        this cache, including the previous tables which are kept
+        ///        alive for concurrent readers.
+        std::size_t memory_usage() const
+        {
+            std::lock_guard<mutex_type> l(tables_mtx_);
+
+            std::size_t bytes = 0;
+            for (std::unique_ptr<table> const& t : tables_)
+                bytes += sizeof(table) + t->num_sets() * sizeof(set);
+            return bytes;
+        }
+
+        /// \brief Get a specific entry identified by the given key.
+        ///
+        /// \param key     [in] The key for the entry which should be
+        ///                retrieved from the cache.
+        /// \param realkey [out] The key of the entry found.
+        /// \param entry   [out] If the entry indexed by the key is found in
+        ///                the cache this value on successful return will be
+        ///                a copy of the corresponding entry.
+        ///
+        /// \returns       This function will return true if the requested
+        ///                entry has been found in the cache, otherwise false.
+        bool get_entry(
+            key_type const& key, key_type& realkey, entry_type& entry)
+        {
+            update_on_exit update(statistics_, statistics::method_get_entry);
+
+            std::size_t const tag = hash_(key);
+            for (slot& sl : get_table().get_set(tag).slots_)
+            {
+                if (sl.tag_.load(std::memory_order_relaxed) != tag)
+                    continue;
+
+                slot_data d;
+                sl.read(d);
+                if (d.occupied_ && d.key_ == key)
+                {
+                    // avoid writing to the shared slot if possible
+                    if (!sl.referenced_.load(std::memory_order_relaxed))
+                        sl.referenced_.store(true, std::memory_order_relaxed);
+
+                    statistics_.got_hit();
+
+                    realkey = d.key_;
+                    entry = d.entry_;
+                    return true;
+                }
+            }
+
+            statistics_.got_miss();
+            return false;
+        }
+
+        bool get_entry(key_type const& key, entry_type& entry)
+        {
+            key_type tmp;
+            return get_entry(key, tmp, entry);
+        }
+
+        /// \brief Insert a new entry into this cache
+        ///
+        /// \returns      This function returns false if an entry with the
+        ///               given key is already stored in the cache.
+        bool insert(key_type const& key, entry_type const& entry)
+        {
+            update_on_exit update(
+                statistics_, statistics::method_insert_entry);
+
+            return update_if(get_table(), key, entry,
+                [](key_type const&, key_type const&) { return true; });
+        }
+
+        /// \brief Update an existing element in this cache, insert it if it
+        ///        is not in the cache yet.
+        void update(key_type const& key, entry_type const& entry)
+        {
+            update_on_exit on_exit(
+                statistics_, statistics::method_update_entry);
+
+            update(get_table(), key, entry);
+        }
+
+        /// \brief Update an existing element in this cache, insert it if it
+        ///        is not in the cache yet.
+        ///
+        /// \param f      [in] A callable taking the given key and the key of
+        ///               the entry found in the cache. The entry is not
+        ///               replaced if it returns true.
+        ///
+        /// \returns      This function returns false if the existing entry
+        ///               was not replaced.
+        template <typename F>
+        bool update_if(key_type const& key, entry_type const& entry, F && f)
+        {
+            update_on_exit update(
+                statistics_, statistics::method_update_entry);
+
+            return update_if(get_table(), key, entry, std::forward<F>(f));
+        }
+
+        /// \brief Remove stored entries from the cache for which the supplied
+        ///        function object returns true.
+        ///
+        /// \param ep     [in] The function object called with an entry_pair
+        ///               for each of the entries.
+        ///
+        /// \returns      This function returns the overall size of the
+        ///               removed entries.
+        template <typename Func>
+        size_type erase(Func const& ep)
+        {
+            update_on_exit update(statistics_, statistics::method_erase_entry);
+
+            table& t = get_table();
+
+            size_type erased = 0;
+            for (std::size_t i = 0; i != t.num_sets(); ++i)
+            {
+                set& s = t.sets_[i];
+                std::lock_guard<mutex_type> l(s.mtx_);
+                for (slot& sl : s.slots_)
+                {
+                    slot_data d;
+                    sl.read(d);
+                    if (d.occupied_ && ep(entry_pair(d.key_, d.entry_)))
+                    {
+                        sl.clear();
+                        t.size_.fetch_sub(1, std::memory_order_relaxed);
+
+                        statistics_.got_eviction();
+                        ++erased;
+                    }
+                }
+            }
+            return erased;
+        }
+
+        /// \brief Clear the cache
+        size_type clear()
+        {
+            return erase([](entry_pair const&) { return true; });
+        }
+
+        /// \brief Allow to access the embedded statistics instance
+        statistics_type const& get_statistics() const
+        {
+            return statistics_;
+        }
+
+        statistics_type& get_statistics()
+        {
+            return statistics_;
+        }
+
+    private:
+        table& get_table() const
+        {
+            return *table_.load(std::memory_order_acquire);
+        }
+
+        void update(table& t, key_type const& key, entry_type const& entry)
+        {
+            update_if(t, key, entry,
+                [](key_type const&, key_type const&) { return false; });
+        }
+
+        template <typename F>
+        bool update_if(table& t, key_type const& key, entry_type const& entry,
+            F && f)
+        {
+            std::size_t const tag = hash_(key);
+            set& s = t.get_set(tag);
+
+            slot_data d;
+            slot* empty = nullptr;
+
+            std::lock_guard<mutex_type> l(s.mtx_);
+            for (slot& sl : s.slots_)
+            {
+                sl.read(d);
+                if (!d.occupied_)
+                {
+                    if (empty == nullptr)
+                        empty = &sl;
+                }
+                else if (d.key_ == key)
+                {
+                    if (f(key, d.key_))
+                        return false;
+
+                    d.entry_ = entry;
+                    sl.write(d, tag);
+                    sl.referenced_.store(true, std::memory_order_relaxed);
+
+                    statistics_.got_hit();
+                    return true;
+                }
+            }
+
+            statistics_.got_miss();
+
+            if (empty == nullptr)
+            {
+                empty = &evict(s);
+            }
+            else
+            {
+                t.size_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            d.occupied_ = true;
+            d.key_ = key;
+            d.entry_ = entry;
+            empty->write(d, tag);
+            empty->referenced_.store(false, std::memory_order_relaxed);
+
+            statistics_.got_insertion();
+            return true;
+        }
+
+        // Select the slot to reuse in a full set, the lock of the set has to
+        // be held by the caller
+        slot& evict(set& s)
+        {
+            for (;;)
+            {
+                slot& sl = s.slots_[s.hand_];
+                s.hand_ = (s.hand_ + 1) % ways;
+
+                if (!sl.referenced_.load(std::memory_order_relaxed))
+                {
+                    statistics_.got_eviction();
+                    return sl;
+                }
+
+                // give the entry a second chance
+                sl.referenced_.store(false, std::memory_order_relaxed);
+            }
+        }
+
+        Hash hash_;
+
+        std::atomic<table*> table_;
+
+        mutable mutex_type tables_mtx_;
+        std::vector<std::unique_ptr<table> > tables_;
+
+        statistics_type statistics_;
+    };
+}}}
+
+#endif
@@ -0,0 +1,192 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_CACHE_CONCURRENT_FULL_STATISTICS_HPP)
+#define HPX_UTIL_CACHE_CONCURRENT_FULL_STATISTICS_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/util/cache/statistics/no_statistics.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace util { namespace cache { namespace statistics
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// The same numbers as collected by \a local_full_statistics, which may
+    /// be updated concurrently by any number of threads.
+    class concurrent_full_statistics
+    {
+    private:
+        template <typename T>
+        static T get_and_reset_value(std::atomic<T>& value, bool reset)
+        {
+            if (reset)
+                return value.exchange(0, std::memory_order_relaxed);
+            return value.load(std::memory_order_relaxed);
+        }
+
+        struct api_counter_data
+        {
+            api_counter_data()
+              : count_(0), time_(0)
+            {}
+
+            std::atomic<std::int64_t> count_;
+            std::atomic<std::int64_t> time_;
+        };
+
+    public:
+        concurrent_full_statistics()
+          : hits_(0), misses_(0), insertions_(0), evictions_(0)
+        {}
+
+        struct update_on_exit
+        {
+        private:
+            static api_counter_data& get_api_counter_data(
+                concurrent_full_statistics& stat, method m)
+            {
+                switch(m) {
+                case method_get_entry:
+                default:
+                    break;
+
+                case method_insert_entry:
+                    return stat.insert_entry_;
+
+                case method_update_entry:
+                    return stat.update_entry_;
+
+                case method_erase_entry:
+                    return stat.erase_entry_;
+                }
+
+                return stat.get_entry_;
+            }
+
+            static std::int64_t now()
+            {
+                std::chrono::nanoseconds ns =
+                    std::chrono::steady_clock::now().time_since_epoch();
+                return static_cast<std::int64_t>(ns.count());
+            }
+
+        public:
+            update_on_exit(concurrent_full_statistics& stat, method m)
+              : started_at_(now()),
+                data_(get_api_counter_data(stat, m))
+            {
+            }
+
+            ~update_on_exit()
+            {
+                data_.time_.fetch_add(now() - started_at_,
+                    std::memory_order_relaxed);
+                data_.count_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            std::int64_t started_at_;
+            api_counter_data& data_;
+        };
+
+        void got_hit() { hits_.fetch_add(1, std::memory_order_relaxed); }
+
+        void got_miss() { misses_.fetch_add(1, std::memory_order_relaxed); }
+
+        void got_insertion()
+        {
+            insertions_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void got_eviction()
+        {
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void clear()
+        {
+            hits_.store(0, std::memory_order_relaxed);
+            misses_.store(0, std::memory_order_relaxed);
+            insertions_.store(0, std::memory_order_relaxed);
+            evictions_.store(0, std::memory_order_relaxed);
+        }
+
+        std::size_t hits(bool reset)
+        {
+            return get_and_reset_value(hits_, reset);
+        }
+        std::size_t misses(bool reset)
+        {
+            return get_and_reset_value(misses_, reset);
+        }
+        std::size_t insertions(bool reset)
+        {
+            return get_and_reset_value(insertions_, reset);
+        }
+        std::size_t evictions(bool reset)
+        {
+            return get_and_reset_value(evictions_, reset);
+        }
+
+        std::int64_t get_get_entry_count(bool reset)
+        {
+            return get_and_reset_value(get_entry_.count_, reset);
+        }
+
+        std::int64_t get_insert_entry_count(bool reset)
+        {
+            return get_and_reset_value(insert_entry_.count_, reset);
+        }
+
+        std::int64_t get_update_entry_count(bool reset)
+        {
+            return get_and_reset_value(update_entry_.count_, reset);
+        }
+
+        std::int64_t get_erase_entry_count(bool reset)
+        {
+            return get_and_reset_value(erase_entry_.count_, reset);
+        }
+
+        std::int64_t get_get_entry_time(bool reset)
+        {
+            return get_and_reset_value(get_entry_.time_, reset);
+        }
+
+        std::int64_t get_insert_entry_time(bool reset)
+        {
+            return get_and_reset_value(insert_entry_.time_, reset);
+        }
+
+        std::int64_t get_update_entry_time(bool reset)
+        {
+            return get_and_reset_value(update_entry_.time_, reset);
+        }
+
+        std::int64_t get_erase_entry_time(bool reset)
+        {
+            return get_and_reset_value(erase_entry_.time_, reset);
+        }
+
+    private:
+        friend struct update_on_exit;
+
+        std::atomic<std::size_t> hits_;
+        std::atomic<std::size_t> misses_;
+        std::atomic<std::size_t> insertions_;
+        std::atomic<std::size_t> evictions_;
+
+        api_counter_data get_entry_;
+        api_counter_data insert_entry_;
+        api_counter_data update_entry_;
+        api_counter_data erase_entry_;
+    };
+}}}}
+
+#endif
@@ -0,0 +1,46 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_CACHE_ALIGNED_DATA_HPP)
+#define HPX_UTIL_CACHE_ALIGNED_DATA_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Holds a value followed by a full cache line of padding. No two elements
+    // of an array of cache_aligned_data share a cache line, which avoids
+    // false sharing between data written by different worker threads (per
+    // worker states, counters, locks, etc.).
+    //
+    // The padding does not rely on over-aligned allocations, which are not
+    // supported by all standard containers before C++17.
+    template <typename Data>
+    struct cache_aligned_data
+    {
+        cache_aligned_data()
+          : data_()
+        {}
+
+        template <typename... Ts, typename Enable = typename
+            std::enable_if<std::is_constructible<Data, Ts&&...>::value>::type>
+        explicit cache_aligned_data(Ts&&... ts)
+          : data_(std::forward<Ts>(ts)...)
+        {}
+
+        Data data_;
+
+        // pad to (at least) the next cache line
+        char cacheline_pad_[threads::get_cache_line_size()];
+    };
+}}
+
+#endif
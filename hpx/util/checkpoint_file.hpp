@@ -0,0 +1,461 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+/// This header defines the save_checkpoint_file and restore_checkpoint_file
+/// functions. Unlike save_checkpoint, which collects the serialized objects
+/// in a checkpoint object in memory, save_checkpoint_file streams the
+/// serialized data to a file while the objects are being serialized.
+//
+
+/// \file hpx/util/checkpoint_file.hpp
+
+#if !defined(HPX_UTIL_CHECKPOINT_FILE_HPP)
+#define HPX_UTIL_CHECKPOINT_FILE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/dataflow.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
+#include <hpx/runtime/serialization/serialization_chunk.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/traits/serialization_access_data.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////
+    /// Options controlling how save_checkpoint_file writes a checkpoint
+    struct checkpoint_file_options
+    {
+        checkpoint_file_options()
+          : block_size_(std::size_t(1) << 20)
+          , max_pending_writes_(4)
+          , incremental_(false)
+          , direct_io_(false)
+          , verify_(true)
+        {}
+
+        /// The serialized data is written in blocks of this size, it is
+        /// rounded up to a multiple of 4096 bytes. At most
+        /// (max_pending_writes_ + 1) blocks are held in memory at any time.
+        std::size_t block_size_;
+
+        /// The number of blocks which may be written concurrently while the
+        /// serialization continues.
+        std::size_t max_pending_writes_;
+
+        /// Update an existing checkpoint file in place, writing only the
+        /// blocks whose content has changed. The blocks are compared using
+        /// the hashes stored in the file.
+        bool incremental_;
+
+        /// Bypass the page cache of the operating system (O_DIRECT), where
+        /// available.
+        bool direct_io_;
+
+        /// Verify the hashes of all blocks before restoring a checkpoint.
+        /// This reads the whole file, restore_checkpoint_file reads only the
+        /// data which is accessed otherwise.
+        bool verify_;
+    };
+
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The layout of a checkpoint file: the header is followed by the
+        // serialized data starting at data_offset_, the table of the hashes
+        // of all blocks starting at data_offset_ + num_blocks_ * block_size_
+        // and the table of the serialization chunks. The data is contiguous,
+        // only the last block may be partial. It consists of the archive
+        // (archive_size_ bytes) followed by the data of the pointer chunks,
+        // each aligned to chunk_alignment.
+        struct checkpoint_file_header
+        {
+            char magic_[8];                     // "HPXCKPT"
+            std::uint32_t version_;
+            std::uint32_t reserved_;
+            std::uint64_t block_size_;
+            std::uint64_t data_size_;
+            std::uint64_t archive_size_;
+            std::uint64_t num_blocks_;
+            std::uint64_t num_chunks_;
+            std::uint64_t data_offset_;
+        };
+
+        struct checkpoint_file_chunk
+        {
+            std::uint64_t type_;                // serialization::chunk_type
+            std::uint64_t offset_;              // into the archive or data
+            std::uint64_t size_;
+        };
+
+        // the alignment of the data of the pointer chunks in the file
+        static constexpr std::size_t chunk_alignment = 64;
+
+        ///////////////////////////////////////////////////////////////////////
+        // The container an output_archive writes to, it collects the
+        // serialized data in blocks and writes each block asynchronously once
+        // it is complete.
+        class HPX_EXPORT checkpoint_file_sink
+        {
+        public:
+            HPX_NON_COPYABLE(checkpoint_file_sink);
+
+        public:
+            checkpoint_file_sink(std::string const& filename,
+                checkpoint_file_options const& options);
+            ~checkpoint_file_sink();
+
+            // the number of bytes the archive has reserved so far
+            std::size_t size() const
+            {
+                return size_;
+            }
+
+            void resize(std::size_t count)
+            {
+                size_ += count;
+            }
+
+            // the archive writes its data sequentially
+            void write(std::size_t count, std::size_t current,
+                void const* address);
+
+            // Write the data of the pointer chunks, the last block and the
+            // file metadata, returns the number of blocks which have been
+            // written.
+            std::size_t finish(
+                std::vector<serialization::serialization_chunk> const& chunks);
+
+        private:
+            struct pending_write
+            {
+                std::size_t index_;
+                char* buffer_;
+                hpx::future<std::uint64_t> hash_;
+            };
+
+            void append(char const* data, std::size_t count);
+            void submit();
+            void wait_for_oldest();
+            void wait_all();
+            bool is_unchanged(std::size_t index, std::uint64_t hash) const;
+
+            std::string filename_;
+            std::string path_;              // the file being written
+            checkpoint_file_options options_;
+            int fd_;
+            bool finished_;
+
+            std::size_t size_;              // reserved by the archive
+            std::size_t written_;           // data passed to the sink
+            std::size_t offset_;            // data in the current block
+            std::size_t num_blocks_;
+            std::size_t data_offset_;
+
+            char* current_;
+            std::vector<char*> buffers_;
+            std::vector<char*> free_buffers_;
+            std::deque<pending_write> pending_;
+
+            std::vector<std::uint64_t> hashes_;
+            std::vector<std::uint64_t> previous_hashes_;
+            std::atomic<std::size_t> blocks_written_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The mapping of the data of a checkpoint file an input_archive
+        // reads from. The pages of the file are mapped copy-on-write, the
+        // data of bitwise serializable chunks is referenced in place by the
+        // restored serialize_buffers, which keep the mapping alive.
+        class HPX_EXPORT checkpoint_file_mapping
+          : public std::enable_shared_from_this<checkpoint_file_mapping>
+        {
+        public:
+            HPX_NON_COPYABLE(checkpoint_file_mapping);
+
+        public:
+            checkpoint_file_mapping(std::string const& filename,
+                bool verify_hashes);
+            ~checkpoint_file_mapping();
+
+            std::size_t size() const
+            {
+                return size_;
+            }
+
+            std::size_t archive_size() const
+            {
+                return archive_size_;
+            }
+
+            std::vector<serialization::serialization_chunk> const&
+            chunks() const
+            {
+                return chunks_;
+            }
+
+            char const& operator[](std::size_t i) const
+            {
+                return data_[i];
+            }
+
+        private:
+            void verify(checkpoint_file_header const& header) const;
+
+            void* base_;
+            std::size_t mapped_size_;
+            char const* data_;
+            std::size_t size_;
+            std::size_t archive_size_;
+            std::vector<serialization::serialization_chunk> chunks_;
+        };
+    }
+}}
+
+namespace hpx { namespace traits
+{
+    template <>
+    struct serialization_access_data<util::detail::checkpoint_file_sink>
+      : default_serialization_access_data<util::detail::checkpoint_file_sink>
+    {
+        static std::size_t size(util::detail::checkpoint_file_sink const& cont)
+        {
+            return cont.size();
+        }
+
+        static void resize(util::detail::checkpoint_file_sink& cont,
+            std::size_t count)
+        {
+            cont.resize(count);
+        }
+
+        static void write(util::detail::checkpoint_file_sink& cont,
+            std::size_t count, std::size_t current, void const* address)
+        {
+            cont.write(count, current, address);
+        }
+    };
+
+    template <>
+    struct serialization_access_data<util::detail::checkpoint_file_mapping>
+      : default_serialization_access_data<util::detail::checkpoint_file_mapping>
+    {
+        static std::size_t size(
+            util::detail::checkpoint_file_mapping const& cont)
+        {
+            return cont.size();
+        }
+
+        static void read(util::detail::checkpoint_file_mapping const& cont,
+            std::size_t count, std::size_t current, void* address)
+        {
+            std::memcpy(address, &cont[current], count);
+        }
+
+        static std::size_t init_data(
+            util::detail::checkpoint_file_mapping const& cont,
+            serialization::binary_filter* filter, std::size_t current,
+            std::size_t decompressed_size)
+        {
+            return filter->init_data(&cont[current], cont.size() - current,
+                decompressed_size);
+        }
+
+        static std::shared_ptr<void const> keep_alive(
+            util::detail::checkpoint_file_mapping const& cont)
+        {
+            return cont.shared_from_this();
+        }
+    };
+}}
+
+namespace hpx { namespace util
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Function object for save_checkpoint_file
+        struct save_file_funct_obj
+        {
+            template <typename... Ts>
+            std::size_t operator()(std::string const& filename,
+                checkpoint_file_options const& options, Ts&&... ts) const
+            {
+                // the data of large bitwise serializable objects is stored
+                // in separate chunks which are written after the archive
+                std::vector<serialization::serialization_chunk> chunks;
+
+                checkpoint_file_sink sink(filename, options);
+                {
+                    hpx::serialization::output_archive ar(sink, 0U, &chunks);
+                    int const sequencer[] = {
+                        0, (ar << ts, 0)...
+                    };
+                    (void) sequencer;
+                    ar.flush();
+                }
+                return sink.finish(chunks);
+            }
+        };
+    }
+
+    ///////////////////////////////////
+    /// Save_checkpoint_file
+    ///
+    /// \tparam Ts           Containers passed to save_checkpoint_file to be
+    ///                      serialized and written to the file.
+    ///
+    /// \param filename      The name of the checkpoint file.
+    ///
+    /// \param options       The options controlling how the file is written.
+    ///
+    /// \param ts            The containers to serialize, futures are waited
+    ///                      for before their values are serialized.
+    ///
+    /// Save_checkpoint_file serializes the given objects and streams the
+    /// serialized data to the given file while the objects are being
+    /// serialized. Unlike save_checkpoint, the serialized data is not
+    /// collected in memory first, the completed blocks of the data are
+    /// written concurrently instead. The checkpoint is written to a temporary
+    /// file which replaces the given file once it is complete. If
+    /// options.incremental_ is set and the file holds a previous checkpoint,
+    /// the file is updated in place and only the blocks which have changed
+    /// since are written.
+    ///
+    /// \returns Save_checkpoint_file returns a future to the number of
+    ///          blocks which have been written to the file.
+    template <typename... Ts>
+    hpx::future<std::size_t> save_checkpoint_file(std::string const& filename,
+        checkpoint_file_options const& options, Ts&&... ts)
+    {
+        return hpx::dataflow(detail::save_file_funct_obj(), filename, options,
+            std::forward<Ts>(ts)...);
+    }
+
+    ///////////////////////////////////
+    /// Save_checkpoint_file - Default options
+    ///
+    /// \tparam T            Containers passed to save_checkpoint_file to be
+    ///                      serialized and written to the file.
+    ///
+    /// \tparam Ts           More containers passed to save_checkpoint_file.
+    ///
+    /// \tparam U            This parameter is used to make sure that T is not
+    ///                      checkpoint_file_options. This forces the compiler
+    ///                      to choose the correct overload.
+    ///
+    /// \param filename      The name of the checkpoint file.
+    ///
+    /// \param t             A container to serialize.
+    ///
+    /// \param ts            Other containers to serialize.
+    ///
+    /// \returns Save_checkpoint_file returns a future to the number of
+    ///          blocks which have been written to the file.
+    template <typename T, typename... Ts,
+        typename U = typename std::enable_if<!std::is_same<
+            typename std::decay<T>::type, checkpoint_file_options>::value>::type>
+    hpx::future<std::size_t> save_checkpoint_file(std::string const& filename,
+        T&& t, Ts&&... ts)
+    {
+        return hpx::dataflow(detail::save_file_funct_obj(), filename,
+            checkpoint_file_options(), std::forward<T>(t),
+            std::forward<Ts>(ts)...);
+    }
+
+    ///////////////////////////////////
+    /// Restore_checkpoint_file
+    ///
+    /// \tparam T           A container to restore.
+    ///
+    /// \tparam Ts          Other containers to restore.
+    ///
+    /// \param filename     The name of the checkpoint file written by
+    ///                     save_checkpoint_file.
+    ///
+    /// \param options      If options.verify_ is set (the default), the
+    ///                     hashes of all blocks are verified in parallel
+    ///                     before restoring the objects.
+    ///
+    /// \param t            A container to restore.
+    ///
+    /// \param ts           Other containers to restore. Containers must be
+    ///                     in the same order that they were passed to
+    ///                     save_checkpoint_file.
+    ///
+    /// Restore_checkpoint_file maps the file into memory and deserializes the
+    /// objects directly from the mapping. The data of
+    /// serialization::serialize_buffers of bitwise serializable types is not
+    /// copied, the restored buffers reference the mapped file in place. Its
+    /// pages are read when they are first accessed and are private to the
+    /// restored buffers, the file must not be updated in place
+    /// (options.incremental_) while these buffers are alive though. Throws
+    /// hpx::exception if the file is not a valid checkpoint file.
+    ///
+    /// \returns Restore_checkpoint_file returns void.
+    template <typename T, typename... Ts>
+    void restore_checkpoint_file(std::string const& filename,
+        checkpoint_file_options const& options, T& t, Ts&... ts)
+    {
+        std::shared_ptr<detail::checkpoint_file_mapping const> mapping =
+            std::make_shared<detail::checkpoint_file_mapping>(
+                filename, options.verify_);
+        hpx::serialization::input_archive ar(
+            *mapping, mapping->archive_size(), &mapping->chunks());
+
+        ar >> t;
+        int const sequencer[] = {
+            0, (ar >> ts, 0)...
+        };
+        (void) sequencer;
+    }
+
+    ///////////////////////////////////
+    /// Restore_checkpoint_file - Default options
+    ///
+    /// \tparam T           A container to restore.
+    ///
+    /// \tparam Ts          Other containers to restore.
+    ///
+    /// \tparam U           This parameter is used to make sure that T is not
+    ///                     checkpoint_file_options. This forces the compiler
+    ///                     to choose the correct overload.
+    ///
+    /// \param filename     The name of the checkpoint file written by
+    ///                     save_checkpoint_file.
+    ///
+    /// \param t            A container to restore.
+    ///
+    /// \param ts           Other containers to restore. Containers must be
+    ///                     in the same order that they were passed to
+    ///                     save_checkpoint_file.
+    ///
+    /// \returns Restore_checkpoint_file returns void.
+    template <typename T, typename... Ts,
+        typename U = typename std::enable_if<!std::is_same<
+            typename std::decay<T>::type, checkpoint_file_options>::value>::type>
+    void restore_checkpoint_file(std::string const& filename, T& t, Ts&... ts)
+    {
+        restore_checkpoint_file(filename, checkpoint_file_options(), t, ts...);
+    }
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -30,6 +30,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -74,6 +75,7 @@ namespace hpx { namespace util
           , hits_(0)
           , misses_(0)
           , reclaims_(0)
+          , reconnects_(0)
         {
             if (max_connections_per_locality_ > max_connections_)
             {
@@ -302,6 +304,7 @@ namespace hpx { namespace util
 
                     // Statistics
                     ++insertions_;
+                    count_reconnect(l);
                     check_invariants();
                     return true;
                 }
@@ -343,6 +346,7 @@ namespace hpx { namespace util
             ++connections_;
 
             ++insertions_;
+            count_reconnect(l);
             check_invariants();
             return true;
         }
@@ -446,6 +450,8 @@ namespace hpx { namespace util
             hits_ = 0;
             misses_ = 0;
             reclaims_ = 0;
+            reconnects_ = 0;
+            evicted_.clear();
 
             // FIXME: This should probably throw instead of asserting, as it
             // can be triggered by caller error.
@@ -539,7 +545,23 @@ namespace hpx { namespace util
             return util::get_and_reset_value(reclaims_, reset);
         }
 
+        // number of connections which had to be re-established after a
+        // connection to the same locality was evicted to make space
+        std::int64_t get_cache_reconnects(bool reset)
+        {
+            std::lock_guard<mutex_type> lock(mtx_);
+            return util::get_and_reset_value(reconnects_, reset);
+        }
+
     private:
+        // A new connection to a locality which lost one of its connections
+        // to make space for others indicates connection churn.
+        void count_reconnect(key_type const& l)
+        {
+            if (!evicted_.empty() && evicted_.erase(l) != 0)
+                ++reconnects_;
+        }
+
         /// Verify class invariants
         void check_invariants() const
         {
@@ -631,6 +653,7 @@ namespace hpx { namespace util
 
                 // Statistics
                 ++evictions_;
+                evicted_.insert(ct->first);
             }
 
             return true;
@@ -650,6 +673,10 @@ namespace hpx { namespace util
         std::int64_t hits_;
         std::int64_t misses_;
         std::int64_t reclaims_;
+        std::int64_t reconnects_;
+
+        // localities which lost a connection in free_space()
+        std::set<key_type> evicted_;
     };
 }}
 
@@ -0,0 +1,137 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_COUNTER_EXPORTER_HPP)
+#define HPX_UTIL_COUNTER_EXPORTER_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/compat/condition_variable.hpp>
+#include <hpx/compat/mutex.hpp>
+#include <hpx/compat/thread.hpp>
+#include <hpx/performance_counters/performance_counter_base.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The counter exporter periodically samples a set of performance counters
+    // of this locality and publishes their values in a shared memory segment
+    // which can be read by external monitoring tools without interfering with
+    // the runtime. The counters are evaluated by a separate OS thread calling
+    // the counter objects directly, i.e. without going through actions or
+    // AGAS. For this reason only counters which report a single raw value are
+    // supported, derived counters (statistics, arithmetics, etc.) have to be
+    // evaluated by the reader.
+    //
+    // The segment starts with a segment_header followed by one entry per
+    // counter and the table of counter names (each an std::uint32_t length
+    // followed by the name). The entries are protected by a sequence lock:
+    // the sequence number is odd while a sample is being written, readers
+    // retry if it was odd or if it changed while reading the entries.
+    // tools/counters/hpx_counters.py is an example reader.
+    class HPX_EXPORT counter_exporter
+    {
+    public:
+        HPX_NON_COPYABLE(counter_exporter);
+
+    public:
+        static std::uint32_t const version = 1;
+
+        struct segment_header
+        {
+            char magic_[8];                     // "HPXCNTRS"
+            std::uint32_t version_;
+            std::uint32_t locality_id_;
+            std::uint64_t num_counters_;
+            std::uint64_t names_offset_;
+            std::uint64_t interval_;            // microseconds
+            std::atomic<std::uint64_t> sequence_;
+            std::atomic<std::uint64_t> timestamp_;  // ns since the epoch
+            std::atomic<std::uint64_t> num_samples_;
+        };
+
+        struct entry
+        {
+            std::atomic<std::int64_t> value_;
+            std::atomic<std::int64_t> scaling_;
+            std::atomic<std::uint64_t> count_;
+            std::atomic<std::int32_t> status_;
+            std::atomic<std::int32_t> scale_inverse_;
+        };
+
+        // The segment is named <segment_name>.<locality_id>, the interval is
+        // given in microseconds.
+        counter_exporter(std::vector<std::string> const& names,
+            std::string const& segment_name, std::size_t interval);
+        ~counter_exporter();
+
+        // Create the counters and the shared memory segment and start the
+        // sampling thread. This has to be called from an HPX thread. Nothing
+        // is exported if none of the counters refers to this locality.
+        void start();
+
+        // Stop sampling and remove the shared memory segment.
+        void stop();
+
+        // Return the name of the segment, empty if nothing is exported.
+        std::string const& get_segment_name() const
+        {
+            return segment_name_;
+        }
+
+    private:
+        struct counter
+        {
+            std::string name_;
+            std::shared_ptr<performance_counters::performance_counter_base>
+                counter_;
+        };
+
+        void find_counters();
+        void create_segment(std::uint32_t locality_id);
+        void remove_segment();
+
+        void run();
+        void sample();
+
+        segment_header& header() const
+        {
+            return *static_cast<segment_header*>(base_);
+        }
+        entry* entries() const
+        {
+            return reinterpret_cast<entry*>(&header() + 1);
+        }
+
+    private:
+        std::vector<std::string> names_;
+        std::string base_name_;
+        std::string segment_name_;
+        std::size_t interval_;
+
+        std::vector<counter> counters_;
+        std::vector<performance_counters::counter_value> values_;
+
+        void* base_;
+        std::size_t size_;
+
+        compat::mutex mtx_;
+        compat::condition_variable cond_;
+        bool stop_requested_;
+        compat::thread sampling_thread_;
+    };
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -0,0 +1,22 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_UTIL_DETAIL_ASYNC_FILE_POLLING_HPP
+#define HPX_UTIL_DETAIL_ASYNC_FILE_POLLING_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_IO_URING)
+namespace hpx { namespace util { namespace detail
+{
+    // Submit the queued operations of all async_file instances and complete
+    // the finished ones, this is called by the worker threads as part of
+    // their background work. Returns whether any operation was submitted or
+    // completed.
+    HPX_API_EXPORT bool poll_async_files();
+}}}
+#endif
+
+#endif
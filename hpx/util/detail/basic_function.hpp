@@ -21,6 +21,7 @@
 #include <hpx/util/detail/vtable/function_vtable.hpp>
 #include <hpx/util/detail/vtable/unique_function_vtable.hpp>
 #include <hpx/util/detail/vtable/vtable.hpp>
+#include <hpx/util_fwd.hpp>
 
 #include <cstddef>
 #include <cstring>
@@ -30,15 +31,18 @@
 
 namespace hpx { namespace util { namespace detail
 {
-    static const std::size_t function_storage_size = 3 * sizeof(void*);
-
     ///////////////////////////////////////////////////////////////////////////
-    template <typename Sig, bool Copyable>
+    // Callables up to StorageSize bytes are stored inline, larger ones are
+    // allocated separately (see vtable::construct).
+    template <typename Sig, bool Copyable,
+        std::size_t StorageSize = function_storage_size>
     class function_base;
 
-    template <bool Copyable, typename R, typename ...Ts>
-    class function_base<R(Ts...), Copyable>
+    template <bool Copyable, typename R, typename ...Ts,
+        std::size_t StorageSize>
+    class function_base<R(Ts...), Copyable, StorageSize>
     {
+
         using vtable = typename std::conditional<
                 Copyable,
                 detail::function_vtable<R(Ts...)>,
@@ -58,7 +62,7 @@ namespace hpx { namespace util { namespace detail
             if (other.object != nullptr)
             {
                 object = vptr->copy(
-                    storage, detail::function_storage_size, other.object);
+                    storage, StorageSize, other.object);
             }
         }
 
@@ -68,7 +72,7 @@ namespace hpx { namespace util { namespace detail
         {
             if (object == &other.storage)
             {
-                std::memcpy(storage, other.storage, function_storage_size);
+                std::memcpy(storage, other.storage, StorageSize);
                 object = &storage;
             }
             other.vptr = detail::get_empty_function_vtable<vtable>();
@@ -98,7 +102,7 @@ namespace hpx { namespace util { namespace detail
                 if (other.object != nullptr)
                 {
                     object = vptr->copy(
-                        storage, detail::function_storage_size, other.object);
+                        storage, StorageSize, other.object);
                 } else {
                     object = nullptr;
                 }
@@ -143,7 +147,7 @@ namespace hpx { namespace util { namespace detail
 
                     vptr = f_vptr;
                     object = vtable::template construct<target_type>(
-                        storage, function_storage_size, std::forward<F>(f));
+                        storage, StorageSize, std::forward<F>(f));
                 }
             } else {
                 reset();
@@ -154,7 +158,7 @@ namespace hpx { namespace util { namespace detail
         {
             if (object != nullptr)
             {
-                vptr->delete_(object, function_storage_size);
+                vptr->delete_(object, StorageSize);
 
                 vptr = detail::get_empty_function_vtable<vtable>();
                 object = nullptr;
@@ -257,22 +261,25 @@ namespace hpx { namespace util { namespace detail
     protected:
         vtable const *vptr;
         void* object;
-        mutable unsigned char storage[function_storage_size];
+        mutable unsigned char storage[StorageSize];
     };
 
-    template <typename Sig, bool Copyable>
-    static bool is_empty_function(function_base<Sig, Copyable> const& f) noexcept
+    template <typename Sig, bool Copyable, std::size_t StorageSize>
+    static bool is_empty_function(
+        function_base<Sig, Copyable, StorageSize> const& f) noexcept
     {
         return f.empty();
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    template <typename Sig, bool Copyable, bool Serializable>
+    template <typename Sig, bool Copyable, bool Serializable,
+        std::size_t StorageSize = function_storage_size>
     class basic_function;
 
-    template <bool Copyable, typename R, typename ...Ts>
-    class basic_function<R(Ts...), Copyable, true>
-      : public function_base<R(Ts...), Copyable>
+    template <bool Copyable, typename R, typename ...Ts,
+        std::size_t StorageSize>
+    class basic_function<R(Ts...), Copyable, true, StorageSize>
+      : public function_base<R(Ts...), Copyable, StorageSize>
     {
         using vtable = typename std::conditional<
                 Copyable,
@@ -280,7 +287,7 @@ namespace hpx { namespace util { namespace detail
                 detail::unique_function_vtable<R(Ts...)>
             >::type;
         using serializable_vtable = serializable_function_vtable<vtable>;
-        using base_type = function_base<R(Ts...), Copyable>;
+        using base_type = function_base<R(Ts...), Copyable, StorageSize>;
 
     public:
         basic_function() noexcept
@@ -336,7 +343,7 @@ namespace hpx { namespace util { namespace detail
 
                 vptr = serializable_vptr->vptr;
                 object = serializable_vptr->load_object(
-                    storage, function_storage_size, ar, version);
+                    storage, StorageSize, ar, version);
             }
         }
 
@@ -355,14 +362,16 @@ namespace hpx { namespace util { namespace detail
         serializable_vtable const* serializable_vptr;
     };
 
-    template <bool Copyable, typename R, typename ...Ts>
-    class basic_function<R(Ts...), Copyable, false>
-      : public function_base<R(Ts...), Copyable>
+    template <bool Copyable, typename R, typename ...Ts,
+        std::size_t StorageSize>
+    class basic_function<R(Ts...), Copyable, false, StorageSize>
+      : public function_base<R(Ts...), Copyable, StorageSize>
     {};
 
-    template <typename Sig, bool Copyable, bool Serializable>
-    static bool is_empty_function(
-        basic_function<Sig, Copyable, Serializable> const& f) noexcept
+    template <typename Sig, bool Copyable, bool Serializable,
+        std::size_t StorageSize>
+    static bool is_empty_function(basic_function<
+        Sig, Copyable, Serializable, StorageSize> const& f) noexcept
     {
         return f.empty();
     }
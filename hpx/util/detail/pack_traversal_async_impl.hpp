@@ -43,6 +43,14 @@ namespace util {
         {
         };
 
+        /// A tag which is passed to the `operator()` of the visitor
+        /// if the remaining elements of a range are visited after the
+        /// traversal was detached. Visitors which accept this tag resume the
+        /// traversal once all of the remaining elements are available.
+        struct async_traverse_detach_range_tag
+        {
+        };
+
         /// A tag which is passed to the `operator()` of the visitor
         /// if the asynchronous pack traversal was finished.
         struct async_traverse_complete_tag
@@ -178,6 +186,32 @@ namespace util {
                     std::forward<T>(value), std::move(resumable));
             }
 
+            /// Calls the visitor with the remaining elements of a range and a
+            /// continuation which is capable of continuing the asynchronous
+            /// traversal after the end of the range. This function is
+            /// SFINAEd out if the visitor doesn't accept the range.
+            template <typename Range, typename Hierarchy>
+            auto async_continue_range(Range&& range, Hierarchy&& hierarchy)
+                -> decltype(util::invoke(std::declval<Visitor&>(),
+                    async_traverse_detach_range_tag{},
+                    std::forward<Range>(range),
+                    make_resume_traversal_callable(
+                        std::declval<
+                            boost::intrusive_ptr<async_traversal_frame>>(),
+                        std::forward<Hierarchy>(hierarchy))))
+            {
+                // Create a self reference
+                boost::intrusive_ptr<async_traversal_frame> self(this);
+
+                // Create a callable object which resumes the traversal
+                // after the range when it's called.
+                auto resumable = make_resume_traversal_callable(
+                    std::move(self), std::forward<Hierarchy>(hierarchy));
+
+                util::invoke(visitor(), async_traverse_detach_range_tag{},
+                    std::forward<Range>(range), std::move(resumable));
+            }
+
             /// Calls the visitor with no arguments to signalize that the
             /// asynchronous traversal was finished.
             void async_complete()
@@ -527,9 +561,46 @@ namespace util {
                     explicit_range_sequence_of_t<Begin, End>{}, current);
             }
 
-            /// Traverse a dynamic range
+            /// Traverse a dynamic range, the remaining elements are handed to
+            /// the visitor at once when the first element which isn't
+            /// available is encountered. This function is SFINAEd out if the
+            /// visitor doesn't accept the range.
             template <typename Begin, typename Sentinel>
-            void async_traverse(dynamic_async_range<Begin, Sentinel> range)
+            auto async_traverse_dynamic_range(
+                    dynamic_async_range<Begin, Sentinel> range, int)
+            -> decltype(std::declval<Frame>()->async_continue_range(
+                    range, util::tuple_cat(util::make_tuple(range),
+                        std::declval<tuple<Hierarchy...>&>())))
+            {
+                if (is_detached())
+                    return;
+
+                for (/**/; !range.is_finished(); ++range)
+                {
+                    if (!frame_->traverse(*range))
+                    {
+                        // Continue the traversal after the end of the range
+                        // once all remaining elements became available.
+                        auto end = range;
+                        while (!end.is_finished())
+                            ++end;
+
+                        auto hierarchy = util::tuple_cat(
+                            util::make_tuple(std::move(end)), hierarchy_);
+
+                        detach();
+
+                        frame_->async_continue_range(
+                            std::move(range), std::move(hierarchy));
+                        return;
+                    }
+                }
+            }
+
+            /// Traverse a dynamic range element by element
+            template <typename Begin, typename Sentinel>
+            void async_traverse_dynamic_range(
+                dynamic_async_range<Begin, Sentinel> range, long)
             {
                 if (!is_detached())
                 {
@@ -541,6 +612,13 @@ namespace util {
                     }
                 }
             }
+
+            /// Traverse a dynamic range
+            template <typename Begin, typename Sentinel>
+            void async_traverse(dynamic_async_range<Begin, Sentinel> range)
+            {
+                async_traverse_dynamic_range(std::move(range), 0);
+            }
         };
 
         /// Deduces to the traversal point class of the
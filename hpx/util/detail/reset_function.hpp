@@ -9,6 +9,8 @@
 #include <hpx/util/function.hpp>
 #include <hpx/util/unique_function.hpp>
 
+#include <cstddef>
+
 namespace hpx { namespace util { namespace detail
 {
     template <typename Sig, bool Serializable>
@@ -23,8 +25,9 @@ namespace hpx { namespace util { namespace detail
         f.reset();
     }
 
-    template <typename Sig, bool Serializable>
-    inline void reset_function(hpx::util::unique_function<Sig, Serializable>& f)
+    template <typename Sig, bool Serializable, std::size_t StorageSize>
+    inline void reset_function(
+        hpx::util::unique_function<Sig, Serializable, StorageSize>& f)
     {
         f.reset();
     }
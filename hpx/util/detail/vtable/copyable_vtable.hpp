@@ -21,12 +21,8 @@ namespace hpx { namespace util { namespace detail
         HPX_FORCEINLINE static void* _copy(
             void* storage, std::size_t storage_size, void const* src)
         {
-            if (sizeof(T) <= storage_size)
-            {
-                return new (storage) T(vtable::get<T>(src));
-            } else {
-                return new T(vtable::get<T>(src));
-            }
+            return vtable::construct<T>(
+                storage, storage_size, vtable::get<T>(src));
         }
         void* (*copy)(void*, std::size_t, void const*);
 
@@ -9,10 +9,13 @@
 #define HPX_UTIL_DETAIL_VTABLE_VTABLE_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/lcos/detail/thread_local_pool.hpp>
+#include <hpx/util/always_void.hpp>
 #include <hpx/util/assert.hpp>
 
 #include <cstddef>
 #include <memory>
+#include <new>
 #include <type_traits>
 #include <utility>
 
@@ -42,6 +45,23 @@ namespace hpx { namespace util { namespace detail
         return &vtables<VTable, T>::instance;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Callables which don't fit into the inline storage of a function are
+    // allocated from the free lists of the calling (worker) thread, unless
+    // they are over-aligned or have their own allocation function.
+    template <typename T, typename Enable = void>
+    struct use_thread_local_pool
+      : std::integral_constant<bool,
+            alignof(T) <= alignof(std::max_align_t)>
+    {};
+
+    template <typename T>
+    struct use_thread_local_pool<T, typename util::always_void<
+            decltype(T::operator new(std::size_t()))
+        >::type>
+      : std::false_type
+    {};
+
     ///////////////////////////////////////////////////////////////////////////
     struct vtable
     {
@@ -59,6 +79,38 @@ namespace hpx { namespace util { namespace detail
             return *reinterpret_cast<T const*>(obj);
         }
 
+        template <typename T, typename ...Args>
+        static T* heap_construct(std::true_type, Args&&... args)
+        {
+            void* p = lcos::detail::thread_local_pool::allocate(sizeof(T));
+            try {
+                return ::new (p) T(std::forward<Args>(args)...); //-V206
+            }
+            catch (...) {
+                lcos::detail::thread_local_pool::deallocate(p, sizeof(T));
+                throw;
+            }
+        }
+
+        template <typename T, typename ...Args>
+        static T* heap_construct(std::false_type, Args&&... args)
+        {
+            return new T(std::forward<Args>(args)...);
+        }
+
+        template <typename T>
+        static void heap_delete(std::true_type, T* p)
+        {
+            p->~T();
+            lcos::detail::thread_local_pool::deallocate(p, sizeof(T));
+        }
+
+        template <typename T>
+        static void heap_delete(std::false_type, T* p)
+        {
+            delete p;
+        }
+
         template <typename T>
         HPX_FORCEINLINE static T* default_construct(
             void* storage, std::size_t storage_size)
@@ -67,7 +119,7 @@ namespace hpx { namespace util { namespace detail
             {
                 return ::new (storage) T; //-V206
             } else {
-                return new T;
+                return heap_construct<T>(use_thread_local_pool<T>());
             }
         }
 
@@ -79,7 +131,8 @@ namespace hpx { namespace util { namespace detail
             {
                 return ::new (storage) T(std::forward<Arg>(arg)); //-V206
             } else {
-                return new T(std::forward<Arg>(arg));
+                return heap_construct<T>(use_thread_local_pool<T>(),
+                    std::forward<Arg>(arg));
             }
         }
 
@@ -99,7 +152,7 @@ namespace hpx { namespace util { namespace detail
             {
                 _destruct<T>(obj);
             } else {
-                delete static_cast<T*>(obj);
+                heap_delete(use_thread_local_pool<T>(), static_cast<T*>(obj));
             }
         }
         void (*delete_)(void*, std::size_t storage_size);
@@ -8,6 +8,7 @@
 #define HPX_UTIL_GENERATE_UNIQUE_IDS_MAR_24_2008_1014AM
 
 #include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
 #include <hpx/runtime/naming/name.hpp>
 #include <hpx/util/spinlock.hpp>
 
@@ -29,13 +30,18 @@ namespace hpx { namespace util
 
         mutex_type mtx_;
 
-        /// size of the id range returned by command_getidrange
+        /// initial size of the id range returned by command_getidrange
         /// FIXME: is this a policy?
         enum { range_delta = 0x100000 };
 
+        /// the size of the requested ranges grows up to this limit if the
+        /// ids are used up faster than AGAS hands out new ranges
+        enum { max_range_delta = 0x4000000 };
+
     public:
         unique_id_ranges()
-          : mtx_(), lower_(0), upper_(0)
+          : mtx_(), lower_(0), upper_(0), prefetch_at_(0)
+          , range_size_(range_delta), next_size_(0)
         {}
 
         /// Generate next unique component id
@@ -48,12 +54,26 @@ namespace hpx { namespace util
             std::lock_guard<mutex_type> l(mtx_);
             lower_ = lower;
             upper_ = upper;
+            prefetch_at_ = upper;
         }
 
     private:
+        /// Request the next range asynchronously, if possible
+        void prefetch_range();
+
         /// The range of available ids for components
         naming::gid_type lower_;
         naming::gid_type upper_;
+
+        /// The next range is requested once the ids up to this one are used
+        naming::gid_type prefetch_at_;
+
+        /// The size of the next range to request
+        std::size_t range_size_;
+
+        /// The lower bound and size of the range requested in advance
+        hpx::future<naming::gid_type> next_lower_;
+        std::size_t next_size_;
     };
 }}
 
@@ -0,0 +1,118 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_HDR_HISTOGRAM_HPP)
+#define HPX_UTIL_HDR_HISTOGRAM_HPP
+
+#include <hpx/config.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A high dynamic range histogram of (non-negative) integer values. The
+    // values are sorted into buckets covering a power of two each, every
+    // bucket is subdivided into 2^(precision_bits - 1) sub-buckets of equal
+    // width. This bounds the relative error of the reported percentiles by
+    // 2^-(precision_bits - 1) independently of the magnitude of the recorded
+    // values while requiring only a few thousand counters to cover the range
+    // from nanoseconds to hours.
+    //
+    // Recording a value does not acquire any lock, it is safe to record
+    // values and to query percentiles concurrently.
+    class HPX_EXPORT hdr_histogram
+    {
+    public:
+        HPX_NON_COPYABLE(hdr_histogram);
+
+    public:
+        // Values larger than max_value are recorded as max_value.
+        explicit hdr_histogram(
+            std::int64_t max_value = std::int64_t(1) << 42,
+            int precision_bits = 7);
+
+        // Add the given value to the histogram.
+        void record(std::int64_t value)
+        {
+            if (value < 0)
+                value = 0;
+            else if (value > max_value_)
+                value = max_value_;
+
+            counts_[index_of(static_cast<std::uint64_t>(value))].fetch_add(
+                1, std::memory_order_relaxed);
+            count_.fetch_add(1, std::memory_order_relaxed);
+
+            std::int64_t max = max_.load(std::memory_order_relaxed);
+            while (value > max &&
+                !max_.compare_exchange_weak(max, value,
+                    std::memory_order_relaxed))
+            {
+            }
+        }
+
+        // Return the number of recorded values.
+        std::int64_t count() const
+        {
+            return count_.load(std::memory_order_relaxed);
+        }
+
+        // Return the largest recorded value.
+        std::int64_t max() const
+        {
+            return max_.load(std::memory_order_relaxed);
+        }
+
+        // Return the value below which the given percentage (0 to 100) of
+        // the recorded values fall. Returns zero if no values were recorded.
+        std::int64_t value_at_percentile(double percentile) const;
+
+        // Discard all recorded values.
+        void reset();
+
+    private:
+        std::size_t index_of(std::uint64_t value) const
+        {
+            if (value < sub_bucket_count_)
+                return static_cast<std::size_t>(value);
+
+            // the bucket holding values in [2^(msb), 2^(msb + 1))
+            int shift = floor_log2(value) - precision_bits_ + 1;
+            return static_cast<std::size_t>(sub_bucket_count_ +
+                (shift - 1) * half_count_ + (value >> shift) - half_count_);
+        }
+
+        std::int64_t highest_equivalent_value(std::size_t index) const;
+
+        static int floor_log2(std::uint64_t value)
+        {
+            int result = 0;
+            if (value >= std::uint64_t(1) << 32) { value >>= 32; result += 32; }
+            if (value >= std::uint64_t(1) << 16) { value >>= 16; result += 16; }
+            if (value >= std::uint64_t(1) << 8)  { value >>= 8;  result += 8; }
+            if (value >= std::uint64_t(1) << 4)  { value >>= 4;  result += 4; }
+            if (value >= std::uint64_t(1) << 2)  { value >>= 2;  result += 2; }
+            if (value >= std::uint64_t(1) << 1)  { result += 1; }
+            return result;
+        }
+
+        int const precision_bits_;
+        std::uint64_t const sub_bucket_count_;
+        std::uint64_t const half_count_;
+        std::int64_t const max_value_;
+
+        std::size_t size_;
+        std::unique_ptr<std::atomic<std::int64_t>[]> counts_;
+
+        std::atomic<std::int64_t> count_;
+        std::atomic<std::int64_t> max_;
+    };
+}}
+
+#endif
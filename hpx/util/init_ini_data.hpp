@@ -15,6 +15,8 @@
 
 #include <boost/filesystem/path.hpp>
 
+#include <cstdint>
+#include <ctime>
 #include <map>
 #include <memory>
 #include <string>
@@ -46,13 +48,52 @@ namespace hpx { namespace util
     // global function to read component ini information
     void merge_component_inis(section& ini);
 
+    ///////////////////////////////////////////////////////////////////////////
+    // The registry information of the shared libraries found in the component
+    // paths, as stored in the file given by hpx.component_registry_cache.
+    // Libraries which did not change since the file was written don't have
+    // to be loaded while reading the configuration, unless they export
+    // plugins.
+    class module_registry_cache
+    {
+    public:
+        struct entry
+        {
+            std::uintmax_t size_;
+            std::time_t last_write_time_;
+            bool has_components_;
+            bool has_plugins_;
+            std::vector<std::string> ini_data_;     // component registry data
+        };
+
+        explicit module_registry_cache(std::string const& filename);
+
+        // Return the cached registry information of the given library, or
+        // nullptr if it is not known or has changed since it was cached.
+        entry const* find(boost::filesystem::path const& lib);
+
+        // Store the registry information of the given library.
+        void insert(boost::filesystem::path const& lib, entry e);
+
+        // Write the registry information of all libraries which have been
+        // looked up or inserted, if anything has changed.
+        void save() const;
+
+    private:
+        std::string filename_;
+        std::map<std::string, entry> cached_;
+        std::map<std::string, entry> current_;
+        bool modified_;
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     // iterate over all shared libraries in the given directory and construct
     // default ini settings assuming all of those are components
     std::vector<std::shared_ptr<plugins::plugin_registry_base> >
     init_ini_data_default(std::string const& libs, section& ini,
         std::map<std::string, boost::filesystem::path>& basenames,
-        std::map<std::string, hpx::util::plugin::dll>& modules);
+        std::map<std::string, hpx::util::plugin::dll>& modules,
+        module_registry_cache* cache = nullptr);
 
 }}
 
@@ -89,6 +89,19 @@ namespace hpx { namespace util
 
         bool stopped();
 
+        /// \brief Stop the threads of the pool without stopping the
+        ///        io_service objects. From now on their handlers have to be
+        ///        run by calling poll(), until the threads are started again
+        ///        by run().
+        void release_threads();
+
+        /// \brief Run the handlers of all io_service objects which are ready
+        ///        to run without blocking. This must not be called while the
+        ///        threads of the pool are running.
+        ///
+        /// \returns The number of handlers which have been run.
+        std::size_t poll();
+
         /// \brief Get an io_service to use.
         boost::asio::io_service& get_io_service(int index = -1);
 
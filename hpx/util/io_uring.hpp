@@ -0,0 +1,222 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_UTIL_IO_URING_HPP
+#define HPX_UTIL_IO_URING_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_IO_URING)
+
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace util { namespace uring
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// An asynchronous operation submitted to the ring. The completion
+    /// function is invoked with the result of the operation, which is the
+    /// number of transferred bytes (or the accepted file descriptor) on
+    /// success, or a negated error number.
+    struct operation
+    {
+        typedef void (*completion_type)(operation&, int);
+
+        explicit operation(completion_type f)
+          : complete_(f)
+        {}
+
+        completion_type complete_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A wrapper around a single io_uring instance, set up directly through
+    /// the system calls (liburing is not required).
+    ///
+    /// Operations can be submitted from any thread, they are only queued in
+    /// the submission ring. All queued operations are handed to the kernel
+    /// with a single io_uring_enter when the ring is polled next, the
+    /// completions are handled on the polling thread. The ring is polled from
+    /// the background work of the HPX worker threads, no thread ever blocks
+    /// in the kernel waiting for completions.
+    ///
+    /// The files used with the ring (for instance the sockets of the io_uring
+    /// parcelport) can be kept in a table of fixed files, which saves the
+    /// kernel from looking up the file for each operation. Each slot of that
+    /// table has a small control block in a registered buffer (buffer 0),
+    /// which can be used for small fixed size transfers. Further buffers can
+    /// be registered explicitly. The ring falls back to ordinary file
+    /// descriptors and buffers if the kernel does not support either of
+    /// these features, or if the table is full.
+    class HPX_EXPORT ring
+    {
+    public:
+        HPX_NON_COPYABLE(ring);
+
+        /// The size of the registered control block of each connection.
+        static constexpr std::size_t control_block_size = 64;
+
+    private:
+        typedef lcos::local::spinlock mutex_type;
+
+    public:
+        /// Create a ring with the given number of submission queue entries
+        /// and the given number of slots for fixed files.
+        ring(unsigned entries, unsigned num_files);
+        ~ring();
+
+        /// Add the given socket to the table of fixed files. Return the
+        /// index of the slot, or -1 if the socket could not be registered.
+        int register_file(int fd);
+
+        /// Remove the socket registered in the given slot from the table.
+        void unregister_file(int index);
+
+        /// Register the given memory as a fixed buffer. Return the index of
+        /// the buffer, or -1 if it could not be registered. Registering a
+        /// buffer waits for all operations in flight to complete, it must
+        /// not be used with rings which have operations in flight which may
+        /// not complete by themselves (like reads from sockets).
+        int register_buffer(void* data, std::size_t size);
+
+        /// Remove the buffer registered with the given index, no operation
+        /// referring to that buffer may be in flight.
+        void unregister_buffer(int index);
+
+        /// Return the index of the registered buffer fully covering the
+        /// given memory, or -1 if there is none.
+        int find_buffer(void const* data, std::size_t size) const;
+
+        /// Return the registered control block belonging to the given slot
+        /// of the table of fixed files, or nullptr if there is none.
+        char* control_block(int index) const noexcept
+        {
+            if (index < 0 || buffers_ == nullptr)
+                return nullptr;
+            return buffers_ + std::size_t(index) * control_block_size;
+        }
+
+        /// Queue an operation. The function \a prepare fills in the
+        /// submission queue entry (except for the user data). The operation
+        /// is handed to the kernel during the next call to \a poll.
+        template <typename F>
+        void submit(operation& op, F && prepare)
+        {
+            std::unique_lock<mutex_type> l(sq_mtx_);
+
+            if (sq_tail_local_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) ==
+                    sq_entries_)
+            {
+                wait_for_sqe(l);
+            }
+
+            unsigned const tail = sq_tail_local_;
+
+            io_uring_sqe& sqe = sqes_[tail & sq_mask_];
+            std::memset(&sqe, 0, sizeof(sqe));
+            prepare(sqe);
+            sqe.user_data = reinterpret_cast<std::uint64_t>(&op);
+
+            in_flight_.fetch_add(1, std::memory_order_relaxed);
+
+            // the store of the tail publishes the entry to the kernel
+            sq_array_[tail & sq_mask_] = tail & sq_mask_;
+            sq_tail_local_ = tail + 1;
+            __atomic_store_n(sq_tail_, sq_tail_local_, __ATOMIC_RELEASE);
+
+            pending_.store(true, std::memory_order_release);
+        }
+
+        /// Submit all queued operations and handle the completed ones. This
+        /// never blocks, the function returns false if there was nothing to
+        /// do (or if another thread is polling the ring already).
+        bool poll();
+
+        /// Return the number of operations which have been submitted but
+        /// have not completed yet.
+        std::size_t in_flight() const noexcept
+        {
+            return in_flight_.load(std::memory_order_relaxed);
+        }
+
+        /// Return whether the table of fixed files could be set up.
+        bool has_fixed_files() const noexcept
+        {
+            return !files_.empty();
+        }
+
+    private:
+        void release() noexcept;
+        bool update_buffers();
+        void wait_for_sqe(std::unique_lock<mutex_type>& l);
+        bool flush();
+        bool reap();
+
+    private:
+        int fd_;
+
+        // the submission queue, protected by sq_mtx_
+        mutex_type sq_mtx_;
+        unsigned* sq_head_;
+        unsigned* sq_tail_;
+        unsigned* sq_flags_;
+        unsigned* sq_array_;
+        unsigned sq_mask_;
+        unsigned sq_entries_;
+        unsigned sq_tail_local_;
+        unsigned sq_submitted_;
+        io_uring_sqe* sqes_;
+        std::atomic<bool> pending_;
+
+        char pad0_[threads::get_cache_line_size()];
+
+        // the completion queue, protected by cq_mtx_
+        mutex_type cq_mtx_;
+        unsigned* cq_head_;
+        unsigned* cq_tail_;
+        unsigned cq_mask_;
+        io_uring_cqe* cqes_;
+
+        char pad1_[threads::get_cache_line_size()];
+
+        std::atomic<std::size_t> in_flight_;
+
+        // the mapped memory of the rings
+        void* sq_ring_;
+        std::size_t sq_ring_size_;
+        void* cq_ring_;
+        std::size_t cq_ring_size_;
+        std::size_t sqes_size_;
+
+        // the table of fixed files and their control blocks and the table of
+        // registered buffers, protected by files_mtx_
+        mutable mutex_type files_mtx_;
+        std::vector<int> files_;
+        std::vector<int> free_files_;
+        char* buffers_;
+        std::vector<iovec> buffer_table_;
+        std::vector<int> free_buffers_;
+        void* placeholder_;                 // occupies unused buffer slots
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
+
+#endif
@@ -0,0 +1,172 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_LOCK_PROFILER_HPP)
+#define HPX_UTIL_LOCK_PROFILER_HPP
+
+#include <hpx/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#if defined(HPX_HAVE_LOCK_PROFILING) && defined(HPX_MSVC)
+#include <intrin.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// The lock profiler records how long locks are waited for and held, and how
+// many threads were contending for them. The statistics are kept per call
+// site (the code address acquiring the lock) and kind of lock. Only every
+// n-th acquisition is measured (hpx.lock_profiling.sample_rate), the totals
+// reported are estimated from the sampled acquisitions.
+//
+// The profiler is enabled by setting hpx.lock_profiling.enabled, the
+// statistics are exposed as the performance counters /locks/... and a
+// report of the most contended call sites can be written at shutdown.
+#if defined(HPX_HAVE_LOCK_PROFILING)
+#if defined(HPX_MSVC)
+#define HPX_LOCK_PROFILING_CALLER() _ReturnAddress()
+#elif defined(__GNUC__)
+#define HPX_LOCK_PROFILING_CALLER() __builtin_return_address(0)
+#else
+#define HPX_LOCK_PROFILING_CALLER() nullptr
+#endif
+#endif
+
+namespace hpx { namespace util { namespace lock_profiling
+{
+    enum lock_kind
+    {
+        kind_spinlock = 0,
+        kind_mutex = 1,
+        kind_shared_mutex = 2,
+        kind_condition_variable = 3,
+        kind_scheduler_mutex = 4,
+        kind_untracked = 5          // used for waits accounted for elsewhere
+    };
+
+    // The statistics which can be queried for a call site
+    enum statistic
+    {
+        stat_acquisitions = 0,      // estimated number of acquisitions
+        stat_contentions = 1,       // estimated number of contended ones
+        stat_wait_time = 2,         // estimated total wait time [ns]
+        stat_hold_time = 3,         // estimated total hold time [ns]
+        stat_max_contenders = 4,    // maximum number of waiting threads
+        stat_last
+    };
+
+#if defined(HPX_HAVE_LOCK_PROFILING)
+    // This is set while the locks are being profiled.
+    extern HPX_EXPORT bool lock_profiling_enabled;
+
+    // The functions below record the given call site or, if none is given,
+    // the code address calling them.
+
+    // Called when a lock was acquired without waiting for it.
+    HPX_EXPORT void acquired(void const* lock, lock_kind kind,
+        void const* site = nullptr);
+
+    // Called before waiting for a lock held by somebody else, the returned
+    // value has to be passed to wait_end once the wait is over.
+    HPX_EXPORT std::uint64_t wait_begin(void const* lock);
+
+    // Called after waiting for a lock, the lock is held afterwards unless
+    // the kind is kind_condition_variable.
+    HPX_EXPORT void wait_end(void const* lock, lock_kind kind,
+        std::uint64_t token, void const* site = nullptr);
+
+    // Called before a lock is released.
+    HPX_EXPORT void released(void const* lock);
+
+    // Start profiling, measuring every sample_rate-th acquisition. The
+    // report of the top call sites is written to the given file when the
+    // profiler is stopped ("cout" and "cerr" refer to the standard streams,
+    // no report is written if the name is empty).
+    HPX_EXPORT void start_lock_profiling(std::size_t sample_rate,
+        std::string const& report, std::size_t report_top);
+
+    // Stop profiling and write the report, if requested.
+    HPX_EXPORT void stop_lock_profiling();
+
+    // Write the report listing the top call sites by wait time.
+    HPX_EXPORT void write_report(std::ostream& os, std::size_t top);
+
+    // Return the names of all call sites recorded so far.
+    HPX_EXPORT std::vector<std::string> get_site_names();
+
+    // Return the given statistic for the call site with the given name, or
+    // for all call sites if the name is empty.
+    HPX_EXPORT std::int64_t get_statistic(statistic stat,
+        std::string const& site, bool reset);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A wrapper profiling a std::mutex compatible mutex, used for the
+    // mutexes internal to the scheduler.
+    template <typename Mutex, lock_kind Kind = kind_scheduler_mutex>
+    class profiled_mutex
+    {
+    public:
+        HPX_NON_COPYABLE(profiled_mutex);
+
+        profiled_mutex() = default;
+
+        void lock()
+        {
+            if (HPX_LIKELY(!lock_profiling_enabled))
+            {
+                mtx_.lock();
+                return;
+            }
+
+            if (mtx_.try_lock())
+            {
+                acquired(this, Kind);
+                return;
+            }
+
+            std::uint64_t token = wait_begin(this);
+            mtx_.lock();
+            wait_end(this, Kind, token);
+        }
+
+        bool try_lock()
+        {
+            if (!mtx_.try_lock())
+                return false;
+
+            if (HPX_UNLIKELY(lock_profiling_enabled))
+                acquired(this, Kind);
+            return true;
+        }
+
+        void unlock()
+        {
+            if (HPX_UNLIKELY(lock_profiling_enabled))
+                released(this);
+            mtx_.unlock();
+        }
+
+    private:
+        Mutex mtx_;
+    };
+#else
+    HPX_CONSTEXPR_OR_CONST bool lock_profiling_enabled = false;
+
+    inline void start_lock_profiling(std::size_t, std::string const&,
+        std::size_t)
+    {
+    }
+
+    inline void stop_lock_profiling()
+    {
+    }
+#endif
+}}}
+
+#endif
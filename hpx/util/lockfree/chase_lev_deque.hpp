@@ -0,0 +1,201 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Algorithms from "Dynamic Circular Work-Stealing Deque"
+//  by D. Chase and Y. Lev
+//  Link: http://dl.acm.org/citation.cfm?id=1073974
+//
+//  using the memory orderings from "Correct and Efficient Work-Stealing for
+//  Weak Memory Models" by N. M. Le, A. Pop, A. Cohen and F. Zappa Nardelli
+//  Link: http://dl.acm.org/citation.cfm?id=2442524
+//
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//  Disclaimer: Not a Boost library.
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPX_UTIL_LOCKFREE_CHASE_LEV_DEQUE_HPP)
+#define HPX_UTIL_LOCKFREE_CHASE_LEV_DEQUE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace boost { namespace lockfree
+{
+
+// The owner of the deque pushes and pops items at the bottom end without
+// using any read-modify-write operations (except when racing a thief for the
+// last item). Any other thread may steal items from the top end.
+//
+// The buffer grows whenever the owner pushes onto a full deque. Buffers
+// which were replaced are kept alive until the deque is destroyed as thieves
+// might still be reading from them.
+template <typename T>
+struct chase_lev_deque
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+        "chase_lev_deque requires trivially copyable items");
+
+  private:
+    struct buffer
+    {
+        explicit buffer(std::size_t size)
+          : mask_(size - 1), items_(new std::atomic<T>[size])
+        {}
+
+        std::size_t size() const
+        {
+            return mask_ + 1;
+        }
+
+        T get(std::int64_t index) const
+        {
+            return items_[std::size_t(index) & mask_].load(
+                std::memory_order_relaxed);
+        }
+
+        void put(std::int64_t index, T const& val)
+        {
+            items_[std::size_t(index) & mask_].store(
+                val, std::memory_order_relaxed);
+        }
+
+        // copy the items [top, bottom) into a new buffer of twice the size
+        buffer* grow(std::int64_t top, std::int64_t bottom) const
+        {
+            buffer* b = new buffer(2 * size());
+            for (std::int64_t i = top; i != bottom; ++i)
+                b->put(i, get(i));
+            return b;
+        }
+
+        std::size_t const mask_;
+        std::unique_ptr<std::atomic<T>[]> items_;
+    };
+
+    static std::size_t adjust_size(std::size_t size)
+    {
+        // round up to the next power of two
+        std::size_t result = 16;
+        while (result < size)
+            result <<= 1;
+        return result;
+    }
+
+  public:
+    typedef T value_type;
+
+    explicit chase_lev_deque(std::size_t initial_size = 0)
+      : top_(0), bottom_(0)
+    {
+        buffers_.emplace_back(new buffer(adjust_size(initial_size)));
+        buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+    }
+
+    chase_lev_deque(chase_lev_deque const&) = delete;
+    chase_lev_deque& operator=(chase_lev_deque const&) = delete;
+
+    // Push the given item onto the bottom of the deque, owner only.
+    bool push_bottom(T const& val)
+    {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        buffer* a = buffer_.load(std::memory_order_relaxed);
+
+        if (b - t > std::int64_t(a->size()) - 1)
+        {
+            // the deque is full, grow the buffer
+            buffers_.emplace_back(a->grow(t, b));
+            a = buffers_.back().get();
+            buffer_.store(a, std::memory_order_release);
+        }
+
+        a->put(b, val);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Pop an item from the bottom of the deque, owner only.
+    bool pop_bottom(T& val)
+    {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        buffer* a = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            // the deque is empty
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        val = a->get(b);
+        if (t == b)
+        {
+            // this is the last item, race against thieves
+            bool result = top_.compare_exchange_strong(t, t + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return result;
+        }
+        return true;
+    }
+
+    // Steal an item from the top of the deque, may be called from any
+    // thread. Returns false if the deque is empty or if the item was taken
+    // by a concurrent thief or the owner.
+    bool steal_top(T& val)
+    {
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = bottom_.load(std::memory_order_acquire);
+
+        if (t >= b)
+            return false;
+
+        buffer* a = buffer_.load(std::memory_order_acquire);
+        val = a->get(t);
+        return top_.compare_exchange_strong(t, t + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    bool empty() const
+    {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+        return b <= t;
+    }
+
+    std::size_t capacity() const
+    {
+        return buffer_.load(std::memory_order_relaxed)->size();
+    }
+
+  private:
+    // top_ is modified by the thieves, bottom_ by the owner only, keep them
+    // on separate cache lines
+    std::atomic<std::int64_t> top_;
+    char pad0_[hpx::threads::get_cache_line_size() - sizeof(std::int64_t)];
+    std::atomic<std::int64_t> bottom_;
+    std::atomic<buffer*> buffer_;
+    char pad1_[hpx::threads::get_cache_line_size() - sizeof(std::int64_t)
+        - sizeof(buffer*)];
+
+    // all buffers ever used by this deque, only accessed by the owner
+    std::vector<std::unique_ptr<buffer> > buffers_;
+};
+
+}}
+
+#endif // HPX_UTIL_LOCKFREE_CHASE_LEV_DEQUE_HPP
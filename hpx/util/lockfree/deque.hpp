@@ -162,9 +162,23 @@ struct deque
     typedef typename std::conditional<
         std::is_same<freelist_t, caching_freelist_t>::value,
         caching_freelist<node, node_allocator>,
-        static_freelist<node, node_allocator>
+        typename std::conditional<
+            std::is_same<freelist_t, reclaiming_freelist_t>::value,
+            reclaiming_freelist<node, node_allocator>,
+            static_freelist<node, node_allocator>
+        >::type
     >::type pool;
 
+    // Nodes handed back to the reclaiming freelist may be returned to the
+    // allocator, all operations have to protect the nodes they access.
+    struct no_guard { no_guard() {} };
+
+    typedef typename std::conditional<
+        std::is_same<freelist_t, reclaiming_freelist_t>::value,
+        hpx::util::lockfree::epoch_guard,
+        no_guard
+    >::type guard;
+
   private:
     anchor anchor_;
     pool pool_;
@@ -280,6 +294,13 @@ struct deque
     bool empty() const
     { return anchor_.lrs().get_left_ptr() == nullptr; }
 
+    // Thread-safe. Retires the cached nodes exceeding the given number, those
+    // are returned to the allocator once no thread can access them anymore.
+    // Available with the reclaiming freelist only.
+    // Complexity: O(N)
+    std::size_t trim(std::size_t keep = 0)
+    { return pool_.trim(keep); }
+
     // Thread-safe and non-blocking.
     // Complexity: O(1)
     bool is_lock_free() const
@@ -291,6 +312,8 @@ struct deque
     // Complexity: O(Processes)
     bool push_left(T const& data)
     {
+        guard g;
+
         // Allocate the new node which we will be inserting.
         node* n = alloc_node(nullptr, nullptr, data);
 
@@ -348,6 +371,8 @@ struct deque
     // Complexity: O(Processes)
     bool push_right(T const& data)
     {
+        guard g;
+
         // Allocate the new node which we will be inserting.
         node* n = alloc_node(nullptr, nullptr, data);
 
@@ -403,6 +428,8 @@ struct deque
     // Complexity: O(Processes)
     bool pop_left(T& r)
     {
+        guard g;
+
         // Loop until we either pop an element or learn that the deque is empty.
         while (true)
         {
@@ -464,6 +491,8 @@ struct deque
     // Complexity: O(Processes)
     bool pop_right(T& r)
     {
+        guard g;
+
         // Loop until we either pop an element or learn that the deque is empty.
         while (true)
         {
@@ -0,0 +1,110 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_LOCKFREE_EPOCH_HPP)
+#define HPX_UTIL_LOCKFREE_EPOCH_HPP
+
+#include <hpx/config.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace hpx { namespace util { namespace lockfree
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Epoch based reclamation of the nodes of lock-free data structures (see
+    // K. Fraser, "Practical lock-freedom", 2004).
+    //
+    // Every OS thread accessing such a data structure does so inside of an
+    // epoch_guard, which announces the global epoch the thread has observed.
+    // Nodes which were unlinked are retired instead of being deleted, they are
+    // deleted once the global epoch has advanced twice, at that point no
+    // thread can still hold a reference to them. The global epoch advances
+    // only if all threads inside of a guard have observed the current one.
+    //
+    // Retired nodes are collected by the thread which retired them, either
+    // every once in a while when retiring further nodes or whenever the
+    // scheduling loop of a worker thread calls collect().
+    class HPX_EXPORT epoch_domain
+    {
+    public:
+        HPX_NON_COPYABLE(epoch_domain);
+
+        typedef void (*deleter_type)(void*);
+
+        struct thread_record;
+
+    private:
+        epoch_domain();
+        ~epoch_domain();
+
+    public:
+        static epoch_domain& get();
+
+        // Hand the given node to the domain, it will be deleted by calling
+        // the given function once no thread can access it anymore.
+        void retire(void* p, deleter_type deleter);
+
+        // Try to advance the global epoch and delete the nodes retired by
+        // the calling thread which have become unreachable. Returns the
+        // number of deleted nodes.
+        std::size_t collect();
+
+        // The number of retired nodes which were not deleted yet.
+        std::size_t retired_count() const
+        {
+            return retired_.load(std::memory_order_relaxed);
+        }
+
+        std::uint64_t epoch() const
+        {
+            return epoch_.load(std::memory_order_acquire);
+        }
+
+        thread_record* enter();
+        void leave(thread_record* record);
+
+    private:
+        thread_record* get_record();
+        bool try_advance(std::uint64_t epoch);
+        std::size_t collect(thread_record* record, std::uint64_t epoch);
+
+        std::atomic<std::uint64_t> epoch_;
+        std::atomic<thread_record*> records_;
+        std::atomic<std::size_t> retired_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Marks the calling thread as accessing the nodes of lock-free data
+    // structures, guards can be nested.
+    class epoch_guard
+    {
+    public:
+        HPX_NON_COPYABLE(epoch_guard);
+
+    public:
+        epoch_guard()
+          : record_(epoch_domain::get().enter())
+        {}
+
+        ~epoch_guard()
+        {
+            epoch_domain::get().leave(record_);
+        }
+
+    private:
+        epoch_domain::thread_record* record_;
+    };
+
+    // Delete the retired nodes which became unreachable, called by the
+    // scheduling loops of the worker threads.
+    inline std::size_t collect_retired_nodes()
+    {
+        return epoch_domain::get().collect();
+    }
+}}}
+
+#endif
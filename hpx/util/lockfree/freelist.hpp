@@ -6,12 +6,17 @@
 #if !defined(HPX_UTIL_LOCKFREE_FIFO_AUG_31_2012_0935PM)
 #define HPX_UTIL_LOCKFREE_FIFO_AUG_31_2012_0935PM
 
+#include <hpx/util/lockfree/epoch.hpp>
+
 #include <boost/version.hpp>
 
 #include <boost/lockfree/policies.hpp>
 #include <boost/lockfree/queue.hpp>
 
+#include <atomic>
 #include <cstddef>
+#include <cstring>
+#include <memory>
 
 namespace boost { namespace lockfree
 {
@@ -60,8 +65,91 @@ namespace boost { namespace lockfree
         }
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Caches up to the given number of nodes, nodes deallocated beyond that
+    // are returned to the allocator once no thread can access them anymore
+    // (see hpx::util::lockfree::epoch_domain). All accesses to the nodes
+    // handed out by this freelist, as well as all calls to allocate, have to
+    // happen inside of an epoch_guard.
+    //
+    // The allocator has to be stateless, as retired nodes may outlive the
+    // freelist.
+    template <typename T, typename Alloc = std::allocator<T> >
+    class reclaiming_freelist
+      : public lockfree::detail::freelist_stack<T, Alloc>
+    {
+        typedef lockfree::detail::freelist_stack<T, Alloc> base_type;
+
+        static void destroy(void* p)
+        {
+            Alloc().deallocate(static_cast<T*>(p), 1);
+        }
+
+    public:
+        reclaiming_freelist (std::size_t n = 0)
+          : lockfree::detail::freelist_stack<T, Alloc>(Alloc(), n)
+          , cached_(n)
+          , max_cached_(n)
+        {}
+
+        T* allocate()
+        {
+            T* n = this->base_type::template allocate<true, true>();
+            if (n != nullptr)
+            {
+                cached_.fetch_sub(1, std::memory_order_relaxed);
+                return n;
+            }
+
+            n = Alloc().allocate(1);
+            std::memset(n, 0, sizeof(T));
+            return n;
+        }
+
+        void deallocate(T* n)
+        {
+            if (cached_.load(std::memory_order_relaxed) < max_cached_)
+            {
+                cached_.fetch_add(1, std::memory_order_relaxed);
+                this->base_type::template deallocate<true>(n);
+                return;
+            }
+            hpx::util::lockfree::epoch_domain::get().retire(n, &destroy);
+        }
+
+        // Retire the cached nodes exceeding the given number, returns the
+        // number of retired nodes.
+        std::size_t trim(std::size_t keep = 0)
+        {
+            hpx::util::lockfree::epoch_guard guard;
+
+            std::size_t count = 0;
+            while (cached_.load(std::memory_order_relaxed) > keep)
+            {
+                T* n = this->base_type::template allocate<true, true>();
+                if (n == nullptr)
+                    break;
+
+                cached_.fetch_sub(1, std::memory_order_relaxed);
+                hpx::util::lockfree::epoch_domain::get().retire(n, &destroy);
+                ++count;
+            }
+            return count;
+        }
+
+        std::size_t cached() const
+        {
+            return cached_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<std::size_t> cached_;
+        std::size_t const max_cached_;
+    };
+
     struct caching_freelist_t {};
     struct static_freelist_t {};
+    struct reclaiming_freelist_t {};
 }}
 
 #endif
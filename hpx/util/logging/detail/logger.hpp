@@ -107,7 +107,9 @@ namespace hpx { namespace util { namespace logging {
             mutable bool m_use;
         };
 
-        logger() {}
+        typedef void (*deferred_write_type)(logger const&, msg_type&&);
+
+        logger() : m_deferred_write(nullptr) {}
 
         ~logger() {
             // force writing all messages from cache,
@@ -151,12 +153,27 @@ namespace hpx { namespace util { namespace logging {
             turn_cache_off();
         }
 
+        /** @brief Hands the gathered messages to @c f instead of writing them
+
+        @c f is expected to eventually pass the message to writer(), for
+        instance from another thread. Pass nullptr to write the messages
+        in the logging thread again. This must not be changed while messages
+        are being logged.
+        */
+        void defer_writes(deferred_write_type f) {
+            m_deferred_write = f;
+        }
+
     public:
         // called after all data has been gathered
         void do_write(msg_type msg) const
         {
-            if ( cache().is_cache_turned_off() )
-                writer()(msg);
+            if ( cache().is_cache_turned_off() ) {
+                if ( m_deferred_write)
+                    m_deferred_write(*this, std::move(msg));
+                else
+                    writer()(msg);
+            }
             else
                 cache().add_msg(std::move(msg));
         }
@@ -164,6 +181,7 @@ namespace hpx { namespace util { namespace logging {
     private:
         cache_type m_cache;
         write_type m_writer;
+        deferred_write_type m_deferred_write;
     };
 
 }}}
@@ -17,6 +17,7 @@
 #ifndef JT28092007_high_precision_time_HPP_DEFINED
 #define JT28092007_high_precision_time_HPP_DEFINED
 
+#include <hpx/config/compiler_native_tls.hpp>
 #include <hpx/util/logging/detail/fwd.hpp>
 
 #include <hpx/util/logging/format/formatter/convert_format.hpp>
@@ -35,7 +36,26 @@
 #include <mutex>
 #endif
 
-namespace hpx { namespace util { namespace logging { namespace formatter {
+namespace hpx { namespace util { namespace logging {
+
+namespace detail {
+    /**
+    While a message whose writing has been deferred (see logger::defer_writes)
+    is written, this refers to the time the message was logged.
+    */
+    inline std::chrono::system_clock::time_point const*& deferred_log_time() {
+        static HPX_NATIVE_TLS std::chrono::system_clock::time_point const* time =
+            nullptr;
+        return time;
+    }
+
+    inline std::chrono::system_clock::time_point log_time() {
+        std::chrono::system_clock::time_point const* time = deferred_log_time();
+        return time ? *time : std::chrono::system_clock::now();
+    }
+}
+
+namespace formatter {
 
 
 /**
@@ -128,7 +148,7 @@ template<class convert = do_convert_format::prepend> struct high_precision_time_
     }
 
     void operator()(msg_type & msg) const {
-        write_high_precision_time(msg, std::chrono::system_clock::now());
+        write_high_precision_time(msg, logging::detail::log_time());
     }
 
     bool operator==(const high_precision_time_t & other) const {
@@ -12,6 +12,7 @@
 #include <hpx/util/assert.hpp>
 #include <hpx/util/wrapper_heap_base.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <list>
 #include <memory>
@@ -60,6 +61,8 @@ namespace hpx { namespace util
 #endif
             , create_heap_(nullptr)
             , parameters_({0, 0, 0})
+            , magazines_(nullptr)
+            , num_magazines_(0)
         {
             HPX_ASSERT(false); // shouldn't ever be called
         }
@@ -76,6 +79,8 @@ namespace hpx { namespace util
 #endif
             , create_heap_(&one_size_heap_list::create_heap<Heap>)
             , parameters_(parameters)
+            , magazines_(nullptr)
+            , num_magazines_(0)
         {}
 
         template <typename Heap>
@@ -90,6 +95,8 @@ namespace hpx { namespace util
 #endif
             , create_heap_(&one_size_heap_list::create_heap<Heap>)
             , parameters_(parameters)
+            , magazines_(nullptr)
+            , num_magazines_(0)
         {}
 
         ~one_size_heap_list() noexcept;
@@ -106,11 +113,29 @@ namespace hpx { namespace util
 
         std::string name() const;
 
+        // number of consecutive elements a worker thread reserves at once
+        HPX_STATIC_CONSTEXPR std::size_t magazine_size = 64;
+
     protected:
+        // Return the heap which has allocated the given pointer
+        std::shared_ptr<util::wrapper_heap_base> find_heap(void* p) const;
+
         mutable mutex_type mtx_;
         list_type heap_list_;
 
     private:
+        // Every worker thread reserves a range of consecutive elements from
+        // one of the heaps and hands those out without touching the list of
+        // heaps. The reserved elements are never given back to the heap,
+        // thus the global ids of the elements are never reused.
+        struct magazine;
+
+        magazine* get_magazine();
+        magazine* find_magazine() const;
+
+        std::shared_ptr<util::wrapper_heap_base> alloc_from_heaps(
+            void** result, std::size_t& count, bool partial);
+
         std::string const class_name_;
 
     public:
@@ -124,6 +149,10 @@ namespace hpx { namespace util
             char const*, std::size_t, heap_parameters);
 
         heap_parameters const parameters_;
+
+    private:
+        magazine* magazines_;
+        std::atomic<std::size_t> num_magazines_;
     };
 }}
 
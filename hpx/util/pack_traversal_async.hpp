@@ -19,6 +19,10 @@ namespace util {
     /// if an element is visited after the traversal was detached.
     using detail::async_traverse_detach_tag;
     /// A tag which is passed to the `operator()` of the visitor
+    /// if the remaining elements of a range are visited after the traversal
+    /// was detached (optional).
+    using detail::async_traverse_detach_range_tag;
+    /// A tag which is passed to the `operator()` of the visitor
     /// if the asynchronous pack traversal was finished.
     using detail::async_traverse_complete_tag;
 
@@ -57,6 +61,18 @@ namespace util {
     ///        {
     ///        }
     ///
+    ///        /// This overload is optional. If it is provided, it is
+    ///        /// called instead of the one above when the synchronous
+    ///        /// overload returned false for an element of a range. It
+    ///        /// receives the remaining elements of the range (starting
+    ///        /// at the current one) and a continuation which resumes the
+    ///        /// traversal after the end of the range.
+    ///        template <typename R, typename N>
+    ///        void operator()(async_traverse_detach_range_tag, R&& range,
+    ///            N&& next)
+    ///        {
+    ///        }
+    ///
     ///        /// The overload is called when the traversal was finished.
     ///        /// As argument the whole pack is passed over which we
     ///        /// traversed asynchronously.
@@ -0,0 +1,182 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The Philox4x32-10 counter based random number generator is described in:
+// J. K. Salmon, M. A. Moraes, R. O. Dror, D. E. Shaw, "Parallel random
+// numbers: as easy as 1, 2, 3", SC'11.
+
+#ifndef HPX_UTIL_PHILOX_ENGINE_HPP
+#define HPX_UTIL_PHILOX_ENGINE_HPP
+
+#include <hpx/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// A random number engine based on the Philox4x32-10 counter based
+    /// generator. The n-th block of four numbers of the sequence is a
+    /// (bijective) function of the key and the counter n only. Unlike the
+    /// state of a conventional engine, the sequence for a given (seed,
+    /// stream) pair can be created from scratch anywhere and at any time,
+    /// which allows to derive independent, reproducible sequences for every
+    /// element of a range processed in parallel (by using the index of the
+    /// element as the stream).
+    ///
+    /// The engine meets the requirements of a UniformRandomBitGenerator and
+    /// can be used with the distributions of the standard library.
+    class philox_engine
+    {
+    public:
+        typedef std::uint32_t result_type;
+
+        HPX_STATIC_CONSTEXPR std::uint64_t default_seed = 20111115u;
+
+        HPX_HOST_DEVICE static HPX_CONSTEXPR result_type (min)()
+        {
+            return 0;
+        }
+        HPX_HOST_DEVICE static HPX_CONSTEXPR result_type (max)()
+        {
+            return ~result_type(0);
+        }
+
+        /// Create the engine for the sequence identified by the given seed
+        /// (the key of the generator) and stream.
+        HPX_HOST_DEVICE explicit philox_engine(
+            std::uint64_t seed = default_seed, std::uint64_t stream = 0)
+        {
+            this->seed(seed, stream);
+        }
+
+        /// Restart the engine at the beginning of the sequence identified by
+        /// the given seed and stream.
+        HPX_HOST_DEVICE void seed(std::uint64_t seed, std::uint64_t stream = 0)
+        {
+            key_[0] = std::uint32_t(seed);
+            key_[1] = std::uint32_t(seed >> 32);
+
+            counter_[0] = 0;
+            counter_[1] = 0;
+            counter_[2] = std::uint32_t(stream);
+            counter_[3] = std::uint32_t(stream >> 32);
+
+            index_ = 4;
+        }
+
+        HPX_HOST_DEVICE result_type operator()()
+        {
+            if (index_ == 4)
+            {
+                generate_block(counter_, key_, results_);
+                increment_counter();
+                index_ = 0;
+            }
+            return results_[index_++];
+        }
+
+        HPX_HOST_DEVICE void discard(unsigned long long n)
+        {
+            // skip over whole blocks without generating them
+            std::uint64_t const available = 4 - index_;
+            if (n < available)
+            {
+                index_ += unsigned(n);
+                return;
+            }
+
+            n -= available;
+            index_ = 4;
+
+            std::uint64_t const blocks = n / 4;
+            std::uint64_t const position =
+                (std::uint64_t(counter_[1]) << 32 | counter_[0]) + blocks;
+            counter_[0] = std::uint32_t(position);
+            counter_[1] = std::uint32_t(position >> 32);
+
+            for (n %= 4; n != 0; --n)
+                (*this)();
+        }
+
+        /// Compute the block of four numbers for the given counter and key,
+        /// this is the whole generator (the engine only keeps track of the
+        /// position in the sequence).
+        HPX_HOST_DEVICE static void generate_block(
+            std::uint32_t const (&counter)[4], std::uint32_t const (&key)[2],
+            std::uint32_t (&result)[4])
+        {
+            std::uint32_t c0 = counter[0], c1 = counter[1];
+            std::uint32_t c2 = counter[2], c3 = counter[3];
+            std::uint32_t k0 = key[0], k1 = key[1];
+
+            for (int round = 0; round != 10; ++round)
+            {
+                if (round != 0)
+                {
+                    k0 += 0x9E3779B9u;
+                    k1 += 0xBB67AE85u;
+                }
+
+                std::uint64_t const p0 = std::uint64_t(0xD2511F53u) * c0;
+                std::uint64_t const p1 = std::uint64_t(0xCD9E8D57u) * c2;
+
+                std::uint32_t const hi0 = std::uint32_t(p0 >> 32);
+                std::uint32_t const lo0 = std::uint32_t(p0);
+                std::uint32_t const hi1 = std::uint32_t(p1 >> 32);
+                std::uint32_t const lo1 = std::uint32_t(p1);
+
+                c0 = hi1 ^ c1 ^ k0;
+                c1 = lo1;
+                c2 = hi0 ^ c3 ^ k1;
+                c3 = lo0;
+            }
+
+            result[0] = c0;
+            result[1] = c1;
+            result[2] = c2;
+            result[3] = c3;
+        }
+
+        friend bool operator==(philox_engine const& lhs,
+            philox_engine const& rhs)
+        {
+            if (lhs.key_[0] != rhs.key_[0] || lhs.key_[1] != rhs.key_[1] ||
+                lhs.index_ != rhs.index_)
+            {
+                return false;
+            }
+            for (int i = 0; i != 4; ++i)
+            {
+                if (lhs.counter_[i] != rhs.counter_[i])
+                    return false;
+            }
+            return true;
+        }
+
+        friend bool operator!=(philox_engine const& lhs,
+            philox_engine const& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        // the block index occupies the lower two words of the counter, the
+        // stream the upper two words
+        HPX_HOST_DEVICE void increment_counter()
+        {
+            if (++counter_[0] == 0)
+                ++counter_[1];
+        }
+
+        std::uint32_t key_[2];
+        std::uint32_t counter_[4];
+        std::uint32_t results_[4];
+        unsigned index_;
+    };
+}}
+
+#endif
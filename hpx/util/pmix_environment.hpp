@@ -0,0 +1,62 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_PMIX_ENVIRONMENT_HPP)
+#define HPX_UTIL_PMIX_ENVIRONMENT_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/util_fwd.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Access to the PMIx server of the resource manager which launched this
+    // process (srun --mpi=pmix, prterun, ...). The localities publish their
+    // bootstrap data to the PMIx key-value store and retrieve the data of
+    // their peers after a fence, which replaces the registration of each
+    // locality with the AGAS root over the network.
+    //
+    // All functions are no-ops (or throw) if HPX was built without PMIx
+    // support (HPX_WITH_PMIX=OFF) or if the process was not launched by a
+    // PMIx enabled launcher.
+    struct HPX_EXPORT pmix_environment
+    {
+        // Returns whether the process was launched by a PMIx enabled
+        // launcher and PMIx was not disabled (hpx.pmix.enable=0).
+        static bool check_pmix_environment(runtime_configuration const& cfg);
+
+        // Connect to the PMIx server, returns whether that succeeded. This
+        // may be called more than once.
+        static bool init(runtime_configuration const& cfg);
+        static void finalize();
+
+        static bool enabled();
+
+        // The rank of this process and the number of processes in the job.
+        static std::uint32_t rank();
+        static std::uint32_t size();
+
+        // Store the given value with the given key for this process, the
+        // value is visible to the other processes after the next fence.
+        static void put(std::string const& key, std::vector<char> const& data);
+
+        // Commit the stored values and wait for all processes of the job to
+        // do the same. If collect_data is false the values are fetched from
+        // their owner on the first get() instead of being distributed to all
+        // processes as part of the fence.
+        static void fence(bool collect_data = false);
+
+        // Retrieve the value stored by the process with the given rank,
+        // returns an empty vector if there is none.
+        static std::vector<char> get(std::uint32_t rank,
+            std::string const& key);
+    };
+}}
+
+#endif
@@ -11,6 +11,7 @@
 #include <hpx/runtime/agas_fwd.hpp>
 #include <hpx/runtime/components/static_factory_data.hpp>
 #include <hpx/runtime/runtime_mode.hpp>
+#include <hpx/runtime/threads/coroutines/detail/stack_pool.hpp>
 #include <hpx/runtime/threads/thread_enums.hpp>
 #include <hpx/util/ini.hpp>
 #include <hpx/util/plugin/dll.hpp>
@@ -29,6 +30,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace util
 {
+    class module_registry_cache;
+
     ///////////////////////////////////////////////////////////////////////////
     // The runtime_configuration class is a wrapper for the runtime
     // configuration data allowing to extract configuration information in a
@@ -85,6 +88,10 @@ namespace hpx { namespace util
 
         std::size_t get_agas_max_pending_refcnt_requests() const;
 
+        // the time (in microseconds) after which pending reference counting
+        // requests are sent at the latest
+        std::size_t get_agas_refcnt_flush_interval() const;
+
         // Load application specific configuration and merge it with the
         // default configuration loaded from hpx.ini
         bool load_application_configuration(char const* filename,
@@ -146,6 +153,13 @@ namespace hpx { namespace util
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
         bool init_use_stack_guard_pages() const;
 #endif
+#if defined(__linux) || defined(linux) || defined(__linux__)
+        bool init_fused_thread_data() const;
+#endif
+#if defined(HPX_COROUTINES_HAVE_STACK_POOL)
+        bool init_use_stack_pool() const;
+        std::uint64_t init_stack_pool_idle_threshold() const;
+#endif
 
         void pre_initialize_ini();
         void post_initialize_ini(std::string& hpx_ini_file,
@@ -159,14 +173,16 @@ namespace hpx { namespace util
             std::string const& component_base_paths,
             std::string const& component_path_suffixes,
             std::set<std::string>& component_paths,
-            std::map<std::string, boost::filesystem::path>& basenames);
+            std::map<std::string, boost::filesystem::path>& basenames,
+            module_registry_cache* cache);
 
         void load_component_path(
             std::vector<std::shared_ptr<plugins::plugin_registry_base>>&
                 plugin_registries,
             std::string const& path,
             std::set<std::string>& component_paths,
-            std::map<std::string, boost::filesystem::path>& basenames);
+            std::map<std::string, boost::filesystem::path>& basenames,
+            module_registry_cache* cache);
 
     public:
         runtime_mode mode_;
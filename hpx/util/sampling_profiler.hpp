@@ -0,0 +1,83 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_SAMPLING_PROFILER_HPP)
+#define HPX_UTIL_SAMPLING_PROFILER_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/util/thread_description.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+// The sampling profiler attributes the CPU time of the worker threads to the
+// HPX threads running on them. Each worker OS thread sets up a timer on its
+// own CPU time which delivers SIGPROF to it. The signal handler records the
+// description of the running HPX thread (the action name or the name given
+// to annotated_function) and walks the frame pointers of the user stack,
+// starting at the interrupted instruction. The walk stays within the stack
+// of the HPX thread and ends at the entry of its coroutine; samples taken
+// while a worker runs the scheduler itself are attributed to <scheduler>.
+//
+// Sampling is enabled by setting hpx.sampling.file. The samples are written
+// as folded stacks (one 'description;outermost;...;innermost count' line per
+// distinct stack) when the runtime stops, which can be turned into a flame
+// graph by flamegraph.pl or speedscope. Code compiled without frame pointers
+// (-fno-omit-frame-pointer) shows up with truncated stacks.
+namespace hpx { namespace util { namespace sampling
+{
+#if defined(HPX_HAVE_SAMPLING_PROFILER)
+    // This is set while sampling is active.
+    extern HPX_EXPORT bool sampling_enabled;
+
+    // Called by the scheduling loop before and after an HPX thread runs.
+    HPX_EXPORT void task_started(util::thread_description const& desc,
+        std::pair<void*, void*> const& stack_bounds);
+    HPX_EXPORT void task_stopped();
+
+    // Called by annotate_function whenever the running HPX thread changes
+    // its description.
+    HPX_EXPORT void set_annotation(util::thread_description const& desc);
+
+    // Start sampling each worker thread the given number of times per second
+    // of CPU time, recording at most max_depth frames per sample. Each worker
+    // buffers up to buffer_size samples while an HPX thread runs, the samples
+    // beyond this are dropped.
+    HPX_EXPORT void start_sampling(std::string const& filename,
+        std::size_t frequency, std::size_t max_depth,
+        std::size_t buffer_size);
+
+    // Stop sampling and write the folded stacks.
+    HPX_EXPORT void stop_sampling();
+#else
+    HPX_CONSTEXPR_OR_CONST bool sampling_enabled = false;
+
+    inline void task_started(util::thread_description const&,
+        std::pair<void*, void*> const&)
+    {
+    }
+
+    inline void task_stopped()
+    {
+    }
+
+    inline void set_annotation(util::thread_description const&)
+    {
+    }
+
+    inline void start_sampling(std::string const&, std::size_t, std::size_t,
+        std::size_t)
+    {
+    }
+
+    inline void stop_sampling()
+    {
+    }
+#endif
+}}}
+
+#endif
@@ -65,6 +65,7 @@ namespace hpx { namespace util
         static detail::spinlock_holder pool_[N];
 #if HPX_HAVE_ITTNOTIFY != 0
         static detail::itt_spinlock_init<Tag, N> init_;
+        friend struct detail::itt_spinlock_init<Tag, N>;
 #endif
 
     public:
@@ -121,7 +122,7 @@ namespace hpx { namespace util
         template <typename Tag, std::size_t N>
         itt_spinlock_init<Tag, N>::itt_spinlock_init()
         {
-            for (int i = 0; i < N; ++i)
+            for (std::size_t i = 0; i != N; ++i)
             {
                 HPX_ITT_SYNC_CREATE(&spinlock_pool<Tag, N>::pool_[i].lock,
                     "boost::detail::spinlock", 0);
@@ -133,7 +134,7 @@ namespace hpx { namespace util
         template <typename Tag, std::size_t N>
         itt_spinlock_init<Tag, N>::~itt_spinlock_init()
         {
-            for (int i = 0; i < N; ++i)
+            for (std::size_t i = 0; i != N; ++i)
             {
                 HPX_ITT_SYNC_DESTROY(&spinlock_pool<Tag, N>::pool_[i].lock);
             }
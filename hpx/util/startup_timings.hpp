@@ -0,0 +1,32 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_STARTUP_TIMINGS_HPP)
+#define HPX_UTIL_STARTUP_TIMINGS_HPP
+
+#include <hpx/config.hpp>
+
+#include <cstdint>
+#include <iosfwd>
+
+///////////////////////////////////////////////////////////////////////////////
+// The startup timings record the durations of the phases of the startup of
+// the runtime system (command line handling, module discovery, component
+// loading, etc.) on this locality. These are printed before hpx_main is
+// invoked if --hpx:print-startup-timings was given on the command line.
+namespace hpx { namespace util { namespace startup_timings
+{
+    // Start measuring, discarding all phases recorded so far.
+    HPX_EXPORT void start();
+
+    // Record the end of the phase with the given name, its duration is
+    // measured from the end of the previously recorded phase.
+    HPX_EXPORT void record(char const* phase);
+
+    // Print all recorded phases and the total startup time.
+    HPX_EXPORT void print(std::ostream& os, std::uint32_t locality_id);
+}}}
+
+#endif
@@ -0,0 +1,100 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_TAGGED_ALLOCATOR_HPP)
+#define HPX_UTIL_TAGGED_ALLOCATOR_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/util/allocation_accounting.hpp>
+#include <hpx/util/internal_allocator.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace util
+{
+#if defined(HPX_HAVE_ALLOCATION_ACCOUNTING)
+    ///////////////////////////////////////////////////////////////////////////
+    // An internal_allocator accounting for the memory it allocates on behalf
+    // of the given subsystem.
+    template <typename T, allocation_accounting::subsystem Subsystem>
+    struct tagged_allocator
+    {
+        typedef T value_type;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef T& reference;
+        typedef T const& const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        template <typename U>
+        struct rebind
+        {
+            typedef tagged_allocator<U, Subsystem> other;
+        };
+
+        typedef std::true_type is_always_equal;
+        typedef std::true_type propagate_on_container_move_assignment;
+
+        tagged_allocator() = default;
+
+        template <typename U>
+        tagged_allocator(tagged_allocator<U, Subsystem> const&)
+        {
+        }
+
+        pointer allocate(size_type n)
+        {
+            pointer p = internal_allocator<T>().allocate(n);
+            allocation_accounting::allocated(Subsystem, n * sizeof(T));
+            return p;
+        }
+
+        void deallocate(pointer p, size_type n)
+        {
+            allocation_accounting::deallocated(Subsystem, n * sizeof(T));
+            internal_allocator<T>().deallocate(p, n);
+        }
+
+        size_type max_size() const noexcept
+        {
+            return internal_allocator<T>().max_size();
+        }
+    };
+
+    template <typename T, typename U,
+        allocation_accounting::subsystem Subsystem>
+    HPX_CONSTEXPR bool operator==(tagged_allocator<T, Subsystem> const&,
+        tagged_allocator<U, Subsystem> const&)
+    {
+        return true;
+    }
+
+    template <typename T, typename U,
+        allocation_accounting::subsystem Subsystem>
+    HPX_CONSTEXPR bool operator!=(tagged_allocator<T, Subsystem> const&,
+        tagged_allocator<U, Subsystem> const&)
+    {
+        return false;
+    }
+#else
+    // without allocation accounting this is just the internal allocator
+    template <typename T, allocation_accounting::subsystem Subsystem>
+    using tagged_allocator = internal_allocator<T>;
+#endif
+
+    // The allocator used for the shared states of the futures created by the
+    // runtime (async, then, dataflow, when_all, etc.)
+    template <typename T = int>
+    using future_state_allocator =
+        tagged_allocator<T, allocation_accounting::shared_states>;
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
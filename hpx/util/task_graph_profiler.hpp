@@ -0,0 +1,99 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_TASK_GRAPH_PROFILER_HPP)
+#define HPX_UTIL_TASK_GRAPH_PROFILER_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/util/thread_description.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+// The task graph profiler records the dependencies between the HPX threads
+// of a run. Every execution of an HPX thread (a thread phase) is a node of
+// the graph. A node depends on the previous phase of the same HPX thread and
+// on the node which made it ready: the node creating the HPX thread or the
+// node waking it up. As continuations attached to futures (then, dataflow,
+// when_all) are scheduled by the thread making the last of their inputs
+// ready, this captures the dependency which actually delayed them.
+//
+// The profiler is enabled by setting hpx.task_graph.file. When the runtime
+// is stopped it writes a report listing the critical path of the run, the
+// available parallelism over time and the contributions of each thread
+// description (the action type or the name given to annotated_function).
+namespace hpx { namespace util { namespace task_graph
+{
+    // The task graph related data kept for each HPX thread, a node id of
+    // zero refers to no node.
+    struct thread_info
+    {
+        thread_info()
+          : enabled_by_(0), enabled_at_(0), last_node_(0)
+        {}
+
+        std::uint64_t enabled_by_;  // the node which made the thread ready
+        std::uint64_t enabled_at_;  // the time it was made ready
+        std::uint64_t last_node_;   // the node of the previous thread phase
+    };
+
+#if defined(HPX_HAVE_TASK_GRAPH_PROFILER)
+    // This is set while the task graph is being recorded.
+    extern HPX_EXPORT bool profiling_enabled;
+
+    // Called whenever an HPX thread is made ready (created or woken up),
+    // records the node of the calling OS thread as the one enabling it.
+    HPX_EXPORT void thread_enabled(thread_info& data);
+
+    // Called by the scheduling loop before and after an HPX thread runs.
+    HPX_EXPORT void node_started(thread_info& data,
+        util::thread_description const& desc);
+    HPX_EXPORT void node_finished();
+
+    // Start recording the task graph, each OS thread records at most the
+    // given number of nodes. The report is written to the given file when
+    // the profiler is stopped ("cout" and "cerr" refer to the standard
+    // streams).
+    HPX_EXPORT void start_profiling(std::string const& filename,
+        std::size_t max_nodes);
+
+    // Stop recording and write the report, if any. All worker threads have
+    // to be stopped at this point.
+    HPX_EXPORT void stop_profiling();
+
+    // Write the report for the nodes recorded so far to the given stream.
+    HPX_EXPORT void write_report(std::ostream& os);
+
+    // Return the number of nodes which had to be dropped.
+    HPX_EXPORT std::uint64_t get_dropped_nodes();
+#else
+    HPX_CONSTEXPR_OR_CONST bool profiling_enabled = false;
+
+    inline void thread_enabled(thread_info&)
+    {
+    }
+
+    inline void node_started(thread_info&, util::thread_description const&)
+    {
+    }
+
+    inline void node_finished()
+    {
+    }
+
+    inline void start_profiling(std::string const&, std::size_t)
+    {
+    }
+
+    inline void stop_profiling()
+    {
+    }
+#endif
+}}}
+
+#endif
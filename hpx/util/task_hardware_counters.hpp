@@ -0,0 +1,83 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_TASK_HARDWARE_COUNTERS_HPP)
+#define HPX_UTIL_TASK_HARDWARE_COUNTERS_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/util/thread_description.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The task hardware counters attribute hardware events (cache misses, cycles,
+// etc.) to the HPX threads causing them. Each worker OS thread opens a group
+// of perf_event counters measuring only itself, the scheduling loop reads the
+// counters whenever an HPX thread is resumed or suspended and adds the
+// difference to the totals of the description of the HPX thread (the action
+// name or the name given to annotated_function).
+//
+// The measurement is enabled by setting hpx.task_counters.events to a comma
+// separated list of events, the totals are exposed as the performance
+// counters /threads{locality#N/total}/task-events/<event>@<description>.
+namespace hpx { namespace util { namespace task_counters
+{
+    // The maximum number of events which can be measured at the same time
+    HPX_STATIC_CONSTEXPR std::size_t max_events = 8;
+
+#if defined(HPX_HAVE_TASK_HARDWARE_COUNTERS)
+    // This is set while the events are being measured.
+    extern HPX_EXPORT bool task_counters_enabled;
+
+    // Called by the scheduling loop before and after an HPX thread runs.
+    HPX_EXPORT void task_started(util::thread_description const& desc);
+    HPX_EXPORT void task_stopped();
+
+    // Start measuring the given events, the event names are separated by
+    // commas. Raw (model specific) events can be given as r<hex code>.
+    HPX_EXPORT void start_task_counters(std::string const& events);
+
+    // Stop measuring, closes the counters of all OS threads.
+    HPX_EXPORT void stop_task_counters();
+
+    // Return the names of the events being measured.
+    HPX_EXPORT std::vector<std::string> get_events();
+
+    // Return the descriptions of all HPX threads measured so far.
+    HPX_EXPORT std::vector<std::string> get_task_names();
+
+    // Return the index of the given event, -1 if it is not measured.
+    HPX_EXPORT int get_event_index(std::string const& event);
+
+    // Return the total of the given event for all HPX threads with the given
+    // description. The number of times HPX threads with that description
+    // were run is returned for the event index max_events.
+    HPX_EXPORT std::int64_t get_task_event_count(std::size_t event,
+        std::string const& task, bool reset);
+#else
+    HPX_CONSTEXPR_OR_CONST bool task_counters_enabled = false;
+
+    inline void task_started(util::thread_description const&)
+    {
+    }
+
+    inline void task_stopped()
+    {
+    }
+
+    inline void start_task_counters(std::string const&)
+    {
+    }
+
+    inline void stop_task_counters()
+    {
+    }
+#endif
+}}}
+
+#endif
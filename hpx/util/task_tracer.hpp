@@ -0,0 +1,96 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_TASK_TRACER_HPP)
+#define HPX_UTIL_TASK_TRACER_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/util/thread_description.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+// The task tracer records the life cycle of the HPX threads and the parcels
+// sent and received by a locality. Each OS thread writes the events into its
+// own ring buffer, the buffers are drained by a separate OS thread which
+// writes them to a binary file. Events are dropped if a ring buffer is full.
+//
+// Tracing is enabled by setting hpx.trace.file, tools/trace/hpx_trace.py
+// converts the written file to the Chrome trace event (JSON) format which is
+// understood by chrome://tracing and Perfetto.
+namespace hpx { namespace util { namespace tracing
+{
+    enum event_type
+    {
+        event_thread_create = 0,    // id: thread, data: initial state
+        event_thread_run = 1,       // id: thread, data: thread phase
+        event_thread_suspend = 2,   // id: thread, data: new thread state
+        event_thread_terminate = 3, // id: thread
+        event_parcel_send = 4,      // id: parcel, data: destination locality
+        event_parcel_receive = 5,   // id: parcel, data: source locality
+        event_annotation = 6,       // id: thread
+        event_type_last
+    };
+
+#if defined(HPX_HAVE_TASK_TRACER)
+    // This is set while tracing is active, the events recorded otherwise are
+    // ignored. Call sites which have to do some work to collect the event
+    // data should check this flag first.
+    extern HPX_EXPORT bool tracing_enabled;
+
+    // Record an event into the ring buffer of the calling OS thread. The
+    // events refer to the interned name (see util::annotation).
+    HPX_EXPORT void record_event_impl(event_type type, std::uint64_t id,
+        char const* name, std::uint32_t data);
+    HPX_EXPORT void record_event_impl(event_type type, std::uint64_t id,
+        util::thread_description const& desc, std::uint32_t data);
+
+    template <typename Name>
+    inline void record_event(event_type type, std::uint64_t id,
+        Name const& name, std::uint32_t data = 0)
+    {
+        if (HPX_UNLIKELY(tracing_enabled))
+            record_event_impl(type, id, name, data);
+    }
+
+    // Start writing the recorded events to the given file. The ring buffers
+    // are created on the first event recorded by an OS thread, each holds
+    // the given number of events (rounded up to a power of two).
+    HPX_EXPORT void start_tracing(std::string const& filename,
+        std::size_t buffer_size, std::uint32_t locality_id);
+
+    // Stop tracing, flushes all events recorded so far.
+    HPX_EXPORT void stop_tracing();
+
+    // Return the number of events which had to be dropped because of full
+    // ring buffers.
+    HPX_EXPORT std::uint64_t get_dropped_events();
+#else
+    HPX_CONSTEXPR_OR_CONST bool tracing_enabled = false;
+
+    template <typename Name>
+    inline void record_event(event_type, std::uint64_t, Name const&,
+        std::uint32_t = 0)
+    {
+    }
+
+    inline void start_tracing(std::string const&, std::size_t, std::uint32_t)
+    {
+    }
+
+    inline void stop_tracing()
+    {
+    }
+
+    inline std::uint64_t get_dropped_events()
+    {
+        return 0;
+    }
+#endif
+}}}
+
+#endif
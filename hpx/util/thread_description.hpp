@@ -12,12 +12,14 @@
 #include <hpx/traits/get_function_address.hpp>
 #include <hpx/traits/get_function_annotation.hpp>
 #include <hpx/traits/is_action.hpp>
+#include <hpx/util/annotation.hpp>
 #include <hpx/util/assert.hpp>
 #if HPX_HAVE_ITTNOTIFY != 0 && !defined(HPX_HAVE_APEX)
 #include <hpx/util/itt_notify.hpp>
 #endif
 
 #include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <string>
 #include <type_traits>
@@ -26,6 +28,18 @@
 namespace hpx { namespace util
 {
 #if defined(HPX_HAVE_THREAD_DESCRIPTION)
+    namespace detail
+    {
+        // The name of an action is interned once.
+        template <typename Action>
+        annotation const& get_action_annotation()
+        {
+            static annotation const a(
+                hpx::actions::detail::get_action_name<Action>());
+            return a;
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     struct thread_description
     {
@@ -44,6 +58,7 @@ namespace hpx { namespace util
         };
 
         data_type type_;
+        std::uint32_t id_;      // id of the interned description, if known
         data data_;
 #if HPX_HAVE_ITTNOTIFY != 0 && !defined(HPX_HAVE_APEX)
         util::itt::string_handle desc_itt_;
@@ -53,21 +68,27 @@ namespace hpx { namespace util
 
     public:
         thread_description() noexcept
-          : type_(data_type_description)
+          : type_(data_type_description), id_(0)
         {
             data_.desc_ = "<unknown>";
         }
 
         thread_description(char const* desc) noexcept
-          : type_(data_type_description)
+          : type_(data_type_description), id_(0)
         {
             data_.desc_ = desc ? desc : "<unknown>";
         }
 
+        thread_description(annotation const& a) noexcept
+          : type_(data_type_description), id_(a.id())
+        {
+            data_.desc_ = a ? a.name() : "<unknown>";
+        }
+
 #if HPX_HAVE_ITTNOTIFY != 0 && !defined(HPX_HAVE_APEX)
         thread_description(char const* desc,
                 util::itt::string_handle const& sh) noexcept
-          : type_(data_type_description)
+          : type_(data_type_description), id_(0)
         {
             data_.desc_ = desc ? desc : "<unknown>";
             desc_itt_ = sh;
@@ -78,17 +99,19 @@ namespace hpx { namespace util
         template <typename F, typename =
             typename std::enable_if<
                 !std::is_same<F, thread_description>::value &&
+                !std::is_same<F, annotation>::value &&
                 !traits::is_action<F>::value
             >::type>
         explicit thread_description(F const& f,
                 char const* altname = nullptr) noexcept
-          : type_(data_type_description)
+          : type_(data_type_description), id_(0)
         {
             char const* name = traits::get_function_annotation<F>::call(f);
             // If a name exists, use it, not the altname.
             if (name != nullptr)
             {
                 altname = name;
+                id_ = traits::get_function_annotation_id<F>::call(f);
 #if HPX_HAVE_ITTNOTIFY != 0 && !defined(HPX_HAVE_APEX)
                 desc_itt_ = traits::get_function_annotation_itt<F>::call(f);
 #endif
@@ -121,10 +144,12 @@ namespace hpx { namespace util
                 traits::is_action<Action>::value
             >::type>
         explicit thread_description(Action,
-                char const* altname = nullptr) noexcept
+                char const* altname = nullptr)
           : type_(data_type_description)
         {
-            data_.desc_ = hpx::actions::detail::get_action_name<Action>();
+            annotation const& a = detail::get_action_annotation<Action>();
+            id_ = a.id();
+            data_.desc_ = a.name();
 #if HPX_HAVE_ITTNOTIFY != 0 && !defined(HPX_HAVE_APEX)
             desc_itt_ = hpx::actions::detail::get_action_name_itt<Action>();
 #endif
@@ -156,6 +181,16 @@ namespace hpx { namespace util
             return data_.addr_;
         }
 
+        // Return the id of the interned description, descriptions given as
+        // plain strings are interned on the first call. Returns zero for
+        // addresses.
+        std::uint32_t get_annotation_id() const
+        {
+            if (type_ != data_type_description)
+                return 0;
+            return id_ != 0 ? id_ : intern_annotation(data_.desc_);
+        }
+
         explicit operator bool() const noexcept
         {
             return valid();
@@ -194,9 +229,14 @@ namespace hpx { namespace util
         {
         }
 
+        thread_description(annotation const& /*a*/) noexcept
+        {
+        }
+
         template <typename F, typename =
             typename std::enable_if<
                 !std::is_same<F, thread_description>::value &&
+                !std::is_same<F, annotation>::value &&
                 !traits::is_action<F>::value
             >::type>
         explicit thread_description(F const& /*f*/,
@@ -236,6 +276,11 @@ namespace hpx { namespace util
             return 0;
         }
 
+        std::uint32_t get_annotation_id() const noexcept
+        {
+            return 0;
+        }
+
         explicit operator bool() const noexcept
         {
             return valid();
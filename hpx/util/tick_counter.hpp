@@ -21,14 +21,17 @@ namespace hpx { namespace util
     class tick_counter
     {
     public:
-        tick_counter(std::uint64_t& output)
-          : start_time_(take_time_stamp())
+        // no time stamps are taken if the counter is not enabled
+        tick_counter(std::uint64_t& output, bool enabled = true)
+          : start_time_(enabled ? take_time_stamp() : 0)
           , output_(output)
+          , enabled_(enabled)
         {}
 
         ~tick_counter()
         {
-            output_ += take_time_stamp() - start_time_;
+            if (enabled_)
+                output_ += take_time_stamp() - start_time_;
         }
 
     protected:
@@ -40,6 +43,7 @@ namespace hpx { namespace util
     private:
         std::uint64_t const start_time_;
         std::uint64_t& output_;
+        bool const enabled_;
     };
 }} // namespace hpx::util
 
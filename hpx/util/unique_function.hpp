@@ -26,14 +26,17 @@
 namespace hpx { namespace util
 {
     ///////////////////////////////////////////////////////////////////////////
-    template <typename Sig, bool Serializable>
+    template <typename Sig, bool Serializable, std::size_t StorageSize>
     class unique_function;
 
-    template <typename R, typename ...Ts, bool Serializable>
-    class unique_function<R(Ts...), Serializable>
-      : public detail::basic_function<R(Ts...), false, Serializable>
+    template <typename R, typename ...Ts, bool Serializable,
+        std::size_t StorageSize>
+    class unique_function<R(Ts...), Serializable, StorageSize>
+      : public detail::basic_function<R(Ts...), false, Serializable,
+            StorageSize>
     {
-        using base_type = detail::basic_function<R(Ts...), false, Serializable>;
+        using base_type = detail::basic_function<R(Ts...), false,
+            Serializable, StorageSize>;
 
     public:
         typedef R result_type;
@@ -72,9 +75,9 @@ namespace hpx { namespace util
         using base_type::target;
     };
 
-    template <typename Sig, bool Serializable>
+    template <typename Sig, bool Serializable, std::size_t StorageSize>
     static bool is_empty_function(
-        unique_function<Sig, Serializable> const& f) noexcept
+        unique_function<Sig, Serializable, StorageSize> const& f) noexcept
     {
         return f.empty();
     }
@@ -84,32 +87,35 @@ namespace hpx { namespace util
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace traits
 {
-    template <typename Sig, bool Serializable>
-    struct get_function_address<util::unique_function<Sig, Serializable> >
+    template <typename Sig, bool Serializable, std::size_t StorageSize>
+    struct get_function_address<
+        util::unique_function<Sig, Serializable, StorageSize> >
     {
-        static std::size_t
-            call(util::unique_function<Sig, Serializable> const& f) noexcept
+        static std::size_t call(util::unique_function<
+            Sig, Serializable, StorageSize> const& f) noexcept
         {
             return f.get_function_address();
         }
     };
 
-    template <typename Sig, bool Serializable>
-    struct get_function_annotation<util::unique_function<Sig, Serializable> >
+    template <typename Sig, bool Serializable, std::size_t StorageSize>
+    struct get_function_annotation<
+        util::unique_function<Sig, Serializable, StorageSize> >
     {
-        static char const*
-            call(util::unique_function<Sig, Serializable> const& f) noexcept
+        static char const* call(util::unique_function<
+            Sig, Serializable, StorageSize> const& f) noexcept
         {
             return f.get_function_annotation();
         }
     };
 
 #if HPX_HAVE_ITTNOTIFY != 0 && !defined(HPX_HAVE_APEX)
-    template <typename Sig, bool Serializable>
-    struct get_function_annotation_itt<util::unique_function<Sig, Serializable> >
+    template <typename Sig, bool Serializable, std::size_t StorageSize>
+    struct get_function_annotation_itt<
+        util::unique_function<Sig, Serializable, StorageSize> >
     {
-        static util::itt::string_handle
-            call(util::unique_function<Sig, Serializable> const& f) noexcept
+        static util::itt::string_handle call(util::unique_function<
+            Sig, Serializable, StorageSize> const& f) noexcept
         {
             return f.get_function_annotation_itt();
         }
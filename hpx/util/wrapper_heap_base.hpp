@@ -27,6 +27,14 @@ namespace hpx { namespace util
         virtual ~wrapper_heap_base() {}
 
         virtual bool alloc(void** result, std::size_t count = 1) = 0;
+
+        // allocate up to max_count consecutive elements, returns the number
+        // of elements actually allocated
+        virtual std::size_t alloc_some(void** result, std::size_t max_count) = 0;
+
+        // return whether the memory of this heap has been released
+        virtual bool is_empty() const = 0;
+
         virtual bool did_alloc (void *p) const = 0;
         virtual void free(void *p, std::size_t count = 1) = 0;
 
@@ -11,9 +11,23 @@
 
 #include <hpx/config.hpp>
 
+#include <cstddef>
+
 namespace hpx { namespace util
 {
     /// \cond NOINTERNAL
+    namespace detail
+    {
+        // The size of the inline storage of util::function and
+        // util::unique_function, larger callables are allocated separately.
+        static const std::size_t function_storage_size = 3 * sizeof(void*);
+
+        // The size of the inline storage of the functions holding the
+        // callables of HPX threads and of future continuations.
+        static const std::size_t task_function_storage_size =
+            HPX_HAVE_TASK_FUNCTION_STORAGE_SIZE * sizeof(void*);
+    }
+
     class backtrace;
 
     struct command_line_handling;
@@ -29,11 +43,13 @@ namespace hpx { namespace util
     class HPX_EXPORT runtime_configuration;
     class HPX_EXPORT section;
 
-    template <typename Sig, bool Serializable = true>
+    template <typename Sig, bool Serializable = true,
+        std::size_t StorageSize = detail::function_storage_size>
     class unique_function;
 
-    template <typename Sig>
-    using unique_function_nonser = unique_function<Sig, false>;
+    template <typename Sig,
+        std::size_t StorageSize = detail::function_storage_size>
+    using unique_function_nonser = unique_function<Sig, false, StorageSize>;
     /// \endcond
 }}
 
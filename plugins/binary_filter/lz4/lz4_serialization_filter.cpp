@@ -0,0 +1,218 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/actions/action_support.hpp>
+
+#include <hpx/plugins/plugin_registry.hpp>
+#include <hpx/plugins/binary_filter_factory.hpp>
+#include <hpx/plugins/binary_filter/lz4_serialization_filter.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include <lz4frame.h>
+
+///////////////////////////////////////////////////////////////////////////////
+HPX_REGISTER_PLUGIN_MODULE();
+HPX_REGISTER_BINARY_FILTER_FACTORY(
+    hpx::plugins::compression::lz4_serialization_filter,
+    lz4_serialization_filter);
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace plugins { namespace compression
+{
+    namespace
+    {
+        // the amount of data handed to the compressor at once
+        constexpr std::size_t block_size = 65536;
+
+        void check_result(std::size_t result, char const* function)
+        {
+            if (LZ4F_isError(result))
+            {
+                HPX_THROW_EXCEPTION(serialization_error, function,
+                    std::string("lz4 failure: ") + LZ4F_getErrorName(result));
+            }
+        }
+    }
+
+    struct lz4_serialization_filter::stream
+    {
+        stream()
+          : cctx_(nullptr)
+        {
+            std::memset(&prefs_, 0, sizeof(prefs_));
+        }
+
+        ~stream()
+        {
+            if (cctx_ != nullptr)
+                LZ4F_freeCompressionContext(cctx_);
+        }
+
+        LZ4F_cctx* cctx_;
+        LZ4F_preferences_t prefs_;
+    };
+
+    lz4_serialization_filter::lz4_serialization_filter(bool compress,
+            serialization::binary_filter* next_filter)
+      : current_(0), compress_(compress), finished_(false)
+    {
+        if (compress_)
+        {
+            stream_.reset(new stream);
+            check_result(LZ4F_createCompressionContext(
+                &stream_->cctx_, LZ4F_VERSION),
+                "lz4_serialization_filter::lz4_serialization_filter");
+
+            compressed_.resize(LZ4F_HEADER_SIZE_MAX);
+            std::size_t written = LZ4F_compressBegin(stream_->cctx_,
+                compressed_.data(), compressed_.size(), &stream_->prefs_);
+            check_result(written,
+                "lz4_serialization_filter::lz4_serialization_filter");
+            compressed_.resize(written);
+        }
+    }
+
+    lz4_serialization_filter::~lz4_serialization_filter() = default;
+
+    void lz4_serialization_filter::set_max_length(std::size_t size)
+    {
+        if (!compress_)
+            return;
+
+        buffer_.reserve((std::min)(size, block_size));
+        compressed_.reserve(LZ4F_compressBound(size, &stream_->prefs_));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t lz4_serialization_filter::init_data(
+        char const* buffer, std::size_t size, std::size_t buffer_size)
+    {
+        buffer_.resize(buffer_size);
+
+        LZ4F_dctx* dctx = nullptr;
+        check_result(LZ4F_createDecompressionContext(&dctx, LZ4F_VERSION),
+            "lz4_serialization_filter::init_data");
+        std::unique_ptr<LZ4F_dctx, LZ4F_errorCode_t(*)(LZ4F_dctx*)> guard(
+            dctx, &LZ4F_freeDecompressionContext);
+
+        std::size_t src_pos = 0;
+        std::size_t dst_pos = 0;
+        std::size_t result = 1;
+        while (result != 0 && src_pos != size)
+        {
+            std::size_t dst_count = buffer_.size() - dst_pos;
+            std::size_t src_count = size - src_pos;
+            result = LZ4F_decompress(dctx, buffer_.data() + dst_pos,
+                &dst_count, buffer + src_pos, &src_count, nullptr);
+            check_result(result, "lz4_serialization_filter::init_data");
+
+            dst_pos += dst_count;
+            src_pos += src_count;
+
+            if (dst_count == 0 && src_count == 0)
+                break;
+        }
+
+        if (dst_pos != buffer_.size())
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "lz4_serialization_filter::init_data",
+                "decompression failure, unexpected size of the data");
+        }
+
+        current_ = 0;
+        return buffer_.size();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void lz4_serialization_filter::load(void* dst, std::size_t dst_count)
+    {
+        if (current_+dst_count > buffer_.size())
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                    "lz4_serialization_filter::load",
+                    "archive data bstream is too short");
+            return;
+        }
+
+        std::memcpy(dst, &buffer_[current_], dst_count);
+        current_ += dst_count;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void lz4_serialization_filter::compress_block(bool finish)
+    {
+        std::size_t pos = compressed_.size();
+        std::size_t bound = LZ4F_compressBound(buffer_.size(), &stream_->prefs_);
+        compressed_.resize(pos + bound);
+
+        std::size_t written = 0;
+        if (!buffer_.empty())
+        {
+            written = LZ4F_compressUpdate(stream_->cctx_,
+                compressed_.data() + pos, bound, buffer_.data(),
+                buffer_.size(), nullptr);
+            check_result(written, "lz4_serialization_filter::compress_block");
+            buffer_.clear();
+        }
+
+        if (finish)
+        {
+            // the remaining space is sufficient to end the frame
+            std::size_t end = LZ4F_compressEnd(stream_->cctx_,
+                compressed_.data() + pos + written, bound - written, nullptr);
+            check_result(end, "lz4_serialization_filter::compress_block");
+            written += end;
+        }
+
+        compressed_.resize(pos + written);
+    }
+
+    void lz4_serialization_filter::save(void const* src,
+        std::size_t src_count)
+    {
+        char const* src_begin = static_cast<char const*>(src);
+        while (src_count != 0)
+        {
+            std::size_t count =
+                (std::min)(src_count, block_size - buffer_.size());
+            buffer_.insert(buffer_.end(), src_begin, src_begin + count);
+            src_begin += count;
+            src_count -= count;
+
+            if (buffer_.size() == block_size)
+                compress_block(false);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool lz4_serialization_filter::flush(void* dst, std::size_t dst_count,
+        std::size_t& written)
+    {
+        // flush might be called again if the given space was not sufficient
+        if (!finished_)
+        {
+            compress_block(true);
+            finished_ = true;
+        }
+
+        if (compressed_.size() > dst_count)
+        {
+            written = 0;
+            return false;
+        }
+
+        std::memcpy(dst, compressed_.data(), compressed_.size());
+        written = compressed_.size();
+        return true;
+    }
+}}}
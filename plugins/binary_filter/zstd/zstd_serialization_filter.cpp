@@ -0,0 +1,195 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/actions/action_support.hpp>
+
+#include <hpx/plugins/plugin_registry.hpp>
+#include <hpx/plugins/binary_filter_factory.hpp>
+#include <hpx/plugins/binary_filter/zstd_serialization_filter.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include <zstd.h>
+
+///////////////////////////////////////////////////////////////////////////////
+HPX_REGISTER_PLUGIN_MODULE();
+HPX_REGISTER_BINARY_FILTER_FACTORY(
+    hpx::plugins::compression::zstd_serialization_filter,
+    zstd_serialization_filter);
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace plugins { namespace compression
+{
+    namespace
+    {
+        // the amount of data handed to the compressor at once
+        constexpr std::size_t block_size = 65536;
+
+        // favor speed over the compression ratio, parcels are compressed
+        // on the critical path
+        constexpr int compression_level = 1;
+
+        std::size_t check_result(std::size_t result, char const* function)
+        {
+            if (ZSTD_isError(result))
+            {
+                HPX_THROW_EXCEPTION(serialization_error, function,
+                    std::string("zstd failure: ") + ZSTD_getErrorName(result));
+            }
+            return result;
+        }
+    }
+
+    struct zstd_serialization_filter::stream
+    {
+        stream()
+          : cctx_(ZSTD_createCCtx())
+        {}
+
+        ~stream()
+        {
+            ZSTD_freeCCtx(cctx_);
+        }
+
+        ZSTD_CCtx* cctx_;
+    };
+
+    zstd_serialization_filter::zstd_serialization_filter(bool compress,
+            serialization::binary_filter* next_filter)
+      : current_(0), compress_(compress), finished_(false)
+    {
+        if (compress_)
+        {
+            stream_.reset(new stream);
+            if (stream_->cctx_ == nullptr)
+            {
+                HPX_THROW_EXCEPTION(out_of_memory,
+                    "zstd_serialization_filter::zstd_serialization_filter",
+                    "could not create the compression context");
+            }
+
+            check_result(ZSTD_CCtx_setParameter(stream_->cctx_,
+                ZSTD_c_compressionLevel, compression_level),
+                "zstd_serialization_filter::zstd_serialization_filter");
+        }
+    }
+
+    zstd_serialization_filter::~zstd_serialization_filter() = default;
+
+    void zstd_serialization_filter::set_max_length(std::size_t size)
+    {
+        if (!compress_)
+            return;
+
+        buffer_.reserve((std::min)(size, block_size));
+        compressed_.reserve(ZSTD_compressBound(size));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t zstd_serialization_filter::init_data(
+        char const* buffer, std::size_t size, std::size_t buffer_size)
+    {
+        buffer_.resize(buffer_size);
+
+        std::size_t decompressed = check_result(
+            ZSTD_decompress(buffer_.data(), buffer_.size(), buffer, size),
+            "zstd_serialization_filter::init_data");
+
+        if (decompressed != buffer_.size())
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "zstd_serialization_filter::init_data",
+                "decompression failure, unexpected size of the data");
+        }
+
+        current_ = 0;
+        return buffer_.size();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void zstd_serialization_filter::load(void* dst, std::size_t dst_count)
+    {
+        if (current_+dst_count > buffer_.size())
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                    "zstd_serialization_filter::load",
+                    "archive data bstream is too short");
+            return;
+        }
+
+        std::memcpy(dst, &buffer_[current_], dst_count);
+        current_ += dst_count;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void zstd_serialization_filter::compress_block(bool finish)
+    {
+        ZSTD_inBuffer in = { buffer_.data(), buffer_.size(), 0 };
+        ZSTD_EndDirective mode = finish ? ZSTD_e_end : ZSTD_e_continue;
+
+        std::size_t remaining = 0;
+        do {
+            // make room for (at least) one more block of output
+            std::size_t pos = compressed_.size();
+            compressed_.resize(pos + ZSTD_CStreamOutSize());
+
+            ZSTD_outBuffer out = {
+                compressed_.data() + pos, compressed_.size() - pos, 0 };
+            remaining = check_result(
+                ZSTD_compressStream2(stream_->cctx_, &out, &in, mode),
+                "zstd_serialization_filter::compress_block");
+
+            compressed_.resize(pos + out.pos);
+
+        } while (finish ? remaining != 0 : in.pos != in.size);
+
+        buffer_.clear();
+    }
+
+    void zstd_serialization_filter::save(void const* src,
+        std::size_t src_count)
+    {
+        char const* src_begin = static_cast<char const*>(src);
+        while (src_count != 0)
+        {
+            std::size_t count =
+                (std::min)(src_count, block_size - buffer_.size());
+            buffer_.insert(buffer_.end(), src_begin, src_begin + count);
+            src_begin += count;
+            src_count -= count;
+
+            if (buffer_.size() == block_size)
+                compress_block(false);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool zstd_serialization_filter::flush(void* dst, std::size_t dst_count,
+        std::size_t& written)
+    {
+        // flush might be called again if the given space was not sufficient
+        if (!finished_)
+        {
+            compress_block(true);
+            finished_ = true;
+        }
+
+        if (compressed_.size() > dst_count)
+        {
+            written = 0;
+            return false;
+        }
+
+        std::memcpy(dst, compressed_.data(), compressed_.size());
+        written = compressed_.size();
+        return true;
+    }
+}}}
@@ -24,6 +24,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/accumulators/accumulators.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -42,6 +43,7 @@ namespace hpx { namespace traits
     //      ...
     //      num_messages = 50
     //      interval = 100
+    //      target_latency = 0
     //
     template <>
     struct plugin_config_data<hpx::plugins::parcel::coalescing_message_handler>
@@ -50,7 +52,8 @@ namespace hpx { namespace traits
         {
             return "num_messages = 50\n"
                    "interval = 100\n"
-                   "allow_background_flush = 1";
+                   "allow_background_flush = 1\n"
+                   "target_latency = 0";
         }
     };
 }}
@@ -79,6 +82,13 @@ namespace hpx { namespace plugins { namespace parcel
                 "hpx.plugins.coalescing_message_handler.interval", interval));
         }
 
+        std::size_t get_target_latency(std::size_t target_latency)
+        {
+            return boost::lexical_cast<std::size_t>(hpx::get_config_entry(
+                "hpx.plugins.coalescing_message_handler.target_latency",
+                target_latency));
+        }
+
         bool get_background_flush()
         {
             std::string value = hpx::get_config_entry(
@@ -91,14 +101,75 @@ namespace hpx { namespace plugins { namespace parcel
     void coalescing_message_handler::update_num_messages()
     {
         std::lock_guard<mutex_type> l(mtx_);
-        num_coalesced_parcels_ =
-            detail::get_num_messages(num_coalesced_parcels_);
+        max_coalesced_parcels_ =
+            detail::get_num_messages(max_coalesced_parcels_);
+        if (target_latency_ == 0)
+            num_coalesced_parcels_ = max_coalesced_parcels_;
     }
 
     void coalescing_message_handler::update_interval()
     {
         std::lock_guard<mutex_type> l(mtx_);
-        interval_ = detail::get_interval(interval_);
+        max_interval_ = detail::get_interval(max_interval_);
+        if (target_latency_ == 0)
+            interval_ = max_interval_;
+    }
+
+    void coalescing_message_handler::update_target_latency()
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        target_latency_ = detail::get_target_latency(target_latency_);
+        if (target_latency_ == 0)
+        {
+            // fall back to the configured settings
+            num_coalesced_parcels_ = max_coalesced_parcels_;
+            interval_ = max_interval_;
+        }
+        else
+        {
+            adapt_locked();
+        }
+    }
+
+    // Derive the coalescing parameters from the observed arrival rate of
+    // the parcels sent through this handler. As there is one handler for
+    // each action and destination, the parameters adapt to each of those
+    // separately.
+    //
+    // No parcel is held back for longer than the target latency. The number
+    // of parcels per message is chosen such that the buffer fills up at
+    // about the time the deadline expires, which avoids sending messages
+    // holding only a few parcels while the arrival rate is high. If parcels
+    // arrive less frequently than the target latency, no coalescing is done
+    // at all.
+    void coalescing_message_handler::adapt_locked()
+    {
+        HPX_ASSERT(target_latency_ != 0);
+
+        interval_ = target_latency_;
+
+        if (avg_time_between_parcels_ <= 0)
+        {
+            // no data yet
+            num_coalesced_parcels_ = max_coalesced_parcels_;
+            return;
+        }
+
+        double const expected_parcels =
+            double(interval_) * 1000. / avg_time_between_parcels_;
+
+        if (expected_parcels < 1.)
+        {
+            num_coalesced_parcels_ = 1;
+        }
+        else if (expected_parcels >= double(max_coalesced_parcels_))
+        {
+            num_coalesced_parcels_ = max_coalesced_parcels_;
+        }
+        else
+        {
+            num_coalesced_parcels_ = std::size_t(expected_parcels);
+        }
     }
 
     coalescing_message_handler::coalescing_message_handler(
@@ -107,6 +178,10 @@ namespace hpx { namespace plugins { namespace parcel
       : pp_(pp),
         num_coalesced_parcels_(detail::get_num_messages(num)),
         interval_(detail::get_interval(interval)),
+        max_coalesced_parcels_(num_coalesced_parcels_),
+        max_interval_(interval_),
+        target_latency_(detail::get_target_latency(0)),
+        avg_time_between_parcels_(0),
         buffer_(num_coalesced_parcels_),
         timer_(
             util::bind_back(&coalescing_message_handler::timer_flush, this_()),
@@ -144,6 +219,12 @@ namespace hpx { namespace plugins { namespace parcel
         set_config_entry_callback(
             "hpx.plugins.coalescing_message_handler.interval",
             util::bind(&coalescing_message_handler::update_interval, this));
+        set_config_entry_callback(
+            "hpx.plugins.coalescing_message_handler.target_latency",
+            util::bind(&coalescing_message_handler::update_target_latency, this));
+
+        if (target_latency_ != 0)
+            adapt_locked();
     }
 
     void coalescing_message_handler::put_parcel(
@@ -162,6 +243,23 @@ namespace hpx { namespace plugins { namespace parcel
         if (time_between_parcels_)
             (*time_between_parcels_)(time_since_last_parcel);
 
+        // track the arrival rate for adapting the coalescing parameters,
+        // an exponentially weighted moving average reacts to changes in
+        // the behavior of the application
+        if (target_latency_ != 0)
+        {
+            if (avg_time_between_parcels_ <= 0)
+            {
+                avg_time_between_parcels_ = double(time_since_last_parcel);
+            }
+            else
+            {
+                avg_time_between_parcels_ +=
+                    (double(time_since_last_parcel) -
+                        avg_time_between_parcels_) / 8.;
+            }
+        }
+
         std::chrono::microseconds interval(interval_);
 
         // just send parcel if the coalescing was stopped or the buffer is
@@ -271,6 +369,10 @@ namespace hpx { namespace plugins { namespace parcel
         if (buffer_.empty())
             return false;
 
+        // the new parameters take effect with the next message
+        if (target_latency_ != 0)
+            adapt_locked();
+
         detail::message_buffer buff (num_coalesced_parcels_);
         std::swap(buff, buffer_);
 
@@ -24,6 +24,7 @@
 #include <plugins/parcelport/libfabric/rma_receiver.hpp>
 #include <plugins/parcelport/libfabric/locality.hpp>
 //
+#include <plugins/parcelport/rma_memory_cache.hpp>
 #include <plugins/parcelport/unordered_map.hpp>
 //
 #include <memory>
@@ -284,6 +285,9 @@ namespace libfabric
             // Cleaning up receivers to avoid memory leak errors.
             receivers_.clear();
 
+            // cached registrations must be released before the domain
+            registration_cache_.reset();
+
             LOG_DEBUG_MSG("closing fabric_->fid");
             if (fabric_)
                 fi_close(&fabric_->fid);
@@ -962,6 +966,23 @@ namespace libfabric
             return *memory_pool_;
         }
 
+        // --------------------------------------------------------------------
+        // keep the registrations of zero copy chunks in a cache, at most
+        // max_bytes (in max_entries regions) stay registered while unused
+        void enable_registration_cache(std::size_t max_bytes,
+            std::size_t max_entries)
+        {
+            registration_cache_.reset(
+                new rma_memory_cache<libfabric_region_provider>(
+                    fabric_domain_, max_bytes, max_entries));
+        }
+
+        // returns nullptr if the registration cache is not enabled
+        inline rma_memory_cache<libfabric_region_provider>*
+        get_registration_cache() {
+            return registration_cache_.get();
+        }
+
         // --------------------------------------------------------------------
         void create_completion_queues(struct fi_info *info, int N)
         {
@@ -1157,6 +1178,10 @@ namespace libfabric
         // Pinned memory pool used for allocating buffers
         std::unique_ptr<rma_memory_pool<libfabric_region_provider>>  memory_pool_;
 
+        // Registrations of user memory kept beyond a single transfer
+        std::unique_ptr<rma_memory_cache<libfabric_region_provider>>
+            registration_cache_;
+
         // Shared completion queue for all endoints
         // Count outstanding receives posted to SRQ + Completion queue
         std::vector<receiver> receivers_;
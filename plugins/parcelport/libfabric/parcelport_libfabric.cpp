@@ -126,6 +126,16 @@ namespace libfabric
         libfabric_controller_ = std::make_shared<libfabric_controller>(
             provider, domain, endpoint);
 
+        // cache the registrations of zero copy chunks if requested
+        std::size_t cache_size = hpx::util::get_entry_as<std::size_t>(ini,
+            "hpx.parcel.libfabric.registration_cache", 0);
+        if (cache_size != 0)
+        {
+            libfabric_controller_->enable_registration_cache(cache_size,
+                hpx::util::get_entry_as<std::size_t>(ini,
+                    "hpx.parcel.libfabric.registration_cache_entries", 256));
+        }
+
         // get 'this' locality from the controller
         LOG_DEBUG_MSG("Getting local locality object");
         const locality & local = libfabric_controller_->here();
@@ -170,7 +180,8 @@ namespace libfabric
                new sender(this,
                     libfabric_controller_->ep_active_,
                     libfabric_controller_->get_domain(),
-                    chunk_pool_);
+                    chunk_pool_,
+                    libfabric_controller_->get_registration_cache());
             snd->postprocess_handler_ = [this](sender* s)
                 {
                     --senders_in_use_;
@@ -274,6 +274,12 @@ struct plugin_config_data<hpx::parcelset::policies::libfabric::parcelport> {
                 HPX_PARCELPORT_LIBFABRIC_DOMAIN "}\n"
         "endpoint = ${HPX_PARCELPORT_LIBFABRIC_ENDPOINT:"
                 HPX_PARCELPORT_LIBFABRIC_ENDPOINT "}\n"
+        "device_memory_chunks = "
+            "${HPX_PARCELPORT_LIBFABRIC_DEVICE_MEMORY_CHUNKS:0}\n"
+        "registration_cache = "
+            "${HPX_PARCELPORT_LIBFABRIC_REGISTRATION_CACHE:0}\n"
+        "registration_cache_entries = "
+            "${HPX_PARCELPORT_LIBFABRIC_REGISTRATION_CACHE_ENTRIES:256}\n"
         ;
     }
 };
@@ -53,8 +53,10 @@ namespace libfabric
             {
                 LOG_EXCLUSIVE(util::high_resolution_timer regtimer);
 
-                // create a new memory region from the user supplied pointer
-                region_type *zero_copy_region =
+                // create a new memory region from the user supplied pointer,
+                // or reuse a cached registration of the same memory
+                region_type *zero_copy_region = registration_cache_ ?
+                    registration_cache_->acquire(c.data_.cpos_, c.size_) :
                     new region_type(domain_, c.data_.cpos_, c.size_);
 
                 rma_regions_.push_back(zero_copy_region);
@@ -260,7 +262,10 @@ namespace libfabric
         }
 
         for (auto& region: rma_regions_) {
-            memory_pool_->deallocate(region);
+            if (registration_cache_)
+                registration_cache_->release(region);
+            else
+                memory_pool_->deallocate(region);
         }
         rma_regions_.clear();
         buffer_.data_point_.time_ =
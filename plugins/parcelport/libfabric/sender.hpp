@@ -12,6 +12,7 @@
 #include <plugins/parcelport/libfabric/pinned_memory_vector.hpp>
 #include <plugins/parcelport/libfabric/rma_base.hpp>
 #include <plugins/parcelport/performance_counter.hpp>
+#include <plugins/parcelport/rma_memory_cache.hpp>
 #include <plugins/parcelport/rma_memory_pool.hpp>
 
 #include <hpx/runtime/parcelset/locality.hpp>
@@ -38,6 +39,7 @@ namespace libfabric
         typedef libfabric_region_provider                region_provider;
         typedef rma_memory_region<region_provider>       region_type;
         typedef rma_memory_pool<region_provider>         memory_pool_type;
+        typedef rma_memory_cache<region_provider>        memory_cache_type;
 
         typedef header<HPX_PARCELPORT_LIBFABRIC_MESSAGE_HEADER_SIZE> header_type;
         static constexpr unsigned int header_size = header_type::header_block_size;
@@ -50,12 +52,16 @@ namespace libfabric
         typedef boost::container::small_vector<region_type*,8> zero_copy_vector;
 
         // --------------------------------------------------------------------
+        // if registration_cache is not null, the registrations of zero copy
+        // chunks are taken from (and returned to) the cache
         sender(parcelport* pp, fid_ep* endpoint, fid_domain* domain,
-            memory_pool_type* memory_pool)
+            memory_pool_type* memory_pool,
+            memory_cache_type* registration_cache = nullptr)
           : parcelport_(pp)
           , endpoint_(endpoint)
           , domain_(domain)
           , memory_pool_(memory_pool)
+          , registration_cache_(registration_cache)
           , buffer_(snd_data_type(memory_pool_), memory_pool_)
           , header_region_(nullptr)
           , chunk_region_(nullptr)
@@ -125,6 +131,7 @@ namespace libfabric
         fid_ep                   *endpoint_;
         fid_domain               *domain_;
         memory_pool_type         *memory_pool_;
+        memory_cache_type        *registration_cache_;
         fi_addr_t                 dst_addr_;
         snd_buffer_type           buffer_;
         region_type              *header_region_;
@@ -11,6 +11,7 @@
 #include <hpx/plugins/parcelport/mpi/mpi.hpp>
 #endif
 
+#include <hpx/util/assert.hpp>
 #include <hpx/util/runtime_configuration.hpp>
 #include <hpx/util/command_line_handling.hpp>
 #include <hpx/plugins/parcelport/mpi/mpi_environment.hpp>
@@ -22,6 +23,7 @@
 #include <cstddef>
 #include <cstdlib>
 #include <string>
+#include <vector>
 
 namespace hpx { namespace util
 {
@@ -80,6 +82,9 @@ namespace hpx { namespace util
     bool mpi_environment::has_called_init_ = false;
     int mpi_environment::provided_threading_flag_ = MPI_THREAD_SINGLE;
     MPI_Comm mpi_environment::communicator_ = MPI_COMM_NULL;
+    std::vector<MPI_Comm> mpi_environment::communicators_;
+    std::size_t mpi_environment::rma_threshold_ = 0;
+    std::vector<MPI_Win> mpi_environment::rma_windows_;
 
     ///////////////////////////////////////////////////////////////////////////
     bool mpi_environment::check_mpi_environment(runtime_configuration const& cfg)
@@ -164,6 +169,50 @@ namespace hpx { namespace util
 
         MPI_Comm_dup(MPI_COMM_WORLD, &communicator_);
 
+        // Additional communicators are used without any locking, which
+        // requires full multi-threading support. MPI_Comm_dup is collective,
+        // all localities have to use the same number of communicators.
+        int num_communicators = detail::get_cfg_entry(
+            cfg, "hpx.parcel.mpi.communicators", 1);
+        if (num_communicators < 1 ||
+            provided_threading_flag_ < MPI_THREAD_MULTIPLE)
+        {
+            num_communicators = 1;
+        }
+
+        communicators_.clear();
+        communicators_.reserve(std::size_t(num_communicators));
+        communicators_.push_back(communicator_);
+        for (int i = 1; i < num_communicators; ++i)
+        {
+            MPI_Comm comm = MPI_COMM_NULL;
+            MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+            communicators_.push_back(comm);
+        }
+
+        cfg.ini_config_ += std::string("hpx.parcel.mpi.communicators!=") +
+            std::to_string(num_communicators);
+
+        // The windows are created collectively as well, all localities have
+        // to agree on whether RMA is used. The windows stay locked for
+        // passive target access until MPI is finalized.
+        int rma_threshold = detail::get_cfg_entry(
+            cfg, "hpx.parcel.mpi.rma_threshold", 0);
+        rma_threshold_ = rma_threshold > 0 ? std::size_t(rma_threshold) : 0;
+
+        rma_windows_.clear();
+        if (rma_threshold_ != 0)
+        {
+            rma_windows_.reserve(communicators_.size());
+            for (MPI_Comm comm : communicators_)
+            {
+                MPI_Win win = MPI_WIN_NULL;
+                MPI_Win_create_dynamic(MPI_INFO_NULL, comm, &win);
+                MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+                rma_windows_.push_back(win);
+            }
+        }
+
         if (provided_threading_flag_ < MPI_THREAD_SERIALIZED)
         {
             // explicitly disable mpi if not run by mpirun
@@ -214,6 +263,13 @@ namespace hpx { namespace util
     {
         if(enabled() && has_called_init())
         {
+            for (MPI_Win& win : rma_windows_)
+            {
+                MPI_Win_unlock_all(win);
+                MPI_Win_free(&win);
+            }
+            rma_windows_.clear();
+
             MPI_Finalize();
         }
     }
@@ -254,6 +310,34 @@ namespace hpx { namespace util
         return communicator_;
     }
 
+    std::size_t mpi_environment::num_communicators()
+    {
+        return communicators_.empty() ? 1 : communicators_.size();
+    }
+
+    MPI_Comm& mpi_environment::communicator(std::size_t i)
+    {
+        if (communicators_.empty())
+            return communicator_;
+
+        HPX_ASSERT(i < communicators_.size());
+        return communicators_[i];
+    }
+
+    std::size_t mpi_environment::rma_threshold()
+    {
+        return rma_threshold_;
+    }
+
+    MPI_Win* mpi_environment::rma_window(std::size_t i)
+    {
+        if (rma_windows_.empty())
+            return nullptr;
+
+        HPX_ASSERT(i < rma_windows_.size());
+        return &rma_windows_[i];
+    }
+
     mpi_environment::scoped_lock::scoped_lock()
     {
         if(!multi_threaded())
@@ -83,9 +83,29 @@ namespace hpx { namespace parcelset
 
     namespace policies { namespace mpi
     {
-        int acquire_tag(sender * s)
+        std::size_t select_communicator(sender * s)
         {
-            return s->acquire_tag();
+            return s->select_communicator();
+        }
+
+        std::size_t eager_threshold(sender * s)
+        {
+            return s->eager_threshold();
+        }
+
+        int acquire_tag(sender * s, std::size_t comm)
+        {
+            return s->acquire_tag(comm);
+        }
+
+        void await_tag_release(sender * s, std::size_t comm, int tag)
+        {
+            s->await_tag_release(comm, tag);
+        }
+
+        bool tag_released(sender * s, std::size_t comm, int tag)
+        {
+            return s->tag_released(comm, tag);
         }
 
         void add_connection(sender * s, std::shared_ptr<sender_connection> const &ptr)
@@ -120,7 +140,8 @@ namespace hpx { namespace parcelset
                 util::function_nonser<void(std::size_t, char const*)> const& on_stop)
               : base_type(ini, here(), on_start, on_stop)
               , stopped_(false)
-              , receiver_(*this)
+              , sender_(ini)
+              , receiver_(*this, ini)
             {}
 
             ~parcelport()
@@ -192,8 +213,8 @@ namespace hpx { namespace parcelset
                     return false;
 
                 bool has_work = false;
-                has_work = sender_.background_work();
-                has_work = receiver_.background_work() || has_work;
+                has_work = sender_.background_work(num_thread);
+                has_work = receiver_.background_work(num_thread) || has_work;
                 return has_work;
             }
 
@@ -283,7 +304,15 @@ namespace hpx { namespace traits
                     "}\n"
 #endif
                 "multithreaded = ${HPX_HAVE_PARCELPORT_MPI_MULTITHREADED:0}\n"
+                "communicators = ${HPX_HAVE_PARCELPORT_MPI_COMMUNICATORS:1}\n"
+                "eager_threshold = ${HPX_HAVE_PARCELPORT_MPI_EAGER_THRESHOLD:8192}\n"
+                "eager_receives = ${HPX_HAVE_PARCELPORT_MPI_EAGER_RECEIVES:4}\n"
+                "rma_threshold = ${HPX_HAVE_PARCELPORT_MPI_RMA_THRESHOLD:0}\n"
                 "max_connections = ${HPX_HAVE_PARCELPORT_MPI_MAX_CONNECTIONS:8192}\n"
+                "device_memory_chunks = "
+                    "${HPX_HAVE_PARCELPORT_MPI_DEVICE_MEMORY_CHUNKS:0}\n"
+                "deduplicate_chunks = "
+                    "${HPX_HAVE_PARCELPORT_MPI_DEDUPLICATE_CHUNKS:1}\n"
                 ;
         }
     };
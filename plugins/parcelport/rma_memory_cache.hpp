@@ -0,0 +1,263 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_RMA_MEMORY_CACHE
+#define HPX_PARCELSET_POLICIES_RMA_MEMORY_CACHE
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+//
+#include <plugins/parcelport/parcelport_logging.hpp>
+#include <plugins/parcelport/rma_memory_region.hpp>
+#include <plugins/parcelport/performance_counter.hpp>
+//
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <map>
+#include <mutex>
+
+// Description of the memory registration cache:
+//
+// rma_memory_cache:
+// Zero copy chunks are sent directly from the memory of the user, which has
+// to be registered with the fabric for every transfer. Registering memory
+// pins the pages and programs the translation tables of the NIC, which for
+// medium sized messages takes longer than the transfer itself. The cache
+// keeps the registrations of user buffers alive after the transfer has
+// completed, so that repeated sends from the same buffer reuse them.
+//
+// The cached regions are kept in a map ordered by their start address. The
+// regions of the map never overlap (a new registration replaces the idle
+// regions it overlaps and is not cached if it overlaps a region in use),
+// which allows to find the region covering an address range with a single
+// lookup. Unused regions are kept in LRU order and are only deregistered
+// when the cache exceeds its limits or the range they cover is invalidated.
+//
+// Note: the registration of a buffer which is freed and returned to the OS
+// becomes stale, memory mapped at the same address later on would not be
+// covered by it. Memory which is unmapped while the cache is in use has to
+// be passed to invalidate().
+
+namespace hpx {
+namespace parcelset
+{
+    template <typename RegionProvider>
+    struct rma_memory_cache
+    {
+        HPX_NON_COPYABLE(rma_memory_cache);
+
+        typedef typename RegionProvider::provider_domain domain_type;
+        typedef rma_memory_region<RegionProvider>        region_type;
+        typedef hpx::lcos::local::spinlock               mutex_type;
+
+    private:
+        typedef std::list<char const*>                   lru_type;
+
+        struct entry
+        {
+            region_type *region_;
+            char const  *end_;
+            std::size_t  refcount_;
+            bool         invalid_;
+            // position in the LRU list, valid if refcount_ == 0
+            typename lru_type::iterator lru_;
+        };
+
+        typedef std::map<char const*, entry>             map_type;
+        typedef typename map_type::iterator              iterator;
+
+    public:
+        //----------------------------------------------------------------------------
+        // max_bytes and max_entries limit the amount of memory (and the number
+        // of regions) kept registered while not being used
+        rma_memory_cache(domain_type *pd, std::size_t max_bytes,
+                std::size_t max_entries)
+          : protection_domain_(pd)
+          , max_bytes_(max_bytes)
+          , max_entries_(max_entries)
+          , idle_bytes_(0)
+          , hits_(0)
+          , misses_(0)
+          , evictions_(0)
+        {
+        }
+
+        //----------------------------------------------------------------------------
+        ~rma_memory_cache()
+        {
+            for (auto& e : regions_)
+            {
+                if (e.second.refcount_ != 0)
+                {
+                    LOG_ERROR_MSG("Deleting registration cache : region in use "
+                        << *e.second.region_);
+                }
+                delete e.second.region_;
+            }
+            LOG_DEBUG_MSG("Registration cache hits " << decnumber(hits_)
+                << "misses " << decnumber(misses_)
+                << "evictions " << decnumber(evictions_));
+        }
+
+        //----------------------------------------------------------------------------
+        // return a registered region covering the given buffer, the region
+        // has to be handed back using release() once the transfer completed
+        region_type *acquire(void const* buffer, std::size_t length)
+        {
+            char const* first = static_cast<char const*>(buffer);
+            char const* last = first + length;
+
+            std::lock_guard<mutex_type> l(mtx_);
+
+            // the only region which could cover the buffer is the last one
+            // starting at or before it
+            iterator it = regions_.upper_bound(first);
+            if (it != regions_.begin())
+            {
+                iterator prev = std::prev(it);
+                if (!prev->second.invalid_ && prev->second.end_ >= last)
+                {
+                    ++hits_;
+                    use(prev);
+                    return prev->second.region_;
+                }
+                if (prev->second.end_ > first)
+                    it = prev;
+            }
+
+            // replace all idle regions overlapping the buffer, give up on
+            // caching if a region in use overlaps it
+            iterator end = it;
+            while (end != regions_.end() && end->first < last)
+            {
+                if (end->second.refcount_ != 0)
+                {
+                    ++misses_;
+                    return new region_type(protection_domain_, buffer, length);
+                }
+                ++end;
+            }
+            while (it != end)
+            {
+                it = erase(it);
+            }
+
+            ++misses_;
+            region_type* region =
+                new region_type(protection_domain_, buffer, length);
+            entry e = { region, last, 1, false, lru_.end() };
+            regions_.emplace(first, e);
+            return region;
+        }
+
+        //----------------------------------------------------------------------------
+        // hand back a region returned by acquire()
+        void release(region_type *region)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+
+            iterator it = regions_.find(region->get_address());
+            if (it == regions_.end() || it->second.region_ != region)
+            {
+                // the region was not cached
+                delete region;
+                return;
+            }
+
+            if (--it->second.refcount_ != 0)
+                return;
+
+            if (it->second.invalid_)
+            {
+                erase(it);
+                return;
+            }
+
+            idle_bytes_ += region->get_size();
+            it->second.lru_ = lru_.insert(lru_.begin(), it->first);
+
+            // deregister the least recently used regions
+            while (!lru_.empty() &&
+                (idle_bytes_ > max_bytes_ || lru_.size() > max_entries_))
+            {
+                ++evictions_;
+                erase(regions_.find(lru_.back()));
+            }
+        }
+
+        //----------------------------------------------------------------------------
+        // remove the registrations covering the given memory, regions in use
+        // are removed once they are released
+        void invalidate(void const* buffer, std::size_t length)
+        {
+            char const* first = static_cast<char const*>(buffer);
+            char const* last = first + length;
+
+            std::lock_guard<mutex_type> l(mtx_);
+
+            iterator it = regions_.upper_bound(first);
+            if (it != regions_.begin() && std::prev(it)->second.end_ > first)
+                --it;
+
+            while (it != regions_.end() && it->first < last)
+            {
+                if (it->second.refcount_ != 0)
+                {
+                    it->second.invalid_ = true;
+                    ++it;
+                }
+                else
+                {
+                    it = erase(it);
+                }
+            }
+        }
+
+    private:
+        //----------------------------------------------------------------------------
+        void use(iterator it)
+        {
+            if (it->second.refcount_++ == 0)
+            {
+                idle_bytes_ -= it->second.region_->get_size();
+                lru_.erase(it->second.lru_);
+                it->second.lru_ = lru_.end();
+            }
+        }
+
+        //----------------------------------------------------------------------------
+        iterator erase(iterator it)
+        {
+            if (it->second.refcount_ == 0)
+            {
+                idle_bytes_ -= it->second.region_->get_size();
+                lru_.erase(it->second.lru_);
+            }
+            LOG_TRACE_MSG("Deregistering cached region " << *it->second.region_);
+            delete it->second.region_;
+            return regions_.erase(it);
+        }
+
+        //----------------------------------------------------------------------------
+        domain_type       *protection_domain_;
+        std::size_t const  max_bytes_;
+        std::size_t const  max_entries_;
+
+        mutex_type         mtx_;
+        map_type           regions_;
+        lru_type           lru_;
+        std::size_t        idle_bytes_;
+
+        // for debugging/performance measurement
+        performance_counter<unsigned int> hits_;
+        performance_counter<unsigned int> misses_;
+        performance_counter<unsigned int> evictions_;
+    };
+
+}}
+
+#endif
@@ -0,0 +1,346 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_SHMEM)
+#include <hpx/compat/thread.hpp>
+#include <hpx/plugins/parcelport/shmem/connection_handler.hpp>
+#include <hpx/plugins/parcelport/shmem/receiver.hpp>
+#include <hpx/plugins/parcelport/shmem/segment.hpp>
+#include <hpx/plugins/parcelport/shmem/sender.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+#include <hpx/util/runtime_configuration.hpp>
+
+#include <boost/asio/error.hpp>
+#include <boost/asio/ip/host_name.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    namespace
+    {
+        // Shared memory can be used between all processes running on the
+        // same (booted instance of the) host.
+        std::string host_id()
+        {
+            std::string boot_id;
+            std::ifstream in("/proc/sys/kernel/random/boot_id");
+            std::getline(in, boot_id);
+
+            return boost::asio::ip::host_name() + "/" + boot_id;
+        }
+
+        std::unique_ptr<segment> create_segment(
+            util::runtime_configuration const& ini)
+        {
+            // the segment is not created if this parcelport is not going to
+            // be used
+            if (ini.get_entry("hpx.parcel.shmem.enable", "0") != "1")
+                return std::unique_ptr<segment>();
+
+            return std::unique_ptr<segment>(new segment(
+                hpx::util::get_entry_as<std::size_t>(
+                    ini, "hpx.parcel.shmem.channels", "64"),
+                hpx::util::get_entry_as<std::size_t>(
+                    ini, "hpx.parcel.shmem.channel_size", "1048576")));
+        }
+
+        // the time the io_service thread sleeps at most before polling the
+        // pending write operations again
+        constexpr std::uint64_t doorbell_timeout_ns = 10000000;
+    }
+
+    connection_handler::connection_handler(
+        util::runtime_configuration const& ini,
+        util::function_nonser<void(std::size_t, char const*)> const&
+            on_start_thread,
+        util::function_nonser<void(std::size_t, char const*)> const&
+            on_stop_thread)
+      : connection_handler(ini, create_segment(ini), on_start_thread,
+            on_stop_thread)
+    {
+    }
+
+    connection_handler::connection_handler(
+        util::runtime_configuration const& ini, std::unique_ptr<segment> s,
+        util::function_nonser<void(std::size_t, char const*)> const&
+            on_start_thread,
+        util::function_nonser<void(std::size_t, char const*)> const&
+            on_stop_thread)
+      : base_type(ini,
+            parcelset::locality(locality(host_id(), s ? s->name() : "")),
+            on_start_thread, on_stop_thread)
+      , segment_(std::move(s))
+      , stopped_(false)
+      , num_pending_writes_(0)
+    {
+        if (segment_)
+        {
+            for (std::size_t i = 0; i != segment_->num_channels(); ++i)
+            {
+                receivers_.emplace_back(new receiver(*segment_, i, *this));
+            }
+        }
+    }
+
+    connection_handler::~connection_handler()
+    {
+        HPX_ASSERT(pending_writes_.empty());
+    }
+
+    bool connection_handler::do_run()
+    {
+        HPX_ASSERT(segment_);
+
+        // the io_service threads receive the incoming data while no HPX
+        // worker thread is doing background work
+        for (std::size_t i = 0; i != io_service_pool_.size(); ++i)
+        {
+            io_service_pool_.get_io_service(int(i)).post(
+                hpx::util::bind(&connection_handler::io_service_work, this));
+        }
+        return true;
+    }
+
+    void connection_handler::do_stop()
+    {
+        stopped_ = true;
+
+        // write operations still waiting for their receiver will not
+        // complete anymore
+        std::vector<std::shared_ptr<sender> > pending;
+        {
+            std::lock_guard<lcos::local::spinlock> l(pending_writes_mtx_);
+            std::swap(pending, pending_writes_);
+            num_pending_writes_ = 0;
+        }
+        for (std::shared_ptr<sender> const& s : pending)
+        {
+            s->abort(boost::asio::error::make_error_code(
+                boost::asio::error::operation_aborted));
+        }
+
+        {
+            std::lock_guard<lcos::local::spinlock> l(segments_mtx_);
+            segments_.clear();
+        }
+
+        // no new connections can be established to this locality anymore,
+        // the memory is released once all processes have unmapped it
+        if (segment_)
+            segment_->unlink();
+    }
+
+    bool connection_handler::can_connect(parcelset::locality const& l,
+        bool use_alternative_parcelport)
+    {
+        return l.get<locality>().host() == here_.get<locality>().host();
+    }
+
+    std::shared_ptr<sender> connection_handler::create_connection(
+        parcelset::locality const& l, error_code& ec)
+    {
+        std::shared_ptr<segment> s;
+        try {
+            s = get_segment(l.get<locality>().segment());
+        }
+        catch (hpx::exception const& e) {
+            HPX_THROWS_IF(ec, network_error,
+                "shmem::connection_handler::create_connection", e.what());
+            return std::shared_ptr<sender>();
+        }
+
+        // Claim a free channel of the destination, retry if needed
+        for (std::size_t i = 0; i < HPX_MAX_NETWORK_RETRIES; ++i)
+        {
+            // An exit here, avoids hangs when late parcels are in flight
+            // (those are mainly decref requests).
+            if (stopped_)
+                return std::shared_ptr<sender>();
+
+            std::size_t channel = s->claim_channel();
+            if (channel != std::size_t(-1))
+            {
+                std::shared_ptr<sender> sender_connection(
+                    new sender(std::move(s), channel, l, this));
+
+                if (&ec != &throws)
+                    ec = make_success_code();
+
+                return sender_connection;
+            }
+
+            // wait for a really short amount of time
+            if (hpx::threads::get_self_ptr()) {
+                this_thread::suspend(hpx::threads::pending,
+                    "connection_handler(shmem)::create_connection");
+            }
+            else {
+                compat::this_thread::sleep_for(
+                    std::chrono::milliseconds(HPX_NETWORK_RETRIES_SLEEP));
+            }
+        }
+
+        std::ostringstream strm;
+        strm << "all channels are in use (while trying to connect to: "
+             << l << ")";
+
+        HPX_THROWS_IF(ec, network_error,
+            "shmem::connection_handler::create_connection", strm.str());
+        return std::shared_ptr<sender>();
+    }
+
+    parcelset::locality connection_handler::agas_locality(
+        util::runtime_configuration const & ini) const
+    {
+        // this parcelport is never used for bootstrapping
+        return parcelset::locality(locality());
+    }
+
+    parcelset::locality connection_handler::create_locality() const
+    {
+        return parcelset::locality(locality());
+    }
+
+    bool connection_handler::background_work(std::size_t num_thread)
+    {
+        bool did_some_work = receive();
+        if (progress_pending_writes())
+            did_some_work = true;
+        return did_some_work;
+    }
+
+    void connection_handler::add_pending_write(
+        std::shared_ptr<sender> sender_conn)
+    {
+        std::lock_guard<lcos::local::spinlock> l(pending_writes_mtx_);
+        pending_writes_.push_back(std::move(sender_conn));
+        num_pending_writes_ = pending_writes_.size();
+    }
+
+    std::shared_ptr<segment> connection_handler::get_segment(
+        std::string const& name)
+    {
+        std::lock_guard<lcos::local::spinlock> l(segments_mtx_);
+
+        std::map<std::string, std::shared_ptr<segment> >::iterator it =
+            segments_.find(name);
+        if (it == segments_.end())
+        {
+            it = segments_.emplace(name, std::make_shared<segment>(name)).first;
+        }
+        return it->second;
+    }
+
+    bool connection_handler::receive()
+    {
+        bool did_some_work = false;
+        for (std::unique_ptr<receiver> const& r : receivers_)
+        {
+            if (r->receive())
+                did_some_work = true;
+        }
+        return did_some_work;
+    }
+
+    bool connection_handler::has_incoming_data() const
+    {
+        for (std::unique_ptr<receiver> const& r : receivers_)
+        {
+            if (r->has_data())
+                return true;
+        }
+        return false;
+    }
+
+    bool connection_handler::progress_pending_writes()
+    {
+        if (num_pending_writes_.load(std::memory_order_relaxed) == 0)
+            return false;
+
+        // take over all pending write operations, a completed write might
+        // start the next one on the same connection
+        std::vector<std::shared_ptr<sender> > pending;
+        {
+            std::unique_lock<lcos::local::spinlock> l(
+                pending_writes_mtx_, std::try_to_lock);
+            if (!l.owns_lock())
+                return false;
+
+            std::swap(pending, pending_writes_);
+            num_pending_writes_ = 0;
+        }
+
+        bool did_some_work = false;
+        std::vector<std::shared_ptr<sender> > remaining;
+        for (std::shared_ptr<sender>& s : pending)
+        {
+            if (s->progress())
+                did_some_work = true;
+            else
+                remaining.push_back(std::move(s));
+        }
+
+        if (!remaining.empty())
+        {
+            std::lock_guard<lcos::local::spinlock> l(pending_writes_mtx_);
+            pending_writes_.insert(pending_writes_.end(),
+                std::make_move_iterator(remaining.begin()),
+                std::make_move_iterator(remaining.end()));
+            num_pending_writes_ = pending_writes_.size();
+        }
+        return did_some_work;
+    }
+
+    void connection_handler::io_service_work()
+    {
+        std::size_t k = 0;
+        while (!stopped_)
+        {
+            bool did_some_work = receive();
+            if (progress_pending_writes())
+                did_some_work = true;
+
+            if (did_some_work)
+            {
+                k = 0;
+            }
+            else if (++k < 32 || num_pending_writes_ != 0)
+            {
+                util::detail::yield_k(k,
+                    "hpx::parcelset::policies::shmem::connection_handler::"
+                        "io_service_work");
+            }
+            else
+            {
+                // Nothing arrived for a while, sleep until a sender rings
+                // the doorbell of our segment.
+                segment_->wait_for_doorbell(
+                    [this]() { return has_incoming_data(); },
+                    doorbell_timeout_ns);
+                k = 0;
+            }
+        }
+    }
+}}}}
+
+#endif
@@ -0,0 +1,57 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_SHMEM)
+#include <hpx/traits/plugin_config_data.hpp>
+
+#include <hpx/plugins/parcelport/shmem/connection_handler.hpp>
+#include <hpx/plugins/parcelport/shmem/sender.hpp>
+#include <hpx/plugins/parcelport_factory.hpp>
+
+namespace hpx { namespace traits
+{
+    // Inject additional configuration data into the factory registry for this
+    // type. This information ends up in the system wide configuration database
+    // under the plugin specific section:
+    //
+    //      [hpx.parcel.shmem]
+    //      ...
+    //      priority = 1000
+    //
+    // The parcelport is used only for destinations running on the same host,
+    // its priority is higher than the priority of all other parcelports to
+    // make sure it is chosen for those.
+    template <>
+    struct plugin_config_data<hpx::parcelset::policies::shmem::connection_handler>
+    {
+        static char const* priority()
+        {
+            return "1000";
+        }
+
+        static void init(int *argc, char ***argv, util::command_line_handling &cfg)
+        {
+        }
+
+        static char const* call()
+        {
+            return
+                "io_pool_size = ${HPX_PARCEL_SHMEM_IO_POOL_SIZE:1}\n"
+                "channels = ${HPX_PARCEL_SHMEM_CHANNELS:64}\n"
+                "channel_size = ${HPX_PARCEL_SHMEM_CHANNEL_SIZE:1048576}\n"
+                "deduplicate_chunks = "
+                    "${HPX_PARCEL_SHMEM_DEDUPLICATE_CHUNKS:1}\n"
+                ;
+        }
+    };
+}}
+
+HPX_REGISTER_PARCELPORT(
+    hpx::parcelset::policies::shmem::connection_handler,
+    shmem);
+
+#endif
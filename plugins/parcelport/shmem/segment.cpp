@@ -0,0 +1,241 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_SHMEM)
+#include <hpx/plugins/parcelport/shmem/segment.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    namespace
+    {
+        std::string make_segment_name()
+        {
+            std::random_device rd;
+            std::ostringstream strm;
+            strm << "/hpx." << ::getpid() << "." << std::hex << rd() << rd();
+            return strm.str();
+        }
+
+        std::string last_error(char const* what, std::string const& name)
+        {
+            return std::string(what) + " (" + name + "): " +
+                std::strerror(errno);
+        }
+
+        std::uint32_t* futex_word(std::atomic<std::uint32_t>& word)
+        {
+            return reinterpret_cast<std::uint32_t*>(&word);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    segment::segment(std::size_t num_channels, std::size_t channel_size)
+      : base_(nullptr)
+      , size_(0)
+      , linked_(false)
+    {
+        if (num_channels == 0 || channel_size == 0 ||
+            (channel_size & (channel_size - 1)) != 0)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter, "shmem::segment::segment",
+                "the shared memory segment needs at least one channel, the "
+                "size of a channel has to be a power of two");
+        }
+
+        // the data of the channels starts at a page boundary
+        std::size_t const page_size = std::size_t(::sysconf(_SC_PAGESIZE));
+        std::size_t data_offset = sizeof(segment_header) +
+            num_channels * sizeof(channel_header);
+        data_offset = (data_offset + page_size - 1) & ~(page_size - 1);
+
+        std::size_t const size = data_offset + num_channels * channel_size;
+
+        // create a new segment with a name which is not in use yet
+        int fd = -1;
+        for (int i = 0; i != 16 && fd == -1; ++i)
+        {
+            name_ = make_segment_name();
+            fd = ::shm_open(name_.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC,
+                S_IRUSR | S_IWUSR);
+            if (fd == -1 && errno != EEXIST)
+                break;
+        }
+        if (fd == -1)
+        {
+            HPX_THROW_EXCEPTION(network_error, "shmem::segment::segment",
+                last_error("shm_open failed", name_));
+        }
+        linked_ = true;
+
+        if (::ftruncate(fd, off_t(size)) == -1)
+        {
+            std::string const msg = last_error("ftruncate failed", name_);
+            ::close(fd);
+            unlink();
+            HPX_THROW_EXCEPTION(network_error, "shmem::segment::segment", msg);
+        }
+
+        try {
+            map(fd, size);
+        }
+        catch (...) {
+            unlink();
+            throw;
+        }
+
+        segment_header* h = new (base_) segment_header();
+        h->num_channels_ = num_channels;
+        h->channel_size_ = channel_size;
+        h->data_offset_ = data_offset;
+
+        for (std::size_t i = 0; i != num_channels; ++i)
+        {
+            new (&channel(i)) channel_header();
+        }
+
+        h->magic_ = segment_header::magic;
+    }
+
+    segment::segment(std::string const& name)
+      : name_(name)
+      , base_(nullptr)
+      , size_(0)
+      , linked_(false)
+    {
+        int fd = ::shm_open(name_.c_str(), O_RDWR | O_CLOEXEC, 0);
+        if (fd == -1)
+        {
+            HPX_THROW_EXCEPTION(network_error, "shmem::segment::segment",
+                last_error("shm_open failed", name_));
+        }
+
+        struct ::stat st;
+        if (::fstat(fd, &st) == -1 ||
+            std::size_t(st.st_size) < sizeof(segment_header))
+        {
+            std::string const msg = last_error("fstat failed", name_);
+            ::close(fd);
+            HPX_THROW_EXCEPTION(network_error, "shmem::segment::segment", msg);
+        }
+
+        map(fd, std::size_t(st.st_size));
+
+        segment_header const& h = header();
+        if (h.magic_ != segment_header::magic || h.num_channels_ == 0 ||
+            h.data_offset_ + h.num_channels_ * h.channel_size_ > size_)
+        {
+            ::munmap(base_, size_);
+            HPX_THROW_EXCEPTION(network_error, "shmem::segment::segment",
+                "the shared memory segment has an unexpected layout: " + name_);
+        }
+    }
+
+    segment::~segment()
+    {
+        if (base_ != nullptr)
+            ::munmap(base_, size_);
+        unlink();
+    }
+
+    void segment::map(int fd, std::size_t size)
+    {
+        void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+            fd, 0);
+        ::close(fd);
+
+        if (base == MAP_FAILED)
+        {
+            HPX_THROW_EXCEPTION(network_error, "shmem::segment::map",
+                last_error("mmap failed", name_));
+        }
+
+        base_ = base;
+        size_ = size;
+    }
+
+    void segment::unlink() noexcept
+    {
+        if (linked_)
+        {
+            ::shm_unlink(name_.c_str());
+            linked_ = false;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t segment::claim_channel() const noexcept
+    {
+        for (std::size_t i = 0; i != num_channels(); ++i)
+        {
+            std::uint32_t expected = 0;
+            if (channel(i).owner_.compare_exchange_strong(expected, 1,
+                    std::memory_order_acquire))
+            {
+                return i;
+            }
+        }
+        return std::size_t(-1);
+    }
+
+    void segment::release_channel(std::size_t i) const noexcept
+    {
+        channel(i).owner_.store(0, std::memory_order_release);
+    }
+
+    void segment::ring_doorbell() const noexcept
+    {
+        // the caller has published its data with sequential consistency,
+        // the receiver either sees the data or has announced to sleep
+        segment_header& h = header();
+        if (h.sleeping_.load(std::memory_order_relaxed) != 0)
+        {
+            h.doorbell_.fetch_add(1, std::memory_order_release);
+            futex_wake(h.doorbell_);
+        }
+    }
+
+    void segment::futex_wait(std::atomic<std::uint32_t>& word,
+        std::uint32_t value, std::uint64_t timeout_ns) noexcept
+    {
+        ::timespec ts;
+        ts.tv_sec = time_t(timeout_ns / 1000000000);
+        ts.tv_nsec = long(timeout_ns % 1000000000);
+
+        // the segment is shared between processes, FUTEX_PRIVATE_FLAG must
+        // not be used
+        ::syscall(SYS_futex, futex_word(word), FUTEX_WAIT, value, &ts,
+            nullptr, 0);
+    }
+
+    void segment::futex_wake(std::atomic<std::uint32_t>& word) noexcept
+    {
+        ::syscall(SYS_futex, futex_word(word), FUTEX_WAKE, 1, nullptr,
+            nullptr, 0);
+    }
+}}}}
+
+#endif
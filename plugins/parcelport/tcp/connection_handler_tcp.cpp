@@ -16,6 +16,7 @@
 #include <hpx/plugins/parcelport/tcp/connection_handler.hpp>
 #include <hpx/plugins/parcelport/tcp/receiver.hpp>
 #include <hpx/plugins/parcelport/tcp/sender.hpp>
+#include <hpx/plugins/parcelport/tcp/stripes.hpp>
 #include <hpx/runtime/parcelset/locality.hpp>
 #include <hpx/util/asio_util.hpp>
 #include <hpx/util/assert.hpp>
@@ -25,14 +26,18 @@
 #include <boost/io/ios_state.hpp>
 #include <boost/asio/ip/tcp.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <memory>
 #include <mutex>
+#include <random>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace hpx { namespace parcelset { namespace policies { namespace tcp
 {
@@ -68,6 +73,10 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
             on_stop_thread)
       : base_type(ini, parcelport_address(ini), on_start_thread, on_stop_thread)
       , acceptor_(nullptr)
+      , stripe_connections_(hpx::util::get_entry_as<std::size_t>(
+            ini, "hpx.parcel.tcp.stripe_connections", 0))
+      , stripe_threshold_(hpx::util::get_entry_as<std::size_t>(
+            ini, "hpx.parcel.tcp.stripe_threshold", 1048576))
     {
         if (here_.type() != std::string("tcp")) {
             HPX_THROW_EXCEPTION(network_error, "tcp::parcelport::parcelport",
@@ -136,6 +145,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
             }
 
             accepted_connections_.clear();
+            stripes_.clear();
 #if defined(HPX_HOLDON_TO_OUTGOING_CONNECTIONS)
             write_connections_.clear();
 #endif
@@ -226,6 +236,9 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
         s.set_option(boost::asio::ip::tcp::no_delay(true));
         s.set_option(boost::asio::socket_base::linger(true, 0));
 
+        if (stripe_connections_ != 0)
+            connect_stripes(*sender_connection, l);
+
 #if defined(HPX_HOLDON_TO_OUTGOING_CONNECTIONS)
         {
             std::lock_guard<lcos::local::spinlock> lock(connections_mtx_);
@@ -248,6 +261,137 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
         return sender_connection;
     }
 
+    namespace
+    {
+        // Announce a connection which is accompanied by stripes or one of
+        // its stripes to the receiving end, wait for the acknowledgment
+        boost::system::error_code announce_stripe(
+            boost::asio::ip::tcp::socket& s, std::uint64_t id,
+            std::size_t index, std::size_t count)
+        {
+            stripe_announcement announcement;
+            announcement.size_ = stripe_announcement_tag;
+            announcement.data_size_ = id;
+            announcement.num_chunks_.first = static_cast<std::uint32_t>(index);
+            announcement.num_chunks_.second = static_cast<std::uint32_t>(count);
+
+            boost::system::error_code error;
+            boost::asio::write(s,
+                boost::asio::buffer(&announcement, sizeof(announcement)),
+                error);
+            if (error)
+                return error;
+
+            bool ack = false;
+            boost::asio::read(s, boost::asio::buffer(&ack, sizeof(ack)), error);
+            if (!error && !ack)
+                error = boost::asio::error::make_error_code(
+                    boost::asio::error::operation_not_supported);
+            return error;
+        }
+
+        std::uint64_t initial_stripes_id()
+        {
+            std::random_device rd;
+            return (std::uint64_t(rd()) << 32) + 1;
+        }
+
+        std::uint64_t next_stripes_id()
+        {
+            // the ids are unique per sending locality with a high probability
+            static std::atomic<std::uint64_t> next_id(initial_stripes_id());
+            return next_id++;
+        }
+    }
+
+    // Open additional connections to the destination of the given one, the
+    // zero-copy chunks of large messages are split over all of them. The
+    // connection is used without stripes if any of them can't be set up.
+    void connection_handler::connect_stripes(sender& connection,
+        parcelset::locality const& l)
+    {
+        boost::asio::io_service& io_service = io_service_pool_.get_io_service();
+        std::uint64_t const id = next_stripes_id();
+
+        std::vector<std::unique_ptr<boost::asio::ip::tcp::socket> > stripes;
+        stripes.reserve(stripe_connections_);
+
+        boost::system::error_code error;
+        for (std::size_t i = 0; i != stripe_connections_; ++i)
+        {
+            std::unique_ptr<boost::asio::ip::tcp::socket> stripe(
+                new boost::asio::ip::tcp::socket(io_service));
+
+            error = boost::asio::error::try_again;
+            util::endpoint_iterator_type end = util::connect_end();
+            for (util::endpoint_iterator_type it =
+                    util::connect_begin(l.get<locality>(), io_service);
+                 it != end; ++it)
+            {
+                stripe->close(error);
+                stripe->connect(*it, error);
+                if (!error)
+                    break;
+            }
+            if (error)
+                break;
+
+            stripe->set_option(boost::asio::ip::tcp::no_delay(true));
+            stripe->set_option(boost::asio::socket_base::linger(true, 0));
+
+            error = announce_stripe(*stripe, id, i + 1, stripe_connections_);
+            if (error)
+                break;
+
+            stripes.push_back(std::move(stripe));
+        }
+
+        if (!error)
+        {
+            error = announce_stripe(
+                connection.socket(), id, 0, stripe_connections_);
+        }
+
+        if (error)
+        {
+            LPT_(warning)
+                << "tcp::connection_handler::connect_stripes: could not set "
+                   "up the stripes of a connection to " << l << ": "
+                << error.message();
+            return;
+        }
+
+        connection.set_stripes(std::move(stripes), stripe_threshold_);
+    }
+
+    void connection_handler::add_stripe(std::uint64_t id, std::size_t index,
+        std::size_t count, std::shared_ptr<receiver> const& stripe)
+    {
+        HPX_ASSERT(index != 0 && index <= count);
+
+        std::lock_guard<lcos::local::spinlock> l(connections_mtx_);
+        std::vector<std::shared_ptr<receiver> >& stripes = stripes_[id];
+        if (stripes.size() < count)
+            stripes.resize(count);
+        stripes[index - 1] = stripe;
+    }
+
+    std::vector<std::shared_ptr<receiver> > connection_handler::get_stripes(
+        std::uint64_t id) const
+    {
+        std::lock_guard<lcos::local::spinlock> l(connections_mtx_);
+        stripes_map::const_iterator it = stripes_.find(id);
+        if (it == stripes_.end())
+            return std::vector<std::shared_ptr<receiver> >();
+
+        for (std::shared_ptr<receiver> const& stripe : it->second)
+        {
+            if (!stripe)
+                return std::vector<std::shared_ptr<receiver> >();
+        }
+        return it->second;
+    }
+
     parcelset::locality connection_handler::agas_locality(
         util::runtime_configuration const & ini) const
     {
@@ -337,11 +481,36 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                 << e.message();
         }
 
+        std::vector<std::shared_ptr<receiver> > stripes;
+
 //         if (e != boost::asio::error::eof)
         {
             // remove this connection from the list of known connections
             std::lock_guard<lcos::local::spinlock> l(connections_mtx_);
             accepted_connections_.erase(receiver_conn);
+
+            // the stripes of the connection are closed along with it
+            std::uint64_t id = receiver_conn->stripes_id();
+            if (id != 0)
+            {
+                stripes_map::iterator it = stripes_.find(id);
+                if (it != stripes_.end())
+                {
+                    std::swap(stripes, it->second);
+                    stripes_.erase(it);
+                }
+                for (std::shared_ptr<receiver> const& stripe : stripes)
+                {
+                    if (stripe)
+                        accepted_connections_.erase(stripe);
+                }
+            }
+        }
+
+        for (std::shared_ptr<receiver> const& stripe : stripes)
+        {
+            if (stripe)
+                stripe->shutdown();
         }
     }
 }}}}
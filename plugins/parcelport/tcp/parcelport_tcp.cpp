@@ -35,7 +35,13 @@ namespace hpx { namespace traits
         }
         static char const* call()
         {
-            return "";
+            return
+                "deduplicate_chunks = ${HPX_PARCEL_TCP_DEDUPLICATE_CHUNKS:1}\n"
+                "stripe_connections = ${HPX_PARCEL_TCP_STRIPE_CONNECTIONS:0}\n"
+                "stripe_threshold = ${HPX_PARCEL_TCP_STRIPE_THRESHOLD:1048576}\n"
+                "polling = ${HPX_PARCEL_TCP_POLLING:0}\n"
+                "polling_interval = ${HPX_PARCEL_TCP_POLLING_INTERVAL:100}\n"
+                ;
         }
     };
 }}
@@ -0,0 +1,439 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_URING)
+#include <hpx/compat/thread.hpp>
+#include <hpx/exception_list.hpp>
+#include <hpx/plugins/parcelport/uring/connection_handler.hpp>
+#include <hpx/plugins/parcelport/uring/io_uring.hpp>
+#include <hpx/plugins/parcelport/uring/receiver.hpp>
+#include <hpx/plugins/parcelport/uring/sender.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime_fwd.hpp>
+#include <hpx/util/asio_util.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+#include <hpx/util/runtime_configuration.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#include <boost/asio/error.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/system/error_code.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+namespace hpx { namespace parcelset { namespace policies { namespace uring
+{
+    namespace
+    {
+        boost::system::error_code last_error()
+        {
+            return boost::system::error_code(errno,
+                boost::system::system_category());
+        }
+
+        // make sure the Nagle algorithm is disabled for this socket, disable
+        // lingering on close
+        void set_socket_options(int fd)
+        {
+            int const nodelay = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay,
+                sizeof(nodelay));
+
+            ::linger const l = { 1, 0 };
+            ::setsockopt(fd, SOL_SOCKET, SO_LINGER, &l, sizeof(l));
+        }
+    }
+
+    parcelset::locality parcelport_address(util::runtime_configuration const & ini)
+    {
+        // load all components as described in the configuration information
+        if (ini.has_section("hpx.parcel")) {
+            util::section const* sec = ini.get_section("hpx.parcel");
+            if (nullptr != sec) {
+                return parcelset::locality(
+                    locality(
+                        sec->get_entry("address", HPX_INITIAL_IP_ADDRESS)
+                      , hpx::util::get_entry_as<std::uint16_t>(
+                            *sec, "port", HPX_INITIAL_IP_PORT)
+                    )
+                );
+            }
+        }
+        return
+            parcelset::locality(
+                locality(
+                    HPX_INITIAL_IP_ADDRESS
+                  , HPX_INITIAL_IP_PORT
+                )
+            );
+    }
+
+    connection_handler::connection_handler(
+        util::runtime_configuration const& ini,
+        util::function_nonser<void(std::size_t, char const*)> const&
+            on_start_thread,
+        util::function_nonser<void(std::size_t, char const*)> const&
+            on_stop_thread)
+      : base_type(ini, parcelport_address(ini), on_start_thread, on_stop_thread)
+      , ring_(std::make_shared<ring>(
+            hpx::util::get_entry_as<unsigned>(
+                ini, "hpx.parcel.uring.submission_queue_size", "256"),
+            hpx::util::get_entry_as<unsigned>(
+                ini, "hpx.parcel.uring.fixed_files", "1024")))
+      , stopped_(false)
+    {
+        if (here_.type() != std::string("uring")) {
+            HPX_THROW_EXCEPTION(network_error, "uring::parcelport::parcelport",
+                "this parcelport was instantiated to represent an unexpected "
+                "locality type: " + std::string(here_.type()));
+        }
+    }
+
+    connection_handler::~connection_handler()
+    {
+        HPX_ASSERT(acceptors_.empty());
+    }
+
+    bool connection_handler::do_run()
+    {
+        boost::asio::io_service& io_service = io_service_pool_.get_io_service();
+
+        // initialize network
+        std::size_t tried = 0;
+        exception_list errors;
+        util::endpoint_iterator_type end = util::accept_end();
+        for (util::endpoint_iterator_type it =
+                util::accept_begin(here_.get<locality>(), io_service);
+             it != end; ++it, ++tried)
+        {
+            int fd = -1;
+            try {
+                boost::asio::ip::tcp::endpoint ep = *it;
+
+                fd = ::socket(ep.protocol().family(),
+                    SOCK_STREAM | SOCK_CLOEXEC, 0);
+                if (fd == -1)
+                    throw boost::system::system_error(last_error());
+
+                int const reuse_address = 1;
+                if (::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse_address,
+                        sizeof(reuse_address)) == -1 ||
+                    ::bind(fd, ep.data(), ep.size()) == -1 ||
+                    ::listen(fd, SOMAXCONN) == -1)
+                {
+                    throw boost::system::system_error(last_error());
+                }
+
+                acceptors_.emplace_back(new acceptor(*this, fd));
+                async_accept(*acceptors_.back());
+            }
+            catch (boost::system::system_error const&) {
+                if (fd != -1)
+                    ::close(fd);
+                errors.add(std::current_exception());
+                continue;
+            }
+        }
+
+        if (errors.size() == tried) {
+            // all attempts failed
+            HPX_THROW_EXCEPTION(network_error,
+                "uring::parcelport::run", errors.get_message());
+            return false;
+        }
+
+        // the ring is polled by the io_service threads until the background
+        // work of the worker threads takes over
+        for (std::size_t i = 0; i != io_service_pool_.size(); ++i)
+        {
+            io_service_pool_.get_io_service(int(i)).post(
+                hpx::util::bind(&connection_handler::io_service_work, this));
+        }
+        return true;
+    }
+
+    void connection_handler::do_stop()
+    {
+        stopped_ = true;
+
+        // abort all pending accept and read operations
+        for (std::unique_ptr<acceptor> const& a : acceptors_)
+        {
+            ::shutdown(a->fd_, SHUT_RDWR);
+        }
+
+        {
+            std::lock_guard<lcos::local::spinlock> l(connections_mtx_);
+            for (std::shared_ptr<receiver> const& c : accepted_connections_)
+            {
+                c->shutdown();
+            }
+        }
+
+        // wait for the aborted operations to complete
+        while (ring_->in_flight() != 0)
+        {
+            if (!ring_->poll() && threads::get_self_ptr())
+            {
+                hpx::this_thread::suspend(hpx::threads::pending,
+                    "uring::connection_handler::do_stop");
+            }
+        }
+
+        for (std::unique_ptr<acceptor> const& a : acceptors_)
+        {
+            ::close(a->fd_);
+        }
+        acceptors_.clear();
+
+        std::lock_guard<lcos::local::spinlock> l(connections_mtx_);
+        accepted_connections_.clear();
+    }
+
+    std::shared_ptr<sender> connection_handler::create_connection(
+        parcelset::locality const& l, error_code& ec)
+    {
+        boost::asio::io_service& io_service = io_service_pool_.get_io_service();
+
+        // Connect to the target locality, retry if needed
+        int fd = -1;
+        boost::system::error_code error = boost::asio::error::try_again;
+        for (std::size_t i = 0; i < HPX_MAX_NETWORK_RETRIES; ++i)
+        {
+            // An exit here, avoids hangs when late parcels are in flight
+            // (those are mainly decref requests).
+            if (stopped_)
+                return std::shared_ptr<sender>();
+            try {
+                util::endpoint_iterator_type end = util::connect_end();
+                for (util::endpoint_iterator_type it =
+                        util::connect_begin(l.get<locality>(), io_service);
+                      it != end; ++it)
+                {
+                    boost::asio::ip::tcp::endpoint ep = *it;
+
+                    fd = ::socket(ep.protocol().family(),
+                        SOCK_STREAM | SOCK_CLOEXEC, 0);
+                    if (fd == -1)
+                    {
+                        error = last_error();
+                        continue;
+                    }
+
+                    if (::connect(fd, ep.data(), ep.size()) == 0)
+                    {
+                        error = boost::system::error_code();
+                        break;
+                    }
+
+                    error = last_error();
+                    ::close(fd);
+                    fd = -1;
+                }
+                if (!error)
+                    break;
+
+                // wait for a really short amount of time
+                if (hpx::threads::get_self_ptr()) {
+                    this_thread::suspend(hpx::threads::pending,
+                        "connection_handler(uring)::create_connection");
+                }
+                else {
+                    compat::this_thread::sleep_for(
+                        std::chrono::milliseconds(HPX_NETWORK_RETRIES_SLEEP));
+                }
+            }
+            catch (boost::system::system_error const& e) {
+                HPX_THROWS_IF(ec, network_error,
+                    "uring::connection_handler::get_connection", e.what());
+                return std::shared_ptr<sender>();
+            }
+        }
+
+        if (error) {
+            std::ostringstream strm;
+            strm << error.message() << " (while trying to connect to: "
+                  << l << ")";
+
+            if (tolerate_node_faults())
+                return std::shared_ptr<sender>();
+
+            HPX_THROWS_IF(ec, network_error,
+                "uring::connection_handler::get_connection",
+                strm.str());
+            return std::shared_ptr<sender>();
+        }
+
+        set_socket_options(fd);
+
+        // The parcel gets serialized inside the connection constructor, no
+        // need to keep the original parcel alive after this call returned.
+        std::shared_ptr<sender> sender_connection(
+            new sender(ring_, fd, l, this));
+
+        if (&ec != &throws)
+            ec = make_success_code();
+
+        return sender_connection;
+    }
+
+    parcelset::locality connection_handler::agas_locality(
+        util::runtime_configuration const & ini) const
+    {
+        // load all components as described in the configuration information
+        if (ini.has_section("hpx.agas")) {
+            util::section const* sec = ini.get_section("hpx.agas");
+            if (nullptr != sec) {
+                return
+                    parcelset::locality(
+                        locality(
+                            sec->get_entry("address", HPX_INITIAL_IP_ADDRESS)
+                          , hpx::util::get_entry_as<std::uint16_t>(
+                                *sec, "port", HPX_INITIAL_IP_PORT)
+                        )
+                    );
+            }
+        }
+        return
+            parcelset::locality(
+                locality(
+                    HPX_INITIAL_IP_ADDRESS
+                  , HPX_INITIAL_IP_PORT
+                )
+            );
+    }
+
+    parcelset::locality connection_handler::create_locality() const
+    {
+        return parcelset::locality(locality());
+    }
+
+    bool connection_handler::background_work(std::size_t num_thread)
+    {
+        return ring_->poll();
+    }
+
+    void connection_handler::io_service_work()
+    {
+        std::size_t k = 0;
+        // We only poll the ring on the io_service while HPX is starting
+        while (hpx::is_starting())
+        {
+            if (ring_->poll())
+            {
+                k = 0;
+            }
+            else
+            {
+                ++k;
+                util::detail::yield_k(k,
+                    "hpx::parcelset::policies::uring::connection_handler::"
+                        "io_service_work");
+            }
+        }
+    }
+
+    void connection_handler::async_accept(acceptor& a)
+    {
+        ring_->submit(a,
+            [&a](io_uring_sqe& sqe)
+            {
+                sqe.opcode = IORING_OP_ACCEPT;
+                sqe.fd = a.fd_;
+                sqe.accept_flags = SOCK_CLOEXEC;
+            });
+    }
+
+    // accepted new incoming connection
+    void connection_handler::handle_accept(operation& op, int result)
+    {
+        acceptor& a = static_cast<acceptor&>(op);
+        connection_handler& this_ = a.handler_;
+
+        if (this_.stopped_)
+        {
+            if (result >= 0)
+                ::close(result);
+            return;
+        }
+
+        if (result < 0)
+        {
+            LPT_(error)
+                << "accept incoming connection: error: "
+                << std::strerror(-result);
+
+            // the listening socket keeps working after the pending
+            // connection was aborted, accept the next one
+            if (result == -ECONNABORTED || result == -EINTR ||
+                result == -EAGAIN)
+            {
+                this_.async_accept(a);
+            }
+            return;
+        }
+
+        // handle this incoming connection
+        set_socket_options(result);
+
+        std::shared_ptr<receiver> c(new receiver(this_.ring_, result,
+            this_.get_max_inbound_message_size(), this_));
+
+        {
+            // keep track of all accepted connections
+            std::lock_guard<lcos::local::spinlock> l(this_.connections_mtx_);
+            this_.accepted_connections_.insert(c);
+        }
+
+        // now accept the incoming connection by starting to read from the
+        // socket
+        c->async_read();
+
+        // wait for the next connection
+        this_.async_accept(a);
+    }
+
+    // Handle completion of a read operation.
+    void connection_handler::handle_read_completion(
+        boost::system::error_code const& e,
+        std::shared_ptr<receiver> receiver_conn)
+    {
+        if (!e) return;
+
+        if (e != boost::asio::error::operation_aborted &&
+            e != boost::asio::error::eof &&
+            e != boost::asio::error::connection_reset)
+        {
+            LPT_(error)
+                << "handle read operation completion: error: "
+                << e.message();
+        }
+
+        // remove this connection from the list of known connections
+        std::lock_guard<lcos::local::spinlock> l(connections_mtx_);
+        accepted_connections_.erase(receiver_conn);
+    }
+}}}}
+
+#endif
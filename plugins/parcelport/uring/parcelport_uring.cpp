@@ -0,0 +1,59 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_URING)
+#include <hpx/traits/plugin_config_data.hpp>
+
+#include <hpx/plugins/parcelport/uring/connection_handler.hpp>
+#include <hpx/plugins/parcelport/uring/sender.hpp>
+#include <hpx/plugins/parcelport_factory.hpp>
+
+namespace hpx { namespace traits
+{
+    // Inject additional configuration data into the factory registry for this
+    // type. This information ends up in the system wide configuration database
+    // under the plugin specific section:
+    //
+    //      [hpx.parcel.uring]
+    //      ...
+    //      priority = 10
+    //
+    // The parcelport listens on the same address and port as the TCP
+    // parcelport, it has to be enabled explicitly (and the TCP parcelport
+    // has to be disabled).
+    template <>
+    struct plugin_config_data<hpx::parcelset::policies::uring::connection_handler>
+    {
+        static char const* priority()
+        {
+            return "10";
+        }
+
+        static void init(int *argc, char ***argv, util::command_line_handling &cfg)
+        {
+        }
+
+        static char const* call()
+        {
+            return
+                "enable = ${HPX_HAVE_PARCELPORT_URING:0}\n"
+                "io_pool_size = ${HPX_PARCEL_URING_IO_POOL_SIZE:1}\n"
+                "submission_queue_size = "
+                    "${HPX_PARCEL_URING_SUBMISSION_QUEUE_SIZE:256}\n"
+                "fixed_files = ${HPX_PARCEL_URING_FIXED_FILES:1024}\n"
+                "deduplicate_chunks = "
+                    "${HPX_PARCEL_URING_DEDUPLICATE_CHUNKS:1}\n"
+                ;
+        }
+    };
+}}
+
+HPX_REGISTER_PARCELPORT(
+    hpx::parcelset::policies::uring::connection_handler,
+    uring);
+
+#endif
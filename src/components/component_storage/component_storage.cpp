@@ -10,6 +10,7 @@
 #include <hpx/components/component_storage/component_storage.hpp>
 
 #include <cstddef>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -19,6 +20,12 @@ namespace hpx { namespace components
       : base_type(hpx::new_<server::component_storage>(target_locality))
     {}
 
+    component_storage::component_storage(hpx::id_type target_locality,
+            std::string const& filename)
+      : base_type(hpx::new_<server::component_storage>(target_locality,
+            filename))
+    {}
+
     component_storage::component_storage(hpx::future<naming::id_type> && f)
       : base_type(std::move(f))
     {}
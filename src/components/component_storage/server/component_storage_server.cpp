@@ -7,7 +7,9 @@
 #include <hpx/components/component_storage/server/component_storage.hpp>
 #include <hpx/runtime/find_localities.hpp>
 
+#include <cstddef>
 #include <sstream>
+#include <string>
 #include <vector>
 
 namespace hpx { namespace components { namespace server
@@ -16,13 +18,20 @@ namespace hpx { namespace components { namespace server
       : data_(container_layout(find_all_localities()))
     {}
 
+    component_storage::component_storage(std::string const& filename)
+      : mapped_data_(new mapped_storage(filename))
+    {}
+
     ///////////////////////////////////////////////////////////////////////////
     naming::gid_type component_storage::migrate_to_here(
         std::vector<char> const& data, naming::id_type id,
         naming::address const& current_lva)
     {
         naming::gid_type gid(naming::detail::get_stripped_gid(id.get_gid()));
-        data_[gid] = data;
+        if (mapped_data_)
+            mapped_data_->store(gid, data);
+        else
+            data_[gid] = data;
 
         // rebind the object to this storage locality
         naming::address addr(current_lva);
@@ -47,9 +56,19 @@ namespace hpx { namespace components { namespace server
         naming::gid_type const& id)
     {
         // return the stored data and erase it from the map
+        if (mapped_data_)
+            return mapped_data_->retrieve(naming::detail::get_stripped_gid(id));
+
         return data_.get_value(launch::sync,
             naming::detail::get_stripped_gid(id), true);
     }
+
+    std::size_t component_storage::size() const
+    {
+        if (mapped_data_)
+            return mapped_data_->size();
+        return data_.size();
+    }
 }}}
 
 HPX_REGISTER_UNORDERED_MAP(hpx::naming::gid_type, hpx_component_storage_data_type)
@@ -0,0 +1,246 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <hpx/components/component_storage/server/mapped_storage.hpp>
+
+#if !defined(HPX_WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace components { namespace server
+{
+    namespace
+    {
+        // all stored components start at a multiple of this
+        std::uint64_t const alignment = 64;
+
+        // the initial size of the file, it is doubled whenever it is full
+        std::uint64_t const initial_size = std::uint64_t(16) << 20;
+
+        std::uint64_t round_up(std::uint64_t size)
+        {
+            return (size + alignment - 1) & ~(alignment - 1);
+        }
+
+        std::string last_error(char const* what, std::string const& name)
+        {
+            return std::string(what) + " (" + name + "): " +
+                std::strerror(errno);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    mapped_storage::mapped_storage(std::string const& filename)
+      : filename_(filename)
+      , fd_(-1)
+      , base_(nullptr)
+      , mapped_size_(0)
+      , end_(0)
+    {
+#if defined(HPX_WINDOWS)
+        HPX_THROW_EXCEPTION(not_implemented,
+            "mapped_storage::mapped_storage",
+            "memory mapped component storage is not supported on this "
+            "platform");
+#else
+        fd_ = ::open(filename_.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC,
+            0600);
+        if (fd_ == -1)
+        {
+            HPX_THROW_EXCEPTION(filesystem_error,
+                "mapped_storage::mapped_storage",
+                last_error("open failed", filename_));
+        }
+
+        try {
+            grow(initial_size);
+        }
+        catch (...) {
+            ::close(fd_);
+            ::unlink(filename_.c_str());
+            throw;
+        }
+#endif
+    }
+
+    mapped_storage::~mapped_storage()
+    {
+#if !defined(HPX_WINDOWS)
+        if (base_ != nullptr)
+            ::munmap(base_, mapped_size_);
+        if (fd_ != -1)
+        {
+            ::close(fd_);
+            ::unlink(filename_.c_str());
+        }
+#endif
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void mapped_storage::store(naming::gid_type const& id,
+        std::vector<char> const& data)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+
+        auto it = index_.find(id);
+        if (it != index_.end())
+        {
+            deallocate(it->second.offset_, it->second.size_);
+            index_.erase(it);
+        }
+
+        std::uint64_t const offset = allocate(data.size());
+        if (!data.empty())
+            std::memcpy(base_ + offset, data.data(), data.size());
+
+        index_[id] = record{offset, data.size()};
+    }
+
+    std::vector<char> mapped_storage::retrieve(naming::gid_type const& id)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+
+        auto it = index_.find(id);
+        if (it == index_.end())
+        {
+            std::ostringstream strm;
+            strm << "no component with the id " << id << " was stored in '"
+                 << filename_ << "'";
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "mapped_storage::retrieve", strm.str());
+        }
+
+        record const r = it->second;
+        index_.erase(it);
+
+        // the pages holding the data are read on demand
+        std::vector<char> data(base_ + r.offset_, base_ + r.offset_ + r.size_);
+        deallocate(r.offset_, r.size_);
+
+        return data;
+    }
+
+    std::size_t mapped_storage::size() const
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        return index_.size();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // first fit allocation from the free ranges, extend the used part of the
+    // file if none of those is large enough
+    std::uint64_t mapped_storage::allocate(std::uint64_t size)
+    {
+        size = round_up(size == 0 ? 1 : size);
+
+        for (auto it = free_.begin(); it != free_.end(); ++it)
+        {
+            if (it->second < size)
+                continue;
+
+            std::uint64_t const offset = it->first;
+            std::uint64_t const remaining = it->second - size;
+            free_.erase(it);
+            if (remaining != 0)
+                free_.emplace(offset + size, remaining);
+            return offset;
+        }
+
+        if (end_ + size > mapped_size_)
+        {
+            std::uint64_t new_size = mapped_size_;
+            while (end_ + size > new_size)
+                new_size *= 2;
+            grow(new_size);
+        }
+
+        std::uint64_t const offset = end_;
+        end_ += size;
+        return offset;
+    }
+
+    // return the given range to the free ranges, merging it with adjacent
+    // ones, ranges at the end of the used part of the file shrink that
+    void mapped_storage::deallocate(std::uint64_t offset, std::uint64_t size)
+    {
+        size = round_up(size == 0 ? 1 : size);
+
+        auto next = free_.lower_bound(offset);
+        if (next != free_.begin())
+        {
+            auto prev = std::prev(next);
+            if (prev->first + prev->second == offset)
+            {
+                offset = prev->first;
+                size += prev->second;
+                free_.erase(prev);
+            }
+        }
+        if (next != free_.end() && offset + size == next->first)
+        {
+            size += next->second;
+            free_.erase(next);
+        }
+
+        if (offset + size == end_)
+            end_ = offset;
+        else
+            free_.emplace(offset, size);
+
+#if !defined(HPX_WINDOWS) && defined(MADV_REMOVE)
+        // the data is not needed anymore, release the memory and the disk
+        // space it occupies (errors are ignored, not all file systems support
+        // this)
+        std::uint64_t const page_size = std::uint64_t(::sysconf(_SC_PAGESIZE));
+        std::uint64_t const first = (offset + page_size - 1) & ~(page_size - 1);
+        std::uint64_t const last = (offset + size) & ~(page_size - 1);
+        if (first < last)
+            ::madvise(base_ + first, last - first, MADV_REMOVE);
+#endif
+    }
+
+    void mapped_storage::grow(std::uint64_t size)
+    {
+#if !defined(HPX_WINDOWS)
+        if (::ftruncate(fd_, off_t(size)) == -1)
+        {
+            HPX_THROW_EXCEPTION(filesystem_error,
+                "mapped_storage::grow",
+                last_error("ftruncate failed", filename_));
+        }
+
+        void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+            fd_, 0);
+        if (base == MAP_FAILED)
+        {
+            HPX_THROW_EXCEPTION(filesystem_error,
+                "mapped_storage::grow",
+                last_error("mmap failed", filename_));
+        }
+
+        if (base_ != nullptr)
+            ::munmap(base_, mapped_size_);
+
+        base_ = static_cast<char*>(base);
+        mapped_size_ = size;
+#endif
+    }
+}}}
@@ -14,6 +14,7 @@
 #include <hpx/runtime/actions/basic_action.hpp>
 #include <hpx/util/function.hpp>
 
+#include <hpx/components/iostreams/server/output_aggregator.hpp>
 #include <hpx/components/iostreams/server/output_stream.hpp>
 #include <hpx/components/iostreams/ostream.hpp>
 #include <hpx/components/iostreams/standard_streams.hpp>
@@ -50,6 +51,8 @@ namespace hpx { namespace iostreams { namespace detail
         hpx::cout.initialize(iostreams::detail::cout_tag());
         hpx::cerr.initialize(iostreams::detail::cerr_tag());
         hpx::consolestream.initialize(iostreams::detail::consolestream_tag());
+
+        output_aggregator::get().start();
     }
 
     void unregister_ostreams()
@@ -57,6 +60,9 @@ namespace hpx { namespace iostreams { namespace detail
         hpx::cout.uninitialize(iostreams::detail::cout_tag());
         hpx::cerr.uninitialize(iostreams::detail::cerr_tag());
         hpx::consolestream.uninitialize(iostreams::detail::consolestream_tag());
+
+        // send the output still held back by the aggregator
+        output_aggregator::get().stop();
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,282 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/apply.hpp>
+#include <hpx/async.hpp>
+#include <hpx/error.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/runtime/actions/plain_action.hpp>
+#include <hpx/runtime/agas/interface.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/get_num_localities.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/bind_front.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#include <hpx/components/iostreams/server/output_aggregator.hpp>
+#include <hpx/components/iostreams/server/output_stream.hpp>
+#include <hpx/components/iostreams/standard_streams.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace iostreams { namespace detail
+{
+    void write_batch(std::vector<output_entry> entries, bool sync);
+}}}
+
+HPX_PLAIN_ACTION(hpx::iostreams::detail::write_batch,
+    output_aggregator_write_batch_action);
+
+namespace hpx { namespace iostreams { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    void write_batch(std::vector<output_entry> entries, bool sync)
+    {
+        output_aggregator::get().receive(std::move(entries), sync);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    output_aggregator::output_aggregator()
+      : pending_bytes_(0)
+      , buffer_size_(0)
+      , parent_(0)
+      , is_console_(true)
+      , enabled_(false)
+      , async_(false)
+      , stopped_(true)
+    {}
+
+    output_aggregator& output_aggregator::get()
+    {
+        static output_aggregator aggregator;
+        return aggregator;
+    }
+
+    void output_aggregator::start()
+    {
+        std::uint32_t arity = util::safe_lexical_cast<std::uint32_t>(
+            get_config_entry("hpx.iostreams.arity", 0), 0);
+        std::int64_t flush_interval = util::safe_lexical_cast<std::int64_t>(
+            get_config_entry("hpx.iostreams.flush_interval", 10), 10);
+
+        std::lock_guard<mutex_type> l(mtx_);
+
+        buffer_size_ = util::safe_lexical_cast<std::size_t>(
+            get_config_entry("hpx.iostreams.buffer_size", 0), 0);
+        async_ = util::safe_lexical_cast<int>(
+            get_config_entry("hpx.iostreams.async", 0), 0) != 0;
+
+        is_console_ = agas::is_console();
+        enabled_ = !is_console_ && (arity != 0 || buffer_size_ != 0 || async_);
+        stopped_ = false;
+
+        if (!enabled_)
+            return;
+
+        // the console has rank 0, the parent of rank r is rank (r - 1) / arity,
+        // localities connecting later send their output to the console
+        std::uint32_t console = naming::get_locality_id_from_id(
+            agas::get_console_locality());
+        std::uint32_t here = get_locality_id();
+        std::uint32_t num_localities = get_initial_num_localities();
+
+        parent_ = console;
+        if (arity != 0 && here < num_localities && console < num_localities)
+        {
+            std::uint32_t rank = (here + num_localities - console) %
+                num_localities;
+            parent_ = ((rank - 1) / arity + console) % num_localities;
+        }
+
+        if ((buffer_size_ != 0 || async_) && flush_interval > 0)
+        {
+            timer_.reset(new util::interval_timer(
+                util::bind_front(&output_aggregator::flush_pending, this),
+                flush_interval * 1000, "hpx::iostreams::output_aggregator",
+                true));
+            timer_->start(false);
+        }
+    }
+
+    void output_aggregator::stop()
+    {
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            if (stopped_)
+                return;
+            stopped_ = true;
+        }
+
+        if (timer_)
+            timer_->stop();
+
+        flush(true);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void output_aggregator::receive(std::vector<output_entry>&& entries,
+        bool sync)
+    {
+        if (is_console_)
+        {
+            deliver_output(entries, sync);
+            return;
+        }
+
+        std::vector<output_entry> batch;
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+
+            for (output_entry const& entry : entries)
+                pending_bytes_ += entry.data_.size();
+
+            if (pending_.empty())
+            {
+                pending_ = std::move(entries);
+            }
+            else
+            {
+                pending_.reserve(pending_.size() + entries.size());
+                std::move(entries.begin(), entries.end(),
+                    std::back_inserter(pending_));
+            }
+
+            // output arriving after shutdown started is not delayed anymore
+            if (sync || stopped_ || pending_bytes_ >= buffer_size_)
+            {
+                std::swap(batch, pending_);
+                pending_bytes_ = 0;
+            }
+        }
+
+        if (!batch.empty())
+            send(std::move(batch), sync);
+    }
+
+    void output_aggregator::flush(bool sync)
+    {
+        std::vector<output_entry> batch;
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            std::swap(batch, pending_);
+            pending_bytes_ = 0;
+        }
+
+        if (!batch.empty())
+            send(std::move(batch), sync);
+    }
+
+    bool output_aggregator::flush_pending()
+    {
+        flush(false);
+        return true;
+    }
+
+    void output_aggregator::send(std::vector<output_entry>&& entries,
+        bool sync) const
+    {
+        naming::id_type parent = naming::get_id_from_locality_id(parent_);
+        if (sync)
+        {
+            hpx::async<output_aggregator_write_batch_action>(
+                parent, std::move(entries), true).get();
+        }
+        else
+        {
+            hpx::apply<output_aggregator_write_batch_action>(
+                parent, std::move(entries), false);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    naming::id_type const& get_stream_id(std::uint8_t stream)
+    {
+        switch (stream)
+        {
+        case cout_stream:
+            return hpx::cout.get_id();
+
+        case cerr_stream:
+            return hpx::cerr.get_id();
+
+        case console_stream:
+            return hpx::consolestream.get_id();
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(bad_parameter,
+            "hpx::iostreams::detail::get_stream_id",
+            "unknown standard stream");
+        return naming::invalid_id;
+    }
+
+    void deliver_output(std::vector<output_entry> const& entries, bool sync)
+    {
+        std::vector<hpx::future<void> > writes;
+        if (sync)
+            writes.reserve(entries.size());
+
+        for (output_entry const& entry : entries)
+        {
+            naming::id_type const& id = get_stream_id(entry.stream_);
+            if (sync)
+            {
+                typedef server::output_stream::write_sync_action action_type;
+                writes.push_back(hpx::async<action_type>(id,
+                    entry.locality_id_, entry.count_, entry.data_));
+            }
+            else
+            {
+                typedef server::output_stream::write_async_action action_type;
+                hpx::apply<action_type>(id, entry.locality_id_, entry.count_,
+                    entry.data_);
+            }
+        }
+
+        hpx::wait_all(writes);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void write_output(naming::id_type const& id, std::uint8_t stream,
+        std::uint64_t count, buffer const& data, bool sync, bool force_sync)
+    {
+        output_aggregator& aggregator = output_aggregator::get();
+        sync = force_sync || (sync && !aggregator.is_async());
+
+        if (!aggregator.enabled())
+        {
+            if (sync)
+            {
+                typedef server::output_stream::write_sync_action action_type;
+                hpx::async<action_type>(id, hpx::get_locality_id(), count,
+                    data).get();
+            }
+            else
+            {
+                typedef server::output_stream::write_async_action action_type;
+                hpx::apply<action_type>(id, hpx::get_locality_id(), count,
+                    data);
+            }
+            return;
+        }
+
+        std::vector<output_entry> entries;
+        entries.push_back(
+            output_entry{stream, hpx::get_locality_id(), count, data});
+        aggregator.receive(std::move(entries), sync);
+    }
+}}}
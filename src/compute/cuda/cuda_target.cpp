@@ -7,13 +7,17 @@
 
 #if defined(HPX_HAVE_CUDA)
 
+#include <hpx/compute/cuda/event_polling.hpp>
 #include <hpx/compute/cuda/target.hpp>
 #include <hpx/exception.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/config_entry.hpp>
 #include <hpx/runtime/find_here.hpp>
 #include <hpx/runtime/naming/id_type_impl.hpp>
 #include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/runtime_fwd.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
 
 #if !defined(HPX_COMPUTE_DEVICE_CODE)
 #if !defined(HPX_COMPUTE_DEVICE_CODE) && defined(HPX_HAVE_MORE_THAN_64_THREADS)
@@ -26,9 +30,13 @@
 #include <hpx/runtime/serialization/serialize.hpp>
 #endif
 
+#include <atomic>
 #include <cstddef>
+#include <map>
+#include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <cuda_runtime.h>
 
@@ -140,6 +148,211 @@ namespace hpx { namespace compute { namespace cuda
                         cudaGetErrorString(error));
             }
         }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The shared state of a future which is made ready by poll_events()
+        // once the event recorded on the stream has been reached.
+        struct event_future_data : lcos::detail::future_data<void>
+        {
+            event_future_data(cudaEvent_t event, int device)
+              : event_(event), device_(device)
+            {}
+
+            cudaEvent_t event_;
+            int device_;
+        };
+
+        class event_poller
+        {
+            typedef hpx::lcos::local::spinlock mutex_type;
+            typedef boost::intrusive_ptr<event_future_data> pending_type;
+
+        public:
+            event_poller()
+              : num_pending_(0)
+            {}
+
+            // The events are not destroyed, the CUDA runtime might have been
+            // shut down already when the static instance is destroyed.
+
+            cudaEvent_t get_event(int device)
+            {
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    std::vector<cudaEvent_t>& events = free_events_[device];
+                    if (!events.empty())
+                    {
+                        cudaEvent_t event = events.back();
+                        events.pop_back();
+                        return event;
+                    }
+                }
+
+                cudaError_t error = cudaSetDevice(device);
+                if (error != cudaSuccess)
+                {
+                    HPX_THROW_EXCEPTION(kernel_error,
+                        "cuda::detail::event_poller::get_event()",
+                        std::string("cudaSetDevice failed: ") +
+                            cudaGetErrorString(error));
+                }
+
+                cudaEvent_t event;
+                error = cudaEventCreateWithFlags(&event,
+                    cudaEventDisableTiming);
+                if (error != cudaSuccess)
+                {
+                    HPX_THROW_EXCEPTION(kernel_error,
+                        "cuda::detail::event_poller::get_event()",
+                        std::string("cudaEventCreateWithFlags failed: ") +
+                            cudaGetErrorString(error));
+                }
+                return event;
+            }
+
+            void release_event(int device, cudaEvent_t event)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                free_events_[device].push_back(event);
+            }
+
+            // Make the given stream wait for the event of the given future.
+            void wait_for(cudaStream_t stream, event_future_data const* data)
+            {
+                cudaError_t error = cudaSuccess;
+                {
+                    // the event is recorded for this future only as long as
+                    // the future is pending, otherwise it has been reached
+                    // already
+                    std::lock_guard<mutex_type> l(mtx_);
+                    for (pending_type const& p : pending_)
+                    {
+                        if (p.get() == data)
+                        {
+                            error = cudaStreamWaitEvent(
+                                stream, data->event_, 0);
+                            break;
+                        }
+                    }
+                }
+
+                if (error != cudaSuccess)
+                {
+                    HPX_THROW_EXCEPTION(kernel_error,
+                        "cuda::detail::event_poller::wait_for()",
+                        std::string("cudaStreamWaitEvent failed: ") +
+                            cudaGetErrorString(error));
+                }
+            }
+
+            void add(pending_type const& p)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                pending_.push_back(p);
+                ++num_pending_;
+            }
+
+            bool poll()
+            {
+                // avoid taking the lock if there is nothing to do
+                if (num_pending_.load(std::memory_order_relaxed) == 0)
+                    return false;
+
+                // only one worker thread polls at any time
+                std::unique_lock<mutex_type> l(mtx_, std::try_to_lock);
+                if (!l.owns_lock())
+                    return false;
+
+                std::vector<std::pair<pending_type, cudaError_t> > completed;
+                for (std::size_t i = 0; i != pending_.size(); /**/)
+                {
+                    event_future_data& data = *pending_[i];
+                    cudaError_t error = cudaEventQuery(data.event_);
+                    if (error == cudaErrorNotReady)
+                    {
+                        ++i;
+                        continue;
+                    }
+
+                    if (error == cudaSuccess)
+                        free_events_[data.device_].push_back(data.event_);
+                    else
+                        cudaEventDestroy(data.event_);      // ignore error
+
+                    completed.emplace_back(std::move(pending_[i]), error);
+                    pending_[i] = std::move(pending_.back());
+                    pending_.pop_back();
+                }
+                num_pending_ -= completed.size();
+
+                // make the futures ready outside of the lock, this runs
+                // their continuations
+                l.unlock();
+
+                for (auto& p : completed)
+                {
+                    if (p.second != cudaSuccess)
+                    {
+                        p.first->set_exception(
+                            HPX_GET_EXCEPTION(kernel_error,
+                                "cuda::detail::event_poller::poll()",
+                                std::string("cudaEventQuery failed: ") +
+                                    cudaGetErrorString(p.second))
+                        );
+                        continue;
+                    }
+                    p.first->set_data(hpx::util::unused);
+                }
+                return !completed.empty();
+            }
+
+        private:
+            mutex_type mtx_;
+            std::atomic<std::size_t> num_pending_;
+            std::vector<pending_type> pending_;
+            std::map<int, std::vector<cudaEvent_t> > free_events_;
+        };
+
+        event_poller& get_event_poller()
+        {
+            static event_poller poller;
+            return poller;
+        }
+
+        hpx::future<void> get_event_future(cudaStream_t stream, int device)
+        {
+            event_poller& poller = get_event_poller();
+
+            cudaEvent_t event = poller.get_event(device);
+            cudaError_t error = cudaEventRecord(event, stream);
+            if (error != cudaSuccess)
+            {
+                poller.release_event(device, event);
+                HPX_THROW_EXCEPTION(kernel_error,
+                    "cuda::detail::get_event_future()",
+                    std::string("cudaEventRecord failed: ") +
+                        cudaGetErrorString(error));
+            }
+
+            boost::intrusive_ptr<event_future_data> p(
+                new event_future_data(event, device));
+            poller.add(p);
+            return hpx::traits::future_access<hpx::future<void> >::
+                create(std::move(p));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool event_polling_enabled()
+    {
+        static bool const enabled = hpx::util::safe_lexical_cast<int>(
+            hpx::get_config_entry("hpx.cuda.event_polling", "0"), 0) != 0;
+        return enabled;
+    }
+
+    bool poll_events()
+    {
+        return detail::get_event_poller().poll();
     }
 
     void target::native_handle_type::init_processing_units()
@@ -306,6 +519,12 @@ namespace hpx { namespace compute { namespace cuda
 
     hpx::future<void> target::get_future() const
     {
+        if (event_polling_enabled())
+        {
+            return detail::get_event_future(
+                handle_.get_stream(), handle_.get_device());
+        }
+
         typedef detail::future_data shared_state_type;
 
         // make sure shared state stays alive even if the callback is invoked
@@ -316,6 +535,19 @@ namespace hpx { namespace compute { namespace cuda
             create(std::move(p));
     }
 
+    bool target::wait_for_shared_state(
+        hpx::traits::detail::shared_state_ptr<void>::type::element_type*
+            state) const
+    {
+        detail::event_future_data const* data =
+            dynamic_cast<detail::event_future_data const*>(state);
+        if (data == nullptr)
+            return false;
+
+        detail::get_event_poller().wait_for(handle_.get_stream(), data);
+        return true;
+    }
+
 #if !defined(HPX_COMPUTE_DEVICE_CODE)
     ///////////////////////////////////////////////////////////////////////////
     void target::serialize(serialization::input_archive& ar,
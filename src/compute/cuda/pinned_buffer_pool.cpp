@@ -0,0 +1,366 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_CUDA)
+
+#include <hpx/compute/cuda/pinned_buffer_pool.hpp>
+#include <hpx/compute/cuda/target.hpp>
+#include <hpx/exception.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+#include <hpx/util/yield_while.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <cuda_runtime.h>
+
+namespace hpx { namespace compute { namespace cuda { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Each pinned buffer is preceded by this header, which keeps the data of
+    // the buffer aligned to a cache line.
+    struct alignas(64) pinned_header
+    {
+        std::size_t size_class;
+        std::size_t capacity;
+        cudaEvent_t event;
+    };
+
+    static_assert(sizeof(pinned_header) == 64,
+        "the header of the pinned buffers should fill one cache line");
+
+    pinned_header* get_header(void const* p)
+    {
+        return reinterpret_cast<pinned_header*>(
+            const_cast<char*>(static_cast<char const*>(p)) -
+                sizeof(pinned_header));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    class pinned_buffer_pool
+    {
+        typedef hpx::lcos::local::spinlock mutex_type;
+
+        // the buffers are rounded up to powers of two between 64KiB and
+        // 64MiB, larger buffers are not cached
+        static constexpr std::size_t min_class_log2 = 16;
+        static constexpr std::size_t max_class_log2 = 26;
+        static constexpr std::size_t num_classes =
+            max_class_log2 - min_class_log2 + 1;
+        static constexpr std::size_t uncached = std::size_t(-1);
+
+        // the number of bytes cached for each size class
+        static constexpr std::size_t max_cached_bytes =
+            std::size_t(1) << max_class_log2;
+
+        static std::size_t get_size_class(std::size_t size)
+        {
+            std::size_t log2 = min_class_log2;
+            while (log2 <= max_class_log2 && (std::size_t(1) << log2) < size)
+                ++log2;
+            return log2 <= max_class_log2 ? log2 - min_class_log2 : uncached;
+        }
+
+    public:
+        void* allocate(std::size_t size)
+        {
+            std::size_t size_class = get_size_class(size);
+            if (size_class != uncached)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                std::vector<pinned_header*>& buffers = free_[size_class];
+                if (!buffers.empty())
+                {
+                    pinned_header* header = buffers.back();
+                    buffers.pop_back();
+                    return header + 1;
+                }
+            }
+
+            std::size_t capacity = size_class != uncached ?
+                std::size_t(1) << (size_class + min_class_log2) : size;
+
+            void* p = nullptr;
+            cudaError_t error =
+                cudaMallocHost(&p, capacity + sizeof(pinned_header));
+            if (error != cudaSuccess)
+            {
+                HPX_THROW_EXCEPTION(out_of_memory,
+                    "cuda::detail::pinned_buffer_pool::allocate()",
+                    std::string("cudaMallocHost failed: ") +
+                        cudaGetErrorString(error));
+            }
+
+            pinned_header* header = static_cast<pinned_header*>(p);
+            header->size_class = size_class;
+            header->capacity = capacity;
+            header->event = nullptr;
+            return header + 1;
+        }
+
+        void deallocate(void* p) noexcept
+        {
+            pinned_header* header = get_header(p);
+            if (header->size_class != uncached)
+            {
+                std::size_t max_cached = (std::max)(std::size_t(2),
+                    max_cached_bytes / header->capacity);
+
+                std::lock_guard<mutex_type> l(mtx_);
+                std::vector<pinned_header*>& buffers =
+                    free_[header->size_class];
+                if (buffers.size() < max_cached)
+                {
+                    buffers.push_back(header);
+                    return;
+                }
+            }
+
+            if (header->event != nullptr)
+                cudaEventDestroy(header->event);        // ignore error
+            cudaFreeHost(header);                       // ignore error
+        }
+
+    private:
+        mutex_type mtx_;
+        std::vector<pinned_header*> free_[num_classes];
+    };
+
+    // The cached buffers are not released, the CUDA runtime might have been
+    // shut down already when the static instance is destroyed.
+    pinned_buffer_pool& get_pinned_buffer_pool()
+    {
+        static pinned_buffer_pool* pool = new pinned_buffer_pool;
+        return *pool;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void* allocate_pinned(std::size_t size)
+    {
+        return get_pinned_buffer_pool().allocate(size);
+    }
+
+    void deallocate_pinned(void* p) noexcept
+    {
+        if (p != nullptr)
+            get_pinned_buffer_pool().deallocate(p);
+    }
+
+    std::size_t pinned_capacity(void const* p) noexcept
+    {
+        return get_header(p)->capacity;
+    }
+
+    cudaEvent_t pinned_event(void* p)
+    {
+        pinned_header* header = get_header(p);
+        if (header->event == nullptr)
+        {
+            cudaError_t error = cudaEventCreateWithFlags(
+                &header->event, cudaEventDisableTiming);
+            if (error != cudaSuccess)
+            {
+                header->event = nullptr;
+                HPX_THROW_EXCEPTION(kernel_error,
+                    "cuda::detail::pinned_event()",
+                    std::string("cudaEventCreateWithFlags failed: ") +
+                        cudaGetErrorString(error));
+            }
+        }
+        return header->event;
+    }
+
+    bool is_pinned(void const* p)
+    {
+        cudaPointerAttributes attributes;
+        cudaError_t error = cudaPointerGetAttributes(&attributes, p);
+        if (error != cudaSuccess)
+        {
+            // older versions of CUDA report an error for memory which is not
+            // known to the runtime, reset the error state
+            cudaGetLastError();
+            return false;
+        }
+#if CUDART_VERSION >= 10000
+        return attributes.type == cudaMemoryTypeHost;
+#else
+        return attributes.memoryType == cudaMemoryTypeHost;
+#endif
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        std::size_t staging_threshold()
+        {
+            static std::size_t const threshold =
+                hpx::util::safe_lexical_cast<std::size_t>(
+                    hpx::get_config_entry("hpx.cuda.staging_threshold",
+                        "65536"), 65536);
+            return threshold;
+        }
+
+        std::size_t staging_chunk_size()
+        {
+            static std::size_t const chunk_size = (std::max)(std::size_t(1),
+                hpx::util::safe_lexical_cast<std::size_t>(
+                    hpx::get_config_entry("hpx.cuda.staging_chunk_size",
+                        "1048576"), 1048576));
+            return chunk_size;
+        }
+
+        bool use_staging(void const* host, std::size_t bytes)
+        {
+            std::size_t threshold = staging_threshold();
+            return threshold != 0 && bytes >= threshold && !is_pinned(host);
+        }
+
+        void check_error(cudaError_t error, char const* function,
+            char const* call)
+        {
+            if (error != cudaSuccess)
+            {
+                HPX_THROW_EXCEPTION(kernel_error, function,
+                    std::string(call) + " failed: " +
+                        cudaGetErrorString(error));
+            }
+        }
+
+        // Wait for the given event, HPX threads yield while waiting.
+        void wait_for_event(cudaEvent_t event, char const* function)
+        {
+            if (hpx::threads::get_self_ptr() != nullptr)
+            {
+                cudaError_t error = cudaSuccess;
+                hpx::util::yield_while(
+                    [event, &error]() -> bool
+                    {
+                        error = cudaEventQuery(event);
+                        return error == cudaErrorNotReady;
+                    }, function);
+                check_error(error, function, "cudaEventQuery");
+            }
+            else
+            {
+                check_error(cudaEventSynchronize(event), function,
+                    "cudaEventSynchronize");
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void copy_host_to_device(cuda::target const& tgt, void* dest,
+        void const* src, std::size_t bytes)
+    {
+        char const* const function = "cuda::detail::copy_host_to_device()";
+
+        cudaStream_t stream = tgt.native_handle().get_stream();
+        if (!use_staging(src, bytes))
+        {
+            check_error(cudaMemcpyAsync(dest, src, bytes,
+                cudaMemcpyHostToDevice, stream), function, "cudaMemcpyAsync");
+            return;
+        }
+
+        std::size_t chunk_size = (std::min)(staging_chunk_size(), bytes);
+        pinned_buffer buffers[2] = {
+            pinned_buffer(chunk_size), pinned_buffer(chunk_size)
+        };
+        bool pending[2] = { false, false };
+
+        char* d = static_cast<char*>(dest);
+        char const* s = static_cast<char const*>(src);
+
+        // fill one buffer while the other one is being transferred
+        std::size_t i = 0;
+        for (std::size_t offset = 0; offset < bytes; offset += chunk_size)
+        {
+            std::size_t size = (std::min)(chunk_size, bytes - offset);
+            pinned_buffer& buffer = buffers[i];
+
+            if (pending[i])
+                wait_for_event(buffer.event(), function);
+
+            std::memcpy(buffer.data(), s + offset, size);
+            check_error(cudaMemcpyAsync(d + offset, buffer.data(), size,
+                cudaMemcpyHostToDevice, stream), function, "cudaMemcpyAsync");
+            check_error(cudaEventRecord(buffer.event(), stream), function,
+                "cudaEventRecord");
+
+            pending[i] = true;
+            i ^= 1;
+        }
+
+        // the buffers can be reused once the transfers have completed
+        for (std::size_t j = 0; j != 2; ++j)
+        {
+            if (pending[j])
+                wait_for_event(buffers[j].event(), function);
+        }
+    }
+
+    void copy_device_to_host(cuda::target const& tgt, void* dest,
+        void const* src, std::size_t bytes)
+    {
+        char const* const function = "cuda::detail::copy_device_to_host()";
+
+        cudaStream_t stream = tgt.native_handle().get_stream();
+        if (!use_staging(dest, bytes))
+        {
+            check_error(cudaMemcpyAsync(dest, src, bytes,
+                cudaMemcpyDeviceToHost, stream), function, "cudaMemcpyAsync");
+            return;
+        }
+
+        std::size_t chunk_size = (std::min)(staging_chunk_size(), bytes);
+        pinned_buffer buffers[2] = {
+            pinned_buffer(chunk_size), pinned_buffer(chunk_size)
+        };
+
+        char* d = static_cast<char*>(dest);
+        char const* s = static_cast<char const*>(src);
+
+        // transfer the next chunk into one buffer while the previous chunk
+        // is copied out of the other one
+        std::size_t num_chunks = (bytes + chunk_size - 1) / chunk_size;
+        for (std::size_t k = 0; k <= num_chunks; ++k)
+        {
+            if (k != num_chunks)
+            {
+                std::size_t offset = k * chunk_size;
+                std::size_t size = (std::min)(chunk_size, bytes - offset);
+                pinned_buffer& buffer = buffers[k % 2];
+
+                check_error(cudaMemcpyAsync(buffer.data(), s + offset, size,
+                    cudaMemcpyDeviceToHost, stream), function,
+                    "cudaMemcpyAsync");
+                check_error(cudaEventRecord(buffer.event(), stream),
+                    function, "cudaEventRecord");
+            }
+
+            if (k != 0)
+            {
+                std::size_t offset = (k - 1) * chunk_size;
+                std::size_t size = (std::min)(chunk_size, bytes - offset);
+                pinned_buffer& buffer = buffers[(k - 1) % 2];
+
+                wait_for_event(buffer.event(), function);
+                std::memcpy(d + offset, buffer.data(), size);
+            }
+        }
+    }
+}}}}
+
+#endif
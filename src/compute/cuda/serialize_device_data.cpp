@@ -0,0 +1,86 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_CUDA)
+
+#include <hpx/compute/cuda/pinned_buffer_pool.hpp>
+#include <hpx/compute/cuda/serialization/device_data.hpp>
+#include <hpx/compute/cuda/target.hpp>
+#include <hpx/runtime/serialization/array.hpp>
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
+
+#include <boost/predef/other/endian.h>
+
+#include <cstddef>
+
+namespace hpx { namespace compute { namespace cuda { namespace detail
+{
+    void save_device_data(serialization::output_archive& ar,
+        cuda::target const& tgt, void const* data, std::size_t bytes)
+    {
+#if BOOST_ENDIAN_BIG_BYTE
+        bool const endianess_differs = ar.endian_little();
+#else
+        bool const endianess_differs = ar.endian_big();
+#endif
+        // arrays are always serialized as chunks under these conditions
+        bool const as_chunk = ar.enable_device_memory_chunks() &&
+            !ar.disable_array_optimization() && !endianess_differs &&
+            bytes >= HPX_ZERO_COPY_SERIALIZATION_THRESHOLD;
+        ar << as_chunk;
+
+        char const* device_data = static_cast<char const*>(data);
+
+        // the size of the data is all that is needed while preprocessing
+        if (ar.is_preprocessing())
+        {
+            if (as_chunk)
+                ar << hpx::serialization::make_array(device_data, bytes);
+            else
+                save_binary(ar, device_data, bytes);
+            return;
+        }
+
+        // wait for the kernels producing the data
+        tgt.synchronize();
+
+        if (as_chunk)
+        {
+            // the parcelport reads the device memory directly
+            ar << hpx::serialization::make_array(device_data, bytes);
+            return;
+        }
+
+        pinned_buffer buffer(bytes);
+        copy_device_to_host(tgt, buffer.data(), data, bytes);
+        tgt.synchronize();
+
+        save_binary(ar, buffer.data(), bytes);
+    }
+
+    void load_device_data(serialization::input_archive& ar,
+        cuda::target const& tgt, void* data, std::size_t bytes)
+    {
+        bool as_chunk = false;
+        ar >> as_chunk;
+
+        // the received data is in host memory, copy it to the device from a
+        // pinned buffer to avoid staging it once more
+        pinned_buffer buffer(bytes);
+        char* host_data = static_cast<char*>(buffer.data());
+        if (as_chunk)
+            ar >> hpx::serialization::make_array(host_data, bytes);
+        else
+            load_binary(ar, host_data, bytes);
+
+        copy_host_to_device(tgt, data, buffer.data(), bytes);
+        tgt.synchronize();
+    }
+}}}}
+
+#endif
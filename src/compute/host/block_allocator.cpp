@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+///////////////////////////////////////////////////////////////////////////////
+
+#include <hpx/config.hpp>
+#include <hpx/compute/host/block_allocator.hpp>
+#include <hpx/compute/host/target.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+// huge pages are mapped explicitly using MAP_HUGETLB, transparent huge pages
+// are requested using madvise
+#if defined(MAP_HUGETLB) && defined(MADV_HUGEPAGE)
+#define HPX_COMPUTE_HOST_HAVE_HUGE_PAGES
+#if !defined(MAP_HUGE_SHIFT)
+#define MAP_HUGE_SHIFT 26
+#endif
+#endif
+
+namespace hpx { namespace compute { namespace host { namespace detail
+{
+#if defined(HPX_COMPUTE_HOST_HAVE_HUGE_PAGES)
+    namespace
+    {
+        std::size_t const huge_page_size_2m = std::size_t(1) << 21;
+        std::size_t const huge_page_size_1g = std::size_t(1) << 30;
+
+        std::size_t huge_page_size(huge_pages pages)
+        {
+            return pages == huge_pages::explicit_1g ?
+                huge_page_size_1g : huge_page_size_2m;
+        }
+
+        // The length of the mapping holding the given number of bytes, this
+        // is the same for explicit huge pages and their fallback.
+        std::size_t mapping_size(std::size_t bytes, huge_pages pages)
+        {
+            std::size_t page_size = huge_page_size(pages);
+            return (bytes + page_size - 1) & ~(page_size - 1);
+        }
+
+        void* map_explicit(std::size_t len, huge_pages pages)
+        {
+            int log2 = pages == huge_pages::explicit_1g ? 30 : 21;
+            void* p = mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB |
+                    (log2 << MAP_HUGE_SHIFT),
+                -1, 0);
+            return p != MAP_FAILED ? p : nullptr;
+        }
+
+        // Map len bytes aligned to the given page size and ask the kernel to
+        // back them with transparent huge pages.
+        void* map_transparent(std::size_t len, std::size_t alignment)
+        {
+            std::size_t mapped = len + alignment;
+            void* p = mmap(nullptr, mapped, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED)
+                return nullptr;
+
+            // release the parts of the mapping outside of the aligned range
+            std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(p);
+            std::uintptr_t aligned =
+                (begin + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+            if (aligned != begin)
+                munmap(p, aligned - begin);
+            if (aligned + len != begin + mapped)
+            {
+                munmap(reinterpret_cast<void*>(aligned + len),
+                    begin + mapped - aligned - len);
+            }
+
+            p = reinterpret_cast<void*>(aligned);
+            madvise(p, len, MADV_HUGEPAGE);       // ignore errors
+            return p;
+        }
+    }
+#endif
+
+    ///////////////////////////////////////////////////////////////////////////
+    void* allocate_block(std::size_t bytes, huge_pages pages,
+        memory_placement placement, std::vector<host::target> const& targets)
+    {
+        auto const& topo = hpx::threads::get_topology();
+
+        void* p = nullptr;
+        std::size_t len = bytes;
+
+#if defined(HPX_COMPUTE_HOST_HAVE_HUGE_PAGES)
+        if (pages != huge_pages::none)
+        {
+            len = mapping_size(bytes, pages);
+            if (pages != huge_pages::transparent)
+                p = map_explicit(len, pages);
+            if (p == nullptr)
+                p = map_transparent(len, huge_page_size(pages));
+            if (p == nullptr)
+                throw std::bad_alloc();
+        }
+        else
+#endif
+        {
+            p = topo.allocate(bytes);
+            if (p == nullptr)
+                throw std::bad_alloc();
+        }
+
+        // The pages have not been touched yet, binding them to the NUMA
+        // domains of all targets interleaves them when they are faulted in.
+        if (placement == memory_placement::interleave && !targets.empty())
+        {
+            hpx::threads::mask_type mask =
+                targets.front().native_handle().get_device();
+            for (host::target const& tgt : targets)
+                mask |= tgt.native_handle().get_device();
+
+            hpx::threads::hwloc_bitmap_ptr nodeset =
+                topo.cpuset_to_nodeset(mask);
+            try {
+                topo.set_area_membind_nodeset(p, len, nodeset->get_bmp(),
+                    hpx::threads::membind_interleave);
+            }
+            catch (...) {
+                deallocate_block(p, bytes, pages);
+                throw;
+            }
+        }
+
+        return p;
+    }
+
+    void deallocate_block(void* p, std::size_t bytes, huge_pages pages)
+    {
+        if (p == nullptr)
+            return;
+
+#if defined(HPX_COMPUTE_HOST_HAVE_HUGE_PAGES)
+        if (pages != huge_pages::none)
+        {
+            munmap(p, mapping_size(bytes, pages));
+            return;
+        }
+#endif
+        hpx::threads::get_topology().deallocate(p, bytes);
+    }
+}}}}
@@ -0,0 +1,47 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+///////////////////////////////////////////////////////////////////////////////
+
+#include <hpx/compute/host/replicated_vector.hpp>
+#include <hpx/compute/host/target.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
+#include <hpx/runtime/resource/detail/partitioner.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace hpx { namespace compute { namespace host { namespace detail
+{
+    std::vector<std::size_t> get_worker_thread_targets(
+        std::vector<host::target> const& targets)
+    {
+        auto const& topo = hpx::threads::get_topology();
+        auto& rp = hpx::resource::get_partitioner();
+
+        std::size_t num_os_threads = hpx::get_os_thread_count();
+        std::vector<std::size_t> result(num_os_threads, 0);
+
+        for (std::size_t num_thread = 0; num_thread != num_os_threads;
+             ++num_thread)
+        {
+            std::size_t pu_num = rp.get_pu_num(num_thread);
+            auto const& mask = topo.get_thread_affinity_mask(pu_num);
+
+            for (std::size_t i = 0; i != targets.size(); ++i)
+            {
+                if (hpx::threads::bit_and(
+                        mask, targets[i].native_handle().get_device()))
+                {
+                    result[num_thread] = i;
+                    break;
+                }
+            }
+        }
+
+        return result;
+    }
+}}}}
@@ -28,10 +28,12 @@
 #include <hpx/util/bind_action.hpp>
 #include <hpx/util/bind_front.hpp>
 #include <hpx/util/command_line_handling.hpp>
+#include <hpx/util/counter_exporter.hpp>
 #include <hpx/util/format.hpp>
 #include <hpx/util/function.hpp>
 #include <hpx/util/logging.hpp>
 #include <hpx/util/query_counters.hpp>
+#include <hpx/util/startup_timings.hpp>
 
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/classification.hpp>
@@ -281,6 +283,20 @@ namespace hpx { namespace detail
             hpx::terminate();
         }
     }
+
+    void start_exporting_counters(
+        std::shared_ptr<util::counter_exporter> const& ce)
+    {
+        try {
+            HPX_ASSERT(ce);
+            ce->start();
+        }
+        catch (...) {
+            std::cerr << hpx::diagnostic_information(std::current_exception())
+                << std::flush;
+            hpx::terminate();
+        }
+    }
 }}
 
 #if (HPX_HAVE_DYNAMIC_HPX_MAIN != 0) && \
@@ -470,6 +486,45 @@ namespace hpx
             }
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        void handle_export_options(hpx::runtime& rt,
+            boost::program_options::variables_map& vm)
+        {
+            if (vm.count("hpx:export-counter")) {
+                std::vector<std::string> counters =
+                    vm["hpx:export-counter"].as<std::vector<std::string> >();
+
+                std::string segment;
+                if (vm.count("hpx:export-counter-segment"))
+                    segment = vm["hpx:export-counter-segment"].as<std::string>();
+
+                std::size_t interval = 1000;
+                if (vm.count("hpx:export-counter-interval"))
+                    interval = vm["hpx:export-counter-interval"].as<std::size_t>();
+
+                // every locality exports its own counters, sampling starts
+                // once all counter types have been registered
+                std::shared_ptr<util::counter_exporter> ce =
+                    std::make_shared<util::counter_exporter>(
+                        counters, segment, interval);
+
+                rt.add_startup_function(
+                    util::bind_front(&start_exporting_counters, ce));
+                rt.add_pre_shutdown_function(
+                    util::bind_front(&util::counter_exporter::stop, ce));
+            }
+            else if (vm.count("hpx:export-counter-segment")) {
+                throw detail::command_line_error("Invalid command line option "
+                    "--hpx:export-counter-segment, valid in conjunction with "
+                    "--hpx:export-counter only");
+            }
+            else if (vm.count("hpx:export-counter-interval")) {
+                throw detail::command_line_error("Invalid command line option "
+                    "--hpx:export-counter-interval, valid in conjunction with "
+                    "--hpx:export-counter only");
+            }
+        }
+
         void add_startup_functions(hpx::runtime& rt,
             boost::program_options::variables_map& vm, runtime_mode mode,
             startup_function_type startup, shutdown_function_type shutdown)
@@ -493,6 +548,9 @@ namespace hpx
             if (mode == runtime_mode_console || print_counters_locally)
                 handle_list_and_print_options(rt, vm, print_counters_locally);
 
+            // Add startup function exporting counters (on all localities).
+            handle_export_options(rt, vm);
+
             // Dump the configuration before all components have been loaded.
             if (vm.count("hpx:dump-config-initial")) {
                 std::cout << "Configuration after runtime construction:\n";
@@ -638,6 +696,7 @@ namespace hpx
 
                 util::command_line_handling& cms = rp.get_command_line_switches();
                 std::unique_ptr<hpx::runtime> rt(new runtime_type(cms.rtcfg_));
+                util::startup_timings::record("runtime construction");
 
                 result = rp.parse_result();
 
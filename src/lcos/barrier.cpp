@@ -35,7 +35,7 @@ namespace hpx { namespace lcos {
                 hpx::get_num_localities(hpx::launch::sync),
                 hpx::get_locality_id())))
     {
-        if ((*node_)->num_ >= (*node_)->cut_off_ || (*node_)->rank_ == 0)
+        if ((*node_)->needs_registration())
             register_with_basename(
                 base_name, node_->get_unmanaged_id(), (*node_)->rank_).get();
     }
@@ -45,7 +45,7 @@ namespace hpx { namespace lcos {
             wrapping_type(new wrapped_type(base_name, num, hpx::get_locality_id()
         )))
     {
-        if ((*node_)->num_ >= (*node_)->cut_off_ || (*node_)->rank_ == 0)
+        if ((*node_)->needs_registration())
             register_with_basename(
                 base_name, node_->get_unmanaged_id(), (*node_)->rank_).get();
     }
@@ -54,7 +54,17 @@ namespace hpx { namespace lcos {
       : node_(new (hpx::components::component_heap<wrapping_type>().alloc())
             wrapping_type(new wrapped_type(base_name, num, rank)))
     {
-        if ((*node_)->num_ >= (*node_)->cut_off_ || (*node_)->rank_ == 0)
+        if ((*node_)->needs_registration())
+            register_with_basename(
+                base_name, node_->get_unmanaged_id(), (*node_)->rank_).get();
+    }
+
+    barrier::barrier(std::string const& base_name, std::size_t num,
+            std::size_t rank, barrier_algorithm algorithm)
+      : node_(new (hpx::components::component_heap<wrapping_type>().alloc())
+            wrapping_type(new wrapped_type(base_name, num, rank, algorithm)))
+    {
+        if ((*node_)->needs_registration())
             register_with_basename(
                 base_name, node_->get_unmanaged_id(), (*node_)->rank_).get();
     }
@@ -108,7 +118,7 @@ namespace hpx { namespace lcos {
                 }
 
                 hpx::future<void> f;
-                if ((*node_)->num_ >= (*node_)->cut_off_ || (*node_)->rank_ == 0)
+                if ((*node_)->needs_registration())
                 {
                     f = hpx::unregister_with_basename(
                         (*node_)->base_name_, (*node_)->rank_);
@@ -138,7 +148,7 @@ namespace hpx { namespace lcos {
                 hpx::threads::threadmanager_is(state_running) &&
                 !hpx::is_stopped_or_shutting_down())
             {
-                if ((*node_)->num_ >= (*node_)->cut_off_ || (*node_)->rank_ == 0)
+                if ((*node_)->needs_registration())
                     hpx::unregister_with_basename(
                         (*node_)->base_name_, (*node_)->rank_);
             }
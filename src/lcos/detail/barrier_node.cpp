@@ -3,18 +3,26 @@
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <hpx/apply.hpp>
 #include <hpx/async.hpp>
+#include <hpx/lcos/barrier.hpp>
 #include <hpx/lcos/detail/barrier_node.hpp>
 #include <hpx/lcos/future.hpp>
 #include <hpx/lcos/when_all.hpp>
 #include <hpx/runtime/components/component_type.hpp>
 #include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/throw_exception.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/unwrap.hpp>
 
 #include <boost/intrusive_ptr.hpp>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -29,8 +37,36 @@ HPX_DEFINE_GET_COMPONENT_TYPE_STATIC(
 
 HPX_REGISTER_ACTION(hpx::lcos::detail::barrier_node::gather_action,
     barrier_node_gather_action);
+HPX_REGISTER_ACTION(hpx::lcos::detail::barrier_node::signal_action,
+    barrier_node_signal_action);
 
 namespace hpx { namespace lcos { namespace detail {
+    namespace
+    {
+        barrier_algorithm get_default_barrier_algorithm()
+        {
+            std::string algorithm =
+                get_config_entry("hpx.lcos.barrier.algorithm", "tree");
+
+            if (algorithm == "tree")
+                return barrier_algorithm::tree;
+            if (algorithm == "dissemination")
+                return barrier_algorithm::dissemination;
+            if (algorithm == "hierarchical")
+                return barrier_algorithm::hierarchical;
+
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "hpx::lcos::detail::get_default_barrier_algorithm",
+                "unknown barrier algorithm: " + algorithm +
+                " (hpx.lcos.barrier.algorithm must be tree, dissemination, "
+                "or hierarchical)");
+            return barrier_algorithm::tree;
+        }
+    }
+
+    std::size_t const barrier_node::local_gather_tag;
+    std::size_t const barrier_node::local_release_tag;
+
     barrier_node::barrier_node()
       : count_(0),
         local_barrier_(0)
@@ -39,14 +75,49 @@ namespace hpx { namespace lcos { namespace detail {
     }
 
     barrier_node::barrier_node(std::string base_name, std::size_t num, std::size_t rank)
+      : barrier_node(std::move(base_name), num, rank,
+            get_default_barrier_algorithm())
+    {
+    }
+
+    barrier_node::barrier_node(std::string base_name, std::size_t num,
+            std::size_t rank, barrier_algorithm algorithm)
       : count_(0),
         base_name_(base_name),
         rank_(rank),
         num_(num),
         arity_(std::stol(get_config_entry("hpx.lcos.collectives.arity", 32))),
         cut_off_(std::stol(get_config_entry("hpx.lcos.collectives.cut_off", -1))),
-        local_barrier_(num)
+        algorithm_(algorithm),
+        local_barrier_(num),
+        episode_(0),
+        connected_(false),
+        is_leader_(true)
     {
+        // the nodes are resolved once the first operation starts, resolving
+        // them now would dead-lock as all nodes depend on each other
+        if (algorithm_ == barrier_algorithm::dissemination)
+        {
+            std::vector<std::size_t> ids;
+            for (std::size_t step = 1; step < num_; step *= 2)
+                ids.push_back((rank_ + step) % num_);
+
+            connecting_ = hpx::find_from_basename(base_name_, ids);
+            return;
+        }
+
+        if (algorithm_ == barrier_algorithm::hierarchical)
+        {
+            // all nodes are needed to find the ones located on each of the
+            // localities
+            std::vector<std::size_t> ids(num_);
+            for (std::size_t i = 0; i != num_; ++i)
+                ids[i] = i;
+
+            connecting_ = hpx::find_from_basename(base_name_, ids);
+            return;
+        }
+
         if (num_ >= cut_off_)
         {
             std::vector<std::size_t> ids;
@@ -74,6 +145,25 @@ namespace hpx { namespace lcos { namespace detail {
 
     hpx::future<void> barrier_node::wait(bool async)
     {
+        if (algorithm_ != barrier_algorithm::tree)
+        {
+            std::size_t episode = episode_++;
+            if (!connected_)
+            {
+                connected_ = true;
+
+                boost::intrusive_ptr<barrier_node> this_(this);
+                return hpx::when_all(connecting_).then(hpx::launch::sync,
+                    [this_, episode](hpx::future<
+                        std::vector<hpx::future<naming::id_type> > > f)
+                    {
+                        this_->connected(hpx::util::unwrap(f.get()));
+                        return this_->disseminate(episode);
+                    });
+            }
+            return disseminate(episode);
+        }
+
         if (num_ < cut_off_)
         {
             if (rank_ != 0)
@@ -228,4 +318,154 @@ namespace hpx { namespace lcos { namespace detail {
                 broadcast_promise_.set_value();
             });
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void barrier_node::connected(std::vector<naming::id_type> ids)
+    {
+        connecting_.clear();
+
+        if (algorithm_ == barrier_algorithm::dissemination)
+        {
+            partners_ = std::move(ids);
+            return;
+        }
+
+        HPX_ASSERT(algorithm_ == barrier_algorithm::hierarchical);
+        HPX_ASSERT(ids.size() == num_);
+
+        // the participant with the smallest rank on each of the localities
+        // communicates for all participants of its locality
+        std::vector<std::uint32_t> localities;
+        localities.reserve(num_);
+        for (naming::id_type const& id : ids)
+            localities.push_back(naming::get_locality_id_from_gid(id.get_gid()));
+
+        std::map<std::uint32_t, std::size_t> leader_of;
+        std::vector<std::size_t> leaders;
+        for (std::size_t i = 0; i != num_; ++i)
+        {
+            if (leader_of.insert(std::make_pair(localities[i], i)).second)
+                leaders.push_back(i);
+        }
+
+        std::uint32_t const here = localities[rank_];
+        std::size_t const leader = leader_of[here];
+
+        is_leader_ = (leader == rank_);
+        local_participants_.clear();
+        partners_.clear();
+
+        if (!is_leader_)
+        {
+            local_participants_.push_back(ids[leader]);
+            return;
+        }
+
+        for (std::size_t i = 0; i != num_; ++i)
+        {
+            if (i != rank_ && localities[i] == here)
+                local_participants_.push_back(ids[i]);
+        }
+
+        std::size_t const index =
+            std::find(leaders.begin(), leaders.end(), rank_) - leaders.begin();
+        for (std::size_t step = 1; step < leaders.size(); step *= 2)
+        {
+            partners_.push_back(
+                ids[leaders[(index + step) % leaders.size()]]);
+        }
+    }
+
+    hpx::future<void> barrier_node::disseminate(std::size_t episode)
+    {
+        if (!is_leader_)
+        {
+            // notify the participant communicating for this locality and
+            // wait for being released by it
+            hpx::apply(signal_action(), local_participants_[0],
+                local_gather_tag, episode);
+            return wait_for_signals(local_release_tag, episode, 1);
+        }
+
+        // wait for the other participants on this locality, synchronize
+        // with the other localities, and release the local participants
+        boost::intrusive_ptr<barrier_node> this_(this);
+        return wait_for_signals(
+                local_gather_tag, episode, local_participants_.size())
+            .then(hpx::launch::sync,
+                [this_, episode](hpx::future<void> f)
+                {
+                    // Trigger possible errors...
+                    f.get();
+                    return this_->disseminate(0, episode);
+                })
+            .then(hpx::launch::sync,
+                [this_, episode](hpx::future<void> f)
+                {
+                    // Trigger possible errors...
+                    f.get();
+                    for (naming::id_type const& id : this_->local_participants_)
+                    {
+                        hpx::apply(signal_action(), id, local_release_tag,
+                            episode);
+                    }
+                });
+    }
+
+    hpx::future<void> barrier_node::disseminate(
+        std::size_t round, std::size_t episode)
+    {
+        if (round == partners_.size())
+            return hpx::make_ready_future();
+
+        // The notifications are sent one-way, waiting for the partner to
+        // acknowledge it would add a round-trip to each of the rounds.
+        hpx::apply(signal_action(), partners_[round], round, episode);
+
+        boost::intrusive_ptr<barrier_node> this_(this);
+        return wait_for_signals(round, episode, 1).then(hpx::launch::sync,
+            [this_, round, episode](hpx::future<void> f)
+            {
+                // Trigger possible errors...
+                f.get();
+                return this_->disseminate(round + 1, episode);
+            });
+    }
+
+    hpx::future<void> barrier_node::wait_for_signals(
+        std::size_t tag, std::size_t episode, std::size_t count)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+
+        // notifications for later episodes may arrive early, those are kept
+        // until they are waited for
+        auto it = signals_.insert(std::make_pair(
+            std::make_pair(tag, episode), signal_data())).first;
+
+        if (it->second.received_ >= count)
+        {
+            signals_.erase(it);
+            return hpx::make_ready_future();
+        }
+
+        it->second.expected_ = count;
+        return it->second.promise_.get_future();
+    }
+
+    void barrier_node::signal(std::size_t tag, std::size_t episode)
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+
+        auto it = signals_.insert(std::make_pair(
+            std::make_pair(tag, episode), signal_data())).first;
+
+        if (++it->second.received_ != it->second.expected_)
+            return;
+
+        hpx::lcos::local::promise<void> p(std::move(it->second.promise_));
+        signals_.erase(it);
+
+        l.unlock();
+        p.set_value();
+    }
 }}}
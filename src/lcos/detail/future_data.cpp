@@ -20,7 +20,9 @@
 
 #include <boost/intrusive_ptr.hpp>
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <functional>
 #include <mutex>
@@ -46,6 +48,19 @@ namespace hpx { namespace lcos { namespace detail
         std::size_t& count_;
     };
 
+    // Returns whether a continuation invoked from here would be run on a new
+    // thread by handle_on_completed
+    static bool must_recurse_asynchronously()
+    {
+#if defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
+        return !this_thread::has_sufficient_stack_space();
+#else
+        return hpx::threads::get_self_ptr() == nullptr ||
+            threads::get_continuation_recursion_count() >=
+                HPX_CONTINUATION_MAX_RECURSION_DEPTH;
+#endif
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename Callback>
     static void run_on_completed_on_new_thread(Callback&& f)
@@ -99,7 +114,7 @@ namespace hpx { namespace lcos { namespace detail
         // thread was suspended, in this case we need to load it again.
         if (s == empty)
         {
-            s = state_.load(std::memory_order_relaxed);
+            s = get_state(std::memory_order_relaxed);
         }
 
         if (s == value)
@@ -204,16 +219,184 @@ namespace hpx { namespace lcos { namespace detail
         }
     }
 
-    // We need only one explicit instantiation here as the second version
-    // (single callback) is implicitly instantiated below.
+    // Both versions are used by the shared states, the single callback
+    // version is used by other fan-in operations as well.
+    using completed_callback_type =
+        future_data_refcnt_base::completed_callback_type;
     using completed_callback_vector_type =
         future_data_refcnt_base::completed_callback_vector_type;
 
+    template HPX_EXPORT
+    void future_data_base<traits::detail::future_data_void>::
+        handle_on_completed<completed_callback_type>(
+            completed_callback_type&&);
+
     template HPX_EXPORT
     void future_data_base<traits::detail::future_data_void>::
         handle_on_completed<completed_callback_vector_type>(
             completed_callback_vector_type&&);
 
+    ///////////////////////////////////////////////////////////////////////////
+    // A continuation registered through set_on_completed
+    struct future_data_base<traits::detail::future_data_void>::
+        completed_callback_node : completion_hook
+    {
+        explicit completed_callback_node(completed_callback_type&& f)
+          : f_(std::move(f))
+        {
+            on_completed_ = &completed_callback_node::on_completed;
+        }
+
+        static completed_callback_node* create(completed_callback_type&& f)
+        {
+            void* p = thread_local_pool::allocate(
+                sizeof(completed_callback_node));
+            return ::new (p) completed_callback_node(std::move(f));
+        }
+
+        static void destroy(completed_callback_node* node) noexcept
+        {
+            node->~completed_callback_node();
+            thread_local_pool::deallocate(
+                node, sizeof(completed_callback_node));
+        }
+
+        static void on_completed(completion_hook* hook, bool is_ready)
+        {
+            completed_callback_node* node =
+                static_cast<completed_callback_node*>(hook);
+
+            if (!is_ready)
+            {
+                destroy(node);
+                return;
+            }
+
+            completed_callback_type f = std::move(node->f_);
+            destroy(node);
+            handle_on_completed(std::move(f));
+        }
+
+        completed_callback_type f_;
+    };
+
+    void future_data_base<traits::detail::future_data_void>::
+        release_on_completed(std::uintptr_t s) noexcept
+    {
+        completion_hook* hook =
+            reinterpret_cast<completion_hook*>(s & callbacks_mask);
+        while (hook != nullptr)
+        {
+            completion_hook* next = hook->next_;
+            hook->on_completed_(hook, false);
+            hook = next;
+        }
+    }
+
+    bool future_data_base<traits::detail::future_data_void>::make_ready(
+        state new_state)
+    {
+        // publish the stored data and retrieve the registered continuations
+        // with a single atomic operation
+        std::uintptr_t s = state_.load(std::memory_order_relaxed);
+        do
+        {
+            if ((s & ready) != 0)
+                return false;
+        }
+        while (!state_.compare_exchange_weak(
+            s, new_state, std::memory_order_acq_rel));
+
+        if ((s & has_waiters) != 0)
+        {
+            // Note: we use notify_one repeatedly instead of notify_all as we
+            //       know: a) that most of the time we have at most one thread
+            //       waiting on the future (most futures are not shared), and
+            //       b) our implementation of condition_variable::notify_one
+            //       relinquishes the lock before resuming the waiting thread
+            //       which avoids suspension of this thread when it tries to
+            //       re-lock the mutex while exiting from
+            //       condition_variable::wait
+            std::unique_lock<mutex_type> l(mtx_);
+            while (cond_.notify_one(std::move(l), threads::thread_priority_boost))
+            {
+                l = std::unique_lock<mutex_type>(mtx_);
+            }
+
+            // Note: cv.notify_one() above 'consumes' the lock 'l' and leaves
+            //       it unlocked when returning.
+        }
+
+        // continuations were pushed onto a stack, invoke them in the order
+        // they were registered
+        completion_hook* hook =
+            reinterpret_cast<completion_hook*>(s & callbacks_mask);
+        completion_hook* reversed = nullptr;
+        while (hook != nullptr)
+        {
+            completion_hook* next = hook->next_;
+            hook->next_ = reversed;
+            reversed = hook;
+            hook = next;
+        }
+
+        if (reversed != nullptr && reversed->next_ != nullptr &&
+            must_recurse_asynchronously())
+        {
+            // Each of the continuations would be run on a new thread, run
+            // all of them on the same one instead. They don't recurse any
+            // further there.
+            void (*p)(completion_hook*) = &invoke_completion_hooks;
+
+            try
+            {
+                run_on_completed_on_new_thread(
+                    util::deferred_call(p, reversed));
+            }
+            catch(...)
+            {
+                hpx::detail::report_exception_and_terminate(
+                    std::current_exception());
+            }
+            return true;
+        }
+
+        invoke_completion_hooks(reversed);
+        return true;
+    }
+
+    // invoke the callback (continuation) functions, a hook may not be
+    // accessed anymore once it was invoked
+    void future_data_base<traits::detail::future_data_void>::
+        invoke_completion_hooks(completion_hook* hook) noexcept
+    {
+        while (hook != nullptr)
+        {
+            completion_hook* next = hook->next_;
+            hook->on_completed_(hook, true);
+            hook = next;
+        }
+    }
+
+    bool future_data_base<traits::detail::future_data_void>::
+        add_completion_hook(completion_hook* hook)
+    {
+        std::uintptr_t s = state_.load(std::memory_order_acquire);
+        do
+        {
+            if ((s & ready) != 0)
+                return false;
+
+            hook->next_ =
+                reinterpret_cast<completion_hook*>(s & callbacks_mask);
+        }
+        while (!state_.compare_exchange_weak(s,
+            reinterpret_cast<std::uintptr_t>(hook) | (s & has_waiters),
+            std::memory_order_acq_rel, std::memory_order_acquire));
+
+        return true;
+    }
+
     /// Set the callback which needs to be invoked when the future becomes
     /// ready. If the future is ready the function will be invoked
     /// immediately.
@@ -226,38 +409,54 @@ namespace hpx { namespace lcos { namespace detail
         {
             // invoke the callback (continuation) function right away
             handle_on_completed(std::move(data_sink));
+            return;
         }
-        else
+
+        completed_callback_node* node =
+            completed_callback_node::create(std::move(data_sink));
+        if (!add_completion_hook(node))
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            if (is_ready())
-            {
-                l.unlock();
+            // the future became ready in the meantime, invoke the callback
+            // (continuation) function
+            data_sink = std::move(node->f_);
+            completed_callback_node::destroy(node);
+            handle_on_completed(std::move(data_sink));
+        }
+    }
 
-                // invoke the callback (continuation) function
-                handle_on_completed(std::move(data_sink));
-            }
-            else
-            {
-                on_completed_.push_back(std::move(data_sink));
-            }
+    // Mark the state word to have threads waiting on cond_, this has to be
+    // done while holding mtx_.
+    bool future_data_base<traits::detail::future_data_void>::add_waiter()
+    {
+        std::uintptr_t s = state_.load(std::memory_order_acquire);
+        do
+        {
+            if ((s & ready) != 0)
+                return false;
         }
+        while (!state_.compare_exchange_weak(s, s | has_waiters,
+            std::memory_order_acq_rel, std::memory_order_acquire));
+
+        return true;
     }
 
     future_data_base<traits::detail::future_data_void>::state
     future_data_base<traits::detail::future_data_void>::wait(error_code& ec)
     {
         // block if this entry is empty
-        state s = state_.load(std::memory_order_acquire);
+        state s = get_state();
         if (s == empty)
         {
             std::unique_lock<mutex_type> l(mtx_);
-            s = state_.load(std::memory_order_relaxed);
-            if (s == empty)
+            if (add_waiter())
             {
                 cond_.wait(l, "future_data_base::wait", ec);
                 if (ec) return s;
             }
+            else
+            {
+                s = get_state(std::memory_order_relaxed);
+            }
         }
 
         if (&ec != &throws)
@@ -269,10 +468,10 @@ namespace hpx { namespace lcos { namespace detail
         wait_until(util::steady_clock::time_point const& abs_time, error_code& ec)
     {
         // block if this entry is empty
-        if (state_.load(std::memory_order_acquire) == empty)
+        if (!is_ready())
         {
             std::unique_lock<mutex_type> l(mtx_);
-            if (state_.load(std::memory_order_relaxed) == empty)
+            if (add_waiter())
             {
                 threads::thread_state_ex_enum const reason =
                     cond_.wait_until(l, abs_time,
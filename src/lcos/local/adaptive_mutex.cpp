@@ -0,0 +1,248 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/lcos/local/adaptive_mutex.hpp>
+
+#include <hpx/lcos/local/detail/condition_variable.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+#include <hpx/runtime/threads/thread_enums.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/itt_notify.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos { namespace local
+{
+    namespace
+    {
+        // spin at least this long before suspending [ns]
+        std::uint64_t const min_spin_time = 100;
+
+        // critical sections taking longer than this are not worth spinning
+        // for [ns]
+        std::uint64_t const max_spin_time = 20000;
+
+        // interval between two fair handoffs of a contended lock [ns]
+        std::uint64_t const fair_handoff_interval = 500000;
+
+        ///////////////////////////////////////////////////////////////////////
+        // Histogram of equally sized buckets, measurements beyond the upper
+        // boundary are added to the last bucket.
+        template <std::int64_t Max, std::size_t NumBuckets>
+        class histogram
+        {
+        public:
+            histogram()
+            {
+                for (std::atomic<std::int64_t>& b : buckets_)
+                    b.store(0, std::memory_order_relaxed);
+            }
+
+            void add(std::uint64_t value)
+            {
+                std::size_t index =
+                    std::size_t(value / (std::uint64_t(Max) / NumBuckets));
+                if (index >= NumBuckets)
+                    index = NumBuckets - 1;
+                buckets_[index].fetch_add(1, std::memory_order_relaxed);
+            }
+
+            std::vector<std::int64_t> get(bool reset)
+            {
+                std::vector<std::int64_t> result;
+                result.reserve(NumBuckets + 3);
+
+                result.push_back(0);
+                result.push_back(Max);
+                result.push_back(std::int64_t(NumBuckets));
+
+                for (std::atomic<std::int64_t>& b : buckets_)
+                {
+                    result.push_back(reset ?
+                        b.exchange(0, std::memory_order_relaxed) :
+                        b.load(std::memory_order_relaxed));
+                }
+                return result;
+            }
+
+        private:
+            std::atomic<std::int64_t> buckets_[NumBuckets];
+        };
+
+        // hold times up to 10us in buckets of 100ns, wait times up to 100us
+        // in buckets of 1us
+        histogram<10000, 100> hold_times;
+        histogram<100000, 100> wait_times;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    adaptive_mutex::adaptive_mutex(char const* const description)
+      : state_(0)
+      , avg_hold_time_(0)
+      , acquisitions_(0)
+      , lock_time_(0)
+      , next_fair_handoff_(0)
+      , handoff_(false)
+    {
+        HPX_ITT_SYNC_CREATE(this, "lcos::local::adaptive_mutex", description);
+        HPX_ITT_SYNC_RENAME(this, "lcos::local::adaptive_mutex");
+    }
+
+    adaptive_mutex::~adaptive_mutex()
+    {
+        HPX_ITT_SYNC_DESTROY(this);
+    }
+
+    void adaptive_mutex::lock_slow()
+    {
+        std::uint64_t const start = util::high_resolution_clock::now();
+
+        // spin for about as long as the lock is usually held, unless other
+        // threads are suspended already
+        std::uint64_t const avg_hold_time =
+            avg_hold_time_.load(std::memory_order_relaxed);
+        if (avg_hold_time <= max_spin_time)
+        {
+            std::uint64_t const deadline =
+                start + avg_hold_time + min_spin_time;
+
+            for (std::size_t k = 0; /**/; ++k)
+            {
+                std::uint8_t s = state_.load(std::memory_order_relaxed);
+                if (!(s & locked_bit))
+                {
+                    if (state_.compare_exchange_weak(s, s | locked_bit,
+                            std::memory_order_acquire,
+                            std::memory_order_relaxed))
+                    {
+                        wait_times.add(
+                            util::high_resolution_clock::now() - start);
+                        return;
+                    }
+                    continue;
+                }
+
+                if (s & parked_bit)
+                    break;
+
+#if defined(HPX_SMT_PAUSE)
+                HPX_SMT_PAUSE;
+#endif
+                if (k % 16 == 15 &&
+                    util::high_resolution_clock::now() >= deadline)
+                {
+                    break;
+                }
+            }
+        }
+
+        // suspend until the lock is released (or handed over)
+        bool const is_hpx_thread = threads::get_self_ptr() != nullptr;
+        for (std::size_t k = 0; /**/; ++k)
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+
+            std::uint8_t s = state_.load(std::memory_order_relaxed);
+            if (!(s & locked_bit))
+            {
+                if (state_.compare_exchange_strong(s, s | locked_bit,
+                        std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    break;
+                }
+                continue;
+            }
+
+            if (!is_hpx_thread)
+            {
+                l.unlock();
+                util::detail::yield_k(k, "adaptive_mutex::lock");
+                continue;
+            }
+
+            if (!(s & parked_bit) &&
+                !state_.compare_exchange_strong(s, s | parked_bit,
+                    std::memory_order_relaxed))
+            {
+                continue;
+            }
+
+            cond_.wait(l, "adaptive_mutex::lock");
+
+            if (handoff_)
+            {
+                // the lock was handed over by the releasing thread
+                handoff_ = false;
+                break;
+            }
+        }
+
+        wait_times.add(util::high_resolution_clock::now() - start);
+    }
+
+    void adaptive_mutex::unlock_slow()
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+
+        std::size_t const waiting = cond_.size(l);
+        if (waiting == 0)
+        {
+            state_.store(0, std::memory_order_release);
+            return;
+        }
+
+        std::uint8_t const parked = waiting > 1 ? parked_bit : 0;
+
+        // from time to time, hand over the lock to the longest waiting thread
+        // to prevent it from starving
+        std::uint64_t const now = util::high_resolution_clock::now();
+        if (now >= next_fair_handoff_)
+        {
+            next_fair_handoff_ = now + fair_handoff_interval;
+            handoff_ = true;
+            state_.store(locked_bit | parked, std::memory_order_relaxed);
+        }
+        else
+        {
+            state_.store(parked, std::memory_order_release);
+        }
+
+        cond_.notify_one(std::move(l), threads::thread_priority_boost);
+    }
+
+    void adaptive_mutex::record_hold_time(std::uint64_t hold_time)
+    {
+        hold_times.add(hold_time);
+
+        // exponential moving average, only the owner of the lock updates it,
+        // long critical sections are counted as 1ms
+        if (hold_time > 1000000)
+            hold_time = 1000000;
+
+        std::int64_t avg = avg_hold_time_.load(std::memory_order_relaxed);
+        avg += (std::int64_t(hold_time) - avg) / 8;
+        avg_hold_time_.store(std::uint32_t(avg), std::memory_order_relaxed);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<std::int64_t> adaptive_mutex::get_hold_time_histogram(
+        bool reset)
+    {
+        return hold_times.get(reset);
+    }
+
+    std::vector<std::int64_t> adaptive_mutex::get_wait_time_histogram(
+        bool reset)
+    {
+        return wait_times.get(reset);
+    }
+}}}
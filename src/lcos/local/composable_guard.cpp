@@ -5,6 +5,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/apply.hpp>
+#include <hpx/lcos/detail/thread_local_pool.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/bind_front.hpp>
 #include <hpx/util/function.hpp>
@@ -37,6 +38,17 @@ namespace hpx { namespace lcos { namespace local
               : next(nullptr), run(nothing), single_guard(true) {}
             guard_task(bool sg)
               : next(nullptr), run(nothing), single_guard(sg) {}
+
+            // tasks are short-lived, recycle their memory
+            static void* operator new(std::size_t size)
+            {
+                return lcos::detail::thread_local_pool::allocate(size);
+            }
+
+            static void operator delete(void* p, std::size_t size) noexcept
+            {
+                lcos::detail::thread_local_pool::deallocate(p, size);
+            }
         };
 
         void free(guard_task* task)
@@ -173,12 +185,15 @@ namespace hpx { namespace lcos { namespace local
     // This class exists so that a destructor is
     // used to perform cleanup. By using a destructor
     // we ensure the code works even if exceptions are
-    // thrown.
+    // thrown. Without exceptions, run_composable
+    // releases the task itself (task is reset).
     struct run_composable_cleanup
     {
         detail::guard_task* task;
         run_composable_cleanup(detail::guard_task* task_) : task(task_) {}
         ~run_composable_cleanup() {
+            if (task == nullptr)
+                return;
             detail::guard_task* zero = nullptr;
             // If single_guard is false, then this is one of the
             // setup tasks for a multi-guarded task. By not setting
@@ -197,20 +212,40 @@ namespace hpx { namespace lcos { namespace local
     using hpx::lcos::local::detail::guard_task;
     guard_task *empty = new guard_task;
 
+    // The thread which runs a task on a guard also runs
+    // all tasks queued to the guard in the meantime, one
+    // after the other (flat combining). This keeps the
+    // guarded data in the cache of one core and does not
+    // need any stack space for the queued tasks.
     static void run_composable(detail::guard_task* task)
     {
-        if(task == empty)
-            return;
-        HPX_ASSERT(task != nullptr);
-        task->check_();
-        if (task->single_guard) {
-            run_composable_cleanup rcc(task);
-            task->run();
-        } else {
-            task->run();
-            // Note that by this point in the execution
-            // the task data structure has probably
-            // been deleted.
+        for (;;) {
+            if(task == empty)
+                return;
+            HPX_ASSERT(task != nullptr);
+            task->check_();
+            if (!task->single_guard) {
+                task->run();
+                // Note that by this point in the execution
+                // the task data structure has probably
+                // been deleted.
+                return;
+            }
+
+            {
+                run_composable_cleanup rcc(task);
+                task->run();
+                rcc.task = nullptr;
+            }
+
+            // continue with the next queued task, if any
+            detail::guard_task* zero = nullptr;
+            if (task->next.compare_exchange_strong(zero, task))
+                return;
+
+            HPX_ASSERT(zero != nullptr);
+            free(task);
+            task = zero;
         }
     }
 
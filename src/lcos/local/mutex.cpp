@@ -13,6 +13,7 @@
 #include <hpx/runtime/threads/thread_enums.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/itt_notify.hpp>
+#include <hpx/util/lock_profiler.hpp>
 #include <hpx/util/register_locks.hpp>
 #include <hpx/util/steady_clock.hpp>
 
@@ -51,6 +52,14 @@ namespace hpx { namespace lcos { namespace local
             return;
         }
 
+#if defined(HPX_HAVE_LOCK_PROFILING)
+        if (HPX_UNLIKELY(util::lock_profiling::lock_profiling_enabled))
+        {
+            lock_profiled(l, HPX_LOCK_PROFILING_CALLER(), ec);
+            return;
+        }
+#endif
+
         while (owner_id_ != threads::invalid_thread_id)
         {
             cond_.wait(l, ec);
@@ -62,6 +71,39 @@ namespace hpx { namespace lcos { namespace local
         owner_id_ = self_id;
     }
 
+#if defined(HPX_HAVE_LOCK_PROFILING)
+    void mutex::lock_profiled(std::unique_lock<mutex_type>& l,
+        void const* site, error_code& ec)
+    {
+        if (owner_id_ == threads::invalid_thread_id)
+        {
+            util::lock_profiling::acquired(this,
+                util::lock_profiling::kind_mutex, site);
+        }
+        else
+        {
+            std::uint64_t token = util::lock_profiling::wait_begin(this);
+            while (owner_id_ != threads::invalid_thread_id)
+            {
+                cond_.wait(l, ec);
+                if (ec)
+                {
+                    util::lock_profiling::wait_end(this,
+                        util::lock_profiling::kind_untracked, token, site);
+                    HPX_ITT_SYNC_CANCEL(this);
+                    return;
+                }
+            }
+            util::lock_profiling::wait_end(this,
+                util::lock_profiling::kind_mutex, token, site);
+        }
+
+        util::register_lock(this);
+        HPX_ITT_SYNC_ACQUIRED(this);
+        owner_id_ = threads::get_self_id();
+    }
+#endif
+
     bool mutex::try_lock(char const* description, error_code& ec)
     {
         HPX_ASSERT(threads::get_self_ptr() != nullptr);
@@ -76,6 +118,13 @@ namespace hpx { namespace lcos { namespace local
         }
 
         threads::thread_id_type self_id = threads::get_self_id();
+#if defined(HPX_HAVE_LOCK_PROFILING)
+        if (HPX_UNLIKELY(util::lock_profiling::lock_profiling_enabled))
+        {
+            util::lock_profiling::acquired(this,
+                util::lock_profiling::kind_mutex, HPX_LOCK_PROFILING_CALLER());
+        }
+#endif
         util::register_lock(this);
         HPX_ITT_SYNC_ACQUIRED(this);
         owner_id_ = self_id;
@@ -99,6 +148,10 @@ namespace hpx { namespace lcos { namespace local
             return;
         }
 
+#if defined(HPX_HAVE_LOCK_PROFILING)
+        if (HPX_UNLIKELY(util::lock_profiling::lock_profiling_enabled))
+            util::lock_profiling::released(this);
+#endif
         util::unregister_lock(this);
         HPX_ITT_SYNC_RELEASED(this);
         owner_id_ = threads::invalid_thread_id;
@@ -123,10 +176,31 @@ namespace hpx { namespace lcos { namespace local
         std::unique_lock<mutex_type> l(mtx_);
 
         threads::thread_id_type self_id = threads::get_self_id();
+#if defined(HPX_HAVE_LOCK_PROFILING)
+        bool const profiled = util::lock_profiling::lock_profiling_enabled;
+        void const* site = HPX_LOCK_PROFILING_CALLER();
+#endif
         if (owner_id_ != threads::invalid_thread_id)
         {
+#if defined(HPX_HAVE_LOCK_PROFILING)
+            std::uint64_t token = profiled ?
+                util::lock_profiling::wait_begin(this) : 0;
+#endif
             threads::thread_state_ex_enum const reason =
                 cond_.wait_until(l, abs_time, ec);
+
+#if defined(HPX_HAVE_LOCK_PROFILING)
+            if (profiled)
+            {
+                // only successful acquisitions are recorded
+                bool const acquired = !ec && reason != threads::wait_timeout &&
+                    owner_id_ == threads::invalid_thread_id;
+                util::lock_profiling::wait_end(this, acquired ?
+                        util::lock_profiling::kind_mutex :
+                        util::lock_profiling::kind_untracked,
+                    token, site);
+            }
+#endif
             if (ec) { HPX_ITT_SYNC_CANCEL(this); return false; }
 
             if (reason == threads::wait_timeout) //-V110
@@ -141,6 +215,13 @@ namespace hpx { namespace lcos { namespace local
                 return false;
             }
         }
+#if defined(HPX_HAVE_LOCK_PROFILING)
+        else if (profiled)
+        {
+            util::lock_profiling::acquired(this,
+                util::lock_profiling::kind_mutex, site);
+        }
+#endif
 
         util::register_lock(this);
         HPX_ITT_SYNC_ACQUIRED(this);
@@ -4,13 +4,20 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <hpx/config.hpp>
+#include <hpx/async.hpp>
 #include <hpx/error_code.hpp>
 #include <hpx/lcos/future.hpp>
 #include <hpx/performance_counters/counters.hpp>
 #include <hpx/performance_counters/performance_counter_set.hpp>
+#include <hpx/performance_counters/server/base_performance_counter.hpp>
 #include <hpx/performance_counters/stubs/performance_counter.hpp>
+#include <hpx/runtime/actions/plain_action.hpp>
 #include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/get_ptr.hpp>
 #include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
 #include <hpx/runtime_fwd.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/bind.hpp>
@@ -19,12 +26,59 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace performance_counters { namespace detail
+{
+    // Evaluate all given counters of this locality, the counters are called
+    // directly instead of sending one action per counter. The performance
+    // counter set keeps the counters alive, so the ids are sent without
+    // credits.
+    std::vector<counter_value> get_local_counter_values(
+        std::vector<naming::gid_type> const& gids,
+        std::vector<std::uint8_t> const& reset)
+    {
+        HPX_ASSERT(gids.size() == reset.size());
+
+        std::vector<counter_value> values;
+        values.reserve(gids.size());
+
+        for (std::size_t i = 0; i != gids.size(); ++i)
+        {
+            naming::id_type id(gids[i], naming::id_type::unmanaged);
+
+            // the counter might not live on this locality
+            error_code ec(lightweight);
+            std::shared_ptr<server::base_performance_counter> p =
+                hpx::get_ptr<server::base_performance_counter>(
+                    launch::sync, id, ec);
+
+            if (ec || !p)
+            {
+                using performance_counters::stubs::performance_counter;
+                values.push_back(performance_counter::get_value(
+                    launch::sync, id, reset[i] != 0));
+                continue;
+            }
+
+            performance_counter_base* base = p.get();
+            values.push_back(base->get_counter_value(reset[i] != 0));
+        }
+
+        return values;
+    }
+}}}
+
+HPX_PLAIN_ACTION(hpx::performance_counters::detail::get_local_counter_values,
+    performance_counters_get_local_counter_values_action);
+
 namespace hpx { namespace performance_counters
 {
     performance_counter_set::performance_counter_set(std::string const& name,
@@ -290,28 +344,61 @@ namespace hpx { namespace performance_counters
         performance_counter_set::get_counter_values(bool reset) const
     {
         std::vector<hpx::id_type> ids;
+        std::vector<counter_info> infos;
+        std::vector<std::uint8_t> resets;
 
         {
             std::unique_lock<mutex_type> l(mtx_);
             ids = ids_;
+            infos = infos_;
+            resets = reset_;
             ++invocation_count_;
         }
 
-        std::vector<hpx::future<counter_value> > v;
-        v.reserve(ids.size());
+        // group the counters by the locality they live on, all counters of
+        // one locality are evaluated by a single action
+        struct batch
+        {
+            std::vector<naming::gid_type> gids_;
+            std::vector<std::uint8_t> reset_;
+            std::vector<std::size_t> positions_;
+        };
+        std::map<std::uint32_t, batch> batches;
 
-        // reset all performance counters
+        std::size_t count = 0;
         for (std::size_t i = 0; i != ids.size(); ++i)
         {
-            if (infos_[i].type_ == counter_histogram ||
-                infos_[i].type_ == counter_raw_values)
+            if (infos[i].type_ == counter_histogram ||
+                infos[i].type_ == counter_raw_values)
             {
                 continue;
             }
 
-            using performance_counters::stubs::performance_counter;
-            v.push_back(performance_counter::get_value(
-                launch::async, ids[i], reset || reset_[i]));
+            batch& b = batches[naming::get_locality_id_from_id(ids[i])];
+            b.gids_.push_back(
+                naming::detail::get_stripped_gid(ids[i].get_gid()));
+            b.reset_.push_back((reset || resets[i]) ? 1 : 0);
+            b.positions_.push_back(count++);
+        }
+
+        std::vector<hpx::future<counter_value> > v(count);
+
+        for (auto& b : batches)
+        {
+            hpx::shared_future<std::vector<counter_value> > values =
+                hpx::async(performance_counters_get_local_counter_values_action(),
+                    naming::get_id_from_locality_id(b.first),
+                    std::move(b.second.gids_), std::move(b.second.reset_));
+
+            for (std::size_t j = 0; j != b.second.positions_.size(); ++j)
+            {
+                v[b.second.positions_[j]] = values.then(launch::sync,
+                    [j](hpx::shared_future<std::vector<counter_value> > f)
+                    -> counter_value
+                    {
+                        return f.get()[j];
+                    });
+            }
         }
 
         return v;
@@ -0,0 +1,143 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+#include <hpx/performance_counters/counters.hpp>
+#include <hpx/performance_counters/counter_creators.hpp>
+#include <hpx/runtime/actions/detail/action_latency_registry.hpp>
+#include <hpx/runtime/actions/detail/invocation_count_registry.hpp>
+#include <hpx/util/bind_front.hpp>
+#include <hpx/util/function.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace performance_counters
+{
+    namespace detail
+    {
+        // The counter parameters are the action type, optionally followed by
+        // the percentile to report. Split off the percentile, return -1 if
+        // none is given.
+        double split_latency_percentile(std::string& parameters)
+        {
+            std::string::size_type p = parameters.find_last_of(',');
+            if (p == std::string::npos)
+                return -1.0;
+
+            double percentile =
+                util::safe_lexical_cast(parameters.substr(p + 1), -1.0);
+            if (percentile >= 0.0)
+                parameters.erase(p);
+            return percentile;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Discoverer function for action latency counters
+    bool action_latency_counter_discoverer(counter_info const& info,
+        discover_counter_func const& f, discover_counters_mode mode,
+        error_code& ec)
+    {
+        // compose the counter name templates
+        performance_counters::counter_path_elements p;
+        performance_counters::counter_status status =
+            get_counter_path_elements(info.fullname_, p, ec);
+        if (!status_is_valid(status)) return false;
+
+        // the known action types are the same as for the invocation counters,
+        // the percentile is appended to each of the discovered counters
+        std::string suffix;
+        if (detail::split_latency_percentile(p.parameters_) >= 0.0)
+            suffix = info.fullname_.substr(info.fullname_.find_last_of(','));
+
+        discover_counter_func append_suffix =
+            [&f, &suffix](counter_info const& cinfo, error_code& ec) -> bool
+            {
+                counter_info i = cinfo;
+                if (!suffix.empty() &&
+                    i.fullname_.find('@') != std::string::npos)
+                {
+                    i.fullname_ += suffix;
+                }
+                return f(i, ec);
+            };
+
+        using hpx::actions::detail::invocation_count_registry;
+        bool result = invocation_count_registry::local_instance()
+            .counter_discoverer(info, p, append_suffix, mode, ec);
+        if (!result || ec) return false;
+
+        if (&ec != &throws)
+            ec = make_success_code();
+
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Creation function for action latency counters
+    naming::gid_type action_latency_counter_creator(counter_info const& info,
+        hpx::actions::detail::action_latency_type type, error_code& ec)
+    {
+        switch (info.type_) {
+        case counter_raw:
+            {
+                counter_path_elements paths;
+                get_counter_path_elements(info.fullname_, paths, ec);
+                if (ec) return naming::invalid_gid;
+
+                if (paths.parentinstance_is_basename_) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "action_latency_counter_creator",
+                        "invalid action latency counter name (instance name "
+                        "must not be a valid base counter name)");
+                    return naming::invalid_gid;
+                }
+
+                double percentile =
+                    detail::split_latency_percentile(paths.parameters_);
+                if (percentile < 0.0)
+                    percentile = 50.0;
+
+                if (paths.parameters_.empty() || percentile > 100.0) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "action_latency_counter_creator",
+                        "invalid action latency counter parameter: must "
+                        "specify an action type, optionally followed by a "
+                        "percentile in between 0 and 100");
+                    return naming::invalid_gid;
+                }
+
+                // make sure the action type is known
+                using hpx::actions::detail::invocation_count_registry;
+                invocation_count_registry::local_instance()
+                    .get_invocation_counter(paths.parameters_);
+
+                // collect latencies from now on
+                hpx::actions::detail::maintain_action_latencies = true;
+
+                hpx::util::function_nonser<std::int64_t(bool)> f =
+                    util::bind_front(&hpx::actions::detail::get_action_latency,
+                        type, paths.parameters_, percentile);
+
+                return detail::create_raw_counter(info, std::move(f), ec);
+            }
+            break;
+
+        default:
+            HPX_THROWS_IF(ec, bad_parameter,
+                "action_latency_counter_creator",
+                "invalid counter type requested");
+            return naming::invalid_gid;
+        }
+    }
+}}
+
+#endif
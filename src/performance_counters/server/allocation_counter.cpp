@@ -0,0 +1,252 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_ALLOCATION_ACCOUNTING)
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/performance_counters/counters.hpp>
+#include <hpx/performance_counters/counter_creators.hpp>
+#include <hpx/util/allocation_accounting.hpp>
+#include <hpx/util/bind_front.hpp>
+#include <hpx/util/function.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/regex_from_pattern.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <string>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace performance_counters
+{
+    namespace detail
+    {
+        // Extract the subsystem the counter refers to from its parameters
+        bool get_allocation_subsystem(counter_info const& info,
+            util::allocation_accounting::subsystem& s, error_code& ec)
+        {
+            counter_path_elements paths;
+            get_counter_path_elements(info.fullname_, paths, ec);
+            if (ec) return false;
+
+            if (paths.parentinstance_is_basename_) {
+                HPX_THROWS_IF(ec, bad_parameter,
+                    "allocation_counter_creator",
+                    "invalid allocation counter name (instance name must "
+                    "not be a valid base counter name)");
+                return false;
+            }
+
+            s = util::allocation_accounting::get_subsystem(paths.parameters_);
+            if (s == util::allocation_accounting::subsystem_last) {
+                HPX_THROWS_IF(ec, bad_parameter,
+                    "allocation_counter_creator",
+                    "invalid allocation counter name (the counter parameter "
+                    "must name a subsystem, e.g. @shared-states): " +
+                        info.fullname_);
+                return false;
+            }
+            return true;
+        }
+
+        // The number of allocations since the counter was reset
+        struct allocation_count
+        {
+            explicit allocation_count(util::allocation_accounting::subsystem s)
+              : subsystem_(s), base_(0)
+            {}
+
+            std::int64_t operator()(bool reset)
+            {
+                std::int64_t const count =
+                    util::allocation_accounting::get_statistic(
+                        util::allocation_accounting::stat_allocations,
+                        subsystem_, false);
+
+                std::lock_guard<lcos::local::spinlock> l(mtx_);
+                std::int64_t const result = count - base_;
+                if (reset)
+                    base_ = count;
+                return result;
+            }
+
+            util::allocation_accounting::subsystem subsystem_;
+            lcos::local::spinlock mtx_;
+            std::int64_t base_;
+        };
+
+        // The number of allocations per second since the previous evaluation
+        struct allocation_rate
+        {
+            explicit allocation_rate(util::allocation_accounting::subsystem s)
+              : subsystem_(s)
+              , count_(util::allocation_accounting::get_statistic(
+                    util::allocation_accounting::stat_allocations, s, false))
+              , time_(util::high_resolution_clock::now())
+            {}
+
+            std::int64_t operator()(bool)
+            {
+                std::int64_t const count =
+                    util::allocation_accounting::get_statistic(
+                        util::allocation_accounting::stat_allocations,
+                        subsystem_, false);
+                std::uint64_t const now = util::high_resolution_clock::now();
+
+                std::lock_guard<lcos::local::spinlock> l(mtx_);
+                std::int64_t result = 0;
+                if (now > time_)
+                {
+                    result = std::int64_t(double(count - count_) * 1e9 /
+                        double(now - time_));
+                }
+                count_ = count;
+                time_ = now;
+                return result;
+            }
+
+            util::allocation_accounting::subsystem subsystem_;
+            lcos::local::spinlock mtx_;
+            std::int64_t count_;
+            std::uint64_t time_;
+        };
+
+        template <typename F>
+        std::int64_t invoke_shared(std::shared_ptr<F> const& f, bool reset)
+        {
+            return (*f)(reset);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Discoverer function for the allocation accounting counters, the
+    // parameters are matched against the names of the subsystems.
+    bool allocation_counter_discoverer(counter_info const& info,
+        discover_counter_func const& f, discover_counters_mode mode,
+        error_code& ec)
+    {
+        counter_path_elements p;
+        counter_status status = get_counter_path_elements(info.fullname_, p, ec);
+        if (!status_is_valid(status)) return false;
+
+        if (mode == discover_counters_minimal ||
+            p.parentinstancename_.empty() || p.instancename_.empty())
+        {
+            if (p.parentinstancename_.empty())
+            {
+                p.parentinstancename_ = "locality#*";
+                p.parentinstanceindex_ = -1;
+            }
+
+            if (p.instancename_.empty())
+            {
+                p.instancename_ = "total";
+                p.instanceindex_ = -1;
+            }
+        }
+
+        std::string str_rx(util::regex_from_pattern(
+            p.parameters_.empty() ? std::string("*") : p.parameters_, ec));
+        if (ec) return false;
+
+        std::regex rx(str_rx);
+        for (int i = 0; i != util::allocation_accounting::subsystem_last; ++i)
+        {
+            std::string const name = util::allocation_accounting::
+                get_subsystem_name(
+                    static_cast<util::allocation_accounting::subsystem>(i));
+            if (!std::regex_match(name, rx))
+                continue;
+
+            std::string fullname;
+            counter_path_elements cp = p;
+            cp.parameters_ = name;
+
+            get_counter_name(cp, fullname, ec);
+            if (ec) return false;
+
+            counter_info cinfo = info;
+            cinfo.fullname_ = fullname;
+            if (!f(cinfo, ec) || ec)
+                return false;
+        }
+
+        if (&ec != &throws)
+            ec = make_success_code();
+
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Creation function for the allocation accounting counters
+    naming::gid_type allocation_counter_creator(counter_info const& info,
+        util::allocation_accounting::statistic stat, error_code& ec)
+    {
+        switch (info.type_) {
+        case counter_raw:
+            {
+                util::allocation_accounting::subsystem s;
+                if (!detail::get_allocation_subsystem(info, s, ec))
+                    return naming::invalid_gid;
+
+                hpx::util::function_nonser<std::int64_t(bool)> f;
+                if (stat == util::allocation_accounting::stat_allocations)
+                {
+                    f = util::bind_front(
+                        &detail::invoke_shared<detail::allocation_count>,
+                        std::make_shared<detail::allocation_count>(s));
+                }
+                else
+                {
+                    f = util::bind_front(
+                        &util::allocation_accounting::get_statistic, stat, s);
+                }
+
+                return detail::create_raw_counter(info, std::move(f), ec);
+            }
+            break;
+
+        default:
+            HPX_THROWS_IF(ec, bad_parameter,
+                "allocation_counter_creator",
+                "invalid counter type requested");
+            return naming::invalid_gid;
+        }
+    }
+
+    naming::gid_type allocation_rate_counter_creator(counter_info const& info,
+        error_code& ec)
+    {
+        switch (info.type_) {
+        case counter_raw:
+            {
+                util::allocation_accounting::subsystem s;
+                if (!detail::get_allocation_subsystem(info, s, ec))
+                    return naming::invalid_gid;
+
+                hpx::util::function_nonser<std::int64_t(bool)> f =
+                    util::bind_front(
+                        &detail::invoke_shared<detail::allocation_rate>,
+                        std::make_shared<detail::allocation_rate>(s));
+
+                return detail::create_raw_counter(info, std::move(f), ec);
+            }
+            break;
+
+        default:
+            HPX_THROWS_IF(ec, bad_parameter,
+                "allocation_rate_counter_creator",
+                "invalid counter type requested");
+            return naming::invalid_gid;
+        }
+    }
+}}
+
+#endif
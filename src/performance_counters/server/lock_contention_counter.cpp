@@ -0,0 +1,130 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_LOCK_PROFILING)
+#include <hpx/performance_counters/counters.hpp>
+#include <hpx/performance_counters/counter_creators.hpp>
+#include <hpx/util/bind_front.hpp>
+#include <hpx/util/function.hpp>
+#include <hpx/util/lock_profiler.hpp>
+#include <hpx/util/regex_from_pattern.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <regex>
+#include <string>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace performance_counters
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Discoverer function for the lock contention counters, the parameters
+    // are matched against the names of the call sites recorded so far. A
+    // counter without parameters refers to all call sites.
+    bool lock_contention_counter_discoverer(counter_info const& info,
+        discover_counter_func const& f, discover_counters_mode mode,
+        error_code& ec)
+    {
+        counter_path_elements p;
+        counter_status status = get_counter_path_elements(info.fullname_, p, ec);
+        if (!status_is_valid(status)) return false;
+
+        if (mode == discover_counters_minimal ||
+            p.parentinstancename_.empty() || p.instancename_.empty())
+        {
+            if (p.parentinstancename_.empty())
+            {
+                p.parentinstancename_ = "locality#*";
+                p.parentinstanceindex_ = -1;
+            }
+
+            if (p.instancename_.empty())
+            {
+                p.instancename_ = "total";
+                p.instanceindex_ = -1;
+            }
+        }
+
+        if (p.parameters_.empty() ||
+            p.parameters_.find_first_of("*?[]") == std::string::npos)
+        {
+            std::string fullname;
+            get_counter_name(p, fullname, ec);
+            if (ec) return false;
+
+            counter_info cinfo = info;
+            cinfo.fullname_ = fullname;
+            return f(cinfo, ec) && !ec;
+        }
+
+        std::string str_rx(util::regex_from_pattern(p.parameters_, ec));
+        if (ec) return false;
+
+        std::regex rx(str_rx);
+        for (std::string const& name : util::lock_profiling::get_site_names())
+        {
+            if (!std::regex_match(name, rx))
+                continue;
+
+            std::string fullname;
+            counter_path_elements cp = p;
+            cp.parameters_ = name;
+
+            get_counter_name(cp, fullname, ec);
+            if (ec) return false;
+
+            counter_info cinfo = info;
+            cinfo.fullname_ = fullname;
+            if (!f(cinfo, ec) || ec)
+                return false;
+        }
+
+        if (&ec != &throws)
+            ec = make_success_code();
+
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Creation function for the lock contention counters
+    naming::gid_type lock_contention_counter_creator(counter_info const& info,
+        util::lock_profiling::statistic stat, error_code& ec)
+    {
+        switch (info.type_) {
+        case counter_raw:
+            {
+                counter_path_elements paths;
+                get_counter_path_elements(info.fullname_, paths, ec);
+                if (ec) return naming::invalid_gid;
+
+                if (paths.parentinstance_is_basename_) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "lock_contention_counter_creator",
+                        "invalid lock contention counter name (instance "
+                        "name must not be a valid base counter name)");
+                    return naming::invalid_gid;
+                }
+
+                hpx::util::function_nonser<std::int64_t(bool)> f =
+                    util::bind_front(&util::lock_profiling::get_statistic,
+                        stat, paths.parameters_);
+
+                return detail::create_raw_counter(info, std::move(f), ec);
+            }
+            break;
+
+        default:
+            HPX_THROWS_IF(ec, bad_parameter,
+                "lock_contention_counter_creator",
+                "invalid counter type requested");
+            return naming::invalid_gid;
+        }
+    }
+}}
+
+#endif
@@ -21,9 +21,11 @@
 #include <hpx/runtime/naming/resolver_client.hpp>
 #include <hpx/runtime/shutdown_function.hpp>
 #include <hpx/runtime/startup_function.hpp>
+#include <hpx/runtime/threads/elastic_controller.hpp>
 #include <hpx/runtime/threads/threadmanager.hpp>
 #include <hpx/util/logging.hpp>
 #include <hpx/util/runtime_configuration.hpp>
+#include <hpx/util/startup_timings.hpp>
 #include <hpx/util/tuple.hpp>
 
 #include <cstddef>
@@ -90,6 +92,9 @@ int pre_main(runtime_mode mode)
     register_pre_shutdown_function(&::garbage_collect_non_blocking);
     register_shutdown_function(&::garbage_collect);
 
+    // Resize the thread pools listed in hpx.elasticity.pools to their load
+    threads::detail::register_elastic_controller();
+
     using components::stubs::runtime_support;
 
     naming::resolver_client& agas_client = naming::get_agas_client();
@@ -106,6 +111,7 @@ int pre_main(runtime_mode mode)
         exit_code = runtime_support::load_components(find_here());
         lbt_ << "(2nd stage) pre_main: loaded components"
             << (exit_code ? ", application exit has been requested" : "");
+        util::startup_timings::record("component loading");
 
         // Work on registration requests for message handler plugins
         register_message_handlers();
@@ -113,14 +119,17 @@ int pre_main(runtime_mode mode)
         // Register all counter types before the startup functions are being
         // executed.
         register_counter_types();
+        util::startup_timings::record("counter registration");
 
         rt.set_state(state_pre_startup);
         runtime_support::call_startup_functions(find_here(), true);
         lbt_ << "(3rd stage) pre_main: ran pre-startup functions";
+        util::startup_timings::record("pre-startup functions");
 
         rt.set_state(state_startup);
         runtime_support::call_startup_functions(find_here(), false);
         lbt_ << "(4th stage) pre_main: ran startup functions";
+        util::startup_timings::record("startup functions");
     }
     else
     {
@@ -130,6 +139,7 @@ int pre_main(runtime_mode mode)
         exit_code = runtime_support::load_components(find_here());
         lbt_ << "(2nd stage) pre_main: loaded components"
             << (exit_code ? ", application exit has been requested" : "");
+        util::startup_timings::record("component loading");
 
         // {{{ Second and third stage barrier creation.
         if (agas_client.is_bootstrap())
@@ -166,6 +176,7 @@ int pre_main(runtime_mode mode)
         // Register all counter types before the startup functions are being
         // executed.
         register_counter_types();
+        util::startup_timings::record("counter registration");
 
         // Second stage bootstrap synchronizes performance counter loading
         // across all localities.
@@ -174,6 +185,7 @@ int pre_main(runtime_mode mode)
 
         runtime_support::call_startup_functions(find_here(), true);
         lbt_ << "(3rd stage) pre_main: ran pre-startup functions";
+        util::startup_timings::record("pre-startup functions");
 
         // Third stage separates pre-startup and startup function phase.
         lcos::barrier::synchronize();
@@ -181,6 +193,7 @@ int pre_main(runtime_mode mode)
 
         runtime_support::call_startup_functions(find_here(), false);
         lbt_ << "(4th stage) pre_main: ran startup functions";
+        util::startup_timings::record("startup functions");
 
         // Forth stage bootstrap synchronizes startup functions across all
         // localities. This is done after component loading to guarantee that
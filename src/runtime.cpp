@@ -28,12 +28,14 @@
 #include <hpx/state.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/backtrace.hpp>
+#include <hpx/util/bind.hpp>
 #include <hpx/util/command_line_handling.hpp>
 #include <hpx/util/debugging.hpp>
 #include <hpx/util/high_resolution_clock.hpp>
 #include <hpx/util/logging.hpp>
 #include <hpx/util/query_counters.hpp>
 #include <hpx/util/static_reinit.hpp>
+#include <hpx/util/task_hardware_counters.hpp>
 #include <hpx/util/thread_mapper.hpp>
 #include <hpx/version.hpp>
 
@@ -567,6 +569,254 @@ namespace hpx
             statistic_counter_types,
             sizeof(statistic_counter_types)/sizeof(statistic_counter_types[0]));
 
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+        using util::placeholders::_1;
+        using util::placeholders::_2;
+
+        performance_counters::generic_counter_type_data latency_counter_types[] =
+        {
+            // action latency counters
+            { "/runtime/latency/action-round-trip",
+              performance_counters::counter_raw,
+              "returns the given percentile of the times it took for the "
+              "results of a specific action to become available, measured "
+              "from sending the request (the action type and optionally the "
+              "percentile have to be specified as the counter parameters: "
+              "@<action_type>,<percentile>, the percentile defaults to 50)",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::action_latency_counter_creator,
+                  _1, actions::detail::round_trip_latency, _2),
+              &performance_counters::action_latency_counter_discoverer,
+              "ns"
+            },
+            { "/runtime/latency/action-serialization",
+              performance_counters::counter_raw,
+              "returns the given percentile of the times it took to serialize "
+              "the parcels of a specific action (the action type and "
+              "optionally the percentile have to be specified as the counter "
+              "parameters: @<action_type>,<percentile>, the percentile "
+              "defaults to 50)",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::action_latency_counter_creator,
+                  _1, actions::detail::serialization_latency, _2),
+              &performance_counters::action_latency_counter_discoverer,
+              "ns"
+            },
+            { "/runtime/latency/action-queue",
+              performance_counters::counter_raw,
+              "returns the given percentile of the times the threads running "
+              "a specific action spent waiting to be scheduled (the action "
+              "type and optionally the percentile have to be specified as the "
+              "counter parameters: @<action_type>,<percentile>, the "
+              "percentile defaults to 50)",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::action_latency_counter_creator,
+                  _1, actions::detail::queue_latency, _2),
+              &performance_counters::action_latency_counter_discoverer,
+              "ns"
+            },
+            { "/runtime/latency/action-future-wait",
+              performance_counters::counter_raw,
+              "returns the given percentile of the times threads were blocked "
+              "waiting for the result of a specific action (the action type "
+              "and optionally the percentile have to be specified as the "
+              "counter parameters: @<action_type>,<percentile>, the "
+              "percentile defaults to 50)",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::action_latency_counter_creator,
+                  _1, actions::detail::future_wait_latency, _2),
+              &performance_counters::action_latency_counter_discoverer,
+              "ns"
+            }
+        };
+        performance_counters::install_counter_types(
+            latency_counter_types,
+            sizeof(latency_counter_types)/sizeof(latency_counter_types[0]));
+#endif
+
+#if defined(HPX_HAVE_TASK_HARDWARE_COUNTERS)
+        // one counter type for each of the measured hardware events
+        std::vector<std::string> events = util::task_counters::get_events();
+        if (!events.empty())
+        {
+            std::vector<performance_counters::generic_counter_type_data>
+                task_event_counter_types;
+
+            for (std::size_t i = 0; i <= events.size(); ++i)
+            {
+                std::size_t event = i;
+                std::string name = "count";
+                std::string helptext =
+                    "returns the number of times HPX threads with the given "
+                    "description were run";
+
+                if (i != events.size())
+                {
+                    name = events[i];
+                    helptext = "returns the number of '" + events[i] +
+                        "' hardware events caused by HPX threads with the "
+                        "given description";
+                }
+                else
+                {
+                    event = util::task_counters::max_events;
+                }
+
+                performance_counters::generic_counter_type_data data = {
+                    "/threads/task-events/" + name,
+                    performance_counters::counter_raw,
+                    helptext + " (the action type or the annotation of the "
+                        "threads has to be specified as the counter "
+                        "parameter)",
+                    HPX_PERFORMANCE_COUNTER_V1,
+                    [event](performance_counters::counter_info const& info,
+                        error_code& ec)
+                    {
+                        return performance_counters::task_event_counter_creator(
+                            info, event, ec);
+                    },
+                    &performance_counters::task_event_counter_discoverer,
+                    ""
+                };
+                task_event_counter_types.push_back(std::move(data));
+            }
+
+            performance_counters::install_counter_types(
+                task_event_counter_types.data(),
+                task_event_counter_types.size());
+        }
+#endif
+
+#if defined(HPX_HAVE_LOCK_PROFILING)
+        // the statistics recorded by the lock profiler
+        struct lock_counter_type
+        {
+            char const* name;
+            util::lock_profiling::statistic stat;
+            char const* helptext;
+            char const* unit;
+        };
+
+        lock_counter_type const lock_counters[] =
+        {
+            { "/locks/count/acquisitions",
+              util::lock_profiling::stat_acquisitions,
+              "returns the estimated number of lock acquisitions", "" },
+            { "/locks/count/contentions",
+              util::lock_profiling::stat_contentions,
+              "returns the estimated number of lock acquisitions which had to "
+              "wait for the lock", "" },
+            { "/locks/time/wait",
+              util::lock_profiling::stat_wait_time,
+              "returns the estimated total time spent waiting for locks",
+              "ns" },
+            { "/locks/time/hold",
+              util::lock_profiling::stat_hold_time,
+              "returns the estimated total time locks were held", "ns" },
+            { "/locks/contenders/max",
+              util::lock_profiling::stat_max_contenders,
+              "returns the maximum number of threads seen waiting for a lock",
+              "" }
+        };
+
+        std::vector<performance_counters::generic_counter_type_data>
+            lock_counter_types;
+        for (lock_counter_type const& c : lock_counters)
+        {
+            util::lock_profiling::statistic stat = c.stat;
+            performance_counters::generic_counter_type_data data = {
+                c.name,
+                performance_counters::counter_raw,
+                std::string(c.helptext) + " (the call site can be specified "
+                    "as the counter parameter, all call sites are accounted "
+                    "for otherwise)",
+                HPX_PERFORMANCE_COUNTER_V1,
+                [stat](performance_counters::counter_info const& info,
+                    error_code& ec)
+                {
+                    return performance_counters::
+                        lock_contention_counter_creator(info, stat, ec);
+                },
+                &performance_counters::lock_contention_counter_discoverer,
+                c.unit
+            };
+            lock_counter_types.push_back(std::move(data));
+        }
+
+        performance_counters::install_counter_types(
+            lock_counter_types.data(), lock_counter_types.size());
+#endif
+
+#if defined(HPX_HAVE_ALLOCATION_ACCOUNTING)
+        // the memory allocated by the subsystems of the runtime
+        struct allocation_counter_type
+        {
+            char const* name;
+            util::allocation_accounting::statistic stat;
+            char const* helptext;
+            char const* unit;
+        };
+
+        allocation_counter_type const allocation_counters[] =
+        {
+            { "/runtime/allocations/bytes-live",
+              util::allocation_accounting::stat_bytes_live,
+              "returns the number of bytes currently allocated by the given "
+              "subsystem", "bytes" },
+            { "/runtime/allocations/high-water",
+              util::allocation_accounting::stat_high_water,
+              "returns the maximum number of bytes allocated by the given "
+              "subsystem at any point in time", "bytes" },
+            { "/runtime/allocations/count",
+              util::allocation_accounting::stat_allocations,
+              "returns the number of allocations performed by the given "
+              "subsystem", "" }
+        };
+
+        std::vector<performance_counters::generic_counter_type_data>
+            allocation_counter_types;
+        for (allocation_counter_type const& c : allocation_counters)
+        {
+            util::allocation_accounting::statistic stat = c.stat;
+            performance_counters::generic_counter_type_data data = {
+                c.name,
+                performance_counters::counter_raw,
+                std::string(c.helptext) + " (the subsystem has to be "
+                    "specified as the counter parameter, e.g. "
+                    "@shared-states)",
+                HPX_PERFORMANCE_COUNTER_V1,
+                [stat](performance_counters::counter_info const& info,
+                    error_code& ec)
+                {
+                    return performance_counters::
+                        allocation_counter_creator(info, stat, ec);
+                },
+                &performance_counters::allocation_counter_discoverer,
+                c.unit
+            };
+            allocation_counter_types.push_back(std::move(data));
+        }
+
+        performance_counters::generic_counter_type_data const
+            allocation_rate_counter_type =
+        {
+            "/runtime/allocations/rate",
+            performance_counters::counter_raw,
+            "returns the number of allocations per second performed by the "
+            "given subsystem since the counter was evaluated last (the "
+            "subsystem has to be specified as the counter parameter, e.g. "
+            "@shared-states)",
+            HPX_PERFORMANCE_COUNTER_V1,
+            &performance_counters::allocation_rate_counter_creator,
+            &performance_counters::allocation_counter_discoverer,
+            "1/s"
+        };
+        allocation_counter_types.push_back(allocation_rate_counter_type);
+
+        performance_counters::install_counter_types(
+            allocation_counter_types.data(), allocation_counter_types.size());
+#endif
+
         performance_counters::generic_counter_type_data arithmetic_counter_types[] =
         {
             // adding counter
@@ -0,0 +1,56 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_ACTION_LATENCY_COUNTERS)
+#include <hpx/runtime/actions/detail/action_latency_registry.hpp>
+#include <hpx/util/hdr_histogram.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace hpx { namespace actions { namespace detail
+{
+    bool maintain_action_latencies = false;
+
+    action_latency_registry& action_latency_registry::instance()
+    {
+        hpx::util::static_<action_latency_registry, tag> registry;
+        return registry.get();
+    }
+
+    action_latency_data& action_latency_registry::get(std::string const& name)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+
+        std::unique_ptr<action_latency_data>& data = map_[name];
+        if (!data)
+            data.reset(new action_latency_data);
+        return *data;
+    }
+
+    std::int64_t action_latency_registry::get_latency(std::string const& name,
+        action_latency_type type, double percentile, bool reset)
+    {
+        util::hdr_histogram& histogram = get(name).histograms_[type];
+
+        std::int64_t result = histogram.value_at_percentile(percentile);
+        if (reset)
+            histogram.reset();
+        return result;
+    }
+
+    std::int64_t get_action_latency(action_latency_type type,
+        std::string const& name, double percentile, bool reset)
+    {
+        return action_latency_registry::instance().get_latency(
+            name, type, percentile, reset);
+    }
+}}}
+
+#endif
@@ -130,16 +130,88 @@ namespace hpx { namespace agas
         }
     }; // }}}
 
+    // The stripped id of a single object in the cache
+    struct addressing_service::gva_cache_id
+    {
+        gva_cache_id() = default;
+
+        explicit gva_cache_id(naming::gid_type const& id)
+          : msb_(naming::detail::get_stripped_gid(id).get_msb())
+          , lsb_(id.get_lsb())
+        {}
+
+        naming::gid_type get_gid() const
+        {
+            return naming::gid_type(msb_, lsb_);
+        }
+
+        friend bool operator==(
+            gva_cache_id const& lhs, gva_cache_id const& rhs)
+        {
+            return lhs.msb_ == rhs.msb_ && lhs.lsb_ == rhs.lsb_;
+        }
+
+        std::uint64_t msb_;
+        std::uint64_t lsb_;
+    };
+
+    struct addressing_service::gva_cache_id_hash
+    {
+        std::size_t operator()(gva_cache_id const& id) const
+        {
+            return std::hash<naming::gid_type>()(id.get_gid());
+        }
+    };
+
+    // A gva in a form which can be copied bitwise
+    struct addressing_service::gva_cache_entry
+    {
+        gva_cache_entry() = default;
+
+        explicit gva_cache_entry(gva const& g)
+          : prefix_msb_(g.prefix.get_msb())
+          , prefix_lsb_(g.prefix.get_lsb())
+          , type_(g.type)
+          , count_(g.count)
+          , lva_(g.lva())
+          , offset_(g.offset)
+        {}
+
+        gva get() const
+        {
+            return gva(naming::gid_type(prefix_msb_, prefix_lsb_), type_,
+                count_, lva_, offset_);
+        }
+
+        std::uint64_t prefix_msb_;
+        std::uint64_t prefix_lsb_;
+        gva::component_type type_;
+        std::uint64_t count_;
+        gva::lva_type lva_;
+        std::uint64_t offset_;
+    };
+
 addressing_service::addressing_service(
     util::runtime_configuration const& ini_
   , runtime_mode runtime_type_
     )
   : gva_cache_(new gva_cache_type)
+  , gva_range_cache_(new gva_range_cache_type)
+  , gva_range_cache_size_(0)
+#if defined(HPX_HAVE_ALLOCATION_ACCOUNTING)
+  , gva_cache_memory_(util::allocation_accounting::agas_caches)
+  , gva_range_cache_memory_(util::allocation_accounting::agas_caches)
+#endif
   , console_cache_(naming::invalid_locality_id)
   , max_refcnt_requests_(ini_.get_agas_max_pending_refcnt_requests())
   , refcnt_requests_count_(0)
   , enable_refcnt_caching_(true)
   , refcnt_requests_(new refcnt_requests_type)
+  , refcnt_flush_interval_(ini_.get_agas_refcnt_flush_interval())
+  , refcnt_requests_timer_(
+        util::bind_front(&addressing_service::flush_refcnt_requests, this),
+        static_cast<std::int64_t>(refcnt_flush_interval_),
+        "addressing_service::flush_refcnt_requests", true)
   , service_type(ini_.get_agas_service_mode())
   , runtime_type(runtime_type_)
   , caching_(ini_.get_agas_caching_mode())
@@ -151,7 +223,12 @@ addressing_service::addressing_service(
   , locality_()
 {
     if (caching_)
+    {
         gva_cache_->reserve(ini_.get_agas_local_cache_size());
+        gva_range_cache_->reserve(ini_.get_agas_local_cache_size());
+        update_cache_memory_accounting();
+    }
+    symbol_ns_.enable_caching(caching_);
 }
 
 void addressing_service::bootstrap(
@@ -291,7 +368,13 @@ void addressing_service::adjust_local_cache_size(std::size_t cache_size)
     if (caching_)
     {
         std::size_t previous = gva_cache_->size();
-            gva_cache_->reserve(cache_size);
+        gva_cache_->reserve(cache_size);
+        {
+            std::lock_guard<mutex_type> lock(gva_range_cache_mtx_);
+            gva_range_cache_->reserve(cache_size);
+            gva_range_cache_size_.store(gva_range_cache_->size());
+            update_cache_memory_accounting();
+        }
 
         LAGAS_(info) << hpx::util::format(
             "addressing_service::adjust_local_cache_size, previous size: {1}, "
@@ -300,6 +383,22 @@ void addressing_service::adjust_local_cache_size(std::size_t cache_size)
     }
 } // }}}
 
+void addressing_service::update_cache_memory_accounting()
+{
+#if defined(HPX_HAVE_ALLOCATION_ACCOUNTING)
+    // an entry of the range cache is stored in a list node, the iterator
+    // referring to it in a map node keyed by the entry's key
+    std::size_t const range_cache_entry_size =
+        sizeof(std::pair<gva_cache_key, gva>) + sizeof(gva_cache_key) +
+        6 * sizeof(void*) + 2 * sizeof(std::size_t);
+
+    gva_cache_memory_.update(gva_cache_->memory_usage());
+    gva_range_cache_memory_.update(
+        gva_range_cache_size_.load(std::memory_order_relaxed) *
+        range_cache_entry_size);
+#endif
+}
+
 void addressing_service::set_local_locality(naming::gid_type const& g)
 {
     locality_ = g;
@@ -1212,6 +1311,109 @@ hpx::future<naming::address> addressing_service::resolve_async(
     return resolve_full_async(gid);
 }
 
+hpx::future<std::vector<naming::address> > addressing_service::resolve_async(
+    std::vector<naming::id_type> const& ids
+    )
+{
+    std::vector<naming::gid_type> gids;
+    gids.reserve(ids.size());
+
+    std::vector<naming::address> addrs(ids.size());
+
+    // the indices of the ids not found in the cache, grouped by the
+    // locality managing them
+    std::map<std::uint32_t, std::vector<std::size_t> > misses;
+
+    for (std::size_t i = 0; i != ids.size(); ++i)
+    {
+        naming::gid_type const& gid = ids[i].get_gid();
+        if (!gid)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "addressing_service::resolve_async",
+                "invalid reference id");
+            return make_ready_future(std::vector<naming::address>());
+        }
+        gids.push_back(gid);
+
+        // Try the cache.
+        if (caching_)
+        {
+            error_code ec;
+            if (resolve_cached(gid, addrs[i], ec))
+                continue;
+
+            if (ec)
+            {
+                return hpx::make_exceptional_future<
+                        std::vector<naming::address>
+                    >(hpx::detail::access_exception(ec));
+            }
+        }
+
+        misses[naming::get_locality_id_from_gid(gid)].push_back(i);
+    }
+
+    if (misses.empty())
+        return make_ready_future(std::move(addrs));
+
+    // now ask the AGAS service, one request per locality
+    std::vector<std::vector<std::size_t> > indices;
+    indices.reserve(misses.size());
+
+    std::vector<future<std::vector<primary_namespace::resolved_type> > >
+        requests;
+    requests.reserve(misses.size());
+
+    for (auto& miss : misses)
+    {
+        std::vector<naming::gid_type> request;
+        request.reserve(miss.second.size());
+        for (std::size_t i : miss.second)
+            request.push_back(gids[i]);
+
+        requests.push_back(primary_ns_.resolve_full(std::move(request)));
+        indices.push_back(std::move(miss.second));
+    }
+
+    return hpx::when_all(requests).then(
+        hpx::launch::sync,
+        util::one_shot(util::bind_front(
+            &addressing_service::resolve_bulk_postproc,
+            this, std::move(gids), std::move(addrs), std::move(indices)
+        )));
+}
+
+std::vector<naming::address> addressing_service::resolve_bulk_postproc(
+    std::vector<naming::gid_type> const& ids
+  , std::vector<naming::address> addrs
+  , std::vector<std::vector<std::size_t> > const& indices
+  , future<std::vector<
+        future<std::vector<primary_namespace::resolved_type> >
+    > > f
+    )
+{
+    std::vector<future<std::vector<primary_namespace::resolved_type> > >
+        requests = f.get();
+
+    HPX_ASSERT(requests.size() == indices.size());
+    for (std::size_t j = 0; j != requests.size(); ++j)
+    {
+        std::vector<primary_namespace::resolved_type> reps = requests[j].get();
+
+        std::vector<std::size_t> const& index = indices[j];
+        HPX_ASSERT(reps.size() == index.size());
+
+        for (std::size_t k = 0; k != index.size(); ++k)
+        {
+            addrs[index[k]] =
+                resolve_full_postproc_entry(ids[index[k]], reps[k]);
+        }
+    }
+
+    return addrs;
+}
+
 hpx::future<naming::id_type> addressing_service::get_colocation_id_async(
     naming::id_type const& id
     )
@@ -1231,16 +1433,22 @@ hpx::future<naming::id_type> addressing_service::get_colocation_id_async(
 naming::address addressing_service::resolve_full_postproc(
     naming::gid_type const& id, future<primary_namespace::resolved_type> f
     )
+{
+    return resolve_full_postproc_entry(id, f.get());
+}
+
+naming::address addressing_service::resolve_full_postproc_entry(
+    naming::gid_type const& id, primary_namespace::resolved_type const& rep
+    )
 {
     using hpx::util::get;
 
     naming::address addr;
 
-    auto rep = f.get();
     if (get<0>(rep) == naming::invalid_gid || get<2>(rep) == naming::invalid_gid)
     {
         HPX_THROW_EXCEPTION(bad_parameter,
-            "addressing_service::resolve_full_postproc",
+            "addressing_service::resolve_full_postproc_entry",
             "could no resolve global id");
         return addr;
     }
@@ -1623,12 +1831,132 @@ void addressing_service::decref(
         }
 
         send_refcnt_requests(l, ec);
+
+        // make sure the pending requests are not held back for too long
+        if (l.owns_lock())
+        {
+            l.unlock();
+            start_refcnt_requests_timer();
+        }
     }
     catch (hpx::exception const& e) {
         HPX_RETHROWS_IF(ec, e, "addressing_service::decref");
     }
 } // }}}
 
+///////////////////////////////////////////////////////////////////////////////
+bool addressing_service::borrow_credit(
+    naming::gid_type const& gid
+  , std::int64_t credits
+    )
+{
+    naming::gid_type raw(naming::detail::get_stripped_gid(gid));
+
+    std::lock_guard<mutex_type> l(credit_reserve_mtx_);
+
+    credit_reserve_type::iterator it = credit_reserve_.find(raw);
+    if (it == credit_reserve_.end() || it->second.credit_ < credits)
+        return false;
+
+    it->second.credit_ -= credits;
+    it->second.used_ = true;
+    if (it->second.credit_ == 0)
+        credit_reserve_.erase(it);
+
+    return true;
+}
+
+void addressing_service::add_credit_reserve(
+    naming::gid_type const& gid
+  , std::int64_t credits
+    )
+{
+    HPX_ASSERT(credits > 0);
+
+    naming::gid_type raw(naming::detail::get_stripped_gid(gid));
+
+    {
+        std::lock_guard<mutex_type> l(credit_reserve_mtx_);
+
+        credit_reserve_entry& e = credit_reserve_[raw];
+        e.credit_ += credits;
+        e.used_ = true;
+    }
+
+    // unused credits will be given back to AGAS eventually
+    start_refcnt_requests_timer();
+}
+
+void addressing_service::replenish_credit_reserve(
+    naming::gid_type const& gid
+  , std::int64_t credits
+    )
+{
+    naming::gid_type raw(naming::detail::get_stripped_gid(gid));
+
+    incref_async(raw, credits, naming::id_type(raw, naming::id_type::unmanaged))
+        .then(hpx::launch::sync,
+            [this, raw, credits](hpx::future<std::int64_t> f)
+            {
+                // the credits are simply not available if AGAS refused them
+                if (!f.has_exception())
+                    add_credit_reserve(raw, credits);
+            });
+}
+
+void addressing_service::release_credit_reserve(bool unused_only)
+{
+    std::vector<std::pair<naming::gid_type, std::int64_t> > released;
+
+    {
+        std::lock_guard<mutex_type> l(credit_reserve_mtx_);
+
+        credit_reserve_type::iterator end = credit_reserve_.end();
+        for (credit_reserve_type::iterator it = credit_reserve_.begin();
+             it != end; /**/)
+        {
+            if (unused_only && it->second.used_)
+            {
+                // give the entry another interval to be needed again
+                it->second.used_ = false;
+                ++it;
+                continue;
+            }
+
+            released.emplace_back(it->first, it->second.credit_);
+            it = credit_reserve_.erase(it);
+        }
+    }
+
+    for (auto const& e : released)
+    {
+        decref(e.first, e.second, throws);
+    }
+}
+
+bool addressing_service::flush_refcnt_requests()
+{
+    release_credit_reserve(true);
+
+    std::unique_lock<mutex_type> l(refcnt_requests_mtx_, std::try_to_lock);
+    if (l.owns_lock())
+    {
+        error_code ec(lightweight);
+        send_refcnt_requests_non_blocking(l, ec);
+    }
+
+    return true;        // keep the timer running
+}
+
+void addressing_service::start_refcnt_requests_timer()
+{
+    if (refcnt_flush_interval_ != 0 && !refcnt_requests_timer_.is_started() &&
+        hpx::is_running())
+    {
+        refcnt_requests_timer_.start(false);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 static bool correct_credit_on_failure(future<bool> f, naming::id_type id,
     std::int64_t mutable_gid_credit, std::int64_t new_gid_credit)
@@ -1746,38 +2074,19 @@ lcos::future<naming::id_type> addressing_service::resolve_name_async(
     return symbol_ns_.resolve_async(name);
 } // }}}
 
-namespace detail
-{
-    hpx::future<hpx::id_type> on_register_event(hpx::future<bool> f,
-        hpx::future<hpx::id_type> result_f)
-    {
-        if (!f.get())
-        {
-            HPX_THROW_EXCEPTION(bad_request,
-                "hpx::agas::detail::on_register_event",
-                "request 'symbol_ns_on_event' failed");
-            return hpx::future<hpx::id_type>();
-        }
-
-        return result_f;
-    }
-}
-
 future<hpx::id_type> addressing_service::on_symbol_namespace_event(
     std::string const& name, bool call_for_past_events)
 {
-    lcos::promise<naming::id_type, naming::gid_type> p;
-    auto result_f = p.get_future();
-
-    hpx::future<bool> f =
-        symbol_ns_.on_event(name, call_for_past_events, p.get_id());
+    std::vector<std::string> names(1, name);
+    return std::move(
+        symbol_ns_.on_events(names, call_for_past_events).front());
+}
 
-    using util::placeholders::_1;
-    return f.then(
-        hpx::launch::sync,
-        util::one_shot(util::bind_back(
-            &detail::on_register_event, std::move(result_f)
-        )));
+std::vector<future<hpx::id_type> >
+addressing_service::on_symbol_namespace_events(
+    std::vector<std::string> const& names, bool call_for_past_events)
+{
+    return symbol_ns_.on_events(names, call_for_past_events);
 }
 
 // Return all matching entries in the symbol namespace
@@ -1857,19 +2166,24 @@ void addressing_service::update_cache_entry(
             "addressing_service::update_cache_entry, gid({1}), count({2})",
             gid, count);
 
-        const gva_cache_key key(gid, count);
-
+        if (count == 1)
+        {
+            gva_cache_->update(gva_cache_id(gid), gva_cache_entry(g));
+        }
+        else
         {
-            std::unique_lock<mutex_type> lock(gva_cache_mtx_);
-            if (!gva_cache_->update_if(key, g, check_for_collisions))
+            const gva_cache_key key(gid, count);
+
+            std::unique_lock<mutex_type> lock(gva_range_cache_mtx_);
+            if (!gva_range_cache_->update_if(key, g, check_for_collisions))
             {
                 if (LAGAS_ENABLED(warning))
                 {
                     // Figure out who we collided with.
                     addressing_service::gva_cache_key idbase;
-                    addressing_service::gva_cache_type::entry_type e;
+                    addressing_service::gva_range_cache_type::entry_type e;
 
-                    if (!gva_cache_->get_entry(key, idbase, e))
+                    if (!gva_range_cache_->get_entry(key, idbase, e))
                     {
                         // This is impossible under sane conditions.
                         lock.unlock();
@@ -1886,6 +2200,9 @@ void addressing_service::update_cache_entry(
                         gid, count, idbase.get_gid(), idbase.get_count());
                 }
             }
+            gva_range_cache_size_.store(gva_range_cache_->size(),
+                std::memory_order_relaxed);
+            update_cache_memory_accounting();
         }
 
         if (&ec != &throws)
@@ -1908,11 +2225,25 @@ bool addressing_service::get_cache_entry(
     {
         return false;
     }
+    // the entries for single objects are looked up without locking
+    gva_cache_id const id(gid);
+    gva_cache_id realid;
+    gva_cache_entry e;
+    if (gva_cache_->get_entry(id, realid, e))
+    {
+        gva = e.get();
+        idbase = realid.get_gid();
+        return true;
+    }
+
+    if (gva_range_cache_size_.load(std::memory_order_relaxed) == 0)
+        return false;
+
     gva_cache_key k(gid);
     gva_cache_key idbase_key;
 
-    std::unique_lock<mutex_type> lock(gva_cache_mtx_);
-    if(gva_cache_->get_entry(k, idbase_key, gva))
+    std::unique_lock<mutex_type> lock(gva_range_cache_mtx_);
+    if(gva_range_cache_->get_entry(k, idbase_key, gva))
     {
         const std::uint64_t id_msb =
             naming::detail::strip_internal_bits_from_gid(gid.get_msb());
@@ -1926,6 +2257,11 @@ bool addressing_service::get_cache_entry(
             return false;
         }
         idbase = idbase_key.get_gid();
+        lock.unlock();
+
+        // the next lookup of this object will not need to take the lock
+        gva_cache_->update(gva_cache_id(gid),
+            gva_cache_entry(gva.resolve(gid, idbase)));
         return true;
     }
 
@@ -1948,9 +2284,13 @@ void addressing_service::clear_cache(
     try {
         LAGAS_(warning) << "addressing_service::clear_cache, clearing cache";
 
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-
         gva_cache_->clear();
+        {
+            std::lock_guard<mutex_type> lock(gva_range_cache_mtx_);
+            gva_range_cache_->clear();
+            gva_range_cache_size_.store(0, std::memory_order_relaxed);
+            update_cache_memory_accounting();
+        }
 
         if (&ec != &throws)
             ec = make_success_code();
@@ -1995,14 +2335,44 @@ void addressing_service::remove_cache_entry(
     try {
         LAGAS_(warning) << "addressing_service::remove_cache_entry";
 
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-
         gva_cache_->erase(
-            [&gid](std::pair<gva_cache_key, gva> const& p)
+            [&gid](gva_cache_type::entry_pair const& p)
             {
                 return gid == p.first.get_gid();
             });
 
+        std::vector<gva_cache_key> erased;
+        {
+            std::lock_guard<mutex_type> lock(gva_range_cache_mtx_);
+            gva_range_cache_->erase(
+                [&gid, &erased](std::pair<gva_cache_key, gva> const& p)
+                {
+                    if (gid != p.first.get_gid())
+                        return false;
+                    erased.push_back(p.first);
+                    return true;
+                });
+            gva_range_cache_size_.store(gva_range_cache_->size(),
+                std::memory_order_relaxed);
+            update_cache_memory_accounting();
+        }
+
+        // the objects of a removed range might have been cached separately
+        if (!erased.empty())
+        {
+            gva_cache_->erase(
+                [&erased](gva_cache_type::entry_pair const& p)
+                {
+                    gva_cache_key const key(p.first.get_gid());
+                    for (gva_cache_key const& range : erased)
+                    {
+                        if (key == range)
+                            return true;
+                    }
+                    return false;
+                });
+        }
+
         if (&ec != &throws)
             ec = make_success_code();
     }
@@ -2014,6 +2384,9 @@ void addressing_service::remove_cache_entry(
 // Disable refcnt caching during shutdown
 void addressing_service::start_shutdown(error_code& ec)
 {
+    symbol_ns_.clear_cache();
+    release_credit_reserve(false);
+
     // If caching is disabled, we silently pretend success.
     if (!caching_)
         return;
@@ -2146,86 +2519,101 @@ namespace detail
 // Helper functions to access the current cache statistics
 std::uint64_t addressing_service::get_cache_entries(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->size();
+    return gva_cache_->size() +
+        gva_range_cache_size_.load(std::memory_order_relaxed);
 }
 
 std::uint64_t addressing_service::get_cache_hits(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().hits(reset);
+    std::lock_guard<mutex_type> lock(gva_range_cache_mtx_);
+    return gva_cache_->get_statistics().hits(reset) +
+        gva_range_cache_->get_statistics().hits(reset);
 }
 
 std::uint64_t addressing_service::get_cache_misses(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().misses(reset);
+    std::lock_guard<mutex_type> lock(gva_range_cache_mtx_);
+    return gva_cache_->get_statistics().misses(reset) +
+        gva_range_cache_->get_statistics().misses(reset);
 }
 
 std::uint64_t addressing_service::get_cache_evictions(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().evictions(reset);
+    std::lock_guard<mutex_type> lock(gva_range_cache_mtx_);
+    return gva_cache_->get_statistics().evictions(reset) +
+        gva_range_cache_->get_statistics().evictions(reset);
 }
 
 std::uint64_t addressing_service::get_cache_insertions(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().insertions(reset);
+    std::lock_guard<mutex_type> lock(gva_range_cache_mtx_);
+    return gva_cache_->get_statistics().insertions(reset) +
+        gva_range_cache_->get_statistics().insertions(reset);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 std::uint64_t addressing_service::get_cache_get_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_get_entry_count(reset);
+    std::lock_guard<mutex_type> lock(gva_range_cache_mtx_);
+    return gva_cache_->get_statistics().get_get_entry_count(reset) +
+        gva_range_cache_->get_statistics().get_get_entry_count(reset);
 }
 
 std::uint64_t addressing_service::get_cache_insertion_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_insert_entry_count(reset);
+    std::lock_guard<mutex_type> lock(gva_range_cache_mtx_);
+    return gva_cache_->get_statistics().get_insert_entry_count(reset) +
+        gva_range_cache_->get_statistics().get_insert_entry_count(reset);
 }
 
 std::uint64_t addressing_service::get_cache_update_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_update_entry_count(reset);
+    std::lock_guard<mutex_type> lock(gva_range_cache_mtx_);
+    return gva_cache_->get_statistics().get_update_entry_count(reset) +
+        gva_range_cache_->get_statistics().get_update_entry_count(reset);
 }
 
 std::uint64_t addressing_service::get_cache_erase_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_erase_entry_count(reset);
+    std::lock_guard<mutex_type> lock(gva_range_cache_mtx_);
+    return gva_cache_->get_statistics().get_erase_entry_count(reset) +
+        gva_range_cache_->get_statistics().get_erase_entry_count(reset);
 }
 
 std::uint64_t addressing_service::get_cache_get_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_get_entry_time(reset);
+    std::lock_guard<mutex_type> lock(gva_range_cache_mtx_);
+    return gva_cache_->get_statistics().get_get_entry_time(reset) +
+        gva_range_cache_->get_statistics().get_get_entry_time(reset);
 }
 
 std::uint64_t addressing_service::get_cache_insertion_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_insert_entry_time(reset);
+    std::lock_guard<mutex_type> lock(gva_range_cache_mtx_);
+    return gva_cache_->get_statistics().get_insert_entry_time(reset) +
+        gva_range_cache_->get_statistics().get_insert_entry_time(reset);
 }
 
 std::uint64_t addressing_service::get_cache_update_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_update_entry_time(reset);
+    std::lock_guard<mutex_type> lock(gva_range_cache_mtx_);
+    return gva_cache_->get_statistics().get_update_entry_time(reset) +
+        gva_range_cache_->get_statistics().get_update_entry_time(reset);
 }
 
 std::uint64_t addressing_service::get_cache_erase_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_erase_entry_time(reset);
+    std::lock_guard<mutex_type> lock(gva_range_cache_mtx_);
+    return gva_cache_->get_statistics().get_erase_entry_time(reset) +
+        gva_range_cache_->get_statistics().get_erase_entry_time(reset);
 }
 
 /// Install performance counter types exposing properties from the local cache.
 void addressing_service::register_counter_types()
 { // {{{
+    using util::placeholders::_1;
+    using util::placeholders::_2;
+
     // install
     util::function_nonser<std::int64_t(bool)> cache_entries(
         util::bind_front(&addressing_service::get_cache_entries, this));
@@ -2401,6 +2789,8 @@ void addressing_service::garbage_collect_non_blocking(
     error_code& ec
     )
 {
+    release_credit_reserve(false);
+
     std::unique_lock<mutex_type> l(refcnt_requests_mtx_, std::try_to_lock);
     if (!l.owns_lock()) return;     // no need to compete for garbage collection
 
@@ -2411,6 +2801,8 @@ void addressing_service::garbage_collect(
     error_code& ec
     )
 {
+    release_credit_reserve(false);
+
     std::unique_lock<mutex_type> l(refcnt_requests_mtx_, std::try_to_lock);
     if (!l.owns_lock()) return;     // no need to compete for garbage collection
 
@@ -2680,6 +3072,9 @@ hpx::future<void> addressing_service::mark_as_migrated(
             HPX_ASSERT(expect_to_be_marked_as_migrating);
         }
 
+        // a previously known location is not valid anymore
+        migrated_objects_forwarding_.erase(gid);
+
         // avoid interactions with the locking in the cache
         lock.unlock();
 
@@ -2715,6 +3110,7 @@ void addressing_service::unmark_as_migrated(
     if (it != migrated_objects_table_.end())
     {
         migrated_objects_table_.erase(it);
+        migrated_objects_forwarding_.erase(gid);
 
         // remove entry from cache
         if (caching_ && naming::detail::store_in_cache(gid_))
@@ -2765,6 +3161,34 @@ bool addressing_service::end_migration(
     return primary_ns_.end_migration(gid);
 }
 
+void addressing_service::track_migrated_object(naming::gid_type const& gid_)
+{
+    HPX_ASSERT(naming::detail::is_migratable(gid_));
+
+    naming::gid_type gid(naming::detail::get_stripped_gid(gid_));
+
+    // The address resolution is held back by AGAS until the migration has
+    // finished, it then refers to the new location of the object.
+    resolve_async(gid).then(hpx::launch::sync,
+        [this, gid](hpx::future<naming::address> f)
+        {
+            if (f.has_exception())
+                return;
+
+            naming::address addr = f.get();
+
+            std::lock_guard<mutex_type> l(migrated_objects_mtx_);
+
+            // the object might have been migrated back in the meantime
+            if (addr.locality_ != get_local_locality() &&
+                migrated_objects_table_.find(gid) !=
+                    migrated_objects_table_.end())
+            {
+                migrated_objects_forwarding_[gid] = addr;
+            }
+        });
+}
+
 bool addressing_service::was_object_migrated_locked(
     naming::gid_type const& gid_
     )
@@ -2850,14 +3274,13 @@ namespace hpx
                 "no basename specified");
         }
 
-        std::vector<hpx::future<hpx::id_type> > results;
+        std::vector<std::string> names;
+        names.reserve(num_ids);
         for(std::size_t i = 0; i != num_ids; ++i)
         {
-            std::string name = detail::name_from_basename(basename, i);
-            results.push_back(agas::on_symbol_namespace_event(
-                std::move(name), true));
+            names.push_back(detail::name_from_basename(basename, i));
         }
-        return results;
+        return agas::on_symbol_namespace_events(names, true);
     }
 
     std::vector<hpx::future<hpx::id_type>> find_from_basename(
@@ -2870,15 +3293,14 @@ namespace hpx
                 "no basename specified");
         }
 
-        std::vector<hpx::future<hpx::id_type> > results;
+        std::vector<std::string> names;
+        names.reserve(ids.size());
         for (std::size_t i : ids)
         {
-            std::string name =
-                detail::name_from_basename(basename, i);    //-V106
-            results.push_back(agas::on_symbol_namespace_event(
-                std::move(name), true));
+            names.push_back(
+                detail::name_from_basename(basename, i));   //-V106
         }
-        return results;
+        return agas::on_symbol_namespace_events(names, true);
     }
 
     hpx::future<hpx::id_type> find_from_basename(std::string basename,
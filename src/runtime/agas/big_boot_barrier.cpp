@@ -29,6 +29,8 @@
 #include <hpx/runtime/parcelset/parcelport.hpp>
 #include <hpx/runtime/parcelset/put_parcel.hpp>
 #include <hpx/runtime/serialization/detail/polymorphic_id_factory.hpp>
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
 #include <hpx/runtime/serialization/vector.hpp>
 #include <hpx/runtime/threads/topology.hpp>
 #include <hpx/util/assert.hpp>
@@ -36,14 +38,17 @@
 #include <hpx/util/detail/yield_k.hpp>
 #include <hpx/util/format.hpp>
 #include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/pmix_environment.hpp>
 #include <hpx/util/reinitializable_static.hpp>
 #include <hpx/util/runtime_configuration.hpp>
 #include <hpx/util/safe_lexical_cast.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -346,6 +351,7 @@ struct notification_header
     notification_header()
       : num_localities(0)
       , used_cores(0)
+      , fanout(0)
     {}
 
     notification_header(
@@ -358,7 +364,8 @@ struct notification_header
         , std::uint32_t num_localities_
         , std::uint32_t used_cores_
         , parcelset::endpoints_type const & agas_endpoints_
-        , detail::assigned_id_sequence const & ids_)
+        , detail::assigned_id_sequence const & ids_
+        , std::uint32_t fanout_)
       : prefix(prefix_)
       , agas_locality(agas_locality_)
       , locality_ns_address(locality_ns_address_)
@@ -369,6 +376,7 @@ struct notification_header
       , used_cores(used_cores_)
       , agas_endpoints(agas_endpoints_)
       , ids(ids_)
+      , fanout(fanout_)
     {}
 
     naming::gid_type prefix;
@@ -381,6 +389,7 @@ struct notification_header
     std::uint32_t used_cores;
     parcelset::endpoints_type agas_endpoints;
     detail::assigned_id_sequence ids;
+    std::uint32_t fanout;           // number of localities to forward to
     std::vector<parcelset::endpoints_type> endpoints;
 
     template <typename Archive>
@@ -396,13 +405,15 @@ struct notification_header
         ar & used_cores;
         ar & agas_endpoints;
         ar & ids;
+        ar & fanout;
         ar & endpoints;
     }
 };
 
 // {{{ early action forwards
 void register_worker(registration_header const& header);
-void notify_worker(notification_header const& header);
+void notify_worker(notification_header const& header,
+    std::vector<notification_header> const& subtree);
 // }}}
 
 // {{{ early action types
@@ -412,7 +423,8 @@ typedef actions::direct_action<
 > register_worker_action;
 
 typedef actions::direct_action<
-    void (*)(notification_header const&)
+    void (*)(notification_header const&,
+        std::vector<notification_header> const&)
   , notify_worker
 > notify_worker_action;
 // }}}
@@ -435,6 +447,23 @@ HPX_REGISTER_ACTION_ID(notify_worker_action,
 namespace hpx { namespace agas
 {
 
+namespace detail
+{
+    // Find the endpoint of the given locality which can be reached using the
+    // same parcelport as the given one
+    parcelset::locality find_destination(
+        parcelset::endpoints_type const& endpoints,
+        parcelset::locality const& here)
+    {
+        for (parcelset::endpoints_type::value_type const& loc : endpoints)
+        {
+            if (loc.second.type() == here.type())
+                return loc.second;
+        }
+        return parcelset::locality();
+    }
+}
+
 // remote call to AGAS
 void register_worker(registration_header const& header)
 {
@@ -521,18 +550,10 @@ void register_worker(registration_header const& header)
 
     notification_header hdr (prefix, bbb.here(), locality_addr, primary_addr
       , component_addr, symbol_addr, rt.get_config().get_num_localities()
-      , first_core, bbb.get_endpoints(), assigned_ids);
+      , first_core, bbb.get_endpoints(), assigned_ids, bbb.get_fanout());
 
-    parcelset::locality dest;
-    parcelset::locality here = bbb.here();
-    for (parcelset::endpoints_type::value_type const & loc : header.endpoints)
-    {
-        if(loc.second.type() == here.type())
-        {
-            dest = loc.second;
-            break;
-        }
-    }
+    parcelset::locality dest =
+        detail::find_destination(header.endpoints, bbb.here());
 
     // collect endpoints from all registering localities
     bbb.add_locality_endpoints(naming::get_locality_id_from_gid(prefix),
@@ -549,7 +570,8 @@ void register_worker(registration_header const& header)
           , naming::get_locality_id_from_gid(prefix)
           , dest
           , notify_worker_action()
-          , std::move(hdr));
+          , std::move(hdr)
+          , std::vector<notification_header>());
     }
 
     else
@@ -557,22 +579,15 @@ void register_worker(registration_header const& header)
         // AGAS is starting up; this locality is participating in startup
         // synchronization.
 
-        // delay the final response until the runtime system is up and running
-        util::unique_function_nonser<void()>* thunk =
-            new util::unique_function_nonser<void()>(
-                util::one_shot(util::bind_front(
-                    &big_boot_barrier::apply_notification
-                  , &get_big_boot_barrier()
-                  , 0
-                  , naming::get_locality_id_from_gid(prefix)
-                  , dest
-                  , std::move(hdr))));
-        get_big_boot_barrier().add_thunk(thunk);
+        // delay the final response until the runtime system is up and
+        // running, all responses are sent together
+        bbb.add_notification(std::move(hdr));
     }
 }
 
 // AGAS callback to client (first round trip response)
-void notify_worker(notification_header const& header)
+void notify_worker(notification_header const& header,
+    std::vector<notification_header> const& subtree)
 {
     // This lock acquires the bbb mutex on creation. When it goes out of scope,
     // it's dtor calls big_boot_barrier::notify().
@@ -643,18 +658,68 @@ void notify_worker(notification_header const& header)
 
     // pre-cache all known locality endpoints in local AGAS
     agas_client.pre_cache_endpoints(header.endpoints);
+
+    // pass the responses on to the localities below us
+    if (!subtree.empty())
+    {
+        get_big_boot_barrier().send_notifications(
+            naming::get_locality_id_from_gid(header.prefix),
+            std::vector<notification_header>(subtree), header.endpoints,
+            header.fanout);
+    }
 }
 // }}}
 
-void big_boot_barrier::apply_notification(
+void big_boot_barrier::add_notification(notification_header&& hdr)
+{
+    notifications.push_back(std::move(hdr));
+}
+
+// Send the given responses using a tree of the given fanout: the localities
+// are split into (at most) fanout contiguous groups, the first locality of
+// each group receives its own response and forwards the responses of the
+// remaining localities of the group in the same way.
+void big_boot_barrier::send_notifications(
     std::uint32_t source_locality_id
-    , std::uint32_t target_locality_id
-    , parcelset::locality const& dest
-    , notification_header && hdr)
+  , std::vector<notification_header>&& hdrs
+  , std::vector<parcelset::endpoints_type> const& endpoints
+  , std::uint32_t fanout)
 {
-    hdr.endpoints = localities;
-    apply(source_locality_id, target_locality_id, dest,
-        notify_worker_action(), std::move(hdr));
+    std::size_t const count = hdrs.size();
+    std::size_t const chunk_size = (fanout == 0) ? 1 :
+        (count + fanout - 1) / fanout;
+
+    for (std::size_t first = 0; first < count; first += chunk_size)
+    {
+        std::size_t const last = (std::min)(count, first + chunk_size);
+
+        notification_header& hdr = hdrs[first];
+        std::uint32_t const target_locality_id =
+            naming::get_locality_id_from_gid(hdr.prefix);
+
+        parcelset::locality dest;
+        if (target_locality_id < endpoints.size())
+        {
+            dest = detail::find_destination(
+                endpoints[target_locality_id], here());
+        }
+
+        if (!dest)
+        {
+            HPX_THROW_EXCEPTION(internal_server_error,
+                "big_boot_barrier::send_notifications",
+                hpx::util::format(
+                    "no endpoint known for locality {1}", target_locality_id));
+        }
+
+        std::vector<notification_header> subtree(
+            std::make_move_iterator(hdrs.begin() + first + 1),
+            std::make_move_iterator(hdrs.begin() + last));
+
+        hdr.endpoints = endpoints;
+        apply(source_locality_id, target_locality_id, dest,
+            notify_worker_action(), std::move(hdr), std::move(subtree));
+    }
 }
 
 void big_boot_barrier::add_locality_endpoints(std::uint32_t locality_id,
@@ -697,6 +762,44 @@ inline std::size_t get_number_of_bootstrap_connections(
     return result;
 }
 
+inline bool use_pmix_bootstrap(util::runtime_configuration const& ini)
+{
+    // all localities have to take part in the exchange, localities which
+    // connect later always register over the network
+    return util::pmix_environment::enabled() &&
+        ini.mode_ != runtime_mode_connect &&
+        util::pmix_environment::size() > 1 &&
+        util::pmix_environment::size() == ini.get_num_localities() &&
+        util::safe_lexical_cast<int>(
+            ini.get_entry("hpx.agas.bootstrap_pmix", "1"), 1) != 0;
+}
+
+template <typename T>
+std::vector<char> pmix_serialize(T const& t)
+{
+    std::vector<char> data;
+    {
+        serialization::output_archive archive(data);
+        archive << t;
+    }
+    return data;
+}
+
+template <typename T>
+void pmix_deserialize(std::vector<char> const& data, T& t, char const* key)
+{
+    if (data.empty())
+    {
+        HPX_THROW_EXCEPTION(internal_server_error,
+            "big_boot_barrier::pmix_deserialize",
+            hpx::util::format("no value for '{1}' in the PMIx key-value "
+                "store", key));
+    }
+
+    serialization::input_archive archive(data, data.size());
+    archive >> t;
+}
+
 big_boot_barrier::big_boot_barrier(
     parcelset::parcelport *pp_
   , parcelset::endpoints_type const& endpoints_
@@ -710,6 +813,9 @@ big_boot_barrier::big_boot_barrier(
   , mtx()
   , connected(get_number_of_bootstrap_connections(ini_))
   , thunks(32)
+  , fanout(util::safe_lexical_cast<std::uint32_t>(
+        ini_.get_entry("hpx.agas.bootstrap_fanout", "16"), 16))
+  , use_pmix(use_pmix_bootstrap(ini_))
 {
     // register all not registered typenames
     if (service_type == service_mode_bootstrap)
@@ -720,14 +826,57 @@ big_boot_barrier::big_boot_barrier(
     }
 }
 
+big_boot_barrier::~big_boot_barrier()
+{
+    util::unique_function_nonser<void()>* f;
+    while (thunks.pop(f))
+        delete f;
+}
+
 void big_boot_barrier::wait_bootstrap()
 { // {{{
     HPX_ASSERT(service_mode_bootstrap == service_type);
 
+    if (use_pmix)
+        wait_bootstrap_pmix();
+
     // the root just waits until all localities have connected
     spin();
 } // }}}
 
+// The workers publish their registration headers instead of sending them, the
+// root reads and registers them in the order of their ranks after the first
+// fence.
+void big_boot_barrier::wait_bootstrap_pmix()
+{
+    std::uint32_t const this_rank = util::pmix_environment::rank();
+    if (this_rank != 0)
+    {
+        HPX_THROW_EXCEPTION(internal_server_error,
+            "big_boot_barrier::wait_bootstrap_pmix",
+            hpx::util::format("the AGAS root has to be launched as PMIx rank "
+                "zero (it is rank {1}), set hpx.agas.bootstrap_pmix=0 to "
+                "use a different rank", this_rank));
+    }
+
+    util::pmix_environment::put("hpx.agas.root", std::vector<char>(1, 1));
+    util::pmix_environment::fence();
+
+    std::uint32_t const size = util::pmix_environment::size();
+    for (std::uint32_t rank = 1; rank != size; ++rank)
+    {
+        registration_header hdr;
+        pmix_deserialize(util::pmix_environment::get(rank,
+            "hpx.agas.registration"), hdr, "hpx.agas.registration");
+
+        register_worker(hdr);
+
+        HPX_ASSERT(!notifications.empty());
+        pmix_ranks[naming::get_locality_id_from_gid(
+            notifications.back().prefix)] = rank;
+    }
+}
+
 namespace detail
 {
     std::uint32_t get_number_of_pus_in_cores(std::uint32_t num_cores)
@@ -791,17 +940,52 @@ void big_boot_barrier::wait_hosted(
         , unassigned
         , suggested_prefix);
 
-    apply(
-          static_cast<std::uint32_t>(std::random_device{}()) // random first parcel id
-        , 0
-        , bootstrap_agas
-        , register_worker_action()
-        , std::move(hdr));
+    if (use_pmix)
+    {
+        wait_hosted_pmix(hdr);
+    }
+    else
+    {
+        apply(
+              static_cast<std::uint32_t>(std::random_device{}()) // random first parcel id
+            , 0
+            , bootstrap_agas
+            , register_worker_action()
+            , std::move(hdr));
+    }
 
     // wait for registration to be complete
     spin();
 } // }}}
 
+// The second fence is entered by the root only after it has published the
+// responses to all workers (see trigger_pmix).
+void big_boot_barrier::wait_hosted_pmix(registration_header const& hdr)
+{
+    util::pmix_environment::put("hpx.agas.registration", pmix_serialize(hdr));
+    util::pmix_environment::fence();
+
+    if (util::pmix_environment::get(0, "hpx.agas.root").empty())
+    {
+        HPX_THROW_EXCEPTION(internal_server_error,
+            "big_boot_barrier::wait_hosted_pmix",
+            "the AGAS root has to be launched as PMIx rank zero, set "
+            "hpx.agas.bootstrap_pmix=0 to use a different rank");
+    }
+
+    util::pmix_environment::fence();
+
+    notification_header response;
+    std::string const key = hpx::util::format("hpx.agas.notification.{1}",
+        util::pmix_environment::rank());
+    pmix_deserialize(util::pmix_environment::get(0, key), response,
+        key.c_str());
+    pmix_deserialize(util::pmix_environment::get(0, "hpx.agas.endpoints"),
+        response.endpoints, "hpx.agas.endpoints");
+
+    notify_worker(response, std::vector<notification_header>());
+}
+
 void big_boot_barrier::notify()
 {
     runtime& rt = get_runtime();
@@ -843,9 +1027,54 @@ void big_boot_barrier::trigger()
             }
             delete p;
         }
+
+        // the workers wait for the responses in a PMIx fence even if there
+        // are none
+        if (!notifications.empty() || use_pmix)
+        {
+            std::vector<notification_header> hdrs;
+            hdrs.swap(notifications);
+
+            // the tree is built in the order of the locality ids
+            std::sort(hdrs.begin(), hdrs.end(),
+                [](notification_header const& lhs,
+                    notification_header const& rhs)
+                {
+                    return lhs.prefix < rhs.prefix;
+                });
+
+            if (use_pmix)
+                trigger_pmix(std::move(hdrs));
+            else
+                send_notifications(0, std::move(hdrs), localities, fanout);
+        }
     }
 }
 
+// The endpoints of all localities are published once, the responses are
+// published for each worker separately. The values are fetched directly from
+// the root by the workers.
+void big_boot_barrier::trigger_pmix(std::vector<notification_header>&& hdrs)
+{
+    util::pmix_environment::put("hpx.agas.endpoints",
+        pmix_serialize(localities));
+
+    for (notification_header const& hdr : hdrs)
+    {
+        std::uint32_t const locality_id =
+            naming::get_locality_id_from_gid(hdr.prefix);
+
+        auto it = pmix_ranks.find(locality_id);
+        HPX_ASSERT(it != pmix_ranks.end());
+
+        util::pmix_environment::put(
+            hpx::util::format("hpx.agas.notification.{1}", it->second),
+            pmix_serialize(hdr));
+    }
+
+    util::pmix_environment::fence();
+}
+
 void big_boot_barrier::add_thunk(util::unique_function_nonser<void()>* f)
 {
     std::size_t k = 0;
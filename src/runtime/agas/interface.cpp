@@ -500,6 +500,13 @@ hpx::future<hpx::id_type> on_symbol_namespace_event(
     return resolver.on_symbol_namespace_event(name, call_for_past_events);
 }
 
+std::vector<hpx::future<hpx::id_type> > on_symbol_namespace_events(
+    std::vector<std::string> const& names, bool call_for_past_events)
+{
+    naming::resolver_client& resolver = naming::get_agas_client();
+    return resolver.on_symbol_namespace_events(names, call_for_past_events);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 hpx::future<std::pair<naming::id_type, naming::address>>
     begin_migration(naming::id_type const& id)
@@ -537,6 +544,12 @@ void unmark_as_migrated(naming::gid_type const& gid)
     return resolver.unmark_as_migrated(gid);
 }
 
+void track_migrated_object(naming::gid_type const& gid)
+{
+    naming::resolver_client& resolver = naming::get_agas_client();
+    resolver.track_migrated_object(gid);
+}
+
 hpx::future<symbol_namespace::iterate_names_return_type> find_symbols(
     std::string const& pattern)
 {
@@ -68,6 +68,11 @@ HPX_REGISTER_ACTION_ID(
     primary_namespace_resolve_gid_action,
     hpx::actions::primary_namespace_resolve_gid_action_id)
 
+HPX_REGISTER_ACTION_ID(
+    primary_namespace::resolve_gids_action,
+    primary_namespace_resolve_gids_action,
+    hpx::actions::primary_namespace_resolve_gids_action_id)
+
 HPX_REGISTER_ACTION_ID(
     primary_namespace::colocate_action,
     primary_namespace_colocate_action,
@@ -96,6 +101,10 @@ HPX_REGISTER_BASE_LCO_WITH_VALUE_ID(
     gva_tuple_type, gva_tuple,
     hpx::actions::base_lco_with_value_gva_tuple_get,
     hpx::actions::base_lco_with_value_gva_tuple_set)
+HPX_REGISTER_BASE_LCO_WITH_VALUE_ID(
+    std::vector<gva_tuple_type>, vector_gva_tuple,
+    hpx::actions::base_lco_with_value_vector_gva_tuple_get,
+    hpx::actions::base_lco_with_value_vector_gva_tuple_set)
 HPX_REGISTER_BASE_LCO_WITH_VALUE_ID(
     std_pair_address_id_type, std_pair_address_id_type,
     hpx::actions::base_lco_with_value_std_pair_address_id_type_get,
@@ -253,6 +262,22 @@ namespace hpx { namespace agas {
         return hpx::async(action, std::move(dest), id);
     }
 
+    future<std::vector<primary_namespace::resolved_type> >
+    primary_namespace::resolve_full(std::vector<naming::gid_type> ids)
+    {
+        HPX_ASSERT(!ids.empty());
+
+        // all ids are expected to be managed by the same locality
+        naming::id_type dest = naming::id_type(get_service_instance(ids[0]),
+            naming::id_type::unmanaged);
+        if (naming::get_locality_from_gid(dest.get_gid()) == hpx::get_locality())
+        {
+            return hpx::make_ready_future(server_->resolve_gids(std::move(ids)));
+        }
+        server::primary_namespace::resolve_gids_action action;
+        return hpx::async(action, std::move(dest), std::move(ids));
+    }
+
     hpx::future<id_type> primary_namespace::colocate(naming::gid_type id)
     {
         naming::id_type dest = naming::id_type(get_service_instance(id),
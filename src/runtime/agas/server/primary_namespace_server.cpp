@@ -557,6 +557,43 @@ primary_namespace::resolved_type primary_namespace::resolve_gid(naming::gid_type
     return r;
 } // }}}
 
+std::vector<primary_namespace::resolved_type> primary_namespace::resolve_gids(
+    std::vector<naming::gid_type> ids
+    )
+{ // {{{ resolve_gids implementation
+    util::scoped_timer<std::atomic<std::int64_t> > update(
+        counter_data_.resolve_gid_.time_,
+        counter_data_.resolve_gid_.enabled_
+    );
+    using hpx::util::get;
+
+    std::vector<resolved_type> results;
+    results.reserve(ids.size());
+
+    {
+        std::unique_lock<mutex_type> l(mutex_);
+
+        for (naming::gid_type const& id : ids)
+        {
+            counter_data_.increment_resolve_gid_count();
+
+            // wait for any migration to be completed
+            if (naming::detail::is_migratable(id))
+            {
+                wait_for_migration_locked(l, id, hpx::throws);
+            }
+
+            // now, resolve the id
+            results.push_back(resolve_gid_locked(l, id, hpx::throws));
+        }
+    }
+
+    LAGAS_(info) << hpx::util::format(
+        "primary_namespace::resolve_gids, count({1})", ids.size());
+
+    return results;
+} // }}}
+
 naming::id_type primary_namespace::colocate(naming::gid_type id)
 {
     return naming::id_type(
@@ -781,37 +818,41 @@ std::pair<naming::gid_type, naming::gid_type> primary_namespace::allocate(
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
     void primary_namespace::dump_refcnt_matches(
-        refcnt_table_type::iterator lower_it
-      , refcnt_table_type::iterator upper_it
-      , naming::gid_type const& lower
+        naming::gid_type const& lower
       , naming::gid_type const& upper
-      , std::unique_lock<mutex_type>& l
       , const char* func_name
         )
     { // dump_refcnt_matches implementation
-        HPX_ASSERT(l.owns_lock());
-
-        if (lower_it == refcnts_.end() && upper_it == refcnts_.end())
-            // We got nothing, bail - our caller is probably about to throw.
-            return;
-
         std::stringstream ss;
         hpx::util::format_to(ss,
             "{1}, dumping server-side refcnt table matches, lower({2}), "
             "upper({3}):",
             func_name, lower, upper);
 
-        for (/**/; lower_it != upper_it; ++lower_it)
+        bool found = false;
+        for (naming::gid_type raw = lower; raw != upper; ++raw)
         {
+            refcnt_shard& shard = get_refcnt_shard(raw);
+            std::lock_guard<mutex_type> l(shard.mtx_);
+
+            refcnt_table_type::iterator it = shard.refcnts_.find(raw);
+            if (it == shard.refcnts_.end())
+                continue;
+
             // The [server] tag is in there to make it easier to filter
             // through the logs.
             hpx::util::format_to(ss,
                 "\n  [server] lower({1}), credits({2})",
-                lower_it->first,
-                lower_it->second);
+                it->first,
+                it->second);
+            found = true;
         }
 
-        LAGAS_(debug) << ss.str();
+        // If we got nothing our caller is probably about to throw.
+        if (found)
+        {
+            LAGAS_(debug) << ss.str();
+        }
     } // dump_refcnt_matches implementation
 #endif
 
@@ -823,28 +864,11 @@ void primary_namespace::increment(
   , error_code& ec
     )
 { // {{{ increment implementation
-    std::unique_lock<mutex_type> l(mutex_);
-
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
     if (LAGAS_ENABLED(debug))
     {
-        typedef refcnt_table_type::iterator iterator;
-
-        // Find the mappings that we're about to touch.
-        refcnt_table_type::iterator lower_it = refcnts_.find(lower);
-        refcnt_table_type::iterator upper_it;
-        if (lower != upper)
-        {
-            upper_it = refcnts_.find(upper);
-        }
-        else
-        {
-            upper_it = lower_it;
-            ++upper_it;
-        }
-
-        dump_refcnt_matches(lower_it, upper_it, lower, upper, l,
-            "primary_namespace::increment");
+        // Dump the mappings that we're about to touch.
+        dump_refcnt_matches(lower, upper, "primary_namespace::increment");
     }
 #endif
 
@@ -860,14 +884,18 @@ void primary_namespace::increment(
 
     for (naming::gid_type raw = lower; raw != upper; ++raw)
     {
-        refcnt_table_type::iterator it = refcnts_.find(raw);
-        if (it == refcnts_.end())
+        refcnt_shard& shard = get_refcnt_shard(raw);
+        std::unique_lock<mutex_type> l(shard.mtx_);
+
+        refcnt_table_type::iterator it = shard.refcnts_.find(raw);
+        if (it == shard.refcnts_.end())
         {
             std::int64_t count =
                 std::int64_t(HPX_GLOBALCREDIT_INITIAL) + credits;
 
             std::pair<refcnt_table_type::iterator, bool> p =
-                refcnts_.insert(refcnt_table_type::value_type(raw, count));
+                shard.refcnts_.insert(
+                    refcnt_table_type::value_type(raw, count));
             if (!p.second)
             {
                 l.unlock();
@@ -888,9 +916,12 @@ void primary_namespace::increment(
             it->second += credits;
         }
 
+        std::int64_t const count = it->second;
+        l.unlock();
+
         LAGAS_(info) << hpx::util::format(
             "primary_namespace::increment, raw({1}), refcnt({2})",
-            lower, it->second);
+            lower, count);
     }
 
     if (&ec != &throws)
@@ -900,7 +931,7 @@ void primary_namespace::increment(
 ///////////////////////////////////////////////////////////////////////////////
 void primary_namespace::resolve_free_list(
     std::unique_lock<mutex_type>& l
-  , std::list<refcnt_table_type::iterator> const& free_list
+  , std::list<naming::gid_type> const& free_list
   , free_entry_list_type& free_entry_list
   , naming::gid_type const& lower
   , naming::gid_type const& upper
@@ -911,15 +942,8 @@ void primary_namespace::resolve_free_list(
 
     using hpx::util::get;
 
-    typedef refcnt_table_type::iterator iterator;
-
-    for (iterator const& it : free_list)
+    for (naming::gid_type const& gid : free_list)
     {
-        typedef refcnt_table_type::key_type key_type;
-
-        // The mapping's key space.
-        key_type gid = it->first;
-
         if (naming::detail::is_migratable(gid))
         {
             // wait for any migration to be completed
@@ -984,9 +1008,6 @@ void primary_namespace::resolve_free_list(
         // Add the information needed to destroy these components to the
         // free list.
         free_entry_list.push_back(free_entry(resolved, gid, get<2>(r)));
-
-        // remove this entry from the refcnt table
-        refcnts_.erase(it);
     }
 }
 
@@ -1007,27 +1028,11 @@ void primary_namespace::decrement_sweep(
     free_entry_list.clear();
 
     {
-        std::unique_lock<mutex_type> l(mutex_);
-
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
         if (LAGAS_ENABLED(debug))
         {
-            typedef refcnt_table_type::iterator iterator;
-
-            // Find the mappings that we just added or modified.
-            refcnt_table_type::iterator lower_it = refcnts_.find(lower);
-            refcnt_table_type::iterator upper_it;
-            if (lower != upper)
-            {
-                upper_it = refcnts_.find(upper);
-            }
-            else
-            {
-                upper_it = lower_it;
-                ++upper_it;
-            }
-
-            dump_refcnt_matches(lower_it, upper_it, lower, upper, l,
+            // Dump the mappings that we're about to touch.
+            dump_refcnt_matches(lower, upper,
                 "primary_namespace::decrement_sweep");
         }
 #endif
@@ -1041,11 +1046,14 @@ void primary_namespace::decrement_sweep(
         // we know that it's global reference count is the initial global
         // reference count.
 
-        std::list<refcnt_table_type::iterator> free_list;
+        std::list<naming::gid_type> free_list;
         for (naming::gid_type raw = lower; raw != upper; ++raw)
         {
-            refcnt_table_type::iterator it = refcnts_.find(raw);
-            if (it == refcnts_.end())
+            refcnt_shard& shard = get_refcnt_shard(raw);
+            std::unique_lock<mutex_type> l(shard.mtx_);
+
+            refcnt_table_type::iterator it = shard.refcnts_.find(raw);
+            if (it == shard.refcnts_.end())
             {
                 if (credits > std::int64_t(HPX_GLOBALCREDIT_INITIAL))
                 {
@@ -1065,7 +1073,8 @@ void primary_namespace::decrement_sweep(
                     std::int64_t(HPX_GLOBALCREDIT_INITIAL) - credits;
 
                 std::pair<refcnt_table_type::iterator, bool> p =
-                    refcnts_.insert(refcnt_table_type::value_type(raw, count));
+                    shard.refcnts_.insert(
+                        refcnt_table_type::value_type(raw, count));
                 if (!p.second)
                 {
                     l.unlock();
@@ -1100,12 +1109,24 @@ void primary_namespace::decrement_sweep(
                 return;
             }
 
-            // this objects needs to be deleted
+            // this objects needs to be deleted, no references to it are
+            // left which could change its reference count anymore
             if (it->second == 0)
-                free_list.push_back(it);
+            {
+                shard.refcnts_.erase(it);
+                free_list.push_back(raw);
+            }
+        }
+
+        if (free_list.empty())
+        {
+            if (&ec != &throws)
+                ec = make_success_code();
+            return;
         }
 
         // Resolve the objects which have to be deleted.
+        std::unique_lock<mutex_type> l(mutex_);
         resolve_free_list(l, free_list, free_entry_list, lower, upper, ec);
 
     } // Unlock the mutex.
@@ -128,3 +128,43 @@ namespace hpx { namespace agas { namespace server
     } // }}}
 }}}
 
+namespace hpx { namespace agas
+{
+    bool addressing_service::forward_to_migrated_object(parcelset::parcel& p)
+    {
+        naming::gid_type gid(
+            naming::detail::get_stripped_gid(p.destination()));
+
+        naming::address addr;
+        {
+            std::lock_guard<mutex_type> l(migrated_objects_mtx_);
+
+            migrated_objects_forwarding_type::const_iterator it =
+                migrated_objects_forwarding_.find(gid);
+            if (it == migrated_objects_forwarding_.end())
+                return false;
+
+            addr = it->second;
+        }
+
+        runtime& rt = get_runtime();
+        naming::id_type source = p.source_id();
+        bool const store_in_cache =
+            naming::detail::store_in_cache(p.destination());
+
+        p.addr() = addr;
+        rt.get_parcel_handler().put_parcel(std::move(p));
+
+        // let the sender know about the new location of the object, this
+        // avoids sending the next parcel through this locality again
+        if (rt.get_state() < state_pre_shutdown && store_in_cache &&
+            naming::is_locality(source))
+        {
+            hpx::apply<update_agas_cache_action>(
+                source, gid, addr, std::uint64_t(1), std::uint64_t(0));
+        }
+
+        return true;
+    }
+}}
+
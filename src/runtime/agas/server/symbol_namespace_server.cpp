@@ -8,6 +8,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <hpx/config.hpp>
+#include <hpx/apply.hpp>
 #include <hpx/lcos/base_lco_with_value.hpp>
 #include <hpx/performance_counters/counter_creators.hpp>
 #include <hpx/performance_counters/counters.hpp>
@@ -34,6 +35,7 @@
 #include <memory>
 #include <mutex>
 #include <regex>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -344,7 +346,7 @@ naming::gid_type symbol_namespace::unbind(std::string const& key)
     );
     counter_data_.increment_unbind_count();
 
-    std::lock_guard<mutex_type> l(mutex_);
+    std::unique_lock<mutex_type> l(mutex_);
 
     gid_table_type::iterator it = gids_.find(key);
     gid_table_type::iterator end = gids_.end();
@@ -362,6 +364,28 @@ naming::gid_type symbol_namespace::unbind(std::string const& key)
 
     gids_.erase(it);
 
+    // remove the entry from all caches holding it
+    std::set<std::uint32_t> watchers;
+    watchers_table_type::iterator wit = watchers_.find(key);
+    if (wit != watchers_.end())
+    {
+        watchers.swap(wit->second);
+        watchers_.erase(wit);
+    }
+
+    l.unlock();
+
+    for (std::uint32_t locality_id : watchers)
+    {
+        naming::id_type dest(
+            naming::replace_locality_id(
+                bootstrap_symbol_namespace_gid(), locality_id),
+            naming::id_type::unmanaged);
+
+        invalidate_action action;
+        hpx::apply(action, std::move(dest), key);
+    }
+
     LAGAS_(info) << hpx::util::format(
         "symbol_namespace::unbind, key({1}), gid({2})",
         key, gid);
@@ -479,6 +503,116 @@ bool symbol_namespace::on_event(
     return true;
 } // }}}
 
+naming::gid_type symbol_namespace::resolve_cached(
+    std::string const& key
+  , std::uint32_t locality_id
+    )
+{ // {{{ resolve_cached implementation
+    naming::gid_type gid = resolve(key);
+    if (gid != naming::invalid_gid)
+        add_watcher(key, locality_id);
+    return gid;
+} // }}}
+
+bool symbol_namespace::on_events(
+    std::vector<std::string> const& names
+  , bool call_for_past_events
+  , std::vector<hpx::id_type> const& lcos
+  , std::uint32_t locality_id
+    )
+{ // {{{ on_events implementation
+    if (HPX_UNLIKELY(names.size() != lcos.size()))
+    {
+        HPX_THROW_EXCEPTION(bad_parameter
+          , "symbol_namespace::on_events"
+          , "the number of names does not match the number of LCOs");
+        return false;
+    }
+
+    for (std::size_t i = 0; i != names.size(); ++i)
+    {
+        // the watcher has to be known before the LCO is triggered, otherwise
+        // an unbind could slip in between
+        add_watcher(names[i], locality_id);
+
+        if (!on_event(names[i], call_for_past_events, lcos[i]))
+            return false;
+    }
+
+    LAGAS_(info) << hpx::util::format(
+        "symbol_namespace::on_events, names({1})", names.size());
+
+    return true;
+} // }}}
+
+void symbol_namespace::add_watcher(
+    std::string const& key
+  , std::uint32_t locality_id
+    )
+{
+    if (locality_id == naming::invalid_locality_id)
+        return;
+
+    std::lock_guard<mutex_type> l(mutex_);
+    watchers_[key].insert(locality_id);
+}
+
+void symbol_namespace::clear_cache()
+{
+    cache_type cache;
+    {
+        std::lock_guard<mutex_type> l(cache_mtx_);
+        ++cache_epoch_;
+        cache.swap(cache_);
+    }
+    // the cached ids are released here, outside of the lock
+}
+
+void symbol_namespace::invalidate(std::string const& key)
+{
+    std::lock_guard<mutex_type> l(cache_mtx_);
+
+    // entries resolved concurrently must not make it into the cache
+    ++cache_epoch_;
+    cache_.erase(key);
+}
+
+bool symbol_namespace::get_cached(
+    std::string const& key
+  , naming::id_type& id
+    ) const
+{
+    std::lock_guard<mutex_type> l(cache_mtx_);
+
+    cache_type::const_iterator it = cache_.find(key);
+    if (it == cache_.end())
+        return false;
+
+    id = it->second;
+    return true;
+}
+
+std::uint64_t symbol_namespace::get_cache_epoch() const
+{
+    std::lock_guard<mutex_type> l(cache_mtx_);
+    return cache_epoch_;
+}
+
+void symbol_namespace::add_cached(
+    std::string const& key
+  , naming::id_type const& id
+  , std::uint64_t epoch
+    )
+{
+    std::lock_guard<mutex_type> l(cache_mtx_);
+
+    // an invalidation was received while the entry was being resolved
+    if (epoch != cache_epoch_)
+        return;
+
+    cache_[key] = id;
+}
+
 naming::gid_type symbol_namespace::statistics_counter(std::string const& name)
 { // {{{ statistics_counter implementation
     LAGAS_(info) << "symbol_namespace::statistics_counter";
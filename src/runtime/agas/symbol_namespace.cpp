@@ -10,13 +10,17 @@
 #include <hpx/async.hpp>
 #include <hpx/lcos/base_lco_with_value.hpp>
 #include <hpx/lcos/broadcast.hpp>
+#include <hpx/lcos/promise.hpp>
 #include <hpx/runtime/actions/component_action.hpp>
 #include <hpx/runtime/agas/symbol_namespace.hpp>
 #include <hpx/runtime/agas/server/symbol_namespace.hpp>
 #include <hpx/runtime/components/component_factory.hpp>
+#include <hpx/util/bind_back.hpp>
 #include <hpx/util/format.hpp>
 #include <hpx/util/jenkins_hash.hpp>
+#include <hpx/util/one_shot.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <string>
@@ -62,6 +66,21 @@ HPX_REGISTER_ACTION_ID(
     symbol_namespace_statistics_counter_action,
     hpx::actions::symbol_namespace_statistics_counter_action_id)
 
+HPX_REGISTER_ACTION_ID(
+    symbol_namespace::resolve_cached_action,
+    symbol_namespace_resolve_cached_action,
+    hpx::actions::symbol_namespace_resolve_cached_action_id)
+
+HPX_REGISTER_ACTION_ID(
+    symbol_namespace::on_events_action,
+    symbol_namespace_on_events_action,
+    hpx::actions::symbol_namespace_on_events_action_id)
+
+HPX_REGISTER_ACTION_ID(
+    symbol_namespace::invalidate_action,
+    symbol_namespace_invalidate_action,
+    hpx::actions::symbol_namespace_invalidate_action_id)
+
 namespace hpx { namespace agas
 {
     naming::gid_type symbol_namespace::get_service_instance(
@@ -109,6 +128,7 @@ namespace hpx { namespace agas
 
     symbol_namespace::symbol_namespace()
       : server_(new server::symbol_namespace())
+      , caching_(false)
     {}
     symbol_namespace::~symbol_namespace()
     {}
@@ -170,8 +190,34 @@ namespace hpx { namespace agas
             return hpx::make_ready_future(
                 naming::id_type(raw_gid, naming::id_type::unmanaged));
         }
-        server::symbol_namespace::resolve_action action;
-        return hpx::async(action, std::move(dest), std::move(key));
+
+        if (!caching_)
+        {
+            server::symbol_namespace::resolve_action action;
+            return hpx::async(action, std::move(dest), std::move(key));
+        }
+
+        naming::id_type id;
+        if (server_->get_cached(key, id))
+            return hpx::make_ready_future(std::move(id));
+
+        // the owner of the entry will tell us once it is unbound
+        std::uint64_t epoch = server_->get_cache_epoch();
+
+        server::symbol_namespace::resolve_cached_action action;
+        hpx::future<naming::id_type> f = hpx::async(action, std::move(dest),
+            key, hpx::get_locality_id());
+
+        server_type* server = server_.get();
+        return f.then(hpx::launch::sync,
+            [server, HPX_CAPTURE_MOVE(key), epoch](
+                hpx::future<naming::id_type> && f) -> naming::id_type
+            {
+                naming::id_type id = f.get();
+                if (id)
+                    server->add_cached(key, id, epoch);
+                return id;
+            });
     }
 
     naming::id_type symbol_namespace::resolve(std::string key) const
@@ -193,6 +239,9 @@ namespace hpx { namespace agas
             return hpx::make_ready_future(
                 naming::id_type(raw_gid, naming::id_type::unmanaged));
         }
+        if (caching_)
+            server_->invalidate(key);
+
         server::symbol_namespace::unbind_action action;
         return hpx::async(action, std::move(dest), std::move(key));
     }
@@ -218,6 +267,117 @@ namespace hpx { namespace agas
         return hpx::async(
             action, std::move(dest), name, call_for_past_events, std::move(lco));
     }
+
+    namespace detail
+    {
+        hpx::future<naming::id_type> on_events_done(
+            hpx::shared_future<bool> f, hpx::future<naming::id_type> result_f)
+        {
+            if (!f.get())
+            {
+                HPX_THROW_EXCEPTION(bad_request,
+                    "hpx::agas::detail::on_events_done",
+                    "request 'symbol_ns_on_events' failed");
+                return hpx::future<naming::id_type>();
+            }
+            return result_f;
+        }
+    }
+
+    std::vector<hpx::future<naming::id_type> > symbol_namespace::on_events(
+        std::vector<std::string> const& names
+      , bool call_for_past_events
+        )
+    {
+        struct request
+        {
+            std::vector<std::string> names_;
+            std::vector<hpx::id_type> lcos_;
+            std::vector<std::size_t> indices_;
+        };
+
+        std::vector<hpx::future<naming::id_type> > results(names.size());
+        std::vector<hpx::future<naming::id_type> > pending(names.size());
+
+        // collect the requests for each of the localities owning a name
+        std::map<std::uint32_t, request> requests;
+        std::uint32_t const here = hpx::get_locality_id();
+        std::uint64_t const epoch = caching_ ? server_->get_cache_epoch() : 0;
+
+        for (std::size_t i = 0; i != names.size(); ++i)
+        {
+            std::string const& name = names[i];
+
+            naming::id_type id;
+            if (caching_ && call_for_past_events &&
+                server_->get_cached(name, id))
+            {
+                results[i] = hpx::make_ready_future(std::move(id));
+                continue;
+            }
+
+            lcos::promise<naming::id_type, naming::gid_type> p;
+            pending[i] = p.get_future();
+
+            std::uint32_t locality_id = naming::get_locality_id_from_id(
+                symbol_namespace_locality(name));
+            if (locality_id == here)
+            {
+                server_->on_event(name, call_for_past_events, p.get_id());
+                results[i] = std::move(pending[i]);
+                continue;
+            }
+
+            request& r = requests[locality_id];
+            r.names_.push_back(name);
+            r.lcos_.push_back(p.get_id());
+            r.indices_.push_back(i);
+        }
+
+        server_type* server = server_.get();
+        for (auto& r : requests)
+        {
+            server::symbol_namespace::on_events_action action;
+            hpx::shared_future<bool> f = hpx::async(action,
+                naming::id_type(get_service_instance(r.first),
+                    naming::id_type::unmanaged),
+                std::move(r.second.names_), call_for_past_events,
+                std::move(r.second.lcos_),
+                caching_ ? here : naming::invalid_locality_id);
+
+            for (std::size_t i : r.second.indices_)
+            {
+                hpx::future<naming::id_type> result = f.then(
+                    hpx::launch::sync,
+                    util::one_shot(util::bind_back(
+                        &detail::on_events_done, std::move(pending[i]))));
+
+                if (!caching_)
+                {
+                    results[i] = std::move(result);
+                    continue;
+                }
+
+                std::string const& name = names[i];
+                results[i] = result.then(hpx::launch::sync,
+                    [server, name, epoch](
+                        hpx::future<naming::id_type> && f) -> naming::id_type
+                    {
+                        naming::id_type id = f.get();
+                        if (id)
+                            server->add_cached(name, id, epoch);
+                        return id;
+                    });
+            }
+        }
+
+        return results;
+    }
+
+    void symbol_namespace::clear_cache()
+    {
+        server_->clear_cache();
+    }
 }}
 
 typedef symbol_namespace::iterate_action iterate_action;
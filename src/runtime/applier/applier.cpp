@@ -120,6 +120,21 @@ namespace hpx { namespace applier
         app->get_thread_manager().register_work(data, state, ec);
     }
 
+    void register_threads(std::vector<threads::thread_init_data>& data,
+        threads::thread_state_enum state, error_code& ec)
+    {
+        hpx::applier::applier* app = hpx::applier::get_applier_ptr();
+        if (nullptr == app)
+        {
+            HPX_THROWS_IF(ec, invalid_status,
+                "hpx::applier::register_threads",
+                "global applier object is not accessible");
+            return;
+        }
+
+        app->get_thread_manager().register_threads(data, state, ec);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     applier::applier(parcelset::parcelhandler &ph, threads::threadmanager& tm)
       : parcel_handler_(ph), thread_manager_(tm)
@@ -22,6 +22,7 @@
 #include <hpx/runtime/actions/plain_action.hpp>
 #include <hpx/runtime/agas/interface.hpp>
 #include <hpx/runtime/components/component_commandline_base.hpp>
+#include <hpx/runtime/components/component_registry_base.hpp>
 #include <hpx/runtime/components/component_startup_shutdown_base.hpp>
 #include <hpx/runtime/components/server/component_database.hpp>
 #include <hpx/runtime/components/server/create_component.hpp>
@@ -1717,10 +1718,49 @@ namespace hpx { namespace components { namespace server
             return false;   // next please :-P
         }
 
+        // The registry information of this module was taken from the
+        // component registry cache (see hpx.component_registry_cache), its
+        // component types still have to be registered.
+        if (ini.get_entry("hpx.components." + instance + ".deferred", "0")
+                == "1")
+        {
+            register_component_types(d);
+        }
+
         modules_.insert(std::make_pair(HPX_MANGLE_STRING(component), d));
         return true;
     }
 
+    void runtime_support::register_component_types(
+        hpx::util::plugin::dll& d)
+    {
+        error_code ec(lightweight);
+        hpx::util::plugin::plugin_factory<component_registry_base>
+            pf(d, "registry");
+
+        std::vector<std::string> names;
+        pf.get_names(names, ec);
+        if (ec) return;
+
+        for (std::string const& s : names)
+        {
+            std::shared_ptr<component_registry_base> registry(
+                pf.create(s, ec));
+            if (ec) {
+                LRT_(warning) << "couldn't create component registry: "
+                    << d.get_name() << ": " << s << ": " << get_error_what(ec);
+                ec = error_code(lightweight);   // reinit ec
+                continue;
+            }
+
+            startup_functions_.push_back(
+                [registry]()
+                {
+                    registry->register_component_type();
+                });
+        }
+    }
+
     bool runtime_support::load_startup_shutdown_functions(hpx::util::plugin::dll& d,
         error_code& ec)
     {
@@ -16,6 +16,8 @@ namespace hpx
         detail::async_policy{threads::thread_priority_default};
     const detail::fork_policy launch::fork =
         detail::fork_policy{threads::thread_priority_default};
+    const detail::work_first_policy launch::work_first =
+        detail::work_first_policy{threads::thread_priority_default};
     const detail::sync_policy launch::sync = detail::sync_policy{};
     const detail::deferred_policy launch::deferred = detail::deferred_policy{};
     const detail::apply_policy launch::apply = detail::apply_policy{};
@@ -372,11 +372,39 @@ namespace hpx { namespace naming
 
                     naming::gid_type new_gid = gid;     // strips lock-bit
                     HPX_ASSERT(new_gid != invalid_gid);
-                    return agas::incref(new_gid, new_credit)
+
+                    agas::addressing_service& agas_client =
+                        naming::get_agas_client();
+                    if (!agas_client.has_credit_reserve())
+                    {
+                        return agas::incref(new_gid, new_credit)
+                            .then(
+                                hpx::launch::sync,
+                                hpx::util::bind(
+                                    postprocess_incref, std::ref(gid)));
+                    }
+
+                    // Use credits which were requested earlier, if any, and
+                    // refill the reserve in the background.
+                    if (agas_client.borrow_credit(new_gid, new_credit))
+                    {
+                        agas_client.replenish_credit_reserve(new_gid, new_credit);
+                        return hpx::make_ready_future(postprocess_incref(gid));
+                    }
+
+                    // Otherwise request twice the needed amount, such that
+                    // the next split of this gid is resolved locally.
+                    return agas::incref(new_gid, 2 * new_credit)
                         .then(
                             hpx::launch::sync,
-                            hpx::util::bind(postprocess_incref, std::ref(gid))
-                        );
+                            [&gid, new_gid, new_credit](
+                                hpx::future<std::int64_t> f) -> gid_type
+                            {
+                                f.get();    // propagate errors
+                                naming::get_agas_client().add_credit_reserve(
+                                    new_gid, new_credit);
+                                return postprocess_incref(gid);
+                            });
                 }
 
                 HPX_ASSERT(src_log2credits > 1);
@@ -734,6 +762,44 @@ namespace hpx { namespace naming
     }
 }}
 
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace serialization { namespace detail
+{
+    void compact_array_encoding<naming::gid_type>::save(output_archive& ar,
+        naming::gid_type const* data, std::size_t size)
+    {
+        std::uint64_t msb = 0;
+        std::uint64_t lsb = 0;
+        for (std::size_t i = 0; i != size; ++i)
+        {
+            ar.save_varint(data[i].get_msb() ^ msb);
+            msb = data[i].get_msb();
+
+            std::int64_t diff = static_cast<std::int64_t>(
+                data[i].get_lsb() - lsb);
+            ar.save_varint((static_cast<std::uint64_t>(diff) << 1) ^
+                static_cast<std::uint64_t>(diff >> 63));
+            lsb = data[i].get_lsb();
+        }
+    }
+
+    void compact_array_encoding<naming::gid_type>::load(input_archive& ar,
+        naming::gid_type* data, std::size_t size)
+    {
+        std::uint64_t msb = 0;
+        std::uint64_t lsb = 0;
+        for (std::size_t i = 0; i != size; ++i)
+        {
+            msb ^= ar.load_varint();
+
+            std::uint64_t diff = ar.load_varint();
+            lsb += (diff >> 1) ^ (0 - (diff & 1));
+
+            data[i] = naming::gid_type(msb, lsb);
+        }
+    }
+}}}
+
 namespace hpx
 {
     naming::id_type get_colocation_id(launch::sync_policy,
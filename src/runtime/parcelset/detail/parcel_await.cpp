@@ -3,6 +3,8 @@
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <hpx/config.hpp>
+#include <hpx/runtime/actions/base_action.hpp>
 #include <hpx/runtime/actions_fwd.hpp>
 #include <hpx/runtime/parcelset/detail/parcel_await.hpp>
 #include <hpx/runtime/parcelset/parcel.hpp>
@@ -18,6 +20,23 @@
 
 namespace hpx { namespace parcelset { namespace detail
 {
+    namespace
+    {
+        // Parcels whose action arguments are all bitwise serializable hold
+        // neither futures nor id_types, their size is estimated without
+        // running the serialization for them.
+        bool set_fixed_size(parcel& p)
+        {
+            std::size_t size = p.get_action()->get_fixed_arguments_size();
+            if (size == std::size_t(-1))
+                return false;
+
+            p.size() = size + HPX_PARCEL_SERIALIZATION_OVERHEAD;
+            p.num_chunks() = 1;
+            return true;
+        }
+    }
+
     template <typename Parcel, typename Handler, typename Derived>
     struct parcel_await_base : std::enable_shared_from_this<Derived>
     {
@@ -128,6 +147,9 @@ namespace hpx { namespace parcelset { namespace detail
     {
         for (/*idx_*/; idx_ != parcel_.size(); ++idx_)
         {
+            if (parcel_[idx_].size() != 0 || set_fixed_size(parcel_[idx_]))
+                continue;
+
             if(!apply_single(parcel_[idx_]))
                 return;
         }
@@ -138,6 +160,14 @@ namespace hpx { namespace parcelset { namespace detail
     void parcel_await_apply(parcel&& p, write_handler_type&& f,
         int archive_flags, put_parcel_type pp)
     {
+        // parcels which were preprocessed while the credit of their
+        // destination was split (see put_parcel) are not awaited again
+        if (p.size() != 0 || set_fixed_size(p))
+        {
+            pp(std::move(p), std::move(f));
+            return;
+        }
+
         std::make_shared<parcel_await>(
                 std::move(p), std::move(f), 0, std::move(pp)
             )->apply();
@@ -18,6 +18,9 @@
 #include <hpx/runtime/serialization/input_archive.hpp>
 #include <hpx/runtime/serialization/output_archive.hpp>
 #include <hpx/runtime/serialization/detail/polymorphic_id_factory.hpp>
+#include <hpx/runtime/serialization/string.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/throw_exception.hpp>
 #include <hpx/util/apex.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
@@ -32,6 +35,7 @@
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace parcelset
@@ -123,9 +127,157 @@ namespace hpx { namespace parcelset
             hpx::serialization::input_archive&, unsigned);
         template void parcel_data::serialize(
             hpx::serialization::output_archive&, unsigned);
+
+        ///////////////////////////////////////////////////////////////////////
+        // The part of the parcel data which is stored for each parcel sent as
+        // part of a batch. The locality of the destination address is stored
+        // only if it differs from the destination locality of the batch.
+        struct batched_parcel_data
+        {
+            enum flags_type
+            {
+                has_continuation = 0x01,
+                has_locality = 0x02
+            };
+
+            template <typename Archive>
+            void serialize(Archive &ar, unsigned)
+            {
+                ar & source_id_;
+                ar & dest_;
+                ar & address_;
+                ar & type_;
+                ar & action_index_;
+                ar & flags_;
+            }
+
+            naming::gid_type source_id_;
+            naming::gid_type dest_;
+            naming::address_type address_;
+            naming::component_type type_;
+            std::uint16_t action_index_;
+            std::uint8_t flags_;
+        };
     }
 }}
 
+HPX_IS_BITWISE_SERIALIZABLE(hpx::parcelset::detail::batched_parcel_data)
+
+namespace hpx { namespace parcelset { namespace detail
+{
+    // A parcel which arrives without the local virtual address of its
+    // target was sent speculatively to the locality managing the address of
+    // the target object (see parcelhandler::put_parcel), it still has to be
+    // resolved by AGAS.
+    static bool needs_resolution(naming::address const& addr, int comptype)
+    {
+        if (addr.address_ != 0 || addr.type_ != components::component_invalid)
+            return false;
+
+        switch (comptype)
+        {
+        case components::component_runtime_support:
+        case components::component_agas_primary_namespace:
+        case components::component_agas_symbol_namespace:
+        case components::component_plain_function:
+        case components::component_memory:
+            return false;
+
+        default:
+            break;
+        }
+        return true;
+    }
+
+    // Ids encoding the address of their target (for instance the ids of
+    // promises) are resolved without asking AGAS.
+    static bool resolve_locally_known_address(parcel_data& data)
+    {
+        naming::address addr;
+        if (!naming::detail::is_migratable(data.dest_) &&
+            naming::refers_to_local_lva(data.dest_) &&
+            hpx::naming::get_agas_client().resolve_cached(data.dest_, addr))
+        {
+            data.addr_ = std::move(addr);
+            return true;
+        }
+        return false;
+    }
+
+    parcel_batch::parcel_batch(parcel const* ps, std::size_t num_parcels)
+    {
+        if (num_parcels != 0)
+            dest_locality_ = ps[0].destination_locality();
+
+        // the number of different actions in a message is usually small
+        indices_.reserve(num_parcels);
+        for (std::size_t i = 0; i != num_parcels; ++i)
+        {
+            std::uint32_t const id = ps[i].get_action()->get_action_id();
+
+            std::size_t index = 0;
+            while (index != action_ids_.size() && action_ids_[index] != id)
+                ++index;
+
+            if (index == action_ids_.size())
+            {
+                if (index == std::size_t(std::uint16_t(-1)))
+                {
+                    HPX_THROW_EXCEPTION(serialization_error,
+                        "parcel_batch::parcel_batch",
+                        "too many different actions in a single message");
+                }
+
+                action_ids_.push_back(id);
+#if defined(HPX_DEBUG)
+                action_names_.push_back(ps[i].get_action()->get_action_name());
+#endif
+            }
+            indices_.push_back(static_cast<std::uint16_t>(index));
+        }
+    }
+
+    std::unique_ptr<actions::base_action> parcel_batch::create_action(
+        std::uint16_t index, bool has_continuation) const
+    {
+        using hpx::actions::detail::action_registry;
+
+        if (index >= action_ids_.size())
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "parcel_batch::create_action",
+                "invalid index into the action table of the message");
+        }
+
+#if !defined(HPX_DEBUG)
+        return std::unique_ptr<actions::base_action>(
+            action_registry::create(action_ids_[index], has_continuation));
+#else
+        return std::unique_ptr<actions::base_action>(
+            action_registry::create(action_ids_[index], has_continuation,
+                &action_names_[index]));
+#endif
+    }
+
+    void parcel_batch::serialize(serialization::input_archive & ar, unsigned)
+    {
+        ar >> dest_locality_;
+        ar >> action_ids_;
+#if defined(HPX_DEBUG)
+        ar >> action_names_;
+#endif
+    }
+
+    void parcel_batch::serialize(serialization::output_archive & ar, unsigned)
+    {
+        ar << dest_locality_;
+        ar << action_ids_;
+#if defined(HPX_DEBUG)
+        ar << action_names_;
+#endif
+    }
+}}}
+
 namespace hpx { namespace parcelset
 {
 #if defined(HPX_DEBUG)
@@ -420,10 +572,32 @@ namespace hpx { namespace parcelset
         std::size_t num_thread, bool& deferred_schedule)
     {
         load_data(ar);
+        return schedule_loaded(ar, num_thread, deferred_schedule);
+    }
+
+    bool parcel::load_schedule(serialization::input_archive & ar,
+        std::size_t num_thread, bool& deferred_schedule,
+        detail::parcel_batch const& batch)
+    {
+        load_data(ar, batch);
+        return schedule_loaded(ar, num_thread, deferred_schedule);
+    }
 
+    bool parcel::schedule_loaded(serialization::input_archive & ar,
+        std::size_t num_thread, bool& deferred_schedule)
+    {
         // make sure this parcel destination matches the proper locality
         HPX_ASSERT(destination_locality() == data_.addr_.locality_);
 
+        // the destination is still unresolved, have it routed by AGAS
+        if (detail::needs_resolution(
+                data_.addr_, action_->get_component_type()) &&
+            !detail::resolve_locally_known_address(data_))
+        {
+            action_->load(ar);
+            return true;
+        }
+
         std::pair<naming::address_type, naming::component_type> p = determine_lva();
 
         // make sure the target has not been migrated away
@@ -459,14 +633,30 @@ namespace hpx { namespace parcelset
         // make sure this parcel destination matches the proper locality
         HPX_ASSERT(destination_locality() == data_.addr_.locality_);
 
+        // the destination is still unresolved, have it routed by AGAS
+        if (detail::needs_resolution(
+                data_.addr_, action_->get_component_type()) &&
+            !detail::resolve_locally_known_address(data_))
+        {
+            hpx::naming::get_agas_client().route(
+                std::move(*this),
+                &detail::parcel_route_handler,
+                threads::thread_priority_normal);
+            return;
+        }
+
         std::pair<naming::address_type, naming::component_type> p = determine_lva();
 
         // make sure the target has not been migrated away
         auto r = action_->was_object_migrated(data_.dest_, p.first);
         if (r.first)
         {
-            // If the object was migrated, just route.
+            // If the object was migrated, forward the parcel to its new
+            // location, if known. Route it through AGAS otherwise.
             naming::resolver_client& client = hpx::naming::get_agas_client();
+            if (client.forward_to_migrated_object(*this))
+                return;
+
             client.route(
                 std::move(*this),
                 &detail::parcel_route_handler,
@@ -496,6 +686,64 @@ namespace hpx { namespace parcelset
 #endif
     }
 
+    void parcel::load_data(serialization::input_archive & ar,
+        detail::parcel_batch const& batch)
+    {
+        detail::batched_parcel_data data;
+        ar >> data;
+
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+        ar >> data_.parcel_id_;
+        ar >> data_.start_time_;
+        ar >> data_.creation_time_;
+#endif
+        data_.source_id_ = data.source_id_;
+        data_.dest_ = data.dest_;
+        data_.addr_.type_ = data.type_;
+        data_.addr_.address_ = data.address_;
+        data_.has_continuation_ =
+            (data.flags_ & detail::batched_parcel_data::has_continuation) != 0;
+
+        if (data.flags_ & detail::batched_parcel_data::has_locality)
+            ar >> data_.addr_.locality_;
+        else
+            data_.addr_.locality_ = batch.destination_locality();
+
+        action_ = batch.create_action(data.action_index_,
+            data_.has_continuation_);
+    }
+
+    void parcel::save_batched(serialization::output_archive & ar,
+        detail::parcel_batch const& batch, std::size_t index) const
+    {
+        detail::batched_parcel_data data;
+        data.source_id_ = data_.source_id_;
+        data.dest_ = data_.dest_;
+        data.address_ = data_.addr_.address_;
+        data.type_ = data_.addr_.type_;
+        data.action_index_ = batch.action_index(index);
+        data.flags_ = 0;
+        if (data_.has_continuation_)
+            data.flags_ |= detail::batched_parcel_data::has_continuation;
+
+        bool const has_locality =
+            data_.addr_.locality_ != batch.destination_locality();
+        if (has_locality)
+            data.flags_ |= detail::batched_parcel_data::has_locality;
+
+        ar << data;
+
+#if defined(HPX_HAVE_PARCEL_PROFILING)
+        ar << data_.parcel_id_;
+        ar << data_.start_time_;
+        ar << data_.creation_time_;
+#endif
+        if (has_locality)
+            ar << data_.addr_.locality_;
+
+        action_->save(ar);
+    }
+
     void parcel::serialize(serialization::input_archive & ar, unsigned)
     {
         load_data(ar);
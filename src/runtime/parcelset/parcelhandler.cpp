@@ -109,7 +109,10 @@ namespace hpx { namespace parcelset
       , enable_parcel_handling_(true)
       , load_message_handlers_(util::get_entry_as<int>(cfg,
                                    "hpx.parcel.message_handlers", "0") != 0)
+      , use_multi_rail_(util::get_entry_as<int>(cfg,
+                                   "hpx.parcel.multi_rail", "0") != 0)
       , count_routed_(0)
+      , count_speculatively_routed_(0)
       , write_handler_(&default_write_handler)
       , is_networking_enabled_(hpx::is_networking_enabled())
     {
@@ -360,6 +363,14 @@ namespace hpx { namespace parcelset
         endpoints_type const & dest_endpoints =
             resolver_->resolve_locality(dest_gid);
 
+        if (use_multi_rail_)
+        {
+            std::pair<std::shared_ptr<parcelport>, locality> dest =
+                find_least_loaded_destination(dest_gid, dest_endpoints);
+            if (dest.first)
+                return dest;
+        }
+
         for (pports_type::value_type& pp : pports_)
         {
             if(pp.first > 0)
@@ -389,6 +400,69 @@ namespace hpx { namespace parcelset
         return std::pair<std::shared_ptr<parcelport>, locality>();
     }
 
+    // Every enabled parcelport which can connect to the destination is used
+    // as a rail. The parcels are sent through the rail with the fewest
+    // parcels waiting to be sent, the rails are ranked starting at one chosen
+    // by the destination locality, which spreads the parcels sent to
+    // different localities over the rails while their queues are balanced.
+    std::pair<std::shared_ptr<parcelport>, locality>
+    parcelhandler::find_least_loaded_destination(
+        naming::gid_type const& dest_gid,
+        endpoints_type const& dest_endpoints)
+    {
+        std::size_t num_rails = 0;
+        for (pports_type::value_type& pp : pports_)
+        {
+            if (pp.first > 0)
+            {
+                locality const& dest =
+                    find_endpoint(dest_endpoints, pp.second->type());
+                if (dest &&
+                    pp.second->can_connect(dest, use_alternative_parcelports_))
+                {
+                    ++num_rails;
+                }
+            }
+        }
+
+        std::pair<std::shared_ptr<parcelport>, locality> result;
+        if (num_rails == 0)
+            return result;
+
+        std::size_t const first_rail =
+            naming::get_locality_id_from_gid(dest_gid) % num_rails;
+
+        std::size_t rail = 0;
+        std::size_t best_rank = num_rails;
+        std::int64_t best_pending = 0;
+        for (pports_type::value_type& pp : pports_)
+        {
+            if (pp.first <= 0)
+                continue;
+
+            locality dest = find_endpoint(dest_endpoints, pp.second->type());
+            if (!dest ||
+                !pp.second->can_connect(dest, use_alternative_parcelports_))
+            {
+                continue;
+            }
+
+            std::size_t const rank =
+                (rail++ + num_rails - first_rail) % num_rails;
+            std::int64_t const pending =
+                pp.second->get_pending_parcels_count(false);
+
+            if (!result.first || pending < best_pending ||
+                (pending == best_pending && rank < best_rank))
+            {
+                result = std::make_pair(pp.second, std::move(dest));
+                best_rank = rank;
+                best_pending = pending;
+            }
+        }
+        return result;
+    }
+
     locality parcelhandler::find_endpoint(endpoints_type const & eps,
         std::string const & name)
     {
@@ -436,6 +510,30 @@ namespace hpx { namespace parcelset
         }
     }
 
+    // The locality a gid was created on manages the address of the
+    // referenced object and most likely still hosts it. If the address is not
+    // known locally, send the parcel directly to that locality instead of
+    // wrapping it into a route action. An address without a local virtual
+    // address makes the receiving locality resolve it and forward the parcel,
+    // if needed.
+    bool parcelhandler::route_speculatively(
+        naming::gid_type const& gid, naming::address& addr)
+    {
+        naming::gid_type locality = naming::get_locality_from_gid(gid);
+
+        // fall back to routing the parcel if the endpoints of the locality
+        // still have to be resolved
+        if (locality == resolver_->get_local_locality() ||
+            !resolver_->has_resolved_locality(locality))
+        {
+            return false;
+        }
+
+        addr = naming::address(locality);
+        ++count_speculatively_routed_;
+        return true;
+    }
+
     void parcelhandler::put_parcel(parcel p, write_handler_type f)
     {
 #if defined(HPX_HAVE_NETWORKING)
@@ -479,7 +577,8 @@ namespace hpx { namespace parcelset
 
         if (!addr)
         {
-            resolved_locally = resolver_->resolve_local(gid, addr);
+            resolved_locally = resolver_->resolve_local(gid, addr) ||
+                route_speculatively(gid, addr);
         }
 
 #if defined(HPX_HAVE_PARCEL_PROFILING)
@@ -617,7 +716,8 @@ namespace hpx { namespace parcelset
             if (!addr)
             {
                 resolved_locally = resolver_->resolve_local(
-                    p.destination(), addr);
+                        p.destination(), addr) ||
+                    route_speculatively(p.destination(), addr);
             }
 
             write_handler_type f = util::bind_front(&detail::parcel_sent_handler,
@@ -860,6 +960,14 @@ namespace hpx { namespace parcelset
         return util::get_and_reset_value(count_routed_, reset);
     }
 
+    // number of parcels sent directly to the locality managing the address
+    // of their destination
+    std::int64_t parcelhandler::get_parcel_speculatively_routed_count(
+        bool reset)
+    {
+        return util::get_and_reset_value(count_speculatively_routed_, reset);
+    }
+
     // number of messages sent
     std::int64_t parcelhandler::get_message_send_count(
         std::string const& pp_type, bool reset) const
@@ -1067,6 +1175,9 @@ namespace hpx { namespace parcelset
             util::bind_front(&parcelhandler::get_outgoing_queue_length, this));
         util::function_nonser<std::int64_t(bool)> outgoing_routed_count(
             util::bind_front(&parcelhandler::get_parcel_routed_count, this));
+        util::function_nonser<std::int64_t(bool)>
+            outgoing_speculatively_routed_count(util::bind_front(
+                &parcelhandler::get_parcel_speculatively_routed_count, this));
 
         performance_counters::generic_counter_type_data const counter_types[] =
         {
@@ -1099,6 +1210,16 @@ namespace hpx { namespace parcelset
                   _1, outgoing_routed_count, _2),
               &performance_counters::locality_counter_discoverer,
               ""
+            },
+            { "/parcels/count/speculatively-routed",
+              performance_counters::counter_raw,
+              "returns the number of (outbound) parcels sent directly to "
+                  "the locality managing the address of their destination",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, outgoing_speculatively_routed_count, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
             }
         };
         performance_counters::install_counter_types(
@@ -1453,6 +1574,9 @@ namespace hpx { namespace parcelset
         util::function_nonser<std::int64_t(bool)> cache_reclaims(
             util::bind_front(&parcelhandler::get_connection_cache_statistics,
                 this, pp_type, parcelport::connection_cache_reclaims));
+        util::function_nonser<std::int64_t(bool)> cache_reconnects(
+            util::bind_front(&parcelhandler::get_connection_cache_statistics,
+                this, pp_type, parcelport::connection_cache_reconnects));
 
         performance_counters::generic_counter_type_data const
             connection_cache_types[] =
@@ -1521,6 +1645,20 @@ namespace hpx { namespace parcelset
                   _1, std::move(cache_reclaims), _2),
               &performance_counters::locality_counter_discoverer,
               ""
+            },
+            { hpx::util::format(
+                  "/parcelport/count/{}/cache-reconnects", pp_type),
+              performance_counters::counter_raw,
+              hpx::util::format(
+                  "returns the number of connections which had to be "
+                  "re-established after a connection to the same locality "
+                  "was evicted from the connection cache for the {} "
+                  "connection type on the referenced locality", pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, std::move(cache_reconnects), _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
             }
         };
         performance_counters::install_counter_types(connection_cache_types,
@@ -1591,6 +1729,10 @@ namespace hpx { namespace parcelset
             "zero_copy_optimization = ${HPX_PARCEL_ZERO_COPY_OPTIMIZATION:"
                 "$[hpx.parcel.array_optimization]}",
             "async_serialization = ${HPX_PARCEL_ASYNC_SERIALIZATION:1}",
+            "compression_max_ratio = ${HPX_PARCEL_COMPRESSION_MAX_RATIO:0.8}",
+            "decode_segment_size = ${HPX_PARCEL_DECODE_SEGMENT_SIZE:0}",
+            "multi_rail = ${HPX_PARCEL_MULTI_RAIL:0}",
+            "compact_encoding = ${HPX_PARCEL_COMPACT_ENCODING:0}",
 #if defined(HPX_HAVE_PARCEL_COALESCING)
             "message_handlers = ${HPX_PARCEL_MESSAGE_HANDLERS:1}"
 #else
@@ -39,7 +39,12 @@ namespace hpx { namespace parcelset
         max_outbound_message_size_(ini.get_max_outbound_message_size()),
         allow_array_optimizations_(true),
         allow_zero_copy_optimizations_(true),
+        allow_device_memory_chunks_(false),
+        allow_chunk_deduplication_(false),
+        allow_compact_encoding_(false),
         async_serialization_(false),
+        decode_segment_size_(hpx::util::get_entry_as<std::size_t>(ini,
+            "hpx.parcel." + type + ".decode_segment_size", "0")),
         priority_(hpx::util::get_entry_as<int>(ini,
             "hpx.parcel." + type + ".priority", "0")),
         type_(type)
@@ -60,6 +65,19 @@ namespace hpx { namespace parcelset
             {
                 allow_zero_copy_optimizations_ = false;
             }
+            else
+            {
+                if (hpx::util::get_entry_as<int>(
+                        ini, key + ".device_memory_chunks", "0") != 0)
+                {
+                    allow_device_memory_chunks_ = true;
+                }
+                if (hpx::util::get_entry_as<int>(
+                        ini, key + ".deduplicate_chunks", "0") != 0)
+                {
+                    allow_chunk_deduplication_ = true;
+                }
+            }
         }
 
         if (hpx::util::get_entry_as<int>(
@@ -67,6 +85,13 @@ namespace hpx { namespace parcelset
         {
             async_serialization_ = true;
         }
+
+        // the setting for all parcelports may be overridden for each of them
+        if (hpx::util::get_entry_as<int>(ini, key + ".compact_encoding",
+                ini.get_entry("hpx.parcel.compact_encoding", "0")) != 0)
+        {
+            allow_compact_encoding_ = true;
+        }
     }
 
     ///////////////////////////////////////////////////////////////////////////
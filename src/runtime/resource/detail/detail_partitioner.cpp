@@ -63,6 +63,7 @@ namespace hpx { namespace resource { namespace detail
         , scheduling_policy_(sched)
         , num_threads_(0)
         , mode_(mode)
+        , sharing_mode_(sharing_none)
     {
         if (name.empty())
         {
@@ -78,6 +79,7 @@ namespace hpx { namespace resource { namespace detail
         , num_threads_(0)
         , mode_(hpx::threads::policies::scheduler_mode::default_mode)
         , create_function_(std::move(create_func))
+        , sharing_mode_(sharing_none)
     {
         if (name.empty())
         {
@@ -158,6 +160,9 @@ namespace hpx { namespace resource { namespace detail
         case resource::shared_priority:
             sched = "shared_priority";
             break;
+        case resource::hierarchical_priority:
+            sched = "hierarchical_priority";
+            break;
         }
 
         os << "\"" << sched << "\" is running on PUs : \n";
@@ -455,6 +460,10 @@ namespace hpx { namespace resource { namespace detail
         {
             default_scheduler = scheduling_policy::shared_priority;
         }
+        else if (0 == std::string("hierarchical-priority").find(cfg_.queuing_))
+        {
+            default_scheduler = scheduling_policy::hierarchical_priority;
+        }
         else
         {
             throw hpx::detail::command_line_error(
@@ -845,6 +854,28 @@ namespace hpx { namespace resource { namespace detail
         return get_pool_data(l, pool_index).mode_;
     }
 
+    void partitioner::set_pool_sharing_mode(
+        std::string const& pool_name, pool_sharing_mode mode)
+    {
+        if (get_runtime_ptr() != nullptr)
+        {
+            HPX_THROW_EXCEPTION(invalid_status,
+                "partitioner::set_pool_sharing_mode",
+                "this function must be called before the runtime system has "
+                "been started");
+        }
+
+        std::unique_lock<mutex_type> l(mtx_);
+        get_pool_data(l, pool_name).sharing_mode_ = mode;
+    }
+
+    pool_sharing_mode partitioner::get_pool_sharing_mode(
+        std::size_t pool_index) const
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+        return get_pool_data(l, pool_index).sharing_mode_;
+    }
+
     detail::init_pool_data const& partitioner::get_pool_data(
         std::unique_lock<mutex_type>&l, std::size_t pool_index) const
     {
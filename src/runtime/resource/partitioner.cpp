@@ -259,6 +259,12 @@ namespace hpx { namespace resource
         partitioner_.set_default_pool_name(name);
     }
 
+    void partitioner::set_pool_sharing_mode(
+        std::string const& pool_name, pool_sharing_mode mode)
+    {
+        partitioner_.set_pool_sharing_mode(pool_name, mode);
+    }
+
     const std::string & partitioner::get_default_pool_name() const {
         return partitioner_.get_default_pool_name();
     }
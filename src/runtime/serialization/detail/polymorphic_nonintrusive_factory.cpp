@@ -7,6 +7,11 @@
 //  http://www.boost.org/LICENSE_1_0.txt)
 
 #include <hpx/runtime/serialization/detail/polymorphic_nonintrusive_factory.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <cstdint>
+#include <string>
+#include <typeinfo>
 
 namespace hpx { namespace serialization { namespace detail
 {
@@ -15,5 +20,51 @@ namespace hpx { namespace serialization { namespace detail
         hpx::util::static_<polymorphic_nonintrusive_factory> factory;
         return factory.get();
     }
-}}}
 
+    void polymorphic_nonintrusive_factory::register_class(
+        const std::type_info& typeinfo, const std::string& class_name,
+        const function_bunch_type& bunch)
+    {
+        if(!typeinfo.name() && std::string(typeinfo.name()).empty())
+        {
+            HPX_THROW_EXCEPTION(serialization_error
+              , "polymorphic_nonintrusive_factory::register_class"
+              , "Cannot register a factory with an empty type name");
+        }
+        if(class_name.empty())
+        {
+            HPX_THROW_EXCEPTION(serialization_error
+              , "polymorphic_nonintrusive_factory::register_class"
+              , "Cannot register a factory with an empty name");
+        }
+
+        // the same class may be registered by several modules
+        std::uint64_t id = get_id(class_name.c_str());
+        auto p = name_map_.emplace(id, class_name);
+        if (!p.second && p.first->second != class_name)
+        {
+            HPX_THROW_EXCEPTION(serialization_error
+              , "polymorphic_nonintrusive_factory::register_class"
+              , "The serialization ids of the classes '" + class_name +
+                "' and '" + p.first->second + "' collide, please register "
+                "one of them using a different name");
+        }
+
+        map_.emplace(id, bunch);
+        typeinfo_map_.emplace(typeinfo.name(), id);
+    }
+
+    function_bunch_type const& polymorphic_nonintrusive_factory::get_bunch(
+        std::uint64_t id) const
+    {
+        serializer_map_type::const_iterator it = map_.find(id);
+        if (it == map_.end())
+        {
+            HPX_THROW_EXCEPTION(serialization_error
+              , "polymorphic_nonintrusive_factory::get_bunch"
+              , "Unknown serialization id " + std::to_string(id) +
+                ", the class was not registered on this locality");
+        }
+        return it->second;
+    }
+}}}
@@ -0,0 +1,94 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/serialization/receive_buffer_registry.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/static.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace hpx { namespace serialization
+{
+    namespace detail
+    {
+        class receive_buffer_registry
+        {
+            typedef lcos::local::spinlock mutex_type;
+
+            struct entry
+            {
+                void* data_;
+                std::size_t bytes_;
+            };
+
+        public:
+            receive_buffer_registry()
+              : next_(0)
+            {}
+
+            static receive_buffer_registry& instance()
+            {
+                util::static_<receive_buffer_registry> inst;
+                return inst.get();
+            }
+
+            std::uint64_t add(void* data, std::size_t bytes)
+            {
+                // the locality id is part of the key, keys created on other
+                // localities never match one registered here
+                std::uint64_t prefix =
+                    std::uint64_t(hpx::get_locality_id() & 0xffffff) << 40;
+
+                std::lock_guard<mutex_type> l(mtx_);
+                std::uint64_t key = prefix | (++next_ & 0xffffffffffull);
+                entry e = { data, bytes };
+                buffers_[key] = e;
+                return key;
+            }
+
+            void remove(std::uint64_t key)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                buffers_.erase(key);
+            }
+
+            void* find(std::uint64_t key, std::size_t bytes)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                auto it = buffers_.find(key);
+                if (it == buffers_.end() || it->second.bytes_ < bytes)
+                    return nullptr;
+                return it->second.data_;
+            }
+
+        private:
+            mutex_type mtx_;
+            std::uint64_t next_;
+            std::unordered_map<std::uint64_t, entry> buffers_;
+        };
+
+        void* find_receive_buffer(std::uint64_t key, std::size_t bytes)
+        {
+            return receive_buffer_registry::instance().find(key, bytes);
+        }
+    }
+
+    std::uint64_t register_receive_buffer(void* data, std::size_t bytes)
+    {
+        HPX_ASSERT(data != nullptr || bytes == 0);
+        return detail::receive_buffer_registry::instance().add(data, bytes);
+    }
+
+    void unregister_receive_buffer(std::uint64_t key)
+    {
+        detail::receive_buffer_registry::instance().remove(key);
+    }
+}}
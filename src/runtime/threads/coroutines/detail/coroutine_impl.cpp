@@ -108,4 +108,49 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         // should not get here, never
         HPX_ASSERT(this->m_state == super_type::ctx_running);
     }
+
+    coroutine_impl::result_type coroutine_impl::run_inline(arg_type arg,
+        inline_yield_type && inline_yield)
+    {
+        HPX_ASSERT(this->is_ready());
+
+#if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
+        ++this->m_phase;
+#endif
+        this->m_state = super_type::ctx_running;
+        this->bind_args(&arg);
+
+        // yield value once the thread function has finished executing
+        result_type result_last(
+            thread_state_enum::terminated, invalid_thread_id);
+
+        std::exception_ptr tinfo;
+        try
+        {
+            coroutine_self* old_self = coroutine_self::get_self();
+            coroutine_self self(this, old_self);
+            self.set_inline_yield(std::move(inline_yield));
+            reset_self_on_exit on_exit(&self, old_self);
+
+            result_last = m_fun(arg);
+            HPX_ASSERT(result_last.first == thread_state_enum::terminated);
+        }
+        catch (...) {
+            tinfo = std::current_exception();
+        }
+
+        this->reset();
+
+        this->m_state = super_type::ctx_exited;
+        if (tinfo)
+        {
+            this->m_exit_status = super_type::ctx_exited_abnormally;
+            this->m_type_info = tinfo;
+            std::rethrow_exception(std::move(tinfo));
+        }
+
+        this->m_exit_status = super_type::ctx_exited_return;
+        this->bind_result(result_last);
+        return result_last;
+    }
 }}}}
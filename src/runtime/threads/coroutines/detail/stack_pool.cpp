@@ -0,0 +1,293 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/coroutines/detail/stack_pool.hpp>
+
+#if defined(HPX_COROUTINES_HAVE_STACK_POOL)
+
+#include <hpx/runtime/threads/coroutines/detail/posix_utility.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/spinlock.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#include <sys/mman.h>
+
+namespace hpx { namespace threads { namespace coroutines { namespace detail {
+namespace posix
+{
+    HPX_EXPORT bool use_stack_pool = false;
+    HPX_EXPORT std::uint64_t stack_pool_idle_threshold = 1000;
+
+    namespace
+    {
+        // minimal number of stacks held by one region
+        std::size_t const min_stacks_per_region = 64;
+
+        std::atomic<std::int64_t> reserved_bytes(0);
+        std::atomic<std::int64_t> committed_bytes(0);
+
+        class region;
+
+        // all regions, used for reclaiming the memory of cold stacks
+        util::spinlock regions_mtx;
+        std::vector<region*> all_regions;
+        std::atomic<std::uint64_t> last_reclaim(0);
+
+        // The region header occupies the first page of each region, regions
+        // are aligned to their (power of two) size, which allows to find the
+        // region of a stack from its address.
+        std::size_t get_region_size(std::size_t stack_size)
+        {
+            std::size_t const size =
+                min_stacks_per_region * stack_size + EXEC_PAGESIZE;
+
+            std::size_t region_size = EXEC_PAGESIZE;
+            while (region_size < size)
+                region_size *= 2;
+            return region_size;
+        }
+
+        class region
+        {
+            struct released_stack
+            {
+                void* stack;
+                std::uint64_t timestamp;
+                bool committed;
+            };
+
+        public:
+            region(std::size_t stack_size, std::size_t region_size)
+              : stack_size_(stack_size),
+                num_stacks_((region_size - EXEC_PAGESIZE) / stack_size),
+                next_(0),
+                available_(num_stacks_)
+            {
+                static_assert(sizeof(region) <= EXEC_PAGESIZE,
+                    "the region header has to fit into one page");
+
+                released_.reserve(num_stacks_);
+            }
+
+            std::size_t get_stack_size() const
+            {
+                return stack_size_;
+            }
+
+            bool has_available_stacks() const
+            {
+                return available_.load(std::memory_order_relaxed) != 0;
+            }
+
+            void* allocate()
+            {
+                std::lock_guard<util::spinlock> l(mtx_);
+
+                // reuse the most recently released stack first, its memory
+                // is most likely still committed (and in cache)
+                if (!released_.empty())
+                {
+                    released_stack s = released_.back();
+                    released_.pop_back();
+                    --available_;
+
+                    if (!s.committed)
+                        committed_bytes += std::int64_t(stack_size_);
+                    return s.stack;
+                }
+
+                if (next_ == num_stacks_)
+                    return nullptr;
+
+                --available_;
+                committed_bytes += std::int64_t(stack_size_);
+                return reinterpret_cast<char*>(this) + EXEC_PAGESIZE +
+                    (next_++) * stack_size_;
+            }
+
+            void deallocate(void* stack)
+            {
+                std::uint64_t now = util::high_resolution_clock::now();
+
+                std::lock_guard<util::spinlock> l(mtx_);
+
+                released_.push_back(released_stack{stack, now, true});
+                ++available_;
+            }
+
+            // give the memory of stacks which have not been reused for longer
+            // than the given threshold [ns] back to the operating system
+            void reclaim(std::uint64_t now, std::uint64_t threshold)
+            {
+                std::lock_guard<util::spinlock> l(mtx_);
+
+                // released stacks are ordered by the time they were released
+                for (released_stack& s : released_)
+                {
+                    if (now - s.timestamp < threshold)
+                        break;
+
+                    if (s.committed)
+                    {
+#if defined(MADV_FREE)
+                        ::madvise(s.stack, stack_size_, MADV_FREE);
+#else
+                        ::madvise(s.stack, stack_size_, MADV_DONTNEED);
+#endif
+                        s.committed = false;
+                        committed_bytes -= std::int64_t(stack_size_);
+                    }
+                }
+            }
+
+            util::spinlock mtx_;
+
+            std::size_t const stack_size_;
+            std::size_t const num_stacks_;
+            std::size_t next_;
+            std::atomic<std::size_t> available_;
+
+            std::vector<released_stack> released_;
+        };
+
+        region* create_region(std::size_t stack_size)
+        {
+            std::size_t const region_size = get_region_size(stack_size);
+
+            // over-allocate to be able to align the region to its size
+            void* p = ::mmap(nullptr, 2 * region_size,
+                PROT_EXEC | PROT_READ | PROT_WRITE,
+#if defined(__FreeBSD__)
+                MAP_PRIVATE | MAP_ANON,
+#else
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+#endif
+                -1, 0);
+
+            if (p == MAP_FAILED)
+            {
+                if (ENOMEM == errno)
+                    throw std::runtime_error("mmap() failed to reserve thread "
+                        "stacks due to insufficient resources, add "
+                        "-Ihpx.stacks.use_stack_pool=0 to the command line");
+                else
+                    throw std::runtime_error(
+                        "mmap() failed to reserve thread stacks");
+            }
+
+            char* begin = static_cast<char*>(p);
+            char* base = reinterpret_cast<char*>(
+                (reinterpret_cast<std::uintptr_t>(begin) + region_size - 1) &
+                ~std::uintptr_t(region_size - 1));
+            char* end = begin + 2 * region_size;
+
+            if (base != begin)
+                ::munmap(begin, std::size_t(base - begin));
+            if (base + region_size != end)
+                ::munmap(base + region_size,
+                    std::size_t(end - (base + region_size)));
+
+            reserved_bytes += std::int64_t(region_size);
+
+            region* r = new (base) region(stack_size, region_size);
+            {
+                std::lock_guard<util::spinlock> l(regions_mtx);
+                all_regions.push_back(r);
+            }
+            return r;
+        }
+
+        // Check all regions for cold stacks, at most once per idle threshold
+        void reclaim_cold_stacks()
+        {
+            std::uint64_t const threshold = stack_pool_idle_threshold * 1000000;
+            std::uint64_t const now = util::high_resolution_clock::now();
+
+            std::uint64_t last = last_reclaim.load(std::memory_order_relaxed);
+            if (now - last < threshold ||
+                !last_reclaim.compare_exchange_strong(last, now))
+            {
+                return;
+            }
+
+            std::unique_lock<util::spinlock> l(regions_mtx, std::try_to_lock);
+            if (!l.owns_lock())
+                return;
+
+            for (region* r : all_regions)
+                r->reclaim(now, threshold);
+        }
+
+        region* get_region(void* stack, std::size_t stack_size)
+        {
+            std::uintptr_t const region_size = get_region_size(stack_size);
+            return reinterpret_cast<region*>(
+                reinterpret_cast<std::uintptr_t>(stack) & ~(region_size - 1));
+        }
+
+        // The regions reserved by the calling OS thread, regions are never
+        // given back to the operating system.
+        std::vector<region*>& get_owned_regions()
+        {
+            static thread_local std::vector<region*> regions;
+            return regions;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void* stack_pool::allocate(std::size_t size)
+    {
+        HPX_ASSERT(size % EXEC_PAGESIZE == 0);
+
+        std::vector<region*>& regions = get_owned_regions();
+        for (auto it = regions.rbegin(); it != regions.rend(); ++it)
+        {
+            region* r = *it;
+            if (r->get_stack_size() == size && r->has_available_stacks())
+            {
+                if (void* stack = r->allocate())
+                    return stack;
+            }
+        }
+
+        region* r = create_region(size);
+        regions.push_back(r);
+
+        void* stack = r->allocate();
+        HPX_ASSERT(stack != nullptr);
+        return stack;
+    }
+
+    void stack_pool::deallocate(void* stack, std::size_t size)
+    {
+        region* r = get_region(stack, size);
+        HPX_ASSERT(r->get_stack_size() == size);
+        r->deallocate(stack);
+
+        reclaim_cold_stacks();
+    }
+
+    std::int64_t stack_pool::get_reserved_bytes(bool)
+    {
+        return reserved_bytes.load(std::memory_order_relaxed);
+    }
+
+    std::int64_t stack_pool::get_committed_bytes(bool)
+    {
+        return committed_bytes.load(std::memory_order_relaxed);
+    }
+}}}}}
+
+#endif
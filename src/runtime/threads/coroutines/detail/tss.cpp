@@ -16,7 +16,9 @@
 
 #include <hpx/runtime/threads_fwd.hpp>
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
 
@@ -35,6 +37,85 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 #endif
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    void tss_slots::insert(tss_slot_key key,
+        std::shared_ptr<tss_cleanup_function> const& func, void* tss_data)
+    {
+        HPX_ASSERT(key.index_ < tss_num_slots);
+        slot& s = slots_[key.index_];
+
+        // the value of a key which held the slot before is orphaned, it is
+        // cleaned up as it would have been at the end of the thread
+        s.node_.reinit(func, tss_data, true);
+        s.id_ = key.id_;
+        used_ |= std::uint32_t(1) << key.index_;
+    }
+
+    void tss_slots::erase(tss_slot_key key, bool cleanup_existing)
+    {
+        HPX_ASSERT(key.index_ < tss_num_slots);
+        slot& s = slots_[key.index_];
+        if (s.id_ == key.id_)
+        {
+            s.node_.cleanup(cleanup_existing);
+            s.id_ = 0;
+            used_ &= ~(std::uint32_t(1) << key.index_);
+        }
+    }
+
+    void tss_slots::clear()
+    {
+        for (std::size_t i = 0; used_ != 0; ++i, used_ >>= 1)
+        {
+            if (used_ & 1)
+            {
+                slots_[i].node_.cleanup(true);
+                slots_[i].id_ = 0;
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        // the mask of the slots assigned to a key
+        std::atomic<std::uint32_t> assigned_tss_slots(0);
+        std::atomic<std::uint64_t> next_tss_slot_id(1);
+    }
+
+    tss_slot_key allocate_tss_slot()
+    {
+        std::uint32_t assigned = assigned_tss_slots.load();
+        for (std::size_t i = 0; i != tss_num_slots; /**/)
+        {
+            std::uint32_t const bit = std::uint32_t(1) << i;
+            if (assigned & bit)
+            {
+                ++i;
+                continue;
+            }
+
+            if (assigned_tss_slots.compare_exchange_weak(
+                    assigned, assigned | bit))
+            {
+                tss_slot_key key = { i, next_tss_slot_id++ };
+                return key;
+            }
+
+            // assigned was reloaded, try again from the first slot
+            i = 0;
+        }
+
+        tss_slot_key key = { tss_num_slots, 0 };
+        return key;
+    }
+
+    void release_tss_slot(tss_slot_key key)
+    {
+        if (key.index_ < tss_num_slots)
+            assigned_tss_slots &= ~(std::uint32_t(1) << key.index_);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     tss_storage* create_tss_storage()
     {
@@ -208,5 +289,78 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         }
 #endif
     }
-}}}}
 
+    ///////////////////////////////////////////////////////////////////////////
+    void* get_tss_data(void const* key, tss_slot_key slot)
+    {
+#ifdef HPX_HAVE_THREAD_LOCAL_STORAGE
+        if (slot.index_ == tss_num_slots)
+            return get_tss_data(key);
+
+        hpx::threads::thread_self* self = hpx::threads::get_self_ptr();
+        if (nullptr == self)
+        {
+            throw null_thread_id_exception();
+            return nullptr;
+        }
+
+        if (tss_data_node* const node = self->get_thread_tss_slots().find(slot))
+            return node->get_value();
+#endif
+        return nullptr;
+    }
+
+    void erase_tss_node(void const* key, tss_slot_key slot,
+        bool cleanup_existing)
+    {
+#ifdef HPX_HAVE_THREAD_LOCAL_STORAGE
+        if (slot.index_ == tss_num_slots)
+        {
+            erase_tss_node(key, cleanup_existing);
+            return;
+        }
+
+        hpx::threads::thread_self* self = hpx::threads::get_self_ptr();
+        if (nullptr == self)
+        {
+            throw null_thread_id_exception();
+            return;
+        }
+
+        self->get_thread_tss_slots().erase(slot, cleanup_existing);
+#endif
+    }
+
+    void set_tss_data(void const* key, tss_slot_key slot,
+        std::shared_ptr<tss_cleanup_function> const& func,
+        void* tss_data, bool cleanup_existing)
+    {
+#ifdef HPX_HAVE_THREAD_LOCAL_STORAGE
+        if (slot.index_ == tss_num_slots)
+        {
+            set_tss_data(key, func, tss_data, cleanup_existing);
+            return;
+        }
+
+        hpx::threads::thread_self* self = hpx::threads::get_self_ptr();
+        if (nullptr == self)
+        {
+            throw null_thread_id_exception();
+            return;
+        }
+
+        tss_slots& slots = self->get_thread_tss_slots();
+        if (tss_data_node* const current_node = slots.find(slot))
+        {
+            if (func || (tss_data != nullptr))
+                current_node->reinit(func, tss_data, cleanup_existing);
+            else
+                slots.erase(slot, cleanup_existing);
+        }
+        else if (func || (tss_data != nullptr))
+        {
+            slots.insert(slot, func, tss_data);
+        }
+#endif
+    }
+}}}}
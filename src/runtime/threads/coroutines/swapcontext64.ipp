@@ -39,6 +39,20 @@
 //
 //     NOTE: popl is slightly better than mov+add to pop registers
 //           so is pushl rather than mov+sub.
+//
+//     Only the registers which are callee-saved in the System V ABI are
+//     saved (rbx, rbp and r12-r15), everything else is clobbered by the
+//     call to this function anyways. The floating point control words
+//     (MXCSR and the x87 control word) are not switched either, all
+//     contexts run with the floating point environment of the OS-thread
+//     executing them.
+//
+//     If indirect branch tracking is enabled (-fcf-protection), the entry
+//     points start with endbr64 and the final jump is exempt from tracking
+//     as it goes to a return address. Shadow stacks are not supported, the
+//     jump does not pop the return address pushed by the call. Objects
+//     containing this code must not be marked as shadow stack compatible
+//     (see src/CMakeLists.txt).
 
 #if defined(__APPLE__)
 #define HPX_COROUTINE_TYPE_DIRECTIVE(name)
@@ -46,6 +60,14 @@
 #define HPX_COROUTINE_TYPE_DIRECTIVE(name) ".type " #name ", @function\n\t"
 #endif
 
+#if defined(__CET__) && (__CET__ & 1)
+#define HPX_COROUTINE_ENDBR "endbr64\n\t"
+#define HPX_COROUTINE_NOTRACK "notrack "
+#else
+#define HPX_COROUTINE_ENDBR
+#define HPX_COROUTINE_NOTRACK
+#endif
+
 // Note: .align 4 below means alignment at 2^4 boundary (16 bytes
 
 #define HPX_COROUTINE_SWAPCONTEXT(name)                                       \
@@ -55,11 +77,10 @@
         ".globl " #name "\n\t"                                                \
         HPX_COROUTINE_TYPE_DIRECTIVE(name)                                    \
     #name ":\n\t"                                                             \
-        "movq  64(%rsi), %rcx\n\t"                                            \
+        HPX_COROUTINE_ENDBR                                                   \
+        "movq  48(%rsi), %rcx\n\t"                                            \
         "pushq %rbp\n\t"                                                      \
         "pushq %rbx\n\t"                                                      \
-        "pushq %rax\n\t"                                                      \
-        "pushq %rdx\n\t"                                                      \
         "pushq %r12\n\t"                                                      \
         "pushq %r13\n\t"                                                      \
         "pushq %r14\n\t"                                                      \
@@ -70,13 +91,11 @@
         "popq  %r14\n\t"                                                      \
         "popq  %r13\n\t"                                                      \
         "popq  %r12\n\t"                                                      \
-        "popq  %rdx\n\t"                                                      \
-        "popq  %rax\n\t"                                                      \
         "popq  %rbx\n\t"                                                      \
         "popq  %rbp\n\t"                                                      \
-        "movq 80(%rsi), %rdi\n\t"                                             \
+        "movq 64(%rsi), %rdi\n\t"                                             \
         "add   $8, %rsp\n\t"                                                  \
-        "jmp   *%rcx\n\t"                                                     \
+        HPX_COROUTINE_NOTRACK "jmp   *%rcx\n\t"                               \
         "ud2\n\t"                                                             \
     )                                                                         \
 /**/
@@ -85,5 +104,7 @@ HPX_COROUTINE_SWAPCONTEXT(swapcontext_stack);
 HPX_COROUTINE_SWAPCONTEXT(swapcontext_stack2);
 
 #undef HPX_COROUTINE_SWAPCONTEXT
+#undef HPX_COROUTINE_NOTRACK
+#undef HPX_COROUTINE_ENDBR
 #undef HPX_COROUTINE_TYPE_DIRECTIVE
 
@@ -0,0 +1,207 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/error_code.hpp>
+#include <hpx/runtime/threads/detail/external_inbox.hpp>
+#include <hpx/runtime/threads/policies/scheduler_base.hpp>
+#include <hpx/runtime/threads/thread_init_data.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace hpx { namespace threads { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    external_inbox::queue::queue()
+      : tail_(&stub_), head_(&stub_)
+    {}
+
+    void external_inbox::queue::push(external_task* first, external_task* last)
+    {
+        last->next_.store(nullptr, std::memory_order_relaxed);
+
+        // the only synchronizing operation of a producer, the chain becomes
+        // visible to the worker once the predecessor has been linked
+        external_task* prev = tail_.exchange(last, std::memory_order_acq_rel);
+        prev->next_.store(first, std::memory_order_release);
+    }
+
+    external_task* external_inbox::queue::pop()
+    {
+        external_task* head = head_;
+        external_task* next = head->next_.load(std::memory_order_acquire);
+
+        if (head == &stub_)
+        {
+            if (next == nullptr)
+                return nullptr;
+
+            head_ = next;
+            head = next;
+            next = next->next_.load(std::memory_order_acquire);
+        }
+
+        if (next != nullptr)
+        {
+            head_ = next;
+            return head;
+        }
+
+        // a producer has not yet linked its chain, try again later
+        if (head != tail_.load(std::memory_order_acquire))
+            return nullptr;
+
+        // the last task can be removed only once the stub is behind it
+        push(&stub_, &stub_);
+
+        next = head->next_.load(std::memory_order_acquire);
+        if (next != nullptr)
+        {
+            head_ = next;
+            return head;
+        }
+        return nullptr;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    external_inbox::external_inbox()
+      : scheduler_(nullptr), num_queues_(0)
+    {}
+
+    external_inbox::~external_inbox()
+    {
+        clear();
+    }
+
+    external_inbox& external_inbox::get()
+    {
+        static external_inbox inbox;
+        return inbox;
+    }
+
+    void external_inbox::attach(policies::scheduler_base* scheduler,
+        std::size_t num_threads)
+    {
+        HPX_ASSERT(scheduler_.load() == nullptr);
+
+        if (num_threads != num_queues_)
+        {
+            clear();
+            queues_.reset(num_threads != 0 ? new queue[num_threads] : nullptr);
+            num_queues_ = num_threads;
+        }
+        scheduler_.store(scheduler, std::memory_order_release);
+    }
+
+    void external_inbox::detach()
+    {
+        scheduler_.store(nullptr, std::memory_order_release);
+        clear();
+    }
+
+    void external_inbox::clear()
+    {
+        for (std::size_t i = 0; i != num_queues_; ++i)
+        {
+            while (external_task* task = queues_[i].pop())
+                delete task;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        // every submitting thread starts at a different inbox and continues
+        // round robin, this avoids a shared counter
+        std::size_t next_inbox()
+        {
+            static HPX_NATIVE_TLS std::size_t next = std::size_t(-1);
+            if (next == std::size_t(-1))
+            {
+                next = std::hash<std::thread::id>()(
+                    std::this_thread::get_id()) % 997;
+            }
+            return next++;
+        }
+    }
+
+    bool external_inbox::push(external_task* first, external_task* last)
+    {
+        policies::scheduler_base* scheduler =
+            scheduler_.load(std::memory_order_acquire);
+        if (scheduler == nullptr || num_queues_ == 0)
+            return false;
+
+        std::size_t num_thread = next_inbox() % num_queues_;
+        queues_[num_thread].push(first, last);
+
+        // a worker which has announced to go to sleep before the push
+        // re-checks its inbox, otherwise it is woken up here
+        scheduler->wake_idle_worker(num_thread);
+        return true;
+    }
+
+    bool external_inbox::push_bulk(std::unique_ptr<external_task>* tasks,
+        std::size_t count)
+    {
+        policies::scheduler_base* scheduler =
+            scheduler_.load(std::memory_order_acquire);
+        if (scheduler == nullptr || num_queues_ == 0)
+            return false;
+
+        // the i-th chain consists of every num_chains-th task, starting with
+        // the i-th one
+        std::size_t num_chains = (std::min)(count, num_queues_);
+        std::size_t start = next_inbox();
+        for (std::size_t i = 0; i != num_chains; ++i)
+        {
+            external_task* first = tasks[i].get();
+            external_task* last = first;
+            for (std::size_t j = i + num_chains; j < count; j += num_chains)
+            {
+                last->next_.store(tasks[j].get(), std::memory_order_relaxed);
+                last = tasks[j].get();
+            }
+
+            std::size_t num_thread = (start + i) % num_queues_;
+            queues_[num_thread].push(first, last);
+            scheduler->wake_idle_worker(num_thread);
+        }
+
+        for (std::size_t i = 0; i != count; ++i)
+            tasks[i].release();
+
+        return true;
+    }
+
+    std::size_t external_inbox::drain(policies::scheduler_base* scheduler,
+        std::size_t num_thread)
+    {
+        queue& q = queues_[num_thread];
+
+        std::size_t count = 0;
+        while (external_task* t = q.pop())
+        {
+            std::unique_ptr<external_task> task(t);
+
+            thread_init_data data(std::move(task->func_), task->desc_, 0,
+                task->priority_,
+                thread_schedule_hint(static_cast<std::int16_t>(num_thread)),
+                get_stack_size(thread_stacksize_default), scheduler);
+
+            scheduler->create_thread(data, nullptr, pending, true, throws);
+            ++count;
+        }
+        return count;
+    }
+}}}
@@ -0,0 +1,174 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/detail/time_slice.hpp>
+#include <hpx/runtime/threads/thread.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+#include <hpx/util/unused.hpp>
+
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <signal.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(SIGEV_THREAD_ID)
+#define HPX_TIME_SLICE_HAVE_SIGNAL
+#endif
+
+namespace hpx { namespace threads { namespace detail
+{
+    namespace
+    {
+        // the end of the time slice of the HPX thread running on this worker
+        // (in nanoseconds of the steady clock), zero if there is none
+        HPX_NATIVE_TLS std::int64_t slice_deadline = 0;
+
+        // set by the timer signal once the time slice has expired, only
+        // used if the time slice is signalled
+        HPX_NATIVE_TLS volatile std::sig_atomic_t slice_expired = 0;
+        HPX_NATIVE_TLS bool slice_signalled = false;
+
+        std::int64_t now()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+#if defined(HPX_TIME_SLICE_HAVE_SIGNAL)
+        void on_time_slice_expired(int)
+        {
+            slice_expired = 1;
+        }
+
+        // the signal handler is installed once for the process, the timer
+        // is created once for each worker thread which uses it
+        bool install_signal_handler()
+        {
+            struct sigaction sa;
+            std::memset(&sa, 0, sizeof(sa));
+            sa.sa_handler = &on_time_slice_expired;
+            sa.sa_flags = SA_RESTART;
+            sigemptyset(&sa.sa_mask);
+            return sigaction(SIGRTMIN, &sa, nullptr) == 0;
+        }
+
+        struct slice_timer
+        {
+            slice_timer()
+              : valid_(false)
+            {
+                static bool const installed = install_signal_handler();
+                if (!installed)
+                    return;
+
+                struct sigevent sev;
+                std::memset(&sev, 0, sizeof(sev));
+                sev.sigev_notify = SIGEV_THREAD_ID;
+                sev.sigev_signo = SIGRTMIN;
+#if defined(sigev_notify_thread_id)
+                sev.sigev_notify_thread_id =
+                    static_cast<pid_t>(syscall(SYS_gettid));
+#else
+                sev._sigev_un._tid = static_cast<pid_t>(syscall(SYS_gettid));
+#endif
+                valid_ = timer_create(CLOCK_MONOTONIC, &sev, &timer_) == 0;
+            }
+
+            ~slice_timer()
+            {
+                if (valid_)
+                    timer_delete(timer_);
+            }
+
+            // arm the timer for the given deadline, disarm it for zero
+            bool set(std::int64_t deadline)
+            {
+                if (!valid_)
+                    return false;
+
+                struct itimerspec spec;
+                std::memset(&spec, 0, sizeof(spec));
+                spec.it_value.tv_sec = deadline / 1000000000;
+                spec.it_value.tv_nsec = deadline % 1000000000;
+                return timer_settime(timer_, TIMER_ABSTIME, &spec, nullptr) == 0;
+            }
+
+            HPX_NON_COPYABLE(slice_timer);
+
+        private:
+            timer_t timer_;
+            bool valid_;
+        };
+
+        slice_timer& get_slice_timer()
+        {
+            static thread_local slice_timer timer;
+            return timer;
+        }
+#endif
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool time_slice_expired()
+    {
+        if (HPX_LIKELY(slice_deadline == 0))
+            return false;
+
+        if (slice_signalled)
+            return slice_expired != 0;
+
+        return now() >= slice_deadline;
+    }
+
+    void yield_if_time_slice_expired()
+    {
+        if (HPX_UNLIKELY(time_slice_expired()) && get_self_ptr() != nullptr)
+            hpx::this_thread::yield();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t time_slice_guard::start(std::int64_t time_slice,
+        bool use_signal)
+    {
+        std::int64_t previous_deadline = slice_deadline;
+        slice_deadline = now() + time_slice * 1000;
+
+        slice_expired = 0;
+        slice_signalled = false;
+
+#if defined(HPX_TIME_SLICE_HAVE_SIGNAL)
+        // the clock is read by the preemption points if the timer could not
+        // be set up
+        if (use_signal)
+            slice_signalled = get_slice_timer().set(slice_deadline);
+#else
+        HPX_UNUSED(use_signal);
+#endif
+        return previous_deadline;
+    }
+
+    void time_slice_guard::stop(std::int64_t previous_deadline)
+    {
+#if defined(HPX_TIME_SLICE_HAVE_SIGNAL)
+        // a nested scheduling loop continues the time slice of the thread
+        // it runs on
+        if (slice_signalled)
+        {
+            slice_signalled = get_slice_timer().set(previous_deadline) &&
+                previous_deadline != 0;
+        }
+#endif
+        slice_deadline = previous_deadline;
+        slice_expired = 0;
+    }
+}}}
@@ -0,0 +1,407 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/error_code.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/runtime/threads/detail/set_thread_state.hpp>
+#include <hpx/runtime/threads/detail/timer_wheel.hpp>
+#include <hpx/runtime/threads/policies/scheduler_base.hpp>
+#include <hpx/runtime/threads/thread_data.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+#include <hpx/util/steady_clock.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace hpx { namespace threads { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    timer_wheel::shard::shard()
+      : next_tick_(0), count_(0)
+    {
+        std::fill(&slots_[0][0], &slots_[0][0] + num_levels * num_slots,
+            nullptr);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    timer_wheel::timer_wheel()
+      : enabled_(util::safe_lexical_cast<int>(
+            get_config_entry("hpx.timer_wheel.enabled", 0), 0) != 0),
+        resolution_((std::max)(util::safe_lexical_cast<std::int64_t>(
+            get_config_entry("hpx.timer_wheel.resolution", 100), 100),
+            std::int64_t(1)) * 1000),
+        epoch_(util::steady_clock::now()),
+        count_(0)
+    {
+        std::size_t num_shards =
+            (std::max)(threads::hardware_concurrency(), std::size_t(1));
+
+        shards_.reserve(num_shards);
+        for (std::size_t i = 0; i != num_shards; ++i)
+            shards_.emplace_back(new shard);
+    }
+
+    timer_wheel::~timer_wheel()
+    {
+        // timeouts still registered at this point will never fire, release
+        // the entries owned by the wheel
+        for (std::unique_ptr<shard> const& s : shards_)
+        {
+            for (std::size_t level = 0; level != num_levels; ++level)
+            {
+                for (std::size_t slot = 0; slot != num_slots; ++slot)
+                {
+                    timer_wheel_entry* e = s->slots_[level][slot];
+                    while (e != nullptr)
+                    {
+                        timer_wheel_entry* next = e->next_;
+                        if (e->owned_)
+                            delete e;
+                        e = next;
+                    }
+                }
+            }
+        }
+    }
+
+    timer_wheel& timer_wheel::get()
+    {
+        static timer_wheel wheel;
+        return wheel;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::uint64_t timer_wheel::current_tick() const
+    {
+        std::int64_t elapsed = std::chrono::duration_cast<
+                std::chrono::nanoseconds
+            >(util::steady_clock::now() - epoch_).count();
+        return elapsed > 0 ? std::uint64_t(elapsed / resolution_) : 0;
+    }
+
+    // round up, timeouts never fire before their expiration time
+    std::uint64_t timer_wheel::expiry_tick(
+        util::steady_time_point const& abs_time) const
+    {
+        std::int64_t elapsed = std::chrono::duration_cast<
+                std::chrono::nanoseconds
+            >(abs_time.value() - epoch_).count();
+        return elapsed > 0 ?
+            std::uint64_t((elapsed + resolution_ - 1) / resolution_) : 0;
+    }
+
+    timer_wheel::shard& timer_wheel::get_shard()
+    {
+        std::size_t num_thread = hpx::get_worker_thread_num();
+        if (num_thread == std::size_t(-1))
+            num_thread = 0;
+        return *shards_[num_thread % shards_.size()];
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void timer_wheel::insert(timer_wheel_entry& e,
+        util::steady_time_point const& abs_time)
+    {
+        HPX_ASSERT(e.state_.load() != timer_wheel_entry::state_queued);
+
+        shard& s = get_shard();
+
+        e.expiry_ = expiry_tick(abs_time);
+        e.shard_ = &s;
+
+        std::lock_guard<mutex_type> l(s.mtx_);
+
+        // an empty shard is not advanced by the scheduling loops, catch up
+        if (s.count_.load(std::memory_order_relaxed) == 0)
+        {
+            std::uint64_t now = current_tick();
+            if (now > s.next_tick_.load(std::memory_order_relaxed))
+                s.next_tick_.store(now, std::memory_order_relaxed);
+        }
+
+        e.state_.store(timer_wheel_entry::state_queued,
+            std::memory_order_relaxed);
+        add(s, e);
+
+        s.count_.fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void timer_wheel::insert_owned(util::steady_time_point const& abs_time,
+        thread_id_type const& thrd, thread_state_enum newstate,
+        thread_state_ex_enum newstate_ex, thread_priority priority)
+    {
+        std::unique_ptr<timer_wheel_entry> e(
+            new timer_wheel_entry(thrd, newstate, newstate_ex, priority));
+        e->owned_ = true;
+
+        insert(*e, abs_time);
+        e.release();
+    }
+
+    bool timer_wheel::cancel(timer_wheel_entry& e)
+    {
+        HPX_ASSERT(!e.owned_);
+
+        for (std::size_t k = 0; /**/; ++k)
+        {
+            int state = e.state_.load(std::memory_order_acquire);
+            if (state == timer_wheel_entry::state_queued)
+            {
+                shard& s = *static_cast<shard*>(e.shard_);
+                std::lock_guard<mutex_type> l(s.mtx_);
+
+                if (e.state_.load(std::memory_order_relaxed) ==
+                    timer_wheel_entry::state_queued)
+                {
+                    unlink(s, e);
+                    e.state_.store(timer_wheel_entry::state_done,
+                        std::memory_order_relaxed);
+
+                    s.count_.fetch_sub(1, std::memory_order_relaxed);
+                    count_.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            else if (state == timer_wheel_entry::state_firing)
+            {
+                // the entry is still referenced while being fired (timed
+                // suspension is not allowed as this would end up here again)
+                util::detail::yield_k(k & 31, "timer_wheel::cancel");
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Link the entry into the finest level covering its expiration time
+    // relative to the next tick to be processed by the shard.
+    void timer_wheel::add(shard& s, timer_wheel_entry& e)
+    {
+        std::uint64_t base = s.next_tick_.load(std::memory_order_relaxed);
+
+        // expired entries are fired when processing the next tick
+        std::uint64_t expires = (std::max)(e.expiry_, base);
+        std::uint64_t delta = expires - base;
+
+        std::size_t level = 0;
+        while (level != num_levels - 1 &&
+            delta >= (std::uint64_t(1) << ((level + 1) * slot_bits)))
+        {
+            ++level;
+        }
+
+        // timeouts beyond the range of the wheel are kept in the last slot
+        // of the coarsest level and are re-inserted once it is reached
+        std::uint64_t const max_delta =
+            (std::uint64_t(1) << (num_levels * slot_bits)) - 1;
+        if (delta > max_delta)
+            expires = base + max_delta;
+
+        std::size_t slot = std::size_t(
+            (expires >> (level * slot_bits)) & (num_slots - 1));
+
+        timer_wheel_entry*& head = s.slots_[level][slot];
+
+        e.level_ = std::uint16_t(level);
+        e.slot_ = std::uint16_t(slot);
+        e.prev_ = nullptr;
+        e.next_ = head;
+        if (head != nullptr)
+            head->prev_ = &e;
+        head = &e;
+    }
+
+    void timer_wheel::unlink(shard& s, timer_wheel_entry& e)
+    {
+        if (e.prev_ != nullptr)
+            e.prev_->next_ = e.next_;
+        else
+            s.slots_[e.level_][e.slot_] = e.next_;
+
+        if (e.next_ != nullptr)
+            e.next_->prev_ = e.prev_;
+
+        e.prev_ = nullptr;
+        e.next_ = nullptr;
+    }
+
+    // Move all entries of the given slot to the finer levels
+    void timer_wheel::cascade(shard& s, std::size_t level, std::size_t slot)
+    {
+        timer_wheel_entry* e = s.slots_[level][slot];
+        s.slots_[level][slot] = nullptr;
+
+        while (e != nullptr)
+        {
+            timer_wheel_entry* next = e->next_;
+            add(s, *e);
+            e = next;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t timer_wheel::poll_shards()
+    {
+        std::uint64_t now = current_tick();
+
+        std::size_t fired = 0;
+        for (std::unique_ptr<shard> const& s : shards_)
+        {
+            if (s->count_.load(std::memory_order_relaxed) != 0 &&
+                now >= s->next_tick_.load(std::memory_order_relaxed))
+            {
+                fired += poll_shard(*s, now);
+            }
+        }
+        return fired;
+    }
+
+    std::size_t timer_wheel::poll_shard(shard& s, std::uint64_t now)
+    {
+        // shards are advanced by one worker thread at a time
+        std::unique_lock<mutex_type> l(s.mtx_, std::try_to_lock);
+        if (!l.owns_lock())
+            return 0;
+
+        timer_wheel_entry* expired = nullptr;
+        std::size_t count = 0;
+
+        std::uint64_t tick = s.next_tick_.load(std::memory_order_relaxed);
+        while (tick <= now && s.count_.load(std::memory_order_relaxed) != 0)
+        {
+            std::size_t slot = std::size_t(tick & (num_slots - 1));
+
+            // refill the finer levels whenever a level wraps around
+            if (slot == 0)
+            {
+                for (std::size_t level = 1; level != num_levels; ++level)
+                {
+                    std::size_t next_slot = std::size_t(
+                        (tick >> (level * slot_bits)) & (num_slots - 1));
+                    cascade(s, level, next_slot);
+                    if (next_slot != 0)
+                        break;
+                }
+            }
+
+            timer_wheel_entry* e = s.slots_[0][slot];
+            s.slots_[0][slot] = nullptr;
+
+            while (e != nullptr)
+            {
+                timer_wheel_entry* next = e->next_;
+
+                e->state_.store(timer_wheel_entry::state_firing,
+                    std::memory_order_relaxed);
+                e->prev_ = nullptr;
+                e->next_ = expired;
+                expired = e;
+                ++count;
+
+                e = next;
+            }
+
+            s.next_tick_.store(++tick, std::memory_order_relaxed);
+        }
+
+        s.count_.fetch_sub(count, std::memory_order_relaxed);
+        count_.fetch_sub(count, std::memory_order_relaxed);
+
+        if (s.count_.load(std::memory_order_relaxed) == 0 && tick <= now)
+            s.next_tick_.store(now + 1, std::memory_order_relaxed);
+
+        l.unlock();
+
+        // wake the threads outside of the lock
+        while (expired != nullptr)
+        {
+            timer_wheel_entry* next = expired->next_;
+            fire(expired);
+            expired = next;
+        }
+
+        return count;
+    }
+
+    void timer_wheel::fire(timer_wheel_entry* e)
+    {
+        if (e->owned_)
+        {
+            error_code ec(lightweight);     // do not throw
+            detail::set_thread_state(e->thrd_, e->newstate_, e->newstate_ex_,
+                e->priority_, thread_schedule_hint(), ec);
+            delete e;
+            return;
+        }
+
+        // The waiting thread may have been woken up by other means in the
+        // meantime, in which case it is going to cancel this entry before
+        // suspending again. Only a thread which is still suspended is
+        // woken, as otherwise its next suspension would be cut short.
+        thread_id_type thrd = e->thrd_;
+        thread_state previous_state = thrd->get_state();
+
+        switch (previous_state.state())
+        {
+        case suspended:
+            if (thrd->restore_state(e->newstate_, e->newstate_ex_,
+                    previous_state))
+            {
+                thread_schedule_hint schedulehint;
+                policies::scheduler_base* scheduler =
+                    thrd->get_scheduler_base();
+
+                scheduler->schedule_thread(thrd.get(), schedulehint, false,
+                    thrd->get_priority());
+                scheduler->do_some_work(schedulehint.hint);
+                break;
+            }
+
+            // the state has changed since we fetched it, retry later
+            HPX_FALLTHROUGH;
+
+        case active:
+            // the thread has not suspended yet (or it is about to cancel
+            // the entry), try again once the next tick has been reached
+            requeue(*e);
+            return;
+
+        default:
+            break;
+        }
+
+        // the entry may be destroyed right after this
+        e->state_.store(timer_wheel_entry::state_done,
+            std::memory_order_release);
+    }
+
+    void timer_wheel::requeue(timer_wheel_entry& e)
+    {
+        shard& s = *static_cast<shard*>(e.shard_);
+        std::lock_guard<mutex_type> l(s.mtx_);
+
+        e.expiry_ = 0;
+        e.state_.store(timer_wheel_entry::state_queued,
+            std::memory_order_release);
+        add(s, e);
+
+        s.count_.fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+    }
+}}}
@@ -0,0 +1,355 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/exception.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/resource/detail/partitioner.hpp>
+#include <hpx/runtime/shutdown_function.hpp>
+#include <hpx/runtime/startup_function.hpp>
+#include <hpx/runtime/thread_pool_helpers.hpp>
+#include <hpx/runtime/threads/elastic_controller.hpp>
+#include <hpx/runtime/threads/policies/scheduler_base.hpp>
+#include <hpx/runtime/threads/policies/scheduler_mode.hpp>
+#include <hpx/runtime/threads/thread_pool_base.hpp>
+#include <hpx/state.hpp>
+#include <hpx/util/logging.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hpx { namespace threads
+{
+    ///////////////////////////////////////////////////////////////////////////
+    elastic_controller_parameters::elastic_controller_parameters()
+      : interval_(hpx::util::safe_lexical_cast<std::int64_t>(
+            hpx::get_config_entry("hpx.elasticity.interval", 100), 100))
+      , hysteresis_(hpx::util::safe_lexical_cast<std::size_t>(
+            hpx::get_config_entry("hpx.elasticity.hysteresis", 3), 3))
+      , min_threads_(hpx::util::safe_lexical_cast<std::size_t>(
+            hpx::get_config_entry("hpx.elasticity.min_threads", 1), 1))
+      , grow_queue_length_(hpx::util::safe_lexical_cast<std::int64_t>(
+            hpx::get_config_entry("hpx.elasticity.grow_queue_length", 4), 4))
+      , grow_idle_rate_(hpx::util::safe_lexical_cast<std::int64_t>(
+            hpx::get_config_entry("hpx.elasticity.grow_idle_rate", 500), 500))
+      , shrink_idle_rate_(hpx::util::safe_lexical_cast<std::int64_t>(
+            hpx::get_config_entry("hpx.elasticity.shrink_idle_rate", 5000),
+            5000))
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    elastic_controller::pool_data::pool_data(thread_pool_base* pool)
+      : pool_(pool)
+#if defined(HPX_HAVE_THREAD_IDLE_RATES)
+      , exec_time_(pool->get_cumulative_exec_time())
+      , tfunc_time_(pool->get_cumulative_tfunc_time())
+#else
+      , exec_time_(0)
+      , tfunc_time_(0)
+#endif
+      , overloaded_(0)
+      , underloaded_(0)
+    {}
+
+    elastic_controller::elastic_controller(
+            std::vector<std::string> const& pools,
+            elastic_controller_parameters const& params)
+      : params_(params)
+      , timer_([this]() { return evaluate(); },
+            (std::max)(params.interval_, std::int64_t(1)) * 1000,
+            "hpx::threads::elastic_controller", true)
+    {
+        params_.hysteresis_ = (std::max)(params_.hysteresis_, std::size_t(1));
+        params_.min_threads_ = (std::max)(params_.min_threads_, std::size_t(1));
+
+        pools_.reserve(pools.size());
+        for (std::string const& name : pools)
+        {
+            thread_pool_base& pool = hpx::resource::get_thread_pool(name);
+            if (!(pool.get_scheduler_mode() & policies::enable_elasticity) ||
+                pool.get_scheduler() == nullptr)
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "elastic_controller::elastic_controller",
+                    "the thread pool '" + name + "' does not support "
+                    "suspending processing units, it has to be created with "
+                    "threads::policies::enable_elasticity");
+            }
+            pools_.emplace_back(&pool);
+        }
+    }
+
+    elastic_controller::~elastic_controller()
+    {
+        timer_.stop();
+    }
+
+    bool elastic_controller::start()
+    {
+        return timer_.start(false);
+    }
+
+    bool elastic_controller::stop()
+    {
+        return timer_.stop();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Return the idle rate of the pool since the last evaluation [0.01%], or
+    // -1 if it is not known.
+    std::int64_t elastic_controller::get_idle_rate(pool_data& data) const
+    {
+#if defined(HPX_HAVE_THREAD_IDLE_RATES)
+        std::int64_t exec_time = data.pool_->get_cumulative_exec_time();
+        std::int64_t tfunc_time = data.pool_->get_cumulative_tfunc_time();
+
+        std::int64_t exec_delta = exec_time - data.exec_time_;
+        std::int64_t tfunc_delta = tfunc_time - data.tfunc_time_;
+
+        data.exec_time_ = exec_time;
+        data.tfunc_time_ = tfunc_time;
+
+        if (tfunc_delta <= 0 || exec_delta < 0)
+            return -1;
+
+        return std::int64_t(
+            10000. * (1. - double(exec_delta) / double(tfunc_delta)));
+#else
+        HPX_UNUSED(data);
+        return -1;
+#endif
+    }
+
+    bool elastic_controller::is_overloaded(
+        pool_data const& data, std::int64_t idle_rate) const
+    {
+        std::int64_t queue_length =
+            data.pool_->get_queue_length(std::size_t(-1), false);
+        std::int64_t active = std::int64_t(
+            data.pool_->get_active_os_thread_count());
+
+        if (queue_length > params_.grow_queue_length_ * active)
+            return true;
+
+        return idle_rate >= 0 && idle_rate < params_.grow_idle_rate_ &&
+            queue_length > 0;
+    }
+
+    bool elastic_controller::is_underloaded(
+        pool_data const& data, std::int64_t idle_rate) const
+    {
+        if (data.pool_->get_queue_length(std::size_t(-1), false) != 0)
+            return false;
+
+        return idle_rate < 0 || idle_rate > params_.shrink_idle_rate_;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        bool is_running(thread_pool_base const& pool, std::size_t virt_core)
+        {
+            return pool.get_scheduler()->get_state(virt_core).load() ==
+                state_running;
+        }
+
+        bool is_sleeping(thread_pool_base const& pool, std::size_t virt_core)
+        {
+            return pool.get_scheduler()->get_state(virt_core).load() ==
+                state_sleeping;
+        }
+    }
+
+    // A suspended processing unit of the pool is resumed, if it is active in
+    // another controlled pool it is moved from there.
+    void elastic_controller::grow(pool_data& data)
+    {
+        auto& rp = hpx::resource::get_partitioner();
+        thread_pool_base& pool = *data.pool_;
+
+        std::size_t num_threads = pool.get_os_thread_count();
+        for (std::size_t i = 0; i != num_threads; ++i)
+        {
+            if (!is_sleeping(pool, i))
+                continue;
+
+            std::size_t pu_num = rp.get_pu_num(pool.get_thread_offset() + i);
+
+            // find the controlled pools actively using the same processing
+            // unit, those have to release it first
+            thread_pool_base* owner = nullptr;
+            std::size_t owner_core = 0;
+            bool can_move = true;
+            for (pool_data const& other : pools_)
+            {
+                if (&other == &data)
+                    continue;
+
+                thread_pool_base& other_pool = *other.pool_;
+                std::size_t other_threads = other_pool.get_os_thread_count();
+                for (std::size_t j = 0; j != other_threads; ++j)
+                {
+                    if (rp.get_pu_num(other_pool.get_thread_offset() + j) !=
+                            pu_num ||
+                        !is_running(other_pool, j))
+                    {
+                        continue;
+                    }
+
+                    if (other.overloaded_ != 0 ||
+                        other_pool.get_active_os_thread_count() <=
+                            params_.min_threads_)
+                    {
+                        can_move = false;
+                    }
+                    owner = &other_pool;
+                    owner_core = j;
+                }
+            }
+
+            if (!can_move)
+                continue;
+
+            if (owner != nullptr)
+            {
+                LTM_(info) << "elastic_controller: moving processing unit "
+                    << pu_num << " from pool '" << owner->get_pool_name()
+                    << "' to pool '" << pool.get_pool_name() << "'";
+                owner->suspend_processing_unit(owner_core).get();
+            }
+            else
+            {
+                LTM_(info) << "elastic_controller: adding processing unit "
+                    << pu_num << " to pool '" << pool.get_pool_name() << "'";
+            }
+
+            pool.resume_processing_unit(i).get();
+            return;
+        }
+    }
+
+    // The running processing unit with the highest index is suspended,
+    // handing it back to the operating system.
+    void elastic_controller::shrink(pool_data& data)
+    {
+        thread_pool_base& pool = *data.pool_;
+        if (pool.get_active_os_thread_count() <= params_.min_threads_)
+            return;
+
+        std::size_t i = pool.get_os_thread_count();
+        while (i-- != 0)
+        {
+            if (!is_running(pool, i))
+                continue;
+
+            LTM_(info) << "elastic_controller: removing processing unit "
+                << hpx::resource::get_partitioner().get_pu_num(
+                       pool.get_thread_offset() + i)
+                << " from pool '" << pool.get_pool_name() << "'";
+
+            pool.suspend_processing_unit(i).get();
+            return;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool elastic_controller::evaluate()
+    {
+        for (pool_data& data : pools_)
+        {
+            std::int64_t idle_rate = get_idle_rate(data);
+
+            if (is_overloaded(data, idle_rate))
+            {
+                ++data.overloaded_;
+                data.underloaded_ = 0;
+            }
+            else if (is_underloaded(data, idle_rate))
+            {
+                ++data.underloaded_;
+                data.overloaded_ = 0;
+            }
+            else
+            {
+                data.overloaded_ = 0;
+                data.underloaded_ = 0;
+            }
+        }
+
+        for (pool_data& data : pools_)
+        {
+            try {
+                if (data.overloaded_ >= params_.hysteresis_)
+                {
+                    data.overloaded_ = 0;
+                    grow(data);
+                }
+                else if (data.underloaded_ >= params_.hysteresis_)
+                {
+                    data.underloaded_ = 0;
+                    shrink(data);
+                }
+            }
+            catch (hpx::exception const& e) {
+                LTM_(warning) << "elastic_controller: failed to resize pool '"
+                    << data.pool_->get_pool_name() << "': " << e.what();
+            }
+        }
+
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        std::unique_ptr<elastic_controller>& get_elastic_controller()
+        {
+            static std::unique_ptr<elastic_controller> controller;
+            return controller;
+        }
+
+        void register_elastic_controller()
+        {
+            std::string pools =
+                hpx::get_config_entry("hpx.elasticity.pools", "");
+
+            std::vector<std::string> names;
+            boost::algorithm::split(names, pools,
+                boost::algorithm::is_any_of(","),
+                boost::algorithm::token_compress_on);
+            for (std::string& name : names)
+                boost::algorithm::trim(name);
+            names.erase(std::remove(names.begin(), names.end(), std::string()),
+                names.end());
+
+            if (names.empty())
+                return;
+
+            register_startup_function(
+                [names]()
+                {
+                    std::unique_ptr<elastic_controller>& controller =
+                        get_elastic_controller();
+                    controller.reset(new elastic_controller(names));
+                    controller->start();
+                });
+
+            register_shutdown_function(
+                []()
+                {
+                    get_elastic_controller().reset();
+                });
+        }
+    }
+}}
@@ -0,0 +1,304 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/apply.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/parallel/executors/distributed_stealing_executor.hpp>
+#include <hpx/runtime/actions/plain_action.hpp>
+#include <hpx/runtime/find_here.hpp>
+#include <hpx/runtime/find_localities.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/unlock_guard.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { namespace execution { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The stealable tasks queued on this locality
+    class stealing_scheduler
+    {
+    private:
+        typedef lcos::local::spinlock mutex_type;
+
+    public:
+        stealing_scheduler()
+          : capacity_(hpx::get_os_thread_count())
+          , running_(0)
+          , stealing_(false)
+          , work_available_(false)
+          , advertised_(false)
+          , random_(hpx::get_locality_id())
+        {}
+
+        static stealing_scheduler& get()
+        {
+            static stealing_scheduler scheduler;
+            return scheduler;
+        }
+
+        void enqueue(stealable_task && task)
+        {
+            std::vector<naming::id_type> advertise_to;
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+                tasks_.push_back(std::move(task));
+
+                // let the other localities know that they can steal from
+                // this one
+                if (!advertised_ && tasks_.size() > capacity_)
+                {
+                    advertised_ = true;
+                    advertise_to = remote_localities(l);
+                }
+            }
+
+            for (naming::id_type const& locality : advertise_to)
+                advertise(locality);
+
+            schedule();
+        }
+
+        // Hand a batch of the queued tasks to the given locality
+        std::size_t steal(naming::id_type const& thief, std::size_t max_tasks)
+        {
+            std::vector<stealable_task> stolen;
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+
+                // leave at least half of the tasks to this locality
+                std::size_t count = (tasks_.size() + 1) / 2;
+                if (count > max_tasks)
+                    count = max_tasks;
+
+                stolen.reserve(count);
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    stolen.push_back(std::move(tasks_.back()));
+                    tasks_.pop_back();
+                }
+                if (tasks_.empty())
+                    advertised_ = false;
+            }
+
+            for (stealable_task& task : stolen)
+                task(thief);
+
+            return stolen.size();
+        }
+
+        // Another locality has queued more tasks than it can run
+        void work_available(naming::id_type const& victim)
+        {
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                work_available_ = true;
+                if (!is_idle())
+                    return;
+                stealing_ = true;
+            }
+            request_tasks(victim, 0);
+        }
+
+        void stolen_task_started()
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            ++running_;
+        }
+
+        void task_finished()
+        {
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                HPX_ASSERT(running_ != 0);
+                --running_;
+            }
+            schedule();
+        }
+
+    private:
+        bool is_idle() const
+        {
+            return tasks_.empty() && running_ < capacity_ && !stealing_;
+        }
+
+        std::vector<naming::id_type> remote_localities(
+            std::unique_lock<mutex_type>& l)
+        {
+            if (remote_localities_.empty())
+            {
+                std::vector<naming::id_type> localities;
+                {
+                    util::unlock_guard<std::unique_lock<mutex_type> > ul(l);
+                    localities = hpx::find_remote_localities();
+                }
+                remote_localities_ = std::move(localities);
+            }
+            return remote_localities_;
+        }
+
+        // Start queued tasks while there are idle worker threads, steal
+        // tasks if there are none left
+        void schedule()
+        {
+            std::vector<stealable_task> ready;
+            naming::id_type victim;
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+                while (running_ < capacity_ && !tasks_.empty())
+                {
+                    ready.push_back(std::move(tasks_.front()));
+                    tasks_.pop_front();
+                    ++running_;
+                }
+                if (tasks_.empty())
+                    advertised_ = false;
+
+                if (work_available_ && is_idle())
+                {
+                    victim = random_victim(l);
+                    stealing_ = victim != naming::invalid_id;
+                }
+            }
+
+            naming::id_type const here = hpx::find_here();
+            for (stealable_task& task : ready)
+            {
+                task(here).then(hpx::launch::sync,
+                    [this](hpx::future<void> &&)
+                    {
+                        task_finished();
+                    });
+            }
+
+            if (victim)
+                request_tasks(victim, 0);
+        }
+
+        naming::id_type random_victim(std::unique_lock<mutex_type>& l)
+        {
+            std::vector<naming::id_type> const& localities =
+                remote_localities(l);
+            if (localities.empty())
+                return naming::invalid_id;
+
+            std::uniform_int_distribution<std::size_t> dist(
+                0, localities.size() - 1);
+            return localities[dist(random_)];
+        }
+
+        void request_tasks(naming::id_type const& victim, std::size_t attempt);
+        void advertise(naming::id_type const& locality);
+
+        void handle_reply(std::size_t stolen, std::size_t attempt)
+        {
+            naming::id_type victim;
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+                stealing_ = false;
+
+                if (stolen != 0)
+                    return;
+
+                // give up once as many requests failed as there are other
+                // localities, wait for the next advertisement
+                if (attempt + 1 >= remote_localities(l).size())
+                {
+                    work_available_ = false;
+                    return;
+                }
+
+                if (!is_idle())
+                    return;
+
+                victim = random_victim(l);
+                stealing_ = true;
+            }
+            request_tasks(victim, attempt + 1);
+        }
+
+    private:
+        mutable mutex_type mtx_;
+        std::deque<stealable_task> tasks_;
+        std::size_t const capacity_;
+        std::size_t running_;       // including stolen tasks
+        bool stealing_;             // a steal request is in flight
+        bool work_available_;       // another locality has advertised work
+        bool advertised_;           // this locality has advertised work
+        std::vector<naming::id_type> remote_localities_;
+        std::mt19937 random_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t steal_tasks(naming::id_type const& thief, std::size_t max_tasks)
+    {
+        return stealing_scheduler::get().steal(thief, max_tasks);
+    }
+
+    void tasks_available(naming::id_type const& victim)
+    {
+        stealing_scheduler::get().work_available(victim);
+    }
+}}}}
+
+HPX_PLAIN_ACTION(hpx::parallel::execution::detail::steal_tasks,
+    distributed_stealing_steal_tasks_action);
+HPX_PLAIN_ACTION(hpx::parallel::execution::detail::tasks_available,
+    distributed_stealing_tasks_available_action);
+
+namespace hpx { namespace parallel { namespace execution { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    void stealing_scheduler::request_tasks(naming::id_type const& victim,
+        std::size_t attempt)
+    {
+        std::size_t max_tasks = 0;
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            max_tasks = capacity_ > running_ ? capacity_ - running_ : 1;
+        }
+
+        hpx::async(distributed_stealing_steal_tasks_action(), victim,
+                hpx::find_here(), max_tasks)
+            .then(hpx::launch::sync,
+                [this, attempt](hpx::future<std::size_t> && f)
+                {
+                    handle_reply(f.has_exception() ? 0 : f.get(), attempt);
+                });
+    }
+
+    void stealing_scheduler::advertise(naming::id_type const& locality)
+    {
+        hpx::apply(distributed_stealing_tasks_available_action(), locality,
+            hpx::find_here());
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void enqueue_stealable_task(stealable_task && task)
+    {
+        stealing_scheduler::get().enqueue(std::move(task));
+    }
+
+    void stolen_task_started()
+    {
+        stealing_scheduler::get().stolen_task_started();
+    }
+
+    void stolen_task_finished()
+    {
+        stealing_scheduler::get().task_finished();
+    }
+}}}}
@@ -8,6 +8,7 @@
 #include <hpx/runtime/threads/threadmanager.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/bind.hpp>
+#include <hpx/util/steady_clock.hpp>
 
 #include <cstddef>
 #include <cstdint>
@@ -21,12 +22,14 @@ namespace hpx { namespace threads { namespace executors
         pool_executor::pool_executor(std::string const& pool_name)
             : scheduled_executor_base()
             , pool_(hpx::threads::get_thread_manager().get_pool(pool_name))
+            , relative_deadline_(0)
         {}
 
         pool_executor::pool_executor(std::string const& pool_name,
                 thread_stacksize stacksize)
             : scheduled_executor_base()
             , pool_(hpx::threads::get_thread_manager().get_pool(pool_name))
+            , relative_deadline_(0)
         {
             stacksize_ = stacksize;
             priority_  = thread_priority_default;
@@ -36,11 +39,23 @@ namespace hpx { namespace threads { namespace executors
                 thread_priority priority, thread_stacksize stacksize)
             : scheduled_executor_base()
             , pool_(hpx::threads::get_thread_manager().get_pool(pool_name))
+            , relative_deadline_(0)
         {
             stacksize_ = stacksize;
             priority_  = priority;
         }
 
+        pool_executor::pool_executor(std::string const& pool_name,
+                util::steady_clock::duration const& relative_deadline,
+                thread_stacksize stacksize)
+            : scheduled_executor_base()
+            , pool_(hpx::threads::get_thread_manager().get_pool(pool_name))
+            , relative_deadline_(relative_deadline)
+        {
+            stacksize_ = stacksize;
+            priority_  = thread_priority_default;
+        }
+
         threads::thread_result_type
         pool_executor::thread_function_nullary(closure_type func)
         {
@@ -85,6 +100,8 @@ namespace hpx { namespace threads { namespace executors
             data.stacksize    = threads::get_stack_size(stacksize);
             data.priority     = priority_;
             data.schedulehint = schedulehint;
+            if (relative_deadline_ != util::steady_clock::duration(0))
+                data.deadline = util::steady_clock::now() + relative_deadline_;
 
             threads::thread_id_type id = threads::invalid_thread_id;
             pool_.create_thread(data, id, initial_state, run_now, ec);
@@ -116,6 +133,8 @@ namespace hpx { namespace threads { namespace executors
                 stacksize = stacksize_;
             data.stacksize = threads::get_stack_size(stacksize);
             data.priority = priority_;
+            if (relative_deadline_ != util::steady_clock::duration(0))
+                data.deadline = abs_time + relative_deadline_;
 
             threads::thread_id_type id = threads::invalid_thread_id;
             pool_.create_thread(data, id, suspended, true, ec);
@@ -185,4 +204,12 @@ namespace hpx { namespace threads { namespace executors
             new detail::pool_executor(pool_name, priority, stacksize))
     {
     }
+
+    pool_executor::pool_executor(std::string const& pool_name,
+            util::steady_clock::duration const& relative_deadline,
+            thread_stacksize stacksize)
+      : scheduled_executor(new detail::pool_executor(
+            pool_name, relative_deadline, stacksize))
+    {
+    }
 }}}
@@ -0,0 +1,63 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/policies/cleanup_statistics.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace hpx { namespace threads { namespace policies
+{
+    namespace
+    {
+        struct counters
+        {
+            std::atomic<std::int64_t> count_;
+            std::atomic<std::int64_t> time_;
+        };
+
+        counters& idle_counters()
+        {
+            static counters c = { {0}, {0} };
+            return c;
+        }
+
+        counters& forced_counters()
+        {
+            static counters c = { {0}, {0} };
+            return c;
+        }
+    }
+
+    std::int64_t cleanup_statistics::get_idle_count(bool reset)
+    {
+        return util::get_and_reset_value(idle_counters().count_, reset);
+    }
+
+    std::int64_t cleanup_statistics::get_idle_time(bool reset)
+    {
+        return util::get_and_reset_value(idle_counters().time_, reset);
+    }
+
+    std::int64_t cleanup_statistics::get_forced_count(bool reset)
+    {
+        return util::get_and_reset_value(forced_counters().count_, reset);
+    }
+
+    std::int64_t cleanup_statistics::get_forced_time(bool reset)
+    {
+        return util::get_and_reset_value(forced_counters().time_, reset);
+    }
+
+    void cleanup_statistics::record(bool forced, std::int64_t count,
+        std::int64_t time)
+    {
+        counters& c = forced ? forced_counters() : idle_counters();
+        c.count_.fetch_add(count, std::memory_order_relaxed);
+        c.time_.fetch_add(time, std::memory_order_relaxed);
+    }
+}}}
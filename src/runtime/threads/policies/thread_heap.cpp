@@ -0,0 +1,49 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/policies/thread_heap.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace hpx { namespace threads { namespace policies
+{
+    namespace
+    {
+        std::atomic<std::int64_t>& local_reuse_counter()
+        {
+            static std::atomic<std::int64_t> counter(0);
+            return counter;
+        }
+
+        std::atomic<std::int64_t>& remote_reuse_counter()
+        {
+            static std::atomic<std::int64_t> counter(0);
+            return counter;
+        }
+    }
+
+    std::int64_t thread_heap::get_local_reuse_count(bool reset)
+    {
+        return util::get_and_reset_value(local_reuse_counter(), reset);
+    }
+
+    std::int64_t thread_heap::get_remote_reuse_count(bool reset)
+    {
+        return util::get_and_reset_value(remote_reuse_counter(), reset);
+    }
+
+    void thread_heap::increment_local_reuse_count()
+    {
+        ++local_reuse_counter();
+    }
+
+    void thread_heap::increment_remote_reuse_count()
+    {
+        ++remote_reuse_counter();
+    }
+}}}
@@ -11,6 +11,7 @@
 #include <hpx/exception.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/runtime/naming/address.hpp>
+#include <hpx/runtime/threads/policies/scheduler_base.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/function.hpp>
 #include <hpx/util/register_locks.hpp>
@@ -19,8 +20,10 @@
 #include <hpx/util/apex.hpp>
 #endif
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <thread>
 
 // #if HPX_DEBUG
 // #  define HPX_DEBUG_THREAD_POOL 1
@@ -37,6 +40,52 @@ namespace hpx { namespace threads
     };
 #endif
 
+    thread_state_ex_enum thread_data::yield_inline(
+        coroutine_type::result_type arg)
+    {
+        HPX_ASSERT(run_to_completion_);
+
+        // the thread to run next is simply scheduled, this thread continues
+        if (arg.second)
+        {
+            thread_data* next = arg.second.get();
+            if (next->get_state().state() == pending)
+            {
+                next->get_scheduler_base()->schedule_thread(next,
+                    thread_schedule_hint(), false, next->get_priority());
+            }
+        }
+
+        if (arg.first == pending || arg.first == pending_boost)
+            return wait_signaled;
+
+        // There is no stack to switch away from, so wait in place until some
+        // other thread makes this thread pending again, see resume_inline.
+        std::int32_t expected = inline_running;
+        if (inline_state_.compare_exchange_strong(expected, inline_waiting,
+                std::memory_order_acq_rel))
+        {
+            for (std::size_t k = 0; /**/; ++k)
+            {
+                expected = inline_state_.load(std::memory_order_acquire);
+                if (expected != inline_waiting)
+                    break;
+
+#if defined(HPX_SMT_PAUSE)
+                if (k < 16)
+                {
+                    HPX_SMT_PAUSE;
+                    continue;
+                }
+#endif
+                std::this_thread::yield();
+            }
+        }
+
+        inline_state_.store(inline_running, std::memory_order_relaxed);
+        return thread_state_ex_enum(expected);
+    }
+
     void thread_data::run_thread_exit_callbacks()
     {
         mutex_type::scoped_lock l(this);
@@ -12,10 +12,12 @@
 #include <hpx/state.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/runtime/threads/detail/set_thread_state.hpp>
+#include <hpx/runtime/threads/detail/timer_wheel.hpp>
 #include <hpx/runtime/threads/executors/current_executor.hpp>
 #include <hpx/runtime/threads/thread_data_fwd.hpp>
 #include <hpx/runtime/threads/thread_enums.hpp>
 #include <hpx/runtime/threads/thread_pool_base.hpp>
+#include <hpx/runtime/threads/topology.hpp>
 #include <hpx/util/assert.hpp>
 #ifdef HPX_HAVE_THREAD_BACKTRACE_ON_SUSPENSION
 #include <hpx/util/backtrace.hpp>
@@ -29,6 +31,7 @@
 
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <sstream>
@@ -80,6 +83,22 @@ namespace hpx { namespace threads
         return hpx::threads::get_topology().get_numa_node_number(pu_num);
     }
 
+    thread_schedule_hint get_data_affinity_hint(void const* addr)
+    {
+        try {
+            int domain = hpx::threads::get_topology().get_numa_domain(addr);
+            if (domain >= 0)
+            {
+                return thread_schedule_hint(thread_schedule_hint_mode_numa,
+                    static_cast<std::int16_t>(domain));
+            }
+        }
+        catch (hpx::exception const&) {
+            // the location of the memory is unknown, don't give a hint
+        }
+        return thread_schedule_hint();
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     threads::thread_priority get_thread_priority(thread_id_type const& id,
         error_code& ec)
@@ -87,6 +106,57 @@ namespace hpx { namespace threads
         return id ? id->get_priority() : thread_priority_unknown;
     }
 
+    util::steady_clock::time_point get_thread_deadline(
+        thread_id_type const& id, error_code& ec)
+    {
+        if (HPX_UNLIKELY(!id)) {
+            HPX_THROWS_IF(ec, null_thread_id,
+                "hpx::threads::get_thread_deadline",
+                "null thread id encountered");
+            return (util::steady_clock::time_point::max)();
+        }
+
+        if (&ec != &throws)
+            ec = make_success_code();
+
+        return id->get_deadline();
+    }
+
+    void set_thread_deadline(thread_id_type const& id,
+        util::steady_time_point const& deadline, error_code& ec)
+    {
+        if (HPX_UNLIKELY(!id)) {
+            HPX_THROWS_IF(ec, null_thread_id,
+                "hpx::threads::set_thread_deadline",
+                "null thread id encountered");
+            return;
+        }
+
+        if (&ec != &throws)
+            ec = make_success_code();
+
+        id->set_deadline(deadline.value());
+    }
+
+    void inherit_thread_priority(thread_id_type const& id,
+        thread_id_type const& waiter)
+    {
+        if (!id || !waiter || id == waiter)
+            return;
+
+        thread_priority priority = waiter->get_priority();
+        if ((priority == thread_priority_high ||
+                priority == thread_priority_high_recursive) &&
+            (id->get_priority() == thread_priority_low ||
+                id->get_priority() == thread_priority_normal))
+        {
+            id->set_priority(priority);
+        }
+
+        if (waiter->get_deadline() < id->get_deadline())
+            id->set_deadline(waiter->get_deadline());
+    }
+
     /// The get_stack_size function is part of the thread related API. It
     std::ptrdiff_t get_stack_size(thread_id_type const& id, error_code& ec)
     {
@@ -552,11 +622,27 @@ namespace hpx { namespace this_thread
 #ifdef HPX_HAVE_THREAD_BACKTRACE_ON_SUSPENSION
             detail::reset_backtrace bt(id, ec);
 #endif
+            // the timer wheel wakes us up directly, otherwise a helper
+            // thread is created which has to be aborted if we are woken
+            // up by other means
+            threads::detail::timer_wheel& wheel =
+                threads::detail::timer_wheel::get();
+
+            threads::detail::timer_wheel_entry timeout(id);
             std::atomic<bool> timer_started(false);
-            threads::thread_id_type timer_id = threads::set_thread_state(id,
-                abs_time, &timer_started, threads::pending, threads::wait_timeout,
-                threads::thread_priority_boost, ec);
-            if (ec) return threads::wait_unknown;
+            threads::thread_id_type timer_id;
+
+            if (wheel.enabled())
+            {
+                wheel.insert(timeout, abs_time);
+            }
+            else
+            {
+                timer_id = threads::set_thread_state(id, abs_time,
+                    &timer_started, threads::pending, threads::wait_timeout,
+                    threads::thread_priority_boost, ec);
+                if (ec) return threads::wait_unknown;
+            }
 
             // We might need to dispatch 'nextid' to it's correct scheduler
             // only if our current scheduler is the same, we should yield the id
@@ -574,7 +660,12 @@ namespace hpx { namespace this_thread
                     threads::thread_result_type(threads::suspended, nextid));
             }
 
-            if (statex != threads::wait_timeout)
+            if (wheel.enabled())
+            {
+                // this waits for a concurrent wakeup to complete
+                wheel.cancel(timeout);
+            }
+            else if (statex != threads::wait_timeout)
             {
                 HPX_ASSERT(
                     statex == threads::wait_abort ||
@@ -13,23 +13,30 @@
 #include <hpx/exception.hpp>
 #include <hpx/error_code.hpp>
 #include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/adaptive_mutex.hpp>
 #include <hpx/lcos/wait_all.hpp>
 #include <hpx/performance_counters/counter_creators.hpp>
 #include <hpx/performance_counters/counters.hpp>
 #include <hpx/performance_counters/manage_counter_type.hpp>
 #include <hpx/runtime/actions/continuation.hpp>
+#include <hpx/runtime/config_entry.hpp>
 #include <hpx/runtime/resource/detail/partitioner.hpp>
 #include <hpx/runtime/thread_pool_helpers.hpp>
+#include <hpx/runtime/threads/coroutines/detail/stack_pool.hpp>
+#include <hpx/runtime/threads/detail/external_inbox.hpp>
 #include <hpx/runtime/threads/detail/scheduled_thread_pool.hpp>
 #include <hpx/runtime/threads/detail/set_thread_state.hpp>
 #include <hpx/runtime/threads/executors/current_executor.hpp>
 #include <hpx/runtime/threads/policies/schedulers.hpp>
+#include <hpx/runtime/threads/policies/cleanup_statistics.hpp>
+#include <hpx/runtime/threads/policies/thread_heap.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/runtime/threads/thread_init_data.hpp>
 #include <hpx/runtime/threads/threadmanager.hpp>
 #include <hpx/runtime/threads/topology.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/bind.hpp>
 #include <hpx/util/bind_back.hpp>
 #include <hpx/util/bind_front.hpp>
 #include <hpx/util/block_profiler.hpp>
@@ -63,6 +70,24 @@ namespace hpx { namespace threads { namespace policies
 }}}
 #endif
 
+#ifdef HPX_HAVE_THREAD_IDLE_RATES
+namespace hpx { namespace threads { namespace policies
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // We control whether to collect idle rates and thread execution times
+    // using this global bool. It will be set by any of the related
+    // performance counters or by the configuration setting
+    // hpx.thread_instrumentation. Once set it stays set, thus no race
+    // conditions will occur.
+    HPX_EXPORT bool maintain_idle_rates = false;
+
+#ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
+    // The same for the thread creation and cleanup times.
+    HPX_EXPORT bool maintain_creation_and_cleanup_rates = false;
+#endif
+}}}
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx {
 
@@ -606,6 +631,42 @@ namespace hpx { namespace threads
 #endif
                 break;
             }
+
+            case resource::hierarchical_priority:
+            {
+#if defined(HPX_HAVE_HIERARCHICAL_SCHEDULER)
+                // set parameters for scheduler and pool instantiation and
+                // perform compatibility checks
+                std::size_t num_high_priority_queues =
+                    hpx::detail::get_num_high_priority_queues(
+                        cfg_, rp.get_num_threads(name));
+
+                // instantiate the scheduler
+                typedef hpx::threads::policies::
+                    hierarchical_queue_scheduler<>
+                        local_sched_type;
+                local_sched_type::init_parameter_type init(num_threads_in_pool,
+                    num_high_priority_queues, 1000, cfg_.numa_sensitive_,
+                    "core-hierarchical_queue_scheduler");
+                std::unique_ptr<local_sched_type> sched(
+                    new local_sched_type(init));
+
+                // instantiate the pool
+                std::unique_ptr<thread_pool_base> pool(
+                    new hpx::threads::detail::scheduled_thread_pool<
+                            local_sched_type
+                        >(std::move(sched),
+                        notifier_, i, name.c_str(), scheduler_mode,
+                        thread_offset));
+                pools_.push_back(std::move(pool));
+#else
+                throw hpx::detail::command_line_error(
+                    "Command line option --hpx:queuing=hierarchical-priority "
+                    "is not configured in this build. Please rebuild with "
+                    "'cmake -DHPX_WITH_THREAD_SCHEDULERS=hierarchical-priority'.");
+#endif
+                break;
+            }
             }
 
             // update the thread_offset for the next pool
@@ -621,10 +682,43 @@ namespace hpx { namespace threads
                 threads_lookup_.push_back(pool_iter->get_pool_id());
             }
         }
+
+        // let the borrowing pools execute work of the lending pools
+        std::vector<policies::scheduler_base*> lenders;
+        for (auto& pool_iter : pools_)
+        {
+            policies::scheduler_base* sched = pool_iter->get_scheduler();
+            if (sched != nullptr &&
+                (rp.get_pool_sharing_mode(pool_iter->get_pool_index()) &
+                    resource::sharing_lender))
+            {
+                lenders.push_back(sched);
+            }
+        }
+
+        for (auto& pool_iter : pools_)
+        {
+            policies::scheduler_base* sched = pool_iter->get_scheduler();
+            if (sched == nullptr ||
+                !(rp.get_pool_sharing_mode(pool_iter->get_pool_index()) &
+                    resource::sharing_borrower))
+            {
+                continue;
+            }
+
+            std::vector<policies::scheduler_base*> pool_lenders;
+            for (policies::scheduler_base* lender : lenders)
+            {
+                if (lender != sched)
+                    pool_lenders.push_back(lender);
+            }
+            sched->set_lenders(std::move(pool_lenders));
+        }
     }
 
     threadmanager::~threadmanager()
     {
+        detail::external_inbox::get().detach();
     }
 
     void threadmanager::init()
@@ -640,6 +734,21 @@ namespace hpx { namespace threads
             pool_iter->init(num_threads_in_pool, threads_offset);
             threads_offset += num_threads_in_pool;
         }
+
+        // collect the data for the thread timing counters from the start,
+        // if requested
+        if (hpx::get_config_entry("hpx.thread_instrumentation", "0") == "1")
+        {
+#ifdef HPX_HAVE_THREAD_IDLE_RATES
+            policies::maintain_idle_rates = true;
+#ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
+            policies::maintain_creation_and_cleanup_rates = true;
+#endif
+#endif
+#ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
+            policies::maintain_queue_wait_times = true;
+#endif
+        }
     }
 
     void threadmanager::print_pools(std::ostream& os)
@@ -814,6 +923,22 @@ namespace hpx { namespace threads
         pool->create_work(data, initial_state, ec);
     }
 
+    void threadmanager::register_threads(std::vector<thread_init_data>& data,
+        thread_state_enum initial_state, error_code& ec)
+    {
+        thread_pool_base *pool = nullptr;
+        if (get_self_ptr())
+        {
+            auto tid = get_self_id();
+            pool = tid->get_scheduler_base()->get_parent_pool();
+        }
+        else
+        {
+            pool = &default_pool();
+        }
+        pool->create_threads(data, initial_state, ec);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     HPX_CONSTEXPR std::size_t all_threads = std::size_t(-1);
 
@@ -1016,6 +1141,22 @@ namespace hpx { namespace threads
             result += pool_iter->get_num_stolen_to_staged(all_threads, reset);
         return result;
     }
+
+    std::int64_t threadmanager::get_num_successful_steals(bool reset)
+    {
+        std::int64_t result = 0;
+        for (auto const& pool_iter : pools_)
+            result += pool_iter->get_num_successful_steals(all_threads, reset);
+        return result;
+    }
+
+    std::int64_t threadmanager::get_num_failed_steals(bool reset)
+    {
+        std::int64_t result = 0;
+        for (auto const& pool_iter : pools_)
+            result += pool_iter->get_num_failed_steals(all_threads, reset);
+        return result;
+    }
 #endif
 
     ///////////////////////////////////////////////////////////////////////////
@@ -1037,6 +1178,43 @@ namespace hpx { namespace threads
     }
 #endif
 
+    naming::gid_type threadmanager::idle_rate_counter_creator(
+        threadmanager_counter_func total_func,
+        threadpool_counter_func pool_func,
+        performance_counters::counter_info const& info, error_code& ec)
+    {
+        naming::gid_type gid = locality_pool_thread_counter_creator(
+            total_func, pool_func, info, ec);
+
+#ifdef HPX_HAVE_THREAD_IDLE_RATES
+        if (!ec)
+            policies::maintain_idle_rates = true;
+#endif
+
+        return gid;
+    }
+
+#ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
+    naming::gid_type threadmanager::creation_and_cleanup_rate_counter_creator(
+        threadmanager_counter_func total_func,
+        threadpool_counter_func pool_func,
+        performance_counters::counter_info const& info, error_code& ec)
+    {
+        naming::gid_type gid = locality_pool_thread_counter_creator(
+            total_func, pool_func, info, ec);
+
+        if (!ec)
+        {
+            // the creation and cleanup idle rates are relative to the idle
+            // rates
+            policies::maintain_idle_rates = true;
+            policies::maintain_creation_and_cleanup_rates = true;
+        }
+
+        return gid;
+    }
+#endif
+
     naming::gid_type threadmanager::locality_pool_thread_counter_creator(
         threadmanager_counter_func total_func,
         threadpool_counter_func pool_func,
@@ -1369,12 +1547,52 @@ namespace hpx { namespace threads
                 util::bind_front(
                     &coroutine_type::impl_type::get_stack_recycle_count),
                 util::function_nonser<std::uint64_t(bool)>(), "", 0},
+            // /threads{locality#%d/total}/count/stack-recycles-local
+            {"count/stack-recycles-local",
+                util::bind_front(
+                    &policies::thread_heap::get_local_reuse_count),
+                util::function_nonser<std::uint64_t(bool)>(), "", 0},
+            // /threads{locality#%d/total}/count/stack-recycles-remote
+            {"count/stack-recycles-remote",
+                util::bind_front(
+                    &policies::thread_heap::get_remote_reuse_count),
+                util::function_nonser<std::uint64_t(bool)>(), "", 0},
+            // /threads{locality#%d/total}/count/cleanup-idle
+            {"count/cleanup-idle",
+                util::bind_front(&policies::cleanup_statistics::get_idle_count),
+                util::function_nonser<std::uint64_t(bool)>(), "", 0},
+            // /threads{locality#%d/total}/count/cleanup-forced
+            {"count/cleanup-forced",
+                util::bind_front(
+                    &policies::cleanup_statistics::get_forced_count),
+                util::function_nonser<std::uint64_t(bool)>(), "", 0},
+            // /threads{locality#%d/total}/time/cleanup-idle
+            {"time/cleanup-idle",
+                util::bind_front(&policies::cleanup_statistics::get_idle_time),
+                util::function_nonser<std::uint64_t(bool)>(), "", 0},
+            // /threads{locality#%d/total}/time/cleanup-forced
+            {"time/cleanup-forced",
+                util::bind_front(
+                    &policies::cleanup_statistics::get_forced_time),
+                util::function_nonser<std::uint64_t(bool)>(), "", 0},
 #if !defined(HPX_WINDOWS) && !defined(HPX_HAVE_GENERIC_CONTEXT_COROUTINES)
             // /threads{locality#%d/total}/count/stack-unbinds
             {"count/stack-unbinds",
                 util::bind_front(
                     &coroutine_type::impl_type::get_stack_unbind_count),
                 util::function_nonser<std::uint64_t(bool)>(), "", 0},
+#endif
+#if defined(HPX_COROUTINES_HAVE_STACK_POOL)
+            // /threads{locality#%d/total}/count/stack-pool-reserved
+            {"count/stack-pool-reserved",
+                util::bind_front(&coroutines::detail::posix::stack_pool::
+                        get_reserved_bytes),
+                util::function_nonser<std::uint64_t(bool)>(), "", 0},
+            // /threads{locality#%d/total}/count/stack-pool-committed
+            {"count/stack-pool-committed",
+                util::bind_front(&coroutines::detail::posix::stack_pool::
+                        get_committed_bytes),
+                util::function_nonser<std::uint64_t(bool)>(), "", 0},
 #endif
         };
         std::size_t const data_size = sizeof(data)/sizeof(data[0]);
@@ -1397,6 +1615,9 @@ namespace hpx { namespace threads
     ///////////////////////////////////////////////////////////////////////////
     void threadmanager::register_counter_types()
     {
+        using util::placeholders::_1;
+        using util::placeholders::_2;
+
         performance_counters::create_counter_func counts_creator(util::bind_front(
             &threadmanager::thread_counts_counter_creator, this));
 
@@ -1437,7 +1658,7 @@ namespace hpx { namespace threads
             {"/threads/idle-rate", performance_counters::counter_raw,
                 "returns the idle rate for the referenced object",
                 HPX_PERFORMANCE_COUNTER_V1,
-                util::bind_front(&threadmanager::locality_pool_thread_counter_creator,
+                util::bind_front(&threadmanager::idle_rate_counter_creator,
                     this, &threadmanager::avg_idle_rate,
                     &thread_pool_base::avg_idle_rate),
                 &performance_counters::locality_pool_thread_counter_discoverer,
@@ -1447,7 +1668,8 @@ namespace hpx { namespace threads
                 "returns the % of idle-rate spent creating HPX-threads for the "
                 "referenced object",
                 HPX_PERFORMANCE_COUNTER_V1,
-                util::bind_front(&threadmanager::locality_pool_thread_counter_creator,
+                util::bind_front(
+                    &threadmanager::creation_and_cleanup_rate_counter_creator,
                     this, &threadmanager::avg_creation_idle_rate,
                     &thread_pool_base::avg_creation_idle_rate),
                 &performance_counters::locality_pool_thread_counter_discoverer,
@@ -1456,7 +1678,8 @@ namespace hpx { namespace threads
                 "returns the % of time spent cleaning up terminated "
                 "HPX-threads for the referenced object",
                 HPX_PERFORMANCE_COUNTER_V1,
-                util::bind_front(&threadmanager::locality_pool_thread_counter_creator,
+                util::bind_front(
+                    &threadmanager::creation_and_cleanup_rate_counter_creator,
                     this, &threadmanager::avg_cleanup_idle_rate,
                     &thread_pool_base::avg_cleanup_idle_rate),
                 &performance_counters::locality_pool_thread_counter_discoverer,
@@ -1488,7 +1711,7 @@ namespace hpx { namespace threads
             {"/threads/time/average", performance_counters::counter_raw,
                 "returns the average time spent executing one HPX-thread",
                 HPX_PERFORMANCE_COUNTER_V1,
-                util::bind_front(&threadmanager::locality_pool_thread_counter_creator,
+                util::bind_front(&threadmanager::idle_rate_counter_creator,
                     this, &threadmanager::get_thread_duration,
                     &thread_pool_base::get_thread_duration),
                 &performance_counters::locality_pool_thread_counter_discoverer,
@@ -1496,7 +1719,7 @@ namespace hpx { namespace threads
             {"/threads/time/average-phase", performance_counters::counter_raw,
                 "returns the average time spent executing one HPX-thread phase",
                 HPX_PERFORMANCE_COUNTER_V1,
-                util::bind_front(&threadmanager::locality_pool_thread_counter_creator,
+                util::bind_front(&threadmanager::idle_rate_counter_creator,
                     this, &threadmanager::get_thread_phase_duration,
                     &thread_pool_base::get_thread_phase_duration),
                 &performance_counters::locality_pool_thread_counter_discoverer,
@@ -1505,7 +1728,7 @@ namespace hpx { namespace threads
                 performance_counters::counter_raw,
                 "returns average overhead time executing one HPX-thread",
                 HPX_PERFORMANCE_COUNTER_V1,
-                util::bind_front(&threadmanager::locality_pool_thread_counter_creator,
+                util::bind_front(&threadmanager::idle_rate_counter_creator,
                     this, &threadmanager::get_thread_overhead,
                     &thread_pool_base::get_thread_overhead),
                 &performance_counters::locality_pool_thread_counter_discoverer,
@@ -1514,7 +1737,7 @@ namespace hpx { namespace threads
                 performance_counters::counter_raw,
                 "returns average overhead time executing one HPX-thread phase",
                 HPX_PERFORMANCE_COUNTER_V1,
-                util::bind_front(&threadmanager::locality_pool_thread_counter_creator,
+                util::bind_front(&threadmanager::idle_rate_counter_creator,
                     this, &threadmanager::get_thread_phase_overhead,
                     &thread_pool_base::get_thread_phase_overhead),
                 &performance_counters::locality_pool_thread_counter_discoverer,
@@ -1522,7 +1745,7 @@ namespace hpx { namespace threads
             {"/threads/time/cumulative", performance_counters::counter_raw,
                 "returns the cumulative time spent executing HPX-threads",
                 HPX_PERFORMANCE_COUNTER_V1,
-                util::bind_front(&threadmanager::locality_pool_thread_counter_creator,
+                util::bind_front(&threadmanager::idle_rate_counter_creator,
                     this, &threadmanager::get_cumulative_thread_duration,
                     &thread_pool_base::get_cumulative_thread_duration),
                 &performance_counters::locality_pool_thread_counter_discoverer,
@@ -1532,7 +1755,7 @@ namespace hpx { namespace threads
                 "returns the cumulative overhead time incurred by executing "
                 "HPX threads",
                 HPX_PERFORMANCE_COUNTER_V1,
-                util::bind_front(&threadmanager::locality_pool_thread_counter_creator,
+                util::bind_front(&threadmanager::idle_rate_counter_creator,
                     this, &threadmanager::get_cumulative_thread_overhead,
                     &thread_pool_base::get_cumulative_thread_overhead),
                 &performance_counters::locality_pool_thread_counter_discoverer,
@@ -1546,7 +1769,7 @@ namespace hpx { namespace threads
                 "returns the overall time spent running background work",
                 HPX_PERFORMANCE_COUNTER_V1,
                 util::bind_front(
-                    &threadmanager::locality_pool_thread_counter_creator, this,
+                    &threadmanager::idle_rate_counter_creator, this,
                     &threadmanager::get_background_work_duration,
                     &thread_pool_base::get_background_work_duration),
                 &performance_counters::locality_pool_thread_counter_discoverer,
@@ -1556,7 +1779,7 @@ namespace hpx { namespace threads
                 "returns the overall background overhead",
                 HPX_PERFORMANCE_COUNTER_V1,
                 util::bind_front(
-                    &threadmanager::locality_pool_thread_counter_creator, this,
+                    &threadmanager::idle_rate_counter_creator, this,
                     &threadmanager::get_background_overhead,
                     &thread_pool_base::get_background_overhead),
                 &performance_counters::locality_pool_thread_counter_discoverer,
@@ -1567,7 +1790,7 @@ namespace hpx { namespace threads
                 "returns the overall time spent running the scheduler on a "
                 "core",
                 HPX_PERFORMANCE_COUNTER_V1,
-                util::bind_front(&threadmanager::locality_pool_thread_counter_creator,
+                util::bind_front(&threadmanager::idle_rate_counter_creator,
                     this, &threadmanager::get_cumulative_duration,
                     &thread_pool_base::get_cumulative_duration),
                 &performance_counters::locality_pool_thread_counter_discoverer,
@@ -1638,12 +1861,65 @@ namespace hpx { namespace threads
                 "performed for the referenced locality",
                 HPX_PERFORMANCE_COUNTER_V1, counts_creator,
                 &performance_counters::locality_counter_discoverer, ""},
+            {"/threads/count/stack-recycles-local",
+                performance_counters::counter_raw,
+                "returns the total number of recycled HPX-thread objects which "
+                "were reused on the NUMA domain their stack was first touched "
+                "in for the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+                &performance_counters::locality_counter_discoverer, ""},
+            {"/threads/count/stack-recycles-remote",
+                performance_counters::counter_raw,
+                "returns the total number of recycled HPX-thread objects which "
+                "were reused on a NUMA domain different from the one their "
+                "stack was first touched in for the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+                &performance_counters::locality_counter_discoverer, ""},
+            {"/threads/count/cleanup-idle", performance_counters::counter_raw,
+                "returns the total number of terminated HPX-thread objects "
+                "cleaned up by idle worker threads for the referenced "
+                "locality",
+                HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+                &performance_counters::locality_counter_discoverer, ""},
+            {"/threads/count/cleanup-forced",
+                performance_counters::counter_raw,
+                "returns the total number of terminated HPX-thread objects "
+                "cleaned up by busy worker threads because the idle ones did "
+                "not keep up for the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+                &performance_counters::locality_counter_discoverer, ""},
+            {"/threads/time/cleanup-idle", performance_counters::counter_raw,
+                "returns the total time idle worker threads spent cleaning up "
+                "terminated HPX-thread objects for the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+                &performance_counters::locality_counter_discoverer, "ns"},
+            {"/threads/time/cleanup-forced", performance_counters::counter_raw,
+                "returns the total time busy worker threads spent cleaning up "
+                "terminated HPX-thread objects for the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+                &performance_counters::locality_counter_discoverer, "ns"},
 #if !defined(HPX_WINDOWS) && !defined(HPX_HAVE_GENERIC_CONTEXT_COROUTINES)
             {"/threads/count/stack-unbinds", performance_counters::counter_raw,
                 "returns the total number of HPX-thread unbind (madvise) "
                 "operations performed for the referenced locality",
                 HPX_PERFORMANCE_COUNTER_V1, counts_creator,
                 &performance_counters::locality_counter_discoverer, ""},
+#endif
+#if defined(HPX_COROUTINES_HAVE_STACK_POOL)
+            {"/threads/count/stack-pool-reserved",
+                performance_counters::counter_raw,
+                "returns the amount of virtual memory reserved for the stacks "
+                "of HPX-threads by the stack pool for the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+                &performance_counters::locality_counter_discoverer, "bytes"},
+            {"/threads/count/stack-pool-committed",
+                performance_counters::counter_raw,
+                "returns the amount of memory of the stacks of HPX-threads "
+                "which are in use or were released to the stack pool recently "
+                "(an upper bound of the committed stack memory) for the "
+                "referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+                &performance_counters::locality_counter_discoverer, "bytes"},
 #endif
             {"/threads/count/objects", performance_counters::counter_raw,
                 "returns the overall number of created HPX-thread objects for "
@@ -1716,6 +1992,28 @@ namespace hpx { namespace threads
                     &thread_pool_base::get_num_stolen_to_staged),
                 &performance_counters::locality_pool_thread_counter_discoverer,
                 ""},
+            {"/threads/count/successful-steals",
+                performance_counters::counter_raw,
+                "returns the number of times the referenced worker-thread "
+                "on the referenced locality successfully stole work from "
+                "a neighboring queue (local scheduler only)",
+                HPX_PERFORMANCE_COUNTER_V1,
+                util::bind_front(&threadmanager::locality_pool_thread_counter_creator,
+                    this, &threadmanager::get_num_successful_steals,
+                    &thread_pool_base::get_num_successful_steals),
+                &performance_counters::locality_pool_thread_counter_discoverer,
+                ""},
+            {"/threads/count/failed-steals",
+                performance_counters::counter_raw,
+                "returns the number of times the referenced worker-thread "
+                "on the referenced locality failed to steal work from any "
+                "of the neighboring queues (local scheduler only)",
+                HPX_PERFORMANCE_COUNTER_V1,
+                util::bind_front(&threadmanager::locality_pool_thread_counter_creator,
+                    this, &threadmanager::get_num_failed_steals,
+                    &thread_pool_base::get_num_failed_steals),
+                &performance_counters::locality_pool_thread_counter_discoverer,
+                ""},
 #endif
             // scheduler utilization
             {"/scheduler/utilization/instantaneous",
@@ -1746,7 +2044,30 @@ namespace hpx { namespace threads
                     this, &thread_pool_base::get_busy_loop_count),
                 &performance_counters::
                     locality_pool_thread_no_total_counter_discoverer,
-                ""}
+                ""},
+            // lock hold and wait times of adaptive mutexes
+            {"/threads/time/adaptive-mutex-hold",
+                performance_counters::counter_histogram,
+                "returns the histogram of the (sampled) times any adaptive "
+                "mutex was held on the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1,
+                util::bind(&performance_counters::
+                        locality_raw_values_counter_creator, _1,
+                    util::function_nonser<std::vector<std::int64_t>(bool)>(
+                        &lcos::local::adaptive_mutex::get_hold_time_histogram),
+                    _2),
+                &performance_counters::locality_counter_discoverer, "ns"},
+            {"/threads/time/adaptive-mutex-wait",
+                performance_counters::counter_histogram,
+                "returns the histogram of the times threads waited for any "
+                "contended adaptive mutex on the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1,
+                util::bind(&performance_counters::
+                        locality_raw_values_counter_creator, _1,
+                    util::function_nonser<std::vector<std::int64_t>(bool)>(
+                        &lcos::local::adaptive_mutex::get_wait_time_histogram),
+                    _2),
+                &performance_counters::locality_counter_discoverer, "ns"}
         };
         performance_counters::install_counter_types(
             counter_types, sizeof(counter_types)/sizeof(counter_types[0]));
@@ -1814,6 +2135,14 @@ namespace hpx { namespace threads
             if (sched) sched->set_all_states(state_running);
         }
 
+        // accept work submitted by threads outside the runtime
+        if (!pools_.empty())
+        {
+            detail::external_inbox::get().attach(
+                default_pool().get_scheduler(),
+                rp.get_num_threads(default_pool().get_pool_name()));
+        }
+
         LTM_(info) << "run: running";
         return true;
     }
@@ -1827,6 +2156,12 @@ namespace hpx { namespace threads
         {
             pool_iter->stop(lk, blocking);
         }
+
+        // the workers have exited, drop the work submitted from outside of
+        // the runtime which has not been picked up anymore
+        if (blocking)
+            detail::external_inbox::get().detach();
+
         deinit_tss();
     }
 
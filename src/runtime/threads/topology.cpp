@@ -126,6 +126,15 @@ namespace hpx { namespace threads { namespace detail
 #endif
         return node;
     }
+
+    bool is_cache_obj(hwloc_obj_t obj) noexcept
+    {
+#if HWLOC_API_VERSION >= 0x00020000
+        return hwloc_obj_type_is_cache(obj->type) != 0;
+#else
+        return obj->type == HWLOC_OBJ_CACHE;
+#endif
+    }
 }}}
 
 namespace hpx { namespace threads
@@ -250,6 +259,7 @@ namespace hpx { namespace threads
         socket_affinity_masks_.reserve(num_of_pus_);
         numa_node_affinity_masks_.reserve(num_of_pus_);
         core_affinity_masks_.reserve(num_of_pus_);
+        cache_affinity_masks_.reserve(num_of_pus_);
         thread_affinity_masks_.reserve(num_of_pus_);
 
         for (std::size_t i = 0; i < num_of_pus_; ++i)
@@ -267,6 +277,11 @@ namespace hpx { namespace threads
             core_affinity_masks_.push_back(init_core_affinity_mask(i));
         }
 
+        for (std::size_t i = 0; i < num_of_pus_; ++i)
+        {
+            cache_affinity_masks_.push_back(init_cache_affinity_mask(i));
+        }
+
         for (std::size_t i = 0; i < num_of_pus_; ++i)
         {
             thread_affinity_masks_.push_back(init_thread_affinity_mask(i));
@@ -299,6 +314,7 @@ namespace hpx { namespace threads
         detail::write_to_log_mask("socket_affinity_mask", socket_affinity_masks_);
         detail::write_to_log_mask("numa_node_affinity_mask", numa_node_affinity_masks_);
         detail::write_to_log_mask("core_affinity_mask", core_affinity_masks_);
+        detail::write_to_log_mask("cache_affinity_mask", cache_affinity_masks_);
         detail::write_to_log_mask("thread_affinity_mask", thread_affinity_masks_);
     }
 
@@ -420,6 +436,29 @@ namespace hpx { namespace threads
         return empty_mask;
     }
 
+    mask_cref_type topology::get_cache_affinity_mask(
+        std::size_t num_thread
+      , error_code& ec
+        ) const
+    { // {{{
+        std::size_t num_pu = num_thread % num_of_pus_;
+
+        if (num_pu < cache_affinity_masks_.size())
+        {
+            if (&ec != &throws)
+                ec = make_success_code();
+
+            return cache_affinity_masks_[num_pu];
+        }
+
+        HPX_THROWS_IF(ec, bad_parameter
+          , "hpx::threads::topology::get_cache_affinity_mask"
+          , hpx::util::format(
+                "thread number %1% is out of range",
+                num_thread));
+        return empty_mask;
+    } // }}}
+
     mask_cref_type topology::get_thread_affinity_mask(
         std::size_t num_thread
       , error_code& ec
@@ -1079,6 +1118,47 @@ namespace hpx { namespace threads
         return default_mask;
     } // }}}
 
+    mask_type topology::init_cache_affinity_mask(
+        std::size_t num_thread
+        ) const
+    { // {{{
+        mask_cref_type core_mask = core_affinity_masks_[num_thread];
+        mask_cref_type numa_node_mask = numa_node_affinity_masks_[num_thread];
+
+        std::size_t num_pu = (num_thread + pu_offset) % num_of_pus_;
+
+        hwloc_obj_t obj = nullptr;
+
+        {
+            std::unique_lock<hpx::util::spinlock> lk(topo_mtx);
+            obj = hwloc_get_obj_by_type(topo, HWLOC_OBJ_PU,
+                    static_cast<unsigned>(num_pu));
+        }
+
+        // walk up the tree until we find the first cache which is shared
+        // with other cores (usually L2 or L3)
+        for (/**/; obj != nullptr; obj = obj->parent)
+        {
+            if (!detail::is_cache_obj(obj))
+                continue;
+
+            mask_type cache_mask = mask_type();
+            resize(cache_mask, get_number_of_pus());
+
+            extract_node_mask(obj, cache_mask);
+            if (equal(cache_mask, core_mask))
+                continue;
+
+            // the sharing group is not allowed to span NUMA domains
+            if (!equal(cache_mask & numa_node_mask, cache_mask))
+                break;
+
+            return cache_mask;
+        }
+
+        return numa_node_mask;
+    } // }}}
+
     mask_type topology::init_thread_affinity_mask(
         std::size_t num_thread
         ) const
@@ -1283,10 +1363,12 @@ namespace hpx { namespace threads
     }
 
     bool topology::set_area_membind_nodeset(
-        const void *addr, std::size_t len, void *nodeset) const
+        const void *addr, std::size_t len, void *nodeset,
+        hpx_hwloc_membind_policy membind_policy) const
     {
 #if !defined(__APPLE__)
-        hwloc_membind_policy_t policy = ::HWLOC_MEMBIND_BIND;
+        hwloc_membind_policy_t policy =
+            static_cast<hwloc_membind_policy_t>(membind_policy);
         hwloc_nodeset_t ns = reinterpret_cast<hwloc_nodeset_t>(nodeset);
         int ret =
 #if HWLOC_API_VERSION >= 0x00010b06
@@ -1483,6 +1565,8 @@ namespace hpx { namespace threads
         print_mask_vector(os, numa_node_affinity_masks_);
         os << "core                  : \n";
         print_mask_vector(os, core_affinity_masks_);
+        os << "shared cache          : \n";
+        print_mask_vector(os, cache_affinity_masks_);
         os << "PUs (/threads)        : \n";
         print_mask_vector(os, thread_affinity_masks_);
 
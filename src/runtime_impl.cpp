@@ -27,9 +27,15 @@
 #include <hpx/util/apex.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/bind.hpp>
+#include <hpx/util/lock_profiler.hpp>
 #include <hpx/util/logging.hpp>
 #include <hpx/util/safe_lexical_cast.hpp>
 #include <hpx/util/set_thread_name.hpp>
+#include <hpx/util/startup_timings.hpp>
+#include <hpx/util/sampling_profiler.hpp>
+#include <hpx/util/task_graph_profiler.hpp>
+#include <hpx/util/task_hardware_counters.hpp>
+#include <hpx/util/task_tracer.hpp>
 #include <hpx/util/thread_mapper.hpp>
 #include <hpx/util/yield_while.hpp>
 
@@ -252,6 +258,7 @@ namespace hpx
         int& result)
     {
         lbt_ << "(2nd stage) runtime_impl::run_helper: launching pre_main";
+        util::startup_timings::record("runtime start");
 
         // Change our thread description, as we're about to call pre_main
         threads::set_thread_description(threads::get_self_id(), "pre_main");
@@ -268,6 +275,9 @@ namespace hpx
         lbt_ << "(4th stage) runtime_impl::run_helper: bootstrap complete";
         set_state(state_running);
 
+        if (get_config_entry("hpx.print_startup_timings", "0") == "1")
+            util::startup_timings::print(std::cout, get_locality_id());
+
         parcel_handler_.enable_alternative_parcelports();
 
         // reset all counters right before running main, if requested
@@ -329,6 +339,80 @@ namespace hpx
         // initialize instrumentation system
         util::apex_init();
 
+#if defined(HPX_HAVE_TASK_TRACER)
+        // start recording the task trace, if requested
+        std::string trace_file = get_config().get_entry("hpx.trace.file", "");
+        if (!trace_file.empty())
+        {
+            util::tracing::start_tracing(trace_file,
+                util::safe_lexical_cast<std::size_t>(
+                    get_config().get_entry("hpx.trace.buffer_size", "65536"),
+                    65536),
+                util::safe_lexical_cast<std::uint32_t>(
+                    get_config().get_entry("hpx.locality", "0"), 0));
+        }
+#endif
+
+#if defined(HPX_HAVE_TASK_HARDWARE_COUNTERS)
+        // attribute the requested hardware events to the HPX threads
+        std::string events =
+            get_config().get_entry("hpx.task_counters.events", "");
+        if (!events.empty())
+            util::task_counters::start_task_counters(events);
+#endif
+
+#if defined(HPX_HAVE_LOCK_PROFILING)
+        // profile the contention of the locks, if requested
+        if (util::safe_lexical_cast<int>(
+                get_config().get_entry("hpx.lock_profiling.enabled", "0"), 0))
+        {
+            util::lock_profiling::start_lock_profiling(
+                util::safe_lexical_cast<std::size_t>(
+                    get_config().get_entry("hpx.lock_profiling.sample_rate",
+                        "64"),
+                    64),
+                get_config().get_entry("hpx.lock_profiling.report", ""),
+                util::safe_lexical_cast<std::size_t>(
+                    get_config().get_entry("hpx.lock_profiling.report_top",
+                        "20"),
+                    20));
+        }
+#endif
+
+#if defined(HPX_HAVE_TASK_GRAPH_PROFILER)
+        // record the task graph, if requested
+        std::string task_graph_file =
+            get_config().get_entry("hpx.task_graph.file", "");
+        if (!task_graph_file.empty())
+        {
+            util::task_graph::start_profiling(task_graph_file,
+                util::safe_lexical_cast<std::size_t>(
+                    get_config().get_entry("hpx.task_graph.max_nodes",
+                        "1048576"),
+                    1048576));
+        }
+#endif
+
+#if defined(HPX_HAVE_SAMPLING_PROFILER)
+        // sample the stacks of the HPX threads, if requested
+        std::string sampling_file =
+            get_config().get_entry("hpx.sampling.file", "");
+        if (!sampling_file.empty())
+        {
+            util::sampling::start_sampling(sampling_file,
+                util::safe_lexical_cast<std::size_t>(
+                    get_config().get_entry("hpx.sampling.frequency", "99"),
+                    99),
+                util::safe_lexical_cast<std::size_t>(
+                    get_config().get_entry("hpx.sampling.max_depth", "64"),
+                    64),
+                util::safe_lexical_cast<std::size_t>(
+                    get_config().get_entry("hpx.sampling.buffer_size",
+                        "1024"),
+                    1024));
+        }
+#endif
+
         LRT_(info) << "cmd_line: " << get_config().get_cmd_line();
 
         lbt_ << "(1st stage) runtime_impl::start: booting locality " << here();
@@ -527,6 +611,21 @@ namespace hpx
 #ifdef HPX_HAVE_IO_POOL
         io_pool_.stop();                    // stops io_pool_ as well
 #endif
+
+        // flush the task trace, if any
+        util::tracing::stop_tracing();
+
+        // close the hardware counters of all worker threads
+        util::task_counters::stop_task_counters();
+
+        // write the critical path report of the recorded task graph, if any
+        util::task_graph::stop_profiling();
+
+        // write the sampled stacks, if any
+        util::sampling::stop_sampling();
+
+        // write the lock contention report, if any
+        util::lock_profiling::stop_lock_profiling();
 //         deinit_tss();
     }
 
@@ -575,12 +674,14 @@ namespace hpx
             return -1;
         }
 
+        // don't sleep while waiting for the last work items to finish, this
+        // usually takes a few microseconds only
         util::yield_while(
             [this]()
             {
                 return thread_manager_->get_thread_count() >
                     thread_manager_->get_background_thread_count();
-            }, "runtime_impl::suspend");
+            }, "runtime_impl::suspend", threads::pending_boost, false);
 
         thread_manager_->suspend();
 
@@ -0,0 +1,126 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/util/allocation_accounting.hpp>
+#include <hpx/util/assert.hpp>
+
+#if defined(HPX_HAVE_ALLOCATION_ACCOUNTING)
+#include <hpx/runtime/threads/topology.hpp>
+
+#include <atomic>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace hpx { namespace util { namespace allocation_accounting
+{
+    namespace
+    {
+        char const* const subsystem_names[] =
+        {
+            "thread-stacks",
+            "thread-data",
+            "shared-states",
+            "parcel-buffers",
+            "agas-caches",
+            "serialization"
+        };
+    }
+
+    char const* get_subsystem_name(subsystem s)
+    {
+        HPX_ASSERT(s < subsystem_last);
+        return subsystem_names[s];
+    }
+
+    subsystem get_subsystem(std::string const& name)
+    {
+        for (int i = 0; i != subsystem_last; ++i)
+        {
+            if (name == subsystem_names[i])
+                return static_cast<subsystem>(i);
+        }
+        return subsystem_last;
+    }
+
+#if defined(HPX_HAVE_ALLOCATION_ACCOUNTING)
+    namespace
+    {
+        // the statistics of the subsystems are kept in separate cache lines
+        // as they are updated concurrently
+        struct alignas(threads::get_cache_line_size()) subsystem_data
+        {
+            std::atomic<std::int64_t> bytes_live_;
+            std::atomic<std::int64_t> high_water_;
+            std::atomic<std::int64_t> allocations_;
+        };
+
+        // zero initialized before any dynamic initialization takes place
+        subsystem_data data[subsystem_last];
+    }
+
+    void allocated(subsystem s, std::size_t bytes)
+    {
+        HPX_ASSERT(s < subsystem_last);
+        subsystem_data& d = data[s];
+
+        d.allocations_.fetch_add(1, std::memory_order_relaxed);
+
+        std::int64_t const live = d.bytes_live_.fetch_add(
+            std::int64_t(bytes), std::memory_order_relaxed) +
+            std::int64_t(bytes);
+
+        std::int64_t high_water = d.high_water_.load(std::memory_order_relaxed);
+        while (live > high_water &&
+            !d.high_water_.compare_exchange_weak(
+                high_water, live, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void deallocated(subsystem s, std::size_t bytes)
+    {
+        HPX_ASSERT(s < subsystem_last);
+        data[s].bytes_live_.fetch_sub(
+            std::int64_t(bytes), std::memory_order_relaxed);
+    }
+
+    std::int64_t get_statistic(statistic stat, subsystem s, bool reset)
+    {
+        HPX_ASSERT(s < subsystem_last);
+        subsystem_data& d = data[s];
+
+        switch (stat)
+        {
+        case stat_bytes_live:
+            return d.bytes_live_.load(std::memory_order_relaxed);
+
+        case stat_high_water:
+            {
+                std::int64_t const value =
+                    d.high_water_.load(std::memory_order_relaxed);
+                if (reset)
+                {
+                    d.high_water_.store(
+                        d.bytes_live_.load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+                }
+                return value;
+            }
+
+        case stat_allocations:
+            return d.allocations_.load(std::memory_order_relaxed);
+
+        default:
+            HPX_ASSERT(false);
+            break;
+        }
+        return 0;
+    }
+#endif
+}}}
@@ -0,0 +1,278 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/annotation.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace hpx { namespace util
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        struct annotation_entry
+        {
+            std::uint64_t hash_;
+            std::size_t length_;
+            std::uint32_t id_;
+            char name_[1];
+        };
+
+        // An open addressing hash table of the interned names. Entries are
+        // only added under the lock of the annotation_table, lookups don't
+        // take a lock. A full table is replaced by a larger one, the old one
+        // is kept alive as concurrent lookups may still use it.
+        struct annotation_hash_table
+        {
+            explicit annotation_hash_table(std::size_t size)
+              : mask_(size - 1)
+              , entries_(new std::atomic<annotation_entry*>[size])
+            {
+                for (std::size_t i = 0; i != size; ++i)
+                    entries_[i].store(nullptr, std::memory_order_relaxed);
+            }
+
+            std::size_t size() const
+            {
+                return mask_ + 1;
+            }
+
+            annotation_entry* find(char const* name, std::size_t length,
+                std::uint64_t hash) const
+            {
+                for (std::size_t i = std::size_t(hash) & mask_; /**/;
+                     i = (i + 1) & mask_)
+                {
+                    annotation_entry* e =
+                        entries_[i].load(std::memory_order_acquire);
+                    if (e == nullptr)
+                        return nullptr;
+
+                    if (e->hash_ == hash && e->length_ == length &&
+                        std::memcmp(e->name_, name, length) == 0)
+                    {
+                        return e;
+                    }
+                }
+            }
+
+            void insert(annotation_entry* e)
+            {
+                std::size_t i = std::size_t(e->hash_) & mask_;
+                while (entries_[i].load(std::memory_order_relaxed) != nullptr)
+                    i = (i + 1) & mask_;
+                entries_[i].store(e, std::memory_order_release);
+            }
+
+            std::size_t const mask_;
+            std::unique_ptr<std::atomic<annotation_entry*>[]> entries_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        class annotation_table
+        {
+            typedef lcos::local::spinlock mutex_type;
+
+            static std::size_t const chunk_size = 1024;
+            static std::size_t const max_chunks = 4096;
+
+        public:
+            // The table is never destroyed, the interned names have to stay
+            // valid for static objects destroyed at exit.
+            static annotation_table& get()
+            {
+                static annotation_table* table = new annotation_table;
+                return *table;
+            }
+
+            std::uint32_t intern(char const* name, std::size_t length,
+                std::uint64_t hash)
+            {
+                annotation_entry* e =
+                    table_.load(std::memory_order_acquire)->find(
+                        name, length, hash);
+                if (e != nullptr)
+                    return e->id_;
+
+                std::lock_guard<mutex_type> l(mtx_);
+
+                annotation_hash_table* table =
+                    table_.load(std::memory_order_relaxed);
+                e = table->find(name, length, hash);
+                if (e != nullptr)
+                    return e->id_;
+
+                std::uint32_t id = count_.load(std::memory_order_relaxed) + 1;
+                std::size_t chunk = (id - 1) / chunk_size;
+                if (chunk == max_chunks)
+                {
+                    HPX_THROW_EXCEPTION(out_of_memory, "intern_annotation",
+                        "too many distinct annotations");
+                }
+
+                e = make_entry(name, length, hash, id);
+
+                std::atomic<annotation_entry*>* entries =
+                    chunks_[chunk].load(std::memory_order_relaxed);
+                if (entries == nullptr)
+                {
+                    entries = new std::atomic<annotation_entry*>[chunk_size];
+                    for (std::size_t i = 0; i != chunk_size; ++i)
+                        entries[i].store(nullptr, std::memory_order_relaxed);
+                    chunks_[chunk].store(entries, std::memory_order_release);
+                }
+                entries[(id - 1) % chunk_size].store(
+                    e, std::memory_order_release);
+
+                // the id has to be valid before the entry can be found
+                count_.store(id, std::memory_order_release);
+
+                // keep the load factor below one half
+                if (2 * std::size_t(id) > table->size())
+                {
+                    std::unique_ptr<annotation_hash_table> grown(
+                        new annotation_hash_table(2 * table->size()));
+                    for (std::uint32_t i = 1; i != id; ++i)
+                        grown->insert(entry(i));
+                    table = grown.get();
+                    tables_.push_back(std::move(grown));
+                }
+                table->insert(e);
+
+                table_.store(table, std::memory_order_release);
+                return id;
+            }
+
+            annotation_entry* find(char const* name, std::size_t length,
+                std::uint64_t hash) const
+            {
+                return table_.load(std::memory_order_acquire)->find(
+                    name, length, hash);
+            }
+
+            char const* name(std::uint32_t id) const noexcept
+            {
+                if (id == 0 || id > count_.load(std::memory_order_acquire))
+                    return nullptr;
+                return entry(id)->name_;
+            }
+
+            std::size_t count() const noexcept
+            {
+                return count_.load(std::memory_order_acquire);
+            }
+
+        private:
+            annotation_table()
+              : count_(0)
+            {
+                for (std::size_t i = 0; i != max_chunks; ++i)
+                    chunks_[i].store(nullptr, std::memory_order_relaxed);
+
+                tables_.emplace_back(new annotation_hash_table(256));
+                table_.store(tables_.back().get(), std::memory_order_relaxed);
+            }
+
+            annotation_entry* entry(std::uint32_t id) const noexcept
+            {
+                return chunks_[(id - 1) / chunk_size].load(
+                    std::memory_order_acquire)[(id - 1) % chunk_size].load(
+                        std::memory_order_acquire);
+            }
+
+            static annotation_entry* make_entry(char const* name,
+                std::size_t length, std::uint64_t hash, std::uint32_t id)
+            {
+                void* p = std::malloc(
+                    offsetof(annotation_entry, name_) + length + 1);
+                if (p == nullptr)
+                {
+                    HPX_THROW_EXCEPTION(out_of_memory, "intern_annotation",
+                        "could not allocate the interned annotation");
+                }
+
+                annotation_entry* e = static_cast<annotation_entry*>(p);
+                e->hash_ = hash;
+                e->length_ = length;
+                e->id_ = id;
+                std::memcpy(e->name_, name, length);
+                e->name_[length] = '\0';
+                return e;
+            }
+
+            mutex_type mtx_;
+            std::atomic<std::uint32_t> count_;
+            std::atomic<annotation_hash_table*> table_;
+            std::vector<std::unique_ptr<annotation_hash_table> > tables_;
+            std::atomic<std::atomic<annotation_entry*>*> chunks_[max_chunks];
+        };
+
+        std::uint64_t hash_annotation(char const* name, std::size_t length)
+        {
+            std::uint64_t hash = annotation_hash_basis;
+            for (std::size_t i = 0; i != length; ++i)
+            {
+                hash = (hash ^ std::uint64_t(
+                    static_cast<unsigned char>(name[i]))) *
+                    annotation_hash_prime;
+            }
+            return hash;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        std::uint32_t intern_annotation(char const* name, std::size_t length,
+            std::uint64_t hash)
+        {
+            return annotation_table::get().intern(name, length, hash);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::uint32_t intern_annotation(char const* name)
+    {
+        if (name == nullptr)
+            return 0;
+
+        std::size_t length = std::strlen(name);
+        return detail::annotation_table::get().intern(
+            name, length, detail::hash_annotation(name, length));
+    }
+
+    std::uint32_t intern_annotation(std::string const& name)
+    {
+        return detail::annotation_table::get().intern(name.data(),
+            name.size(), detail::hash_annotation(name.data(), name.size()));
+    }
+
+    std::uint32_t find_annotation(std::string const& name)
+    {
+        detail::annotation_entry* e = detail::annotation_table::get().find(
+            name.data(), name.size(),
+            detail::hash_annotation(name.data(), name.size()));
+        return e != nullptr ? e->id_ : 0;
+    }
+
+    char const* get_annotation_name(std::uint32_t id) noexcept
+    {
+        return detail::annotation_table::get().name(id);
+    }
+
+    std::size_t get_annotation_count() noexcept
+    {
+        return detail::annotation_table::get().count();
+    }
+}}
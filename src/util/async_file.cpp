@@ -0,0 +1,555 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if !defined(HPX_WINDOWS)
+#include <hpx/exception.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/executors/service_executors.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/async_file.hpp>
+#include <hpx/util/detail/async_file_polling.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#if defined(HPX_HAVE_IO_URING)
+#include <hpx/util/io_uring.hpp>
+#include <linux/io_uring.h>
+#endif
+
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace util
+{
+    namespace
+    {
+        std::string error_message(char const* what, int err)
+        {
+            return std::string(what) + ": " + std::strerror(err);
+        }
+
+        std::exception_ptr make_error(char const* func, char const* what,
+            int err)
+        {
+            return hpx::detail::get_exception(hpx::filesystem_error,
+                error_message(what, err), hpx::plain, func, __FILE__,
+                __LINE__);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // blocking versions of the operations, executed on the io-pool
+        std::size_t blocking_transfer(bool write, int fd,
+            std::vector<iovec> const& iov, std::uint64_t offset)
+        {
+            ssize_t result = 0;
+            do
+            {
+                if (iov.size() == 1)
+                {
+                    result = write ?
+                        ::pwrite(fd, iov[0].iov_base, iov[0].iov_len,
+                            off_t(offset)) :
+                        ::pread(fd, iov[0].iov_base, iov[0].iov_len,
+                            off_t(offset));
+                }
+                else
+                {
+                    result = write ?
+                        ::pwritev(fd, iov.data(), int(iov.size()),
+                            off_t(offset)) :
+                        ::preadv(fd, iov.data(), int(iov.size()),
+                            off_t(offset));
+                }
+            } while (result < 0 && errno == EINTR);
+
+            if (result < 0)
+            {
+                std::rethrow_exception(make_error("util::async_file::transfer",
+                    write ? "writing the file failed" :
+                        "reading the file failed", errno));
+            }
+            return std::size_t(result);
+        }
+
+        void blocking_sync(int fd)
+        {
+            int result = 0;
+            do
+            {
+                result = ::fsync(fd);
+            } while (result < 0 && errno == EINTR);
+
+            if (result < 0)
+            {
+                std::rethrow_exception(make_error("util::async_file::sync",
+                    "synchronizing the file failed", errno));
+            }
+        }
+
+#if defined(HPX_HAVE_IO_URING)
+        ///////////////////////////////////////////////////////////////////////
+        // The ring shared by all files. It is separate from the ring of the
+        // io_uring parcelport, as registering buffers waits for all
+        // operations in flight (which would never complete for reads from
+        // sockets).
+        class file_service
+        {
+        public:
+            HPX_NON_COPYABLE(file_service);
+
+            typedef lcos::local::spinlock mutex_type;
+
+            file_service()
+              : ring_(nullptr)
+              , disabled_(false)
+            {}
+
+            ~file_service()
+            {
+                delete ring_.load(std::memory_order_relaxed);
+            }
+
+            // return the ring, create it on first use
+            uring::ring* get()
+            {
+                uring::ring* r = ring_.load(std::memory_order_acquire);
+                if (r != nullptr || disabled_.load(std::memory_order_relaxed))
+                    return r;
+
+                std::lock_guard<mutex_type> l(mtx_);
+                r = ring_.load(std::memory_order_relaxed);
+                if (r != nullptr || disabled_.load(std::memory_order_relaxed))
+                    return r;
+
+                if (hpx::get_config_entry("hpx.async_file.io_uring", "1") ==
+                    "0")
+                {
+                    disabled_.store(true, std::memory_order_relaxed);
+                    return nullptr;
+                }
+
+                unsigned const entries = util::safe_lexical_cast<unsigned>(
+                    hpx::get_config_entry("hpx.async_file.queue_size", "256"),
+                    256u);
+
+                try {
+                    // every slot of the submission queue can refer to a
+                    // different file
+                    r = new uring::ring(entries, entries);
+                }
+                catch (hpx::exception const&) {
+                    // the kernel does not support io_uring
+                    disabled_.store(true, std::memory_order_relaxed);
+                    return nullptr;
+                }
+
+                ring_.store(r, std::memory_order_release);
+                return r;
+            }
+
+            // return the ring if it exists, without creating it
+            uring::ring* current() const noexcept
+            {
+                return ring_.load(std::memory_order_acquire);
+            }
+
+            bool register_buffer(void* data, std::size_t size)
+            {
+                uring::ring* r = get();
+                if (r == nullptr)
+                    return false;
+
+                std::lock_guard<mutex_type> l(mtx_);
+                if (buffers_.find(data) != buffers_.end())
+                    return true;
+
+                int const index = r->register_buffer(data, size);
+                if (index < 0)
+                    return false;
+
+                buffers_.insert(std::make_pair(data, index));
+                return true;
+            }
+
+            void unregister_buffer(void* data)
+            {
+                uring::ring* r = current();
+                if (r == nullptr)
+                    return;
+
+                std::lock_guard<mutex_type> l(mtx_);
+                auto it = buffers_.find(data);
+                if (it == buffers_.end())
+                    return;
+
+                r->unregister_buffer(it->second);
+                buffers_.erase(it);
+            }
+
+        private:
+            mutex_type mtx_;
+            std::atomic<uring::ring*> ring_;
+            std::atomic<bool> disabled_;
+            std::map<void*, int> buffers_;
+        };
+
+        file_service& get_file_service()
+        {
+            static file_service service;
+            return service;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // An operation in flight, deleted once it has completed
+        struct file_operation : uring::operation
+        {
+            file_operation(std::vector<iovec> && iov)
+              : uring::operation(&file_operation::handle_completion)
+              , iov_(std::move(iov))
+            {}
+
+            static void handle_completion(uring::operation& op, int result)
+            {
+                std::unique_ptr<file_operation> this_(
+                    static_cast<file_operation*>(&op));
+
+                if (result < 0)
+                {
+                    this_->promise_.set_exception(make_error(
+                        "util::async_file::handle_completion",
+                        "the file operation failed", -result));
+                }
+                else
+                {
+                    this_->promise_.set_value(std::size_t(result));
+                }
+            }
+
+            // the kernel reads the array of buffers when the operation is
+            // handed to it, which happens after submit has returned
+            std::vector<iovec> iov_;
+            lcos::local::promise<std::size_t> promise_;
+        };
+
+        void set_file(io_uring_sqe& sqe, int fd, int index) noexcept
+        {
+            if (index != -1)
+            {
+                sqe.fd = index;
+                sqe.flags |= IOSQE_FIXED_FILE;
+            }
+            else
+            {
+                sqe.fd = fd;
+            }
+        }
+#endif
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    async_file::async_file() noexcept
+      : fd_(-1), index_(-1), position_(0)
+    {}
+
+    async_file::async_file(std::string const& path, int flags, int mode)
+      : fd_(-1), index_(-1), position_(0)
+    {
+        open(path, flags, mode);
+    }
+
+    async_file::async_file(async_file && rhs) noexcept
+      : fd_(rhs.fd_), index_(rhs.index_), position_(rhs.tell())
+    {
+        rhs.fd_ = -1;
+        rhs.index_ = -1;
+        rhs.position_.store(0, std::memory_order_relaxed);
+    }
+
+    async_file& async_file::operator=(async_file && rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            try {
+                close();
+            }
+            catch (...) {
+                // errors of close are ignored, as in the destructor
+            }
+
+            fd_ = rhs.fd_;
+            index_ = rhs.index_;
+            position_.store(rhs.tell(), std::memory_order_relaxed);
+
+            rhs.fd_ = -1;
+            rhs.index_ = -1;
+            rhs.position_.store(0, std::memory_order_relaxed);
+        }
+        return *this;
+    }
+
+    async_file::~async_file()
+    {
+        try {
+            close();
+        }
+        catch (...) {
+            // there is nobody to report the error to
+        }
+    }
+
+    void async_file::open(std::string const& path, int flags, int mode)
+    {
+        if (fd_ != -1)
+        {
+            HPX_THROW_EXCEPTION(invalid_status, "util::async_file::open",
+                "the file is open already");
+        }
+
+        int const fd = ::open(path.c_str(), flags | O_CLOEXEC, mode);
+        if (fd < 0)
+        {
+            HPX_THROW_EXCEPTION(filesystem_error, "util::async_file::open",
+                error_message(("opening '" + path + "' failed").c_str(),
+                    errno));
+        }
+
+        fd_ = fd;
+        index_ = -1;
+        position_.store(
+            (flags & O_APPEND) ? std::uint64_t(::lseek(fd, 0, SEEK_END)) : 0,
+            std::memory_order_relaxed);
+
+#if defined(HPX_HAVE_IO_URING)
+        if (uring::ring* r = get_file_service().get())
+            index_ = r->register_file(fd);
+#endif
+    }
+
+    void async_file::close()
+    {
+        if (fd_ == -1)
+            return;
+
+#if defined(HPX_HAVE_IO_URING)
+        if (index_ != -1)
+        {
+            uring::ring* r = get_file_service().current();
+            HPX_ASSERT(r != nullptr);
+            r->unregister_file(index_);
+            index_ = -1;
+        }
+#endif
+
+        int const fd = fd_;
+        fd_ = -1;
+        if (::close(fd) < 0 && errno != EINTR)
+        {
+            HPX_THROW_EXCEPTION(filesystem_error, "util::async_file::close",
+                error_message("closing the file failed", errno));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<std::size_t> async_file::read(void* data, std::size_t size)
+    {
+        return pread(data, size,
+            position_.fetch_add(size, std::memory_order_relaxed));
+    }
+
+    hpx::future<std::size_t> async_file::write(void const* data,
+        std::size_t size)
+    {
+        return pwrite(data, size,
+            position_.fetch_add(size, std::memory_order_relaxed));
+    }
+
+    hpx::future<std::size_t> async_file::pread(void* data, std::size_t size,
+        std::uint64_t offset)
+    {
+        iovec iov;
+        iov.iov_base = data;
+        iov.iov_len = size;
+        return submit_transfer(false, &iov, 1, offset);
+    }
+
+    hpx::future<std::size_t> async_file::pwrite(void const* data,
+        std::size_t size, std::uint64_t offset)
+    {
+        iovec iov;
+        iov.iov_base = const_cast<void*>(data);
+        iov.iov_len = size;
+        return submit_transfer(true, &iov, 1, offset);
+    }
+
+    hpx::future<std::size_t> async_file::preadv(iovec const* iov,
+        std::size_t count, std::uint64_t offset)
+    {
+        return submit_transfer(false, iov, count, offset);
+    }
+
+    hpx::future<std::size_t> async_file::pwritev(iovec const* iov,
+        std::size_t count, std::uint64_t offset)
+    {
+        return submit_transfer(true, iov, count, offset);
+    }
+
+    hpx::future<std::size_t> async_file::submit_transfer(bool write,
+        iovec const* iov, std::size_t count, std::uint64_t offset)
+    {
+        if (fd_ == -1)
+        {
+            return hpx::make_exceptional_future<std::size_t>(
+                HPX_GET_EXCEPTION(invalid_status,
+                    "util::async_file::submit_transfer",
+                    "the file is not open"));
+        }
+
+        std::vector<iovec> buffers(iov, iov + count);
+
+#if defined(HPX_HAVE_IO_URING)
+        if (uring::ring* r = get_file_service().get())
+        {
+            // single buffers lying in registered memory are transferred
+            // without mapping their pages
+            int const buffer = (count == 1) ?
+                r->find_buffer(iov[0].iov_base, iov[0].iov_len) : -1;
+
+            file_operation* op = new file_operation(std::move(buffers));
+            hpx::future<std::size_t> f = op->promise_.get_future();
+
+            int const fd = fd_;
+            int const index = index_;
+            r->submit(*op,
+                [=](io_uring_sqe& sqe)
+                {
+                    if (buffer != -1)
+                    {
+                        sqe.opcode = write ?
+                            IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+                        sqe.addr = reinterpret_cast<std::uint64_t>(
+                            op->iov_[0].iov_base);
+                        sqe.len = static_cast<std::uint32_t>(
+                            op->iov_[0].iov_len);
+                        sqe.buf_index = static_cast<std::uint16_t>(buffer);
+                    }
+                    else
+                    {
+                        sqe.opcode = write ?
+                            IORING_OP_WRITEV : IORING_OP_READV;
+                        sqe.addr = reinterpret_cast<std::uint64_t>(
+                            op->iov_.data());
+                        sqe.len = static_cast<std::uint32_t>(
+                            op->iov_.size());
+                    }
+                    sqe.off = offset;
+                    set_file(sqe, fd, index);
+                });
+            return f;
+        }
+#endif
+
+        parallel::execution::io_pool_executor scheduler;
+        hpx::future<std::size_t> f = parallel::execution::async_execute(
+            scheduler, &blocking_transfer, write, fd_, std::move(buffers),
+            offset);
+        scheduler.detach();
+        return f;
+    }
+
+    hpx::future<void> async_file::sync()
+    {
+        if (fd_ == -1)
+        {
+            return hpx::make_exceptional_future<void>(
+                HPX_GET_EXCEPTION(invalid_status, "util::async_file::sync",
+                    "the file is not open"));
+        }
+
+#if defined(HPX_HAVE_IO_URING)
+        if (uring::ring* r = get_file_service().get())
+        {
+            file_operation* op = new file_operation(std::vector<iovec>());
+            hpx::future<std::size_t> f = op->promise_.get_future();
+
+            int const fd = fd_;
+            int const index = index_;
+            r->submit(*op,
+                [=](io_uring_sqe& sqe)
+                {
+                    sqe.opcode = IORING_OP_FSYNC;
+                    set_file(sqe, fd, index);
+                });
+            return hpx::future<void>(std::move(f));
+        }
+#endif
+
+        parallel::execution::io_pool_executor scheduler;
+        hpx::future<void> f = parallel::execution::async_execute(
+            scheduler, &blocking_sync, fd_);
+        scheduler.detach();
+        return f;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool async_file::register_buffer(void* data, std::size_t size)
+    {
+#if defined(HPX_HAVE_IO_URING)
+        return get_file_service().register_buffer(data, size);
+#else
+        return false;
+#endif
+    }
+
+    void async_file::unregister_buffer(void* data)
+    {
+#if defined(HPX_HAVE_IO_URING)
+        get_file_service().unregister_buffer(data);
+#endif
+    }
+
+    bool async_file::uses_io_uring()
+    {
+#if defined(HPX_HAVE_IO_URING)
+        return get_file_service().get() != nullptr;
+#else
+        return false;
+#endif
+    }
+
+#if defined(HPX_HAVE_IO_URING)
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        bool poll_async_files()
+        {
+            uring::ring* r = get_file_service().current();
+            return r != nullptr && r->poll();
+        }
+    }
+#endif
+}}
+
+#endif
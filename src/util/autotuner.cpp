@@ -0,0 +1,276 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/performance_counters/performance_counter.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/autotuner.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace util
+{
+    autotuner::autotuner(std::size_t warmup_iterations, std::size_t samples)
+      : warmup_iterations_(warmup_iterations)
+      , samples_((std::max)(samples, std::size_t(1)))
+      , best_score_((std::numeric_limits<double>::max)())
+      , iterations_(0)
+      , current_samples_(0)
+      , current_score_((std::numeric_limits<double>::max)())
+      , tuning_(true)
+    {
+    }
+
+    autotuner::autotuner(std::string const& counter_name,
+            std::size_t warmup_iterations, std::size_t samples)
+      : warmup_iterations_(warmup_iterations)
+      , samples_((std::max)(samples, std::size_t(1)))
+      , counter_name_(counter_name)
+      , counter_(counter_name)
+      , best_score_((std::numeric_limits<double>::max)())
+      , iterations_(0)
+      , current_samples_(0)
+      , current_score_((std::numeric_limits<double>::max)())
+      , tuning_(true)
+    {
+        counter_.start(launch::sync);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void autotuner::add(tunable t, std::size_t start)
+    {
+        if (t.candidates_.empty())
+        {
+            HPX_THROW_EXCEPTION(bad_parameter, "autotuner::add",
+                "tunable '" + t.name_ + "' has no candidate values");
+        }
+        if (iterations_ != 0 || current_samples_ != 0)
+        {
+            HPX_THROW_EXCEPTION(invalid_status, "autotuner::add",
+                "tunables have to be added before the first iteration");
+        }
+
+        tunables_.push_back(std::move(t));
+        current_.push_back(start);
+    }
+
+    void autotuner::add_tunable(std::string const& name,
+        std::vector<std::int64_t> candidates, setter_type setter)
+    {
+        std::size_t start = candidates.size() / 2;
+        add(tunable{name, std::move(candidates), std::move(setter), false},
+            start);
+    }
+
+    void autotuner::add_config_tunable(std::string const& key,
+        std::vector<std::int64_t> candidates)
+    {
+        // start at the configured value, if possible
+        std::size_t start = candidates.size() / 2;
+
+        std::string value = hpx::get_config_entry(key, "");
+        if (!value.empty())
+        {
+            auto it = std::find(candidates.begin(), candidates.end(),
+                util::safe_lexical_cast<std::int64_t>(value,
+                    (std::numeric_limits<std::int64_t>::min)()));
+            if (it != candidates.end())
+                start = std::distance(candidates.begin(), it);
+        }
+
+        add(tunable{key, std::move(candidates), setter_type(), true}, start);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void autotuner::apply(configuration const& config)
+    {
+        for (std::size_t i = 0; i != tunables_.size(); ++i)
+        {
+            if (applied_.size() == config.size() && applied_[i] == config[i])
+                continue;
+
+            tunable& t = tunables_[i];
+            std::int64_t value = t.candidates_[config[i]];
+            if (t.is_config_)
+                hpx::set_config_entry(t.name_, std::to_string(value));
+            else
+                t.setter_(value);
+        }
+        applied_ = config;
+    }
+
+    void autotuner::configuration_done(double score)
+    {
+        scores_[current_] = score;
+        if (score < best_score_)
+        {
+            best_score_ = score;
+            best_ = current_;
+        }
+    }
+
+    // Select the next configuration to measure, a neighbour of the best one
+    // which has not been measured yet. Return false if there is none left.
+    bool autotuner::next_configuration()
+    {
+        for (std::size_t i = 0; i != best_.size(); ++i)
+        {
+            configuration config = best_;
+            if (best_[i] != 0)
+            {
+                --config[i];
+                if (scores_.find(config) == scores_.end())
+                {
+                    current_ = std::move(config);
+                    return true;
+                }
+                ++config[i];
+            }
+
+            if (best_[i] + 1 != tunables_[i].candidates_.size())
+            {
+                ++config[i];
+                if (scores_.find(config) == scores_.end())
+                {
+                    current_ = std::move(config);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void autotuner::lock_in()
+    {
+        tuning_ = false;
+        if (best_.empty())
+            best_ = current_;       // nothing has been measured completely
+        apply(best_);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void autotuner::begin_iteration()
+    {
+        if (tuning_)
+            apply(current_);
+
+        if (!counter_name_.empty())
+            counter_.reset(launch::sync);
+
+        timer_.restart();
+    }
+
+    void autotuner::end_iteration()
+    {
+        if (counter_name_.empty())
+            end_iteration(timer_.elapsed());
+        else
+            end_iteration(counter_.get_value<double>(launch::sync, true));
+    }
+
+    void autotuner::end_iteration(double objective)
+    {
+        ++iterations_;
+        if (!tuning_)
+            return;
+
+        current_score_ = (std::min)(current_score_, objective);
+        if (++current_samples_ == samples_)
+        {
+            configuration_done(current_score_);
+
+            current_samples_ = 0;
+            current_score_ = (std::numeric_limits<double>::max)();
+
+            if (!next_configuration())
+            {
+                lock_in();
+                return;
+            }
+        }
+
+        if (iterations_ >= warmup_iterations_)
+            lock_in();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t autotuner::get(std::string const& name) const
+    {
+        for (std::size_t i = 0; i != tunables_.size(); ++i)
+        {
+            if (tunables_[i].name_ == name)
+            {
+                configuration const& config =
+                    applied_.empty() ? current_ : applied_;
+                return tunables_[i].candidates_[config[i]];
+            }
+        }
+
+        HPX_THROW_EXCEPTION(bad_parameter, "autotuner::get",
+            "unknown tunable '" + name + "'");
+        return 0;
+    }
+
+    std::vector<std::pair<std::string, std::int64_t> > autotuner::best() const
+    {
+        configuration const& config = best_.empty() ? current_ : best_;
+
+        std::vector<std::pair<std::string, std::int64_t> > result;
+        result.reserve(tunables_.size());
+        for (std::size_t i = 0; i != tunables_.size(); ++i)
+        {
+            result.emplace_back(tunables_[i].name_,
+                tunables_[i].candidates_[config[i]]);
+        }
+        return result;
+    }
+
+    void autotuner::save(std::string const& filename) const
+    {
+        configuration const& config = best_.empty() ? current_ : best_;
+
+        // group the entries by their section
+        std::map<std::string, std::vector<std::string> > sections;
+        for (std::size_t i = 0; i != tunables_.size(); ++i)
+        {
+            tunable const& t = tunables_[i];
+            if (!t.is_config_)
+                continue;
+
+            std::string::size_type p = t.name_.find_last_of('.');
+            std::string section =
+                p == std::string::npos ? "" : t.name_.substr(0, p);
+            sections[section].push_back(t.name_.substr(p + 1) + " = " +
+                std::to_string(t.candidates_[config[i]]));
+        }
+
+        std::ofstream out(filename);
+        if (!out)
+        {
+            HPX_THROW_EXCEPTION(filesystem_error, "autotuner::save",
+                "could not open '" + filename + "' for writing");
+        }
+
+        out << "# written by hpx::util::autotuner\n";
+        for (auto const& section : sections)
+        {
+            if (!section.first.empty())
+                out << "\n[" << section.first << "]\n";
+            for (std::string const& entry : section.second)
+                out << entry << "\n";
+        }
+    }
+}}
@@ -10,6 +10,7 @@
 #include <hpx/runtime/threads/topology.hpp>
 #include <hpx/util/asio_util.hpp>
 #include <hpx/util/batch_environment.hpp>
+#include <hpx/util/pmix_environment.hpp>
 #include <hpx/util/runtime_configuration.hpp>
 
 #include <hpx/util/batch_environments/alps_environment.hpp>
@@ -38,6 +39,24 @@ namespace hpx { namespace util
         if (!enable)
             return;
 
+        init_from_batch_system(nodelist, cfg, debug);
+
+        // A PMIx enabled launcher provides the rank and the size of the job
+        // directly, the rank of the AGAS root is always zero. The batch
+        // environment (if any) still provides the number of threads.
+        if(pmix_environment::init(cfg))
+        {
+            batch_name_ = batch_name_.empty() ? "PMIx" : batch_name_ + " (PMIx)";
+            node_num_ = pmix_environment::rank();
+            num_localities_ = pmix_environment::size();
+            agas_node_num_ = 0;
+        }
+    }
+
+    void batch_environment::init_from_batch_system(
+        std::vector<std::string> & nodelist,
+        util::runtime_configuration const& cfg, bool debug)
+    {
         batch_environments::alps_environment alps_env(nodelist, debug);
         if(alps_env.valid())
         {
@@ -0,0 +1,665 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/checkpoint_file.hpp>
+
+#if !defined(HPX_WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace util { namespace detail
+{
+    namespace
+    {
+        char const checkpoint_file_magic[8] = "HPXCKPT";
+        std::uint32_t const checkpoint_file_version = 2;
+
+        // the alignment of all blocks and metadata in the file, this is what
+        // O_DIRECT requires on all common file systems
+        std::size_t const alignment = 4096;
+
+        std::size_t round_up(std::size_t size)
+        {
+            return (size + alignment - 1) & ~(alignment - 1);
+        }
+
+        std::string last_error(char const* what, std::string const& name)
+        {
+            return std::string(what) + " (" + name + "): " +
+                std::strerror(errno);
+        }
+
+        // The content of the blocks is compared using this hash only, it
+        // processes 8 bytes at a time and includes the length of the block.
+        std::uint64_t hash_block(char const* data, std::size_t size)
+        {
+            std::uint64_t const prime = 0x100000001b3ull;
+            std::uint64_t h = 0xcbf29ce484222325ull ^ size;
+
+            std::size_t i = 0;
+            for (/**/; i + sizeof(std::uint64_t) <= size;
+                 i += sizeof(std::uint64_t))
+            {
+                std::uint64_t w;
+                std::memcpy(&w, data + i, sizeof(w));
+                h = (h ^ w) * prime;
+                h ^= h >> 29;
+            }
+            for (/**/; i != size; ++i)
+                h = (h ^ std::uint8_t(data[i])) * prime;
+
+            // final mix (MurmurHash3)
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdull;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ull;
+            h ^= h >> 33;
+            return h;
+        }
+
+        bool is_valid(checkpoint_file_header const& header)
+        {
+            return std::memcmp(header.magic_, checkpoint_file_magic,
+                       sizeof(checkpoint_file_magic)) == 0 &&
+                header.version_ == checkpoint_file_version &&
+                header.block_size_ != 0;
+        }
+
+#if !defined(HPX_WINDOWS)
+        char* allocate_buffer(std::size_t size)
+        {
+            void* p = nullptr;
+            if (::posix_memalign(&p, alignment, size) != 0)
+                throw std::bad_alloc();
+            return static_cast<char*>(p);
+        }
+
+        void write_at(int fd, std::string const& filename, char const* data,
+            std::size_t size, std::size_t offset)
+        {
+            while (size != 0)
+            {
+                ssize_t written = ::pwrite(fd, data, size, off_t(offset));
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    HPX_THROW_EXCEPTION(filesystem_error,
+                        "checkpoint_file_sink::write",
+                        last_error("pwrite failed", filename));
+                }
+                data += written;
+                size -= std::size_t(written);
+                offset += std::size_t(written);
+            }
+        }
+
+        bool read_at(int fd, char* data, std::size_t size, std::size_t offset)
+        {
+            while (size != 0)
+            {
+                ssize_t read = ::pread(fd, data, size, off_t(offset));
+                if (read < 0 && errno == EINTR)
+                    continue;
+                if (read <= 0)
+                    return false;
+                data += read;
+                size -= std::size_t(read);
+                offset += std::size_t(read);
+            }
+            return true;
+        }
+
+        // Read the hashes of the blocks of an existing checkpoint file
+        // written with the given block size.
+        std::vector<std::uint64_t> read_hashes(
+            std::string const& filename, std::size_t block_size)
+        {
+            std::vector<std::uint64_t> hashes;
+
+            int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd == -1)
+                return hashes;
+
+            checkpoint_file_header header;
+            if (read_at(fd, reinterpret_cast<char*>(&header), sizeof(header),
+                    0) &&
+                is_valid(header) && header.block_size_ == block_size)
+            {
+                hashes.resize(header.num_blocks_);
+                if (!read_at(fd, reinterpret_cast<char*>(hashes.data()),
+                        hashes.size() * sizeof(std::uint64_t),
+                        header.data_offset_ +
+                            header.num_blocks_ * header.block_size_))
+                {
+                    hashes.clear();
+                }
+            }
+
+            ::close(fd);
+            return hashes;
+        }
+#endif
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    checkpoint_file_sink::checkpoint_file_sink(std::string const& filename,
+            checkpoint_file_options const& options)
+      : filename_(filename)
+      , path_(options.incremental_ ? filename : filename + ".tmp")
+      , options_(options)
+      , fd_(-1)
+      , finished_(false)
+      , size_(0)
+      , written_(0)
+      , offset_(0)
+      , num_blocks_(0)
+      , data_offset_(round_up(sizeof(checkpoint_file_header)))
+      , current_(nullptr)
+      , blocks_written_(0)
+    {
+#if defined(HPX_WINDOWS)
+        HPX_THROW_EXCEPTION(not_implemented,
+            "checkpoint_file_sink::checkpoint_file_sink",
+            "checkpoint files are not supported on this platform");
+#else
+        options_.block_size_ =
+            round_up((std::max)(options_.block_size_, std::size_t(1)));
+        options_.max_pending_writes_ =
+            (std::max)(options_.max_pending_writes_, std::size_t(1));
+
+        // A new checkpoint is written to a temporary file which replaces
+        // the previous one once it is complete. This leaves the previous
+        // checkpoint intact on failures and keeps existing mappings of it
+        // valid.
+        int flags = O_WRONLY | O_CREAT | O_CLOEXEC;
+        if (options_.incremental_)
+            previous_hashes_ = read_hashes(filename_, options_.block_size_);
+        else
+            flags |= O_TRUNC;
+
+#if defined(O_DIRECT)
+        if (options_.direct_io_)
+        {
+            fd_ = ::open(path_.c_str(), flags | O_DIRECT, 0644);
+
+            // not all file systems support O_DIRECT
+            if (fd_ == -1 && errno != EINVAL)
+            {
+                HPX_THROW_EXCEPTION(filesystem_error,
+                    "checkpoint_file_sink::checkpoint_file_sink",
+                    last_error("open failed", path_));
+            }
+        }
+#endif
+        if (fd_ == -1)
+        {
+            fd_ = ::open(path_.c_str(), flags, 0644);
+            if (fd_ == -1)
+            {
+                HPX_THROW_EXCEPTION(filesystem_error,
+                    "checkpoint_file_sink::checkpoint_file_sink",
+                    last_error("open failed", path_));
+            }
+        }
+
+        try {
+            // the header is written last, a file which is being updated
+            // in place is not a valid checkpoint before it is complete
+            buffers_.reserve(options_.max_pending_writes_ + 1);
+            for (std::size_t i = 0; i != options_.max_pending_writes_ + 1; ++i)
+                buffers_.push_back(allocate_buffer(options_.block_size_));
+
+            if (!previous_hashes_.empty())
+            {
+                std::memset(buffers_.front(), 0, alignment);
+                write_at(fd_, path_, buffers_.front(), alignment, 0);
+            }
+        }
+        catch (...) {
+            for (char* buffer : buffers_)
+                std::free(buffer);
+            ::close(fd_);
+            if (path_ != filename_)
+                ::unlink(path_.c_str());
+            throw;
+        }
+
+        free_buffers_ = buffers_;
+        current_ = free_buffers_.back();
+        free_buffers_.pop_back();
+#endif
+    }
+
+    checkpoint_file_sink::~checkpoint_file_sink()
+    {
+#if !defined(HPX_WINDOWS)
+        // the blocks still being written refer to the buffers
+        for (pending_write& w : pending_)
+            w.hash_.wait();
+
+        for (char* buffer : buffers_)
+            std::free(buffer);
+        ::close(fd_);
+
+        if (!finished_ && path_ != filename_)
+            ::unlink(path_.c_str());
+#endif
+    }
+
+    void checkpoint_file_sink::write(std::size_t count, std::size_t current,
+        void const* address)
+    {
+        HPX_ASSERT(current == written_);
+        HPX_UNUSED(current);
+
+        append(static_cast<char const*>(address), count);
+    }
+
+    void checkpoint_file_sink::append(char const* data, std::size_t count)
+    {
+        while (count != 0)
+        {
+            std::size_t n = (std::min)(count, options_.block_size_ - offset_);
+            std::memcpy(current_ + offset_, data, n);
+
+            offset_ += n;
+            written_ += n;
+            data += n;
+            count -= n;
+
+            if (offset_ == options_.block_size_)
+                submit();
+        }
+    }
+
+    bool checkpoint_file_sink::is_unchanged(
+        std::size_t index, std::uint64_t hash) const
+    {
+        return index < previous_hashes_.size() &&
+            previous_hashes_[index] == hash;
+    }
+
+    // Hash the current block and write it asynchronously, unless it is
+    // known to be unchanged.
+    void checkpoint_file_sink::submit()
+    {
+#if !defined(HPX_WINDOWS)
+        std::size_t index = num_blocks_++;
+        char* buffer = current_;
+        std::size_t size = offset_;
+
+        hashes_.push_back(0);
+
+        hpx::future<std::uint64_t> f = hpx::async(
+            [this, index, buffer, size]() -> std::uint64_t
+            {
+                std::uint64_t hash = hash_block(buffer, size);
+                if (is_unchanged(index, hash))
+                    return hash;
+
+                std::size_t length = size;
+                if (options_.direct_io_)
+                {
+                    length = round_up(size);
+                    std::memset(buffer + size, 0, length - size);
+                }
+
+                write_at(fd_, path_, buffer, length,
+                    data_offset_ + index * options_.block_size_);
+
+                ++blocks_written_;
+                return hash;
+            });
+
+        pending_.push_back(pending_write{index, buffer, std::move(f)});
+
+        current_ = nullptr;
+        offset_ = 0;
+
+        if (free_buffers_.empty())
+            wait_for_oldest();
+
+        current_ = free_buffers_.back();
+        free_buffers_.pop_back();
+#endif
+    }
+
+    void checkpoint_file_sink::wait_for_oldest()
+    {
+        pending_write w = std::move(pending_.front());
+        pending_.pop_front();
+
+        // make sure the buffer is available even if the write failed
+        w.hash_.wait();
+        free_buffers_.push_back(w.buffer_);
+
+        hashes_[w.index_] = w.hash_.get();
+    }
+
+    void checkpoint_file_sink::wait_all()
+    {
+        while (!pending_.empty())
+            wait_for_oldest();
+    }
+
+    std::size_t checkpoint_file_sink::finish(
+        std::vector<serialization::serialization_chunk> const& chunks)
+    {
+#if defined(HPX_WINDOWS)
+        return 0;
+#else
+        HPX_ASSERT(written_ == size_);
+
+        // the data of the pointer chunks follows the archive
+        std::size_t archive_size = written_;
+
+        std::vector<checkpoint_file_chunk> chunk_table;
+        chunk_table.reserve(chunks.size());
+        for (serialization::serialization_chunk const& c : chunks)
+        {
+            if (c.type_ == serialization::chunk_type_index)
+            {
+                chunk_table.push_back(checkpoint_file_chunk{
+                    c.type_, c.data_.index_, c.size_});
+                continue;
+            }
+
+            static char const padding[chunk_alignment] = {};
+            append(padding,
+                (chunk_alignment - written_ % chunk_alignment) %
+                    chunk_alignment);
+
+            chunk_table.push_back(checkpoint_file_chunk{
+                c.type_, written_, c.size_});
+            append(static_cast<char const*>(c.data_.cpos_), c.size_);
+        }
+
+        if (offset_ != 0)
+            submit();
+        wait_all();
+
+        // the tables of hashes and chunks directly follow the data
+        std::size_t table_offset =
+            data_offset_ + num_blocks_ * options_.block_size_;
+        std::size_t hashes_size = hashes_.size() * sizeof(std::uint64_t);
+        std::size_t table_size = hashes_size +
+            chunk_table.size() * sizeof(checkpoint_file_chunk);
+        if (table_size != 0)
+        {
+            std::size_t length = round_up(table_size);
+            char* table = allocate_buffer(length);
+            std::memcpy(table, hashes_.data(), hashes_size);
+            std::memcpy(table + hashes_size, chunk_table.data(),
+                table_size - hashes_size);
+            std::memset(table + table_size, 0, length - table_size);
+
+            try {
+                write_at(fd_, path_, table,
+                    options_.direct_io_ ? length : table_size, table_offset);
+            }
+            catch (...) {
+                std::free(table);
+                throw;
+            }
+            std::free(table);
+        }
+
+        if (::ftruncate(fd_, off_t(table_offset + table_size)) == -1 ||
+            ::fdatasync(fd_) == -1)
+        {
+            HPX_THROW_EXCEPTION(filesystem_error,
+                "checkpoint_file_sink::finish",
+                last_error("flushing the checkpoint file failed", path_));
+        }
+
+        // the header makes the file a valid checkpoint once all of the data
+        // has been written
+        char* page = free_buffers_.back();
+        std::memset(page, 0, alignment);
+
+        checkpoint_file_header header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic_, checkpoint_file_magic,
+            sizeof(checkpoint_file_magic));
+        header.version_ = checkpoint_file_version;
+        header.block_size_ = options_.block_size_;
+        header.data_size_ = written_;
+        header.archive_size_ = archive_size;
+        header.num_blocks_ = num_blocks_;
+        header.num_chunks_ = chunk_table.size();
+        header.data_offset_ = data_offset_;
+        std::memcpy(page, &header, sizeof(header));
+
+        write_at(fd_, path_, page,
+            options_.direct_io_ ? alignment : sizeof(header), 0);
+
+        if (::fdatasync(fd_) == -1)
+        {
+            HPX_THROW_EXCEPTION(filesystem_error,
+                "checkpoint_file_sink::finish",
+                last_error("flushing the checkpoint file failed", path_));
+        }
+
+        if (path_ != filename_ &&
+            ::rename(path_.c_str(), filename_.c_str()) == -1)
+        {
+            HPX_THROW_EXCEPTION(filesystem_error,
+                "checkpoint_file_sink::finish",
+                last_error("rename failed", filename_));
+        }
+        finished_ = true;
+
+        return blocks_written_.load();
+#endif
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    checkpoint_file_mapping::checkpoint_file_mapping(
+            std::string const& filename, bool verify_hashes)
+      : base_(nullptr)
+      , mapped_size_(0)
+      , data_(nullptr)
+      , size_(0)
+      , archive_size_(0)
+    {
+#if defined(HPX_WINDOWS)
+        HPX_THROW_EXCEPTION(not_implemented,
+            "checkpoint_file_mapping::checkpoint_file_mapping",
+            "checkpoint files are not supported on this platform");
+#else
+        int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1)
+        {
+            HPX_THROW_EXCEPTION(filesystem_error,
+                "checkpoint_file_mapping::checkpoint_file_mapping",
+                last_error("open failed", filename));
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) == -1)
+        {
+            std::string msg = last_error("fstat failed", filename);
+            ::close(fd);
+            HPX_THROW_EXCEPTION(filesystem_error,
+                "checkpoint_file_mapping::checkpoint_file_mapping", msg);
+        }
+
+        std::size_t file_size = std::size_t(st.st_size);
+        if (file_size < sizeof(checkpoint_file_header))
+        {
+            ::close(fd);
+            HPX_THROW_EXCEPTION(serialization_error,
+                "checkpoint_file_mapping::checkpoint_file_mapping",
+                "'" + filename + "' is not a checkpoint file");
+        }
+
+        // the restored objects may modify the data referenced in place
+        void* base = ::mmap(nullptr, file_size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE, fd, 0);
+        ::close(fd);
+
+        if (base == MAP_FAILED)
+        {
+            HPX_THROW_EXCEPTION(filesystem_error,
+                "checkpoint_file_mapping::checkpoint_file_mapping",
+                last_error("mmap failed", filename));
+        }
+
+        base_ = base;
+        mapped_size_ = file_size;
+
+        try {
+            checkpoint_file_header header;
+            std::memcpy(&header, base_, sizeof(header));
+
+            std::size_t blocks_size = header.num_blocks_ * header.block_size_;
+            if (!is_valid(header) ||
+                header.archive_size_ > header.data_size_ ||
+                header.data_size_ > blocks_size ||
+                header.data_offset_ + blocks_size +
+                        header.num_blocks_ * sizeof(std::uint64_t) +
+                        header.num_chunks_ * sizeof(checkpoint_file_chunk) >
+                    file_size)
+            {
+                HPX_THROW_EXCEPTION(serialization_error,
+                    "checkpoint_file_mapping::checkpoint_file_mapping",
+                    "'" + filename + "' is not a valid checkpoint file");
+            }
+
+            data_ = static_cast<char const*>(base_) + header.data_offset_;
+            size_ = header.data_size_;
+            archive_size_ = header.archive_size_;
+
+            if (verify_hashes)
+            {
+                ::madvise(base_, mapped_size_, MADV_WILLNEED); // ignore errors
+                this->verify(header);
+            }
+
+            // the pointer chunks refer to the mapped data
+            char const* table = data_ + blocks_size +
+                header.num_blocks_ * sizeof(std::uint64_t);
+
+            chunks_.reserve(header.num_chunks_);
+            for (std::size_t i = 0; i != header.num_chunks_; ++i)
+            {
+                checkpoint_file_chunk c;
+                std::memcpy(&c, table + i * sizeof(c), sizeof(c));
+
+                if (c.type_ == serialization::chunk_type_index &&
+                    c.offset_ + c.size_ <= archive_size_)
+                {
+                    chunks_.push_back(serialization::create_index_chunk(
+                        c.offset_, c.size_));
+                }
+                else if (c.type_ == serialization::chunk_type_pointer &&
+                    c.offset_ + c.size_ <= size_)
+                {
+                    chunks_.push_back(serialization::create_pointer_chunk(
+                        data_ + c.offset_, c.size_));
+                }
+                else
+                {
+                    HPX_THROW_EXCEPTION(serialization_error,
+                        "checkpoint_file_mapping::checkpoint_file_mapping",
+                        "'" + filename + "' is not a valid checkpoint file");
+                }
+            }
+        }
+        catch (...) {
+            ::munmap(base_, mapped_size_);
+            throw;
+        }
+#endif
+    }
+
+    checkpoint_file_mapping::~checkpoint_file_mapping()
+    {
+#if !defined(HPX_WINDOWS)
+        ::munmap(base_, mapped_size_);
+#endif
+    }
+
+    // The hashes of the blocks are verified concurrently, this also faults
+    // in the pages of the file in parallel before they are deserialized.
+    void checkpoint_file_mapping::verify(
+        checkpoint_file_header const& header) const
+    {
+        char const* data =
+            static_cast<char const*>(base_) + header.data_offset_;
+        char const* table = data + header.num_blocks_ * header.block_size_;
+
+        std::size_t num_blocks = header.num_blocks_;
+        std::size_t block_size = header.block_size_;
+        std::size_t data_size = header.data_size_;
+
+        std::size_t num_tasks = (std::min)(
+            num_blocks, (std::max)(hpx::get_os_thread_count(), std::size_t(1)));
+
+        std::atomic<bool> corrupted(false);
+        std::vector<hpx::future<void>> tasks;
+        tasks.reserve(num_tasks);
+
+        for (std::size_t t = 0; t != num_tasks; ++t)
+        {
+            std::size_t begin = t * num_blocks / num_tasks;
+            std::size_t end = (t + 1) * num_blocks / num_tasks;
+
+            tasks.push_back(hpx::async(
+                [=, &corrupted]()
+                {
+                    for (std::size_t i = begin; i != end; ++i)
+                    {
+                        std::size_t size = (std::min)(
+                            block_size, data_size - i * block_size);
+
+                        std::uint64_t expected;
+                        std::memcpy(&expected,
+                            table + i * sizeof(std::uint64_t),
+                            sizeof(expected));
+
+                        if (hash_block(data + i * block_size, size) !=
+                            expected)
+                        {
+                            corrupted.store(true);
+                            return;
+                        }
+                    }
+                }));
+        }
+
+        hpx::wait_all(tasks);
+
+        if (corrupted.load())
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "checkpoint_file_mapping::verify",
+                "the checkpoint file is corrupted");
+        }
+    }
+}}}
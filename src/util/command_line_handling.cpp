@@ -26,6 +26,7 @@
 #include <hpx/util/parse_command_line.hpp>
 #include <hpx/util/safe_lexical_cast.hpp>
 #include <hpx/util/sed_transform.hpp>
+#include <hpx/util/startup_timings.hpp>
 #include <hpx/version.hpp>
 
 #include <boost/asio/ip/host_name.hpp>
@@ -951,6 +952,9 @@ namespace hpx { namespace util
                 ini_config += "hpx.print_counter.reset!=1";
         }
 
+        if (vm.count("hpx:print-startup-timings"))
+            ini_config += "hpx.print_startup_timings!=1";
+
         if (debug_clp) {
             std::cerr << "Configuration before runtime start:\n";
             std::cerr << "-----------------------------------\n";
@@ -1277,6 +1281,8 @@ namespace hpx { namespace util
         // set the flag signaling that command line parsing has been done
         cmd_line_parsed_ = true;
 
+        util::startup_timings::start();
+
         // separate command line arguments from configuration settings
         std::vector<std::string> args = preprocess_config_settings(argc, argv);
 
@@ -1354,11 +1360,15 @@ namespace hpx { namespace util
         util::detail::init_logging(
             rtcfg_, rtcfg_.mode_ == runtime_mode_console);
 
+        util::startup_timings::record("command line handling");
+
         // load plugin modules (after first pass of command line handling,
         // so that settings given on command line could propagate to modules)
         std::vector<std::shared_ptr<plugins::plugin_registry_base> >
             plugin_registries = rtcfg_.load_modules();
 
+        util::startup_timings::record("module discovery");
+
         // Re-run program option analysis, ini settings (such as aliases)
         // will be considered now.
 
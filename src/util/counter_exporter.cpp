@@ -0,0 +1,324 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/compat/condition_variable.hpp>
+#include <hpx/compat/mutex.hpp>
+#include <hpx/compat/thread.hpp>
+#include <hpx/performance_counters/counters.hpp>
+#include <hpx/performance_counters/server/base_performance_counter.hpp>
+#include <hpx/runtime.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/get_ptr.hpp>
+#include <hpx/runtime_fwd.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/counter_exporter.hpp>
+
+#if !defined(HPX_WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace hpx { namespace util
+{
+    namespace
+    {
+        std::string last_error(char const* what, std::string const& name)
+        {
+            return std::string(what) + " (" + name + "): " +
+                std::strerror(errno);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    counter_exporter::counter_exporter(std::vector<std::string> const& names,
+            std::string const& segment_name, std::size_t interval)
+      : names_(names)
+      , base_name_(segment_name)
+      , interval_(interval == 0 ? 1 : interval)
+      , base_(nullptr)
+      , size_(0)
+      , stop_requested_(false)
+    {
+#if !defined(HPX_WINDOWS)
+        if (base_name_.empty())
+            base_name_ = "/hpx-counters." + std::to_string(::getpid());
+#endif
+        if (!base_name_.empty() && base_name_[0] != '/')
+            base_name_ = "/" + base_name_;
+    }
+
+    counter_exporter::~counter_exporter()
+    {
+        stop();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void counter_exporter::find_counters()
+    {
+        using namespace performance_counters;
+
+        std::uint32_t const locality_id = hpx::get_locality_id();
+
+        for (std::string const& name : names_)
+        {
+            std::vector<counter_info> infos;
+            discover_counter_type(name, infos, discover_counters_full);
+
+            for (counter_info const& info : infos)
+            {
+                if (info.type_ != counter_raw &&
+                    info.type_ != counter_elapsed_time)
+                {
+                    HPX_THROW_EXCEPTION(bad_parameter,
+                        "counter_exporter::find_counters",
+                        "only counters reporting raw values can be exported, "
+                        "derived counters have to be evaluated by the "
+                        "reader: " + info.fullname_);
+                }
+
+                counter_path_elements p;
+                get_counter_path_elements(info.fullname_, p);
+
+                // only counters of this locality can be sampled directly
+                if (p.parentinstancename_ != "locality" ||
+                    p.parentinstanceindex_ != std::int64_t(locality_id))
+                {
+                    continue;
+                }
+
+                // keep the counter component alive while it is sampled
+                naming::id_type id = get_counter(info.fullname_);
+
+                counter c;
+                c.name_ = info.fullname_;
+                c.counter_ = hpx::get_ptr<server::base_performance_counter>(
+                    launch::sync, id);
+                counters_.push_back(std::move(c));
+            }
+        }
+    }
+
+    void counter_exporter::start()
+    {
+        find_counters();
+        if (counters_.empty())
+            return;
+
+        create_segment(hpx::get_locality_id());
+        values_.resize(counters_.size());
+
+        // publish an initial sample before the segment is considered valid
+        sample();
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(header().magic_, "HPXCNTRS", sizeof(header().magic_));
+
+        sampling_thread_ = compat::thread(&counter_exporter::run, this);
+    }
+
+    void counter_exporter::stop()
+    {
+        {
+            std::lock_guard<compat::mutex> l(mtx_);
+            stop_requested_ = true;
+        }
+        cond_.notify_all();
+
+        if (sampling_thread_.joinable())
+            sampling_thread_.join();
+
+        counters_.clear();
+        remove_segment();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void counter_exporter::create_segment(std::uint32_t locality_id)
+    {
+#if defined(HPX_WINDOWS)
+        HPX_THROW_EXCEPTION(not_implemented,
+            "counter_exporter::create_segment",
+            "exporting performance counters to shared memory is supported on "
+            "POSIX systems only");
+#else
+        segment_name_ = base_name_ + "." + std::to_string(locality_id);
+
+        std::size_t names_offset = sizeof(segment_header) +
+            counters_.size() * sizeof(entry);
+        std::size_t size = names_offset;
+        for (counter const& c : counters_)
+            size += sizeof(std::uint32_t) + c.name_.size();
+
+        int fd = ::shm_open(segment_name_.c_str(),
+            O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd == -1)
+        {
+            std::string name = segment_name_;
+            segment_name_.clear();
+            HPX_THROW_EXCEPTION(network_error,
+                "counter_exporter::create_segment",
+                last_error("shm_open failed", name));
+        }
+
+        if (::ftruncate(fd, off_t(size)) == -1)
+        {
+            std::string msg = last_error("ftruncate failed", segment_name_);
+            ::close(fd);
+            ::shm_unlink(segment_name_.c_str());
+            segment_name_.clear();
+            HPX_THROW_EXCEPTION(network_error,
+                "counter_exporter::create_segment", msg);
+        }
+
+        void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+            MAP_SHARED, fd, 0);
+        ::close(fd);
+
+        if (base == MAP_FAILED)
+        {
+            std::string msg = last_error("mmap failed", segment_name_);
+            ::shm_unlink(segment_name_.c_str());
+            segment_name_.clear();
+            HPX_THROW_EXCEPTION(network_error,
+                "counter_exporter::create_segment", msg);
+        }
+
+        base_ = base;
+        size_ = size;
+
+        // the magic number is written once the first sample is available
+        segment_header* h = new (base_) segment_header;
+        std::memset(h->magic_, 0, sizeof(h->magic_));
+        h->version_ = version;
+        h->locality_id_ = locality_id;
+        h->num_counters_ = counters_.size();
+        h->names_offset_ = names_offset;
+        h->interval_ = interval_;
+        h->sequence_.store(0, std::memory_order_relaxed);
+        h->timestamp_.store(0, std::memory_order_relaxed);
+        h->num_samples_.store(0, std::memory_order_relaxed);
+
+        entry* e = entries();
+        for (std::size_t i = 0; i != counters_.size(); ++i)
+        {
+            new (&e[i]) entry;
+            e[i].value_.store(0, std::memory_order_relaxed);
+            e[i].scaling_.store(1, std::memory_order_relaxed);
+            e[i].count_.store(0, std::memory_order_relaxed);
+            e[i].status_.store(performance_counters::status_invalid_data,
+                std::memory_order_relaxed);
+            e[i].scale_inverse_.store(0, std::memory_order_relaxed);
+        }
+
+        char* names = static_cast<char*>(base_) + names_offset;
+        for (counter const& c : counters_)
+        {
+            std::uint32_t length = std::uint32_t(c.name_.size());
+            std::memcpy(names, &length, sizeof(length));
+            names += sizeof(length);
+            std::memcpy(names, c.name_.data(), length);
+            names += length;
+        }
+#endif
+    }
+
+    void counter_exporter::remove_segment()
+    {
+#if !defined(HPX_WINDOWS)
+        if (base_ != nullptr)
+        {
+            ::munmap(base_, size_);
+            base_ = nullptr;
+            size_ = 0;
+        }
+        if (!segment_name_.empty())
+        {
+            ::shm_unlink(segment_name_.c_str());
+            segment_name_.clear();
+        }
+#endif
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void counter_exporter::run()
+    {
+        runtime* rt = get_runtime_ptr();
+        bool registered = rt != nullptr &&
+            hpx::register_thread(rt, "counter-exporter", throws);
+
+        std::unique_lock<compat::mutex> l(mtx_);
+        while (!stop_requested_)
+        {
+            cond_.wait_for(l, std::chrono::microseconds(interval_));
+            if (stop_requested_)
+                break;
+
+            l.unlock();
+            sample();
+            l.lock();
+        }
+        l.unlock();
+
+        if (registered)
+            hpx::unregister_thread(rt);
+    }
+
+    void counter_exporter::sample()
+    {
+        using namespace performance_counters;
+
+        // evaluate all counters before touching the segment to keep the
+        // write side of the sequence lock short
+        for (std::size_t i = 0; i != counters_.size(); ++i)
+        {
+            try {
+                values_[i] = counters_[i].counter_->get_counter_value(false);
+            }
+            catch (...) {
+                values_[i] = counter_value();
+                values_[i].status_ = status_invalid_data;
+            }
+        }
+
+        segment_header& h = header();
+        std::uint64_t seq = h.sequence_.load(std::memory_order_relaxed);
+
+        h.sequence_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        entry* e = entries();
+        for (std::size_t i = 0; i != values_.size(); ++i)
+        {
+            counter_value const& v = values_[i];
+            e[i].value_.store(v.value_, std::memory_order_relaxed);
+            e[i].scaling_.store(v.scaling_, std::memory_order_relaxed);
+            e[i].count_.store(v.count_, std::memory_order_relaxed);
+            e[i].status_.store(v.status_, std::memory_order_relaxed);
+            e[i].scale_inverse_.store(
+                v.scale_inverse_ ? 1 : 0, std::memory_order_relaxed);
+        }
+        h.timestamp_.store(std::uint64_t(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count()),
+            std::memory_order_relaxed);
+        h.num_samples_.fetch_add(1, std::memory_order_relaxed);
+
+        h.sequence_.store(seq + 2, std::memory_order_release);
+    }
+}}
@@ -5,12 +5,17 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <hpx/config.hpp>
+#include <hpx/async.hpp>
 #include <hpx/runtime/agas/interface.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/runtime_fwd.hpp>
 #include <hpx/util/generate_unique_ids.hpp>
 #include <hpx/util/unlock_guard.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <mutex>
+#include <utility>
 
 namespace hpx { namespace util
 {
@@ -25,11 +30,35 @@ namespace hpx { namespace util
             lower_ = naming::invalid_gid;
 
             naming::gid_type lower;
-            std::size_t count_ = (std::max)(std::size_t(range_delta), count);
+            std::size_t count_ = 0;
 
+            if (next_lower_.valid() && count <= next_size_)
             {
-                unlock_guard<std::unique_lock<mutex_type> > ul(l);
-                lower = hpx::agas::get_next_id(count_);
+                // use the range requested in advance
+                hpx::future<naming::gid_type> f = std::move(next_lower_);
+                count_ = next_size_;
+
+                // the ids are used up faster than AGAS hands out new ranges,
+                // request larger ranges from now on
+                if (!f.is_ready())
+                {
+                    range_size_ = (std::min)(
+                        2 * range_size_, std::size_t(max_range_delta));
+                }
+
+                {
+                    unlock_guard<std::unique_lock<mutex_type> > ul(l);
+                    lower = f.get();
+                }
+            }
+            else
+            {
+                count_ = (std::max)(range_size_, count);
+
+                {
+                    unlock_guard<std::unique_lock<mutex_type> > ul(l);
+                    lower = hpx::agas::get_next_id(count_);
+                }
             }
 
             // we ignore the result if some other thread has already set the
@@ -38,12 +67,34 @@ namespace hpx { namespace util
             {
                 lower_ = lower;
                 upper_ = lower + count_;
+                prefetch_at_ = lower + count_ / 2;
             }
         }
 
         naming::gid_type result = lower_;
         lower_ += count;
+
+        // request the next range once half of the current range is used
+        if (lower_ >= prefetch_at_ && !next_lower_.valid())
+            prefetch_range();
+
         return result;
     }
-}}
 
+    void unique_id_ranges::prefetch_range()
+    {
+        // the range can be requested asynchronously only while the runtime
+        // is up and running, ids needed before that are taken from the
+        // bootstrap id pool
+        if (!hpx::is_running() || threads::get_self_ptr() == nullptr)
+            return;
+
+        std::size_t count = range_size_;
+        next_size_ = count;
+        next_lower_ = hpx::async(
+            [count]()
+            {
+                return hpx::agas::get_next_id(count);
+            });
+    }
+}}
@@ -0,0 +1,100 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/hdr_histogram.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace hpx { namespace util
+{
+    hdr_histogram::hdr_histogram(std::int64_t max_value, int precision_bits)
+      : precision_bits_(precision_bits)
+      , sub_bucket_count_(std::uint64_t(1) << precision_bits)
+      , half_count_(std::uint64_t(1) << (precision_bits - 1))
+      , max_value_(max_value)
+      , size_(0)
+      , count_(0)
+      , max_(0)
+    {
+        if (precision_bits < 1 || precision_bits > 16)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "hdr_histogram::hdr_histogram",
+                "the precision has to be in between 1 and 16 bits");
+        }
+        if (max_value < 1)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "hdr_histogram::hdr_histogram",
+                "the largest trackable value has to be positive");
+        }
+
+        size_ = index_of(static_cast<std::uint64_t>(max_value_)) + 1;
+        counts_.reset(new std::atomic<std::int64_t>[size_]);
+        for (std::size_t i = 0; i != size_; ++i)
+            counts_[i].store(0, std::memory_order_relaxed);
+    }
+
+    std::int64_t hdr_histogram::highest_equivalent_value(
+        std::size_t index) const
+    {
+        if (index < sub_bucket_count_)
+            return static_cast<std::int64_t>(index);
+
+        std::uint64_t offset = index - sub_bucket_count_;
+        int shift = static_cast<int>(offset / half_count_) + 1;
+        std::uint64_t lowest = (offset % half_count_ + half_count_) << shift;
+        return static_cast<std::int64_t>(
+            lowest + (std::uint64_t(1) << shift) - 1);
+    }
+
+    std::int64_t hdr_histogram::value_at_percentile(double percentile) const
+    {
+        // the counts are summed up directly to stay consistent with values
+        // being recorded concurrently
+        std::int64_t total = 0;
+        for (std::size_t i = 0; i != size_; ++i)
+            total += counts_[i].load(std::memory_order_relaxed);
+
+        if (total == 0)
+            return 0;
+
+        if (percentile < 0.0)
+            percentile = 0.0;
+        else if (percentile > 100.0)
+            percentile = 100.0;
+
+        std::int64_t target = static_cast<std::int64_t>(
+            std::ceil(percentile / 100.0 * static_cast<double>(total)));
+        if (target == 0)
+            target = 1;
+
+        std::int64_t max = max_.load(std::memory_order_relaxed);
+        std::int64_t seen = 0;
+        for (std::size_t i = 0; i != size_; ++i)
+        {
+            seen += counts_[i].load(std::memory_order_relaxed);
+            if (seen >= target)
+            {
+                std::int64_t value = highest_equivalent_value(i);
+                return value < max ? value : max;
+            }
+        }
+        return max;
+    }
+
+    void hdr_histogram::reset()
+    {
+        for (std::size_t i = 0; i != size_; ++i)
+            counts_[i].store(0, std::memory_order_relaxed);
+        count_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+}}
@@ -16,6 +16,7 @@
 #include <hpx/util/init_ini_data.hpp>
 #include <hpx/util/logging.hpp>
 #include <hpx/util/plugin.hpp>
+#include <hpx/version.hpp>
 
 #include <boost/assign/std/vector.hpp>
 #include <boost/filesystem/path.hpp>
@@ -25,9 +26,14 @@
 #include <boost/tokenizer.hpp>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -275,7 +281,8 @@ namespace hpx { namespace util
     }
 
     void load_component_factory(hpx::util::plugin::dll& d, util::section& ini,
-        std::string const& curr, std::string name, error_code& ec)
+        std::string const& curr, std::string name,
+        std::vector<std::string>& ini_data, error_code& ec)
     {
         hpx::util::plugin::plugin_factory<components::component_registry_base>
             pf(d, "registry");
@@ -285,7 +292,6 @@ namespace hpx { namespace util
         pf.get_names(names, ec);
         if (ec) return;
 
-        std::vector<std::string> ini_data;
         if (names.empty()) {
             // This HPX module does not export any factories, but
             // might export startup/shutdown functions. Create some
@@ -362,6 +368,173 @@ namespace hpx { namespace util
         return plugin_registries;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        char const* const cache_header = "# HPX component registry cache ";
+
+        bool get_file_info(boost::filesystem::path const& lib,
+            std::uintmax_t& size, std::time_t& last_write_time)
+        {
+            namespace fs = boost::filesystem;
+
+            boost::system::error_code ec;
+            size = fs::file_size(lib, ec);
+            if (ec)
+                return false;
+            last_write_time = fs::last_write_time(lib, ec);
+            return !ec;
+        }
+
+        // Mark the component sections taken from the cache, the component
+        // types of the corresponding library have to be registered once the
+        // library is loaded (see runtime_support::load_component_dynamic).
+        std::vector<std::string> mark_deferred(
+            std::vector<std::string> const& ini_data)
+        {
+            std::vector<std::string> result;
+            result.reserve(ini_data.size() + 1);
+            for (std::string const& line : ini_data)
+            {
+                result.push_back(line);
+                if (0 == line.find("[hpx.components.") &&
+                    line.find('.', 16) == std::string::npos)
+                {
+                    result.push_back("deferred = 1");
+                }
+            }
+            return result;
+        }
+    }
+
+    module_registry_cache::module_registry_cache(std::string const& filename)
+      : filename_(filename), modified_(false)
+    {
+        std::ifstream in(filename_.c_str());
+        if (!in.is_open())
+            return;
+
+        std::string line;
+        if (!std::getline(in, line) ||
+            line != cache_header + hpx::full_version_as_string())
+        {
+            LRT_(info) << "ignoring outdated component registry cache: "
+                << filename_;
+            return;
+        }
+
+        while (std::getline(in, line))
+        {
+            std::istringstream strm(line);
+
+            std::string tag;
+            entry e;
+            std::size_t num_lines = 0;
+            std::string path;
+            strm >> tag >> e.size_ >> e.last_write_time_ >>
+                e.has_components_ >> e.has_plugins_ >> num_lines;
+            std::getline(strm >> std::ws, path);
+            if (strm.fail() || tag != "module" || path.empty())
+            {
+                LRT_(warning) << "ignoring corrupt component registry cache: "
+                    << filename_;
+                cached_.clear();
+                return;
+            }
+
+            e.ini_data_.reserve(num_lines);
+            for (std::size_t i = 0; i != num_lines; ++i)
+            {
+                if (!std::getline(in, line))
+                {
+                    LRT_(warning) << "ignoring truncated component registry "
+                        "cache: " << filename_;
+                    cached_.clear();
+                    return;
+                }
+                e.ini_data_.push_back(line);
+            }
+            cached_[path] = std::move(e);
+        }
+
+        LRT_(info) << "read component registry cache: " << filename_
+            << " (" << cached_.size() << " libraries)";
+    }
+
+    module_registry_cache::entry const* module_registry_cache::find(
+        boost::filesystem::path const& lib)
+    {
+        std::map<std::string, entry>::iterator it = cached_.find(lib.string());
+        if (it == cached_.end())
+            return nullptr;
+
+        std::uintmax_t size = 0;
+        std::time_t last_write_time = 0;
+        if (!get_file_info(lib, size, last_write_time) ||
+            size != it->second.size_ ||
+            last_write_time != it->second.last_write_time_)
+        {
+            return nullptr;
+        }
+
+        return &(current_[it->first] = it->second);
+    }
+
+    void module_registry_cache::insert(
+        boost::filesystem::path const& lib, entry e)
+    {
+        if (!get_file_info(lib, e.size_, e.last_write_time_))
+            return;
+
+        current_[lib.string()] = std::move(e);
+        modified_ = true;
+    }
+
+    void module_registry_cache::save() const
+    {
+        namespace fs = boost::filesystem;
+
+        if (!modified_ && current_.size() == cached_.size())
+            return;
+
+        // several localities may write the cache concurrently, the file is
+        // replaced atomically
+        try {
+            fs::path filename(filename_);
+            fs::path tmp = fs::unique_path(filename.string() + ".%%%%-%%%%");
+            {
+                std::ofstream out(tmp.string().c_str());
+                out << cache_header << hpx::full_version_as_string() << "\n";
+                for (auto const& e : current_)
+                {
+                    out << "module " << e.second.size_ << " "
+                        << e.second.last_write_time_ << " "
+                        << e.second.has_components_ << " "
+                        << e.second.has_plugins_ << " "
+                        << e.second.ini_data_.size() << " "
+                        << e.first << "\n";
+                    for (std::string const& line : e.second.ini_data_)
+                        out << line << "\n";
+                }
+                if (!out)
+                {
+                    out.close();
+                    fs::remove(tmp);
+                    LRT_(warning) << "couldn't write component registry "
+                        "cache: " << filename_;
+                    return;
+                }
+            }
+            fs::rename(tmp, filename);
+            LRT_(info) << "wrote component registry cache: " << filename_;
+        }
+        catch (fs::filesystem_error const& e) {
+            LRT_(warning) << "couldn't write component registry cache: "
+                << filename_ << ": " << e.what();
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
     namespace detail
     {
         inline bool cmppath_less(
@@ -383,7 +556,8 @@ namespace hpx { namespace util
     std::vector<std::shared_ptr<plugins::plugin_registry_base> >
     init_ini_data_default(std::string const& libs, util::section& ini,
         std::map<std::string, boost::filesystem::path>& basenames,
-        std::map<std::string, hpx::util::plugin::dll>& modules)
+        std::map<std::string, hpx::util::plugin::dll>& modules,
+        module_registry_cache* cache)
     {
         namespace fs = boost::filesystem;
 
@@ -479,8 +653,33 @@ namespace hpx { namespace util
         typedef std::pair<fs::path, std::string> libdata_type;
         for (libdata_type const& p : libdata)
         {
+            // libraries exporting plugins are always loaded, for all others
+            // the cached registry information is sufficient
+            if (cache != nullptr)
+            {
+                module_registry_cache::entry const* e = cache->find(p.first);
+                if (e != nullptr && !e->has_plugins_)
+                {
+                    if (e->has_components_)
+                    {
+                        LRT_(info) << "using cached component registry: "
+                            << p.first.string();
+                        ini.parse("<component registry cache>",
+                            mark_deferred(e->ini_data_), false, false);
+                    }
+                    else
+                    {
+                        LRT_(info) << "skipping (cached, not a module): "
+                            << p.first.string();
+                    }
+                    continue;
+                }
+            }
+
             LRT_(info) << "attempting to load: " << p.first.string();
 
+            module_registry_cache::entry cache_entry = {};
+
             // get the handle of the library
             error_code ec(lightweight);
             hpx::util::plugin::dll d(p.first.string(), p.second);
@@ -489,6 +688,8 @@ namespace hpx { namespace util
                 LRT_(info)
                     << "skipping (load_library failed): " << p.first.string()
                     << ": " << get_error_what(ec);
+                if (cache != nullptr)
+                    cache->insert(p.first, std::move(cache_entry));
                 continue;
             }
 
@@ -496,7 +697,8 @@ namespace hpx { namespace util
 
             // get the component factory
             std::string curr_fullname(p.first.parent_path().string());
-            load_component_factory(d, ini, curr_fullname, p.second, ec);
+            load_component_factory(d, ini, curr_fullname, p.second,
+                cache_entry.ini_data_, ec);
             if (ec) {
                 LRT_(info)
                     << "skipping (load_component_factory failed): "
@@ -508,6 +710,7 @@ namespace hpx { namespace util
                 LRT_(debug)
                     << "load_component_factory succeeded: " << p.first.string();
                 must_keep_loaded = true;
+                cache_entry.has_components_ = true;
             }
 
             // get the plugin factory
@@ -527,8 +730,12 @@ namespace hpx { namespace util
                 std::copy(tmp_regs.begin(), tmp_regs.end(),
                     std::back_inserter(plugin_registries));
                 must_keep_loaded = true;
+                cache_entry.has_plugins_ = !tmp_regs.empty();
             }
 
+            if (cache != nullptr)
+                cache->insert(p.first, std::move(cache_entry));
+
             // store loaded library for future use
             if (must_keep_loaded) {
                 modules.insert(std::make_pair(p.second, std::move(d)));
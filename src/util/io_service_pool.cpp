@@ -306,6 +306,35 @@ namespace hpx { namespace util
         return stopped_;
     }
 
+    void io_service_pool::release_threads()
+    {
+        std::lock_guard<compat::mutex> l(mtx_);
+
+        if (stopped_ || threads_.empty())
+            return;
+
+        // Stopping the io_services makes the threads leave run() once the
+        // handler they execute (if any) returns, the pending handlers are
+        // kept.
+        for (std::size_t i = 0; i < io_services_.size(); ++i)
+            io_services_[i]->stop();
+
+        join_locked();
+
+        for (std::size_t i = 0; i < io_services_.size(); ++i)
+            io_services_[i]->reset();
+    }
+
+    std::size_t io_service_pool::poll()
+    {
+        HPX_ASSERT(threads_.empty());
+
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < io_services_.size(); ++i)
+            count += io_services_[i]->poll();
+        return count;
+    }
+
     boost::asio::io_service& io_service_pool::get_io_service(int index)
     {
         // use this function for single group io_service pools only
@@ -0,0 +1,459 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_IO_URING)
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+#include <hpx/util/io_uring.hpp>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace hpx { namespace util { namespace uring
+{
+    namespace
+    {
+        int io_uring_setup(unsigned entries, io_uring_params* params)
+        {
+            return static_cast<int>(
+                ::syscall(__NR_io_uring_setup, entries, params));
+        }
+
+        int io_uring_enter(int fd, unsigned to_submit, unsigned flags)
+        {
+            return static_cast<int>(::syscall(__NR_io_uring_enter, fd,
+                to_submit, 0, flags, nullptr, 0));
+        }
+
+        int io_uring_register(int fd, unsigned opcode, void const* arg,
+            unsigned nr_args)
+        {
+            return static_cast<int>(
+                ::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+        }
+
+        std::string error_message(char const* what, int err)
+        {
+            return std::string(what) + ": " + std::strerror(err);
+        }
+
+        // the maximal number of completions handled at once by one thread
+        std::size_t const max_completions = 64;
+
+        // the size of the memory registered for unused buffer slots
+        std::size_t const placeholder_size = 4096;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    ring::ring(unsigned entries, unsigned num_files)
+      : fd_(-1)
+      , sq_head_(nullptr), sq_tail_(nullptr), sq_flags_(nullptr)
+      , sq_array_(nullptr), sq_mask_(0), sq_entries_(0)
+      , sq_tail_local_(0), sq_submitted_(0), sqes_(nullptr)
+      , pending_(false)
+      , cq_head_(nullptr), cq_tail_(nullptr), cq_mask_(0), cqes_(nullptr)
+      , in_flight_(0)
+      , sq_ring_(MAP_FAILED), sq_ring_size_(0)
+      , cq_ring_(MAP_FAILED), cq_ring_size_(0), sqes_size_(0)
+      , buffers_(nullptr)
+      , placeholder_(nullptr)
+    {
+        // Every connection has at most one operation in flight, make the
+        // completion queue large enough to hold the completions of all
+        // connections which can be registered.
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        params.flags = IORING_SETUP_CQSIZE;
+        params.cq_entries = (std::max)(2 * entries, num_files + entries);
+
+        fd_ = io_uring_setup(entries, &params);
+        if (fd_ < 0)
+        {
+            HPX_THROW_EXCEPTION(kernel_error, "util::uring::ring::ring",
+                error_message("io_uring_setup failed", errno));
+        }
+
+        // map the submission and completion rings, newer kernels use a
+        // single mapping for both
+        sq_ring_size_ =
+            params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_size_ =
+            params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+        bool const single_mmap =
+            (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap)
+        {
+            sq_ring_size_ = cq_ring_size_ =
+                (std::max)(sq_ring_size_, cq_ring_size_);
+        }
+
+        sq_ring_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+        if (sq_ring_ != MAP_FAILED)
+        {
+            cq_ring_ = single_mmap ? sq_ring_ :
+                ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+        }
+        if (cq_ring_ != MAP_FAILED)
+        {
+            sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+            void* sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+            if (sqes != MAP_FAILED)
+                sqes_ = static_cast<io_uring_sqe*>(sqes);
+        }
+
+        if (sqes_ == nullptr)
+        {
+            int const err = errno;
+            release();
+            HPX_THROW_EXCEPTION(kernel_error, "util::uring::ring::ring",
+                error_message("mapping the rings of io_uring failed", err));
+        }
+
+        char* sq = static_cast<char*>(sq_ring_);
+        sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_flags_ = reinterpret_cast<unsigned*>(sq + params.sq_off.flags);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_entries_ =
+            *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_entries);
+        sq_tail_local_ = sq_submitted_ = *sq_tail_;
+
+        char* cq = static_cast<char*>(cq_ring_);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        if (num_files == 0)
+            return;
+
+        // set up the (sparse) table of fixed files, older kernels do not
+        // support empty slots, we use ordinary file descriptors there
+        files_.assign(num_files, -1);
+        if (io_uring_register(fd_, IORING_REGISTER_FILES, files_.data(),
+                num_files) < 0)
+        {
+            files_.clear();
+            return;
+        }
+
+        free_files_.reserve(num_files);
+        for (unsigned i = num_files; i != 0; --i)
+            free_files_.push_back(int(i - 1));
+
+        // register the control blocks of all slots as a single buffer
+        std::size_t const size = num_files * control_block_size;
+        void* buffers = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (buffers == MAP_FAILED)
+            return;
+
+        iovec iov;
+        iov.iov_base = buffers;
+        iov.iov_len = size;
+        if (io_uring_register(fd_, IORING_REGISTER_BUFFERS, &iov, 1) < 0)
+        {
+            ::munmap(buffers, size);
+            return;
+        }
+        buffers_ = static_cast<char*>(buffers);
+        buffer_table_.push_back(iov);
+    }
+
+    ring::~ring()
+    {
+        HPX_ASSERT(in_flight_ == 0);
+        release();
+    }
+
+    void ring::release() noexcept
+    {
+        if (!buffer_table_.empty())
+            io_uring_register(fd_, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+        if (placeholder_ != nullptr)
+            ::munmap(placeholder_, placeholder_size);
+        if (buffers_ != nullptr)
+            ::munmap(buffers_, files_.size() * control_block_size);
+        if (sqes_ != nullptr)
+            ::munmap(sqes_, sqes_size_);
+        if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_)
+            ::munmap(cq_ring_, cq_ring_size_);
+        if (sq_ring_ != MAP_FAILED)
+            ::munmap(sq_ring_, sq_ring_size_);
+        if (fd_ != -1)
+            ::close(fd_);
+
+        buffer_table_.clear();
+        placeholder_ = nullptr;
+        buffers_ = nullptr;
+        sqes_ = nullptr;
+        cq_ring_ = sq_ring_ = MAP_FAILED;
+        fd_ = -1;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    int ring::register_file(int fd)
+    {
+        if (files_.empty())
+            return -1;
+
+        std::lock_guard<mutex_type> l(files_mtx_);
+        if (free_files_.empty())
+            return -1;
+
+        int const index = free_files_.back();
+
+        io_uring_files_update update;
+        std::memset(&update, 0, sizeof(update));
+        update.offset = static_cast<std::uint32_t>(index);
+        update.fds = reinterpret_cast<std::uint64_t>(&fd);
+        if (io_uring_register(fd_, IORING_REGISTER_FILES_UPDATE, &update, 1) < 0)
+            return -1;
+
+        free_files_.pop_back();
+        files_[index] = fd;
+        return index;
+    }
+
+    void ring::unregister_file(int index)
+    {
+        if (index < 0)
+            return;
+
+        std::lock_guard<mutex_type> l(files_mtx_);
+        HPX_ASSERT(std::size_t(index) < files_.size());
+
+        int fd = -1;
+        io_uring_files_update update;
+        std::memset(&update, 0, sizeof(update));
+        update.offset = static_cast<std::uint32_t>(index);
+        update.fds = reinterpret_cast<std::uint64_t>(&fd);
+        io_uring_register(fd_, IORING_REGISTER_FILES_UPDATE, &update, 1);
+
+        files_[index] = -1;
+        free_files_.push_back(index);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Replace the registered buffers by the current table, files_mtx_ is
+    // held. The submission queue is locked as well to keep the ring from
+    // handing operations to the kernel while no buffers are registered.
+    bool ring::update_buffers()
+    {
+        std::lock_guard<mutex_type> l(sq_mtx_);
+
+        io_uring_register(fd_, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+        if (buffer_table_.empty())
+            return true;
+
+        return io_uring_register(fd_, IORING_REGISTER_BUFFERS,
+            buffer_table_.data(), unsigned(buffer_table_.size())) >= 0;
+    }
+
+    int ring::register_buffer(void* data, std::size_t size)
+    {
+        std::lock_guard<mutex_type> l(files_mtx_);
+
+        // the slots of unregistered buffers keep referring to some memory
+        // (older kernels do not support empty slots), which keeps the
+        // indices of all other buffers stable
+        if (placeholder_ == nullptr)
+        {
+            void* placeholder = ::mmap(nullptr, placeholder_size,
+                PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (placeholder == MAP_FAILED)
+                return -1;
+            placeholder_ = placeholder;
+        }
+
+        iovec iov;
+        iov.iov_base = data;
+        iov.iov_len = size;
+
+        int index = -1;
+        if (!free_buffers_.empty())
+        {
+            index = free_buffers_.back();
+            free_buffers_.pop_back();
+            buffer_table_[index] = iov;
+        }
+        else
+        {
+            index = int(buffer_table_.size());
+            buffer_table_.push_back(iov);
+        }
+
+        if (!update_buffers())
+        {
+            buffer_table_[index].iov_base = placeholder_;
+            buffer_table_[index].iov_len = placeholder_size;
+            free_buffers_.push_back(index);
+            update_buffers();
+            return -1;
+        }
+        return index;
+    }
+
+    void ring::unregister_buffer(int index)
+    {
+        if (index < 0)
+            return;
+
+        std::lock_guard<mutex_type> l(files_mtx_);
+        HPX_ASSERT(std::size_t(index) < buffer_table_.size());
+        HPX_ASSERT(buffers_ == nullptr || index != 0);
+
+        buffer_table_[index].iov_base = placeholder_;
+        buffer_table_[index].iov_len = placeholder_size;
+        free_buffers_.push_back(index);
+        update_buffers();
+    }
+
+    int ring::find_buffer(void const* data, std::size_t size) const
+    {
+        char const* first = static_cast<char const*>(data);
+
+        std::lock_guard<mutex_type> l(files_mtx_);
+        for (std::size_t i = 0; i != buffer_table_.size(); ++i)
+        {
+            iovec const& iov = buffer_table_[i];
+            char const* base = static_cast<char const*>(iov.iov_base);
+            if (base != placeholder_ && first >= base &&
+                first + size <= base + iov.iov_len)
+            {
+                return int(i);
+            }
+        }
+        return -1;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Hand the queued entries over to the kernel, sq_mtx_ is held.
+    bool ring::flush()
+    {
+        unsigned const to_submit = sq_tail_local_ - sq_submitted_;
+        pending_.store(false, std::memory_order_relaxed);
+        if (to_submit == 0)
+            return false;
+
+        int const submitted = io_uring_enter(fd_, to_submit, 0);
+        if (submitted < 0)
+        {
+            // the completion queue is full, or the kernel is short of
+            // memory, try again later
+            pending_.store(true, std::memory_order_relaxed);
+            if (errno == EBUSY || errno == EAGAIN || errno == EINTR)
+                return false;
+
+            HPX_THROW_EXCEPTION(kernel_error, "util::uring::ring::flush",
+                error_message("io_uring_enter failed", errno));
+        }
+
+        sq_submitted_ += unsigned(submitted);
+        if (sq_submitted_ != sq_tail_local_)
+            pending_.store(true, std::memory_order_relaxed);
+
+        return submitted != 0;
+    }
+
+    // The submission queue is full: submit the queued entries and, if that
+    // does not succeed, handle completions to make room.
+    void ring::wait_for_sqe(std::unique_lock<mutex_type>& l)
+    {
+        for (std::size_t k = 0; sq_tail_local_ -
+                __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) == sq_entries_; ++k)
+        {
+            if (flush())
+                continue;
+
+            l.unlock();
+            reap();
+            util::detail::yield_k(k, "util::uring::ring::submit");
+            l.lock();
+        }
+    }
+
+    bool ring::reap()
+    {
+        std::unique_lock<mutex_type> l(cq_mtx_, std::try_to_lock);
+        if (!l.owns_lock())
+            return false;
+
+        unsigned head = *cq_head_;
+        unsigned const tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        if (head == tail)
+        {
+            // completions which did not fit into the completion queue are
+            // moved there by the kernel on request only
+            if (in_flight_.load(std::memory_order_relaxed) != 0 &&
+                (__atomic_load_n(sq_flags_, __ATOMIC_RELAXED) &
+                    IORING_SQ_CQ_OVERFLOW))
+            {
+                io_uring_enter(fd_, 0, IORING_ENTER_GETEVENTS);
+            }
+            return false;
+        }
+
+        std::pair<operation*, int> completed[max_completions];
+        std::size_t count = 0;
+        for (/**/; head != tail && count != max_completions; ++head, ++count)
+        {
+            io_uring_cqe const& cqe = cqes_[head & cq_mask_];
+            completed[count] = std::make_pair(
+                reinterpret_cast<operation*>(cqe.user_data), cqe.res);
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+
+        l.unlock();
+
+        // the completion handlers may submit new operations
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            operation& op = *completed[i].first;
+            op.complete_(op, completed[i].second);
+            in_flight_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    bool ring::poll()
+    {
+        bool did_work = false;
+        if (pending_.load(std::memory_order_acquire))
+        {
+            std::unique_lock<mutex_type> l(sq_mtx_, std::try_to_lock);
+            if (l.owns_lock())
+                did_work = flush();
+        }
+
+        if (in_flight_.load(std::memory_order_relaxed) != 0)
+            did_work = reap() || did_work;
+
+        return did_work;
+    }
+}}}
+
+#endif
@@ -0,0 +1,589 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_LOCK_PROFILING)
+#include <hpx/compat/mutex.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/backtrace/backtrace.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/lock_profiler.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// The profiler must not use any of the locks it profiles, all of its
+// internal locks are plain OS mutexes.
+namespace hpx { namespace util { namespace lock_profiling
+{
+    bool lock_profiling_enabled = false;
+
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        char const* const kind_names[] =
+        {
+            "spinlock", "mutex", "shared_mutex", "condition_variable",
+            "scheduler mutex", "untracked"
+        };
+
+        struct site_key
+        {
+            void const* site_;
+            int kind_;
+
+            friend bool operator==(site_key const& lhs, site_key const& rhs)
+            {
+                return lhs.site_ == rhs.site_ && lhs.kind_ == rhs.kind_;
+            }
+
+            friend bool operator<(site_key const& lhs, site_key const& rhs)
+            {
+                return std::less<void const*>()(lhs.site_, rhs.site_) ||
+                    (lhs.site_ == rhs.site_ && lhs.kind_ < rhs.kind_);
+            }
+        };
+
+        struct site_key_hash
+        {
+            std::size_t operator()(site_key const& key) const
+            {
+                return std::hash<void const*>()(key.site_) ^
+                    std::size_t(key.kind_);
+            }
+        };
+
+        // the raw values recorded for the sampled acquisitions
+        struct site_stats
+        {
+            site_stats()
+              : acquisitions_(0), contentions_(0), wait_time_(0),
+                hold_time_(0), contenders_(0), max_contenders_(0)
+            {}
+
+            site_stats& operator+=(site_stats const& rhs)
+            {
+                acquisitions_ += rhs.acquisitions_;
+                contentions_ += rhs.contentions_;
+                wait_time_ += rhs.wait_time_;
+                hold_time_ += rhs.hold_time_;
+                contenders_ += rhs.contenders_;
+                max_contenders_ = (std::max)(max_contenders_,
+                    rhs.max_contenders_);
+                return *this;
+            }
+
+            std::uint64_t acquisitions_;
+            std::uint64_t contentions_;
+            std::uint64_t wait_time_;
+            std::uint64_t hold_time_;
+            std::uint64_t contenders_;      // sum over the contentions
+            std::uint64_t max_contenders_;
+        };
+
+        // a sampled acquisition whose hold time is being measured
+        struct held_lock
+        {
+            void const* lock_;
+            site_key key_;
+            std::uint64_t start_;
+        };
+
+        HPX_STATIC_CONSTEXPR std::size_t max_held_locks = 8;
+
+        // The statistics recorded by one OS thread. The mutex is contended
+        // only while the statistics are being queried.
+        struct thread_data
+        {
+            thread_data()
+              : countdown_(1), num_held_(0)
+            {}
+
+            compat::mutex mtx_;
+            std::unordered_map<site_key, site_stats, site_key_hash> sites_;
+
+            std::size_t countdown_;
+            held_lock held_[max_held_locks];
+            std::size_t num_held_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The number of threads waiting for a lock, kept in a table indexed
+        // by the address of the lock. Locks sharing an entry are counted
+        // together, the contender counts are approximate for that reason.
+        HPX_STATIC_CONSTEXPR std::size_t num_waiter_slots = 256;
+        std::atomic<std::int32_t> waiters[num_waiter_slots];
+
+        inline std::atomic<std::int32_t>& waiters_of(void const* lock)
+        {
+            std::size_t key = reinterpret_cast<std::size_t>(lock);
+            return waiters[((key >> 4) ^ (key >> 12)) % num_waiter_slots];
+        }
+
+        // The wait tokens hold the start time (relative to the start of the
+        // profiling) in the upper 48 bits and the number of contenders in
+        // the lower 16 bits.
+        HPX_STATIC_CONSTEXPR std::uint64_t time_mask =
+            (std::uint64_t(1) << 48) - 1;
+
+        ///////////////////////////////////////////////////////////////////////
+        class profiler
+        {
+            typedef compat::mutex mutex_type;
+
+        public:
+            profiler()
+              : sample_rate_(1), report_top_(0), epoch_(0)
+            {}
+
+            static profiler& get()
+            {
+                static profiler p;
+                return p;
+            }
+
+            // The statistics of an OS thread are never deleted, the OS
+            // threads keep referring to them.
+            thread_data* register_thread()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                threads_.emplace_back(new thread_data);
+                threads_.back()->countdown_ = sample_rate_;
+                return threads_.back().get();
+            }
+
+            void start(std::size_t sample_rate, std::string const& report,
+                std::size_t report_top)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+
+                if (lock_profiling_enabled)
+                {
+                    HPX_THROW_EXCEPTION(invalid_status,
+                        "hpx::util::lock_profiling::start_lock_profiling",
+                        "the lock profiler has already been started");
+                }
+
+                // open the report file right away to fail early
+                if (!report.empty() && report != "cout" && report != "cerr")
+                {
+                    file_.reset(new std::ofstream(report.c_str()));
+                    if (!*file_)
+                    {
+                        file_.reset();
+                        HPX_THROW_EXCEPTION(filesystem_error,
+                            "hpx::util::lock_profiling::start_lock_profiling",
+                            "could not open the lock profiling report file: " +
+                                report);
+                    }
+                }
+
+                sample_rate_ = sample_rate == 0 ? 1 : sample_rate;
+                report_ = report;
+                report_top_ = report_top;
+                epoch_ = util::high_resolution_clock::now();
+
+                // discard the statistics of a previous run
+                for (auto& t : threads_)
+                {
+                    std::lock_guard<compat::mutex> tl(t->mtx_);
+                    t->sites_.clear();
+                    t->countdown_ = sample_rate_;
+                    t->num_held_ = 0;
+                }
+
+                lock_profiling_enabled = true;
+            }
+
+            void stop()
+            {
+                std::string report;
+                std::unique_ptr<std::ofstream> file;
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    if (!lock_profiling_enabled)
+                        return;
+
+                    lock_profiling_enabled = false;
+                    std::swap(report, report_);
+                    std::swap(file, file_);
+                }
+
+                if (file)
+                    write_report(*file, report_top_);
+                else if (report == "cout")
+                    write_report(std::cout, report_top_);
+                else if (report == "cerr")
+                    write_report(std::cerr, report_top_);
+            }
+
+            std::size_t sample_rate() const
+            {
+                return sample_rate_;
+            }
+
+            std::uint64_t now() const
+            {
+                return util::high_resolution_clock::now() - epoch_;
+            }
+
+            // collect the statistics of all OS threads
+            std::map<site_key, site_stats> collect(bool reset_all)
+            {
+                std::map<site_key, site_stats> result;
+
+                std::lock_guard<mutex_type> l(mtx_);
+                for (auto& t : threads_)
+                {
+                    std::lock_guard<compat::mutex> tl(t->mtx_);
+                    for (auto const& s : t->sites_)
+                        result[s.first] += s.second;
+                    if (reset_all)
+                        t->sites_.clear();
+                }
+                return result;
+            }
+
+            // reset the given statistic of the matching call sites
+            template <typename F>
+            void reset(statistic stat, F const& matches)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                for (auto& t : threads_)
+                {
+                    std::lock_guard<compat::mutex> tl(t->mtx_);
+                    for (auto& s : t->sites_)
+                    {
+                        if (!matches(s.first))
+                            continue;
+
+                        switch (stat)
+                        {
+                        case stat_acquisitions:
+                            s.second.acquisitions_ = 0; break;
+                        case stat_contentions:
+                            s.second.contentions_ = 0; break;
+                        case stat_wait_time:
+                            s.second.wait_time_ = 0; break;
+                        case stat_hold_time:
+                            s.second.hold_time_ = 0; break;
+                        case stat_max_contenders:
+                            s.second.max_contenders_ = 0; break;
+                        default:
+                            break;
+                        }
+                    }
+                }
+            }
+
+            std::string const& get_name(site_key const& key)
+            {
+                std::lock_guard<mutex_type> l(names_mtx_);
+
+                auto it = names_.find(key);
+                if (it == names_.end())
+                {
+                    std::string name = kind_names[key.kind_];
+                    name += " at ";
+                    name += util::stack_trace::get_symbol(
+                        const_cast<void*>(key.site_));
+                    it = names_.emplace(key, std::move(name)).first;
+                }
+                return it->second;
+            }
+
+            void write_report(std::ostream& os, std::size_t top);
+
+        private:
+            mutex_type mtx_;
+            std::vector<std::unique_ptr<thread_data> > threads_;
+
+            std::size_t sample_rate_;
+            std::string report_;
+            std::size_t report_top_;
+            std::unique_ptr<std::ofstream> file_;
+            std::uint64_t epoch_;
+
+            mutex_type names_mtx_;
+            std::map<site_key, std::string> names_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        thread_data& get_thread_data()
+        {
+            static HPX_NATIVE_TLS thread_data* data = nullptr;
+            if (HPX_UNLIKELY(data == nullptr))
+                data = profiler::get().register_thread();
+            return *data;
+        }
+
+        // returns whether the current acquisition should be measured
+        inline bool sample(thread_data& t)
+        {
+            if (--t.countdown_ != 0)
+                return false;
+
+            t.countdown_ = profiler::get().sample_rate();
+            return true;
+        }
+
+        void hold_begin(thread_data& t, void const* lock, site_key const& key,
+            std::uint64_t now)
+        {
+            // locks released on another OS thread (HPX threads can migrate
+            // while holding a lock) are never found, the oldest entry is
+            // evicted if there is no room
+            std::size_t pos = t.num_held_;
+            if (pos == max_held_locks)
+            {
+                pos = 0;
+                for (std::size_t i = 1; i != max_held_locks; ++i)
+                {
+                    if (t.held_[i].start_ < t.held_[pos].start_)
+                        pos = i;
+                }
+            }
+            else
+            {
+                ++t.num_held_;
+            }
+
+            held_lock h = { lock, key, now };
+            t.held_[pos] = h;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void profiler::write_report(std::ostream& os, std::size_t top)
+        {
+            std::map<site_key, site_stats> sites = collect(false);
+            std::uint64_t const rate = sample_rate_;
+
+            std::vector<std::pair<site_key, site_stats> > sorted(
+                sites.begin(), sites.end());
+            std::stable_sort(sorted.begin(), sorted.end(),
+                [](std::pair<site_key, site_stats> const& lhs,
+                    std::pair<site_key, site_stats> const& rhs)
+                {
+                    return lhs.second.wait_time_ > rhs.second.wait_time_ ||
+                        (lhs.second.wait_time_ == rhs.second.wait_time_ &&
+                            lhs.second.hold_time_ > rhs.second.hold_time_);
+                });
+
+            site_stats total;
+            for (auto const& s : sorted)
+                total += s.second;
+
+            os << "lock contention profile (1 in " << rate
+               << " acquisitions sampled, totals are estimates)\n";
+            os << std::fixed << std::setprecision(3);
+            os << "  call sites:        " << sorted.size() << "\n";
+            os << "  acquisitions:      " << total.acquisitions_ * rate << "\n";
+            os << "  contentions:       " << total.contentions_ * rate << "\n";
+            os << "  wait time [ms]:    "
+               << double(total.wait_time_ * rate) / 1e6 << "\n";
+            os << "  hold time [ms]:    "
+               << double(total.hold_time_ * rate) / 1e6 << "\n";
+
+            std::size_t shown = (std::min)(top, sorted.size());
+            os << "\ntop " << shown << " call sites by wait time:\n";
+            os << "      wait [ms]      hold [ms]  acquisitions   contended [%]"
+                  "  avg contenders  max contenders  call site\n";
+            for (std::size_t i = 0; i != shown; ++i)
+            {
+                site_stats const& s = sorted[i].second;
+                os << std::setw(15) << double(s.wait_time_ * rate) / 1e6
+                   << std::setw(15) << double(s.hold_time_ * rate) / 1e6
+                   << std::setw(14) << s.acquisitions_ * rate
+                   << std::setw(16)
+                   << (s.acquisitions_ == 0 ? 0.0 :
+                        100.0 * double(s.contentions_) /
+                            double(s.acquisitions_))
+                   << std::setw(16)
+                   << (s.contentions_ == 0 ? 0.0 :
+                        double(s.contenders_) / double(s.contentions_))
+                   << std::setw(16) << s.max_contenders_
+                   << "  " << get_name(sorted[i].first) << "\n";
+            }
+            os.flush();
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void acquired(void const* lock, lock_kind kind, void const* site)
+    {
+        if (kind == kind_untracked)
+            return;
+
+        detail::thread_data& t = detail::get_thread_data();
+        if (!detail::sample(t))
+            return;
+
+        detail::site_key key = {
+            site != nullptr ? site : HPX_LOCK_PROFILING_CALLER(), int(kind)
+        };
+
+        {
+            std::lock_guard<compat::mutex> l(t.mtx_);
+            ++t.sites_[key].acquisitions_;
+        }
+
+        if (kind != kind_condition_variable)
+            detail::hold_begin(t, lock, key, detail::profiler::get().now());
+    }
+
+    std::uint64_t wait_begin(void const* lock)
+    {
+        std::int32_t contenders =
+            detail::waiters_of(lock).fetch_add(1, std::memory_order_relaxed) +
+            1;
+
+        detail::thread_data& t = detail::get_thread_data();
+        if (!detail::sample(t))
+            return 0;
+
+        return ((detail::profiler::get().now() & detail::time_mask) << 16) |
+            std::uint64_t((std::min)(contenders, std::int32_t(0xffff)));
+    }
+
+    void wait_end(void const* lock, lock_kind kind, std::uint64_t token,
+        void const* site)
+    {
+        detail::waiters_of(lock).fetch_sub(1, std::memory_order_relaxed);
+
+        if (token == 0 || kind == kind_untracked)
+            return;
+
+        std::uint64_t now = detail::profiler::get().now();
+        std::uint64_t wait_time = ((now & detail::time_mask) -
+            (token >> 16)) & detail::time_mask;
+        std::uint64_t contenders = token & 0xffff;
+
+        detail::site_key key = {
+            site != nullptr ? site : HPX_LOCK_PROFILING_CALLER(), int(kind)
+        };
+
+        // the HPX thread might have been resumed on another OS thread
+        detail::thread_data& t = detail::get_thread_data();
+        {
+            std::lock_guard<compat::mutex> l(t.mtx_);
+            detail::site_stats& s = t.sites_[key];
+            ++s.acquisitions_;
+            ++s.contentions_;
+            s.wait_time_ += wait_time;
+            s.contenders_ += contenders;
+            s.max_contenders_ = (std::max)(s.max_contenders_, contenders);
+        }
+
+        if (kind != kind_condition_variable)
+            detail::hold_begin(t, lock, key, now);
+    }
+
+    void released(void const* lock)
+    {
+        detail::thread_data& t = detail::get_thread_data();
+        for (std::size_t i = 0; i != t.num_held_; ++i)
+        {
+            if (t.held_[i].lock_ != lock)
+                continue;
+
+            std::uint64_t hold_time =
+                detail::profiler::get().now() - t.held_[i].start_;
+            {
+                std::lock_guard<compat::mutex> l(t.mtx_);
+                t.sites_[t.held_[i].key_].hold_time_ += hold_time;
+            }
+
+            t.held_[i] = t.held_[--t.num_held_];
+            return;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void start_lock_profiling(std::size_t sample_rate,
+        std::string const& report, std::size_t report_top)
+    {
+        detail::profiler::get().start(sample_rate, report, report_top);
+    }
+
+    void stop_lock_profiling()
+    {
+        detail::profiler::get().stop();
+    }
+
+    void write_report(std::ostream& os, std::size_t top)
+    {
+        detail::profiler::get().write_report(os, top);
+    }
+
+    std::vector<std::string> get_site_names()
+    {
+        detail::profiler& p = detail::profiler::get();
+
+        std::vector<std::string> names;
+        for (auto const& s : p.collect(false))
+            names.push_back(p.get_name(s.first));
+        return names;
+    }
+
+    std::int64_t get_statistic(statistic stat, std::string const& site,
+        bool reset)
+    {
+        detail::profiler& p = detail::profiler::get();
+
+        auto matches = [&](detail::site_key const& key) -> bool
+        {
+            return site.empty() || p.get_name(key) == site;
+        };
+
+        detail::site_stats total;
+        for (auto const& s : p.collect(false))
+        {
+            if (matches(s.first))
+                total += s.second;
+        }
+
+        if (reset)
+            p.reset(stat, matches);
+
+        std::uint64_t const rate = p.sample_rate();
+        switch (stat)
+        {
+        case stat_acquisitions:
+            return std::int64_t(total.acquisitions_ * rate);
+        case stat_contentions:
+            return std::int64_t(total.contentions_ * rate);
+        case stat_wait_time:
+            return std::int64_t(total.wait_time_ * rate);
+        case stat_hold_time:
+            return std::int64_t(total.hold_time_ * rate);
+        case stat_max_contenders:
+            return std::int64_t(total.max_contenders_);
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(bad_parameter,
+            "hpx::util::lock_profiling::get_statistic",
+            "unknown lock profiling statistic");
+        return 0;
+    }
+}}}
+
+#endif
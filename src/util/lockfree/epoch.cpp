@@ -0,0 +1,257 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/lockfree/epoch.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace util { namespace lockfree
+{
+    ///////////////////////////////////////////////////////////////////////////
+    struct epoch_domain::thread_record
+    {
+        struct retired_node
+        {
+            void* p_;
+            deleter_type deleter_;
+        };
+
+        // the nodes retired during one epoch
+        struct bag
+        {
+            bag() : epoch_(0) {}
+
+            std::size_t clear()
+            {
+                std::size_t const count = nodes_.size();
+                for (retired_node const& n : nodes_)
+                    n.deleter_(n.p_);
+                nodes_.clear();
+                return count;
+            }
+
+            std::uint64_t epoch_;
+            std::vector<retired_node> nodes_;
+        };
+
+        thread_record()
+          : state_(0), in_use_(true), next_(nullptr), nesting_(0),
+            retired_since_collect_(0)
+        {}
+
+        // the epoch observed by the thread shifted left by one, the lowest
+        // bit is set while the thread is inside of a guard
+        std::atomic<std::uint64_t> state_;
+        std::atomic<bool> in_use_;
+        thread_record* next_;           // immutable once published
+
+        // owned by the thread using this record
+        std::size_t nesting_;
+        std::size_t retired_since_collect_;
+        bag limbo_[3];
+    };
+
+    namespace
+    {
+        // the number of nodes a thread retires before it tries to collect
+        // them on its own
+        std::size_t const collect_interval = 128;
+
+        HPX_NATIVE_TLS epoch_domain::thread_record* this_thread_record =
+            nullptr;
+
+        // hands the record of a thread back to the domain once it exits,
+        // the nodes retired by it are collected by other threads
+        struct thread_record_releaser
+        {
+            ~thread_record_releaser()
+            {
+                if (record_ != nullptr)
+                {
+                    HPX_ASSERT(record_->nesting_ == 0);
+                    this_thread_record = nullptr;
+                    record_->in_use_.store(false, std::memory_order_release);
+                }
+            }
+
+            epoch_domain::thread_record* record_;
+        };
+
+        thread_local thread_record_releaser releaser = { nullptr };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    epoch_domain::epoch_domain()
+      : epoch_(0), records_(nullptr), retired_(0)
+    {}
+
+    // the domain outlives all lock-free data structures, the records are
+    // not deleted as threads which were not joined may still refer to them
+    epoch_domain::~epoch_domain()
+    {
+        for (thread_record* r = records_.load(); r != nullptr; r = r->next_)
+        {
+            for (thread_record::bag& b : r->limbo_)
+                b.clear();
+        }
+    }
+
+    epoch_domain& epoch_domain::get()
+    {
+        static epoch_domain domain;
+        return domain;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    epoch_domain::thread_record* epoch_domain::get_record()
+    {
+        thread_record* record = this_thread_record;
+        if (HPX_LIKELY(record != nullptr))
+            return record;
+
+        // reuse the record of a thread which has exited
+        for (record = records_.load(std::memory_order_acquire);
+             record != nullptr; record = record->next_)
+        {
+            bool expected = false;
+            if (!record->in_use_.load(std::memory_order_relaxed) &&
+                record->in_use_.compare_exchange_strong(expected, true,
+                    std::memory_order_acquire))
+            {
+                break;
+            }
+        }
+
+        if (record == nullptr)
+        {
+            record = new thread_record;
+
+            thread_record* head = records_.load(std::memory_order_relaxed);
+            do {
+                record->next_ = head;
+            } while (!records_.compare_exchange_weak(head, record,
+                std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        releaser.record_ = record;
+        this_thread_record = record;
+        return record;
+    }
+
+    epoch_domain::thread_record* epoch_domain::enter()
+    {
+        thread_record* record = get_record();
+        if (record->nesting_++ == 0)
+        {
+            // announce the epoch, make sure it did not change meanwhile
+            std::uint64_t epoch = epoch_.load(std::memory_order_relaxed);
+            while (true)
+            {
+                record->state_.store((epoch << 1) | 1);
+                std::uint64_t const current = epoch_.load();
+                if (current == epoch)
+                    break;
+                epoch = current;
+            }
+        }
+        return record;
+    }
+
+    void epoch_domain::leave(thread_record* record)
+    {
+        HPX_ASSERT(record->nesting_ != 0);
+        if (--record->nesting_ == 0)
+            record->state_.store(0, std::memory_order_release);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void epoch_domain::retire(void* p, deleter_type deleter)
+    {
+        thread_record* record = get_record();
+        std::uint64_t const epoch = epoch_.load();
+
+        // the bag used for this epoch still holds nodes retired three epochs
+        // ago (or earlier), those are unreachable by now
+        thread_record::bag& b = record->limbo_[epoch % 3];
+        if (b.epoch_ != epoch)
+        {
+            if (!b.nodes_.empty())
+                retired_.fetch_sub(b.clear(), std::memory_order_relaxed);
+            b.epoch_ = epoch;
+        }
+
+        b.nodes_.push_back(thread_record::retired_node{p, deleter});
+        retired_.fetch_add(1, std::memory_order_relaxed);
+
+        if (++record->retired_since_collect_ >= collect_interval)
+        {
+            record->retired_since_collect_ = 0;
+            try_advance(epoch);
+            collect(record, epoch_.load());
+        }
+    }
+
+    std::size_t epoch_domain::collect()
+    {
+        if (retired_.load(std::memory_order_relaxed) == 0)
+            return 0;
+
+        try_advance(epoch_.load());
+        std::uint64_t const epoch = epoch_.load();
+
+        std::size_t count = collect(get_record(), epoch);
+
+        // take care of the nodes retired by threads which have exited
+        for (thread_record* r = records_.load(std::memory_order_acquire);
+             r != nullptr; r = r->next_)
+        {
+            bool expected = false;
+            if (!r->in_use_.load(std::memory_order_relaxed) &&
+                r->in_use_.compare_exchange_strong(expected, true,
+                    std::memory_order_acquire))
+            {
+                count += collect(r, epoch);
+                r->in_use_.store(false, std::memory_order_release);
+            }
+        }
+        return count;
+    }
+
+    // advance the global epoch if all threads inside of a guard have
+    // observed the current one
+    bool epoch_domain::try_advance(std::uint64_t epoch)
+    {
+        for (thread_record* r = records_.load(std::memory_order_acquire);
+             r != nullptr; r = r->next_)
+        {
+            std::uint64_t const state = r->state_.load();
+            if ((state & 1) && (state >> 1) != epoch)
+                return false;
+        }
+        return epoch_.compare_exchange_strong(epoch, epoch + 1);
+    }
+
+    // delete the nodes which were retired at least two epochs ago
+    std::size_t epoch_domain::collect(thread_record* record,
+        std::uint64_t epoch)
+    {
+        std::size_t count = 0;
+        for (thread_record::bag& b : record->limbo_)
+        {
+            if (!b.nodes_.empty() && b.epoch_ + 2 <= epoch)
+                count += b.clear();
+        }
+
+        if (count != 0)
+            retired_.fetch_sub(count, std::memory_order_relaxed);
+        return count;
+    }
+}}}
@@ -12,11 +12,14 @@
 #include <hpx/exception.hpp>
 #include <hpx/runtime/naming_fwd.hpp>
 #include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
 #include <hpx/runtime/naming/resolver_client.hpp>
 #include <hpx/runtime/components/console_logging.hpp>
 #include <hpx/runtime/threads/threadmanager.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/util/runtime_configuration.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
 #include <hpx/util/static.hpp>
 #include <hpx/util/logging/format/named_write.hpp>
 #include <hpx/util/logging/format/destination/defaults.hpp>
@@ -26,12 +29,19 @@
 #include <boost/config.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/filesystem/operations.hpp>
+#include <boost/lockfree/queue.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #if defined(ANDROID) || defined(__ANDROID__)
@@ -139,6 +149,176 @@ namespace hpx { namespace util
             "<" + unknown + ">";
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // The context of a message whose writing has been deferred, captured
+        // in the thread that logged it. While the message is written, the
+        // custom formatters below use the values stored here instead of
+        // querying the thread which writes the message.
+        struct log_record
+        {
+            log_record(logger_type const& l, logging::msg_type&& msg)
+              : logger_(&l)
+              , msg_(std::move(msg))
+              , time_(std::chrono::system_clock::now())
+              , worker_thread_num_(std::size_t(-1))
+              , locality_id_(hpx::get_locality_id())
+              , thread_id_(nullptr)
+              , thread_phase_(0)
+              , parent_locality_id_(threads::get_parent_locality_id())
+              , parent_thread_id_(nullptr)
+              , parent_thread_phase_(threads::get_parent_phase())
+              , component_id_(threads::get_self_component_id())
+            {
+                error_code ec(lightweight);
+                worker_thread_num_ = hpx::get_worker_thread_num(ec);
+
+                threads::thread_self* self = threads::get_self_ptr();
+                if (nullptr != self)
+                {
+                    thread_id_ = threads::get_self_id().get();
+                    thread_phase_ = self->get_thread_phase();
+                }
+
+                threads::thread_id_type parent_id = threads::get_parent_id();
+                if (nullptr != parent_id)
+                    parent_thread_id_ = parent_id.get();
+            }
+
+            logger_type const* logger_;
+            logging::msg_type msg_;
+            std::chrono::system_clock::time_point time_;
+            std::size_t worker_thread_num_;
+            std::uint32_t locality_id_;
+            void const* thread_id_;
+            std::size_t thread_phase_;
+            std::uint32_t parent_locality_id_;
+            void const* parent_thread_id_;
+            std::size_t parent_thread_phase_;
+            std::uint64_t component_id_;
+        };
+
+        // the record of the deferred message currently being written
+        log_record const*& current_log_record()
+        {
+            static HPX_NATIVE_TLS log_record const* record = nullptr;
+            return record;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The deferred_log_writer moves writing the messages of the loggers
+        // enabled with hpx.logging.async out of the logging threads. Each
+        // worker thread appends the records of its messages to its own
+        // single-producer queue, other threads share a multi-producer queue.
+        // A dedicated OS thread drains the queues and formats and writes the
+        // messages. Messages are written synchronously if the queues are
+        // full.
+        class deferred_log_writer
+        {
+        public:
+            HPX_NON_COPYABLE(deferred_log_writer);
+
+        public:
+            deferred_log_writer(std::size_t num_queues, std::size_t queue_size)
+              : shared_queue_(queue_size)
+              , stopped_(false)
+            {
+                queues_.reserve(num_queues);
+                for (std::size_t i = 0; i != num_queues; ++i)
+                {
+                    queues_.emplace_back(new queue_type(queue_size));
+                }
+                thread_ = std::thread(&deferred_log_writer::run, this);
+            }
+
+            ~deferred_log_writer()
+            {
+                stopped_.store(true, std::memory_order_release);
+                thread_.join();
+
+                // write what has been logged in the meantime
+                drain();
+            }
+
+            // the deferred_write_type of the loggers
+            static void write(logger_type const& l, logging::msg_type&& msg)
+            {
+                deferred_log_writer* writer = instance().get();
+                if (writer == nullptr)
+                {
+                    l.writer()(msg);
+                    return;
+                }
+                writer->push(new log_record(l, std::move(msg)));
+            }
+
+            static std::unique_ptr<deferred_log_writer>& instance()
+            {
+                static std::unique_ptr<deferred_log_writer> writer;
+                return writer;
+            }
+
+        private:
+            typedef boost::lockfree::spsc_queue<log_record*> queue_type;
+
+            void push(log_record* record)
+            {
+                std::size_t num_thread = record->worker_thread_num_;
+                if (num_thread < queues_.size() &&
+                        queues_[num_thread]->push(record))
+                {
+                    return;
+                }
+                if (!shared_queue_.push(record))
+                    write_record(record);
+            }
+
+            static void write_record(log_record* record)
+            {
+                current_log_record() = record;
+                logging::detail::deferred_log_time() = &record->time_;
+
+                try {
+                    record->logger_->writer()(record->msg_);
+                }
+                catch (...) {
+                    ;   // there is nothing we can do here
+                }
+
+                logging::detail::deferred_log_time() = nullptr;
+                current_log_record() = nullptr;
+                delete record;
+            }
+
+            bool drain()
+            {
+                std::size_t count = 0;
+                for (std::unique_ptr<queue_type>& q : queues_)
+                {
+                    count += q->consume_all(&deferred_log_writer::write_record);
+                }
+                count += shared_queue_.consume_all(
+                    &deferred_log_writer::write_record);
+                return count != 0;
+            }
+
+            void run()
+            {
+                while (!stopped_.load(std::memory_order_acquire))
+                {
+                    if (!drain())
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+
+            std::vector<std::unique_ptr<queue_type> > queues_;
+            boost::lockfree::queue<log_record*> shared_queue_;
+            std::atomic<bool> stopped_;
+            std::thread thread_;
+        };
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // custom formatter: shepherd
     struct shepherd_thread_id
@@ -151,8 +331,18 @@ namespace hpx { namespace util
 
         void operator()(param str) const
         {
-            error_code ec(lightweight);
-            std::size_t thread_num = hpx::get_worker_thread_num(ec);
+            std::size_t thread_num = std::size_t(-1);
+
+            detail::log_record const* record = detail::current_log_record();
+            if (nullptr != record)
+            {
+                thread_num = record->worker_thread_num_;
+            }
+            else
+            {
+                error_code ec(lightweight);
+                thread_num = hpx::get_worker_thread_num(ec);
+            }
 
             if (std::size_t(-1) != thread_num)
             {
@@ -181,7 +371,9 @@ namespace hpx { namespace util
 
         void operator()(param str) const
         {
-            std::uint32_t locality_id = hpx::get_locality_id();
+            detail::log_record const* record = detail::current_log_record();
+            std::uint32_t locality_id = nullptr != record ?
+                record->locality_id_ : hpx::get_locality_id();
 
             if (naming::invalid_locality_id != locality_id) {
                 std::stringstream out;
@@ -205,18 +397,26 @@ namespace hpx { namespace util
     {
         void operator()(param str) const
         {
-            threads::thread_self* self = threads::get_self_ptr();
-            if (nullptr != self) {
+            void const* id = nullptr;
+
+            detail::log_record const* record = detail::current_log_record();
+            if (nullptr != record)
+            {
+                id = record->thread_id_;
+            }
+            else if (nullptr != threads::get_self_ptr())
+            {
                 // called from inside a HPX thread
-                threads::thread_id_type id = threads::get_self_id();
-                if (id != threads::invalid_thread_id) {
-                    std::stringstream out;
-                    out << std::hex << std::setw(sizeof(void*)*2)
-                        << std::setfill('0')
-                        << reinterpret_cast<std::ptrdiff_t>(id.get());
-                    str.prepend_string(out.str());
-                    return;
-                }
+                id = threads::get_self_id().get();
+            }
+
+            if (nullptr != id) {
+                std::stringstream out;
+                out << std::hex << std::setw(sizeof(void*)*2)
+                    << std::setfill('0')
+                    << reinterpret_cast<std::ptrdiff_t>(id);
+                str.prepend_string(out.str());
+                return;
             }
 
             // called from outside a HPX thread or invalid thread id
@@ -233,19 +433,31 @@ namespace hpx { namespace util
     {
         void operator()(param str) const
         {
-            threads::thread_self* self = threads::get_self_ptr();
-            if (nullptr != self) {
-                // called from inside a HPX thread
-                std::size_t phase = self->get_thread_phase();
-                if (0 != phase) {
-                    std::stringstream out;
-                    out << std::hex << std::setw(sizeof(std::uint32_t))
-                        << std::setfill('0') << self->get_thread_phase();
-                    str.prepend_string(out.str());
-                    return;
+            std::size_t phase = 0;
+
+            detail::log_record const* record = detail::current_log_record();
+            if (nullptr != record)
+            {
+                phase = record->thread_phase_;
+            }
+            else
+            {
+                threads::thread_self* self = threads::get_self_ptr();
+                if (nullptr != self)
+                {
+                    // called from inside a HPX thread
+                    phase = self->get_thread_phase();
                 }
             }
 
+            if (0 != phase) {
+                std::stringstream out;
+                out << std::hex << std::setw(sizeof(std::uint32_t))
+                    << std::setfill('0') << phase;
+                str.prepend_string(out.str());
+                return;
+            }
+
             // called from outside a HPX thread or no phase given
             str.prepend_string(std::string(sizeof(std::uint32_t), '-'));
         }
@@ -260,7 +472,11 @@ namespace hpx { namespace util
     {
         void operator()(param str) const
         {
-            std::uint32_t parent_locality_id = threads::get_parent_locality_id();
+            detail::log_record const* record = detail::current_log_record();
+            std::uint32_t parent_locality_id = nullptr != record ?
+                record->parent_locality_id_ :
+                threads::get_parent_locality_id();
+
             if (naming::invalid_locality_id != parent_locality_id) {
                 // called from inside a HPX thread
                 std::stringstream out;
@@ -284,13 +500,26 @@ namespace hpx { namespace util
     {
         void operator()(param str) const
         {
-            threads::thread_id_type parent_id = threads::get_parent_id();
-            if (nullptr != parent_id && threads::invalid_thread_id != parent_id) {
+            void const* parent_id = nullptr;
+
+            detail::log_record const* record = detail::current_log_record();
+            if (nullptr != record)
+            {
+                parent_id = record->parent_thread_id_;
+            }
+            else
+            {
+                threads::thread_id_type id = threads::get_parent_id();
+                if (nullptr != id)
+                    parent_id = id.get();
+            }
+
+            if (nullptr != parent_id) {
                 // called from inside a HPX thread
                 std::stringstream out;
                 out << std::hex << std::setw(sizeof(void*)*2)
                     << std::setfill('0')
-                    << reinterpret_cast<std::ptrdiff_t>(parent_id.get());
+                    << reinterpret_cast<std::ptrdiff_t>(parent_id);
                 str.prepend_string(out.str());
             }
             else {
@@ -309,7 +538,10 @@ namespace hpx { namespace util
     {
         void operator()(param str) const
         {
-            std::size_t parent_phase = threads::get_parent_phase();
+            detail::log_record const* record = detail::current_log_record();
+            std::size_t parent_phase = nullptr != record ?
+                record->parent_thread_phase_ : threads::get_parent_phase();
+
             if (0 != parent_phase) {
                 // called from inside a HPX thread
                 std::stringstream out;
@@ -333,7 +565,10 @@ namespace hpx { namespace util
     {
         void operator()(param str) const
         {
-            std::uint64_t component_id = threads::get_self_component_id();
+            detail::log_record const* record = detail::current_log_record();
+            std::uint64_t component_id = nullptr != record ?
+                record->component_id_ : threads::get_self_component_id();
+
             if (0 != component_id) {
                 // called from inside a HPX thread
                 std::stringstream out;
@@ -1080,6 +1315,8 @@ namespace hpx { namespace util { namespace detail
                 // general logging
                 "[hpx.logging]",
                 "level = ${HPX_LOGLEVEL:0}",
+                "async = ${HPX_LOGASYNC:0}",
+                "async_queue_size = ${HPX_LOGASYNC_QUEUE_SIZE:4096}",
                 "destination = ${HPX_LOGDESTINATION:console}",
                 "format = ${HPX_LOGFORMAT:"
                     "(T%locality%/%hpxthread%.%hpxphase%/%hpxcomponent%) "
@@ -1209,6 +1446,35 @@ namespace hpx { namespace util { namespace detail
 
 #undef HPX_TIMEFORMAT
 
+    ///////////////////////////////////////////////////////////////////////////
+    // the error loggers keep writing synchronously to not lose any messages
+    // logged right before a crash
+    void init_deferred_log_writer(runtime_configuration const& ini)
+    {
+        std::unique_ptr<deferred_log_writer>& writer =
+            deferred_log_writer::instance();
+        if (!writer)
+        {
+            writer.reset(new deferred_log_writer(ini.get_os_thread_count(),
+                get_entry_as<std::size_t>(
+                    ini, "hpx.logging.async_queue_size", 4096)));
+        }
+
+        logger_type* const loggers[] =
+        {
+            agas_logger(), parcel_logger(), timing_logger(), hpx_logger(),
+            app_logger(), debuglog_logger(), agas_console_logger(),
+            parcel_console_logger(), timing_console_logger(),
+            hpx_console_logger(), app_console_logger(),
+            debuglog_console_logger()
+        };
+
+        for (logger_type* l : loggers)
+        {
+            l->defer_writes(&deferred_log_writer::write);
+        }
+    }
+
     struct init_logging_tag {};
     std::vector<std::string> const& get_logging_data()
     {
@@ -1234,6 +1500,10 @@ namespace hpx { namespace util { namespace detail
         init_hpx_console_log(ini);
         init_app_console_log(ini);
         init_debuglog_console_log(ini);
+
+        // move writing the log messages out of the logging threads
+        if (get_entry_as<int>(ini, "hpx.logging.async", 0) != 0)
+            init_deferred_log_writer(ini);
     }
 }}}
 
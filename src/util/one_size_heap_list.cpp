@@ -5,6 +5,9 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <hpx/config.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/runtime/threads/topology.hpp>
 #include <hpx/state.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/assert.hpp>
@@ -14,9 +17,9 @@
 #if defined(HPX_DEBUG)
 #include <hpx/util/logging.hpp>
 #endif
-#include <hpx/util/unlock_guard.hpp>
 #include <hpx/util/wrapper_heap_base.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <list>
 #include <memory>
@@ -25,9 +28,25 @@
 
 namespace hpx { namespace util
 {
+    struct alignas(threads::get_cache_line_size()) one_size_heap_list::magazine
+    {
+        magazine()
+          : next_(nullptr), count_(0)
+        {}
+
+        mutex_type mtx_;
+        std::shared_ptr<util::wrapper_heap_base> heap_;
+        char* next_;
+        std::size_t count_;
+    };
+
     one_size_heap_list::~one_size_heap_list() noexcept
     {
 #if defined(HPX_DEBUG)
+        // the elements still reserved by the worker threads were never used
+        for (std::size_t i = 0; i != num_magazines_; ++i)
+            free_count_ += magazines_[i].count_;
+
         LOSH_(info) << hpx::util::format(
             "{1}::~{1}: size({2}), max_count({3}), alloc_count({4}), "
             "free_count({5})",
@@ -45,111 +64,177 @@ namespace hpx { namespace util
                 alloc_count_ - free_count_);
         }
 #endif
+        delete [] magazines_;
     }
 
-    void* one_size_heap_list::alloc(std::size_t count)
+    one_size_heap_list::magazine* one_size_heap_list::get_magazine()
     {
-        unique_lock_type guard(mtx_);
+        std::size_t num_thread = hpx::get_worker_thread_num();
+        if (num_thread == std::size_t(-1))
+            return nullptr;
 
-        if (HPX_UNLIKELY(0 == count))
+        std::size_t num_magazines =
+            num_magazines_.load(std::memory_order_acquire);
+        if (num_magazines == 0)
         {
-            guard.unlock();
-            HPX_THROW_EXCEPTION(bad_parameter,
-                name() + "::alloc",
-                "cannot allocate 0 objects");
+            std::lock_guard<mutex_type> l(mtx_);
+
+            num_magazines = num_magazines_.load(std::memory_order_relaxed);
+            if (num_magazines == 0)
+            {
+                num_magazines = hpx::get_os_thread_count();
+                if (num_magazines == 0)
+                    return nullptr;
+
+                magazines_ = new magazine[num_magazines];
+                num_magazines_.store(num_magazines, std::memory_order_release);
+            }
         }
 
-        //std::size_t size = 0;
-        void* p = nullptr;
+        return &magazines_[num_thread % num_magazines];
+    }
+
+    one_size_heap_list::magazine* one_size_heap_list::find_magazine() const
+    {
+        std::size_t num_thread = hpx::get_worker_thread_num();
+        if (num_thread == std::size_t(-1))
+            return nullptr;
+
+        std::size_t num_magazines =
+            num_magazines_.load(std::memory_order_acquire);
+        if (num_magazines == 0)
+            return nullptr;
+
+        return &magazines_[num_thread % num_magazines];
+    }
+
+    // Allocate count consecutive elements (or up to count elements if
+    // partial is true) from the first heap which has space left, create a
+    // new heap if necessary. Returns the heap the elements were allocated
+    // from and sets count to the number of allocated elements.
+    std::shared_ptr<util::wrapper_heap_base>
+    one_size_heap_list::alloc_from_heaps(
+        void** result, std::size_t& count, bool partial)
+    {
+        unique_lock_type guard(mtx_);
+
+        for (auto const& heap : heap_list_)
         {
-            if (!heap_list_.empty())
+            std::size_t allocated = 0;
+            if (partial)
+                allocated = heap->alloc_some(result, count);
+            else if (heap->alloc(result, count))
+                allocated = count;
+
+            if (allocated != 0)
             {
-                //size = heap_list_.size();
-                for (auto & heap : heap_list_)
-                {
-                    bool allocated = false;
-
-                    {
-                        util::unlock_guard<unique_lock_type> ul(guard);
-                        allocated = heap->alloc(&p, count);
-                    }
-
-                    if (allocated)
-                    {
 #if defined(HPX_DEBUG)
-                        // Allocation succeeded, update statistics.
-                        alloc_count_ += count;
-                        if (alloc_count_ - free_count_ > max_alloc_count_)
-                            max_alloc_count_ = alloc_count_- free_count_;
+                // Allocation succeeded, update statistics.
+                alloc_count_ += allocated;
+                if (alloc_count_ - free_count_ > max_alloc_count_)
+                    max_alloc_count_ = alloc_count_- free_count_;
 #endif
-                        return p;
-                    }
+                count = allocated;
+                return heap;
+            }
 
 #if defined(HPX_DEBUG)
-                    LOSH_(info) << hpx::util::format(
-                        "{1}::alloc: failed to allocate from heap[{2}] "
-                        "(heap[{2}] has allocated {3} objects and has "
-                        "space for {4} more objects)",
-                        name(),
-                        heap->heap_count(),
-                        heap->size(),
-                        heap->free_size());
+            LOSH_(info) << hpx::util::format(
+                "{1}::alloc: failed to allocate from heap[{2}] "
+                "(heap[{2}] has allocated {3} objects and has "
+                "space for {4} more objects)",
+                name(),
+                heap->heap_count(),
+                heap->size(),
+                heap->free_size());
 #endif
-                }
-            }
         }
 
-        // Create new heap.
-        bool did_create = false;
-        {
+        // Create new heap. Larger blocks of elements (as requested for bulk
+        // creation of components) get a heap of their own, this keeps all of
+        // their global ids in the same range.
+        heap_parameters parameters = parameters_;
+        if (!partial && count > parameters.capacity)
+            parameters.capacity = count;
+
 #if defined(HPX_DEBUG)
-            heap_list_.push_front(create_heap_(
-                class_name_.c_str(), heap_count_ + 1, parameters_));
+        heap_list_.push_front(create_heap_(
+            class_name_.c_str(), heap_count_ + 1, parameters));
 #else
-            heap_list_.push_front(create_heap_(
-                class_name_.c_str(), 0, parameters_));
+        heap_list_.push_front(create_heap_(
+            class_name_.c_str(), 0, parameters));
 #endif
 
-            iterator itnew = heap_list_.begin();
-            typename list_type::value_type heap = *itnew;
-            bool result = false;
+        std::shared_ptr<util::wrapper_heap_base> heap = heap_list_.front();
 
-            {
-                util::unlock_guard<unique_lock_type> ul(guard);
-                result = heap->alloc((void**)&p, count);
-            }
+        std::size_t allocated = 0;
+        if (partial)
+            allocated = heap->alloc_some(result, count);
+        else if (heap->alloc(result, count))
+            allocated = count;
 
-            if (HPX_UNLIKELY(!result || nullptr == p))
-            {
-                // out of memory
-                guard.unlock();
-                HPX_THROW_EXCEPTION(out_of_memory,
-                    name() + "::alloc",
-                    hpx::util::format(
-                        "new heap failed to allocate {1} objects",
-                        count));
-            }
+        if (HPX_UNLIKELY(allocated == 0 || nullptr == *result))
+        {
+            // out of memory
+            guard.unlock();
+            HPX_THROW_EXCEPTION(out_of_memory,
+                name() + "::alloc",
+                hpx::util::format(
+                    "new heap failed to allocate {1} objects",
+                    count));
+        }
 
 #if defined(HPX_DEBUG)
-            alloc_count_ += count;
-            ++heap_count_;
+        alloc_count_ += allocated;
+        ++heap_count_;
 
-            LOSH_(info) << hpx::util::format(
-                "{1}::alloc: creating new heap[{2}], size is now {3}",
-                name(),
-                heap_count_,
-                heap_list_.size());
+        LOSH_(info) << hpx::util::format(
+            "{1}::alloc: creating new heap[{2}], size is now {3}",
+            name(),
+            heap_count_,
+            heap_list_.size());
 #endif
-            did_create = true;
+
+        count = allocated;
+        return heap;
+    }
+
+    void* one_size_heap_list::alloc(std::size_t count)
+    {
+        if (HPX_UNLIKELY(0 == count))
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                name() + "::alloc",
+                "cannot allocate 0 objects");
         }
 
-        if (did_create)
-            return p;
+        void* p = nullptr;
 
-        guard.unlock();
+        // single elements are handed out from the range reserved by the
+        // current worker thread
+        magazine* m = (count == 1) ? get_magazine() : nullptr;
+        if (m != nullptr)
+        {
+            std::lock_guard<mutex_type> l(m->mtx_);
+
+            if (m->count_ == 0)
+            {
+                std::size_t reserved = magazine_size;
+                m->heap_ = alloc_from_heaps(&p, reserved, true);
+                m->next_ = static_cast<char*>(p);
+                m->count_ = reserved;
+            }
+
+            HPX_ASSERT(m->count_ != 0);
 
-        // Try again, we just got a new heap, so we should be good.
-        return alloc(count);
+            p = m->next_;
+            m->next_ += parameters_.element_size;
+            --m->count_;
+            return p;
+        }
+
+        alloc_from_heaps(&p, count, false);
+        return p;
     }
 
     bool one_size_heap_list::reschedule(void* p, std::size_t count)
@@ -166,8 +251,6 @@ namespace hpx { namespace util
 
     void one_size_heap_list::free(void* p, std::size_t count)
     {
-        unique_lock_type ul(mtx_);
-
         if (nullptr == p || !threads::threadmanager_is(state_running))
             return;
 
@@ -177,51 +260,62 @@ namespace hpx { namespace util
             return;
 
         // Find the heap which allocated this pointer.
-        for (auto & heap : heap_list_)
+        std::shared_ptr<util::wrapper_heap_base> heap = find_heap(p);
+        if (!heap)
         {
-            bool did_allocate = false;
+            HPX_THROW_EXCEPTION(bad_parameter,
+                name() + "::free",
+                hpx::util::format(
+                    "pointer {1} was not allocated by this {2}",
+                    p, name()));
+        }
 
-            {
-                util::unlock_guard<unique_lock_type> ull(ul);
-                did_allocate = heap->did_alloc(p);
-                if (did_allocate)
-                    heap->free(p, count);
-            }
+        heap->free(p, count);
 
-            if (did_allocate)
-            {
 #if defined(HPX_DEBUG)
-                free_count_ += count;
-#endif
-                return;
-            }
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            free_count_ += count;
         }
+#endif
 
-        ul.unlock();
-
-        HPX_THROW_EXCEPTION(bad_parameter,
-            name() + "::free",
-            hpx::util::format(
-                "pointer {1} was not allocated by this {2}",
-                p, name()));
+        // a heap which has released its memory will never be used again
+        if (heap->is_empty())
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            heap_list_.remove(heap);
+        }
     }
 
-    bool one_size_heap_list::did_alloc(void* p) const
+    std::shared_ptr<util::wrapper_heap_base>
+        one_size_heap_list::find_heap(void* p) const
     {
-        unique_lock_type ul(mtx_);
-        for (typename list_type::value_type const& heap : heap_list_)
+        // most likely the pointer was allocated from the heap the current
+        // worker thread is reserving elements from
+        if (magazine* m = find_magazine())
         {
-            bool did_allocate = false;
-
+            std::shared_ptr<util::wrapper_heap_base> heap;
             {
-                util::unlock_guard<unique_lock_type> ull(ul);
-                did_allocate = heap->did_alloc(p);
+                std::lock_guard<mutex_type> l(m->mtx_);
+                heap = m->heap_;
             }
 
-            if (did_allocate)
-                return true;
+            if (heap && heap->did_alloc(p))
+                return heap;
         }
-        return false;
+
+        std::lock_guard<mutex_type> l(mtx_);
+        for (typename list_type::value_type const& heap : heap_list_)
+        {
+            if (heap->did_alloc(p))
+                return heap;
+        }
+        return std::shared_ptr<util::wrapper_heap_base>();
+    }
+
+    bool one_size_heap_list::did_alloc(void* p) const
+    {
+        return !!find_heap(p);
     }
 
     std::string one_size_heap_list::name() const
@@ -435,6 +435,9 @@ namespace hpx { namespace util
                 ("hpx:print-bind",
                   "print to the console the bit masks calculated from the "
                   "arguments specified to all --hpx:bind options.")
+                ("hpx:print-startup-timings",
+                  "print to the console the time spent in the phases of the "
+                  "startup of the runtime system before hpx_main is invoked.")
                 ("hpx:threads", value<std::string>(),
                  "the number of operating system threads to spawn for this HPX "
                  "locality (default: 1, using 'all' will spawn one thread for "
@@ -446,8 +449,8 @@ namespace hpx { namespace util
                 ("hpx:queuing", value<std::string>(),
                   "the queue scheduling policy to use, options are "
                   "'local', 'local-priority-fifo','local-priority-lifo', "
-                  "'abp-priority-fifo', 'abp-priority-lifo', 'static', and "
-                  "'static-priority' (default: 'local-priority'; "
+                  "'abp-priority-fifo', 'abp-priority-lifo', 'static', "
+                  "'static-priority', and 'hierarchical-priority' (default: 'local-priority'; "
                   "all option values can be abbreviated)")
                 ("hpx:high-priority-threads", value<std::size_t>(),
                   "the number of operating system threads maintaining a high "
@@ -562,6 +565,21 @@ namespace hpx { namespace util
                   "after they have been evaluated")
                 ("hpx:print-counters-locally",
                   "each locality prints only its own local counters")
+                ("hpx:export-counter",
+                    value<std::vector<std::string> >()->composing(),
+                  "periodically publish the raw values of the specified local "
+                  "performance counter(s) in a shared memory segment (see "
+                  "also options --hpx:export-counter-segment and "
+                  "--hpx:export-counter-interval)")
+                ("hpx:export-counter-segment", value<std::string>(),
+                  "the name of the shared memory segment the performance "
+                  "counter(s) specified with --hpx:export-counter are "
+                  "published in, the locality id is appended to the name "
+                  "(default: /hpx-counters.<pid>)")
+                ("hpx:export-counter-interval", value<std::size_t>(),
+                  "publish the performance counter(s) specified with "
+                  "--hpx:export-counter in the given interval "
+                  "[microseconds] (default: 1000)")
             ;
 
             hidden_options.add_options()
@@ -0,0 +1,236 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/pmix_environment.hpp>
+#include <hpx/util/runtime_configuration.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+#include <hpx/util/unused.hpp>
+
+#if defined(HPX_HAVE_PMIX)
+#include <pmix.h>
+#endif
+
+#include <boost/tokenizer.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hpx { namespace util
+{
+#if defined(HPX_HAVE_PMIX)
+    namespace
+    {
+        std::mutex pmix_mtx;
+        bool pmix_enabled = false;
+        pmix_proc_t pmix_this_proc;
+        std::uint32_t pmix_size = 0;
+
+        std::string pmix_error(char const* what, pmix_status_t rc)
+        {
+            return std::string(what) + " failed: " + PMIx_Error_string(rc);
+        }
+
+        pmix_proc_t make_proc(pmix_rank_t rank)
+        {
+            pmix_proc_t proc;
+            PMIX_PROC_CONSTRUCT(&proc);
+            std::strncpy(proc.nspace, pmix_this_proc.nspace, PMIX_MAX_NSLEN);
+            proc.rank = rank;
+            return proc;
+        }
+    }
+#endif
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool pmix_environment::check_pmix_environment(
+        runtime_configuration const& cfg)
+    {
+#if defined(HPX_HAVE_PMIX)
+        if (safe_lexical_cast<int>(cfg.get_entry("hpx.pmix.enable", "1"), 1)
+                == 0)
+        {
+            return false;
+        }
+
+        // the launcher sets these environment variables for its clients
+        std::string const env = cfg.get_entry("hpx.pmix.env", "PMIX_RANK");
+
+        typedef boost::tokenizer<boost::char_separator<char> > tokenizer;
+        boost::char_separator<char> sep(";,: ");
+        tokenizer tokens(env, sep);
+        for (tokenizer::iterator it = tokens.begin(); it != tokens.end(); ++it)
+        {
+            if (std::getenv(it->c_str()) != nullptr)
+                return true;
+        }
+#endif
+        return false;
+    }
+
+    bool pmix_environment::init(runtime_configuration const& cfg)
+    {
+#if defined(HPX_HAVE_PMIX)
+        std::lock_guard<std::mutex> l(pmix_mtx);
+        if (pmix_enabled)
+            return true;
+
+        if (!check_pmix_environment(cfg))
+            return false;
+
+        if (PMIx_Init(&pmix_this_proc, nullptr, 0) != PMIX_SUCCESS)
+            return false;
+
+        pmix_proc_t job = make_proc(PMIX_RANK_WILDCARD);
+        pmix_value_t* value = nullptr;
+        if (PMIx_Get(&job, PMIX_JOB_SIZE, nullptr, 0, &value) !=
+            PMIX_SUCCESS)
+        {
+            PMIx_Finalize(nullptr, 0);
+            return false;
+        }
+
+        pmix_size = value->data.uint32;
+        PMIX_VALUE_RELEASE(value);
+
+        pmix_enabled = true;
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void pmix_environment::finalize()
+    {
+#if defined(HPX_HAVE_PMIX)
+        std::lock_guard<std::mutex> l(pmix_mtx);
+        if (pmix_enabled)
+        {
+            PMIx_Finalize(nullptr, 0);
+            pmix_enabled = false;
+        }
+#endif
+    }
+
+    bool pmix_environment::enabled()
+    {
+#if defined(HPX_HAVE_PMIX)
+        std::lock_guard<std::mutex> l(pmix_mtx);
+        return pmix_enabled;
+#else
+        return false;
+#endif
+    }
+
+    std::uint32_t pmix_environment::rank()
+    {
+#if defined(HPX_HAVE_PMIX)
+        return pmix_enabled ? std::uint32_t(pmix_this_proc.rank) : 0;
+#else
+        return 0;
+#endif
+    }
+
+    std::uint32_t pmix_environment::size()
+    {
+#if defined(HPX_HAVE_PMIX)
+        return pmix_enabled ? pmix_size : 1;
+#else
+        return 1;
+#endif
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void pmix_environment::put(std::string const& key,
+        std::vector<char> const& data)
+    {
+#if defined(HPX_HAVE_PMIX)
+        // PMIx copies the value, it does not take ownership of the data
+        pmix_value_t value;
+        PMIX_VALUE_CONSTRUCT(&value);
+        value.type = PMIX_BYTE_OBJECT;
+        value.data.bo.bytes = const_cast<char*>(data.data());
+        value.data.bo.size = data.size();
+
+        pmix_status_t rc = PMIx_Put(PMIX_GLOBAL, key.c_str(), &value);
+        if (rc != PMIX_SUCCESS)
+        {
+            HPX_THROW_EXCEPTION(network_error, "pmix_environment::put",
+                pmix_error("PMIx_Put", rc));
+        }
+#else
+        HPX_THROW_EXCEPTION(not_implemented, "pmix_environment::put",
+            "HPX was built without PMIx support (HPX_WITH_PMIX=OFF)");
+#endif
+    }
+
+    void pmix_environment::fence(bool collect_data)
+    {
+#if defined(HPX_HAVE_PMIX)
+        pmix_status_t rc = PMIx_Commit();
+        if (rc != PMIX_SUCCESS)
+        {
+            HPX_THROW_EXCEPTION(network_error, "pmix_environment::fence",
+                pmix_error("PMIx_Commit", rc));
+        }
+
+        pmix_info_t info;
+        PMIX_INFO_CONSTRUCT(&info);
+        PMIX_INFO_LOAD(&info, PMIX_COLLECT_DATA, &collect_data, PMIX_BOOL);
+
+        rc = PMIx_Fence(nullptr, 0, &info, 1);
+        PMIX_INFO_DESTRUCT(&info);
+
+        if (rc != PMIX_SUCCESS)
+        {
+            HPX_THROW_EXCEPTION(network_error, "pmix_environment::fence",
+                pmix_error("PMIx_Fence", rc));
+        }
+#else
+        HPX_UNUSED(collect_data);
+        HPX_THROW_EXCEPTION(not_implemented, "pmix_environment::fence",
+            "HPX was built without PMIx support (HPX_WITH_PMIX=OFF)");
+#endif
+    }
+
+    std::vector<char> pmix_environment::get(std::uint32_t rank,
+        std::string const& key)
+    {
+#if defined(HPX_HAVE_PMIX)
+        pmix_proc_t proc = make_proc(pmix_rank_t(rank));
+        pmix_value_t* value = nullptr;
+
+        pmix_status_t rc =
+            PMIx_Get(&proc, key.c_str(), nullptr, 0, &value);
+        if (rc == PMIX_ERR_NOT_FOUND)
+            return std::vector<char>();
+
+        if (rc != PMIX_SUCCESS)
+        {
+            HPX_THROW_EXCEPTION(network_error, "pmix_environment::get",
+                pmix_error("PMIx_Get", rc));
+        }
+
+        std::vector<char> data;
+        if (value->type == PMIX_BYTE_OBJECT)
+        {
+            data.assign(value->data.bo.bytes,
+                value->data.bo.bytes + value->data.bo.size);
+        }
+        PMIX_VALUE_RELEASE(value);
+
+        return data;
+#else
+        HPX_THROW_EXCEPTION(not_implemented, "pmix_environment::get",
+            "HPX was built without PMIx support (HPX_WITH_PMIX=OFF)");
+        return std::vector<char>();
+#endif
+    }
+}}
@@ -92,6 +92,13 @@ namespace hpx { namespace threads { namespace policies
     // startup code
     HPX_EXPORT bool minimal_deadlock_detection = true;
 #endif
+#if defined(__linux) || defined(linux) || defined(__linux__)
+    ///////////////////////////////////////////////////////////////////////////
+    // We globally control whether new thread objects are placed at the top of
+    // their own stack using this global bool variable. It will be set once by
+    // the runtime configuration startup code
+    HPX_EXPORT bool fused_thread_data = true;
+#endif
 }}}
 
 #ifdef HPX_HAVE_SPINLOCK_DEADLOCK_DETECTION
@@ -137,6 +144,7 @@ namespace hpx { namespace util
                 HPX_INI_PATH_DELIMITER "$[system.executable_prefix]",
             "component_path_suffixes = /lib/hpx" HPX_INI_PATH_DELIMITER
                                       "/bin/hpx",
+            "component_registry_cache = ${HPX_COMPONENT_REGISTRY_CACHE:}",
             "master_ini_path = $[hpx.location]" HPX_INI_PATH_DELIMITER
                               "$[system.executable_prefix]/",
             "master_ini_path_suffixes = /share/" HPX_BASE_DIR_NAME
@@ -201,6 +209,12 @@ namespace hpx { namespace util
             "max_idle_backoff_time = ${HPX_MAX_IDLE_BACKOFF_TIME:"
             HPX_PP_STRINGIZE(HPX_PP_EXPAND(HPX_IDLE_BACKOFF_TIME_MAX)) "}",
 #endif
+            "adaptive_idle_backoff = ${HPX_ADAPTIVE_IDLE_BACKOFF:0}",
+            "max_idle_spin_time = ${HPX_MAX_IDLE_SPIN_TIME:20}",
+            "max_idle_sleep_time = ${HPX_MAX_IDLE_SLEEP_TIME:1000}",
+            "borrow_idle_loop_count = ${HPX_BORROW_IDLE_LOOP_COUNT:100}",
+            "thread_time_slice = ${HPX_THREAD_TIME_SLICE:10000}",
+            "thread_instrumentation = ${HPX_THREAD_INSTRUMENTATION:0}",
 
             /// If HPX_HAVE_ATTACH_DEBUGGER_ON_TEST_FAILURE is set,
             /// then apply the test-failure value as default.
@@ -224,6 +238,12 @@ namespace hpx { namespace util
             "[hpx.parcel]",
             "enable = 1",
 #endif
+#if defined(HPX_HAVE_PMIX)
+            // use the PMIx server of the launcher if any
+            "[hpx.pmix]",
+            "enable = ${HPX_PMIX_ENABLE:1}",
+            "env = ${HPX_PMIX_ENV:PMIX_RANK}",
+#endif
 
             "[hpx.stacks]",
             "small_size = ${HPX_SMALL_STACK_SIZE:"
@@ -236,6 +256,11 @@ namespace hpx { namespace util
                 HPX_PP_STRINGIZE(HPX_PP_EXPAND(HPX_HUGE_STACK_SIZE)) "}",
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
             "use_guard_pages = ${HPX_USE_GUARD_PAGES:1}",
+            "use_stack_pool = ${HPX_USE_STACK_POOL:0}",
+            "stack_pool_idle_threshold = ${HPX_STACK_POOL_IDLE_THRESHOLD:1000}",
+#endif
+#if defined(__linux) || defined(linux) || defined(__linux__)
+            "fused_thread_data = ${HPX_FUSED_THREAD_DATA:1}",
 #endif
 
             "[hpx.threadpools]",
@@ -262,6 +287,78 @@ namespace hpx { namespace util
             "max_delete_count = ${HPX_THREAD_QUEUE_MAX_DELETE_COUNT:1000}",
             "max_terminated_threads = ${HPX_SCHEDULER_MAX_TERMINATED_THREADS:"
               HPX_PP_STRINGIZE(HPX_PP_EXPAND(HPX_SCHEDULER_MAX_TERMINATED_THREADS)) "}",
+            "thread_map_shards = ${HPX_THREAD_QUEUE_THREAD_MAP_SHARDS:8}",
+            "steal_level_backoff = ${HPX_THREAD_QUEUE_STEAL_LEVEL_BACKOFF:2}",
+            "steal_victim_selection = "
+                "${HPX_THREAD_QUEUE_STEAL_VICTIM_SELECTION:round-robin}",
+            "steal_half = ${HPX_THREAD_QUEUE_STEAL_HALF:0}",
+            "run_next_slot = ${HPX_THREAD_QUEUE_RUN_NEXT_SLOT:0}",
+            "run_next_steal_delay = "
+                "${HPX_THREAD_QUEUE_RUN_NEXT_STEAL_DELAY:50}",
+            "static_ring_size = ${HPX_THREAD_QUEUE_STATIC_RING_SIZE:256}",
+
+            "[hpx.elasticity]",
+            "pools = ${HPX_ELASTICITY_POOLS}",
+            "interval = ${HPX_ELASTICITY_INTERVAL:100}",
+            "hysteresis = ${HPX_ELASTICITY_HYSTERESIS:3}",
+            "min_threads = ${HPX_ELASTICITY_MIN_THREADS:1}",
+            "grow_queue_length = ${HPX_ELASTICITY_GROW_QUEUE_LENGTH:4}",
+            "grow_idle_rate = ${HPX_ELASTICITY_GROW_IDLE_RATE:500}",
+            "shrink_idle_rate = ${HPX_ELASTICITY_SHRINK_IDLE_RATE:5000}",
+
+            "[hpx.timer_wheel]",
+            "enabled = ${HPX_TIMER_WHEEL_ENABLED:0}",
+            "resolution = ${HPX_TIMER_WHEEL_RESOLUTION:100}",
+
+            "[hpx.async_file]",
+            "io_uring = ${HPX_ASYNC_FILE_IO_URING:1}",
+            "queue_size = ${HPX_ASYNC_FILE_QUEUE_SIZE:256}",
+
+            "[hpx.iostreams]",
+            "arity = ${HPX_IOSTREAMS_ARITY:0}",
+            "buffer_size = ${HPX_IOSTREAMS_BUFFER_SIZE:0}",
+            "flush_interval = ${HPX_IOSTREAMS_FLUSH_INTERVAL:10}",
+            "async = ${HPX_IOSTREAMS_ASYNC:0}",
+
+#if defined(HPX_HAVE_TASK_TRACER)
+            "[hpx.trace]",
+            "file = ${HPX_TRACE_FILE}",
+            "buffer_size = ${HPX_TRACE_BUFFER_SIZE:65536}",
+#endif
+
+#if defined(HPX_HAVE_TASK_HARDWARE_COUNTERS)
+            "[hpx.task_counters]",
+            "events = ${HPX_TASK_COUNTERS_EVENTS}",
+#endif
+
+#if defined(HPX_HAVE_TASK_GRAPH_PROFILER)
+            "[hpx.task_graph]",
+            "file = ${HPX_TASK_GRAPH_FILE}",
+            "max_nodes = ${HPX_TASK_GRAPH_MAX_NODES:1048576}",
+#endif
+
+#if defined(HPX_HAVE_SAMPLING_PROFILER)
+            "[hpx.sampling]",
+            "file = ${HPX_SAMPLING_FILE}",
+            "frequency = ${HPX_SAMPLING_FREQUENCY:99}",
+            "max_depth = ${HPX_SAMPLING_MAX_DEPTH:64}",
+            "buffer_size = ${HPX_SAMPLING_BUFFER_SIZE:1024}",
+#endif
+
+#if defined(HPX_HAVE_LOCK_PROFILING)
+            "[hpx.lock_profiling]",
+            "enabled = ${HPX_LOCK_PROFILING:0}",
+            "sample_rate = ${HPX_LOCK_PROFILING_SAMPLE_RATE:64}",
+            "report = ${HPX_LOCK_PROFILING_REPORT}",
+            "report_top = ${HPX_LOCK_PROFILING_REPORT_TOP:20}",
+#endif
+
+#if defined(HPX_HAVE_CUDA)
+            "[hpx.cuda]",
+            "event_polling = ${HPX_CUDA_EVENT_POLLING:0}",
+            "staging_threshold = ${HPX_CUDA_STAGING_THRESHOLD:65536}",
+            "staging_chunk_size = ${HPX_CUDA_STAGING_CHUNK_SIZE:1048576}",
+#endif
 
             "[hpx.commandline]",
             // enable aliasing
@@ -310,6 +407,11 @@ namespace hpx { namespace util
                 HPX_PP_STRINGIZE(HPX_PP_EXPAND(
                     HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS))
                 "}",
+            "refcnt_flush_interval = ${HPX_AGAS_REFCNT_FLUSH_INTERVAL:10000}",
+            "bootstrap_fanout = ${HPX_AGAS_BOOTSTRAP_FANOUT:16}",
+#if defined(HPX_HAVE_PMIX)
+            "bootstrap_pmix = ${HPX_AGAS_BOOTSTRAP_PMIX:1}",
+#endif
             "service_mode = hosted",
             "local_cache_size = ${HPX_AGAS_LOCAL_CACHE_SIZE:"
                 HPX_PP_STRINGIZE(HPX_PP_EXPAND(HPX_AGAS_LOCAL_CACHE_SIZE)) "}",
@@ -415,7 +517,8 @@ namespace hpx { namespace util
             plugin_registries,
         std::string const& path,
         std::set<std::string>& component_paths,
-        std::map<std::string, boost::filesystem::path>& basenames)
+        std::map<std::string, boost::filesystem::path>& basenames,
+        util::module_registry_cache* cache)
     {
         namespace fs = boost::filesystem;
 
@@ -442,7 +545,7 @@ namespace hpx { namespace util
                 {
                     plugin_list_type tmp_regs =
                         util::init_ini_data_default(this_path.string(),
-                            *this, basenames, modules_);
+                            *this, basenames, modules_, cache);
 
                     std::copy(tmp_regs.begin(), tmp_regs.end(),
                         std::back_inserter(plugin_registries));
@@ -457,7 +560,8 @@ namespace hpx { namespace util
         std::string const& component_base_paths,
         std::string const& component_path_suffixes,
         std::set<std::string>& component_paths,
-        std::map<std::string, boost::filesystem::path>& basenames)
+        std::map<std::string, boost::filesystem::path>& basenames,
+        util::module_registry_cache* cache)
     {
         namespace fs = boost::filesystem;
 
@@ -484,14 +588,14 @@ namespace hpx { namespace util
                 {
                     std::string p = path;
                     p += *jt;
-                    load_component_path(
-                        plugin_registries, p, component_paths, basenames);
+                    load_component_path(plugin_registries, p,
+                        component_paths, basenames, cache);
                 }
             }
             else
             {
-                load_component_path(
-                    plugin_registries, path, component_paths, basenames);
+                load_component_path(plugin_registries, path,
+                    component_paths, basenames, cache);
             }
         }
     }
@@ -518,13 +622,23 @@ namespace hpx { namespace util
         std::string component_path_suffixes(
             get_entry("hpx.component_path_suffixes", "/lib/hpx"));
 
+        // use the cached registry information of the found modules, if
+        // requested
+        std::unique_ptr<util::module_registry_cache> cache;
+        std::string cache_file(get_entry("hpx.component_registry_cache", ""));
+        if (!cache_file.empty())
+            cache.reset(new util::module_registry_cache(cache_file));
+
         load_component_paths(plugin_registries, component_base_paths,
-            component_path_suffixes, component_paths, basenames);
+            component_path_suffixes, component_paths, basenames, cache.get());
 
         // load additional explicit plugin paths from plugin_paths key
         std::string plugin_paths(get_entry("hpx.component_paths", ""));
-        load_component_paths(
-            plugin_registries, plugin_paths, "", component_paths, basenames);
+        load_component_paths(plugin_registries, plugin_paths, "",
+            component_paths, basenames, cache.get());
+
+        if (cache)
+            cache->save();
 
         // read system and user ini files _again_, to allow the user to
         // overwrite the settings from the default component ini's.
@@ -576,6 +690,15 @@ namespace hpx { namespace util
         threads::coroutines::detail::posix::use_guard_pages =
             init_use_stack_guard_pages();
 #endif
+#if defined(__linux) || defined(linux) || defined(__linux__)
+        threads::policies::fused_thread_data = init_fused_thread_data();
+#endif
+#if defined(HPX_COROUTINES_HAVE_STACK_POOL)
+        threads::coroutines::detail::posix::use_stack_pool =
+            init_use_stack_pool();
+        threads::coroutines::detail::posix::stack_pool_idle_threshold =
+            init_stack_pool_idle_threshold();
+#endif
 #ifdef HPX_HAVE_VERIFY_LOCKS
         if (enable_lock_detection())
             util::enable_lock_detection();
@@ -637,6 +760,15 @@ namespace hpx { namespace util
         threads::coroutines::detail::posix::use_guard_pages =
             init_use_stack_guard_pages();
 #endif
+#if defined(__linux) || defined(linux) || defined(__linux__)
+        threads::policies::fused_thread_data = init_fused_thread_data();
+#endif
+#if defined(HPX_COROUTINES_HAVE_STACK_POOL)
+        threads::coroutines::detail::posix::use_stack_pool =
+            init_use_stack_pool();
+        threads::coroutines::detail::posix::stack_pool_idle_threshold =
+            init_stack_pool_idle_threshold();
+#endif
 #ifdef HPX_HAVE_VERIFY_LOCKS
         if (enable_lock_detection())
             util::enable_lock_detection();
@@ -850,6 +982,19 @@ namespace hpx { namespace util
         return HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS;
     }
 
+    std::size_t
+    runtime_configuration::get_agas_refcnt_flush_interval() const
+    {
+        if (has_section("hpx.agas")) {
+            util::section const* sec = get_section("hpx.agas");
+            if (nullptr != sec) {
+                return hpx::util::get_entry_as<std::size_t>(
+                    *sec, "refcnt_flush_interval", 10000);
+            }
+        }
+        return 10000;
+    }
+
     bool runtime_configuration::get_itt_notify_mode() const
     {
 #if HPX_HAVE_ITTNOTIFY != 0
@@ -1057,6 +1202,46 @@ namespace hpx { namespace util
     }
 #endif
 
+#if defined(__linux) || defined(linux) || defined(__linux__)
+    bool runtime_configuration::init_fused_thread_data() const
+    {
+        if (has_section("hpx")) {
+            util::section const* sec = get_section("hpx.stacks");
+            if (nullptr != sec) {
+                return hpx::util::get_entry_as<int>(
+                    *sec, "fused_thread_data", "1") != 0;
+            }
+        }
+        return true;    // default is true
+    }
+#endif
+
+#if defined(HPX_COROUTINES_HAVE_STACK_POOL)
+    bool runtime_configuration::init_use_stack_pool() const
+    {
+        if (has_section("hpx")) {
+            util::section const* sec = get_section("hpx.stacks");
+            if (nullptr != sec) {
+                return hpx::util::get_entry_as<int>(
+                    *sec, "use_stack_pool", "0") != 0;
+            }
+        }
+        return false;    // default is false
+    }
+
+    std::uint64_t runtime_configuration::init_stack_pool_idle_threshold() const
+    {
+        if (has_section("hpx")) {
+            util::section const* sec = get_section("hpx.stacks");
+            if (nullptr != sec) {
+                return hpx::util::get_entry_as<std::uint64_t>(
+                    *sec, "stack_pool_idle_threshold", "1000");
+            }
+        }
+        return 1000;    // default is one second
+    }
+#endif
+
     std::ptrdiff_t runtime_configuration::init_small_stack_size() const
     {
         return init_stack_size("small_size",
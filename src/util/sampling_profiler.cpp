@@ -0,0 +1,604 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_SAMPLING_PROFILER)
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/annotation.hpp>
+#include <hpx/util/logging.hpp>
+#include <hpx/util/sampling_profiler.hpp>
+#include <hpx/util/thread_description.hpp>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// older versions of glibc do not name the target thread of SIGEV_THREAD_ID
+#if !defined(sigev_notify_thread_id)
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace hpx { namespace util { namespace sampling
+{
+    bool sampling_enabled = false;
+
+    namespace
+    {
+        // the maximum number of frames recorded for a sample
+        HPX_STATIC_CONSTEXPR std::size_t max_frames = 64;
+
+        enum task_kind
+        {
+            kind_scheduler = 0,     // no HPX thread is running
+            kind_description = 1,   // task: id of the interned description
+            kind_address = 2        // task: address of the thread function
+        };
+
+        struct sample
+        {
+            std::uintptr_t kind_;
+            std::uintptr_t task_;
+            std::size_t depth_;
+            std::uintptr_t frames_[max_frames];     // innermost frame first
+        };
+
+        // kind, task, frames
+        typedef std::vector<std::uintptr_t> stack_key;
+
+        struct stack_key_hash
+        {
+            std::size_t operator()(stack_key const& key) const
+            {
+                std::size_t seed = key.size();
+                for (std::uintptr_t v : key)
+                {
+                    seed ^= std::size_t(v) + 0x9e3779b97f4a7c15ull +
+                        (seed << 6) + (seed >> 2);
+                }
+                return seed;
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The state of one worker OS thread. The running task and the ring
+        // buffer are shared between the OS thread and its SIGPROF handler,
+        // which runs on the same OS thread and never locks. The lock protects
+        // the table of stacks and the timer, which are also accessed when
+        // sampling is stopped.
+        struct thread_state
+        {
+            typedef lcos::local::spinlock mutex_type;
+
+            explicit thread_state(std::size_t buffer_size)
+              : samples_(buffer_size)
+              , head_(0)
+              , tail_(0)
+              , dropped_(0)
+              , updating_(0)
+              , kind_(kind_scheduler)
+              , task_(0)
+              , stack_low_(0)
+              , stack_high_(0)
+              , has_timer_(false)
+              , failed_(false)
+            {}
+
+            // The handler drops the samples taken while the task is being
+            // changed.
+            void set_task(std::uintptr_t kind, std::uintptr_t task,
+                std::uintptr_t stack_low, std::uintptr_t stack_high)
+            {
+                updating_ = 1;
+                std::atomic_signal_fence(std::memory_order_seq_cst);
+                kind_ = kind;
+                task_ = task;
+                stack_low_ = stack_low;
+                stack_high_ = stack_high;
+                std::atomic_signal_fence(std::memory_order_seq_cst);
+                updating_ = 0;
+            }
+
+            void record(ucontext_t const* context);
+            void drain();
+
+            mutex_type mtx_;
+            std::vector<sample> samples_;
+            std::atomic<std::size_t> head_;     // written by the handler
+            std::atomic<std::size_t> tail_;     // written by drain
+            std::atomic<std::uint64_t> dropped_;
+
+            volatile sig_atomic_t updating_;
+            volatile std::uintptr_t kind_;
+            volatile std::uintptr_t task_;
+            volatile std::uintptr_t stack_low_;
+            volatile std::uintptr_t stack_high_;
+
+            timer_t timer_;
+            bool has_timer_;
+            bool failed_;
+
+            std::unordered_map<stack_key, std::uint64_t, stack_key_hash>
+                stacks_;
+        };
+
+        std::size_t max_depth = max_frames;
+
+        // Called from the signal handler, this must not allocate or lock.
+        void thread_state::record(ucontext_t const* context)
+        {
+            std::size_t head = head_.load(std::memory_order_relaxed);
+            if (updating_ != 0 ||
+                head - tail_.load(std::memory_order_acquire) >=
+                    samples_.size())
+            {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            std::uintptr_t pc = 0, fp = 0, sp = 0;
+#if defined(__x86_64__)
+            pc = std::uintptr_t(context->uc_mcontext.gregs[REG_RIP]);
+            fp = std::uintptr_t(context->uc_mcontext.gregs[REG_RBP]);
+            sp = std::uintptr_t(context->uc_mcontext.gregs[REG_RSP]);
+#elif defined(__i386__)
+            pc = std::uintptr_t(context->uc_mcontext.gregs[REG_EIP]);
+            fp = std::uintptr_t(context->uc_mcontext.gregs[REG_EBP]);
+            sp = std::uintptr_t(context->uc_mcontext.gregs[REG_ESP]);
+#elif defined(__aarch64__)
+            pc = std::uintptr_t(context->uc_mcontext.pc);
+            fp = std::uintptr_t(context->uc_mcontext.regs[29]);
+            sp = std::uintptr_t(context->uc_mcontext.sp);
+#endif
+
+            sample& s = samples_[head % samples_.size()];
+            s.kind_ = kind_;
+            s.task_ = task_;
+            s.frames_[0] = pc;
+            s.depth_ = 1;
+
+            std::uintptr_t const low = stack_low_;
+            std::uintptr_t const high = stack_high_;
+            if (sp < low || sp >= high)
+            {
+                // the worker is running the scheduler, not the HPX thread
+                if (high != 0)
+                {
+                    s.kind_ = kind_scheduler;
+                    s.task_ = 0;
+                }
+            }
+            else
+            {
+                // Each frame holds the frame pointer of its caller followed
+                // by the return address. The outermost frame of the coroutine
+                // has a null return address. Stop at anything not pointing
+                // further up into the stack of the HPX thread.
+                while (s.depth_ < max_depth && fp >= sp &&
+                    fp <= high - 2 * sizeof(std::uintptr_t) &&
+                    fp % sizeof(std::uintptr_t) == 0)
+                {
+                    std::uintptr_t const* frame =
+                        reinterpret_cast<std::uintptr_t const*>(fp);
+                    if (frame[1] == 0)
+                        break;
+
+                    s.frames_[s.depth_++] = frame[1];
+                    if (frame[0] <= fp)
+                        break;
+                    fp = frame[0];
+                }
+            }
+
+            head_.store(head + 1, std::memory_order_release);
+        }
+
+        // Move the buffered samples into the table of stacks. The handler
+        // may interrupt this, it does not touch the samples not yet drained.
+        void thread_state::drain()
+        {
+            std::size_t const head = head_.load(std::memory_order_acquire);
+            std::size_t tail = tail_.load(std::memory_order_relaxed);
+            for (/**/; tail != head; ++tail)
+            {
+                sample const& s = samples_[tail % samples_.size()];
+
+                stack_key key;
+                key.reserve(s.depth_ + 2);
+                key.push_back(s.kind_);
+                key.push_back(s.task_);
+                key.insert(key.end(), s.frames_, s.frames_ + s.depth_);
+                ++stacks_[std::move(key)];
+            }
+            tail_.store(tail, std::memory_order_release);
+        }
+
+        // The handler finds the state of the OS thread it interrupts. The
+        // variable is accessed before the timer of the OS thread is created,
+        // so that the handler does not trigger the allocation of the TLS
+        // block.
+        HPX_NATIVE_TLS thread_state* current_state = nullptr;
+
+        void on_sigprof(int, siginfo_t*, void* context)
+        {
+            thread_state* state = current_state;
+            if (state == nullptr || !sampling_enabled)
+                return;
+
+            int const saved_errno = errno;
+            state->record(static_cast<ucontext_t const*>(context));
+            errno = saved_errno;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        class registry
+        {
+        public:
+            typedef lcos::local::spinlock mutex_type;
+
+            static registry& get()
+            {
+                static registry r;
+                return r;
+            }
+
+            registry()
+              : frequency_(0)
+              , buffer_size_(0)
+            {}
+
+            thread_state* register_thread()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                threads_.emplace_back(new thread_state(buffer_size_));
+                return threads_.back().get();
+            }
+
+            void start(std::string const& filename, std::size_t frequency,
+                std::size_t buffer_size);
+
+            bool create_timer(thread_state& t);
+
+            // The timers are deleted only after the scheduling loops have
+            // exited, the thread states are kept as they are still
+            // referenced by the OS threads.
+            void stop();
+
+        private:
+            void write_report(std::unordered_map<stack_key, std::uint64_t,
+                stack_key_hash> const& stacks, std::uint64_t dropped);
+
+            mutex_type mtx_;
+            std::string filename_;
+            std::size_t frequency_;
+            std::size_t buffer_size_;
+            struct sigaction previous_action_;
+            std::vector<std::unique_ptr<thread_state> > threads_;
+        };
+
+        void registry::start(std::string const& filename,
+            std::size_t frequency, std::size_t buffer_size)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+
+            filename_ = filename;
+            frequency_ = frequency;
+
+            // the buffers of the OS threads created by an earlier run are
+            // reused
+            if (buffer_size_ == 0)
+                buffer_size_ = buffer_size;
+
+            struct sigaction action;
+            std::memset(&action, 0, sizeof(action));
+            action.sa_sigaction = &on_sigprof;
+            action.sa_flags = SA_SIGINFO | SA_RESTART;
+            sigemptyset(&action.sa_mask);
+
+            if (sigaction(SIGPROF, &action, &previous_action_) != 0)
+            {
+                HPX_THROW_EXCEPTION(kernel_error,
+                    "sampling::start_sampling",
+                    std::string("could not install the SIGPROF handler: ") +
+                        std::strerror(errno));
+            }
+        }
+
+        bool registry::create_timer(thread_state& t)
+        {
+            // no timer may be left behind once sampling has been stopped
+            std::lock_guard<mutex_type> l(mtx_);
+            if (!sampling_enabled)
+                return true;
+
+            sigevent event;
+            std::memset(&event, 0, sizeof(event));
+            event.sigev_notify = SIGEV_THREAD_ID;
+            event.sigev_signo = SIGPROF;
+            event.sigev_notify_thread_id = pid_t(::syscall(SYS_gettid));
+
+            if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &t.timer_) != 0)
+            {
+                LRT_(warning) << "sampling: timer_create failed: "
+                    << std::strerror(errno);
+                return false;
+            }
+
+            std::uint64_t const interval = 1000000000ull / frequency_;
+
+            itimerspec spec;
+            spec.it_interval.tv_sec = time_t(interval / 1000000000ull);
+            spec.it_interval.tv_nsec = long(interval % 1000000000ull);
+            spec.it_value = spec.it_interval;
+
+            if (timer_settime(t.timer_, 0, &spec, nullptr) != 0)
+            {
+                LRT_(warning) << "sampling: timer_settime failed: "
+                    << std::strerror(errno);
+                timer_delete(t.timer_);
+                return false;
+            }
+
+            t.has_timer_ = true;
+            return true;
+        }
+
+        void registry::stop()
+        {
+            std::unordered_map<stack_key, std::uint64_t, stack_key_hash>
+                stacks;
+            std::uint64_t dropped = 0;
+
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                for (auto const& t : threads_)
+                {
+                    std::lock_guard<thread_state::mutex_type> ll(t->mtx_);
+                    if (t->has_timer_)
+                    {
+                        timer_delete(t->timer_);
+                        t->has_timer_ = false;
+                    }
+                    t->failed_ = false;
+
+                    t->drain();
+                    for (auto const& stack : t->stacks_)
+                        stacks[stack.first] += stack.second;
+                    t->stacks_.clear();
+
+                    dropped += t->dropped_.exchange(0);
+                }
+
+                sigaction(SIGPROF, &previous_action_, nullptr);
+            }
+
+            write_report(stacks, dropped);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        std::string symbol_name(std::uintptr_t address)
+        {
+            Dl_info info;
+            if (dladdr(reinterpret_cast<void*>(address), &info) != 0)
+            {
+                if (info.dli_sname != nullptr)
+                {
+                    int status = 0;
+                    char* demangled = abi::__cxa_demangle(
+                        info.dli_sname, nullptr, nullptr, &status);
+                    std::string name(status == 0 && demangled != nullptr ?
+                        demangled : info.dli_sname);
+                    std::free(demangled);
+                    return name;
+                }
+
+                if (info.dli_fname != nullptr)
+                {
+                    char const* module = std::strrchr(info.dli_fname, '/');
+                    std::ostringstream strm;
+                    strm << (module != nullptr ? module + 1 : info.dli_fname)
+                         << "+0x" << std::hex
+                         << (address -
+                                reinterpret_cast<std::uintptr_t>(
+                                    info.dli_fbase));
+                    return strm.str();
+                }
+            }
+
+            std::ostringstream strm;
+            strm << "0x" << std::hex << address;
+            return strm.str();
+        }
+
+        void registry::write_report(std::unordered_map<stack_key,
+            std::uint64_t, stack_key_hash> const& stacks,
+            std::uint64_t dropped)
+        {
+            std::unordered_map<std::uintptr_t, std::string> symbols;
+            auto symbol = [&symbols](std::uintptr_t address)
+                -> std::string const&
+            {
+                auto it = symbols.find(address);
+                if (it == symbols.end())
+                {
+                    std::string name = symbol_name(address);
+
+                    // ';' separates the frames of a folded stack
+                    std::replace(name.begin(), name.end(), ';', ':');
+                    it = symbols.emplace(address, std::move(name)).first;
+                }
+                return it->second;
+            };
+
+            // identical lines result from different return addresses within
+            // the same functions
+            std::map<std::string, std::uint64_t> lines;
+            for (auto const& stack : stacks)
+            {
+                stack_key const& key = stack.first;
+
+                std::string line;
+                switch (key[0])
+                {
+                case kind_description:
+                    line = get_annotation_name(
+                        static_cast<std::uint32_t>(key[1]));
+                    std::replace(line.begin(), line.end(), ';', ':');
+                    break;
+
+                case kind_address:
+                    line = symbol(key[1]);
+                    break;
+
+                default:
+                    line = "<scheduler>";
+                    break;
+                }
+
+                // the return addresses point behind the calls
+                for (std::size_t i = key.size() - 1; i >= 2; --i)
+                {
+                    line += ';';
+                    line += symbol(i == 2 ? key[i] : key[i] - 1);
+                }
+
+                lines[line] += stack.second;
+            }
+
+            std::ofstream out(filename_);
+            if (!out)
+            {
+                HPX_THROW_EXCEPTION(filesystem_error,
+                    "sampling::stop_sampling",
+                    "could not open '" + filename_ + "' for writing");
+            }
+
+            for (auto const& line : lines)
+                out << line.first << ' ' << line.second << '\n';
+
+            if (dropped != 0)
+            {
+                out << "<dropped samples> " << dropped << '\n';
+                LRT_(warning) << "sampling: dropped " << dropped
+                    << " samples, consider increasing "
+                       "hpx.sampling.buffer_size";
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        thread_state* get_thread_state()
+        {
+            if (HPX_UNLIKELY(current_state == nullptr))
+                current_state = registry::get().register_thread();
+            return current_state;
+        }
+
+        void describe(util::thread_description const& desc,
+            std::uintptr_t& kind, std::uintptr_t& task)
+        {
+            if (desc.kind() == util::thread_description::data_type_description)
+            {
+                kind = kind_description;
+                task = desc.get_annotation_id();
+            }
+            else
+            {
+                kind = kind_address;
+                task = std::uintptr_t(desc.get_address());
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void task_started(util::thread_description const& desc,
+        std::pair<void*, void*> const& stack_bounds)
+    {
+        thread_state* t = get_thread_state();
+        if (HPX_UNLIKELY(!t->has_timer_ && !t->failed_))
+        {
+            std::lock_guard<thread_state::mutex_type> l(t->mtx_);
+            t->failed_ = !registry::get().create_timer(*t);
+        }
+
+        std::uintptr_t kind = kind_scheduler, task = 0;
+        describe(desc, kind, task);
+
+        t->set_task(kind, task,
+            reinterpret_cast<std::uintptr_t>(stack_bounds.first),
+            reinterpret_cast<std::uintptr_t>(stack_bounds.second));
+    }
+
+    void task_stopped()
+    {
+        thread_state* t = get_thread_state();
+        t->set_task(kind_scheduler, 0, 0, 0);
+
+        std::lock_guard<thread_state::mutex_type> l(t->mtx_);
+        t->drain();
+    }
+
+    void set_annotation(util::thread_description const& desc)
+    {
+        thread_state* t = current_state;
+        if (t == nullptr)
+            return;
+
+        std::uintptr_t kind = kind_scheduler, task = 0;
+        describe(desc, kind, task);
+
+        t->set_task(kind, task, t->stack_low_, t->stack_high_);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void start_sampling(std::string const& filename, std::size_t frequency,
+        std::size_t depth, std::size_t buffer_size)
+    {
+        if (frequency == 0 || frequency > 1000000)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter, "sampling::start_sampling",
+                "the sampling frequency has to be between 1 and 1000000 "
+                "samples per second");
+        }
+
+        max_depth = (std::max)(std::size_t(1), (std::min)(depth, max_frames));
+
+        registry::get().start(filename, frequency,
+            (std::max)(buffer_size, std::size_t(1)));
+        sampling_enabled = true;
+    }
+
+    void stop_sampling()
+    {
+        if (!sampling_enabled)
+            return;
+
+        sampling_enabled = false;
+        registry::get().stop();
+    }
+}}}
+
+#endif
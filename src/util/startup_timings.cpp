@@ -0,0 +1,80 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/util/format.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/startup_timings.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace util { namespace startup_timings
+{
+    namespace
+    {
+        struct timings
+        {
+            timings()
+              : start_(high_resolution_clock::now())
+              , last_(start_)
+            {}
+
+            std::mutex mtx_;
+            std::uint64_t start_;
+            std::uint64_t last_;
+            std::vector<std::pair<std::string, std::uint64_t>> phases_;
+        };
+
+        timings& get_timings()
+        {
+            static timings t;
+            return t;
+        }
+    }
+
+    void start()
+    {
+        timings& t = get_timings();
+        std::lock_guard<std::mutex> l(t.mtx_);
+        t.start_ = t.last_ = high_resolution_clock::now();
+        t.phases_.clear();
+    }
+
+    void record(char const* phase)
+    {
+        timings& t = get_timings();
+        std::lock_guard<std::mutex> l(t.mtx_);
+        std::uint64_t now = high_resolution_clock::now();
+        t.phases_.emplace_back(phase, now - t.last_);
+        t.last_ = now;
+    }
+
+    void print(std::ostream& os, std::uint32_t locality_id)
+    {
+        timings& t = get_timings();
+        std::lock_guard<std::mutex> l(t.mtx_);
+
+        // print everything at once, several localities may share the console
+        std::ostringstream strm;
+        hpx::util::format_to(strm, "startup timings (locality#{1}):\n",
+            locality_id);
+        for (auto const& p : t.phases_)
+        {
+            std::string name = p.first + ":";
+            hpx::util::format_to(strm, "  {1:-32} {2:.6} [s]\n",
+                name.c_str(), double(p.second) * 1e-9);
+        }
+        hpx::util::format_to(strm, "  {1:-32} {2:.6} [s]\n", "total:",
+            double(t.last_ - t.start_) * 1e-9);
+
+        os << strm.str() << std::flush;
+    }
+}}}
@@ -0,0 +1,557 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_TASK_GRAPH_PROFILER)
+#include <hpx/compat/mutex.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/task_graph_profiler.hpp>
+#include <hpx/util/thread_description.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace util { namespace task_graph
+{
+    bool profiling_enabled = false;
+
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // A node id holds the generation of the recording (8 bits), the index
+        // of the buffer of the OS thread (24 bits) and the position of the
+        // node in that buffer plus one (32 bits). Ids of earlier recordings
+        // which are still stored in HPX threads are ignored this way.
+        inline std::uint64_t make_node_id(std::uint32_t generation,
+            std::uint32_t buffer, std::size_t pos)
+        {
+            return (std::uint64_t(generation & 0xff) << 56) |
+                (std::uint64_t(buffer & 0xffffff) << 32) |
+                std::uint64_t(pos + 1);
+        }
+
+        struct node
+        {
+            util::thread_description desc_;
+            std::uint64_t start_;
+            std::uint64_t end_;
+            std::uint64_t enabled_by_;
+            std::uint64_t enabled_at_;
+            std::uint64_t prev_;
+        };
+
+        // The nodes recorded by one OS thread, only this OS thread touches
+        // the buffer while the task graph is being recorded.
+        struct node_buffer
+        {
+            explicit node_buffer(std::uint32_t index)
+              : index_(index), current_(0), dropped_(0)
+            {}
+
+            std::vector<node> nodes_;
+            std::uint32_t index_;
+            std::uint64_t current_;     // the node running right now
+            std::uint64_t dropped_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        class profiler
+        {
+            typedef compat::mutex mutex_type;
+
+        public:
+            profiler()
+              : max_nodes_(0), generation_(0)
+            {}
+
+            static profiler& get()
+            {
+                static profiler p;
+                return p;
+            }
+
+            // The buffers are never deleted as the OS threads keep referring
+            // to them.
+            node_buffer* register_thread()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (max_nodes_ == 0)
+                    return nullptr;
+
+                buffers_.emplace_back(new node_buffer(
+                    static_cast<std::uint32_t>(buffers_.size())));
+                return buffers_.back().get();
+            }
+
+            void start(std::string const& filename, std::size_t max_nodes)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+
+                if (profiling_enabled)
+                {
+                    HPX_THROW_EXCEPTION(invalid_status,
+                        "hpx::util::task_graph::start_profiling",
+                        "the task graph profiler has already been started");
+                }
+
+                // discard the nodes left over from a previous recording
+                for (auto& buffer : buffers_)
+                {
+                    buffer->nodes_.clear();
+                    buffer->current_ = 0;
+                    buffer->dropped_ = 0;
+                }
+
+                // open the report file right away to fail early
+                if (filename != "cout" && filename != "cerr")
+                {
+                    file_.reset(new std::ofstream(filename.c_str()));
+                    if (!*file_)
+                    {
+                        file_.reset();
+                        HPX_THROW_EXCEPTION(filesystem_error,
+                            "hpx::util::task_graph::start_profiling",
+                            "could not open the task graph report file: " +
+                                filename);
+                    }
+                }
+
+                filename_ = filename;
+                max_nodes_ = max_nodes == 0 ? 1 : max_nodes;
+                ++generation_;
+
+                profiling_enabled = true;
+            }
+
+            void stop()
+            {
+                std::string filename;
+                std::unique_ptr<std::ofstream> file;
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    if (!profiling_enabled)
+                        return;
+
+                    profiling_enabled = false;
+                    std::swap(filename, filename_);
+                    std::swap(file, file_);
+                }
+
+                if (file)
+                    write_report(*file);
+                else if (filename == "cout")
+                    write_report(std::cout);
+                else if (filename == "cerr")
+                    write_report(std::cerr);
+            }
+
+            std::size_t max_nodes() const
+            {
+                return max_nodes_;
+            }
+
+            std::uint32_t generation() const
+            {
+                return generation_;
+            }
+
+            std::uint64_t get_dropped()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+
+                std::uint64_t dropped = 0;
+                for (auto const& buffer : buffers_)
+                    dropped += buffer->dropped_;
+                return dropped;
+            }
+
+            void write_report(std::ostream& os);
+
+        private:
+            mutex_type mtx_;
+
+            std::vector<std::unique_ptr<node_buffer> > buffers_;
+            std::size_t max_nodes_;
+            std::uint32_t generation_;
+            std::string filename_;
+            std::unique_ptr<std::ofstream> file_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        static HPX_NATIVE_TLS node_buffer* local_buffer = nullptr;
+
+        node_buffer* get_local_buffer()
+        {
+            if (HPX_UNLIKELY(local_buffer == nullptr))
+                local_buffer = profiler::get().register_thread();
+            return local_buffer;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        struct description_data
+        {
+            description_data()
+              : work_(0), critical_(0), count_(0), critical_count_(0)
+            {}
+
+            std::uint64_t work_;
+            std::uint64_t critical_;
+            std::uint64_t count_;
+            std::uint64_t critical_count_;
+        };
+
+        inline double to_ms(std::uint64_t ns)
+        {
+            return double(ns) / 1e6;
+        }
+
+        // Add the part of the interval [begin, end) falling into each bin.
+        void add_to_bins(std::vector<double>& bins, std::uint64_t origin,
+            std::uint64_t bin_size, std::uint64_t begin, std::uint64_t end)
+        {
+            if (end <= begin)
+                return;
+
+            std::size_t first = std::size_t((begin - origin) / bin_size);
+            std::size_t last = std::size_t((end - 1 - origin) / bin_size);
+            last = (std::min)(last, bins.size() - 1);
+            for (std::size_t b = first; b <= last; ++b)
+            {
+                std::uint64_t lo = origin + b * bin_size;
+                std::uint64_t hi = lo + bin_size;
+                bins[b] += double((std::min)(end, hi) - (std::max)(begin, lo));
+            }
+        }
+
+        void profiler::write_report(std::ostream& os)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+
+            // collect the nodes of all OS threads, the nodes of a buffer are
+            // kept together
+            std::vector<std::size_t> offsets;
+            std::vector<node> nodes;
+            std::uint64_t dropped = 0;
+            for (auto const& buffer : buffers_)
+            {
+                offsets.push_back(nodes.size());
+                nodes.insert(nodes.end(), buffer->nodes_.begin(),
+                    buffer->nodes_.end());
+                dropped += buffer->dropped_;
+            }
+
+            std::size_t const invalid = std::size_t(-1);
+            auto index_of = [&](std::uint64_t id) -> std::size_t
+            {
+                if (id == 0 || std::uint32_t(id >> 56) != (generation_ & 0xff))
+                    return invalid;
+
+                std::size_t buffer = std::size_t((id >> 32) & 0xffffff);
+                std::size_t pos = std::size_t(id & 0xffffffff) - 1;
+                if (buffer >= buffers_.size() ||
+                    pos >= buffers_[buffer]->nodes_.size())
+                {
+                    return invalid;
+                }
+                return offsets[buffer] + pos;
+            };
+
+            os << "task graph profile\n";
+            os << "  nodes (thread phases):  " << nodes.size() << "\n";
+            os << "  dropped nodes:          " << dropped << "\n";
+            if (nodes.empty())
+            {
+                os.flush();
+                return;
+            }
+
+            // nodes which were still running are cut off at their start
+            std::uint64_t first_start = nodes[0].start_;
+            std::uint64_t last_end = 0;
+            std::uint64_t work = 0;
+            for (node& n : nodes)
+            {
+                if (n.end_ < n.start_)
+                    n.end_ = n.start_;
+                first_start = (std::min)(first_start, n.start_);
+                last_end = (std::max)(last_end, n.end_);
+                work += n.end_ - n.start_;
+            }
+
+            // All predecessors of a node started before it, processing the
+            // nodes in the order of their start times visits them first.
+            std::vector<std::size_t> order(nodes.size());
+            for (std::size_t i = 0; i != order.size(); ++i)
+                order[i] = i;
+            std::stable_sort(order.begin(), order.end(),
+                [&](std::size_t lhs, std::size_t rhs)
+                {
+                    return nodes[lhs].start_ < nodes[rhs].start_;
+                });
+
+            // The length of the longest chain of work leading to the start
+            // of each node. A node made ready by another one depends on the
+            // work that node did up to the point of enabling it only.
+            std::vector<std::uint64_t> path_start(nodes.size(), 0);
+            std::vector<std::size_t> pred(nodes.size(), invalid);
+            std::vector<std::uint64_t> pred_work(nodes.size(), 0);
+
+            std::size_t last = order[0];
+            std::uint64_t span = 0;
+            for (std::size_t i : order)
+            {
+                node const& n = nodes[i];
+
+                std::size_t p = index_of(n.prev_);
+                if (p != invalid)
+                {
+                    std::uint64_t w = nodes[p].end_ - nodes[p].start_;
+                    if (path_start[p] + w >= path_start[i])
+                    {
+                        path_start[i] = path_start[p] + w;
+                        pred[i] = p;
+                        pred_work[i] = w;
+                    }
+                }
+
+                std::size_t e = index_of(n.enabled_by_);
+                if (e != invalid)
+                {
+                    node const& en = nodes[e];
+                    std::uint64_t at = (std::max)(
+                        (std::min)(n.enabled_at_, en.end_), en.start_);
+                    std::uint64_t w = at - en.start_;
+                    if (path_start[e] + w > path_start[i] || pred[i] == invalid)
+                    {
+                        path_start[i] = path_start[e] + w;
+                        pred[i] = e;
+                        pred_work[i] = w;
+                    }
+                }
+
+                std::uint64_t end = path_start[i] + (n.end_ - n.start_);
+                if (end >= span)
+                {
+                    span = end;
+                    last = i;
+                }
+            }
+
+            // Attribute the work on the critical path to the descriptions,
+            // walking it back from the node finishing last.
+            std::map<std::string, description_data> descriptions;
+            std::map<std::pair<int, std::size_t>, description_data*> keys;
+            auto data_of = [&](util::thread_description const& desc)
+                -> description_data&
+            {
+                std::pair<int, std::size_t> key(int(desc.kind()),
+                    desc.kind() ==
+                            util::thread_description::data_type_description ?
+                        std::size_t(desc.get_annotation_id()) :
+                        desc.get_address());
+
+                auto it = keys.find(key);
+                if (it == keys.end())
+                {
+                    it = keys.emplace(key,
+                        &descriptions[util::as_string(desc)]).first;
+                }
+                return *it->second;
+            };
+
+            for (node const& n : nodes)
+            {
+                description_data& d = data_of(n.desc_);
+                d.work_ += n.end_ - n.start_;
+                ++d.count_;
+            }
+
+            std::vector<std::size_t> path;
+            std::uint64_t w = nodes[last].end_ - nodes[last].start_;
+            for (std::size_t i = last; i != invalid; i = pred[i])
+            {
+                description_data& d = data_of(nodes[i].desc_);
+                d.critical_ += w;
+                ++d.critical_count_;
+                path.push_back(i);
+                w = pred_work[i];
+            }
+
+            std::uint64_t const elapsed = last_end - first_start;
+
+            os << std::fixed << std::setprecision(3);
+            os << "  elapsed time [ms]:      " << to_ms(elapsed) << "\n";
+            os << "  total work [ms]:        " << to_ms(work) << "\n";
+            os << "  critical path [ms]:     " << to_ms(span) << "\n";
+            os << "  critical path nodes:    " << path.size() << "\n";
+            os << "  average parallelism:    "
+               << (span == 0 ? 0.0 : double(work) / double(span)) << "\n";
+
+            // the descriptions ordered by their time on the critical path
+            std::vector<std::pair<std::string, description_data> > sorted(
+                descriptions.begin(), descriptions.end());
+            std::stable_sort(sorted.begin(), sorted.end(),
+                [](std::pair<std::string, description_data> const& lhs,
+                    std::pair<std::string, description_data> const& rhs)
+                {
+                    return lhs.second.critical_ > rhs.second.critical_ ||
+                        (lhs.second.critical_ == rhs.second.critical_ &&
+                            lhs.second.work_ > rhs.second.work_);
+                });
+
+            os << "\ncontributions by description:\n";
+            os << "  critical [ms]  critical [%]  on path     work [ms]"
+                  "      nodes  description\n";
+            for (auto const& d : sorted)
+            {
+                os << std::setw(15) << to_ms(d.second.critical_)
+                   << std::setw(14)
+                   << (span == 0 ? 0.0 :
+                        100.0 * double(d.second.critical_) / double(span))
+                   << std::setw(9) << d.second.critical_count_
+                   << std::setw(14) << to_ms(d.second.work_)
+                   << std::setw(11) << d.second.count_
+                   << "  " << d.first << "\n";
+            }
+
+            // The available parallelism over time: the average number of
+            // nodes running and the average number of nodes ready to run
+            // (made ready, but not started yet) during each interval.
+            std::size_t const num_bins = 20;
+            std::uint64_t bin_size = (elapsed + num_bins - 1) / num_bins;
+            if (bin_size == 0)
+                bin_size = 1;
+
+            std::vector<double> running(num_bins, 0.0);
+            std::vector<double> ready(num_bins, 0.0);
+            for (node const& n : nodes)
+            {
+                add_to_bins(running, first_start, bin_size, n.start_, n.end_);
+                if (n.enabled_at_ != 0)
+                {
+                    add_to_bins(ready, first_start, bin_size,
+                        (std::max)(n.enabled_at_, first_start), n.start_);
+                }
+            }
+
+            os << "\nparallelism over time:\n";
+            os << "     begin [ms]      end [ms]    running      ready\n";
+            for (std::size_t b = 0; b != num_bins; ++b)
+            {
+                std::uint64_t begin = b * bin_size;
+                if (begin >= elapsed && b != 0)
+                    break;
+
+                os << std::setw(15) << to_ms(begin)
+                   << std::setw(14) << to_ms(begin + bin_size)
+                   << std::setw(11) << running[b] / double(bin_size)
+                   << std::setw(11) << ready[b] / double(bin_size) << "\n";
+            }
+
+            // the critical path itself, starting with its first node
+            std::size_t const max_path_nodes = 50;
+            os << "\ncritical path";
+            if (path.size() > max_path_nodes)
+                os << " (last " << max_path_nodes << " nodes)";
+            os << ":\n";
+            os << "     start [ms]  duration [ms]  description\n";
+
+            std::size_t shown = (std::min)(path.size(), max_path_nodes);
+            for (std::size_t k = shown; k != 0; --k)
+            {
+                node const& n = nodes[path[k - 1]];
+                os << std::setw(15) << to_ms(n.start_ - first_start)
+                   << std::setw(15) << to_ms(n.end_ - n.start_)
+                   << "  " << util::as_string(n.desc_) << "\n";
+            }
+            os.flush();
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void thread_enabled(thread_info& data)
+    {
+        // OS threads not recording any nodes are never running a node
+        detail::node_buffer* buffer = detail::local_buffer;
+        data.enabled_by_ = buffer != nullptr ? buffer->current_ : 0;
+        data.enabled_at_ = util::high_resolution_clock::now();
+    }
+
+    void node_started(thread_info& data, util::thread_description const& desc)
+    {
+        detail::node_buffer* buffer = detail::get_local_buffer();
+        if (buffer == nullptr)
+            return;
+
+        detail::profiler& p = detail::profiler::get();
+        if (buffer->nodes_.size() >= p.max_nodes())
+        {
+            ++buffer->dropped_;
+            buffer->current_ = 0;
+            data = thread_info();
+            return;
+        }
+
+        detail::node n = {
+            desc, util::high_resolution_clock::now(), 0,
+            data.enabled_by_, data.enabled_at_, data.last_node_
+        };
+        buffer->nodes_.push_back(n);
+
+        std::uint64_t id = detail::make_node_id(p.generation(),
+            buffer->index_, buffer->nodes_.size() - 1);
+
+        buffer->current_ = id;
+        data.last_node_ = id;
+        data.enabled_by_ = 0;
+        data.enabled_at_ = 0;
+    }
+
+    void node_finished()
+    {
+        detail::node_buffer* buffer = detail::local_buffer;
+        if (buffer == nullptr || buffer->current_ == 0)
+            return;
+
+        buffer->nodes_[std::size_t(buffer->current_ & 0xffffffff) - 1].end_ =
+            util::high_resolution_clock::now();
+        buffer->current_ = 0;
+    }
+
+    void start_profiling(std::string const& filename, std::size_t max_nodes)
+    {
+        detail::profiler::get().start(filename, max_nodes);
+    }
+
+    void stop_profiling()
+    {
+        detail::profiler::get().stop();
+    }
+
+    void write_report(std::ostream& os)
+    {
+        detail::profiler::get().write_report(os);
+    }
+
+    std::uint64_t get_dropped_nodes()
+    {
+        return detail::profiler::get().get_dropped();
+    }
+}}}
+
+#endif
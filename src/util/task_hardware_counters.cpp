@@ -0,0 +1,519 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_TASK_HARDWARE_COUNTERS)
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/annotation.hpp>
+#include <hpx/util/logging.hpp>
+#include <hpx/util/task_hardware_counters.hpp>
+#include <hpx/util/thread_description.hpp>
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace util { namespace task_counters
+{
+    bool task_counters_enabled = false;
+
+    namespace
+    {
+        ///////////////////////////////////////////////////////////////////////
+        struct known_event
+        {
+            char const* name_;
+            std::uint32_t type_;
+            std::uint64_t config_;
+        };
+
+        HPX_CONSTEXPR std::uint64_t cache_event(std::uint64_t cache,
+            std::uint64_t op, std::uint64_t result)
+        {
+            return cache | (op << 8) | (result << 16);
+        }
+
+        known_event const known_events[] =
+        {
+            { "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+            { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+            { "cache-references", PERF_TYPE_HARDWARE,
+                PERF_COUNT_HW_CACHE_REFERENCES },
+            { "cache-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+            { "branch-instructions", PERF_TYPE_HARDWARE,
+                PERF_COUNT_HW_BRANCH_INSTRUCTIONS },
+            { "branch-misses", PERF_TYPE_HARDWARE,
+                PERF_COUNT_HW_BRANCH_MISSES },
+            { "stalled-cycles-frontend", PERF_TYPE_HARDWARE,
+                PERF_COUNT_HW_STALLED_CYCLES_FRONTEND },
+            { "stalled-cycles-backend", PERF_TYPE_HARDWARE,
+                PERF_COUNT_HW_STALLED_CYCLES_BACKEND },
+            { "l1d-load-misses", PERF_TYPE_HW_CACHE,
+                cache_event(PERF_COUNT_HW_CACHE_L1D,
+                    PERF_COUNT_HW_CACHE_OP_READ,
+                    PERF_COUNT_HW_CACHE_RESULT_MISS) },
+            { "llc-load-misses", PERF_TYPE_HW_CACHE,
+                cache_event(PERF_COUNT_HW_CACHE_LL,
+                    PERF_COUNT_HW_CACHE_OP_READ,
+                    PERF_COUNT_HW_CACHE_RESULT_MISS) },
+            { "llc-store-misses", PERF_TYPE_HW_CACHE,
+                cache_event(PERF_COUNT_HW_CACHE_LL,
+                    PERF_COUNT_HW_CACHE_OP_WRITE,
+                    PERF_COUNT_HW_CACHE_RESULT_MISS) },
+            { "dtlb-load-misses", PERF_TYPE_HW_CACHE,
+                cache_event(PERF_COUNT_HW_CACHE_DTLB,
+                    PERF_COUNT_HW_CACHE_OP_READ,
+                    PERF_COUNT_HW_CACHE_RESULT_MISS) },
+        };
+
+        struct event
+        {
+            std::string name_;
+            std::uint32_t type_;
+            std::uint64_t config_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The totals collected for one task description.
+        struct task_data
+        {
+            task_data()
+              : count_(0)
+            {
+                std::memset(values_, 0, sizeof(values_));
+            }
+
+            util::thread_description desc_;
+            std::uint64_t values_[max_events];
+            std::uint64_t count_;
+        };
+
+        struct task_key
+        {
+            task_key(util::thread_description const& desc)
+              : kind_(desc.kind())
+              , value_(desc.kind() ==
+                        util::thread_description::data_type_description ?
+                    std::size_t(desc.get_annotation_id()) :
+                    desc.get_address())
+            {}
+
+            friend bool operator==(task_key const& lhs, task_key const& rhs)
+            {
+                return lhs.kind_ == rhs.kind_ && lhs.value_ == rhs.value_;
+            }
+
+            int kind_;
+            std::size_t value_;
+        };
+
+        struct task_key_hash
+        {
+            std::size_t operator()(task_key const& key) const
+            {
+                return key.value_ ^ std::size_t(key.kind_);
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The counters of one OS thread. The totals are updated by the owning
+        // OS thread only, the lock is needed for the performance counters
+        // reading them.
+        struct thread_counters
+        {
+            typedef lcos::local::spinlock mutex_type;
+
+            thread_counters()
+              : group_fd_(-1)
+              , num_events_(0)
+              , failed_(false)
+              , current_(nullptr)
+            {
+                std::memset(start_, 0, sizeof(start_));
+            }
+
+            bool open(std::vector<event> const& events);
+            void close();
+            bool read(std::uint64_t* values) const;
+
+            mutex_type mtx_;
+            int group_fd_;
+            std::vector<int> fds_;
+            std::size_t num_events_;
+            bool failed_;
+
+            std::uint64_t start_[max_events];
+            task_data* current_;
+
+            std::unordered_map<task_key, task_data, task_key_hash> tasks_;
+        };
+
+        long perf_event_open(perf_event_attr* attr, pid_t pid, int cpu,
+            int group_fd, unsigned long flags)
+        {
+            return ::syscall(__NR_perf_event_open, attr, pid, cpu, group_fd,
+                flags);
+        }
+
+        bool thread_counters::open(std::vector<event> const& events)
+        {
+            for (event const& e : events)
+            {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = e.type_;
+                attr.config = e.config_;
+                attr.read_format = PERF_FORMAT_GROUP;
+                attr.disabled = group_fd_ == -1 ? 1 : 0;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+
+                // measure the calling OS thread on any core
+                int fd = int(perf_event_open(&attr, 0, -1, group_fd_, 0));
+                if (fd == -1)
+                {
+                    LRT_(warning) << "task_counters: perf_event_open failed "
+                        "for event " << e.name_ << ": "
+                        << std::strerror(errno);
+                    close();
+                    return false;
+                }
+
+                if (group_fd_ == -1)
+                    group_fd_ = fd;
+                fds_.push_back(fd);
+            }
+
+            num_events_ = events.size();
+            ::ioctl(group_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ::ioctl(group_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            return true;
+        }
+
+        void thread_counters::close()
+        {
+            for (int fd : fds_)
+                ::close(fd);
+            fds_.clear();
+            group_fd_ = -1;
+            num_events_ = 0;
+            current_ = nullptr;
+        }
+
+        bool thread_counters::read(std::uint64_t* values) const
+        {
+            // PERF_FORMAT_GROUP: the number of events followed by the values
+            std::uint64_t data[max_events + 1];
+            std::size_t size = (num_events_ + 1) * sizeof(std::uint64_t);
+            if (::read(group_fd_, data, size) != ssize_t(size))
+                return false;
+
+            std::memcpy(values, data + 1, num_events_ * sizeof(std::uint64_t));
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        class registry
+        {
+        public:
+            typedef lcos::local::spinlock mutex_type;
+
+            static registry& get()
+            {
+                static registry r;
+                return r;
+            }
+
+            thread_counters* register_thread()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                threads_.emplace_back(new thread_counters);
+                return threads_.back().get();
+            }
+
+            void start(std::vector<event> && events)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                events_ = std::move(events);
+            }
+
+            std::vector<event> const& get_events() const
+            {
+                return events_;
+            }
+
+            // The counters are closed only after the scheduling loops have
+            // exited, the thread data is kept as it is still referenced by
+            // the OS threads.
+            void stop()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                for (auto const& t : threads_)
+                {
+                    std::lock_guard<thread_counters::mutex_type> ll(t->mtx_);
+                    t->close();
+                    t->failed_ = false;
+                    t->tasks_.clear();
+                }
+            }
+
+            template <typename F>
+            void for_each_task(F && f)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                for (auto const& t : threads_)
+                {
+                    std::lock_guard<thread_counters::mutex_type> ll(t->mtx_);
+                    for (auto& task : t->tasks_)
+                        f(task.second);
+                }
+            }
+
+        private:
+            mutex_type mtx_;
+            std::vector<event> events_;
+            std::vector<std::unique_ptr<thread_counters> > threads_;
+        };
+
+        thread_counters* get_thread_counters()
+        {
+            static HPX_NATIVE_TLS thread_counters* counters = nullptr;
+            if (HPX_UNLIKELY(counters == nullptr))
+                counters = registry::get().register_thread();
+            return counters;
+        }
+
+        bool find_event(std::string const& name, event& e)
+        {
+            for (known_event const& k : known_events)
+            {
+                if (name == k.name_)
+                {
+                    e.name_ = name;
+                    e.type_ = k.type_;
+                    e.config_ = k.config_;
+                    return true;
+                }
+            }
+
+            // model specific events: r<hex code>
+            if (name.size() > 1 && name[0] == 'r')
+            {
+                char* end = nullptr;
+                std::uint64_t config = std::strtoull(name.c_str() + 1, &end, 16);
+                if (end != nullptr && *end == '\0')
+                {
+                    e.name_ = name;
+                    e.type_ = PERF_TYPE_RAW;
+                    e.config_ = config;
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void task_started(util::thread_description const& desc)
+    {
+        thread_counters* t = get_thread_counters();
+        if (t->group_fd_ == -1)
+        {
+            if (t->failed_)
+                return;
+
+            std::lock_guard<thread_counters::mutex_type> l(t->mtx_);
+            if (!t->open(registry::get().get_events()))
+            {
+                t->failed_ = true;
+                return;
+            }
+        }
+
+        if (!t->read(t->start_))
+            return;
+
+        // the task data is created on first use only, the lookup happens
+        // while the lock is held as the table may be rehashed
+        std::lock_guard<thread_counters::mutex_type> l(t->mtx_);
+        task_data& data = t->tasks_[task_key(desc)];
+        if (data.count_ == 0)
+            data.desc_ = desc;
+        t->current_ = &data;
+    }
+
+    void task_stopped()
+    {
+        thread_counters* t = get_thread_counters();
+        if (t->current_ == nullptr)
+            return;
+
+        std::uint64_t values[max_events];
+        if (!t->read(values))
+        {
+            t->current_ = nullptr;
+            return;
+        }
+
+        std::lock_guard<thread_counters::mutex_type> l(t->mtx_);
+        if (t->current_ == nullptr)
+            return;     // the counters have been stopped in between
+
+        for (std::size_t i = 0; i != t->num_events_; ++i)
+            t->current_->values_[i] += values[i] - t->start_[i];
+        ++t->current_->count_;
+        t->current_ = nullptr;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void start_task_counters(std::string const& names)
+    {
+        std::vector<std::string> event_names;
+        boost::algorithm::split(event_names, names,
+            boost::algorithm::is_any_of(","),
+            boost::algorithm::token_compress_on);
+
+        std::vector<event> events;
+        for (std::string& name : event_names)
+        {
+            boost::algorithm::trim(name);
+            if (name.empty())
+                continue;
+
+            event e;
+            if (!find_event(name, e))
+            {
+                std::string known;
+                for (known_event const& k : known_events)
+                    known += std::string(" ") + k.name_;
+
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "task_counters::start_task_counters",
+                    "unknown hardware event '" + name + "' (known events:" +
+                        known + ", or r<hex code> for raw events)");
+            }
+            events.push_back(e);
+        }
+
+        if (events.empty())
+            return;
+
+        if (events.size() > max_events)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "task_counters::start_task_counters",
+                "too many hardware events requested, at most " +
+                    std::to_string(max_events) + " can be measured at the "
+                    "same time");
+        }
+
+        registry::get().start(std::move(events));
+        task_counters_enabled = true;
+    }
+
+    void stop_task_counters()
+    {
+        if (!task_counters_enabled)
+            return;
+
+        task_counters_enabled = false;
+        registry::get().stop();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<std::string> get_task_names()
+    {
+        std::vector<std::string> names;
+        registry::get().for_each_task(
+            [&names](task_data const& data)
+            {
+                std::string name = util::as_string(data.desc_);
+                for (std::string const& n : names)
+                {
+                    if (n == name)
+                        return;
+                }
+                names.push_back(std::move(name));
+            });
+        return names;
+    }
+
+    std::vector<std::string> get_events()
+    {
+        std::vector<std::string> names;
+        for (event const& e : registry::get().get_events())
+            names.push_back(e.name_);
+        return names;
+    }
+
+    int get_event_index(std::string const& name)
+    {
+        std::vector<event> const& events = registry::get().get_events();
+        for (std::size_t i = 0; i != events.size(); ++i)
+        {
+            if (events[i].name_ == name)
+                return int(i);
+        }
+        return -1;
+    }
+
+    std::int64_t get_task_event_count(std::size_t event,
+        std::string const& task, bool reset)
+    {
+        HPX_ASSERT(event <= max_events);
+
+        // the descriptions of the tasks are compared by their interned ids
+        std::uint32_t const id = find_annotation(task);
+
+        std::uint64_t result = 0;
+        registry::get().for_each_task(
+            [&](task_data& data)
+            {
+                if (data.desc_.kind() ==
+                        util::thread_description::data_type_description ?
+                    data.desc_.get_annotation_id() != id :
+                    util::as_string(data.desc_) != task)
+                {
+                    return;
+                }
+
+                if (event == max_events)
+                {
+                    result += data.count_;
+                    if (reset)
+                        data.count_ = 0;
+                }
+                else
+                {
+                    result += data.values_[event];
+                    if (reset)
+                        data.values_[event] = 0;
+                }
+            });
+        return static_cast<std::int64_t>(result);
+    }
+}}}
+
+#endif
@@ -0,0 +1,401 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_TASK_TRACER)
+#include <hpx/compat/condition_variable.hpp>
+#include <hpx/compat/mutex.hpp>
+#include <hpx/compat/thread.hpp>
+#include <hpx/runtime/get_thread_name.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/annotation.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/hardware/timestamp.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/task_tracer.hpp>
+#include <hpx/util/thread_description.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace hpx { namespace util { namespace tracing
+{
+    bool tracing_enabled = false;
+
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The file starts with the magic string "HPXTRACE", followed by the
+        // version, the locality id and the start time (in ticks and in
+        // nanoseconds). All values are written in the native byte order.
+        // After that the file holds a sequence of records, each starting with
+        // a one byte tag:
+        //
+        //   'T': std::uint32_t buffer, std::uint32_t length, name of an OS thread
+        //   'N': std::uint64_t key, std::uint32_t length, name of a task
+        //   'E': std::uint32_t buffer, std::uint32_t count, count trace_events
+        //   'F': std::uint64_t end ticks, std::uint64_t end nanoseconds,
+        //        std::uint64_t number of dropped events
+        char const trace_magic[] = "HPXTRACE";
+        std::uint32_t const trace_version = 1;
+
+        enum event_flags
+        {
+            flag_name_is_address = 1
+        };
+
+        struct trace_event
+        {
+            std::uint64_t timestamp_;
+            std::uint64_t id_;
+            std::uint64_t name_;        // id of the interned name of the task
+            std::uint32_t data_;
+            std::uint16_t type_;
+            std::uint16_t flags_;
+        };
+
+        static_assert(sizeof(trace_event) == 32,
+            "trace_event is expected to occupy 32 bytes");
+
+        ///////////////////////////////////////////////////////////////////////
+        // The buffer is written by the owning OS thread and read by the
+        // thread draining the events only.
+        struct ring_buffer
+        {
+            ring_buffer(std::size_t size, std::uint32_t index,
+                    std::string const& name)
+              : events_(size), mask_(size - 1), index_(index), name_(name),
+                name_written_(false), head_(0), dropped_(0), tail_(0)
+            {
+                HPX_ASSERT((size & mask_) == 0);
+            }
+
+            void push(trace_event const& e)
+            {
+                std::uint64_t head = head_.load(std::memory_order_relaxed);
+                if (head - tail_.load(std::memory_order_acquire) > mask_)
+                {
+                    dropped_.store(
+                        dropped_.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_relaxed);
+                    return;
+                }
+
+                events_[head & mask_] = e;
+                head_.store(head + 1, std::memory_order_release);
+            }
+
+            std::vector<trace_event> events_;
+            std::uint64_t const mask_;
+            std::uint32_t const index_;
+            std::string const name_;
+            bool name_written_;
+
+            // written by the owning thread only
+            std::atomic<std::uint64_t> head_;
+            std::atomic<std::uint64_t> dropped_;
+            char cacheline_pad_[threads::get_cache_line_size()];
+
+            // written by the draining thread only
+            std::atomic<std::uint64_t> tail_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        class tracer
+        {
+            typedef compat::mutex mutex_type;
+
+        public:
+            tracer()
+              : buffer_size_(0), file_(nullptr), stop_requested_(false)
+            {}
+
+            static tracer& get()
+            {
+                static tracer t;
+                return t;
+            }
+
+            // The ring buffers are never deleted as the OS threads keep
+            // referring to them.
+            ring_buffer* register_thread()
+            {
+                std::string name = hpx::get_thread_name();
+
+                std::lock_guard<mutex_type> l(mtx_);
+                if (buffer_size_ == 0)
+                    return nullptr;
+
+                buffers_.emplace_back(new ring_buffer(buffer_size_,
+                    static_cast<std::uint32_t>(buffers_.size()), name));
+                return buffers_.back().get();
+            }
+
+            void start(std::string const& filename, std::size_t buffer_size,
+                std::uint32_t locality_id)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+
+                if (file_ != nullptr)
+                {
+                    HPX_THROW_EXCEPTION(invalid_status,
+                        "hpx::util::tracing::start_tracing",
+                        "tracing has already been started");
+                }
+
+                file_ = std::fopen(filename.c_str(), "wb");
+                if (file_ == nullptr)
+                {
+                    HPX_THROW_EXCEPTION(filesystem_error,
+                        "hpx::util::tracing::start_tracing",
+                        "could not open trace file: " + filename);
+                }
+
+                // round the buffer size up to the next power of two
+                buffer_size_ = 2;
+                while (buffer_size_ < buffer_size)
+                    buffer_size_ *= 2;
+
+                // discard events and counts left over from a previous trace
+                for (auto& buffer : buffers_)
+                {
+                    buffer->tail_.store(
+                        buffer->head_.load(std::memory_order_acquire),
+                        std::memory_order_release);
+                    buffer->dropped_.store(0, std::memory_order_relaxed);
+                    buffer->name_written_ = false;
+                }
+                names_.clear();
+
+                std::fwrite(trace_magic, 1, 8, file_);
+                write(trace_version);
+                write(locality_id);
+                write(std::uint64_t(util::hardware::timestamp()));
+                write(util::high_resolution_clock::now());
+
+                stop_requested_ = false;
+                drain_thread_ = compat::thread(&tracer::run, this);
+
+                tracing_enabled = true;
+            }
+
+            void stop()
+            {
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    if (file_ == nullptr)
+                        return;
+
+                    tracing_enabled = false;
+                    stop_requested_ = true;
+                }
+
+                cond_.notify_all();
+                drain_thread_.join();
+
+                std::lock_guard<mutex_type> l(mtx_);
+                drain();
+
+                write('F');
+                write(std::uint64_t(util::hardware::timestamp()));
+                write(util::high_resolution_clock::now());
+                write(dropped());
+
+                std::fclose(file_);
+                file_ = nullptr;
+            }
+
+            std::uint64_t get_dropped()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                return dropped();
+            }
+
+        private:
+            template <typename T>
+            void write(T const& value)
+            {
+                std::fwrite(&value, sizeof(T), 1, file_);
+            }
+
+            void write(std::string const& value)
+            {
+                write(static_cast<std::uint32_t>(value.size()));
+                std::fwrite(value.data(), 1, value.size(), file_);
+            }
+
+            std::uint64_t dropped() const
+            {
+                std::uint64_t result = 0;
+                for (auto const& buffer : buffers_)
+                    result += buffer->dropped_.load(std::memory_order_relaxed);
+                return result;
+            }
+
+            // the drain thread wakes up periodically to empty the buffers
+            void run()
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+                while (!stop_requested_)
+                {
+                    drain();
+                    cond_.wait_for(l, std::chrono::milliseconds(10));
+                }
+            }
+
+            void write_name(trace_event const& e)
+            {
+                if (e.name_ == 0 || (e.flags_ & flag_name_is_address) ||
+                    !names_.insert(e.name_).second)
+                {
+                    return;
+                }
+
+                char const* name =
+                    get_annotation_name(static_cast<std::uint32_t>(e.name_));
+                std::uint32_t length =
+                    static_cast<std::uint32_t>(std::strlen(name));
+
+                write('N');
+                write(e.name_);
+                write(length);
+                std::fwrite(name, 1, length, file_);
+            }
+
+            void drain(ring_buffer& buffer)
+            {
+                std::uint64_t tail = buffer.tail_.load(std::memory_order_relaxed);
+                std::uint64_t head = buffer.head_.load(std::memory_order_acquire);
+                if (tail == head)
+                    return;
+
+                if (!buffer.name_written_)
+                {
+                    write('T');
+                    write(buffer.index_);
+                    write(buffer.name_);
+                    buffer.name_written_ = true;
+                }
+
+                for (std::uint64_t i = tail; i != head; ++i)
+                    write_name(buffer.events_[i & buffer.mask_]);
+
+                write('E');
+                write(buffer.index_);
+                write(static_cast<std::uint32_t>(head - tail));
+
+                // the events may wrap around the end of the buffer
+                std::size_t first = tail & buffer.mask_;
+                std::size_t count = static_cast<std::size_t>(head - tail);
+                std::size_t size = buffer.events_.size();
+                if (first + count > size)
+                {
+                    std::fwrite(&buffer.events_[first], sizeof(trace_event),
+                        size - first, file_);
+                    count -= size - first;
+                    first = 0;
+                }
+                std::fwrite(&buffer.events_[first], sizeof(trace_event),
+                    count, file_);
+
+                buffer.tail_.store(head, std::memory_order_release);
+            }
+
+            void drain()
+            {
+                for (auto& buffer : buffers_)
+                    drain(*buffer);
+                std::fflush(file_);
+            }
+
+        private:
+            mutex_type mtx_;
+            compat::condition_variable cond_;
+
+            std::vector<std::unique_ptr<ring_buffer> > buffers_;
+            std::size_t buffer_size_;
+
+            std::FILE* file_;
+            bool stop_requested_;
+            compat::thread drain_thread_;
+
+            // the keys of the names written to the file so far
+            std::unordered_set<std::uint64_t> names_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        ring_buffer* get_local_buffer()
+        {
+            static HPX_NATIVE_TLS ring_buffer* buffer = nullptr;
+            if (HPX_UNLIKELY(buffer == nullptr))
+                buffer = tracer::get().register_thread();
+            return buffer;
+        }
+
+        inline void record_event(event_type type, std::uint64_t id,
+            std::uint64_t name, std::uint16_t flags, std::uint32_t data)
+        {
+            ring_buffer* buffer = get_local_buffer();
+            if (buffer != nullptr)
+            {
+                trace_event e = {
+                    static_cast<std::uint64_t>(util::hardware::timestamp()),
+                    id, name, data, static_cast<std::uint16_t>(type), flags
+                };
+                buffer->push(e);
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void record_event_impl(event_type type, std::uint64_t id,
+        char const* name, std::uint32_t data)
+    {
+        detail::record_event(type, id, intern_annotation(name), 0, data);
+    }
+
+    void record_event_impl(event_type type, std::uint64_t id,
+        util::thread_description const& desc, std::uint32_t data)
+    {
+        if (desc.kind() == util::thread_description::data_type_description)
+        {
+            detail::record_event(type, id, desc.get_annotation_id(), 0, data);
+        }
+        else
+        {
+            detail::record_event(type, id, desc.get_address(),
+                detail::flag_name_is_address, data);
+        }
+    }
+
+    void start_tracing(std::string const& filename, std::size_t buffer_size,
+        std::uint32_t locality_id)
+    {
+        detail::tracer::get().start(filename, buffer_size, locality_id);
+    }
+
+    void stop_tracing()
+    {
+        detail::tracer::get().stop();
+    }
+
+    std::uint64_t get_dropped_events()
+    {
+        return detail::tracer::get().get_dropped();
+    }
+}}}
+
+#endif
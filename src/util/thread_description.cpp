@@ -61,6 +61,7 @@ namespace hpx { namespace util
             // if the current task has a description, use it.
             if (type_ == data_type_description)
             {
+                id_ = desc.id_;
                 data_.desc_ = desc.get_description();
             }
             else
@@ -11,8 +11,10 @@
 #include <hpx/hpx.hpp>
 #include <hpx/hpx_init.hpp>
 
+#include <hpx/util/cache/concurrent_clock_cache.hpp>
 #include <hpx/util/cache/entries/lfu_entry.hpp>
 #include <hpx/util/cache/local_cache.hpp>
+#include <hpx/util/cache/statistics/concurrent_full_statistics.hpp>
 #include <hpx/util/cache/statistics/local_full_statistics.hpp>
 #include <hpx/util/detail/pp/stringize.hpp>
 #include <hpx/util/histogram.hpp>
@@ -26,6 +28,7 @@
 #include <cstdint>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -121,6 +124,23 @@ typedef hpx::util::cache::local_cache<
     hpx::util::cache::statistics::local_full_statistics
 > gva_cache_type;
 
+///////////////////////////////////////////////////////////////////////////////
+// The cache used by AGAS for single objects, which is read without locking
+struct concurrent_gva_entry
+{
+    std::uint64_t prefix_msb_;
+    std::uint64_t prefix_lsb_;
+    std::int32_t type_;
+    std::uint64_t count_;
+    std::uint64_t lva_;
+    std::uint64_t offset_;
+};
+
+typedef hpx::util::cache::concurrent_clock_cache<
+    std::uint64_t, concurrent_gva_entry, std::hash<std::uint64_t>,
+    hpx::util::cache::statistics::concurrent_full_statistics
+> concurrent_gva_cache_type;
+
 ///////////////////////////////////////////////////////////////////////////////
 void calculate_histogram(std::string const& prefix,
     std::vector<std::uint64_t> const& timings)
@@ -227,6 +247,85 @@ void test_update(gva_cache_type& cache, hpx::naming::gid_type first_key)
     calculate_histogram("update", timings);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Run the given lookup function on the given number of threads concurrently,
+// return the number of lookups per second
+template <typename F>
+double measure_concurrent_get(std::size_t num_threads, std::size_t num_lookups,
+    F const& f)
+{
+    std::vector<hpx::future<void> > futures;
+    futures.reserve(num_threads);
+
+    hpx::util::high_resolution_timer t;
+
+    for (std::size_t i = 0; i != num_threads; ++i)
+    {
+        futures.push_back(hpx::async(
+            [&f, i, num_lookups]()
+            {
+                for (std::size_t j = 0; j != num_lookups; ++j)
+                    f(i * 7919 + j);
+            }));
+    }
+    hpx::wait_all(futures);
+
+    return double(num_threads * num_lookups) / t.elapsed();
+}
+
+void test_concurrent_get(gva_cache_type& cache,
+    hpx::naming::gid_type first_key, std::size_t num_lookups)
+{
+    std::size_t const num_entries = cache.size();
+    if (num_entries == 0)
+        return;
+
+    concurrent_gva_cache_type concurrent_cache(num_entries);
+    for (std::size_t i = 1; i <= num_entries; ++i)
+    {
+        concurrent_cache.insert((first_key + i).get_lsb(),
+            concurrent_gva_entry{0, 0, 0, 1, 0, 0});
+    }
+
+    // the original cache has to be protected by a lock
+    hpx::lcos::local::spinlock mtx;
+    auto locked_get =
+        [&](std::size_t j)
+        {
+            gva_cache_key key(first_key + (j % num_entries + 1), 1);
+            gva_cache_key idbase;
+            gva_cache_type::entry_type e;
+
+            std::lock_guard<hpx::lcos::local::spinlock> l(mtx);
+            cache.get_entry(key, idbase, e);
+        };
+
+    auto lockfree_get =
+        [&](std::size_t j)
+        {
+            concurrent_gva_entry e;
+            concurrent_cache.get_entry(
+                (first_key + (j % num_entries + 1)).get_lsb(), e);
+        };
+
+    std::size_t const max_threads = hpx::get_os_thread_count();
+    for (std::size_t n = 1; /**/; n = (std::min)(2 * n, max_threads))
+    {
+        double const locked = measure_concurrent_get(n, num_lookups, locked_get);
+        double const lockfree =
+            measure_concurrent_get(n, num_lookups, lockfree_get);
+
+        std::cout << "concurrent get, threads: " << std::setw(3) << n
+                  << ", locked: " << std::setprecision(3) << std::setw(8)
+                  << locked / 1e6 << " Mops/s"
+                  << ", lock-free: " << std::setprecision(3) << std::setw(8)
+                  << lockfree / 1e6 << " Mops/s" << std::endl;
+
+        if (n == max_threads)
+            break;
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(boost::program_options::variables_map& vm)
 {
@@ -245,9 +344,14 @@ int hpx_main(boost::program_options::variables_map& vm)
 
     hpx::util::high_resolution_timer t1;
 
+    std::size_t num_lookups = 100000;
+    if (vm.count("num_lookups"))
+        num_lookups = vm["num_lookups"].as<std::size_t>();
+
     test_insert(cache, num_entries);
     test_get(cache, first_key);
     test_update(cache, first_key);
+    test_concurrent_get(cache, first_key, num_lookups);
 
     double elapsed = t1.elapsed();
     hpx::util::print_cdash_timing("AGASCache", elapsed);
@@ -267,6 +371,8 @@ int main(int argc, char* argv[])
          HPX_PP_STRINGIZE(HPX_AGAS_LOCAL_CACHE_SIZE_PER_THREAD) ")")
         ("num_entries,n", value<std::size_t>(),
          "number of items to insert into cache (default: 1000)")
+        ("num_lookups", value<std::size_t>(),
+         "number of concurrent lookups per thread (default: 100000)")
         ;
 
     // Initialize and run HPX
@@ -0,0 +1,382 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+// hpxinspect:nodeprecatedname:BOOST_ASSERT
+
+// Compares the owner side push/pop overhead of the Chase-Lev work-stealing
+// deque with the lockfree deque used by the default queue backends. Optional
+// thief threads continuously steal from the opposite end of the owners'
+// queues.
+
+// Makes HPX use BOOST_ASSERT, so that I can use high_resolution_timer without
+// depending on the rest of HPX.
+#define HPX_USE_BOOST_ASSERT
+
+#include <hpx/compat/barrier.hpp>
+#include <hpx/compat/thread.hpp>
+#include <hpx/util/format.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/lockfree/chase_lev_deque.hpp>
+#include <hpx/util/lockfree/deque.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+char const* benchmark_name = "Chase-Lev Deque Overhead";
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+using boost::program_options::store;
+using boost::program_options::command_line_parser;
+using boost::program_options::notify;
+
+namespace compat = hpx::compat;
+using hpx::util::high_resolution_timer;
+
+///////////////////////////////////////////////////////////////////////////////
+std::uint64_t threads = 1;
+std::uint64_t thieves = 0;
+std::uint64_t blocksize = 10000;
+std::uint64_t iterations = 2000000;
+bool header = true;
+
+///////////////////////////////////////////////////////////////////////////////
+std::string format_build_date(std::string timestamp)
+{
+    std::chrono::time_point<std::chrono::system_clock> now =
+        std::chrono::system_clock::now();
+
+    std::time_t current_time = std::chrono::system_clock::to_time_t(now);
+
+    std::string ts = std::ctime(&current_time);
+    ts.resize(ts.size()-1);     // remove trailing '\n'
+    return ts;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void print_results(
+    variables_map& vm
+  , std::pair<double, double> elapsed_lockfree
+  , std::pair<double, double> elapsed_chase_lev
+  , std::uint64_t stolen_lockfree
+  , std::uint64_t stolen_chase_lev
+    )
+{
+    if (header)
+    {
+        std::cout << "# BENCHMARK: " << benchmark_name << "\n";
+
+        std::cout << "# VERSION: " << format_build_date(__DATE__) << "\n"
+             << "#\n";
+
+        std::cout <<
+            "## 0:ITER:Iterations per OS-thread - Independent Variable\n"
+            "## 1:BSIZE:Maximum Queue Depth - Independent Variable\n"
+            "## 2:OSTHRDS:Owning OS-threads - Independent Variable\n"
+            "## 3:THIEVES:Stealing OS-threads - Independent Variable\n"
+            "## 4:WTIME_LF_PUSH:Total Walltime/Push for "
+                "boost::lockfree::deque [nanoseconds]\n"
+            "## 5:WTIME_LF_POP:Total Walltime/Pop for "
+                "boost::lockfree::deque [nanoseconds]\n"
+            "## 6:WTIME_CL_PUSH:Total Walltime/Push for "
+                "boost::lockfree::chase_lev_deque [nanoseconds]\n"
+            "## 7:WTIME_CL_POP:Total Walltime/Pop for "
+                "boost::lockfree::chase_lev_deque [nanoseconds]\n"
+            "## 8:STOLEN_LF:Items stolen from boost::lockfree::deque\n"
+            "## 9:STOLEN_CL:Items stolen from "
+                "boost::lockfree::chase_lev_deque\n"
+                ;
+    }
+
+    hpx::util::format_to(std::cout,
+        "{} {} {} {} {:.14g} {:.14g} {:.14g} {:.14g} {} {}\n",
+        iterations,
+        blocksize,
+        threads,
+        thieves,
+        (elapsed_lockfree.first / (threads*iterations)) * 1e9,
+        (elapsed_lockfree.second / (threads*iterations)) * 1e9,
+        (elapsed_chase_lev.first / (threads*iterations)) * 1e9,
+        (elapsed_chase_lev.second / (threads*iterations)) * 1e9,
+        stolen_lockfree,
+        stolen_chase_lev
+    );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// owner side operations, both deques are used in LIFO order by the owner
+void push(boost::lockfree::deque<std::uint64_t>& q, std::uint64_t seed)
+{
+    q.push_left(seed);
+}
+
+void push(boost::lockfree::chase_lev_deque<std::uint64_t>& q,
+    std::uint64_t seed)
+{
+    q.push_bottom(seed);
+}
+
+bool pop(boost::lockfree::deque<std::uint64_t>& q)
+{
+    std::uint64_t t;
+    return q.pop_left(t);
+}
+
+bool pop(boost::lockfree::chase_lev_deque<std::uint64_t>& q)
+{
+    std::uint64_t t;
+    return q.pop_bottom(t);
+}
+
+// thief side operations, items are taken from the opposite end
+bool steal(boost::lockfree::deque<std::uint64_t>& q)
+{
+    std::uint64_t t;
+    return q.pop_right(t);
+}
+
+bool steal(boost::lockfree::chase_lev_deque<std::uint64_t>& q)
+{
+    std::uint64_t t;
+    return q.steal_top(t);
+}
+
+template <typename Deque>
+std::pair<double, double>
+bench_deque(Deque& q, std::uint64_t local_iterations)
+{
+    std::pair<double, double> elapsed(0.0, 0.0);
+
+    // Start the clock.
+    high_resolution_timer t;
+
+    for ( std::uint64_t block = 0
+        ; block < (local_iterations / blocksize)
+        ; ++block)
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Push.
+
+        // Restart the clock.
+        t.restart();
+
+        for (std::uint64_t i = 0; i < blocksize; ++i)
+        {
+            push(q, i);
+        }
+
+        elapsed.first += t.elapsed();
+
+        ///////////////////////////////////////////////////////////////////////
+        // Pop, stops early if the thieves took the remaining items.
+
+        // Restart the clock.
+        t.restart();
+
+        for (std::uint64_t i = 0; i < blocksize; ++i)
+        {
+            if (!pop(q))
+                break;
+        }
+
+        elapsed.second += t.elapsed();
+    }
+
+    return elapsed;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Deque>
+void owner_thread(
+    hpx::compat::barrier& b
+  , Deque& q
+  , std::pair<double, double>& elapsed
+    )
+{
+    // Warmup.
+    bench_deque(q, blocksize);
+
+    b.wait();
+
+    elapsed = bench_deque(q, iterations);
+}
+
+template <typename Deque>
+void thief_thread(
+    hpx::compat::barrier& b
+  , std::vector<std::unique_ptr<Deque> >& queues
+  , std::atomic<bool>& done
+  , std::uint64_t& stolen
+    )
+{
+    b.wait();
+
+    std::uint64_t victim = 0;
+    while (!done.load(std::memory_order_relaxed))
+    {
+        if (steal(*queues[victim]))
+            ++stolen;
+
+        if (++victim == queues.size())
+            victim = 0;
+    }
+}
+
+template <typename Deque>
+std::pair<double, double> run_benchmark(std::uint64_t& total_stolen)
+{
+    std::vector<std::unique_ptr<Deque> > queues;
+    for (std::uint64_t i = 0; i != threads; ++i)
+        queues.emplace_back(new Deque(blocksize));
+
+    std::vector<std::pair<double, double> >
+        elapsed(threads, std::pair<double, double>(0.0, 0.0));
+    std::vector<std::uint64_t> stolen(thieves, 0);
+    std::atomic<bool> done(false);
+
+    hpx::compat::barrier b(threads + thieves);
+
+    std::vector<compat::thread> owners;
+    for (std::uint64_t i = 0; i != threads; ++i)
+        owners.push_back(compat::thread(
+            owner_thread<Deque>,
+            std::ref(b),
+            std::ref(*queues[i]),
+            std::ref(elapsed[i])
+            ));
+
+    std::vector<compat::thread> stealers;
+    for (std::uint64_t i = 0; i != thieves; ++i)
+        stealers.push_back(compat::thread(
+            thief_thread<Deque>,
+            std::ref(b),
+            std::ref(queues),
+            std::ref(done),
+            std::ref(stolen[i])
+            ));
+
+    for (compat::thread& thread : owners)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+
+    done.store(true);
+
+    for (compat::thread& thread : stealers)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+
+    std::pair<double, double> total_elapsed(0.0, 0.0);
+    for (std::uint64_t i = 0; i < elapsed.size(); ++i)
+    {
+        total_elapsed.first  += elapsed[i].first;
+        total_elapsed.second += elapsed[i].second;
+    }
+
+    total_stolen = 0;
+    for (std::uint64_t i = 0; i < stolen.size(); ++i)
+        total_stolen += stolen[i];
+
+    return total_elapsed;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int app_main(
+    variables_map& vm
+    )
+{
+    std::uint64_t stolen_lockfree = 0;
+    std::pair<double, double> elapsed_lockfree =
+        run_benchmark<boost::lockfree::deque<std::uint64_t> >(
+            stolen_lockfree);
+
+    std::uint64_t stolen_chase_lev = 0;
+    std::pair<double, double> elapsed_chase_lev =
+        run_benchmark<boost::lockfree::chase_lev_deque<std::uint64_t> >(
+            stolen_chase_lev);
+
+    // Print out the results.
+    print_results(vm, elapsed_lockfree, elapsed_chase_lev,
+        stolen_lockfree, stolen_chase_lev);
+
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(
+    int argc
+  , char* argv[]
+    )
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Parse command line.
+    variables_map vm;
+
+    options_description cmdline("Usage: chase_lev_deque_overhead [options]");
+
+    cmdline.add_options()
+        ( "help,h"
+        , "print out program usage (this message)")
+
+        ( "threads,t"
+        , value<std::uint64_t>(&threads)->default_value(1)
+        , "number of owning threads to use")
+
+        ( "thieves"
+        , value<std::uint64_t>(&thieves)->default_value(0)
+        , "number of threads stealing from the owning threads' queues")
+
+        ( "iterations"
+        , value<std::uint64_t>(&iterations)->default_value(2000000)
+        , "number of iterations to perform (most be divisible by block size)")
+
+        ( "blocksize"
+        , value<std::uint64_t>(&blocksize)->default_value(10000)
+        , "size of each block")
+
+        ( "no-header"
+        , "do not print out the header")
+        ;
+
+    store(command_line_parser(argc, argv).options(cmdline).run(), vm);
+
+    notify(vm);
+
+    // Print help screen.
+    if (vm.count("help"))
+    {
+        std::cout << cmdline;
+        return 0;
+    }
+
+    if (iterations % blocksize)
+        throw std::invalid_argument(
+            "iterations must be cleanly divisable by blocksize\n");
+
+    if (threads == 0)
+        throw std::invalid_argument("at least one owning thread is required\n");
+
+    if (vm.count("no-header"))
+        header = false;
+
+    return app_main(vm);
+}
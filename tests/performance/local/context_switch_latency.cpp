@@ -0,0 +1,88 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the latency of a single context switch by
+// repeatedly resuming one coroutine which immediately yields back. Unlike
+// coroutines_call_overhead it touches only one context, so the stack and the
+// context data stay in the cache and only the switch itself is measured.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/util/format.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <cstdint>
+#include <iostream>
+
+using namespace boost::program_options;
+using namespace hpx::threads;
+
+///////////////////////////////////////////////////////////////////////////////
+std::uint64_t iterations = 10000000;
+std::uint64_t repetitions = 5;
+
+struct yield_back
+{
+    thread_result_type operator()(thread_state_ex_enum) const
+    {
+        return thread_result_type(pending, invalid_thread_id);
+    }
+};
+
+// returns the average duration of one switch [ns]
+double measure_switch_latency()
+{
+    coroutine_type c(yield_back(), invalid_thread_id);
+
+    // warm up
+    for (std::uint64_t i = 0; i != iterations / 10; ++i)
+        c(wait_signaled);
+
+    hpx::util::high_resolution_timer t;
+    for (std::uint64_t i = 0; i != iterations; ++i)
+        c(wait_signaled);
+
+    // every resume consists of two switches
+    return t.elapsed() * 1e9 / (2.0 * double(iterations));
+}
+
+int hpx_main(variables_map& vm)
+{
+    double best = 0.0;
+    double total = 0.0;
+    for (std::uint64_t i = 0; i != repetitions; ++i)
+    {
+        double ns = measure_switch_latency();
+        if (i == 0 || ns < best)
+            best = ns;
+        total += ns;
+    }
+
+    hpx::util::format_to(std::cout,
+        "context switch latency: {:.2f} [ns] (best of {}), {:.2f} [ns] "
+        "(average), {} switches per repetition\n",
+        best, repetitions, total / double(repetitions), 2 * iterations);
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "iterations"
+        , value<std::uint64_t>(&iterations)->default_value(10000000)
+        , "number of times the coroutine is resumed (2 * iterations context "
+          "switches will occur)")
+
+        ( "repetitions"
+        , value<std::uint64_t>(&repetitions)->default_value(5)
+        , "number of times the measurement is repeated")
+        ;
+
+    return hpx::init(cmdline, argc, argv);
+}
@@ -0,0 +1,157 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the cost of false sharing between worker threads.
+// Every worker thread repeatedly updates its own counter (or acquires its own
+// spinlock), once with the per worker data packed into a plain array and once
+// with every element padded to a cache line (util::cache_aligned_data, as
+// used for the per worker data of the schedulers). The packed variant slows
+// down with the number of worker threads, the padded one should not.
+//
+// To verify that no other data is shared, run the benchmark under
+// 'perf c2c record' and look for contended cache lines in 'perf c2c report'.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/cache_aligned_data.hpp>
+#include <hpx/util/format.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+using hpx::util::high_resolution_timer;
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+T& get(T& t)
+{
+    return t;
+}
+
+template <typename T>
+T& get(hpx::util::cache_aligned_data<T>& t)
+{
+    return t.data_;
+}
+
+template <typename Counter>
+void update_counter(Counter* counters, std::size_t i, std::uint64_t updates)
+{
+    for (std::uint64_t k = 0; k != updates; ++k)
+        get(counters[i]).fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename Lock>
+void acquire_lock(Lock* locks, std::size_t i, std::uint64_t updates)
+{
+    for (std::uint64_t k = 0; k != updates; ++k)
+    {
+        std::lock_guard<hpx::lcos::local::spinlock> l(get(locks[i]));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Data, typename F>
+double run(std::string const& name, F f, std::uint64_t updates, bool csv)
+{
+    std::size_t const num_threads = hpx::get_os_thread_count();
+    std::vector<Data> data(num_threads);
+
+    std::vector<hpx::future<void> > futures;
+    futures.reserve(num_threads);
+
+    // start the clock
+    high_resolution_timer walltime;
+
+    // one task for each worker thread, each touching its own element only
+    for (std::size_t i = 0; i != num_threads; ++i)
+    {
+        futures.push_back(hpx::async(f, data.data(), i, updates));
+    }
+    hpx::wait_all(futures);
+
+    // stop the clock
+    double const duration = walltime.elapsed();
+
+    if (csv)
+    {
+        hpx::util::format_to(hpx::cout,
+            "{1},{2},{3},{4}\n",
+            name, num_threads, updates, duration) << hpx::flush;
+    }
+    else
+    {
+        hpx::util::format_to(hpx::cout,
+            "{1}: {2} threads, {3} updates each in {4} seconds\n",
+            name, num_threads, updates, duration) << hpx::flush;
+    }
+    return duration;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(variables_map& vm)
+{
+    {
+        std::uint64_t const updates = vm["updates"].as<std::uint64_t>();
+        bool const csv = vm.count("csv") != 0;
+
+        typedef std::atomic<std::uint64_t> counter_type;
+        typedef hpx::util::cache_aligned_data<counter_type>
+            aligned_counter_type;
+        typedef hpx::lcos::local::spinlock lock_type;
+        typedef hpx::util::cache_aligned_data<lock_type> aligned_lock_type;
+
+        double duration = run<counter_type>("packed counters",
+            &update_counter<counter_type>, updates, csv);
+        hpx::util::print_cdash_timing("FalseSharingPackedCounters", duration);
+
+        duration = run<aligned_counter_type>("padded counters",
+            &update_counter<aligned_counter_type>, updates, csv);
+        hpx::util::print_cdash_timing("FalseSharingPaddedCounters", duration);
+
+        duration = run<lock_type>("packed locks",
+            &acquire_lock<lock_type>, updates, csv);
+        hpx::util::print_cdash_timing("FalseSharingPackedLocks", duration);
+
+        duration = run<aligned_lock_type>("padded locks",
+            &acquire_lock<aligned_lock_type>, updates, csv);
+        hpx::util::print_cdash_timing("FalseSharingPaddedLocks", duration);
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "updates"
+        , value<std::uint64_t>()->default_value(10000000)
+        , "number of updates executed by each worker thread")
+
+        ( "csv"
+        , "output results as csv (format: name,threads,updates,duration)")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
@@ -18,6 +18,7 @@
 #include <numeric>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -64,6 +65,24 @@ void measure_parallel_foreach(std::size_t size)
         });
 }
 
+template <typename Parameters>
+void measure_parallel_foreach_params(std::size_t size, Parameters && params)
+{
+    std::vector<std::size_t> data_representation(size);
+    std::iota(std::begin(data_representation),
+        std::end(data_representation),
+        gen());
+
+    // invoke parallel for_each
+    hpx::parallel::for_each(
+        hpx::parallel::execution::par.with(std::forward<Parameters>(params)),
+        std::begin(data_representation),
+        std::end(data_representation),
+        [](std::size_t) {
+            worker_timed(delay);
+        });
+}
+
 hpx::future<void> measure_task_foreach(std::size_t size)
 {
     std::shared_ptr<std::vector<std::size_t> > data_representation(
@@ -100,6 +119,32 @@ std::uint64_t average_out_parallel(std::size_t vector_size)
     return (hpx::util::high_resolution_clock::now() - start) / test_count;
 }
 
+std::uint64_t average_out_parallel_auto(std::size_t vector_size)
+{
+    // the chunk size is determined anew for each execution
+    hpx::parallel::execution::auto_chunk_size acs;
+
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+
+    for(auto i = 0; i < test_count; i++)
+        measure_parallel_foreach_params(vector_size, acs);
+
+    return (hpx::util::high_resolution_clock::now() - start) / test_count;
+}
+
+std::uint64_t average_out_parallel_tuned(std::size_t vector_size)
+{
+    // the chunk size is tuned across all executions of the loop
+    hpx::parallel::execution::tuned_chunk_size tcs;
+
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+
+    for(auto i = 0; i < test_count; i++)
+        measure_parallel_foreach_params(vector_size, tcs);
+
+    return (hpx::util::high_resolution_clock::now() - start) / test_count;
+}
+
 std::uint64_t average_out_task(std::size_t vector_size)
 {
     if (num_overlapping_loops <= 0)
@@ -162,11 +207,15 @@ int hpx_main(boost::program_options::variables_map& vm)
         std::uint64_t par_time = average_out_parallel(vector_size);
         std::uint64_t task_time = average_out_task(vector_size);
         std::uint64_t seq_time = average_out_sequential(vector_size);
+        std::uint64_t auto_time = average_out_parallel_auto(vector_size);
+        std::uint64_t tuned_time = average_out_parallel_tuned(vector_size);
 
         if(csvoutput) {
             hpx::cout << "," << seq_time/1e9
                       << "," << par_time/1e9
-                      << "," << task_time/1e9 << "\n" << hpx::flush;
+                      << "," << task_time/1e9
+                      << "," << auto_time/1e9
+                      << "," << tuned_time/1e9 << "\n" << hpx::flush;
         }
         else {
         // print results(Formatted). Setw(x) assures that all output is right justified
@@ -187,13 +236,22 @@ int hpx_main(boost::program_options::variables_map& vm)
                              << std::right << std::setw(8) << task_time/1e9 << "\n"
                 << std::left << "Average sequential execution time: "
                              << std::right << std::setw(8) << seq_time/1e9 << "\n"
+                << std::left << "Average auto chunk size time     : "
+                             << std::right << std::setw(8) << auto_time/1e9 << "\n"
+                << std::left << "Average tuned chunk size time    : "
+                             << std::right << std::setw(8) << tuned_time/1e9 << "\n"
                              << hpx::flush;
 
             hpx::cout << "---------Execution Time Difference---------\n"
                 << std::left << "Parallel Scale: " << std::right  << std::setw(27)
                              << (double(seq_time) / par_time) << "\n"
                 << std::left << "Task Scale    : " << std::right  << std::setw(27)
-                             << (double(seq_time) / task_time) << "\n" << hpx::flush;
+                             << (double(seq_time) / task_time) << "\n"
+                << std::left << "Auto Scale    : " << std::right  << std::setw(27)
+                             << (double(seq_time) / auto_time) << "\n"
+                << std::left << "Tuned Scale   : " << std::right  << std::setw(27)
+                             << (double(seq_time) / tuned_time) << "\n"
+                             << hpx::flush;
         }
     }
 
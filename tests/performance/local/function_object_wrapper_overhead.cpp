@@ -39,6 +39,14 @@ struct foo
     template <typename Archive> void serialize(Archive&, unsigned int) {}
 };
 
+// a callable too large for the default small buffer of the function objects
+struct bar
+{
+    void operator()() const {}
+
+    void* data[6];
+};
+
 template <typename F>
 void run(F const & f, std::uint64_t local_iterations)
 {
@@ -53,6 +61,24 @@ void run(F const & f, std::uint64_t local_iterations)
               << ((elapsed/i)*1e9) << " ns\n";
 }
 
+// measure the cost of constructing and destroying the function object
+template <typename F>
+void run_construct(std::uint64_t local_iterations)
+{
+    std::uint64_t i = 0;
+    hpx::util::high_resolution_timer t;
+
+    for (; i < local_iterations; ++i)
+    {
+        F f = bar();
+        f();
+    }
+
+    double elapsed = t.elapsed();
+    std::cout << " walltime/iteration: "
+              << ((elapsed/i)*1e9) << " ns\n";
+}
+
 int app_main(
     variables_map& vm
     )
@@ -82,6 +108,19 @@ int app_main(
         std::cout << "std::function";
         run(f, iterations);
     }
+    {
+        std::cout << "construct hpx::util::unique_function (default storage)";
+        run_construct<hpx::util::unique_function_nonser<void()> >(iterations);
+    }
+    {
+        std::cout << "construct hpx::util::unique_function (task storage)";
+        run_construct<hpx::util::unique_function_nonser<void(),
+            hpx::util::detail::task_function_storage_size> >(iterations);
+    }
+    {
+        std::cout << "construct std::function";
+        run_construct<std::function<void()> >(iterations);
+    }
 
     return 0;
 }
@@ -15,6 +15,7 @@
 #include <hpx/include/apply.hpp>
 #include <hpx/include/async.hpp>
 #include <hpx/include/iostreams.hpp>
+#include <hpx/include/local_lcos.hpp>
 #include <hpx/include/threads.hpp>
 #include <hpx/util/yield_while.hpp>
 #include <hpx/util/lightweight_test.hpp>
@@ -199,6 +200,85 @@ void measure_function_futures_thread_count(std::uint64_t count, bool csv)
     hpx::util::print_cdash_timing("FutureOverheadThreadCount", duration);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Shared states of small trivially copyable values are allocated from a pool
+// kept for each worker thread, this compares them with shared states holding
+// a value of the same size which is not trivially copyable.
+struct boxed_double
+{
+    boxed_double(double d = 0.)
+      : d_(d)
+    {}
+
+    boxed_double(boxed_double const& rhs)
+      : d_(rhs.d_)
+    {}
+
+    boxed_double& operator=(boxed_double const& rhs)
+    {
+        d_ = rhs.d_;
+        return *this;
+    }
+
+    double d_;
+};
+
+double get_value(double d)
+{
+    return d;
+}
+
+double get_value(boxed_double const& d)
+{
+    return d.d_;
+}
+
+template <typename T>
+double measure_shared_states(std::uint64_t count)
+{
+    // start the clock
+    high_resolution_timer walltime;
+
+    for (std::uint64_t i = 0; i < count; ++i)
+    {
+        hpx::lcos::local::promise<T> p;
+        future<T> f = p.get_future().then(
+            [](future<T> g) -> T
+            {
+                return g.get();
+            });
+        p.set_value(T(1.));
+        global_scratch += get_value(f.get());
+    }
+
+    // stop the clock
+    return walltime.elapsed();
+}
+
+void measure_function_futures_shared_states(std::uint64_t count, bool csv)
+{
+    const double pooled = measure_shared_states<double>(count);
+    const double allocated = measure_shared_states<boxed_double>(count);
+
+    if (csv)
+        hpx::util::format_to(cout,
+            "{1},{2},{3}\n",
+            count,
+            pooled,
+            allocated) << flush;
+    else
+        hpx::util::format_to(cout,
+            "created {1} shared states (with continuation) in {2} seconds "
+            "(pooled), {3} seconds (allocated)\n",
+            count,
+            pooled,
+            allocated) << flush;
+    // CDash graph plotting
+    hpx::util::print_cdash_timing("FutureOverheadPooledSharedStates", pooled);
+    hpx::util::print_cdash_timing(
+        "FutureOverheadAllocatedSharedStates", allocated);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(
     variables_map& vm
@@ -216,6 +296,12 @@ int hpx_main(
         measure_function_futures_wait_each(count, vm.count("csv") != 0);
         measure_function_futures_wait_all(count, vm.count("csv") != 0);
         measure_function_futures_thread_count(count, vm.count("csv") != 0);
+
+        if (vm.count("compare-shared-states"))
+        {
+            measure_function_futures_shared_states(
+                count, vm.count("csv") != 0);
+        }
     }
 
     finalize();
@@ -240,6 +326,9 @@ int main(
         , value<std::uint64_t>()->default_value(0)
         , "number of iterations in the delay loop")
 
+        ( "compare-shared-states"
+        , "compare pooled shared states with allocated ones")
+
         ( "csv"
         , "output results as csv (format: count,duration)")
         ;
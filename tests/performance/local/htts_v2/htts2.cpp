@@ -17,6 +17,42 @@
 namespace htts2
 {
 
+namespace
+{
+
+void parse_command_line(
+    boost::program_options::options_description const& cmdline
+  , boost::program_options::variables_map& vm
+  , int argc
+  , char** argv
+  , bool allow_unregistered
+    )
+{
+    if (allow_unregistered)
+    {
+        boost::program_options::store(
+            boost::program_options::command_line_parser(argc, argv)
+                .options(cmdline).allow_unregistered().run(), vm);
+    }
+    else
+    {
+        boost::program_options::store(
+            boost::program_options::command_line_parser(argc, argv)
+                .options(cmdline).run(), vm);
+    }
+
+    boost::program_options::notify(vm);
+
+    // Print help screen.
+    if (vm.count("help"))
+    {
+        std::cout << cmdline;
+        std::exit(0);
+    }
+}
+
+}
+
 driver::driver(int argc, char** argv, bool allow_unregistered)
   : osthreads_(1)
   , tasks_(500000)
@@ -54,31 +90,103 @@ driver::driver(int argc, char** argv, bool allow_unregistered)
         , "don't print out column headers")
         ;
 
-    if (allow_unregistered_)
-    {
-        boost::program_options::store(
-            boost::program_options::command_line_parser(argc, argv)
-                .options(cmdline).allow_unregistered().run(), vm);
-    }
-    else
-    {
-        boost::program_options::store(
-            boost::program_options::command_line_parser(argc, argv)
-                .options(cmdline).run(), vm);
-    }
+    parse_command_line(cmdline, vm, argc, argv, allow_unregistered_);
 
-    boost::program_options::notify(vm);
+    if (vm.count("no-header"))
+        io_ = csv_without_headers;
+}
 
-    // Print help screen.
-    if (vm.count("help"))
-    {
-        std::cout << cmdline;
-        std::exit(0);
-    }
+latency_driver::latency_driver(int argc, char** argv, bool allow_unregistered)
+  : osthreads_(1)
+  , samples_(10000)
+  , background_(0)
+  , payload_duration_(5000)
+  , io_(csv_with_headers)
+  , argc_(argc)
+  , argv_(argv)
+  , allow_unregistered_(allow_unregistered)
+{
+    boost::program_options::variables_map vm;
+
+    boost::program_options::options_description cmdline
+        (std::string("Usage: ") + argv[0] + " [options]");
+
+    cmdline.add_options()
+        ( "help,h"
+        , "print out program usage (this message)")
+
+        ( "osthreads,t"
+        , boost::program_options::value<std::uint64_t>
+                (&osthreads_)->default_value(1)
+        , "number of OS-threads to use")
+
+        ( "samples"
+        , boost::program_options::value<std::uint64_t>
+                (&samples_)->default_value(10000)
+        , "number of latency samples to take for each scenario")
+
+        ( "background"
+        , boost::program_options::value<std::uint64_t>
+                (&background_)->default_value(0)
+        , "number of background tasks per OS-thread kept runnable while "
+          "sampling")
+
+        ( "payload"
+        , boost::program_options::value<std::uint64_t>
+                (&payload_duration_)->default_value(5000)
+        , "duration of the payload of the background tasks in nanoseconds")
+
+        ( "no-header"
+        , "don't print out column headers")
+        ;
+
+    parse_command_line(cmdline, vm, argc, argv, allow_unregistered_);
 
     if (vm.count("no-header"))
         io_ = csv_without_headers;
 }
 
+void latency_driver::print_headers() const
+{
+    if (io_ != csv_with_headers)
+        return;
+
+    std::cout
+        << "Scheduler,"
+        << "OS-threads (Independent Variable),"
+        << "Background Tasks per OS-thread (Independent Variable) "
+           "[tasks/OS-threads],"
+        << "Background Payload Duration (Control Variable) [nanoseconds],"
+        << "Scenario,"
+        << "Samples,"
+        << "Mean Latency [nanoseconds],"
+        << "50th Percentile Latency [nanoseconds],"
+        << "99th Percentile Latency [nanoseconds],"
+        << "99.9th Percentile Latency [nanoseconds],"
+        << "Maximum Latency [nanoseconds]"
+        << "\n";
 }
 
+void latency_driver::print_results(std::string const& scheduler
+  , char const* scenario, latency_statistics const& stats) const
+{
+    std::streamsize const precision = std::cout.precision(14);
+
+    std::cout
+        << scheduler << ","
+        << osthreads_ << ","
+        << background_ << ","
+        << payload_duration_ << ","
+        << scenario << ","
+        << stats.samples_ << ","
+        << stats.mean_ << ","
+        << stats.p50_ << ","
+        << stats.p99_ << ","
+        << stats.p999_ << ","
+        << stats.max_
+        << "\n";
+
+    std::cout.precision(precision);
+}
+
+}
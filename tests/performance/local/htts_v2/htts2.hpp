@@ -12,10 +12,14 @@
 
 #include <boost/assert.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
+#include <string>
+#include <vector>
 
 namespace htts2
 {
@@ -123,5 +127,77 @@ struct driver
     bool allow_unregistered_;
 };
 
+// Distribution of a set of latency samples, in nanoseconds.
+struct latency_statistics
+{
+    std::uint64_t samples_;
+    double mean_;
+    double p50_;
+    double p99_;
+    double p999_;
+    double max_;
+};
+
+template <typename Rep>
+double percentile(std::vector<Rep> const& sorted, double q)
+{
+    BOOST_ASSERT(!sorted.empty());
+
+    // nearest-rank method
+    std::size_t rank = static_cast<std::size_t>(std::ceil(q * sorted.size()));
+    return static_cast<double>(sorted[rank == 0 ? 0 : rank - 1]);
+}
+
+template <typename Rep>
+latency_statistics compute_latency_statistics(std::vector<Rep> samples)
+{
+    latency_statistics stats = {};
+
+    stats.samples_ = samples.size();
+    if (samples.empty())
+        return stats;
+
+    std::sort(samples.begin(), samples.end());
+
+    double sum = 0.0;
+    for (Rep s : samples)
+        sum += static_cast<double>(s);
+
+    stats.mean_ = sum / samples.size();
+    stats.p50_ = percentile(samples, 0.5);
+    stats.p99_ = percentile(samples, 0.99);
+    stats.p999_ = percentile(samples, 0.999);
+    stats.max_ = static_cast<double>(samples.back());
+    return stats;
+}
+
+struct latency_driver
+{
+    // Parses the command line.
+    latency_driver(int argc, char** argv, bool allow_unregistered = false);
+
+    virtual ~latency_driver() {}
+
+  protected:
+    // Prints the column headers, if requested on the command line.
+    void print_headers() const;
+
+    // Prints one row with the latency distribution of a scenario.
+    void print_results(std::string const& scheduler, char const* scenario,
+        latency_statistics const& stats) const;
+
+    // Reads from the command line.
+    std::uint64_t osthreads_;
+    std::uint64_t samples_;
+    std::uint64_t background_;
+    std::uint64_t payload_duration_;
+    io_type         io_;
+
+    // hold on to command line
+    int argc_;
+    char** argv_;
+    bool allow_unregistered_;
+};
+
 }
 
@@ -0,0 +1,347 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the latency distribution of the HPX schedulers (select one with
+// --hpx:queuing) instead of their throughput:
+//
+//   spawn-to-start:      time from registering a task until it starts running
+//   spawn-to-start-high-priority:
+//                        the same for a high priority task
+//   priority-inversion:  time a high priority task waits for a lock which is
+//                        held by a suspended normal priority task
+//   ready-to-resume:     time from making a suspended task ready until it
+//                        resumes, with the task on another OS-thread of the
+//                        same NUMA domain as the thread waking it up
+//   ready-to-resume-cross-numa:
+//                        the same with the task on an OS-thread of another
+//                        NUMA domain (if there is any)
+//
+// Every scenario is measured while --background tasks per OS-thread (each
+// running for --payload nanoseconds) are kept runnable.
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/lcos/local/event.hpp>
+#include <hpx/lcos/local/mutex.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/resource/detail/partitioner.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/util/bind.hpp>
+
+#include "htts2.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+template <typename BaseClock = std::chrono::steady_clock>
+struct hpx_driver : htts2::latency_driver
+{
+    typedef typename htts2::clocksource<BaseClock>::rep rep;
+
+    hpx_driver(int argc, char** argv)
+      : htts2::latency_driver(argc, argv, true)
+      , stop_(false)
+      , active_background_(0)
+    {}
+
+    void run()
+    {
+        std::vector<std::string> const cfg = {
+            "hpx.os_threads=" + std::to_string(osthreads_),
+            "hpx.run_hpx_main!=0",
+            "hpx.commandline.allow_unknown!=1"
+        };
+
+        boost::program_options::options_description desc;
+
+        using hpx::util::placeholders::_1;
+        hpx::init(hpx::util::bind(&hpx_driver::run_impl, std::ref(*this), _1),
+            desc, argc_, argv_, cfg);
+    }
+
+  private:
+    int run_impl(boost::program_options::variables_map&)
+    {
+        std::string const scheduler =
+            hpx::get_config_entry("hpx.scheduler", "unknown");
+
+        print_headers();
+
+        start_background();
+
+        print_results(scheduler, "spawn-to-start",
+            spawn_to_start(hpx::threads::thread_priority_normal));
+        print_results(scheduler, "spawn-to-start-high-priority",
+            spawn_to_start(hpx::threads::thread_priority_high));
+        print_results(scheduler, "priority-inversion", priority_inversion());
+
+        std::vector<std::size_t> const domains = numa_domains();
+
+        std::uint64_t const signaler = 0;
+        std::uint64_t local_waiter = signaler;
+        std::uint64_t remote_waiter = signaler;
+        for (std::uint64_t i = this->osthreads_; i-- != 1; )
+        {
+            if (domains[i] == domains[signaler])
+                local_waiter = i;
+            else
+                remote_waiter = i;
+        }
+
+        print_results(scheduler, "ready-to-resume",
+            ready_to_resume(signaler, local_waiter));
+
+        if (remote_waiter != signaler)
+        {
+            print_results(scheduler, "ready-to-resume-cross-numa",
+                ready_to_resume(signaler, remote_waiter));
+        }
+
+        stop_background();
+
+        return hpx::finalize();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The background tasks replace themselves by a new task on the same
+    // OS-thread until they are stopped, which keeps the queues of all
+    // OS-threads filled.
+    void background_task(std::uint64_t target_osthread)
+    {
+        htts2::payload<BaseClock>(this->payload_duration_ /* = p */);
+
+        if (stop_.load(std::memory_order_relaxed))
+        {
+            --active_background_;
+            return;
+        }
+
+        register_background_task(target_osthread);
+    }
+
+    void register_background_task(std::uint64_t target_osthread)
+    {
+        hpx::threads::register_work_nullary(
+            [this, target_osthread]()
+            {
+                background_task(target_osthread);
+            }
+          , "background_task"
+          , hpx::threads::pending
+          , hpx::threads::thread_priority_normal
+          // Place in the target OS-thread's queue.
+          , hpx::threads::thread_schedule_hint(target_osthread)
+        );
+    }
+
+    void start_background()
+    {
+        active_background_ = this->osthreads_ * this->background_;
+
+        for (std::uint64_t i = 0; i != this->osthreads_; ++i)
+        {
+            for (std::uint64_t j = 0; j != this->background_; ++j)
+                register_background_task(i);
+        }
+    }
+
+    void stop_background()
+    {
+        stop_ = true;
+
+        while (active_background_ != 0)
+            hpx::this_thread::yield();
+    }
+
+    // Returns: the NUMA domain of each of the OS-threads.
+    std::vector<std::size_t> numa_domains() const
+    {
+        auto const& topo = hpx::threads::get_topology();
+        auto& rp = hpx::resource::get_partitioner();
+
+        std::vector<std::size_t> result(this->osthreads_);
+        for (std::uint64_t i = 0; i != this->osthreads_; ++i)
+            result[i] = topo.get_numa_node_number(rp.get_pu_num(i));
+
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    htts2::latency_statistics spawn_to_start(
+        hpx::threads::thread_priority priority)
+    {
+        std::vector<rep> samples(this->samples_);
+        std::atomic<bool> started(false);
+
+        for (std::uint64_t i = 0; i != this->samples_; ++i)
+        {
+            started = false;
+
+            rep const spawned = htts2::clocksource<BaseClock>::now();
+
+            hpx::threads::register_thread_nullary(
+                [&samples, &started, i, spawned]()
+                {
+                    samples[i] = htts2::clocksource<BaseClock>::now() - spawned;
+                    started.store(true, std::memory_order_release);
+                }
+              , "spawn_to_start"
+              , hpx::threads::pending
+              , true
+              , priority
+            );
+
+            // Take one sample at a time, otherwise we would measure the
+            // throughput of the scheduler.
+            while (!started.load(std::memory_order_acquire))
+                hpx::this_thread::yield();
+        }
+
+        return htts2::compute_latency_statistics(std::move(samples));
+    }
+
+    // A normal priority task acquires a lock and suspends (yields) while
+    // holding it. A high priority task trying to acquire the lock has to
+    // wait for the lock holder to be resumed, which is queued behind the
+    // background tasks.
+    htts2::latency_statistics priority_inversion()
+    {
+        std::vector<rep> samples(this->samples_);
+        hpx::lcos::local::mutex mtx;
+        std::atomic<bool> locked(false);
+        std::atomic<bool> acquired(false);
+
+        for (std::uint64_t i = 0; i != this->samples_; ++i)
+        {
+            locked = false;
+            acquired = false;
+
+            hpx::threads::register_thread_nullary(
+                [&mtx, &locked]()
+                {
+                    std::lock_guard<hpx::lcos::local::mutex> l(mtx);
+                    locked.store(true, std::memory_order_release);
+                    hpx::this_thread::yield();
+                }
+              , "priority_inversion_holder"
+              , hpx::threads::pending
+              , true
+              , hpx::threads::thread_priority_normal
+            );
+
+            while (!locked.load(std::memory_order_acquire))
+                hpx::this_thread::yield();
+
+            hpx::threads::register_thread_nullary(
+                [&samples, &mtx, &acquired, i]()
+                {
+                    rep const start = htts2::clocksource<BaseClock>::now();
+                    {
+                        std::lock_guard<hpx::lcos::local::mutex> l(mtx);
+                    }
+                    samples[i] = htts2::clocksource<BaseClock>::now() - start;
+                    acquired.store(true, std::memory_order_release);
+                }
+              , "priority_inversion_waiter"
+              , hpx::threads::pending
+              , true
+              , hpx::threads::thread_priority_high
+            );
+
+            while (!acquired.load(std::memory_order_acquire))
+                hpx::this_thread::yield();
+        }
+
+        // make sure the last lock holder has released the lock
+        std::lock_guard<hpx::lcos::local::mutex> l(mtx);
+
+        return htts2::compute_latency_statistics(std::move(samples));
+    }
+
+    // A task running on the signaler OS-thread wakes up a task suspended
+    // on the waiter OS-thread.
+    htts2::latency_statistics ready_to_resume(
+        std::uint64_t signaler_osthread, std::uint64_t waiter_osthread)
+    {
+        std::vector<rep> samples(this->samples_);
+        hpx::lcos::local::event finished;
+
+        hpx::threads::register_thread_nullary(
+            [&, waiter_osthread]()
+            {
+                for (std::uint64_t i = 0; i != this->samples_; ++i)
+                    samples[i] = ready_to_resume_sample(waiter_osthread);
+
+                finished.set();
+            }
+          , "ready_to_resume_signaler"
+          , hpx::threads::pending
+          , true
+          , hpx::threads::thread_priority_normal
+          , hpx::threads::thread_schedule_hint(signaler_osthread)
+        );
+
+        finished.wait();
+
+        return htts2::compute_latency_statistics(std::move(samples));
+    }
+
+    rep ready_to_resume_sample(std::uint64_t waiter_osthread)
+    {
+        hpx::lcos::local::event ready;
+        std::atomic<bool> resumed(false);
+        rep signaled = 0;
+        rep sample = 0;
+
+        hpx::threads::thread_id_type id = hpx::threads::register_thread_nullary(
+            [&]()
+            {
+                ready.wait();
+                sample = htts2::clocksource<BaseClock>::now() - signaled;
+                resumed.store(true, std::memory_order_release);
+            }
+          , "ready_to_resume_waiter"
+          , hpx::threads::pending
+          , true
+          , hpx::threads::thread_priority_normal
+          , hpx::threads::thread_schedule_hint(waiter_osthread)
+        );
+
+        // Make the waiter ready only after it has suspended.
+        while (hpx::threads::get_thread_state(id).state() !=
+            hpx::threads::suspended)
+        {
+            hpx::this_thread::yield();
+        }
+
+        signaled = htts2::clocksource<BaseClock>::now();
+        ready.set();
+
+        while (!resumed.load(std::memory_order_acquire))
+            hpx::this_thread::yield();
+
+        return sample;
+    }
+
+    std::atomic<bool> stop_;
+    std::atomic<std::uint64_t> active_background_;
+};
+
+int main(int argc, char** argv)
+{
+    hpx_driver<> d(argc, argv);
+
+    d.run();
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// OpenMP baseline for htts2_latency_hpx. OpenMP has no means of suspending
+// and resuming tasks or of prioritizing them reliably, so only the
+// spawn-to-start latency is measured.
+
+#define HPX_NO_VERSION_CHECK
+#include "htts2.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <omp.h>
+
+template <typename BaseClock = std::chrono::steady_clock>
+struct omp_driver : htts2::latency_driver
+{
+    typedef typename htts2::clocksource<BaseClock>::rep rep;
+
+    omp_driver(int argc, char** argv)
+      : htts2::latency_driver(argc, argv)
+      , stop_(false)
+    {}
+
+    void run()
+    {
+        omp_set_num_threads(this->osthreads_);
+
+        print_headers();
+        print_results("omp", "spawn-to-start", spawn_to_start());
+    }
+
+  private:
+    // The background tasks replace themselves by a new task until they are
+    // stopped. Note that OpenMP runtimes may run tasks undeferred once too
+    // many tasks are queued, so --background should stay small.
+    void background_task()
+    {
+        htts2::payload<BaseClock>(this->payload_duration_ /* = p */);
+
+        if (!stop_.load(std::memory_order_relaxed))
+        {
+            #pragma omp task untied
+            background_task();
+        }
+    }
+
+    htts2::latency_statistics spawn_to_start()
+    {
+        std::vector<rep> samples(this->samples_);
+
+        stop_ = false;
+
+        #pragma omp parallel
+        #pragma omp single
+        {
+            // The background tasks are not children of this task, the
+            // taskwait below does not wait for them.
+            #pragma omp task untied
+            for (std::uint64_t n = 0;
+                 n < this->osthreads_ * this->background_; ++n)
+            {
+                #pragma omp task untied
+                background_task();
+            }
+
+            for (std::uint64_t i = 0; i != this->samples_; ++i)
+            {
+                rep const spawned = htts2::clocksource<BaseClock>::now();
+
+                #pragma omp task firstprivate(i, spawned) shared(samples)
+                samples[i] = htts2::clocksource<BaseClock>::now() - spawned;
+
+                // Take one sample at a time, otherwise we would measure the
+                // throughput of the scheduler.
+                #pragma omp taskwait
+            }
+
+            stop_ = true;
+        }
+
+        return htts2::compute_latency_statistics(std::move(samples));
+    }
+
+    std::atomic<bool> stop_;
+};
+
+int main(int argc, char** argv)
+{
+    omp_driver<> d(argc, argv);
+
+    d.run();
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Qthreads baseline for htts2_latency_hpx. Qthreads have no priorities and
+// no means of querying whether a qthread is blocked, so only the
+// spawn-to-start latency is measured.
+
+#define HPX_NO_VERSION_CHECK
+#include "htts2.hpp"
+
+#include <qthread/qthread.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+typedef std::chrono::steady_clock BaseClock;
+typedef htts2::clocksource<BaseClock>::rep rep;
+
+struct sample_data
+{
+    rep spawned_;
+    rep sample_;
+};
+
+extern "C" aligned_t spawn_to_start_sample(void* data_)
+{
+    sample_data* data = reinterpret_cast<sample_data*>(data_);
+    data->sample_ = htts2::clocksource<BaseClock>::now() - data->spawned_;
+    return 0;
+}
+
+struct qthreads_driver : htts2::latency_driver
+{
+    qthreads_driver(int argc, char** argv)
+      : htts2::latency_driver(argc, argv)
+      , stop_(false)
+      , active_background_(0)
+    {}
+
+    void run()
+    {
+        setenv("QT_NUM_SHEPHERDS",
+            std::to_string(this->osthreads_).c_str(), 1);
+        setenv("QT_NUM_WORKERS_PER_SHEPHERD", "1", 1);
+
+        qthread_initialize();
+
+        print_headers();
+        print_results("qthreads", "spawn-to-start", spawn_to_start());
+    }
+
+  private:
+    // The background tasks replace themselves by a new qthread until they
+    // are stopped.
+    static aligned_t background_task(void* driver_)
+    {
+        qthreads_driver* driver = reinterpret_cast<qthreads_driver*>(driver_);
+
+        htts2::payload<BaseClock>(driver->payload_duration_ /* = p */);
+
+        if (driver->stop_.load(std::memory_order_relaxed))
+            --driver->active_background_;
+        else
+            qthread_fork(&qthreads_driver::background_task, driver, nullptr);
+
+        return 0;
+    }
+
+    htts2::latency_statistics spawn_to_start()
+    {
+        std::vector<rep> samples(this->samples_);
+
+        stop_ = false;
+        active_background_ = this->osthreads_ * this->background_;
+
+        for (std::uint64_t n = 0; n < this->osthreads_ * this->background_; ++n)
+            qthread_fork(&qthreads_driver::background_task, this, nullptr);
+
+        for (std::uint64_t i = 0; i != this->samples_; ++i)
+        {
+            sample_data data = { htts2::clocksource<BaseClock>::now(), 0 };
+            aligned_t done = 0;
+
+            qthread_fork(&spawn_to_start_sample, &data, &done);
+
+            // Take one sample at a time, otherwise we would measure the
+            // throughput of the scheduler.
+            qthread_readFF(nullptr, &done);
+
+            samples[i] = data.sample_;
+        }
+
+        stop_ = true;
+        while (active_background_ != 0)
+            qthread_yield();
+
+        return htts2::compute_latency_statistics(std::move(samples));
+    }
+
+    std::atomic<bool> stop_;
+    std::atomic<std::uint64_t> active_background_;
+};
+
+int main(int argc, char** argv)
+{
+    qthreads_driver d(argc, argv);
+
+    d.run();
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// TBB baseline for htts2_latency_hpx. TBB tasks can neither be suspended
+// and resumed nor prioritized individually, so only the spawn-to-start
+// latency is measured.
+
+#define HPX_NO_VERSION_CHECK
+#include "htts2.hpp"
+
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+template <typename BaseClock = std::chrono::steady_clock>
+struct tbb_driver : htts2::latency_driver
+{
+    typedef typename htts2::clocksource<BaseClock>::rep rep;
+
+    tbb_driver(int argc, char** argv)
+      : htts2::latency_driver(argc, argv)
+      , stop_(false)
+    {}
+
+    void run()
+    {
+        tbb::task_arena arena(static_cast<int>(this->osthreads_));
+
+        print_headers();
+        arena.execute([this]()
+        {
+            print_results("tbb", "spawn-to-start", spawn_to_start());
+        });
+    }
+
+  private:
+    // The background tasks replace themselves by a new task until they are
+    // stopped.
+    void background_task(tbb::task_group& background)
+    {
+        htts2::payload<BaseClock>(this->payload_duration_ /* = p */);
+
+        if (!stop_.load(std::memory_order_relaxed))
+        {
+            background.run([this, &background]()
+            {
+                background_task(background);
+            });
+        }
+    }
+
+    htts2::latency_statistics spawn_to_start()
+    {
+        std::vector<rep> samples(this->samples_);
+
+        stop_ = false;
+
+        tbb::task_group background;
+        for (std::uint64_t n = 0; n < this->osthreads_ * this->background_; ++n)
+        {
+            background.run([this, &background]()
+            {
+                background_task(background);
+            });
+        }
+
+        for (std::uint64_t i = 0; i != this->samples_; ++i)
+        {
+            tbb::task_group sample;
+
+            rep const spawned = htts2::clocksource<BaseClock>::now();
+
+            sample.run([&samples, i, spawned]()
+            {
+                samples[i] = htts2::clocksource<BaseClock>::now() - spawned;
+            });
+
+            // Take one sample at a time, otherwise we would measure the
+            // throughput of the scheduler.
+            sample.wait();
+        }
+
+        stop_ = true;
+        background.wait();
+
+        return htts2::compute_latency_statistics(std::move(samples));
+    }
+
+    std::atomic<bool> stop_;
+};
+
+int main(int argc, char** argv)
+{
+    tbb_driver<> d(argc, argv);
+
+    d.run();
+
+    return 0;
+}
@@ -0,0 +1,177 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the time needed to run a number of HPX threads
+// which all update data protected by a small number of mutexes. The length
+// of the critical sections is controlled with --delay-iterations, the type
+// of the mutex can be selected with --mutex (spinlock, mutex, adaptive).
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/local/adaptive_mutex.hpp>
+#include <hpx/lcos/local/mutex.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/format.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+using hpx::util::high_resolution_timer;
+
+///////////////////////////////////////////////////////////////////////////////
+// we use globals here to prevent the delay from being optimized away
+double global_scratch = 0;
+std::uint64_t num_iterations = 0;
+
+std::size_t const max_num_mutexes = 64;
+double global_data[max_num_mutexes] = {0};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Mutex>
+double update(Mutex* mtx, std::size_t num_mutexes, std::size_t i,
+    std::uint64_t updates)
+{
+    double d = 0.;
+    for (std::uint64_t k = 0; k != updates; ++k)
+    {
+        std::size_t idx = (i + k) % num_mutexes;
+
+        std::lock_guard<Mutex> l(mtx[idx]);
+        d = global_data[idx];
+        for (double j = 0.; j < num_iterations; ++j)
+        {
+            d += 1. / (2. * j + 1.);
+        }
+        global_data[idx] = d;
+    }
+    return d;
+}
+
+template <typename Mutex>
+double run(std::string const& name, std::uint64_t count,
+    std::size_t num_mutexes, std::uint64_t updates, bool csv)
+{
+    std::vector<Mutex> mtx(num_mutexes);
+
+    std::vector<hpx::future<double> > futures;
+    futures.reserve(count);
+
+    // start the clock
+    high_resolution_timer walltime;
+    for (std::uint64_t i = 0; i != count; ++i)
+    {
+        futures.push_back(hpx::async(&update<Mutex>, mtx.data(), num_mutexes,
+            std::size_t(i), updates));
+    }
+
+    for (hpx::future<double>& f : futures)
+        global_scratch += f.get();
+
+    // stop the clock
+    double const duration = walltime.elapsed();
+
+    if (csv)
+    {
+        hpx::util::format_to(hpx::cout,
+            "{1},{2},{3},{4},{5}\n",
+            name, count, num_mutexes, num_iterations, duration) << hpx::flush;
+    }
+    else
+    {
+        hpx::util::format_to(hpx::cout,
+            "{1}: invoked {2} futures ({3} mutexes, {4} delay iterations) "
+            "in {5} seconds\n",
+            name, count, num_mutexes, num_iterations, duration) << hpx::flush;
+    }
+    return duration;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(variables_map& vm)
+{
+    {
+        num_iterations = vm["delay-iterations"].as<std::uint64_t>();
+
+        std::uint64_t const count = vm["futures"].as<std::uint64_t>();
+        std::uint64_t const updates = vm["updates"].as<std::uint64_t>();
+        std::size_t const num_mutexes = vm["mutexes"].as<std::size_t>();
+        std::string const mutex = vm["mutex"].as<std::string>();
+        bool const csv = vm.count("csv") != 0;
+
+        if (HPX_UNLIKELY(0 == count))
+            throw std::logic_error("error: count of 0 futures specified\n");
+        if (HPX_UNLIKELY(0 == num_mutexes || num_mutexes > max_num_mutexes))
+            throw std::logic_error("error: invalid number of mutexes\n");
+
+        if (mutex == "all" || mutex == "spinlock")
+        {
+            double duration = run<hpx::lcos::local::spinlock>(
+                "spinlock", count, num_mutexes, updates, csv);
+            hpx::util::print_cdash_timing("MutexOverheadSpinlock", duration);
+        }
+        if (mutex == "all" || mutex == "mutex")
+        {
+            double duration = run<hpx::lcos::local::mutex>(
+                "mutex", count, num_mutexes, updates, csv);
+            hpx::util::print_cdash_timing("MutexOverheadMutex", duration);
+        }
+        if (mutex == "all" || mutex == "adaptive")
+        {
+            double duration = run<hpx::lcos::local::adaptive_mutex>(
+                "adaptive", count, num_mutexes, updates, csv);
+            hpx::util::print_cdash_timing("MutexOverheadAdaptive", duration);
+        }
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "futures"
+        , value<std::uint64_t>()->default_value(10000)
+        , "number of futures to invoke")
+
+        ( "updates"
+        , value<std::uint64_t>()->default_value(100)
+        , "number of critical sections executed by each future")
+
+        ( "delay-iterations"
+        , value<std::uint64_t>()->default_value(50)
+        , "number of iterations in the delay loop inside the critical "
+          "sections")
+
+        ( "mutexes"
+        , value<std::size_t>()->default_value(4)
+        , "number of mutexes protecting the data (at most 64)")
+
+        ( "mutex"
+        , value<std::string>()->default_value("all")
+        , "type of mutex to measure (spinlock, mutex, adaptive, or all)")
+
+        ( "csv"
+        , "output results as csv (format: mutex,count,mutexes,delay,duration)")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
@@ -0,0 +1,129 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measure the time needed for creating and destroying managed components,
+// either from one HPX thread or concurrently from all worker threads.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/format.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct test_server
+  : hpx::components::managed_component_base<test_server>
+{
+};
+
+typedef hpx::components::managed_component<test_server> test_server_type;
+HPX_REGISTER_COMPONENT(test_server_type, test_server);
+
+///////////////////////////////////////////////////////////////////////////////
+// create the given number of components, keeping num_alive of them alive at
+// any point in time
+void create_components(std::size_t num_components, std::size_t num_alive)
+{
+    hpx::id_type here = hpx::find_here();
+
+    std::vector<hpx::id_type> ids(num_alive);
+    for (std::size_t i = 0; i != num_components; ++i)
+    {
+        ids[i % num_alive] = hpx::new_<test_server>(here).get();
+    }
+}
+
+double measure(std::size_t num_samples, std::size_t num_components,
+    std::size_t num_alive, std::size_t num_threads)
+{
+    double result = 0;
+
+    for (std::size_t k = 0; k != num_samples; ++k)
+    {
+        hpx::util::high_resolution_timer t;
+        if (num_threads == 1)
+        {
+            create_components(num_components, num_alive);
+        }
+        else
+        {
+            std::vector<hpx::future<void> > tasks;
+            tasks.reserve(num_threads);
+            for (std::size_t i = 0; i != num_threads; ++i)
+            {
+                tasks.push_back(hpx::async(
+                    &create_components, num_components, num_alive));
+            }
+            hpx::wait_all(tasks);
+        }
+        result += t.elapsed();
+    }
+
+    return result / num_samples;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t num_samples = vm["samples"].as<std::size_t>();
+    std::size_t num_components = vm["components"].as<std::size_t>();
+    std::size_t num_alive = vm["alive"].as<std::size_t>();
+    bool header = vm.count("no-header") == 0;
+
+    if (num_alive == 0)
+        num_alive = 1;
+
+    std::size_t num_threads = hpx::get_os_thread_count();
+
+    double elapsed_seq = measure(num_samples, num_components, num_alive, 1);
+    double elapsed_par =
+        measure(num_samples, num_components, num_alive, num_threads);
+
+    if (header)
+    {
+        hpx::cout
+            << "Components,Alive,Threads,Walltime sequential[s],"
+               "Walltime per Component sequential[s],Walltime concurrent[s],"
+               "Walltime per Component concurrent[s]"
+            << hpx::endl;
+    }
+
+    hpx::util::format_to(hpx::cout, "{},{},{},{},{},{},{}\n",
+        num_components, num_alive, num_threads,
+        elapsed_seq, elapsed_seq / num_components,
+        elapsed_par, elapsed_par / (num_components * num_threads))
+        << hpx::flush;
+    hpx::util::print_cdash_timing("NewComponent", elapsed_seq / num_components);
+    hpx::util::print_cdash_timing("NewComponentConcurrent",
+        elapsed_par / (num_components * num_threads));
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    namespace po = boost::program_options;
+
+    po::options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+    cmdline.add_options()
+        ("samples", po::value<std::size_t>()->default_value(10),
+         "number of samples to average over (default: 10)")
+        ("components", po::value<std::size_t>()->default_value(10000),
+         "number of components to create per thread (default: 10000)")
+        ("alive", po::value<std::size_t>()->default_value(100),
+         "number of components per thread to keep alive (default: 100)")
+        ("no-header", "do not print out the csv header row")
+        ;
+
+    return hpx::init(cmdline, argc, argv);
+}
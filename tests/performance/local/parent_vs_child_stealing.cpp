@@ -68,6 +68,7 @@ int hpx_main(boost::program_options::variables_map& vm)
     bool print_header = vm.count("no-header") == 0;
     bool do_child = vm.count("no-child") == 0;      // fork only
     bool do_parent = vm.count("no-parent") == 0;    // async only
+    bool do_work_first = vm.count("no-work-first") == 0;
     std::size_t num_cores = hpx::get_os_thread_count();
     if (vm.count("num_cores") != 0)
         num_cores = vm["num_cores"].as<std::size_t>();
@@ -82,19 +83,26 @@ int hpx_main(boost::program_options::variables_map& vm)
     if (do_child)
         parent_stealing_time = measure(hpx::launch::fork);
 
+    // and work-first times (parent stealing, parent resumed next)
+    double work_first_time = 0;
+    if (do_work_first)
+        work_first_time = measure(hpx::launch::work_first);
+
     if (print_header)
     {
         hpx::cout
-            << "num_cores,num_threads,child_stealing_time[s],parent_stealing_time[s]"
+            << "num_cores,num_threads,child_stealing_time[s],"
+               "parent_stealing_time[s],work_first_time[s]"
             << hpx::endl;
     }
 
     hpx::util::format_to(hpx::cout,
-        "{},{},{},{}",
+        "{},{},{},{},{}",
         num_cores,
         iterations,
         child_stealing_time,
-        parent_stealing_time) << hpx::endl;
+        parent_stealing_time,
+        work_first_time) << hpx::endl;
 
     return hpx::finalize();
 }
@@ -121,6 +129,7 @@ int main(int argc, char* argv[])
         ("no-header", "do not print out the csv header row")
         ("no-child", "do not test child-stealing (launch::fork only)")
         ("no-parent", "do not test child-stealing (launch::async only)")
+        ("no-work-first", "do not test launch::work_first")
         ;
 
     return hpx::init(cmdline, argc, argv);
@@ -9,6 +9,9 @@
 #include <hpx/include/iostreams.hpp>
 #include <hpx/util/detail/pp/stringize.hpp>
 #include <hpx/util/format.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
 
 using boost::program_options::variables_map;
 using boost::program_options::options_description;
@@ -22,6 +25,34 @@ using hpx::find_here;
 using hpx::cout;
 using hpx::flush;
 
+///////////////////////////////////////////////////////////////////////////////
+// The maximal size of a thread object: four cache lines (the first of which
+// holds the data used by the schedulers) plus the optional debugging data.
+std::size_t thread_data_budget()
+{
+    std::size_t budget = 4 * 64;
+#if defined(HPX_HAVE_THREAD_TARGET_ADDRESS)
+    budget += sizeof(hpx::naming::address_type);
+#endif
+#if defined(HPX_HAVE_THREAD_DESCRIPTION)
+    budget += 2 * sizeof(hpx::util::thread_description);
+#endif
+#if defined(HPX_HAVE_THREAD_PARENT_REFERENCE)
+    budget += sizeof(std::uint64_t) + sizeof(hpx::threads::thread_id_type) +
+        sizeof(std::size_t);
+#endif
+#if defined(HPX_HAVE_TASK_GRAPH_PROFILER)
+    budget += sizeof(hpx::util::task_graph::thread_info);
+#endif
+#if defined(HPX_HAVE_THREAD_MINIMAL_DEADLOCK_DETECTION)
+    budget += sizeof(std::uint64_t);
+#endif
+#if defined(HPX_HAVE_THREAD_BACKTRACE_ON_SUSPENSION)
+    budget += sizeof(void*);
+#endif
+    return budget;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(
     variables_map&
@@ -42,6 +73,10 @@ int hpx_main(
 #       undef HPX_SIZEOF
     }
 
+    // every additional cache line of the thread objects costs a cache miss
+    // per scheduled thread
+    HPX_TEST_LTE(sizeof(hpx::threads::thread_data), thread_data_budget());
+
     finalize();
     return 0;
 }
@@ -56,6 +91,7 @@ int main(
     options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
 
     // Initialize and run HPX.
-    return init(cmdline, argc, argv);
+    HPX_TEST_EQ(init(cmdline, argc, argv), 0);
+    return hpx::util::report_errors();
 }
 
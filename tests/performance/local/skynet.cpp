@@ -14,13 +14,22 @@
 // until reaching the root actor. (The answer should be 499999500000).
 
 // This code implements two versions of the skynet micro benchmark: a 'normal'
-// and a futurized one.
+// and a futurized one. Additionally, a 'flat' mode is provided which spawns
+// all leaf tasks directly from the root task. This mode stresses the creation
+// and retirement of HPX threads in the thread queues. The effect of sharding
+// the thread map of the queues can be measured by comparing the results for
+// --hpx:ini=hpx.thread_queue.thread_map_shards=1 with the default settings.
 
-#include <hpx/hpx_main.hpp>
+#include <hpx/hpx_init.hpp>
 #include <hpx/hpx.hpp>
 #include <hpx/include/iostreams.hpp>
+#include <hpx/lcos/local/latch.hpp>
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <string>
 #include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -80,33 +89,104 @@ skynet_f(std::int64_t num, std::int64_t size, std::int64_t div)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-int main()
+std::atomic<std::int64_t> flat_sum(0);
+
+void skynet_leaf(std::int64_t num, hpx::lcos::local::latch& l)
+{
+    flat_sum += num;
+    l.count_down(1);
+}
+
+std::int64_t skynet_flat(std::int64_t size)
 {
+    flat_sum = 0;
+
+    hpx::lcos::local::latch l(size + 1);
+    for (std::int64_t i = 0; i != size; ++i)
+    {
+        hpx::apply(&skynet_leaf, i, std::ref(l));
+    }
+    l.count_down_and_wait();
+
+    return flat_sum.load();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename F>
+void measure(char const* name, std::size_t repetitions, F && f)
+{
+    for (std::size_t i = 0; i != repetitions; ++i)
     {
         std::uint64_t t = hpx::util::high_resolution_clock::now();
 
-        hpx::future<std::int64_t> result = hpx::async(skynet, 0, 1000000, 10);
-        result.wait();
+        std::int64_t result = f();
 
         t = hpx::util::high_resolution_clock::now() - t;
 
         hpx::cout
-            << "Result 1: " << result.get() << " in "
-            << (t / 1e6) << " ms.\n";
+            << name << ": " << result << " in "
+            << (t / 1e6) << " ms.\n" << hpx::flush;
     }
+}
 
-    {
-        std::uint64_t t = hpx::util::high_resolution_clock::now();
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::int64_t const num = vm["num"].as<std::int64_t>();
+    std::int64_t const div = vm["div"].as<std::int64_t>();
+    std::size_t const repetitions = vm["repetitions"].as<std::size_t>();
+    std::string const mode = vm["mode"].as<std::string>();
 
-        hpx::future<std::int64_t> result = hpx::async(skynet_f, 0, 1000000, 10);
-        result.wait();
+    bool const all = (mode == "all");
 
-        t = hpx::util::high_resolution_clock::now() - t;
+    if (all || mode == "normal")
+    {
+        measure("Result 1", repetitions,
+            [&]()
+            {
+                return hpx::async(skynet, 0, num, div).get();
+            });
+    }
 
-        hpx::cout
-            << "Result 2: " << result.get() << " in "
-            << (t / 1e6) << " ms.\n";
+    if (all || mode == "futurized")
+    {
+        measure("Result 2", repetitions,
+            [&]()
+            {
+                hpx::future<std::int64_t> result =
+                    hpx::async(skynet_f, 0, num, div);
+                return result.get();
+            });
     }
-    return 0;
+
+    if (all || mode == "flat")
+    {
+        measure("Result 3 (flat)", repetitions,
+            [&]()
+            {
+                return hpx::async(skynet_flat, num).get();
+            });
+    }
+
+    return hpx::finalize();
 }
 
+int main(int argc, char* argv[])
+{
+    using boost::program_options::value;
+
+    boost::program_options::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ("num", value<std::int64_t>()->default_value(1000000),
+            "number of leaf tasks to create (default: 1000000)")
+        ("div", value<std::int64_t>()->default_value(10),
+            "number of children created by each task (default: 10)")
+        ("repetitions", value<std::size_t>()->default_value(1),
+            "number of times each benchmark is repeated (default: 1)")
+        ("mode", value<std::string>()->default_value("all"),
+            "benchmark to run: normal, futurized, flat, or all (default: all)")
+        ;
+
+    return hpx::init(cmdline, argc, argv);
+}
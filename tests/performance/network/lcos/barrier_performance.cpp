@@ -33,12 +33,42 @@ void global_barrier()
     }
 }
 
+void algorithm_barrier(
+    hpx::lcos::barrier_algorithm algorithm, char const* algorithm_name)
+{
+    std::string name = std::string("barrier_performance_") + algorithm_name;
+    hpx::lcos::barrier b(name, hpx::get_num_localities(hpx::launch::sync),
+        hpx::get_locality_id(), algorithm);
+
+    // the first operation resolves the participating nodes
+    b.wait();
+
+    hpx::util::high_resolution_timer t;
+    for (std::size_t i = 0; i != iterations; ++i)
+    {
+        b.wait();
+    }
+    double elapsed = t.elapsed();
+
+    if (hpx::get_locality_id() == 0)
+    {
+        std::cout << "Barrier (" << algorithm_name << "): "
+                  << elapsed/iterations << " (seconds)\n";
+    }
+}
+
 int hpx_main()
 {
     if (hpx::get_locality_id() == 0)
         startup_end = hpx::util::high_resolution_timer::now();
     global_barrier();
 
+    algorithm_barrier(hpx::lcos::barrier_algorithm::tree, "tree");
+    algorithm_barrier(
+        hpx::lcos::barrier_algorithm::dissemination, "dissemination");
+    algorithm_barrier(
+        hpx::lcos::barrier_algorithm::hierarchical, "hierarchical");
+
     if (hpx::get_locality_id() == 0)
         shutdown_start = hpx::util::high_resolution_timer::now();
     return hpx::finalize();
@@ -0,0 +1,417 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Multi-locality network benchmarks. All localities run the selected
+// benchmarks concurrently; the point to point benchmarks send to the next
+// locality (the locality itself if there is only one). Locality 0 prints the
+// results as DartMeasurements, which are collected by the network suite of
+// tools/benchmarks/hpx_benchmarks.py:
+//
+//   message_rate      one-way messages (hpx::apply) sent by many concurrent
+//                     senders [messages/s]
+//   all_to_all        every locality sends a message to every other locality
+//                     and waits for all acknowledgements [s per exchange]
+//   async_round_trip  remote hpx::async round trips, one outstanding per
+//                     sender [round trips/s, s per round trip]
+//   agas_resolve      AGAS resolve requests for remote objects, bypassing the
+//                     AGAS cache [requests/s]
+//   agas_incref       AGAS incref requests for remote objects [requests/s]
+//   coalescing        message_rate for an action using message coalescing,
+//                     its speedup over message_rate and the average number
+//                     of parcels per message [messages/s, ratio, parcels]
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/parcel_coalescing.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/runtime/agas/interface.hpp>
+#include <hpx/runtime/naming/resolver_client.hpp>
+#include <hpx/runtime/serialization/serialize_buffer.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+typedef hpx::serialization::serialize_buffer<char> buffer_type;
+
+///////////////////////////////////////////////////////////////////////////////
+// The number of messages received by this locality
+std::atomic<std::uint64_t> received_messages(0);
+
+void sink(buffer_type const&)
+{
+    ++received_messages;
+}
+HPX_PLAIN_ACTION(sink, sink_action);
+
+void coalesced_sink(buffer_type const&)
+{
+    ++received_messages;
+}
+HPX_PLAIN_ACTION(coalesced_sink, coalesced_sink_action);
+HPX_ACTION_USES_MESSAGE_COALESCING(coalesced_sink_action);
+
+std::uint64_t get_received_messages()
+{
+    return received_messages.load();
+}
+HPX_PLAIN_ACTION(get_received_messages, get_received_messages_action);
+
+void acknowledge(buffer_type const&)
+{
+}
+HPX_PLAIN_ACTION(acknowledge, acknowledge_action);
+
+// The objects whose addresses are resolved by the AGAS benchmarks
+struct benchmark_object
+  : hpx::components::component_base<benchmark_object>
+{
+};
+
+typedef hpx::components::component<benchmark_object> benchmark_object_type;
+HPX_REGISTER_COMPONENT(benchmark_object_type, benchmark_object);
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::id_type next_locality()
+{
+    std::uint32_t const here = hpx::get_locality_id();
+    std::uint32_t const num_localities =
+        hpx::get_num_localities(hpx::launch::sync);
+
+    return hpx::naming::get_id_from_locality_id((here + 1) % num_localities);
+}
+
+// Runs the given function concurrently on the given number of HPX threads,
+// returns the elapsed time in seconds.
+template <typename F>
+double run_concurrently(std::size_t senders, F const& f)
+{
+    hpx::util::high_resolution_timer t;
+
+    std::vector<hpx::future<void> > tasks;
+    tasks.reserve(senders);
+    for (std::size_t s = 0; s != senders; ++s)
+        tasks.push_back(hpx::async(f, s));
+
+    hpx::wait_all(tasks);
+
+    return t.elapsed();
+}
+
+template <typename Action>
+double send_messages(
+    std::size_t senders, std::size_t messages, std::size_t size)
+{
+    hpx::id_type const target = next_locality();
+    buffer_type const buffer(size);
+
+    // only this locality sends to the target
+    std::uint64_t const expected =
+        get_received_messages_action()(target) + senders * messages;
+
+    hpx::util::high_resolution_timer t;
+
+    run_concurrently(senders,
+        [&](std::size_t)
+        {
+            for (std::size_t m = 0; m != messages; ++m)
+                hpx::apply<Action>(target, buffer);
+        });
+
+    // the messages were sent, wait for all of them to arrive
+    while (get_received_messages_action()(target) < expected)
+        hpx::this_thread::yield();
+
+    return t.elapsed();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+double message_rate(std::size_t senders, std::size_t messages,
+    std::size_t size)
+{
+    return send_messages<sink_action>(senders, messages, size);
+}
+HPX_PLAIN_ACTION(message_rate, message_rate_action);
+
+double coalesced_message_rate(std::size_t senders, std::size_t messages,
+    std::size_t size)
+{
+    return send_messages<coalesced_sink_action>(senders, messages, size);
+}
+HPX_PLAIN_ACTION(coalesced_message_rate, coalesced_message_rate_action);
+
+double all_to_all(std::size_t iterations, std::size_t size)
+{
+    std::vector<hpx::id_type> localities = hpx::find_remote_localities();
+    if (localities.empty())
+        localities.push_back(hpx::find_here());
+
+    buffer_type const buffer(size);
+
+    hpx::util::high_resolution_timer t;
+
+    std::vector<hpx::future<void> > acks;
+    acks.reserve(localities.size());
+    for (std::size_t i = 0; i != iterations; ++i)
+    {
+        acks.clear();
+        for (hpx::id_type const& locality : localities)
+            acks.push_back(hpx::async<acknowledge_action>(locality, buffer));
+
+        hpx::wait_all(acks);
+    }
+
+    return t.elapsed() / iterations;
+}
+HPX_PLAIN_ACTION(all_to_all, all_to_all_action);
+
+double async_round_trip(std::size_t senders, std::size_t messages,
+    std::size_t size)
+{
+    hpx::id_type const target = next_locality();
+    buffer_type const buffer(size);
+
+    return run_concurrently(senders,
+        [&](std::size_t)
+        {
+            for (std::size_t m = 0; m != messages; ++m)
+                hpx::async<acknowledge_action>(target, buffer).get();
+        });
+}
+HPX_PLAIN_ACTION(async_round_trip, async_round_trip_action);
+
+// The objects are kept alive until the end of the benchmarks
+std::vector<hpx::id_type> remote_objects;
+
+std::vector<hpx::naming::gid_type> create_remote_objects(std::size_t count)
+{
+    remote_objects =
+        hpx::new_<benchmark_object[]>(next_locality(), count).get();
+
+    std::vector<hpx::naming::gid_type> gids;
+    gids.reserve(remote_objects.size());
+    for (hpx::id_type const& id : remote_objects)
+        gids.push_back(hpx::naming::detail::get_stripped_gid(id.get_gid()));
+
+    return gids;
+}
+
+double agas_resolve(std::size_t senders, std::size_t messages,
+    std::size_t objects)
+{
+    std::vector<hpx::naming::gid_type> const gids =
+        create_remote_objects(objects);
+    hpx::naming::resolver_client& agas = hpx::naming::get_agas_client();
+
+    return run_concurrently(senders,
+        [&](std::size_t s)
+        {
+            std::vector<hpx::future<hpx::naming::address> > requests;
+            requests.reserve(messages);
+            for (std::size_t m = 0; m != messages; ++m)
+            {
+                requests.push_back(agas.resolve_full_async(
+                    gids[(s * messages + m) % gids.size()]));
+            }
+            hpx::wait_all(requests);
+        });
+}
+HPX_PLAIN_ACTION(agas_resolve, agas_resolve_action);
+
+double agas_incref(std::size_t senders, std::size_t messages,
+    std::size_t objects)
+{
+    std::vector<hpx::naming::gid_type> const gids =
+        create_remote_objects(objects);
+
+    double elapsed = run_concurrently(senders,
+        [&](std::size_t s)
+        {
+            std::vector<hpx::future<std::int64_t> > requests;
+            requests.reserve(messages);
+            for (std::size_t m = 0; m != messages; ++m)
+            {
+                requests.push_back(hpx::agas::incref(
+                    gids[(s * messages + m) % gids.size()], 1));
+            }
+            hpx::wait_all(requests);
+        });
+
+    // give the credits back
+    for (std::size_t i = 0; i != senders * messages; ++i)
+        hpx::agas::decref(gids[i % gids.size()], 1);
+
+    return elapsed;
+}
+HPX_PLAIN_ACTION(agas_incref, agas_incref_action);
+
+void release_remote_objects()
+{
+    remote_objects.clear();
+}
+HPX_PLAIN_ACTION(release_remote_objects, release_remote_objects_action);
+
+///////////////////////////////////////////////////////////////////////////////
+// Runs the benchmark on all localities, returns the longest of the times
+template <typename Action, typename... Ts>
+double run_on_all_localities(Ts const&... ts)
+{
+    std::vector<hpx::future<double> > results;
+    for (hpx::id_type const& locality : hpx::find_all_localities())
+        results.push_back(hpx::async<Action>(locality, ts...));
+
+    double elapsed = 0.0;
+    for (hpx::future<double>& f : results)
+        elapsed = (std::max)(elapsed, f.get());
+    return elapsed;
+}
+
+double average_parcels_per_message()
+{
+    using namespace hpx::performance_counters;
+
+    std::vector<performance_counter> counters = discover_counters(
+        "/coalescing{locality#*/total}/count/average-parcels-per-message"
+        "@coalesced_sink_action");
+
+    // the coalescing plugin is not available
+    if (counters.empty())
+        return 0.0;
+
+    double sum = 0.0;
+    for (performance_counter const& c : counters)
+        sum += c.get_value<double>(hpx::launch::sync);
+    return sum / counters.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::string const benchmarks = vm["benchmarks"].as<std::string>();
+    std::size_t const size = vm["message-size"].as<std::size_t>();
+    std::size_t const messages = vm["messages"].as<std::size_t>();
+    std::size_t const objects = vm["objects"].as<std::size_t>();
+
+    std::size_t senders = vm["senders"].as<std::size_t>();
+    if (senders == 0)
+        senders = hpx::get_os_thread_count();
+
+    std::vector<std::string> selected;
+    boost::algorithm::split(selected, benchmarks, boost::is_any_of(","));
+
+    auto is_selected = [&](char const* name)
+    {
+        return std::find(selected.begin(), selected.end(), "all") !=
+                selected.end() ||
+            std::find(selected.begin(), selected.end(), name) !=
+                selected.end();
+    };
+
+    std::size_t const num_localities =
+        hpx::get_num_localities(hpx::launch::sync);
+    double const total = double(num_localities * senders * messages);
+
+    std::cout << "localities: " << num_localities
+              << ", senders: " << senders
+              << ", message size: " << size << std::endl;
+
+    double rate = 0.0;
+    if (is_selected("message_rate") || is_selected("coalescing"))
+    {
+        rate = total / run_on_all_localities<message_rate_action>(
+            senders, messages, size);
+        hpx::util::print_cdash_timing("MessageRate", rate);
+    }
+
+    if (is_selected("all_to_all"))
+    {
+        hpx::util::print_cdash_timing("AllToAllTime",
+            run_on_all_localities<all_to_all_action>(messages, size));
+    }
+
+    if (is_selected("async_round_trip"))
+    {
+        double elapsed = run_on_all_localities<async_round_trip_action>(
+            senders, messages, size);
+        hpx::util::print_cdash_timing("AsyncRoundTripRate", total / elapsed);
+        hpx::util::print_cdash_timing("AsyncRoundTripTime",
+            elapsed / messages);
+    }
+
+    if (is_selected("agas_resolve"))
+    {
+        hpx::util::print_cdash_timing("AGASResolveRate",
+            total / run_on_all_localities<agas_resolve_action>(
+                senders, messages, objects));
+    }
+
+    if (is_selected("agas_incref"))
+    {
+        hpx::util::print_cdash_timing("AGASIncrefRate",
+            total / run_on_all_localities<agas_incref_action>(
+                senders, messages, objects));
+    }
+
+    if (is_selected("coalescing"))
+    {
+        double coalesced_rate = total /
+            run_on_all_localities<coalesced_message_rate_action>(
+                senders, messages, size);
+        hpx::util::print_cdash_timing("CoalescedMessageRate", coalesced_rate);
+        hpx::util::print_cdash_timing("CoalescingSpeedup",
+            coalesced_rate / rate);
+        hpx::util::print_cdash_timing("CoalescingParcelsPerMessage",
+            average_parcels_per_message());
+    }
+
+    for (hpx::id_type const& locality : hpx::find_all_localities())
+        release_remote_objects_action()(locality);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    using boost::program_options::value;
+
+    boost::program_options::options_description cmdline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ("benchmarks", value<std::string>()->default_value("all"),
+         "comma separated list of the benchmarks to run (message_rate, "
+         "all_to_all, async_round_trip, agas_resolve, agas_incref, "
+         "coalescing or all)")
+        ("message-size", value<std::size_t>()->default_value(8),
+         "the size of the messages in bytes")
+        ("messages", value<std::size_t>()->default_value(10000),
+         "the number of messages (or requests) per sender, the number of "
+         "exchanges for all_to_all")
+        ("senders", value<std::size_t>()->default_value(0),
+         "the number of concurrent senders per locality (default: the "
+         "number of worker threads)")
+        ("objects", value<std::size_t>()->default_value(1000),
+         "the number of remote objects used by the AGAS benchmarks")
+        ;
+
+    // enable message coalescing
+    std::vector<std::string> const cfg = {
+        "hpx.parcel.message_handlers=1"
+    };
+
+    return hpx::init(cmdline, argc, argv, cfg);
+}
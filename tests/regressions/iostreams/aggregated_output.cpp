@@ -0,0 +1,90 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that the output of all localities reaches the console
+// in order if it is batched and forwarded through a chain of localities
+// (hpx.iostreams.arity=1).
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const num_lines = 10;
+
+std::string make_line(std::uint32_t locality_id, std::size_t i)
+{
+    std::ostringstream strm;
+    strm << "locality " << locality_id << ": line " << i << "\n";
+    return strm.str();
+}
+
+void worker()
+{
+    std::uint32_t locality_id = hpx::get_locality_id();
+
+    // these are held back by the output aggregator
+    for (std::size_t i = 0; i != num_lines - 1; ++i)
+    {
+        hpx::consolestream << make_line(locality_id, i) << hpx::async_flush;
+    }
+
+    // this sends all pending lines and waits for them to reach the console
+    hpx::consolestream << make_line(locality_id, num_lines - 1) << hpx::flush;
+}
+HPX_PLAIN_ACTION(worker, worker_action);
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<std::uint32_t> locality_ids;
+
+int hpx_main()
+{
+    std::vector<hpx::future<void> > futures;
+    for (hpx::id_type const& l : hpx::find_all_localities())
+    {
+        futures.push_back(hpx::async(worker_action(), l));
+        locality_ids.push_back(hpx::naming::get_locality_id_from_id(l));
+    }
+    hpx::wait_all(futures);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg =
+    {
+        "hpx.iostreams.arity=1",
+        "hpx.iostreams.buffer_size=65536",
+        "hpx.iostreams.flush_interval=60000"
+    };
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    // the output is complete once the runtime system has been stopped
+    std::string output = hpx::get_consolestream().str();
+    for (std::uint32_t locality_id : locality_ids)
+    {
+        // the lines of each locality appear in the order they were written
+        std::string::size_type pos = 0;
+        for (std::size_t i = 0; i != num_lines; ++i)
+        {
+            pos = output.find(make_line(locality_id, i), pos);
+            HPX_TEST(pos != std::string::npos);
+            if (pos == std::string::npos)
+                break;
+        }
+    }
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,86 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that plain actions invoked on this locality are
+// executed directly, using all launch policies.
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+int times_two(int i)
+{
+    return 2 * i;
+}
+HPX_PLAIN_ACTION(times_two, times_two_action);
+
+void throw_error()
+{
+    throw std::runtime_error("throw_error");
+}
+HPX_PLAIN_ACTION(throw_error, throw_error_action);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Policy>
+void test_local_plain_action(Policy policy)
+{
+    hpx::id_type here = hpx::find_here();
+
+    std::vector<hpx::future<int> > calls;
+    for (int i = 0; i != 100; ++i)
+    {
+        calls.push_back(hpx::async<times_two_action>(policy, here, i));
+    }
+
+    for (int i = 0; i != 100; ++i)
+    {
+        HPX_TEST_EQ(calls[i].get(), 2 * i);
+    }
+
+    bool caught_exception = false;
+    try {
+        hpx::async<throw_error_action>(policy, here).get();
+    }
+    catch (std::runtime_error const&) {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+// targets on other localities still go through the parcel layer
+void test_remote_plain_action()
+{
+    std::vector<hpx::future<int> > calls;
+    for (hpx::id_type const& id : hpx::find_remote_localities())
+    {
+        calls.push_back(hpx::async<times_two_action>(id, 21));
+    }
+
+    for (hpx::future<int>& f : calls)
+    {
+        HPX_TEST_EQ(f.get(), 42);
+    }
+}
+
+int main()
+{
+    test_local_plain_action(hpx::launch::async);
+    test_local_plain_action(hpx::launch::sync);
+    test_local_plain_action(hpx::launch::deferred);
+    test_local_plain_action(hpx::launch::fork);
+    test_local_plain_action(hpx::launch::all);
+
+    test_remote_plain_action();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,85 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/run_as.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+
+///////////////////////////////////////////////////////////////////////////////
+std::atomic<bool> executed(false);
+std::atomic<bool> executed_on_hpx_thread(false);
+
+void set_executed()
+{
+    executed_on_hpx_thread = hpx::threads::get_self_ptr() != nullptr;
+    executed = true;
+}
+
+HPX_DEFINE_PLAIN_DIRECT_ACTION(set_executed, direct_action);
+HPX_DEFINE_PLAIN_DIRECT_ACTION(set_executed, non_blocking_action);
+HPX_ACTION_IS_NON_BLOCKING(non_blocking_action);
+
+static_assert(!hpx::traits::action_is_non_blocking<direct_action>::value,
+    "direct actions are not non-blocking by default");
+static_assert(hpx::traits::action_is_non_blocking<non_blocking_action>::value,
+    "non_blocking_action should be marked as non-blocking");
+static_assert(hpx::traits::action_is_non_blocking<
+        hpx::lcos::base_lco_with_value<int>::set_value_action
+    >::value,
+    "setting the value of an LCO should be non-blocking");
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Action>
+bool apply_on_os_thread()
+{
+    executed = false;
+    hpx::id_type here = hpx::find_here();
+
+    // returns whether the action was executed before apply returned
+    return hpx::threads::run_as_os_thread(
+        [here]() -> bool
+        {
+            hpx::apply<Action>(here);
+            return executed.load();
+        }).get();
+}
+
+int main()
+{
+    // non-blocking actions are executed directly on non-HPX threads
+    HPX_TEST(apply_on_os_thread<non_blocking_action>());
+    HPX_TEST(executed);
+    HPX_TEST(!executed_on_hpx_thread);
+
+    // other direct actions are executed on a new HPX thread
+    apply_on_os_thread<direct_action>();
+    while (!executed)
+        hpx::this_thread::yield();
+    HPX_TEST(executed_on_hpx_thread);
+
+    // on HPX threads direct actions are executed directly anyways
+    executed = false;
+    hpx::apply<non_blocking_action>(hpx::find_here());
+    HPX_TEST(executed);
+    HPX_TEST(executed_on_hpx_thread);
+
+    // setting the value of an LCO works from non-HPX threads
+    hpx::lcos::promise<int> p;
+    hpx::future<int> f = p.get_future();
+    hpx::id_type id = p.get_id();
+    hpx::threads::run_as_os_thread(
+        [id]()
+        {
+            hpx::set_lco_value(id, 42);
+        }).get();
+    HPX_TEST_EQ(f.get(), 42);
+
+    return hpx::util::report_errors();
+}
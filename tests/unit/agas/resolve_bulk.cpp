@@ -0,0 +1,80 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/runtime/agas/addressing_service.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct test_server
+  : hpx::components::component_base<test_server>
+{
+};
+
+typedef hpx::components::component<test_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, test_server);
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    hpx::agas::addressing_service& agas = hpx::naming::get_agas_client();
+
+    // create some objects on all localities, interleaved
+    std::vector<hpx::id_type> ids;
+    for (int i = 0; i != 8; ++i)
+    {
+        for (hpx::id_type const& loc : hpx::find_all_localities())
+        {
+            ids.push_back(hpx::new_<test_server>(loc).get());
+        }
+    }
+
+    // resolve everything twice, the second time the cache may be used
+    for (int j = 0; j != 2; ++j)
+    {
+        std::vector<hpx::naming::address> addrs = agas.resolve_async(ids).get();
+        HPX_TEST_EQ(addrs.size(), ids.size());
+
+        for (std::size_t i = 0; i != ids.size(); ++i)
+        {
+            hpx::naming::address addr = agas.resolve_async(ids[i]).get();
+            HPX_TEST_EQ(addrs[i].locality_, addr.locality_);
+            HPX_TEST_EQ(addrs[i].type_, addr.type_);
+            HPX_TEST_EQ(addrs[i].address_, addr.address_);
+        }
+    }
+
+    // nothing to resolve
+    HPX_TEST(agas.resolve_async(std::vector<hpx::id_type>()).get().empty());
+
+    bool caught_exception = false;
+    try {
+        std::vector<hpx::id_type> invalid(1, hpx::invalid_id);
+        agas.resolve_async(invalid).get();
+        HPX_TEST(false);
+    }
+    catch (hpx::exception const&) {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
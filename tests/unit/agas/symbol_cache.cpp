@@ -0,0 +1,111 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that names registered with AGAS are still found after they were
+// cached on a different locality, and that the cached entries are dropped
+// once the names are unregistered.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/unwrap.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const test_basename = "/symbol_cache_test/";
+std::size_t const num_names = 32;
+
+std::vector<hpx::id_type> find_names()
+{
+    std::vector<hpx::future<hpx::id_type> > ids =
+        hpx::find_all_from_basename(test_basename, num_names);
+    return hpx::util::unwrap(ids);
+}
+HPX_PLAIN_ACTION(find_names, find_names_action);
+
+std::vector<hpx::id_type> resolve_names()
+{
+    std::vector<hpx::id_type> ids;
+    for (std::size_t i = 0; i != num_names; ++i)
+    {
+        std::string name(test_basename + std::to_string(i));
+        ids.push_back(hpx::agas::resolve_name(hpx::launch::sync, name));
+    }
+    return ids;
+}
+HPX_PLAIN_ACTION(resolve_names, resolve_names_action);
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_remote_localities();
+
+    // register one id for each name, the names are distributed over all
+    // localities
+    hpx::id_type here = hpx::find_here();
+    for (std::size_t i = 0; i != num_names; ++i)
+    {
+        HPX_TEST(hpx::register_with_basename(test_basename, here, i).get());
+    }
+
+    for (hpx::id_type const& locality : localities)
+    {
+        // the first lookup fills the cache, the second one uses it
+        for (int i = 0; i != 2; ++i)
+        {
+            std::vector<hpx::id_type> ids =
+                find_names_action()(locality);
+            HPX_TEST_EQ(ids.size(), num_names);
+            for (hpx::id_type const& id : ids)
+                HPX_TEST_EQ(id, here);
+
+            ids = resolve_names_action()(locality);
+            HPX_TEST_EQ(ids.size(), num_names);
+            for (hpx::id_type const& id : ids)
+                HPX_TEST_EQ(id, here);
+        }
+    }
+
+    for (std::size_t i = 0; i != num_names; ++i)
+    {
+        HPX_TEST_EQ(
+            hpx::unregister_with_basename(test_basename, i).get(), here);
+    }
+
+    // caches on other localities are invalidated asynchronously
+    for (hpx::id_type const& locality : localities)
+    {
+        bool all_invalidated = false;
+        for (int retry = 0; !all_invalidated && retry != 1000; ++retry)
+        {
+            std::vector<hpx::id_type> ids =
+                resolve_names_action()(locality);
+
+            all_invalidated = true;
+            for (hpx::id_type const& id : ids)
+            {
+                if (id != hpx::invalid_id)
+                    all_invalidated = false;
+            }
+
+            if (!all_invalidated)
+                hpx::this_thread::yield();
+        }
+        HPX_TEST(all_invalidated);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,92 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/util/generate_unique_ids.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+using hpx::naming::gid_type;
+
+///////////////////////////////////////////////////////////////////////////////
+// Blocks of ids taken from the ranges (some of them requested in advance)
+// never overlap.
+void test_id_blocks()
+{
+    hpx::util::unique_id_ranges ids;
+
+    std::size_t const block_size = 0x10000;
+    std::vector<std::pair<gid_type, gid_type> > blocks;
+
+    // this spans a couple of ranges
+    for (std::size_t i = 0; i != 128; ++i)
+    {
+        gid_type lower = ids.get_id(block_size);
+        HPX_TEST(lower != hpx::naming::invalid_gid);
+        blocks.push_back(std::make_pair(lower, lower + block_size));
+    }
+
+    // a block larger than any of the ranges
+    gid_type lower = ids.get_id(0x8000000);
+    blocks.push_back(std::make_pair(lower, lower + 0x8000000));
+
+    std::sort(blocks.begin(), blocks.end());
+    for (std::size_t i = 1; i < blocks.size(); ++i)
+    {
+        HPX_TEST(blocks[i - 1].second <= blocks[i].first);
+    }
+}
+
+// Ids handed out concurrently are unique.
+void test_concurrent_ids()
+{
+    hpx::util::unique_id_ranges ids;
+
+    std::size_t const num_tasks = 8;
+    std::size_t const num_ids = 0x30000;
+
+    std::vector<hpx::future<std::vector<gid_type> > > tasks;
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        tasks.push_back(hpx::async(
+            [&ids]()
+            {
+                std::vector<gid_type> result;
+                result.reserve(num_ids);
+                for (std::size_t j = 0; j != num_ids; ++j)
+                    result.push_back(ids.get_id());
+                return result;
+            }));
+    }
+
+    hpx::wait_all(tasks);
+
+    std::vector<gid_type> all_ids;
+    all_ids.reserve(num_tasks * num_ids);
+    for (auto& f : tasks)
+    {
+        std::vector<gid_type> task_ids = f.get();
+        all_ids.insert(all_ids.end(), task_ids.begin(), task_ids.end());
+    }
+
+    std::sort(all_ids.begin(), all_ids.end());
+    HPX_TEST(std::adjacent_find(all_ids.begin(), all_ids.end()) ==
+        all_ids.end());
+}
+
+int main()
+{
+    test_id_blocks();
+    test_concurrent_ids();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,108 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::id_type work(int delay_ms)
+{
+    hpx::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+    return hpx::find_here();
+}
+HPX_PLAIN_ACTION(work, work_action);
+
+int square(int i)
+{
+    return i * i;
+}
+HPX_PLAIN_ACTION(square, square_action);
+
+std::atomic<int> count(0);
+
+void increment()
+{
+    ++count;
+}
+HPX_PLAIN_ACTION(increment, increment_action);
+
+void throw_error()
+{
+    throw std::runtime_error("throw_error");
+}
+HPX_PLAIN_ACTION(throw_error, throw_error_action);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_results()
+{
+    using namespace hpx::parallel;
+
+    execution::distributed_stealing_executor exec;
+
+    std::vector<hpx::future<int> > results;
+    for (int i = 0; i != 100; ++i)
+        results.push_back(execution::async_execute(exec, square_action(), i));
+
+    for (int i = 0; i != 100; ++i)
+        HPX_TEST_EQ(results[i].get(), i * i);
+
+    HPX_TEST_EQ(execution::sync_execute(exec, square_action(), 7), 49);
+
+    execution::sync_execute(exec, increment_action());
+    HPX_TEST_EQ(count.load(), 1);
+
+    bool caught_exception = false;
+    try
+    {
+        execution::sync_execute(exec, throw_error_action());
+    }
+    catch (std::runtime_error const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+void test_stealing()
+{
+    using namespace hpx::parallel;
+
+    execution::distributed_stealing_executor exec;
+
+    std::vector<hpx::future<hpx::id_type> > results;
+    for (int i = 0; i != 400; ++i)
+        results.push_back(execution::async_execute(exec, work_action(), 10));
+
+    std::size_t remote = 0;
+    for (hpx::future<hpx::id_type>& f : results)
+    {
+        if (f.get() != hpx::find_here())
+            ++remote;
+    }
+
+    // the other localities were idle, they must have stolen some of the work
+    if (hpx::get_num_localities(hpx::launch::sync) > 1)
+        HPX_TEST_LT(std::size_t(0), remote);
+}
+
+int main()
+{
+    test_results();
+    test_stealing();
+
+    return hpx::util::report_errors();
+}
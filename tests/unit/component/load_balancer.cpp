@@ -0,0 +1,155 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/serialization.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct test_server
+  : hpx::components::migration_support<
+        hpx::components::component_base<test_server>
+    >
+{
+    typedef hpx::components::migration_support<
+            hpx::components::component_base<test_server>
+        > base_type;
+
+    test_server() {}
+
+    test_server(test_server const& rhs)
+      : base_type(rhs)
+    {}
+
+    test_server(test_server && rhs)
+      : base_type(std::move(rhs))
+    {}
+
+    test_server& operator=(test_server const&) { return *this; }
+    test_server& operator=(test_server &&) { return *this; }
+
+    hpx::id_type call() const
+    {
+        return hpx::find_here();
+    }
+
+    HPX_DEFINE_COMPONENT_ACTION(test_server, call, call_action);
+
+    template <typename Archive>
+    void serialize(Archive& ar, unsigned version)
+    {
+    }
+};
+
+typedef hpx::components::component<test_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, test_server);
+
+typedef test_server::call_action call_action;
+HPX_REGISTER_ACTION_DECLARATION(call_action);
+HPX_REGISTER_ACTION(call_action);
+
+typedef hpx::components::server::get_component_activity_action<test_server>
+    get_activity_action;
+
+///////////////////////////////////////////////////////////////////////////////
+// Keep the worker threads of this locality busy for the given time, the
+// threads yield to leave some room for the actions of the load balancer.
+void make_busy(std::size_t num_threads, std::int64_t milliseconds)
+{
+    auto const deadline = std::chrono::steady_clock::now() +
+        std::chrono::milliseconds(milliseconds);
+
+    for (std::size_t i = 0; i != num_threads; ++i)
+    {
+        hpx::apply(
+            [deadline]()
+            {
+                while (std::chrono::steady_clock::now() < deadline)
+                    hpx::this_thread::yield();
+            });
+    }
+}
+HPX_PLAIN_ACTION(make_busy, make_busy_action);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_activity()
+{
+    hpx::id_type id = hpx::new_<test_server>(hpx::find_here()).get();
+
+    for (int i = 0; i != 5; ++i)
+        HPX_TEST_EQ(call_action()(id), hpx::find_here());
+
+    HPX_TEST_EQ(get_activity_action()(id, id, true), std::uint64_t(5));
+    HPX_TEST_EQ(get_activity_action()(id, id, false), std::uint64_t(0));
+}
+
+void test_rebalance(hpx::id_type const& busy, bool tracked)
+{
+    hpx::components::load_balancing_parameters params;
+    params.max_migrations = 2;
+
+    hpx::components::load_balancer<test_server> balancer(params);
+
+    std::vector<hpx::id_type> ids;
+    for (int i = 0; i != 4; ++i)
+    {
+        ids.push_back(hpx::new_<test_server>(busy).get());
+        HPX_TEST_EQ(call_action()(ids.back()), busy);
+
+        balancer.track(ids.back());
+    }
+
+    if (!tracked)
+    {
+        for (hpx::id_type const& id : ids)
+            balancer.untrack(id);
+    }
+
+    make_busy_action()(busy, 1000, 3000);
+
+    std::size_t const migrated = balancer.rebalance().get();
+    if (tracked)
+    {
+        HPX_TEST_LT(std::size_t(0), migrated);
+        HPX_TEST_LTE(migrated, params.max_migrations);
+    }
+    else
+    {
+        HPX_TEST_EQ(migrated, std::size_t(0));
+    }
+
+    std::size_t moved = 0;
+    for (hpx::id_type const& id : ids)
+    {
+        if (call_action()(id) != busy)
+            ++moved;
+    }
+    HPX_TEST_EQ(moved, migrated);
+}
+
+int main()
+{
+    test_activity();
+
+    std::vector<hpx::id_type> localities = hpx::find_remote_localities();
+    if (!localities.empty())
+    {
+        test_rebalance(localities[0], true);
+        test_rebalance(localities[0], false);
+    }
+
+    return hpx::util::report_errors();
+}
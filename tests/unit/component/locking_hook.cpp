@@ -0,0 +1,145 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/local_lcos.hpp>
+#include <hpx/include/traits.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Record the number of actions running concurrently on a component
+struct concurrency
+{
+    concurrency()
+      : active_(0), max_active_(0), overlapped_writes_(false)
+    {}
+
+    // busy wait, the action must not be suspended as that releases the lock
+    void run(bool write)
+    {
+        int const active = ++active_;
+        if (write && active != 1)
+            overlapped_writes_ = true;
+
+        int max_active = max_active_.load();
+        while (max_active < active &&
+            !max_active_.compare_exchange_weak(max_active, active))
+        {
+        }
+
+        auto const start = std::chrono::steady_clock::now();
+        while (std::chrono::steady_clock::now() - start <
+            std::chrono::milliseconds(100))
+        {
+            if (!write && overlapped_writes_.load())
+                break;
+        }
+
+        if (write && active_.load() != 1)
+            overlapped_writes_ = true;
+        --active_;
+    }
+
+    std::atomic<int> active_;
+    std::atomic<int> max_active_;
+    std::atomic<bool> overlapped_writes_;
+};
+
+template <typename Mutex>
+struct test_server
+  : hpx::components::locking_hook<
+        hpx::components::component_base<test_server<Mutex> >, Mutex>
+{
+    void read() { state_.run(false); }
+    void write() { state_.run(true); }
+
+    int max_active() const { return state_.max_active_.load(); }
+    bool overlapped_writes() const { return state_.overlapped_writes_.load(); }
+
+    HPX_DEFINE_COMPONENT_ACTION(test_server, read, read_action);
+    HPX_DEFINE_COMPONENT_ACTION(test_server, write, write_action);
+
+    concurrency state_;
+};
+
+typedef test_server<hpx::lcos::local::shared_mutex> shared_server;
+typedef hpx::components::component<shared_server> shared_server_type;
+HPX_REGISTER_COMPONENT(shared_server_type, shared_server);
+
+typedef shared_server::read_action shared_read_action;
+typedef shared_server::write_action shared_write_action;
+HPX_ACTION_IS_READ_ONLY(shared_read_action);
+HPX_REGISTER_ACTION(shared_read_action);
+HPX_REGISTER_ACTION(shared_write_action);
+
+typedef test_server<hpx::lcos::local::spinlock> exclusive_server;
+typedef hpx::components::component<exclusive_server> exclusive_server_type;
+HPX_REGISTER_COMPONENT(exclusive_server_type, exclusive_server);
+
+typedef exclusive_server::read_action exclusive_read_action;
+typedef exclusive_server::write_action exclusive_write_action;
+HPX_ACTION_IS_READ_ONLY(exclusive_read_action);
+HPX_REGISTER_ACTION(exclusive_read_action);
+HPX_REGISTER_ACTION(exclusive_write_action);
+
+typedef test_server<hpx::lcos::local::no_mutex> immutable_server;
+typedef hpx::components::component<immutable_server> immutable_server_type;
+HPX_REGISTER_COMPONENT(immutable_server_type, immutable_server);
+
+typedef immutable_server::read_action immutable_read_action;
+HPX_REGISTER_ACTION(immutable_read_action);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Server, typename ReadAction, typename WriteAction>
+std::shared_ptr<Server> run_actions(int num_reads, int num_writes)
+{
+    hpx::id_type id = hpx::new_<Server>(hpx::find_here()).get();
+
+    std::vector<hpx::future<void> > results;
+    for (int i = 0; i != num_reads; ++i)
+        results.push_back(hpx::async<ReadAction>(id));
+    for (int i = 0; i != num_writes; ++i)
+        results.push_back(hpx::async<WriteAction>(id));
+    hpx::wait_all(results);
+
+    return hpx::get_ptr<Server>(id).get();
+}
+
+int main()
+{
+    // read-only actions run concurrently if the mutex supports shared locks
+    {
+        auto ptr = run_actions<shared_server,
+            shared_read_action, shared_write_action>(4, 0);
+        HPX_TEST_LT(1, ptr->max_active());
+    }
+
+    // other actions never run concurrently with any other action
+    {
+        auto ptr = run_actions<shared_server,
+            shared_read_action, shared_write_action>(4, 4);
+        HPX_TEST(!ptr->overlapped_writes());
+    }
+
+    // read-only actions are serialized if the mutex is exclusive only
+    {
+        auto ptr = run_actions<exclusive_server,
+            exclusive_read_action, exclusive_write_action>(4, 0);
+        HPX_TEST_EQ(1, ptr->max_active());
+    }
+
+    // the hook does nothing for immutable components
+    HPX_TEST(!hpx::traits::has_decorates_action<immutable_read_action>::value);
+    HPX_TEST(hpx::traits::has_decorates_action<shared_read_action>::value);
+
+    return hpx::util::report_errors();
+}
@@ -12,6 +12,7 @@
 #include <hpx/util/lightweight_test.hpp>
 
 #include <cstddef>
+#include <string>
 
 ///////////////////////////////////////////////////////////////////////////////
 struct test_server
@@ -214,10 +215,9 @@ bool test_migrate_component_from_storage(hpx::id_type const& source,
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_storage(hpx::id_type const& here, hpx::id_type const& there)
+void test_storage(hpx::id_type const& here, hpx::id_type const& there,
+    hpx::components::component_storage storage)
 {
-    // create a new storage instance
-    hpx::components::component_storage storage(here);
     HPX_TEST_NEQ(hpx::naming::invalid_id, storage.get_id());
 
     HPX_TEST(test_migrate_component_to_storage(here, storage,
@@ -233,6 +233,20 @@ void test_storage(hpx::id_type const& here, hpx::id_type const& there)
 //     HPX_TEST(test_migrate_component_from_storage(here, storage));
 }
 
+void test_storage(hpx::id_type const& here, hpx::id_type const& there)
+{
+    // create a new storage instance
+    test_storage(here, there, hpx::components::component_storage(here));
+
+#if !defined(HPX_WINDOWS)
+    // the same for a storage instance using a memory mapped file
+    std::string filename = "migrate_component_to_storage_" +
+        std::to_string(hpx::naming::get_locality_id_from_id(here)) + ".dat";
+    test_storage(here, there,
+        hpx::components::component_storage(here, filename));
+#endif
+}
+
 int main()
 {
     test_storage(hpx::find_here(), hpx::find_here());
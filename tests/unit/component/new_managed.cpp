@@ -0,0 +1,78 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that managed components created in bulk occupy a contiguous range
+// of global ids, even if there are more of them than fit into one heap.
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct test_server : hpx::components::managed_component_base<test_server>
+{
+    test_server() : value_(0) {}
+    explicit test_server(std::size_t value) : value_(value) {}
+
+    std::size_t call() const { return value_; }
+
+    HPX_DEFINE_COMPONENT_ACTION(test_server, call);
+
+    std::size_t value_;
+};
+
+typedef hpx::components::managed_component<test_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, test_server);
+
+typedef test_server::call_action call_action;
+HPX_REGISTER_ACTION(call_action);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_contiguous_ids(std::vector<hpx::id_type> const& ids)
+{
+    hpx::naming::gid_type base =
+        hpx::naming::detail::get_stripped_gid(ids[0].get_gid());
+
+    for (std::size_t i = 0; i != ids.size(); ++i)
+    {
+        HPX_TEST_EQ(hpx::naming::detail::get_stripped_gid(ids[i].get_gid()),
+            base + i);
+    }
+}
+
+void test_bulk_create(std::size_t count)
+{
+    for (hpx::id_type const& loc : hpx::find_all_localities())
+    {
+        std::vector<hpx::id_type> ids =
+            hpx::new_<test_server[]>(loc, count).get();
+        HPX_TEST_EQ(ids.size(), count);
+        test_contiguous_ids(ids);
+
+        HPX_TEST_EQ(hpx::async<call_action>(ids.front()).get(), 0u);
+        HPX_TEST_EQ(hpx::async<call_action>(ids.back()).get(), 0u);
+
+        ids = hpx::new_<test_server[]>(loc, count, count).get();
+        HPX_TEST_EQ(ids.size(), count);
+        test_contiguous_ids(ids);
+
+        HPX_TEST_EQ(hpx::async<call_action>(ids.front()).get(), count);
+        HPX_TEST_EQ(hpx::async<call_action>(ids.back()).get(), count);
+    }
+}
+
+int main()
+{
+    test_bulk_create(10);
+
+    // more components than fit into a single heap
+    test_bulk_create(10000);
+
+    return hpx::util::report_errors();
+}
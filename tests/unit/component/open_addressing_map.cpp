@@ -0,0 +1,154 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/components/containers/unordered/open_addressing_map.hpp>
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
+#include <hpx/runtime/serialization/string.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+typedef hpx::server::open_addressing_map<std::string, int> map_type;
+
+///////////////////////////////////////////////////////////////////////////////
+void compare_maps(map_type const& m, std::map<std::string, int> const& ref)
+{
+    HPX_TEST_EQ(m.size(), ref.size());
+
+    std::size_t count = 0;
+    for (map_type::value_type const& v : m)
+    {
+        std::map<std::string, int>::const_iterator it = ref.find(v.first);
+        HPX_TEST(it != ref.end());
+        if (it != ref.end())
+            HPX_TEST_EQ(v.second, it->second);
+        ++count;
+    }
+    HPX_TEST_EQ(count, ref.size());
+}
+
+// compare the table against std::map for a random sequence of operations,
+// erasing many elements leaves many deleted slots behind
+void test_operations()
+{
+    map_type m;
+    std::map<std::string, int> ref;
+
+    std::mt19937 gen(42);
+    for (int i = 0; i != 100000; ++i)
+    {
+        std::string key = std::to_string(gen() % 3000);
+        switch (gen() % 4)
+        {
+        case 0:
+            m.insert_or_assign(key, i);
+            ref[key] = i;
+            break;
+
+        case 1:
+            HPX_TEST_EQ(m.erase(key), ref.erase(key));
+            break;
+
+        case 2:
+            {
+                hpx::util::optional<int> val = m.get(key);
+                std::map<std::string, int>::iterator it = ref.find(key);
+                HPX_TEST_EQ(bool(val), it != ref.end());
+                if (val && it != ref.end())
+                    HPX_TEST_EQ(*val, it->second);
+            }
+            break;
+
+        default:
+            m.update(key, [](int& v) { v += 1; });
+            ref[key] += 1;
+            break;
+        }
+    }
+
+    compare_maps(m, ref);
+
+    // copies keep all elements reachable
+    map_type c(m);
+    compare_maps(c, ref);
+
+    std::string key = ref.begin()->first;
+    hpx::util::optional<int> val = m.take(key);
+    HPX_TEST(bool(val));
+    HPX_TEST_EQ(*val, ref.begin()->second);
+    HPX_TEST(!m.get(key));
+    HPX_TEST_EQ(m.count(key), std::size_t(0));
+    HPX_TEST_EQ(c.count(key), std::size_t(1));
+
+    m = std::move(c);
+    compare_maps(m, ref);
+
+    m.clear();
+    HPX_TEST(m.empty());
+    HPX_TEST(m.begin() == m.end());
+}
+
+void test_serialization()
+{
+    map_type m(100);
+    std::map<std::string, int> ref;
+    for (int i = 0; i != 1000; ++i)
+    {
+        m.insert_or_assign(std::to_string(i), i);
+        ref[std::to_string(i)] = i;
+    }
+
+    std::vector<char> buffer;
+    hpx::serialization::output_archive oarchive(buffer);
+    oarchive << m;
+
+    map_type loaded;
+    hpx::serialization::input_archive iarchive(buffer);
+    iarchive >> loaded;
+
+    compare_maps(loaded, ref);
+}
+
+// concurrent updates of the same elements
+void test_concurrent_updates()
+{
+    hpx::server::open_addressing_map<int, long> m;
+
+    std::size_t const count = 1000;
+    std::size_t const repetitions = 100;
+
+    hpx::parallel::for_loop(hpx::parallel::execution::par,
+        std::size_t(0), count * repetitions,
+        [&](std::size_t i)
+        {
+            m.update(int(i % count), [](long& v) { ++v; });
+        });
+
+    HPX_TEST_EQ(m.size(), count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        hpx::util::optional<long> val = m.get(int(i));
+        HPX_TEST(bool(val));
+        if (val)
+            HPX_TEST_EQ(*val, long(repetitions));
+    }
+}
+
+int main()
+{
+    test_operations();
+    test_serialization();
+    test_concurrent_updates();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,97 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/parallel_for_each.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/components/containers/partitioned_vector/partitioned_soa_vector.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the field types to be used.
+HPX_REGISTER_PARTITIONED_SOA_VECTOR_FIELD(double);
+HPX_REGISTER_PARTITIONED_SOA_VECTOR_FIELD(int);
+
+typedef hpx::partitioned_soa_vector<double, int> particles;
+
+///////////////////////////////////////////////////////////////////////////////
+struct update_particle
+{
+    template <typename Tuple>
+    void operator()(Tuple && t) const
+    {
+        hpx::util::get<0>(t) *= 2.0;
+        hpx::util::get<1>(t) += 1;
+    }
+};
+
+void test_partitioned_soa_vector(particles& v, std::size_t size)
+{
+    HPX_TEST_EQ(v.size(), size);
+    HPX_TEST_EQ(v.field<0>().size(), size);
+    HPX_TEST_EQ(v.field<1>().size(), size);
+
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        v[i] = hpx::util::make_tuple(double(i), int(i));
+    }
+
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        hpx::util::tuple<double, int> value = v[i];
+        HPX_TEST_EQ(hpx::util::get<0>(value), double(i));
+        HPX_TEST_EQ(hpx::util::get<1>(value), int(i));
+    }
+
+    // work on the local partitions of all fields at once
+    std::size_t local_size = 0;
+    for (particles::local_segment_type const& segment : v.local_segments())
+    {
+        double const* data =
+            hpx::util::get<0>(segment.begin().get_iterator_tuple());
+        HPX_TEST(reinterpret_cast<std::uintptr_t>(data) %
+            hpx::util::aligned_allocator<double>::alignment == 0);
+
+        hpx::parallel::for_each(hpx::parallel::execution::par,
+            segment.begin(), segment.end(), update_particle());
+
+        local_size += std::size_t(segment.size());
+    }
+    HPX_TEST_EQ(local_size, size);
+
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        hpx::util::tuple<double, int> value = v.get_value(hpx::launch::sync, i);
+        HPX_TEST_EQ(hpx::util::get<0>(value), 2.0 * double(i));
+        HPX_TEST_EQ(hpx::util::get<1>(value), int(i) + 1);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    // all partitions are located here
+    std::size_t const size = 1007;
+    {
+        particles v(size);
+        test_partitioned_soa_vector(v, size);
+    }
+    {
+        particles v(size, hpx::container_layout(4));
+        test_partitioned_soa_vector(v, size);
+    }
+    {
+        particles v(size, hpx::util::make_tuple(1.0, 1));
+        HPX_TEST_EQ(hpx::util::get<1>(v.get_value(size - 1).get()), 1);
+    }
+
+    return hpx::util::report_errors();
+}
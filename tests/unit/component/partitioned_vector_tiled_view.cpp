@@ -0,0 +1,193 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector_predef.hpp>
+#include <hpx/include/partitioned_vector_tiled_view.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The vector types to be used are defined in partitioned_vector module.
+// HPX_REGISTER_PARTITIONED_VECTOR(double);
+
+typedef hpx::partitioned_vector_tiled_view<double> view_type;
+
+double value(std::size_t row, std::size_t col)
+{
+    return double(row * 100 + col);
+}
+
+void fill(view_type& view)
+{
+    hpx::tiled_layout const& layout = view.get_layout();
+
+    std::vector<double> values;
+    for (std::size_t r = 0; r != layout.rows(); ++r)
+        for (std::size_t c = 0; c != layout.cols(); ++c)
+            values.push_back(value(r, c));
+
+    view.put(hpx::launch::sync, 0, 0, layout.rows(), layout.cols(), values);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_layout()
+{
+    hpx::tiled_layout layout(13, 10, 4, 3, 2, 3);
+
+    HPX_TEST_EQ(layout.num_tile_rows(), std::size_t(4));
+    HPX_TEST_EQ(layout.num_tile_cols(), std::size_t(4));
+    HPX_TEST_EQ(layout.num_tiles(), std::size_t(16));
+    HPX_TEST_EQ(layout.size(), std::size_t(16 * 12));
+
+    HPX_TEST_EQ(layout.get_tile(2, 1), std::size_t(9));
+    HPX_TEST_EQ(layout.get_owner(0, 0), std::size_t(0));
+    HPX_TEST_EQ(layout.get_owner(1, 1), std::size_t(4));
+    HPX_TEST_EQ(layout.get_owner(2, 3), std::size_t(0));
+    HPX_TEST_EQ(layout.get_owner(3, 2), std::size_t(5));
+}
+
+void test_sub_arrays(std::vector<hpx::id_type> const& localities)
+{
+    hpx::tiled_layout layout(13, 10, 4, 3, localities.size(), 1);
+    hpx::partitioned_vector<double> v(
+        layout.size(), layout.get_policy(localities));
+
+    view_type view(v, layout);
+    fill(view);
+
+    // sub-arrays crossing the borders of the tiles
+    std::vector<double> values = view.get(hpx::launch::sync, 3, 2, 7, 5);
+    HPX_TEST_EQ(values.size(), std::size_t(35));
+    for (std::size_t r = 0; r != 7; ++r)
+        for (std::size_t c = 0; c != 5; ++c)
+            HPX_TEST_EQ(values[r * 5 + c], value(r + 3, c + 2));
+
+    values = view.get(hpx::launch::sync, 12, 9, 1, 1);
+    HPX_TEST_EQ(values.size(), std::size_t(1));
+    HPX_TEST_EQ(values[0], value(12, 9));
+
+    view.put(hpx::launch::sync, 1, 1, 2, 3, {-1, -2, -3, -4, -5, -6});
+    values = view.get(hpx::launch::sync, 0, 0, 4, 5);
+    for (std::size_t r = 0; r != 4; ++r)
+    {
+        for (std::size_t c = 0; c != 5; ++c)
+        {
+            if (r >= 1 && r < 3 && c >= 1 && c < 4)
+            {
+                HPX_TEST_EQ(values[r * 5 + c],
+                    -double((r - 1) * 3 + (c - 1) + 1));
+            }
+            else
+            {
+                HPX_TEST_EQ(values[r * 5 + c], value(r, c));
+            }
+        }
+    }
+
+    // sub-arrays have to be inside the matrix
+    bool caught_exception = false;
+    try {
+        view.get(hpx::launch::sync, 10, 0, 4, 1);
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::bad_parameter);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+void test_tiles(std::vector<hpx::id_type> const& localities)
+{
+    hpx::tiled_layout layout(13, 10, 4, 3, 1, localities.size());
+    hpx::partitioned_vector<double> v(
+        layout.size(), layout.get_policy(localities));
+
+    view_type view(v, layout);
+    fill(view);
+
+    // the matrix is transposed tile by tile, each tile is moved with one
+    // message
+    hpx::tiled_layout transposed_layout(10, 13, 3, 4, localities.size(), 1);
+    hpx::partitioned_vector<double> t(transposed_layout.size(),
+        transposed_layout.get_policy(localities));
+
+    view_type transposed(t, transposed_layout);
+    for (std::size_t ti = 0; ti != layout.num_tile_rows(); ++ti)
+    {
+        for (std::size_t tj = 0; tj != layout.num_tile_cols(); ++tj)
+        {
+            std::vector<double> tile = view.get_tile(hpx::launch::sync, ti, tj);
+            HPX_TEST_EQ(tile.size(), layout.tile_size());
+
+            std::vector<double> result(tile.size());
+            for (std::size_t i = 0; i != layout.tile_rows(); ++i)
+            {
+                for (std::size_t j = 0; j != layout.tile_cols(); ++j)
+                {
+                    result[j * layout.tile_rows() + i] =
+                        tile[i * layout.tile_cols() + j];
+                }
+            }
+            transposed.put_tile(hpx::launch::sync, tj, ti, std::move(result));
+        }
+    }
+
+    std::vector<double> values = transposed.get(hpx::launch::sync, 0, 0,
+        transposed_layout.rows(), transposed_layout.cols());
+    for (std::size_t r = 0; r != transposed_layout.rows(); ++r)
+    {
+        for (std::size_t c = 0; c != transposed_layout.cols(); ++c)
+            HPX_TEST_EQ(values[r * transposed_layout.cols() + c], value(c, r));
+    }
+
+    // visit the local elements in blocks
+    std::size_t count = 0;
+    view.for_each_local(
+        [&](std::size_t row, std::size_t col, double& element)
+        {
+            HPX_TEST_EQ(element, value(row, col));
+            element = -element;
+            ++count;
+        }, 2, 2);
+
+    std::size_t expected = 0;
+    for (std::size_t ti = 0; ti != layout.num_tile_rows(); ++ti)
+    {
+        for (std::size_t tj = 0; tj != layout.num_tile_cols(); ++tj)
+        {
+            if (!view.is_local_tile(ti, tj))
+                continue;
+
+            std::size_t rows = (std::min)(layout.tile_rows(),
+                layout.rows() - ti * layout.tile_rows());
+            std::size_t cols = (std::min)(layout.tile_cols(),
+                layout.cols() - tj * layout.tile_cols());
+            expected += rows * cols;
+
+            std::vector<double> const& tile = view.local_tile(ti, tj);
+            HPX_TEST_EQ(tile[0],
+                -value(ti * layout.tile_rows(), tj * layout.tile_cols()));
+        }
+    }
+    HPX_TEST_EQ(count, expected);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    test_layout();
+    test_sub_arrays(localities);
+    test_tiles(localities);
+
+    return hpx::util::report_errors();
+}
@@ -75,6 +75,56 @@ void fill_unordered_map(hpx::unordered_map<Key, Value, Hash, KeyEqual>& m,
     HPX_TEST(m.size() == count);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+void bulk_tests(hpx::unordered_map<Key, Value, Hash, KeyEqual>& m,
+    std::size_t count)
+{
+    std::vector<Key> keys;
+    std::vector<Value> values;
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        keys.push_back(std::to_string(i));
+        values.push_back(Value(i));
+    }
+
+    m.insert_bulk(hpx::launch::sync, keys, values);
+    HPX_TEST_EQ(m.size(), count);
+
+    // the keys in reverse order, with one missing key
+    std::vector<Key> find_keys(keys.rbegin(), keys.rend());
+    find_keys.push_back(std::to_string(count));
+
+    std::vector<hpx::util::optional<Value> > found =
+        m.find_bulk(hpx::launch::sync, find_keys);
+    HPX_TEST_EQ(found.size(), count + 1);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        HPX_TEST(bool(found[i]));
+        HPX_TEST_EQ(*found[i], Value(count - 1 - i));
+    }
+    HPX_TEST(!found[count]);
+
+    // repeated updates of the same keys are combined
+    std::vector<Key> update_keys;
+    std::vector<Value> deltas;
+    for (std::size_t j = 0; j != 3; ++j)
+    {
+        for (std::size_t i = 0; i != count + 1; ++i)
+        {
+            update_keys.push_back(std::to_string(i));
+            deltas.push_back(Value(1));
+        }
+    }
+
+    m.update_bulk(hpx::launch::sync, update_keys, deltas);
+    HPX_TEST_EQ(m.size(), count + 1);
+
+    for (std::size_t i = 0; i != count; ++i)
+        HPX_TEST_EQ(m[std::to_string(i)], Value(i + 3));
+    HPX_TEST_EQ(m[std::to_string(count)], Value(3));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 template <typename Key, typename Value, typename DistPolicy>
 void trivial_tests(DistPolicy const& policy)
@@ -88,6 +138,12 @@ void trivial_tests(DistPolicy const& policy)
         test_global_iteration(m, Value(42));
     }
 
+    // bulk operations
+    {
+        hpx::unordered_map<Key, Value> m(17, policy);
+        bulk_tests(m, 107);
+    }
+
     // bucket_count, hash
     {
         hpx::unordered_map<Key, Value> m(17, std::hash<std::string>(),
@@ -120,6 +176,12 @@ void trivial_tests()
         test_global_iteration(m, Value(42));
     }
 
+    // bulk operations
+    {
+        hpx::unordered_map<Key, Value> m;
+        bulk_tests(m, 107);
+    }
+
     // bucket_count
     {
         hpx::unordered_map<Key, Value> m(17);
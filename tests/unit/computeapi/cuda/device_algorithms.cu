@@ -0,0 +1,186 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+///////////////////////////////////////////////////////////////////////////////
+
+#include <hpx/include/compute.hpp>
+#include <hpx/include/parallel_copy.hpp>
+#include <hpx/include/parallel_reduce.hpp>
+#include <hpx/include/parallel_scan.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/include/parallel_transform_reduce.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <hpx/hpx_init.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+typedef hpx::compute::cuda::default_executor executor_type;
+typedef hpx::compute::cuda::allocator<int> target_allocator;
+typedef hpx::compute::vector<int, target_allocator> target_vector;
+
+struct plus
+{
+    template <typename T>
+    HPX_HOST_DEVICE T operator()(T const& a, T const& b) const
+    {
+        return a + b;
+    }
+};
+
+struct square
+{
+    HPX_HOST_DEVICE long long operator()(int a) const
+    {
+        return (long long)a * a;
+    }
+};
+
+struct negate
+{
+    HPX_HOST_DEVICE int operator()(int a) const
+    {
+        return -a;
+    }
+};
+
+std::vector<int> copy_to_host(target_vector const& d)
+{
+    std::vector<int> h(d.size());
+    hpx::parallel::copy(hpx::parallel::execution::par,
+        d.begin(), d.end(), h.begin());
+    return h;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_reduce(executor_type& exec, target_vector& d,
+    std::vector<int> const& h)
+{
+    using namespace hpx::parallel;
+
+    int r1 = reduce(execution::par.on(exec), d.begin(), d.end(), 42, plus());
+    HPX_TEST_EQ(r1, std::accumulate(h.begin(), h.end(), 42));
+
+    hpx::future<int> f = reduce(execution::par(execution::task).on(exec),
+        d.begin(), d.end(), 0, plus());
+    HPX_TEST_EQ(f.get(), std::accumulate(h.begin(), h.end(), 0));
+
+    long long r2 = transform_reduce(execution::par.on(exec),
+        d.begin(), d.end(), 0ll, plus(), square());
+
+    long long ref = 0;
+    for (int v : h)
+        ref += (long long)v * v;
+    HPX_TEST_EQ(r2, ref);
+}
+
+void test_inclusive_scan(executor_type& exec, target_vector& d,
+    std::vector<int> const& h)
+{
+    using namespace hpx::parallel;
+
+    target_vector d_dest(d.size(), d.get_allocator());
+    auto end = inclusive_scan(execution::par.on(exec),
+        d.begin(), d.end(), d_dest.begin(), 3, plus());
+    HPX_TEST(end == d_dest.end());
+
+    std::vector<int> ref(h.size());
+    int sum = 3;
+    for (std::size_t i = 0; i != h.size(); ++i)
+    {
+        sum += h[i];
+        ref[i] = sum;
+    }
+    HPX_TEST(copy_to_host(d_dest) == ref);
+
+    auto f = inclusive_scan(execution::par(execution::task).on(exec),
+        d.begin(), d.end(), d_dest.begin(), 0, plus());
+    HPX_TEST(f.get() == d_dest.end());
+
+    std::partial_sum(h.begin(), h.end(), ref.begin());
+    HPX_TEST(copy_to_host(d_dest) == ref);
+}
+
+void test_sort(executor_type& exec, target_vector& d,
+    std::vector<int> const& h)
+{
+    using namespace hpx::parallel;
+
+    std::vector<int> ref(h);
+    std::sort(ref.begin(), ref.end());
+
+    auto end = sort(execution::par.on(exec), d.begin(), d.end());
+    HPX_TEST(end == d.end());
+    HPX_TEST(copy_to_host(d) == ref);
+
+    // sort descending by projecting onto the negated value
+    hpx::future<target_vector::iterator> f =
+        sort(execution::par(execution::task).on(exec), d.begin(), d.end(),
+            std::less<int>(), negate());
+    f.get();
+
+    std::reverse(ref.begin(), ref.end());
+    HPX_TEST(copy_to_host(d) == ref);
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::random_device{}();
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> dis(-10007, 10007);
+
+    hpx::compute::cuda::target target;
+    target_allocator alloc(target);
+    executor_type exec(target);
+
+    // cover a single tile as well as many tiles
+    for (std::size_t N : {std::size_t(1), std::size_t(100),
+             std::size_t(1000003)})
+    {
+        std::vector<int> h(N);
+        std::generate(h.begin(), h.end(), [&]() { return dis(gen); });
+
+        target_vector d(N, alloc);
+        hpx::parallel::copy(hpx::parallel::execution::par,
+            h.begin(), h.end(), d.begin());
+
+        test_reduce(exec, d, h);
+        test_inclusive_scan(exec, d, h);
+        test_sort(exec, d, h);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // Initialize and run HPX
+    hpx::init(desc_commandline, argc, argv);
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,153 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <hpx/include/compute.hpp>
+
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <cuda_runtime.h>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::compute::cuda::multi_stream_executor executor;
+typedef hpx::compute::cuda::allocator<int> allocator_type;
+typedef hpx::compute::vector<int, allocator_type> vector_type;
+
+std::size_t const count = 107;
+
+std::vector<int> copy_to_host(vector_type const& v)
+{
+    std::vector<int> result(v.size());
+    cudaMemcpy(result.data(), v.data().device_ptr(), v.size() * sizeof(int),
+        cudaMemcpyDeviceToHost);
+    return result;
+}
+
+struct set_value
+{
+    HPX_HOST_DEVICE void operator()(int* p, int value) const
+    {
+        *p = value;
+    }
+};
+
+struct add_value
+{
+    HPX_HOST_DEVICE void operator()(int* p, int value) const
+    {
+        *p += value;
+    }
+};
+
+void test_async(executor& exec)
+{
+    hpx::compute::cuda::target target;
+    vector_type v(exec.num_streams(), allocator_type(target));
+
+    std::vector<hpx::future<void> > futures;
+    for (std::size_t i = 0; i != exec.num_streams(); ++i)
+    {
+        futures.push_back(hpx::parallel::execution::async_execute(exec,
+            set_value(), v.data().device_ptr() + i, int(i)));
+    }
+    hpx::when_all(futures).get();
+
+    std::vector<int> expected(exec.num_streams());
+    std::iota(expected.begin(), expected.end(), 0);
+    HPX_TEST(copy_to_host(v) == expected);
+}
+
+void test_async_after(executor& exec)
+{
+    hpx::compute::cuda::target target;
+    vector_type v(1, allocator_type(target));
+    int* p = v.data().device_ptr();
+
+    // the kernels are launched on different streams and have to be ordered
+    hpx::future<void> f = exec.async_execute(set_value(), p, 1);
+    for (int i = 0; i != 10; ++i)
+        f = exec.async_execute_after(std::move(f), add_value(), p, 1);
+    f.get();
+
+    HPX_TEST_EQ(copy_to_host(v)[0], 11);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+struct bulk_test
+{
+    HPX_HOST_DEVICE void operator()(int i, int* p) const
+    {
+        p[i] = i;
+    }
+};
+
+void test_bulk_sync(executor& exec)
+{
+    hpx::compute::cuda::target target;
+    vector_type v(count, allocator_type(target));
+
+    std::vector<int> shape(count);
+    std::iota(shape.begin(), shape.end(), 0);
+
+    hpx::parallel::execution::bulk_sync_execute(exec, bulk_test(), shape,
+        v.data().device_ptr());
+
+    HPX_TEST(copy_to_host(v) == shape);
+}
+
+void test_bulk_async(executor& exec)
+{
+    hpx::compute::cuda::target target;
+    vector_type v(count, allocator_type(target));
+
+    std::vector<int> shape(count);
+    std::iota(shape.begin(), shape.end(), 0);
+
+    std::vector<hpx::future<void> > futures =
+        hpx::parallel::execution::bulk_async_execute(exec, bulk_test(), shape,
+            v.data().device_ptr());
+
+    // one kernel is launched per stream
+    HPX_TEST_EQ(futures.size(), exec.num_streams());
+    hpx::when_all(futures).get();
+
+    HPX_TEST(copy_to_host(v) == shape);
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    hpx::compute::cuda::target target;
+    executor exec(target, 4);
+    HPX_TEST_EQ(exec.num_streams(), std::size_t(4));
+
+    test_async(exec);
+    test_async_after(exec);
+    test_bulk_sync(exec);
+    test_bulk_async(exec);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // complete the futures by polling the events, this allows to track the
+    // dependencies between the kernels on the device
+    std::vector<std::string> const cfg = {
+        "hpx.cuda.event_polling=1"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,88 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/compute.hpp>
+#include <hpx/include/parallel_copy.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <hpx/compute/cuda/pinned_buffer_pool.hpp>
+
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <vector>
+
+typedef hpx::compute::cuda::allocator<int> target_allocator;
+typedef hpx::compute::vector<int, target_allocator> target_vector;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_pinned_buffer()
+{
+    hpx::compute::cuda::pinned_buffer buffer(100000);
+    HPX_TEST(buffer.data() != nullptr);
+    HPX_TEST(buffer.size() >= std::size_t(100000));
+    HPX_TEST(hpx::compute::cuda::detail::is_pinned(buffer.data()));
+
+    // released buffers are reused
+    void* data = buffer.data();
+    buffer.reset();
+    hpx::compute::cuda::pinned_buffer reused(100000);
+    HPX_TEST_EQ(reused.data(), data);
+
+    std::vector<int> pageable(10);
+    HPX_TEST(!hpx::compute::cuda::detail::is_pinned(pageable.data()));
+}
+
+// copy vectors which are staged through a number of chunks
+template <typename Allocator>
+void test_copy(hpx::compute::cuda::target const& target, std::size_t size)
+{
+    std::vector<int, Allocator> h_A(size);
+    std::iota(h_A.begin(), h_A.end(), 42);
+
+    target_vector d_A(size, target_allocator(target));
+    hpx::parallel::copy(hpx::parallel::execution::par,
+        h_A.begin(), h_A.end(), d_A.begin());
+
+    std::vector<int, Allocator> h_B(size);
+    hpx::parallel::copy(hpx::parallel::execution::par,
+        d_A.begin(), d_A.end(), h_B.begin());
+
+    HPX_TEST(h_A == h_B);
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    hpx::compute::cuda::target target;
+
+    test_pinned_buffer();
+
+    // below the staging threshold, a single chunk, a multiple of the chunk
+    // size and a partial last chunk
+    test_copy<std::allocator<int> >(target, 1000);
+    test_copy<std::allocator<int> >(target, 100000);
+    test_copy<std::allocator<int> >(target, 1 << 20);
+    test_copy<std::allocator<int> >(target, (1 << 20) + 12345);
+
+    // pinned host memory is not staged
+    test_copy<hpx::compute::cuda::pinned_allocator<int> >(target, 1 << 20);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // use small chunks to exercise the double buffering
+    std::vector<std::string> const cfg = {
+        "hpx.cuda.staging_threshold=65536",
+        "hpx.cuda.staging_chunk_size=262144"
+    };
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,112 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/compute.hpp>
+#include <hpx/include/parallel_copy.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <hpx/compute/serialization/vector.hpp>
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
+#include <hpx/runtime/serialization/serialization_chunk.hpp>
+
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+typedef hpx::compute::cuda::allocator<int> target_allocator;
+typedef hpx::compute::vector<int, target_allocator> target_vector;
+
+///////////////////////////////////////////////////////////////////////////////
+target_vector make_vector(hpx::compute::cuda::target const& target,
+    std::size_t size)
+{
+    std::vector<int> h(size);
+    std::iota(h.begin(), h.end(), 42);
+
+    target_vector v(size, target_allocator(target));
+    hpx::parallel::copy(hpx::parallel::execution::par,
+        h.begin(), h.end(), v.begin());
+    return v;
+}
+
+std::vector<int> copy_to_host(target_vector const& v)
+{
+    std::vector<int> h(v.size());
+    hpx::parallel::copy(hpx::parallel::execution::par,
+        v.begin(), v.end(), h.begin());
+    return h;
+}
+
+// the device data is copied through the host
+void test_roundtrip(hpx::compute::cuda::target const& target,
+    std::size_t size)
+{
+    target_vector out = make_vector(target, size);
+
+    std::vector<char> buffer;
+    std::vector<hpx::serialization::serialization_chunk> chunks;
+    {
+        hpx::serialization::output_archive oarchive(buffer, 0, &chunks);
+        oarchive << out;
+    }
+
+    target_vector in(0, target_allocator(target));
+    {
+        hpx::serialization::input_archive iarchive(buffer, buffer.size(),
+            &chunks);
+        iarchive >> in;
+    }
+
+    HPX_TEST_EQ(in.size(), out.size());
+    HPX_TEST(copy_to_host(in) == copy_to_host(out));
+}
+
+// large buffers are referred to by a chunk pointing to the device memory
+void test_device_chunk(hpx::compute::cuda::target const& target)
+{
+    std::size_t const size = HPX_ZERO_COPY_SERIALIZATION_THRESHOLD;
+    target_vector out = make_vector(target, size);
+
+    std::vector<char> buffer;
+    std::vector<hpx::serialization::serialization_chunk> chunks;
+    {
+        hpx::serialization::output_archive oarchive(buffer,
+            hpx::serialization::enable_device_memory_chunks, &chunks);
+        oarchive << out;
+    }
+
+    bool found = false;
+    for (auto const& c : chunks)
+    {
+        if (c.type_ == hpx::serialization::chunk_type_pointer &&
+            c.data_.cpos_ == out.device_data())
+        {
+            HPX_TEST_EQ(c.size_, size * sizeof(int));
+            found = true;
+        }
+    }
+    HPX_TEST(found);
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    hpx::compute::cuda::target target;
+
+    test_roundtrip(target, 10);
+    test_roundtrip(target, 100000);
+    test_device_chunk(target);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
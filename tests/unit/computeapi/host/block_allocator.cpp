@@ -53,6 +53,24 @@ void test_bulk_allocator(std::size_t count)
     test_block_deallocation(alloc, p, count);
 }
 
+template <typename T>
+void test_bulk_allocator(std::size_t count,
+    hpx::compute::host::huge_pages pages,
+    hpx::compute::host::memory_placement placement)
+{
+    hpx::compute::host::block_allocator<T> alloc(
+        hpx::compute::host::numa_domains(), pages, placement);
+    HPX_TEST(alloc.pages() == pages);
+    HPX_TEST(alloc.placement() == placement);
+
+    T* p = test_block_allocation(alloc, count);
+    test_block_construction(alloc, p, count);
+    for (std::size_t i = 0; i != count; ++i)
+        HPX_TEST_EQ(p[i], T());
+    test_block_destruction(alloc, p, count);
+    test_block_deallocation(alloc, p, count);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 std::atomic<std::size_t> construction_count(0);
 std::atomic<std::size_t> destruction_count(0);
@@ -94,6 +112,22 @@ int hpx_main(boost::program_options::variables_map& vm)
 
     test_bulk_allocator<int>(0);
 
+    {
+        using hpx::compute::host::huge_pages;
+        using hpx::compute::host::memory_placement;
+
+        huge_pages const pages[] = {
+            huge_pages::none, huge_pages::transparent,
+            huge_pages::explicit_2m, huge_pages::explicit_1g
+        };
+        for (huge_pages p : pages)
+        {
+            std::size_t count = dis(gen);
+            test_bulk_allocator<int>(count, p, memory_placement::first_touch);
+            test_bulk_allocator<int>(count, p, memory_placement::interleave);
+        }
+    }
+
     return hpx::finalize();
 }
 
@@ -0,0 +1,103 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/compute.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_replicated_vector(std::vector<hpx::compute::host::target> const& t)
+{
+    std::vector<double> values(10007);
+    std::iota(values.begin(), values.end(), 1.0);
+
+    hpx::compute::host::replicated_vector<double> v(
+        values.begin(), values.end(), t);
+
+    HPX_TEST_EQ(v.size(), values.size());
+    HPX_TEST_EQ(v.num_replicas(), t.size());
+    HPX_TEST(!v.empty());
+
+    // all replicas hold a copy of the values
+    for (std::size_t r = 0; r != v.num_replicas(); ++r)
+    {
+        double const* data = v.data(r);
+        for (std::size_t i = 0; i != values.size(); ++i)
+        {
+            HPX_TEST_EQ(data[i], values[i]);
+        }
+    }
+
+    // the replicas are distinct copies
+    if (v.num_replicas() > 1)
+    {
+        HPX_TEST(v.data(0) != v.data(1));
+    }
+
+    // all workers access a copy holding the values
+    std::atomic<std::size_t> errors(0);
+    hpx::parallel::for_loop(hpx::parallel::execution::par,
+        std::size_t(0), values.size(),
+        [&](std::size_t i)
+        {
+            HPX_TEST(v.local_replica() < v.num_replicas());
+            if (v[i] != values[i])
+                ++errors;
+        });
+    HPX_TEST_EQ(errors.load(), std::size_t(0));
+
+    HPX_TEST(std::equal(v.begin(), v.end(), values.begin()));
+}
+
+void test_replicated_vector_move()
+{
+    std::vector<int> values(107, 42);
+
+    hpx::compute::host::replicated_vector<int> v(values);
+    hpx::compute::host::replicated_vector<int> w;
+    HPX_TEST(w.empty());
+
+    w = std::move(v);
+    HPX_TEST_EQ(w.size(), values.size());
+    HPX_TEST(std::equal(w.begin(), w.end(), values.begin()));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    auto numa_nodes = hpx::compute::host::numa_domains();
+
+    test_replicated_vector(numa_nodes);
+
+    // more than one replica per domain is allowed as well
+    std::vector<hpx::compute::host::target> targets(numa_nodes);
+    targets.insert(targets.end(), numa_nodes.begin(), numa_nodes.end());
+    test_replicated_vector(targets);
+
+    test_replicated_vector_move();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
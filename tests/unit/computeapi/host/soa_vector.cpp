@@ -0,0 +1,117 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/compute.hpp>
+#include <hpx/include/parallel_for_each.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#if defined(HPX_HAVE_DATAPAR)
+#include <hpx/include/datapar.hpp>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+typedef hpx::compute::soa_vector<double, float, int> particles;
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+bool is_aligned(T const* p)
+{
+    return reinterpret_cast<std::uintptr_t>(p) %
+        hpx::util::aligned_allocator<T>::alignment == 0;
+}
+
+void test_soa_vector_basics()
+{
+    particles v(1007, hpx::util::make_tuple(1.0, 2.0f, 3));
+    HPX_TEST_EQ(v.size(), std::size_t(1007));
+    HPX_TEST(is_aligned(v.data<0>()));
+    HPX_TEST(is_aligned(v.data<1>()));
+    HPX_TEST(is_aligned(v.data<2>()));
+
+    // the elements are accessed through tuples of references
+    hpx::util::get<0>(v[5]) = 42.0;
+    HPX_TEST_EQ(v.data<0>()[5], 42.0);
+
+    v[6] = hpx::util::make_tuple(7.0, 8.0f, 9);
+    HPX_TEST_EQ(v.data<0>()[6], 7.0);
+    HPX_TEST_EQ(v.data<1>()[6], 8.0f);
+    HPX_TEST_EQ(v.data<2>()[6], 9);
+
+    for (int i = 0; i != 100; ++i)
+        v.push_back(hpx::util::make_tuple(double(i), float(i), i));
+    HPX_TEST_EQ(v.size(), std::size_t(1107));
+    HPX_TEST(v.capacity() >= v.size());
+    HPX_TEST_EQ(hpx::util::get<2>(v.back()), 99);
+    HPX_TEST(is_aligned(v.data<0>()));
+
+    particles w(v);
+    HPX_TEST(w == v);
+
+    w.pop_back();
+    HPX_TEST_EQ(w.size(), std::size_t(1106));
+    HPX_TEST(w != v);
+
+    w.clear();
+    HPX_TEST(w.empty());
+    HPX_TEST(w.begin() == w.end());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+struct move_particle
+{
+    template <typename Tuple>
+    void operator()(Tuple && t) const
+    {
+        hpx::util::get<0>(t) += hpx::util::get<1>(t);
+        hpx::util::get<2>(t) = 1.0;
+    }
+};
+
+// the vector packs of all fields hold the same number of elements
+typedef hpx::compute::soa_vector<double, double, double> positions;
+
+template <typename ExPolicy>
+void test_soa_vector_for_each(ExPolicy && policy)
+{
+    positions v(10007, hpx::util::make_tuple(1.0, 2.0, 0.0));
+
+    hpx::parallel::for_each(policy, v.begin(), v.end(), move_particle());
+
+    for (std::size_t i = 0; i != v.size(); ++i)
+    {
+        HPX_TEST_EQ(v.data<0>()[i], 3.0);
+        HPX_TEST_EQ(v.data<2>()[i], 1.0);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_soa_vector_basics();
+
+    test_soa_vector_for_each(hpx::parallel::execution::seq);
+    test_soa_vector_for_each(hpx::parallel::execution::par);
+#if defined(HPX_HAVE_DATAPAR)
+    test_soa_vector_for_each(hpx::parallel::execution::datapar);
+#endif
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,92 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that a chain of continuations started without an LCO
+// delivers the result to the last action of the chain only.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/apply.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstdint>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::int32_t increment(std::int32_t i)
+{
+    return i + 1;
+}
+HPX_PLAIN_ACTION(increment);  // defines increment_action
+
+std::int32_t mult2(std::int32_t i)
+{
+    return i * 2;
+}
+HPX_PLAIN_ACTION(mult2);      // defines mult2_action
+
+// the final consumer of the results, runs on the root locality
+hpx::lcos::local::promise<std::int32_t> result;
+
+void consume(std::int32_t i)
+{
+    result.set_value(i);
+}
+HPX_PLAIN_ACTION(consume);    // defines consume_action
+
+std::int32_t get_result()
+{
+    std::int32_t value = result.get_future().get();
+    result = hpx::lcos::local::promise<std::int32_t>();
+    return value;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_chain(hpx::id_type const& there)
+{
+    using hpx::make_continuation;
+
+    increment_action inc;
+    mult2_action mult;
+    consume_action cons;
+
+    hpx::id_type here = hpx::find_here();
+
+    hpx::apply_continue(inc, make_continuation(cons, here), there, 42);
+    HPX_TEST_EQ(get_result(), 43);
+
+    hpx::apply_continue(inc,
+        make_continuation(mult, there, make_continuation(cons, here)),
+        there, 42);
+    HPX_TEST_EQ(get_result(), 86);
+
+    hpx::apply_continue(inc,
+        make_continuation(mult, there,
+            make_continuation(inc, there, make_continuation(cons, here))),
+        there, 42);
+    HPX_TEST_EQ(get_result(), 87);
+}
+
+int hpx_main()
+{
+    test_chain(hpx::find_here());
+
+    for (hpx::id_type const& id : hpx::find_remote_localities())
+    {
+        test_chain(id);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,95 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that hpx::launch::work_first runs the new thread before
+// the calling thread continues and that the calling thread is resumed (or
+// stolen) afterwards.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::uint64_t fib(std::uint64_t n)
+{
+    if (n < 2)
+        return n;
+
+    hpx::future<std::uint64_t> lhs =
+        hpx::async(hpx::launch::work_first, &fib, n - 1);
+    std::uint64_t rhs = fib(n - 2);
+    return lhs.get() + rhs;
+}
+
+void test_child_first()
+{
+    // the child runs to completion before the parent continues
+    for (int i = 0; i != 100; ++i)
+    {
+        bool ran = false;
+        hpx::future<void> f =
+            hpx::async(hpx::launch::work_first, [&ran]() { ran = true; });
+        HPX_TEST(ran);
+        HPX_TEST(f.is_ready());
+        f.get();
+    }
+
+    // threads which suspend hand back control to the parent
+    hpx::lcos::local::promise<void> p;
+    hpx::shared_future<void> sf = p.get_future();
+    std::atomic<bool> started(false);
+    hpx::future<void> f = hpx::async(hpx::launch::work_first,
+        [&started, sf]()
+        {
+            started = true;
+            sf.get();
+        });
+    HPX_TEST(started.load());
+    HPX_TEST(!f.is_ready());
+    p.set_value();
+    f.get();
+}
+
+void test_executor()
+{
+    hpx::parallel::execution::parallel_policy_executor<
+            hpx::launch::work_first_policy> exec;
+
+    bool ran = false;
+    hpx::parallel::execution::post(exec, [&ran]() { ran = true; });
+    HPX_TEST(ran);
+
+    HPX_TEST_EQ(hpx::parallel::execution::async_execute(
+        exec, [](int i) { return i + 1; }, 41).get(), 42);
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_child_first();
+    test_executor();
+
+    HPX_TEST_EQ(fib(20), std::uint64_t(6765));
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // with a single worker thread nobody can steal the parent, the child
+    // has to run before the parent continues
+    std::vector<std::string> const cfg = { "hpx.os_threads=1" };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+
+    return hpx::util::report_errors();
+}
@@ -17,9 +17,10 @@
 #include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
-void barrier_test(std::size_t num, std::size_t rank, std::atomic<std::size_t>& c)
+void barrier_test(std::size_t num, std::size_t rank,
+    hpx::lcos::barrier_algorithm algorithm, std::atomic<std::size_t>& c)
 {
-    hpx::lcos::barrier b("local_barrier_test", num, rank);
+    hpx::lcos::barrier b("local_barrier_test", num, rank, algorithm);
     ++c;
 
     // wait for all threads to enter the barrier
@@ -27,7 +28,8 @@ void barrier_test(std::size_t num, std::size_t rank, std::atomic<std::size_t>& c
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void local_tests(boost::program_options::variables_map& vm)
+void local_tests(boost::program_options::variables_map& vm,
+    hpx::lcos::barrier_algorithm algorithm)
 {
     std::size_t pxthreads = 0;
     if (vm.count("pxthreads"))
@@ -43,10 +45,12 @@ void local_tests(boost::program_options::variables_map& vm)
         std::atomic<std::size_t> c(0);
         for (std::size_t j = 0; j < pxthreads; ++j)
         {
-            hpx::async(hpx::util::bind(&barrier_test, pxthreads + 1, j, std::ref(c)));
+            hpx::async(hpx::util::bind(&barrier_test, pxthreads + 1, j,
+                algorithm, std::ref(c)));
         }
 
-        hpx::lcos::barrier b("local_barrier_test", pxthreads + 1, pxthreads);
+        hpx::lcos::barrier b(
+            "local_barrier_test", pxthreads + 1, pxthreads, algorithm);
         b.wait();       // wait for all threads to enter the barrier
         HPX_TEST_EQ(pxthreads, c.load());
     }
@@ -66,6 +70,26 @@ void remote_test_multiple(boost::program_options::variables_map& vm)
         b.wait();
 }
 
+void remote_test_algorithm(boost::program_options::variables_map& vm,
+    hpx::lcos::barrier_algorithm algorithm)
+{
+    std::size_t iterations = 0;
+    if (vm.count("iterations"))
+        iterations = vm["iterations"].as<std::size_t>();
+
+    char const* const barrier_test_name = "/test/barrier/algorithm";
+
+    hpx::lcos::barrier b(barrier_test_name,
+        hpx::get_num_localities(hpx::launch::sync), hpx::get_locality_id(),
+        algorithm);
+    for (std::size_t i = 0; i != iterations; ++i)
+        b.wait();
+
+    // the asynchronous operations may overlap with other work
+    for (std::size_t i = 0; i != iterations; ++i)
+        b.wait(hpx::launch::async).get();
+}
+
 void remote_test_single(boost::program_options::variables_map& vm)
 {
     std::vector<hpx::id_type> localities = hpx::find_all_localities();
@@ -92,11 +116,21 @@ void remote_test_single(boost::program_options::variables_map& vm)
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(boost::program_options::variables_map& vm)
 {
-    local_tests(vm);
+    hpx::lcos::barrier_algorithm const algorithms[] = {
+        hpx::lcos::barrier_algorithm::tree,
+        hpx::lcos::barrier_algorithm::dissemination,
+        hpx::lcos::barrier_algorithm::hierarchical
+    };
+
+    for (hpx::lcos::barrier_algorithm algorithm : algorithms)
+        local_tests(vm, algorithm);
 
     remote_test_multiple(vm);
     remote_test_multiple(vm);
 
+    for (hpx::lcos::barrier_algorithm algorithm : algorithms)
+        remote_test_algorithm(vm, algorithm);
+
     return hpx::finalize();
 }
 
@@ -0,0 +1,128 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/local/bounded_channel.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_try_send_receive()
+{
+    hpx::lcos::local::bounded_channel<std::string> c(3);
+    HPX_TEST_EQ(c.capacity(), std::size_t(4));
+
+    std::string value;
+    HPX_TEST(!c.try_receive(value));
+
+    for (int i = 0; i != 4; ++i)
+        HPX_TEST(c.try_send(std::to_string(i)));
+
+    std::string rejected("rejected");
+    HPX_TEST(!c.try_send(std::move(rejected)));
+    HPX_TEST_EQ(rejected, std::string("rejected"));
+
+    for (int i = 0; i != 4; ++i)
+    {
+        HPX_TEST(c.try_receive(value));
+        HPX_TEST_EQ(value, std::to_string(i));
+    }
+    HPX_TEST(!c.try_receive(value));
+
+    // values left in the channel are destroyed with it
+    HPX_TEST(c.try_send(std::string("left")));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// several senders and receivers block on a small channel
+void test_send_receive()
+{
+    std::size_t const num_senders = 4;
+    std::size_t const num_receivers = 4;
+    std::size_t const count = 10000;
+
+    hpx::lcos::local::bounded_channel<std::size_t> c(2);
+
+    std::vector<hpx::future<void> > senders;
+    for (std::size_t i = 0; i != num_senders; ++i)
+    {
+        senders.push_back(hpx::async([&c, count]()
+            {
+                for (std::size_t j = 1; j <= count; ++j)
+                    c.send(j);
+            }));
+    }
+
+    std::vector<hpx::future<std::size_t> > receivers;
+    for (std::size_t i = 0; i != num_receivers; ++i)
+    {
+        receivers.push_back(hpx::async([&c, count]()
+            {
+                std::size_t sum = 0;
+                for (std::size_t j = 0; j != count; ++j)
+                    sum += c.receive();
+                return sum;
+            }));
+    }
+
+    hpx::wait_all(senders);
+
+    std::size_t sum = 0;
+    for (hpx::future<std::size_t>& f : receivers)
+        sum += f.get();
+
+    HPX_TEST_EQ(sum, num_senders * count * (count + 1) / 2);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_close()
+{
+    hpx::lcos::local::bounded_channel<int> c(1);
+
+    // a blocked receiver is resumed once the channel is closed
+    hpx::future<int> f = hpx::async([&c]() { return c.receive(); });
+    HPX_TEST(c.try_send(42));
+    HPX_TEST_EQ(f.get(), 42);
+
+    hpx::future<int> g = hpx::async([&c]() { return c.receive(); });
+    c.close();
+
+    bool caught_exception = false;
+    try
+    {
+        g.get();
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    caught_exception = false;
+    try
+    {
+        c.send(43);
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_try_send_receive();
+    test_send_receive();
+    test_close();
+
+    return hpx::util::report_errors();
+}
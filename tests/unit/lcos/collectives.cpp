@@ -0,0 +1,215 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/runtime/serialization/serialize_buffer.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+typedef hpx::serialization::serialize_buffer<double> buffer_type;
+
+HPX_REGISTER_COLLECTIVES(int);
+HPX_REGISTER_COLLECTIVES(buffer_type, collective_buffer);
+HPX_REGISTER_COLLECTIVES(std::uint32_t, collective_uint32);
+
+///////////////////////////////////////////////////////////////////////////////
+// run one instance of the operation for each of the given number of sites on
+// this locality
+template <typename F>
+void run_sites(std::size_t num_sites, F f)
+{
+    std::vector<hpx::future<void> > sites;
+    sites.reserve(num_sites);
+    for (std::size_t i = 0; i != num_sites; ++i)
+        sites.push_back(hpx::async(f, i));
+
+    hpx::wait_all(sites);
+    for (hpx::future<void>& site : sites)
+        site.get();
+}
+
+void test_all_reduce(std::size_t num_sites, std::size_t generation)
+{
+    run_sites(num_sites,
+        [=](std::size_t this_site)
+        {
+            int sum = hpx::lcos::all_reduce("/test/all_reduce/",
+                int(this_site), std::plus<int>(), num_sites, generation,
+                this_site).get();
+            HPX_TEST_EQ(sum, int(num_sites * (num_sites - 1) / 2));
+        });
+}
+
+void test_all_reduce_vector(std::size_t num_sites, std::size_t size,
+    std::size_t generation)
+{
+    run_sites(num_sites,
+        [=](std::size_t this_site)
+        {
+            std::vector<int> values(size);
+            for (std::size_t i = 0; i != size; ++i)
+                values[i] = int(i + this_site);
+
+            std::vector<int> result = hpx::lcos::all_reduce(
+                "/test/all_reduce_vector/", std::move(values),
+                std::plus<int>(), num_sites, generation, this_site).get();
+
+            HPX_TEST_EQ(result.size(), size);
+            for (std::size_t i = 0; i != result.size(); ++i)
+            {
+                HPX_TEST_EQ(result[i],
+                    int(i * num_sites + num_sites * (num_sites - 1) / 2));
+            }
+        });
+}
+
+void test_all_reduce_buffer(std::size_t num_sites, std::size_t generation)
+{
+    std::size_t const size = 100;
+
+    run_sites(num_sites,
+        [=](std::size_t this_site)
+        {
+            buffer_type values(size);
+            for (std::size_t i = 0; i != size; ++i)
+                values[i] = double(this_site);
+
+            buffer_type result = hpx::lcos::all_reduce(
+                "/test/all_reduce_buffer/", std::move(values),
+                [](buffer_type const& lhs, buffer_type const& rhs)
+                {
+                    buffer_type result(lhs.size());
+                    for (std::size_t i = 0; i != lhs.size(); ++i)
+                        result[i] = lhs[i] + rhs[i];
+                    return result;
+                },
+                num_sites, generation, this_site).get();
+
+            HPX_TEST_EQ(result.size(), size);
+            for (std::size_t i = 0; i != result.size(); ++i)
+                HPX_TEST_EQ(result[i], double(num_sites * (num_sites - 1) / 2));
+        });
+}
+
+void test_all_gather(std::size_t num_sites, std::size_t generation)
+{
+    run_sites(num_sites,
+        [=](std::size_t this_site)
+        {
+            std::vector<int> result = hpx::lcos::all_gather(
+                "/test/all_gather/", int(this_site), num_sites, generation,
+                this_site).get();
+
+            HPX_TEST_EQ(result.size(), num_sites);
+            for (std::size_t i = 0; i != result.size(); ++i)
+                HPX_TEST_EQ(result[i], int(i));
+        });
+}
+
+void test_all_to_all(std::size_t num_sites, std::size_t generation)
+{
+    run_sites(num_sites,
+        [=](std::size_t this_site)
+        {
+            std::vector<int> values(num_sites);
+            for (std::size_t i = 0; i != num_sites; ++i)
+                values[i] = int(this_site * num_sites + i);
+
+            std::vector<int> result = hpx::lcos::all_to_all(
+                "/test/all_to_all/", std::move(values), num_sites,
+                generation, this_site).get();
+
+            HPX_TEST_EQ(result.size(), num_sites);
+            for (std::size_t i = 0; i != result.size(); ++i)
+                HPX_TEST_EQ(result[i], int(i * num_sites + this_site));
+        });
+}
+
+void test_reduce_scatter(std::size_t num_sites, std::size_t generation)
+{
+    run_sites(num_sites,
+        [=](std::size_t this_site)
+        {
+            std::vector<int> values(num_sites);
+            for (std::size_t i = 0; i != num_sites; ++i)
+                values[i] = int(this_site + i);
+
+            int result = hpx::lcos::reduce_scatter("/test/reduce_scatter/",
+                std::move(values), std::plus<int>(), num_sites, generation,
+                this_site).get();
+
+            HPX_TEST_EQ(result,
+                int(this_site * num_sites + num_sites * (num_sites - 1) / 2));
+        });
+}
+
+void test_invalid_arguments()
+{
+    bool caught_exception = false;
+    try {
+        hpx::lcos::all_to_all("/test/all_to_all_invalid/",
+            std::vector<int>(3), 2, std::size_t(-1), 0).get();
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::bad_parameter);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+// one site on each locality
+void test_all_localities()
+{
+    std::size_t const num_localities =
+        hpx::get_num_localities(hpx::launch::sync);
+
+    int sum = hpx::lcos::all_reduce("/test/all_reduce_localities/",
+        int(hpx::get_locality_id()), std::plus<int>()).get();
+    HPX_TEST_EQ(sum, int(num_localities * (num_localities - 1) / 2));
+
+    std::vector<std::uint32_t> ids = hpx::lcos::all_gather(
+        "/test/all_gather_localities/", hpx::get_locality_id()).get();
+    HPX_TEST_EQ(ids.size(), num_localities);
+    for (std::size_t i = 0; i != ids.size(); ++i)
+        HPX_TEST_EQ(ids[i], std::uint32_t(i));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::size_t generation = 0;
+
+    // only locality 0 runs the tests with multiple sites per locality
+    if (hpx::get_locality_id() == 0)
+    {
+        for (std::size_t num_sites : {1, 2, 3, 4, 5, 8})
+        {
+            test_all_reduce(num_sites, ++generation);
+            test_all_reduce_vector(num_sites, 10, ++generation);
+            test_all_reduce_buffer(num_sites, ++generation);
+            test_all_gather(num_sites, ++generation);
+            test_all_to_all(num_sites, ++generation);
+            test_reduce_scatter(num_sites, ++generation);
+        }
+
+        // large enough to select the ring algorithm
+        test_all_reduce_vector(3, 100000, ++generation);
+        test_all_reduce_vector(4, 100001, ++generation);
+
+        test_invalid_arguments();
+    }
+
+    test_all_localities();
+
+    return hpx::util::report_errors();
+}
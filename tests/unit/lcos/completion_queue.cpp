@@ -0,0 +1,132 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/local_lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// the futures are handed out in the order they become ready, not in the
+// order they were added
+void test_readiness_order()
+{
+    std::size_t const count = 10;
+
+    std::vector<hpx::lcos::local::promise<std::size_t> > promises(count);
+    hpx::lcos::local::completion_queue<hpx::future<std::size_t> > q;
+
+    for (std::size_t i = 0; i != count; ++i)
+        HPX_TEST_EQ(q.add(promises[i].get_future()), i);
+
+    HPX_TEST_EQ(q.size(), count);
+
+    std::size_t index = 0;
+    hpx::future<std::size_t> f;
+    HPX_TEST(!q.try_get(index, f));
+
+    for (std::size_t i = count; i != 0; --i)
+        promises[i - 1].set_value(i - 1);
+
+    for (std::size_t i = count; i != 0; --i)
+    {
+        std::pair<std::size_t, hpx::future<std::size_t> > p = q.get();
+        HPX_TEST_EQ(p.first, i - 1);
+        HPX_TEST_EQ(p.second.get(), i - 1);
+    }
+
+    HPX_TEST(q.empty());
+
+    bool caught_exception = false;
+    try {
+        q.get();
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::invalid_status);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+// get() suspends until one of the futures becomes ready
+void test_concurrent(std::size_t count)
+{
+    hpx::lcos::local::completion_queue<hpx::future<std::size_t> > q;
+
+    for (std::size_t i = 0; i != count; ++i)
+        q.add(hpx::async([i]() { return i; }));
+
+    std::vector<bool> seen(count, false);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        std::pair<std::size_t, hpx::future<std::size_t> > p = q.get();
+        HPX_TEST_EQ(p.first, p.second.get());
+        HPX_TEST(!seen[p.first]);
+        seen[p.first] = true;
+    }
+
+    HPX_TEST(q.empty());
+}
+
+// when_each calls the function in readiness order and never concurrently
+void test_when_each_order(std::size_t count)
+{
+    std::vector<hpx::lcos::local::promise<std::size_t> > promises(count);
+    std::vector<hpx::future<std::size_t> > futures;
+    for (auto& p : promises)
+        futures.push_back(p.get_future());
+
+    std::vector<std::size_t> order;
+    hpx::future<void> r = hpx::when_each(
+        [&](std::size_t idx, hpx::future<std::size_t> f)
+        {
+            HPX_TEST_EQ(idx, f.get());
+            order.push_back(idx);
+        },
+        futures);
+
+    for (std::size_t i = count; i != 0; --i)
+        promises[i - 1].set_value(i - 1);
+
+    r.get();
+
+    HPX_TEST_EQ(order.size(), count);
+    for (std::size_t i = 0; i != order.size(); ++i)
+        HPX_TEST_EQ(order[i], count - i - 1);
+
+    // the futures become ready on different threads
+    std::atomic<std::size_t> active(0);
+    std::size_t calls = 0;
+
+    futures.clear();
+    for (std::size_t i = 0; i != count; ++i)
+        futures.push_back(hpx::async([i]() { return i; }));
+
+    hpx::wait_each(
+        [&](hpx::future<std::size_t> f)
+        {
+            HPX_TEST_EQ(++active, std::size_t(1));
+            f.get();
+            ++calls;
+            --active;
+        },
+        futures);
+
+    HPX_TEST_EQ(calls, count);
+}
+
+int main()
+{
+    test_readiness_order();
+    test_concurrent(1000);
+    test_when_each_order(100);
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,163 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+HPX_REGISTER_DISTRIBUTED_QUEUE(std::uint64_t, std_uint64_t);
+
+typedef hpx::lcos::distributed_queue<std::uint64_t> queue_type;
+
+///////////////////////////////////////////////////////////////////////////////
+// the first site produces all items, all sites consume them
+std::vector<std::uint64_t> run_site(std::string const& basename,
+    std::size_t site, std::size_t num_sites, std::uint64_t num_items)
+{
+    queue_type q(basename, site, num_sites, 16);
+    hpx::lcos::barrier b(basename + "/barrier", num_sites, site);
+
+    HPX_TEST_EQ(q.get_site(), site);
+    HPX_TEST_EQ(q.get_num_sites(), num_sites);
+
+    if (site == 0)
+    {
+        std::vector<std::uint64_t> items;
+        for (std::uint64_t i = 0; i != num_items; ++i)
+            items.push_back(i);
+        q.push(std::move(items));
+    }
+    else
+    {
+        // the other sites add one item each to the shard of the first site
+        q.push(0, std::vector<std::uint64_t>(1, num_items + site)).get();
+    }
+    b.wait();
+
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0;
+    for (std::vector<std::uint64_t> items = q.pop(8); !items.empty();
+         items = q.pop(8))
+    {
+        HPX_TEST(items.size() <= std::size_t(8));
+        for (std::uint64_t i : items)
+        {
+            ++count;
+            sum += i;
+        }
+    }
+    HPX_TEST_EQ(q.local_size(), std::size_t(0));
+
+    // no shard may go away while other sites are still taking items
+    b.wait();
+    HPX_TEST_EQ(q.size().get(), std::size_t(0));
+    b.wait();
+
+    return std::vector<std::uint64_t>{ count, sum };
+}
+
+std::vector<std::uint64_t> run_sites(std::string const& basename,
+    std::size_t first, std::size_t count, std::size_t num_sites,
+    std::uint64_t num_items)
+{
+    std::vector<hpx::future<std::vector<std::uint64_t> > > sites;
+    for (std::size_t s = first; s != first + count; ++s)
+    {
+        sites.push_back(
+            hpx::async(&run_site, basename, s, num_sites, num_items));
+    }
+
+    std::vector<std::uint64_t> result(2, 0);
+    for (auto& f : sites)
+    {
+        std::vector<std::uint64_t> r = f.get();
+        result[0] += r[0];
+        result[1] += r[1];
+    }
+    return result;
+}
+HPX_PLAIN_ACTION(run_sites, run_sites_action);
+
+void test_master_worker(std::size_t sites_per_locality,
+    std::uint64_t num_items)
+{
+    std::string basename = "/test/distributed_queue/master_worker/" +
+        std::to_string(sites_per_locality) + "/" + std::to_string(num_items);
+
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    std::size_t num_sites = sites_per_locality * localities.size();
+
+    std::vector<hpx::future<std::vector<std::uint64_t> > > futures;
+    for (std::size_t l = 0; l != localities.size(); ++l)
+    {
+        futures.push_back(hpx::async<run_sites_action>(localities[l],
+            basename, l * sites_per_locality, sites_per_locality, num_sites,
+            num_items));
+    }
+
+    // every item has been taken exactly once
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0;
+    for (auto& f : futures)
+    {
+        std::vector<std::uint64_t> r = f.get();
+        count += r[0];
+        sum += r[1];
+    }
+
+    std::uint64_t expected_sum = num_items * (num_items - 1) / 2;
+    for (std::size_t s = 1; s != num_sites; ++s)
+        expected_sum += num_items + s;
+
+    HPX_TEST_EQ(count, num_items + num_sites - 1);
+    HPX_TEST_EQ(sum, expected_sum);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_local()
+{
+    queue_type q("/test/distributed_queue/local", 0, 1);
+
+    std::uint64_t item = 0;
+    HPX_TEST(!q.try_pop(item));
+    HPX_TEST(q.pop(10).empty());
+
+    q.push(1);
+    q.push(std::vector<std::uint64_t>{ 2, 3, 4 });
+    q.push(0, std::vector<std::uint64_t>{ 5 }).get();
+    HPX_TEST_EQ(q.local_size(), std::size_t(5));
+    HPX_TEST_EQ(q.size().get(), std::size_t(5));
+
+    // the local consumers take the items in order
+    HPX_TEST(q.try_pop(item));
+    HPX_TEST_EQ(item, std::uint64_t(1));
+
+    std::vector<std::uint64_t> items = q.pop(3);
+    HPX_TEST(items == std::vector<std::uint64_t>({ 2, 3, 4 }));
+
+    items = q.pop(3);
+    HPX_TEST(items == std::vector<std::uint64_t>({ 5 }));
+    HPX_TEST(q.pop(3).empty());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_local();
+
+    test_master_worker(1, 1000);
+    test_master_worker(4, 10000);
+
+    return hpx::util::report_errors();
+}
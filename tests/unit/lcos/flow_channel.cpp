@@ -0,0 +1,167 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+typedef std::pair<std::size_t, std::size_t> value_type;
+
+HPX_REGISTER_FLOW_CHANNEL(int);
+HPX_REGISTER_FLOW_CHANNEL(value_type, pair_of_size_t);
+
+///////////////////////////////////////////////////////////////////////////////
+// send the values (producer, 0) ... (producer, count - 1)
+void produce(hpx::lcos::flow_channel<value_type> c, std::size_t producer,
+    std::size_t count, std::size_t batch_size)
+{
+    hpx::lcos::flow_channel_sender<value_type> sender(c, batch_size);
+    for (std::size_t i = 0; i != count; ++i)
+        sender.set(std::make_pair(producer, i));
+    sender.flush();
+}
+HPX_PLAIN_ACTION(produce);
+
+void test_producers(std::size_t capacity, std::size_t batch_size,
+    bool prefetch)
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    std::size_t const count = 1000;
+
+    hpx::lcos::flow_channel<value_type> c(hpx::find_here(), capacity);
+
+    // two producers on each locality
+    std::vector<hpx::future<void> > producers;
+    for (std::size_t i = 0; i != 2 * localities.size(); ++i)
+    {
+        producers.push_back(hpx::async(produce_action(),
+            localities[i % localities.size()], c, i, count, batch_size));
+    }
+
+    // the values of each producer arrive in order
+    hpx::lcos::flow_channel_receiver<value_type> receiver(
+        c, batch_size, prefetch);
+
+    std::vector<std::size_t> next(producers.size(), 0);
+    for (std::size_t i = 0; i != count * producers.size(); ++i)
+    {
+        value_type value = receiver.get(hpx::launch::sync);
+        HPX_TEST(value.first < next.size());
+        if (value.first < next.size())
+        {
+            HPX_TEST_EQ(value.second, next[value.first]);
+            ++next[value.first];
+        }
+    }
+
+    hpx::wait_all(producers);
+    for (hpx::future<void>& f : producers)
+        f.get();
+
+    HPX_TEST_EQ(c.close(), std::size_t(0));
+
+    // the receiver sees the end of the stream
+    bool caught_exception = false;
+    try {
+        receiver.get(hpx::launch::sync);
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::invalid_status);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+// close the channel through the sender, iterate over the values
+void test_close()
+{
+    hpx::lcos::flow_channel<int> c(hpx::find_here(), 100);
+
+    hpx::future<void> producer = hpx::async(
+        [c]()
+        {
+            hpx::lcos::flow_channel_sender<int> sender(c, 7);
+            for (int i = 0; i != 1000; ++i)
+                sender.set(i);
+            sender.close();
+        });
+
+    int expected = 0;
+    hpx::lcos::flow_channel_receiver<int> receiver(c, 10);
+    for (int value : receiver)
+    {
+        HPX_TEST_EQ(value, expected);
+        ++expected;
+    }
+    HPX_TEST_EQ(expected, 1000);
+
+    producer.get();
+
+    // writing to a closed channel fails
+    bool caught_exception = false;
+    try {
+        hpx::lcos::flow_channel_sender<int> sender(c, 1);
+        sender.set(42);
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::invalid_status);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+// a producer is blocked once the capacity of the channel is used up
+void test_flow_control()
+{
+    hpx::lcos::flow_channel<int> c(hpx::find_here(), 10);
+
+    hpx::lcos::flow_channel_sender<int> sender(c, 5);
+    for (int i = 0; i != 10; ++i)
+        sender.set(i);
+    sender.flush();
+
+    hpx::future<void> blocked = hpx::async(
+        [sender]() mutable
+        {
+            for (int i = 10; i != 15; ++i)
+                sender.set(i);
+        });
+
+    HPX_TEST(blocked.wait_for(std::chrono::milliseconds(100)) ==
+        hpx::lcos::future_status::timeout);
+
+    hpx::lcos::flow_channel_receiver<int> receiver(c, 5, false);
+    for (int i = 0; i != 5; ++i)
+        HPX_TEST_EQ(receiver.get(hpx::launch::sync), i);
+
+    blocked.get();
+    sender.flush();
+
+    for (int i = 5; i != 15; ++i)
+        HPX_TEST_EQ(receiver.get(hpx::launch::sync), i);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_producers(1, 1, false);
+    test_producers(16, 4, true);
+    test_producers(1024, 64, true);
+    test_producers(100, 1000, false);
+
+    test_close();
+    test_flow_control();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,149 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+HPX_REGISTER_HALO_EXCHANGE(double);
+
+///////////////////////////////////////////////////////////////////////////////
+double value(std::size_t site, std::size_t generation, std::size_t i)
+{
+    return double(site * 1000000 + generation * 100 + i);
+}
+
+// run the time steps of one site of a periodic one-dimensional domain
+void run_site(std::string const& basename, std::size_t site,
+    std::size_t num_sites, std::size_t width, std::size_t steps)
+{
+    typedef hpx::lcos::halo_exchange<double> halo_type;
+    halo_type halo(basename, site, num_sites, width, true);
+
+    HPX_TEST_EQ(halo.get_num_neighbors(), std::size_t(2));
+    HPX_TEST(halo.get_neighbor(halo_type::left).valid());
+    HPX_TEST(halo.get_neighbor(halo_type::right).valid());
+
+    std::size_t left = (site + num_sites - 1) % num_sites;
+    std::size_t right = (site + 1) % num_sites;
+
+    std::vector<double> data(3 * width);
+    for (std::size_t t = 0; t != steps; ++t)
+    {
+        for (std::size_t i = 0; i != data.size(); ++i)
+            data[i] = value(site, t, i);
+
+        halo.put_edges(data.begin(), data.end(), t);
+        halo.get_future(t).get();
+
+        // the left neighbor sends the end of its data, the right neighbor
+        // the beginning
+        double const* from_left = halo.get_data(halo_type::left, t);
+        double const* from_right = halo.get_data(halo_type::right, t);
+        for (std::size_t i = 0; i != width; ++i)
+        {
+            HPX_TEST_EQ(from_left[i], value(left, t, 2 * width + i));
+            HPX_TEST_EQ(from_right[i], value(right, t, i));
+        }
+
+        halo.release(t);
+    }
+}
+
+void run_sites(std::string const& basename, std::size_t first,
+    std::size_t count, std::size_t num_sites, std::size_t width,
+    std::size_t steps)
+{
+    std::vector<hpx::future<void> > sites;
+    for (std::size_t s = first; s != first + count; ++s)
+    {
+        sites.push_back(
+            hpx::async(&run_site, basename, s, num_sites, width, steps));
+    }
+    hpx::wait_all(sites);
+    for (hpx::future<void>& f : sites)
+        f.get();
+}
+HPX_PLAIN_ACTION(run_sites, run_sites_action);
+
+void test_periodic(std::size_t sites_per_locality, std::size_t width,
+    std::size_t steps)
+{
+    std::string basename = "/test/halo_exchange/periodic/" +
+        std::to_string(sites_per_locality) + "/" + std::to_string(width);
+
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    std::size_t num_sites = sites_per_locality * localities.size();
+
+    std::vector<hpx::future<void> > futures;
+    for (std::size_t l = 0; l != localities.size(); ++l)
+    {
+        futures.push_back(hpx::async<run_sites_action>(localities[l],
+            basename, l * sites_per_locality, sites_per_locality, num_sites,
+            width, steps));
+    }
+    hpx::wait_all(futures);
+    for (hpx::future<void>& f : futures)
+        f.get();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// halos arriving before the previous generation was released are kept back
+void test_early_arrival()
+{
+    typedef hpx::lcos::halo_exchange<double> halo_type;
+    std::string basename = "/test/halo_exchange/early_arrival";
+
+    halo_type a(basename, 0, 2, 1, false, 1);
+    halo_type b(basename, 1, 2, 1, false, 1);
+
+    HPX_TEST(!a.get_neighbor(halo_type::left).valid());
+    HPX_TEST(!b.get_neighbor(halo_type::right).valid());
+    HPX_TEST(a.send_buffer(halo_type::left, 0) == nullptr);
+
+    for (std::size_t t = 0; t != 3; ++t)
+    {
+        *a.send_buffer(halo_type::right, t) = double(t);
+        a.put(halo_type::right, t);
+    }
+
+    for (std::size_t t = 0; t != 3; ++t)
+    {
+        hpx::future<void> f = b.get_future(t);
+        HPX_TEST(f.is_ready());
+        f.get();
+
+        HPX_TEST(b.get_data(halo_type::right, t) == nullptr);
+        HPX_TEST_EQ(*b.get_data(halo_type::left, t), double(t));
+        b.release(t);
+    }
+
+    // the other direction
+    HPX_TEST(!a.get_future(0).is_ready());
+    *b.send_buffer(halo_type::left, 0) = 42.0;
+    b.put(halo_type::left, 0);
+    HPX_TEST(a.get_future(0).is_ready());
+    HPX_TEST_EQ(*a.get_data(halo_type::right, 0), 42.0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_periodic(1, 1, 10);
+    test_periodic(4, 16, 100);
+    test_periodic(2, 1024, 20);
+
+    test_early_arrival();
+
+    return hpx::util::report_errors();
+}
@@ -7,6 +7,8 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/lcos/local/adaptive_mutex.hpp>
 #include <hpx/lcos/local/condition_variable.hpp>
 #include <hpx/lcos/local/mutex.hpp>
 #include <hpx/runtime/threads/thread.hpp>
@@ -16,6 +18,8 @@
 
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -289,6 +293,38 @@ void test_timed_mutex()
     test_timedlock<hpx::lcos::local::timed_mutex>()();
 }
 
+void test_adaptive_mutex()
+{
+    test_lock<hpx::lcos::local::adaptive_mutex>()();
+    test_trylock<hpx::lcos::local::adaptive_mutex>()();
+
+    // contended short and long critical sections
+    hpx::lcos::local::adaptive_mutex mtx;
+    std::size_t counter = 0;
+
+    std::vector<hpx::future<void> > threads;
+    for (std::size_t i = 0; i != 16; ++i)
+    {
+        threads.push_back(hpx::async([&mtx, &counter, i]()
+            {
+                for (std::size_t j = 0; j != 1000; ++j)
+                {
+                    std::lock_guard<hpx::lcos::local::adaptive_mutex> l(mtx);
+                    ++counter;
+                    if (i % 4 == 0 && j % 100 == 0)
+                        hpx::this_thread::yield();
+                }
+            }));
+    }
+    hpx::wait_all(threads);
+
+    HPX_TEST_EQ(counter, std::size_t(16000));
+
+    std::vector<std::int64_t> const hold_times =
+        hpx::lcos::local::adaptive_mutex::get_hold_time_histogram(false);
+    HPX_TEST_EQ(hold_times.size(), std::size_t(hold_times[2] + 3));
+}
+
 //void test_recursive_mutex()
 //{
 //    test_lock<hpx::lcos::local::recursive_mutex>()();
@@ -313,6 +349,7 @@ int hpx_main(variables_map&)
     {
         test_mutex();
         test_timed_mutex();
+        test_adaptive_mutex();
         //~ test_recursive_mutex();
         //~ test_recursive_timed_mutex();
     }
@@ -0,0 +1,140 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/pipelined_broadcast.hpp>
+#include <hpx/runtime/serialization/serialize_buffer.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+typedef hpx::serialization::serialize_buffer<double> buffer_type;
+
+std::atomic<std::size_t> received(0);
+
+void verify_buffer(buffer_type const& buffer)
+{
+    for (std::size_t i = 0; i != buffer.size(); ++i)
+        HPX_TEST_EQ(buffer[i], double(i));
+}
+
+void receive_buffer(buffer_type const& buffer)
+{
+    verify_buffer(buffer);
+    ++received;
+}
+HPX_PLAIN_ACTION(receive_buffer);
+
+HPX_REGISTER_PIPELINED_BROADCAST_ACTION_DECLARATION(receive_buffer_action)
+HPX_REGISTER_PIPELINED_BROADCAST_ACTION(receive_buffer_action)
+
+std::size_t get_received()
+{
+    return received.exchange(0);
+}
+HPX_PLAIN_ACTION(get_received);
+
+// the result of the action is discarded
+double sum_buffer(buffer_type const& buffer)
+{
+    verify_buffer(buffer);
+    ++received;
+
+    double sum = 0;
+    for (std::size_t i = 0; i != buffer.size(); ++i)
+        sum += buffer[i];
+    return sum;
+}
+HPX_PLAIN_ACTION(sum_buffer);
+
+HPX_REGISTER_PIPELINED_BROADCAST_ACTION_DECLARATION(sum_buffer_action)
+HPX_REGISTER_PIPELINED_BROADCAST_ACTION(sum_buffer_action)
+
+///////////////////////////////////////////////////////////////////////////////
+buffer_type make_buffer(std::size_t size)
+{
+    buffer_type buffer(size);
+    for (std::size_t i = 0; i != size; ++i)
+        buffer[i] = double(i);
+    return buffer;
+}
+
+std::size_t count_received(std::vector<hpx::id_type> const& localities)
+{
+    std::size_t count = 0;
+    for (hpx::id_type const& id : localities)
+        count += get_received_action()(id);
+    return count;
+}
+
+template <typename Action>
+void test_pipelined_broadcast(std::vector<hpx::id_type> const& ids,
+    std::size_t size, std::size_t chunk_size)
+{
+    buffer_type buffer = make_buffer(size);
+    hpx::lcos::pipelined_broadcast<Action>(ids, buffer, chunk_size).get();
+
+    HPX_TEST_EQ(count_received(hpx::find_all_localities()), ids.size());
+}
+
+int hpx_main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    // every locality is targeted several times
+    std::vector<hpx::id_type> ids;
+    for (std::size_t i = 0; i != 7; ++i)
+        ids.insert(ids.end(), localities.begin(), localities.end());
+
+    for (std::size_t size : {0, 1, 1000, 100000})
+    {
+        test_pipelined_broadcast<receive_buffer_action>(
+            localities, size, 4096);
+        test_pipelined_broadcast<receive_buffer_action>(ids, size, 4096);
+        test_pipelined_broadcast<receive_buffer_action>(ids, size, 1);
+        test_pipelined_broadcast<sum_buffer_action>(ids, size,
+            HPX_PIPELINED_BROADCAST_CHUNK_SIZE);
+    }
+
+    // several concurrent broadcasts of the same action
+    {
+        buffer_type buffer = make_buffer(10000);
+
+        std::vector<hpx::future<void> > broadcasts;
+        for (std::size_t i = 0; i != 10; ++i)
+        {
+            broadcasts.push_back(hpx::lcos::pipelined_broadcast<
+                receive_buffer_action>(ids, buffer, 1024));
+        }
+        hpx::wait_all(broadcasts);
+
+        HPX_TEST_EQ(count_received(localities), 10 * ids.size());
+    }
+
+    // empty list of targets
+    bool caught_exception = false;
+    try {
+        hpx::lcos::pipelined_broadcast<receive_buffer_action>(
+            std::vector<hpx::id_type>(), make_buffer(10)).get();
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::bad_parameter);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,69 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that the ids of promises encode the address of their
+// LCO, which allows to set their values without resolving them in AGAS.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/runtime/agas/interface.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstdint>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void set_value(hpx::id_type const& id, std::int32_t i)
+{
+    hpx::set_lco_value(id, i);
+}
+HPX_PLAIN_ACTION(set_value);    // defines set_value_action
+
+///////////////////////////////////////////////////////////////////////////////
+void test_promise_id()
+{
+    hpx::lcos::promise<std::int32_t> p;
+    hpx::future<std::int32_t> f = p.get_future();
+
+    hpx::id_type id = p.get_id();
+    HPX_TEST(hpx::naming::refers_to_local_lva(id.get_gid()));
+    HPX_TEST_EQ(hpx::naming::get_locality_id_from_id(id),
+        hpx::get_locality_id());
+
+    hpx::naming::address addr;
+    HPX_TEST(hpx::agas::is_local_address_cached(id, addr));
+    HPX_TEST(addr.locality_ == hpx::get_locality());
+
+    hpx::set_lco_value(id, std::int32_t(42));
+    HPX_TEST_EQ(f.get(), 42);
+}
+
+void test_remote_set_value(hpx::id_type const& locality)
+{
+    hpx::lcos::promise<std::int32_t> p;
+    hpx::future<std::int32_t> f = p.get_future();
+
+    hpx::async<set_value_action>(locality, p.get_id(), 42).get();
+    HPX_TEST_EQ(f.get(), 42);
+}
+
+int hpx_main()
+{
+    test_promise_id();
+
+    for (hpx::id_type const& locality : hpx::find_all_localities())
+        test_remote_set_value(locality);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
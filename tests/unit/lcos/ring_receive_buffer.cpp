@@ -0,0 +1,130 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/local_lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// the values are matched with the futures of the same step, regardless of
+// the order of store_received and receive
+void test_store_receive(std::size_t depth, std::size_t steps)
+{
+    hpx::lcos::local::ring_receive_buffer<std::size_t> buffer(depth);
+    HPX_TEST_EQ(buffer.depth(), depth);
+
+    for (std::size_t step = 0; step != steps; ++step)
+    {
+        if (step % 2)
+        {
+            buffer.store_received(step, step);
+            HPX_TEST_EQ(buffer.receive(step).get(), step);
+        }
+        else
+        {
+            hpx::future<std::size_t> f = buffer.receive(step);
+            HPX_TEST(!f.is_ready());
+            buffer.store_received(step, step);
+            HPX_TEST_EQ(f.get(), step);
+        }
+    }
+
+    // the futures of the whole window can be retrieved up front
+    std::vector<hpx::future<std::size_t> > futures;
+    for (std::size_t step = steps; step != steps + depth; ++step)
+        futures.push_back(buffer.receive(step));
+    for (std::size_t step = steps + depth; step != steps; --step)
+        buffer.store_received(step - 1, step - 1);
+    for (std::size_t i = 0; i != depth; ++i)
+        HPX_TEST_EQ(futures[i].get(), steps + i);
+
+    // completed steps cannot be used again
+    bool caught_exception = false;
+    try {
+        buffer.receive(0);
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::invalid_status);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+// a step beyond the window waits for the oldest step to complete
+void test_window()
+{
+    std::size_t const depth = 2;
+    hpx::lcos::local::ring_receive_buffer<std::size_t> buffer(depth, 10);
+
+    hpx::future<std::size_t> f10 = buffer.receive(10);
+
+    hpx::future<void> store12 = hpx::async(
+        [&]() { buffer.store_received(12, std::size_t(12)); });
+
+    hpx::this_thread::sleep_for(std::chrono::milliseconds(100));
+    HPX_TEST(!store12.is_ready());
+
+    buffer.store_received(10, std::size_t(10));
+    HPX_TEST_EQ(f10.get(), std::size_t(10));
+
+    store12.get();
+    HPX_TEST_EQ(buffer.receive(12).get(), std::size_t(12));
+}
+
+// concurrent producers and consumers
+void test_concurrent(std::size_t depth, std::size_t steps)
+{
+    hpx::lcos::local::ring_receive_buffer<std::size_t> buffer(depth);
+
+    hpx::future<void> producer = hpx::async(
+        [&]()
+        {
+            for (std::size_t step = 0; step != steps; ++step)
+                buffer.store_received(step, step);
+        });
+
+    for (std::size_t step = 0; step != steps; ++step)
+        HPX_TEST_EQ(buffer.receive(step).get(), step);
+
+    producer.get();
+}
+
+void test_void_and_cancel()
+{
+    hpx::lcos::local::ring_receive_buffer<void> buffer(4);
+
+    buffer.store_received(0);
+    buffer.receive(0).get();
+
+    hpx::future<void> f1 = buffer.receive(1);
+    hpx::future<void> f2 = buffer.receive(2);
+    buffer.store_received(2);
+
+    HPX_TEST_EQ(buffer.cancel_waiting(std::make_exception_ptr(
+        std::runtime_error("canceled"))), std::size_t(1));
+
+    HPX_TEST(f1.has_exception());
+    HPX_TEST(f2.has_value());
+}
+
+int main()
+{
+    test_store_receive(1, 10);
+    test_store_receive(4, 100);
+    test_window();
+    test_concurrent(4, 10000);
+    test_void_and_cancel();
+
+    return hpx::util::report_errors();
+}
@@ -50,7 +50,25 @@ void check_()
     HPX_TEST(2*increments == i1 && 2*increments == i2);
 }
 
+// tasks queued while the guard is held are run by the thread holding
+// the guard, one after the other
+void test_queued_tasks()
+{
+    hpx::lcos::local::guard g;
+    int count = 0;
+
+    run_guarded(g, [&]() {
+        for (int i = 0; i != 100000; ++i)
+            run_guarded(g, [&]() { ++count; });
+        HPX_TEST_EQ(count, 0);
+    });
+
+    HPX_TEST_EQ(count, 100000);
+}
+
 int hpx_main(boost::program_options::variables_map& vm) {
+    test_queued_tasks();
+
     if (vm.count("increments"))
         increments = vm["increments"].as<int>();
 
@@ -0,0 +1,128 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/local/scalable_shared_mutex.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <boost/thread/locks.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_try_lock()
+{
+    hpx::lcos::local::scalable_shared_mutex mtx;
+
+    HPX_TEST(mtx.try_lock_shared());
+    HPX_TEST(mtx.try_lock_shared());
+    HPX_TEST(!mtx.try_lock());
+    mtx.unlock_shared();
+    mtx.unlock_shared();
+
+    HPX_TEST(mtx.try_lock());
+    HPX_TEST(!mtx.try_lock());
+    HPX_TEST(!mtx.try_lock_shared());
+    mtx.unlock();
+
+    HPX_TEST(mtx.try_lock_shared());
+    mtx.unlock_shared();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// readers may hold the lock at the same time
+void test_multiple_readers()
+{
+    hpx::lcos::local::scalable_shared_mutex mtx;
+    hpx::lcos::local::latch all_locked(11);
+    hpx::lcos::local::latch release(2);
+
+    std::vector<hpx::future<void> > readers;
+    for (int i = 0; i != 10; ++i)
+    {
+        readers.push_back(hpx::async([&]()
+            {
+                boost::shared_lock<hpx::lcos::local::scalable_shared_mutex>
+                    l(mtx);
+                all_locked.count_down(1);
+                release.wait();
+            }));
+    }
+
+    all_locked.count_down_and_wait();
+    HPX_TEST(!mtx.try_lock());
+
+    release.count_down(1);
+    hpx::wait_all(readers);
+
+    HPX_TEST(mtx.try_lock());
+    mtx.unlock();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// writers exclude readers and other writers
+void test_readers_and_writers()
+{
+    std::size_t const num_readers = 16;
+    std::size_t const num_writers = 4;
+    std::size_t const count = 1000;
+
+    hpx::lcos::local::scalable_shared_mutex mtx;
+    std::atomic<std::size_t> active_readers(0);
+    std::atomic<std::size_t> active_writers(0);
+    std::size_t value = 0;
+
+    std::vector<hpx::future<void> > threads;
+    for (std::size_t i = 0; i != num_writers; ++i)
+    {
+        threads.push_back(hpx::async([&]()
+            {
+                for (std::size_t j = 0; j != count; ++j)
+                {
+                    std::lock_guard<hpx::lcos::local::scalable_shared_mutex>
+                        l(mtx);
+                    HPX_TEST_EQ(++active_writers, std::size_t(1));
+                    HPX_TEST_EQ(active_readers.load(), std::size_t(0));
+                    ++value;
+                    --active_writers;
+                }
+            }));
+    }
+
+    for (std::size_t i = 0; i != num_readers; ++i)
+    {
+        threads.push_back(hpx::async([&]()
+            {
+                for (std::size_t j = 0; j != count; ++j)
+                {
+                    boost::shared_lock<
+                        hpx::lcos::local::scalable_shared_mutex> l(mtx);
+                    ++active_readers;
+                    HPX_TEST_EQ(active_writers.load(), std::size_t(0));
+                    if (j % 100 == 0)
+                        hpx::this_thread::yield();
+                    --active_readers;
+                }
+            }));
+    }
+
+    hpx::wait_all(threads);
+    HPX_TEST_EQ(value, num_writers * count);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_try_lock();
+    test_multiple_readers();
+    test_readers_and_writers();
+
+    return hpx::util::report_errors();
+}
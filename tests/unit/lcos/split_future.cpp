@@ -9,6 +9,8 @@
 
 #include <array>
 #include <chrono>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -173,6 +175,73 @@ void test_split_future_vector()
     HPX_TEST_EQ(result[2].get(), 44);
 }
 
+// the elements which are not part of the vector hold an exception
+void test_split_future_vector_out_of_bounds()
+{
+    hpx::lcos::local::futures_factory<std::vector<int>()> pt(
+        make_vector_slowly);
+    pt.apply();
+
+    std::vector<hpx::future<int> > result =
+        hpx::split_future(pt.get_future(), 4);
+
+    HPX_TEST_EQ(result[2].get(), 44);
+
+    bool caught_exception = false;
+    try {
+        result[3].get();
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::length_error);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// the elements are moved out of the split future only once they are
+// retrieved
+hpx::util::tuple<std::unique_ptr<int>, std::string> make_move_only_slowly()
+{
+    hpx::this_thread::sleep_for(std::chrono::milliseconds(100));
+    return hpx::util::make_tuple(
+        std::unique_ptr<int>(new int(42)), std::string("43"));
+}
+
+void test_split_future_move_only()
+{
+    typedef hpx::util::tuple<std::unique_ptr<int>, std::string> tuple_type;
+
+    hpx::lcos::local::futures_factory<tuple_type()> pt(make_move_only_slowly);
+    pt.apply();
+
+    hpx::util::tuple<hpx::future<std::unique_ptr<int> >,
+        hpx::future<std::string> > result = hpx::split_future(pt.get_future());
+
+    hpx::shared_future<std::string> s = hpx::util::get<1>(result).share();
+    HPX_TEST_EQ(s.get(), std::string("43"));
+    HPX_TEST_EQ(&s.get(), &s.get());
+
+    std::unique_ptr<int> p = hpx::util::get<0>(result).get();
+    HPX_TEST_EQ(*p, 42);
+}
+
+void test_split_future_exception()
+{
+    hpx::lcos::local::promise<hpx::util::tuple<int, int> > p;
+
+    hpx::util::tuple<hpx::future<int>, hpx::future<int> > result =
+        hpx::split_future(p.get_future());
+
+    p.set_exception(std::make_exception_ptr(std::runtime_error("test")));
+
+    hpx::util::get<0>(result).wait();
+    hpx::util::get<1>(result).wait();
+
+    HPX_TEST(hpx::util::get<0>(result).has_exception());
+    HPX_TEST(hpx::util::get<1>(result).has_exception());
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(int argc, char* argv[])
 {
@@ -187,6 +256,10 @@ int hpx_main(int argc, char* argv[])
     test_split_future_array();
 
     test_split_future_vector();
+    test_split_future_vector_out_of_bounds();
+
+    test_split_future_move_only();
+    test_split_future_exception();
 
     hpx::finalize();
     return hpx::util::report_errors();
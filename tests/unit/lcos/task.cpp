@@ -0,0 +1,129 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx.hpp>
+
+#if !defined(HPX_HAVE_CXX20_COROUTINES)
+#error "This test requires compiler support for C++20 coroutines"
+#endif
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/local_lcos.hpp>
+#include <hpx/lcos/task.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::task<int> fib(int n)
+{
+    if (n < 2)
+        co_return n;
+
+    int a = co_await fib(n - 1);
+    int b = co_await fib(n - 2);
+    co_return a + b;
+}
+
+hpx::task<int> fib_async(int n)
+{
+    if (n < 2)
+        co_return n;
+
+    hpx::future<int> f = hpx::async([n]() { return fib(n - 1).get_future(); });
+    int b = co_await fib(n - 2);
+    co_return co_await f + b;
+}
+
+hpx::task<int> identity(int n)
+{
+    co_return n;
+}
+
+// awaits many tasks which finish right away
+hpx::task<std::size_t> sum(std::size_t n)
+{
+    std::size_t result = 0;
+    for (std::size_t i = 0; i != n; ++i)
+        result += co_await identity(1);
+    co_return result;
+}
+
+hpx::task<void> throws()
+{
+    co_await hpx::async([]() {});
+    throw std::runtime_error("task");
+}
+
+hpx::task<> rethrows(bool& caught)
+{
+    try
+    {
+        co_await throws();
+    }
+    catch (std::runtime_error const&)
+    {
+        caught = true;
+    }
+}
+
+hpx::task<int> await_shared(hpx::shared_future<int> f)
+{
+    int a = co_await f;
+    int b = co_await f;
+    co_return a + b;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    HPX_TEST_EQ(fib(10).get_future().get(), 55);
+    HPX_TEST_EQ(fib_async(10).get_future().get(), 55);
+    HPX_TEST_EQ(sum(100).get_future().get(), std::size_t(100));
+
+    {
+        bool caught = false;
+        rethrows(caught).get_future().get();
+        HPX_TEST(caught);
+
+        bool exception_thrown = false;
+        try
+        {
+            throws().get_future().get();
+        }
+        catch (std::runtime_error const&)
+        {
+            exception_thrown = true;
+        }
+        HPX_TEST(exception_thrown);
+    }
+
+    {
+        hpx::lcos::local::promise<int> p;
+        hpx::future<int> f = await_shared(p.get_future().share()).get_future();
+        p.set_value(21);
+        HPX_TEST_EQ(f.get(), 42);
+    }
+
+    HPX_TEST_EQ(hpx::finalize(), 0);
+    return hpx::util::report_errors();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // We force this test to use several threads by default.
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    return hpx::init(argc, argv, cfg);
+}
@@ -0,0 +1,147 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/local_lcos.hpp>
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// every task runs after all of its dependencies, in every replay
+void test_dependencies(std::size_t iterations)
+{
+    std::size_t const width = 16;
+
+    std::vector<std::size_t> stage1(width, 0);
+    std::vector<std::size_t> stage2(width, 0);
+    std::size_t total = 0;
+
+    hpx::lcos::local::task_graph g;
+
+    std::vector<hpx::lcos::local::task_graph::node_id> first;
+    for (std::size_t i = 0; i != width; ++i)
+    {
+        first.push_back(g.add([&, i]() { ++stage1[i]; }));
+    }
+
+    // each task of the second stage depends on its neighbors
+    std::vector<hpx::lcos::local::task_graph::node_id> second;
+    for (std::size_t i = 0; i != width; ++i)
+    {
+        std::size_t const left = (i + width - 1) % width;
+        std::size_t const right = (i + 1) % width;
+        second.push_back(g.add(
+            [&, i, left, right]()
+            {
+                HPX_TEST_EQ(stage1[left], stage1[i]);
+                HPX_TEST_EQ(stage1[right], stage1[i]);
+                stage2[i] = stage1[i];
+            },
+            {first[left], first[i], first[right]}));
+    }
+
+    g.add(
+        [&]()
+        {
+            for (std::size_t i = 0; i != width; ++i)
+                total += stage2[i];
+        },
+        second);
+
+    HPX_TEST_EQ(g.size(), 2 * width + 1);
+
+    for (std::size_t it = 1; it <= iterations; ++it)
+    {
+        g.run().get();
+
+        HPX_TEST_EQ(total, width * it * (it + 1) / 2);
+        for (std::size_t i = 0; i != width; ++i)
+        {
+            HPX_TEST_EQ(stage1[i], it);
+            HPX_TEST_EQ(stage2[i], it);
+        }
+    }
+
+    // no tasks can be added once the graph is instantiated
+    bool caught_exception = false;
+    try {
+        g.add([]() {});
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::invalid_status);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+// a chain of tasks is run on the given executor
+void test_executor()
+{
+    std::atomic<std::size_t> count(0);
+
+    hpx::lcos::local::task_graph g;
+    hpx::lcos::local::task_graph::node_id prev =
+        g.add([&]() { HPX_TEST_EQ(count++, std::size_t(0)); });
+    for (std::size_t i = 1; i != 100; ++i)
+    {
+        prev = g.add([&, i]() { HPX_TEST_EQ(count++, i); }, {prev});
+    }
+
+    hpx::parallel::execution::parallel_executor exec;
+    g.run(exec).get();
+    HPX_TEST_EQ(count.load(), std::size_t(100));
+
+    count = 0;
+    g.run(hpx::parallel::execution::sequenced_executor()).get();
+    HPX_TEST_EQ(count.load(), std::size_t(100));
+}
+
+// tasks can depend on tasks added before them only, the tasks after a
+// failing one are skipped
+void test_exceptions()
+{
+    hpx::lcos::local::task_graph g;
+
+    bool caught_exception = false;
+    try {
+        g.add([]() {}, {0});
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::bad_parameter);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    bool executed = false;
+    auto a = g.add([]() { throw std::runtime_error("test"); });
+    g.add([&]() { executed = true; }, {a});
+
+    for (int i = 0; i != 2; ++i)
+    {
+        hpx::future<void> f = g.run();
+        f.wait();
+        HPX_TEST(f.has_exception());
+        HPX_TEST(!executed);
+    }
+
+    // an empty graph completes immediately
+    hpx::lcos::local::task_graph empty;
+    empty.run().get();
+}
+
+int main()
+{
+    test_dependencies(100);
+    test_executor();
+    test_exceptions();
+
+    return hpx::util::report_errors();
+}
@@ -11,6 +11,7 @@
 #include <hpx/util/lightweight_test.hpp>
 
 #include <chrono>
+#include <cstddef>
 #include <deque>
 #include <list>
 #include <memory>
@@ -270,6 +271,42 @@ void test_wait_for_all_deferred_futures()
     HPX_TEST(hpx::util::get<1>(result).is_ready());
 }
 
+// many ready and not ready futures, made ready concurrently
+void test_wait_for_all_many_futures()
+{
+    std::size_t const count = 1000;
+
+    std::vector<hpx::lcos::local::promise<int> > promises(count);
+    std::vector<hpx::lcos::future<int> > futures;
+    futures.reserve(2 * count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        futures.push_back(promises[i].get_future());
+        futures.push_back(hpx::make_ready_future(int(i)));
+    }
+
+    hpx::lcos::future<std::vector<hpx::lcos::future<int> > > r =
+        hpx::when_all(futures);
+    HPX_TEST(!r.is_ready());
+
+    std::vector<hpx::lcos::future<void> > setters;
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        setters.push_back(hpx::async(
+            [&promises, i]() { promises[i].set_value(int(i)); }));
+    }
+
+    std::vector<hpx::lcos::future<int> > result = r.get();
+    HPX_TEST_EQ(result.size(), 2 * count);
+    for (std::size_t i = 0; i != 2 * count; ++i)
+    {
+        HPX_TEST(result[i].is_ready());
+        HPX_TEST_EQ(result[i].get(), int(i / 2));
+    }
+
+    hpx::wait_all(setters);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 using boost::program_options::variables_map;
 using boost::program_options::options_description;
@@ -292,6 +329,7 @@ int hpx_main(variables_map&)
         test_wait_for_all_five_futures();
         test_wait_for_all_late_futures();
         test_wait_for_all_deferred_futures();
+        test_wait_for_all_many_futures();
     }
 
     hpx::finalize();
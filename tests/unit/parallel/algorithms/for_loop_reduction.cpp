@@ -206,6 +206,62 @@ void for_loop_reduction_test_idx()
     test_for_loop_reduction_bit_or_idx(execution::par_unseq);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+struct add_vectors
+{
+    std::vector<std::size_t> operator()(std::vector<std::size_t> lhs,
+        std::vector<std::size_t> const& rhs) const
+    {
+        for (std::size_t i = 0; i != lhs.size(); ++i)
+            lhs[i] += rhs[i];
+        return lhs;
+    }
+};
+
+template <typename ExPolicy>
+void test_for_loop_reduction_vector_idx(ExPolicy && policy)
+{
+    static_assert(
+        hpx::parallel::execution::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::execution::is_execution_policy<ExPolicy>::value");
+
+    std::vector<std::size_t> c(10007);
+    std::iota(std::begin(c), std::end(c), gen());
+
+    // the views are reused by subsequent reductions, make sure they are
+    // properly reset
+    for (int k = 0; k != 3; ++k)
+    {
+        std::vector<std::size_t> bins(16, 0);
+        hpx::parallel::for_loop(
+            policy,
+            0, c.size(),
+            hpx::parallel::reduction(bins, std::vector<std::size_t>(16, 0),
+                add_vectors()),
+            [&c](std::size_t i, std::vector<std::size_t>& bins)
+            {
+                ++bins[c[i] % 16];
+            });
+
+        // verify values
+        std::vector<std::size_t> bins2(16, 0);
+        for (std::size_t v : c)
+            ++bins2[v % 16];
+        HPX_TEST(bins == bins2);
+    }
+}
+
+void for_loop_reduction_test_vector_idx()
+{
+    using namespace hpx::parallel;
+
+    test_for_loop_reduction_vector_idx(execution::seq);
+    test_for_loop_reduction_vector_idx(execution::par);
+    test_for_loop_reduction_vector_idx(execution::par_unseq);
+    test_for_loop_reduction_vector_idx(
+        execution::par.with(execution::static_chunk_size(1)));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(boost::program_options::variables_map& vm)
 {
@@ -218,6 +274,7 @@ int hpx_main(boost::program_options::variables_map& vm)
 
     for_loop_reduction_test();
     for_loop_reduction_test_idx();
+    for_loop_reduction_test_vector_idx();
 
     return hpx::finalize();
 }
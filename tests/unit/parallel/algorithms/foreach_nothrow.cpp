@@ -0,0 +1,132 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_executor_parameters.hpp>
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/include/parallel_for_each.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct increment_nothrow
+{
+    void operator()(std::size_t& v) const noexcept
+    {
+        ++v;
+    }
+};
+
+struct increment
+{
+    void operator()(std::size_t& v) const
+    {
+        ++v;
+    }
+};
+
+// the partitioners take the exception free path for noexcept functions only
+typedef std::vector<std::size_t>::iterator iterator;
+
+static_assert(
+    hpx::parallel::util::detail::is_nothrow_partition<
+        hpx::parallel::v1::detail::for_each_iteration<
+            hpx::parallel::execution::parallel_policy, increment_nothrow,
+            hpx::parallel::util::projection_identity>,
+        iterator, std::size_t, std::size_t
+    >::value,
+    "the iterations of a noexcept function are expected not to throw");
+
+static_assert(
+    !hpx::parallel::util::detail::is_nothrow_partition<
+        hpx::parallel::v1::detail::for_each_iteration<
+            hpx::parallel::execution::parallel_policy, increment,
+            hpx::parallel::util::projection_identity>,
+        iterator, std::size_t, std::size_t
+    >::value,
+    "the iterations of a function which may throw are expected to throw");
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy>
+void test_for_each_nothrow(ExPolicy && policy, std::size_t size)
+{
+    std::vector<std::size_t> c(size, 0);
+
+    iterator result = hpx::parallel::for_each(policy,
+        c.begin(), c.end(), increment_nothrow());
+    HPX_TEST(result == c.end());
+
+    std::size_t count = 0;
+    for (std::size_t v : c)
+    {
+        HPX_TEST_EQ(v, std::size_t(1));
+        ++count;
+    }
+    HPX_TEST_EQ(count, size);
+
+    // the same with a lambda
+    hpx::parallel::for_each_n(policy, c.begin(), size,
+        [](std::size_t& v) noexcept { ++v; });
+    for (std::size_t v : c)
+        HPX_TEST_EQ(v, std::size_t(2));
+}
+
+template <typename ExPolicy>
+void test_for_each_nothrow_async(ExPolicy && policy, std::size_t size)
+{
+    std::vector<std::size_t> c(size, 0);
+
+    hpx::future<iterator> f = hpx::parallel::for_each(policy,
+        c.begin(), c.end(), increment_nothrow());
+    HPX_TEST(f.get() == c.end());
+
+    for (std::size_t v : c)
+        HPX_TEST_EQ(v, std::size_t(1));
+}
+
+void test_for_each_nothrow(std::size_t size)
+{
+    using namespace hpx::parallel;
+
+    test_for_each_nothrow(execution::par, size);
+    test_for_each_nothrow(execution::par_unseq, size);
+    test_for_each_nothrow(
+        execution::par.with(execution::static_chunk_size(7)), size);
+    test_for_each_nothrow(
+        execution::par.with(execution::dynamic_chunk_size(3)), size);
+
+    test_for_each_nothrow_async(execution::par(execution::task), size);
+    test_for_each_nothrow_async(
+        execution::par(execution::task).with(
+            execution::static_chunk_size(7)),
+        size);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    for (std::size_t size : {1, 10, 100, 1000, 100007})
+        test_for_each_nothrow(size);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,154 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/parallel_generate.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/philox_engine.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "test_utils.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+struct gen_value
+{
+    double operator()(hpx::util::philox_engine& engine) const
+    {
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+        return dist(engine);
+    }
+};
+
+// the expected value of the element at the given position
+double expected_value(std::uint64_t seed, std::size_t i)
+{
+    hpx::util::philox_engine engine(seed, i);
+    return gen_value()(engine);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename IteratorTag>
+void test_generate_random(ExPolicy policy, IteratorTag)
+{
+    static_assert(
+        hpx::parallel::execution::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::execution::is_execution_policy<ExPolicy>::value");
+
+    typedef std::vector<double>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<double> c(10007);
+
+    iterator end = hpx::parallel::generate(policy,
+        iterator(std::begin(c)), iterator(std::end(c)), 42, gen_value());
+    HPX_TEST(end == iterator(std::end(c)));
+
+    for (std::size_t i = 0; i != c.size(); ++i)
+    {
+        HPX_TEST_EQ(c[i], expected_value(42, i));
+    }
+
+    // generate_n produces the same values
+    std::vector<double> d(c.size());
+    hpx::parallel::generate_n(policy,
+        iterator(std::begin(d)), d.size(), 42, gen_value());
+    HPX_TEST(c == d);
+}
+
+template <typename ExPolicy, typename IteratorTag>
+void test_generate_random_async(ExPolicy p, IteratorTag)
+{
+    typedef std::vector<double>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<double> c(10007);
+
+    hpx::future<iterator> f = hpx::parallel::generate(p,
+        iterator(std::begin(c)), iterator(std::end(c)), 43, gen_value());
+    HPX_TEST(f.get() == iterator(std::end(c)));
+
+    for (std::size_t i = 0; i != c.size(); ++i)
+    {
+        HPX_TEST_EQ(c[i], expected_value(43, i));
+    }
+}
+
+template <typename IteratorTag>
+void test_generate_random()
+{
+    using namespace hpx::parallel;
+
+    test_generate_random(execution::seq, IteratorTag());
+    test_generate_random(execution::par, IteratorTag());
+    test_generate_random(execution::par_unseq, IteratorTag());
+
+    test_generate_random_async(execution::seq(execution::task), IteratorTag());
+    test_generate_random_async(execution::par(execution::task), IteratorTag());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy>
+void test_for_loop_random(ExPolicy && policy)
+{
+    std::vector<double> c(10007);
+
+    hpx::parallel::for_loop(policy, 0, int(c.size()),
+        hpx::parallel::random_stream(44),
+        [&](int i, hpx::util::philox_engine& engine)
+        {
+            c[i] = gen_value()(engine);
+        });
+
+    for (std::size_t i = 0; i != c.size(); ++i)
+    {
+        HPX_TEST_EQ(c[i], expected_value(44, i));
+    }
+}
+
+void test_for_loop_random()
+{
+    using namespace hpx::parallel;
+
+    test_for_loop_random(execution::seq);
+    test_for_loop_random(execution::par);
+    test_for_loop_random(execution::par.with(execution::static_chunk_size(7)));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    test_generate_random<std::random_access_iterator_tag>();
+    test_generate_random<std::forward_iterator_tag>();
+    test_for_loop_random();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,239 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_histogram.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+unsigned int seed = std::random_device{}();
+std::mt19937 gen(seed);
+
+std::size_t const num_bins = 17;
+
+std::vector<int> make_values(std::size_t size)
+{
+    // include values outside of the range of the bins
+    std::uniform_int_distribution<int> dis(-3, int(num_bins) + 3);
+    std::vector<int> values(size);
+    std::generate(values.begin(), values.end(), [&]() { return dis(gen); });
+    return values;
+}
+
+std::vector<std::size_t> expected_histogram(std::vector<int> const& values)
+{
+    std::vector<std::size_t> bins(num_bins, 0);
+    for (int v : values)
+    {
+        if (v >= 0 && std::size_t(v) < num_bins)
+            ++bins[v];
+    }
+    return bins;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy>
+void test_histogram(ExPolicy policy, std::size_t size)
+{
+    std::vector<int> values = make_values(size);
+    std::vector<std::size_t> bins(num_bins + 1, 42);
+
+    auto result = hpx::parallel::histogram(policy,
+        values.begin(), values.end(), bins.begin(), num_bins,
+        [](int v) { return std::size_t(v); });
+
+    HPX_TEST(result == bins.begin() + num_bins);
+    HPX_TEST(std::equal(bins.begin(), bins.begin() + num_bins,
+        expected_histogram(values).begin()));
+    HPX_TEST_EQ(bins.back(), std::size_t(42));
+
+    // forward iterators and a projection
+    std::list<int> l(values.begin(), values.end());
+    std::vector<std::size_t> lbins(num_bins, 0);
+    hpx::parallel::histogram(policy, l.begin(), l.end(), lbins.begin(),
+        num_bins, [](int v) { return std::size_t(v); },
+        [](int v) { return v + 1; });
+
+    std::vector<int> shifted(values);
+    for (int& v : shifted)
+        ++v;
+    HPX_TEST(lbins == expected_histogram(shifted));
+}
+
+template <typename ExPolicy>
+void test_histogram_async(ExPolicy policy, std::size_t size)
+{
+    std::vector<int> values = make_values(size);
+    std::vector<std::size_t> bins(num_bins, 0);
+
+    auto f = hpx::parallel::histogram(policy,
+        values.begin(), values.end(), bins.begin(), num_bins,
+        [](int v) { return std::size_t(v); });
+
+    HPX_TEST(f.get() == bins.end());
+    HPX_TEST(bins == expected_histogram(values));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy>
+void test_bucketize(ExPolicy policy, std::size_t size)
+{
+    std::vector<int> values = make_values(size);
+    std::vector<int> bounds = { 0, 4, 5, 10 };
+    std::vector<std::size_t> bins(bounds.size() + 1, 0);
+
+    auto result = hpx::parallel::bucketize(policy,
+        values.begin(), values.end(), bounds.begin(), bounds.end(),
+        bins.begin());
+    HPX_TEST(result == bins.end());
+
+    std::vector<std::size_t> expected(bounds.size() + 1, 0);
+    for (int v : values)
+    {
+        ++expected[std::upper_bound(bounds.begin(), bounds.end(), v) -
+            bounds.begin()];
+    }
+    HPX_TEST(bins == expected);
+
+    // descending boundaries with a custom comparison
+    std::vector<int> rbounds(bounds.rbegin(), bounds.rend());
+    std::vector<std::size_t> rbins(rbounds.size() + 1, 0);
+    hpx::parallel::bucketize(policy, values.begin(), values.end(),
+        rbounds.begin(), rbounds.end(), rbins.begin(), std::greater<int>());
+    HPX_TEST(std::equal(rbins.begin(), rbins.end(), expected.rbegin()));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy>
+void test_group_by(ExPolicy policy, std::size_t size)
+{
+    std::vector<int> values = make_values(size);
+
+    // tag each element with its position to verify stability
+    std::vector<std::pair<int, std::size_t> > tagged(size);
+    for (std::size_t i = 0; i != size; ++i)
+        tagged[i] = std::make_pair(values[i], i);
+
+    std::vector<std::pair<int, std::size_t> > dest(size);
+    std::vector<std::size_t> offsets(num_bins + 1);
+
+    auto result = hpx::parallel::group_by(policy,
+        tagged.begin(), tagged.end(), dest.begin(), offsets.begin(),
+        num_bins, [](int v) { return std::size_t(v); },
+        [](std::pair<int, std::size_t> const& p) { return p.first; });
+
+    std::vector<std::pair<int, std::size_t> > expected;
+    std::vector<std::size_t> expected_offsets;
+    for (std::size_t g = 0; g != num_bins; ++g)
+    {
+        expected_offsets.push_back(expected.size());
+        for (auto const& p : tagged)
+        {
+            if (p.first == int(g))
+                expected.push_back(p);
+        }
+    }
+    expected_offsets.push_back(expected.size());
+
+    HPX_TEST(result.first == dest.begin() + expected.size());
+    HPX_TEST(result.second == offsets.end());
+    HPX_TEST(offsets == expected_offsets);
+    HPX_TEST(std::equal(expected.begin(), expected.end(), dest.begin()));
+}
+
+template <typename ExPolicy>
+void test_group_by_async(ExPolicy policy, std::size_t size)
+{
+    std::vector<int> values = make_values(size);
+    std::vector<int> dest(size);
+    std::vector<std::size_t> offsets(num_bins + 1);
+
+    auto f = hpx::parallel::group_by(policy,
+        values.begin(), values.end(), dest.begin(), offsets.begin(),
+        num_bins, [](int v) { return std::size_t(v); });
+
+    auto result = f.get();
+    HPX_TEST(result.second == offsets.end());
+
+    std::vector<std::size_t> bins = expected_histogram(values);
+    for (std::size_t g = 0; g != num_bins; ++g)
+    {
+        HPX_TEST_EQ(offsets[g + 1] - offsets[g], bins[g]);
+        for (std::size_t i = offsets[g]; i != offsets[g + 1]; ++i)
+            HPX_TEST_EQ(dest[i], int(g));
+    }
+    HPX_TEST(result.first == dest.begin() + offsets[num_bins]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void histogram_test()
+{
+    using namespace hpx::parallel;
+
+    for (std::size_t size : { std::size_t(0), std::size_t(13),
+             std::size_t(10007), std::size_t(100007) })
+    {
+        test_histogram(execution::seq, size);
+        test_histogram(execution::par, size);
+        test_histogram(execution::par_unseq, size);
+
+        test_histogram_async(execution::seq(execution::task), size);
+        test_histogram_async(execution::par(execution::task), size);
+
+        test_bucketize(execution::seq, size);
+        test_bucketize(execution::par, size);
+
+        test_group_by(execution::seq, size);
+        test_group_by(execution::par, size);
+
+        test_group_by_async(execution::seq(execution::task), size);
+        test_group_by_async(execution::par(execution::task), size);
+    }
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    gen.seed(seed);
+
+    histogram_test();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
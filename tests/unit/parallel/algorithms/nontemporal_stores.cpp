@@ -0,0 +1,186 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The algorithms write large ranges of trivially copyable values using
+// non-temporal stores. Verify those for ranges exceeding the threshold and
+// for destinations which are not aligned.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_copy.hpp>
+#include <hpx/include/parallel_fill.hpp>
+#include <hpx/include/parallel_move.hpp>
+#include <hpx/include/parallel_transform.hpp>
+#include <hpx/include/parallel_uninitialized_fill.hpp>
+#include <hpx/parallel/util/detail/nontemporal_store.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+unsigned int seed = std::random_device{}();
+std::mt19937 gen(seed);
+
+// a type which does not evenly divide the vector register size
+struct triple
+{
+    std::int32_t a, b, c;
+};
+
+bool operator==(triple const& lhs, triple const& rhs)
+{
+    return lhs.a == rhs.a && lhs.b == rhs.b && lhs.c == rhs.c;
+}
+
+triple make_value(std::size_t i, triple*)
+{
+    return triple{ std::int32_t(i), std::int32_t(i + 1), std::int32_t(i + 2) };
+}
+
+template <typename T>
+T make_value(std::size_t i, T*)
+{
+    return T(i);
+}
+
+template <typename T>
+T make_value(std::size_t i)
+{
+    return make_value(i, static_cast<T*>(nullptr));
+}
+
+template <typename T>
+std::size_t nontemporal_size()
+{
+    // make sure the threshold is exceeded and the size is odd
+    return HPX_PARALLEL_NONTEMPORAL_STORE_THRESHOLD / sizeof(T) + 1025;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename T>
+void test_nontemporal(ExPolicy policy, std::size_t offset)
+{
+    std::size_t const size = nontemporal_size<T>();
+
+    std::vector<T> src(size);
+    for (std::size_t i = 0; i != size; ++i)
+        src[i] = make_value<T>(i + gen() % 7);
+
+    std::vector<T> storage(size + offset);
+    T* dest = storage.data() + offset;
+
+    // copy
+    hpx::parallel::copy(policy, src.data(), src.data() + size, dest);
+    for (std::size_t i = 0; i != size; ++i)
+        HPX_TEST(dest[i] == src[i]);
+
+    // copy_n
+    std::fill(storage.begin(), storage.end(), T());
+    hpx::parallel::copy_n(policy, src.data(), size, dest);
+    for (std::size_t i = 0; i != size; ++i)
+        HPX_TEST(dest[i] == src[i]);
+
+    // move
+    std::fill(storage.begin(), storage.end(), T());
+    hpx::parallel::move(policy, src.data(), src.data() + size, dest);
+    for (std::size_t i = 0; i != size; ++i)
+        HPX_TEST(dest[i] == src[i]);
+
+    // fill
+    T const value = make_value<T>(gen() % 127);
+    hpx::parallel::fill(policy, dest, dest + size, value);
+    for (std::size_t i = 0; i != size; ++i)
+        HPX_TEST(dest[i] == value);
+
+    // fill_n
+    T const value_n = make_value<T>(gen() % 127);
+    hpx::parallel::fill_n(policy, dest, size, value_n);
+    for (std::size_t i = 0; i != size; ++i)
+        HPX_TEST(dest[i] == value_n);
+
+    // uninitialized_fill
+    std::fill(storage.begin(), storage.end(), T());
+    hpx::parallel::uninitialized_fill(policy, dest, dest + size, value);
+    for (std::size_t i = 0; i != size; ++i)
+        HPX_TEST(dest[i] == value);
+
+    // transform
+    hpx::parallel::transform(policy, src.data(), src.data() + size, dest,
+        [](T const& t) { return t; });
+    for (std::size_t i = 0; i != size; ++i)
+        HPX_TEST(dest[i] == src[i]);
+
+    // binary transform
+    std::fill(storage.begin(), storage.end(), T());
+    hpx::parallel::transform(policy, src.data(), src.data() + size,
+        src.data(), dest,
+        [](T const& t, T const&) { return t; });
+    for (std::size_t i = 0; i != size; ++i)
+        HPX_TEST(dest[i] == src[i]);
+
+    // the elements outside of the destination range are not touched
+    for (std::size_t i = 0; i != offset; ++i)
+        HPX_TEST(storage[i] == T());
+}
+
+template <typename T>
+void test_nontemporal()
+{
+    using namespace hpx::parallel;
+
+    test_nontemporal<execution::parallel_policy, T>(execution::par, 0);
+    test_nontemporal<execution::parallel_policy, T>(execution::par, 1);
+    test_nontemporal<execution::parallel_policy, T>(execution::par, 3);
+}
+
+void nontemporal_test()
+{
+    test_nontemporal<char>();
+    test_nontemporal<std::uint16_t>();
+    test_nontemporal<double>();
+    test_nontemporal<triple>();
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    gen.seed(seed);
+
+    nontemporal_test();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,173 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+std::mt19937 gen;
+
+///////////////////////////////////////////////////////////////////////////////
+// check that nth holds the element it would hold if the range was sorted and
+// that the range is partitioned around it
+template <typename T, typename Compare>
+void verify_nth_element(std::vector<T> const& c, std::vector<T> const& sorted,
+    std::size_t nth, Compare comp)
+{
+    if (nth == c.size())
+        return;
+
+    HPX_TEST(!comp(c[nth], sorted[nth]) && !comp(sorted[nth], c[nth]));
+
+    bool partitioned = true;
+    for (std::size_t i = 0; i != nth; ++i)
+        partitioned = partitioned && !comp(c[nth], c[i]);
+    for (std::size_t i = nth + 1; i < c.size(); ++i)
+        partitioned = partitioned && !comp(c[i], c[nth]);
+    HPX_TEST(partitioned);
+}
+
+template <typename ExPolicy, typename Compare = std::less<int> >
+void test_nth_element(ExPolicy && policy, std::size_t size, int max_value,
+    Compare comp = Compare())
+{
+    std::uniform_int_distribution<int> dis(0, max_value);
+
+    std::vector<int> c(size);
+    std::generate(c.begin(), c.end(), [&]() { return dis(gen); });
+
+    std::vector<int> sorted(c);
+    std::sort(sorted.begin(), sorted.end(), comp);
+
+    std::size_t const positions[] = { 0, size / 3, size / 2, size - 1, size };
+    for (std::size_t nth : positions)
+    {
+        if (nth > size)
+            continue;
+
+        std::vector<int> d(c);
+        auto result = hpx::parallel::nth_element(policy,
+            d.begin(), d.begin() + nth, d.end(), comp);
+        HPX_TEST(result == d.end());
+
+        verify_nth_element(d, sorted, nth, comp);
+    }
+}
+
+template <typename ExPolicy>
+void test_nth_element_async(ExPolicy && policy, std::size_t size)
+{
+    std::uniform_int_distribution<int> dis(0, 1000000);
+
+    std::vector<int> c(size);
+    std::generate(c.begin(), c.end(), [&]() { return dis(gen); });
+
+    std::vector<int> sorted(c);
+    std::sort(sorted.begin(), sorted.end());
+
+    hpx::future<std::vector<int>::iterator> f =
+        hpx::parallel::nth_element(policy,
+            c.begin(), c.begin() + size / 2, c.end());
+    HPX_TEST(f.get() == c.end());
+
+    verify_nth_element(c, sorted, size / 2, std::less<int>());
+}
+
+template <typename ExPolicy>
+void test_nth_element_proj(ExPolicy && policy, std::size_t size)
+{
+    std::uniform_int_distribution<int> dis(0, 1000000);
+
+    std::vector<std::pair<int, std::size_t> > c;
+    for (std::size_t i = 0; i != size; ++i)
+        c.push_back(std::make_pair(dis(gen), i));
+
+    std::size_t nth = size / 4;
+    hpx::parallel::nth_element(policy, c.begin(), c.begin() + nth, c.end(),
+        std::greater<int>(),
+        [](std::pair<int, std::size_t> const& p) { return p.first; });
+
+    bool partitioned = true;
+    for (std::size_t i = 0; i != nth; ++i)
+        partitioned = partitioned && c[i].first >= c[nth].first;
+    for (std::size_t i = nth + 1; i < size; ++i)
+        partitioned = partitioned && c[i].first <= c[nth].first;
+    HPX_TEST(partitioned);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_nth_element()
+{
+    using namespace hpx::parallel;
+
+    std::size_t const sizes[] = { 0, 1, 1000, 65537, 1000000 };
+    for (std::size_t size : sizes)
+    {
+        test_nth_element(execution::seq, size, 1000000);
+        test_nth_element(execution::par, size, 1000000);
+        test_nth_element(execution::par_unseq, size, 1000000);
+
+        // many duplicates
+        test_nth_element(execution::par, size, 3);
+        test_nth_element(execution::par, size, 0);
+
+        test_nth_element(execution::seq, size, 1000000, std::greater<int>());
+        test_nth_element(execution::par, size, 1000000, std::greater<int>());
+
+        test_nth_element_async(execution::seq(execution::task), size);
+        test_nth_element_async(execution::par(execution::task), size);
+
+        test_nth_element_proj(execution::seq, size);
+        test_nth_element_proj(execution::par, size);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    gen.seed(seed);
+
+    test_nth_element();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run");
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
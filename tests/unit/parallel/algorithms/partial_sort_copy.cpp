@@ -0,0 +1,160 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+std::mt19937 gen;
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename Compare = std::less<int> >
+void test_partial_sort_copy(ExPolicy && policy, std::size_t size,
+    int max_value, Compare comp = Compare())
+{
+    std::uniform_int_distribution<int> dis(0, max_value);
+
+    std::vector<int> c(size);
+    std::generate(c.begin(), c.end(), [&]() { return dis(gen); });
+
+    std::vector<int> sorted(c);
+    std::sort(sorted.begin(), sorted.end(), comp);
+
+    // destination ranges smaller and larger than the input
+    std::size_t const dest_sizes[] = { 0, 1, 100, size / 2, size, size + 10 };
+    for (std::size_t dest_size : dest_sizes)
+    {
+        std::vector<int> d(dest_size, -1);
+        auto result = hpx::parallel::partial_sort_copy(policy,
+            c.begin(), c.end(), d.begin(), d.end(), comp);
+
+        std::size_t count = (std::min)(size, dest_size);
+        HPX_TEST(result == d.begin() + count);
+        HPX_TEST(std::equal(d.begin(), d.begin() + count, sorted.begin()));
+        HPX_TEST(std::count(d.begin() + count, d.end(), -1) ==
+            std::ptrdiff_t(dest_size - count));
+    }
+}
+
+template <typename ExPolicy>
+void test_partial_sort_copy_async(ExPolicy && policy, std::size_t size)
+{
+    std::uniform_int_distribution<int> dis(0, 1000000);
+
+    std::vector<int> c(size);
+    std::generate(c.begin(), c.end(), [&]() { return dis(gen); });
+
+    std::vector<int> sorted(c);
+    std::sort(sorted.begin(), sorted.end());
+
+    std::vector<int> d(size / 10);
+    hpx::future<std::vector<int>::iterator> f =
+        hpx::parallel::partial_sort_copy(policy,
+            c.begin(), c.end(), d.begin(), d.end());
+    HPX_TEST(f.get() == d.end());
+
+    HPX_TEST(std::equal(d.begin(), d.end(), sorted.begin()));
+}
+
+template <typename ExPolicy>
+void test_partial_sort_copy_proj(ExPolicy && policy, std::size_t size)
+{
+    std::uniform_int_distribution<int> dis(0, 1000000);
+
+    std::vector<std::pair<int, std::size_t> > c;
+    for (std::size_t i = 0; i != size; ++i)
+        c.push_back(std::make_pair(dis(gen), i));
+
+    std::vector<int> sorted;
+    for (auto const& p : c)
+        sorted.push_back(p.first);
+    std::sort(sorted.begin(), sorted.end(), std::greater<int>());
+
+    std::vector<std::pair<int, std::size_t> > d(size / 4);
+    hpx::parallel::partial_sort_copy(policy, c.begin(), c.end(),
+        d.begin(), d.end(), std::greater<int>(),
+        [](std::pair<int, std::size_t> const& p) { return p.first; });
+
+    bool is_sorted = true;
+    for (std::size_t i = 0; i != d.size(); ++i)
+        is_sorted = is_sorted && d[i].first == sorted[i];
+    HPX_TEST(is_sorted);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_partial_sort_copy()
+{
+    using namespace hpx::parallel;
+
+    std::size_t const sizes[] = { 0, 1, 1000, 65537, 1000000 };
+    for (std::size_t size : sizes)
+    {
+        test_partial_sort_copy(execution::seq, size, 1000000);
+        test_partial_sort_copy(execution::par, size, 1000000);
+        test_partial_sort_copy(execution::par_unseq, size, 1000000);
+
+        // many duplicates
+        test_partial_sort_copy(execution::par, size, 3);
+
+        test_partial_sort_copy(execution::seq, size, 1000000,
+            std::greater<int>());
+        test_partial_sort_copy(execution::par, size, 1000000,
+            std::greater<int>());
+
+        test_partial_sort_copy_async(execution::seq(execution::task), size);
+        test_partial_sort_copy_async(execution::par(execution::task), size);
+
+        test_partial_sort_copy_proj(execution::seq, size);
+        test_partial_sort_copy_proj(execution::par, size);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    gen.seed(seed);
+
+    test_partial_sort_copy();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run");
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -182,6 +182,63 @@ void set_union_test2()
 #endif
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Many equivalent elements, which have to be kept together in one chunk
+template <typename ExPolicy, typename IteratorTag>
+void test_set_union3(ExPolicy policy, IteratorTag)
+{
+    static_assert(
+        hpx::parallel::execution::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::execution::is_execution_policy<ExPolicy>::value");
+
+    typedef std::vector<std::size_t>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<std::size_t> c1 = test::random_fill(10007);
+    std::vector<std::size_t> c2 = test::random_fill(2 * c1.size());
+
+    for (std::size_t& v : c1)
+        v %= 17;
+    for (std::size_t& v : c2)
+        v %= 23;
+
+    std::sort(std::begin(c1), std::end(c1));
+    std::sort(std::begin(c2), std::end(c2));
+
+    std::vector<std::size_t> c3(3*c1.size()), c4(3*c1.size()); //-V656
+
+    auto result = hpx::parallel::set_union(policy,
+        iterator(std::begin(c1)), iterator(std::end(c1)),
+        std::begin(c2), std::end(c2), std::begin(c3));
+
+    auto expected = std::set_union(std::begin(c1), std::end(c1),
+        std::begin(c2), std::end(c2), std::begin(c4));
+
+    // verify values
+    HPX_TEST(std::distance(std::begin(c3), result) ==
+        std::distance(std::begin(c4), expected));
+    HPX_TEST(std::equal(std::begin(c3), std::end(c3), std::begin(c4)));
+}
+
+template <typename IteratorTag>
+void test_set_union3()
+{
+    using namespace hpx::parallel;
+
+    test_set_union3(execution::seq, IteratorTag());
+    test_set_union3(execution::par, IteratorTag());
+    test_set_union3(execution::par_unseq, IteratorTag());
+}
+
+void set_union_test3()
+{
+    test_set_union3<std::random_access_iterator_tag>();
+    test_set_union3<std::forward_iterator_tag>();
+#if defined(HPX_HAVE_ALGORITHM_INPUT_ITERATOR_SUPPORT)
+    test_set_union3<std::input_iterator_tag>();
+#endif
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 template <typename ExPolicy, typename IteratorTag>
 void test_set_union_exception(ExPolicy policy, IteratorTag)
@@ -426,6 +483,7 @@ int hpx_main(boost::program_options::variables_map& vm)
 
     set_union_test1();
     set_union_test2();
+    set_union_test3();
     set_union_exception_test();
     set_union_bad_alloc_test();
     return hpx::finalize();
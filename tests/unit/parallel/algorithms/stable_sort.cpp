@@ -0,0 +1,236 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// use smaller array sizes for debug tests
+#if defined(HPX_DEBUG)
+#define HPX_STABLE_SORT_TEST_SIZE 100000
+#else
+#define HPX_STABLE_SORT_TEST_SIZE 1000000
+#endif
+
+std::mt19937 gen;
+
+///////////////////////////////////////////////////////////////////////////////
+struct element
+{
+    element() : key(0), index(0) {}
+    element(int k, std::size_t i) : key(k), index(i) {}
+
+    int key;
+    std::size_t index;
+};
+
+bool operator==(element const& lhs, element const& rhs)
+{
+    return lhs.key == rhs.key && lhs.index == rhs.index;
+}
+
+std::vector<element> make_elements(std::size_t size, int max_key)
+{
+    std::uniform_int_distribution<int> dis(-max_key, max_key);
+
+    std::vector<element> c;
+    c.reserve(size);
+    for (std::size_t i = 0; i != size; ++i)
+        c.push_back(element(dis(gen), i));
+    return c;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// equal keys have to keep their order, this is checked for comparison based
+// sorting (user supplied comparison operator) and radix sorting (projection
+// onto an arithmetic key)
+template <typename ExPolicy>
+void test_stable_sort_comp(ExPolicy && policy, std::size_t size)
+{
+    std::vector<element> c = make_elements(size, 1000);
+    std::vector<element> expected(c);
+
+    auto comp = [](element const& lhs, element const& rhs)
+        {
+            return lhs.key < rhs.key;
+        };
+    std::stable_sort(expected.begin(), expected.end(), comp);
+
+    hpx::parallel::stable_sort(std::forward<ExPolicy>(policy),
+        c.begin(), c.end(), comp);
+
+    HPX_TEST(c == expected);
+}
+
+template <typename ExPolicy>
+void test_stable_sort_proj(ExPolicy && policy, std::size_t size)
+{
+    std::vector<element> c = make_elements(size, 1000);
+    std::vector<element> expected(c);
+
+    std::stable_sort(expected.begin(), expected.end(),
+        [](element const& lhs, element const& rhs)
+        {
+            return lhs.key < rhs.key;
+        });
+
+    hpx::parallel::stable_sort(std::forward<ExPolicy>(policy),
+        c.begin(), c.end(), std::less<int>(),
+        [](element const& e) { return e.key; });
+
+    HPX_TEST(c == expected);
+}
+
+template <typename ExPolicy>
+void test_stable_sort_async(ExPolicy && policy, std::size_t size)
+{
+    std::vector<element> c = make_elements(size, 10);
+    std::vector<element> expected(c);
+
+    auto comp = [](element const& lhs, element const& rhs)
+        {
+            return lhs.key < rhs.key;
+        };
+    std::stable_sort(expected.begin(), expected.end(), comp);
+
+    hpx::future<std::vector<element>::iterator> f =
+        hpx::parallel::stable_sort(std::forward<ExPolicy>(policy),
+            c.begin(), c.end(), comp);
+    HPX_TEST(f.get() == c.end());
+
+    HPX_TEST(c == expected);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T, typename Distribution>
+std::vector<T> make_values(std::size_t size, Distribution dis)
+{
+    std::vector<T> c;
+    c.reserve(size);
+    for (std::size_t i = 0; i != size; ++i)
+        c.push_back(T(dis(gen)));
+    return c;
+}
+
+template <typename ExPolicy, typename T, typename Compare = std::less<T> >
+void test_sort(ExPolicy && policy, std::vector<T> c, Compare comp = Compare())
+{
+    std::vector<T> expected(c);
+    std::sort(expected.begin(), expected.end(), comp);
+
+    // sort and stable_sort both select the radix sort for arithmetic values
+    std::vector<T> d(c);
+    hpx::parallel::sort(policy, d.begin(), d.end(), comp);
+    HPX_TEST(d == expected);
+
+    hpx::parallel::stable_sort(policy, c.begin(), c.end(), comp);
+    HPX_TEST(c == expected);
+}
+
+template <typename ExPolicy>
+void test_sort_values(ExPolicy && policy, std::size_t size)
+{
+    test_sort(policy, make_values<int>(size,
+        std::uniform_int_distribution<int>(-1000000, 1000000)));
+    test_sort(policy, make_values<std::uint64_t>(size,
+        std::uniform_int_distribution<std::uint64_t>()));
+    test_sort(policy, make_values<std::int64_t>(size,
+        std::uniform_int_distribution<std::int64_t>()));
+    test_sort(policy, make_values<char>(size,
+        std::uniform_int_distribution<int>(-128, 127)));
+    test_sort(policy, make_values<float>(size,
+        std::uniform_real_distribution<float>(-1e6f, 1e6f)));
+    test_sort(policy, make_values<double>(size,
+        std::uniform_real_distribution<double>(-1e100, 1e100)));
+
+    // all keys are equal
+    test_sort(policy, std::vector<int>(size, 42));
+
+    test_sort(policy, make_values<double>(size,
+        std::uniform_real_distribution<double>(-1e6, 1e6)),
+        std::greater<double>());
+
+    std::uniform_int_distribution<std::size_t> length(0, 16);
+    std::vector<std::string> strings;
+    for (std::size_t i = 0; i != size / 10; ++i)
+        strings.push_back(std::string(length(gen), char('a' + i % 26)));
+    test_sort(policy, strings);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_stable_sort()
+{
+    using namespace hpx::parallel;
+
+    std::size_t const sizes[] = {
+        0, 1, 100, 65537, HPX_STABLE_SORT_TEST_SIZE
+    };
+
+    for (std::size_t size : sizes)
+    {
+        test_stable_sort_comp(execution::seq, size);
+        test_stable_sort_comp(execution::par, size);
+        test_stable_sort_comp(execution::par_unseq, size);
+
+        test_stable_sort_proj(execution::seq, size);
+        test_stable_sort_proj(execution::par, size);
+        test_stable_sort_proj(execution::par_unseq, size);
+
+        test_stable_sort_async(execution::seq(execution::task), size);
+        test_stable_sort_async(execution::par(execution::task), size);
+
+        test_sort_values(execution::seq, size);
+        test_sort_values(execution::par, size);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    gen.seed(seed);
+
+    test_stable_sort();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run");
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,242 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_container_algorithm.hpp>
+#include <hpx/include/parallel_reduce.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <list>
+#include <numeric>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy>
+void test_transform_view(ExPolicy policy)
+{
+    using namespace hpx::parallel;
+
+    std::vector<int> c(10007);
+    std::iota(c.begin(), c.end(), std::rand() % 1000);
+
+    auto squares = views::transform(c, [](int v) { return 2 * v; });
+
+    std::vector<int> d(c.size());
+    auto result = copy(policy, squares, d.begin());
+    HPX_TEST(result.out() == d.end());
+    for (std::size_t i = 0; i != c.size(); ++i)
+        HPX_TEST_EQ(d[i], 2 * c[i]);
+
+    int sum = reduce(policy, squares, 0);
+    HPX_TEST_EQ(sum, 2 * std::accumulate(c.begin(), c.end(), 0));
+}
+
+template <typename ExPolicy>
+void test_filter_view(ExPolicy policy)
+{
+    using namespace hpx::parallel;
+
+    std::vector<int> c(10007);
+    std::iota(c.begin(), c.end(), std::rand() % 1000);
+
+    auto is_odd = [](int v) { return v % 2 != 0; };
+    auto odd = views::filter(c, is_odd);
+
+    std::vector<int> expected;
+    std::copy_if(c.begin(), c.end(), std::back_inserter(expected), is_odd);
+
+    // copy compacts the elements satisfying the predicate
+    std::vector<int> d(c.size(), 0);
+    auto result = copy(policy, odd, d.begin());
+    HPX_TEST(result.in() == odd.end());
+    HPX_TEST(result.out() == d.begin() + expected.size());
+    HPX_TEST(std::equal(expected.begin(), expected.end(), d.begin()));
+
+    // for_each visits the elements satisfying the predicate only
+    std::atomic<std::size_t> count(0);
+    auto it = for_each(policy, odd,
+        [&count](int v)
+        {
+            HPX_TEST(v % 2 != 0);
+            ++count;
+        });
+    HPX_TEST(it == odd.end());
+    HPX_TEST_EQ(count.load(), expected.size());
+
+    // reduce skips the elements not satisfying the predicate
+    int sum = reduce(policy, odd, 42);
+    HPX_TEST_EQ(sum,
+        std::accumulate(expected.begin(), expected.end(), 42));
+
+    // a filter view without any matching elements
+    auto none = views::filter(c, [](int) { return false; });
+    HPX_TEST_EQ(reduce(policy, none, 42), 42);
+    HPX_TEST(copy(policy, none, d.begin()).out() == d.begin());
+}
+
+template <typename ExPolicy>
+void test_fused_pipeline(ExPolicy policy)
+{
+    using namespace hpx::parallel;
+
+    std::vector<int> c(10007);
+    std::iota(c.begin(), c.end(), std::rand() % 1000);
+
+    // transform -> filter -> reduce in a single pass over the input
+    auto pipeline = views::filter(
+        views::transform(c, [](int v) { return 3 * v; }),
+        [](int v) { return v % 2 == 0; });
+
+    int expected = 0;
+    for (int v : c)
+    {
+        if ((3 * v) % 2 == 0)
+            expected += 3 * v;
+    }
+    HPX_TEST_EQ(reduce(policy, pipeline, 0), expected);
+}
+
+template <typename ExPolicy>
+void test_zip_enumerate(ExPolicy policy)
+{
+    using namespace hpx::parallel;
+
+    std::vector<int> a(10007), b(10007);
+    std::iota(a.begin(), a.end(), std::rand() % 1000);
+    std::iota(b.begin(), b.end(), std::rand() % 1000);
+
+    std::vector<int> d(a.size());
+    auto sums = views::transform(views::zip(a, b),
+        [](hpx::util::tuple<int&, int&> t)
+        {
+            return hpx::util::get<0>(t) + hpx::util::get<1>(t);
+        });
+    copy(policy, sums, d.begin());
+    for (std::size_t i = 0; i != a.size(); ++i)
+        HPX_TEST_EQ(d[i], a[i] + b[i]);
+
+    // writing through the zipped references
+    for_each(policy, views::zip(a, b),
+        [](hpx::util::tuple<int&, int&> t)
+        {
+            hpx::util::get<1>(t) = hpx::util::get<0>(t);
+        });
+    HPX_TEST(a == b);
+
+    std::vector<std::size_t> positions(a.size(), 0);
+    for_each(policy, views::enumerate(a),
+        [&positions](hpx::util::tuple<std::size_t, int&> t)
+        {
+            positions[hpx::util::get<0>(t)] = hpx::util::get<0>(t) + 1;
+        });
+    for (std::size_t i = 0; i != positions.size(); ++i)
+        HPX_TEST_EQ(positions[i], i + 1);
+}
+
+template <typename ExPolicy>
+void test_views(ExPolicy policy)
+{
+    test_transform_view(policy);
+    test_filter_view(policy);
+    test_fused_pipeline(policy);
+    test_zip_enumerate(policy);
+}
+
+template <typename ExPolicy>
+void test_views_async(ExPolicy policy)
+{
+    using namespace hpx::parallel;
+
+    std::vector<int> c(10007);
+    std::iota(c.begin(), c.end(), std::rand() % 1000);
+
+    auto is_odd = [](int v) { return v % 2 != 0; };
+    auto odd = views::filter(c, is_odd);
+
+    std::vector<int> expected;
+    std::copy_if(c.begin(), c.end(), std::back_inserter(expected), is_odd);
+
+    std::vector<int> d(c.size(), 0);
+    auto f = copy(policy, odd, d.begin());
+    HPX_TEST(f.get().out() == d.begin() + expected.size());
+    HPX_TEST(std::equal(expected.begin(), expected.end(), d.begin()));
+
+    hpx::future<int> sum = reduce(policy, odd, 0);
+    HPX_TEST_EQ(sum.get(),
+        std::accumulate(expected.begin(), expected.end(), 0));
+
+    auto it = for_each(policy, odd, [](int v) { HPX_TEST(v % 2 != 0); });
+    HPX_TEST(it.get() == odd.end());
+}
+
+void views_test()
+{
+    using namespace hpx::parallel;
+
+    test_views(execution::seq);
+    test_views(execution::par);
+
+    test_views_async(execution::seq(execution::task));
+    test_views_async(execution::par(execution::task));
+
+    // views of forward ranges
+    std::list<int> l(1007);
+    std::iota(l.begin(), l.end(), 0);
+    int sum = reduce(execution::par,
+        views::filter(views::transform(l, [](int v) { return v + 1; }),
+            [](int v) { return v % 3 == 0; }),
+        0);
+    int expected = 0;
+    for (int v : l)
+    {
+        if ((v + 1) % 3 == 0)
+            expected += v + 1;
+    }
+    HPX_TEST_EQ(sum, expected);
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    views_test();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
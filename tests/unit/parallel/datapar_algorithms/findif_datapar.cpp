@@ -0,0 +1,119 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/datapar.hpp>
+#include <hpx/include/parallel_find.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <ctime>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "../algorithms/test_utils.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+struct equal_to_one
+{
+    template <typename T>
+    auto operator()(T const& x) const -> decltype(x == 1)
+    {
+        return x == 1;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename IteratorTag>
+void test_find_if(ExPolicy policy, IteratorTag)
+{
+    typedef std::vector<int>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<int> c(10007, 0);
+
+    // no match
+    iterator index = hpx::parallel::find_if(policy,
+        iterator(std::begin(c)), iterator(std::end(c)), equal_to_one());
+    HPX_TEST(index == iterator(std::end(c)));
+
+    // the first match is reported, regardless of its position in the
+    // vector-pack, the last element always matches as well
+    c.back() = 1;
+
+    std::size_t const positions[] = { 0, 1, 17, 5003, 10005, 10006 };
+    for (std::size_t pos : positions)
+    {
+        c[pos] = 1;
+
+        index = hpx::parallel::find_if(policy,
+            iterator(std::begin(c)), iterator(std::end(c)), equal_to_one());
+        HPX_TEST(index == iterator(std::begin(c) + pos));
+
+        index = hpx::parallel::find(policy,
+            iterator(std::begin(c)), iterator(std::end(c)), 1);
+        HPX_TEST(index == iterator(std::begin(c) + pos));
+
+        c[pos] = 0;
+        c.back() = 1;
+    }
+}
+
+template <typename IteratorTag>
+void test_find_if()
+{
+    using namespace hpx::parallel;
+
+    test_find_if(execution::dataseq, IteratorTag());
+    test_find_if(execution::datapar, IteratorTag());
+}
+
+void find_if_test()
+{
+    test_find_if<std::random_access_iterator_tag>();
+    test_find_if<std::forward_iterator_tag>();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    find_if_test();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+         "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,128 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/datapar.hpp>
+#include <hpx/include/parallel_equal.hpp>
+#include <hpx/include/parallel_mismatch.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <ctime>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../algorithms/test_utils.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+struct equal_to
+{
+    template <typename T>
+    auto operator()(T const& lhs, T const& rhs) const -> decltype(lhs == rhs)
+    {
+        return lhs == rhs;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename IteratorTag>
+void test_mismatch(ExPolicy policy, IteratorTag)
+{
+    typedef std::vector<int>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<int> c1(10007);
+    std::iota(std::begin(c1), std::end(c1), std::rand() % 100);
+    std::vector<int> c2(c1);
+
+    {
+        auto result = hpx::parallel::mismatch(policy,
+            iterator(std::begin(c1)), iterator(std::end(c1)),
+            std::begin(c2), equal_to());
+        HPX_TEST(result.first == iterator(std::end(c1)));
+        HPX_TEST(result.second == std::end(c2));
+
+        HPX_TEST(hpx::parallel::equal(policy,
+            iterator(std::begin(c1)), iterator(std::end(c1)),
+            std::begin(c2), equal_to()));
+    }
+
+    std::size_t const positions[] = { 0, 3, 4099, 10006 };
+    for (std::size_t pos : positions)
+    {
+        ++c1[pos];
+
+        auto result = hpx::parallel::mismatch(policy,
+            iterator(std::begin(c1)), iterator(std::end(c1)),
+            std::begin(c2), equal_to());
+        HPX_TEST(result.first == iterator(std::begin(c1) + pos));
+        HPX_TEST(result.second == std::begin(c2) + pos);
+
+        HPX_TEST(!hpx::parallel::equal(policy,
+            iterator(std::begin(c1)), iterator(std::end(c1)),
+            std::begin(c2), equal_to()));
+
+        --c1[pos];
+    }
+}
+
+template <typename IteratorTag>
+void test_mismatch()
+{
+    using namespace hpx::parallel;
+
+    test_mismatch(execution::dataseq, IteratorTag());
+    test_mismatch(execution::datapar, IteratorTag());
+}
+
+void mismatch_test()
+{
+    test_mismatch<std::random_access_iterator_tag>();
+    test_mismatch<std::forward_iterator_tag>();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    mismatch_test();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+         "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,139 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/datapar.hpp>
+#include <hpx/include/parallel_reduce.hpp>
+#include <hpx/include/parallel_transform_reduce.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <ctime>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "../algorithms/test_utils.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+struct plus
+{
+    template <typename T>
+    auto operator()(T const& lhs, T const& rhs) const -> decltype(lhs + rhs)
+    {
+        return lhs + rhs;
+    }
+};
+
+struct square
+{
+    template <typename T>
+    auto operator()(T const& x) const -> decltype(x * x)
+    {
+        return x * x;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename IteratorTag>
+void test_reduce(ExPolicy policy, IteratorTag)
+{
+    typedef std::vector<int>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    // the size is not a multiple of the vector-pack size
+    std::vector<int> c(10007);
+    std::iota(std::begin(c), std::end(c), std::rand() % 100);
+    int init = std::rand() % 1007;
+
+    int r1 = hpx::parallel::reduce(policy,
+        iterator(std::begin(c)), iterator(std::end(c)), init, plus());
+    HPX_TEST_EQ(r1, std::accumulate(std::begin(c), std::end(c), init));
+
+    // sequences shorter than a vector-pack
+    int r2 = hpx::parallel::reduce(policy,
+        iterator(std::begin(c)), iterator(std::begin(c) + 3), init, plus());
+    HPX_TEST_EQ(r2, std::accumulate(std::begin(c), std::begin(c) + 3, init));
+}
+
+template <typename ExPolicy, typename IteratorTag>
+void test_transform_reduce(ExPolicy policy, IteratorTag)
+{
+    typedef std::vector<int>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<int> c(10007);
+    std::iota(std::begin(c), std::end(c), std::rand() % 10);
+    int init = std::rand() % 1007;
+
+    int r = hpx::parallel::transform_reduce(policy,
+        iterator(std::begin(c)), iterator(std::end(c)), init, plus(),
+        square());
+
+    int expected = init;
+    for (int v : c)
+        expected += v * v;
+    HPX_TEST_EQ(r, expected);
+}
+
+template <typename IteratorTag>
+void test_reduce()
+{
+    using namespace hpx::parallel;
+
+    test_reduce(execution::dataseq, IteratorTag());
+    test_reduce(execution::datapar, IteratorTag());
+
+    test_transform_reduce(execution::dataseq, IteratorTag());
+    test_transform_reduce(execution::datapar, IteratorTag());
+}
+
+void reduce_test()
+{
+    test_reduce<std::random_access_iterator_tag>();
+    test_reduce<std::forward_iterator_tag>();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    reduce_test();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+         "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
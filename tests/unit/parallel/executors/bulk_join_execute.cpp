@@ -0,0 +1,136 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/include/parallel_execution.hpp>
+#include <hpx/parallel/executors/bulk_join_execute.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+template <typename Executor>
+void test_bulk_join(Executor& exec)
+{
+    std::vector<int> v(107);
+    std::iota(std::begin(v), std::end(v), 0);
+
+    std::atomic<int> sum(0);
+    hpx::future<void> f = hpx::parallel::execution::detail::bulk_join_execute(
+        exec, [&](int i) { sum += i; }, v);
+
+    f.get();
+    HPX_TEST_EQ(sum.load(), std::accumulate(v.begin(), v.end(), 0));
+}
+
+template <typename Executor>
+void test_bulk_join_results(Executor& exec)
+{
+    std::vector<int> v(107);
+    std::iota(std::begin(v), std::end(v), 0);
+
+    std::vector<int> results(v.size(), -1);
+    hpx::future<void> f = hpx::parallel::execution::detail::bulk_join_execute(
+        exec, [](int i) { return 2 * i; }, v, results.begin());
+
+    f.get();
+    for (std::size_t i = 0; i != v.size(); ++i)
+    {
+        HPX_TEST_EQ(results[i], 2 * v[i]);
+    }
+}
+
+template <typename Executor>
+void test_bulk_join_exceptions(Executor& exec)
+{
+    std::vector<int> v(107);
+    std::iota(std::begin(v), std::end(v), 0);
+
+    std::atomic<int> count(0);
+    hpx::future<void> f = hpx::parallel::execution::detail::bulk_join_execute(
+        exec,
+        [&](int i)
+        {
+            ++count;
+            if (i % 10 == 0)
+                throw std::runtime_error("test");
+        },
+        v);
+
+    bool caught_exception = false;
+    try {
+        f.get();
+        HPX_TEST(false);
+    }
+    catch (hpx::exception_list const& e) {
+        caught_exception = true;
+        HPX_TEST_EQ(e.size(), std::size_t(11));
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_exception);
+
+    // all elements are processed even if some of them fail
+    HPX_TEST_EQ(count.load(), 107);
+}
+
+template <typename Executor>
+void test_bulk_join_empty(Executor& exec)
+{
+    std::vector<int> v;
+
+    hpx::future<void> f = hpx::parallel::execution::detail::bulk_join_execute(
+        exec, [](int) { HPX_TEST(false); }, v);
+
+    HPX_TEST(f.is_ready());
+    f.get();
+}
+
+template <typename Executor>
+void test_executor(Executor& exec)
+{
+    test_bulk_join(exec);
+    test_bulk_join_results(exec);
+    test_bulk_join_exceptions(exec);
+    test_bulk_join_empty(exec);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    using namespace hpx::parallel;
+
+    execution::parallel_executor par_exec;
+    execution::parallel_executor par_fork_exec(hpx::launch::fork);
+    test_executor(par_exec);
+    test_executor(par_fork_exec);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
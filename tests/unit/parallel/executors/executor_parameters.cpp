@@ -10,11 +10,13 @@
 #include <hpx/hpx.hpp>
 #include <hpx/include/parallel_executors.hpp>
 #include <hpx/include/parallel_executor_parameters.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
 #include <hpx/util/lightweight_test.hpp>
 #include <hpx/util/iterator_range.hpp>
 
 #include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <functional>
 #include <iostream>
 #include <iterator>
@@ -97,6 +99,49 @@ void test_guided_chunk_size()
     }
 }
 
+void test_for_loop_adaptive(std::size_t min_chunk_size, int stride)
+{
+    using namespace hpx::parallel;
+
+    std::vector<std::size_t> c(10007, 0);
+    std::size_t const size = c.size();
+
+    // irregular work per iteration, every visited element is counted
+    execution::adaptive_chunk_size acs(min_chunk_size);
+    for_loop_strided(execution::par.with(acs), std::size_t(0), size, stride,
+        [&](std::size_t i)
+        {
+            if (i % 1000 == 0)
+                hpx::this_thread::sleep_for(std::chrono::milliseconds(1));
+            ++c[i];
+        });
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        HPX_TEST_EQ(c[i], std::size_t(i % stride == 0 ? 1 : 0));
+        count += c[i];
+    }
+    HPX_TEST_EQ(count, (size + stride - 1) / stride);
+}
+
+void test_adaptive_chunk_size()
+{
+    {
+        hpx::parallel::execution::adaptive_chunk_size acs;
+        parameters_test(acs);
+    }
+
+    {
+        hpx::parallel::execution::adaptive_chunk_size acs(100);
+        parameters_test(acs);
+    }
+
+    test_for_loop_adaptive(0, 1);
+    test_for_loop_adaptive(1, 1);
+    test_for_loop_adaptive(100, 3);
+}
+
 void test_auto_chunk_size()
 {
     {
@@ -131,6 +176,20 @@ void test_persistent_auto_chunk_size()
     }
 }
 
+void test_tuned_chunk_size()
+{
+    {
+        hpx::parallel::execution::tuned_chunk_size tcs;
+        parameters_test(tcs);
+    }
+
+    {
+        hpx::parallel::execution::tuned_chunk_size tcs(1, 0.5);
+        parameters_test(tcs);
+        HPX_TEST_NEQ(tcs.best_chunk_size(), std::size_t(0));
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 struct timer_hooks_parameters
 {
@@ -181,8 +240,10 @@ int hpx_main(boost::program_options::variables_map& vm)
     test_dynamic_chunk_size();
     test_static_chunk_size();
     test_guided_chunk_size();
+    test_adaptive_chunk_size();
     test_auto_chunk_size();
     test_persistent_auto_chunk_size();
+    test_tuned_chunk_size();
 
     test_combined_hooks();
 
@@ -232,6 +232,7 @@ int hpx_main(int argc, char* argv[])
     policy_test<hpx::launch::async_policy>();
     policy_test<hpx::launch::sync_policy>(true);
     policy_test<hpx::launch::fork_policy>();
+    policy_test<hpx::launch::work_first_policy>();
     policy_test<hpx::launch::deferred_policy>(true);
 
     return hpx::finalize();
@@ -0,0 +1,200 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/include/parallel_executor_parameters.hpp>
+#include <hpx/include/parallel_algorithm.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/parallel_numeric.hpp>
+#include <hpx/include/parallel_transform.hpp>
+#include <hpx/include/parallel_transform_reduce.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "../algorithms/foreach_tests.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy>
+void test_prefetch_algorithms(ExPolicy policy)
+{
+    std::vector<std::size_t> c(10007);
+    std::iota(c.begin(), c.end(), std::rand());
+
+    // transform
+    std::vector<std::size_t> d(c.size());
+    hpx::parallel::transform(policy, c.begin(), c.end(), d.begin(),
+        [](std::size_t v) { return v + 1; });
+    for (std::size_t i = 0; i != c.size(); ++i)
+        HPX_TEST_EQ(d[i], c[i] + 1);
+
+    // binary transform
+    std::vector<std::size_t> e(c.size());
+    hpx::parallel::transform(policy, c.begin(), c.end(), d.begin(), e.begin(),
+        [](std::size_t v1, std::size_t v2) { return v1 + v2; });
+    for (std::size_t i = 0; i != c.size(); ++i)
+        HPX_TEST_EQ(e[i], 2 * c[i] + 1);
+
+    // reduce
+    std::size_t sum = hpx::parallel::reduce(policy, c.begin(), c.end(),
+        std::size_t(0));
+    HPX_TEST_EQ(sum, std::accumulate(c.begin(), c.end(), std::size_t(0)));
+
+    // transform_reduce
+    std::size_t tsum = hpx::parallel::transform_reduce(policy,
+        c.begin(), c.end(), std::size_t(0), std::plus<std::size_t>(),
+        [](std::size_t v) { return v + 1; });
+    HPX_TEST_EQ(tsum, sum + c.size());
+
+    // for_loop, strided
+    std::vector<std::size_t> f(c.size(), 0);
+    hpx::parallel::for_loop_strided(policy, f.begin(), f.end(), 3,
+        [](std::vector<std::size_t>::iterator it) { *it = 1; });
+    for (std::size_t i = 0; i != f.size(); ++i)
+        HPX_TEST_EQ(f[i], std::size_t(i % 3 == 0 ? 1 : 0));
+
+    // non-random access iterators
+    std::list<std::size_t> l(c.begin(), c.end());
+    std::size_t lsum = hpx::parallel::reduce(policy, l.begin(), l.end(),
+        std::size_t(0));
+    HPX_TEST_EQ(lsum, sum);
+}
+
+void test_prefetch_indirect()
+{
+    using namespace hpx::parallel;
+
+    // a sparse matrix vector product, the indirect prefetcher prefetches the
+    // elements of the vector referenced through the column indices
+    std::size_t const rows = 1031;
+    std::size_t const nnz_per_row = 7;
+
+    std::vector<std::size_t> row_offsets(rows + 1);
+    std::vector<std::size_t> columns(rows * nnz_per_row);
+    std::vector<double> values(rows * nnz_per_row, 1.0);
+    std::vector<double> x(rows);
+    std::vector<double> y(rows, 0.0);
+
+    for (std::size_t r = 0; r != rows; ++r)
+    {
+        row_offsets[r] = r * nnz_per_row;
+        x[r] = double(std::rand() % 100);
+        for (std::size_t j = 0; j != nnz_per_row; ++j)
+            columns[r * nnz_per_row + j] = std::rand() % rows;
+    }
+    row_offsets[rows] = rows * nnz_per_row;
+
+    double const* xp = x.data();
+    std::size_t const* rp = row_offsets.data();
+    std::size_t const* cp = columns.data();
+
+    auto p = execution::make_prefetch_indirect(4,
+        [xp, rp, cp](std::size_t r) -> void const*
+        {
+            return xp + cp[rp[r]];
+        });
+
+    for_loop(execution::par.with(p), std::size_t(0), rows,
+        [&](std::size_t r)
+        {
+            double sum = 0.0;
+            for (std::size_t k = row_offsets[r]; k != row_offsets[r + 1]; ++k)
+                sum += values[k] * x[columns[k]];
+            y[r] = sum;
+        });
+
+    for (std::size_t r = 0; r != rows; ++r)
+    {
+        double sum = 0.0;
+        for (std::size_t k = row_offsets[r]; k != row_offsets[r + 1]; ++k)
+            sum += values[k] * x[columns[k]];
+        HPX_TEST_EQ(y[r], sum);
+    }
+}
+
+void test_prefetch_distance()
+{
+    using namespace hpx::parallel;
+
+    typedef std::random_access_iterator_tag iterator_tag;
+    {
+        execution::prefetch_distance p(8);
+        test_for_each(execution::par.with(p), iterator_tag());
+        test_for_each_async(execution::par(execution::task).with(p),
+            iterator_tag());
+        test_prefetch_algorithms(execution::par.with(p));
+    }
+
+    {
+        // prefetching can be combined with the chunk size parameters
+        execution::static_chunk_size cs(100);
+        execution::prefetch_distance p(16);
+        test_for_each(execution::par.with(cs, p), iterator_tag());
+        test_prefetch_algorithms(execution::par.with(cs, p));
+    }
+
+    {
+        // a distance exceeding the size of the partitions
+        execution::prefetch_distance p(100000);
+        test_prefetch_algorithms(execution::par.with(p));
+    }
+
+    {
+        execution::prefetch_distance p(8);
+        test_prefetch_algorithms(execution::par.with(std::ref(p)));
+    }
+
+    test_prefetch_indirect();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = static_cast<unsigned int>(std::time(nullptr));
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    test_prefetch_distance();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,151 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector_predef.hpp>
+#include <hpx/include/partitioned_csr_matrix.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The vector types to be used are defined in partitioned_vector module.
+// HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_CSR_MATRIX(double);
+
+///////////////////////////////////////////////////////////////////////////////
+// A square matrix with a tridiagonal band and a few entries far off the
+// diagonal, which reference elements of remote partitions.
+struct csr_data
+{
+    explicit csr_data(std::size_t n)
+      : size_(n)
+    {
+        row_ptr_.push_back(0);
+        for (std::size_t row = 0; row != n; ++row)
+        {
+            if (row != 0)
+                add(row - 1, -1.0);
+            add(row, 2.0);
+            if (row != n - 1)
+                add(row + 1, -1.0);
+            if (row % 3 == 0)
+                add((row * 7 + n / 2) % n, 0.5);
+            row_ptr_.push_back(col_idx_.size());
+        }
+    }
+
+    void add(std::size_t col, double value)
+    {
+        col_idx_.push_back(col);
+        values_.push_back(value);
+    }
+
+    std::vector<double> multiply(std::vector<double> const& x) const
+    {
+        std::vector<double> y(size_, 0.0);
+        for (std::size_t row = 0; row != size_; ++row)
+        {
+            for (std::size_t k = row_ptr_[row]; k != row_ptr_[row + 1]; ++k)
+                y[row] += values_[k] * x[col_idx_[k]];
+        }
+        return y;
+    }
+
+    std::size_t size_;
+    std::vector<std::size_t> row_ptr_;
+    std::vector<std::size_t> col_idx_;
+    std::vector<double> values_;
+};
+
+template <typename DistPolicy, typename VectorPolicy>
+void spmv_tests(std::size_t n, DistPolicy const& policy,
+    VectorPolicy const& vector_policy)
+{
+    csr_data data(n);
+
+    hpx::partitioned_csr_matrix<double> m(n, n, data.row_ptr_,
+        data.col_idx_, data.values_, policy);
+    HPX_TEST_EQ(m.num_rows(), n);
+    HPX_TEST_EQ(m.num_cols(), n);
+    HPX_TEST_EQ(m.nnz(), data.values_.size());
+
+    std::size_t rows = 0;
+    for (std::size_t p = 0; p != m.num_partitions(); ++p)
+    {
+        HPX_TEST_EQ(m.get_row_begin(p), rows);
+        rows += m.get_num_rows(p);
+    }
+    HPX_TEST_EQ(rows, n);
+
+    hpx::partitioned_vector<double> x(n, vector_policy);
+    hpx::partitioned_vector<double> y(n, 0.0, vector_policy);
+
+    std::vector<double> expected_x(n);
+    for (std::size_t i = 0; i != n; ++i)
+    {
+        expected_x[i] = double(i + 1);
+        x.set_value(hpx::launch::sync, i, expected_x[i]);
+    }
+
+    // the second product reuses the gather plan of the first
+    for (int iteration = 0; iteration != 2; ++iteration)
+    {
+        m.spmv(hpx::launch::sync, x, y);
+
+        std::vector<double> expected_y = data.multiply(expected_x);
+        for (std::size_t i = 0; i != n; ++i)
+            HPX_TEST_EQ(y.get_value(hpx::launch::sync, i), expected_y[i]);
+
+        // iterate y = A * y
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            expected_x[i] = expected_y[i] / 10.0;
+            x.set_value(hpx::launch::sync, i, expected_x[i]);
+        }
+    }
+
+    // the vectors have to match the size of the matrix
+    hpx::partitioned_vector<double> z(n + 1, vector_policy);
+    bool caught_exception = false;
+    try {
+        m.spmv(hpx::launch::sync, z, y);
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::bad_parameter);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+void spmv_tests()
+{
+    std::size_t const length = 37;
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    // the vectors are partitioned like the matrix
+    spmv_tests(length, hpx::container_layout, hpx::container_layout);
+    spmv_tests(length, hpx::container_layout(3), hpx::container_layout(3));
+    spmv_tests(length, hpx::container_layout(localities),
+        hpx::container_layout(localities));
+    spmv_tests(length, hpx::container_layout(5, localities),
+        hpx::container_layout(5, localities));
+
+    // the partitions of the vectors don't line up with the matrix
+    spmv_tests(length, hpx::container_layout(3, localities),
+        hpx::container_layout(4, localities));
+    spmv_tests(length, hpx::container_layout(localities),
+        hpx::container_layout);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    spmv_tests();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,158 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector_predef.hpp>
+#include <hpx/include/partitioned_vector_cache.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The vector types to be used are defined in partitioned_vector module.
+// HPX_REGISTER_PARTITIONED_VECTOR(double);
+// HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void fill_vector(hpx::partitioned_vector<T>& v)
+{
+    for (std::size_t i = 0; i != v.size(); ++i)
+        v.set_value(hpx::launch::sync, i, T(i));
+}
+
+template <typename T>
+void cache_read_tests(hpx::partitioned_vector<T>& v, std::size_t block_size)
+{
+    fill_vector(v);
+
+    hpx::partitioned_vector_cache<T> cache(v, block_size);
+    HPX_TEST_EQ(cache.block_size(), block_size);
+
+    // strided and repeated reads
+    for (std::size_t i = 0; i != v.size(); i += 3)
+        HPX_TEST_EQ(cache.get_value(i), T(i));
+    for (std::size_t i = v.size(); i != 0; --i)
+        HPX_TEST_EQ(cache.get_value(i - 1), T(i - 1));
+
+    std::vector<std::size_t> positions;
+    for (std::size_t i = 0; i != v.size(); i += 2)
+        positions.push_back(v.size() - 1 - i);
+
+    std::vector<T> values = cache.get_values(positions);
+    HPX_TEST_EQ(values.size(), positions.size());
+    for (std::size_t i = 0; i != positions.size(); ++i)
+        HPX_TEST_EQ(values[i], T(positions[i]));
+
+    // writes not performed through the cache are visible after invalidating
+    v.set_value(hpx::launch::sync, v.size() - 1, T(42));
+    cache.invalidate();
+    HPX_TEST_EQ(cache.num_cached_blocks(), std::size_t(0));
+    HPX_TEST_EQ(cache.get_value(v.size() - 1), T(42));
+}
+
+template <typename T>
+void cache_write_tests(hpx::partitioned_vector<T>& v, std::size_t block_size,
+    std::size_t max_pending_writes)
+{
+    fill_vector(v);
+
+    {
+        hpx::partitioned_vector_cache<T> cache(v, block_size, 2,
+            max_pending_writes);
+
+        // reads see the writes performed through the cache, before and
+        // after fetching the block
+        for (std::size_t i = 0; i != v.size(); ++i)
+        {
+            cache.set_value(i, T(2 * i));
+            HPX_TEST_EQ(cache.get_value(i), T(2 * i));
+        }
+
+        // repeated writes to the same elements
+        for (std::size_t i = 0; i != v.size(); i += 2)
+            cache.set_value(i, T(3 * i));
+
+        for (std::size_t i = 0; i != v.size(); ++i)
+        {
+            HPX_TEST_EQ(cache.get_value(i),
+                T(i % 2 == 0 ? 3 * i : 2 * i));
+        }
+
+        cache.fence();
+        HPX_TEST_EQ(cache.num_cached_blocks(), std::size_t(0));
+
+        for (std::size_t i = 0; i != v.size(); ++i)
+        {
+            HPX_TEST_EQ(v.get_value(hpx::launch::sync, i),
+                T(i % 2 == 0 ? 3 * i : 2 * i));
+        }
+
+        // the writes are flushed explicitly
+        for (std::size_t i = 0; i != v.size(); ++i)
+            cache.set_value(i, T(i + 1));
+        cache.flush().get();
+
+        for (std::size_t i = 0; i != v.size(); ++i)
+            HPX_TEST_EQ(v.get_value(hpx::launch::sync, i), T(i + 1));
+
+        // the destructor sends the buffered writes
+        for (std::size_t i = 0; i != v.size(); ++i)
+            cache.set_value(i, T(i + 2));
+    }
+
+    for (std::size_t i = 0; i != v.size(); ++i)
+        HPX_TEST_EQ(v.get_value(hpx::launch::sync, i), T(i + 2));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T, typename DistPolicy>
+void cache_tests_with_policy(std::size_t size, DistPolicy const& policy)
+{
+    {
+        hpx::partitioned_vector<T> v(size, policy);
+        cache_read_tests(v, 1);
+        cache_read_tests(v, 5);
+        cache_read_tests(v, size);
+    }
+
+    {
+        hpx::partitioned_vector<T> v(size, policy);
+        cache_write_tests(v, 1, 1);
+        cache_write_tests(v, 4, 3);
+        cache_write_tests(v, size, size);
+    }
+}
+
+template <typename T>
+void cache_tests()
+{
+    std::size_t const length = 37;
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    {
+        hpx::partitioned_vector<T> v(length);
+        hpx::partitioned_vector_cache<T> cache(v);
+        HPX_TEST_EQ(cache.block_size(), 4096 / sizeof(T));
+
+        cache_read_tests(v, cache.block_size());
+    }
+
+    cache_tests_with_policy<T>(length, hpx::container_layout);
+    cache_tests_with_policy<T>(length, hpx::container_layout(3));
+    cache_tests_with_policy<T>(length, hpx::container_layout(3, localities));
+    cache_tests_with_policy<T>(length, hpx::container_layout(localities));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    cache_tests<double>();
+    cache_tests<int>();
+
+    return 0;
+}
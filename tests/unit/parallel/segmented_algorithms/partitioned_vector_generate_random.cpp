@@ -0,0 +1,122 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector_predef.hpp>
+#include <hpx/include/parallel_generate.hpp>
+#include <hpx/util/philox_engine.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The vector types to be used are defined in partitioned_vector module.
+// HPX_REGISTER_PARTITIONED_VECTOR(double);
+// HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+struct gen_value
+{
+    T operator()(hpx::util::philox_engine& engine) const
+    {
+        std::uniform_int_distribution<int> dist(0, 1000);
+        return T(dist(engine));
+    }
+
+    template <typename Archive>
+    void serialize(Archive&, unsigned)
+    {
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// the values depend on the seed and on the global position of the elements
+// only, independently of the partitioning of the vector
+template <typename T>
+void verify_values(hpx::partitioned_vector<T> const& v, std::uint64_t seed,
+    std::size_t first, std::size_t last)
+{
+    typedef typename hpx::partitioned_vector<T>::const_iterator const_iterator;
+
+    std::size_t i = first;
+    const_iterator end = v.begin() + last;
+    for (const_iterator it = v.begin() + first; it != end; ++it, ++i)
+    {
+        hpx::util::philox_engine engine(seed, i - first);
+        HPX_TEST_EQ(T(*it), gen_value<T>()(engine));
+    }
+}
+
+template <typename T, typename DistPolicy, typename ExPolicy>
+void generate_algo_tests_with_policy(std::size_t size,
+    DistPolicy const& policy, ExPolicy const& gen_policy)
+{
+    hpx::partitioned_vector<T> c(size, T(-1), policy);
+
+    hpx::parallel::generate(gen_policy, c.begin(), c.end(), 42,
+        gen_value<T>());
+    verify_values(c, 42, 0, size);
+
+    hpx::parallel::generate(gen_policy, c.begin() + 1, c.end() - 1, 43,
+        gen_value<T>());
+    verify_values(c, 43, 1, size - 1);
+}
+
+template <typename T, typename DistPolicy, typename ExPolicy>
+void generate_algo_tests_with_policy_async(std::size_t size,
+    DistPolicy const& policy, ExPolicy const& gen_policy)
+{
+    hpx::partitioned_vector<T> c(size, T(-1), policy);
+
+    auto f = hpx::parallel::generate(gen_policy, c.begin(), c.end(), 42,
+        gen_value<T>());
+    f.wait();
+    verify_values(c, 42, 0, size);
+
+    auto f1 = hpx::parallel::generate(gen_policy, c.begin() + 1, c.end() - 1,
+        43, gen_value<T>());
+    f1.wait();
+    verify_values(c, 43, 1, size - 1);
+}
+
+template <typename T, typename DistPolicy>
+void generate_tests_with_policy(std::size_t size, DistPolicy const& policy)
+{
+    using namespace hpx::parallel::execution;
+
+    generate_algo_tests_with_policy<T>(size, policy, seq);
+    generate_algo_tests_with_policy<T>(size, policy, par);
+
+    //async
+    generate_algo_tests_with_policy_async<T>(size, policy, seq(task));
+    generate_algo_tests_with_policy_async<T>(size, policy, par(task));
+}
+
+template <typename T>
+void generate_tests()
+{
+    std::size_t const length = 12;
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    generate_tests_with_policy<T>(length, hpx::container_layout);
+    generate_tests_with_policy<T>(length, hpx::container_layout(3));
+    generate_tests_with_policy<T>(length,
+        hpx::container_layout(3, localities));
+    generate_tests_with_policy<T>(length, hpx::container_layout(localities));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    generate_tests<double>();
+    generate_tests<int>();
+
+    return 0;
+}
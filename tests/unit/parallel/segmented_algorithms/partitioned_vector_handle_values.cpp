@@ -103,6 +103,40 @@ void handle_values_tests_distributed_access(hpx::partitioned_vector<T>& v)
     compare_vectors(values2, result2);
 }
 
+template <typename T>
+void handle_values_tests_scattered_access(hpx::partitioned_vector<T>& v)
+{
+    fill_vector(v, T(42));
+
+    // positions alternating between the partitions, in descending order
+    std::vector<std::size_t> positions;
+    for (std::size_t i = 0; i != v.size() / 2; ++i)
+    {
+        positions.push_back(v.size() - 1 - i);
+        positions.push_back(i);
+    }
+
+    std::vector<T> values(positions.size());
+    fill_vector(values, T(48), T(3));
+
+    v.set_values(hpx::launch::sync, positions, values);
+    std::vector<T> result = v.get_values(hpx::launch::sync, positions);
+    compare_vectors(values, result);
+
+    for (std::size_t i = 0; i != positions.size(); ++i)
+        HPX_TEST_EQ(v.get_value(hpx::launch::sync, positions[i]), values[i]);
+
+    // repeated positions
+    std::vector<std::size_t> repeated(positions.begin(), positions.end());
+    repeated.insert(repeated.end(), positions.rbegin(), positions.rend());
+
+    std::vector<T> expected(values.begin(), values.end());
+    expected.insert(expected.end(), values.rbegin(), values.rend());
+
+    result = v.get_values(hpx::launch::sync, repeated);
+    compare_vectors(expected, result);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 template <typename T, typename DistPolicy>
@@ -118,6 +152,11 @@ void handle_values_tests_with_policy(std::size_t size, std::size_t localities,
         hpx::partitioned_vector<T> v(size, policy);
         handle_values_tests_distributed_access(v);
     }
+
+    {
+        hpx::partitioned_vector<T> v(size, policy);
+        handle_values_tests_scattered_access(v);
+    }
 }
 
 template <typename T>
@@ -0,0 +1,101 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector_predef.hpp>
+#include <hpx/include/parallel_histogram.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The vector types to be used are defined in partitioned_vector module.
+// HPX_REGISTER_PARTITIONED_VECTOR(double);
+// HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const num_bins = 8;
+
+struct bin_of
+{
+    template <typename T>
+    std::size_t operator()(T const& value) const
+    {
+        return std::size_t(value) % num_bins;
+    }
+};
+
+template <typename ExPolicy, typename T>
+std::vector<std::size_t> test_histogram(ExPolicy && policy,
+    hpx::partitioned_vector<T> const& xvalues)
+{
+    std::vector<std::size_t> bins(num_bins, 0);
+    hpx::parallel::histogram(policy, xvalues.begin(), xvalues.end(),
+        bins.begin(), num_bins, bin_of());
+    return bins;
+}
+
+template <typename ExPolicy, typename T>
+std::vector<std::size_t> test_histogram_async(ExPolicy && policy,
+    hpx::partitioned_vector<T> const& xvalues)
+{
+    std::vector<std::size_t> bins(num_bins, 0);
+    hpx::parallel::histogram(policy, xvalues.begin(), xvalues.end(),
+        bins.begin(), num_bins, bin_of()).get();
+    return bins;
+}
+
+template <typename ExPolicy, typename T>
+std::vector<std::size_t> test_bucketize(ExPolicy && policy,
+    hpx::partitioned_vector<T> const& xvalues)
+{
+    std::vector<T> bounds = { T(0), T(2), T(5) };
+    std::vector<std::size_t> bins(bounds.size() + 1, 0);
+    hpx::parallel::bucketize(policy, xvalues.begin(), xvalues.end(),
+        bounds.begin(), bounds.end(), bins.begin());
+    return bins;
+}
+
+template <typename T>
+void histogram_tests(std::size_t num,
+    hpx::partitioned_vector<T> const& xvalues)
+{
+    using namespace hpx::parallel;
+
+    std::vector<std::size_t> expected(num_bins, 0);
+    expected[3] = num;
+
+    HPX_TEST(test_histogram(execution::seq, xvalues) == expected);
+    HPX_TEST(test_histogram(execution::par, xvalues) == expected);
+    HPX_TEST(test_histogram_async(
+        execution::seq(execution::task), xvalues) == expected);
+    HPX_TEST(test_histogram_async(
+        execution::par(execution::task), xvalues) == expected);
+
+    std::vector<std::size_t> expected_buckets = { 0, 0, num, 0 };
+
+    HPX_TEST(test_bucketize(execution::seq, xvalues) == expected_buckets);
+    HPX_TEST(test_bucketize(execution::par, xvalues) == expected_buckets);
+}
+
+template <typename T>
+void histogram_tests(std::vector<hpx::id_type> &localities)
+{
+    std::size_t const num = 10007;
+    hpx::partitioned_vector<T> xvalues(num, T(3),
+        hpx::container_layout(localities));
+    histogram_tests(num, xvalues);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    histogram_tests<int>(localities);
+    histogram_tests<double>(localities);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,121 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector_predef.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The vector types to be used are defined in partitioned_vector module.
+// HPX_REGISTER_PARTITIONED_VECTOR(double);
+// HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void fill_vector(hpx::partitioned_vector<T>& v, T offset)
+{
+    for (std::size_t i = 0; i != v.size(); ++i)
+        v.set_value(hpx::launch::sync, i, T(i) + offset);
+}
+
+template <typename T>
+void verify_vector(hpx::partitioned_vector<T> const& v, T offset)
+{
+    std::size_t count = 0;
+    for (typename hpx::partitioned_vector<T>::const_iterator it = v.begin();
+         it != v.end(); ++it, ++count)
+    {
+        HPX_TEST_EQ(*it, T(count) + offset);
+    }
+    HPX_TEST_EQ(count, v.size());
+}
+
+// the file holds the raw elements in the order of their global index
+template <typename T>
+void verify_file(std::string const& path, std::size_t size, T offset)
+{
+    std::ifstream in(path, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+    HPX_TEST_EQ(bytes.size(), size * sizeof(T));
+
+    T const* values = reinterpret_cast<T const*>(bytes.data());
+    for (std::size_t i = 0; i != bytes.size() / sizeof(T); ++i)
+        HPX_TEST_EQ(values[i], T(i) + offset);
+}
+
+template <typename T, typename DistPolicy>
+void load_save_tests_with_policy(std::size_t size, DistPolicy const& policy,
+    std::size_t stripe_size)
+{
+    std::string const path = "partitioned_vector_load_save.bin";
+
+    hpx::partitioned_vector<T> v(size, policy);
+    fill_vector(v, T(42));
+
+    v.save(hpx::launch::sync, path, stripe_size);
+    verify_file(path, size, T(42));
+
+    // the file does not depend on the layout of the vector
+    hpx::partitioned_vector<T> w(size, T(0), hpx::container_layout(2));
+    w.load(path, stripe_size).get();
+    verify_vector(w, T(42));
+
+    fill_vector(w, T(1));
+    w.save(path, stripe_size).get();
+
+    v.load(hpx::launch::sync, path, stripe_size);
+    verify_vector(v, T(1));
+
+    // the file has to hold all elements
+    hpx::partitioned_vector<T> larger(size + 1, policy);
+
+    bool caught_exception = false;
+    try {
+        larger.load(hpx::launch::sync, path, stripe_size);
+    }
+    catch (hpx::exception const&) {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    std::remove(path.c_str());
+}
+
+template <typename T>
+void load_save_tests()
+{
+    std::size_t const length = 1007;
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    for (std::size_t stripe_size : {std::size_t(0), std::size_t(64)})
+    {
+        load_save_tests_with_policy<T>(length, hpx::container_layout,
+            stripe_size);
+        load_save_tests_with_policy<T>(length, hpx::container_layout(3),
+            stripe_size);
+        load_save_tests_with_policy<T>(length,
+            hpx::container_layout(3, localities), stripe_size);
+        load_save_tests_with_policy<T>(length,
+            hpx::container_layout(localities), stripe_size);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    load_save_tests<double>();
+    load_save_tests<int>();
+
+    return hpx::util::report_errors();
+}
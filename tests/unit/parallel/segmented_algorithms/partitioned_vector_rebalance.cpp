@@ -0,0 +1,167 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/parallel_reduce.hpp>
+#include <hpx/include/partitioned_vector_predef.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The vector types to be used are defined in partitioned_vector module.
+// HPX_REGISTER_PARTITIONED_VECTOR(double);
+// HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void fill_vector(hpx::partitioned_vector<T>& v)
+{
+    for (std::size_t i = 0; i != v.size(); ++i)
+        v.set_value(hpx::launch::sync, i, T(i));
+}
+
+template <typename T>
+void verify_vector(hpx::partitioned_vector<T> const& v, std::size_t size)
+{
+    HPX_TEST_EQ(v.size(), size);
+
+    // element access
+    for (std::size_t i = 0; i != v.size(); ++i)
+        HPX_TEST_EQ(v.get_value(hpx::launch::sync, i), T(i));
+
+    // bulk element access
+    std::vector<std::size_t> positions;
+    for (std::size_t i = 0; i != v.size(); ++i)
+        positions.push_back(v.size() - 1 - i);
+
+    std::vector<T> values = v.get_values(hpx::launch::sync, positions);
+    HPX_TEST_EQ(values.size(), positions.size());
+    for (std::size_t i = 0; i != positions.size(); ++i)
+        HPX_TEST_EQ(values[i], T(positions[i]));
+
+    // iteration
+    std::size_t count = 0;
+    for (typename hpx::partitioned_vector<T>::const_iterator it = v.begin();
+         it != v.end(); ++it, ++count)
+    {
+        HPX_TEST_EQ(*it, T(count));
+    }
+    HPX_TEST_EQ(count, size);
+
+    // segmented algorithms
+    T sum = hpx::parallel::reduce(
+        hpx::parallel::execution::par, v.begin(), v.end(), T(0));
+    HPX_TEST_EQ(sum, T(size * (size - 1) / 2));
+}
+
+template <typename T>
+void rebalance_tests(hpx::partitioned_vector<T>& v, std::size_t num_parts)
+{
+    std::size_t const size = v.size();
+    fill_vector(v);
+
+    // increasing weights
+    std::vector<double> weights;
+    for (std::size_t i = 0; i != num_parts; ++i)
+        weights.push_back(double(i + 1));
+
+    v.rebalance(hpx::launch::sync, weights);
+    verify_vector(v, size);
+
+    // all elements in the last partition
+    std::fill(weights.begin(), weights.end(), 0.0);
+    weights.back() = 1.0;
+
+    v.rebalance(weights).get();
+    verify_vector(v, size);
+
+    // all elements in the first partition
+    std::fill(weights.begin(), weights.end(), 0.0);
+    weights.front() = 1.0;
+
+    v.rebalance(hpx::launch::sync, weights);
+    verify_vector(v, size);
+
+    // back to equal sizes
+    std::fill(weights.begin(), weights.end(), 1.0);
+
+    v.rebalance(hpx::launch::sync, weights);
+    verify_vector(v, size);
+
+    // invalid weights
+    bool caught_exception = false;
+    try {
+        v.rebalance(hpx::launch::sync, std::vector<double>(num_parts + 1, 1.0));
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::bad_parameter);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+    verify_vector(v, size);
+}
+
+template <typename T, typename DistPolicy>
+void rebalance_tests_with_policy(std::size_t size, std::size_t num_parts,
+    DistPolicy const& policy)
+{
+    hpx::partitioned_vector<T> v(size, policy);
+    rebalance_tests(v, num_parts);
+}
+
+template <typename T>
+void registered_rebalance_tests(std::size_t size, std::size_t num_parts,
+    std::vector<hpx::id_type> const& localities)
+{
+    std::string const name =
+        "partitioned_vector_rebalance_" + std::to_string(sizeof(T));
+
+    hpx::partitioned_vector<T> v(size,
+        hpx::container_layout(num_parts, localities));
+    v.register_as(hpx::launch::sync, name);
+    fill_vector(v);
+
+    std::vector<double> weights;
+    for (std::size_t i = 0; i != num_parts; ++i)
+        weights.push_back(double(num_parts - i));
+
+    v.rebalance(hpx::launch::sync, weights);
+
+    // vectors connecting afterwards see the new layout
+    hpx::partitioned_vector<T> connected;
+    connected.connect_to(hpx::launch::sync, name);
+    verify_vector(connected, size);
+}
+
+template <typename T>
+void rebalance_tests()
+{
+    std::size_t const length = 117;
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    rebalance_tests_with_policy<T>(length, 1, hpx::container_layout(1));
+    rebalance_tests_with_policy<T>(length, 3, hpx::container_layout(3));
+    rebalance_tests_with_policy<T>(length, 3,
+        hpx::container_layout(3, localities));
+    rebalance_tests_with_policy<T>(length, localities.size(),
+        hpx::container_layout(localities));
+    rebalance_tests_with_policy<T>(5, 7, hpx::container_layout(7));
+
+    registered_rebalance_tests<T>(length, 4, localities);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    rebalance_tests<double>();
+    rebalance_tests<int>();
+
+    return hpx::util::report_errors();
+}
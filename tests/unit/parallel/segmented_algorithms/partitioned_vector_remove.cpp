@@ -0,0 +1,145 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector_predef.hpp>
+#include <hpx/include/parallel_remove.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The vector types to be used are defined in partitioned_vector module.
+// HPX_REGISTER_PARTITIONED_VECTOR(double);
+// HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+struct is_odd
+{
+    template <typename T>
+    bool operator()(T const& value) const
+    {
+        return int(value) % 2 != 0;
+    }
+};
+
+template <typename T>
+std::vector<T> fill_vector(hpx::partitioned_vector<T>& v, int range)
+{
+    std::vector<T> values(v.size());
+    for (std::size_t i = 0; i != values.size(); ++i)
+        values[i] = T(std::rand() % range);
+
+    std::vector<std::size_t> positions(v.size());
+    for (std::size_t i = 0; i != positions.size(); ++i)
+        positions[i] = i;
+
+    v.set_values(hpx::launch::sync, positions, values);
+    return values;
+}
+
+template <typename T>
+void verify_vector(hpx::partitioned_vector<T> const& v, std::size_t count,
+    std::vector<T> const& expected)
+{
+    HPX_TEST_EQ(count, expected.size());
+
+    std::vector<std::size_t> positions(count);
+    for (std::size_t i = 0; i != count; ++i)
+        positions[i] = i;
+
+    HPX_TEST(v.get_values(hpx::launch::sync, positions) == expected);
+}
+
+template <typename ExPolicy, typename T>
+void test_remove_if(ExPolicy && policy, hpx::partitioned_vector<T>& v,
+    int range)
+{
+    std::vector<T> expected = fill_vector(v, range);
+    expected.erase(
+        std::remove_if(expected.begin(), expected.end(), is_odd()),
+        expected.end());
+
+    auto result = hpx::parallel::remove_if(policy, v.begin(), v.end(),
+        is_odd());
+    verify_vector(v, std::distance(v.begin(), result), expected);
+}
+
+template <typename ExPolicy, typename T>
+void test_remove_if_async(ExPolicy && policy, hpx::partitioned_vector<T>& v,
+    int range)
+{
+    std::vector<T> expected = fill_vector(v, range);
+    expected.erase(
+        std::remove_if(expected.begin(), expected.end(), is_odd()),
+        expected.end());
+
+    auto f = hpx::parallel::remove_if(policy, v.begin(), v.end(), is_odd());
+    verify_vector(v, std::distance(v.begin(), f.get()), expected);
+}
+
+template <typename ExPolicy, typename T>
+void test_remove(ExPolicy && policy, hpx::partitioned_vector<T>& v)
+{
+    std::vector<T> expected = fill_vector(v, 4);
+    expected.erase(
+        std::remove(expected.begin(), expected.end(), T(2)),
+        expected.end());
+
+    auto result = hpx::parallel::remove(policy, v.begin(), v.end(), T(2));
+    verify_vector(v, std::distance(v.begin(), result), expected);
+}
+
+template <typename T>
+void remove_tests(hpx::partitioned_vector<T>& v)
+{
+    using namespace hpx::parallel;
+
+    // a range of 1 removes no elements, a range of 2 removes the odd ones
+    for (int range : { 1000, 2, 1 })
+    {
+        test_remove_if(execution::seq, v, range);
+        test_remove_if(execution::par, v, range);
+        test_remove_if_async(execution::seq(execution::task), v, range);
+        test_remove_if_async(execution::par(execution::task), v, range);
+    }
+
+    test_remove(execution::seq, v);
+    test_remove(execution::par, v);
+}
+
+template <typename T>
+void remove_tests(std::vector<hpx::id_type>& localities)
+{
+    std::size_t const num = 10007;
+
+    {
+        hpx::partitioned_vector<T> v(num);
+        remove_tests(v);
+    }
+    {
+        hpx::partitioned_vector<T> v(num, hpx::container_layout(localities));
+        remove_tests(v);
+    }
+    {
+        hpx::partitioned_vector<T> v(num,
+            hpx::container_layout(3 * localities.size(), localities));
+        remove_tests(v);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    remove_tests<int>(localities);
+    remove_tests<double>(localities);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,134 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector_predef.hpp>
+#include <hpx/include/parallel_sort.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The vector types to be used are defined in partitioned_vector module.
+// HPX_REGISTER_PARTITIONED_VECTOR(double);
+// HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+struct greater
+{
+    template <typename T>
+    bool operator()(T const& lhs, T const& rhs) const
+    {
+        return rhs < lhs;
+    }
+};
+
+template <typename T>
+std::vector<T> fill_vector(hpx::partitioned_vector<T>& v, int range)
+{
+    std::vector<T> values(v.size());
+    for (std::size_t i = 0; i != values.size(); ++i)
+        values[i] = T(std::rand() % range);
+
+    std::vector<std::size_t> positions(v.size());
+    for (std::size_t i = 0; i != positions.size(); ++i)
+        positions[i] = i;
+
+    v.set_values(hpx::launch::sync, positions, values);
+    return values;
+}
+
+template <typename T>
+void verify_vector(hpx::partitioned_vector<T> const& v,
+    std::vector<T> const& expected)
+{
+    std::vector<std::size_t> positions(v.size());
+    for (std::size_t i = 0; i != positions.size(); ++i)
+        positions[i] = i;
+
+    HPX_TEST(v.get_values(hpx::launch::sync, positions) == expected);
+}
+
+template <typename ExPolicy, typename T>
+void test_sort(ExPolicy && policy, hpx::partitioned_vector<T>& v, int range)
+{
+    std::vector<T> expected = fill_vector(v, range);
+    std::sort(expected.begin(), expected.end());
+
+    auto result = hpx::parallel::sort(policy, v.begin(), v.end());
+    HPX_TEST(result == v.end());
+    verify_vector(v, expected);
+
+    // sorting with a comparison function
+    std::sort(expected.begin(), expected.end(), greater());
+    hpx::parallel::sort(policy, v.begin(), v.end(), greater());
+    verify_vector(v, expected);
+}
+
+template <typename ExPolicy, typename T>
+void test_sort_async(ExPolicy && policy, hpx::partitioned_vector<T>& v,
+    int range)
+{
+    std::vector<T> expected = fill_vector(v, range);
+    std::sort(expected.begin(), expected.end());
+
+    auto f = hpx::parallel::sort(policy, v.begin(), v.end());
+    HPX_TEST(f.get() == v.end());
+    verify_vector(v, expected);
+}
+
+template <typename T>
+void sort_tests(hpx::partitioned_vector<T>& v)
+{
+    using namespace hpx::parallel;
+
+    // many distinct, few distinct, and all equal values
+    for (int range : { 100000, 3, 1 })
+    {
+        test_sort(execution::seq, v, range);
+        test_sort(execution::par, v, range);
+        test_sort_async(execution::seq(execution::task), v, range);
+        test_sort_async(execution::par(execution::task), v, range);
+    }
+}
+
+template <typename T>
+void sort_tests(std::vector<hpx::id_type>& localities)
+{
+    std::size_t const num = 10007;
+
+    {
+        hpx::partitioned_vector<T> v(num);
+        sort_tests(v);
+    }
+    {
+        hpx::partitioned_vector<T> v(num, hpx::container_layout(localities));
+        sort_tests(v);
+    }
+    {
+        hpx::partitioned_vector<T> v(num,
+            hpx::container_layout(3 * localities.size(), localities));
+        sort_tests(v);
+    }
+    {
+        // more partitions than samples drawn from each of those
+        hpx::partitioned_vector<T> v(100, hpx::container_layout(7));
+        sort_tests(v);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    sort_tests<int>(localities);
+    sort_tests<double>(localities);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,119 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector_predef.hpp>
+#include <hpx/include/parallel_unique.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The vector types to be used are defined in partitioned_vector module.
+// HPX_REGISTER_PARTITIONED_VECTOR(double);
+// HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+std::vector<T> fill_vector(hpx::partitioned_vector<T>& v, int range)
+{
+    std::vector<T> values(v.size());
+    for (std::size_t i = 0; i != values.size(); ++i)
+        values[i] = T(std::rand() % range);
+
+    std::vector<std::size_t> positions(v.size());
+    for (std::size_t i = 0; i != positions.size(); ++i)
+        positions[i] = i;
+
+    v.set_values(hpx::launch::sync, positions, values);
+    return values;
+}
+
+template <typename T>
+void verify_vector(hpx::partitioned_vector<T> const& v, std::size_t count,
+    std::vector<T> const& expected)
+{
+    HPX_TEST_EQ(count, expected.size());
+
+    std::vector<std::size_t> positions(count);
+    for (std::size_t i = 0; i != count; ++i)
+        positions[i] = i;
+
+    HPX_TEST(v.get_values(hpx::launch::sync, positions) == expected);
+}
+
+template <typename ExPolicy, typename T>
+void test_unique(ExPolicy && policy, hpx::partitioned_vector<T>& v,
+    int range)
+{
+    std::vector<T> expected = fill_vector(v, range);
+    expected.erase(std::unique(expected.begin(), expected.end()),
+        expected.end());
+
+    auto result = hpx::parallel::unique(policy, v.begin(), v.end());
+    verify_vector(v, std::distance(v.begin(), result), expected);
+}
+
+template <typename ExPolicy, typename T>
+void test_unique_async(ExPolicy && policy, hpx::partitioned_vector<T>& v,
+    int range)
+{
+    std::vector<T> expected = fill_vector(v, range);
+    expected.erase(std::unique(expected.begin(), expected.end()),
+        expected.end());
+
+    auto f = hpx::parallel::unique(policy, v.begin(), v.end());
+    verify_vector(v, std::distance(v.begin(), f.get()), expected);
+}
+
+template <typename T>
+void unique_tests(hpx::partitioned_vector<T>& v)
+{
+    using namespace hpx::parallel;
+
+    // a range of 1 leaves a single element, the duplicates of a range of 2
+    // cross the boundaries of the partitions
+    for (int range : { 1000, 2, 1 })
+    {
+        test_unique(execution::seq, v, range);
+        test_unique(execution::par, v, range);
+        test_unique_async(execution::seq(execution::task), v, range);
+        test_unique_async(execution::par(execution::task), v, range);
+    }
+}
+
+template <typename T>
+void unique_tests(std::vector<hpx::id_type>& localities)
+{
+    std::size_t const num = 10007;
+
+    {
+        hpx::partitioned_vector<T> v(num);
+        unique_tests(v);
+    }
+    {
+        hpx::partitioned_vector<T> v(num, hpx::container_layout(localities));
+        unique_tests(v);
+    }
+    {
+        hpx::partitioned_vector<T> v(num,
+            hpx::container_layout(3 * localities.size(), localities));
+        unique_tests(v);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    unique_tests<int>(localities);
+    unique_tests<double>(localities);
+    return hpx::util::report_errors();
+}
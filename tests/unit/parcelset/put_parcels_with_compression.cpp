@@ -68,6 +68,10 @@ HPX_ACTION_USES_BZIP2_COMPRESSION(test1_action)
 HPX_ACTION_USES_ZLIB_COMPRESSION(test1_action)
 #elif defined(HPX_HAVE_COMPRESSION_SNAPPY)
 HPX_ACTION_USES_SNAPPY_COMPRESSION(test1_action)
+#elif defined(HPX_HAVE_COMPRESSION_LZ4)
+HPX_ACTION_USES_LZ4_COMPRESSION(test1_action)
+#elif defined(HPX_HAVE_COMPRESSION_ZSTD)
+HPX_ACTION_USES_ZSTD_COMPRESSION(test1_action)
 #endif
 
 HPX_REGISTER_ACTION(test1_action);
@@ -123,6 +127,10 @@ HPX_ACTION_USES_BZIP2_COMPRESSION(test2_action)
 HPX_ACTION_USES_ZLIB_COMPRESSION(test2_action)
 #elif defined(HPX_HAVE_COMPRESSION_SNAPPY)
 HPX_ACTION_USES_SNAPPY_COMPRESSION(test2_action)
+#elif defined(HPX_HAVE_COMPRESSION_LZ4)
+HPX_ACTION_USES_ADAPTIVE_COMPRESSION(test2_action, "lz4_serialization_filter")
+#elif defined(HPX_HAVE_COMPRESSION_ZSTD)
+HPX_ACTION_USES_ADAPTIVE_COMPRESSION(test2_action, "zstd_serialization_filter")
 #endif
 
 HPX_PLAIN_ACTION(test2, test2_action);
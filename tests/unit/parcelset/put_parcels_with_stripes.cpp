@@ -0,0 +1,96 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that messages whose zero-copy chunks are split over the stripes of a
+// TCP connection arrive intact (see hpx.parcel.tcp.stripe_connections).
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/serialization.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::serialization::serialize_buffer<double> buffer_type;
+
+double sum_buffers(buffer_type const& b1, buffer_type const& b2)
+{
+    return std::accumulate(b1.data(), b1.data() + b1.size(), 0.0) +
+        std::accumulate(b2.data(), b2.data() + b2.size(), 0.0);
+}
+HPX_PLAIN_ACTION(sum_buffers);
+
+buffer_type make_buffer(std::size_t size)
+{
+    buffer_type b(size);
+    for (std::size_t i = 0; i != size; ++i)
+        b[i] = double(i % 1000);
+    return b;
+}
+
+double expected_sum(std::size_t size)
+{
+    double sum = 0;
+    for (std::size_t i = 0; i != size; ++i)
+        sum += double(i % 1000);
+    return sum;
+}
+
+void test_stripes(hpx::id_type const& id, std::size_t size1, std::size_t size2)
+{
+    buffer_type b1 = make_buffer(size1);
+    buffer_type b2 = make_buffer(size2);
+
+    double result = hpx::async<sum_buffers_action>(id, b1, b2).get();
+    HPX_TEST_EQ(result, expected_sum(size1) + expected_sum(size2));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    for (hpx::id_type const& id : hpx::find_remote_localities())
+    {
+        // below the threshold
+        test_stripes(id, 1024, 1024);
+
+        // a single chunk split over all connections
+        test_stripes(id, 1000003, 0);
+
+        // several chunks, the stripes begin in the middle of chunks
+        test_stripes(id, 123457, 654323);
+
+        // more messages than connections
+        std::vector<hpx::future<double> > results;
+        for (std::size_t i = 0; i != 16; ++i)
+        {
+            results.push_back(hpx::async<sum_buffers_action>(
+                id, make_buffer(100000 + i), make_buffer(i)));
+        }
+        for (std::size_t i = 0; i != 16; ++i)
+        {
+            HPX_TEST_EQ(results[i].get(),
+                expected_sum(100000 + i) + expected_sum(i));
+        }
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.parcel.tcp.stripe_connections=3",
+        "hpx.parcel.tcp.stripe_threshold=65536"
+    };
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
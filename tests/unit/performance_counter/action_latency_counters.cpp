@@ -0,0 +1,141 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/util/hdr_histogram.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+int latency_test_function(int i)
+{
+    return i;
+}
+HPX_PLAIN_ACTION(latency_test_function, latency_test_action);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_hdr_histogram()
+{
+    hpx::util::hdr_histogram h;
+    HPX_TEST_EQ(h.count(), std::int64_t(0));
+    HPX_TEST_EQ(h.value_at_percentile(50.0), std::int64_t(0));
+
+    for (std::int64_t i = 1; i <= 10000; ++i)
+        h.record(i * 1000);
+
+    HPX_TEST_EQ(h.count(), std::int64_t(10000));
+    HPX_TEST_EQ(h.max(), std::int64_t(10000000));
+    HPX_TEST_EQ(h.value_at_percentile(100.0), std::int64_t(10000000));
+
+    // the relative error of the reported percentiles is bound by 1/64
+    double const percentiles[] = { 1.0, 50.0, 90.0, 99.0, 99.9 };
+    for (double p : percentiles)
+    {
+        double expected = p * 100000.0;
+        double value = static_cast<double>(h.value_at_percentile(p));
+        HPX_TEST(value >= expected);
+        HPX_TEST(value <= expected * (1.0 + 1.0 / 64));
+    }
+
+    // small values are tracked exactly
+    hpx::util::hdr_histogram small;
+    for (std::int64_t i = 0; i != 100; ++i)
+        small.record(i);
+    HPX_TEST_EQ(small.value_at_percentile(50.0), std::int64_t(49));
+
+    // values outside of the trackable range are clamped
+    hpx::util::hdr_histogram clamped(1000);
+    clamped.record(-1);
+    clamped.record(1000000);
+    HPX_TEST_EQ(clamped.value_at_percentile(0.0), std::int64_t(0));
+    HPX_TEST_EQ(clamped.max(), std::int64_t(1000));
+
+    h.reset();
+    HPX_TEST_EQ(h.count(), std::int64_t(0));
+    HPX_TEST_EQ(h.value_at_percentile(99.0), std::int64_t(0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_latency_counters()
+{
+    std::string const action = "latency_test_action";
+    hpx::performance_counters::performance_counter queue(
+        "/runtime{locality#0/total}/latency/action-queue@" + action + ",99.9");
+    hpx::performance_counters::performance_counter round_trip(
+        "/runtime{locality#0/total}/latency/action-round-trip@" + action);
+
+    // the measurement starts once the counters have been created
+    HPX_TEST_EQ(queue.get_value<std::int64_t>(hpx::launch::sync),
+        std::int64_t(0));
+
+    std::vector<hpx::future<int> > futures;
+    for (int i = 0; i != 100; ++i)
+    {
+        futures.push_back(
+            hpx::async<latency_test_action>(hpx::find_here(), i));
+    }
+    hpx::wait_all(futures);
+
+    HPX_TEST(queue.get_value<std::int64_t>(hpx::launch::sync, true) > 0);
+    HPX_TEST(round_trip.get_value<std::int64_t>(hpx::launch::sync) >= 0);
+
+    // the histogram was reset
+    HPX_TEST_EQ(queue.get_value<std::int64_t>(hpx::launch::sync),
+        std::int64_t(0));
+
+    // discovering the counters preserves the requested percentile
+    std::vector<hpx::performance_counters::counter_info> counters;
+    hpx::performance_counters::discover_counter_type(
+        "/runtime{locality#0/total}/latency/action-queue@" + action + ",90",
+        counters, hpx::performance_counters::discover_counters_full);
+
+    HPX_TEST_EQ(counters.size(), std::size_t(1));
+    if (!counters.empty())
+    {
+        HPX_TEST_EQ(counters[0].fullname_,
+            "/runtime{locality#0/total}/latency/action-queue@" + action +
+                ",90");
+    }
+
+    // unknown actions are rejected
+    bool caught_exception = false;
+    try
+    {
+        hpx::performance_counters::performance_counter unknown(
+            "/runtime{locality#0/total}/latency/action-queue@unknown_action");
+        unknown.get_value<std::int64_t>(hpx::launch::sync);
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_hdr_histogram();
+    test_latency_counters();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Initialize and run HPX.
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=1"
+    };
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,113 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/util/allocation_accounting.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/tagged_allocator.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace accounting = hpx::util::allocation_accounting;
+
+///////////////////////////////////////////////////////////////////////////////
+std::int64_t get_value(std::string const& name, bool reset = false)
+{
+    hpx::performance_counters::performance_counter counter(name);
+    return counter.get_value<std::int64_t>(hpx::launch::sync, reset);
+}
+
+void test_tagged_allocator()
+{
+    std::int64_t const live = accounting::get_statistic(
+        accounting::stat_bytes_live, accounting::serialization, false);
+    std::int64_t const count = accounting::get_statistic(
+        accounting::stat_allocations, accounting::serialization, false);
+
+    {
+        std::vector<char, hpx::util::tagged_allocator<char,
+            accounting::serialization> > v(1024);
+
+        HPX_TEST(accounting::get_statistic(accounting::stat_bytes_live,
+            accounting::serialization, false) >= live + 1024);
+        HPX_TEST(accounting::get_statistic(accounting::stat_high_water,
+            accounting::serialization, false) >= live + 1024);
+        HPX_TEST(accounting::get_statistic(accounting::stat_allocations,
+            accounting::serialization, false) > count);
+    }
+
+    HPX_TEST_EQ(accounting::get_statistic(accounting::stat_bytes_live,
+        accounting::serialization, false), live);
+}
+
+void test_accounted_size()
+{
+    std::int64_t const live = accounting::get_statistic(
+        accounting::stat_bytes_live, accounting::agas_caches, false);
+
+    {
+        accounting::accounted_size size(accounting::agas_caches);
+        size.update(4096);
+        HPX_TEST_EQ(accounting::get_statistic(accounting::stat_bytes_live,
+            accounting::agas_caches, false), live + 4096);
+
+        size.update(1024);
+        HPX_TEST_EQ(accounting::get_statistic(accounting::stat_bytes_live,
+            accounting::agas_caches, false), live + 1024);
+    }
+
+    HPX_TEST_EQ(accounting::get_statistic(accounting::stat_bytes_live,
+        accounting::agas_caches, false), live);
+}
+
+void test_counters()
+{
+    std::int64_t const count = get_value(
+        "/runtime{locality#0/total}/allocations/count@shared-states");
+
+    // the shared states of the futures are allocated by the runtime
+    std::vector<hpx::future<int> > futures;
+    for (int i = 0; i != 100; ++i)
+        futures.push_back(hpx::async([i]() { return i; }));
+
+    HPX_TEST(get_value(
+        "/runtime{locality#0/total}/allocations/bytes-live@shared-states") >=
+        std::int64_t(100 * sizeof(int)));
+
+    hpx::wait_all(futures);
+    futures.clear();
+
+    HPX_TEST(get_value(
+        "/runtime{locality#0/total}/allocations/count@shared-states") >=
+        count + 100);
+    HPX_TEST(get_value(
+        "/runtime{locality#0/total}/allocations/high-water@thread-data") > 0);
+    HPX_TEST(get_value(
+        "/runtime{locality#0/total}/allocations/bytes-live@thread-stacks") > 0);
+    HPX_TEST(get_value(
+        "/runtime{locality#0/total}/allocations/rate@shared-states") >= 0);
+
+    // all subsystems are discovered
+    std::vector<hpx::performance_counters::counter_info> counters;
+    hpx::performance_counters::discover_counter_type(
+        "/runtime{locality#0/total}/allocations/bytes-live",
+        counters, hpx::performance_counters::discover_counters_full);
+    HPX_TEST_EQ(counters.size(), std::size_t(accounting::subsystem_last));
+}
+
+int main()
+{
+    test_tagged_allocator();
+    test_accounted_size();
+    test_counters();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,169 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/counter_exporter.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef hpx::util::counter_exporter exporter_type;
+
+///////////////////////////////////////////////////////////////////////////////
+// read the segment the way an external monitor would do
+struct segment_reader
+{
+    explicit segment_reader(std::string const& name)
+      : base_(nullptr), size_(0)
+    {
+        int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        HPX_TEST(fd != -1);
+        if (fd == -1)
+            return;
+
+        struct stat st;
+        ::fstat(fd, &st);
+        size_ = std::size_t(st.st_size);
+        base_ = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        HPX_TEST(base_ != MAP_FAILED);
+    }
+
+    ~segment_reader()
+    {
+        if (base_ != nullptr && base_ != MAP_FAILED)
+            ::munmap(base_, size_);
+    }
+
+    exporter_type::segment_header const& header() const
+    {
+        return *static_cast<exporter_type::segment_header const*>(base_);
+    }
+
+    std::string name(std::size_t i) const
+    {
+        char const* p =
+            static_cast<char const*>(base_) + header().names_offset_;
+        std::uint32_t length = 0;
+        for (std::size_t j = 0; j <= i; ++j)
+        {
+            std::memcpy(&length, p, sizeof(length));
+            if (j != i)
+                p += sizeof(length) + length;
+        }
+        return std::string(p + sizeof(length), length);
+    }
+
+    std::int64_t value(std::size_t i, std::uint64_t& samples) const
+    {
+        exporter_type::entry const* e =
+            reinterpret_cast<exporter_type::entry const*>(&header() + 1);
+
+        std::uint64_t seq1 = 0, seq2 = 0;
+        std::int64_t value = 0;
+        do {
+            seq1 = header().sequence_.load(std::memory_order_acquire);
+            value = e[i].value_.load(std::memory_order_relaxed);
+            samples = header().num_samples_.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            seq2 = header().sequence_.load(std::memory_order_relaxed);
+        } while ((seq1 & 1) != 0 || seq1 != seq2);
+        return value;
+    }
+
+    void* base_;
+    std::size_t size_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+void test_export()
+{
+    std::string const counter =
+        "/threads{locality#0/total}/count/cumulative";
+
+    exporter_type ce(std::vector<std::string>(1, counter),
+        "hpx-counter-exporter-test", 100);
+    ce.start();
+
+    std::string const segment = ce.get_segment_name();
+    HPX_TEST_EQ(segment, std::string("/hpx-counter-exporter-test.0"));
+
+    {
+        segment_reader r(segment);
+        HPX_TEST_EQ(std::memcmp(r.header().magic_, "HPXCNTRS", 8), 0);
+        HPX_TEST_EQ(r.header().version_, exporter_type::version);
+        HPX_TEST_EQ(r.header().num_counters_, std::uint64_t(1));
+        HPX_TEST_EQ(r.name(0), counter);
+
+        std::uint64_t samples = 0;
+        std::int64_t before = r.value(0, samples);
+
+        std::vector<hpx::future<void> > futures;
+        for (int i = 0; i != 100; ++i)
+            futures.push_back(hpx::async([]() {}));
+        hpx::wait_all(futures);
+
+        // wait for the exporter to publish a new sample
+        std::uint64_t samples_after = samples;
+        std::int64_t after = before;
+        for (int i = 0; i != 1000 && after < before + 100; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            after = r.value(0, samples_after);
+        }
+        HPX_TEST(samples_after > samples);
+        HPX_TEST(after >= before + 100);
+    }
+
+    ce.stop();
+    HPX_TEST(ce.get_segment_name().empty());
+    HPX_TEST_EQ(::shm_open(segment.c_str(), O_RDONLY, 0), -1);
+}
+
+void test_derived_counters()
+{
+    // derived counters have to be evaluated by the reader
+    exporter_type ce(std::vector<std::string>(1,
+            "/statistics{/threads{locality#0/total}/count/cumulative}/average"),
+        "hpx-counter-exporter-test-derived", 100);
+
+    bool caught_exception = false;
+    try {
+        ce.start();
+    }
+    catch (hpx::exception const&) {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+    HPX_TEST(ce.get_segment_name().empty());
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_export();
+    test_derived_counters();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
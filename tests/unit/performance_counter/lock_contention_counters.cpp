@@ -0,0 +1,92 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/lcos/local/mutex.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/lock_profiler.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace lock_profiling = hpx::util::lock_profiling;
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::lcos::local::mutex mtx;
+std::size_t value = 0;
+
+void contend()
+{
+    std::lock_guard<hpx::lcos::local::mutex> l(mtx);
+
+    // give the other threads a chance to find the mutex locked
+    hpx::this_thread::yield();
+    ++value;
+}
+
+void test_lock_contention_counters()
+{
+    HPX_TEST(lock_profiling::lock_profiling_enabled);
+
+    std::vector<hpx::future<void> > futures;
+    for (int i = 0; i != 100; ++i)
+        futures.push_back(hpx::async(&contend));
+    hpx::wait_all(futures);
+
+    HPX_TEST_EQ(value, std::size_t(100));
+
+    // every acquisition is sampled
+    HPX_TEST(lock_profiling::get_statistic(
+        lock_profiling::stat_acquisitions, "", false) >= 100);
+    HPX_TEST(lock_profiling::get_statistic(
+        lock_profiling::stat_hold_time, "", false) > 0);
+
+    hpx::performance_counters::performance_counter contentions(
+        "/locks{locality#0/total}/count/contentions");
+    hpx::performance_counters::performance_counter wait_time(
+        "/locks{locality#0/total}/time/wait");
+
+    std::int64_t num_contentions =
+        contentions.get_value<std::int64_t>(hpx::launch::sync);
+    HPX_TEST(num_contentions > 0);
+    HPX_TEST(wait_time.get_value<std::int64_t>(hpx::launch::sync) > 0);
+
+    // the call sites of the mutex are discovered
+    std::vector<hpx::performance_counters::counter_info> counters;
+    hpx::performance_counters::discover_counter_type(
+        "/locks{locality#0/total}/count/acquisitions@mutex at *",
+        counters, hpx::performance_counters::discover_counters_full);
+    HPX_TEST(!counters.empty());
+
+    std::ostringstream report;
+    lock_profiling::write_report(report, 5);
+    HPX_TEST(report.str().find("call sites by wait time") !=
+        std::string::npos);
+    HPX_TEST(report.str().find("mutex at ") != std::string::npos);
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_lock_contention_counters();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.lock_profiling.enabled=1",
+        "hpx.lock_profiling.sample_rate=1"
+    };
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
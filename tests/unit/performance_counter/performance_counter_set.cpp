@@ -0,0 +1,106 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void run_threads()
+{
+    std::vector<hpx::future<void> > futures;
+    for (int i = 0; i != 100; ++i)
+        futures.push_back(hpx::async([]() {}));
+    hpx::wait_all(futures);
+}
+
+void test_counter_set()
+{
+    using hpx::performance_counters::counter_info;
+    using hpx::performance_counters::counter_value;
+    using hpx::performance_counters::performance_counter_set;
+
+    std::vector<std::string> const names = {
+        "/threads{locality#*/worker-thread#*}/count/cumulative",
+        "/threads{locality#*/total}/count/cumulative",
+        "/runtime{locality#*/total}/uptime"
+    };
+
+    performance_counter_set counters(names);
+
+    std::size_t const num_localities =
+        hpx::get_num_localities(hpx::launch::sync);
+    std::size_t const num_threads = hpx::get_os_thread_count();
+
+    std::vector<counter_info> infos = counters.get_counter_infos();
+    HPX_TEST_EQ(infos.size(), num_localities * (num_threads + 2));
+
+    run_threads();
+
+    // all counters of a locality are evaluated at once, the values are
+    // returned in the order the counters were added
+    std::vector<counter_value> values =
+        counters.get_counter_values(hpx::launch::sync);
+    HPX_TEST_EQ(values.size(), infos.size());
+
+    std::int64_t sum = 0;
+    std::int64_t total = 0;
+    for (std::size_t i = 0; i != values.size(); ++i)
+    {
+        HPX_TEST(hpx::performance_counters::status_is_valid(
+            values[i].status_));
+
+        hpx::performance_counters::counter_path_elements p;
+        hpx::performance_counters::get_counter_path_elements(
+            infos[i].fullname_, p);
+
+        if (p.parentinstanceindex_ != 0 ||
+            p.countername_ != "count/cumulative")
+        {
+            continue;
+        }
+
+        if (p.instancename_ == "total")
+            total = values[i].get_value<std::int64_t>();
+        else
+            sum += values[i].get_value<std::int64_t>();
+    }
+    HPX_TEST(total >= 100);
+    HPX_TEST(sum >= 100);
+
+    // resetting the counters is forwarded to each of them
+    counters.get_counter_values(hpx::launch::sync, true);
+    std::vector<std::int64_t> after =
+        counters.get_values<std::int64_t>(hpx::launch::sync);
+    HPX_TEST_EQ(after.size(), infos.size());
+    for (std::size_t i = 0; i != after.size(); ++i)
+    {
+        if (infos[i].fullname_.find("count/cumulative") != std::string::npos)
+            HPX_TEST(after[i] < 100);
+    }
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_counter_set();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=4"
+    };
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
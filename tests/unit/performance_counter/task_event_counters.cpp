@@ -0,0 +1,86 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/util/annotated_function.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::uint64_t work(std::uint64_t n)
+{
+    std::uint64_t result = 0;
+    for (std::uint64_t i = 0; i != n; ++i)
+        result += i * i;
+    return result;
+}
+
+void test_task_event_counters()
+{
+    std::string const task = "task_event_counters_test";
+
+    std::vector<hpx::future<std::uint64_t> > futures;
+    for (int i = 0; i != 100; ++i)
+    {
+        futures.push_back(hpx::async(
+            hpx::util::annotated_function(&work, task.c_str()), 10000));
+    }
+    hpx::wait_all(futures);
+
+    hpx::performance_counters::performance_counter count(
+        "/threads{locality#0/total}/task-events/count@" + task);
+    hpx::performance_counters::performance_counter instructions(
+        "/threads{locality#0/total}/task-events/instructions@" + task);
+
+    std::int64_t num_tasks = count.get_value<std::int64_t>(hpx::launch::sync);
+    std::int64_t num_instructions =
+        instructions.get_value<std::int64_t>(hpx::launch::sync, true);
+
+    // the hardware counters might not be accessible (perf_event_paranoid)
+    if (num_tasks == 0)
+        return;
+
+    HPX_TEST_EQ(num_tasks, std::int64_t(100));
+    HPX_TEST(num_instructions >= 100 * 10000);
+
+    // the counter was reset
+    HPX_TEST_EQ(instructions.get_value<std::int64_t>(hpx::launch::sync),
+        std::int64_t(0));
+
+    // the descriptions of the measured threads are discovered
+    std::vector<hpx::performance_counters::counter_info> counters;
+    hpx::performance_counters::discover_counter_type(
+        "/threads{locality#0/total}/task-events/count@task_event_*",
+        counters, hpx::performance_counters::discover_counters_full);
+
+    HPX_TEST_EQ(counters.size(), std::size_t(1));
+    if (!counters.empty())
+    {
+        HPX_TEST_EQ(counters[0].fullname_,
+            "/threads{locality#0/total}/task-events/count@" + task);
+    }
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_task_event_counters();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.task_counters.events=instructions"
+    };
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
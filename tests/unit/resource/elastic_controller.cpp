@@ -0,0 +1,125 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that the elastic_controller suspends the processing units of an idle
+// pool and resumes them once the pool is overloaded
+
+#include <hpx/hpx_init.hpp>
+
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/resource_partitioner.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/runtime/threads/elastic_controller.hpp>
+#include <hpx/runtime/threads/executors/pool_executor.hpp>
+#include <hpx/runtime/threads/policies/scheduler_mode.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+std::size_t const worker_pool_threads = 3;
+
+// Wait until the given number of worker threads of the pool is active
+bool wait_for_active(hpx::threads::thread_pool_base& pool,
+    std::size_t count, std::atomic<bool> const* done = nullptr)
+{
+    hpx::util::high_resolution_timer t;
+    while (t.elapsed() < 10)
+    {
+        if (pool.get_active_os_thread_count() == count)
+            return true;
+        if (done != nullptr && *done)
+            return false;
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    hpx::threads::thread_pool_base& worker_pool =
+        hpx::resource::get_thread_pool("worker");
+    HPX_TEST_EQ(worker_pool_threads, worker_pool.get_active_os_thread_count());
+
+    hpx::threads::elastic_controller_parameters params;
+    params.interval_ = 10;
+    params.hysteresis_ = 1;
+    params.min_threads_ = 1;
+
+    hpx::threads::elastic_controller controller(
+        std::vector<std::string>{"worker"}, params);
+    HPX_TEST(controller.start());
+
+    // the idle pool shrinks to the minimal number of worker threads
+    HPX_TEST(wait_for_active(worker_pool, params.min_threads_));
+
+    // the overloaded pool grows again, keep it busy until it has
+    std::atomic<bool> done(false);
+    std::atomic<bool> grown(false);
+
+    hpx::threads::executors::pool_executor worker_exec("worker");
+    std::vector<hpx::future<void>> fs;
+    for (std::size_t i = 0; i != 100 * worker_pool_threads; ++i)
+    {
+        fs.push_back(hpx::async(worker_exec,
+            [&grown]()
+            {
+                hpx::util::high_resolution_timer t;
+                while (!grown && t.elapsed() < 0.1)
+                {
+                }
+            }));
+    }
+
+    grown = wait_for_active(worker_pool, worker_pool_threads, &done);
+    HPX_TEST(grown);
+
+    hpx::wait_all(fs);
+    done = true;
+
+    HPX_TEST(controller.stop());
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "hpx.os_threads=4"
+    };
+
+    hpx::resource::partitioner rp(argc, argv, std::move(cfg));
+
+    rp.create_thread_pool("worker",
+        hpx::resource::scheduling_policy::local_priority_fifo,
+        hpx::threads::policies::scheduler_mode(
+            hpx::threads::policies::default_mode |
+            hpx::threads::policies::enable_elasticity));
+
+    std::size_t worker_pool_threads_added = 0;
+    for (const hpx::resource::numa_domain& d : rp.numa_domains())
+    {
+        for (const hpx::resource::core& c : d.cores())
+        {
+            for (const hpx::resource::pu& p : c.pus())
+            {
+                if (worker_pool_threads_added < worker_pool_threads)
+                {
+                    rp.add_resource(p, "worker");
+                    ++worker_pool_threads_added;
+                }
+            }
+        }
+    }
+
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,105 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that the idle worker threads of a borrowing pool execute the low
+// priority threads of a lending pool whose worker threads are busy
+
+#include <hpx/hpx_init.hpp>
+
+#include <hpx/async.hpp>
+#include <hpx/include/resource_partitioner.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/lcos/when_all.hpp>
+#include <hpx/runtime/threads/executors/pool_executor.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+std::size_t const num_tasks = 100;
+
+std::atomic<std::size_t> executed(0);
+std::atomic<std::size_t> borrowed(0);
+
+void low_priority_task()
+{
+    // the only worker thread of the default pool is busy running hpx_main
+    if (hpx::get_worker_thread_num() != 0)
+        ++borrowed;
+    ++executed;
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(std::size_t(2), hpx::resource::get_num_thread_pools());
+    HPX_TEST_EQ(std::size_t(1), hpx::resource::get_num_threads("default"));
+
+    hpx::threads::scheduled_executor exec =
+        hpx::threads::executors::pool_executor("default",
+            hpx::threads::thread_priority_low);
+
+    std::vector<hpx::future<void>> futures;
+    futures.reserve(num_tasks);
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        futures.push_back(hpx::async(exec, &low_priority_task));
+    }
+
+    // keep the worker thread of the default pool busy without yielding
+    auto const deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (executed.load() != num_tasks &&
+        std::chrono::steady_clock::now() < deadline)
+    {
+    }
+
+    HPX_TEST_EQ(executed.load(), num_tasks);
+    HPX_TEST_EQ(borrowed.load(), num_tasks);
+
+    hpx::wait_all(futures);
+
+    return hpx::finalize();
+}
+
+// this test must be run with 4 threads
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "hpx.os_threads=4"
+    };
+
+    // create the resource partitioner
+    hpx::resource::partitioner rp(argc, argv, std::move(cfg));
+
+    rp.create_thread_pool("default",
+        hpx::resource::scheduling_policy::local_priority_fifo);
+    rp.create_thread_pool("borrower",
+        hpx::resource::scheduling_policy::local_priority_fifo);
+
+    rp.set_pool_sharing_mode("default", hpx::resource::sharing_lender);
+    rp.set_pool_sharing_mode("borrower", hpx::resource::sharing_borrower);
+
+    // give one PU to the default pool and the others to the borrowing pool
+    bool first = true;
+    for (const hpx::resource::numa_domain& d : rp.numa_domains())
+    {
+        for (const hpx::resource::core& c : d.cores())
+        {
+            for (const hpx::resource::pu& p : c.pus())
+            {
+                rp.add_resource(p, first ? "default" : "borrower");
+                first = false;
+            }
+        }
+    }
+
+    // now run the test
+    HPX_TEST_EQ(hpx::init(), 0);
+    return hpx::util::report_errors();
+}
@@ -84,6 +84,9 @@ int main(int argc, char* argv[])
 #endif
 #if defined(HPX_HAVE_SHARED_PRIORITY_SCHEDULER)
                 hpx::resource::scheduling_policy::shared_priority,
+#endif
+#if defined(HPX_HAVE_HIERARCHICAL_SCHEDULER)
+                hpx::resource::scheduling_policy::hierarchical_priority,
 #endif
             };
 
@@ -11,8 +11,12 @@
 #include <hpx/runtime/serialization/input_archive.hpp>
 #include <hpx/runtime/serialization/output_archive.hpp>
 
+#include <hpx/exception.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <vector>
 
@@ -180,11 +184,54 @@ void test_member()
     }
 }
 
+// the objects are identified by an id, not by their class name
+void test_wire_format()
+{
+    using hpx::serialization::detail::polymorphic_nonintrusive_factory;
+
+    char const* name = hpx::serialization::detail::
+        get_serialization_name<E<float> >()();
+    HPX_TEST_EQ(polymorphic_nonintrusive_factory::get_id(name),
+        polymorphic_nonintrusive_factory::get_id(name));
+    HPX_TEST_NEQ(polymorphic_nonintrusive_factory::get_id(name),
+        polymorphic_nonintrusive_factory::get_id("A"));
+
+    std::vector<char> buffer;
+    {
+        std::shared_ptr<A> struct_a(new E<float>(1, 2.3f));
+        hpx::serialization::output_archive oarchive(buffer);
+        oarchive << struct_a;
+    }
+    HPX_TEST(std::search(buffer.begin(), buffer.end(),
+        name, name + std::strlen(name)) == buffer.end());
+
+    // an unknown id is rejected
+    buffer.clear();
+    {
+        hpx::serialization::output_archive oarchive(buffer);
+        oarchive << std::uint64_t(polymorphic_nonintrusive_factory::get_id(
+            "not a registered class"));
+    }
+    {
+        bool caught_exception = false;
+        try {
+            A a;
+            hpx::serialization::input_archive iarchive(buffer);
+            iarchive >> a;
+        }
+        catch (hpx::exception const& e) {
+            HPX_TEST_EQ(e.get_error(), hpx::serialization_error);
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+    }
+}
 
 int main()
 {
     test_basic();
     test_member();
+    test_wire_format();
 
     return hpx::util::report_errors();
 }
@@ -0,0 +1,96 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that archives can be read starting at positions
+// recorded while writing them (as done for decoding the segments of
+// parcel messages concurrently).
+
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+std::size_t const num_segments = 8;
+
+// every other segment holds data which is sent as a zero-copy chunk
+std::vector<double> make_segment(std::size_t i)
+{
+    std::vector<double> v(i % 2 == 0 ? 4 : 1024);
+    std::iota(v.begin(), v.end(), double(i));
+    return v;
+}
+
+void test_positions(std::vector<hpx::serialization::serialization_chunk>* chunks)
+{
+    // zero-copy chunks refer to the data written
+    std::vector<std::vector<double> > segments;
+    for (std::size_t i = 0; i != num_segments; ++i)
+        segments.push_back(make_segment(i));
+
+    std::vector<char> buffer;
+    std::vector<hpx::serialization::archive_position> positions;
+    std::uint32_t flags = 0;
+    std::size_t size = 0;
+    {
+        hpx::serialization::output_archive oarchive(buffer, 0, chunks);
+        flags = oarchive.flags();
+
+        for (std::size_t i = 0; i != num_segments; ++i)
+        {
+            hpx::serialization::archive_position pos;
+            HPX_TEST(oarchive.get_position(pos));
+            positions.push_back(pos);
+
+            oarchive << std::uint64_t(i) << segments[i];
+        }
+        oarchive.flush();
+        size = oarchive.bytes_written();
+    }
+
+    for (std::size_t i = 0; i != num_segments; ++i)
+    {
+        hpx::serialization::input_archive iarchive(
+            buffer, size, chunks, flags, positions[i]);
+
+        std::uint64_t index = 0;
+        std::vector<double> v;
+        iarchive >> index >> v;
+
+        HPX_TEST_EQ(index, std::uint64_t(i));
+        HPX_TEST(v == segments[i]);
+    }
+
+    // all segments can still be read sequentially
+    {
+        hpx::serialization::input_archive iarchive(buffer, size, chunks);
+        for (std::size_t i = 0; i != num_segments; ++i)
+        {
+            std::uint64_t index = 0;
+            std::vector<double> v;
+            iarchive >> index >> v;
+
+            HPX_TEST_EQ(index, std::uint64_t(i));
+            HPX_TEST(v == segments[i]);
+        }
+    }
+}
+
+int main()
+{
+    test_positions(nullptr);
+
+    std::vector<hpx::serialization::serialization_chunk> chunks;
+    test_positions(&chunks);
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,153 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that archives using the compact encoding (variable
+// length integers, delta encoded vectors) read back what was written, and
+// that the encoded data is smaller.
+
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+enum class color : std::int16_t
+{
+    red = -1,
+    green = 300
+};
+
+template <typename T>
+std::size_t round_trip(T const& value, std::uint32_t flags)
+{
+    std::vector<char> buffer;
+    std::size_t size = 0;
+    {
+        hpx::serialization::output_archive oarchive(buffer, flags);
+        oarchive << value;
+        size = oarchive.bytes_written();
+    }
+
+    hpx::serialization::input_archive iarchive(buffer, size);
+    HPX_TEST_EQ(iarchive.enable_compact_encoding(),
+        (flags & hpx::serialization::enable_compact_encoding) != 0);
+
+    T loaded;
+    iarchive >> loaded;
+    HPX_TEST(loaded == value);
+
+    return size;
+}
+
+template <typename T>
+void test_value(T const& value)
+{
+    round_trip(value, 0);
+    round_trip(value, hpx::serialization::enable_compact_encoding);
+}
+
+template <typename T>
+void test_integral()
+{
+    test_value(T(0));
+    test_value(T(1));
+    test_value(T(127));
+    test_value(T(128));
+    test_value((std::numeric_limits<T>::min)());
+    test_value((std::numeric_limits<T>::max)());
+    if (std::numeric_limits<T>::is_signed)
+    {
+        test_value(T(-1));
+        test_value(T(-128));
+    }
+
+    // sorted and unsorted vectors, including the extreme values
+    std::vector<T> sorted(1000);
+    std::iota(sorted.begin(), sorted.end(), T(0));
+    sorted.front() = (std::numeric_limits<T>::min)();
+    sorted.back() = (std::numeric_limits<T>::max)();
+    test_value(sorted);
+
+    std::vector<T> unsorted(sorted.rbegin(), sorted.rend());
+    test_value(unsorted);
+
+    test_value(std::vector<T>());
+    test_value(std::vector<T>(1, T(42)));
+}
+
+void test_sizes()
+{
+    std::uint32_t const compact = hpx::serialization::enable_compact_encoding;
+
+    // small values take a single byte instead of eight
+    HPX_TEST_EQ(round_trip(std::uint64_t(5), compact) + 7,
+        round_trip(std::uint64_t(5), 0));
+    HPX_TEST_EQ(round_trip(std::int32_t(-5), compact) + 7,
+        round_trip(std::int32_t(-5), 0));
+
+    // consecutive indices take a single byte each
+    std::vector<std::uint64_t> indices(1000);
+    std::iota(indices.begin(), indices.end(), std::uint64_t(1) << 40);
+    HPX_TEST_LT(round_trip(indices, compact),
+        indices.size() + 16 + round_trip(std::uint64_t(0), 0));
+
+    // byte vectors are copied as before, only their size is encoded
+    std::vector<char> bytes(1000, 'x');
+    HPX_TEST_EQ(round_trip(bytes, compact) + 6, round_trip(bytes, 0));
+}
+
+void test_gids()
+{
+    std::vector<hpx::naming::gid_type> gids;
+    for (std::uint32_t locality = 0; locality != 3; ++locality)
+    {
+        for (std::uint64_t i = 0; i != 100; ++i)
+        {
+            hpx::naming::gid_type gid =
+                hpx::naming::get_gid_from_locality_id(locality);
+            gid.set_lsb((std::uint64_t(1) << 36) + 3 * i);
+            gids.push_back(gid);
+        }
+    }
+    gids.push_back(hpx::naming::invalid_gid);
+
+    std::uint32_t const compact = hpx::serialization::enable_compact_encoding;
+
+    std::size_t fixed = round_trip(gids, 0);
+    std::size_t encoded = round_trip(gids, compact);
+    HPX_TEST_LT(4 * encoded, fixed);
+
+    // single gids are not affected
+    test_value(gids.front());
+}
+
+int main()
+{
+    test_integral<std::int16_t>();
+    test_integral<std::uint16_t>();
+    test_integral<std::int32_t>();
+    test_integral<std::uint32_t>();
+    test_integral<std::int64_t>();
+    test_integral<std::uint64_t>();
+
+    test_value(color::red);
+    test_value(color::green);
+    test_value(true);
+    test_value(3.5);
+
+    test_sizes();
+    test_gids();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,154 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/map.hpp>
+#include <hpx/runtime/serialization/pooled.hpp>
+#include <hpx/runtime/serialization/string.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+template <typename T>
+void round_trip(T const& in, T& out)
+{
+    std::vector<char> buffer;
+    hpx::serialization::output_archive oarchive(buffer);
+    oarchive << in;
+
+    hpx::serialization::input_archive iarchive(buffer);
+    iarchive >> out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_vector()
+{
+    std::vector<std::vector<double> > out(3, std::vector<double>(100, 1.0));
+    double const* data = out[1].data();
+
+    std::vector<std::vector<double> > in = { { 1.0, 2.0 }, { 3.0 } };
+    round_trip(in, out);
+
+    HPX_TEST(in == out);
+    HPX_TEST(out[1].data() == data);
+    HPX_TEST(out[1].capacity() >= std::size_t(100));
+
+    // loading an empty vector clears the elements
+    round_trip(std::vector<std::vector<double> >(), out);
+    HPX_TEST(out.empty());
+}
+
+void test_strings()
+{
+    std::vector<std::string> out(2, std::string(100, 'x'));
+    char const* data = out[0].data();
+
+    std::vector<std::string> in = { "a", "b", "c" };
+    round_trip(in, out);
+
+    HPX_TEST(in == out);
+    HPX_TEST(out[0].data() == data);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_map()
+{
+    std::map<int, std::vector<double> > out;
+    out[1] = std::vector<double>(100, 1.0);
+    out[3] = std::vector<double>(100, 3.0);
+    out[5] = std::vector<double>(100, 5.0);
+    out[9] = std::vector<double>(100, 9.0);
+
+    std::vector<double> const* node = &out[3];
+    double const* data = out[3].data();
+
+    std::map<int, std::vector<double> > in;
+    in[0] = { 0.0 };
+    in[3] = { 3.0, 3.0 };
+    in[4] = { 4.0 };
+    in[7] = { 7.0 };
+
+    round_trip(in, out);
+
+    HPX_TEST(in == out);
+
+    // the element with a key which was present before is reused
+    HPX_TEST(&out[3] == node);
+    HPX_TEST(out[3].data() == data);
+
+    round_trip(std::map<int, std::vector<double> >(), out);
+    HPX_TEST(out.empty());
+}
+
+void test_bitwise_map()
+{
+    std::map<double, double> out = { { 1.0, 1.0 }, { 2.0, 2.0 } };
+    double const* value = &out[2.0];
+
+    std::map<double, double> in = { { 0.5, 0.5 }, { 2.0, 4.0 }, { 3.0, 6.0 } };
+    round_trip(in, out);
+
+    HPX_TEST(in == out);
+    HPX_TEST(&out[2.0] == value);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+struct pooled_tag {};
+typedef hpx::serialization::pooled<std::vector<double>, pooled_tag>
+    pooled_vector;
+
+void test_pooled()
+{
+    std::vector<double> const values(1000, 42.0);
+
+    double const* data = nullptr;
+    {
+        pooled_vector out;
+        round_trip(pooled_vector(values), out);
+        HPX_TEST(*out == values);
+        data = out->data();
+    }
+
+    // the object loaded into before is taken from the pool again, its
+    // storage is reused
+    {
+        pooled_vector out;
+        round_trip(pooled_vector(std::vector<double>(10, 1.0)), out);
+        HPX_TEST_EQ(out->size(), std::size_t(10));
+        HPX_TEST_EQ((*out)[9], 1.0);
+        HPX_TEST(out->data() == data);
+    }
+
+    // moved from handles acquire a new object when assigned to
+    {
+        pooled_vector from(values);
+        pooled_vector to(std::move(from));
+        HPX_TEST(*to == values);
+
+        from = to;
+        HPX_TEST(*from == values);
+        HPX_TEST(&*from != &*to);
+    }
+}
+
+int main()
+{
+    test_vector();
+    test_strings();
+    test_map();
+    test_bitwise_map();
+    test_pooled();
+
+    return hpx::util::report_errors();
+}
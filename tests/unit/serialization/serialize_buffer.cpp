@@ -9,9 +9,13 @@
 #include <hpx/include/actions.hpp>
 #include <hpx/include/lcos.hpp>
 #include <hpx/util/lightweight_test.hpp>
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
+#include <hpx/runtime/serialization/receive_buffer_registry.hpp>
 #include <hpx/runtime/serialization/serialize_buffer.hpp>
 
 #include <cstddef>
+#include <cstring>
 #include <memory>
 #include <vector>
 
@@ -128,6 +132,75 @@ void test_initialization_from_vector(std::size_t max_size)
     }
 }
 
+template <typename T>
+void test_registered_receive_buffer(std::size_t size)
+{
+    typedef hpx::serialization::serialize_buffer<T> buffer_type;
+
+    std::vector<T> send_vec(size);
+    for (std::size_t i = 0; i != size; ++i)
+        send_vec[i] = static_cast<T>(size - i);
+
+    std::vector<T> target(size);
+    hpx::serialization::receive_buffer_registration<T> reg(
+        target.data(), target.size());
+
+    buffer_type send_buffer(send_vec.data(), size, buffer_type::reference);
+    send_buffer.set_receive_target(reg.key());
+
+    {
+        std::vector<char> buffer;
+        hpx::serialization::output_archive oarchive(buffer);
+        oarchive << send_buffer;
+
+        // the data is received into the registered memory
+        buffer_type recv_buffer;
+        hpx::serialization::input_archive iarchive(buffer);
+        iarchive >> recv_buffer;
+
+        HPX_TEST_EQ(recv_buffer.size(), size);
+        HPX_TEST(recv_buffer.data() == target.data());
+        HPX_TEST(send_vec == target);
+    }
+
+    {
+        // a buffer too small for the data is not used
+        hpx::serialization::receive_buffer_registration<T> small(
+            target.data(), size - 1);
+        send_buffer.set_receive_target(small.key());
+
+        std::vector<char> buffer;
+        hpx::serialization::output_archive oarchive(buffer);
+        oarchive << send_buffer;
+
+        buffer_type recv_buffer;
+        hpx::serialization::input_archive iarchive(buffer);
+        iarchive >> recv_buffer;
+
+        HPX_TEST_EQ(recv_buffer.size(), size);
+        HPX_TEST(recv_buffer.data() != target.data());
+        HPX_TEST(0 == std::memcmp(recv_buffer.data(), send_vec.data(),
+            size * sizeof(T)));
+    }
+
+    {
+        // the memory is not used anymore once it was unregistered
+        std::uint64_t key = reg.key();
+        reg.reset();
+        send_buffer.set_receive_target(key);
+
+        std::vector<char> buffer;
+        hpx::serialization::output_archive oarchive(buffer);
+        oarchive << send_buffer;
+
+        buffer_type recv_buffer;
+        hpx::serialization::input_archive iarchive(buffer);
+        iarchive >> recv_buffer;
+
+        HPX_TEST(recv_buffer.data() != target.data());
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(int argc, char* argv[])
 {
@@ -153,6 +226,12 @@ int hpx_main(int argc, char* argv[])
         test_fixed_size_initialization_for_persistent_buffers<double>(size);
     }
 
+    for (std::size_t size = 2; size <= max_size; size *= 2)
+    {
+        test_registered_receive_buffer<char>(size);
+        test_registered_receive_buffer<double>(size);
+    }
+
     return hpx::finalize();
 }
 
@@ -0,0 +1,77 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that data affinity hints refer to an existing NUMA
+// domain and that threads created with such a hint are executed.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/runtime/threads/thread_init_data.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+std::size_t const num_tasks = 100;
+
+std::atomic<std::size_t> count(0);
+
+hpx::threads::thread_result_type increment(hpx::threads::thread_arg_type)
+{
+    ++count;
+    return hpx::threads::thread_result_type(
+        hpx::threads::terminated, hpx::threads::invalid_thread_id);
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    // first touch places the data on the NUMA domain of this worker
+    std::vector<double> data(1024 * 1024, 1.0);
+
+    hpx::threads::thread_schedule_hint hint =
+        hpx::threads::get_data_affinity_hint(data.data());
+
+    if (hint.mode == hpx::threads::thread_schedule_hint_mode_numa)
+    {
+        std::size_t num_domains = (std::max)(std::size_t(1),
+            hpx::threads::get_topology().get_number_of_numa_nodes());
+        HPX_TEST(hint.hint >= 0);
+        HPX_TEST_LT(std::size_t(hint.hint), num_domains);
+    }
+    else
+    {
+        HPX_TEST_EQ(hint.mode, hpx::threads::thread_schedule_hint_mode_none);
+    }
+
+    std::vector<hpx::threads::thread_init_data> tasks;
+    tasks.reserve(num_tasks);
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        tasks.emplace_back(&increment,
+            hpx::util::thread_description("increment"), 0,
+            hpx::threads::thread_priority_normal, hint,
+            hpx::threads::get_stack_size(
+                hpx::threads::thread_stacksize_default));
+    }
+
+    hpx::threads::register_threads(tasks);
+
+    while (count.load() != num_tasks)
+        hpx::this_thread::yield();
+
+    HPX_TEST_EQ(count.load(), num_tasks);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+
+    return hpx::util::report_errors();
+}
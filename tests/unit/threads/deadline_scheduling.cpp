@@ -0,0 +1,162 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that threads having a deadline are run in earliest
+// deadline first order before other threads, and that the thread running a
+// task inherits the priority and the deadline of the threads waiting for it.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/runtime/threads/executors/pool_executor.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/steady_clock.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+std::size_t const num_tasks = 10;
+
+hpx::util::steady_clock::time_point get_deadline()
+{
+    return hpx::threads::get_thread_deadline(hpx::threads::get_self_id());
+}
+
+void test_earliest_deadline_first()
+{
+    std::vector<int> order;
+
+    std::vector<hpx::future<void>> fs;
+    fs.reserve(3 * num_tasks);
+
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        fs.push_back(hpx::async([&order]() { order.push_back(-1); }));
+    }
+
+    // the later the tasks are added the earlier their deadline is
+    for (std::size_t i = 0; i != 2 * num_tasks; ++i)
+    {
+        hpx::threads::executors::pool_executor exec("default",
+            std::chrono::seconds(2 * num_tasks - i));
+        fs.push_back(hpx::async(exec,
+            [&order, i]() { order.push_back(int(i)); }));
+    }
+
+    hpx::wait_all(fs);
+
+    HPX_TEST_EQ(order.size(), 3 * num_tasks);
+    for (std::size_t i = 0; i != order.size(); ++i)
+    {
+        int expected = i < 2 * num_tasks ? int(2 * num_tasks - i - 1) : -1;
+        HPX_TEST_EQ(order[i], expected);
+    }
+}
+
+void test_deadline_inherited_by_children()
+{
+    hpx::threads::executors::pool_executor exec("default",
+        std::chrono::seconds(10));
+
+    hpx::async(exec,
+        []()
+        {
+            hpx::util::steady_clock::time_point deadline = get_deadline();
+            HPX_TEST(deadline !=
+                (hpx::util::steady_clock::time_point::max)());
+
+            hpx::async([deadline]()
+                {
+                    HPX_TEST(get_deadline() == deadline);
+                }).get();
+        }).get();
+}
+
+// The producer keeps yielding until the waiter has boosted it, the waiter
+// starts waiting for the producer only once it is running.
+template <typename Boosted>
+void test_inheritance(hpx::threads::executors::pool_executor& waiter_exec,
+    Boosted boosted)
+{
+    hpx::lcos::local::promise<void> started;
+    hpx::future<void> started_f = started.get_future();
+
+    hpx::shared_future<bool> producer = hpx::async(
+        [&started, boosted]() -> bool
+        {
+            started.set_value();
+            for (std::size_t i = 0; i != 1000000; ++i)
+            {
+                if (boosted())
+                    return true;
+                hpx::this_thread::yield();
+            }
+            return false;
+        });
+
+    hpx::future<bool> waiter = hpx::async(waiter_exec,
+        [&started_f, producer]() -> bool
+        {
+            started_f.get();
+            return producer.get();
+        });
+
+    HPX_TEST(waiter.get());
+}
+
+void test_priority_inheritance()
+{
+    hpx::threads::executors::pool_executor exec("default",
+        hpx::threads::thread_priority_high);
+
+    test_inheritance(exec,
+        []()
+        {
+            return hpx::threads::get_thread_priority(
+                hpx::threads::get_self_id()) ==
+                    hpx::threads::thread_priority_high;
+        });
+}
+
+void test_deadline_inheritance()
+{
+    hpx::threads::executors::pool_executor exec("default",
+        std::chrono::seconds(10));
+
+    test_inheritance(exec,
+        []()
+        {
+            return get_deadline() !=
+                (hpx::util::steady_clock::time_point::max)();
+        });
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_earliest_deadline_first();
+    test_deadline_inherited_by_children();
+    test_priority_inheritance();
+    test_deadline_inheritance();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // the order in which the threads are run is verified using a single
+    // worker thread
+    std::vector<std::string> const cfg =
+    {
+        "hpx.os_threads=1"
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+
+    return hpx::util::report_errors();
+}
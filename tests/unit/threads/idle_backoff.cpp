@@ -0,0 +1,58 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that work is still picked up by worker threads which went
+// to sleep because of the adaptive idle back-off.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+std::size_t const num_bursts = 20;
+std::size_t const num_tasks = 100;
+
+int hpx_main(int argc, char* argv[])
+{
+    std::atomic<std::size_t> count(0);
+
+    for (std::size_t i = 0; i != num_bursts; ++i)
+    {
+        // give the other worker threads time to go to sleep
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(i % 4));
+
+        std::vector<hpx::future<void>> fs;
+        fs.reserve(num_tasks);
+        for (std::size_t j = 0; j != num_tasks; ++j)
+        {
+            fs.push_back(hpx::async([&count]() { ++count; }));
+        }
+        hpx::wait_all(fs);
+    }
+
+    HPX_TEST_EQ(count.load(), num_bursts * num_tasks);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg =
+    {
+        "hpx.os_threads=4",
+        "hpx.adaptive_idle_backoff=1"
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,73 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that the local scheduler executes all work when using
+// randomized victim selection and stealing half of the staged tasks.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+std::size_t const num_tasks = 10000;
+
+int hpx_main(int argc, char* argv[])
+{
+    std::atomic<std::size_t> count(0);
+
+    // all tasks are created on one worker thread, the other worker threads
+    // have to steal them
+    hpx::async([&count]()
+        {
+            std::vector<hpx::future<void>> fs;
+            fs.reserve(num_tasks);
+            for (std::size_t i = 0; i != num_tasks; ++i)
+            {
+                fs.push_back(hpx::async([&count]() { ++count; }));
+            }
+            hpx::wait_all(fs);
+        }).get();
+
+    HPX_TEST_EQ(count.load(), num_tasks);
+
+#if defined(HPX_HAVE_THREAD_STEALING_COUNTS)
+    hpx::performance_counters::performance_counter successful(
+        "/threads{locality#0/total}/count/successful-steals");
+    hpx::performance_counters::performance_counter failed(
+        "/threads{locality#0/total}/count/failed-steals");
+
+    std::int64_t num_successful =
+        successful.get_value<std::int64_t>(hpx::launch::sync);
+    std::int64_t num_failed =
+        failed.get_value<std::int64_t>(hpx::launch::sync);
+
+    HPX_TEST_LT(std::int64_t(0), num_successful + num_failed);
+#endif
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg =
+    {
+        "hpx.os_threads=4",
+        "hpx.scheduler=local",
+        "hpx.thread_queue.steal_victim_selection=power-of-two",
+        "hpx.thread_queue.steal_half=1"
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,155 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/compat/thread.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/lockfree/deque.hpp>
+#include <hpx/util/lockfree/epoch.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+typedef boost::lockfree::deque<
+        std::uint64_t, boost::lockfree::reclaiming_freelist_t
+    > deque_type;
+
+using hpx::util::lockfree::epoch_domain;
+
+///////////////////////////////////////////////////////////////////////////////
+std::atomic<std::size_t> deleted(0);
+
+void count_deletion(void* p)
+{
+    ++deleted;
+    delete static_cast<int*>(p);
+}
+
+// nodes are deleted only after the epoch has advanced twice, which it
+// can't while a thread is still inside of a guard
+void test_guard_delays_deletion()
+{
+    deleted = 0;
+
+    std::atomic<bool> entered(false);
+    std::atomic<bool> done(false);
+
+    hpx::compat::thread t(
+        [&]()
+        {
+            hpx::util::lockfree::epoch_guard guard;
+            entered = true;
+            while (!done)
+                hpx::compat::this_thread::yield();
+        });
+
+    while (!entered)
+        hpx::compat::this_thread::yield();
+
+    epoch_domain::get().retire(new int(42), &count_deletion);
+    for (int i = 0; i != 10; ++i)
+        epoch_domain::get().collect();
+
+    HPX_TEST_EQ(deleted.load(), std::size_t(0));
+
+    done = true;
+    t.join();
+
+    for (int i = 0; i != 1000 && deleted == 0; ++i)
+    {
+        epoch_domain::get().collect();
+        hpx::compat::this_thread::yield();
+    }
+
+    HPX_TEST_EQ(deleted.load(), std::size_t(1));
+}
+
+// the deque caches as many nodes as it was created with, the nodes in
+// excess of those are returned to the allocator
+void test_bounded_cache()
+{
+    deque_type q(16);
+
+    for (std::uint64_t i = 0; i != 1000; ++i)
+        HPX_TEST(q.push_left(i));
+
+    for (std::uint64_t i = 0; i != 1000; ++i)
+    {
+        std::uint64_t value = 0;
+        HPX_TEST(q.pop_right(value));
+        HPX_TEST_EQ(value, i);
+    }
+    HPX_TEST(q.empty());
+
+    HPX_TEST_EQ(q.trim(4), std::size_t(12));
+    HPX_TEST_EQ(q.trim(), std::size_t(4));
+
+    for (int i = 0; i != 1000 && epoch_domain::get().retired_count() != 0;
+         ++i)
+    {
+        epoch_domain::get().collect();
+        hpx::compat::this_thread::yield();
+    }
+
+    HPX_TEST_EQ(epoch_domain::get().retired_count(), std::size_t(0));
+}
+
+// concurrent producers and consumers, run with an address sanitizer to
+// detect accesses to deleted nodes
+void test_concurrent(std::size_t num_threads, std::uint64_t items)
+{
+    deque_type q(8);
+
+    std::atomic<std::uint64_t> sum(0);
+    std::atomic<std::uint64_t> popped(0);
+
+    std::vector<hpx::compat::thread> threads;
+    for (std::size_t t = 0; t != num_threads; ++t)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                for (std::uint64_t i = 0; i != items; ++i)
+                {
+                    if (t % 2 == 0)
+                        q.push_left(i);
+                    else
+                        q.push_right(i);
+
+                    std::uint64_t value = 0;
+                    if (t % 2 == 0 ? q.pop_right(value) : q.pop_left(value))
+                    {
+                        sum += value;
+                        ++popped;
+                    }
+                }
+                epoch_domain::get().collect();
+            });
+    }
+
+    for (hpx::compat::thread& t : threads)
+        t.join();
+
+    std::uint64_t value = 0;
+    while (q.pop_left(value))
+    {
+        sum += value;
+        ++popped;
+    }
+
+    HPX_TEST_EQ(popped.load(), num_threads * items);
+    HPX_TEST_EQ(sum.load(), num_threads * (items * (items - 1) / 2));
+}
+
+int main()
+{
+    test_guard_delays_deletion();
+    test_bounded_cache();
+    test_concurrent(4, 100000);
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,112 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that work submitted by OS threads which are not known
+// to the runtime through hpx::post_from_external is executed on HPX threads.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/run_as.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/yield_while.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+std::size_t const num_producers = 4;
+std::size_t const num_tasks = 10000;
+
+///////////////////////////////////////////////////////////////////////////////
+struct count_task
+{
+    void operator()() const
+    {
+        if (hpx::threads::get_self_ptr() == nullptr)
+            ++(*not_on_hpx_thread_);
+        ++(*count_);
+    }
+
+    std::atomic<std::size_t>* count_;
+    std::atomic<std::size_t>* not_on_hpx_thread_;
+};
+
+void test_post_from_external()
+{
+    std::atomic<std::size_t> count(0);
+    std::atomic<std::size_t> not_on_hpx_thread(0);
+
+    std::vector<std::thread> producers;
+    for (std::size_t i = 0; i != num_producers; ++i)
+    {
+        producers.emplace_back([&]()
+        {
+            count_task task = { &count, &not_on_hpx_thread };
+            for (std::size_t j = 0; j != num_tasks; ++j)
+                hpx::post_from_external(task);
+        });
+    }
+
+    for (std::thread& t : producers)
+        t.join();
+
+    hpx::util::yield_while([&]()
+    {
+        return count.load() != num_producers * num_tasks;
+    });
+
+    HPX_TEST_EQ(count.load(), num_producers * num_tasks);
+    HPX_TEST_EQ(not_on_hpx_thread.load(), std::size_t(0));
+}
+
+void test_post_from_external_bulk()
+{
+    std::atomic<std::size_t> count(0);
+    std::atomic<std::size_t> not_on_hpx_thread(0);
+
+    std::thread producer([&]()
+    {
+        // batches smaller and larger than the number of worker threads
+        for (std::size_t size : { 1, 3, 100, 1000 })
+        {
+            count_task task = { &count, &not_on_hpx_thread };
+            std::vector<count_task> tasks(size, task);
+            hpx::post_from_external(tasks.begin(), tasks.end());
+        }
+    });
+    producer.join();
+
+    hpx::util::yield_while([&]()
+    {
+        return count.load() != 1104;
+    });
+
+    HPX_TEST_EQ(count.load(), std::size_t(1104));
+    HPX_TEST_EQ(not_on_hpx_thread.load(), std::size_t(0));
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_post_from_external();
+    test_post_from_external_bulk();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // submitting work without a running runtime is reported as an error
+    {
+        hpx::error_code ec(hpx::lightweight);
+        hpx::post_from_external([]() {}, ec);
+        HPX_TEST(ec);
+    }
+
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,72 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that all work items registered as a batch are executed,
+// for a batch with normal priority tasks only and for a mixed batch.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/runtime/threads/thread_init_data.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+std::size_t const num_tasks = 1000;
+
+std::atomic<std::size_t> count(0);
+
+hpx::threads::thread_result_type increment(hpx::threads::thread_arg_type)
+{
+    ++count;
+    return hpx::threads::thread_result_type(
+        hpx::threads::terminated, hpx::threads::invalid_thread_id);
+}
+
+void test_register_threads(bool mixed_priorities)
+{
+    count = 0;
+
+    std::vector<hpx::threads::thread_init_data> data;
+    data.reserve(num_tasks);
+
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        hpx::threads::thread_priority priority =
+            (mixed_priorities && i % 3 == 0) ?
+                hpx::threads::thread_priority_high :
+                hpx::threads::thread_priority_normal;
+
+        data.emplace_back(&increment,
+            hpx::util::thread_description("increment"), 0, priority,
+            hpx::threads::thread_schedule_hint(),
+            hpx::threads::get_stack_size(
+                hpx::threads::thread_stacksize_default));
+    }
+
+    hpx::threads::register_threads(data);
+
+    while (count.load() != num_tasks)
+        hpx::this_thread::yield();
+
+    HPX_TEST_EQ(count.load(), num_tasks);
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_register_threads(false);
+    test_register_threads(true);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+
+    return hpx::util::report_errors();
+}
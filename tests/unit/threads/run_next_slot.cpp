@@ -0,0 +1,96 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that suspended threads which are made ready while the
+// run-next slot of the worker threads is enabled are all resumed, both for
+// chains of dependent threads and for many threads made ready at once.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+std::size_t const num_tasks = 1000;
+
+void test_chain()
+{
+    std::vector<hpx::lcos::local::promise<void>> promises(num_tasks + 1);
+    std::vector<hpx::future<void>> fs;
+    fs.reserve(num_tasks);
+
+    std::atomic<std::size_t> count(0);
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        hpx::future<void> f = promises[i].get_future();
+        hpx::lcos::local::promise<void>& next = promises[i + 1];
+        fs.push_back(hpx::async(
+            [&count, &next](hpx::future<void> f)
+            {
+                f.get();
+                ++count;
+                next.set_value();
+            },
+            std::move(f)));
+    }
+
+    hpx::future<void> last = promises[num_tasks].get_future();
+    promises[0].set_value();
+    last.get();
+    hpx::wait_all(fs);
+
+    HPX_TEST_EQ(count.load(), num_tasks);
+}
+
+void test_fan_out()
+{
+    hpx::lcos::local::promise<void> start;
+    hpx::shared_future<void> started = start.get_future().share();
+
+    std::atomic<std::size_t> count(0);
+    std::vector<hpx::future<void>> fs;
+    fs.reserve(num_tasks);
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        fs.push_back(hpx::async(
+            [&count, started]()
+            {
+                started.get();
+                ++count;
+            }));
+    }
+
+    start.set_value();
+    hpx::wait_all(fs);
+
+    HPX_TEST_EQ(count.load(), num_tasks);
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_chain();
+    test_fan_out();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg =
+    {
+        "hpx.os_threads=4",
+        "hpx.thread_queue.run_next_slot=1"
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,125 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that run-to-completion threads are executed, and that
+// they continue correctly after yielding or waiting for a future.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/runtime/threads/thread_init_data.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+std::size_t const num_tasks = 100;
+std::size_t const num_waiting_tasks = 2;
+
+std::atomic<std::size_t> count(0);
+
+void register_run_to_completion(std::vector<hpx::threads::thread_function_type>&
+    funcs)
+{
+    std::vector<hpx::threads::thread_init_data> tasks;
+    tasks.reserve(funcs.size());
+    for (auto& f : funcs)
+    {
+        tasks.emplace_back(std::move(f),
+            hpx::util::thread_description("run_to_completion"));
+        tasks.back().run_to_completion = true;
+    }
+
+    hpx::threads::register_threads(tasks);
+}
+
+void wait_for(std::size_t expected)
+{
+    while (count.load() != expected)
+        hpx::this_thread::yield();
+
+    HPX_TEST_EQ(count.load(), expected);
+}
+
+void test_no_suspension()
+{
+    count.store(0);
+
+    std::vector<hpx::threads::thread_function_type> funcs;
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        funcs.push_back([](hpx::threads::thread_arg_type)
+            {
+                ++count;
+                return hpx::threads::thread_result_type(
+                    hpx::threads::terminated, hpx::threads::invalid_thread_id);
+            });
+    }
+    register_run_to_completion(funcs);
+
+    wait_for(num_tasks);
+}
+
+void test_yield()
+{
+    count.store(0);
+
+    std::vector<hpx::threads::thread_function_type> funcs;
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        funcs.push_back([](hpx::threads::thread_arg_type)
+            {
+                hpx::this_thread::yield();
+                ++count;
+                return hpx::threads::thread_result_type(
+                    hpx::threads::terminated, hpx::threads::invalid_thread_id);
+            });
+    }
+    register_run_to_completion(funcs);
+
+    wait_for(num_tasks);
+}
+
+void test_wait()
+{
+    count.store(0);
+
+    hpx::lcos::local::promise<void> p;
+    hpx::shared_future<void> f = p.get_future().share();
+
+    std::vector<hpx::threads::thread_function_type> funcs;
+    for (std::size_t i = 0; i != num_waiting_tasks; ++i)
+    {
+        funcs.push_back([f](hpx::threads::thread_arg_type)
+            {
+                f.get();
+                ++count;
+                return hpx::threads::thread_result_type(
+                    hpx::threads::terminated, hpx::threads::invalid_thread_id);
+            });
+    }
+    register_run_to_completion(funcs);
+
+    p.set_value();
+
+    wait_for(num_waiting_tasks);
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_no_suspension();
+    test_yield();
+    test_wait();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+
+    return hpx::util::report_errors();
+}
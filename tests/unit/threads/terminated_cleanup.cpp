@@ -0,0 +1,73 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that terminated threads are cleaned up by the idle
+// worker threads without the busy ones having to do so.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/runtime/threads/policies/cleanup_statistics.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using hpx::threads::policies::cleanup_statistics;
+
+std::size_t const num_tasks = 2000;
+
+int hpx_main(int argc, char* argv[])
+{
+    cleanup_statistics::get_idle_count(true);
+    cleanup_statistics::get_forced_count(true);
+
+    std::atomic<std::size_t> count(0);
+
+    std::vector<hpx::future<void>> fs;
+    fs.reserve(num_tasks);
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        fs.push_back(hpx::async([&count]() { ++count; }));
+    }
+    hpx::wait_all(fs);
+
+    HPX_TEST_EQ(count.load(), num_tasks);
+
+    // give the worker threads time to become idle
+    for (int i = 0; i != 100; ++i)
+    {
+        if (cleanup_statistics::get_idle_count(false) >=
+                std::int64_t(num_tasks))
+        {
+            break;
+        }
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    HPX_TEST_LTE(std::int64_t(num_tasks),
+        cleanup_statistics::get_idle_count(false));
+    HPX_TEST_EQ(cleanup_statistics::get_forced_count(false), std::int64_t(0));
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg =
+    {
+        "hpx.os_threads=4",
+        "hpx.thread_queue.max_terminated_threads=1000000"
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,100 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that HPX threads running on a pool with time slicing give up their
+// worker thread at the preemption points once their time slice has expired.
+// The pool has a single worker thread, the threads scheduled while another
+// thread is busy can run only if that thread is preempted.
+
+#include <hpx/hpx_init.hpp>
+
+#include <hpx/apply.hpp>
+#include <hpx/include/parallel_executor_parameters.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/resource_partitioner.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_preemption_point()
+{
+    std::atomic<bool> executed(false);
+    hpx::apply([&]() { executed = true; });
+
+    auto const deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!executed.load() && std::chrono::steady_clock::now() < deadline)
+    {
+        hpx::this_thread::preemption_point();
+    }
+
+    HPX_TEST(executed.load());
+}
+
+void test_for_loop()
+{
+    std::size_t const size = 20000;
+
+    std::atomic<bool> executed(false);
+    bool executed_before_end = false;
+
+    // every iteration takes about a microsecond, the loop runs for much
+    // longer than its time slice
+    hpx::parallel::for_loop(
+        hpx::parallel::execution::par.with(
+            hpx::parallel::execution::static_chunk_size(size)),
+        std::size_t(0), size,
+        [&](std::size_t i)
+        {
+            if (i == 0)
+                hpx::apply([&]() { executed = true; });
+            else if (i == size - 1)
+                executed_before_end = executed.load();
+
+            auto const start = std::chrono::steady_clock::now();
+            while (std::chrono::steady_clock::now() - start <
+                std::chrono::microseconds(1))
+            {
+            }
+        });
+
+    HPX_TEST(executed_before_end);
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(std::size_t(1), hpx::resource::get_num_threads("default"));
+
+    test_preemption_point();
+    test_for_loop();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "hpx.os_threads=1",
+        "hpx.thread_time_slice=1000"
+    };
+
+    hpx::resource::partitioner rp(argc, argv, std::move(cfg));
+
+    rp.create_thread_pool("default",
+        hpx::resource::scheduling_policy::local_priority_fifo,
+        hpx::threads::policies::scheduler_mode(
+            hpx::threads::policies::default_mode |
+            hpx::threads::policies::time_slicing));
+
+    HPX_TEST_EQ(hpx::init(), 0);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,137 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that timed waits and timed executions are handled
+// correctly if their timeouts are kept in the timer wheel
+// (hpx.timer_wheel.enabled=1).
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+std::size_t const num_sleepers = 1000;
+
+///////////////////////////////////////////////////////////////////////////////
+// threads sleeping for different durations never wake up early
+void test_sleep_for()
+{
+    std::atomic<std::size_t> early(0);
+
+    std::vector<hpx::future<void> > fs;
+    fs.reserve(num_sleepers);
+    for (std::size_t i = 0; i != num_sleepers; ++i)
+    {
+        fs.push_back(hpx::async([i, &early]()
+        {
+            // spans several levels of the wheel (with 100us ticks)
+            std::chrono::microseconds duration((i * 37) % 50000);
+
+            hpx::util::steady_clock::time_point start =
+                hpx::util::steady_clock::now();
+            hpx::this_thread::sleep_for(duration);
+
+            if (hpx::util::steady_clock::now() - start < duration)
+                ++early;
+        }));
+    }
+    hpx::wait_all(fs);
+
+    HPX_TEST_EQ(early.load(), std::size_t(0));
+}
+
+// waits which are ended early cancel their timeouts
+void test_cancel()
+{
+    hpx::lcos::local::mutex mtx;
+    hpx::lcos::local::condition_variable cond;
+
+    for (std::size_t i = 0; i != 100; ++i)
+    {
+        bool ready = false;
+        hpx::future<void> f = hpx::async([&]()
+        {
+            std::lock_guard<hpx::lcos::local::mutex> l(mtx);
+            ready = true;
+            cond.notify_one();
+        });
+
+        {
+            std::unique_lock<hpx::lcos::local::mutex> l(mtx);
+            HPX_TEST(cond.wait_for(l, std::chrono::seconds(10),
+                [&ready]() { return ready; }));
+        }
+        f.get();
+    }
+
+    // a wait which times out
+    {
+        std::unique_lock<hpx::lcos::local::mutex> l(mtx);
+        HPX_TEST(cond.wait_for(l, std::chrono::milliseconds(10)) ==
+            hpx::lcos::local::cv_status::timeout);
+    }
+
+    // a future which never becomes ready
+    hpx::lcos::local::promise<void> p;
+    hpx::future<void> f = p.get_future();
+    HPX_TEST(f.wait_for(std::chrono::milliseconds(10)) ==
+        hpx::lcos::future_status::timeout);
+    p.set_value();
+    HPX_TEST(f.wait_for(std::chrono::milliseconds(10)) ==
+        hpx::lcos::future_status::ready);
+}
+
+// timed executions go through the wheel as well
+void test_timed_execution()
+{
+    std::vector<hpx::future<int> > fs;
+    fs.reserve(num_sleepers);
+
+    hpx::util::steady_clock::time_point start =
+        hpx::util::steady_clock::now();
+    for (std::size_t i = 0; i != num_sleepers; ++i)
+    {
+        fs.push_back(hpx::make_ready_future_after(
+            std::chrono::milliseconds(i % 20), int(i)));
+    }
+
+    for (std::size_t i = 0; i != num_sleepers; ++i)
+    {
+        HPX_TEST_EQ(fs[i].get(), int(i));
+    }
+
+    HPX_TEST(hpx::util::steady_clock::now() - start >=
+        std::chrono::milliseconds(19));
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_sleep_for();
+    test_cancel();
+    test_timed_execution();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg =
+    {
+        "hpx.timer_wheel.enabled=1",
+        "hpx.timer_wheel.resolution=100"
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+
+    return hpx::util::report_errors();
+}
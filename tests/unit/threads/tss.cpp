@@ -11,6 +11,9 @@
 #include <hpx/util/lightweight_test.hpp>
 
 #include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <vector>
 #include <utility>
@@ -206,6 +209,61 @@ void test_tss_cleanup_not_called_for_null_pointer()
     HPX_TEST(!tss_cleanup_called);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// more instances than there are fixed slots, the last ones use the tss map
+void test_tss_more_instances_than_slots()
+{
+    std::size_t const num_instances =
+        2 * hpx::threads::coroutines::detail::tss_num_slots + 1;
+
+    std::vector<std::unique_ptr<hpx::threads::thread_specific_ptr<int> > >
+        ptrs;
+    for (std::size_t i = 0; i != num_instances; ++i)
+    {
+        ptrs.emplace_back(new hpx::threads::thread_specific_ptr<int>);
+        ptrs.back()->reset(new int(static_cast<int>(i)));
+    }
+
+    for (std::size_t i = 0; i != num_instances; ++i)
+    {
+        HPX_TEST(ptrs[i]->get() != nullptr);
+        HPX_TEST_EQ(*ptrs[i]->get(), static_cast<int>(i));
+    }
+}
+
+// a new instance which reuses the slot of a destroyed one does not see the
+// value the destroyed one has left in another thread
+void thread_reusing_slot(
+    std::unique_ptr<hpx::threads::thread_specific_ptr<int> >& ptr,
+    hpx::lcos::local::promise<void>& value_set,
+    hpx::shared_future<void> ptr_replaced)
+{
+    ptr->reset(new int(42));
+    value_set.set_value();
+
+    ptr_replaced.get();
+    HPX_TEST(ptr->get() == nullptr);
+}
+
+void test_tss_slot_reuse()
+{
+    std::unique_ptr<hpx::threads::thread_specific_ptr<int> > ptr(
+        new hpx::threads::thread_specific_ptr<int>);
+
+    hpx::lcos::local::promise<void> value_set;
+    hpx::lcos::local::promise<void> ptr_replaced;
+
+    hpx::thread t(&thread_reusing_slot, std::ref(ptr), std::ref(value_set),
+        ptr_replaced.get_future().share());
+
+    value_set.get_future().get();
+    ptr.reset();
+    ptr.reset(new hpx::threads::thread_specific_ptr<int>);
+    ptr_replaced.set_value();
+
+    t.join();
+}
+
 int main(int argc, char**argv)
 {
     test_tss();
@@ -214,6 +272,8 @@ int main(int argc, char**argv)
     test_tss_does_no_cleanup_with_null_cleanup_function();
     test_tss_does_not_call_cleanup_after_ptr_destroyed();
     test_tss_cleanup_not_called_for_null_pointer();
+    test_tss_more_instances_than_slots();
+    test_tss_slot_reuse();
 
     return hpx::util::report_errors();
 }
@@ -0,0 +1,132 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/util/annotated_function.hpp>
+#include <hpx/util/annotation.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/thread_description.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_interning()
+{
+    std::uint32_t id1 = hpx::util::intern_annotation("annotation_test_1");
+    std::uint32_t id2 = hpx::util::intern_annotation("annotation_test_2");
+
+    HPX_TEST_NEQ(id1, std::uint32_t(0));
+    HPX_TEST_NEQ(id2, std::uint32_t(0));
+    HPX_TEST_NEQ(id1, id2);
+    HPX_TEST_EQ(hpx::util::intern_annotation(nullptr), std::uint32_t(0));
+
+    // the same name results in the same id, no matter where it is stored
+    std::string name("annotation_test_");
+    name += "1";
+    HPX_TEST_EQ(hpx::util::intern_annotation(name), id1);
+    HPX_TEST_EQ(hpx::util::find_annotation(name), id1);
+    HPX_TEST_EQ(hpx::util::find_annotation("annotation_test_unknown"),
+        std::uint32_t(0));
+
+    // the table keeps its own copy of the name
+    char const* interned = hpx::util::get_annotation_name(id1);
+    name.assign("something else");
+    HPX_TEST_EQ(std::string(interned), std::string("annotation_test_1"));
+    HPX_TEST(hpx::util::get_annotation_name(0) == nullptr);
+
+    // literals are hashed at compile time
+    hpx::util::annotation a = HPX_ANNOTATION("annotation_test_1");
+    HPX_TEST_EQ(a.id(), id1);
+    HPX_TEST(a.name() == interned);
+    HPX_TEST(a == hpx::util::annotation(std::string("annotation_test_1")));
+    HPX_TEST(a != hpx::util::annotation("annotation_test_2"));
+    HPX_TEST(!hpx::util::annotation());
+}
+
+void test_concurrent_interning()
+{
+    std::size_t const count = 1000;
+    std::size_t const tasks = 8;
+
+    std::size_t initial_count = hpx::util::get_annotation_count();
+
+    std::vector<hpx::future<std::vector<std::uint32_t> > > futures;
+    for (std::size_t t = 0; t != tasks; ++t)
+    {
+        futures.push_back(hpx::async(
+            [count]()
+            {
+                std::vector<std::uint32_t> ids;
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    ids.push_back(hpx::util::intern_annotation(
+                        "annotation_test_concurrent_" + std::to_string(i)));
+                }
+                return ids;
+            }));
+    }
+    hpx::wait_all(futures);
+
+    std::vector<std::uint32_t> ids = futures[0].get();
+    for (std::size_t t = 1; t != tasks; ++t)
+        HPX_TEST(futures[t].get() == ids);
+
+    HPX_TEST_EQ(hpx::util::get_annotation_count(), initial_count + count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        HPX_TEST_EQ(std::string(hpx::util::get_annotation_name(ids[i])),
+            "annotation_test_concurrent_" + std::to_string(i));
+    }
+}
+
+#if defined(HPX_HAVE_THREAD_DESCRIPTION)
+void test_thread_description()
+{
+    hpx::util::annotation a = HPX_ANNOTATION("annotation_test_desc");
+
+    hpx::util::thread_description desc(a);
+    HPX_TEST_EQ(desc.get_annotation_id(), a.id());
+    HPX_TEST(desc.get_description() == a.name());
+
+    // plain strings are interned on demand
+    hpx::util::thread_description plain("annotation_test_desc");
+    HPX_TEST_EQ(plain.get_annotation_id(), a.id());
+
+    // annotated functions carry the id of their interned name
+    std::string name("annotation_test_");
+    name += "dynamic";
+    auto f = hpx::util::annotated_function(
+        []()
+        {
+            hpx::util::thread_description d =
+                hpx::threads::get_thread_description(
+                    hpx::threads::get_self_id());
+            return d.get_annotation_id();
+        },
+        name);
+    name.clear();
+
+    std::uint32_t id = hpx::util::find_annotation("annotation_test_dynamic");
+    HPX_TEST_NEQ(id, std::uint32_t(0));
+    HPX_TEST_EQ(hpx::async(f).get(), id);
+}
+#endif
+
+int main()
+{
+    test_interning();
+    test_concurrent_interning();
+#if defined(HPX_HAVE_THREAD_DESCRIPTION)
+    test_thread_description();
+#endif
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,148 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that the reads and writes of async_file transfer the
+// data correctly, with and without registered buffers, and that several
+// operations can be in flight at once.
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/async_file.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using hpx::util::async_file;
+
+char const* const filename = "async_file_test.dat";
+
+std::size_t const block_size = 4096;
+std::size_t const num_blocks = 64;
+
+std::vector<char> make_data()
+{
+    std::vector<char> data(block_size * num_blocks);
+    for (std::size_t i = 0; i != data.size(); ++i)
+        data[i] = char(i * 7 + i / block_size);
+    return data;
+}
+
+void test_read_write(bool register_buffers)
+{
+    std::vector<char> data = make_data();
+    std::vector<char> data2(data.size(), 0);
+
+    if (register_buffers)
+    {
+        async_file::register_buffer(data.data(), data.size());
+        async_file::register_buffer(data2.data(), data2.size());
+    }
+
+    {
+        async_file f(filename, O_CREAT | O_TRUNC | O_WRONLY);
+        HPX_TEST(f.is_open());
+
+        // write all blocks at once, in reverse order
+        std::vector<hpx::future<std::size_t> > fs;
+        for (std::size_t i = num_blocks; i != 0; --i)
+        {
+            std::size_t const offset = (i - 1) * block_size;
+            fs.push_back(f.pwrite(&data[offset], block_size, offset));
+        }
+        for (auto& fut : fs)
+            HPX_TEST_EQ(fut.get(), block_size);
+
+        f.sync().get();
+    }
+
+    {
+        async_file f(filename, O_RDONLY);
+
+        std::vector<hpx::future<std::size_t> > fs;
+        for (std::size_t i = 0; i != num_blocks; ++i)
+            fs.push_back(f.read(&data2[i * block_size], block_size));
+        for (auto& fut : fs)
+            HPX_TEST_EQ(fut.get(), block_size);
+
+        HPX_TEST_EQ(f.tell(), std::uint64_t(data.size()));
+        HPX_TEST(data == data2);
+
+        // reading at the end of the file transfers nothing
+        char c = 0;
+        HPX_TEST_EQ(f.read(&c, 1).get(), std::size_t(0));
+    }
+
+    if (register_buffers)
+    {
+        async_file::unregister_buffer(data.data());
+        async_file::unregister_buffer(data2.data());
+    }
+}
+
+void test_scatter_gather()
+{
+    std::vector<char> data = make_data();
+    std::vector<char> data2(data.size(), 0);
+
+    async_file f(filename, O_CREAT | O_TRUNC | O_RDWR);
+
+    std::vector<iovec> iov(num_blocks);
+    for (std::size_t i = 0; i != num_blocks; ++i)
+    {
+        iov[i].iov_base = &data[i * block_size];
+        iov[i].iov_len = block_size;
+    }
+    HPX_TEST_EQ(f.pwritev(iov.data(), iov.size(), 0).get(), data.size());
+
+    for (std::size_t i = 0; i != num_blocks; ++i)
+        iov[i].iov_base = &data2[i * block_size];
+    HPX_TEST_EQ(f.preadv(iov.data(), iov.size(), 0).get(), data.size());
+
+    HPX_TEST(data == data2);
+}
+
+void test_errors()
+{
+    bool caught_exception = false;
+    try {
+        async_file f("/this/file/does/not/exist", O_RDONLY);
+    }
+    catch (hpx::exception const&) {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    // writing to a file opened for reading fails
+    {
+        async_file f(filename, O_RDONLY);
+        char c = 0;
+        hpx::future<std::size_t> fut = f.write(&c, 1);
+        fut.wait();
+        HPX_TEST(fut.has_exception());
+    }
+
+    async_file f;
+    HPX_TEST(!f.is_open());
+    HPX_TEST(f.sync().has_exception());
+}
+
+int main()
+{
+    test_read_write(false);
+    test_read_write(true);
+    test_scatter_gather();
+    test_errors();
+
+    std::remove(filename);
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,126 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/util/autotuner.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_hill_climbing()
+{
+    hpx::util::autotuner tuner(1000, 2);
+
+    std::int64_t x = -1;
+    std::int64_t chunk_size = -1;
+
+    tuner.add_tunable("x", {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10},
+        [&x](std::int64_t value) { x = value; });
+    tuner.add_tunable("chunk_size", {1, 2, 4, 8, 16, 32},
+        [&chunk_size](std::int64_t value) { chunk_size = value; });
+
+    std::size_t iterations = 0;
+    while (tuner.is_tuning())
+    {
+        tuner.begin_iteration();
+
+        std::int64_t log2_chunk_size = 0;
+        while ((std::int64_t(1) << log2_chunk_size) < chunk_size)
+            ++log2_chunk_size;
+
+        tuner.end_iteration(double((x - 6) * (x - 6) +
+            (log2_chunk_size - 3) * (log2_chunk_size - 3)));
+
+        HPX_TEST(++iterations < 1000);
+    }
+
+    // the search has converged long before the end of the warm-up phase
+    HPX_TEST_EQ(x, 6);
+    HPX_TEST_EQ(chunk_size, 8);
+    HPX_TEST_EQ(tuner.get("x"), 6);
+    HPX_TEST_EQ(tuner.get("chunk_size"), 8);
+
+    // the best configuration stays in place
+    tuner.begin_iteration();
+    tuner.end_iteration(100.0);
+    HPX_TEST(!tuner.is_tuning());
+    HPX_TEST_EQ(x, 6);
+}
+
+void test_warmup_limit()
+{
+    hpx::util::autotuner tuner(4, 1);
+
+    std::int64_t x = -1;
+    tuner.add_tunable("x", {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10},
+        [&x](std::int64_t value) { x = value; });
+
+    // the objective keeps improving towards zero
+    for (std::size_t i = 0; i != 4; ++i)
+    {
+        HPX_TEST(tuner.is_tuning());
+        tuner.begin_iteration();
+        tuner.end_iteration(double(x));
+    }
+
+    HPX_TEST(!tuner.is_tuning());
+    HPX_TEST_EQ(x, 2);
+
+    std::vector<std::pair<std::string, std::int64_t> > best = tuner.best();
+    HPX_TEST_EQ(best.size(), std::size_t(1));
+    HPX_TEST_EQ(best[0].first, std::string("x"));
+    HPX_TEST_EQ(best[0].second, 2);
+}
+
+void test_config_tunable()
+{
+    std::string const key("hpx.thread_queue.min_tasks_to_steal_pending");
+
+    hpx::util::autotuner tuner(100);
+    tuner.add_config_tunable(key, {0, 4, 16, 64});
+
+    while (tuner.is_tuning())
+    {
+        tuner.begin_iteration();
+
+        std::int64_t value = std::stoll(hpx::get_config_entry(key, ""));
+        tuner.end_iteration(double(value > 16 ? value - 16 : 16 - value));
+    }
+
+    HPX_TEST_EQ(hpx::get_config_entry(key, ""), std::string("16"));
+
+    std::string const filename("autotuner_test.ini");
+    tuner.save(filename);
+
+    std::ifstream in(filename);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    in.close();
+    std::remove(filename.c_str());
+
+    HPX_TEST(contents.str().find("[hpx.thread_queue]\n"
+        "min_tasks_to_steal_pending = 16\n") != std::string::npos);
+
+    // restore the default
+    hpx::set_config_entry(key, "0");
+}
+
+int main()
+{
+    test_hill_climbing();
+    test_warmup_limit();
+    test_config_tunable();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,147 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/cache/concurrent_clock_cache.hpp>
+#include <hpx/util/cache/statistics/concurrent_full_statistics.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct entry
+{
+    std::uint64_t value1;
+    std::uint64_t value2;
+};
+
+typedef hpx::util::cache::concurrent_clock_cache<
+        std::uint64_t, entry, std::hash<std::uint64_t>,
+        hpx::util::cache::statistics::concurrent_full_statistics
+    > cache_type;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_insert()
+{
+    cache_type c(64);
+    HPX_TEST_EQ(c.capacity(), std::size_t(64));
+
+    for (std::uint64_t i = 0; i != 32; ++i)
+    {
+        HPX_TEST(c.insert(i, entry{i, 2 * i}));
+    }
+    HPX_TEST(c.size() <= std::size_t(32));
+
+    // inserting the same key again fails
+    std::uint64_t key = 0;
+    entry e = {0, 0};
+    if (c.get_entry(1, key, e))
+    {
+        HPX_TEST(!c.insert(1, entry{3, 3}));
+        HPX_TEST_EQ(key, std::uint64_t(1));
+        HPX_TEST_EQ(e.value2, std::uint64_t(2));
+    }
+
+    // the cache never grows beyond its capacity
+    for (std::uint64_t i = 32; i != 1024; ++i)
+    {
+        c.update(i, entry{i, 2 * i});
+        HPX_TEST(c.size() <= c.capacity());
+    }
+    HPX_TEST(c.get_statistics().evictions(false) != 0);
+
+    // whatever is found has the right value
+    for (std::uint64_t i = 0; i != 1024; ++i)
+    {
+        if (c.get_entry(i, e))
+        {
+            HPX_TEST_EQ(e.value1, i);
+            HPX_TEST_EQ(e.value2, 2 * i);
+        }
+    }
+}
+
+void test_update_and_erase()
+{
+    cache_type c(16);
+
+    c.update(1, entry{1, 1});
+    c.update(1, entry{1, 2});
+
+    entry e = {0, 0};
+    HPX_TEST(c.get_entry(1, e));
+    HPX_TEST_EQ(e.value2, std::uint64_t(2));
+
+    HPX_TEST(!c.update_if(1, entry{1, 3},
+        [](std::uint64_t, std::uint64_t) { return true; }));
+    HPX_TEST(c.get_entry(1, e));
+    HPX_TEST_EQ(e.value2, std::uint64_t(2));
+
+    c.update(2, entry{2, 2});
+    HPX_TEST_EQ(c.erase(
+        [](cache_type::entry_pair const& p) { return p.first == 1; }),
+        std::size_t(1));
+    HPX_TEST(!c.get_entry(1, e));
+    HPX_TEST(c.get_entry(2, e));
+
+    c.clear();
+    HPX_TEST_EQ(c.size(), std::size_t(0));
+    HPX_TEST(!c.get_entry(2, e));
+
+    // resizing keeps the entries
+    c.update(3, entry{3, 3});
+    c.reserve(1024);
+    HPX_TEST_EQ(c.capacity(), std::size_t(1024));
+    HPX_TEST(c.get_entry(3, e));
+    HPX_TEST_EQ(e.value1, std::uint64_t(3));
+}
+
+void test_concurrent_access()
+{
+    cache_type c(256);
+
+    std::vector<hpx::future<void> > futures;
+    for (std::uint64_t t = 0; t != 8; ++t)
+    {
+        futures.push_back(hpx::async([&c, t]()
+        {
+            for (std::uint64_t i = 0; i != 10000; ++i)
+            {
+                std::uint64_t const key = (i * 7 + t) % 512;
+                if (i % 4 == 0)
+                {
+                    c.update(key, entry{key, key + 1});
+                    continue;
+                }
+
+                // readers must never see a partially written entry
+                entry e = {0, 0};
+                if (c.get_entry(key, e))
+                {
+                    HPX_TEST_EQ(e.value1, key);
+                    HPX_TEST_EQ(e.value2, key + 1);
+                }
+            }
+        }));
+    }
+    hpx::wait_all(futures);
+
+    HPX_TEST(c.size() <= c.capacity());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_insert();
+    test_update_and_erase();
+    test_concurrent_access();
+
+    return hpx::util::report_errors();
+}
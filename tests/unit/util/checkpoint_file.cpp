@@ -0,0 +1,158 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that save_checkpoint_file streams the objects to a file
+// which restore_checkpoint_file can read back, that incremental checkpoints
+// write the changed blocks only, and that restored serialize_buffers
+// referencing the file in place behave like copies.
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/runtime/serialization/serialize_buffer.hpp>
+#include <hpx/util/checkpoint_file.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using hpx::util::checkpoint_file_options;
+using hpx::util::restore_checkpoint_file;
+using hpx::util::save_checkpoint_file;
+
+char const* const filename = "checkpoint_file_test.ckpt";
+
+checkpoint_file_options get_options(bool incremental)
+{
+    checkpoint_file_options options;
+    options.block_size_ = 64 * 1024;
+    options.max_pending_writes_ = 2;
+    options.incremental_ = incremental;
+    return options;
+}
+
+void test_save_restore()
+{
+    std::string str = "I am a string of characters";
+    std::vector<double> vec(100000);
+    for (std::size_t i = 0; i != vec.size(); ++i)
+        vec[i] = double(i);
+
+    // the vector occupies more than 12 blocks
+    std::size_t written = save_checkpoint_file(
+        filename, get_options(false), str, vec, hpx::make_ready_future(42))
+        .get();
+    HPX_TEST_LT(std::size_t(12), written);
+
+    std::string str2;
+    std::vector<double> vec2;
+    int i2 = 0;
+    restore_checkpoint_file(filename, str2, vec2, i2);
+
+    HPX_TEST_EQ(str, str2);
+    HPX_TEST(vec == vec2);
+    HPX_TEST_EQ(i2, 42);
+}
+
+void test_incremental()
+{
+    std::vector<double> vec(100000, 1.0);
+
+    std::size_t written =
+        save_checkpoint_file(filename, get_options(true), vec).get();
+    HPX_TEST_LT(std::size_t(0), written);
+
+    // nothing has changed
+    written = save_checkpoint_file(filename, get_options(true), vec).get();
+    HPX_TEST_EQ(written, std::size_t(0));
+
+    // a single block has changed
+    vec[vec.size() / 2] = 2.0;
+    written = save_checkpoint_file(filename, get_options(true), vec).get();
+    HPX_TEST_EQ(written, std::size_t(1));
+
+    std::vector<double> vec2;
+    restore_checkpoint_file(filename, vec2);
+    HPX_TEST(vec == vec2);
+}
+
+void test_serialize_buffer()
+{
+    typedef hpx::serialization::serialize_buffer<double> buffer_type;
+
+    buffer_type buffer(100000);
+    for (std::size_t i = 0; i != buffer.size(); ++i)
+        buffer[i] = double(i);
+
+    std::vector<int> vec(1000, 42);
+    save_checkpoint_file(filename, buffer, vec).get();
+
+    // the restored buffer keeps the file mapped after the restore
+    buffer_type buffer2;
+    {
+        std::vector<int> vec2;
+        checkpoint_file_options options;
+        options.verify_ = false;
+        restore_checkpoint_file(filename, options, buffer2, vec2);
+        HPX_TEST(vec == vec2);
+    }
+
+    HPX_TEST_EQ(buffer.size(), buffer2.size());
+    for (std::size_t i = 0; i != buffer.size(); ++i)
+        HPX_TEST_EQ(buffer[i], buffer2[i]);
+
+    // modifying the restored data does not modify the file
+    buffer2[0] = -1.0;
+
+    buffer_type buffer3;
+    std::vector<int> vec3;
+    restore_checkpoint_file(filename, buffer3, vec3);
+    HPX_TEST_EQ(buffer3[0], 0.0);
+    HPX_TEST_EQ(buffer2[0], -1.0);
+
+    // a new checkpoint replaces the file, the restored data is not affected
+    buffer[1] = -2.0;
+    save_checkpoint_file(filename, buffer, vec).get();
+    HPX_TEST_EQ(buffer3[1], 1.0);
+}
+
+void test_corrupted()
+{
+    std::vector<double> vec(100000, 1.0);
+    save_checkpoint_file(filename, vec).get();
+
+    // overwrite some of the data following the header
+    {
+        std::fstream f(filename,
+            std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(4096 + 1000);
+        f.write("corrupted", 9);
+    }
+
+    bool caught_exception = false;
+    try {
+        std::vector<double> vec2;
+        restore_checkpoint_file(filename, vec2);
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::serialization_error);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+int main()
+{
+    test_save_restore();
+    test_incremental();
+    test_serialize_buffer();
+    test_corrupted();
+
+    std::remove(filename);
+
+    return hpx::util::report_errors();
+}
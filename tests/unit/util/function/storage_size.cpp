@@ -0,0 +1,103 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/unique_function.hpp>
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+static int alloc_count = 0;
+static int dealloc_count = 0;
+static int live_count = 0;
+
+// a callable too large for the default storage of a function, but small
+// enough for the storage of a thread function
+struct medium_object
+{
+    medium_object() { ++live_count; }
+    medium_object(medium_object const&) { ++live_count; }
+    ~medium_object() { --live_count; }
+
+    int operator()() const { return 42; }
+
+    void* data[6];
+};
+
+// the same, counting the allocations of its storage
+struct counted_medium_object : medium_object
+{
+    static void* operator new(std::size_t size)
+    {
+        ++alloc_count;
+        return ::operator new(size);
+    }
+
+    static void operator delete(void* p)
+    {
+        ++dealloc_count;
+        ::operator delete(p);
+    }
+};
+
+// a callable too large for both, allocated from the thread local pool
+struct large_object : medium_object
+{
+    void* more_data[16];
+};
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int, char* [])
+{
+    static_assert(sizeof(medium_object) >
+        hpx::util::detail::function_storage_size,
+        "medium_object has to exceed the default storage");
+    static_assert(sizeof(medium_object) <=
+        hpx::util::detail::task_function_storage_size,
+        "medium_object has to fit into the storage of a thread function");
+
+    typedef hpx::util::unique_function_nonser<int()> default_function;
+    typedef hpx::util::unique_function_nonser<int(),
+        hpx::util::detail::task_function_storage_size> task_function;
+
+    {
+        default_function f = counted_medium_object();
+        HPX_TEST_EQ(f(), 42);
+        HPX_TEST_EQ(alloc_count, 1);
+
+        default_function g = std::move(f);
+        HPX_TEST_EQ(g(), 42);
+        HPX_TEST_EQ(alloc_count, 1);
+    }
+    HPX_TEST_EQ(dealloc_count, 1);
+    HPX_TEST_EQ(live_count, 0);
+
+    alloc_count = 0;
+    dealloc_count = 0;
+    {
+        task_function f = counted_medium_object();
+        HPX_TEST_EQ(f(), 42);
+
+        task_function g = std::move(f);
+        HPX_TEST_EQ(g(), 42);
+    }
+    HPX_TEST_EQ(alloc_count, 0);
+    HPX_TEST_EQ(dealloc_count, 0);
+    HPX_TEST_EQ(live_count, 0);
+
+    // the blocks released to the pool are reused
+    for (int i = 0; i != 100; ++i)
+    {
+        task_function f = large_object();
+        HPX_TEST_EQ(f(), 42);
+        HPX_TEST_EQ(live_count, 1);
+
+        f.reset();
+        HPX_TEST_EQ(live_count, 0);
+    }
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,120 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/philox_engine.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// known answers published with the Random123 library
+void test_known_answers()
+{
+    std::uint32_t result[4];
+
+    {
+        std::uint32_t const counter[4] = {0, 0, 0, 0};
+        std::uint32_t const key[2] = {0, 0};
+        hpx::util::philox_engine::generate_block(counter, key, result);
+
+        HPX_TEST_EQ(result[0], 0x6627e8d5u);
+        HPX_TEST_EQ(result[1], 0xe169c58du);
+        HPX_TEST_EQ(result[2], 0xbc57ac4cu);
+        HPX_TEST_EQ(result[3], 0x9b00dbd8u);
+    }
+
+    {
+        std::uint32_t const counter[4] = {
+            0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu};
+        std::uint32_t const key[2] = {0xffffffffu, 0xffffffffu};
+        hpx::util::philox_engine::generate_block(counter, key, result);
+
+        HPX_TEST_EQ(result[0], 0x408f276du);
+        HPX_TEST_EQ(result[1], 0x41c83b0eu);
+        HPX_TEST_EQ(result[2], 0xa20bc7c6u);
+        HPX_TEST_EQ(result[3], 0x6d5451fdu);
+    }
+
+    {
+        std::uint32_t const counter[4] = {
+            0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u};
+        std::uint32_t const key[2] = {0xa4093822u, 0x299f31d0u};
+        hpx::util::philox_engine::generate_block(counter, key, result);
+
+        HPX_TEST_EQ(result[0], 0xd16cfe09u);
+        HPX_TEST_EQ(result[1], 0x94fdccebu);
+        HPX_TEST_EQ(result[2], 0x5001e420u);
+        HPX_TEST_EQ(result[3], 0x24126ea1u);
+    }
+}
+
+void test_engine()
+{
+    // the first block of a sequence is the block for the counter
+    // {0, 0, stream}
+    {
+        hpx::util::philox_engine engine(0, 0);
+        HPX_TEST_EQ(engine(), 0x6627e8d5u);
+        HPX_TEST_EQ(engine(), 0xe169c58du);
+        HPX_TEST_EQ(engine(), 0xbc57ac4cu);
+        HPX_TEST_EQ(engine(), 0x9b00dbd8u);
+    }
+
+    // sequences are reproducible, different streams are different
+    {
+        hpx::util::philox_engine e1(42, 7), e2(42, 7), e3(42, 8);
+        HPX_TEST(e1 == e2);
+
+        std::vector<std::uint32_t> v1, v2, v3;
+        for (int i = 0; i != 100; ++i)
+        {
+            v1.push_back(e1());
+            v2.push_back(e2());
+            v3.push_back(e3());
+        }
+        HPX_TEST(v1 == v2);
+        HPX_TEST(v1 != v3);
+
+        e2.seed(42, 7);
+        HPX_TEST(e1 != e2);
+        HPX_TEST_EQ(e2(), v1[0]);
+    }
+
+    // discard is equivalent to drawing the numbers
+    for (unsigned long long n : {0ull, 1ull, 3ull, 4ull, 5ull, 13ull, 1000ull})
+    {
+        hpx::util::philox_engine e1(1, 2), e2(1, 2);
+        e1();
+        e2();
+
+        for (unsigned long long i = 0; i != n; ++i)
+            e1();
+        e2.discard(n);
+
+        HPX_TEST(e1 == e2);
+        HPX_TEST_EQ(e1(), e2());
+    }
+
+    // the engine can be used with the standard distributions
+    {
+        hpx::util::philox_engine engine(3);
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+        for (int i = 0; i != 1000; ++i)
+        {
+            double value = dist(engine);
+            HPX_TEST(value >= 0.0 && value < 1.0);
+        }
+    }
+}
+
+int main()
+{
+    test_known_answers();
+    test_engine();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,93 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/annotated_function.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/sampling_profiler.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <time.h>
+
+namespace sampling = hpx::util::sampling;
+
+///////////////////////////////////////////////////////////////////////////////
+// burn the given amount of CPU time of the calling OS thread
+double thread_cpu_time()
+{
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return double(ts.tv_sec) + double(ts.tv_nsec) * 1e-9;
+}
+
+void spin(double seconds)
+{
+    double const start = thread_cpu_time();
+    while (thread_cpu_time() - start < seconds)
+        /**/;
+}
+
+void sampled_task()
+{
+    hpx::util::annotate_function annotate("sampling_inner");
+    spin(0.05);
+}
+
+int main()
+{
+    std::string const filename = "sampling_profiler_test.folded";
+    sampling::start_sampling(filename, 997, 64, 4096);
+    HPX_TEST(sampling::sampling_enabled);
+
+    std::vector<hpx::future<void> > futures;
+    for (std::size_t i = 0; i != 8; ++i)
+    {
+        futures.push_back(hpx::async(hpx::util::annotated_function(
+            [](){ spin(0.05); }, "sampling_outer")));
+        futures.push_back(hpx::async(&sampled_task));
+    }
+    hpx::wait_all(futures);
+
+    sampling::stop_sampling();
+    HPX_TEST(!sampling::sampling_enabled);
+
+    std::ifstream in(filename.c_str());
+    HPX_TEST(in.is_open());
+
+    // every line is a folded stack followed by its number of samples
+    std::uint64_t outer = 0, inner = 0, total = 0;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::string::size_type pos = line.rfind(' ');
+        HPX_TEST(pos != std::string::npos);
+
+        std::uint64_t count = std::stoull(line.substr(pos + 1));
+        total += count;
+        if (line.compare(0, 14, "sampling_outer") == 0)
+            outer += count;
+        else if (line.compare(0, 14, "sampling_inner") == 0)
+            inner += count;
+    }
+    in.close();
+    std::remove(filename.c_str());
+
+    // 0.4s of CPU time each, the timers on the CPU time of a thread expire
+    // at the scheduler ticks of the kernel only (100Hz at least)
+    HPX_TEST(outer >= 10);
+    HPX_TEST(inner >= 10);
+    HPX_TEST(total >= outer + inner);
+
+    return hpx::util::report_errors();
+}
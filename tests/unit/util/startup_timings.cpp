@@ -0,0 +1,54 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that the phases of the startup of the runtime system are
+// recorded by the time hpx_main is invoked.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/startup_timings.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+int hpx_main(int argc, char* argv[])
+{
+    std::ostringstream strm;
+    hpx::util::startup_timings::print(strm, hpx::get_locality_id());
+
+    std::string const timings = strm.str();
+    char const* const phases[] =
+    {
+        "command line handling:", "module discovery:",
+        "runtime construction:", "runtime start:", "component loading:",
+        "counter registration:", "pre-startup functions:",
+        "startup functions:", "total:"
+    };
+
+    std::string::size_type pos = 0;
+    for (char const* phase : phases)
+    {
+        std::string::size_type next = timings.find(phase, pos);
+        HPX_TEST_NEQ(next, std::string::npos);
+        if (next != std::string::npos)
+            pos = next;
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg =
+    {
+        "hpx.print_startup_timings=1"
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+
+    return hpx::util::report_errors();
+}
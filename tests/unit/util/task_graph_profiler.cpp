@@ -0,0 +1,100 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/annotated_function.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/task_graph_profiler.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace task_graph = hpx::util::task_graph;
+
+///////////////////////////////////////////////////////////////////////////////
+void spin(double seconds)
+{
+    hpx::util::high_resolution_timer t;
+    while (t.elapsed() < seconds)
+        /**/;
+}
+
+void side_task()
+{
+    spin(0.001);
+}
+
+// return the value following the given label in the report
+double get_value(std::string const& report, std::string const& label)
+{
+    std::string::size_type pos = report.find(label);
+    if (pos == std::string::npos)
+        return -1.0;
+
+    std::istringstream strm(report.substr(pos + label.size()));
+    double value = -1.0;
+    strm >> value;
+    return value;
+}
+
+int main()
+{
+    std::string const filename = "task_graph_profiler_test.txt";
+    task_graph::start_profiling(filename, 1048576);
+    HPX_TEST(task_graph::profiling_enabled);
+
+    // a chain of 10 continuations of 2ms each, next to 40 independent tasks
+    // of 1ms each
+    hpx::future<void> chain = hpx::make_ready_future();
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        chain = chain.then(hpx::util::annotated_function(
+            [](hpx::future<void>&&) { spin(0.002); }, "task_graph_chain"));
+    }
+
+    std::vector<hpx::future<void> > futures;
+    for (std::size_t i = 0; i != 40; ++i)
+    {
+        futures.push_back(hpx::async(
+            hpx::util::annotated_function(&side_task, "task_graph_side")));
+    }
+    futures.push_back(std::move(chain));
+    hpx::wait_all(futures);
+
+    task_graph::stop_profiling();
+    HPX_TEST(!task_graph::profiling_enabled);
+
+    std::ifstream in(filename.c_str());
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    std::string const report = buffer.str();
+
+    HPX_TEST_EQ(get_value(report, "dropped nodes:"), 0.0);
+    HPX_TEST(get_value(report, "nodes (thread phases):") >= 51.0);
+
+    // the chain of continuations is on the critical path
+    double const work = get_value(report, "total work [ms]:");
+    double const span = get_value(report, "critical path [ms]:");
+    HPX_TEST(work >= 60.0);
+    HPX_TEST(span >= 19.0);
+    HPX_TEST(span <= work);
+    HPX_TEST(get_value(report, "critical path nodes:") >= 10.0);
+
+    HPX_TEST(report.find("parallelism over time:") != std::string::npos);
+
+#if defined(HPX_HAVE_THREAD_DESCRIPTION)
+    HPX_TEST(report.find("task_graph_side") != std::string::npos);
+#endif
+
+    return hpx::util::report_errors();
+}
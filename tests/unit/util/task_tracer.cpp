@@ -0,0 +1,170 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/annotated_function.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/task_tracer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace tracing = hpx::util::tracing;
+
+///////////////////////////////////////////////////////////////////////////////
+// the layout of the events as written by the tracer
+struct trace_event
+{
+    std::uint64_t timestamp_;
+    std::uint64_t id_;
+    std::uint64_t name_;
+    std::uint32_t data_;
+    std::uint16_t type_;
+    std::uint16_t flags_;
+};
+
+struct trace_file
+{
+    explicit trace_file(std::string const& filename)
+      : valid_(false), finished_(false), dropped_(0)
+    {
+        std::ifstream in(filename.c_str(), std::ios::binary);
+        data_.assign(std::istreambuf_iterator<char>(in),
+            std::istreambuf_iterator<char>());
+
+        if (data_.size() < 32 || std::memcmp(data_.data(), "HPXTRACE", 8) != 0)
+            return;
+
+        std::size_t pos = 32;
+        while (pos < data_.size())
+        {
+            char tag = data_[pos++];
+            if (tag == 'T' || tag == 'N')
+            {
+                std::uint64_t key = 0;
+                std::size_t key_size = tag == 'T' ? 4 : 8;
+                std::memcpy(&key, &data_[pos], key_size);
+                pos += key_size;
+
+                std::uint32_t length = read<std::uint32_t>(pos);
+                std::string name(&data_[pos], length);
+                pos += length;
+
+                if (tag == 'N')
+                    names_.insert(name);
+            }
+            else if (tag == 'E')
+            {
+                read<std::uint32_t>(pos);
+                std::uint32_t count = read<std::uint32_t>(pos);
+                for (std::uint32_t i = 0; i != count; ++i)
+                    events_.push_back(read<trace_event>(pos));
+            }
+            else if (tag == 'F')
+            {
+                read<std::uint64_t>(pos);
+                read<std::uint64_t>(pos);
+                dropped_ = read<std::uint64_t>(pos);
+                finished_ = true;
+            }
+            else
+            {
+                return;
+            }
+        }
+        valid_ = true;
+    }
+
+    template <typename T>
+    T read(std::size_t& pos)
+    {
+        T value;
+        std::memcpy(&value, &data_[pos], sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    std::size_t count(tracing::event_type type) const
+    {
+        std::size_t result = 0;
+        for (trace_event const& e : events_)
+        {
+            if (e.type_ == type)
+                ++result;
+        }
+        return result;
+    }
+
+    std::vector<char> data_;
+    bool valid_;
+    bool finished_;
+    std::uint64_t dropped_;
+    std::vector<trace_event> events_;
+    std::set<std::string> names_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+void annotated()
+{
+    hpx::util::annotate_function annotate("task_tracer_annotation");
+}
+
+void test_trace(std::size_t buffer_size)
+{
+    std::string const filename = "task_tracer_test.bin";
+    tracing::start_tracing(filename, buffer_size, 0);
+
+    std::vector<hpx::future<void> > futures;
+    for (std::size_t i = 0; i != 100; ++i)
+    {
+        futures.push_back(hpx::async(
+            hpx::util::annotated_function(&annotated, "task_tracer_task")));
+    }
+    hpx::wait_all(futures);
+
+    tracing::stop_tracing();
+
+    trace_file trace(filename);
+    HPX_TEST(trace.valid_);
+    HPX_TEST(trace.finished_);
+    HPX_TEST_EQ(trace.dropped_, tracing::get_dropped_events());
+
+    // every event was either written or dropped
+    std::size_t const recorded = trace.events_.size() + trace.dropped_;
+    HPX_TEST(recorded >= 400);
+
+    if (trace.dropped_ == 0)
+    {
+        HPX_TEST(trace.count(tracing::event_thread_create) >= 100);
+        HPX_TEST(trace.count(tracing::event_thread_run) >= 100);
+        HPX_TEST(trace.count(tracing::event_thread_terminate) >= 100);
+
+#if defined(HPX_HAVE_THREAD_DESCRIPTION)
+        HPX_TEST(trace.names_.count("task_tracer_task") == 1);
+        HPX_TEST(trace.names_.count("task_tracer_annotation") == 1);
+#endif
+    }
+
+    // nothing is recorded once tracing has been stopped
+    HPX_TEST(!tracing::tracing_enabled);
+}
+
+int main()
+{
+    test_trace(65536);
+
+    // a second trace starts afresh, reusing the existing ring buffers
+    test_trace(1024);
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,467 @@
+#!/usr/bin/python
+"""
+# Copyright (c) 2019 The STE||AR-Group
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+hpx_benchmarks.py - Run the local or the network HPX benchmarks with a fixed
+number of repetitions and write their results as JSON (run), or compare the
+results of two runs and report the statistically significant regressions
+(compare).
+"""
+
+from __future__ import print_function
+import argparse
+import datetime
+import json
+import math
+import os
+import platform
+import re
+import subprocess
+import sys
+
+FORMAT_VERSION = 1
+
+# not available with python 2, timeouts are not supported there
+TIMEOUT_EXPIRED = getattr(subprocess, 'TimeoutExpired', ())
+
+
+class Metric(object):
+    '''Extracts the values of one or more metrics from the output of a
+    benchmark. The first group of the pattern is the name of the metric
+    (unless a name is given), the last one its value.'''
+
+    def __init__(self, pattern, unit, higher_is_better=False, name=None,
+                 scale=1.0):
+        self.pattern = re.compile(pattern, re.MULTILINE)
+        self.unit = unit
+        self.higher_is_better = higher_is_better
+        self.name = name
+        self.scale = scale
+
+    def parse(self, output):
+        for match in self.pattern.finditer(output):
+            name = self.name if self.name is not None else match.group(1)
+            yield name, float(match.group(match.lastindex)) * self.scale
+
+
+def dart_measurement(names=r'[^"]+', unit='s', higher_is_better=False):
+    '''The values printed by hpx::util::print_cdash_timing (in seconds,
+    unless noted otherwise) with a name matching the given pattern.'''
+    return Metric(r'<DartMeasurement name="(' + names +
+                  r')" type="numeric/double">([-+0-9.eE]+)</DartMeasurement>',
+                  unit, higher_is_better)
+
+
+# The benchmarks of the suite: the executable, its arguments and the metrics
+# reported by it. The executables are looked up in the given build directory.
+SUITE = {
+    'future_overhead': {
+        'executable': 'future_overhead_test',
+        'arguments': ['--futures=100000'],
+        'metrics': [dart_measurement()],
+    },
+    'async_overheads': {
+        'executable': 'async_overheads_test',
+        'arguments': ['--tasks=100000'],
+        'metrics': [dart_measurement(r'(?!AsyncSpeedup)[^"]+'),
+                    dart_measurement('AsyncSpeedup', '', True)],
+    },
+    'wait_all_timings': {
+        'executable': 'wait_all_timings_test',
+        'arguments': [],
+        'metrics': [dart_measurement()],
+    },
+    'skynet': {
+        'executable': 'skynet_test',
+        'arguments': ['--repetitions=1'],
+        'metrics': [Metric(r'^(\S+): -?\d+ in ([-+0-9.eE]+) ms', 'ms')],
+    },
+    'stream': {
+        'executable': 'stream_test',
+        'arguments': ['--vector_size=1048576', '--iterations=10'],
+        'metrics': [Metric(r'^(Copy|Scale|Add|Triad):\s+([-+0-9.eE]+)',
+                           'MB/s', higher_is_better=True)],
+    },
+    'htts2_hpx': {
+        'executable': 'htts2_hpx',
+        'arguments': ['--tasks=100000', '--payload=0'],
+        'metrics': [Metric(r'^\d+,\d+,\d+,([-+0-9.eE]+)$', 's',
+                           name='walltime', scale=1e-9)],
+    },
+}
+
+
+def network_suite(message_sizes, messages):
+    '''The multi-locality benchmarks (network_benchmarks), run once for each
+    of the message sizes. They are started through hpxrun.py.'''
+    suite = {}
+    for size in message_sizes:
+        suite['network_%d' % size] = {
+            'executable': 'network_benchmarks',
+            'arguments': ['--message-size=%d' % size,
+                          '--messages=%d' % messages],
+            'metrics': [
+                dart_measurement('MessageRate|CoalescedMessageRate|'
+                                 'AsyncRoundTripRate|AGASResolveRate|'
+                                 'AGASIncrefRate', '1/s', True),
+                dart_measurement('CoalescingSpeedup|'
+                                 'CoalescingParcelsPerMessage', '', True),
+                dart_measurement('AllToAllTime|AsyncRoundTripTime'),
+            ],
+        }
+    return suite
+
+
+###############################################################################
+# statistics
+def median(values):
+    s = sorted(values)
+    n = len(s)
+    if n % 2:
+        return s[n // 2]
+    return 0.5 * (s[n // 2 - 1] + s[n // 2])
+
+
+def binomial_cdf(k, n):
+    '''P(X <= k) for X ~ B(n, 1/2)'''
+    return sum(math.exp(math.lgamma(n + 1) - math.lgamma(i + 1) -
+                        math.lgamma(n - i + 1)) for i in range(k + 1)) / \
+        2.0 ** n
+
+
+def median_confidence_interval(values, confidence):
+    '''Distribution free confidence interval of the median, based on the
+    order statistics of the samples. Returns the range of the samples if
+    there are too few of them for the requested confidence.'''
+    s = sorted(values)
+    n = len(s)
+    alpha = 1.0 - confidence
+    lower = 0
+    while lower + 1 < n and binomial_cdf(lower, n) <= alpha / 2:
+        lower += 1
+    # s[lower - 1] is the largest order statistic below the median which
+    # still satisfies P(X < lower) <= alpha / 2
+    lower = max(lower - 1, 0)
+    return s[lower], s[n - 1 - lower]
+
+
+def normal_cdf(x):
+    return 0.5 * math.erfc(-x / math.sqrt(2.0))
+
+
+def mann_whitney(a, b):
+    '''Two sided Mann-Whitney U test using the normal approximation with
+    tie correction, returns the p-value.'''
+    n1, n2 = len(a), len(b)
+    if n1 == 0 or n2 == 0:
+        return 1.0
+
+    combined = sorted([(v, 0) for v in a] + [(v, 1) for v in b])
+    ranks = [0.0] * len(combined)
+    ties = 0.0
+    i = 0
+    while i < len(combined):
+        j = i
+        while j + 1 < len(combined) and combined[j + 1][0] == combined[i][0]:
+            j += 1
+        rank = 0.5 * (i + j) + 1.0
+        for k in range(i, j + 1):
+            ranks[k] = rank
+        t = j - i + 1
+        ties += t ** 3 - t
+        i = j + 1
+
+    r1 = sum(r for r, (_, group) in zip(ranks, combined) if group == 0)
+    u = r1 - n1 * (n1 + 1) / 2.0
+    n = n1 + n2
+    mu = n1 * n2 / 2.0
+    sigma = math.sqrt(n1 * n2 / 12.0 * ((n + 1) - ties / (n * (n - 1))))
+    if sigma == 0.0:
+        return 1.0
+    z = (abs(u - mu) - 0.5) / sigma
+    return min(1.0, 2.0 * (1.0 - normal_cdf(max(z, 0.0))))
+
+
+def summarize(samples, confidence):
+    n = len(samples)
+    mean = sum(samples) / n
+    stddev = math.sqrt(sum((v - mean) ** 2 for v in samples) / (n - 1)) \
+        if n > 1 else 0.0
+    low, high = median_confidence_interval(samples, confidence)
+    return {
+        'median': median(samples),
+        'ci_low': low,
+        'ci_high': high,
+        'mean': mean,
+        'stddev': stddev,
+        'min': min(samples),
+        'max': max(samples),
+    }
+
+
+###############################################################################
+# run
+def run_benchmark(command, timeout):
+    process = subprocess.Popen(command, stdout=subprocess.PIPE,
+                               stderr=subprocess.STDOUT)
+    try:
+        if timeout and sys.version_info[0] >= 3:
+            output, _ = process.communicate(timeout=timeout)
+        else:
+            output, _ = process.communicate()
+    except TIMEOUT_EXPIRED:
+        process.kill()
+        process.communicate()
+        raise RuntimeError('timed out after %d seconds' % timeout)
+
+    output = output.decode('utf-8', 'replace')
+    if process.returncode != 0:
+        raise RuntimeError('exited with %d:\n%s' %
+                           (process.returncode, output))
+    return output
+
+
+def run(args):
+    if args.suite == 'network':
+        suite = network_suite(
+            [int(size) for size in args.message_sizes.split(',')],
+            args.messages)
+    else:
+        suite = SUITE
+
+    selected = sorted(suite.keys())
+    if args.filter:
+        rx = re.compile(args.filter)
+        selected = [name for name in selected if rx.search(name)]
+
+    hpx_arguments = []
+    if args.bind:
+        hpx_arguments.append('--hpx:bind=%s' % args.bind)
+    hpx_arguments += args.hpx_args or []
+
+    # the network benchmarks are started on all localities by hpxrun.py,
+    # which also selects the parcelport and the number of threads
+    if args.suite == 'network':
+        hpxrun = args.hpxrun or os.path.join(args.build_dir, 'hpxrun.py')
+        launcher = [sys.executable, hpxrun]
+        launcher_arguments = [
+            '-l', str(args.localities), '-t', str(args.threads),
+            '-p', args.parcelport, '-r', args.runwrapper, '--']
+    else:
+        launcher = []
+        launcher_arguments = []
+        hpx_arguments.insert(0, '--hpx:threads=%d' % args.threads)
+
+    results = {}
+    failures = 0
+    for name in selected:
+        benchmark = suite[name]
+        path = os.path.join(args.build_dir,
+                            args.executable_prefix + benchmark['executable'])
+        if platform.system() == 'Windows':
+            path += '.exe'
+        if not os.path.exists(path):
+            print('%s: %s not found, skipping' % (name, path),
+                  file=sys.stderr)
+            continue
+
+        command = launcher + [path] + launcher_arguments + \
+            benchmark['arguments'] + hpx_arguments
+        samples = {}
+        try:
+            for repetition in range(args.warmup + args.repetitions):
+                print('%s: %s %d/%d' % (
+                    name, 'warm-up' if repetition < args.warmup else 'run',
+                    repetition + 1, args.warmup + args.repetitions),
+                    file=sys.stderr)
+                output = run_benchmark(command, args.timeout)
+                if repetition < args.warmup:
+                    continue
+                for metric in benchmark['metrics']:
+                    for key, value in metric.parse(output):
+                        samples.setdefault(key, (metric, []))[1].append(value)
+        except RuntimeError as e:
+            print('%s: %s' % (name, e), file=sys.stderr)
+            failures += 1
+            continue
+
+        if not samples:
+            print('%s: no results found in the output' % name,
+                  file=sys.stderr)
+            failures += 1
+            continue
+
+        metrics = {}
+        for key, (metric, values) in samples.items():
+            entry = summarize(values, args.confidence)
+            entry['unit'] = metric.unit
+            entry['higher_is_better'] = metric.higher_is_better
+            entry['samples'] = values
+            metrics[key] = entry
+
+        results[name] = {
+            'command_line': command,
+            'metrics': metrics,
+        }
+
+    report = {
+        'version': FORMAT_VERSION,
+        'timestamp': datetime.datetime.utcnow().isoformat() + 'Z',
+        'host': platform.node(),
+        'label': args.label,
+        'repetitions': args.repetitions,
+        'warmup': args.warmup,
+        'confidence': args.confidence,
+        'suite': args.suite,
+        'benchmarks': results,
+    }
+    if args.suite == 'network':
+        report['localities'] = args.localities
+        report['parcelport'] = args.parcelport
+
+    if args.output == '-':
+        json.dump(report, sys.stdout, indent=2, sort_keys=True)
+        print()
+    else:
+        with open(args.output, 'w') as f:
+            json.dump(report, f, indent=2, sort_keys=True)
+            f.write('\n')
+
+    return 1 if failures else 0
+
+
+###############################################################################
+# compare
+def load(filename):
+    with open(filename) as f:
+        report = json.load(f)
+    if report.get('version') != FORMAT_VERSION:
+        raise ValueError('%s: unsupported format version %s' %
+                         (filename, report.get('version')))
+    return report
+
+
+def compare(args):
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    regressions = 0
+    rows = []
+    for name in sorted(current['benchmarks'].keys()):
+        if name not in baseline['benchmarks']:
+            continue
+        base_metrics = baseline['benchmarks'][name]['metrics']
+        metrics = current['benchmarks'][name]['metrics']
+        for key in sorted(metrics.keys()):
+            if key not in base_metrics:
+                continue
+            old = base_metrics[key]
+            new = metrics[key]
+            if old['median'] == 0.0:
+                continue
+
+            change = (new['median'] - old['median']) / abs(old['median'])
+            worse = -change if new['higher_is_better'] else change
+            p = mann_whitney(old['samples'], new['samples'])
+
+            status = ''
+            if p < args.alpha and abs(change) > args.threshold:
+                if worse > 0:
+                    status = 'REGRESSION'
+                    regressions += 1
+                else:
+                    status = 'improvement'
+
+            rows.append((name + '/' + key, old['median'], new['median'],
+                         new['unit'], 100.0 * change, p, status))
+
+    print('%-50s %12s %12s %6s %8s %8s  %s' % (
+        'benchmark/metric', 'baseline', 'current', 'unit', 'change',
+        'p-value', ''))
+    for row in rows:
+        print('%-50s %12.6g %12.6g %6s %+7.2f%% %8.4f  %s' % row)
+
+    print('\n%d regression(s) found (alpha = %g, threshold = %g%%)' % (
+        regressions, args.alpha, 100.0 * args.threshold))
+    return 1 if regressions else 0
+
+
+###############################################################################
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n', 1)[1],
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    commands = parser.add_subparsers(dest='command')
+
+    p = commands.add_parser('run', help='run the benchmarks')
+    p.add_argument('--suite', choices=['local', 'network'], default='local',
+                   help='the benchmarks to run (default: local)')
+    p.add_argument('--build-dir', default='bin',
+                   help='directory holding the benchmark executables')
+    p.add_argument('--executable-prefix', default='',
+                   help='the prefix of the executable names, see '
+                        'HPX_WITH_EXECUTABLE_PREFIX')
+    p.add_argument('--output', '-o', default='-',
+                   help='the JSON file to write (default: stdout)')
+    p.add_argument('--repetitions', '-r', type=int, default=10,
+                   help='measured runs of each benchmark (default: 10)')
+    p.add_argument('--warmup', '-w', type=int, default=1,
+                   help='discarded runs before measuring (default: 1)')
+    p.add_argument('--threads', '-t', type=int, default=4,
+                   help='the number of worker threads (default: 4)')
+    p.add_argument('--bind', default='compact',
+                   help='the thread binding passed as --hpx:bind, empty '
+                        'to disable pinning (default: compact)')
+    p.add_argument('--filter', help='run only the benchmarks matching this '
+                                    'regular expression')
+    p.add_argument('--confidence', type=float, default=0.95,
+                   help='the confidence level of the intervals of the '
+                        'medians (default: 0.95)')
+    p.add_argument('--timeout', type=int, default=600,
+                   help='timeout of a single run in seconds (default: 600)')
+    p.add_argument('--label', default='',
+                   help='a label stored with the results, e.g. the version')
+    p.add_argument('--localities', '-l', type=int, default=2,
+                   help='network suite: the number of localities '
+                        '(default: 2)')
+    p.add_argument('--parcelport', '-p', default='tcp',
+                   help='network suite: the parcelport, passed to hpxrun.py '
+                        '(default: tcp)')
+    p.add_argument('--runwrapper', default='none',
+                   help='network suite: how to start the localities (none, '
+                        'mpi or srun), passed to hpxrun.py (default: none)')
+    p.add_argument('--message-sizes', default='8,1024,65536',
+                   help='network suite: comma separated list of the message '
+                        'sizes in bytes (default: 8,1024,65536)')
+    p.add_argument('--messages', type=int, default=10000,
+                   help='network suite: the number of messages per sender '
+                        '(default: 10000)')
+    p.add_argument('--hpxrun',
+                   help='network suite: the path of hpxrun.py (default: '
+                        'hpxrun.py in the build directory)')
+    p.add_argument('hpx_args', nargs='*',
+                   help='additional arguments passed to all benchmarks')
+
+    p = commands.add_parser('compare', help='compare the results of two runs')
+    p.add_argument('baseline', help='the results of the baseline run')
+    p.add_argument('current', help='the results of the run to check')
+    p.add_argument('--alpha', type=float, default=0.01,
+                   help='significance level of the Mann-Whitney U test '
+                        '(default: 0.01)')
+    p.add_argument('--threshold', type=float, default=0.02,
+                   help='minimal relative change of the median reported '
+                        '(default: 0.02)')
+
+    args = parser.parse_args()
+    if args.command == 'run':
+        return run(args)
+    if args.command == 'compare':
+        return compare(args)
+    parser.print_help()
+    return 2
+
+
+if __name__ == '__main__':
+    sys.exit(main())
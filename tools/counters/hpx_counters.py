@@ -0,0 +1,144 @@
+#!/usr/bin/python
+"""
+# Copyright (c) 2019 The STE||AR-Group
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+hpx_counters.py - Read the performance counters published by HPX in a shared
+memory segment (see --hpx:export-counter) and print them as plain text or in
+the Prometheus text exposition format.
+"""
+
+from __future__ import print_function
+import argparse
+import mmap
+import os
+import re
+import struct
+import sys
+import time
+
+# keep in sync with hpx/util/counter_exporter.hpp
+MAGIC = b'HPXCNTRS'
+VERSION = 1
+
+HEADER = struct.Struct('=8sIIQQQ')
+STATE = struct.Struct('=QQQ')           # sequence, timestamp, samples
+ENTRY = struct.Struct('=qqQii')         # value, scaling, count, status, inverse
+HEADER_SIZE = HEADER.size + STATE.size
+
+STATUS_VALID_DATA = 0
+STATUS_NEW_DATA = 1
+
+
+class Segment(object):
+    '''A shared memory segment written by one locality.'''
+
+    def __init__(self, name):
+        path = name
+        if not os.path.exists(path):
+            path = '/dev/shm/' + name.lstrip('/')
+        with open(path, 'rb') as f:
+            self.map = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+
+        magic, version, self.locality, self.num_counters, names_offset, \
+            self.interval = HEADER.unpack_from(self.map, 0)
+        if magic != MAGIC:
+            raise ValueError('%s: not an HPX counter segment (yet)' % name)
+        if version != VERSION:
+            raise ValueError('%s: unsupported version %d' % (name, version))
+
+        self.names = []
+        offset = names_offset
+        for _ in range(self.num_counters):
+            length, = struct.unpack_from('=I', self.map, offset)
+            offset += 4
+            self.names.append(
+                self.map[offset:offset + length].decode('utf-8'))
+            offset += length
+
+    def sample(self):
+        '''Return a consistent snapshot of all counters. The writer
+        increments the sequence number before and after updating the
+        values, retry while it is odd or if it changed while reading.'''
+        size = self.num_counters * ENTRY.size
+        while True:
+            seq1, timestamp, samples = STATE.unpack_from(self.map, HEADER.size)
+            if seq1 & 1:
+                continue
+            data = self.map[HEADER_SIZE:HEADER_SIZE + size]
+            seq2, = struct.unpack_from('=Q', self.map, HEADER.size)
+            if seq1 == seq2:
+                break
+
+        values = []
+        for i in range(self.num_counters):
+            value, scaling, count, status, inverse = \
+                ENTRY.unpack_from(data, i * ENTRY.size)
+            if status not in (STATUS_VALID_DATA, STATUS_NEW_DATA):
+                value = None
+            elif scaling not in (0, 1):
+                value = float(value) / scaling if inverse \
+                    else float(value) * scaling
+            values.append((self.names[i], value, count))
+        return timestamp, samples, values
+
+
+def prometheus_name(name):
+    '''Map an HPX counter name to a metric name and its labels.'''
+    m = re.match(r'/([^{/]+)(?:\{([^}]*)\})?/?(.*)', name)
+    obj, instance, counter = m.group(1), m.group(2) or '', m.group(3)
+    params = ''
+    if '@' in counter:
+        counter, params = counter.split('@', 1)
+    metric = 'hpx_' + re.sub(r'[^a-zA-Z0-9_]', '_', obj + '_' + counter)
+    labels = ['instance="%s"' % instance]
+    if params:
+        labels.append('parameters="%s"' % params.replace('"', '\\"'))
+    return metric, ','.join(labels)
+
+
+def print_plain(segment, out):
+    timestamp, samples, values = segment.sample()
+    print('# locality %d, sample %d, timestamp %d ns' % (
+        segment.locality, samples, timestamp), file=out)
+    for name, value, count in values:
+        print('%s,%d,%s' % (name, count,
+            'invalid' if value is None else value), file=out)
+
+
+def print_prometheus(segment, out):
+    timestamp, samples, values = segment.sample()
+    for name, value, _ in values:
+        if value is None:
+            continue
+        metric, labels = prometheus_name(name)
+        print('%s{%s,locality="%d"} %s %d' % (metric, labels,
+            segment.locality, value, timestamp // 1000000), file=out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[-1])
+    parser.add_argument('segments', nargs='+',
+                        help='shared memory segments, e.g. /hpx-counters.42.0')
+    parser.add_argument('-p', '--prometheus', action='store_true',
+                        help='print in the prometheus text format')
+    parser.add_argument('-i', '--interval', type=float, default=0,
+                        help='repeat every given number of seconds')
+    args = parser.parse_args()
+
+    segments = [Segment(name) for name in args.segments]
+    printer = print_prometheus if args.prometheus else print_plain
+    while True:
+        for segment in segments:
+            printer(segment, sys.stdout)
+        sys.stdout.flush()
+        if args.interval <= 0:
+            break
+        time.sleep(args.interval)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,214 @@
+#!/usr/bin/python
+"""
+# Copyright (c) 2019 The STE||AR-Group
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+hpx_trace.py - Convert the binary task traces written by HPX (see
+hpx.trace.file) to the Chrome trace event format (JSON), which can be loaded
+into chrome://tracing or https://ui.perfetto.dev.
+"""
+
+from __future__ import print_function
+import argparse
+import json
+import struct
+import sys
+
+# keep in sync with hpx/util/task_tracer.hpp
+EVENT_THREAD_CREATE = 0
+EVENT_THREAD_RUN = 1
+EVENT_THREAD_SUSPEND = 2
+EVENT_THREAD_TERMINATE = 3
+EVENT_PARCEL_SEND = 4
+EVENT_PARCEL_RECEIVE = 5
+EVENT_ANNOTATION = 6
+
+FLAG_NAME_IS_ADDRESS = 1
+
+THREAD_STATES = {
+    1: 'active', 2: 'pending', 3: 'suspended', 4: 'depleted',
+    5: 'terminated', 6: 'staged', 7: 'pending_do_not_schedule',
+    8: 'pending_boost'
+}
+
+EVENT = struct.Struct('=QQQIHH')
+
+
+class Trace(object):
+    '''The contents of one trace file.'''
+
+    def __init__(self, filename):
+        self.threads = {}
+        self.names = {}
+        self.events = []        # (buffer, timestamp, id, name, data, type, flags)
+        self.end_ticks = None
+        self.end_ns = None
+        self.dropped = 0
+
+        with open(filename, 'rb') as f:
+            data = f.read()
+
+        if data[:8] != b'HPXTRACE':
+            raise ValueError('%s is not a HPX trace file' % filename)
+
+        self.version, self.locality, self.start_ticks, self.start_ns = \
+            struct.unpack_from('=IIQQ', data, 8)
+        if self.version != 1:
+            raise ValueError('%s: unsupported trace version %d' %
+                (filename, self.version))
+
+        try:
+            self._parse(data, 32)
+        except struct.error:
+            print('%s: the trace file is truncated' % filename,
+                file=sys.stderr)
+
+    def _string(self, data, pos):
+        length, = struct.unpack_from('=I', data, pos)
+        pos += 4
+        if pos + length > len(data):
+            raise struct.error('truncated string')
+        return data[pos:pos + length].decode('utf-8', 'replace'), pos + length
+
+    def _parse(self, data, pos):
+        while pos < len(data):
+            tag = data[pos:pos + 1]
+            pos += 1
+            if tag == b'T':
+                index, = struct.unpack_from('=I', data, pos)
+                self.threads[index], pos = self._string(data, pos + 4)
+            elif tag == b'N':
+                key, = struct.unpack_from('=Q', data, pos)
+                self.names[key], pos = self._string(data, pos + 8)
+            elif tag == b'E':
+                index, count = struct.unpack_from('=II', data, pos)
+                pos += 8
+                for _ in range(count):
+                    self.events.append((index,) +
+                        EVENT.unpack_from(data, pos))
+                    pos += EVENT.size
+            elif tag == b'F':
+                self.end_ticks, self.end_ns, self.dropped = \
+                    struct.unpack_from('=QQQ', data, pos)
+                pos += 24
+            else:
+                raise ValueError('unknown record type at offset %d' % pos)
+
+    def ns_per_tick(self):
+        if self.end_ticks is None or self.end_ticks <= self.start_ticks:
+            return 1.0
+        return float(self.end_ns - self.start_ns) / \
+            float(self.end_ticks - self.start_ticks)
+
+    def name(self, event):
+        key, flags = event[3], event[6]
+        if flags & FLAG_NAME_IS_ADDRESS:
+            return '0x%x' % key
+        if key == 0:
+            return '<unknown>'
+        return self.names.get(key, '<unknown>')
+
+
+def convert(traces):
+    '''Return the Chrome trace events for the given traces.'''
+    result = []
+    origin = min(t.start_ns for t in traces)
+
+    for trace in traces:
+        pid = trace.locality
+        scale = trace.ns_per_tick()
+
+        def timestamp(ticks):
+            # the trace events use microseconds
+            return (trace.start_ns - origin +
+                (ticks - trace.start_ticks) * scale) / 1000.0
+
+        result.append({'ph': 'M', 'name': 'process_name', 'pid': pid,
+            'args': {'name': 'locality#%d' % pid}})
+        for index, name in trace.threads.items():
+            result.append({'ph': 'M', 'name': 'thread_name', 'pid': pid,
+                'tid': index, 'args': {'name': name}})
+
+        if trace.dropped != 0:
+            print('locality#%d: %d events were dropped' %
+                (pid, trace.dropped), file=sys.stderr)
+
+        # the ring buffers are written in chunks, restore the order
+        events = sorted(trace.events, key=lambda e: (e[0], e[1]))
+
+        running = {}            # buffer -> thread currently running
+        for e in events:
+            tid, ticks, ident, etype = e[0], e[1], e[2], e[5]
+            ts = timestamp(ticks)
+            base = {'pid': pid, 'tid': tid, 'ts': ts}
+
+            if etype == EVENT_THREAD_RUN:
+                if tid in running:
+                    result.append(dict(base, ph='E'))
+                running[tid] = ident
+                result.append(dict(base, ph='B', name=trace.name(e),
+                    cat='thread', args={'id': '0x%x' % ident,
+                        'phase': e[4]}))
+            elif etype in (EVENT_THREAD_SUSPEND, EVENT_THREAD_TERMINATE):
+                if running.pop(tid, None) is not None:
+                    args = {}
+                    if etype == EVENT_THREAD_SUSPEND:
+                        args['state'] = THREAD_STATES.get(e[4], str(e[4]))
+                    else:
+                        args['state'] = 'terminated'
+                    result.append(dict(base, ph='E', args=args))
+            elif etype == EVENT_ANNOTATION:
+                # the running thread changed its description
+                if running.get(tid) == ident:
+                    result.append(dict(base, ph='E'))
+                    result.append(dict(base, ph='B', name=trace.name(e),
+                        cat='thread', args={'id': '0x%x' % ident}))
+            elif etype == EVENT_THREAD_CREATE:
+                args = {'state': THREAD_STATES.get(e[4], str(e[4]))}
+                if ident != 0:
+                    args['id'] = '0x%x' % ident
+                result.append(dict(base, ph='i', s='t', cat='create',
+                    name='create ' + trace.name(e), args=args))
+            elif etype in (EVENT_PARCEL_SEND, EVENT_PARCEL_RECEIVE):
+                send = etype == EVENT_PARCEL_SEND
+                args = {('destination' if send else 'source'): e[4]}
+                result.append(dict(base, ph='i', s='t', cat='parcel',
+                    name=('send ' if send else 'receive ') + trace.name(e),
+                    args=args))
+                # connect sender and receiver if the parcel id is known
+                if ident != 0:
+                    result.append(dict(base, ph='s' if send else 'f',
+                        bp='e', cat='parcel', name='parcel',
+                        id='0x%x' % ident))
+
+        # close the slices of threads still running at the end of the trace
+        for tid in running:
+            end = trace.end_ticks if trace.end_ticks is not None else \
+                max(e[1] for e in events)
+            result.append({'ph': 'E', 'pid': pid, 'tid': tid,
+                'ts': timestamp(end)})
+
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[1])
+    parser.add_argument('traces', nargs='+',
+        help='the trace files to convert, one for each locality')
+    parser.add_argument('-o', '--output', default='-',
+        help='the JSON file to write (default: standard output)')
+    args = parser.parse_args()
+
+    events = convert([Trace(name) for name in args.traces])
+
+    if args.output == '-':
+        json.dump({'traceEvents': events}, sys.stdout)
+    else:
+        with open(args.output, 'w') as f:
+            json.dump({'traceEvents': events}, f)
+
+
+if __name__ == '__main__':
+    main()